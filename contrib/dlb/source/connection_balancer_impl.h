@@ -185,6 +185,8 @@ public:
   // Return DlbBalancedConnectionHandlerImpl to handle Dlb send/recv.
   Envoy::Network::BalancedConnectionHandler&
   pickTargetHandler(Envoy::Network::BalancedConnectionHandler& current_handler) override;
+
+  void onConnectionClosed(Envoy::Network::BalancedConnectionHandler&) override {}
 };
 
 } // namespace Dlb
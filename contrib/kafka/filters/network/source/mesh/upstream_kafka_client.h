@@ -20,7 +20,7 @@ namespace Mesh {
 struct DeliveryMemento {
 
   // Pointer to byte array that was passed to Kafka producer.
-  // We use this to tell apart messages.
+  // We use this to tell apart messages, and to find the requests that could have sent them.
   // Important: we do not free this memory, it's still part of the 'ProduceRequestHandler' object.
   // Future work: adopt Kafka's opaque-pointer functionality so we use less memory instead of
   // keeping whole payload until we receive a confirmation.
@@ -84,7 +84,7 @@ void RichKafkaProducer::send(const ProduceFinishCbSharedPtr origin, const Outbou
 
     if (RdKafka::ERR_NO_ERROR == ec) {
       // We have succeeded with submitting data to producer, so we register a callback.
-      unfinished_produce_requests_.push_back(origin);
+      unfinished_produce_requests_.emplace(value_data, origin);
     } else {
       // We could not submit data to producer.
       // Let's treat that as a normal failure (Envoy is a broker after all) and propagate
@@ -124,21 +124,20 @@ void RichKafkaProducer::dr_cb(RdKafka::Message& message) {
 }
 
 // We got the delivery data.
-// Now we just check all unfinished requests, find the one that originated this particular delivery,
-// and notify it.
+// Now we just check the unfinished requests that sent this payload, find the one that originated
+// this particular delivery, and notify it.
 void RichKafkaProducer::processDelivery(const DeliveryMemento& memento) {
-  for (auto it = unfinished_produce_requests_.begin(); it != unfinished_produce_requests_.end();) {
-    bool accepted = (*it)->accept(memento);
+  auto [it, end] = unfinished_produce_requests_.equal_range(memento.data_);
+  for (; it != end; ++it) {
+    bool accepted = it->second->accept(memento);
     if (accepted) {
       unfinished_produce_requests_.erase(it);
       break; // This is important - a single request can be mapped into multiple callbacks here.
-    } else {
-      ++it;
     }
   }
 }
 
-std::list<ProduceFinishCbSharedPtr>& RichKafkaProducer::getUnfinishedRequestsForTest() {
+RichKafkaProducer::UnfinishedProduceRequests& RichKafkaProducer::getUnfinishedRequestsForTest() {
   return unfinished_produce_requests_;
 }
 
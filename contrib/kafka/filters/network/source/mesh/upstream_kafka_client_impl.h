@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <unordered_map>
 
 #include "envoy/event/dispatcher.h"
 
@@ -53,12 +54,17 @@ public:
   // Executed in Envoy worker thread.
   void processDelivery(const DeliveryMemento& memento);
 
-  std::list<ProduceFinishCbSharedPtr>& getUnfinishedRequestsForTest();
+  using UnfinishedProduceRequests = std::unordered_multimap<const void*, ProduceFinishCbSharedPtr>;
+
+  UnfinishedProduceRequests& getUnfinishedRequestsForTest();
 
 private:
   Event::Dispatcher& dispatcher_;
 
-  std::list<ProduceFinishCbSharedPtr> unfinished_produce_requests_;
+  // Requests waiting for delivery confirmations, keyed by the payload pointer of each record sent,
+  // so that a confirmation does not need to be offered to every request in flight.
+  // Records with null values share the same (null) key.
+  UnfinishedProduceRequests unfinished_produce_requests_;
 
   // Real Kafka producer (thread-safe).
   // Invoked by Envoy handler thread (to produce), and internal monitoring thread
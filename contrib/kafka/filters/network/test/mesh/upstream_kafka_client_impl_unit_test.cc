@@ -106,7 +106,8 @@ TEST_F(UpstreamKafkaClientTest, ShouldCheckCallbacksForDeliveries) {
   EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), payloads.size());
 
   // when, then - should process confirmations (notice we pass second memento first).
-  EXPECT_CALL(*origin1, accept(_)).WillOnce(Return(false)).WillOnce(Return(true));
+  // Each confirmation is only offered to the request that sent its payload.
+  EXPECT_CALL(*origin1, accept(_)).WillOnce(Return(true));
   EXPECT_CALL(*origin2, accept(_)).WillOnce(Return(true));
   const DeliveryMemento memento1 = {payloads[1].c_str(), RdKafka::ERR_NO_ERROR, 0};
   testee.processDelivery(memento1);
@@ -116,6 +117,30 @@ TEST_F(UpstreamKafkaClientTest, ShouldCheckCallbacksForDeliveries) {
   EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 0);
 }
 
+TEST_F(UpstreamKafkaClientTest, ShouldCheckAllCallbacksForNullPayloads) {
+  // given
+  setupConstructorExpectations();
+  RichKafkaProducer testee = {dispatcher_, thread_factory_, config_, kafka_utils_};
+
+  // when, then - records with null values share the same payload pointer.
+  EXPECT_CALL(producer_, produce("topic", 13, _, _, _, _, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(Return(RdKafka::ERR_NO_ERROR));
+  auto origin1 = std::make_shared<MockProduceFinishCb>();
+  auto origin2 = std::make_shared<MockProduceFinishCb>();
+  const OutboundRecord record = {"topic", 13, absl::string_view(), "key", {}};
+  testee.send(origin1, record);
+  testee.send(origin2, record);
+  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 2);
+
+  // when, then - the confirmation is offered to both until one accepts it.
+  EXPECT_CALL(*origin1, accept(_)).WillRepeatedly(Return(false));
+  EXPECT_CALL(*origin2, accept(_)).WillOnce(Return(true));
+  const DeliveryMemento memento = {nullptr, RdKafka::ERR_NO_ERROR, 0};
+  testee.processDelivery(memento);
+  EXPECT_EQ(testee.getUnfinishedRequestsForTest().size(), 1);
+}
+
 TEST_F(UpstreamKafkaClientTest, ShouldHandleProduceFailures) {
   // given
   setupConstructorExpectations();
@@ -6,6 +6,7 @@
 #include "envoy/server/filter_config.h"
 
 #include "source/common/common/logger.h"
+#include "source/common/protobuf/utility.h"
 
 #include "contrib/envoy/extensions/filters/network/mysql_proxy/v3/mysql_proxy.pb.h"
 #include "contrib/envoy/extensions/filters/network/mysql_proxy/v3/mysql_proxy.pb.validate.h"
@@ -29,7 +30,9 @@ NetworkFilters::MySQLProxy::MySQLConfigFactory::createFilterFactoryFromProtoType
   const std::string stat_prefix = fmt::format("mysql.{}", proto_config.stat_prefix());
 
   MySQLFilterConfigSharedPtr filter_config(
-      std::make_shared<MySQLFilterConfig>(stat_prefix, context.scope()));
+      std::make_shared<MySQLFilterConfig>(stat_prefix, context.scope(),
+                                          PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+                                              proto_config, enable_sql_parsing, true)));
   return [filter_config](Network::FilterManager& filter_manager) -> void {
     filter_manager.addFilter(std::make_shared<MySQLFilter>(filter_config));
   };
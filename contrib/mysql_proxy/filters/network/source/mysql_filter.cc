@@ -16,8 +16,10 @@ namespace Extensions {
 namespace NetworkFilters {
 namespace MySQLProxy {
 
-MySQLFilterConfig::MySQLFilterConfig(const std::string& stat_prefix, Stats::Scope& scope)
-    : scope_(scope), stats_(generateStats(stat_prefix, scope)) {}
+MySQLFilterConfig::MySQLFilterConfig(const std::string& stat_prefix, Stats::Scope& scope,
+                                     bool enable_sql_parsing)
+    : scope_(scope), stats_(generateStats(stat_prefix, scope)),
+      enable_sql_parsing_(enable_sql_parsing) {}
 
 MySQLFilter::MySQLFilter(MySQLFilterConfigSharedPtr config) : config_(std::move(config)) {}
 
@@ -46,12 +48,14 @@ Network::FilterStatus MySQLFilter::onWrite(Buffer::Instance& data, bool) {
 }
 
 void MySQLFilter::doDecode(Buffer::Instance& buffer) {
-  // Clear dynamic metadata.
-  envoy::config::core::v3::Metadata& dynamic_metadata =
-      read_callbacks_->connection().streamInfo().dynamicMetadata();
-  auto& metadata =
-      (*dynamic_metadata.mutable_filter_metadata())[NetworkFilterNames::get().MySQLProxy];
-  metadata.mutable_fields()->clear();
+  // Clear dynamic metadata, which is only produced when parsing SQL.
+  if (config_->enable_sql_parsing_) {
+    envoy::config::core::v3::Metadata& dynamic_metadata =
+        read_callbacks_->connection().streamInfo().dynamicMetadata();
+    auto& metadata =
+        (*dynamic_metadata.mutable_filter_metadata())[NetworkFilterNames::get().MySQLProxy];
+    metadata.mutable_fields()->clear();
+  }
 
   if (!decoder_) {
     decoder_ = createDecoder(*this);
@@ -101,7 +105,7 @@ void MySQLFilter::onMoreClientLoginResponse(ClientLoginResponse& client_login_re
 }
 
 void MySQLFilter::onCommand(Command& command) {
-  if (!command.isQuery()) {
+  if (!command.isQuery() || !config_->enable_sql_parsing_) {
     return;
   }
 
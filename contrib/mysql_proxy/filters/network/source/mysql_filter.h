@@ -49,12 +49,14 @@ struct MySQLProxyStats {
  */
 class MySQLFilterConfig {
 public:
-  MySQLFilterConfig(const std::string& stat_prefix, Stats::Scope& scope);
+  MySQLFilterConfig(const std::string& stat_prefix, Stats::Scope& scope,
+                    bool enable_sql_parsing = true);
 
   const MySQLProxyStats& stats() { return stats_; }
 
   Stats::Scope& scope_;
   MySQLProxyStats stats_;
+  const bool enable_sql_parsing_;
 
 private:
   MySQLProxyStats generateStats(const std::string& prefix, Stats::Scope& scope) {
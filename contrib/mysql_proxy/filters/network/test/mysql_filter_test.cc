@@ -1,4 +1,5 @@
 #include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/filters/network/well_known_names.h"
 
 #include "test/mocks/network/mocks.h"
 
@@ -22,8 +23,8 @@ class MySQLFilterTest : public testing::Test, public MySQLTestUtils {
 public:
   MySQLFilterTest() { ENVOY_LOG_MISC(info, "test"); }
 
-  void initialize() {
-    config_ = std::make_shared<MySQLFilterConfig>(stat_prefix_, scope_);
+  void initialize(bool enable_sql_parsing = true) {
+    config_ = std::make_shared<MySQLFilterConfig>(stat_prefix_, scope_, enable_sql_parsing);
     filter_ = std::make_unique<MySQLFilter>(config_);
     filter_->initializeReadFilterCallbacks(filter_callbacks_);
   }
@@ -920,6 +921,41 @@ TEST_F(MySQLFilterTest, MySqlHandshake320WrongServerRespCode) {
   EXPECT_EQ(MySQLSession::State::NotHandled, filter_->getSession().getState());
 }
 
+// Test that queries are decoded without being parsed when SQL parsing is disabled.
+TEST_F(MySQLFilterTest, MySqlQueryWithoutSqlParsingTest) {
+  initialize(false);
+
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onNewConnection());
+
+  std::string greeting_data = encodeServerGreeting(MYSQL_PROTOCOL_10);
+  Buffer::InstancePtr greet_data(new Buffer::OwnedImpl(greeting_data));
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(*greet_data, false));
+
+  std::string clogin_data = encodeClientLogin(CLIENT_PROTOCOL_41, "user1", CHALLENGE_SEQ_NUM);
+  Buffer::InstancePtr client_login_data(new Buffer::OwnedImpl(clogin_data));
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(*client_login_data, false));
+  EXPECT_EQ(1UL, config_->stats().login_attempts_.value());
+
+  std::string srv_resp_data = encodeClientLoginResp(MYSQL_RESP_OK);
+  Buffer::InstancePtr server_resp_data(new Buffer::OwnedImpl(srv_resp_data));
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(*server_resp_data, false));
+  EXPECT_EQ(MySQLSession::State::Req, filter_->getSession().getState());
+
+  Command mysql_cmd_encode{};
+  mysql_cmd_encode.setCmd(Command::Cmd::Query);
+  mysql_cmd_encode.setData("CREATE DATABASE mysqldb");
+  Buffer::OwnedImpl client_query_data;
+  mysql_cmd_encode.encode(client_query_data);
+  BufferHelper::encodeHdr(client_query_data, 0);
+  EXPECT_EQ(Envoy::Network::FilterStatus::Continue, filter_->onData(client_query_data, false));
+  EXPECT_EQ(MySQLSession::State::ReqResp, filter_->getSession().getState());
+  EXPECT_EQ(0UL, config_->stats().queries_parsed_.value());
+  EXPECT_EQ(0UL, config_->stats().queries_parse_error_.value());
+  EXPECT_FALSE(
+      filter_callbacks_.connection_.stream_info_.dynamicMetadata().filter_metadata().contains(
+          NetworkFilterNames::get().MySQLProxy));
+}
+
 /**
  * Negative Testing
  * Invalid Mysql Pkt Hdr
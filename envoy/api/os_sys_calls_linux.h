@@ -9,6 +9,8 @@
 #include "envoy/api/os_sys_calls_common.h"
 #include "envoy/common/pure.h"
 
+union bpf_attr;
+
 namespace Envoy {
 namespace Api {
 
@@ -20,6 +22,22 @@ public:
    * @see sched_getaffinity (man 2 sched_getaffinity)
    */
   virtual SysCallIntResult sched_getaffinity(pid_t pid, size_t cpusetsize, cpu_set_t* mask) PURE;
+
+  /**
+   * @see pipe2 (man 2 pipe2)
+   */
+  virtual SysCallIntResult pipe2(int pipefd[2], int flags) PURE;
+
+  /**
+   * @see splice (man 2 splice)
+   */
+  virtual SysCallSizeResult splice(int fd_in, off_t* off_in, int fd_out, off_t* off_out,
+                                   size_t len, unsigned int flags) PURE;
+
+  /**
+   * @see bpf (man 2 bpf)
+   */
+  virtual SysCallIntResult bpf(int cmd, union bpf_attr* attr, unsigned int size) PURE;
 };
 
 using LinuxOsSysCallsPtr = std::unique_ptr<LinuxOsSysCalls>;
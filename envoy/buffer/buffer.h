@@ -122,6 +122,11 @@ public:
    */
   virtual void credit(uint64_t amount) PURE;
 
+  /**
+   * @return the largest amount of memory charged to the account at once.
+   */
+  virtual uint64_t peakBalance() const PURE;
+
   /**
    * Clears the associated downstream with this account.
    * After this has been called, calls to reset the downstream become no-ops.
@@ -52,9 +52,12 @@ private:
  * @param user_data is any data attached to an entry submitted to the submission
  * queue.
  * @param result is a return code of submitted system call.
+ * @param flags are the `IORING_CQE_F_*` flags of the completion, always 0 for injected
+ * completions.
  * @param injected indicates whether the completion is injected or not.
  */
-using CompletionCb = std::function<void(Request* user_data, int32_t result, bool injected)>;
+using CompletionCb =
+    std::function<void(Request* user_data, int32_t result, uint32_t flags, bool injected)>;
 
 /**
  * Callback for releasing the user data.
@@ -64,6 +67,42 @@ using InjectedCompletionUserDataReleasor = std::function<void(Request* user_data
 
 enum class IoUringResult { Ok, Busy, Failed };
 
+/**
+ * A ring of equally sized buffers provided to the kernel. Receives submitted with
+ * IoUring::prepareRecvMultishot() pick the buffer for each completion from the ring, and the id of
+ * the picked buffer is carried by the completion flags.
+ *
+ * The ring is bound to the thread of the IoUring it was created from: buffers must be recycled on
+ * that thread.
+ */
+class ProvidedBufferRing {
+public:
+  virtual ~ProvidedBufferRing() = default;
+
+  /**
+   * Returns the buffer group id of the ring.
+   */
+  virtual uint16_t group() const PURE;
+
+  /**
+   * Returns the size of each buffer in the ring.
+   */
+  virtual uint32_t bufferSize() const PURE;
+
+  /**
+   * Returns the memory of a buffer picked by the kernel.
+   */
+  virtual uint8_t* buffer(uint16_t id) PURE;
+
+  /**
+   * Hands a buffer back to the kernel once the data it holds has been consumed. This is a no-op
+   * once the IoUring the ring was created from has been destroyed.
+   */
+  virtual void recycle(uint16_t id) PURE;
+};
+
+using ProvidedBufferRingSharedPtr = std::shared_ptr<ProvidedBufferRing>;
+
 /**
  * Abstract wrapper around `io_uring`.
  */
@@ -110,6 +149,31 @@ public:
                                        const Network::Address::InstanceConstSharedPtr& address,
                                        Request* user_data) PURE;
 
+  /**
+   * Returns true if the kernel supports the given `IORING_OP_*` operation.
+   */
+  virtual bool isOpSupported(uint8_t op) const PURE;
+
+  /**
+   * Creates a ring of buffers for the kernel to pick receive buffers from.
+   * Returns nullptr if the kernel does not support provided buffer rings.
+   * @param group the buffer group id to register the ring with.
+   * @param num_buffers the number of buffers in the ring, must be a power of two.
+   * @param buffer_size the size of each buffer.
+   */
+  virtual ProvidedBufferRingSharedPtr
+  createProvidedBufferRing(uint16_t group, uint32_t num_buffers, uint32_t buffer_size) PURE;
+
+  /**
+   * Prepares a multishot recv operation which picks its buffers from the given buffer group and
+   * puts it into the submission queue. The operation keeps completing with
+   * `IORING_CQE_F_MORE` set until it fails or is cancelled.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareRecvMultishot(os_fd_t fd, uint16_t buffer_group,
+                                             Request* user_data) PURE;
+
   /**
    * Prepares a readv system call and puts it into the submission queue.
    * Returns IoUringResult::Failed in case the submission queue is full already
@@ -126,6 +190,16 @@ public:
   virtual IoUringResult prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                                       off_t offset, Request* user_data) PURE;
 
+  /**
+   * Prepares a zero copy sendmsg operation and puts it into the submission queue. The operation
+   * completes twice: with the result of the send and `IORING_CQE_F_MORE` set, then with
+   * `IORING_CQE_F_NOTIF` set once the kernel does not reference the sent memory anymore.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareSendmsgZeroCopy(os_fd_t fd, const struct msghdr* msg,
+                                               Request* user_data) PURE;
+
   /**
    * Prepares a close system call and puts it into the submission queue.
    * Returns IoUringResult::Failed in case the submission queue is full already
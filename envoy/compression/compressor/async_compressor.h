@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+
+#include "envoy/buffer/buffer.h"
+#include "envoy/common/pure.h"
+#include "envoy/compression/compressor/compressor.h"
+
+#include "absl/functional/any_invocable.h"
+
+namespace Envoy {
+namespace Compression {
+namespace Compressor {
+
+/**
+ * Compressor compressing the chunks of a stream asynchronously, e.g. on a hardware accelerator or
+ * on other threads, so that the thread of its dispatcher goes on with other work meanwhile.
+ */
+class AsyncCompressor {
+public:
+  using Done = absl::AnyInvocable<void(Buffer::InstancePtr compressed)>;
+
+  /**
+   * Destroying the compressor cancels the compression of the pending chunk, if any, whose callback
+   * isn't called.
+   */
+  virtual ~AsyncCompressor() = default;
+
+  /**
+   * Compresses a chunk of the stream. Chunks are compressed one at a time, the next one being
+   * passed once the callback of the previous one is called.
+   * @param data supplies the chunk to compress, which is drained.
+   * @param state supplies whether to flush or finish the compressed stream after the chunk.
+   * @param done supplies the callback called on the dispatcher of the compressor with the
+   *        compressed chunk, never before compress() returns.
+   */
+  virtual void compress(Buffer::Instance& data, State state, Done done) PURE;
+};
+
+using AsyncCompressorPtr = std::unique_ptr<AsyncCompressor>;
+
+} // namespace Compressor
+} // namespace Compression
+} // namespace Envoy
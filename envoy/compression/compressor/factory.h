@@ -1,6 +1,10 @@
 #pragma once
 
+#include "envoy/compression/compressor/async_compressor.h"
 #include "envoy/compression/compressor/compressor.h"
+#include "envoy/event/dispatcher.h"
+
+#include "absl/strings/string_view.h"
 
 namespace Envoy {
 namespace Compression {
@@ -11,8 +15,28 @@ public:
   virtual ~CompressorFactory() = default;
 
   virtual CompressorPtr createCompressor() PURE;
+
+  /**
+   * @return a compressor producing the same encoding with less CPU effort, at the expense of the
+   * compression ratio, used when the CPU is under pressure. By default a regular compressor.
+   */
+  virtual CompressorPtr createLowEffortCompressor() { return createCompressor(); }
+
+  /**
+   * @return a compressor compressing asynchronously, e.g. on a hardware accelerator, on the given
+   * dispatcher, or nullptr if the compressors only compress synchronously, which is the default.
+   */
+  virtual AsyncCompressorPtr createAsyncCompressor(Event::Dispatcher&) { return nullptr; }
   virtual const std::string& statsPrefix() const PURE;
   virtual const std::string& contentEncoding() const PURE;
+
+  /**
+   * @return the SHA-256 hash of the dictionary shared with clients that the compressors compress
+   * with, as a structured field byte sequence, i.e. in the form of the Available-Dictionary request
+   * header of the clients holding it, or an empty string if the compressors don't compress with a
+   * shared dictionary, in which case they're usable for all clients accepting their encoding.
+   */
+  virtual absl::string_view sharedDictionaryHash() const { return {}; }
 };
 
 using CompressorFactoryPtr = std::unique_ptr<CompressorFactory>;
@@ -40,7 +40,8 @@ namespace Event {
  */
 #define ALL_DISPATCHER_STATS(HISTOGRAM)                                                            \
   HISTOGRAM(loop_duration_us, Microseconds)                                                        \
-  HISTOGRAM(poll_delay_us, Microseconds)
+  HISTOGRAM(poll_delay_us, Microseconds)                                                           \
+  HISTOGRAM(tracked_scope_duration_us, Microseconds)
 
 /**
  * Struct definition for all dispatcher stats. @see stats_macros.h
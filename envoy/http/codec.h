@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <limits>
 #include <memory>
@@ -535,6 +536,14 @@ struct Http1Settings {
   // If false, only methods from a hard-coded list of known methods are accepted.
   // Only implemented in BalsaParser. http-parser only accepts known methods.
   bool allow_custom_methods_{false};
+
+  // The most requests in flight on an upstream connection. Requests are pipelined if this is
+  // larger than 1.
+  uint32_t max_requests_in_flight_{1};
+
+  // No request is pipelined behind a request that has been waiting longer than this for its
+  // response.
+  std::chrono::milliseconds pipelining_head_of_line_timeout_{};
 };
 
 /**
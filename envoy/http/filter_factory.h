@@ -75,6 +75,13 @@ public:
    * @param factory factory function used to create filter instances.
    */
   virtual void applyFilterFactoryCb(FilterContext context, FilterFactoryCb& factory) PURE;
+
+  /**
+   * Hints the number of filter factories that are about to be applied, so that the filter chain
+   * manager can reserve memory for the filters up front.
+   * @param size_t supplies the number of filter factories.
+   */
+  virtual void reserveFilters(size_t) {}
 };
 
 /**
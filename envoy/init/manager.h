@@ -1,11 +1,14 @@
 #pragma once
 
+#include <functional>
+
 #include "envoy/admin/v3/init_dump.pb.h"
 #include "envoy/common/pure.h"
 #include "envoy/init/target.h"
 #include "envoy/init/watcher.h"
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
 
 namespace Envoy {
 namespace Init {
@@ -81,6 +84,24 @@ struct Manager {
    * Add unready targets information into the config dump.
    */
   virtual void dumpUnreadyTargets(envoy::admin::v3::UnreadyTargetsDumps& dumps) PURE;
+
+  /**
+   * Events reported to a TargetObserver.
+   */
+  enum class TargetEvent {
+    // The manager started initializing the target.
+    Initializing,
+    // The target signaled that it is ready.
+    Ready,
+  };
+
+  using TargetObserver = std::function<void(absl::string_view target_name, TargetEvent event)>;
+
+  /**
+   * Sets an observer of the initialization of each target, e.g. to measure how long
+   * initialization waits on each target.
+   */
+  virtual void setTargetObserver(TargetObserver observer) PURE;
 };
 
 } // namespace Init
@@ -6,6 +6,7 @@
 #include <string>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/common/optref.h"
 #include "envoy/common/pure.h"
 #include "envoy/common/scope_tracker.h"
 #include "envoy/event/deferred_deletable.h"
@@ -257,6 +258,15 @@ public:
    */
   virtual absl::optional<UnixDomainSocketPeerCredentials> unixSocketPeerCredentials() const PURE;
 
+  /**
+   * @return the I/O handle of the socket backing the connection, or an empty reference if the
+   * connection is not backed by a single kernel socket or if its transport socket does not pass
+   * the payload through unchanged, see TransportSocket::passesRawBytesThrough(). Data read from or
+   * written to the handle directly bypasses the connection's buffers, filters and byte
+   * statistics, so this is only meaningful for callers that have read disabled the connection.
+   */
+  virtual OptRef<IoHandle> socketIoHandle() PURE;
+
   /**
    * Set the stats to update for various connection state changes. Note that for performance reasons
    * these stats are eventually consistent and may not always accurately represent the connection
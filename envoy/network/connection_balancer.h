@@ -66,6 +66,13 @@ public:
    */
   virtual BalancedConnectionHandler&
   pickTargetHandler(BalancedConnectionHandler& current_handler) PURE;
+
+  /**
+   * Called when a connection counted by a handler has been closed, after the handler's connection
+   * count has been decremented.
+   * @param handler supplies the handler the connection was counted by.
+   */
+  virtual void onConnectionClosed(BalancedConnectionHandler& handler) PURE;
 };
 
 using ConnectionBalancerSharedPtr = std::shared_ptr<ConnectionBalancer>;
@@ -397,6 +397,13 @@ public:
    */
   virtual void onDatagramsDropped(uint32_t dropped) PURE;
 
+  /**
+   * Called after each read from the underlying socket, once onData() was called for the datagrams
+   * it received. A read with recvmmsg or GRO can receive several datagrams.
+   * @param datagrams supplies the number of datagrams received by the read.
+   */
+  virtual void onDatagramsRead(uint32_t datagrams) PURE;
+
   /**
    * Called when the underlying socket is ready for read, before onData() is
    * called. Called only once per event loop, even if followed by multiple
@@ -208,6 +208,13 @@ public:
    */
   virtual void configureInitialCongestionWindow(uint64_t bandwidth_bits_per_sec,
                                                 std::chrono::microseconds rtt) PURE;
+
+  /**
+   * @return whether the transport socket passes the payload between the connection and the
+   * underlying socket unchanged and without observing it, so that the payload may be read from and
+   * written to the socket directly, bypassing the transport socket.
+   */
+  virtual bool passesRawBytesThrough() const PURE;
 };
 
 using TransportSocketPtr = std::unique_ptr<TransportSocket>;
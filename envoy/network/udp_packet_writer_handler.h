@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 
@@ -54,6 +55,23 @@ public:
                                               const Address::Ip* local_ip,
                                               const Address::Instance& peer_address) PURE;
 
+  /**
+   * @return true if the writer can have the kernel hold packets until a release time, which
+   * offloads pacing to the kernel, e.g. with SO_TXTIME.
+   */
+  virtual bool supportsReleaseTime() const PURE;
+
+  /**
+   * @brief Like writePacket(), but the packet is not sent before release_time_delay from now.
+   * Only called if supportsReleaseTime() returns true.
+   *
+   * @param release_time_delay is how long after now the packet may be sent.
+   */
+  virtual Api::IoCallUint64Result
+  writePacketWithReleaseTime(const Buffer::Instance& buffer, const Address::Ip* local_ip,
+                             const Address::Instance& peer_address,
+                             std::chrono::microseconds release_time_delay) PURE;
+
   /**
    * @returns true if the network socket is not writable.
    */
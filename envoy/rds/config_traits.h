@@ -59,11 +59,14 @@ public:
    *    table refers to will be validated by the cluster manager. Currently thrift
    *    route config provider manager validates the clusters for static route config
    *    by default but doesn't validate the clusters for TRDS.
+   * @param previous_config supplies the config created for the previous version of the route
+   *    configuration, if any. Implementations may share unchanged parts of it with the new config.
    * @throw EnvoyException if the new config can't be applied of.
    */
   virtual ConfigConstSharedPtr createConfig(const Protobuf::Message& rc,
                                             Server::Configuration::ServerFactoryContext& context,
-                                            bool validate_clusters_default) const PURE;
+                                            bool validate_clusters_default,
+                                            const ConfigConstSharedPtr& previous_config) const PURE;
 };
 
 } // namespace Rds
@@ -89,6 +89,18 @@ public:
    * @return true if deferred creation of stats is enabled.
    */
   virtual bool enableDeferredCreationStats() const PURE;
+
+  /**
+   * @return true if stats flushes only pass the metrics that changed since the previous flush to
+   *         the sinks.
+   */
+  virtual bool enableDeltaStatFlush() const PURE;
+
+  /**
+   * @return std::chrono::milliseconds the minimal time interval between flushes that pass all
+   *         metrics to the sinks if delta stats flushes are enabled.
+   */
+  virtual std::chrono::milliseconds deltaStatFullFlushInterval() const PURE;
 };
 
 /**
@@ -262,6 +262,11 @@ public:
    */
   virtual bool cpusetThreadsEnabled() const PURE;
 
+  /**
+   * @return bool indicating whether worker threads should be pinned to the CPUs of the process.
+   */
+  virtual bool pinWorkerThreadsEnabled() const PURE;
+
   /**
    * @return the names of extensions to disable.
    */
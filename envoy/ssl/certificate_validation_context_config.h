@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -101,6 +102,16 @@ public:
    */
   virtual bool autoSniSanMatch() const PURE;
 
+  /**
+   * @return the most verified certificate chains to remember, or 0 if they are not remembered.
+   */
+  virtual uint32_t verifiedCertificateCacheSize() const PURE;
+
+  /**
+   * @return how long a verified certificate chain is remembered.
+   */
+  virtual std::chrono::milliseconds verifiedCertificateCacheMaxAge() const PURE;
+
   // SECURITY NOTE
   //
   // When adding or changing this interface, it is likely that a change is needed to
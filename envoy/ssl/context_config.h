@@ -117,6 +117,12 @@ public:
    * @return the access log manager object reference
    */
   virtual AccessLog::AccessLogManager& accessLogManager() const PURE;
+
+  /**
+   * @return true if the write direction of established connections should be offloaded to kernel
+   * TLS when possible.
+   */
+  virtual bool kernelTlsTxOffload() const PURE;
 };
 
 class ClientContextConfig : public virtual ContextConfig {
@@ -155,6 +161,13 @@ public:
    * and incompatible with the TLS usage is enabled.
    */
   virtual bool enforceRsaKeyUsage() const PURE;
+
+  /**
+   * @return a hash of the config and the secrets it refers to. Client contexts created from
+   * configs with the same key share their stored session keys. absl::nullopt if the session keys
+   * must not be shared with other contexts.
+   */
+  virtual absl::optional<uint64_t> sessionCacheKey() const PURE;
 };
 
 using ClientContextConfigPtr = std::unique_ptr<ClientContextConfig>;
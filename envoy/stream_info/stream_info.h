@@ -266,6 +266,8 @@ struct LocalCloseReasonValues {
   const std::string TriggeredDelayedCloseTimeout = "triggered_delayed_close_timeout";
   const std::string TcpProxyInitializationFailure = "tcp_initializion_failure:";
   const std::string TcpSessionIdleTimeout = "tcp_session_idle_timeout";
+  const std::string TcpProxySpliceFailed = "tcp_proxy_splice_failed";
+  const std::string TcpProxyDrainClose = "tcp_proxy_drain_close";
   const std::string MaxConnectionDurationReached = "max_connection_duration_reached";
   const std::string ClosingUpstreamTcpDueToDownstreamRemoteClose =
       "closing_upstream_tcp_connection_due_to_downstream_remote_close";
@@ -408,6 +410,8 @@ struct DownstreamTiming {
     ASSERT(!last_downstream_header_rx_byte_received_);
     last_downstream_header_rx_byte_received_ = time_source.monotonicTime();
   }
+  void addCpuTime(std::chrono::nanoseconds cpu_time) { cpu_time_ += cpu_time; }
+  std::chrono::nanoseconds cpuTime() const { return cpu_time_; }
 
   absl::flat_hash_map<std::string, MonotonicTime> timings_;
   // The time when the last byte of the request was received.
@@ -422,6 +426,8 @@ struct DownstreamTiming {
   absl::optional<MonotonicTime> last_downstream_ack_received_;
   // The time when the last header byte was received.
   absl::optional<MonotonicTime> last_downstream_header_rx_byte_received_;
+  // The CPU time spent in the filter chain of the stream, if the connection manager tracks it.
+  std::chrono::nanoseconds cpu_time_{};
 };
 
 // Measure the number of bytes sent and received for a stream.
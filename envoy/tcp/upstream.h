@@ -157,6 +157,12 @@ public:
    * @return the const SSL connection data of upstream.
    */
   virtual Ssl::ConnectionInfoConstSharedPtr getUpstreamConnectionSslInfo() PURE;
+
+  /**
+   * @return the upstream network connection if data encoded on this upstream is written to it
+   *         unmodified, i.e. the upstream is a TCP connection rather than a tunnel over HTTP.
+   */
+  virtual OptRef<Network::Connection> tcpConnection() PURE;
 };
 
 using GenericConnPoolPtr = std::unique_ptr<GenericConnPool>;
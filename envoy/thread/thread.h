@@ -65,6 +65,9 @@ struct Options {
   // If no value is set, the thread will be created with the default thread priority for the
   // platform.
   absl::optional<int> priority_{absl::nullopt};
+  // An optional CPU to pin the thread to. Only supported on Linux, where a failure to set the
+  // affinity of the thread is logged. Ignored on other platforms.
+  absl::optional<uint32_t> cpu_{absl::nullopt};
 };
 
 using OptionsOptConstRef = const absl::optional<Options>&;
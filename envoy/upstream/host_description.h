@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <string>
@@ -107,6 +108,16 @@ public:
   virtual absl::Status onOrcaLoadReport(const OrcaLoadReport& /*report*/) {
     return absl::OkStatus();
   }
+
+  /**
+   * Invoked by the router when a response of this upstream host is complete.
+   * NOTE: this method may be called concurrently from multiple threads.
+   * Please ensure that the implementation is thread-safe.
+   *
+   * @param response_time supplies the time from the end of the downstream request to the end of
+   *        the upstream response.
+   */
+  virtual void onResponseTime(std::chrono::milliseconds /*response_time*/) {}
 };
 
 using HostLbPolicyDataPtr = std::unique_ptr<HostLbPolicyData>;
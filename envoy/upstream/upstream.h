@@ -723,6 +723,8 @@ public:
   COUNTER(upstream_internal_redirect_succeeded_total)                                              \
   COUNTER(upstream_rq_cancelled)                                                                   \
   COUNTER(upstream_rq_completed)                                                                   \
+  COUNTER(upstream_rq_hedge_abandoned)                                                             \
+  COUNTER(upstream_rq_hedge_attempted)                                                             \
   COUNTER(upstream_rq_maintenance_mode)                                                            \
   COUNTER(upstream_rq_max_duration_reached)                                                        \
   COUNTER(upstream_rq_pending_failure_eject)                                                       \
@@ -731,6 +733,7 @@ public:
   COUNTER(upstream_rq_0rtt)                                                                        \
   COUNTER(upstream_rq_per_try_timeout)                                                             \
   COUNTER(upstream_rq_per_try_idle_timeout)                                                        \
+  COUNTER(upstream_rq_pipelined)                                                                   \
   COUNTER(upstream_rq_retry)                                                                       \
   COUNTER(upstream_rq_retry_backoff_exponential)                                                   \
   COUNTER(upstream_rq_retry_backoff_ratelimited)                                                   \
@@ -831,6 +834,8 @@ using DeferredCreationCompatibleClusterTrafficStats =
 MAKE_STAT_NAMES_STRUCT(ClusterLoadReportStatNames, ALL_CLUSTER_LOAD_REPORT_STATS);
 MAKE_STATS_STRUCT(ClusterLoadReportStats, ClusterLoadReportStatNames,
                   ALL_CLUSTER_LOAD_REPORT_STATS);
+using DeferredCreationCompatibleClusterLoadReportStats =
+    Stats::DeferredCreationCompatibleStats<ClusterLoadReportStats>;
 
 // We can't use macros to make the Stats class for circuit breakers due to
 // the conditional inclusion of 'remaining' gauges. But we do auto-generate
@@ -947,6 +952,12 @@ public:
    */
   virtual float peekaheadRatio() const PURE;
 
+  /**
+   * @return optional window over which connection pools remember the peak stream demand to
+   *         preconnect for.
+   */
+  virtual const absl::optional<std::chrono::milliseconds> preconnectPeakDemandWindow() const PURE;
+
   /**
    * @return soft limit on size of the cluster's connections read and write buffers.
    */
@@ -1105,9 +1116,11 @@ public:
   virtual Stats::Scope& statsScope() const PURE;
 
   /**
-   * @return ClusterLoadReportStats& load report stats for this cluster.
+   * @return DeferredCreationCompatibleClusterLoadReportStats& load report stats for this cluster.
+   *         These are only instantiated on first use if deferred stats creation is enabled, and
+   *         isPresent() may be used to skip them otherwise.
    */
-  virtual ClusterLoadReportStats& loadReportStats() const PURE;
+  virtual DeferredCreationCompatibleClusterLoadReportStats& loadReportStats() const PURE;
 
   /**
    * @return absl::optional<std::reference_wrapper<ClusterRequestResponseSizeStats>> stats to track
@@ -74,7 +74,7 @@ void Client::DirectStreamCallbacks::encodeHeaders(const ResponseHeaderMap& heade
   ENVOY_LOG(debug, "[S{}] dispatching to platform response headers for stream (end_stream={}):\n{}",
             direct_stream_.stream_handle_, end_stream, headers);
 
-  auto callback_time_ms = std::make_unique<Stats::HistogramCompletableTimespanImpl>(
+  Stats::HistogramCompletableTimespanImpl callback_time_ms(
       http_client_.stats().on_headers_callback_latency_, http_client_.timeSource());
 
   if (alpn.empty()) {
@@ -86,8 +86,8 @@ void Client::DirectStreamCallbacks::encodeHeaders(const ResponseHeaderMap& heade
     stream_callbacks_.on_headers_(*new_headers, end_stream, streamIntel());
   }
 
-  callback_time_ms->complete();
-  auto elapsed = callback_time_ms->elapsed();
+  callback_time_ms.complete();
+  auto elapsed = callback_time_ms.elapsed();
   if (elapsed > SlowCallbackWarningThreshold) {
     ENVOY_LOG_EVENT(warn, "slow_on_headers_cb", "{}ms", elapsed.count());
   }
@@ -161,7 +161,7 @@ void Client::DirectStreamCallbacks::sendData(Buffer::Instance& data, bool end_st
             "[S{}] dispatching to platform response data for stream (length={} end_stream={})",
             direct_stream_.stream_handle_, bytes_to_send, send_end_stream);
 
-  auto callback_time_ms = std::make_unique<Stats::HistogramCompletableTimespanImpl>(
+  Stats::HistogramCompletableTimespanImpl callback_time_ms(
       http_client_.stats().on_data_callback_latency_, http_client_.timeSource());
 
   // Make sure that when using explicit flow control this won't send more data until the next call
@@ -172,8 +172,8 @@ void Client::DirectStreamCallbacks::sendData(Buffer::Instance& data, bool end_st
   // We can drain the data up to bytes_to_send since we are done with it.
   data.drain(bytes_to_send);
 
-  callback_time_ms->complete();
-  auto elapsed = callback_time_ms->elapsed();
+  callback_time_ms.complete();
+  auto elapsed = callback_time_ms.elapsed();
   if (elapsed > SlowCallbackWarningThreshold) {
     ENVOY_LOG_EVENT(warn, "slow_on_data_cb", "{}ms", elapsed.count());
   }
@@ -209,13 +209,13 @@ void Client::DirectStreamCallbacks::sendTrailers(const ResponseTrailerMap& trail
   ENVOY_LOG(debug, "[S{}] dispatching to platform response trailers for stream:\n{}",
             direct_stream_.stream_handle_, trailers);
 
-  auto callback_time_ms = std::make_unique<Stats::HistogramCompletableTimespanImpl>(
+  Stats::HistogramCompletableTimespanImpl callback_time_ms(
       http_client_.stats().on_trailers_callback_latency_, http_client_.timeSource());
 
   stream_callbacks_.on_trailers_(trailers, streamIntel());
 
-  callback_time_ms->complete();
-  auto elapsed = callback_time_ms->elapsed();
+  callback_time_ms.complete();
+  auto elapsed = callback_time_ms.elapsed();
   if (elapsed > SlowCallbackWarningThreshold) {
     ENVOY_LOG_EVENT(warn, "slow_on_trailers_cb", "{}ms", elapsed.count());
   }
@@ -283,13 +283,13 @@ void Client::DirectStreamCallbacks::onComplete() {
     http_client_.stats().stream_failure_.inc();
   }
 
-  auto callback_time_ms = std::make_unique<Stats::HistogramCompletableTimespanImpl>(
+  Stats::HistogramCompletableTimespanImpl callback_time_ms(
       http_client_.stats().on_complete_callback_latency_, http_client_.timeSource());
 
   stream_callbacks_.on_complete_(streamIntel(), finalStreamIntel());
 
-  callback_time_ms->complete();
-  auto elapsed = callback_time_ms->elapsed();
+  callback_time_ms.complete();
+  auto elapsed = callback_time_ms.elapsed();
   if (elapsed > SlowCallbackWarningThreshold) {
     ENVOY_LOG_EVENT(warn, "slow_on_complete_cb", "{}ms", elapsed.count());
   }
@@ -338,14 +338,14 @@ void Client::DirectStreamCallbacks::sendError() {
             direct_stream_.stream_handle_);
   http_client_.stats().stream_failure_.inc();
 
-  auto callback_time_ms = std::make_unique<Stats::HistogramCompletableTimespanImpl>(
+  Stats::HistogramCompletableTimespanImpl callback_time_ms(
       http_client_.stats().on_error_callback_latency_, http_client_.timeSource());
 
   stream_callbacks_.on_error_(error_.value(), streamIntel(), finalStreamIntel());
   error_.reset();
 
-  callback_time_ms->complete();
-  auto elapsed = callback_time_ms->elapsed();
+  callback_time_ms.complete();
+  auto elapsed = callback_time_ms.elapsed();
   if (elapsed > SlowCallbackWarningThreshold) {
     ENVOY_LOG_EVENT(warn, "slow_on_error_cb", "{}ms", elapsed.count());
   }
@@ -366,13 +366,13 @@ void Client::DirectStreamCallbacks::onCancel() {
   // is already complete.
   direct_stream_.saveFinalStreamIntel();
 
-  auto callback_time_ms = std::make_unique<Stats::HistogramCompletableTimespanImpl>(
+  Stats::HistogramCompletableTimespanImpl callback_time_ms(
       http_client_.stats().on_cancel_callback_latency_, http_client_.timeSource());
 
   stream_callbacks_.on_cancel_(streamIntel(), finalStreamIntel());
 
-  callback_time_ms->complete();
-  auto elapsed = callback_time_ms->elapsed();
+  callback_time_ms.complete();
+  auto elapsed = callback_time_ms.elapsed();
   if (elapsed > SlowCallbackWarningThreshold) {
     ENVOY_LOG_EVENT(warn, "slow_on_cancel_cb", "{}ms", elapsed.count());
   }
@@ -1,5 +1,6 @@
 #include "source/common/access_log/access_log_manager_impl.h"
 
+#include <algorithm>
 #include <string>
 
 #include "envoy/common/exception.h"
@@ -18,6 +19,76 @@ static constexpr Filesystem::FlagSet default_flags{1 << Filesystem::File::Operat
                                                    1 << Filesystem::File::Operation::Append};
 } // namespace
 
+AccessLogFlushThread::~AccessLogFlushThread() {
+  Thread::ThreadPtr thread;
+  {
+    absl::MutexLock lock(&mutex_);
+    // The files hold a reference to the flush thread, so they were all destroyed.
+    ASSERT(queue_.empty());
+    terminate_ = true;
+    thread = std::move(thread_);
+  }
+  if (thread != nullptr) {
+    thread->join();
+  }
+}
+
+void AccessLogFlushThread::schedule(AccessLogFileImpl& file) {
+  absl::MutexLock lock(&mutex_);
+  if (file.flush_queued_) {
+    return;
+  }
+  file.flush_queued_ = true;
+  queue_.push_back(&file);
+  if (thread_ == nullptr) {
+    thread_ = thread_factory_.createThread([this]() -> void { threadRoutine(); },
+                                           Thread::Options{"AccessLogFlush"});
+  }
+}
+
+void AccessLogFlushThread::cancel(AccessLogFileImpl& file) {
+  absl::MutexLock lock(&mutex_);
+  const auto not_flushing = [this, &file]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return flushing_ != &file;
+  };
+  mutex_.Await(absl::Condition(&not_flushing));
+  if (file.flush_queued_) {
+    queue_.erase(std::find(queue_.begin(), queue_.end(), &file));
+    file.flush_queued_ = false;
+  }
+}
+
+void AccessLogFlushThread::threadRoutine() {
+  const auto has_work = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !queue_.empty() || terminate_;
+  };
+  while (true) {
+    AccessLogFileImpl* file;
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(&has_work));
+      if (terminate_) {
+        return;
+      }
+      file = queue_.front();
+      queue_.pop_front();
+      file->flush_queued_ = false;
+      flushing_ = file;
+    }
+
+    const bool more_data = file->flushFromThread();
+
+    absl::MutexLock lock(&mutex_);
+    // A file keeps being flushed as long as data is buffered, so that writers only wake the thread
+    // once enough data is buffered.
+    if (more_data && !file->flush_queued_) {
+      file->flush_queued_ = true;
+      queue_.push_back(file);
+    }
+    flushing_ = nullptr;
+  }
+}
+
 AccessLogManagerImpl::~AccessLogManagerImpl() {
   for (auto& [log_key, log_file_ptr] : access_logs_) {
     ENVOY_LOG(debug, "destroying access logger {}", log_key);
@@ -46,42 +117,45 @@ AccessLogManagerImpl::createAccessLog(const Filesystem::FilePathAndType& file_in
                                                   open_result.err_->getErrorDetails()));
   }
 
+  if (flush_thread_ == nullptr) {
+    flush_thread_ = std::make_shared<AccessLogFlushThread>(api_.threadFactory());
+  }
   access_logs_[file_name] =
       std::make_shared<AccessLogFileImpl>(std::move(file), dispatcher_, lock_, file_stats_,
-                                          file_flush_interval_msec_, api_.threadFactory());
+                                          file_flush_interval_msec_, flush_thread_);
   return access_logs_[file_name];
 }
 
 AccessLogFileImpl::AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                                      Thread::BasicLockable& lock, AccessLogFileStats& stats,
                                      std::chrono::milliseconds flush_interval_msec,
-                                     Thread::ThreadFactory& thread_factory)
-    : file_(std::move(file)), file_lock_(lock),
+                                     AccessLogFlushThreadSharedPtr flush_thread)
+    : file_(std::move(file)), file_lock_(lock), flush_thread_(std::move(flush_thread)),
       flush_timer_(dispatcher.createTimer([this]() -> void {
         stats_.flushed_by_timer_.inc();
-        flush_event_.notifyOne();
+        {
+          Thread::LockGuard lock(write_lock_);
+          if (flush_started_) {
+            flush_thread_->schedule(*this);
+          }
+        }
         flush_timer_->enableTimer(flush_interval_msec_);
       })),
-      thread_factory_(thread_factory), flush_interval_msec_(flush_interval_msec), stats_(stats) {
+      flush_interval_msec_(flush_interval_msec), stats_(stats) {
   flush_timer_->enableTimer(flush_interval_msec_);
 }
 
 void AccessLogFileImpl::reopen() {
   Thread::LockGuard lock(write_lock_);
   reopen_file_ = true;
-  flush_event_.notifyOne();
+  // Before the first write, the file is reopened when it's first flushed.
+  if (flush_started_) {
+    flush_thread_->schedule(*this);
+  }
 }
 
 AccessLogFileImpl::~AccessLogFileImpl() {
-  {
-    Thread::LockGuard lock(write_lock_);
-    flush_thread_exit_ = true;
-    flush_event_.notifyOne();
-  }
-
-  if (flush_thread_ != nullptr) {
-    flush_thread_->join();
-  }
+  flush_thread_->cancel(*this);
 
   // Flush any remaining data. If file was not opened for some reason, skip flushing part.
   if (file_->isOpen()) {
@@ -123,60 +197,50 @@ void AccessLogFileImpl::doWrite(Buffer::Instance& buffer) {
   buffer.drain(buffer.length());
 }
 
-void AccessLogFileImpl::flushThreadFunc() {
-
-  // Transfer the action from `reopen_file_` to this variable so that `reopen_file_` is only
-  // accessed while holding the mutex while the actual operation is performed while not holding the
-  // mutex.
+bool AccessLogFileImpl::flushFromThread() {
+  std::unique_lock<Thread::BasicLockable> flush_lock;
   bool do_reopen = false;
 
-  while (true) {
-    std::unique_lock<Thread::BasicLockable> flush_lock;
-
-    {
-      Thread::LockGuard write_lock(write_lock_);
-
-      // flush_event_ can be woken up either by large enough flush_buffer or by timer.
-      // In case it was timer, flush_buffer_ can be empty.
-      //
-      // Note: do not stop waiting when only `do_reopen` is true. In this case, we tried to
-      // reopen and failed. We don't want to retry this in a tight loop, so wait for the next
-      // event (timer or flush).
-      while (flush_buffer_.length() == 0 && !flush_thread_exit_ && !reopen_file_) {
-        // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
-        flush_event_.wait(write_lock_);
-      }
+  {
+    Thread::LockGuard write_lock(write_lock_);
 
-      if (flush_thread_exit_) {
-        return;
-      }
+    // The file can be queued by the timer with nothing buffered, or for a reopen. Note that a
+    // failed reopen is only retried on the next flush rather than right away, so that it isn't
+    // retried in a tight loop.
+    if (flush_buffer_.length() == 0 && !reopen_file_) {
+      return false;
+    }
 
-      flush_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
-      about_to_write_buffer_.move(flush_buffer_);
-      ASSERT(flush_buffer_.length() == 0);
+    flush_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
+    about_to_write_buffer_.move(flush_buffer_);
+    ASSERT(flush_buffer_.length() == 0);
 
-      if (reopen_file_) {
-        do_reopen = true;
-        reopen_file_ = false;
-      }
+    if (reopen_file_) {
+      reopen_pending_ = true;
+      reopen_file_ = false;
     }
+    do_reopen = reopen_pending_;
+  }
 
-    if (do_reopen) {
-      if (file_->isOpen()) {
-        const Api::IoCallBoolResult result = file_->close();
-        ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
-                                                 result.err_->getErrorDetails()));
-      }
-      const Api::IoCallBoolResult open_result = file_->open(default_flags);
-      if (!open_result.return_value_) {
-        stats_.reopen_failed_.inc();
-      } else {
-        do_reopen = false;
-      }
+  if (do_reopen) {
+    if (file_->isOpen()) {
+      const Api::IoCallBoolResult result = file_->close();
+      ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
+                                               result.err_->getErrorDetails()));
+    }
+    const Api::IoCallBoolResult open_result = file_->open(default_flags);
+    if (!open_result.return_value_) {
+      stats_.reopen_failed_.inc();
+    } else {
+      reopen_pending_ = false;
     }
-    // doWrite no matter file isOpen, if not, we can drain buffer
-    doWrite(about_to_write_buffer_);
   }
+  // doWrite no matter file isOpen, if not, we can drain buffer
+  doWrite(about_to_write_buffer_);
+  flush_lock.unlock();
+
+  Thread::LockGuard write_lock(write_lock_);
+  return flush_buffer_.length() > 0 || reopen_file_;
 }
 
 void AccessLogFileImpl::flush() {
@@ -206,22 +270,14 @@ void AccessLogFileImpl::flush() {
 void AccessLogFileImpl::write(absl::string_view data) {
   Thread::LockGuard lock(write_lock_);
 
-  if (flush_thread_ == nullptr) {
-    createFlushStructures();
-  }
-
   stats_.write_buffered_.inc();
   stats_.write_total_buffered_.add(data.length());
   flush_buffer_.add(data.data(), data.size());
-  if (flush_buffer_.length() > MIN_FLUSH_SIZE) {
-    flush_event_.notifyOne();
+  if (!flush_started_ || flush_buffer_.length() > MIN_FLUSH_SIZE) {
+    flush_started_ = true;
+    flush_thread_->schedule(*this);
   }
 }
 
-void AccessLogFileImpl::createFlushStructures() {
-  flush_thread_ = thread_factory_.createThread([this]() -> void { flushThreadFunc(); },
-                                               Thread::Options{"AccessLogFlush"});
-}
-
 } // namespace AccessLog
 } // namespace Envoy
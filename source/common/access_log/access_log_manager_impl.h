@@ -1,5 +1,7 @@
 #pragma once
 
+#include <deque>
+#include <memory>
 #include <string>
 
 #include "envoy/access_log/access_log.h"
@@ -14,6 +16,7 @@
 #include "source/common/common/thread.h"
 
 #include "absl/container/node_hash_map.h"
+#include "absl/synchronization/mutex.h"
 
 namespace Envoy {
 
@@ -31,6 +34,47 @@ struct AccessLogFileStats {
 
 namespace AccessLog {
 
+class AccessLogFileImpl;
+
+/**
+ * A single thread flushing all the access log files of a process, so that the number of threads
+ * doesn't grow with the number of files, most of which are idle most of the time. The files are
+ * queued to be flushed when they have enough data buffered, when their flush timer fires or when
+ * they need to be reopened, and the thread flushes them in order. The thread is started the first
+ * time a file is queued.
+ */
+class AccessLogFlushThread {
+public:
+  explicit AccessLogFlushThread(Thread::ThreadFactory& thread_factory)
+      : thread_factory_(thread_factory) {}
+  ~AccessLogFlushThread();
+
+  /**
+   * Queues the file to be flushed, if it isn't queued already.
+   */
+  void schedule(AccessLogFileImpl& file);
+
+  /**
+   * Removes the file from the queue, waiting for an ongoing flush of the file to complete. This
+   * must be called before the file is destroyed.
+   */
+  void cancel(AccessLogFileImpl& file);
+
+private:
+  void threadRoutine();
+
+  Thread::ThreadFactory& thread_factory_;
+  absl::Mutex mutex_;
+  std::deque<AccessLogFileImpl*> queue_ ABSL_GUARDED_BY(mutex_);
+  // The file being flushed by the thread, if any, which it requeues if more data was buffered in
+  // the meantime.
+  AccessLogFileImpl* flushing_ ABSL_GUARDED_BY(mutex_){};
+  bool terminate_ ABSL_GUARDED_BY(mutex_){false};
+  Thread::ThreadPtr thread_ ABSL_GUARDED_BY(mutex_);
+};
+
+using AccessLogFlushThreadSharedPtr = std::shared_ptr<AccessLogFlushThread>;
+
 class AccessLogManagerImpl : public AccessLogManager, Logger::Loggable<Logger::Id::main> {
 public:
   AccessLogManagerImpl(std::chrono::milliseconds file_flush_interval_msec, Api::Api& api,
@@ -53,22 +97,23 @@ private:
   Event::Dispatcher& dispatcher_;
   Thread::BasicLockable& lock_;
   AccessLogFileStats file_stats_;
+  // Shared with the files, which may outlive the manager.
+  AccessLogFlushThreadSharedPtr flush_thread_;
   absl::node_hash_map<std::string, AccessLogFileSharedPtr> access_logs_;
 };
 
 /**
  * This is a file implementation geared for writing out access logs. It turn out that in certain
  * cases even if a standard file is opened with O_NONBLOCK, the kernel can still block when writing.
- * This implementation uses a flush thread per file, with the idea there aren't that many
- * files. If this turns out to be a good implementation we can potentially have a single flush
- * thread that flushes all files, but we will start with this.
+ * This implementation buffers the writes, which are written to disk by the flush thread shared by
+ * all the files of the access log manager.
  */
 class AccessLogFileImpl : public AccessLogFile {
 public:
   AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                     Thread::BasicLockable& lock, AccessLogFileStats& stats,
                     std::chrono::milliseconds flush_interval_msec,
-                    Thread::ThreadFactory& thread_factory);
+                    AccessLogFlushThreadSharedPtr flush_thread);
   ~AccessLogFileImpl() override;
 
   // AccessLog::AccessLogFile
@@ -83,9 +128,12 @@ public:
   void flush() override;
 
 private:
+  friend class AccessLogFlushThread;
+
   void doWrite(Buffer::Instance& buffer);
-  void flushThreadFunc();
-  void createFlushStructures();
+  // Called by the flush thread to write the buffered data and reopen the file if needed. Returns
+  // whether more data was buffered in the meantime.
+  bool flushFromThread();
 
   // Minimum size before the flush thread will be told to flush.
   static const uint64_t MIN_FLUSH_SIZE = 1024 * 64;
@@ -96,6 +144,7 @@ private:
   //    1) write_lock_
   //    2) flush_lock_
   //    3) file_lock_
+  // The flush thread's lock is acquired while holding write_lock_, but never the other way around.
   Thread::BasicLockable& file_lock_;      // This lock is used only by the flush thread when writing
                                           // to disk. This is used to make sure that file blocks do
                                           // not get interleaved by multiple processes writing to
@@ -109,10 +158,15 @@ private:
       write_lock_; // The lock is used when filling the flush buffer. It allows
                    // multiple threads to write to the same file at relatively
                    // high performance. It is always local to the process.
-  Thread::ThreadPtr flush_thread_;
-  Thread::CondVar flush_event_;
-  bool flush_thread_exit_ ABSL_GUARDED_BY(write_lock_){false};
+  const AccessLogFlushThreadSharedPtr flush_thread_;
+  // Whether the file was ever queued to be flushed. The first write is flushed right away.
+  bool flush_started_ ABSL_GUARDED_BY(write_lock_){false};
   bool reopen_file_ ABSL_GUARDED_BY(write_lock_){false};
+  // Whether a reopen failed, in which case it's retried on the next flush. Only used by the flush
+  // thread.
+  bool reopen_pending_{false};
+  // Whether the file is in the queue of the flush thread, guarded by the lock of the flush thread.
+  bool flush_queued_{false};
   Buffer::OwnedImpl
       flush_buffer_ ABSL_GUARDED_BY(write_lock_); // This buffer is used by multiple threads. It
                                                   // gets filled and then flushed either when max
@@ -126,7 +180,6 @@ private:
                                             // continue to fill. This buffer is then used for the
                                             // final write to disk.
   Event::TimerPtr flush_timer_;
-  Thread::ThreadFactory& thread_factory_;
   const std::chrono::milliseconds flush_interval_msec_; // Time interval buffer gets flushed no
                                                         // matter if it reached the MIN_FLUSH_SIZE
                                                         // or not.
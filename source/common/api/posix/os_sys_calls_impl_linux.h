@@ -15,6 +15,10 @@ class LinuxOsSysCallsImpl : public LinuxOsSysCalls {
 public:
   // Api::LinuxOsSysCalls
   SysCallIntResult sched_getaffinity(pid_t pid, size_t cpusetsize, cpu_set_t* mask) override;
+  SysCallIntResult pipe2(int pipefd[2], int flags) override;
+  SysCallSizeResult splice(int fd_in, off_t* off_in, int fd_out, off_t* off_out, size_t len,
+                           unsigned int flags) override;
+  SysCallIntResult bpf(int cmd, union bpf_attr* attr, unsigned int size) override;
 };
 
 using LinuxOsSysCallsSingleton = ThreadSafeSingleton<LinuxOsSysCallsImpl>;
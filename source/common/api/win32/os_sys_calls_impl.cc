@@ -153,6 +153,11 @@ SysCallSizeResult OsSysCallsImpl::pwrite(os_fd_t fd, const void* buffer, size_t
   PANIC("not implemented");
 }
 
+SysCallSizeResult OsSysCallsImpl::pwritev(os_fd_t fd, const iovec* iov, int num_iov,
+                                          off_t offset) const {
+  PANIC("not implemented");
+}
+
 SysCallSizeResult OsSysCallsImpl::pread(os_fd_t fd, void* buffer, size_t length,
                                         off_t offset) const {
   PANIC("not implemented");
@@ -1,5 +1,6 @@
 #include "source/common/buffer/buffer_impl.h"
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -17,11 +18,125 @@ namespace {
 // TODO(yanavlasov): This may not be optimal for all hardware configurations or traffic patterns and
 // may need to be configurable in the future.
 constexpr uint64_t CopyThreshold = 512;
+
+std::atomic<bool> slice_storage_pool_enabled{true};
+// Bumped by SliceStoragePool::releaseAll(). Each thread compares it against the generation it last
+// observed and drops its cached storage when they differ.
+std::atomic<uint64_t> slice_storage_pool_release_generation{0};
+
+// The pool state is trivially destructible so that it can be used safely by slices that are
+// destroyed during thread or process teardown. The cached storage itself is freed by
+// SliceStoragePoolCleanup below.
+struct SliceStoragePoolState {
+  uint8_t* entries_[SliceStoragePool::NumSizeClasses][SliceStoragePool::MaxEntriesPerSizeClass];
+  uint32_t sizes_[SliceStoragePool::NumSizeClasses];
+  uint64_t release_generation_;
+  bool cleanup_registered_;
+  bool shut_down_;
+  SliceStoragePool::Stats stats_;
+};
+
+thread_local SliceStoragePoolState slice_storage_pool_state{};
+
+void drainSliceStoragePool(SliceStoragePoolState& state) {
+  for (uint32_t size_class = 0; size_class < SliceStoragePool::NumSizeClasses; ++size_class) {
+    for (uint32_t i = 0; i < state.sizes_[size_class]; ++i) {
+      delete[] state.entries_[size_class][i];
+    }
+    state.sizes_[size_class] = 0;
+  }
+  state.stats_.retained_bytes_ = 0;
+}
+
+struct SliceStoragePoolCleanup {
+  bool registered_{};
+
+  ~SliceStoragePoolCleanup() {
+    drainSliceStoragePool(slice_storage_pool_state);
+    slice_storage_pool_state.shut_down_ = true;
+  }
+};
+
+thread_local SliceStoragePoolCleanup slice_storage_pool_cleanup;
+
+// Returns the size class index for the given capacity, or NumSizeClasses if the capacity is not
+// cacheable.
+uint32_t sliceStorageSizeClass(uint64_t capacity) {
+  if (capacity == 0 || capacity > SliceStoragePool::MaxCachedSize ||
+      capacity % SliceStoragePool::PageSize != 0) {
+    return SliceStoragePool::NumSizeClasses;
+  }
+  return capacity / SliceStoragePool::PageSize - 1;
+}
+
+// Returns the calling thread's pool, or nullptr if pooling is disabled or the thread is exiting.
+SliceStoragePoolState* activeSliceStoragePool() {
+  if (!slice_storage_pool_enabled.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  SliceStoragePoolState& state = slice_storage_pool_state;
+  if (state.shut_down_) {
+    return nullptr;
+  }
+  const uint64_t generation =
+      slice_storage_pool_release_generation.load(std::memory_order_relaxed);
+  if (state.release_generation_ != generation) {
+    drainSliceStoragePool(state);
+    state.release_generation_ = generation;
+  }
+  return &state;
+}
+
 } // namespace
 
-thread_local absl::InlinedVector<Slice::StoragePtr,
-                                 OwnedImpl::OwnedImplReservationSlicesOwnerMultiple::free_list_max_>
-    OwnedImpl::OwnedImplReservationSlicesOwnerMultiple::free_list_;
+SliceStoragePool::StoragePtr SliceStoragePool::acquire(uint64_t capacity) {
+  const uint32_t size_class = sliceStorageSizeClass(capacity);
+  if (size_class < NumSizeClasses) {
+    if (SliceStoragePoolState* state = activeSliceStoragePool(); state != nullptr) {
+      if (state->sizes_[size_class] > 0) {
+        ++state->stats_.hits_;
+        state->stats_.retained_bytes_ -= capacity;
+        return StoragePtr{state->entries_[size_class][--state->sizes_[size_class]]};
+      }
+      ++state->stats_.misses_;
+    }
+  }
+  return StoragePtr{new uint8_t[capacity]};
+}
+
+void SliceStoragePool::release(StoragePtr storage, uint64_t capacity) {
+  if (storage == nullptr) {
+    return;
+  }
+  const uint32_t size_class = sliceStorageSizeClass(capacity);
+  if (size_class >= NumSizeClasses) {
+    return;
+  }
+  SliceStoragePoolState* state = activeSliceStoragePool();
+  if (state == nullptr || state->sizes_[size_class] >= MaxEntriesPerSizeClass) {
+    return;
+  }
+  if (!state->cleanup_registered_) {
+    // Make sure the retained storage is freed when this thread exits.
+    slice_storage_pool_cleanup.registered_ = true;
+    state->cleanup_registered_ = true;
+  }
+  state->entries_[size_class][state->sizes_[size_class]++] = storage.release();
+  state->stats_.retained_bytes_ += capacity;
+}
+
+const SliceStoragePool::Stats& SliceStoragePool::stats() { return slice_storage_pool_state.stats_; }
+
+void SliceStoragePool::releaseThreadLocal() { drainSliceStoragePool(slice_storage_pool_state); }
+
+void SliceStoragePool::releaseAll() {
+  slice_storage_pool_release_generation.fetch_add(1, std::memory_order_relaxed);
+  releaseThreadLocal();
+}
+
+void SliceStoragePool::setEnabled(bool enabled) {
+  slice_storage_pool_enabled.store(enabled, std::memory_order_relaxed);
+}
 
 void OwnedImpl::addImpl(const void* data, uint64_t size) {
   const char* src = static_cast<const char*>(data);
@@ -19,6 +19,72 @@
 namespace Envoy {
 namespace Buffer {
 
+/**
+ * A per-thread cache of slice backing storage, bucketed by size class. Mutable slices that own
+ * their storage are almost always created and destroyed on the same worker thread, so keeping a
+ * small number of recently released blocks per thread lets new slices skip the global allocator
+ * without any locking. Only page-multiple sizes up to the default slice size are cached; larger
+ * blocks always go back to the allocator.
+ */
+class SliceStoragePool {
+public:
+  using StoragePtr = std::unique_ptr<uint8_t[]>;
+
+  static constexpr uint64_t PageSize = 4096;
+  static constexpr uint32_t NumSizeClasses = 4;
+  static constexpr uint64_t MaxCachedSize = PageSize * NumSizeClasses;
+  static constexpr uint32_t MaxEntriesPerSizeClass = 8;
+
+  /**
+   * Per-thread pool counters.
+   */
+  struct Stats {
+    // Number of allocations of a cacheable size that were served from the pool.
+    uint64_t hits_{};
+    // Number of allocations of a cacheable size that fell through to the allocator.
+    uint64_t misses_{};
+    // Number of bytes currently held by the pool of the calling thread.
+    uint64_t retained_bytes_{};
+  };
+
+  /**
+   * Obtain a block of storage from the calling thread's pool or from the allocator.
+   * @param capacity the size of the block. Must be a multiple of the page size.
+   * @return the storage block.
+   */
+  static StoragePtr acquire(uint64_t capacity);
+
+  /**
+   * Return a block of storage to the calling thread's pool. The block is freed if it is not of a
+   * cacheable size or the corresponding size class is full.
+   * @param storage the storage block; may be null.
+   * @param capacity the size of the block, as passed to acquire().
+   */
+  static void release(StoragePtr storage, uint64_t capacity);
+
+  /**
+   * @return the counters of the calling thread's pool.
+   */
+  static const Stats& stats();
+
+  /**
+   * Free all storage retained by the calling thread's pool.
+   */
+  static void releaseThreadLocal();
+
+  /**
+   * Ask every thread to free the storage retained by its pool. This is safe to call from any
+   * thread; each pool drops its cached blocks the next time it is used.
+   */
+  static void releaseAll();
+
+  /**
+   * Enable or disable pooling process-wide. When disabled, all storage is allocated from and
+   * returned to the allocator directly. Intended for benchmarks and tests.
+   */
+  static void setEnabled(bool enabled);
+};
+
 /**
  * A Slice manages a contiguous block of bytes.
  * The block is arranged like this:
@@ -57,7 +123,7 @@ public:
    * @param account the account to charge.
    */
   Slice(uint64_t min_capacity, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(sliceSize(min_capacity)), storage_(new uint8_t[capacity_]),
+      : capacity_(sliceSize(min_capacity)), storage_(SliceStoragePool::acquire(capacity_)),
         base_(storage_.get()) {
     if (account) {
       account->charge(capacity_);
@@ -114,6 +180,7 @@ public:
   Slice& operator=(Slice&& rhs) noexcept {
     if (this != &rhs) {
       callAndClearDrainTrackersAndCharges();
+      SliceStoragePool::release(std::move(storage_), capacity_);
 
       capacity_ = rhs.capacity_;
       storage_ = std::move(rhs.storage_);
@@ -139,6 +206,7 @@ public:
 
   ~Slice() {
     callAndClearDrainTrackersAndCharges();
+    SliceStoragePool::release(std::move(storage_), capacity_);
     if (releasor_) {
       releasor_();
     }
@@ -385,7 +453,7 @@ public:
    */
   static inline SizedStorage newStorage(uint64_t min_capacity) {
     const uint64_t slice_size = sliceSize(min_capacity);
-    return {StoragePtr{new uint8_t[slice_size]}, static_cast<size_t>(slice_size)};
+    return {SliceStoragePool::acquire(slice_size), static_cast<size_t>(slice_size)};
   }
 
 protected:
@@ -783,32 +851,18 @@ private:
 
   struct OwnedImplReservationSlicesOwnerMultiple : public OwnedImplReservationSlicesOwner {
   public:
-    static constexpr uint32_t free_list_max_ = Buffer::Reservation::MAX_SLICES_;
-
-    OwnedImplReservationSlicesOwnerMultiple() : free_list_ref_(free_list_) {}
     ~OwnedImplReservationSlicesOwnerMultiple() override {
       for (auto r = owned_storages_.rbegin(); r != owned_storages_.rend(); r++) {
         if (r->mem_ != nullptr) {
           ASSERT(r->len_ == Slice::default_slice_size_);
-          if (free_list_ref_.size() < free_list_max_) {
-            free_list_ref_.push_back(std::move(r->mem_));
-          }
+          SliceStoragePool::release(std::move(r->mem_), r->len_);
         }
       }
     }
 
     Slice::SizedStorage newStorage() {
       ASSERT(Slice::sliceSize(Slice::default_slice_size_) == Slice::default_slice_size_);
-
-      Slice::SizedStorage storage{nullptr, Slice::default_slice_size_};
-      if (!free_list_ref_.empty()) {
-        storage.mem_ = std::move(free_list_ref_.back());
-        free_list_ref_.pop_back();
-      } else {
-        storage.mem_.reset(new uint8_t[Slice::default_slice_size_]);
-      }
-
-      return storage;
+      return {SliceStoragePool::acquire(Slice::default_slice_size_), Slice::default_slice_size_};
     }
 
     absl::Span<Slice::SizedStorage> ownedStorages() override {
@@ -816,19 +870,13 @@ private:
     }
 
     absl::InlinedVector<Slice::SizedStorage, Buffer::Reservation::MAX_SLICES_> owned_storages_;
-
-  private:
-    // Thread local resolving introduces additional overhead. Initialize this reference once when
-    // constructing the owner to reduce thread local resolving to improve performance.
-    absl::InlinedVector<Slice::StoragePtr, free_list_max_>& free_list_ref_;
-
-    // Simple thread local cache to reduce unnecessary memory allocation and release. This cache
-    // is currently only used for multiple slices reservation because of the additional overhead
-    // that thread local resolving would introduce.
-    static thread_local absl::InlinedVector<Slice::StoragePtr, free_list_max_> free_list_;
   };
 
   struct OwnedImplReservationSlicesOwnerSingle : public OwnedImplReservationSlicesOwner {
+    ~OwnedImplReservationSlicesOwnerSingle() override {
+      SliceStoragePool::release(std::move(owned_storage_.mem_), owned_storage_.len_);
+    }
+
     absl::Span<Slice::SizedStorage> ownedStorages() override {
       return absl::MakeSpan(&owned_storage_, 1);
     }
@@ -1,5 +1,6 @@
 #include "source/common/buffer/watermark_buffer.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 
@@ -294,6 +295,7 @@ void BufferMemoryAccountImpl::charge(uint64_t amount) {
   // Check overflow
   ASSERT(std::numeric_limits<uint64_t>::max() - buffer_memory_allocated_ >= amount);
   buffer_memory_allocated_ += amount;
+  peak_buffer_memory_allocated_ = std::max(peak_buffer_memory_allocated_, buffer_memory_allocated_);
   updateAccountClass();
 }
 
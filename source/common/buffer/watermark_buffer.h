@@ -114,6 +114,7 @@ public:
   uint64_t balance() const { return buffer_memory_allocated_; }
   void charge(uint64_t amount) override;
   void credit(uint64_t amount) override;
+  uint64_t peakBalance() const override { return peak_buffer_memory_allocated_; }
 
   // Clear the associated downstream, preparing the account to be destroyed.
   // This is idempotent.
@@ -141,6 +142,7 @@ private:
   void updateAccountClass();
 
   uint64_t buffer_memory_allocated_ = 0;
+  uint64_t peak_buffer_memory_allocated_ = 0;
   // Current bucket index where the account is being tracked in.
   absl::optional<uint32_t> current_bucket_idx_{};
 
@@ -44,7 +44,11 @@ bool checkForTtl(absl::string_view& contents) {
 KeyValueStoreBase::KeyValueStoreBase(Event::Dispatcher& dispatcher,
                                      std::chrono::milliseconds flush_interval, uint32_t max_entries)
     : max_entries_(max_entries), flush_timer_(dispatcher.createTimer([this, flush_interval]() {
-        flush();
+        // Rewriting an unchanged store is skipped, as it may be large.
+        if (dirty_) {
+          dirty_ = false;
+          flush();
+        }
         flush_timer_->enableTimer(flush_interval);
       })),
       ttl_manager_([this](const std::vector<std::string>& expired) { onExpiredKeys(expired); },
@@ -123,9 +127,7 @@ void KeyValueStoreBase::addOrUpdate(absl::string_view key_view, absl::string_vie
     store_.pop_front();
   }
 
-  if (!flush_timer_->enabled()) {
-    flush();
-  }
+  onChange();
 }
 
 void KeyValueStoreBase::onExpiredKeys(const std::vector<std::string>& keys) {
@@ -133,16 +135,20 @@ void KeyValueStoreBase::onExpiredKeys(const std::vector<std::string>& keys) {
   for (const auto& key : keys) {
     store_.erase(std::string(key));
   }
-  if (!flush_timer_->enabled()) {
-    flush();
-  }
+  onChange();
 }
 
 void KeyValueStoreBase::remove(absl::string_view key) {
   ENVOY_BUG(!under_iterate_, "remove under the stack of iterate");
   ttl_manager_.clear(std::string(key));
   store_.erase(std::string(key));
-  if (!flush_timer_->enabled()) {
+  onChange();
+}
+
+void KeyValueStoreBase::onChange() {
+  if (flush_timer_->enabled()) {
+    dirty_ = true;
+  } else {
     flush();
   }
 }
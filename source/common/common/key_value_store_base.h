@@ -52,10 +52,15 @@ protected:
   const KeyValueMap& store() { return store_; }
 
 private:
+  // Flushes the store now if there is no flush interval, or on the next flush otherwise.
+  void onChange();
+
   const uint32_t max_entries_;
   const Event::TimerPtr flush_timer_;
   Config::TtlManager ttl_manager_;
   KeyValueMap store_;
+  // Whether the store changed since the last periodic flush.
+  bool dirty_{};
   // Used for validation only.
   mutable bool under_iterate_{};
   TimeSource& time_source_;
@@ -77,23 +77,73 @@ void StderrSinkDelegate::flush() {
   std::cerr << std::flush;
 }
 
+namespace {
+
+// Generations of the formatters of all the sinks, so that a thread never mistakes the formatter of
+// one sink for that of another.
+std::atomic<uint64_t> next_formatter_generation{1};
+
+thread_local bool thread_formatter_destroyed = false;
+
+struct ThreadFormatter {
+  ~ThreadFormatter() { thread_formatter_destroyed = true; }
+
+  uint64_t generation_{0};
+  std::unique_ptr<spdlog::formatter> formatter_;
+};
+
+// Returns nullptr while the thread exits, as the formatter may be gone before the last log lines.
+ThreadFormatter* threadFormatter() {
+  if (thread_formatter_destroyed) {
+    return nullptr;
+  }
+  static thread_local ThreadFormatter thread_formatter;
+  return &thread_formatter;
+}
+
+} // namespace
+
 void DelegatingLogSink::set_formatter(std::unique_ptr<spdlog::formatter> formatter) {
   absl::MutexLock lock(&format_mutex_);
   formatter_ = std::move(formatter);
+  formatter_generation_ = next_formatter_generation++;
+}
+
+bool DelegatingLogSink::format(const spdlog::details::log_msg& msg,
+                               spdlog::memory_buf_t& formatted) {
+  ThreadFormatter* thread_formatter = threadFormatter();
+  if (thread_formatter == nullptr) {
+    absl::MutexLock lock(&format_mutex_);
+    if (formatter_ == nullptr) {
+      return false;
+    }
+    formatter_->format(msg, formatted);
+    return true;
+  }
+
+  // Format with the clone of the calling thread, so that threads logging at the same time don't
+  // wait for each other. The lock is only taken to clone the formatter after it is set.
+  if (thread_formatter->generation_ != formatter_generation_) {
+    absl::MutexLock lock(&format_mutex_);
+    thread_formatter->formatter_ = formatter_ != nullptr ? formatter_->clone() : nullptr;
+    thread_formatter->generation_ = formatter_generation_;
+  }
+  if (thread_formatter->formatter_ == nullptr) {
+    return false;
+  }
+  thread_formatter->formatter_->format(msg, formatted);
+  return true;
 }
 
 void DelegatingLogSink::log(const spdlog::details::log_msg& msg) {
-  absl::ReleasableMutexLock lock(&format_mutex_);
   absl::string_view msg_view = absl::string_view(msg.payload.data(), msg.payload.size());
 
   // This memory buffer must exist in the scope of the entire function,
   // otherwise the string_view will refer to memory that is already free.
   spdlog::memory_buf_t formatted;
-  if (formatter_) {
-    formatter_->format(msg, formatted);
+  if (format(msg, formatted)) {
     msg_view = absl::string_view(formatted.data(), formatted.size());
   }
-  lock.Release();
 
   auto log_to_sink = [this, msg_view, msg](SinkDelegate& sink) {
     if (should_escape_) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <bitset>
 #include <chrono>
 #include <cstdint>
@@ -262,12 +263,17 @@ private:
   }
   SinkDelegate** tlsSink();
   void setTlsDelegate(SinkDelegate* sink);
+  // Formats `msg` into `formatted` if there is a formatter, and returns whether it did.
+  bool format(const spdlog::details::log_msg& msg, spdlog::memory_buf_t& formatted);
   SinkDelegate* tlsDelegate();
 
   SinkDelegate* sink_ ABSL_GUARDED_BY(sink_mutex_){nullptr};
   absl::Mutex sink_mutex_;
   std::unique_ptr<StderrSinkDelegate> stderr_sink_; // Builtin sink to use as a last resort.
+  // Formatters are not thread safe, so each thread formats with its own clone of formatter_. The
+  // generation changes whenever formatter_ is set, for the threads to clone it again.
   std::unique_ptr<spdlog::formatter> formatter_ ABSL_GUARDED_BY(format_mutex_);
+  std::atomic<uint64_t> formatter_generation_{0};
   absl::Mutex format_mutex_;
   bool should_escape_{false};
 };
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+
+/**
+ * Storage for the nodes of a node based container, e.g. std::list, owned by the container. Nodes
+ * are carved out of blocks that double in size up to MaxBlockNodes, and freed nodes are kept on a
+ * free list for reuse. Blocks are only released when the pool is destroyed, so a container that
+ * holds N nodes makes O(log N) allocations instead of N, and frees them all at once.
+ *
+ * All nodes of a pool have the same size, which is fixed by the first allocation. Allocations of
+ * any other size are not served by the pool, see NodePoolAllocator.
+ */
+class NodePool : NonCopyable {
+public:
+  static constexpr uint32_t MaxBlockNodes = 32;
+
+  NodePool() = default;
+  ~NodePool() {
+    while (blocks_ != nullptr) {
+      Block* block = blocks_;
+      blocks_ = block->previous_;
+      delete[] reinterpret_cast<char*>(block);
+    }
+  }
+
+  /**
+   * @return storage for a node of the given size and alignment, or nullptr if the pool does not
+   *         serve nodes of that size.
+   */
+  void* allocate(size_t size, size_t alignment) {
+    if (!serves(size, alignment)) {
+      return nullptr;
+    }
+    if (free_list_ != nullptr) {
+      FreeNode* node = free_list_;
+      free_list_ = node->next_;
+      return node;
+    }
+    if (next_ == end_) {
+      addBlock();
+    }
+    void* node = next_;
+    next_ += node_size_;
+    return node;
+  }
+
+  /**
+   * Return a node obtained from allocate() to the pool.
+   */
+  void deallocate(void* node) {
+    ASSERT(node != nullptr);
+    free_list_ = new (node) FreeNode{free_list_};
+  }
+
+  /**
+   * @return whether nodes of the given size and alignment are served by the pool. The first call
+   *         with a size and alignment the pool can serve fixes the node size.
+   */
+  bool serves(size_t size, size_t alignment) {
+    if (node_size_ == 0) {
+      if (alignment > alignof(std::max_align_t) || size == 0) {
+        return false;
+      }
+      // Round up so that every node is aligned for both the node and a free list entry.
+      const size_t node_alignment = std::max(alignment, alignof(FreeNode));
+      node_size_ = (std::max(size, sizeof(FreeNode)) + node_alignment - 1) & ~(node_alignment - 1);
+      size_ = size;
+      alignment_ = alignment;
+      return true;
+    }
+    return size == size_ && alignment == alignment_;
+  }
+
+private:
+  struct FreeNode {
+    FreeNode* next_;
+  };
+
+  // Prefix of every block; the nodes start at the next max aligned offset.
+  struct alignas(std::max_align_t) Block {
+    Block* previous_;
+  };
+
+  void addBlock() {
+    const size_t bytes = sizeof(Block) + node_size_ * next_block_nodes_;
+    // new char[] is aligned for any object that fits, which covers Block.
+    Block* block = new (new char[bytes]) Block{blocks_};
+    blocks_ = block;
+    next_ = reinterpret_cast<char*>(block) + sizeof(Block);
+    end_ = reinterpret_cast<char*>(block) + bytes;
+    next_block_nodes_ = std::min(next_block_nodes_ * 2, MaxBlockNodes);
+  }
+
+  FreeNode* free_list_{};
+  // The unused part of the most recent block.
+  char* next_{};
+  char* end_{};
+  Block* blocks_{};
+  size_t size_{};
+  size_t alignment_{};
+  size_t node_size_{};
+  uint32_t next_block_nodes_{1};
+};
+
+/**
+ * Standard allocator that takes single nodes from a NodePool. Other allocations, e.g. arrays or
+ * objects of a different size than the pool's nodes, go to std::allocator. The pool must outlive
+ * the allocator and every copy of it.
+ */
+template <class T> class NodePoolAllocator {
+public:
+  using value_type = T;
+
+  explicit NodePoolAllocator(NodePool& pool) : pool_(&pool) {}
+  template <class U> NodePoolAllocator(const NodePoolAllocator<U>& other) : pool_(other.pool_) {}
+
+  T* allocate(size_t n) {
+    if (n == 1) {
+      if (void* node = pool_->allocate(sizeof(T), alignof(T)); node != nullptr) {
+        return static_cast<T*>(node);
+      }
+    }
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, size_t n) {
+    if (n == 1 && pool_->serves(sizeof(T), alignof(T))) {
+      pool_->deallocate(p);
+    } else {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  template <class U> bool operator==(const NodePoolAllocator<U>& other) const {
+    return pool_ == other.pool_;
+  }
+  template <class U> bool operator!=(const NodePoolAllocator<U>& other) const {
+    return pool_ != other.pool_;
+  }
+
+private:
+  template <class U> friend class NodePoolAllocator;
+
+  NodePool* pool_;
+};
+
+} // namespace Envoy
@@ -8,6 +8,7 @@
 #include "absl/strings/str_cat.h"
 
 #if defined(__linux__)
+#include <sched.h>
 #include <sys/resource.h>
 #include <sys/syscall.h>
 #elif defined(__APPLE__)
@@ -62,6 +63,20 @@ void setThreadPriority(const int64_t tid, const int priority) {
 #endif
 }
 
+void setThreadCpu(const uint32_t cpu) {
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(cpu, &mask);
+  const int rc = pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+  if (rc != 0) {
+    ENVOY_LOG_MISC(warn, "failed to pin thread to CPU {}: {}", cpu, Envoy::errorDetails(rc));
+  }
+#else
+  UNREFERENCED_PARAMETER(cpu);
+#endif
+}
+
 } // namespace
 
 // See https://www.man7.org/linux/man-pages/man3/pthread_setname_np.3.html.
@@ -70,14 +85,17 @@ void setThreadPriority(const int64_t tid, const int priority) {
 #define PTHREAD_MAX_THREADNAME_LEN_INCLUDING_NULL_BYTE 16
 
 ThreadHandle::ThreadHandle(std::function<void()> thread_routine,
-                           absl::optional<int> thread_priority)
-    : thread_routine_(thread_routine), thread_priority_(thread_priority) {}
+                           absl::optional<int> thread_priority,
+                           absl::optional<uint32_t> thread_cpu)
+    : thread_routine_(thread_routine), thread_priority_(thread_priority), thread_cpu_(thread_cpu) {}
 
 /** Returns the thread routine. */
 std::function<void()>& ThreadHandle::routine() { return thread_routine_; }
 
 absl::optional<int> ThreadHandle::priority() const { return thread_priority_; }
 
+absl::optional<uint32_t> ThreadHandle::cpu() const { return thread_cpu_; }
+
 /** Returns the thread handle. */
 pthread_t& ThreadHandle::handle() { return thread_handle_; }
 
@@ -175,6 +193,9 @@ int PosixThreadFactory::createPthread(ThreadHandle* thread_handle) {
         if (handle->priority()) {
           setThreadPriority(getCurrentThreadId(), *handle->priority());
         }
+        if (handle->cpu()) {
+          setThreadCpu(*handle->cpu());
+        }
         handle->routine()();
         return nullptr;
       },
@@ -184,7 +205,8 @@ int PosixThreadFactory::createPthread(ThreadHandle* thread_handle) {
 PosixThreadPtr PosixThreadFactory::createThread(std::function<void()> thread_routine,
                                                 OptionsOptConstRef options, bool crash_on_failure) {
   auto thread_handle =
-      new ThreadHandle(thread_routine, options ? options->priority_ : absl::nullopt);
+      new ThreadHandle(thread_routine, options ? options->priority_ : absl::nullopt,
+                       options ? options->cpu_ : absl::nullopt);
   const int rc = createPthread(thread_handle);
   if (rc != 0) {
     delete thread_handle;
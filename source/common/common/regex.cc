@@ -1,5 +1,7 @@
 #include "source/common/common/regex.h"
 
+#include <algorithm>
+
 #include "envoy/common/exception.h"
 #include "envoy/extensions/regex_engines/v3/google_re2.pb.h"
 #include "envoy/extensions/regex_engines/v3/google_re2.pb.validate.h"
@@ -92,6 +94,45 @@ CompiledGoogleReMatcher::CompiledGoogleReMatcher(
   }
 }
 
+absl::StatusOr<std::unique_ptr<CompiledGoogleReSetMatcher>>
+CompiledGoogleReSetMatcher::create(const std::vector<std::string>& regexes) {
+  auto matcher = std::unique_ptr<CompiledGoogleReSetMatcher>(new CompiledGoogleReSetMatcher());
+  for (const std::string& regex : regexes) {
+    std::string error;
+    if (matcher->set_.Add(regex, &error) < 0) {
+      return absl::InvalidArgumentError(error);
+    }
+  }
+  if (!matcher->set_.Compile()) {
+    return absl::ResourceExhaustedError(
+        fmt::format("{} regexes are too large to be matched together", regexes.size()));
+  }
+  matcher->size_ = regexes.size();
+  return matcher;
+}
+
+bool CompiledGoogleReSetMatcher::match(absl::string_view value, std::vector<int>& matches) const {
+  matches.clear();
+  re2::RE2::Set::ErrorInfo error_info;
+  if (!set_.Match(value, &matches, &error_info)) {
+    matches.clear();
+    return error_info.kind == re2::RE2::Set::kNoError;
+  }
+  std::sort(matches.begin(), matches.end());
+  return true;
+}
+
+absl::optional<bool> CompiledGoogleReSetMatcher::matchAny(absl::string_view value) const {
+  re2::RE2::Set::ErrorInfo error_info;
+  if (set_.Match(value, nullptr, &error_info)) {
+    return true;
+  }
+  if (error_info.kind != re2::RE2::Set::kNoError) {
+    return absl::nullopt;
+  }
+  return false;
+}
+
 absl::StatusOr<CompiledMatcherPtr> GoogleReEngine::matcher(const std::string& regex) const {
   return CompiledGoogleReMatcher::createAndSizeCheck(regex);
 }
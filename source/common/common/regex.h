@@ -13,6 +13,7 @@
 #include "source/common/stats/symbol_table.h"
 
 #include "re2/re2.h"
+#include "re2/set.h"
 #include "xds/type/matcher/v3/regex.pb.h"
 
 namespace Envoy {
@@ -64,6 +65,45 @@ public:
       : CompiledGoogleReMatcher(regex) {}
 };
 
+/**
+ * Matches a value against many regexes in a single pass, in time linear in the length of the value
+ * however many regexes there are. Each regex matches the same values as a CompiledGoogleReMatcher
+ * of it, so sibling matchers of the RE2 engine can be combined into one set.
+ */
+class CompiledGoogleReSetMatcher {
+public:
+  /**
+   * @return the matcher, or an error if a regex is invalid or the regexes are too large to be
+   *         combined, in which case they have to be matched one by one.
+   */
+  static absl::StatusOr<std::unique_ptr<CompiledGoogleReSetMatcher>>
+  create(const std::vector<std::string>& regexes);
+
+  /**
+   * Sets matches to the indexes of the regexes that match the value, in increasing order.
+   * @return false if the set ran out of memory for the value, in which case the regexes have to be
+   *         matched one by one.
+   */
+  bool match(absl::string_view value, std::vector<int>& matches) const;
+
+  /**
+   * @return whether any regex matches the value, or nullopt if the set ran out of memory for the
+   *         value, in which case the regexes have to be matched one by one.
+   */
+  absl::optional<bool> matchAny(absl::string_view value) const;
+
+  size_t size() const { return size_; }
+
+private:
+  CompiledGoogleReSetMatcher()
+      : set_(re2::RE2::Options(re2::RE2::Quiet), re2::RE2::ANCHOR_BOTH) {}
+
+  re2::RE2::Set set_;
+  size_t size_{};
+};
+
+using CompiledGoogleReSetMatcherPtr = std::unique_ptr<const CompiledGoogleReSetMatcher>;
+
 class GoogleReEngine : public Engine {
 public:
   absl::StatusOr<CompiledMatcherPtr> matcher(const std::string& regex) const override;
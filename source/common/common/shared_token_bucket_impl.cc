@@ -33,12 +33,17 @@ std::chrono::milliseconds SharedTokenBucketImpl::nextTokenAvailable() {
 };
 
 void SharedTokenBucketImpl::maybeReset(uint64_t num_tokens) {
-  Thread::LockGuard lock(mutex_);
   // Don't reset if reset once before.
-  if (reset_once_) {
+  if (reset_once_.load(std::memory_order_acquire)) {
+    return;
+  }
+  Thread::LockGuard lock(mutex_);
+  if (reset_once_.load(std::memory_order_relaxed)) {
     return;
   }
-  reset_once_ = true;
+  // Any other caller which sees this before the reset is done will wait for it on the lock as
+  // soon as it uses the bucket.
+  reset_once_.store(true, std::memory_order_release);
   synchronizer_.syncPoint(ResetCheckSyncPoint);
   impl_.maybeReset(num_tokens);
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include "source/common/common/thread.h"
 #include "source/common/common/thread_synchronizer.h"
 #include "source/common/common/token_bucket_impl.h"
@@ -43,7 +45,9 @@ public:
 private:
   Thread::MutexBasicLockable mutex_;
   TokenBucketImpl impl_ ABSL_GUARDED_BY(mutex_);
-  bool reset_once_ ABSL_GUARDED_BY(mutex_){false};
+  // Written under the lock, but also read without it so that the streams which share the bucket do
+  // not contend on the lock once the bucket has been reset.
+  std::atomic<bool> reset_once_{false};
   mutable Thread::ThreadSynchronizer synchronizer_; // Used only for testing.
   friend class SharedTokenBucketImplTest;
 };
@@ -167,6 +167,29 @@ public:
     return nodes_[result].value_;
   }
 
+  /**
+   * Calls the callback with the value of every key that is a prefix of the specified key,
+   * including the empty key, in order of increasing key length. Keys without a value are skipped.
+   * Complexity is O(min(longest key prefix, key length)).
+   * @param key the key used to find.
+   * @param cb the callback, invoked with a const reference to every value found.
+   */
+  template <class Callback> void forEachPrefixValue(absl::string_view key, Callback cb) const {
+    int32_t current = 0;
+    if (nodes_[current].value_) {
+      cb(nodes_[current].value_);
+    }
+    for (uint8_t c : key) {
+      current = getChildIndex(current, c);
+      if (current == NoNode) {
+        return;
+      }
+      if (nodes_[current].value_) {
+        cb(nodes_[current].value_);
+      }
+    }
+  }
+
 private:
   // Flat representation of the tree - each node has a vector of indices to its
   // child nodes.
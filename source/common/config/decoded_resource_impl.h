@@ -68,6 +68,12 @@ public:
                       const std::vector<std::string>& aliases, const std::string& version)
       : resource_(std::move(resource)), has_resource_(true), name_(name), aliases_(aliases),
         version_(version), ttl_(absl::nullopt), metadata_(absl::nullopt) {}
+  // Shares a message which was decoded for an earlier update, e.g. when a state-of-the-world
+  // response repeats a resource unchanged.
+  DecodedResourceImpl(std::shared_ptr<const Protobuf::Message> resource, const std::string& name,
+                      const std::string& version)
+      : resource_(std::move(resource)), has_resource_(true), name_(name), version_(version),
+        ttl_(absl::nullopt), metadata_(absl::nullopt) {}
 
   // Config::DecodedResource
   const std::string& name() const override { return name_; }
@@ -75,6 +81,7 @@ public:
   const std::string& version() const override { return version_; };
   const Protobuf::Message& resource() const override { return *resource_; };
   bool hasResource() const override { return has_resource_; }
+  std::shared_ptr<const Protobuf::Message> sharedResource() const { return resource_; }
   absl::optional<std::chrono::milliseconds> ttl() const override { return ttl_; }
   const OptRef<const envoy::config::core::v3::Metadata> metadata() const override {
     return metadata_.has_value() ? makeOptRef(metadata_.value()) : absl::nullopt;
@@ -91,7 +98,7 @@ private:
         aliases_(repeatedPtrFieldToVector(aliases)), version_(version), ttl_(ttl),
         metadata_(metadata) {}
 
-  const ProtobufTypes::MessagePtr resource_;
+  const std::shared_ptr<const Protobuf::Message> resource_;
   const bool has_resource_;
   const std::string name_;
   const std::vector<std::string> aliases_;
@@ -59,8 +59,20 @@ const ProtobufWkt::Value& Metadata::metadataValue(const envoy::config::core::v3:
 const ProtobufWkt::Value& Metadata::metadataValue(const envoy::config::core::v3::Metadata* metadata,
                                                   const std::string& filter,
                                                   const std::string& key) {
-  const std::vector<std::string> path{key};
-  return metadataValue(metadata, filter, path);
+  // Equivalent to a lookup with the path {key}, without building the path.
+  if (!metadata) {
+    return ProtobufWkt::Value::default_instance();
+  }
+  const auto filter_it = metadata->filter_metadata().find(filter);
+  if (filter_it == metadata->filter_metadata().end()) {
+    return ProtobufWkt::Value::default_instance();
+  }
+  const auto& fields = filter_it->second.fields();
+  const auto entry_it = fields.find(key);
+  if (entry_it == fields.end()) {
+    return ProtobufWkt::Value::default_instance();
+  }
+  return entry_it->second;
 }
 
 ProtobufWkt::Value& Metadata::mutableMetadataValue(envoy::config::core::v3::Metadata& metadata,
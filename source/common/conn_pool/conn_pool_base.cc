@@ -26,6 +26,7 @@ ConnPoolImplBase::ConnPoolImplBase(
     Upstream::ClusterConnectivityState& state)
     : state_(state), host_(host), priority_(priority), dispatcher_(dispatcher),
       socket_options_(options), transport_socket_options_(transport_socket_options),
+      peak_demand_window_start_(dispatcher_.timeSource().monotonicTime()),
       upstream_ready_cb_(dispatcher_.createSchedulableCallback([this]() { onUpstreamReady(); })) {}
 
 ConnPoolImplBase::~ConnPoolImplBase() {
@@ -97,8 +98,11 @@ bool ConnPoolImplBase::shouldCreateNewConnection(float global_preconnect_ratio)
     // Local preconnect does not need to anticipate a stream. It is called as
     // new streams are established or torn down and simply attempts to maintain
     // the correct ratio of streams and anticipated capacity.
-    return shouldConnect(pending_streams_.size(), num_active_streams_, connecting_stream_capacity_,
-                         perUpstreamPreconnectRatio());
+    //
+    // If the peak demand window is set, the pool is also provisioned for the recent peak demand,
+    // so that connections are kept warm for the next burst of streams.
+    return shouldConnect(streamDemand() - num_active_streams_, num_active_streams_,
+                         connecting_stream_capacity_, perUpstreamPreconnectRatio());
   }
 }
 
@@ -106,8 +110,33 @@ float ConnPoolImplBase::perUpstreamPreconnectRatio() const {
   return host_->cluster().perUpstreamPreconnectRatio();
 }
 
+void ConnPoolImplBase::updatePeakDemand() {
+  const absl::optional<std::chrono::milliseconds> window =
+      host_->cluster().preconnectPeakDemandWindow();
+  if (!window.has_value()) {
+    return;
+  }
+
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  const auto elapsed = now - peak_demand_window_start_;
+  if (elapsed >= *window) {
+    // Without any demand recorded in the last window, there is no previous peak to remember.
+    previous_window_peak_demand_ = elapsed >= 2 * *window ? 0 : current_window_peak_demand_;
+    current_window_peak_demand_ = 0;
+    peak_demand_window_start_ = now;
+  }
+  current_window_peak_demand_ = std::max<uint32_t>(
+      current_window_peak_demand_, pending_streams_.size() + num_active_streams_);
+}
+
+size_t ConnPoolImplBase::streamDemand() const {
+  return std::max<size_t>(pending_streams_.size() + num_active_streams_,
+                          std::max(current_window_peak_demand_, previous_window_peak_demand_));
+}
+
 ConnPoolImplBase::ConnectionResult ConnPoolImplBase::tryCreateNewConnections() {
   ConnPoolImplBase::ConnectionResult result;
+  updatePeakDemand();
   // Somewhat arbitrarily cap the number of connections preconnected due to new
   // incoming connections. The preconnect ratio is capped at 3, so in steady
   // state, no more than 3 connections should be preconnected. If hosts go
@@ -279,6 +308,15 @@ ConnectionPool::Cancellable* ConnPoolImplBase::newStreamImpl(AttachContext& cont
     return nullptr;
   }
 
+  if (can_send_early_data) {
+    if (ActiveClient* client = clientForReplaySafeStream(); client != nullptr) {
+      ENVOY_CONN_LOG(debug, "pipelining stream on existing connection", *client);
+      attachStreamToClient(*client, context);
+      tryCreateNewConnections();
+      return nullptr;
+    }
+  }
+
   if (!host_->cluster().resourceManager(priority_).pendingRequests().canCreate()) {
     ENVOY_LOG(debug, "max pending streams overflow");
     onPoolFailure(nullptr, absl::string_view(), ConnectionPool::PoolFailureReason::Overflow,
@@ -659,8 +697,9 @@ bool ConnPoolImplBase::connectingConnectionIsExcess(const ActiveClient& client)
   //
   // If preconnect ratio is set, it also factors in the anticipated load based on both queued
   // streams and active streams, and makes sure the connecting capacity would still be sufficient to
-  // serve that even with the most recent client removed.
-  return (pending_streams_.size() + num_active_streams_) * perUpstreamPreconnectRatio() <=
+  // serve that even with the most recent client removed. If the peak demand window is set, the
+  // recent peak demand is anticipated as well.
+  return streamDemand() * perUpstreamPreconnectRatio() <=
          (connecting_stream_capacity_ - client.currentUnusedCapacity() + num_active_streams_);
 }
 
@@ -265,6 +265,10 @@ public:
   virtual ConnectionPool::Cancellable* newPendingStream(AttachContext& context,
                                                         bool can_send_early_data) PURE;
 
+  // Returns a busy client which takes one more stream ahead of the completion of its current
+  // streams, or nullptr. Only asked for streams which are safe to replay, when no client is ready.
+  virtual ActiveClient* clientForReplaySafeStream() { return nullptr; }
+
   virtual void attachStreamToClient(Envoy::ConnectionPool::ActiveClient& client,
                                     AttachContext& context);
 
@@ -345,6 +349,13 @@ protected:
 
   float perUpstreamPreconnectRatio() const;
 
+  // Rolls the peak demand window over if it has passed and records the current demand in it.
+  void updatePeakDemand();
+
+  // The number of streams to provision for: the streams in flight, or the peak demand of the
+  // current and previous windows if the peak demand window is set.
+  size_t streamDemand() const;
+
   ConnectionPool::Cancellable*
   addPendingStream(Envoy::ConnectionPool::PendingStreamPtr&& pending_stream) {
     LinkedList::moveIntoList(std::move(pending_stream), pending_streams_);
@@ -401,6 +412,12 @@ private:
   // The number of streams currently attached to clients.
   uint32_t num_active_streams_{0};
 
+  // The start of the current peak demand window, and the peak number of pending and active streams
+  // seen within the current and the previous window.
+  MonotonicTime peak_demand_window_start_;
+  uint32_t current_window_peak_demand_{0};
+  uint32_t previous_window_peak_demand_{0};
+
   // Whether the connection pool is currently in the process of closing
   // all connections so that it can be gracefully deleted.
   bool is_draining_for_deletion_{false};
@@ -3,6 +3,7 @@
 #include <chrono>
 #include <cstdint>
 #include <functional>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -292,7 +293,7 @@ void DispatcherImpl::shutdown() {
   // callbacks and dispatcher thread deletable objects.
   ASSERT(isThreadSafe());
   auto deferred_deletables_size = current_to_delete_->size();
-  std::list<std::function<void()>>::size_type post_callbacks_size;
+  std::vector<PostCb>::size_type post_callbacks_size;
   {
     Thread::LockGuard lock(post_lock_);
     post_callbacks_size = post_callbacks_.size();
@@ -342,27 +343,38 @@ void DispatcherImpl::runPostCallbacks() {
   // objects that is being deferred deleted.
   clearDeferredDeleteList();
 
-  std::list<PostCb> callbacks;
+  std::vector<PostCb> callbacks;
   {
     // Take ownership of the callbacks under the post_lock_. The lock must be released before
     // callbacks execute. Callbacks added after this transfer will re-arm post_cb_ and will execute
     // later in the event loop.
     Thread::LockGuard lock(post_lock_);
-    callbacks = std::move(post_callbacks_);
-    // post_callbacks_ should be empty after the move.
+    callbacks.swap(post_callbacks_);
+    // post_callbacks_ should be empty after the swap.
     ASSERT(post_callbacks_.empty());
   }
+  if (callbacks.empty()) {
+    return;
+  }
   // It is important that the execution and deletion of the callback happen while post_lock_ is not
   // held. Either the invocation or destructor of the callback can call post() on this dispatcher.
-  while (!callbacks.empty()) {
+  for (PostCb& callback : callbacks) {
     // Touch the watchdog before executing the callback to avoid spurious watchdog miss events when
     // executing a long list of callbacks.
     touchWatchdog();
     // Run the callback.
-    callbacks.front()();
-    // Pop the front so that the destructor of the callback that just executed runs before the next
-    // callback executes.
-    callbacks.pop_front();
+    callback();
+    // Destroy the callback so that the destructor of the callback that just executed runs before
+    // the next callback executes.
+    callback = nullptr;
+  }
+  callbacks.clear();
+  {
+    // Give the buffer back for the next batch, unless callbacks were posted in the meantime.
+    Thread::LockGuard lock(post_lock_);
+    if (post_callbacks_.empty() && post_callbacks_.capacity() < callbacks.capacity()) {
+      post_callbacks_.swap(callbacks);
+    }
   }
 }
 
@@ -373,6 +385,14 @@ void DispatcherImpl::onFatalError(std::ostream& os) const {
     for (auto iter = tracked_object_stack_.rbegin(); iter != tracked_object_stack_.rend(); ++iter) {
       (*iter)->dumpState(os);
     }
+    if (!slow_tracked_scopes_.empty()) {
+      os << "Last slow tracked scopes:\n";
+      for (size_t i = 0; i < slow_tracked_scopes_.size(); ++i) {
+        const SlowTrackedScope& scope =
+            slow_tracked_scopes_[(next_slow_tracked_scope_ + i) % slow_tracked_scopes_.size()];
+        os << "  " << scope.duration_.count() << "us: " << scope.state_ << "\n";
+      }
+    }
   }
 }
 
@@ -398,6 +418,9 @@ void DispatcherImpl::touchWatchdog() {
 void DispatcherImpl::pushTrackedObject(const ScopeTrackedObject* object) {
   ASSERT(isThreadSafe());
   ASSERT(object != nullptr);
+  if (stats_ != nullptr && tracked_object_stack_.empty()) {
+    tracked_scope_start_ = time_source_.monotonicTime();
+  }
   tracked_object_stack_.push_back(object);
   ASSERT(tracked_object_stack_.size() <= ExpectedMaxTrackedObjectStackDepth);
 }
@@ -411,6 +434,33 @@ void DispatcherImpl::popTrackedObject(const ScopeTrackedObject* expected_object)
   tracked_object_stack_.pop_back();
   ASSERT(top == expected_object,
          "Popped the top of the tracked object stack, but it wasn't the expected object!");
+  if (tracked_scope_start_.has_value() && tracked_object_stack_.empty()) {
+    recordTrackedScope(*top);
+  }
+}
+
+void DispatcherImpl::recordTrackedScope(const ScopeTrackedObject& object) {
+  const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      time_source_.monotonicTime() - *tracked_scope_start_);
+  tracked_scope_start_.reset();
+  stats_->tracked_scope_duration_us_.recordValue(duration.count());
+  if (duration < SlowTrackedScopeThreshold) {
+    return;
+  }
+
+  // Only the state of slow scopes is dumped, so that their owner (e.g. the connection or stream
+  // whose filters ran) can be identified after the fact.
+  std::ostringstream state;
+  object.dumpState(state);
+  SlowTrackedScope slow_scope{duration, state.str().substr(0, MaxSlowTrackedScopeStateSize)};
+  ENVOY_LOG(debug, "{} spent {}us in the scope of: {}", stats_prefix_, duration.count(),
+            slow_scope.state_);
+  if (slow_tracked_scopes_.size() < MaxSlowTrackedScopes) {
+    slow_tracked_scopes_.push_back(std::move(slow_scope));
+    return;
+  }
+  slow_tracked_scopes_[next_slow_tracked_scope_] = std::move(slow_scope);
+  next_slow_tracked_scope_ = (next_slow_tracked_scope_ + 1) % MaxSlowTrackedScopes;
 }
 
 } // namespace Event
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <list>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "envoy/api/api.h"
@@ -21,6 +23,7 @@
 #include "source/common/signal/fatal_error_handler.h"
 
 #include "absl/container/inlined_vector.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Event {
@@ -30,6 +33,13 @@ namespace Event {
 // shouldn't have to grow larger.
 inline constexpr size_t ExpectedMaxTrackedObjectStackDepth = 10;
 
+// When the dispatcher stats are enabled, the state of the outermost tracked objects whose scopes
+// last longer than SlowTrackedScopeThreshold is kept for the last MaxSlowTrackedScopes of them,
+// truncated to MaxSlowTrackedScopeStateSize bytes, and dumped on fatal errors.
+inline constexpr std::chrono::milliseconds SlowTrackedScopeThreshold{10};
+inline constexpr size_t MaxSlowTrackedScopes = 4;
+inline constexpr size_t MaxSlowTrackedScopeStateSize = 1024;
+
 /**
  * libevent implementation of Event::Dispatcher.
  */
@@ -125,6 +135,11 @@ private:
   };
   using WatchdogRegistrationPtr = std::unique_ptr<WatchdogRegistration>;
 
+  struct SlowTrackedScope {
+    std::chrono::microseconds duration_;
+    std::string state_;
+  };
+
   TimerPtr createTimerInternal(TimerCb cb);
   void updateApproximateMonotonicTimeInternal();
   void runPostCallbacks();
@@ -132,6 +147,8 @@ private:
 
   // Helper used to touch the watchdog after most schedulable, fd, and timer callbacks.
   void touchWatchdog();
+  // Records the duration of the scope of the outermost tracked object, which just ended.
+  void recordTrackedScope(const ScopeTrackedObject& object);
 
   // Validate that an operation is thread safe, i.e. it's invoked on the same thread that the
   // dispatcher run loop is executing on. We allow run_tid_ to be empty for tests where we don't
@@ -162,7 +179,10 @@ private:
 
   SchedulableCallbackPtr post_cb_;
   Thread::MutexBasicLockable post_lock_;
-  std::list<PostCb> post_callbacks_ ABSL_GUARDED_BY(post_lock_);
+  // A vector rather than a list, so that post() doesn't allocate a node while holding post_lock_.
+  // runPostCallbacks() swaps the batch out and gives the buffer back once the callbacks have run,
+  // so that its capacity is reused by the following batches.
+  std::vector<PostCb> post_callbacks_ ABSL_GUARDED_BY(post_lock_);
 
   std::vector<DeferredDeletablePtr> to_delete_1_;
   std::vector<DeferredDeletablePtr> to_delete_2_;
@@ -170,6 +190,11 @@ private:
 
   absl::InlinedVector<const ScopeTrackedObject*, ExpectedMaxTrackedObjectStackDepth>
       tracked_object_stack_;
+  // Start of the scope of the outermost tracked object, only measured when stats are enabled.
+  absl::optional<MonotonicTime> tracked_scope_start_;
+  // Ring of the last slow tracked scopes, next_slow_tracked_scope_ is the oldest one once full.
+  std::vector<SlowTrackedScope> slow_tracked_scopes_;
+  size_t next_slow_tracked_scope_{};
   bool deferred_deleting_{};
   MonotonicTime approximate_monotonic_time_;
   WatchdogRegistrationPtr watchdog_registration_;
@@ -7,6 +7,8 @@
 #include "envoy/event/scaled_range_timer_manager.h"
 #include "envoy/event/timer.h"
 
+#include "source/common/event/timer_wheel.h"
+
 #include "absl/container/flat_hash_map.h"
 
 namespace Envoy {
@@ -19,7 +21,8 @@ namespace Event {
  * and uses a real Timer object to schedule the expiration of the first timer in the queue. The
  * expectation is that the number of (max - min) values used to enable timers is small, so the
  * number of queues is tightly bounded. The queue-based implementation depends on that expectation
- * for efficient operation.
+ * for efficient operation. With envoy.restart_features.scaled_timers_use_timer_wheel, the wait for
+ * the min duration uses a TimerWheel rather than a real Timer per timer.
  */
 class ScaledRangeTimerManagerImpl : public ScaledRangeTimerManager {
 public:
@@ -122,10 +125,16 @@ private:
 
   void onQueueTimerFired(Queue& queue);
 
+  // @return a timer for the min duration of a range timer, from the timer wheel if it's used.
+  TimerPtr createMinDurationTimer(TimerCb callback);
+
   Dispatcher& dispatcher_;
   const ScaledTimerTypeMapConstSharedPtr timer_minimums_;
   UnitFloat scale_factor_;
   absl::flat_hash_set<std::unique_ptr<Queue>, Hash, Eq> queues_;
+  const bool use_timer_wheel_;
+  // Created on first use, as the manager is created with the dispatcher.
+  std::unique_ptr<TimerWheel> timer_wheel_;
 };
 
 } // namespace Event
@@ -0,0 +1,250 @@
+#include "source/common/event/timer_wheel.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/scope_tracker.h"
+
+#include "absl/numeric/bits.h"
+
+namespace Envoy {
+namespace Event {
+
+class TimerWheel::WheelTimerImpl final : public Timer {
+public:
+  WheelTimerImpl(TimerWheel& wheel, TimerCb callback)
+      : wheel_(wheel), callback_(std::move(callback)) {}
+
+  ~WheelTimerImpl() override { disableTimer(); }
+
+  // Timer
+  void disableTimer() override {
+    if (slot_ != nullptr) {
+      wheel_.remove(*this);
+    }
+    scope_ = nullptr;
+  }
+
+  void enableTimer(std::chrono::milliseconds ms, const ScopeTrackedObject* scope) override {
+    ASSERT(wheel_.dispatcher_.isThreadSafe());
+    disableTimer();
+    scope_ = scope;
+    expiry_tick_ =
+        wheel_.expiryTick(wheel_.dispatcher_.approximateMonotonicTime() +
+                          std::max(ms, std::chrono::milliseconds::zero()));
+    wheel_.add(*this);
+  }
+
+  void enableHRTimer(std::chrono::microseconds us, const ScopeTrackedObject* scope) override {
+    enableTimer(std::chrono::ceil<std::chrono::milliseconds>(us), scope);
+  }
+
+  bool enabled() override { return slot_ != nullptr; }
+
+  void fire() {
+    if (scope_ == nullptr) {
+      callback_();
+    } else {
+      ScopeTrackerScopeState scope(scope_, wheel_.dispatcher_);
+      scope_ = nullptr;
+      callback_();
+    }
+  }
+
+  TimerWheel& wheel_;
+  const TimerCb callback_;
+  const ScopeTrackedObject* scope_{};
+  uint64_t expiry_tick_{};
+  // The slot the timer is linked in, nullptr if the timer is disabled.
+  Slot* slot_{};
+  // The level and index of the slot, or Levels for the expired list.
+  uint32_t level_{};
+  uint32_t index_{};
+  WheelTimerImpl* prev_{};
+  WheelTimerImpl* next_{};
+};
+
+TimerWheel::TimerWheel(Dispatcher& dispatcher)
+    : dispatcher_(dispatcher), start_(dispatcher.approximateMonotonicTime()),
+      tick_timer_(dispatcher.createTimer([this] { onTick(); })) {}
+
+TimerWheel::~TimerWheel() {
+  // Timers of the wheel shouldn't outlive it.
+  ASSERT(expired_.head_ == nullptr);
+  ASSERT(std::all_of(levels_.begin(), levels_.end(),
+                     [](const Level& level) { return level.occupied_ == 0; }));
+}
+
+TimerPtr TimerWheel::createTimer(TimerCb callback) {
+  return std::make_unique<WheelTimerImpl>(*this, std::move(callback));
+}
+
+uint64_t TimerWheel::expiryTick(MonotonicTime time) const {
+  if (time <= start_) {
+    return 0;
+  }
+  return std::chrono::ceil<std::chrono::milliseconds>(time - start_).count();
+}
+
+uint64_t TimerWheel::passedTick(MonotonicTime time) const {
+  if (time <= start_) {
+    return 0;
+  }
+  return std::chrono::floor<std::chrono::milliseconds>(time - start_).count();
+}
+
+MonotonicTime TimerWheel::timeOf(uint64_t tick) const {
+  return start_ + std::chrono::milliseconds(tick);
+}
+
+uint64_t TimerWheel::nextEventTick() const {
+  uint64_t next = UINT64_MAX;
+  for (uint32_t level = 0; level < Levels; ++level) {
+    const uint64_t occupied = levels_[level].occupied_;
+    if (occupied == 0) {
+      continue;
+    }
+    // The slots of a level hold the buckets after the current one, find the first occupied one.
+    const uint32_t shift = level * LevelBits;
+    const uint64_t current_bucket = current_tick_ >> shift;
+    const uint32_t first_index = (current_bucket + 1) % SlotsPerLevel;
+    const uint64_t rotated = absl::rotr(occupied, static_cast<int>(first_index));
+    const uint64_t bucket = current_bucket + 1 + absl::countr_zero(rotated);
+    next = std::min(next, bucket << shift);
+  }
+  return next;
+}
+
+void TimerWheel::add(WheelTimerImpl& timer) {
+  timer.expiry_tick_ = std::max(timer.expiry_tick_, current_tick_ + 1);
+  if (insert(timer) < scheduled_tick_) {
+    scheduleTick();
+  }
+}
+
+uint64_t TimerWheel::insert(WheelTimerImpl& timer) {
+  if (timer.expiry_tick_ <= current_tick_) {
+    timer.level_ = Levels;
+    link(expired_, timer);
+    return current_tick_;
+  }
+  // Use the lowest level that has a slot for the expiry tick. Timers expiring after the range of
+  // the highest level are put in its last slot, and are inserted again when it's reached.
+  for (uint32_t level = 0; level < Levels; ++level) {
+    const uint32_t shift = level * LevelBits;
+    const uint64_t current_bucket = current_tick_ >> shift;
+    uint64_t bucket = timer.expiry_tick_ >> shift;
+    if (bucket - current_bucket >= SlotsPerLevel) {
+      if (level + 1 < Levels) {
+        continue;
+      }
+      bucket = current_bucket + SlotsPerLevel - 1;
+    }
+    timer.level_ = level;
+    timer.index_ = bucket % SlotsPerLevel;
+    link(levels_[level].slots_[timer.index_], timer);
+    levels_[level].occupied_ |= uint64_t(1) << timer.index_;
+    return bucket << shift;
+  }
+  PANIC("not reached");
+}
+
+void TimerWheel::remove(WheelTimerImpl& timer) {
+  Slot& slot = *timer.slot_;
+  unlink(slot, timer);
+  if (slot.head_ == nullptr && timer.level_ < Levels) {
+    levels_[timer.level_].occupied_ &= ~(uint64_t(1) << timer.index_);
+  }
+}
+
+void TimerWheel::link(Slot& slot, WheelTimerImpl& timer) {
+  timer.slot_ = &slot;
+  timer.prev_ = nullptr;
+  timer.next_ = slot.head_;
+  if (slot.head_ != nullptr) {
+    slot.head_->prev_ = &timer;
+  }
+  slot.head_ = &timer;
+}
+
+void TimerWheel::unlink(Slot& slot, WheelTimerImpl& timer) {
+  if (timer.prev_ != nullptr) {
+    timer.prev_->next_ = timer.next_;
+  } else {
+    slot.head_ = timer.next_;
+  }
+  if (timer.next_ != nullptr) {
+    timer.next_->prev_ = timer.prev_;
+  }
+  timer.slot_ = nullptr;
+  timer.prev_ = nullptr;
+  timer.next_ = nullptr;
+}
+
+void TimerWheel::onTick() {
+  // The tick timer fired, so its tick has passed even if the approximate time lags behind.
+  const uint64_t fired_tick = scheduled_tick_;
+  scheduled_tick_ = UINT64_MAX;
+  advance(std::max(passedTick(dispatcher_.approximateMonotonicTime()), fired_tick));
+  runExpired();
+  scheduleTick();
+}
+
+void TimerWheel::advance(uint64_t tick) {
+  while (true) {
+    const uint64_t next = nextEventTick();
+    if (next > tick) {
+      current_tick_ = std::max(current_tick_, tick);
+      return;
+    }
+    current_tick_ = next;
+    // Insert the timers of the slots of the reached tick again, which moves them to a lower level
+    // or to the expired list.
+    for (uint32_t level = 0; level < Levels; ++level) {
+      const uint32_t shift = level * LevelBits;
+      if ((current_tick_ & ((uint64_t(1) << shift) - 1)) != 0) {
+        break;
+      }
+      const uint32_t index = (current_tick_ >> shift) % SlotsPerLevel;
+      Level& wheel_level = levels_[level];
+      if ((wheel_level.occupied_ & (uint64_t(1) << index)) == 0) {
+        continue;
+      }
+      WheelTimerImpl* timer = wheel_level.slots_[index].head_;
+      wheel_level.slots_[index].head_ = nullptr;
+      wheel_level.occupied_ &= ~(uint64_t(1) << index);
+      while (timer != nullptr) {
+        WheelTimerImpl* next_timer = timer->next_;
+        insert(*timer);
+        timer = next_timer;
+      }
+    }
+  }
+}
+
+void TimerWheel::runExpired() {
+  // Callbacks may enable, disable or destroy any timer, so the expired timers are taken one at a
+  // time from the list.
+  while (expired_.head_ != nullptr) {
+    WheelTimerImpl& timer = *expired_.head_;
+    remove(timer);
+    timer.fire();
+  }
+}
+
+void TimerWheel::scheduleTick() {
+  const uint64_t next = nextEventTick();
+  if (next == UINT64_MAX) {
+    scheduled_tick_ = UINT64_MAX;
+    tick_timer_->disableTimer();
+    return;
+  }
+  scheduled_tick_ = next;
+  const MonotonicTime now = dispatcher_.approximateMonotonicTime();
+  const MonotonicTime time = timeOf(next);
+  tick_timer_->enableTimer(time > now ? std::chrono::ceil<std::chrono::milliseconds>(time - now)
+                                      : std::chrono::milliseconds::zero());
+}
+
+} // namespace Event
+} // namespace Envoy
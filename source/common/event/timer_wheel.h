@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * Hierarchical timing wheel of coarse timers with millisecond granularity, for timers that are
+ * enabled and disabled much more often than they fire, e.g. idle timeouts. Enabling and disabling
+ * a timer is O(1), as opposed to the O(log n) of the timers of the dispatcher, and all the timers
+ * of the wheel are driven by a single timer of the dispatcher, which is only enabled for the ticks
+ * at which timers expire or move to a lower level of the wheel.
+ *
+ * The wheel has Levels levels of SlotsPerLevel slots. Level L holds the timers that expire within
+ * SlotsPerLevel^(L + 1) ticks, in slots of SlotsPerLevel^L ticks, and its timers move to the lower
+ * levels when the tick of their slot is reached. Timers never fire early, and fire up to a tick
+ * later than a timer of the dispatcher would. All methods must be called on the thread of the
+ * dispatcher, and the timers must not outlive the wheel.
+ */
+class TimerWheel : NonCopyable {
+public:
+  explicit TimerWheel(Dispatcher& dispatcher);
+  ~TimerWheel();
+
+  /**
+   * Creates a timer of the wheel.
+   */
+  TimerPtr createTimer(TimerCb callback);
+
+private:
+  class WheelTimerImpl;
+
+  static constexpr uint32_t LevelBits = 6;
+  static constexpr uint32_t SlotsPerLevel = 1 << LevelBits;
+  static constexpr uint32_t Levels = 6;
+
+  // A slot of the wheel, an intrusive list of timers.
+  struct Slot {
+    WheelTimerImpl* head_{};
+  };
+
+  struct Level {
+    std::array<Slot, SlotsPerLevel> slots_;
+    // Bit i is set if slot i isn't empty.
+    uint64_t occupied_{};
+  };
+
+  // @return the first tick at or after the given time.
+  uint64_t expiryTick(MonotonicTime time) const;
+  // @return the last tick at or before the given time.
+  uint64_t passedTick(MonotonicTime time) const;
+  MonotonicTime timeOf(uint64_t tick) const;
+  // @return the next tick at which a slot of a level needs processing, or UINT64_MAX if the wheel
+  //         is empty.
+  uint64_t nextEventTick() const;
+
+  void add(WheelTimerImpl& timer);
+  // Inserts the timer in the slot of its expiry tick, or in the expired list if it has expired.
+  // @return the tick at which the slot of the timer is processed.
+  uint64_t insert(WheelTimerImpl& timer);
+  void remove(WheelTimerImpl& timer);
+  void link(Slot& slot, WheelTimerImpl& timer);
+  void unlink(Slot& slot, WheelTimerImpl& timer);
+
+  void onTick();
+  // Processes the slots of the ticks up to the given one, moving the expired timers to expired_.
+  void advance(uint64_t tick);
+  void runExpired();
+  void scheduleTick();
+
+  Dispatcher& dispatcher_;
+  const MonotonicTime start_;
+  const TimerPtr tick_timer_;
+  // All the timers expiring up to this tick have been moved to expired_.
+  uint64_t current_tick_{};
+  // The tick the tick timer is enabled for, UINT64_MAX if it is disabled.
+  uint64_t scheduled_tick_{UINT64_MAX};
+  std::array<Level, Levels> levels_;
+  // Timers that have expired but haven't fired yet, as their callbacks run one at a time.
+  Slot expired_;
+};
+
+} // namespace Event
+} // namespace Envoy
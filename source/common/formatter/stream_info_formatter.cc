@@ -1043,6 +1043,20 @@ const StreamInfoFormatterProviderLookupTable& getKnownStreamInfoFormatterProvide
                                        return stream_info.currentDuration();
                                      });
                                }}},
+                             {"CPU_TIME",
+                              {CommandSyntaxChecker::COMMAND_ONLY,
+                               [](absl::string_view, absl::optional<size_t>) {
+                                 return std::make_unique<StreamInfoUInt64FormatterProvider>(
+                                     [](const StreamInfo::StreamInfo& stream_info) -> uint64_t {
+                                       const auto timing = stream_info.downstreamTiming();
+                                       if (!timing.has_value()) {
+                                         return 0;
+                                       }
+                                       return std::chrono::duration_cast<
+                                                  std::chrono::microseconds>(timing->cpuTime())
+                                           .count();
+                                     });
+                               }}},
                              {"COMMON_DURATION",
                               {CommandSyntaxChecker::PARAMS_REQUIRED,
                                [](absl::string_view sub_command, absl::optional<size_t>) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <bitset>
 #include <functional>
 #include <list>
@@ -19,6 +20,7 @@
 #include "source/common/json/json_utility.h"
 
 #include "absl/types/optional.h"
+#include "absl/types/variant.h"
 #include "re2/re2.h"
 
 namespace Envoy {
@@ -33,6 +35,8 @@ class PlainStringFormatterBase : public FormatterProviderBase<FormatterContext>
 public:
   PlainStringFormatterBase(absl::string_view str) { str_.set_string_value(str); }
 
+  absl::string_view str() const { return str_.string_value(); }
+
   // FormatterProviderBase
   absl::optional<std::string> formatWithContext(const FormatterContext&,
                                                 const StreamInfo::StreamInfo&) const override {
@@ -229,9 +233,15 @@ public:
   std::string formatWithContext(const FormatterContext& context,
                                 const StreamInfo::StreamInfo& stream_info) const override {
     std::string log_line;
-    log_line.reserve(256);
+    log_line.reserve(reserve_size_);
 
-    for (const auto& provider : providers_) {
+    for (const auto& element : elements_) {
+      if (absl::holds_alternative<std::string>(element)) {
+        log_line += absl::get<std::string>(element);
+        continue;
+      }
+      const FormatterProviderBasePtr<FormatterContext>& provider =
+          absl::get<FormatterProviderBasePtr<FormatterContext>>(element);
       const absl::optional<std::string> bit = provider->formatWithContext(context, stream_info);
       // Add the formatted value if there is one. Otherwise add a default value
       // of "-" if omit_empty_values_ is not set.
@@ -251,7 +261,7 @@ protected:
       : omit_empty_values_(omit_empty_values) {
     auto providers_or_error = SubstitutionFormatParser::parse<FormatterContext>(format);
     SET_AND_RETURN_IF_NOT_OK(providers_or_error.status(), creation_status);
-    providers_ = std::move(*providers_or_error);
+    setProviders(std::move(*providers_or_error));
   }
   FormatterBaseImpl(absl::Status& creation_status, absl::string_view format, bool omit_empty_values,
                     const CommandParsers& command_parsers = {})
@@ -259,12 +269,36 @@ protected:
     auto providers_or_error =
         SubstitutionFormatParser::parse<FormatterContext>(format, command_parsers);
     SET_AND_RETURN_IF_NOT_OK(providers_or_error.status(), creation_status);
-    providers_ = std::move(*providers_or_error);
+    setProviders(std::move(*providers_or_error));
   }
 
 private:
+  // Expected size of the output of a command, used to size the log line up front.
+  static constexpr size_t EstimatedCommandSize = 32;
+
+  void setProviders(std::vector<FormatterProviderBasePtr<FormatterContext>> providers) {
+    // The literals are appended to the log line directly rather than copied out of their provider
+    // for each log line.
+    size_t literals_size = 0;
+    size_t commands = 0;
+    for (auto& provider : providers) {
+      const auto* plain =
+          dynamic_cast<const PlainStringFormatterBase<FormatterContext>*>(provider.get());
+      if (plain != nullptr) {
+        literals_size += plain->str().size();
+        elements_.emplace_back(std::string(plain->str()));
+      } else {
+        ++commands;
+        elements_.emplace_back(std::move(provider));
+      }
+    }
+    reserve_size_ = std::max<size_t>(256, literals_size + commands * EstimatedCommandSize);
+  }
+
   const bool omit_empty_values_;
-  std::vector<FormatterProviderBasePtr<FormatterContext>> providers_;
+  using FormatElement = absl::variant<std::string, FormatterProviderBasePtr<FormatterContext>>;
+  std::vector<FormatElement> elements_;
+  size_t reserve_size_{};
 };
 
 // Helper class to write value to output buffer in JSON style.
@@ -53,6 +53,16 @@ AsyncClientImpl::~AsyncClientImpl() {
   }
 }
 
+const std::string& AsyncClientImpl::path(absl::string_view service_full_name,
+                                         absl::string_view method_name) {
+  auto& paths = paths_[service_full_name];
+  auto it = paths.find(method_name);
+  if (it == paths.end()) {
+    it = paths.emplace(method_name, absl::StrCat("/", service_full_name, "/", method_name)).first;
+  }
+  return it->second;
+}
+
 AsyncRequest* AsyncClientImpl::sendRaw(absl::string_view service_full_name,
                                        absl::string_view method_name, Buffer::InstancePtr&& request,
                                        RawAsyncRequestCallbacks& callbacks,
@@ -92,8 +102,8 @@ RawAsyncStream* AsyncClientImpl::startRaw(absl::string_view service_full_name,
 AsyncStreamImpl::AsyncStreamImpl(AsyncClientImpl& parent, absl::string_view service_full_name,
                                  absl::string_view method_name, RawAsyncStreamCallbacks& callbacks,
                                  const Http::AsyncClient::StreamOptions& options)
-    : parent_(parent), service_full_name_(service_full_name), method_name_(method_name),
-      callbacks_(callbacks), options_(options) {
+    : parent_(parent), path_(parent.path(service_full_name, method_name)), callbacks_(callbacks),
+      options_(options) {
   // Apply parent retry policy if no per-stream override.
   if (!options.retry_policy.has_value() && parent_.retryPolicy().has_value()) {
     options_.setRetryPolicy(*parent_.retryPolicy());
@@ -158,8 +168,8 @@ void AsyncStreamImpl::initialize(bool buffer_body_for_retry) {
   // TODO(htuch): match Google gRPC base64 encoding behavior for *-bin headers, see
   // https://github.com/envoyproxy/envoy/pull/2444#discussion_r163914459.
   headers_message_ = Common::prepareHeaders(
-      parent_.host_name_.empty() ? parent_.remote_cluster_name_ : parent_.host_name_,
-      service_full_name_, method_name_, options_.timeout);
+      parent_.host_name_.empty() ? parent_.remote_cluster_name_ : parent_.host_name_, path_,
+      options_.timeout);
   // Fill service-wide initial metadata.
   // TODO(cpakulski): Find a better way to access requestHeaders
   // request headers should not be stored in stream_info.
@@ -14,6 +14,9 @@
 #include "source/common/http/async_client_impl.h"
 #include "source/common/router/header_parser.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_map.h"
+
 namespace Envoy {
 namespace Grpc {
 
@@ -48,6 +51,9 @@ protected:
                   TimeSource& time_source, absl::Status& creation_status);
 
 private:
+  // @return the :path of the requests to the method, built on first use.
+  const std::string& path(absl::string_view service_full_name, absl::string_view method_name);
+
   const uint32_t max_recv_message_length_;
   const bool skip_envoy_headers_;
   Upstream::ClusterManager& cm_;
@@ -59,6 +65,9 @@ private:
   Router::HeaderParserPtr metadata_parser_;
   // Default per service retry policy.
   absl::optional<envoy::config::route::v3::RetryPolicy> retry_policy_;
+  // The paths of the methods called so far, by service and method name. Side-calls go to a handful
+  // of methods, so they are kept for the lifetime of the client rather than built for each call.
+  absl::flat_hash_map<std::string, absl::node_hash_map<std::string, std::string>> paths_;
 
   friend class AsyncRequestImpl;
   friend class AsyncStreamImpl;
@@ -122,8 +131,8 @@ private:
   Event::Dispatcher* dispatcher_{};
   Http::RequestMessagePtr headers_message_;
   AsyncClientImpl& parent_;
-  std::string service_full_name_;
-  std::string method_name_;
+  // Owned by the parent.
+  const std::string& path_;
   Tracing::SpanPtr current_span_;
 
   RawAsyncStreamCallbacks& callbacks_;
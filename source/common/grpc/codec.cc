@@ -1,11 +1,13 @@
 #include "source/common/grpc/codec.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <memory>
 #include <vector>
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/assert.h"
 
 #include "absl/container/fixed_array.h"
 
@@ -35,8 +37,29 @@ absl::Status Decoder::decode(Buffer::Instance& input, std::vector<Frame>& output
   // Make sure those flags are set to initial state.
   decoding_error_ = false;
   is_frame_oversized_ = false;
-  output_ = &output;
+
+  // Checks the frame headers first, without decoding the frames, so that the frame data can be
+  // moved out of the input rather than copied when the whole input is valid.
+  const State state = state_;
+  const uint32_t length = length_;
+  const uint64_t count = count_;
+  validating_ = true;
   inspect(input);
+  validating_ = false;
+  const bool valid = !decoding_error_ && !is_frame_oversized_;
+  state_ = state;
+  length_ = length;
+  count_ = count;
+  decoding_error_ = false;
+  is_frame_oversized_ = false;
+
+  output_ = &output;
+  if (valid) {
+    moveFrames(input);
+  } else {
+    // Decodes the frames preceding the error, leaving the input unchanged.
+    inspect(input);
+  }
   output_ = nullptr;
 
   if (decoding_error_) {
@@ -51,24 +74,62 @@ absl::Status Decoder::decode(Buffer::Instance& input, std::vector<Frame>& output
   return absl::OkStatus();
 }
 
+void Decoder::moveFrames(Buffer::Instance& input) {
+  while (input.length() > 0) {
+    if (state_ == State::Data) {
+      const uint64_t length = std::min<uint64_t>(length_, input.length());
+      frame_.data_->move(input, length);
+      length_ -= length;
+      if (length_ == 0) {
+        frameDataEnd();
+        state_ = State::FhFlag;
+      }
+      continue;
+    }
+
+    // Only the rest of the frame header is inspected, which stops at the start of the frame data.
+    // The states of the frame header are in order, from FhFlag at the start of the header.
+    const uint64_t header_length =
+        std::min<uint64_t>(GRPC_FRAME_HEADER_SIZE - static_cast<uint64_t>(state_), input.length());
+    std::array<uint8_t, GRPC_FRAME_HEADER_SIZE> header;
+    input.copyOut(0, header_length, header.data());
+    uint64_t delta = 0;
+    const bool inspected = inspectSlice(header.data(), header_length, delta);
+    ASSERT(inspected);
+    input.drain(header_length);
+  }
+}
+
 bool Decoder::frameStart(uint8_t flags) {
   // Unsupported flags.
   if (flags & ~GRPC_FH_COMPRESSED) {
     decoding_error_ = true;
     return false;
   }
-  frame_.flags_ = flags;
+  if (!validating_) {
+    frame_.flags_ = flags;
+  }
   return true;
 }
 
 void Decoder::frameDataStart() {
+  if (validating_) {
+    return;
+  }
   frame_.length_ = length_;
   frame_.data_ = std::make_unique<Buffer::OwnedImpl>();
 }
 
-void Decoder::frameData(uint8_t* mem, uint64_t length) { frame_.data_->add(mem, length); }
+void Decoder::frameData(uint8_t* mem, uint64_t length) {
+  if (!validating_) {
+    frame_.data_->add(mem, length);
+  }
+}
 
 void Decoder::frameDataEnd() {
+  if (validating_) {
+    return;
+  }
   output_->push_back(std::move(frame_));
   frame_.flags_ = 0;
   frame_.length_ = 0;
@@ -78,74 +139,80 @@ void Decoder::frameDataEnd() {
 uint64_t FrameInspector::inspect(const Buffer::Instance& data) {
   uint64_t delta = 0;
   for (const Buffer::RawSlice& slice : data.getRawSlices()) {
-    uint8_t* mem = reinterpret_cast<uint8_t*>(slice.mem_);
-    uint8_t* end = mem + slice.len_;
-    while (mem < end) {
-      uint8_t c = *mem;
-      switch (state_) {
-      case State::FhFlag:
-        if (!frameStart(c)) {
-          return delta;
-        }
-        count_ += 1;
-        delta += 1;
-        state_ = State::FhLen0;
-        mem++;
-        break;
-      case State::FhLen0:
-        length_as_bytes_[0] = c;
-        state_ = State::FhLen1;
-        mem++;
-        break;
-      case State::FhLen1:
-        length_as_bytes_[1] = c;
-        state_ = State::FhLen2;
-        mem++;
-        break;
-      case State::FhLen2:
-        length_as_bytes_[2] = c;
-        state_ = State::FhLen3;
-        mem++;
-        break;
-      case State::FhLen3:
-        length_as_bytes_[3] = c;
-        length_ = absl::big_endian::Load32(length_as_bytes_);
-        // Compares the frame length against maximum length when `max_frame_length_` is configured,
-        if (max_frame_length_ != 0 && length_ > max_frame_length_) {
-          // Set the flag to indicate the over-limit error and return.
-          is_frame_oversized_ = true;
-          return delta;
-        }
-        frameDataStart();
-        if (length_ == 0) {
-          frameDataEnd();
-          state_ = State::FhFlag;
-        } else {
-          state_ = State::Data;
-        }
-        mem++;
-        break;
-      case State::Data:
-        uint64_t remain_in_buffer = end - mem;
-        if (remain_in_buffer <= length_) {
-          frameData(mem, remain_in_buffer);
-          mem += remain_in_buffer;
-          length_ -= remain_in_buffer;
-        } else {
-          frameData(mem, length_);
-          mem += length_;
-          length_ = 0;
-        }
-        if (length_ == 0) {
-          frameDataEnd();
-          state_ = State::FhFlag;
-        }
-        break;
-      }
+    if (!inspectSlice(reinterpret_cast<uint8_t*>(slice.mem_), slice.len_, delta)) {
+      break;
     }
   }
   return delta;
 }
 
+bool FrameInspector::inspectSlice(uint8_t* mem, uint64_t length, uint64_t& delta) {
+  uint8_t* end = mem + length;
+  while (mem < end) {
+    uint8_t c = *mem;
+    switch (state_) {
+    case State::FhFlag:
+      if (!frameStart(c)) {
+        return false;
+      }
+      count_ += 1;
+      delta += 1;
+      state_ = State::FhLen0;
+      mem++;
+      break;
+    case State::FhLen0:
+      length_as_bytes_[0] = c;
+      state_ = State::FhLen1;
+      mem++;
+      break;
+    case State::FhLen1:
+      length_as_bytes_[1] = c;
+      state_ = State::FhLen2;
+      mem++;
+      break;
+    case State::FhLen2:
+      length_as_bytes_[2] = c;
+      state_ = State::FhLen3;
+      mem++;
+      break;
+    case State::FhLen3:
+      length_as_bytes_[3] = c;
+      length_ = absl::big_endian::Load32(length_as_bytes_);
+      // Compares the frame length against maximum length when `max_frame_length_` is configured,
+      if (max_frame_length_ != 0 && length_ > max_frame_length_) {
+        // Set the flag to indicate the over-limit error and return.
+        is_frame_oversized_ = true;
+        return false;
+      }
+      frameDataStart();
+      if (length_ == 0) {
+        frameDataEnd();
+        state_ = State::FhFlag;
+      } else {
+        state_ = State::Data;
+      }
+      mem++;
+      break;
+    case State::Data:
+      uint64_t remain_in_buffer = end - mem;
+      if (remain_in_buffer <= length_) {
+        frameData(mem, remain_in_buffer);
+        mem += remain_in_buffer;
+        length_ -= remain_in_buffer;
+      } else {
+        frameData(mem, length_);
+        mem += length_;
+        length_ = 0;
+      }
+      if (length_ == 0) {
+        frameDataEnd();
+        state_ = State::FhFlag;
+      }
+      break;
+    }
+  }
+  return true;
+}
+
 } // namespace Grpc
 } // namespace Envoy
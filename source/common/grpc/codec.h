@@ -99,6 +99,10 @@ public:
   virtual ~FrameInspector() = default;
 
 protected:
+  // Inspects the given bytes, as inspect() does for each slice of its input.
+  // Returns false if the inspector aborted.
+  bool inspectSlice(uint8_t* mem, uint64_t length, uint64_t& delta);
+
   virtual bool frameStart(uint8_t) { return true; }
   virtual void frameDataStart() {}
   virtual void frameData(uint8_t*, uint64_t) {}
@@ -149,9 +153,14 @@ protected:
   void frameDataEnd() override;
 
 private:
+  // Decodes the frames of a valid input, moving the frame data out of it.
+  void moveFrames(Buffer::Instance& input);
+
   Frame frame_;
   std::vector<Frame>* output_{nullptr};
   bool decoding_error_{false};
+  // Whether the frame headers are only checked, without decoding the frames.
+  bool validating_{false};
 };
 
 } // namespace Grpc
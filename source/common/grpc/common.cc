@@ -271,9 +271,15 @@ Http::RequestMessagePtr
 Common::prepareHeaders(absl::string_view host_name, absl::string_view service_full_name,
                        absl::string_view method_name,
                        const absl::optional<std::chrono::milliseconds>& timeout) {
+  return prepareHeaders(host_name, absl::StrCat("/", service_full_name, "/", method_name), timeout);
+}
+
+Http::RequestMessagePtr
+Common::prepareHeaders(absl::string_view host_name, absl::string_view path,
+                       const absl::optional<std::chrono::milliseconds>& timeout) {
   Http::RequestMessagePtr message(new Http::RequestMessageImpl());
   message->headers().setReferenceMethod(Http::Headers::get().MethodValues.Post);
-  message->headers().setPath(absl::StrCat("/", service_full_name, "/", method_name));
+  message->headers().setPath(path);
   message->headers().setHost(host_name);
   // According to https://github.com/grpc/grpc/blob/master/doc/PROTOCOL-HTTP2.md TE should appear
   // before Timeout and ContentType.
@@ -177,6 +177,14 @@ public:
                  absl::string_view method_name,
                  const absl::optional<std::chrono::milliseconds>& timeout);
 
+  /**
+   * Prepare headers for protobuf service, given the path "/<service_full_name>/<method_name>" of
+   * the method.
+   */
+  static Http::RequestMessagePtr
+  prepareHeaders(absl::string_view upstream_cluster, absl::string_view path,
+                 const absl::optional<std::chrono::milliseconds>& timeout);
+
   /**
    * @return const std::string& type URL prefix.
    */
@@ -63,13 +63,16 @@ struct BufferInstanceContainer {
 };
 
 grpc::ByteBuffer GoogleGrpcUtils::makeByteBuffer(Buffer::InstancePtr&& buffer_instance) {
-  if (!buffer_instance) {
+  if (!buffer_instance || buffer_instance->length() == 0) {
     return {};
   }
-  Buffer::RawSliceVector raw_slices = buffer_instance->getRawSlices();
-  if (raw_slices.empty()) {
-    return {};
+  if (buffer_instance->length() <= MaxCopiedSize) {
+    char data[MaxCopiedSize];
+    buffer_instance->copyOut(0, buffer_instance->length(), data);
+    grpc::Slice slice(data, buffer_instance->length());
+    return {&slice, 1};
   }
+  Buffer::RawSliceVector raw_slices = buffer_instance->getRawSlices();
 
   auto* container =
       new BufferInstanceContainer{static_cast<int>(raw_slices.size()), std::move(buffer_instance)};
@@ -108,7 +111,11 @@ Buffer::InstancePtr GoogleGrpcUtils::makeBufferInstance(const grpc::ByteBuffer&
   }
 
   for (auto& slice : slices) {
-    buffer->addBufferFragment(*new GrpcSliceBufferFragmentImpl(std::move(slice)));
+    if (slice.size() <= MaxCopiedSize) {
+      buffer->add(slice.begin(), slice.size());
+    } else {
+      buffer->addBufferFragment(*new GrpcSliceBufferFragmentImpl(std::move(slice)));
+    }
   }
   return buffer;
 }
@@ -15,8 +15,13 @@ namespace Grpc {
 
 class GoogleGrpcUtils {
 public:
+  // Data up to this size is copied between grpc::ByteBuffer and Buffer::Instance rather than
+  // aliased, as the copy is cheaper than the allocations which tie the lifetimes together.
+  static constexpr uint64_t MaxCopiedSize = 512;
+
   /**
-   * Build grpc::ByteBuffer which aliases the data in a Buffer::InstancePtr.
+   * Build grpc::ByteBuffer which aliases the data in a Buffer::InstancePtr, or holds a copy of the
+   * data if it is at most MaxCopiedSize bytes.
    * @param buffer source data container.
    * @return byteBuffer target container aliased to the data in Buffer::Instance and owning the
    * Buffer::Instance.
@@ -24,7 +29,8 @@ public:
   static grpc::ByteBuffer makeByteBuffer(Buffer::InstancePtr&& buffer);
 
   /**
-   * Build Buffer::Instance which aliases the data in a grpc::ByteBuffer.
+   * Build Buffer::Instance which aliases the data in a grpc::ByteBuffer. The grpc::Slice(s) of at
+   * most MaxCopiedSize bytes are copied.
    * @param buffer source data container.
    * @return a Buffer::InstancePtr aliased to the data in the provided grpc::ByteBuffer and
    * owning the corresponding grpc::Slice(s) or nullptr if the grpc::ByteBuffer is bad.
@@ -86,6 +86,7 @@ namespace Http {
   GAUGE(downstream_cx_http1_soft_drain, Accumulate)                                                \
   GAUGE(downstream_rq_active, Accumulate)                                                          \
   HISTOGRAM(downstream_cx_length_ms, Milliseconds)                                                 \
+  HISTOGRAM(downstream_rq_buffer_peak_bytes, Bytes)                                                \
   HISTOGRAM(downstream_rq_time, Milliseconds)
 
 /**
@@ -560,6 +561,11 @@ public:
    *         Connection Lifetime.
    */
   virtual bool addProxyProtocolConnectionState() const PURE;
+
+  /**
+   * @return whether to measure the CPU time spent in the filter chain of each stream.
+   */
+  virtual bool trackCpuTime() const PURE;
 };
 
 using ConnectionManagerConfigSharedPtr = std::shared_ptr<ConnectionManagerConfig>;
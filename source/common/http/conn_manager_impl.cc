@@ -48,6 +48,7 @@
 #include "source/common/router/config_impl.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/stats/timespan_impl.h"
+#include "source/common/stream_info/uint64_accessor_impl.h"
 #include "source/common/stream_info/utility.h"
 
 #include "absl/strings/escaping.h"
@@ -847,6 +848,10 @@ ConnectionManagerImpl::ActiveStream::ActiveStream(ConnectionManagerImpl& connect
   filter_manager_.streamInfo().setShouldSchemeMatchUpstream(
       connection_manager.config_->shouldSchemeMatchUpstream());
 
+  if (connection_manager_.config_->trackCpuTime()) {
+    filter_manager_.trackCpuTime();
+  }
+
   // TODO(chaoqin-li1123): can this be moved to the on demand filter?
   auto factory = Envoy::Config::Utility::getFactoryByName<RouteConfigUpdateRequesterFactory>(
       kRouteFactoryName);
@@ -954,6 +959,16 @@ void ConnectionManagerImpl::ActiveStream::log(AccessLog::AccessLogType type) {
 void ConnectionManagerImpl::ActiveStream::completeRequest() {
   filter_manager_.streamInfo().onRequestComplete();
 
+  // The account only exists if the buffer memory of the streams is tracked, and it's charged for
+  // the buffers of both the downstream and the upstream streams.
+  if (const auto account = filter_manager_.account(); account != nullptr) {
+    const uint64_t peak_bytes = account->peakBalance();
+    connection_manager_.stats_.named_.downstream_rq_buffer_peak_bytes_.recordValue(peak_bytes);
+    filter_manager_.streamInfo().filterState()->setData(
+        BufferPeakBytesFilterStateKey, std::make_shared<StreamInfo::UInt64AccessorImpl>(peak_bytes),
+        StreamInfo::FilterState::StateType::ReadOnly, StreamInfo::FilterState::LifeSpan::Request);
+  }
+
   connection_manager_.stats_.named_.downstream_rq_active_.dec();
   if (filter_manager_.streamInfo().healthCheck()) {
     connection_manager_.config_->tracingStats().health_check_.inc();
@@ -974,6 +989,15 @@ void ConnectionManagerImpl::ActiveStream::resetIdleTimer() {
     // TODO(htuch): If this shows up in performance profiles, optimize by only
     // updating a timestamp here and doing periodic checks for idle timeouts
     // instead, or reducing the accuracy of timers.
+    if (state_.successful_upgrade_) {
+      // Upgraded streams may carry many small messages in each event loop iteration, and
+      // rescheduling the timer again within an iteration would barely move its deadline.
+      const MonotonicTime now = connection_manager_.dispatcher_->approximateMonotonicTime();
+      if (idle_timer_reset_time_ == now) {
+        return;
+      }
+      idle_timer_reset_time_ = now;
+    }
     stream_idle_timer_->enableTimer(idle_timeout_ms_);
   }
 }
@@ -2146,6 +2170,7 @@ void ConnectionManagerImpl::ActiveStream::refreshIdleTimeout() {
     const Router::RouteEntry* route_entry = cached_route_.value()->routeEntry();
     if (route_entry != nullptr && route_entry->idleTimeout()) {
       idle_timeout_ms_ = route_entry->idleTimeout().value();
+      idle_timer_reset_time_.reset();
       response_encoder_->getStream().setFlushTimeout(idle_timeout_ms_);
       if (idle_timeout_ms_.count()) {
         // If we have a route-level idle timeout but no global stream idle timeout, create a timer.
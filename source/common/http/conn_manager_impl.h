@@ -52,6 +52,9 @@
 namespace Envoy {
 namespace Http {
 
+constexpr absl::string_view BufferPeakBytesFilterStateKey =
+    "envoy.filters.network.http_connection_manager.buffer_peak_bytes";
+
 /**
  * Implementation of both ConnectionManager and ServerConnectionCallbacks. This is a
  * Network::Filter that can be installed on a connection that will perform HTTP protocol agnostic
@@ -476,6 +479,8 @@ private:
     Event::TimerPtr access_log_flush_timer_;
 
     std::chrono::milliseconds idle_timeout_ms_{};
+    // The approximate time at which the idle timer of an upgraded stream was last rescheduled.
+    absl::optional<MonotonicTime> idle_timer_reset_time_;
     State state_;
 
     // Snapshot of the route configuration at the time of request is started. This is used to ensure
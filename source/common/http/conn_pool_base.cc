@@ -64,6 +64,18 @@ HttpConnPoolImplBase::newStream(Http::ResponseDecoder& response_decoder,
   return newStreamImpl(context, options.can_send_early_data_);
 }
 
+Envoy::ConnectionPool::ActiveClient* HttpConnPoolImplBase::clientForReplaySafeStream() {
+  if (pipelining_disabled_ || host_->cluster().http1Settings().max_requests_in_flight_ < 2) {
+    return nullptr;
+  }
+  for (auto& client : busy_clients_) {
+    if (static_cast<ActiveClient&>(*client).allowPipelinedStream()) {
+      return client.get();
+    }
+  }
+  return nullptr;
+}
+
 bool HttpConnPoolImplBase::hasActiveConnections() const {
   return (hasPendingStreams() || (hasActiveStreams()));
 }
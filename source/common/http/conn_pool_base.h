@@ -84,6 +84,7 @@ public:
   }
   void onPoolReady(Envoy::ConnectionPool::ActiveClient& client,
                    Envoy::ConnectionPool::AttachContext& context) override;
+  Envoy::ConnectionPool::ActiveClient* clientForReplaySafeStream() override;
 
   virtual CodecClientPtr createCodecClient(Upstream::Host::CreateConnectionData& data) PURE;
   Random::RandomGenerator& randomGenerator() { return random_generator_; }
@@ -91,6 +92,9 @@ public:
   virtual absl::optional<HttpServerPropertiesCache::Origin>& origin() { return origin_; }
   virtual Http::HttpServerPropertiesCacheSharedPtr cache() { return nullptr; }
 
+  // Stops pipelining streams on the connections of this pool, after pipelined streams failed.
+  void disablePipelining() { pipelining_disabled_ = true; }
+
 protected:
   friend class ActiveClient;
 
@@ -100,6 +104,7 @@ protected:
 
 private:
   absl::optional<HttpServerPropertiesCache::Origin> origin_;
+  bool pipelining_disabled_{};
 };
 
 // An implementation of Envoy::ConnectionPool::ActiveClient for HTTP/1.1 and HTTP/2
@@ -144,6 +149,9 @@ public:
   }
   uint32_t numActiveStreams() const override { return codec_client_->numActiveRequests(); }
   uint64_t id() const override { return codec_client_->id(); }
+  // Allows one more stream on this busy client ahead of the completion of its current streams,
+  // if the protocol of the client and its current streams allow it.
+  virtual bool allowPipelinedStream() { return false; }
   HttpConnPoolImplBase& parent() { return *static_cast<HttpConnPoolImplBase*>(&parent_); }
 
   Http::CodecClientPtr codec_client_;
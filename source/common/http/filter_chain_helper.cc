@@ -18,6 +18,7 @@ namespace Http {
 void FilterChainUtility::createFilterChainForFactories(
     Http::FilterChainManager& manager, const FilterChainOptions& options,
     const FilterFactoriesList& filter_factories) {
+  manager.reserveFilters(filter_factories.size());
   bool added_missing_config_filter = false;
   for (const auto& filter_config_provider : filter_factories) {
     // If this filter is disabled explicitly, skip trying to create it.
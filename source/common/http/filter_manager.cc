@@ -1,5 +1,6 @@
 #include "source/common/http/filter_manager.h"
 
+#include <ctime>
 #include <functional>
 
 #include "envoy/http/header_map.h"
@@ -45,8 +46,32 @@ void recordLatestDataFilter(typename Filters::Iterator current_filter,
   }
 }
 
+// Returns the CPU time which the calling thread has used so far.
+std::chrono::nanoseconds threadCpuTime() {
+#ifdef WIN32
+  return std::chrono::nanoseconds(0);
+#else
+  struct timespec now;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+  return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+#endif
+}
+
 } // namespace
 
+FilterManager::ScopedCpuTimeTracker::ScopedCpuTimeTracker(FilterManager& manager)
+    : manager_(manager) {
+  if (manager_.track_cpu_time_ && manager_.cpu_time_tracker_depth_++ == 0) {
+    start_ = threadCpuTime();
+  }
+}
+
+FilterManager::ScopedCpuTimeTracker::~ScopedCpuTimeTracker() {
+  if (manager_.track_cpu_time_ && --manager_.cpu_time_tracker_depth_ == 0) {
+    manager_.streamInfo().downstreamTiming().addCpuTime(threadCpuTime() - start_);
+  }
+}
+
 void ActiveStreamFilterBase::commonContinue() {
   if (!canContinue()) {
     ENVOY_STREAM_LOG(trace, "cannot continue filter chain: filter={}", *this,
@@ -522,6 +547,14 @@ void FilterManager::applyFilterFactoryCb(FilterContext context, FilterFactoryCb&
   factory(callbacks);
 }
 
+void FilterManager::reserveFilters(size_t count) {
+  // Most filter factories add a single filter, which is usually both a decoder and an encoder one,
+  // so this avoids growing the containers of the filters one filter at a time.
+  filters_.reserve(filters_.size() + count);
+  decoder_filters_.entries_.reserve(decoder_filters_.entries_.size() + count);
+  encoder_filters_.entries_.reserve(encoder_filters_.entries_.size() + count);
+}
+
 void FilterManager::maybeContinueDecoding(StreamDecoderFilters::Iterator continue_data_entry) {
   if (continue_data_entry != decoder_filters_.end()) {
     // We use the continueDecoding() code since it will correctly handle not calling
@@ -536,6 +569,7 @@ void FilterManager::maybeContinueDecoding(StreamDecoderFilters::Iterator continu
 
 void FilterManager::decodeHeaders(ActiveStreamDecoderFilter* filter, RequestHeaderMap& headers,
                                   bool end_stream) {
+  ScopedCpuTimeTracker cpu_time_tracker(*this);
   // Headers filter iteration should always start with the next filter if available.
   StreamDecoderFilters::Iterator entry =
       commonDecodePrefix(filter, FilterIterationStartState::AlwaysStartFromNext);
@@ -638,6 +672,7 @@ void FilterManager::decodeHeaders(ActiveStreamDecoderFilter* filter, RequestHead
 void FilterManager::decodeData(ActiveStreamDecoderFilter* filter, Buffer::Instance& data,
                                bool end_stream,
                                FilterIterationStartState filter_iteration_start_state) {
+  ScopedCpuTimeTracker cpu_time_tracker(*this);
   ScopeTrackerScopeState scope(this, dispatcher_);
   filter_manager_callbacks_.resetIdleTimer();
 
@@ -794,6 +829,7 @@ void FilterManager::addDecodedData(ActiveStreamDecoderFilter& filter, Buffer::In
 MetadataMapVector& FilterManager::addDecodedMetadata() { return *getRequestMetadataMapVector(); }
 
 void FilterManager::decodeTrailers(ActiveStreamDecoderFilter* filter, RequestTrailerMap& trailers) {
+  ScopedCpuTimeTracker cpu_time_tracker(*this);
   // If a response is complete or a reset has been sent, filters do not care about further body
   // data. Just drop it.
   if (stopDecoderFilterChain()) {
@@ -841,6 +877,7 @@ void FilterManager::decodeTrailers(ActiveStreamDecoderFilter* filter, RequestTra
 }
 
 void FilterManager::decodeMetadata(ActiveStreamDecoderFilter* filter, MetadataMap& metadata_map) {
+  ScopedCpuTimeTracker cpu_time_tracker(*this);
   ScopeTrackerScopeState scope(&*this, dispatcher_);
   filter_manager_callbacks_.resetIdleTimer();
 
@@ -1172,6 +1209,7 @@ void DownstreamFilterManager::sendDirectLocalReply(
 
 void FilterManager::encode1xxHeaders(ActiveStreamEncoderFilter* filter,
                                      ResponseHeaderMap& headers) {
+  ScopedCpuTimeTracker cpu_time_tracker(*this);
   filter_manager_callbacks_.resetIdleTimer();
   ASSERT(proxy_100_continue_);
   // The caller must guarantee that encode1xxHeaders() is invoked at most once.
@@ -1224,6 +1262,7 @@ void FilterManager::maybeContinueEncoding(StreamEncoderFilters::Iterator continu
 
 void FilterManager::encodeHeaders(ActiveStreamEncoderFilter* filter, ResponseHeaderMap& headers,
                                   bool end_stream) {
+  ScopedCpuTimeTracker cpu_time_tracker(*this);
   // See encodeHeaders() comments in envoy/http/filter.h for why the 1xx precondition holds.
   ASSERT(!CodeUtility::is1xx(Utility::getResponseStatus(headers)) ||
          Utility::getResponseStatus(headers) == enumToInt(Http::Code::SwitchingProtocols));
@@ -1315,6 +1354,7 @@ void FilterManager::encodeHeaders(ActiveStreamEncoderFilter* filter, ResponseHea
 
 void FilterManager::encodeMetadata(ActiveStreamEncoderFilter* filter,
                                    MetadataMapPtr&& metadata_map_ptr) {
+  ScopedCpuTimeTracker cpu_time_tracker(*this);
   filter_manager_callbacks_.resetIdleTimer();
 
   StreamEncoderFilters::Iterator entry =
@@ -1401,6 +1441,7 @@ void FilterManager::addEncodedData(ActiveStreamEncoderFilter& filter, Buffer::In
 void FilterManager::encodeData(ActiveStreamEncoderFilter* filter, Buffer::Instance& data,
                                bool end_stream,
                                FilterIterationStartState filter_iteration_start_state) {
+  ScopedCpuTimeTracker cpu_time_tracker(*this);
   filter_manager_callbacks_.resetIdleTimer();
 
   // Filter iteration may start at the current filter.
@@ -1475,6 +1516,7 @@ void FilterManager::encodeData(ActiveStreamEncoderFilter* filter, Buffer::Instan
 
 void FilterManager::encodeTrailers(ActiveStreamEncoderFilter* filter,
                                    ResponseTrailerMap& trailers) {
+  ScopedCpuTimeTracker cpu_time_tracker(*this);
   filter_manager_callbacks_.resetIdleTimer();
 
   // Filter iteration may start at the current filter.
@@ -1674,8 +1716,6 @@ FilterManager::createFilterChain(const FilterChainFactory& filter_chain_factory)
     }
   });
 
-  // TODO(wbpcode): reserve memory for filters to avoid frequent reallocation.
-
   OptRef<DownstreamStreamFilterCallbacks> downstream_callbacks =
       filter_manager_callbacks_.downstreamCallbacks();
 
@@ -714,6 +714,7 @@ public:
 
   // FilterChainManager
   void applyFilterFactoryCb(FilterContext context, FilterFactoryCb& factory) override;
+  void reserveFilters(size_t count) override;
 
   void log(const Formatter::HttpFormatterContext log_context) {
     for (const auto& log_handler : access_log_handlers_) {
@@ -904,6 +905,12 @@ public:
 
   void contextOnContinue(ScopeTrackedObjectStack& tracked_object_stack);
 
+  /**
+   * Measures the CPU time spent in the filter chain, and adds it to the downstream timing of the
+   * stream info.
+   */
+  void trackCpuTime() { track_cpu_time_ = true; }
+
   void onDownstreamReset() { state_.saw_downstream_reset_ = true; }
   bool sawDownstreamReset() { return state_.saw_downstream_reset_; }
 
@@ -1119,6 +1126,8 @@ private:
   Buffer::InstancePtr buffered_request_data_;
   uint32_t buffer_limit_{0};
   uint32_t high_watermark_count_{0};
+  bool track_cpu_time_{};
+  uint32_t cpu_time_tracker_depth_{0};
   std::list<DownstreamWatermarkCallbacks*> watermark_callbacks_;
   Network::Socket::OptionsSharedPtr upstream_options_ =
       std::make_shared<Network::Socket::Options>();
@@ -1130,6 +1139,18 @@ private:
   friend ActiveStreamDecoderFilter;
   friend ActiveStreamEncoderFilter;
 
+  // Adds the CPU time which the thread spends in its scope to the stream info, if tracked. Scopes
+  // nest, e.g. when a decoder filter sends a local reply, and only the outermost one is timed.
+  class ScopedCpuTimeTracker {
+  public:
+    explicit ScopedCpuTimeTracker(FilterManager& manager);
+    ~ScopedCpuTimeTracker();
+
+  private:
+    FilterManager& manager_;
+    std::chrono::nanoseconds start_{};
+  };
+
   /**
    * Flags that keep track of which filter calls are currently in progress.
    */
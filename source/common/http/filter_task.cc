@@ -0,0 +1,76 @@
+#include "source/common/http/filter_task.h"
+
+#include <array>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace Envoy {
+namespace Http {
+
+namespace {
+
+constexpr size_t SizeClassBytes = 64;
+constexpr size_t SizeClasses = 16;
+constexpr uint32_t MaxCachedFramesPerSizeClass = 64;
+
+struct FreeFrame {
+  FreeFrame* next_;
+};
+
+struct FrameCache {
+  ~FrameCache() {
+    for (FreeFrame* frame : free_frames_) {
+      while (frame != nullptr) {
+        ::operator delete(std::exchange(frame, frame->next_));
+      }
+    }
+  }
+
+  std::array<FreeFrame*, SizeClasses> free_frames_{};
+  std::array<uint32_t, SizeClasses> cached_frames_{};
+};
+
+FrameCache& frameCache() {
+  static thread_local FrameCache cache;
+  return cache;
+}
+
+size_t sizeClass(size_t size) { return (size + SizeClassBytes - 1) / SizeClassBytes - 1; }
+
+} // namespace
+
+void* FilterTaskFrameAllocator::allocate(size_t size) {
+  const size_t size_class = sizeClass(size);
+  if (size_class >= SizeClasses) {
+    return ::operator new(size);
+  }
+  FrameCache& cache = frameCache();
+  FreeFrame* frame = cache.free_frames_[size_class];
+  if (frame == nullptr) {
+    return ::operator new((size_class + 1) * SizeClassBytes);
+  }
+  cache.free_frames_[size_class] = frame->next_;
+  --cache.cached_frames_[size_class];
+  return frame;
+}
+
+void FilterTaskFrameAllocator::deallocate(void* frame, size_t size) {
+  const size_t size_class = sizeClass(size);
+  if (size_class >= SizeClasses) {
+    ::operator delete(frame);
+    return;
+  }
+  FrameCache& cache = frameCache();
+  if (cache.cached_frames_[size_class] >= MaxCachedFramesPerSizeClass) {
+    ::operator delete(frame);
+    return;
+  }
+  // Frames may be freed on another thread than the one that allocated them, in which case they're
+  // cached by the thread freeing them, as all the frames of a size class have the same size.
+  cache.free_frames_[size_class] = new (frame) FreeFrame{cache.free_frames_[size_class]};
+  ++cache.cached_frames_[size_class];
+}
+
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <utility>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/non_copyable.h"
+
+#include "absl/functional/any_invocable.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * Allocator of the frames of filter tasks, which keeps a bounded thread local cache of the freed
+ * frames of each size class, so that the frames of the tasks of a worker are reused instead of
+ * going through the allocator for each stream. Frames larger than the largest size class aren't
+ * cached.
+ */
+class FilterTaskFrameAllocator {
+public:
+  static void* allocate(size_t size);
+  static void deallocate(void* frame, size_t size);
+};
+
+/**
+ * A coroutine running the asynchronous work of a filter, e.g.
+ *
+ *   FilterTask MyFilter::authorize() {
+ *     const auto response = co_await AsyncCall<Response>([this](auto done) {
+ *       return client_->check(request_, std::move(done));
+ *     });
+ *     ...
+ *   }
+ *
+ *   Http::FilterHeadersStatus MyFilter::decodeHeaders(Http::RequestHeaderMap&, bool) {
+ *     task_ = authorize();
+ *     if (task_.done()) {
+ *       return Http::FilterHeadersStatus::Continue;
+ *     }
+ *     task_.onAsyncCompletion([this]() { decoder_callbacks_->continueDecoding(); });
+ *     return Http::FilterHeadersStatus::StopAllIterationAndWatermark;
+ *   }
+ *
+ * The coroutine starts running when it's called, until it completes or waits for an asynchronous
+ * call. Destroying the task destroys the coroutine, which cancels the asynchronous call it waits
+ * for, if any, so that a filter cancels all its asynchronous work by destroying its task in
+ * onDestroy().
+ */
+class FilterTask {
+public:
+  struct promise_type;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Handle handle) noexcept {
+      // The callback may destroy the task, and with it the frame, so it's moved out of the frame
+      // before running.
+      absl::AnyInvocable<void()> callback = std::move(handle.promise().on_async_completion_);
+      if (callback) {
+        callback();
+      }
+    }
+    void await_resume() const noexcept {}
+  };
+
+  struct promise_type {
+    FilterTask get_return_object() { return FilterTask(Handle::from_promise(*this)); }
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void return_void() const {}
+    void unhandled_exception() const { PANIC("unhandled exception in a filter task"); }
+
+    static void* operator new(size_t size) { return FilterTaskFrameAllocator::allocate(size); }
+    static void operator delete(void* frame, size_t size) {
+      FilterTaskFrameAllocator::deallocate(frame, size);
+    }
+
+    absl::AnyInvocable<void()> on_async_completion_;
+  };
+
+  FilterTask() = default;
+  FilterTask(const FilterTask&) = delete;
+  FilterTask& operator=(const FilterTask&) = delete;
+  FilterTask(FilterTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+  FilterTask& operator=(FilterTask&& other) noexcept {
+    if (this != &other) {
+      reset();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+  ~FilterTask() { reset(); }
+
+  /**
+   * @return whether the coroutine completed, or there is none.
+   */
+  bool done() const { return handle_ == nullptr || handle_.done(); }
+
+  /**
+   * Sets the callback run when the coroutine completes, which must still be running or waiting.
+   * The callback may destroy the task.
+   */
+  void onAsyncCompletion(absl::AnyInvocable<void()> callback) {
+    ASSERT(!done());
+    handle_.promise().on_async_completion_ = std::move(callback);
+  }
+
+  /**
+   * Destroys the coroutine, cancelling the asynchronous call it waits for, if any.
+   */
+  void reset() {
+    if (handle_ != nullptr) {
+      std::exchange(handle_, nullptr).destroy();
+    }
+  }
+
+private:
+  explicit FilterTask(Handle handle) : handle_(handle) {}
+
+  Handle handle_;
+};
+
+/**
+ * Awaits an asynchronous call from a filter task.
+ *
+ * The call is started with a function that it must call with the result once, possibly before
+ * returning, and it returns a function cancelling the call, after which the function mustn't be
+ * called. The call is cancelled if the task is destroyed while waiting for it.
+ */
+template <class T> class AsyncCall : NonCopyable {
+public:
+  using Done = absl::AnyInvocable<void(T)>;
+  using CancelFunction = absl::AnyInvocable<void()>;
+  using Start = absl::AnyInvocable<CancelFunction(Done)>;
+
+  explicit AsyncCall(Start start) : start_(std::move(start)) {}
+  ~AsyncCall() {
+    if (cancel_) {
+      cancel_();
+    }
+  }
+
+  bool await_ready() const { return false; }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    CancelFunction cancel = start_([this, handle](T result) {
+      result_.emplace(std::move(result));
+      cancel_ = nullptr;
+      if (suspended_) {
+        handle.resume();
+      }
+    });
+    if (result_.has_value()) {
+      // Completed before returning, keep running the coroutine.
+      return false;
+    }
+    cancel_ = std::move(cancel);
+    suspended_ = true;
+    return true;
+  }
+
+  T await_resume() { return std::move(*result_); }
+
+private:
+  Start start_;
+  CancelFunction cancel_;
+  absl::optional<T> result_;
+  bool suspended_{};
+};
+
+} // namespace Http
+} // namespace Envoy
@@ -67,6 +67,7 @@ public:
   const LowerCaseString AltSvc{"alt-svc"};
   const LowerCaseString Authentication{"authentication"};
   const LowerCaseString Authorization{"authorization"};
+  const LowerCaseString AvailableDictionary{"available-dictionary"};
   const LowerCaseString CacheControl{"cache-control"};
   const LowerCaseString CacheStatus{"cache-status"};
   const LowerCaseString CdnLoop{"cdn-loop"};
@@ -112,6 +113,7 @@ public:
 
   struct {
     const std::string Brotli{"br"};
+    const std::string DictionaryZstd{"dcz"};
     const std::string Gzip{"gzip"};
     const std::string Zstd{"zstd"};
   } ContentEncodingValues;
@@ -126,6 +128,7 @@ public:
 
   struct {
     const std::string AcceptEncoding{"Accept-Encoding"};
+    const std::string AvailableDictionary{"Available-Dictionary"};
     const std::string Wildcard{"*"};
   } VaryValues;
 };
@@ -265,6 +268,7 @@ public:
     const std::string GrpcWebText{"application/grpc-web-text"};
     const std::string GrpcWebTextProto{"application/grpc-web-text+proto"};
     const std::string Json{"application/json"};
+    const std::string OctetStream{"application/octet-stream"};
     const std::string Protobuf{"application/x-protobuf"};
     const std::string FormUrlEncoded{"application/x-www-form-urlencoded"};
     const std::string Thrift{"application/x-thrift"};
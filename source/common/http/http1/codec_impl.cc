@@ -1,5 +1,7 @@
 #include "source/common/http/http1/codec_impl.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -88,6 +90,44 @@ StatefulHeaderKeyFormatterPtr statefulFormatterFromSettings(const Http::Http1Set
 
 constexpr size_t CRLF_SIZE = 2;
 
+constexpr absl::string_view RESPONSE_PREFIX = "HTTP/1.1 ";
+constexpr absl::string_view HTTP_10_RESPONSE_PREFIX = "HTTP/1.0 ";
+
+// Pre-serialized status lines, e.g. "HTTP/1.1 200 OK\r\n", for the status codes that have a
+// standard reason phrase. Encoding the status line of a response is then a single copy instead of
+// formatting the code and looking up the reason phrase for every response.
+class StatusLines {
+public:
+  StatusLines() {
+    for (uint64_t code = MinCode; code < MaxCode; ++code) {
+      const absl::string_view reason_phrase = CodeUtility::toString(static_cast<Code>(code));
+      if (reason_phrase == "Unknown") {
+        continue;
+      }
+      http11_[code - MinCode] = absl::StrCat(RESPONSE_PREFIX, code, " ", reason_phrase, "\r\n");
+      http10_[code - MinCode] =
+          absl::StrCat(HTTP_10_RESPONSE_PREFIX, code, " ", reason_phrase, "\r\n");
+    }
+  }
+
+  // @return the status line, or an empty view if the code has no standard reason phrase.
+  absl::string_view get(bool http10, uint64_t code) const {
+    if (code < MinCode || code >= MaxCode) {
+      return {};
+    }
+    return http10 ? http10_[code - MinCode] : http11_[code - MinCode];
+  }
+
+private:
+  static constexpr uint64_t MinCode = 100;
+  static constexpr uint64_t MaxCode = 600;
+
+  std::array<std::string, MaxCode - MinCode> http11_;
+  std::array<std::string, MaxCode - MinCode> http10_;
+};
+
+const StatusLines& statusLines() { CONSTRUCT_ON_FIRST_USE(StatusLines); }
+
 } // namespace
 
 static constexpr absl::string_view CRLF = "\r\n";
@@ -395,9 +435,6 @@ const Network::ConnectionInfoProvider& StreamEncoderImpl::connectionInfoProvider
   return connection_.connection().connectionInfoProvider();
 }
 
-static constexpr absl::string_view RESPONSE_PREFIX = "HTTP/1.1 ";
-static constexpr absl::string_view HTTP_10_RESPONSE_PREFIX = "HTTP/1.0 ";
-
 void ResponseEncoderImpl::encodeHeaders(const ResponseHeaderMap& headers, bool end_stream) {
   started_response_ = true;
 
@@ -405,26 +442,31 @@ void ResponseEncoderImpl::encodeHeaders(const ResponseHeaderMap& headers, bool e
   ASSERT(headers.Status() != nullptr);
   uint64_t numeric_status = Utility::getResponseStatus(headers);
 
-  absl::string_view response_prefix;
-  if (connection_.protocol() == Protocol::Http10 && connection_.supportsHttp10()) {
-    response_prefix = HTTP_10_RESPONSE_PREFIX;
-  } else {
-    response_prefix = RESPONSE_PREFIX;
-  }
+  const bool http10 = connection_.protocol() == Protocol::Http10 && connection_.supportsHttp10();
 
   StatefulHeaderKeyFormatterOptConstRef formatter(headers.formatter());
 
-  absl::string_view reason_phrase;
-  if (formatter.has_value() && !formatter->getReasonPhrase().empty()) {
-    reason_phrase = formatter->getReasonPhrase();
-  } else {
-    const char* status_string = CodeUtility::toString(static_cast<Code>(numeric_status));
-    uint32_t status_string_len = strlen(status_string);
-    reason_phrase = {status_string, status_string_len};
+  absl::string_view status_line;
+  if (!formatter.has_value() || formatter->getReasonPhrase().empty()) {
+    status_line = statusLines().get(http10, numeric_status);
   }
 
-  connection_.buffer().addFragments(
-      {response_prefix, absl::StrCat(numeric_status), SPACE, reason_phrase, CRLF});
+  if (!status_line.empty()) {
+    connection_.buffer().add(status_line);
+  } else {
+    absl::string_view reason_phrase;
+    if (formatter.has_value() && !formatter->getReasonPhrase().empty()) {
+      reason_phrase = formatter->getReasonPhrase();
+    } else {
+      const char* status_string = CodeUtility::toString(static_cast<Code>(numeric_status));
+      uint32_t status_string_len = strlen(status_string);
+      reason_phrase = {status_string, status_string_len};
+    }
+
+    connection_.buffer().addFragments(
+        {http10 ? HTTP_10_RESPONSE_PREFIX : RESPONSE_PREFIX, absl::StrCat(numeric_status), SPACE,
+         reason_phrase, CRLF});
+  }
 
   if (numeric_status >= 300) {
     // Don't do special CONNECT logic if the CONNECT was rejected.
@@ -505,6 +547,20 @@ Status RequestEncoderImpl::encodeHeaders(const RequestHeaderMap& headers, bool e
   return okStatus();
 }
 
+void RequestEncoderImpl::resetStream(StreamResetReason reason) {
+  if (connection_.resetStreamCalled()) {
+    // The requests pipelined on the connection are reset along with the first request that is
+    // reset, whose callbacks may reset them again.
+    runResetCallbacks(reason, absl::string_view());
+    return;
+  }
+  // Request encoders are only created by client connections.
+  if (static_cast<ClientConnectionImpl&>(connection_).orphanRequest(*this, reason)) {
+    return;
+  }
+  StreamEncoderImpl::resetStream(reason);
+}
+
 CallbackResult ConnectionImpl::setAndCheckCallbackStatus(Status&& status) {
   ASSERT(codec_status_.ok());
   codec_status_ = std::move(status);
@@ -631,6 +687,15 @@ void ConnectionImpl::onDispatch(const Buffer::Instance& data) {
 
 Http::Status ClientConnectionImpl::dispatch(Buffer::Instance& data) {
   Http::Status status = ConnectionImpl::dispatch(data);
+  // The responses to pipelined requests may follow the complete response.
+  while (status.ok() && data.length() > 0 && !pending_responses_.empty() &&
+         connection_.state() == Network::Connection::State::Open) {
+    const uint64_t length = data.length();
+    status = ConnectionImpl::dispatch(data);
+    if (data.length() == length) {
+      break;
+    }
+  }
   if (status.ok() && data.length() > 0) {
     // The HTTP/1.1 codec pauses dispatch after a single response is complete. Extraneous data
     // after a response is complete indicates an error.
@@ -1043,9 +1108,9 @@ void ClientConnectionImpl::dumpAdditionalState(std::ostream& os, int indent_leve
 
   // Dump the associated request.
   os << spaces << "Dumping corresponding downstream request:";
-  if (pending_response_.has_value()) {
+  if (!pending_responses_.empty()) {
     os << '\n';
-    const ResponseDecoder* decoder = pending_response_.value().decoder_;
+    const ResponseDecoder* decoder = pending_responses_.front().decoder_;
     DUMP_DETAILS(decoder);
   } else {
     os << " null\n";
@@ -1450,7 +1515,7 @@ ClientConnectionImpl::ClientConnectionImpl(Network::Connection& connection, Code
 }
 
 bool ClientConnectionImpl::cannotHaveBody() {
-  if (pending_response_.has_value() && pending_response_.value().encoder_.headRequest()) {
+  if (!pending_responses_.empty() && pending_responses_.front().encoder_.headRequest()) {
     ASSERT(!pending_response_done_);
     return true;
   } else if (parser_->statusCode() == Http::Code::NoContent ||
@@ -1465,15 +1530,47 @@ bool ClientConnectionImpl::cannotHaveBody() {
 }
 
 RequestEncoder& ClientConnectionImpl::newStream(ResponseDecoder& response_decoder) {
-  // If reads were disabled due to flow control, we expect reads to always be enabled again before
-  // reusing this connection. This is done when the response is received.
-  ASSERT(connection_.readEnabled());
-
-  ASSERT(!pending_response_.has_value());
-  ASSERT(pending_response_done_);
-  pending_response_.emplace(*this, std::move(bytes_meter_before_stream_), &response_decoder);
-  pending_response_done_ = false;
-  return pending_response_.value().encoder_;
+  // If responses are pending, the request is pipelined behind them. Callers only do so once the
+  // previous request is fully sent.
+  const bool pipelined = !pending_responses_.empty();
+  if (!pipelined) {
+    // If reads were disabled due to flow control, we expect reads to always be enabled again
+    // before reusing this connection. This is done when the response is received.
+    ASSERT(connection_.readEnabled());
+    ASSERT(pending_response_done_);
+    pending_response_done_ = false;
+  }
+  pending_responses_.emplace_back(*this, std::move(bytes_meter_before_stream_), &response_decoder,
+                                  pipelined);
+  return pending_responses_.back().encoder_;
+}
+
+bool ClientConnectionImpl::orphanRequest(RequestEncoderImpl& encoder, StreamResetReason reason) {
+  if (reason != StreamResetReason::LocalReset ||
+      connection_.state() != Network::Connection::State::Open) {
+    return false;
+  }
+  auto orphaned = std::find_if(
+      pending_responses_.begin(), pending_responses_.end(),
+      [&encoder](const PendingResponse& response) { return &response.encoder_ == &encoder; });
+  if (orphaned == pending_responses_.end() || !orphaned->encode_complete_ ||
+      orphaned->decoder_ == nullptr ||
+      (orphaned == pending_responses_.begin() && pending_response_done_)) {
+    return false;
+  }
+  // The connection is only kept for the responses that are still wanted.
+  const bool others_pending = std::any_of(
+      pending_responses_.begin(), pending_responses_.end(), [&](const PendingResponse& response) {
+        return &response != &*orphaned && response.decoder_ != nullptr &&
+               (&response != &pending_responses_.front() || !pending_response_done_);
+      });
+  if (!others_pending) {
+    return false;
+  }
+  ENVOY_CONN_LOG(debug, "discarding the response of a reset pipelined request", connection_);
+  orphaned->decoder_ = nullptr;
+  encoder.runResetCallbacks(reason, absl::string_view());
+  return true;
 }
 
 Status ClientConnectionImpl::onStatusBase(const char* data, size_t length) {
@@ -1492,9 +1589,9 @@ Envoy::StatusOr<CallbackResult> ClientConnectionImpl::onHeadersCompleteBase() {
   // Handle the case where the client is closing a kept alive connection (by sending a 408
   // with a 'Connection: close' header). In this case we just let response flush out followed
   // by the remote close.
-  if (!pending_response_.has_value() && !resetStreamCalled()) {
+  if (pending_responses_.empty() && !resetStreamCalled()) {
     return prematureResponseError("", parser_->statusCode());
-  } else if (pending_response_.has_value()) {
+  } else if (!pending_responses_.empty()) {
     ASSERT(!pending_response_done_);
     auto& headers = absl::get<ResponseHeaderMapPtr>(headers_or_trailers_);
     ENVOY_CONN_LOG(trace, "Client: onHeadersComplete size={}", connection_, headers->size());
@@ -1502,7 +1599,7 @@ Envoy::StatusOr<CallbackResult> ClientConnectionImpl::onHeadersCompleteBase() {
 
     if (parser_->statusCode() >= Http::Code::OK &&
         parser_->statusCode() < Http::Code::MultipleChoices &&
-        pending_response_.value().encoder_.connectRequest()) {
+        pending_responses_.front().encoder_.connectRequest()) {
       ENVOY_CONN_LOG(trace, "codec entering upgrade mode for CONNECT response.", connection_);
       handling_upgrade_ = true;
     }
@@ -1528,12 +1625,16 @@ Envoy::StatusOr<CallbackResult> ClientConnectionImpl::onHeadersCompleteBase() {
       }
     }
 
+    // The response of an orphaned request is discarded.
+    ResponseDecoder* decoder = pending_responses_.front().decoder_;
     if (HeaderUtility::isSpecial1xx(*headers)) {
-      pending_response_.value().decoder_->decode1xxHeaders(std::move(headers));
+      if (decoder != nullptr) {
+        decoder->decode1xxHeaders(std::move(headers));
+      }
     } else if (cannotHaveBody() && !handling_upgrade_) {
       deferred_end_stream_headers_ = true;
-    } else {
-      pending_response_.value().decoder_->decodeHeaders(std::move(headers), false);
+    } else if (decoder != nullptr) {
+      decoder->decodeHeaders(std::move(headers), false);
     }
 
     // http-parser treats 1xx headers as their own complete response. Swallow the spurious
@@ -1554,17 +1655,17 @@ Envoy::StatusOr<CallbackResult> ClientConnectionImpl::onHeadersCompleteBase() {
 }
 
 bool ClientConnectionImpl::upgradeAllowed() const {
-  if (pending_response_.has_value()) {
-    return pending_response_->encoder_.upgradeRequest();
+  if (!pending_responses_.empty()) {
+    return pending_responses_.front().encoder_.upgradeRequest();
   }
   return false;
 }
 
 void ClientConnectionImpl::onBody(Buffer::Instance& data) {
   ASSERT(!deferred_end_stream_headers_);
-  if (pending_response_.has_value()) {
+  if (!pending_responses_.empty() && pending_responses_.front().decoder_ != nullptr) {
     ASSERT(!pending_response_done_);
-    pending_response_.value().decoder_->decodeData(data, false);
+    pending_responses_.front().decoder_->decodeData(data, false);
   }
 }
 
@@ -1574,15 +1675,18 @@ CallbackResult ClientConnectionImpl::onMessageCompleteBase() {
     ignore_message_complete_for_1xx_ = false;
     return CallbackResult::Success;
   }
-  if (pending_response_.has_value()) {
+  if (!pending_responses_.empty()) {
     ASSERT(!pending_response_done_);
     // After calling decodeData() with end stream set to true, we should no longer be able to reset.
-    PendingResponse& response = pending_response_.value();
-    // Encoder is used as part of decode* calls later in this function so pending_response_ can not
-    // be reset just yet. Preserve the state in pending_response_done_ instead.
+    PendingResponse& response = pending_responses_.front();
+    // Encoder is used as part of decode* calls later in this function so the response can not
+    // be removed just yet. Preserve the state in pending_response_done_ instead.
     pending_response_done_ = true;
 
-    if (deferred_end_stream_headers_) {
+    if (response.decoder_ == nullptr) {
+      // The response of an orphaned request is discarded.
+      deferred_end_stream_headers_ = false;
+    } else if (deferred_end_stream_headers_) {
       response.decoder_->decodeHeaders(
           std::move(absl::get<ResponseHeaderMapPtr>(headers_or_trailers_)), true);
       deferred_end_stream_headers_ = false;
@@ -1604,8 +1708,11 @@ CallbackResult ClientConnectionImpl::onMessageCompleteBase() {
                                           absl::string_view());
     }
 
-    // Reset to ensure no information from one requests persists to the next.
-    pending_response_.reset();
+    // Reset to ensure no information from one requests persists to the next. The callbacks may
+    // have reset the requests pipelined behind this one, but not this one.
+    ASSERT(&pending_responses_.front() == &response);
+    pending_responses_.pop_front();
+    pending_response_done_ = pending_responses_.empty();
     headers_or_trailers_.emplace<ResponseHeaderMapPtr>(nullptr);
   }
 
@@ -1614,32 +1721,49 @@ CallbackResult ClientConnectionImpl::onMessageCompleteBase() {
 }
 
 void ClientConnectionImpl::onResetStream(StreamResetReason reason) {
-  // Only raise reset if we did not already dispatch a complete response.
-  if (pending_response_.has_value() && !pending_response_done_) {
-    pending_response_.value().encoder_.runResetCallbacks(reason, absl::string_view());
-    pending_response_done_ = true;
-    pending_response_.reset();
+  // Only raise reset if we did not already dispatch a complete response. The pipelined requests
+  // are reset too, as the connection can not be used anymore. Those whose response has not
+  // started are refused, so that they may be sent again on another connection.
+  auto first_reset = pending_responses_.begin();
+  if (first_reset != pending_responses_.end() && pending_response_done_) {
+    ++first_reset;
+  }
+  std::list<PendingResponse> reset_responses;
+  reset_responses.splice(reset_responses.end(), pending_responses_, first_reset,
+                         pending_responses_.end());
+  pending_response_done_ = true;
+  for (PendingResponse& response : reset_responses) {
+    const bool refused = response.pipelined_ && !response.response_started_;
+    response.encoder_.runResetCallbacks(
+        refused ? StreamResetReason::RemoteRefusedStreamReset : reason, absl::string_view());
   }
 }
 
 Status ClientConnectionImpl::sendProtocolError(absl::string_view details) {
-  if (pending_response_.has_value()) {
+  if (!pending_responses_.empty()) {
     ASSERT(!pending_response_done_);
-    pending_response_.value().encoder_.setDetails(details);
+    pending_responses_.front().encoder_.setDetails(details);
   }
   return okStatus();
 }
 
 void ClientConnectionImpl::onAboveHighWatermark() {
   // This should never happen without an active stream/request.
-  pending_response_.value().encoder_.runHighWatermarkCallbacks();
+  for (PendingResponse& response : pending_responses_) {
+    if (response.decoder_ != nullptr) {
+      response.encoder_.runHighWatermarkCallbacks();
+    }
+  }
 }
 
 void ClientConnectionImpl::onBelowLowWatermark() {
   // This can get called without an active stream/request when the response completion causes us to
   // close the connection, but in doing so go below low watermark.
-  if (pending_response_.has_value() && !pending_response_done_) {
-    pending_response_.value().encoder_.runLowWatermarkCallbacks();
+  for (PendingResponse& response : pending_responses_) {
+    if (response.decoder_ != nullptr &&
+        (&response != &pending_responses_.front() || !pending_response_done_)) {
+      response.encoder_.runLowWatermarkCallbacks();
+    }
   }
 }
 
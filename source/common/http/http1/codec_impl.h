@@ -200,6 +200,9 @@ public:
   void encodeTrailers(const RequestTrailerMap& trailers) override { encodeTrailersBase(trailers); }
   void enableTcpTunneling() override { is_tcp_tunneling_ = true; }
 
+  // Http::Stream
+  void resetStream(StreamResetReason reason) override;
+
 private:
   bool upgrade_request_{};
   bool head_request_{};
@@ -234,6 +237,7 @@ public:
    * fire any more callbacks in case some stack has to unwind.
    */
   void onResetStreamBase(StreamResetReason reason);
+  bool resetStreamCalled() { return reset_stream_called_; }
 
   /**
    * Flush all pending output from encoding.
@@ -279,8 +283,6 @@ protected:
   ConnectionImpl(Network::Connection& connection, CodecStats& stats, const Http1Settings& settings,
                  MessageType type, uint32_t max_headers_kb, const uint32_t max_headers_count);
 
-  bool resetStreamCalled() { return reset_stream_called_; }
-
   // This must be protected because it is called through ServerConnectionImpl::sendProtocolError.
   Status onMessageBeginImpl();
 
@@ -595,13 +597,25 @@ public:
   // Http::ClientConnection
   RequestEncoder& newStream(ResponseDecoder& response_decoder) override;
 
+  /**
+   * Resets a request without resetting the connection if it was fully sent and the responses of
+   * other requests are pending on the connection. Its response is then read and discarded.
+   * @return whether the request was reset this way.
+   */
+  bool orphanRequest(RequestEncoderImpl& encoder, StreamResetReason reason);
+
 private:
   struct PendingResponse {
     PendingResponse(ConnectionImpl& connection, StreamInfo::BytesMeterSharedPtr&& bytes_meter,
-                    ResponseDecoder* decoder)
-        : encoder_(connection, std::move(bytes_meter)), decoder_(decoder) {}
+                    ResponseDecoder* decoder, bool pipelined)
+        : encoder_(connection, std::move(bytes_meter)), decoder_(decoder), pipelined_(pipelined) {}
     RequestEncoderImpl encoder_;
+    // Null once the request is orphaned, so that its response is discarded.
     ResponseDecoder* decoder_;
+    // Whether the request was sent before the response to the previous request was received.
+    const bool pipelined_;
+    bool encode_complete_{};
+    bool response_started_{};
   };
 
   bool cannotHaveBody();
@@ -618,17 +632,27 @@ private:
   Status onStatusBase(const char* data, size_t length) override;
   // ConnectionImpl
   Http::Status dispatch(Buffer::Instance& data) override;
-  void onEncodeComplete() override { encode_complete_ = true; }
+  void onEncodeComplete() override {
+    encode_complete_ = true;
+    if (!pending_responses_.empty()) {
+      pending_responses_.back().encode_complete_ = true;
+    }
+  }
   StreamInfo::BytesMeter& getBytesMeter() override {
-    if (pending_response_.has_value()) {
-      return *(pending_response_->encoder_.getStream().bytesMeter());
+    if (!pending_responses_.empty()) {
+      return *(pending_responses_.front().encoder_.getStream().bytesMeter());
     }
     if (bytes_meter_before_stream_ == nullptr) {
       bytes_meter_before_stream_ = std::make_shared<StreamInfo::BytesMeter>();
     }
     return *bytes_meter_before_stream_;
   }
-  Status onMessageBeginBase() override { return okStatus(); }
+  Status onMessageBeginBase() override {
+    if (!pending_responses_.empty()) {
+      pending_responses_.front().response_started_ = true;
+    }
+    return okStatus();
+  }
   Envoy::StatusOr<CallbackResult> onHeadersCompleteBase() override;
   bool upgradeAllowed() const override;
   void onBody(Buffer::Instance& data) override;
@@ -667,12 +691,14 @@ private:
   // buffer. This buffer is always allocated, never nullptr.
   Buffer::InstancePtr owned_output_buffer_;
 
-  absl::optional<PendingResponse> pending_response_;
-  // TODO(mattklein123): The following bool tracks whether a pending response is complete before
-  // dispatching callbacks. This is needed so that pending_response_ stays valid during callbacks
+  // The responses to the requests sent on this connection, in order. The first one is being
+  // received, and the others are those of pipelined requests.
+  std::list<PendingResponse> pending_responses_;
+  // TODO(mattklein123): The following bool tracks whether the first pending response is complete
+  // before dispatching callbacks. This is needed so that the response stays valid during callbacks
   // in order to access the stream, but to avoid invoking callbacks that shouldn't be called once
   // the response is complete. The existence of this variable is hard to reason about and it should
-  // be combined with pending_response_ somehow in a follow up cleanup.
+  // be combined with pending_responses_ somehow in a follow up cleanup.
   bool pending_response_done_{true};
   // Set true between receiving non-101 1xx headers and receiving the spurious onMessageComplete.
   bool ignore_message_complete_for_1xx_{};
@@ -1,5 +1,6 @@
 #include "source/common/http/http1/conn_pool.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -15,6 +16,7 @@
 #include "source/common/http/codes.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/http/headers.h"
+#include "source/common/http/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
 #include "absl/strings/match.h"
@@ -25,7 +27,8 @@ namespace Http1 {
 
 ActiveClient::StreamWrapper::StreamWrapper(ResponseDecoder& response_decoder, ActiveClient& parent)
     : RequestEncoderWrapper(&parent.codec_client_->newStream(*this)),
-      ResponseDecoderWrapper(response_decoder), parent_(parent) {
+      ResponseDecoderWrapper(response_decoder), parent_(parent),
+      start_time_(parent.parent_.dispatcher().timeSource().monotonicTime()) {
   RequestEncoderWrapper::inner_encoder_->getStream().addCallbacks(*this);
 }
 
@@ -34,6 +37,13 @@ ActiveClient::StreamWrapper::~StreamWrapper() {
   // here to attach pending requests in next dispatcher loop to handle that case.
   // https://github.com/envoyproxy/envoy/issues/2715
   parent_.parent_.onStreamClosed(parent_, true);
+  parent_.lowerConcurrentStreamLimit();
+}
+
+Status ActiveClient::StreamWrapper::encodeHeaders(const RequestHeaderMap& headers,
+                                                  bool end_stream) {
+  pipelinable_ = Utility::isSafeRequest(headers) && !Utility::isUpgrade(headers);
+  return RequestEncoderWrapper::encodeHeaders(headers, end_stream);
 }
 
 void ActiveClient::StreamWrapper::onEncodeComplete() { encode_complete_ = true; }
@@ -59,15 +69,48 @@ void ActiveClient::StreamWrapper::onDecodeComplete() {
     ENVOY_CONN_LOG(debug, "saw upstream close connection", *parent_.codec_client_);
     parent_.codec_client_->close();
   } else {
-    auto* pool = &parent_.parent();
+    // Responses arrive in the order of the requests, so the streams ahead of this one were
+    // orphaned, and their responses were discarded.
+    ActiveClient& client = parent_;
+    auto* pool = &client.parent();
     pool->scheduleOnUpstreamReady();
-    parent_.stream_wrapper_.reset();
-
+    while (client.streams_.front().get() != this) {
+      ASSERT(client.streams_.front()->orphaned_);
+      StreamWrapperPtr orphaned = std::move(client.streams_.front());
+      client.streams_.pop_front();
+    }
+    StreamWrapperPtr self = std::move(client.streams_.front());
+    client.streams_.pop_front();
+    self.reset();
+
+    if (!client.streams_.empty() &&
+        std::all_of(client.streams_.begin(), client.streams_.end(),
+                    [](const StreamWrapperPtr& stream) { return stream->orphaned_; })) {
+      // No stream waits for the responses left on the connection.
+      ENVOY_CONN_LOG(debug, "only discarded responses pending", *client.codec_client_);
+      client.codec_client_->close();
+      return;
+    }
     pool->checkForIdleAndCloseIdleConnsIfDraining();
   }
 }
 
-void ActiveClient::StreamWrapper::onResetStream(StreamResetReason, absl::string_view) {
+void ActiveClient::StreamWrapper::onResetStream(StreamResetReason reason, absl::string_view) {
+  // This matches ClientConnectionImpl::orphanRequest(), which keeps the connection for the other
+  // streams when a fully sent stream is reset locally.
+  if (reason == StreamResetReason::LocalReset && encode_complete_ &&
+      parent_.hasOtherPendingResponse(*this)) {
+    ENVOY_CONN_LOG(debug, "pipelined stream reset, discarding its response",
+                   *parent_.codec_client_);
+    orphaned_ = true;
+    return;
+  }
+  if (reason == StreamResetReason::ProtocolError && parent_.streams_.size() > 1) {
+    // The upstream may not handle pipelined requests, so the pool stops sending them.
+    ENVOY_CONN_LOG(debug, "protocol error with pipelined streams, disabling pipelining",
+                   *parent_.codec_client_);
+    parent_.parent().disablePipelining();
+  }
   parent_.codec_client_->close();
 }
 
@@ -79,16 +122,70 @@ ActiveClient::ActiveClient(HttpConnPoolImplBase& parent,
   parent.host()->cluster().trafficStats()->upstream_cx_http1_total_.inc();
 }
 
-ActiveClient::~ActiveClient() { ASSERT(!stream_wrapper_.get()); }
+ActiveClient::~ActiveClient() { ASSERT(streams_.empty()); }
 
 bool ActiveClient::closingWithIncompleteStream() const {
-  return (stream_wrapper_ != nullptr) && (!stream_wrapper_->decode_complete_);
+  return std::any_of(streams_.begin(), streams_.end(), [](const StreamWrapperPtr& stream) {
+    return !stream->decode_complete_ && !stream->orphaned_;
+  });
+}
+
+bool ActiveClient::hasOtherPendingResponse(const StreamWrapper& stream) const {
+  return std::any_of(streams_.begin(), streams_.end(), [&stream](const StreamWrapperPtr& other) {
+    return other.get() != &stream && !other->orphaned_ && !other->decode_complete_;
+  });
 }
 
 RequestEncoder& ActiveClient::newStreamEncoder(ResponseDecoder& response_decoder) {
-  ASSERT(!stream_wrapper_);
-  stream_wrapper_ = std::make_unique<StreamWrapper>(response_decoder, *this);
-  return *stream_wrapper_;
+  ASSERT(streams_.empty() || streams_.back()->encode_complete_);
+  if (!streams_.empty()) {
+    parent().host()->cluster().trafficStats()->upstream_rq_pipelined_.inc();
+  }
+  streams_.push_back(std::make_unique<StreamWrapper>(response_decoder, *this));
+  return *streams_.back();
+}
+
+bool ActiveClient::allowPipelinedStream() {
+  const Http1Settings& settings = parent().host()->cluster().http1Settings();
+  if (state() != State::Busy || streams_.empty() ||
+      streams_.size() >= settings.max_requests_in_flight_ || codec_client_->remoteClosed()) {
+    return false;
+  }
+  // Requests are only pipelined behind complete requests which are safe to send again, and which
+  // leave the connection to HTTP/1.1.
+  for (const StreamWrapperPtr& stream : streams_) {
+    if (!stream->encode_complete_ || !stream->pipelinable_ || stream->close_connection_) {
+      return false;
+    }
+  }
+  // Nothing more waits behind a response which is already slow.
+  if (parent_.dispatcher().timeSource().monotonicTime() - streams_.front()->start_time_ >=
+      settings.pipelining_head_of_line_timeout_) {
+    return false;
+  }
+  setConcurrentStreamLimit(streams_.size() + 1);
+  return true;
+}
+
+void ActiveClient::setConcurrentStreamLimit(uint32_t limit) {
+  const int64_t old_unused_capacity = currentUnusedCapacity();
+  concurrent_stream_limit_ = limit;
+  const int64_t delta = old_unused_capacity - currentUnusedCapacity();
+  if (delta > 0) {
+    parent_.decrClusterStreamCapacity(delta);
+  } else if (delta < 0) {
+    parent_.incrClusterStreamCapacity(-delta);
+  }
+}
+
+void ActiveClient::lowerConcurrentStreamLimit() {
+  if (concurrent_stream_limit_ == 1 || state() == State::Closed) {
+    return;
+  }
+  setConcurrentStreamLimit(std::max<uint32_t>(streams_.size(), 1));
+  if (state() == State::Ready && currentUnusedCapacity() <= 0) {
+    parent_.transitionActiveClientState(*this, State::Busy);
+  }
 }
 
 ConnectionPool::InstancePtr
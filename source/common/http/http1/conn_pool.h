@@ -1,5 +1,7 @@
 #pragma once
 
+#include <list>
+
 #include "envoy/event/timer.h"
 #include "envoy/http/codec.h"
 #include "envoy/upstream/upstream.h"
@@ -22,19 +24,29 @@ public:
   // ConnPoolImplBase::ActiveClient
   bool closingWithIncompleteStream() const override;
   RequestEncoder& newStreamEncoder(ResponseDecoder& response_decoder) override;
+  bool readyForStream() const override {
+    // A busy client takes a pipelined stream once allowPipelinedStream() raised its limit.
+    return state() == State::Ready || (state() == State::Busy && currentUnusedCapacity() > 0);
+  }
 
   uint32_t numActiveStreams() const override {
     // Override the parent class using the codec for numActiveStreams.
     // Unfortunately for the HTTP/1 codec, the stream is destroyed before decode
     // is complete, and we must make sure the connection pool does not observe available
     // capacity and assign a new stream before decode is complete.
-    return stream_wrapper_.get() ? 1 : 0;
+    return streams_.size();
   }
   void releaseResources() override {
-    parent_.dispatcher().deferredDelete(std::move(stream_wrapper_));
+    for (StreamWrapperPtr& stream : streams_) {
+      parent_.dispatcher().deferredDelete(std::move(stream));
+    }
+    streams_.clear();
     Envoy::Http::ActiveClient::releaseResources();
   }
 
+  // Envoy::Http::ActiveClient
+  bool allowPipelinedStream() override;
+
   struct StreamWrapper : public RequestEncoderWrapper,
                          public ResponseDecoderWrapper,
                          public StreamCallbacks,
@@ -44,6 +56,9 @@ public:
     StreamWrapper(ResponseDecoder& response_decoder, ActiveClient& parent);
     ~StreamWrapper() override;
 
+    // RequestEncoderWrapper
+    Status encodeHeaders(const RequestHeaderMap& headers, bool end_stream) override;
+
     // StreamEncoderWrapper
     void onEncodeComplete() override;
 
@@ -58,14 +73,31 @@ public:
     void onBelowWriteBufferLowWatermark() override {}
 
     ActiveClient& parent_;
+    const MonotonicTime start_time_;
     bool stream_incomplete_{};
     bool encode_complete_{};
     bool decode_complete_{};
     bool close_connection_{};
+    // Whether requests may be pipelined behind this one: it is safe to send again if the
+    // connection fails, and is not an upgrade, which takes over the connection.
+    bool pipelinable_{};
+    // Set once the stream is reset while other streams wait on the connection. The codec then
+    // discards its response, and the stream is only removed once a later response is received.
+    bool orphaned_{};
   };
   using StreamWrapperPtr = std::unique_ptr<StreamWrapper>;
 
-  StreamWrapperPtr stream_wrapper_;
+  // The streams of this connection in the order of their requests. The first one receives its
+  // response, and the others were pipelined behind it.
+  std::list<StreamWrapperPtr> streams_;
+
+private:
+  // Whether a stream other than the given one still waits for its response.
+  bool hasOtherPendingResponse(const StreamWrapper& stream) const;
+  // Sets the concurrent stream limit and updates the stream capacity of the pool and cluster.
+  void setConcurrentStreamLimit(uint32_t limit);
+  // Lowers the limit raised for a pipelined stream once a stream is closed.
+  void lowerConcurrentStreamLimit();
 };
 
 ConnectionPool::InstancePtr
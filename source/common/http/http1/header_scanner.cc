@@ -0,0 +1,159 @@
+#include "source/common/http/http1/header_scanner.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define ENVOY_HTTP1_HEADER_SCANNER_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ENVOY_HTTP1_HEADER_SCANNER_NEON
+#endif
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+namespace HeaderScanner {
+
+namespace {
+
+using CharTable = std::array<bool, 256>;
+
+template <class Predicate> constexpr CharTable makeCharTable(Predicate predicate) {
+  CharTable table{};
+  for (size_t c = 0; c < table.size(); ++c) {
+    table[c] = predicate(static_cast<uint8_t>(c));
+  }
+  return table;
+}
+
+// Allowed characters for field names according to Section 5.1
+// and for methods according to Section 9.1 of RFC 9110:
+// https://www.rfc-editor.org/rfc/rfc9110.html
+constexpr CharTable TokenTable = makeCharTable([](uint8_t c) {
+  constexpr char punctuation[] = "!#$%&'*+-.^_`|~";
+  for (const char p : punctuation) {
+    if (p != '\0' && c == static_cast<uint8_t>(p)) {
+      return true;
+    }
+  }
+  return ('0' <= c && c <= '9') || ('A' <= c && c <= 'Z') || ('a' <= c && c <= 'z');
+});
+
+constexpr CharTable PathQueryTable =
+    makeCharTable([](uint8_t c) { return c == 9 || c == 12 || ('!' <= c && c <= 126); });
+
+constexpr CharTable CrOrLfTable = makeCharTable([](uint8_t c) { return c == '\r' || c == '\n'; });
+
+bool inTable(const CharTable& table, char c) { return table[static_cast<uint8_t>(c)]; }
+
+bool allInTable(const CharTable& table, const char* begin, const char* end) {
+  return std::all_of(begin, end, [&table](char c) { return inTable(table, c); });
+}
+
+bool anyInTable(const CharTable& table, const char* begin, const char* end) {
+  return std::any_of(begin, end, [&table](char c) { return inTable(table, c); });
+}
+
+#if defined(ENVOY_HTTP1_HEADER_SCANNER_SSE2)
+
+constexpr ptrdiff_t BlockSize = sizeof(__m128i);
+using Block = __m128i;
+
+Block load(const char* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+bool all(Block mask) { return _mm_movemask_epi8(mask) == 0xffff; }
+bool any(Block mask) { return _mm_movemask_epi8(mask) != 0; }
+Block either(Block a, Block b) { return _mm_or_si128(a, b); }
+Block equal(Block block, char c) { return _mm_cmpeq_epi8(block, _mm_set1_epi8(c)); }
+Block setBits(Block block, char bits) { return _mm_or_si128(block, _mm_set1_epi8(bits)); }
+// The comparisons are signed, so bytes of 0x80 and above are never in range. This requires that
+// 0 < low and high < 127.
+Block inRange(Block block, char low, char high) {
+  return _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(low - 1)),
+                       _mm_cmplt_epi8(block, _mm_set1_epi8(high + 1)));
+}
+
+#elif defined(ENVOY_HTTP1_HEADER_SCANNER_NEON)
+
+constexpr ptrdiff_t BlockSize = sizeof(uint8x16_t);
+using Block = uint8x16_t;
+
+Block load(const char* data) { return vld1q_u8(reinterpret_cast<const uint8_t*>(data)); }
+bool all(Block mask) { return vminvq_u8(mask) == 0xff; }
+bool any(Block mask) { return vmaxvq_u8(mask) != 0; }
+Block either(Block a, Block b) { return vorrq_u8(a, b); }
+Block equal(Block block, char c) { return vceqq_u8(block, vdupq_n_u8(c)); }
+Block setBits(Block block, char bits) { return vorrq_u8(block, vdupq_n_u8(bits)); }
+Block inRange(Block block, char low, char high) {
+  return vandq_u8(vcgeq_u8(block, vdupq_n_u8(low)), vcleq_u8(block, vdupq_n_u8(high)));
+}
+
+#endif
+
+#if defined(ENVOY_HTTP1_HEADER_SCANNER_SSE2) || defined(ENVOY_HTTP1_HEADER_SCANNER_NEON)
+#define ENVOY_HTTP1_HEADER_SCANNER_SIMD
+
+// Most field names and methods only contain letters, digits and '-'. Blocks with any other
+// character are checked against the table.
+Block commonTokenChars(Block block) {
+  // Setting 0x20 maps upper case letters to lower case ones, and no other character to a letter.
+  return either(either(inRange(setBits(block, 0x20), 'a', 'z'), inRange(block, '0', '9')),
+                equal(block, '-'));
+}
+
+Block pathQueryChars(Block block) {
+  return either(inRange(block, '!', '~'), either(equal(block, 9), equal(block, 12)));
+}
+
+Block crOrLf(Block block) { return either(equal(block, '\r'), equal(block, '\n')); }
+
+#endif
+
+} // namespace
+
+bool isToken(absl::string_view input) {
+  const char* data = input.data();
+  const char* const end = data + input.size();
+#if defined(ENVOY_HTTP1_HEADER_SCANNER_SIMD)
+  for (; end - data >= BlockSize; data += BlockSize) {
+    if (!all(commonTokenChars(load(data))) && !allInTable(TokenTable, data, data + BlockSize)) {
+      return false;
+    }
+  }
+#endif
+  return allInTable(TokenTable, data, end);
+}
+
+bool isPathQuery(absl::string_view input) {
+  const char* data = input.data();
+  const char* const end = data + input.size();
+#if defined(ENVOY_HTTP1_HEADER_SCANNER_SIMD)
+  for (; end - data >= BlockSize; data += BlockSize) {
+    if (!all(pathQueryChars(load(data)))) {
+      return false;
+    }
+  }
+#endif
+  return allInTable(PathQueryTable, data, end);
+}
+
+bool containsCrOrLf(absl::string_view input) {
+  const char* data = input.data();
+  const char* const end = data + input.size();
+#if defined(ENVOY_HTTP1_HEADER_SCANNER_SIMD)
+  for (; end - data >= BlockSize; data += BlockSize) {
+    if (any(crOrLf(load(data)))) {
+      return true;
+    }
+  }
+#endif
+  return anyInTable(CrOrLfTable, data, end);
+}
+
+} // namespace HeaderScanner
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
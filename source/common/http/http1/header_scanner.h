@@ -0,0 +1,37 @@
+#pragma once
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+
+/**
+ * Scanners for the character classes that the HTTP/1 parser validates in the request line and the
+ * header block. Input is checked 16 bytes at a time with SSE2 on x86-64 and NEON on AArch64, both
+ * of which are part of the baseline instruction set, so no runtime CPU dispatch is needed. The
+ * remainder, and all input on other platforms, is checked with a lookup table.
+ */
+namespace HeaderScanner {
+
+/**
+ * @return whether all characters of the input are token characters as defined by Section 5.6.2 of
+ *         RFC 9110, which are the characters allowed in field names and methods.
+ */
+bool isToken(absl::string_view input);
+
+/**
+ * @return whether all characters of the input are allowed in the path and query of a URL. This
+ *         matches the http-parser library: horizontal tab, form feed and visible ASCII.
+ */
+bool isPathQuery(absl::string_view input);
+
+/**
+ * @return whether the input contains a CR or LF character.
+ */
+bool containsCrOrLf(absl::string_view input);
+
+} // namespace HeaderScanner
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
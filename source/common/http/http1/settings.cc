@@ -41,6 +41,12 @@ Http1Settings parseHttp1Settings(const envoy::config::core::v3::Http1ProtocolOpt
 
   ret.allow_custom_methods_ = config.allow_custom_methods();
 
+  if (config.has_upstream_pipelining()) {
+    ret.max_requests_in_flight_ = config.upstream_pipelining().max_requests_in_flight();
+    ret.pipelining_head_of_line_timeout_ = std::chrono::milliseconds(
+        PROTOBUF_GET_MS_OR_DEFAULT(config.upstream_pipelining(), head_of_line_timeout, 100));
+  }
+
   return ret;
 }
 
@@ -107,6 +107,34 @@ int reasonToReset(StreamResetReason reason) {
 using Http2ResponseCodeDetails = ConstSingleton<Http2ResponseCodeDetailValues>;
 using OnHeaderResult = http2::adapter::Http2VisitorInterface::OnHeaderResult;
 
+namespace {
+
+// The opaque data of the PINGs that measure the bandwidth-delay product. It reads the same in any
+// byte order.
+constexpr uint64_t BdpPingId = 0xbdbdbdbdbdbdbdbd;
+
+// The most slices looked at to end a DATA frame at a slice boundary.
+constexpr uint64_t MaxSlicesPerAlignedDataFrame = 16;
+
+// Returns the largest length, up to `length`, at which `data` ends at a slice boundary, so that
+// the DATA frame payload can be moved to the write buffer without copying part of a slice. Falls
+// back to `length` if that would make the frame less than half as large.
+size_t sliceAlignedLength(const Buffer::Instance& data, size_t length) {
+  if (length == data.length()) {
+    return length;
+  }
+  size_t aligned_length = 0;
+  for (const Buffer::RawSlice& slice : data.getRawSlices(MaxSlicesPerAlignedDataFrame)) {
+    if (aligned_length + slice.len_ > length) {
+      break;
+    }
+    aligned_length += slice.len_;
+  }
+  return aligned_length >= length / 2 ? aligned_length : length;
+}
+
+} // namespace
+
 enum Settings {
   // SETTINGS_HEADER_TABLE_SIZE = 0x01,
   // SETTINGS_ENABLE_PUSH = 0x02,
@@ -244,6 +272,10 @@ http2::adapter::HeaderRep getRep(const HeaderString& str) {
   }
 }
 
+// Whether a header is added to the HPACK dynamic table is decided by the encoder of the codec
+// library, nghttp2 or oghttp2, based on the header name and the value size. http2::adapter::Header
+// carries no per-header indexing hint, so the order and the representation of the headers are the
+// only things under the control of Envoy here.
 std::vector<http2::adapter::Header>
 ConnectionImpl::StreamImpl::buildHeaders(const HeaderMap& headers) {
   std::vector<http2::adapter::Header> out;
@@ -841,7 +873,12 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
                                Random::RandomGenerator& random_generator,
                                const envoy::config::core::v3::Http2ProtocolOptions& http2_options,
                                const uint32_t max_headers_kb, const uint32_t max_headers_count)
-    : stats_(stats), connection_(connection), max_headers_kb_(max_headers_kb),
+    : align_data_frames_to_slices_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.http2_align_data_frames_to_slices")),
+      connection_window_size_(http2_options.initial_connection_window_size().value()),
+      max_connection_window_size_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(http2_options, max_connection_window_size, 0)),
+      stats_(stats), connection_(connection), max_headers_kb_(max_headers_kb),
       max_headers_count_(max_headers_count),
       per_stream_buffer_limit_(http2_options.initial_stream_window_size().value()),
       stream_error_on_invalid_http_messaging_(
@@ -917,6 +954,37 @@ void ConnectionImpl::onKeepaliveResponse() {
   }
 }
 
+void ConnectionImpl::onDataForWindowTuning(size_t length) {
+  if (connection_window_size_ >= max_connection_window_size_) {
+    return;
+  }
+  bdp_bytes_received_ += length;
+  if (!bdp_ping_outstanding_) {
+    // The bytes received until the ACK are those the peer sent in one round trip.
+    ENVOY_CONN_LOG(trace, "Sending BDP PING", connection_);
+    adapter_->SubmitPing(BdpPingId);
+    bdp_ping_outstanding_ = true;
+    bdp_bytes_received_ = 0;
+  }
+}
+
+void ConnectionImpl::onBdpPingAck() {
+  bdp_ping_outstanding_ = false;
+  // Like gRPC, grow the window to twice the bandwidth-delay product once the peer sends more than
+  // two thirds of the window per round trip, as it is then likely limited by the window.
+  if (bdp_bytes_received_ < connection_window_size_ / 3 * 2) {
+    return;
+  }
+  const uint32_t new_window_size = static_cast<uint32_t>(
+      std::min<uint64_t>(2 * bdp_bytes_received_, max_connection_window_size_));
+  if (new_window_size > connection_window_size_) {
+    ENVOY_CONN_LOG(debug, "growing connection-level window size to {}", connection_,
+                   new_window_size);
+    adapter_->SubmitWindowUpdate(0, new_window_size - connection_window_size_);
+    connection_window_size_ = new_window_size;
+  }
+}
+
 void ConnectionImpl::onKeepaliveResponseTimeout() {
   ENVOY_CONN_LOG_EVENT(debug, "h2_ping_timeout", "Closing connection due to keepalive timeout",
                        connection_);
@@ -1008,6 +1076,7 @@ int ConnectionImpl::onData(int32_t stream_id, const uint8_t* data, size_t len) {
   // If this results in buffering too much data, the watermark buffer will call
   // pendingRecvBufferHighWatermark, resulting in ++read_disable_count_
   stream->pending_recv_data_->add(data, len);
+  onDataForWindowTuning(len);
   // Update the window to the peer unless some consumer of this stream's data has hit a flow control
   // limit and disabled reads on this stream
   if (stream->shouldAllowPeerAdditionalStreamWindow()) {
@@ -1092,6 +1161,10 @@ Status ConnectionImpl::onPing(uint64_t opaque_data, bool is_ack) {
   if (is_ack) {
     ENVOY_CONN_LOG(trace, "recv PING ACK {}", connection_, opaque_data);
 
+    if (bdp_ping_outstanding_ && opaque_data == BdpPingId) {
+      onBdpPingAck();
+      return okStatus();
+    }
     onKeepaliveResponse();
   }
   return okStatus();
@@ -1695,7 +1768,10 @@ ConnectionImpl::Http2Visitor::OnReadyToSendDataForStream(Http2StreamId stream_id
     stream->data_deferred_ = true;
     return {/*payload_length=*/0, /*end_data=*/false, /*end_stream=*/false};
   }
-  const size_t length = std::min<size_t>(max_length, stream->pending_send_data_->length());
+  size_t length = std::min<size_t>(max_length, stream->pending_send_data_->length());
+  if (connection_->align_data_frames_to_slices_) {
+    length = sliceAlignedLength(*stream->pending_send_data_, length);
+  }
   bool end_data = false;
   bool end_stream = false;
   if (stream->local_end_stream_ && length == stream->pending_send_data_->length()) {
@@ -701,6 +701,19 @@ protected:
 
   // Whether to use the new HTTP/2 library.
   bool use_oghttp2_library_;
+  // Whether DATA frames end at slice boundaries of the pending send data where possible.
+  const bool align_data_frames_to_slices_;
+
+  // Grows the connection window to the bandwidth-delay product measured by BDP PINGs.
+  void onDataForWindowTuning(size_t length);
+  void onBdpPingAck();
+
+  // The connection-level receive window, and how large it may grow.
+  uint32_t connection_window_size_;
+  const uint32_t max_connection_window_size_;
+  // The bytes received since the outstanding BDP PING was sent.
+  uint64_t bdp_bytes_received_{};
+  bool bdp_ping_outstanding_{};
 
   // If deferred processing, the streams will be in LRU order based on when the
   // stream encoded to the http2 connection. The LRU property is used when
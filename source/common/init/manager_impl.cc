@@ -29,7 +29,7 @@ void ManagerImpl::add(const Target& target) {
     // it's important in this case that count_ was incremented above before calling the target,
     // because if the target calls the init manager back immediately, count_ will be decremented
     // here (see the definition of watcher_ above).
-    target_handle->initialize(watcher_);
+    initializeTarget(*target_handle);
     return;
   case State::Initialized:
     // If the manager has already completed initialization, consider this a programming error.
@@ -56,7 +56,7 @@ void ManagerImpl::initialize(const Watcher& watcher) {
     // Attempt to initialize each target. If a target is unavailable, treat it as though it
     // completed immediately.
     for (const auto& target_handle : target_handles_) {
-      if (!target_handle->initialize(watcher_)) {
+      if (!initializeTarget(*target_handle)) {
         onTargetReady(target_handle->name());
       }
     }
@@ -77,6 +77,10 @@ void ManagerImpl::onTargetReady(absl::string_view target_name) {
   ASSERT(count_ != 0,
          fmt::format("{} called back by target after initialization complete", target_name));
 
+  if (observer_ != nullptr) {
+    observer_(target_name, TargetEvent::Ready);
+  }
+
   // Decrease target_name count by 1.
   ASSERT(target_names_count_.find(target_name) != target_names_count_.end());
   if (--target_names_count_[target_name] == 0) {
@@ -90,6 +94,13 @@ void ManagerImpl::onTargetReady(absl::string_view target_name) {
   }
 }
 
+bool ManagerImpl::initializeTarget(const TargetHandle& target_handle) {
+  if (observer_ != nullptr) {
+    observer_(target_handle.name(), TargetEvent::Initializing);
+  }
+  return target_handle.initialize(watcher_);
+}
+
 void ManagerImpl::ready() {
   state_ = State::Initialized;
   watcher_handle_->ready();
@@ -37,6 +37,7 @@ public:
   void add(const Target& target) override;
   void initialize(const Watcher& watcher) override;
   void dumpUnreadyTargets(envoy::admin::v3::UnreadyTargetsDumps& dumps) override;
+  void setTargetObserver(TargetObserver observer) override { observer_ = std::move(observer); }
 
 private:
   // Callback function with an additional target_name parameter, decrease unready targets count by
@@ -45,6 +46,9 @@ private:
 
   void ready();
 
+  // Initializes a target, and reports it to the observer.
+  bool initializeTarget(const TargetHandle& target_handle);
+
   // Human-readable name for logging.
   const std::string name_;
 
@@ -68,6 +72,9 @@ private:
 
   // Count of target_name of unready targets.
   absl::flat_hash_map<std::string, uint32_t> target_names_count_;
+
+  // Observer of the initialization of each target, if any.
+  TargetObserver observer_;
 };
 
 } // namespace Init
@@ -17,6 +17,44 @@ bool isIoUringSupported() {
   return is_supported;
 }
 
+ProvidedBufferRingImpl::ProvidedBufferRingImpl(struct io_uring& ring,
+                                               struct io_uring_buf_ring* buf_ring, uint16_t group,
+                                               uint32_t num_buffers, uint32_t buffer_size)
+    : ring_(&ring), buf_ring_(buf_ring), group_(group), num_buffers_(num_buffers),
+      buffer_size_(buffer_size),
+      buffers_(std::make_unique<uint8_t[]>(static_cast<size_t>(num_buffers) * buffer_size)) {
+  const int mask = io_uring_buf_ring_mask(num_buffers_);
+  for (uint32_t id = 0; id < num_buffers_; ++id) {
+    io_uring_buf_ring_add(buf_ring_, buffer(id), buffer_size_, id, mask, id);
+  }
+  io_uring_buf_ring_advance(buf_ring_, num_buffers_);
+}
+
+ProvidedBufferRingImpl::~ProvidedBufferRingImpl() { detach(); }
+
+uint8_t* ProvidedBufferRingImpl::buffer(uint16_t id) {
+  ASSERT(id < num_buffers_);
+  return buffers_.get() + static_cast<size_t>(id) * buffer_size_;
+}
+
+void ProvidedBufferRingImpl::recycle(uint16_t id) {
+  if (ring_ == nullptr) {
+    return;
+  }
+  io_uring_buf_ring_add(buf_ring_, buffer(id), buffer_size_, id,
+                        io_uring_buf_ring_mask(num_buffers_), 0);
+  io_uring_buf_ring_advance(buf_ring_, 1);
+}
+
+void ProvidedBufferRingImpl::detach() {
+  if (ring_ == nullptr) {
+    return;
+  }
+  io_uring_free_buf_ring(ring_, buf_ring_, num_buffers_, group_);
+  ring_ = nullptr;
+  buf_ring_ = nullptr;
+}
+
 IoUringImpl::IoUringImpl(uint32_t io_uring_size, bool use_submission_queue_polling)
     : cqes_(io_uring_size, nullptr) {
   struct io_uring_params p {};
@@ -28,9 +66,21 @@ IoUringImpl::IoUringImpl(uint32_t io_uring_size, bool use_submission_queue_polli
   // with SQ ring. We will figure out better handle of entries number in the future.
   int ret = io_uring_queue_init_params(io_uring_size, &ring_, &p);
   RELEASE_ASSERT(ret == 0, fmt::format("unable to initialize io_uring: {}", errorDetails(-ret)));
+  probe_ = io_uring_get_probe_ring(&ring_);
 }
 
-IoUringImpl::~IoUringImpl() { io_uring_queue_exit(&ring_); }
+IoUringImpl::~IoUringImpl() {
+  // Buffers of a ring may still be referenced by buffers outliving the io_uring.
+  for (auto& weak_buffer_ring : provided_buffer_rings_) {
+    if (auto buffer_ring = weak_buffer_ring.lock(); buffer_ring != nullptr) {
+      buffer_ring->detach();
+    }
+  }
+  if (probe_ != nullptr) {
+    io_uring_free_probe(probe_);
+  }
+  io_uring_queue_exit(&ring_);
+}
 
 os_fd_t IoUringImpl::registerEventfd() {
   ASSERT(!isEventfdRegistered());
@@ -69,7 +119,7 @@ void IoUringImpl::forEveryCompletion(const CompletionCb& completion_cb) {
 
   for (unsigned i = 0; i < count; ++i) {
     struct io_uring_cqe* cqe = cqes_[i];
-    completion_cb(reinterpret_cast<Request*>(cqe->user_data), cqe->res, false);
+    completion_cb(reinterpret_cast<Request*>(cqe->user_data), cqe->res, cqe->flags, false);
   }
 
   io_uring_cq_advance(&ring_, count);
@@ -80,7 +130,7 @@ void IoUringImpl::forEveryCompletion(const CompletionCb& completion_cb) {
   // Iterate the injected completion.
   while (!injected_completions_.empty()) {
     auto& completion = injected_completions_.front();
-    completion_cb(completion.user_data_, completion.result_, true);
+    completion_cb(completion.user_data_, completion.result_, 0, true);
     // The socket may closed in the completion_cb and all the related completions are
     // removed.
     if (injected_completions_.empty()) {
@@ -90,6 +140,43 @@ void IoUringImpl::forEveryCompletion(const CompletionCb& completion_cb) {
   }
 }
 
+bool IoUringImpl::isOpSupported(uint8_t op) const {
+  return probe_ != nullptr && io_uring_opcode_supported(probe_, op);
+}
+
+ProvidedBufferRingSharedPtr IoUringImpl::createProvidedBufferRing(uint16_t group,
+                                                                  uint32_t num_buffers,
+                                                                  uint32_t buffer_size) {
+  ASSERT(num_buffers > 0 && (num_buffers & (num_buffers - 1)) == 0);
+  int ret = 0;
+  struct io_uring_buf_ring* buf_ring = io_uring_setup_buf_ring(&ring_, num_buffers, group, 0, &ret);
+  if (buf_ring == nullptr) {
+    ENVOY_LOG(debug, "unable to set up provided buffer ring: {}", errorDetails(-ret));
+    return nullptr;
+  }
+  auto buffer_ring =
+      std::make_shared<ProvidedBufferRingImpl>(ring_, buf_ring, group, num_buffers, buffer_size);
+  provided_buffer_rings_.push_back(buffer_ring);
+  return buffer_ring;
+}
+
+IoUringResult IoUringImpl::prepareRecvMultishot(os_fd_t fd, uint16_t buffer_group,
+                                                Request* user_data) {
+  ENVOY_LOG(trace, "prepare multishot recv for fd = {}", fd);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_recv_multishot(sqe, fd, nullptr, 0, 0);
+  sqe->flags |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group = buffer_group;
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
 IoUringResult IoUringImpl::prepareAccept(os_fd_t fd, struct sockaddr* remote_addr,
                                          socklen_t* remote_addr_len, Request* user_data) {
   ENVOY_LOG(trace, "prepare close for fd = {}", fd);
@@ -151,6 +238,21 @@ IoUringResult IoUringImpl::prepareWritev(os_fd_t fd, const struct iovec* iovecs,
   return IoUringResult::Ok;
 }
 
+IoUringResult IoUringImpl::prepareSendmsgZeroCopy(os_fd_t fd, const struct msghdr* msg,
+                                                  Request* user_data) {
+  ENVOY_LOG(trace, "prepare zero copy sendmsg for fd = {}", fd);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_sendmsg_zc(sqe, fd, msg, 0);
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
 IoUringResult IoUringImpl::prepareClose(os_fd_t fd, Request* user_data) {
   ENVOY_LOG(trace, "prepare close for fd = {}", fd);
   // TODO (soulxu): Handling the case of CQ ring is overflow.
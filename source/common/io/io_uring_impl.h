@@ -21,6 +21,31 @@ struct InjectedCompletion {
   const int32_t result_;
 };
 
+class ProvidedBufferRingImpl : public ProvidedBufferRing {
+public:
+  ProvidedBufferRingImpl(struct io_uring& ring, struct io_uring_buf_ring* buf_ring, uint16_t group,
+                         uint32_t num_buffers, uint32_t buffer_size);
+  ~ProvidedBufferRingImpl() override;
+
+  // ProvidedBufferRing
+  uint16_t group() const override { return group_; }
+  uint32_t bufferSize() const override { return buffer_size_; }
+  uint8_t* buffer(uint16_t id) override;
+  void recycle(uint16_t id) override;
+
+  // Unregister the ring from the kernel. Called when the io_uring is destroyed while buffers of
+  // the ring are still referenced, after which the buffers are only released.
+  void detach();
+
+private:
+  struct io_uring* ring_;
+  struct io_uring_buf_ring* buf_ring_;
+  const uint16_t group_;
+  const uint32_t num_buffers_;
+  const uint32_t buffer_size_;
+  std::unique_ptr<uint8_t[]> buffers_;
+};
+
 class IoUringImpl : public IoUring,
                     public ThreadLocal::ThreadLocalObject,
                     protected Logger::Loggable<Logger::Id::io> {
@@ -32,6 +57,11 @@ public:
   void unregisterEventfd() override;
   bool isEventfdRegistered() const override;
   void forEveryCompletion(const CompletionCb& completion_cb) override;
+  bool isOpSupported(uint8_t op) const override;
+  ProvidedBufferRingSharedPtr createProvidedBufferRing(uint16_t group, uint32_t num_buffers,
+                                                       uint32_t buffer_size) override;
+  IoUringResult prepareRecvMultishot(os_fd_t fd, uint16_t buffer_group,
+                                     Request* user_data) override;
   IoUringResult prepareAccept(os_fd_t fd, struct sockaddr* remote_addr, socklen_t* remote_addr_len,
                               Request* user_data) override;
   IoUringResult prepareConnect(os_fd_t fd, const Network::Address::InstanceConstSharedPtr& address,
@@ -40,6 +70,8 @@ public:
                              Request* user_data) override;
   IoUringResult prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                               off_t offset, Request* user_data) override;
+  IoUringResult prepareSendmsgZeroCopy(os_fd_t fd, const struct msghdr* msg,
+                                       Request* user_data) override;
   IoUringResult prepareClose(os_fd_t fd, Request* user_data) override;
   IoUringResult prepareCancel(Request* cancelling_user_data, Request* user_data) override;
   IoUringResult prepareShutdown(os_fd_t fd, int how, Request* user_data) override;
@@ -52,6 +84,9 @@ private:
   std::vector<struct io_uring_cqe*> cqes_;
   os_fd_t event_fd_{INVALID_SOCKET};
   std::list<InjectedCompletion> injected_completions_;
+  // The operations supported by the kernel, absent if probing is not supported.
+  struct io_uring_probe* probe_{};
+  std::vector<std::weak_ptr<ProvidedBufferRingImpl>> provided_buffer_rings_;
 };
 
 } // namespace Io
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "envoy/common/io/io_uring.h"
+#include "envoy/stats/scope.h"
 #include "envoy/thread_local/thread_local.h"
 
 namespace Envoy {
@@ -8,9 +9,16 @@ namespace Io {
 
 class IoUringWorkerFactoryImpl : public IoUringWorkerFactory {
 public:
+  /**
+   * @param provided_buffers the number of read buffers each worker provides to the kernel for
+   *        multishot receives, must be a power of two. 0 disables multishot receives.
+   * @param send_zero_copy_threshold the minimum size of the writes which are sent with zero copy.
+   *        0 disables zero copy send.
+   */
   IoUringWorkerFactoryImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                            uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                           ThreadLocal::SlotAllocator& tls);
+                           uint32_t provided_buffers, uint32_t send_zero_copy_threshold,
+                           Stats::Scope& scope, ThreadLocal::SlotAllocator& tls);
 
   OptRef<IoUringWorker> getIoUringWorker() override;
 
@@ -24,6 +32,9 @@ private:
   const bool use_submission_queue_polling_;
   const uint32_t read_buffer_size_;
   const uint32_t write_timeout_ms_;
+  const uint32_t provided_buffers_;
+  const uint32_t send_zero_copy_threshold_;
+  Stats::Scope& scope_;
   ThreadLocal::TypedSlot<IoUringWorker> tls_;
 };
 
@@ -1,15 +1,29 @@
 #include "source/common/io/io_uring_worker_impl.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Io {
 
+namespace {
+
+IoUringWorkerStats generateStats(Stats::Scope& scope, const std::string& worker_name) {
+  const std::string prefix = absl::StrCat("io_uring.", worker_name, ".");
+  return {ALL_IO_URING_WORKER_STATS(POOL_COUNTER_PREFIX(scope, prefix))};
+}
+
+} // namespace
+
 ReadRequest::ReadRequest(IoUringSocket& socket, uint32_t size)
     : Request(RequestType::Read, socket), buf_(std::make_unique<uint8_t[]>(size)),
-      iov_(std::make_unique<struct iovec>()) {
+      iov_(std::make_unique<struct iovec>()), multishot_(false) {
   iov_->iov_base = buf_.get();
   iov_->iov_len = size;
 }
 
+ReadRequest::ReadRequest(IoUringSocket& socket)
+    : Request(RequestType::Read, socket), multishot_(true) {}
+
 WriteRequest::WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices)
     : Request(RequestType::Write, socket), iov_(std::make_unique<struct iovec[]>(slices.size())) {
   for (size_t i = 0; i < slices.size(); i++) {
@@ -18,6 +32,13 @@ WriteRequest::WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector&
   }
 }
 
+WriteRequest::WriteRequest(IoUringSocket& socket, std::shared_ptr<Buffer::OwnedImpl> data)
+    : WriteRequest(socket, data->getRawSlices(IOV_MAX)) {
+  msg_.msg_iov = iov_.get();
+  msg_.msg_iovlen = data->getRawSlices(IOV_MAX).size();
+  zero_copy_data_ = std::move(data);
+}
+
 IoUringSocketEntry::IoUringSocketEntry(os_fd_t fd, IoUringWorkerImpl& parent, Event::FileReadyCb cb,
                                        bool enable_close_event)
     : fd_(fd), parent_(parent), enable_close_event_(enable_close_event), cb_(std::move(cb)) {}
@@ -60,14 +81,31 @@ void IoUringSocketEntry::onRemoteClose() {
 
 IoUringWorkerImpl::IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                                      uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                                     Event::Dispatcher& dispatcher)
+                                     uint32_t provided_buffers, uint32_t send_zero_copy_threshold,
+                                     Stats::Scope& scope, Event::Dispatcher& dispatcher)
     : IoUringWorkerImpl(std::make_unique<IoUringImpl>(io_uring_size, use_submission_queue_polling),
-                        read_buffer_size, write_timeout_ms, dispatcher) {}
+                        read_buffer_size, write_timeout_ms, provided_buffers,
+                        send_zero_copy_threshold, scope, dispatcher) {}
 
 IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size,
-                                     uint32_t write_timeout_ms, Event::Dispatcher& dispatcher)
+                                     uint32_t write_timeout_ms, uint32_t provided_buffers,
+                                     uint32_t send_zero_copy_threshold, Stats::Scope& scope,
+                                     Event::Dispatcher& dispatcher)
     : io_uring_(std::move(io_uring)), read_buffer_size_(read_buffer_size),
-      write_timeout_ms_(write_timeout_ms), dispatcher_(dispatcher) {
+      write_timeout_ms_(write_timeout_ms), send_zero_copy_threshold_(send_zero_copy_threshold),
+      stats_(generateStats(scope, dispatcher.name())), dispatcher_(dispatcher) {
+  if (provided_buffers > 0) {
+    provided_buffer_ring_ =
+        io_uring_->createProvidedBufferRing(0, provided_buffers, read_buffer_size_);
+    if (provided_buffer_ring_ == nullptr) {
+      ENVOY_LOG(debug, "provided buffer rings are not supported, reading into allocated buffers");
+    }
+  }
+  if (send_zero_copy_threshold_ > 0 && !io_uring_->isOpSupported(IORING_OP_SENDMSG_ZC)) {
+    ENVOY_LOG(debug, "zero copy send is not supported, sending with writev");
+    send_zero_copy_threshold_ = 0;
+  }
+
   const os_fd_t event_fd = io_uring_->registerEventfd();
   // We only care about the read event of Eventfd, since we only receive the
   // event here.
@@ -89,7 +127,9 @@ IoUringWorkerImpl::~IoUringWorkerImpl() {
     }
   }
 
-  while (!sockets_.empty()) {
+  // Also wait for the notifications of zero copy sends, since their requests still reference the
+  // sent data.
+  while (!sockets_.empty() || pending_zero_copy_notifications_ > 0) {
     ENVOY_LOG(trace, "still left {} sockets are not closed", sockets_.size());
     for (auto& socket : sockets_) {
       ENVOY_LOG(trace, "the socket fd = {} not closed", socket->fd());
@@ -148,11 +188,35 @@ IoUringWorkerImpl::submitConnectRequest(IoUringSocket& socket,
     res = io_uring_->prepareConnect(socket.fd(), address, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare connect");
   }
+  stats_.requests_total_.inc();
   submit();
   return req;
 }
 
 Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
+  return submitReadRequest(socket, true);
+}
+
+Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket, bool use_provided_buffers) {
+  if (use_provided_buffers && provided_buffer_ring_ != nullptr && recv_multishot_enabled_) {
+    ReadRequest* req = new ReadRequest(socket);
+
+    ENVOY_LOG(trace, "submit multishot recv request, fd = {}, read req = {}", socket.fd(),
+              fmt::ptr(req));
+
+    auto res = io_uring_->prepareRecvMultishot(socket.fd(), provided_buffer_ring_->group(), req);
+    if (res == IoUringResult::Failed) {
+      // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+      submit();
+      res = io_uring_->prepareRecvMultishot(socket.fd(), provided_buffer_ring_->group(), req);
+      RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare multishot recv");
+    }
+    stats_.requests_total_.inc();
+    stats_.recv_multishot_total_.inc();
+    submit();
+    return req;
+  }
+
   ReadRequest* req = new ReadRequest(socket, read_buffer_size_);
 
   ENVOY_LOG(trace, "submit read request, fd = {}, read req = {}", socket.fd(), fmt::ptr(req));
@@ -164,6 +228,7 @@ Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
     res = io_uring_->prepareReadv(socket.fd(), req->iov_.get(), 1, 0, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare readv");
   }
+  stats_.requests_total_.inc();
   submit();
   return req;
 }
@@ -181,6 +246,27 @@ Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
     res = io_uring_->prepareWritev(socket.fd(), req->iov_.get(), slices.size(), 0, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare writev");
   }
+  stats_.requests_total_.inc();
+  submit();
+  return req;
+}
+
+Request* IoUringWorkerImpl::submitZeroCopyWriteRequest(IoUringSocket& socket,
+                                                       std::shared_ptr<Buffer::OwnedImpl> data) {
+  WriteRequest* req = new WriteRequest(socket, std::move(data));
+
+  ENVOY_LOG(trace, "submit zero copy write request, fd = {}, req = {}", socket.fd(),
+            fmt::ptr(req));
+
+  auto res = io_uring_->prepareSendmsgZeroCopy(socket.fd(), &req->msg_, req);
+  if (res == IoUringResult::Failed) {
+    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+    submit();
+    res = io_uring_->prepareSendmsgZeroCopy(socket.fd(), &req->msg_, req);
+    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare zero copy sendmsg");
+  }
+  stats_.requests_total_.inc();
+  stats_.send_zero_copy_total_.inc();
   submit();
   return req;
 }
@@ -197,6 +283,7 @@ Request* IoUringWorkerImpl::submitCloseRequest(IoUringSocket& socket) {
     res = io_uring_->prepareClose(socket.fd(), req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare close");
   }
+  stats_.requests_total_.inc();
   submit();
   return req;
 }
@@ -214,6 +301,7 @@ Request* IoUringWorkerImpl::submitCancelRequest(IoUringSocket& socket, Request*
     res = io_uring_->prepareCancel(request_to_cancel, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare cancel");
   }
+  stats_.requests_total_.inc();
   submit();
   return req;
 }
@@ -231,10 +319,18 @@ Request* IoUringWorkerImpl::submitShutdownRequest(IoUringSocket& socket, int how
     res = io_uring_->prepareShutdown(socket.fd(), how, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare cancel");
   }
+  stats_.requests_total_.inc();
   submit();
   return req;
 }
 
+void IoUringWorkerImpl::disableRecvMultishot() {
+  if (recv_multishot_enabled_) {
+    ENVOY_LOG(debug, "multishot recv is not supported, reading into allocated buffers");
+    recv_multishot_enabled_ = false;
+  }
+}
+
 IoUringSocketEntryPtr IoUringWorkerImpl::removeSocket(IoUringSocketEntry& socket) {
   // Remove all the injection completion for this socket.
   io_uring_->removeInjectedCompletion(socket.fd());
@@ -251,10 +347,16 @@ void IoUringWorkerImpl::injectCompletion(IoUringSocket& socket, Request::Request
 void IoUringWorkerImpl::onFileEvent() {
   ENVOY_LOG(trace, "io uring worker, on file event");
   delay_submit_ = true;
-  io_uring_->forEveryCompletion([](Request* req, int32_t result, bool injected) {
-    ENVOY_LOG(trace, "receive request completion, type = {}, req = {}",
-              static_cast<uint8_t>(req->type()), fmt::ptr(req));
+  io_uring_->forEveryCompletion([this](Request* req, int32_t result, uint32_t flags,
+                                       bool injected) {
+    ENVOY_LOG(trace, "receive request completion, type = {}, req = {}, flags = {}",
+              static_cast<uint8_t>(req->type()), fmt::ptr(req), flags);
     ASSERT(req != nullptr);
+    if (injected) {
+      stats_.injected_completions_total_.inc();
+    } else {
+      stats_.completions_total_.inc();
+    }
 
     switch (req->type()) {
     case Request::RequestType::Accept:
@@ -267,16 +369,51 @@ void IoUringWorkerImpl::onFileEvent() {
                 fmt::ptr(req));
       req->socket().onConnect(req, result, injected);
       break;
-    case Request::RequestType::Read:
+    case Request::RequestType::Read: {
       ENVOY_LOG(trace, "receive Read request completion, fd = {}, req = {}", req->socket().fd(),
                 fmt::ptr(req));
+      // Injected completions are not read requests.
+      ReadRequest* read_req = injected ? nullptr : static_cast<ReadRequest*>(req);
+      if (read_req != nullptr) {
+        read_req->more_ = flags & IORING_CQE_F_MORE;
+        if (flags & IORING_CQE_F_BUFFER) {
+          read_req->provided_buffer_id_ = flags >> IORING_CQE_BUFFER_SHIFT;
+        }
+      }
       req->socket().onRead(req, result, injected);
+      if (read_req != nullptr) {
+        // Hand the buffer back to the kernel if the socket discarded the data.
+        if (read_req->provided_buffer_id_.has_value()) {
+          provided_buffer_ring_->recycle(read_req->provided_buffer_id_.value());
+          read_req->provided_buffer_id_.reset();
+        }
+        if (read_req->more_) {
+          return;
+        }
+      }
       break;
-    case Request::RequestType::Write:
+    }
+    case Request::RequestType::Write: {
+      WriteRequest* write_req = injected ? nullptr : static_cast<WriteRequest*>(req);
+      if (write_req != nullptr && (flags & IORING_CQE_F_NOTIF)) {
+        // The kernel does not reference the data of a zero copy send anymore. The socket may be
+        // gone already, so the notification is not delivered to it.
+        ASSERT(pending_zero_copy_notifications_ > 0);
+        pending_zero_copy_notifications_--;
+        break;
+      }
       ENVOY_LOG(trace, "receive write request completion, fd = {}, req = {}", req->socket().fd(),
                 fmt::ptr(req));
+      if (write_req != nullptr) {
+        write_req->more_ = flags & IORING_CQE_F_MORE;
+      }
       req->socket().onWrite(req, result, injected);
+      if (write_req != nullptr && write_req->more_) {
+        pending_zero_copy_notifications_++;
+        return;
+      }
       break;
+    }
     case Request::RequestType::Close:
       ENVOY_LOG(trace, "receive close request completion, fd = {}, req = {}", req->socket().fd(),
                 fmt::ptr(req));
@@ -302,7 +439,10 @@ void IoUringWorkerImpl::onFileEvent() {
 
 void IoUringWorkerImpl::submit() {
   if (!delay_submit_) {
-    io_uring_->submit();
+    stats_.submit_total_.inc();
+    if (io_uring_->submit() == IoUringResult::Busy) {
+      stats_.submit_busy_.inc();
+    }
   }
 }
 
@@ -430,6 +570,21 @@ void IoUringServerSocket::onCancel(Request* req, int32_t result, bool injected)
 
 void IoUringServerSocket::moveReadDataToBuffer(Request* req, size_t data_length) {
   ReadRequest* read_req = static_cast<ReadRequest*>(req);
+  if (read_req->provided_buffer_id_.has_value()) {
+    // Take the buffer the kernel picked over. It is handed back to the kernel once the data has
+    // been drained.
+    const uint16_t id = read_req->provided_buffer_id_.value();
+    read_req->provided_buffer_id_.reset();
+    ProvidedBufferRingSharedPtr buffer_ring = parent_.providedBufferRing();
+    Buffer::BufferFragment* fragment = new Buffer::BufferFragmentImpl(
+        buffer_ring->buffer(id), data_length,
+        [buffer_ring, id](const void*, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
+          buffer_ring->recycle(id);
+          delete this_fragment;
+        });
+    read_buf_.addBufferFragment(*fragment);
+    return;
+  }
   Buffer::BufferFragment* fragment = new Buffer::BufferFragmentImpl(
       read_req->buf_.release(), data_length,
       [](const void* data, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
@@ -457,10 +612,13 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
             "onRead with result {}, fd = {}, injected = {}, status_ = {}, enable_close_event = {}",
             result, fd_, injected, static_cast<int>(status_), enable_close_event_);
   if (!injected) {
-    read_req_ = nullptr;
+    // A multishot request stays in flight until a completion without more to come.
+    if (!static_cast<ReadRequest*>(req)->more_) {
+      read_req_ = nullptr;
+    }
     // If the socket is going to close, discard all results.
-    if (status_ == Closed && write_or_shutdown_req_ == nullptr && read_cancel_req_ == nullptr &&
-        write_or_shutdown_cancel_req_ == nullptr) {
+    if (status_ == Closed && read_req_ == nullptr && write_or_shutdown_req_ == nullptr &&
+        read_cancel_req_ == nullptr && write_or_shutdown_cancel_req_ == nullptr) {
       if (result > 0 && keep_fd_open_) {
         moveReadDataToBuffer(req, result);
       }
@@ -472,6 +630,17 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
   // Move read data from request to buffer or store the error.
   if (result > 0) {
     moveReadDataToBuffer(req, result);
+  } else if (!injected && static_cast<ReadRequest*>(req)->multishot_ &&
+             (result == -ENOBUFS || result == -EINVAL)) {
+    // Either all the provided buffers hold data which has not been consumed yet, or the kernel
+    // does not support multishot receives. Neither is an error of the socket: the next read is
+    // done into an allocated buffer.
+    if (result == -ENOBUFS) {
+      parent_.stats().provided_buffers_exhausted_.inc();
+    } else {
+      parent_.disableRecvMultishot();
+    }
+    read_into_allocated_buffer_ = true;
   } else {
     if (result != -ECANCELED) {
       read_error_ = result;
@@ -577,8 +746,14 @@ void IoUringServerSocket::onWrite(Request* req, int32_t result, bool injected) {
     return;
   }
 
+  const std::shared_ptr<Buffer::OwnedImpl>& zero_copy_data =
+      static_cast<WriteRequest*>(req)->zero_copy_data_;
   if (result > 0) {
-    write_buf_.drain(result);
+    if (zero_copy_data != nullptr) {
+      restoreUnsentData(zero_copy_data, result);
+    } else {
+      write_buf_.drain(result);
+    }
     ENVOY_LOG(trace, "drain write buf, drain size = {}, fd = {}", result, fd_);
   } else {
     // Drain all write buf since the write failed.
@@ -596,6 +771,26 @@ void IoUringServerSocket::onWrite(Request* req, int32_t result, bool injected) {
   submitWriteOrShutdownRequest();
 }
 
+void IoUringServerSocket::restoreUnsentData(const std::shared_ptr<Buffer::OwnedImpl>& data,
+                                            uint64_t sent) {
+  // Put the data which has not been sent in front of the data written since, without copying it.
+  Buffer::OwnedImpl unsent;
+  for (const Buffer::RawSlice& slice : data->getRawSlices()) {
+    if (sent >= slice.len_) {
+      sent -= slice.len_;
+      continue;
+    }
+    Buffer::BufferFragment* fragment = new Buffer::BufferFragmentImpl(
+        static_cast<uint8_t*>(slice.mem_) + sent, slice.len_ - sent,
+        [data](const void*, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
+          delete this_fragment;
+        });
+    unsent.addBufferFragment(*fragment);
+    sent = 0;
+  }
+  write_buf_.prepend(unsent);
+}
+
 void IoUringServerSocket::onShutdown(Request* req, int32_t result, bool injected) {
   IoUringSocketEntry::onShutdown(req, result, injected);
 
@@ -609,6 +804,14 @@ void IoUringServerSocket::onShutdown(Request* req, int32_t result, bool injected
 
 void IoUringServerSocket::closeInternal() {
   if (keep_fd_open_) {
+    if (parent_.providedBufferRing() != nullptr && read_buf_.length() > 0) {
+      // The read buffer is handed over to another thread, while provided buffers can only be
+      // recycled on this one.
+      Buffer::OwnedImpl read_buf;
+      read_buf.add(read_buf_);
+      read_buf_.drain(read_buf_.length());
+      read_buf_.move(read_buf);
+    }
     if (on_closed_cb_) {
       on_closed_cb_(read_buf_);
     }
@@ -622,13 +825,25 @@ void IoUringServerSocket::closeInternal() {
 
 void IoUringServerSocket::submitReadRequest() {
   if (!read_req_) {
-    read_req_ = parent_.submitReadRequest(*this);
+    read_req_ = parent_.submitReadRequest(*this, !read_into_allocated_buffer_);
+    read_into_allocated_buffer_ = false;
   }
 }
 
 void IoUringServerSocket::submitWriteOrShutdownRequest() {
   if (!write_or_shutdown_req_) {
     if (write_buf_.length() > 0) {
+      const uint32_t zero_copy_threshold = parent_.sendZeroCopyThreshold();
+      if (zero_copy_threshold > 0 && write_buf_.length() >= zero_copy_threshold) {
+        ENVOY_LOG(trace, "submit zero copy write request, write_buf size = {}, fd = {}",
+                  write_buf_.length(), fd_);
+        // The kernel references the data until it notifies otherwise, which may be after the
+        // write completed. The request takes the data over so that it stays alive until then.
+        auto data = std::make_shared<Buffer::OwnedImpl>();
+        data->move(write_buf_);
+        write_or_shutdown_req_ = parent_.submitZeroCopyWriteRequest(*this, std::move(data));
+        return;
+      }
       Buffer::RawSliceVector slices = write_buf_.getRawSlices(IOV_MAX);
       ENVOY_LOG(trace, "submit write request, write_buf size = {}, num_iovecs = {}, fd = {}",
                 write_buf_.length(), slices.size(), fd_);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "envoy/common/io/io_uring.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/linked_object.h"
@@ -10,19 +12,54 @@
 namespace Envoy {
 namespace Io {
 
+/**
+ * All io_uring worker stats. @see stats_macros.h
+ */
+#define ALL_IO_URING_WORKER_STATS(COUNTER)                                                         \
+  COUNTER(completions_total)                                                                       \
+  COUNTER(injected_completions_total)                                                              \
+  COUNTER(provided_buffers_exhausted)                                                              \
+  COUNTER(recv_multishot_total)                                                                    \
+  COUNTER(requests_total)                                                                          \
+  COUNTER(send_zero_copy_total)                                                                    \
+  COUNTER(submit_busy)                                                                             \
+  COUNTER(submit_total)
+
+/**
+ * Struct definition for all io_uring worker stats. @see stats_macros.h
+ */
+struct IoUringWorkerStats {
+  ALL_IO_URING_WORKER_STATS(GENERATE_COUNTER_STRUCT)
+};
+
 class ReadRequest : public Request {
 public:
   ReadRequest(IoUringSocket& socket, uint32_t size);
+  // A multishot receive into buffers picked from a provided buffer ring.
+  explicit ReadRequest(IoUringSocket& socket);
 
   std::unique_ptr<uint8_t[]> buf_;
   std::unique_ptr<struct iovec> iov_;
+  const bool multishot_;
+  // The buffer the kernel picked for the completion being handled, if any. The buffer is recycled
+  // after the completion is handled unless the socket took it over.
+  absl::optional<uint16_t> provided_buffer_id_;
+  // Whether more completions are going to be delivered for this request.
+  bool more_{};
 };
 
 class WriteRequest : public Request {
 public:
   WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices);
+  // A zero copy send of the data, which the request keeps alive since the kernel references it
+  // until it notifies otherwise.
+  WriteRequest(IoUringSocket& socket, std::shared_ptr<Buffer::OwnedImpl> data);
 
   std::unique_ptr<struct iovec[]> iov_;
+  struct msghdr msg_ {};
+  std::shared_ptr<Buffer::OwnedImpl> zero_copy_data_;
+  // Whether a notification is going to be delivered for this request.
+  bool more_{};
 };
 
 class IoUringSocketEntry;
@@ -32,9 +69,11 @@ class IoUringWorkerImpl : public IoUringWorker, private Logger::Loggable<Logger:
 public:
   IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                     uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    uint32_t provided_buffers, uint32_t send_zero_copy_threshold,
+                    Stats::Scope& scope, Event::Dispatcher& dispatcher);
   IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    uint32_t provided_buffers, uint32_t send_zero_copy_threshold,
+                    Stats::Scope& scope, Event::Dispatcher& dispatcher);
   ~IoUringWorkerImpl() override;
 
   // IoUringWorker
@@ -55,6 +94,25 @@ public:
 
   Event::Dispatcher& dispatcher() override;
 
+  // Submit a read request, which is a multishot receive into provided buffers if the worker has a
+  // provided buffer ring and `use_provided_buffers` is true, or a read into an allocated buffer.
+  Request* submitReadRequest(IoUringSocket& socket, bool use_provided_buffers);
+
+  // Submit a zero copy send of the data.
+  Request* submitZeroCopyWriteRequest(IoUringSocket& socket,
+                                      std::shared_ptr<Buffer::OwnedImpl> data);
+
+  // Return the minimum size of the data sent with zero copy, or 0 if zero copy is disabled.
+  uint32_t sendZeroCopyThreshold() const { return send_zero_copy_threshold_; }
+
+  // Stop submitting multishot receives, used when the kernel does not support them.
+  void disableRecvMultishot();
+
+  // Return the ring of buffers picked by multishot receives, or nullptr if there is none.
+  const ProvidedBufferRingSharedPtr& providedBufferRing() const { return provided_buffer_ring_; }
+
+  IoUringWorkerStats& stats() { return stats_; }
+
   // Remove a socket from this worker.
   IoUringSocketEntryPtr removeSocket(IoUringSocketEntry& socket);
 
@@ -74,6 +132,15 @@ protected:
   IoUringPtr io_uring_;
   const uint32_t read_buffer_size_;
   const uint32_t write_timeout_ms_;
+  // Writes of at least this many bytes are sent with zero copy, 0 if zero copy send is disabled
+  // or not supported.
+  uint32_t send_zero_copy_threshold_;
+  IoUringWorkerStats stats_;
+  ProvidedBufferRingSharedPtr provided_buffer_ring_;
+  bool recv_multishot_enabled_{true};
+  // The zero copy sends of which the kernel has not notified that it released the memory yet.
+  // Their requests are not owned by any socket anymore.
+  uint32_t pending_zero_copy_notifications_{0};
   // The dispatcher of this worker is running on.
   Event::Dispatcher& dispatcher_;
   // The file event of iouring's eventfd.
@@ -242,11 +309,15 @@ protected:
   Request* write_or_shutdown_cancel_req_{nullptr};
   // This is used for tracking the close request.
   Request* close_req_{nullptr};
+  // Whether the next read request has to read into an allocated buffer, since the last read could
+  // not be done into a provided buffer.
+  bool read_into_allocated_buffer_{false};
 
   void closeInternal();
   void submitReadRequest();
   void submitWriteOrShutdownRequest();
   void moveReadDataToBuffer(Request* req, size_t data_length);
+  void restoreUnsentData(const std::shared_ptr<Buffer::OwnedImpl>& data, uint64_t sent);
   void onReadCompleted(int32_t result);
   void onWriteCompleted(int32_t result);
 };
@@ -18,7 +18,9 @@
 // Do not let nlohmann/json leak outside of this file.
 #include "include/nlohmann/json.hpp"
 
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/match.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Json {
@@ -47,17 +49,17 @@ public:
 
   // Value factory.
   template <typename T> static FieldSharedPtr createValue(T value) {
-    return FieldSharedPtr{new Field(value)}; // NOLINT(modernize-make-shared)
+    return FieldSharedPtr{new Field(std::move(value))}; // NOLINT(modernize-make-shared)
   }
 
   absl::Status append(FieldSharedPtr field_ptr) {
     RETURN_IF_NOT_OK(checkType(Type::Array));
-    value_.array_value_.push_back(field_ptr);
+    value_.array_value_.push_back(std::move(field_ptr));
     return absl::OkStatus();
   }
-  absl::Status insert(const std::string& key, FieldSharedPtr field_ptr) {
+  absl::Status insert(std::string key, FieldSharedPtr field_ptr) {
     RETURN_IF_NOT_OK(checkType(Type::Object));
-    value_.object_value_[key] = field_ptr;
+    value_.object_value_.insert_or_assign(std::move(key), std::move(field_ptr));
     return absl::OkStatus();
   }
 
@@ -129,7 +131,9 @@ private:
   };
 
   explicit Field(Type type) : type_(type) {}
-  explicit Field(const std::string& value) : type_(Type::String) { value_.string_value_ = value; }
+  explicit Field(std::string value) : type_(Type::String) {
+    value_.string_value_ = std::move(value);
+  }
   explicit Field(int64_t value) : type_(Type::Integer) { value_.integer_value_ = value; }
   explicit Field(double value) : type_(Type::Double) { value_.double_value_ = value; }
   explicit Field(bool value) : type_(Type::Boolean) { value_.boolean_value_ = value; }
@@ -181,15 +185,27 @@ private:
 class ObjectHandler : public nlohmann::json_sax<nlohmann::json> {
 public:
   ObjectHandler() = default;
+  explicit ObjectHandler(const std::vector<std::vector<std::string>>& paths) : paths_(&paths) {
+    next_paths_.emplace();
+    for (uint32_t i = 0; i < paths.size(); i++) {
+      if (paths[i].empty()) {
+        next_paths_ = absl::nullopt;
+        break;
+      }
+      next_paths_->push_back(i);
+    }
+  }
 
   bool start_object(std::size_t) override;
   bool end_object() override;
   bool key(std::string& val) override;
   bool start_array(std::size_t) override;
   bool end_array() override;
-  bool boolean(bool value) override { return handleValueEvent(Field::createValue(value)); }
+  bool boolean(bool value) override {
+    return skipValue() || handleValueEvent(Field::createValue(value));
+  }
   bool number_integer(int64_t value) override {
-    return handleValueEvent(Field::createValue(static_cast<int64_t>(value)));
+    return skipValue() || handleValueEvent(Field::createValue(static_cast<int64_t>(value)));
   }
   bool number_unsigned(uint64_t value) override {
     if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
@@ -201,13 +217,16 @@ public:
       error_position_ = absl::StrCat("line: ", line_number_);
       return false;
     }
-    return handleValueEvent(Field::createValue(static_cast<int64_t>(value)));
+    return skipValue() || handleValueEvent(Field::createValue(static_cast<int64_t>(value)));
   }
   bool number_float(double value, const std::string&) override {
-    return handleValueEvent(Field::createValue(value));
+    return skipValue() || handleValueEvent(Field::createValue(value));
+  }
+  bool null() override { return skipValue() || handleValueEvent(Field::createNull()); }
+  // The parser hands over its buffers for keys and strings, which are moved rather than copied.
+  bool string(std::string& value) override {
+    return skipValue() || handleValueEvent(Field::createValue(std::move(value)));
   }
-  bool null() override { return handleValueEvent(Field::createNull()); }
-  bool string(std::string& value) override { return handleValueEvent(Field::createValue(value)); }
   bool binary(binary_t&) override { return false; }
   bool parse_error(std::size_t at, const std::string& token,
                    const nlohmann::detail::exception& ex) override {
@@ -252,7 +271,35 @@ public:
   int line_number_{1};
 
 private:
+  // The indexes of the paths going through a container, or nullopt if it is kept whole.
+  using Paths = absl::optional<absl::InlinedVector<uint32_t, 4>>;
+
   bool handleValueEvent(FieldSharedPtr ptr);
+  // Selects the paths going through the value of the current key, or skips the value if there
+  // are none.
+  void selectPaths();
+  // Returns whether a scalar value is skipped, in which case it is consumed.
+  bool skipValue() {
+    if (skip_depth_ > 0) {
+      return true;
+    }
+    if (skip_value_) {
+      skip_value_ = false;
+      state_ = State::ExpectKeyOrEndObject;
+      return true;
+    }
+    return false;
+  }
+  // Returns whether the container being started is skipped, in which case it is consumed.
+  bool skipContainer() {
+    if (skip_depth_ == 0 && !skip_value_) {
+      return false;
+    }
+    skip_value_ = false;
+    skip_depth_++;
+    state_ = State::ExpectKeyOrEndObject;
+    return true;
+  }
 
   enum class State {
     ExpectRoot,
@@ -266,6 +313,15 @@ private:
   std::stack<FieldSharedPtr> stack_;
   std::string key_;
 
+  // The paths of keys to keep, or nullptr to keep the whole document.
+  const std::vector<std::vector<std::string>>* paths_{};
+  // The paths going through each container of the stack, and through the next value.
+  std::stack<Paths> paths_stack_;
+  Paths next_paths_;
+  // Whether the next value is skipped, and the nesting depth within a skipped value.
+  bool skip_value_{};
+  uint64_t skip_depth_{};
+
   FieldSharedPtr root_;
 
   std::string error_;
@@ -614,12 +670,17 @@ void Field::validateSchema(const std::string&) const {
 }
 
 bool ObjectHandler::start_object(std::size_t) {
+  if (skipContainer()) {
+    return true;
+  }
+  // The members of objects within arrays are all kept.
+  paths_stack_.push(state_ == State::ExpectArrayValueOrEndArray ? absl::nullopt : next_paths_);
   FieldSharedPtr object = Field::createObject();
   object->setLineNumberStart(line_number_);
 
   switch (state_) {
   case State::ExpectValueOrStartObjectArray:
-    THROW_IF_NOT_OK(stack_.top()->insert(key_, object));
+    THROW_IF_NOT_OK(stack_.top()->insert(std::move(key_), object));
     stack_.push(object);
     state_ = State::ExpectKeyOrEndObject;
     return true;
@@ -642,9 +703,14 @@ bool ObjectHandler::start_object(std::size_t) {
 }
 
 bool ObjectHandler::end_object() {
+  if (skip_depth_ > 0) {
+    skip_depth_--;
+    return true;
+  }
   if (state_ == State::ExpectKeyOrEndObject) {
     stack_.top()->setLineNumberEnd(line_number_);
     stack_.pop();
+    paths_stack_.pop();
 
     if (stack_.empty()) {
       state_ = State::ExpectFinished;
@@ -659,21 +725,53 @@ bool ObjectHandler::end_object() {
 }
 
 bool ObjectHandler::key(std::string& val) {
+  if (skip_depth_ > 0) {
+    return true;
+  }
   if (state_ == State::ExpectKeyOrEndObject) {
-    key_ = val;
+    key_ = std::move(val);
     state_ = State::ExpectValueOrStartObjectArray;
+    selectPaths();
     return true;
   }
   PANIC("parsing error not handled");
 }
 
+void ObjectHandler::selectPaths() {
+  const Paths& paths = paths_stack_.top();
+  if (!paths.has_value()) {
+    next_paths_ = absl::nullopt;
+    return;
+  }
+  const size_t depth = paths_stack_.size() - 1;
+  next_paths_.emplace();
+  for (const uint32_t index : *paths) {
+    const std::vector<std::string>& path = (*paths_)[index];
+    if (path[depth] != key_) {
+      continue;
+    }
+    if (path.size() == depth + 1) {
+      // The value at the end of a path is kept whole.
+      next_paths_ = absl::nullopt;
+      return;
+    }
+    next_paths_->push_back(index);
+  }
+  skip_value_ = next_paths_->empty();
+}
+
 bool ObjectHandler::start_array(std::size_t) {
+  if (skipContainer()) {
+    return true;
+  }
+  // Arrays are kept whole.
+  paths_stack_.push(absl::nullopt);
   FieldSharedPtr array = Field::createArray();
   array->setLineNumberStart(line_number_);
 
   switch (state_) {
   case State::ExpectValueOrStartObjectArray:
-    THROW_IF_NOT_OK(stack_.top()->insert(key_, array));
+    THROW_IF_NOT_OK(stack_.top()->insert(std::move(key_), array));
     stack_.push(array);
     state_ = State::ExpectArrayValueOrEndArray;
     return true;
@@ -692,10 +790,15 @@ bool ObjectHandler::start_array(std::size_t) {
 }
 
 bool ObjectHandler::end_array() {
+  if (skip_depth_ > 0) {
+    skip_depth_--;
+    return true;
+  }
   switch (state_) {
   case State::ExpectArrayValueOrEndArray:
     stack_.top()->setLineNumberEnd(line_number_);
     stack_.pop();
+    paths_stack_.pop();
 
     if (stack_.empty()) {
       state_ = State::ExpectFinished;
@@ -717,7 +820,7 @@ bool ObjectHandler::handleValueEvent(FieldSharedPtr ptr) {
   switch (state_) {
   case State::ExpectValueOrStartObjectArray:
     state_ = State::ExpectKeyOrEndObject;
-    THROW_IF_NOT_OK(stack_.top()->insert(key_, ptr));
+    THROW_IF_NOT_OK(stack_.top()->insert(std::move(key_), ptr));
     return true;
   case State::ExpectArrayValueOrEndArray:
     THROW_IF_NOT_OK(stack_.top()->append(ptr));
@@ -729,8 +832,9 @@ bool ObjectHandler::handleValueEvent(FieldSharedPtr ptr) {
 
 } // namespace
 
-absl::StatusOr<ObjectSharedPtr> Factory::loadFromString(const std::string& json) {
-  ObjectHandler handler;
+namespace {
+
+absl::StatusOr<ObjectSharedPtr> parse(const std::string& json, ObjectHandler& handler) {
   auto json_container = JsonContainer(json.c_str(), &handler);
 
   nlohmann::json::sax_parse(json_container, &handler);
@@ -742,6 +846,20 @@ absl::StatusOr<ObjectSharedPtr> Factory::loadFromString(const std::string& json)
   return handler.getRoot();
 }
 
+} // namespace
+
+absl::StatusOr<ObjectSharedPtr> Factory::loadFromString(const std::string& json) {
+  ObjectHandler handler;
+  return parse(json, handler);
+}
+
+absl::StatusOr<ObjectSharedPtr>
+Factory::loadFromString(const std::string& json,
+                        const std::vector<std::vector<std::string>>& paths) {
+  ObjectHandler handler(paths);
+  return parse(json, handler);
+}
+
 absl::StatusOr<FieldSharedPtr>
 loadFromProtobufStructInternal(const ProtobufWkt::Struct& protobuf_struct);
 
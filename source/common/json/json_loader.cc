@@ -10,6 +10,12 @@ absl::StatusOr<ObjectSharedPtr> Factory::loadFromString(const std::string& json)
   return Nlohmann::Factory::loadFromString(json);
 }
 
+absl::StatusOr<ObjectSharedPtr>
+Factory::loadFromString(const std::string& json,
+                        const std::vector<std::vector<std::string>>& paths) {
+  return Nlohmann::Factory::loadFromString(json, paths);
+}
+
 ObjectSharedPtr Factory::loadFromProtobufStruct(const ProtobufWkt::Struct& protobuf_struct) {
   return Nlohmann::Factory::loadFromProtobufStruct(protobuf_struct);
 }
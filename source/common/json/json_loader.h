@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "envoy/json/json_object.h"
 
@@ -17,6 +18,15 @@ public:
    */
   static absl::StatusOr<ObjectSharedPtr> loadFromString(const std::string& json);
 
+  /**
+   * Constructs a Json Object from a string, keeping only the parts of the document on the given
+   * paths of keys. The members of objects which are not on any path are dropped, while the values
+   * at the ends of the paths and arrays are kept whole. The whole string is still validated. This
+   * saves building the parts of large documents which are not looked at.
+   */
+  static absl::StatusOr<ObjectSharedPtr>
+  loadFromString(const std::string& json, const std::vector<std::vector<std::string>>& paths);
+
   /**
    * Constructs a Json Object from a Protobuf struct.
    */
@@ -21,10 +21,11 @@ ActiveTcpListener::ActiveTcpListener(Network::TcpConnectionHandler& parent,
                                      ThreadLocalOverloadStateOptRef overload_state)
     : OwnedActiveStreamListenerBase(
           parent, parent.dispatcher(),
-          parent.createListener(std::move(socket), *this, runtime, random, config, overload_state),
+          parent.createListener(Network::SocketSharedPtr(socket), *this, runtime, random, config,
+                                overload_state),
           config),
       tcp_conn_handler_(parent), connection_balancer_(connection_balancer),
-      listen_address_(listen_address) {
+      listen_address_(listen_address), listen_socket_(socket) {
   connection_balancer_.registerHandler(*this);
 }
 
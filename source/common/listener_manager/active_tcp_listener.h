@@ -48,6 +48,7 @@ public:
     ASSERT(num_listener_connections_ > 0);
     --num_listener_connections_;
     config_->openConnections().dec();
+    connection_balancer_.onConnectionClosed(*this);
   }
 
   // Network::TcpListenerCallbacks
@@ -96,6 +97,10 @@ public:
   // when rebalancing. The accepted socket can't be used to get the listening address, since
   // the accepted socket's remote address can be another address than the listening address.
   Network::Address::InstanceConstSharedPtr listen_address_;
+  // The socket this listener accepts connections from, if it was created from one. This is not
+  // owning so that the socket is still closed along with the listener. It's used by connection
+  // balancers that steer connections between the sockets of the workers in the kernel.
+  const std::weak_ptr<Network::Socket> listen_socket_;
 };
 
 using ActiveTcpListenerOptRef = absl::optional<std::reference_wrapper<ActiveTcpListener>>;
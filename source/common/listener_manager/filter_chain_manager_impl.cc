@@ -134,6 +134,8 @@ absl::Status FilterChainManagerImpl::addFilterChains(
       filter_chains;
   uint32_t new_filter_chain_size = 0;
   FilterChainsByName filter_chains_by_name;
+  // Hashing filter chain messages is expensive, avoid rehashing them as the map grows.
+  fc_contexts_.reserve(filter_chain_span.size());
 
   for (const auto& filter_chain : filter_chain_span) {
     const auto& filter_chain_match = filter_chain->filter_chain_match();
@@ -240,7 +242,7 @@ absl::Status FilterChainManagerImpl::addFilterChains(
           filter_chain_impl));
     }
 
-    fc_contexts_[*filter_chain] = filter_chain_impl;
+    fc_contexts_.emplace(*filter_chain, filter_chain_impl);
   }
   RETURN_IF_NOT_OK(convertIPsToTries());
   RETURN_IF_NOT_OK(copyOrRebuildDefaultFilterChain(default_filter_chain,
@@ -508,6 +510,47 @@ makeCidrListEntry(const std::string& cidr, const T& data, absl::Status& creation
   return std::make_pair<T, std::vector<Network::Address::CidrRange>>(T(data), std::move(subnets));
 }
 
+// Whether the catch-all entry "" of a CIDR map matches every address looked up in it without a
+// trie, which requires its IPv4 catch-all range to exist for the fake address of UDS connections.
+bool catchAllMatchesAnyAddress(absl::string_view cidr) {
+  return cidr.empty() && Network::SocketInterfaceSingleton::get().ipFamilySupported(AF_INET);
+}
+
+// Builds the trie of a CIDR map, unless the map only has an entry matching any address, which is
+// looked up directly instead. Most filter chains leave some of the IP levels unset, for which
+// neither the memory nor the build time of a trie is spent.
+template <class T>
+std::unique_ptr<Network::LcTrie::LcTrie<T>>
+makeCidrTrie(const absl::flat_hash_map<std::string, T>& cidr_map,
+             const std::vector<std::pair<T, std::vector<Network::Address::CidrRange>>>& cidr_list) {
+  if (cidr_map.size() == 1 && catchAllMatchesAnyAddress(cidr_map.begin()->first)) {
+    return nullptr;
+  }
+  return std::make_unique<Network::LcTrie::LcTrie<T>>(cidr_list, true);
+}
+
+// Returns the data of the entry of a CIDR map matching the address, if any, using the trie built
+// by makeCidrTrie().
+template <class T>
+const T* findCidrEntry(const absl::flat_hash_map<std::string, T>& cidr_map,
+                       const Network::LcTrie::LcTrie<T>* trie,
+                       const Network::Address::InstanceConstSharedPtr& address) {
+  if (trie == nullptr) {
+    ASSERT(cidr_map.size() == 1);
+    return &cidr_map.begin()->second;
+  }
+
+  // Match on both: exact IP and wider CIDR ranges using LcTrie.
+  const auto& data = trie->getData(address->type() == Network::Address::Type::Ip
+                                       ? address
+                                       : FilterChain::fakeAddress());
+  if (data.empty()) {
+    return nullptr;
+  }
+  ASSERT(data.size() == 1);
+  return &data.back();
+}
+
 }; // namespace
 
 const Network::FilterChain*
@@ -524,7 +567,8 @@ FilterChainManagerImpl::findFilterChain(const Network::ConnectionSocket& socket,
   if (address->type() == Network::Address::Type::Ip) {
     const auto port_match = destination_ports_map_.find(address->ip()->port());
     if (port_match != destination_ports_map_.end()) {
-      best_match_filter_chain = findFilterChainForDestinationIP(*port_match->second.second, socket);
+      best_match_filter_chain = findFilterChainForDestinationIP(
+          port_match->second.first, port_match->second.second.get(), socket);
       if (best_match_filter_chain != nullptr) {
         return best_match_filter_chain;
       } else {
@@ -537,7 +581,8 @@ FilterChainManagerImpl::findFilterChain(const Network::ConnectionSocket& socket,
   // Match on catch-all port 0 if there is no specific port sub tree.
   const auto port_match = destination_ports_map_.find(0);
   if (port_match != destination_ports_map_.end()) {
-    best_match_filter_chain = findFilterChainForDestinationIP(*port_match->second.second, socket);
+    best_match_filter_chain = findFilterChainForDestinationIP(
+        port_match->second.first, port_match->second.second.get(), socket);
   }
   return best_match_filter_chain != nullptr
              ? best_match_filter_chain
@@ -561,17 +606,12 @@ FilterChainManagerImpl::findFilterChainUsingMatcher(const Network::ConnectionSoc
 }
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDestinationIP(
-    const DestinationIPsTrie& destination_ips_trie, const Network::ConnectionSocket& socket) const {
-  auto address = socket.connectionInfoProvider().localAddress();
-  if (address->type() != Network::Address::Type::Ip) {
-    address = FilterChain::fakeAddress();
-  }
-
-  // Match on both: exact IP and wider CIDR ranges using LcTrie.
-  const auto& data = destination_ips_trie.getData(address);
-  if (!data.empty()) {
-    ASSERT(data.size() == 1);
-    return findFilterChainForServerName(*data.back(), socket);
+    const DestinationIPsMap& destination_ips_map, const DestinationIPsTrie* destination_ips_trie,
+    const Network::ConnectionSocket& socket) const {
+  const ServerNamesMapSharedPtr* data = findCidrEntry(
+      destination_ips_map, destination_ips_trie, socket.connectionInfoProvider().localAddress());
+  if (data != nullptr) {
+    return findFilterChainForServerName(**data, socket);
   }
 
   return nullptr;
@@ -580,7 +620,7 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDestinatio
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName(
     const ServerNamesMap& server_names_map, const Network::ConnectionSocket& socket) const {
   ASSERT(absl::AsciiStrToLower(socket.requestedServerName()) == socket.requestedServerName());
-  const std::string server_name(socket.requestedServerName());
+  const absl::string_view server_name = socket.requestedServerName();
 
   // Match on exact server name, i.e. "www.example.com" for "www.example.com".
   const auto server_name_exact_match = server_names_map.find(server_name);
@@ -591,7 +631,7 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
   // Match on all wildcard domains, i.e. ".example.com" and ".com" for "www.example.com".
   size_t pos = server_name.find('.', 1);
   while (pos < server_name.size() - 1 && pos != std::string::npos) {
-    const std::string wildcard = server_name.substr(pos);
+    const absl::string_view wildcard = server_name.substr(pos);
     const auto server_name_wildcard_match = server_names_map.find(wildcard);
     if (server_name_wildcard_match != server_names_map.end()) {
       return findFilterChainForTransportProtocol(server_name_wildcard_match->second, socket);
@@ -611,7 +651,7 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForTransportProtocol(
     const TransportProtocolsMap& transport_protocols_map,
     const Network::ConnectionSocket& socket) const {
-  const std::string transport_protocol(socket.detectedTransportProtocol());
+  const absl::string_view transport_protocol = socket.detectedTransportProtocol();
 
   // Match on exact transport protocol, e.g. "tls".
   const auto transport_protocol_match = transport_protocols_map.find(transport_protocol);
@@ -635,31 +675,31 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForApplicatio
   for (const auto& application_protocol : socket.requestedApplicationProtocols()) {
     const auto application_protocol_match = application_protocols_map.find(application_protocol);
     if (application_protocol_match != application_protocols_map.end()) {
-      return findFilterChainForDirectSourceIP(*application_protocol_match->second.second, socket);
+      return findFilterChainForDirectSourceIP(application_protocol_match->second.first,
+                                              application_protocol_match->second.second.get(),
+                                              socket);
     }
   }
 
   // Match on a filter chain without application protocol requirements.
   const auto any_protocol_match = application_protocols_map.find(EMPTY_STRING);
   if (any_protocol_match != application_protocols_map.end()) {
-    return findFilterChainForDirectSourceIP(*any_protocol_match->second.second, socket);
+    return findFilterChainForDirectSourceIP(any_protocol_match->second.first,
+                                            any_protocol_match->second.second.get(), socket);
   }
 
   return nullptr;
 }
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDirectSourceIP(
-    const DirectSourceIPsTrie& direct_source_ips_trie,
+    const DirectSourceIPsMap& direct_source_ips_map,
+    const DirectSourceIPsTrie* direct_source_ips_trie,
     const Network::ConnectionSocket& socket) const {
-  auto address = socket.connectionInfoProvider().directRemoteAddress();
-  if (address->type() != Network::Address::Type::Ip) {
-    address = FilterChain::fakeAddress();
-  }
-
-  const auto& data = direct_source_ips_trie.getData(address);
-  if (!data.empty()) {
-    ASSERT(data.size() == 1);
-    return findFilterChainForSourceTypes(*data.back(), socket);
+  const SourceTypesArraySharedPtr* data =
+      findCidrEntry(direct_source_ips_map, direct_source_ips_trie,
+                    socket.connectionInfoProvider().directRemoteAddress());
+  if (data != nullptr) {
+    return findFilterChainForSourceTypes(**data, socket);
   }
 
   return nullptr;
@@ -682,39 +722,39 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForSourceType
 
   if (is_local_connection) {
     if (!filter_chain_local.first.empty()) {
-      return findFilterChainForSourceIpAndPort(*filter_chain_local.second, socket);
+      return findFilterChainForSourceIpAndPort(filter_chain_local.first,
+                                               filter_chain_local.second.get(), socket);
     }
   } else {
     if (!filter_chain_external.first.empty()) {
-      return findFilterChainForSourceIpAndPort(*filter_chain_external.second, socket);
+      return findFilterChainForSourceIpAndPort(filter_chain_external.first,
+                                               filter_chain_external.second.get(), socket);
     }
   }
 
   const auto& filter_chain_any = source_types[envoy::config::listener::v3::FilterChainMatch::ANY];
 
   if (!filter_chain_any.first.empty()) {
-    return findFilterChainForSourceIpAndPort(*filter_chain_any.second, socket);
+    return findFilterChainForSourceIpAndPort(filter_chain_any.first, filter_chain_any.second.get(),
+                                             socket);
   } else {
     return nullptr;
   }
 }
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForSourceIpAndPort(
-    const SourceIPsTrie& source_ips_trie, const Network::ConnectionSocket& socket) const {
-  auto address = socket.connectionInfoProvider().remoteAddress();
-  if (address->type() != Network::Address::Type::Ip) {
-    address = FilterChain::fakeAddress();
-  }
-
-  // Match on both: exact IP and wider CIDR ranges using LcTrie.
-  const auto& data = source_ips_trie.getData(address);
-  if (data.empty()) {
+    const SourceIPsMap& source_ips_map, const SourceIPsTrie* source_ips_trie,
+    const Network::ConnectionSocket& socket) const {
+  const auto& address = socket.connectionInfoProvider().remoteAddress();
+  const SourcePortsMapSharedPtr* data = findCidrEntry(source_ips_map, source_ips_trie, address);
+  if (data == nullptr) {
     return nullptr;
   }
 
-  ASSERT(data.size() == 1);
-  const auto& source_ports_map = *data.back();
-  const uint32_t source_port = address->ip()->port();
+  const auto& source_ports_map = **data;
+  // UDS connections only match port 0.
+  const uint32_t source_port =
+      address->type() == Network::Address::Type::Ip ? address->ip()->port() : 0;
   const auto port_match = source_ports_map.find(source_port);
 
   // Did we get a direct hit on port.
@@ -781,17 +821,16 @@ absl::Status FilterChainManagerImpl::convertIPsToTries() {
                   RETURN_IF_NOT_OK(creation_status);
                 }
 
-                source_ips_trie = std::make_unique<SourceIPsTrie>(source_ips_list, true);
+                source_ips_trie = makeCidrTrie(source_ips_map, source_ips_list);
               }
             }
-            direct_source_ips_trie =
-                std::make_unique<DirectSourceIPsTrie>(direct_source_ips_list, true);
+            direct_source_ips_trie = makeCidrTrie(direct_source_ips_map, direct_source_ips_list);
           }
         }
       }
     }
 
-    destination_ips_trie = std::make_unique<DestinationIPsTrie>(destination_ips_list, true);
+    destination_ips_trie = makeCidrTrie(destination_ips_map, destination_ips_list);
   }
   return absl::OkStatus();
 }
@@ -803,10 +842,9 @@ Network::DrainableFilterChainSharedPtr FilterChainManagerImpl::findExistingFilte
   if (origin == nullptr) {
     return nullptr;
   }
+  // The context is added to this filter chain manager by the caller.
   auto iter = origin->fc_contexts_.find(filter_chain_message);
   if (iter != origin->fc_contexts_.end()) {
-    // copy the context to this filter chain manager.
-    fc_contexts_.emplace(filter_chain_message, iter->second);
     return iter->second;
   }
   return nullptr;
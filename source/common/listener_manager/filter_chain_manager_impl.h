@@ -185,6 +185,8 @@ private:
   using SourcePortsMap = absl::flat_hash_map<uint16_t, Network::FilterChainSharedPtr>;
   using SourcePortsMapSharedPtr = std::shared_ptr<SourcePortsMap>;
   using SourceIPsMap = absl::flat_hash_map<std::string, SourcePortsMapSharedPtr>;
+  // The tries of the IP levels are only built for maps with entries other than the catch-all
+  // entry "", and are null otherwise.
   using SourceIPsTrie = Network::LcTrie::LcTrie<SourcePortsMapSharedPtr>;
   using SourceIPsTriePtr = std::unique_ptr<SourceIPsTrie>;
   using SourceTypesArray = std::array<std::pair<SourceIPsMap, SourceIPsTriePtr>, 3>;
@@ -271,7 +273,8 @@ private:
                                             const Network::FilterChainSharedPtr& filter_chain);
 
   const Network::FilterChain*
-  findFilterChainForDestinationIP(const DestinationIPsTrie& destination_ips_trie,
+  findFilterChainForDestinationIP(const DestinationIPsMap& destination_ips_map,
+                                  const DestinationIPsTrie* destination_ips_trie,
                                   const Network::ConnectionSocket& socket) const;
   const Network::FilterChain*
   findFilterChainForServerName(const ServerNamesMap& server_names_map,
@@ -283,14 +286,16 @@ private:
   findFilterChainForApplicationProtocols(const ApplicationProtocolsMap& application_protocols_map,
                                          const Network::ConnectionSocket& socket) const;
   const Network::FilterChain*
-  findFilterChainForDirectSourceIP(const DirectSourceIPsTrie& direct_source_ips_trie,
+  findFilterChainForDirectSourceIP(const DirectSourceIPsMap& direct_source_ips_map,
+                                   const DirectSourceIPsTrie* direct_source_ips_trie,
                                    const Network::ConnectionSocket& socket) const;
   const Network::FilterChain*
   findFilterChainForSourceTypes(const SourceTypesArray& source_types,
                                 const Network::ConnectionSocket& socket) const;
 
   const Network::FilterChain*
-  findFilterChainForSourceIpAndPort(const SourceIPsTrie& source_ips_trie,
+  findFilterChainForSourceIpAndPort(const SourceIPsMap& source_ips_map,
+                                    const SourceIPsTrie* source_ips_trie,
                                     const Network::ConnectionSocket& socket) const;
 
   const FilterChainManagerImpl* getOriginFilterChainManager() { return origin_.value(); }
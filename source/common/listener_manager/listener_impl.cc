@@ -34,6 +34,8 @@
 #include "source/server/drain_manager_impl.h"
 #include "source/server/transport_socket_config_impl.h"
 
+#include "absl/container/flat_hash_set.h"
+
 #ifdef ENVOY_ENABLE_QUIC
 #include "source/common/quic/active_quic_listener.h"
 #include "source/common/quic/udp_gso_batch_writer.h"
@@ -1067,10 +1069,21 @@ ListenerImpl::newListenerWithFilterChain(const envoy::config::listener::v3::List
 
 void ListenerImpl::diffFilterChain(const ListenerImpl& another_listener,
                                    std::function<void(Network::DrainableFilterChain&)> callback) {
+  // Unchanged filter chains are shared by the listeners, and are found by pointer without hashing
+  // their messages.
+  absl::flat_hash_set<const Network::DrainableFilterChain*> another_filter_chains;
+  const auto& another_filter_chains_by_message =
+      another_listener.filter_chain_manager_->filterChainsByMessage();
+  another_filter_chains.reserve(another_filter_chains_by_message.size());
+  for (const auto& message_and_filter_chain : another_filter_chains_by_message) {
+    another_filter_chains.insert(message_and_filter_chain.second.get());
+  }
   for (const auto& message_and_filter_chain : filter_chain_manager_->filterChainsByMessage()) {
-    if (another_listener.filter_chain_manager_->filterChainsByMessage().find(
-            message_and_filter_chain.first) ==
-        another_listener.filter_chain_manager_->filterChainsByMessage().end()) {
+    if (another_filter_chains.contains(message_and_filter_chain.second.get())) {
+      continue;
+    }
+    if (another_filter_chains_by_message.find(message_and_filter_chain.first) ==
+        another_filter_chains_by_message.end()) {
       // The filter chain exists in `this` listener but not in the listener passed in.
       callback(*message_and_filter_chain.second);
     }
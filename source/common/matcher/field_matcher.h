@@ -2,6 +2,7 @@
 
 #include "envoy/matcher/matcher.h"
 
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/str_join.h"
 
 namespace Envoy {
@@ -25,6 +26,13 @@ struct FieldMatchResult {
   }
 };
 
+/**
+ * The values extracted by the shared data inputs of a list matcher during one match, by input
+ * index. Predicates with the same input extract it once and match against the stored value. This
+ * lives on the stack of the match, as match trees are shared by the workers.
+ */
+using DataInputValues = absl::InlinedVector<absl::optional<DataInputGetResult>, 4>;
+
 /**
  * Base class for matching against a single input.
  */
@@ -37,7 +45,16 @@ public:
    * @returns absl::optional<bool> if matching was possible, the result of the match. Otherwise
    * absl::nullopt if the data is not available.
    */
-  virtual FieldMatchResult match(const DataType& data) PURE;
+  FieldMatchResult match(const DataType& data) {
+    DataInputValues values;
+    return match(data, values);
+  }
+
+  /**
+   * Attempts to match against the provided data, reusing the values of shared data inputs that
+   * were already extracted during this match.
+   */
+  virtual FieldMatchResult match(const DataType& data, DataInputValues& values) PURE;
 };
 template <class DataType> using FieldMatcherPtr = std::unique_ptr<FieldMatcher<DataType>>;
 
@@ -52,9 +69,10 @@ public:
   explicit AllFieldMatcher(std::vector<FieldMatcherPtr<DataType>>&& matchers)
       : matchers_(std::move(matchers)) {}
 
-  FieldMatchResult match(const DataType& data) override {
+  using FieldMatcher<DataType>::match;
+  FieldMatchResult match(const DataType& data, DataInputValues& values) override {
     for (const auto& matcher : matchers_) {
-      const auto result = matcher->match(data);
+      const auto result = matcher->match(data, values);
 
       // If we are unable to decide on a match at this point, propagate this up to defer
       // the match result until we have the requisite data.
@@ -86,10 +104,11 @@ public:
   explicit AnyFieldMatcher(std::vector<FieldMatcherPtr<DataType>>&& matchers)
       : matchers_(std::move(matchers)) {}
 
-  FieldMatchResult match(const DataType& data) override {
+  using FieldMatcher<DataType>::match;
+  FieldMatchResult match(const DataType& data, DataInputValues& values) override {
     bool unable_to_match_some_matchers = false;
     for (const auto& matcher : matchers_) {
-      const auto result = matcher->match(data);
+      const auto result = matcher->match(data, values);
 
       if (result.match_state_ == MatchState::UnableToMatch) {
         unable_to_match_some_matchers = true;
@@ -121,8 +140,9 @@ template <class DataType> class NotFieldMatcher : public FieldMatcher<DataType>
 public:
   explicit NotFieldMatcher(FieldMatcherPtr<DataType> matcher) : matcher_(std::move(matcher)) {}
 
-  FieldMatchResult match(const DataType& data) override {
-    const auto result = matcher_->match(data);
+  using FieldMatcher<DataType>::match;
+  FieldMatchResult match(const DataType& data, DataInputValues& values) override {
+    const auto result = matcher_->match(data, values);
     if (result.match_state_ == MatchState::UnableToMatch) {
       return result;
     }
@@ -140,12 +160,26 @@ private:
  * if we failed to match and there is more data available.
  * A consequence of this is that if a match result is desired, care should be taken so that matching
  * is done with all the data available at some point.
+ *
+ * A SingleFieldMatcher may share its data input with the other predicates of a list matcher, in
+ * which case the input is extracted once per match of the list.
  */
 template <class DataType>
 class SingleFieldMatcher : public FieldMatcher<DataType>, Logger::Loggable<Logger::Id::matcher> {
 public:
   static absl::StatusOr<std::unique_ptr<SingleFieldMatcher<DataType>>>
   create(DataInputPtr<DataType>&& data_input, InputMatcherPtr&& input_matcher) {
+    return create(std::shared_ptr<DataInput<DataType>>(std::move(data_input)), absl::nullopt,
+                  std::move(input_matcher));
+  }
+
+  /**
+   * Creates a matcher for a shared data input, whose value is stored at `input_index` of the
+   * DataInputValues of a match.
+   */
+  static absl::StatusOr<std::unique_ptr<SingleFieldMatcher<DataType>>>
+  create(std::shared_ptr<DataInput<DataType>> data_input, absl::optional<size_t> input_index,
+         InputMatcherPtr&& input_matcher) {
     auto supported_input_types = input_matcher->supportedDataInputTypes();
     if (supported_input_types.find(data_input->dataInputType()) == supported_input_types.end()) {
       std::string supported_types =
@@ -155,13 +189,29 @@ public:
                        ". The matcher supports input type: ", supported_types));
     }
 
-    return std::unique_ptr<SingleFieldMatcher<DataType>>{
-        new SingleFieldMatcher<DataType>(std::move(data_input), std::move(input_matcher))};
+    return std::unique_ptr<SingleFieldMatcher<DataType>>{new SingleFieldMatcher<DataType>(
+        std::move(data_input), input_index, std::move(input_matcher))};
+  }
+
+  using FieldMatcher<DataType>::match;
+  FieldMatchResult match(const DataType& data, DataInputValues& values) override {
+    if (input_index_.has_value() && *input_index_ < values.size()) {
+      absl::optional<DataInputGetResult>& value = values[*input_index_];
+      if (!value.has_value()) {
+        value.emplace(data_input_->get(data));
+      }
+      return matchInput(*value);
+    }
+    return matchInput(data_input_->get(data));
   }
 
-  FieldMatchResult match(const DataType& data) override {
-    const auto input = data_input_->get(data);
+private:
+  SingleFieldMatcher(std::shared_ptr<DataInput<DataType>> data_input,
+                     absl::optional<size_t> input_index, InputMatcherPtr&& input_matcher)
+      : data_input_(std::move(data_input)), input_index_(input_index),
+        input_matcher_(std::move(input_matcher)) {}
 
+  FieldMatchResult matchInput(const DataInputGetResult& input) {
     ENVOY_LOG(trace, "Attempting to match {}", input);
     if (input.data_availability_ == DataInputGetResult::DataAvailability::NotAvailable) {
       return {MatchState::UnableToMatch, absl::nullopt};
@@ -179,11 +229,8 @@ public:
     return {MatchState::MatchComplete, current_match};
   }
 
-private:
-  SingleFieldMatcher(DataInputPtr<DataType>&& data_input, InputMatcherPtr&& input_matcher)
-      : data_input_(std::move(data_input)), input_matcher_(std::move(input_matcher)) {}
-
-  const DataInputPtr<DataType> data_input_;
+  const std::shared_ptr<DataInput<DataType>> data_input_;
+  const absl::optional<size_t> input_index_;
   const InputMatcherPtr input_matcher_;
 };
 
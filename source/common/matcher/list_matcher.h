@@ -10,14 +10,19 @@ namespace Matcher {
 /**
  * A match tree that iterates over a list of matchers to find the first one that matches. If one
  * does, the MatchResult will be the one specified by the individual matcher.
+ *
+ * The matchers may share `num_shared_inputs` data inputs, each of which is extracted at most once
+ * per match.
  */
 template <class DataType> class ListMatcher : public MatchTree<DataType> {
 public:
-  explicit ListMatcher(absl::optional<OnMatch<DataType>> on_no_match) : on_no_match_(on_no_match) {}
+  explicit ListMatcher(absl::optional<OnMatch<DataType>> on_no_match, size_t num_shared_inputs = 0)
+      : on_no_match_(on_no_match), num_shared_inputs_(num_shared_inputs) {}
 
   typename MatchTree<DataType>::MatchResult match(const DataType& matching_data) override {
+    DataInputValues values(num_shared_inputs_);
     for (const auto& matcher : matchers_) {
-      const auto maybe_match = matcher.first->match(matching_data);
+      const auto maybe_match = matcher.first->match(matching_data, values);
 
       // One of the matchers don't have enough information, bail on evaluating the match.
       if (maybe_match.match_state_ == MatchState::UnableToMatch) {
@@ -38,6 +43,7 @@ public:
 
 private:
   absl::optional<OnMatch<DataType>> on_no_match_;
+  const size_t num_shared_inputs_;
   std::vector<std::pair<FieldMatcherPtr<DataType>, OnMatch<DataType>>> matchers_;
 };
 
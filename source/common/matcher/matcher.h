@@ -18,6 +18,7 @@
 #include "source/common/matcher/validation_visitor.h"
 #include "source/common/matcher/value_input_matcher.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
@@ -61,7 +62,13 @@ static inline MaybeMatchResult evaluateMatch(MatchTree<DataType>& match_tree,
   return MaybeMatchResult{result.on_match_->action_cb_, MatchState::MatchComplete};
 }
 
-template <class DataType> using FieldMatcherFactoryCb = std::function<FieldMatcherPtr<DataType>()>;
+template <class DataType>
+using SharedDataInputs = std::vector<std::shared_ptr<DataInput<DataType>>>;
+
+// Creates a FieldMatcher using the shared data inputs of its list matcher.
+template <class DataType>
+using FieldMatcherFactoryCb =
+    std::function<FieldMatcherPtr<DataType>(const SharedDataInputs<DataType>&)>;
 
 /**
  * A matcher that will always resolve to associated on_no_match. This is used when
@@ -179,6 +186,13 @@ public:
   }
 
 private:
+  // The distinct data inputs of the predicates of a list matcher. Predicates with the same input
+  // config share one data input, which is only extracted once per match.
+  struct SharedDataInputFactories {
+    absl::flat_hash_map<std::string, size_t> index_by_config_;
+    std::vector<DataInputFactoryCb<DataType>> factories_;
+  };
+
   template <class MatcherType>
   MatchTreeFactoryCb<DataType> createAnyMatcher(const MatcherType& config) {
     auto on_no_match = createOnMatch(config.on_no_match());
@@ -193,19 +207,28 @@ private:
     std::vector<std::pair<FieldMatcherFactoryCb<DataType>, OnMatchFactoryCb<DataType>>>
         matcher_factories;
     matcher_factories.reserve(config.matcher_list().matchers().size());
+    SharedDataInputFactories shared_inputs;
     for (const auto& matcher : config.matcher_list().matchers()) {
-      matcher_factories.push_back(std::make_pair(
-          createFieldMatcher<typename MatcherType::MatcherList::Predicate>(matcher.predicate()),
-          *createOnMatch(matcher.on_match())));
+      matcher_factories.push_back(
+          std::make_pair(createFieldMatcher<typename MatcherType::MatcherList::Predicate>(
+                             matcher.predicate(), shared_inputs),
+                         *createOnMatch(matcher.on_match())));
     }
 
     auto on_no_match = createOnMatch(config.on_no_match());
-    return [matcher_factories, on_no_match]() {
+    return [matcher_factories, input_factories = std::move(shared_inputs.factories_),
+            on_no_match]() {
+      SharedDataInputs<DataType> data_inputs;
+      data_inputs.reserve(input_factories.size());
+      for (const auto& input_factory : input_factories) {
+        data_inputs.emplace_back(input_factory());
+      }
+
       auto list_matcher = std::make_unique<ListMatcher<DataType>>(
-          on_no_match ? absl::make_optional((*on_no_match)()) : absl::nullopt);
+          on_no_match ? absl::make_optional((*on_no_match)()) : absl::nullopt, data_inputs.size());
 
       for (const auto& matcher : matcher_factories) {
-        list_matcher->addMatcher(matcher.first(), matcher.second());
+        list_matcher->addMatcher(matcher.first(data_inputs), matcher.second());
       }
 
       return list_matcher;
@@ -214,17 +237,18 @@ private:
 
   template <class MatcherT, class PredicateType, class FieldPredicateType>
   FieldMatcherFactoryCb<DataType> createAggregateFieldMatcherFactoryCb(
-      const Protobuf::RepeatedPtrField<FieldPredicateType>& predicates) {
+      const Protobuf::RepeatedPtrField<FieldPredicateType>& predicates,
+      SharedDataInputFactories& shared_inputs) {
     std::vector<FieldMatcherFactoryCb<DataType>> sub_matchers;
     for (const auto& predicate : predicates) {
-      sub_matchers.emplace_back(createFieldMatcher<PredicateType>(predicate));
+      sub_matchers.emplace_back(createFieldMatcher<PredicateType>(predicate, shared_inputs));
     }
 
-    return [sub_matchers]() {
+    return [sub_matchers](const SharedDataInputs<DataType>& data_inputs) {
       std::vector<FieldMatcherPtr<DataType>> matchers;
       matchers.reserve(sub_matchers.size());
       for (const auto& factory_cb : sub_matchers) {
-        matchers.emplace_back(factory_cb());
+        matchers.emplace_back(factory_cb(data_inputs));
       }
 
       return std::make_unique<MatcherT>(std::move(matchers));
@@ -232,30 +256,32 @@ private:
   }
 
   template <class PredicateType, class FieldMatcherType>
-  FieldMatcherFactoryCb<DataType> createFieldMatcher(const FieldMatcherType& field_predicate) {
+  FieldMatcherFactoryCb<DataType> createFieldMatcher(const FieldMatcherType& field_predicate,
+                                                     SharedDataInputFactories& shared_inputs) {
     switch (field_predicate.match_type_case()) {
     case (PredicateType::kSinglePredicate): {
-      auto data_input =
-          match_input_factory_.createDataInput(field_predicate.single_predicate().input());
+      const size_t input_index =
+          addSharedDataInput(field_predicate.single_predicate().input(), shared_inputs);
       auto input_matcher = createInputMatcher(field_predicate.single_predicate());
 
-      return [data_input, input_matcher]() {
-        return THROW_OR_RETURN_VALUE(
-            SingleFieldMatcher<DataType>::create(data_input(), input_matcher()),
-            std::unique_ptr<SingleFieldMatcher<DataType>>);
+      return [input_index, input_matcher](const SharedDataInputs<DataType>& data_inputs) {
+        return THROW_OR_RETURN_VALUE(SingleFieldMatcher<DataType>::create(
+                                         data_inputs[input_index], input_index, input_matcher()),
+                                     std::unique_ptr<SingleFieldMatcher<DataType>>);
       };
     }
     case (PredicateType::kOrMatcher):
       return createAggregateFieldMatcherFactoryCb<AnyFieldMatcher<DataType>, PredicateType>(
-          field_predicate.or_matcher().predicate());
+          field_predicate.or_matcher().predicate(), shared_inputs);
     case (PredicateType::kAndMatcher):
       return createAggregateFieldMatcherFactoryCb<AllFieldMatcher<DataType>, PredicateType>(
-          field_predicate.and_matcher().predicate());
+          field_predicate.and_matcher().predicate(), shared_inputs);
     case (PredicateType::kNotMatcher): {
-      auto matcher_factory = createFieldMatcher<PredicateType>(field_predicate.not_matcher());
+      auto matcher_factory =
+          createFieldMatcher<PredicateType>(field_predicate.not_matcher(), shared_inputs);
 
-      return [matcher_factory]() {
-        return std::make_unique<NotFieldMatcher<DataType>>(matcher_factory());
+      return [matcher_factory](const SharedDataInputs<DataType>& data_inputs) {
+        return std::make_unique<NotFieldMatcher<DataType>>(matcher_factory(data_inputs));
       };
     }
     case PredicateType::MATCH_TYPE_NOT_SET:
@@ -264,6 +290,21 @@ private:
     PANIC_DUE_TO_CORRUPT_ENUM;
   }
 
+  // @return the index of the shared data input for `input`, which is added if no other predicate of
+  //         the list has the same input.
+  template <class TypedExtensionConfigType>
+  size_t addSharedDataInput(const TypedExtensionConfigType& input,
+                            SharedDataInputFactories& shared_inputs) {
+    // Every input is validated, even when it is shared.
+    auto data_input = match_input_factory_.createDataInput(input);
+    const auto [it, inserted] = shared_inputs.index_by_config_.try_emplace(
+        input.SerializeAsString(), shared_inputs.factories_.size());
+    if (inserted) {
+      shared_inputs.factories_.push_back(std::move(data_input));
+    }
+    return it->second;
+  }
+
   template <class MatcherType>
   MatchTreeFactoryCb<DataType> createTreeMatcher(const MatcherType& matcher) {
     auto data_input = match_input_factory_.createDataInput(matcher.matcher_tree().input());
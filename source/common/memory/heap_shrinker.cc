@@ -1,5 +1,6 @@
 #include "source/common/memory/heap_shrinker.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/memory/utils.h"
 #include "source/common/stats/symbol_table.h"
 
@@ -30,6 +31,9 @@ HeapShrinker::HeapShrinker(Event::Dispatcher& dispatcher, Server::OverloadManage
 
 void HeapShrinker::shrinkHeap() {
   if (active_) {
+    // Drop slice storage cached by each thread so that it can be returned to the OS below. Worker
+    // pools are drained lazily the next time they are used.
+    Buffer::SliceStoragePool::releaseAll();
     Utils::releaseFreeMemory();
     shrink_counter_->inc();
   }
@@ -1,11 +1,19 @@
 #include "source/common/memory/stats.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 #include "source/common/common/assert.h"
 #include "source/common/common/logger.h"
 
+#include "absl/strings/match.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/str_split.h"
+
 #if defined(TCMALLOC)
+#include "absl/debugging/symbolize.h"
 #include "tcmalloc/malloc_extension.h"
 #elif defined(GPERFTOOLS_TCMALLOC)
 #include "gperftools/malloc_extension.h"
@@ -107,6 +115,51 @@ void Stats::dumpStatsToLog() {
 #endif
 }
 
+absl::flat_hash_map<std::string, uint64_t> Stats::allocatedBySubsystem() {
+  absl::flat_hash_map<std::string, uint64_t> allocated;
+#if defined(TCMALLOC)
+  // Many samples share frames, so the subsystem of each frame is only looked up once.
+  absl::flat_hash_map<const void*, absl::optional<std::string>> frame_subsystems;
+  const auto frame_subsystem = [&frame_subsystems](const void* frame) {
+    auto [it, inserted] = frame_subsystems.try_emplace(frame);
+    if (inserted) {
+      char symbol[1024];
+      if (absl::Symbolize(frame, symbol, sizeof(symbol))) {
+        it->second = subsystemOfSymbol(symbol);
+      }
+    }
+    return it->second;
+  };
+  tcmalloc::MallocExtension::SnapshotCurrent(tcmalloc::ProfileType::kHeap)
+      .Iterate([&](const tcmalloc::Profile::Sample& sample) {
+        std::string subsystem = "other";
+        // The stack starts with the innermost frame.
+        for (int i = 0; i < sample.depth; ++i) {
+          absl::optional<std::string> frame = frame_subsystem(sample.stack[i]);
+          if (frame.has_value()) {
+            subsystem = std::move(*frame);
+            break;
+          }
+        }
+        allocated[subsystem] += sample.sum;
+      });
+#endif
+  return allocated;
+}
+
+absl::optional<std::string> Stats::subsystemOfSymbol(absl::string_view symbol) {
+  if (!absl::StartsWith(symbol, "Envoy::")) {
+    return absl::nullopt;
+  }
+  // Only the qualified name is split, not the template or function parameters.
+  symbol = symbol.substr(0, symbol.find_first_of("<("));
+  std::vector<absl::string_view> names = absl::StrSplit(symbol, "::");
+  const size_t depth = names.size() > 1 && names[1] == "Extensions" ? 4 : 2;
+  // The last name is the function, which is not part of the subsystem.
+  names.resize(std::max<size_t>(1, std::min(depth, names.size() - 1)));
+  return absl::StrJoin(names, "::");
+}
+
 AllocatorManager::AllocatorManager(
     Api::Api& api, Envoy::Stats::Scope& scope,
     const envoy::config::bootstrap::v3::MemoryAllocatorManager& config)
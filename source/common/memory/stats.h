@@ -8,6 +8,10 @@
 #include "source/common/common/thread.h"
 #include "source/common/protobuf/utility.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
 namespace Envoy {
 
 #define MEMORY_ALLOCATOR_MANAGER_STATS(COUNTER) COUNTER(released_by_timer)
@@ -64,6 +68,23 @@ public:
    * Log detailed stats about current memory allocation. Intended for debugging purposes.
    */
   static void dumpStatsToLog();
+
+  /**
+   * Estimates the memory currently allocated by each subsystem from the sampled heap profile of
+   * the allocator. The allocations are attributed to the subsystem of the innermost frame of their
+   * stack in the Envoy namespace, see subsystemOfSymbol(), or to "other" if there is none. This
+   * symbolizes the stacks of the samples, so it's meant for on demand debugging only.
+   * @return the estimated allocated bytes by subsystem, empty if the allocator doesn't sample
+   *         allocations.
+   */
+  static absl::flat_hash_map<std::string, uint64_t> allocatedBySubsystem();
+
+  /**
+   * @return the subsystem of a symbol in the Envoy namespace, i.e. its first two namespaces, or its
+   *         first four under Envoy::Extensions (e.g. Envoy::Stats or
+   *         Envoy::Extensions::TransportSockets::Tls), or nullopt for other symbols.
+   */
+  static absl::optional<std::string> subsystemOfSymbol(absl::string_view symbol);
 };
 
 class AllocatorManager {
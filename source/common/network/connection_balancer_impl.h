@@ -38,6 +38,7 @@ public:
   void registerHandler(BalancedConnectionHandler& handler) override;
   void unregisterHandler(BalancedConnectionHandler& handler) override;
   BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler) override;
+  void onConnectionClosed(BalancedConnectionHandler&) override {}
 
 private:
   absl::Mutex lock_;
@@ -59,6 +60,7 @@ public:
     current_handler.incNumConnections();
     return current_handler;
   }
+  void onConnectionClosed(BalancedConnectionHandler&) override {}
 };
 
 } // namespace Network
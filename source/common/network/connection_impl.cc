@@ -737,6 +737,15 @@ ConnectionImpl::unixSocketPeerCredentials() const {
 #endif
 }
 
+OptRef<IoHandle> ConnectionImpl::socketIoHandle() {
+  // Transport sockets may transform or observe the payload even without TLS, e.g. by adding a
+  // PROXY protocol header or tapping it.
+  if (!transport_socket_->passesRawBytesThrough()) {
+    return {};
+  }
+  return socket_->ioHandle();
+}
+
 void ConnectionImpl::onWriteReady() {
   ENVOY_CONN_LOG(trace, "write ready", *this);
 
@@ -88,6 +88,7 @@ public:
     return socket_->connectionInfoProviderSharedPtr();
   }
   absl::optional<UnixDomainSocketPeerCredentials> unixSocketPeerCredentials() const override;
+  OptRef<IoHandle> socketIoHandle() override;
   Ssl::ConnectionInfoConstSharedPtr ssl() const override {
     // SSL info may be overwritten by a filter in the provider.
     return socket_->connectionInfoProvider().sslConnection();
@@ -14,6 +14,7 @@
 #include "source/common/network/cidr_range.h"
 #include "source/common/network/utility.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_set.h"
 #include "absl/numeric/int128.h"
 #include "fmt/format.h"
@@ -23,11 +24,11 @@ namespace Network {
 namespace LcTrie {
 
 /**
- * Maximum number of nodes an LC trie can hold.
- * @note If the size of LcTrieInternal::LcNode::address_ ever changes, this constant
- *       should be changed to match.
+ * Maximum number of nodes an LC trie can hold. This bounds the size of the node array to 128MiB,
+ * and allows up to 4M CIDR ranges with the default fill factor.
+ * @note This must fit in LcTrieInternal::LcNode::address_.
  */
-constexpr size_t MaxLcTrieNodes = (1 << 20);
+constexpr size_t MaxLcTrieNodes = (1 << 24);
 
 /**
  * Level Compressed Trie for associating data with CIDR ranges. Both IPv4 and IPv6 addresses are
@@ -58,8 +59,8 @@ public:
   LcTrie(const std::vector<std::pair<T, std::vector<Address::CidrRange>>>& data,
          bool exclusive = false, double fill_factor = 0.5, uint32_t root_branching_factor = 0) {
 
-    // The LcTrie implementation uses 20-bit "pointers" in its compact internal representation,
-    // so it cannot hold more than 2^20 nodes. But the number of nodes can be greater than the
+    // The LcTrie implementation cannot hold more than MaxLcTrieNodes nodes. But the number of
+    // nodes can be greater than the
     // number of supported prefixes. Given N prefixes in the data input list, step 2 below can
     // produce a new list of up to 2*N prefixes to insert in the LC trie. And the LC trie can
     // use up to 2*N/fill_factor nodes.
@@ -180,9 +181,9 @@ public:
    * @param  ip_address supplies the IP address.
    * @return a vector of data from the CIDR ranges and IP addresses that contains 'ip_address'. An
    * empty vector is returned if no prefix contains 'ip_address' or there is no data for the IP
-   * version of the ip_address.
+   * version of the ip_address. The vector is owned by the trie.
    */
-  std::vector<T> getData(const Network::Address::InstanceConstSharedPtr& ip_address) const {
+  const std::vector<T>& getData(const Network::Address::InstanceConstSharedPtr& ip_address) const {
     if (ip_address->ip()->version() == Address::IpVersion::v4) {
       Ipv4 ip = ntohl(ip_address->ip()->ipv4()->address());
       return ipv4_trie_->getData(ip);
@@ -409,8 +410,8 @@ private:
    * 'http://www.csc.kth.se/~snilsson/software/router/C/' were used as reference during
    * implementation.
    *
-   * Note: The trie can only support up 524288(2^19) prefixes with a fill_factor of 1 and
-   * root_branching_factor not set. Refer to LcTrieInternal::build() method for more details.
+   * Note: The trie can only support up to MaxLcTrieNodes / 2 prefixes with a fill_factor of 1
+   * and root_branching_factor not set. Refer to LcTrieInternal::build() method for more details.
    */
   template <class IpType, uint32_t address_size = CHAR_BIT * sizeof(IpType)> class LcTrieInternal {
   public:
@@ -432,19 +433,22 @@ private:
      * @return a vector of data from the CIDR ranges and IP addresses that encompasses the input.
      * An empty vector is returned if the LC Trie is empty.
      */
-    std::vector<T> getData(const IpType& ip_address) const;
+    const std::vector<T>& getData(const IpType& ip_address) const;
 
   private:
     /**
      * Builds the Level Compressed Trie, by first sorting the data, removing duplicated
-     * prefixes and invoking buildRecursive() to build the trie.
+     * prefixes and invoking buildRecursive() to build the trie. Then replaces the prefixes with
+     * compact leaves.
      */
     void build(std::vector<IpPrefix<IpType>>& data) {
+      // No prefix contains an address in the first data set.
+      data_sets_.emplace_back();
       if (data.empty()) {
         return;
       }
 
-      ip_prefixes_ = data;
+      ip_prefixes_ = std::move(data);
       std::sort(ip_prefixes_.begin(), ip_prefixes_.end());
 
       // Build the trie_.
@@ -456,6 +460,42 @@ private:
       ASSERT(next_free_index <= trie_.size());
       trie_.resize(next_free_index);
       trie_.shrink_to_fit();
+
+      buildLeaves();
+    }
+
+    /**
+     * Moves the prefixes to leaves_, with one copy of each distinct data set in data_sets_. Large
+     * inputs usually have many more prefixes than distinct data sets, so this keeps the memory
+     * touched by a lookup small, and lets it return the data without copying it.
+     */
+    void buildLeaves() {
+      // The indexes in data_sets_ of the data sets, by the sum of the hashes of their elements,
+      // which does not depend on the order of the elements.
+      absl::flat_hash_map<size_t, std::vector<uint32_t>> data_sets_by_hash;
+      leaves_.reserve(ip_prefixes_.size());
+      for (const IpPrefix<IpType>& prefix : ip_prefixes_) {
+        size_t hash = 0;
+        for (const T& element : prefix.data_) {
+          hash += absl::Hash<T>()(element);
+        }
+        std::vector<uint32_t>& candidates = data_sets_by_hash[hash];
+        const auto same_data = [&prefix, this](uint32_t index) {
+          const std::vector<T>& data_set = data_sets_[index];
+          return data_set.size() == prefix.data_.size() &&
+                 std::all_of(data_set.begin(), data_set.end(), [&prefix](const T& element) {
+                   return prefix.data_.contains(element);
+                 });
+        };
+        auto it = std::find_if(candidates.begin(), candidates.end(), same_data);
+        if (it == candidates.end()) {
+          data_sets_.emplace_back(prefix.data_.begin(), prefix.data_.end());
+          it = candidates.insert(candidates.end(), data_sets_.size() - 1);
+        }
+        leaves_.push_back(Leaf{prefix.ip_, prefix.length_, *it});
+      }
+      data_sets_.shrink_to_fit();
+      std::vector<IpPrefix<IpType>>().swap(ip_prefixes_);
     }
 
     // Thin wrapper around computeBranch output to facilitate code readability.
@@ -658,34 +698,47 @@ private:
     }
 
     /**
-     * LcNode is a uint32_t. A wrapper is provided to simplify getting/setting the branch, the
-     * skip and the address values held within the structure.
-     *
-     * The LcNode has three parts to it
-     * - Branch: the first 5 bits represent the branching factor. The branching factor is used to
-     * determine the number of descendants for the current node. The number represents a power of
-     * 2, so there can be at most 2^31 descendant nodes.
-     * - Skip: the next 7 bits represent the number of bits to skip when looking at an IP address.
-     * This value can be between 0 and 127, so IPv6 is supported.
-     * - Address: the remaining 20 bits represent an index either into the trie_ or the
-     * ip_prefixes_. If branch_ != 0, the index is for the trie_. If branch == zero, the index is
-     * for the ip_prefixes_.
-     *
-     * Note: If more than 2^19-1 CIDR ranges are to be stored in trie_, uint64_t should be used
-     * instead.
+     * LcNode has three parts to it
+     * - Branch: the branching factor. The branching factor is used to determine the number of
+     * descendants for the current node. The number represents a power of 2.
+     * - Skip: the number of bits to skip when looking at an IP address. This value can be between
+     * 0 and 128, so IPv6 is supported.
+     * - Address: an index either into the trie_ or the leaves_. If branch_ != 0, the index is for
+     * the trie_. If branch == zero, the index is for the leaves_.
      */
     struct LcNode {
-      uint32_t branch_ : 5;
-      uint32_t skip_ : 7;
-      uint32_t address_ : 20; // If this 20-bit size changes, please change MaxLcTrieNodes too.
+      uint32_t address_;
+      uint8_t branch_;
+      uint8_t skip_;
+    };
+    static_assert(sizeof(LcNode) == 8, "LcNode should stay small to fit more nodes per cache line");
+
+    /**
+     * A CIDR range at a leaf of the trie, with the index of its data in data_sets_.
+     */
+    struct Leaf {
+      bool contains(const IpType& address) const {
+        return (extractBits<IpType, address_size>(0, length_, ip_) ==
+                extractBits<IpType, address_size>(0, length_, address));
+      }
+
+      IpType ip_;
+      uint32_t length_;
+      uint32_t data_index_;
     };
 
+    // The prefixes the trie is built from. They are replaced by leaves_ once the trie is built.
+    std::vector<IpPrefix<IpType>> ip_prefixes_;
+
     // The CIDR range and data needs to be maintained separately from the LC-Trie. A LC-Trie skips
     // chunks of data while searching for a match. This means that the node found in the LC-Trie
     // is not guaranteed to have the IP address in range. The last step prior to returning
     // associated data is to check the CIDR range pointed to by the node in the LC-Trie has
     // the IP address in range.
-    std::vector<IpPrefix<IpType>> ip_prefixes_;
+    std::vector<Leaf> leaves_;
+
+    // The distinct data sets of the leaves. The first one is empty.
+    std::vector<std::vector<T>> data_sets_;
 
     // Main trie search structure.
     std::vector<LcNode> trie_;
@@ -709,11 +762,10 @@ LcTrie<T>::LcTrieInternal<IpType, address_size>::LcTrieInternal(std::vector<IpPr
 
 template <class T>
 template <class IpType, uint32_t address_size>
-std::vector<T>
+const std::vector<T>&
 LcTrie<T>::LcTrieInternal<IpType, address_size>::getData(const IpType& ip_address) const {
-  std::vector<T> return_vector;
   if (trie_.empty()) {
-    return return_vector;
+    return data_sets_[0];
   }
 
   LcNode node = trie_[0];
@@ -735,11 +787,11 @@ LcTrie<T>::LcTrieInternal<IpType, address_size>::getData(const IpType& ip_addres
   // The path taken through the trie to match the ip_address may have contained skips,
   // so it is necessary to check whether the matched prefix really contains the
   // ip_address.
-  const auto& prefix = ip_prefixes_[address];
-  if (prefix.contains(ip_address)) {
-    return std::vector<T>(prefix.data_.begin(), prefix.data_.end());
+  const Leaf& leaf = leaves_[address];
+  if (leaf.contains(ip_address)) {
+    return data_sets_[leaf.data_index_];
   }
-  return std::vector<T>();
+  return data_sets_[0];
 }
 
 } // namespace LcTrie
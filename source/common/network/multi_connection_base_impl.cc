@@ -182,6 +182,14 @@ MultiConnectionBaseImpl::unixSocketPeerCredentials() const {
   return connections_[0]->unixSocketPeerCredentials();
 }
 
+OptRef<IoHandle> MultiConnectionBaseImpl::socketIoHandle() {
+  if (!connect_finished_) {
+    // The socket that is going to carry the connection has not been picked yet.
+    return {};
+  }
+  return connections_[0]->socketIoHandle();
+}
+
 Ssl::ConnectionInfoConstSharedPtr MultiConnectionBaseImpl::ssl() const {
   return connections_[0]->ssl();
 }
@@ -24,6 +24,7 @@ public:
   Ssl::ConnectionInfoConstSharedPtr ssl() const override { return nullptr; }
   bool startSecureTransport() override { return false; }
   void configureInitialCongestionWindow(uint64_t, std::chrono::microseconds) override {}
+  bool passesRawBytesThrough() const override { return true; }
 
 protected:
   TransportSocketCallbacks* transportSocketCallbacks() const { return callbacks_; };
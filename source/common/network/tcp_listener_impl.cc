@@ -18,17 +18,21 @@
 namespace Envoy {
 namespace Network {
 
-bool TcpListenerImpl::rejectCxOverGlobalLimit() const {
-  // Enforce the global connection limit if necessary, immediately closing the accepted connection.
+uint64_t TcpListenerImpl::globalCxLimit() const {
   if (ignore_global_conn_limit_) {
-    return false;
+    return std::numeric_limits<uint64_t>::max();
   }
+  // TODO(tonya11en): In integration tests, threadsafeSnapshot is necessary since the
+  // FakeUpstreams use a listener and do not run in a worker thread. In practice, this code path
+  // will always be run on a worker thread, but to prevent failed assertions in test environments,
+  // threadsafe snapshots must be used. This must be revisited.
+  const Runtime::SnapshotConstSharedPtr snapshot = runtime_.threadsafeSnapshot();
   // TODO(nezdolik): deprecate `overload.global_downstream_max_connections` key once
   // downstream connections monitor extension is stable.
   if (track_global_cx_limit_in_overload_manager_) {
     // Check if runtime flag `overload.global_downstream_max_connections` is configured
     // simultaneously with downstream connections monitor in overload manager.
-    if (runtime_.threadsafeSnapshot()->get(Runtime::Keys::GlobalMaxCxRuntimeKey)) {
+    if (snapshot->get(Runtime::Keys::GlobalMaxCxRuntimeKey)) {
       ENVOY_LOG_ONCE_MISC(
           warn,
           "Global downstream connections limits is configured via deprecated runtime key {} and in "
@@ -36,27 +40,35 @@ bool TcpListenerImpl::rejectCxOverGlobalLimit() const {
           Runtime::Keys::GlobalMaxCxRuntimeKey,
           Server::OverloadProactiveResources::get().GlobalDownstreamMaxConnections);
     }
+    return std::numeric_limits<uint64_t>::max();
+  }
+  // If the connection limit is not set, don't limit the connections, but still track them.
+  return snapshot->getInteger(Runtime::Keys::GlobalMaxCxRuntimeKey,
+                              std::numeric_limits<uint64_t>::max());
+}
+
+bool TcpListenerImpl::rejectCxOverGlobalLimit(uint64_t global_cx_limit) const {
+  // Enforce the global connection limit if necessary, immediately closing the accepted connection.
+  if (ignore_global_conn_limit_) {
+    return false;
+  }
+  if (track_global_cx_limit_in_overload_manager_) {
     // Try to allocate resource within overload manager. We do it once here, instead of checking if
     // it is possible to allocate resource in this method and then actually allocating it later in
     // the code to avoid race conditions.
     return !(overload_state_->tryAllocateResource(
         Server::OverloadProactiveResourceName::GlobalDownstreamMaxConnections, 1));
-  } else {
-    // If the connection limit is not set, don't limit the connections, but still track them.
-    // TODO(tonya11en): In integration tests, threadsafeSnapshot is necessary since the
-    // FakeUpstreams use a listener and do not run in a worker thread. In practice, this code path
-    // will always be run on a worker thread, but to prevent failed assertions in test environments,
-    // threadsafe snapshots must be used. This must be revisited.
-    const uint64_t global_cx_limit = runtime_.threadsafeSnapshot()->getInteger(
-        Runtime::Keys::GlobalMaxCxRuntimeKey, std::numeric_limits<uint64_t>::max());
-    return AcceptedSocketImpl::acceptedSocketCount() >= global_cx_limit;
   }
+  return AcceptedSocketImpl::acceptedSocketCount() >= global_cx_limit;
 }
 
 absl::Status TcpListenerImpl::onSocketEvent(short flags) {
   ASSERT(bind_to_port_);
   ASSERT(flags & (Event::FileReadyType::Read));
 
+  // Runtime is only consulted once for however many connections are accepted below, as taking a
+  // snapshot for each of them is expensive when connections are being rejected in bulk.
+  const uint64_t global_cx_limit = globalCxLimit();
   uint32_t connections_accepted_from_kernel_count = 0;
   for (; connections_accepted_from_kernel_count < max_connections_to_accept_per_socket_event_;
        ++connections_accepted_from_kernel_count) {
@@ -73,7 +85,7 @@ absl::Status TcpListenerImpl::onSocketEvent(short flags) {
       break;
     }
 
-    if (rejectCxOverGlobalLimit()) {
+    if (rejectCxOverGlobalLimit(global_cx_limit)) {
       // The global connection limit has been reached.
       io_handle->close();
       cb_.onReject(TcpListenerCallbacks::RejectCause::GlobalCxLimit);
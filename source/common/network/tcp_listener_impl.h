@@ -38,9 +38,13 @@ protected:
 private:
   absl::Status onSocketEvent(short flags);
 
+  // Returns the global connection limit configured in runtime, which is read once for all the
+  // connections accepted on a socket event.
+  uint64_t globalCxLimit() const;
+
   // Returns true if global connection limit has been reached and the accepted socket should be
   // rejected/closed. If the accepted socket is to be admitted, false is returned.
-  bool rejectCxOverGlobalLimit() const;
+  bool rejectCxOverGlobalLimit(uint64_t global_cx_limit) const;
 
   Random::RandomGenerator& random_;
   Runtime::Loader& runtime_;
@@ -50,6 +50,7 @@ public:
                      Buffer::OwnedImpl saved_cmsg) override;
   uint64_t maxDatagramSize() const override { return config_.max_rx_datagram_size_; }
   void onDatagramsDropped(uint32_t dropped) override { cb_.onDatagramsDropped(dropped); }
+  void onDatagramsRead(uint32_t datagrams) override { cb_.onDatagramsRead(datagrams); }
   size_t numPacketsExpectedPerEventLoop() const override {
     return cb_.numPacketsExpectedPerEventLoop();
   }
@@ -19,6 +19,14 @@ public:
   Api::IoCallUint64Result writePacket(const Buffer::Instance& buffer, const Address::Ip* local_ip,
                                       const Address::Instance& peer_address) override;
 
+  bool supportsReleaseTime() const override { return false; }
+  Api::IoCallUint64Result writePacketWithReleaseTime(const Buffer::Instance& buffer,
+                                                     const Address::Ip* local_ip,
+                                                     const Address::Instance& peer_address,
+                                                     std::chrono::microseconds) override {
+    return writePacket(buffer, local_ip, peer_address);
+  }
+
   bool isWriteBlocked() const override { return write_blocked_; }
   void setWritable() override { write_blocked_ = false; }
   uint64_t getMaxPacketSize(const Address::Instance& /*peer_address*/) const override {
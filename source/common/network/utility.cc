@@ -567,11 +567,30 @@ void passPayloadToProcessor(uint64_t bytes_read, Buffer::InstancePtr buffer,
                                      std::move(buffer), receive_time, tos, std::move(saved_cmsg));
 }
 
+// A GRO segment, which refers to the buffer of the whole read instead of being copied out of it.
+// The buffer is released with the last of its segments.
+class GroSegmentFragment : public Buffer::BufferFragment {
+public:
+  GroSegmentFragment(std::shared_ptr<const Buffer::Instance> read_buffer, const uint8_t* data,
+                     size_t size)
+      : read_buffer_(std::move(read_buffer)), data_(data), size_(size) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return data_; }
+  size_t size() const override { return size_; }
+  void done() override { delete this; }
+
+private:
+  const std::shared_ptr<const Buffer::Instance> read_buffer_;
+  const uint8_t* const data_;
+  const size_t size_;
+};
+
 Api::IoCallUint64Result readFromSocketRecvGro(IoHandle& handle,
                                               const Address::Instance& local_address,
                                               UdpPacketProcessor& udp_packet_processor,
                                               MonotonicTime receive_time, uint32_t* packets_dropped,
-                                              uint32_t* num_packets_read) {
+                                              uint32_t* num_packets_read, bool limit_read_size) {
   ASSERT(Api::OsSysCallsSingleton::get().supportsUdpGro(),
          "cannot use GRO when the platform doesn't support it.");
   if (num_packets_read != nullptr) {
@@ -582,9 +601,8 @@ Api::IoCallUint64Result readFromSocketRecvGro(IoHandle& handle,
 
   // TODO(yugant): Avoid allocating 64k for each read by getting memory from UdpPacketProcessor
   const uint64_t max_rx_datagram_size_with_gro =
-      num_packets_read != nullptr
-          ? 64 * 1024
-          : NUM_DATAGRAMS_PER_RECEIVE * udp_packet_processor.maxDatagramSize();
+      limit_read_size ? NUM_DATAGRAMS_PER_RECEIVE * udp_packet_processor.maxDatagramSize()
+                      : 64 * 1024;
   ENVOY_LOG_MISC(trace, "starting gro recvmsg with max={}", max_rx_datagram_size_with_gro);
 
   Api::IoCallUint64Result result =
@@ -610,17 +628,21 @@ Api::IoCallUint64Result readFromSocketRecvGro(IoHandle& handle,
     return result;
   }
 
-  // Segment the buffer read by the recvmsg syscall into gso_sized sub buffers.
-  // TODO(mattklein123): The following code should be optimized to avoid buffer copies, either by
-  // switching to slices or by using a CoW buffer type.
-  while (buffer->length() > 0) {
-    const uint64_t bytes_to_copy = std::min(buffer->length(), gso_size);
+  // Segment the buffer read by the recvmsg syscall into gso_sized sub buffers. The sub buffers
+  // refer to the read buffer, which was read into a single slice, so no payload is copied.
+  ASSERT(buffer->getRawSlices().size() <= 1);
+  const uint64_t length = buffer->length();
+  const auto* data = static_cast<const uint8_t*>(buffer->frontSlice().mem_);
+  std::shared_ptr<const Buffer::Instance> read_buffer = std::move(buffer);
+  for (uint64_t offset = 0; offset < length; offset += gso_size) {
+    const uint64_t segment_size = std::min(length - offset, gso_size);
     Buffer::InstancePtr sub_buffer = std::make_unique<Buffer::OwnedImpl>();
-    sub_buffer->move(*buffer, bytes_to_copy);
+    sub_buffer->addBufferFragment(
+        *new GroSegmentFragment(read_buffer, data + offset, segment_size));
     if (num_packets_read != nullptr) {
       *num_packets_read += 1;
     }
-    passPayloadToProcessor(bytes_to_copy, std::move(sub_buffer), output.msg_[0].peer_address_,
+    passPayloadToProcessor(segment_size, std::move(sub_buffer), output.msg_[0].peer_address_,
                            output.msg_[0].local_address_, udp_packet_processor, receive_time,
                            output.msg_[0].tos_, std::move(output.msg_[0].saved_cmsg_));
   }
@@ -725,16 +747,17 @@ Api::IoCallUint64Result readFromSocketRecvMsg(IoHandle& handle,
   return result;
 }
 
-} // namespace
-
-Api::IoCallUint64Result
-Utility::readFromSocket(IoHandle& handle, const Address::Instance& local_address,
-                        UdpPacketProcessor& udp_packet_processor, MonotonicTime receive_time,
-                        UdpRecvMsgMethod recv_msg_method, uint32_t* packets_dropped,
-                        uint32_t* num_packets_read) {
+// @param limit_read_size whether a GRO read is limited to NUM_DATAGRAMS_PER_RECEIVE datagrams of
+//        the max datagram size, instead of 64k.
+Api::IoCallUint64Result readFromSocketImpl(IoHandle& handle, const Address::Instance& local_address,
+                                           UdpPacketProcessor& udp_packet_processor,
+                                           MonotonicTime receive_time,
+                                           UdpRecvMsgMethod recv_msg_method,
+                                           uint32_t* packets_dropped, uint32_t* num_packets_read,
+                                           bool limit_read_size) {
   if (recv_msg_method == UdpRecvMsgMethod::RecvMsgWithGro) {
     return readFromSocketRecvGro(handle, local_address, udp_packet_processor, receive_time,
-                                 packets_dropped, num_packets_read);
+                                 packets_dropped, num_packets_read, limit_read_size);
   } else if (recv_msg_method == UdpRecvMsgMethod::RecvMmsg) {
     return readFromSocketRecvMmsg(handle, local_address, udp_packet_processor, receive_time,
                                   packets_dropped, num_packets_read);
@@ -743,6 +766,18 @@ Utility::readFromSocket(IoHandle& handle, const Address::Instance& local_address
                                packets_dropped, num_packets_read);
 }
 
+} // namespace
+
+Api::IoCallUint64Result
+Utility::readFromSocket(IoHandle& handle, const Address::Instance& local_address,
+                        UdpPacketProcessor& udp_packet_processor, MonotonicTime receive_time,
+                        UdpRecvMsgMethod recv_msg_method, uint32_t* packets_dropped,
+                        uint32_t* num_packets_read) {
+  return readFromSocketImpl(handle, local_address, udp_packet_processor, receive_time,
+                            recv_msg_method, packets_dropped, num_packets_read,
+                            /*limit_read_size=*/num_packets_read == nullptr);
+}
+
 Api::IoErrorPtr Utility::readPacketsFromSocket(IoHandle& handle,
                                                const Address::Instance& local_address,
                                                UdpPacketProcessor& udp_packet_processor,
@@ -785,14 +820,18 @@ Api::IoErrorPtr Utility::readPacketsFromSocket(IoHandle& handle,
     const uint32_t old_packets_dropped = packets_dropped;
     uint32_t num_packets_processed = 0;
     const MonotonicTime receive_time = time_source.monotonicTime();
-    Api::IoCallUint64Result result = Utility::readFromSocket(
+    Api::IoCallUint64Result result = readFromSocketImpl(
         handle, local_address, udp_packet_processor, receive_time, recv_msg_method,
-        &packets_dropped, apply_read_limit_differently ? &num_packets_processed : nullptr);
+        &packets_dropped, &num_packets_processed,
+        /*limit_read_size=*/!apply_read_limit_differently);
 
     if (!result.ok()) {
       // No more to read or encountered a system error.
       return std::move(result.err_);
     }
+    if (num_packets_processed > 0) {
+      udp_packet_processor.onDatagramsRead(num_packets_processed);
+    }
 
     if (packets_dropped != old_packets_dropped) {
       // The kernel tracks SO_RXQ_OVFL as a uint32 which can overflow to a smaller
@@ -43,6 +43,13 @@ public:
    */
   virtual void onDatagramsDropped(uint32_t dropped) PURE;
 
+  /**
+   * Called by readPacketsFromSocket() after each read from the socket which passed datagrams to
+   * processPacket(). A read with recvmmsg or GRO can pass several datagrams.
+   * @param datagrams supplies the number of datagrams passed to processPacket() by the read.
+   */
+  virtual void onDatagramsRead(uint32_t datagrams) PURE;
+
   /**
    * The expected max size of the datagram to be read. If it's smaller than
    * the size of datagrams received, they will be dropped.
@@ -2,20 +2,19 @@
 
 #include <cmath>
 #include <cstddef>
+#include <iterator>
 #include <string>
 #include <utility>
-#include <vector>
 
 #include "envoy/common/exception.h"
 #include "envoy/http/header_map.h"
 
 #include "source/common/common/base64.h"
 #include "source/common/common/fmt.h"
-#include "source/common/http/header_utility.h"
 #include "source/common/protobuf/utility.h"
 
-#include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
@@ -49,12 +48,32 @@ absl::Status tryCopyNamedMetricToOrcaLoadReport(absl::string_view metric_name, d
   return absl::OkStatus();
 }
 
-std::vector<absl::string_view> parseCommaDelimitedHeader(const absl::string_view entry) {
-  std::vector<absl::string_view> values;
-  std::vector<absl::string_view> tokens =
-      Envoy::Http::HeaderUtility::parseCommaDelimitedHeader(entry);
-  values.insert(values.end(), tokens.begin(), tokens.end());
-  return values;
+// Returns whether the metric was already copied to the report. OrcaLoadReport fields are not
+// marked as optional and therefore don't differentiate between unset and default values, so the
+// fields which were copied are tracked in `copied_fields` rather than in a set of metric names,
+// which would be allocated for every response.
+bool isDuplicateMetric(absl::string_view metric_name, const OrcaLoadReport& orca_load_report,
+                       uint32_t& copied_fields) {
+  if (absl::StartsWith(metric_name, kUtilizationPrefix)) {
+    return orca_load_report.utilization().contains(
+        absl::StripPrefix(metric_name, kUtilizationPrefix));
+  }
+  if (absl::StartsWith(metric_name, kNamedMetricsFieldPrefix)) {
+    return orca_load_report.named_metrics().contains(
+        absl::StripPrefix(metric_name, kNamedMetricsFieldPrefix));
+  }
+  constexpr absl::string_view fields[] = {kCpuUtilizationField, kMemUtilizationField,
+                                          kApplicationUtilizationField, kEpsField,
+                                          kRpsFractionalField};
+  for (uint32_t i = 0; i < std::size(fields); i++) {
+    if (metric_name == fields[i]) {
+      const uint32_t field_bit = 1 << i;
+      const bool duplicate = (copied_fields & field_bit) != 0;
+      copied_fields |= field_bit;
+      return duplicate;
+    }
+  }
+  return false;
 }
 
 absl::Status tryCopyMetricToOrcaLoadReport(absl::string_view metric_name,
@@ -125,21 +144,21 @@ absl::Status tryCopyMetricToOrcaLoadReport(absl::string_view metric_name,
 
 absl::Status tryParseNativeHttpEncoded(const absl::string_view header,
                                        OrcaLoadReport& orca_load_report) {
-  const std::vector<absl::string_view> values = parseCommaDelimitedHeader(header);
-
-  // Check for duplicate metric names here because OrcaLoadReport fields are not
-  // marked as optional and therefore don't differentiate between unset and
-  // default values.
-  absl::flat_hash_set<absl::string_view> metric_names;
-  for (const auto value : values) {
+  uint32_t copied_fields = 0;
+  // The header is split as by Http::HeaderUtility::parseCommaDelimitedHeader(), but without
+  // collecting the values in a vector.
+  for (const absl::string_view value : absl::StrSplit(header, ',')) {
+    const absl::string_view token = absl::StripAsciiWhitespace(value);
+    if (token.empty()) {
+      continue;
+    }
     std::pair<absl::string_view, absl::string_view> entry =
-        absl::StrSplit(value, absl::MaxSplits(absl::ByAnyChar("=:"), 1), absl::SkipWhitespace());
-    if (metric_names.contains(entry.first)) {
+        absl::StrSplit(token, absl::MaxSplits(absl::ByAnyChar("=:"), 1), absl::SkipWhitespace());
+    if (isDuplicateMetric(entry.first, orca_load_report, copied_fields)) {
       return absl::AlreadyExistsError(
           absl::StrCat(kEndpointLoadMetricsHeader, " contains duplicate metric: ", entry.first));
     }
     RETURN_IF_NOT_OK(tryCopyMetricToOrcaLoadReport(entry.first, entry.second, orca_load_report));
-    metric_names.insert(entry.first);
   }
   return absl::OkStatus();
 }
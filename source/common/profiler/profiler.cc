@@ -20,6 +20,14 @@ bool Cpu::startProfiler(const std::string& output_path) {
 
 void Cpu::stopProfiler() { ProfilerStop(); }
 
+bool Cpu::flushProfiler() {
+  if (!ProfilingIsEnabledForAllThreads()) {
+    return false;
+  }
+  ProfilerFlush();
+  return true;
+}
+
 bool Heap::profilerEnabled() {
   // determined by PROFILER_AVAILABLE
   return true;
@@ -51,6 +59,7 @@ namespace Profiler {
 bool Cpu::profilerEnabled() { return false; }
 bool Cpu::startProfiler(const std::string&) { return false; }
 void Cpu::stopProfiler() {}
+bool Cpu::flushProfiler() { return false; }
 
 bool Heap::profilerEnabled() { return false; }
 bool Heap::isProfilerStarted() { return false; }
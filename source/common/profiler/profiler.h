@@ -34,6 +34,12 @@ public:
    * Stop the profiler.
    */
   static void stopProfiler();
+
+  /**
+   * Write the samples collected so far to the output file, without stopping the profiler.
+   * @return bool whether the profiler is running.
+   */
+  static bool flushProfiler();
 };
 
 /**
@@ -119,6 +119,7 @@ using MessageDifferencer = MessageLiteDifferencer;
 using ::google::protobuf::util::JsonParseOptions; // NOLINT(misc-unused-using-decls)
 using ::google::protobuf::util::JsonPrintOptions; // NOLINT(misc-unused-using-decls)
 using ::google::protobuf::util::TimeUtil;         // NOLINT(misc-unused-using-decls)
+using ::google::protobuf::util::TypeResolver;     // NOLINT(misc-unused-using-decls)
 } // namespace util
 
 } // namespace Protobuf
@@ -856,7 +856,7 @@ absl::Status MessageUtil::loadFromFile(const std::string& path, Protobuf::Messag
                                        Api::Api& api) {
   auto file_or_error = api.fileSystem().fileReadToEnd(path);
   RETURN_IF_NOT_OK_REF(file_or_error.status());
-  const std::string contents = file_or_error.value();
+  const std::string contents = std::move(file_or_error.value());
   // If the filename ends with .pb, attempt to parse it as a binary proto.
   if (absl::EndsWithIgnoreCase(path, FileExtensions::get().ProtoBinary)) {
     // Attempt to parse the binary format.
@@ -80,6 +80,7 @@ public:
   void onDatagramsDropped(uint32_t) override {
     // TODO(mattklein123): Emit a stat for this.
   }
+  void onDatagramsRead(uint32_t) override {}
   size_t numPacketsExpectedPerEventLoop() const override {
     if (!Runtime::runtimeFeatureEnabled(
             "envoy.reloadable_features.quic_upstream_reads_fixed_number_packets") &&
@@ -146,6 +146,13 @@ std::unique_ptr<quic::QuicSession> EnvoyQuicDispatcher::CreateQuicSession(
   } else {
     quic_session->close(Network::ConnectionCloseType::FlushWrite, "no filter chain found");
   }
+  if (Network::UdpListenerConfigOptRef udp_listener_config = listener_config_->udpListenerConfig();
+      udp_listener_config.has_value() &&
+      udp_listener_config->config().quic_options().has_max_qpack_dynamic_table_capacity()) {
+    // Advertised to the client in the SETTINGS sent by Initialize().
+    quic_session->set_qpack_maximum_dynamic_table_capacity(
+        udp_listener_config->config().quic_options().max_qpack_dynamic_table_capacity().value());
+  }
   quic_session->Initialize();
   connection_handler_.incNumConnections();
   listener_stats_.downstream_cx_active_.inc();
@@ -28,7 +28,7 @@ EnvoyQuicPacketWriter::EnvoyQuicPacketWriter(Network::UdpPacketWriterPtr envoy_u
 quic::WriteResult EnvoyQuicPacketWriter::WritePacket(
     const char* buffer, size_t buffer_len, const quic::QuicIpAddress& self_ip,
     const quic::QuicSocketAddress& peer_address, quic::PerPacketOptions* options,
-    [[maybe_unused]] const quic::QuicPacketWriterParams& params) {
+    const quic::QuicPacketWriterParams& params) {
   ASSERT(options == nullptr, "Per packet option is not supported yet.");
 
   Buffer::BufferFragmentImpl fragment(buffer, buffer_len, nullptr);
@@ -41,8 +41,13 @@ quic::WriteResult EnvoyQuicPacketWriter::WritePacket(
   Network::Address::InstanceConstSharedPtr remote_addr =
       quicAddressToEnvoyAddressInstance(peer_address);
 
-  Api::IoCallUint64Result result = envoy_udp_packet_writer_->writePacket(
-      buf, local_addr == nullptr ? nullptr : local_addr->ip(), *remote_addr);
+  const Network::Address::Ip* local_ip = local_addr == nullptr ? nullptr : local_addr->ip();
+  Api::IoCallUint64Result result =
+      envoy_udp_packet_writer_->supportsReleaseTime()
+          ? envoy_udp_packet_writer_->writePacketWithReleaseTime(
+                buf, local_ip, *remote_addr,
+                std::chrono::microseconds(params.release_time_delay.ToMicroseconds()))
+          : envoy_udp_packet_writer_->writePacket(buf, local_ip, *remote_addr);
 
   return convertToQuicWriteResult(result);
 }
@@ -21,8 +21,9 @@ public:
   bool IsWriteBlocked() const override { return envoy_udp_packet_writer_->isWriteBlocked(); }
   void SetWritable() override { envoy_udp_packet_writer_->setWritable(); }
   bool IsBatchMode() const override { return envoy_udp_packet_writer_->isBatchMode(); }
-  // Currently this writer doesn't support pacing offload.
-  bool SupportsReleaseTime() const override { return false; }
+  bool SupportsReleaseTime() const override {
+    return envoy_udp_packet_writer_->supportsReleaseTime();
+  }
   // Currently this writer doesn't support Explicit Congestion Notification.
   bool SupportsEcn() const override { return false; }
 
@@ -84,9 +84,13 @@ std::shared_ptr<quic::QuicCryptoClientConfig> QuicClientTransportSocketFactory::
                 ACCEPT_UNTRUSTED;
     // If the context has been updated, update the crypto config.
     tls_config.client_context_ = context;
+    std::unique_ptr<quic::SessionCache> session_cache =
+        Runtime::runtimeFeatureEnabled("envoy.reloadable_features.quic_share_client_session_cache")
+            ? sharedSessionCache(context)
+            : std::make_unique<quic::QuicClientSessionCache>();
     tls_config.crypto_config_ = std::make_shared<quic::QuicCryptoClientConfig>(
         std::make_unique<Quic::EnvoyQuicProofVerifier>(std::move(context), accept_untrusted),
-        std::make_unique<quic::QuicClientSessionCache>());
+        std::move(session_cache));
 
     if (Runtime::runtimeFeatureEnabled(
             "envoy.reloadable_features.quic_disable_client_early_data")) {
@@ -98,6 +102,17 @@ std::shared_ptr<quic::QuicCryptoClientConfig> QuicClientTransportSocketFactory::
   return tls_config.crypto_config_;
 }
 
+std::unique_ptr<quic::SessionCache> QuicClientTransportSocketFactory::sharedSessionCache(
+    const Envoy::Ssl::ClientContextSharedPtr& context) {
+  absl::MutexLock lock(&session_cache_mutex_);
+  // Sessions are only resumed with the client context that created them.
+  if (session_cache_ == nullptr || session_cache_context_.lock() != context) {
+    session_cache_context_ = context;
+    session_cache_ = std::make_unique<SharedQuicClientSessionCache>();
+  }
+  return session_cache_->share();
+}
+
 REGISTER_FACTORY(QuicClientTransportSocketConfigFactory,
                  Server::Configuration::UpstreamTransportSocketConfigFactory);
 
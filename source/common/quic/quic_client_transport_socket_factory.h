@@ -1,6 +1,7 @@
 #pragma once
 
 #include "source/common/quic/quic_transport_socket_factory.h"
+#include "source/common/quic/shared_quic_client_session_cache.h"
 #include "source/common/tls/client_ssl_socket.h"
 
 namespace Envoy {
@@ -63,11 +64,22 @@ protected:
   };
 
 private:
+  // Returns the session cache for a worker's crypto config using `context`.
+  std::unique_ptr<quic::SessionCache>
+  sharedSessionCache(const Envoy::Ssl::ClientContextSharedPtr& context);
+
   // The QUIC client transport socket can create TLS sockets for fallback to TCP.
   std::unique_ptr<Envoy::Extensions::TransportSockets::Tls::ClientSslSocketFactory>
       fallback_factory_;
   // The storage for thread local quic config.
   ThreadLocal::TypedSlot<ThreadLocalQuicConfig> tls_slot_;
+  // The session cache that the crypto configs of all the workers share, for the client context
+  // it was created with.
+  absl::Mutex session_cache_mutex_;
+  std::weak_ptr<const Envoy::Ssl::ClientContext>
+      session_cache_context_ ABSL_GUARDED_BY(session_cache_mutex_);
+  std::unique_ptr<SharedQuicClientSessionCache>
+      session_cache_ ABSL_GUARDED_BY(session_cache_mutex_);
 };
 
 class QuicClientTransportSocketConfigFactory
@@ -100,6 +100,8 @@ public:
   unixSocketPeerCredentials() const override {
     return absl::nullopt;
   }
+  // QUIC connections share a UDP socket.
+  OptRef<Network::IoHandle> socketIoHandle() override { return {}; }
   void setConnectionStats(const Network::Connection::ConnectionStats& stats) override {
     // TODO(danzh): populate stats.
     Network::ConnectionImplBase::setConnectionStats(stats);
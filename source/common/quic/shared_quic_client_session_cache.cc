@@ -0,0 +1,43 @@
+#include "source/common/quic/shared_quic_client_session_cache.h"
+
+namespace Envoy {
+namespace Quic {
+
+void SharedQuicClientSessionCache::Insert(const quic::QuicServerId& server_id,
+                                          bssl::UniquePtr<SSL_SESSION> session,
+                                          const quic::TransportParameters& params,
+                                          const quic::ApplicationState* application_state) {
+  absl::MutexLock lock(&state_->mutex_);
+  state_->cache_.Insert(server_id, std::move(session), params, application_state);
+}
+
+std::unique_ptr<quic::QuicResumptionState>
+SharedQuicClientSessionCache::Lookup(const quic::QuicServerId& server_id, quic::QuicWallTime now,
+                                     const SSL_CTX* ctx) {
+  absl::MutexLock lock(&state_->mutex_);
+  return state_->cache_.Lookup(server_id, now, ctx);
+}
+
+void SharedQuicClientSessionCache::ClearEarlyData(const quic::QuicServerId& server_id) {
+  absl::MutexLock lock(&state_->mutex_);
+  state_->cache_.ClearEarlyData(server_id);
+}
+
+void SharedQuicClientSessionCache::OnNewTokenReceived(const quic::QuicServerId& server_id,
+                                                      absl::string_view token) {
+  absl::MutexLock lock(&state_->mutex_);
+  state_->cache_.OnNewTokenReceived(server_id, token);
+}
+
+void SharedQuicClientSessionCache::RemoveExpiredEntries(quic::QuicWallTime now) {
+  absl::MutexLock lock(&state_->mutex_);
+  state_->cache_.RemoveExpiredEntries(now);
+}
+
+void SharedQuicClientSessionCache::Clear() {
+  absl::MutexLock lock(&state_->mutex_);
+  state_->cache_.Clear();
+}
+
+} // namespace Quic
+} // namespace Envoy
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+
+#include "absl/synchronization/mutex.h"
+#include "quiche/quic/core/crypto/quic_client_session_cache.h"
+
+namespace Envoy {
+namespace Quic {
+
+/**
+ * A QUIC client session cache whose entries can be shared by the crypto configs of all the
+ * workers, so that the first connection of every worker can resume, with 0-RTT, a session that
+ * any worker learnt.
+ */
+class SharedQuicClientSessionCache : public quic::SessionCache {
+public:
+  SharedQuicClientSessionCache() : state_(std::make_shared<State>()) {}
+
+  /**
+   * @return a cache with the same entries as this one, for the crypto config of another worker.
+   */
+  std::unique_ptr<SharedQuicClientSessionCache> share() const {
+    return std::unique_ptr<SharedQuicClientSessionCache>(new SharedQuicClientSessionCache(state_));
+  }
+
+  // quic::SessionCache
+  void Insert(const quic::QuicServerId& server_id, bssl::UniquePtr<SSL_SESSION> session,
+              const quic::TransportParameters& params,
+              const quic::ApplicationState* application_state) override;
+  std::unique_ptr<quic::QuicResumptionState> Lookup(const quic::QuicServerId& server_id,
+                                                    quic::QuicWallTime now,
+                                                    const SSL_CTX* ctx) override;
+  void ClearEarlyData(const quic::QuicServerId& server_id) override;
+  void OnNewTokenReceived(const quic::QuicServerId& server_id, absl::string_view token) override;
+  void RemoveExpiredEntries(quic::QuicWallTime now) override;
+  void Clear() override;
+
+private:
+  // QuicClientSessionCache is not thread-safe.
+  struct State {
+    absl::Mutex mutex_;
+    quic::QuicClientSessionCache cache_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  explicit SharedQuicClientSessionCache(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+  const std::shared_ptr<State> state_;
+};
+
+} // namespace Quic
+} // namespace Envoy
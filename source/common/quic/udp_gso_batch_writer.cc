@@ -3,6 +3,8 @@
 #include "source/common/network/io_socket_error_impl.h"
 #include "source/common/quic/envoy_quic_utils.h"
 
+#include "quiche/quic/platform/api/quic_flags.h"
+
 namespace Envoy {
 namespace Quic {
 namespace {
@@ -39,12 +41,35 @@ Api::IoCallUint64Result convertQuicWriteResult(quic::WriteResult quic_result, si
 } // namespace
 
 // Initialize QuicGsoBatchWriter, set io_handle_ and stats_
-UdpGsoBatchWriter::UdpGsoBatchWriter(Network::IoHandle& io_handle, Stats::Scope& scope)
-    : quic::QuicGsoBatchWriter(io_handle.fdDoNotUse()), stats_(generateStats(scope)) {}
+UdpGsoBatchWriter::UdpGsoBatchWriter(Network::IoHandle& io_handle, Stats::Scope& scope,
+                                     bool enable_release_time)
+    : quic::QuicGsoBatchWriter(io_handle.fdDoNotUse()), stats_(generateStats(scope)),
+      enable_release_time_(enable_release_time) {}
 
 Api::IoCallUint64Result
 UdpGsoBatchWriter::writePacket(const Buffer::Instance& buffer, const Network::Address::Ip* local_ip,
                                const Network::Address::Instance& peer_address) {
+  return writePacketWithParams(buffer, local_ip, peer_address, quic::QuicPacketWriterParams());
+}
+
+Api::IoCallUint64Result UdpGsoBatchWriter::writePacketWithReleaseTime(
+    const Buffer::Instance& buffer, const Network::Address::Ip* local_ip,
+    const Network::Address::Instance& peer_address, std::chrono::microseconds release_time_delay) {
+  ASSERT(supportsReleaseTime());
+  quic::QuicPacketWriterParams params;
+  params.release_time_delay = quic::QuicTime::Delta::FromMicroseconds(release_time_delay.count());
+  Api::IoCallUint64Result result = writePacketWithParams(buffer, local_ip, peer_address, params);
+  if (result.ok()) {
+    stats_.pkts_sent_with_release_time_.inc();
+  }
+  return result;
+}
+
+Api::IoCallUint64Result
+UdpGsoBatchWriter::writePacketWithParams(const Buffer::Instance& buffer,
+                                         const Network::Address::Ip* local_ip,
+                                         const Network::Address::Instance& peer_address,
+                                         const quic::QuicPacketWriterParams& params) {
   // Convert received parameters to relevant forms
   quic::QuicSocketAddress peer_addr = envoyIpAddressToQuicSocketAddress(peer_address.ip());
   quic::QuicSocketAddress self_addr = envoyIpAddressToQuicSocketAddress(local_ip);
@@ -53,7 +78,6 @@ UdpGsoBatchWriter::writePacket(const Buffer::Instance& buffer, const Network::Ad
 
   // TODO(yugant): Currently we do not use PerPacketOptions with Quic, we may want to
   // specify this parameter here at a later stage.
-  quic::QuicPacketWriterParams params;
   quic::WriteResult quic_result = WritePacket(static_cast<char*>(buffer.frontSlice().mem_),
                                               payload_len, self_addr.host(), peer_addr,
                                               /*quic::PerPacketOptions=*/nullptr, params);
@@ -102,9 +126,17 @@ UdpGsoBatchWriterStats UdpGsoBatchWriter::generateStats(Stats::Scope& scope) {
       UDP_GSO_BATCH_WRITER_STATS(POOL_COUNTER(scope), POOL_GAUGE(scope), POOL_HISTOGRAM(scope))};
 }
 
+UdpGsoBatchWriterFactory::UdpGsoBatchWriterFactory(bool enable_release_time)
+    : enable_release_time_(enable_release_time) {
+  if (enable_release_time_) {
+    // Read by QUICHE when a writer is created, which sets SO_TXTIME on its socket.
+    SetQuicRestartFlag(quic_support_release_time_for_gso, true);
+  }
+}
+
 Network::UdpPacketWriterPtr
 UdpGsoBatchWriterFactory::createUdpPacketWriter(Network::IoHandle& io_handle, Stats::Scope& scope) {
-  return std::make_unique<UdpGsoBatchWriter>(io_handle, scope);
+  return std::make_unique<UdpGsoBatchWriter>(io_handle, scope, enable_release_time_);
 }
 
 } // namespace Quic
@@ -33,12 +33,16 @@ namespace Quic {
  * Provides summary count of batch-sizes within bucketed range,
  * and also provides sum and count stats.
  *
+ * @pkts_sent_with_release_time: Maintains the count of packets
+ * written with a release time, which the kernel paces.
+ *
  * TODO(danzh): Add writer stats to QUIC Documentation when it is
  * created for QUIC/HTTP3 docs. Also specify in the documentation
  * that user has to compile in QUICHE to use UdpGsoBatchWriter.
  */
 #define UDP_GSO_BATCH_WRITER_STATS(COUNTER, GAUGE, HISTOGRAM)                                      \
   COUNTER(total_bytes_sent)                                                                        \
+  COUNTER(pkts_sent_with_release_time)                                                             \
   GAUGE(internal_buffer_size, NeverImport)                                                         \
   HISTOGRAM(pkts_sent_per_batch, Unspecified)
 
@@ -53,10 +57,13 @@ struct UdpGsoBatchWriterStats {
 /**
  * UdpPacketWriter implementation based on quic::QuicGsoBatchWriter to send packets
  * in batches, using UDP socket's generic segmentation offload(GSO) capability.
+ * If release time is enabled, packets also carry the time QUICHE's pacing would send them at,
+ * so that the kernel paces them with SO_TXTIME and QUIC can write larger batches.
  */
 class UdpGsoBatchWriter : public quic::QuicGsoBatchWriter, public Network::UdpPacketWriter {
 public:
-  UdpGsoBatchWriter(Network::IoHandle& io_handle, Stats::Scope& scope);
+  UdpGsoBatchWriter(Network::IoHandle& io_handle, Stats::Scope& scope,
+                    bool enable_release_time = false);
 
   // writePacket perform batched sends based on QuicGsoBatchWriter::WritePacket
   Api::IoCallUint64Result writePacket(const Buffer::Instance& buffer,
@@ -64,6 +71,14 @@ public:
                                       const Network::Address::Instance& peer_address) override;
 
   // UdpPacketWriter Implementations
+  // QUICHE only enables release time if it could set SO_TXTIME on the socket.
+  bool supportsReleaseTime() const override {
+    return enable_release_time_ && SupportsReleaseTime();
+  }
+  Api::IoCallUint64Result
+  writePacketWithReleaseTime(const Buffer::Instance& buffer, const Network::Address::Ip* local_ip,
+                             const Network::Address::Instance& peer_address,
+                             std::chrono::microseconds release_time_delay) override;
   bool isWriteBlocked() const override { return IsWriteBlocked(); }
   void setWritable() override { return SetWritable(); }
   bool isBatchMode() const override { return IsBatchMode(); }
@@ -74,6 +89,11 @@ public:
   Api::IoCallUint64Result flush() override;
 
 private:
+  Api::IoCallUint64Result writePacketWithParams(const Buffer::Instance& buffer,
+                                                const Network::Address::Ip* local_ip,
+                                                const Network::Address::Instance& peer_address,
+                                                const quic::QuicPacketWriterParams& params);
+
   /**
    * @brief Update stats_ field for the udp packet writer
    * @param quic_result is the result from Flush/WritePacket
@@ -88,15 +108,23 @@ private:
   UdpGsoBatchWriterStats generateStats(Stats::Scope& scope);
   UdpGsoBatchWriterStats stats_;
   uint64_t gso_size_;
+  const bool enable_release_time_;
 };
 
 class UdpGsoBatchWriterFactory : public Network::UdpPacketWriterFactory {
 public:
+  /**
+   * @param enable_release_time whether the writers offload pacing to the kernel. This enables
+   * QUICHE's process wide support for release times in GSO writers.
+   */
+  explicit UdpGsoBatchWriterFactory(bool enable_release_time = false);
+
   Network::UdpPacketWriterPtr createUdpPacketWriter(Network::IoHandle& io_handle,
                                                     Stats::Scope& scope) override;
 
 private:
   envoy::config::core::v3::RuntimeFeatureFlag enabled_;
+  const bool enable_release_time_;
 };
 
 } // namespace Quic
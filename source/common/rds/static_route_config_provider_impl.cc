@@ -12,7 +12,7 @@ StaticRouteConfigProviderImpl::StaticRouteConfigProviderImpl(
     : route_config_proto_(
           cloneProto(route_config_provider_manager.protoTraits(), route_config_proto)),
       config_(config_traits.createConfig(*route_config_proto_, factory_context,
-                                         true /* validate unknown cluster */)),
+                                         true /* validate unknown cluster */, nullptr)),
       last_updated_(factory_context.timeSource().systemTime()),
       config_info_(ConfigInfo{*route_config_proto_, ""}),
       route_config_provider_manager_(route_config_provider_manager) {}
@@ -0,0 +1,111 @@
+#include "source/common/router/compiled_route_table.h"
+
+#include <algorithm>
+
+#include "source/common/http/path_utility.h"
+
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Router {
+
+CompiledRouteTable::CompiledRouteTable(const std::vector<PathMatch>& routes, bool use_regex_set,
+                                       bool ignore_path_parameters)
+    : ignore_path_parameters_(ignore_path_parameters) {
+  RouteIndices regex_routes;
+  std::vector<std::string> regexes;
+  for (uint32_t i = 0; i < routes.size(); ++i) {
+    const PathMatch& route = routes[i];
+    switch (route.type_) {
+    case PathMatchType::Exact:
+      if (route.case_sensitive_) {
+        exact_routes_[route.value_].push_back(i);
+        continue;
+      }
+      break;
+    case PathMatchType::Prefix:
+    // A path separated prefix only matches paths that start with the prefix.
+    case PathMatchType::PathSeparatedPrefix:
+      if (route.case_sensitive_) {
+        prefix_routes_[route.value_].push_back(i);
+        continue;
+      }
+      break;
+    case PathMatchType::Regex:
+      if (use_regex_set) {
+        regex_routes.push_back(i);
+        regexes.push_back(route.value_);
+        continue;
+      }
+      break;
+    case PathMatchType::None:
+    case PathMatchType::Template:
+      break;
+    }
+    other_routes_.push_back(i);
+  }
+
+  for (const auto& [prefix, indices] : prefix_routes_) {
+    prefix_trie_.add(prefix, &indices);
+  }
+
+  if (!regexes.empty()) {
+    auto regex_set_or_error = Regex::CompiledGoogleReSetMatcher::create(regexes);
+    if (regex_set_or_error.ok()) {
+      regex_set_ = std::move(regex_set_or_error.value());
+      regex_routes_ = std::move(regex_routes);
+    } else {
+      // The set is too large, match each regex separately.
+      other_routes_.insert(other_routes_.end(), regex_routes.begin(), regex_routes.end());
+      std::sort(other_routes_.begin(), other_routes_.end());
+    }
+  }
+}
+
+void CompiledRouteTable::forEachCandidate(absl::string_view path,
+                                          absl::FunctionRef<bool(uint32_t)> cb) const {
+  // Match what the path matchers see, see RouteEntryImplBase::sanitizePathBeforePathMatching().
+  if (ignore_path_parameters_) {
+    path = path.substr(0, path.find_first_of(';'));
+  }
+  path = Http::PathUtil::removeQueryAndFragment(path);
+
+  absl::InlinedVector<uint32_t, 8> indexed;
+  if (const auto it = exact_routes_.find(path); it != exact_routes_.end()) {
+    indexed.insert(indexed.end(), it->second.begin(), it->second.end());
+  }
+  prefix_trie_.forEachPrefixValue(path, [&indexed](const RouteIndices* indices) {
+    indexed.insert(indexed.end(), indices->begin(), indices->end());
+  });
+  if (regex_set_ != nullptr) {
+    std::vector<int> matches;
+    if (regex_set_->match(path, matches)) {
+      for (int match : matches) {
+        indexed.push_back(regex_routes_[match]);
+      }
+    } else {
+      // The DFA ran out of memory, the regexes have to be matched separately.
+      indexed.insert(indexed.end(), regex_routes_.begin(), regex_routes_.end());
+    }
+  }
+  std::sort(indexed.begin(), indexed.end());
+
+  // Merge the indexed candidates with the routes that are always candidates.
+  auto indexed_it = indexed.begin();
+  auto other_it = other_routes_.begin();
+  while (indexed_it != indexed.end() || other_it != other_routes_.end()) {
+    uint32_t index;
+    if (other_it == other_routes_.end() ||
+        (indexed_it != indexed.end() && *indexed_it < *other_it)) {
+      index = *indexed_it++;
+    } else {
+      index = *other_it++;
+    }
+    if (cb(index)) {
+      return;
+    }
+  }
+}
+
+} // namespace Router
+} // namespace Envoy
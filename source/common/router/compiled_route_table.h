@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/router/router.h"
+
+#include "source/common/common/regex.h"
+#include "source/common/common/trie_lookup_table.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * Index over the path matchers of the routes of a virtual host. For the path of a request it yields
+ * the routes whose path matcher may match, in route order, so that first match semantics are kept
+ * without evaluating every route. Case sensitive exact and prefix matchers are looked up in a hash
+ * map and a trie, and regex matchers are evaluated in a single pass by an RE2::Set. All other
+ * routes, e.g. path templates or case insensitive matchers, are always candidates.
+ *
+ * The candidates are a superset of the routes that match the path, every candidate must still be
+ * matched against the request.
+ */
+class CompiledRouteTable {
+public:
+  // The path matcher of a route.
+  struct PathMatch {
+    PathMatchType type_;
+    // The path, prefix or regex, depending on the type.
+    std::string value_;
+    bool case_sensitive_;
+  };
+
+  /**
+   * @param routes supplies the path matcher of every route, in route order.
+   * @param use_regex_set supplies whether the regex matchers use RE2, so that they can be combined
+   *        into an RE2::Set.
+   * @param ignore_path_parameters supplies whether path parameters are ignored in path matching.
+   */
+  CompiledRouteTable(const std::vector<PathMatch>& routes, bool use_regex_set,
+                     bool ignore_path_parameters);
+
+  /**
+   * Calls the callback with the index of every candidate route for the path, in increasing order,
+   * until the callback returns true.
+   * @param path supplies the :path header of the request.
+   * @param cb supplies the callback.
+   */
+  void forEachCandidate(absl::string_view path, absl::FunctionRef<bool(uint32_t)> cb) const;
+
+private:
+  using RouteIndices = std::vector<uint32_t>;
+
+  absl::flat_hash_map<std::string, RouteIndices> exact_routes_;
+  absl::flat_hash_map<std::string, RouteIndices> prefix_routes_;
+  // Points into prefix_routes_, which is not modified once the trie is built.
+  TrieLookupTable<const RouteIndices*> prefix_trie_;
+  Regex::CompiledGoogleReSetMatcherPtr regex_set_;
+  // The route index of every pattern of regex_set_.
+  RouteIndices regex_routes_;
+  // Routes that are always candidates.
+  RouteIndices other_routes_;
+  const bool ignore_path_parameters_;
+};
+
+using CompiledRouteTablePtr = std::unique_ptr<const CompiledRouteTable>;
+
+} // namespace Router
+} // namespace Envoy
@@ -243,6 +243,77 @@ createRedirectConfig(const envoy::config::route::v3::Route& route, Regex::Engine
   return redirect_config;
 }
 
+// Creates the object, or gets it from the pool if there is one.
+template <class T>
+absl::StatusOr<std::shared_ptr<const T>>
+getOrCreate(InternPool* pool, absl::FunctionRef<std::string()> config,
+            absl::FunctionRef<absl::StatusOr<std::unique_ptr<T>>()> create) {
+  if (pool == nullptr) {
+    return create();
+  }
+  return pool->getOrCreate<T>(config(), create);
+}
+
+// Appends a part of the pool key of an object, prefixed by its length so that consecutive parts
+// can't be confused.
+void appendInternKey(std::string& key, absl::string_view part) {
+  absl::StrAppend(&key, part.size(), ":", part);
+}
+
+// Appends the deterministic serialization of the message to the pool key of an object. Equal
+// bytes mean equal messages, which is all the pool needs.
+void appendInternKey(std::string& key, const Protobuf::Message& message) {
+  std::string bytes;
+  {
+    Protobuf::io::StringOutputStream stream(&bytes);
+    Protobuf::io::CodedOutputStream coded_stream(&stream);
+    coded_stream.SetSerializationDeterministic(true);
+    message.SerializeToCodedStream(&coded_stream);
+  }
+  appendInternKey(key, bytes);
+}
+
+std::string internKey(const Protobuf::Message& message) {
+  std::string key;
+  appendInternKey(key, message);
+  return key;
+}
+
+std::string headerParserKey(const Protobuf::RepeatedPtrField<HeaderValueOption>& headers_to_add,
+                            const Protobuf::RepeatedPtrField<std::string>& headers_to_remove) {
+  std::string key = absl::StrCat(headers_to_add.size(), ":");
+  for (const HeaderValueOption& header : headers_to_add) {
+    appendInternKey(key, header);
+  }
+  for (const std::string& header : headers_to_remove) {
+    appendInternKey(key, header);
+  }
+  return key;
+}
+
+// Mask of every field of a route configuration except for its virtual hosts.
+const ProtobufWkt::FieldMask& sharedConfigFieldMask() {
+  CONSTRUCT_ON_FIRST_USE(ProtobufWkt::FieldMask, []() {
+    ProtobufWkt::FieldMask mask;
+    const Protobuf::Descriptor* descriptor =
+        envoy::config::route::v3::RouteConfiguration::descriptor();
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+      if (descriptor->field(i)->name() != "virtual_hosts") {
+        mask.add_paths(descriptor->field(i)->name());
+      }
+    }
+    return mask;
+  }());
+}
+
+// Key of the route configuration without its virtual hosts, i.e. of the parts that make up the
+// CommonConfigImpl.
+std::string sharedConfigKey(const envoy::config::route::v3::RouteConfiguration& config) {
+  envoy::config::route::v3::RouteConfiguration shared_config;
+  ProtobufUtil::FieldMaskUtil::MergeMessageTo(config, sharedConfigFieldMask(), {}, &shared_config);
+  return internKey(shared_config);
+}
+
 } // namespace
 
 const std::string& OriginalConnectPort::key() {
@@ -634,15 +705,32 @@ RouteEntryImplBase::RouteEntryImplBase(const CommonVirtualHostSharedPtr& vhost,
     direct_response_body_provider_ = std::move(provider_or_error.value());
   }
 
+  InternPool* intern_pool = vhost_->globalRouteConfig().internPool();
   if (!route.request_headers_to_add().empty() || !route.request_headers_to_remove().empty()) {
-    auto parser_or_error =
-        HeaderParser::configure(route.request_headers_to_add(), route.request_headers_to_remove());
+    auto parser_or_error = getOrCreate<HeaderParser>(
+        intern_pool,
+        [&route]() {
+          return headerParserKey(route.request_headers_to_add(),
+                                 route.request_headers_to_remove());
+        },
+        [&route]() {
+          return HeaderParser::configure(route.request_headers_to_add(),
+                                         route.request_headers_to_remove());
+        });
     SET_AND_RETURN_IF_NOT_OK(parser_or_error.status(), creation_status);
     request_headers_parser_ = std::move(parser_or_error.value());
   }
   if (!route.response_headers_to_add().empty() || !route.response_headers_to_remove().empty()) {
-    auto parser_or_error = HeaderParser::configure(route.response_headers_to_add(),
-                                                   route.response_headers_to_remove());
+    auto parser_or_error = getOrCreate<HeaderParser>(
+        intern_pool,
+        [&route]() {
+          return headerParserKey(route.response_headers_to_add(),
+                                 route.response_headers_to_remove());
+        },
+        [&route]() {
+          return HeaderParser::configure(route.response_headers_to_add(),
+                                         route.response_headers_to_remove());
+        });
     SET_AND_RETURN_IF_NOT_OK(parser_or_error.status(), creation_status);
     response_headers_parser_ = std::move(parser_or_error.value());
   }
@@ -653,7 +741,13 @@ RouteEntryImplBase::RouteEntryImplBase(const CommonVirtualHostSharedPtr& vhost,
     const auto filter_it = route.route().metadata_match().filter_metadata().find(
         Envoy::Config::MetadataFilters::get().ENVOY_LB);
     if (filter_it != route.route().metadata_match().filter_metadata().end()) {
-      metadata_match_criteria_ = std::make_unique<MetadataMatchCriteriaImpl>(filter_it->second);
+      auto criteria_or_error = getOrCreate<MetadataMatchCriteriaImpl>(
+          intern_pool, [&filter_it]() { return internKey(filter_it->second); },
+          [&filter_it]() -> absl::StatusOr<std::unique_ptr<MetadataMatchCriteriaImpl>> {
+            return std::make_unique<MetadataMatchCriteriaImpl>(filter_it->second);
+          });
+      SET_AND_RETURN_IF_NOT_OK(criteria_or_error.status(), creation_status);
+      metadata_match_criteria_ = std::move(criteria_or_error.value());
     }
   }
 
@@ -728,8 +822,13 @@ RouteEntryImplBase::RouteEntryImplBase(const CommonVirtualHostSharedPtr& vhost,
 
   if (!route.route().hash_policy().empty()) {
     hash_policy_ = THROW_OR_RETURN_VALUE(
-        Http::HashPolicyImpl::create(route.route().hash_policy(), factory_context.regexEngine()),
-        std::unique_ptr<Http::HashPolicyImpl>);
+        getOrCreate<Http::HashPolicyImpl>(
+            intern_pool, [&route]() { return internKey(route.route().hash_policy()); },
+            [&route, &factory_context]() {
+              return Http::HashPolicyImpl::create(route.route().hash_policy(),
+                                                  factory_context.regexEngine());
+            }),
+        std::shared_ptr<const Http::HashPolicyImpl>);
   }
 
   if (route.match().has_tls_context()) {
@@ -1191,27 +1290,40 @@ std::unique_ptr<HedgePolicyImpl> RouteEntryImplBase::buildHedgePolicy(
   return nullptr;
 }
 
-absl::StatusOr<std::unique_ptr<RetryPolicyImpl>> RouteEntryImplBase::buildRetryPolicy(
+absl::StatusOr<std::shared_ptr<const RetryPolicyImpl>> RouteEntryImplBase::buildRetryPolicy(
     RetryPolicyConstOptRef vhost_retry_policy,
     const envoy::config::route::v3::RouteAction& route_config,
     ProtobufMessage::ValidationVisitor& validation_visitor,
     Server::Configuration::ServerFactoryContext& factory_context) const {
-  Upstream::RetryExtensionFactoryContextImpl retry_factory_context(
-      factory_context.singletonManager());
-  // Route specific policy wins, if available.
+  // Route specific policy wins, if available. If not, we fallback to the virtual host policy if
+  // there is one.
+  const envoy::config::route::v3::RetryPolicy* retry_policy = nullptr;
   if (route_config.has_retry_policy()) {
-    return RetryPolicyImpl::create(route_config.retry_policy(), validation_visitor,
-                                   retry_factory_context, factory_context);
+    retry_policy = &route_config.retry_policy();
+  } else if (vhost_retry_policy.has_value()) {
+    retry_policy = vhost_retry_policy.ptr();
   }
 
-  // If not, we fallback to the virtual host policy if there is one.
-  if (vhost_retry_policy.has_value()) {
-    return RetryPolicyImpl::create(*vhost_retry_policy, validation_visitor, retry_factory_context,
-                                   factory_context);
+  // Otherwise, an empty policy will do.
+  if (retry_policy == nullptr) {
+    return nullptr;
   }
 
-  // Otherwise, an empty policy will do.
-  return nullptr;
+  return getOrCreate<RetryPolicyImpl>(
+      vhost_->globalRouteConfig().internPool(),
+      [retry_policy, &validation_visitor]() {
+        // The policy keeps the validation visitor to create retry extensions, so it's part of the
+        // key.
+        std::string key = absl::StrCat(reinterpret_cast<uintptr_t>(&validation_visitor), ":");
+        appendInternKey(key, *retry_policy);
+        return key;
+      },
+      [retry_policy, &validation_visitor, &factory_context]() {
+        Upstream::RetryExtensionFactoryContextImpl retry_factory_context(
+            factory_context.singletonManager());
+        return RetryPolicyImpl::create(*retry_policy, validation_visitor, retry_factory_context,
+                                       factory_context);
+      });
 }
 
 absl::StatusOr<std::unique_ptr<InternalRedirectPolicyImpl>>
@@ -2041,11 +2153,54 @@ VirtualHostImpl::VirtualHostImpl(
       SET_AND_RETURN_IF_NOT_OK(route_or_error.status(), creation_status);
       routes_.emplace_back(route_or_error.value());
     }
+
+    if (routes_.size() >= MinCompiledRoutes &&
+        Runtime::runtimeFeatureEnabled("envoy.reloadable_features.router_compiled_route_table")) {
+      std::vector<CompiledRouteTable::PathMatch> path_matches;
+      path_matches.reserve(routes_.size());
+      for (const auto& route : routes_) {
+        path_matches.push_back({route->matchType(), route->matcher(), route->case_sensitive()});
+      }
+      // Regexes of the default engine can be combined into a single RE2::Set.
+      const bool use_regex_set =
+          dynamic_cast<const Regex::GoogleReEngine*>(&factory_context.regexEngine()) != nullptr;
+      compiled_routes_ = std::make_unique<const CompiledRouteTable>(
+          path_matches, use_regex_set, global_route_config->ignorePathParametersInPathMatching());
+    }
   }
 }
 
 const VirtualHost& SslRedirectRoute::virtualHost() const { return *virtual_host_; }
 
+bool VirtualHostImpl::selectRoute(const RouteCallback& cb, const RouteEntryImplBase& route,
+                                  bool last_route, const Http::RequestHeaderMap& headers,
+                                  const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
+                                  RouteConstSharedPtr& selected) const {
+  RouteConstSharedPtr route_entry = route.matches(headers, stream_info, random_value);
+  if (route_entry == nullptr) {
+    return false;
+  }
+
+  if (cb == nullptr) {
+    selected = std::move(route_entry);
+    return true;
+  }
+
+  RouteEvalStatus eval_status =
+      last_route ? RouteEvalStatus::NoMoreRoutes : RouteEvalStatus::HasMoreRoutes;
+  RouteMatchStatus match_status = cb(route_entry, eval_status);
+  if (match_status == RouteMatchStatus::Accept) {
+    selected = std::move(route_entry);
+    return true;
+  }
+  if (match_status == RouteMatchStatus::Continue && eval_status == RouteEvalStatus::NoMoreRoutes) {
+    ENVOY_LOG(debug,
+              "return null when route match status is Continue but there is no more routes");
+    return true;
+  }
+  return false;
+}
+
 RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
     const RouteCallback& cb, const Http::RequestHeaderMap& headers,
     const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
@@ -2055,27 +2210,10 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
       continue;
     }
 
-    RouteConstSharedPtr route_entry = (*route)->matches(headers, stream_info, random_value);
-    if (route_entry == nullptr) {
-      continue;
-    }
-
-    if (cb == nullptr) {
-      return route_entry;
-    }
-
-    RouteEvalStatus eval_status = (std::next(route) == routes.end())
-                                      ? RouteEvalStatus::NoMoreRoutes
-                                      : RouteEvalStatus::HasMoreRoutes;
-    RouteMatchStatus match_status = cb(route_entry, eval_status);
-    if (match_status == RouteMatchStatus::Accept) {
-      return route_entry;
-    }
-    if (match_status == RouteMatchStatus::Continue &&
-        eval_status == RouteEvalStatus::NoMoreRoutes) {
-      ENVOY_LOG(debug,
-                "return null when route match status is Continue but there is no more routes");
-      return nullptr;
+    RouteConstSharedPtr selected;
+    if (selectRoute(cb, **route, std::next(route) == routes.end(), headers, stream_info,
+                    random_value, selected)) {
+      return selected;
     }
   }
 
@@ -2083,6 +2221,23 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
   return nullptr;
 }
 
+RouteConstSharedPtr VirtualHostImpl::getRouteFromCompiledRoutes(
+    const RouteCallback& cb, const Http::RequestHeaderMap& headers,
+    const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const {
+  RouteConstSharedPtr selected;
+  bool done = false;
+  compiled_routes_->forEachCandidate(headers.getPathValue(), [&](uint32_t index) {
+    done = selectRoute(cb, *routes_[index], index + 1 == routes_.size(), headers, stream_info,
+                       random_value, selected);
+    return done;
+  });
+
+  if (!done) {
+    ENVOY_LOG(debug, "route was resolved but final route list did not match incoming request");
+  }
+  return selected;
+}
+
 RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb,
                                                          const Http::RequestHeaderMap& headers,
                                                          const StreamInfo::StreamInfo& stream_info,
@@ -2132,6 +2287,9 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
   }
 
   // Check for a route that matches the request.
+  if (compiled_routes_ != nullptr && headers.Path() != nullptr) {
+    return getRouteFromCompiledRoutes(cb, headers, stream_info, random_value);
+  }
   return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
 }
 
@@ -2160,11 +2318,12 @@ absl::StatusOr<std::unique_ptr<RouteMatcher>>
 RouteMatcher::create(const envoy::config::route::v3::RouteConfiguration& route_config,
                      const CommonConfigSharedPtr& global_route_config,
                      Server::Configuration::ServerFactoryContext& factory_context,
-                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters) {
+                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                     const RouteMatcher* previous) {
   absl::Status creation_status = absl::OkStatus();
-  auto ret = std::unique_ptr<RouteMatcher>{new RouteMatcher(route_config, global_route_config,
-                                                            factory_context, validator,
-                                                            validate_clusters, creation_status)};
+  auto ret = std::unique_ptr<RouteMatcher>{
+      new RouteMatcher(route_config, global_route_config, factory_context, validator,
+                       validate_clusters, previous, creation_status)};
   RETURN_IF_NOT_OK(creation_status);
   return ret;
 }
@@ -2172,7 +2331,7 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
                            const CommonConfigSharedPtr& global_route_config,
                            Server::Configuration::ServerFactoryContext& factory_context,
                            ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
-                           absl::Status& creation_status)
+                           const RouteMatcher* previous, absl::Status& creation_status)
     : vhost_scope_(factory_context.scope().scopeFromStatName(
           factory_context.routerContext().virtualClusterStatNames().vhost_)),
       ignore_port_in_host_matching_(route_config.ignore_port_in_host_matching()) {
@@ -2180,11 +2339,33 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
   if (validate_clusters) {
     validation_clusters = factory_context.clusterManager().clusters();
   }
+  const bool reuse_virtual_hosts = Runtime::runtimeFeatureEnabled(
+      "envoy.reloadable_features.router_reuse_unchanged_virtual_hosts");
+  // Reused virtual hosts would skip the validation of their clusters.
+  if (validate_clusters) {
+    previous = nullptr;
+  }
   for (const auto& virtual_host_config : route_config.virtual_hosts()) {
-    VirtualHostSharedPtr virtual_host = std::make_shared<VirtualHostImpl>(
-        virtual_host_config, global_route_config, factory_context, *vhost_scope_, validator,
-        validation_clusters, creation_status);
-    SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+    VirtualHostSharedPtr virtual_host;
+    std::string key;
+    if (reuse_virtual_hosts) {
+      key = internKey(virtual_host_config);
+      if (previous != nullptr) {
+        if (const auto it = previous->virtual_hosts_by_config_.find(key);
+            it != previous->virtual_hosts_by_config_.end()) {
+          virtual_host = it->second;
+        }
+      }
+    }
+    if (virtual_host == nullptr) {
+      virtual_host = std::make_shared<VirtualHostImpl>(virtual_host_config, global_route_config,
+                                                       factory_context, *vhost_scope_, validator,
+                                                       validation_clusters, creation_status);
+      SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+    }
+    if (reuse_virtual_hosts) {
+      virtual_hosts_by_config_.emplace(std::move(key), virtual_host);
+    }
     for (const std::string& domain_name : virtual_host_config.domains()) {
       const Http::LowerCaseString lower_case_domain_name(domain_name);
       absl::string_view domain = lower_case_domain_name;
@@ -2323,6 +2504,9 @@ CommonConfigImpl::CommonConfigImpl(const envoy::config::route::v3::RouteConfigur
       uses_vhds_(config.has_vhds()),
       most_specific_header_mutations_wins_(config.most_specific_header_mutations_wins()),
       ignore_path_parameters_in_path_matching_(config.ignore_path_parameters_in_path_matching()) {
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.router_intern_route_policies")) {
+    intern_pool_ = InternPool::get(factory_context.singletonManager());
+  }
   if (!config.request_mirror_policies().empty()) {
     shadow_policies_.reserve(config.request_mirror_policies().size());
     for (const auto& mirror_policy_config : config.request_mirror_policies()) {
@@ -2394,10 +2578,11 @@ create(const envoy::config::route::v3::RouteConfiguration& config,
 absl::StatusOr<std::shared_ptr<ConfigImpl>>
 ConfigImpl::create(const envoy::config::route::v3::RouteConfiguration& config,
                    Server::Configuration::ServerFactoryContext& factory_context,
-                   ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default) {
+                   ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+                   const ConfigImpl* previous) {
   absl::Status creation_status = absl::OkStatus();
   auto ret = std::shared_ptr<ConfigImpl>(new ConfigImpl(
-      config, factory_context, validator, validate_clusters_default, creation_status));
+      config, factory_context, validator, validate_clusters_default, previous, creation_status));
   RETURN_IF_NOT_OK(creation_status);
   return ret;
 }
@@ -2405,14 +2590,28 @@ ConfigImpl::create(const envoy::config::route::v3::RouteConfiguration& config,
 ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
                        Server::Configuration::ServerFactoryContext& factory_context,
                        ProtobufMessage::ValidationVisitor& validator,
-                       bool validate_clusters_default, absl::Status& creation_status) {
-  auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
-  SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
-  shared_config_ = std::move(config_or_error.value());
+                       bool validate_clusters_default, const ConfigImpl* previous,
+                       absl::Status& creation_status) {
+  if (Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.router_reuse_unchanged_virtual_hosts")) {
+    shared_config_key_ = sharedConfigKey(config);
+  }
+  // The virtual hosts of the previous version refer to its global route config, so they can only
+  // be reused together with it.
+  if (previous != nullptr && !previous->shared_config_key_.empty() &&
+      previous->shared_config_key_ == shared_config_key_) {
+    shared_config_ = previous->shared_config_;
+  } else {
+    previous = nullptr;
+    auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
+    SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
+    shared_config_ = std::move(config_or_error.value());
+  }
 
   auto matcher_or_error = RouteMatcher::create(
       config, shared_config_, factory_context, validator,
-      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default));
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default),
+      previous != nullptr ? previous->route_matcher_.get() : nullptr);
   SET_AND_RETURN_IF_NOT_OK(matcher_or_error.status(), creation_status);
   route_matcher_ = std::move(matcher_or_error.value());
 }
@@ -28,8 +28,10 @@
 #include "source/common/http/hash_policy.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/matcher/matcher.h"
+#include "source/common/router/compiled_route_table.h"
 #include "source/common/router/config_utility.h"
 #include "source/common/router/header_parser.h"
+#include "source/common/router/intern_pool.h"
 #include "source/common/router/metadatamatchcriteria_impl.h"
 #include "source/common/router/router_ratelimit.h"
 #include "source/common/router/tls_context_match_criteria_impl.h"
@@ -406,15 +408,32 @@ public:
                      const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
                      absl::Span<const RouteEntryImplBaseConstSharedPtr> routes) const;
 
+  // Virtual hosts with at least this many routes have their routes indexed by path, see
+  // CompiledRouteTable.
+  static constexpr size_t MinCompiledRoutes = 16;
+
 private:
   enum class SslRequirements : uint8_t { None, ExternalOnly, All };
 
+  // Match a single route of a route list. Returns whether the route lookup is done, with the
+  // selected route, if any, in selected.
+  bool selectRoute(const RouteCallback& cb, const RouteEntryImplBase& route, bool last_route,
+                   const Http::RequestHeaderMap& headers,
+                   const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
+                   RouteConstSharedPtr& selected) const;
+  RouteConstSharedPtr getRouteFromCompiledRoutes(const RouteCallback& cb,
+                                                 const Http::RequestHeaderMap& headers,
+                                                 const StreamInfo::StreamInfo& stream_info,
+                                                 uint64_t random_value) const;
+
   CommonVirtualHostSharedPtr shared_virtual_host_;
 
   std::shared_ptr<const SslRedirectRoute> ssl_redirect_route_;
   SslRequirements ssl_requirements_;
 
   std::vector<RouteEntryImplBaseConstSharedPtr> routes_;
+  // Index over routes_, only set for virtual hosts with many routes.
+  CompiledRouteTablePtr compiled_routes_;
   Matcher::MatchTreeSharedPtr<Http::HttpMatchingData> matcher_;
 };
 
@@ -676,6 +695,7 @@ public:
 
   bool matchRoute(const Http::RequestHeaderMap& headers, const StreamInfo::StreamInfo& stream_info,
                   uint64_t random_value) const;
+  bool case_sensitive() const { return case_sensitive_; }
   absl::Status
   validateClusters(const Upstream::ClusterManager::ClusterInfoMaps& cluster_info_maps) const;
 
@@ -1105,7 +1125,6 @@ protected:
   const std::string host_rewrite_;
   std::unique_ptr<ConnectConfig> connect_config_;
 
-  bool case_sensitive() const { return case_sensitive_; }
   RouteConstSharedPtr clusterEntry(const Http::RequestHeaderMap& headers,
                                    uint64_t random_value) const;
 
@@ -1171,7 +1190,7 @@ private:
   buildHedgePolicy(HedgePolicyConstOptRef vhost_hedge_policy,
                    const envoy::config::route::v3::RouteAction& route_config) const;
 
-  absl::StatusOr<std::unique_ptr<RetryPolicyImpl>>
+  absl::StatusOr<std::shared_ptr<const RetryPolicyImpl>>
   buildRetryPolicy(RetryPolicyConstOptRef vhost_retry_policy,
                    const envoy::config::route::v3::RouteAction& route_config,
                    ProtobufMessage::ValidationVisitor& validation_visitor,
@@ -1228,7 +1247,7 @@ private:
   std::unique_ptr<const RuntimeData> runtime_;
   std::unique_ptr<const ::Envoy::Http::Utility::RedirectConfig> redirect_config_;
   std::unique_ptr<const HedgePolicyImpl> hedge_policy_;
-  std::unique_ptr<const RetryPolicyImpl> retry_policy_;
+  std::shared_ptr<const RetryPolicyImpl> retry_policy_;
   std::unique_ptr<const InternalRedirectPolicyImpl> internal_redirect_policy_;
   std::unique_ptr<const RateLimitPolicyImpl> rate_limit_policy_;
   std::vector<ShadowPolicyPtr> shadow_policies_;
@@ -1237,11 +1256,12 @@ private:
   std::unique_ptr<const WeightedClustersConfig> weighted_clusters_config_;
 
   UpgradeMap upgrade_map_;
-  std::unique_ptr<const Http::HashPolicyImpl> hash_policy_;
-  MetadataMatchCriteriaConstPtr metadata_match_criteria_;
+  // The policies, criteria and parsers below may be shared with other routes, see InternPool.
+  std::shared_ptr<const Http::HashPolicyImpl> hash_policy_;
+  std::shared_ptr<const MetadataMatchCriteriaImpl> metadata_match_criteria_;
   TlsContextMatchCriteriaConstPtr tls_context_match_criteria_;
-  HeaderParserPtr request_headers_parser_;
-  HeaderParserPtr response_headers_parser_;
+  HeaderParserSharedPtr request_headers_parser_;
+  HeaderParserSharedPtr response_headers_parser_;
   RouteMetadataPackPtr metadata_;
   const std::vector<Envoy::Matchers::MetadataMatcher> dynamic_metadata_;
 
@@ -1528,11 +1548,17 @@ DECLARE_FACTORY(RouteListMatchActionFactory);
  */
 class RouteMatcher {
 public:
+  /**
+   * @param previous supplies an optional matcher of the previous version of the route
+   *        configuration, built with the same global route config. Its virtual hosts are reused
+   *        for virtual hosts whose config is unchanged.
+   */
   static absl::StatusOr<std::unique_ptr<RouteMatcher>>
   create(const envoy::config::route::v3::RouteConfiguration& config,
          const CommonConfigSharedPtr& global_route_config,
          Server::Configuration::ServerFactoryContext& factory_context,
-         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters);
+         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+         const RouteMatcher* previous = nullptr);
 
   RouteConstSharedPtr route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                             const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const;
@@ -1544,7 +1570,7 @@ private:
                const CommonConfigSharedPtr& global_route_config,
                Server::Configuration::ServerFactoryContext& factory_context,
                ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
-               absl::Status& creation_status);
+               const RouteMatcher* previous, absl::Status& creation_status);
 
   using WildcardVirtualHosts =
       std::map<int64_t, absl::node_hash_map<std::string, VirtualHostSharedPtr>, std::greater<>>;
@@ -1569,6 +1595,10 @@ private:
   WildcardVirtualHosts wildcard_virtual_host_prefixes_;
 
   VirtualHostSharedPtr default_virtual_host_;
+  // Virtual hosts by the serialization of their config, for reuse by the next version of the route
+  // configuration. The configs are compared in full rather than by hash, as a collision would
+  // serve the routes of another virtual host. Empty if reuse is disabled.
+  absl::flat_hash_map<std::string, VirtualHostSharedPtr> virtual_hosts_by_config_;
   const bool ignore_port_in_host_matching_{false};
 };
 
@@ -1620,6 +1650,8 @@ public:
   bool ignorePathParametersInPathMatching() const {
     return ignore_path_parameters_in_path_matching_;
   }
+  // The pool that routes share immutable objects through, or nullptr if sharing is disabled.
+  InternPool* internPool() const { return intern_pool_.get(); }
   const envoy::config::core::v3::Metadata& metadata() const override;
   const Envoy::Config::TypedMetadata& typedMetadata() const override;
 
@@ -1637,6 +1669,7 @@ private:
   absl::flat_hash_map<std::string, ClusterSpecifierPluginSharedPtr> cluster_specifier_plugins_;
   std::unique_ptr<PerFilterConfigs> per_filter_configs_;
   RouteMetadataPackPtr metadata_;
+  InternPoolSharedPtr intern_pool_;
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   const uint32_t max_direct_response_body_size_bytes_;
   const bool uses_vhds_ : 1;
@@ -1649,10 +1682,16 @@ private:
  */
 class ConfigImpl : public Config {
 public:
+  /**
+   * @param previous supplies an optional previous version of the route configuration. If only
+   *        virtual hosts changed since then, the unchanged virtual hosts and the global route
+   *        config of the previous version are shared with the new one instead of being rebuilt.
+   */
   static absl::StatusOr<std::shared_ptr<ConfigImpl>>
   create(const envoy::config::route::v3::RouteConfiguration& config,
          Server::Configuration::ServerFactoryContext& factory_context,
-         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default);
+         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+         const ConfigImpl* previous = nullptr);
 
   bool virtualHostExists(const Http::RequestHeaderMap& headers) const {
     return route_matcher_->findVirtualHost(headers) != nullptr;
@@ -1695,10 +1734,13 @@ protected:
   ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
              Server::Configuration::ServerFactoryContext& factory_context,
              ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
-             absl::Status& creation_status);
+             const ConfigImpl* previous, absl::Status& creation_status);
 
 private:
   CommonConfigSharedPtr shared_config_;
+  // Serialization of the config without its virtual hosts, i.e. of the config of shared_config_.
+  // Empty if reuse of unchanged virtual hosts is disabled.
+  std::string shared_config_key_;
   std::unique_ptr<RouteMatcher> route_matcher_;
 };
 
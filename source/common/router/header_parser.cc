@@ -14,6 +14,7 @@
 #include "source/common/json/json_loader.h"
 #include "source/common/protobuf/utility.h"
 
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
 
@@ -48,6 +49,9 @@ parseHttpHeaderFormatter(const envoy::config::core::v3::HeaderValue& header_valu
   return Envoy::Formatter::FormatterImpl::create(final_header_value, true);
 }
 
+// A value without any '%' has neither commands nor escapes, so it formats to itself.
+bool isConstantValue(absl::string_view value) { return !absl::StrContains(value, '%'); }
+
 } // namespace
 
 HeadersToAddEntry::HeadersToAddEntry(const HeaderValueOption& header_value_option,
@@ -73,6 +77,7 @@ HeadersToAddEntry::HeadersToAddEntry(const HeaderValueOption& header_value_optio
   auto formatter_or_error = parseHttpHeaderFormatter(header_value_option.header());
   SET_AND_RETURN_IF_NOT_OK(formatter_or_error.status(), creation_status);
   formatter_ = std::move(formatter_or_error.value());
+  constant_value_ = isConstantValue(original_value_);
 }
 
 HeadersToAddEntry::HeadersToAddEntry(const HeaderValue& header_value,
@@ -82,6 +87,7 @@ HeadersToAddEntry::HeadersToAddEntry(const HeaderValue& header_value,
   auto formatter_or_error = parseHttpHeaderFormatter(header_value);
   SET_AND_RETURN_IF_NOT_OK(formatter_or_error.status(), creation_status);
   formatter_ = std::move(formatter_or_error.value());
+  constant_value_ = isConstantValue(original_value_);
 }
 
 absl::StatusOr<HeaderParserPtr>
@@ -160,21 +166,18 @@ void HeaderParser::evaluateHeaders(Http::HeaderMap& headers,
   // header_formatter_speed_test.cc provides micro-benchmark for evaluating speed of adding and
   // replacing headers and should be used when modifying the code below to access the performance
   // impact of code changes.
-  absl::InlinedVector<std::pair<const Http::LowerCaseString&, const std::string>, 4> headers_to_add,
-      headers_to_overwrite;
-  // value_buffer is used only when stream_info is a valid pointer and stores header value
-  // created by a formatter. It is declared outside of 'for' loop for performance reason to avoid
-  // stack allocation and unnecessary std::string's memory adjustments for each iteration. The
-  // actual value of the header is accessed via 'value' variable which is initialized differently
-  // depending whether stream_info and valid or nullptr. Based on performance tests implemented in
-  // header_formatter_speed_test.cc this approach strikes the best balance between performance and
-  // readability.
-  std::string value_buffer;
+  absl::InlinedVector<std::pair<const Http::LowerCaseString&, absl::string_view>, 4>
+      headers_to_add, headers_to_overwrite;
+  // formatted_values stores the header values created by formatters, which the views above refer
+  // to. Its capacity is reserved up front so that the values never move. Constant values are
+  // neither formatted nor copied here, but viewed in place.
+  absl::InlinedVector<std::string, 4> formatted_values;
+  formatted_values.reserve(headers_to_add_.size());
   for (const auto& [key, entry] : headers_to_add_) {
     absl::string_view value;
-    if (stream_info != nullptr) {
-      value_buffer = entry->formatter_->formatWithContext(context, *stream_info);
-      value = value_buffer;
+    if (stream_info != nullptr && !entry->constant_value_) {
+      value = formatted_values.emplace_back(
+          entry->formatter_->formatWithContext(context, *stream_info));
     } else {
       value = entry->original_value_;
     }
@@ -218,7 +221,9 @@ Http::HeaderTransforms HeaderParser::getHeaderTransforms(const StreamInfo::Strea
 
   for (const auto& [key, entry] : headers_to_add_) {
     if (do_formatting) {
-      const std::string value = entry->formatter_->formatWithContext({}, stream_info);
+      const std::string value = entry->constant_value_
+                                    ? entry->original_value_
+                                    : entry->formatter_->formatWithContext({}, stream_info);
       if (!value.empty() || entry->add_if_empty_) {
         switch (entry->append_action_) {
         case HeaderValueOption::APPEND_IF_EXISTS_OR_ADD:
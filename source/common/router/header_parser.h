@@ -16,6 +16,7 @@ namespace Router {
 
 class HeaderParser;
 using HeaderParserPtr = std::unique_ptr<HeaderParser>;
+using HeaderParserSharedPtr = std::shared_ptr<const HeaderParser>;
 
 using HeaderAppendAction = envoy::config::core::v3::HeaderValueOption::HeaderAppendAction;
 using HeaderValueOption = envoy::config::core::v3::HeaderValueOption;
@@ -44,6 +45,8 @@ struct HeadersToAddEntry {
   HeaderAppendAction append_action_;
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   bool add_if_empty_ = false;
+  // Whether the value has no substitutions, so it can be used without formatting it.
+  bool constant_value_ = false;
 
 protected:
   HeadersToAddEntry(const HeaderValue& header_value, HeaderAppendAction append_action,
@@ -0,0 +1,15 @@
+#include "source/common/router/intern_pool.h"
+
+namespace Envoy {
+namespace Router {
+
+SINGLETON_MANAGER_REGISTRATION(router_intern_pool);
+
+std::shared_ptr<InternPool> InternPool::get(Singleton::Manager& singleton_manager) {
+  return singleton_manager.getTyped<InternPool>(
+      SINGLETON_MANAGER_REGISTERED_NAME(router_intern_pool),
+      [] { return std::make_shared<InternPool>(); });
+}
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <utility>
+
+#include "envoy/common/exception.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/singleton/manager.h"
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * Pool of the immutable objects that routes are built from, e.g. retry policies or header parsers,
+ * shared by every route configuration of the server. Objects are keyed by their type and the config
+ * they are built from, so that routes of different route configurations, e.g. of different scopes
+ * of scoped RDS, with the same config share one object. Objects are released once the last route
+ * using them is destroyed.
+ *
+ * Objects are created on the main thread, but may be released on any thread, as routes may be
+ * destroyed on workers.
+ */
+class InternPool : public Singleton::Instance,
+                   public std::enable_shared_from_this<InternPool>,
+                   NonCopyable {
+public:
+  /**
+   * @return the pool of the server.
+   */
+  static std::shared_ptr<InternPool> get(Singleton::Manager& singleton_manager);
+
+  /**
+   * @param config supplies the config of the object, e.g. its serialized proto. The config must
+   *        determine the object, i.e. objects of the same type with the same config must be
+   *        interchangeable. It is kept with the pooled object and compared on lookup, so unlike a
+   *        hash it can't collide.
+   * @param create supplies the function that creates the object if none is pooled.
+   * @return the pooled object, or the error of create.
+   */
+  template <class T>
+  absl::StatusOr<std::shared_ptr<const T>>
+  getOrCreate(std::string config, absl::FunctionRef<absl::StatusOr<std::unique_ptr<T>>()> create) {
+    const Key key{std::type_index(typeid(T)), std::move(config)};
+    {
+      absl::MutexLock lock(&mutex_);
+      if (const auto it = objects_.find(key); it != objects_.end()) {
+        if (std::shared_ptr<const void> object = it->second.lock(); object != nullptr) {
+          return std::static_pointer_cast<const T>(object);
+        }
+      }
+    }
+
+    absl::StatusOr<std::unique_ptr<T>> object_or_error = create();
+    RETURN_IF_NOT_OK(object_or_error.status());
+    std::shared_ptr<const T> object(object_or_error.value().release(),
+                                    [pool = shared_from_this(), key](const T* object) {
+                                      pool->release(key);
+                                      delete object;
+                                    });
+    absl::MutexLock lock(&mutex_);
+    objects_[key] = object;
+    return object;
+  }
+
+  /**
+   * @return the number of pooled objects, including objects that are being released.
+   */
+  size_t size() const {
+    absl::MutexLock lock(&mutex_);
+    return objects_.size();
+  }
+
+private:
+  using Key = std::pair<std::type_index, std::string>;
+
+  void release(const Key& key) {
+    absl::MutexLock lock(&mutex_);
+    // The entry may already refer to a new object with the same key.
+    if (const auto it = objects_.find(key); it != objects_.end() && it->second.expired()) {
+      objects_.erase(it);
+    }
+  }
+
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<Key, std::weak_ptr<const void>> objects_ ABSL_GUARDED_BY(mutex_);
+};
+
+using InternPoolSharedPtr = std::shared_ptr<InternPool>;
+
+} // namespace Router
+} // namespace Envoy
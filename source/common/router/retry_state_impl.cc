@@ -36,12 +36,15 @@ RetryStateImpl::create(const RetryPolicy& route_policy, Http::RequestHeaderMap&
   // We short circuit here and do not bother with an allocation if there is no chance we will retry.
   // But for HTTP/3 0-RTT safe requests, which can be rejected because they are sent too early(425
   // response code), we want to give them a chance to retry as normal requests even though the retry
-  // policy doesn't specify it. So always allocate retry state object.
+  // policy doesn't specify it. The same goes for safe requests pipelined on HTTP/1.1 connections,
+  // which are refused if their connection fails before their response starts. So always allocate
+  // retry state object.
   if (request_headers.EnvoyRetryOn() || request_headers.EnvoyRetryGrpcOn() ||
       route_policy.retryOn()) {
     ret.reset(new RetryStateImpl(route_policy, request_headers, cluster, vcluster,
                                  route_stats_context, context, dispatcher, priority, false));
-  } else if ((cluster.features() & Upstream::ClusterInfo::Features::HTTP3) &&
+  } else if (((cluster.features() & Upstream::ClusterInfo::Features::HTTP3) ||
+              cluster.http1Settings().max_requests_in_flight_ > 1) &&
              Http::Utility::isSafeRequest(request_headers)) {
     ret.reset(new RetryStateImpl(route_policy, request_headers, cluster, vcluster,
                                  route_stats_context, context, dispatcher, priority, true));
@@ -65,7 +68,7 @@ RetryStateImpl::RetryStateImpl(const RetryPolicy& route_policy,
                                RouteStatsContextOptRef route_stats_context,
                                Server::Configuration::CommonFactoryContext& context,
                                Event::Dispatcher& dispatcher, Upstream::ResourcePriority priority,
-                               bool auto_configured_for_http3)
+                               bool auto_configured)
     : cluster_(cluster), vcluster_(vcluster), route_stats_context_(route_stats_context),
       runtime_(context.runtime()), random_(context.api().randomGenerator()),
       dispatcher_(dispatcher), time_source_(context.timeSource()),
@@ -76,7 +79,7 @@ RetryStateImpl::RetryStateImpl(const RetryPolicy& route_policy,
       reset_headers_(route_policy.resetHeaders()),
       reset_max_interval_(route_policy.resetMaxInterval()), retry_on_(route_policy.retryOn()),
       retries_remaining_(route_policy.numRetries()), priority_(priority),
-      auto_configured_for_http3_(auto_configured_for_http3) {
+      auto_configured_(auto_configured) {
   if ((cluster.features() & Upstream::ClusterInfo::Features::HTTP3) &&
       Http::Utility::isSafeRequest(request_headers)) {
     // Because 0-RTT requests could be rejected because they are sent too early, and such requests
@@ -87,6 +90,12 @@ RetryStateImpl::RetryStateImpl(const RetryPolicy& route_policy,
     retry_on_ |= RetryPolicy::RETRY_ON_RETRIABLE_STATUS_CODES;
     retriable_status_codes_.push_back(static_cast<uint32_t>(Http::Code::TooEarly));
   }
+  if (cluster.http1Settings().max_requests_in_flight_ > 1 &&
+      Http::Utility::isSafeRequest(request_headers)) {
+    // Safe requests may be pipelined on HTTP/1.1 connections. If the connection fails before their
+    // response starts, they are refused, and should be sent again on another connection.
+    retry_on_ |= RetryPolicy::RETRY_ON_REFUSED_STREAM;
+  }
   std::chrono::milliseconds base_interval(
       runtime_.snapshot().getInteger("upstream.base_retry_backoff_ms", 25));
   if (route_policy.baseInterval()) {
@@ -96,7 +96,9 @@ public:
 
   uint32_t hostSelectionMaxAttempts() const override { return host_selection_max_attempts_; }
 
-  bool isAutomaticallyConfiguredForHttp3() const { return auto_configured_for_http3_; }
+  // Whether the retry state only exists to send safe requests again after they failed for reasons
+  // that the retry policy does not need to allow: HTTP/3 early data or HTTP/1.1 pipelining.
+  bool isAutomaticallyConfigured() const { return auto_configured_; }
 
 private:
   RetryStateImpl(const RetryPolicy& route_policy, Http::RequestHeaderMap& request_headers,
@@ -104,7 +106,7 @@ private:
                  RouteStatsContextOptRef route_stats_context,
                  Server::Configuration::CommonFactoryContext& context,
                  Event::Dispatcher& dispatcher, Upstream::ResourcePriority priority,
-                 bool auto_configured_for_http3);
+                 bool auto_configured);
 
   void enableBackoffTimer();
   void resetRetry();
@@ -141,7 +143,7 @@ private:
   uint32_t retries_remaining_{};
   uint32_t host_selection_max_attempts_;
   Upstream::ResourcePriority priority_;
-  const bool auto_configured_for_http3_{};
+  const bool auto_configured_{};
 };
 
 } // namespace Router
@@ -42,11 +42,13 @@ Rds::ConfigConstSharedPtr ConfigTraitsImpl::createNullConfig() const {
 Rds::ConfigConstSharedPtr
 ConfigTraitsImpl::createConfig(const Protobuf::Message& rc,
                                Server::Configuration::ServerFactoryContext& factory_context,
-                               bool validate_clusters_default) const {
+                               bool validate_clusters_default,
+                               const Rds::ConfigConstSharedPtr& previous_config) const {
   ASSERT(dynamic_cast<const envoy::config::route::v3::RouteConfiguration*>(&rc));
   return THROW_OR_RETURN_VALUE(
       ConfigImpl::create(static_cast<const envoy::config::route::v3::RouteConfiguration&>(rc),
-                         factory_context, validator_, validate_clusters_default),
+                         factory_context, validator_, validate_clusters_default,
+                         dynamic_cast<const ConfigImpl*>(previous_config.get())),
       std::shared_ptr<ConfigImpl>);
 }
 
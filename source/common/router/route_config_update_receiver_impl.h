@@ -23,9 +23,10 @@ public:
   ConfigTraitsImpl(ProtobufMessage::ValidationVisitor& validator) : validator_(validator) {}
 
   Rds::ConfigConstSharedPtr createNullConfig() const override;
-  Rds::ConfigConstSharedPtr createConfig(const Protobuf::Message& rc,
-                                         Server::Configuration::ServerFactoryContext& context,
-                                         bool validate_clusters_default) const override;
+  Rds::ConfigConstSharedPtr
+  createConfig(const Protobuf::Message& rc, Server::Configuration::ServerFactoryContext& context,
+               bool validate_clusters_default,
+               const Rds::ConfigConstSharedPtr& previous_config) const override;
 
 private:
   ProtobufMessage::ValidationVisitor& validator_;
@@ -51,6 +51,32 @@ constexpr char NumInternalRedirectsFilterStateName[] = "num_internal_redirects";
 
 uint32_t getLength(const Buffer::Instance* instance) { return instance ? instance->length() : 0; }
 
+// Returns a copy of `data` which several shadow requests may share, if there is more than one of
+// them, so that the data is copied once rather than once per shadow request.
+std::shared_ptr<const std::string> shareShadowData(const Buffer::Instance* data,
+                                                   size_t shadow_count) {
+  if (shadow_count <= 1 || getLength(data) == 0) {
+    return nullptr;
+  }
+  return std::make_shared<const std::string>(data->toString());
+}
+
+// Adds `data` to the body of a shadow request, either by referencing the shared copy or by copying
+// it.
+void addShadowData(Buffer::Instance& body, const Buffer::Instance& data,
+                   const std::shared_ptr<const std::string>& shared_data) {
+  if (shared_data == nullptr) {
+    body.add(data);
+    return;
+  }
+  auto fragment = new Buffer::BufferFragmentImpl(
+      shared_data->data(), shared_data->size(),
+      [shared_data](const void*, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
+        delete this_fragment;
+      });
+  body.addBufferFragment(*fragment);
+}
+
 bool schemeIsHttp(const Http::RequestHeaderMap& downstream_headers,
                   OptRef<const Network::Connection> connection) {
   if (Http::Utility::schemeIsHttp(downstream_headers.getSchemeValue())) {
@@ -426,7 +452,7 @@ void Filter::chargeUpstreamCode(uint64_t response_status_code,
     }
 
     if (dropped) {
-      cluster_->loadReportStats().upstream_rq_dropped_.inc();
+      cluster_->loadReportStats()->upstream_rq_dropped_.inc();
     }
     if (upstream_host && Http::CodeUtility::is5xx(response_status_code)) {
       upstream_host->stats().rq_error_.inc();
@@ -485,16 +511,16 @@ Http::FilterHeadersStatus Filter::decodeHeaders(Http::RequestHeaderMap& headers,
         direct_response->responseCode(), direct_response->responseBody(),
         [this, direct_response,
          &request_headers = headers](Http::ResponseHeaderMap& response_headers) -> void {
-          std::string new_uri;
-          if (request_headers.Path()) {
-            new_uri = direct_response->newUri(request_headers);
-          }
           // See https://tools.ietf.org/html/rfc7231#section-7.1.2.
           const auto add_location =
               direct_response->responseCode() == Http::Code::Created ||
               Http::CodeUtility::is3xx(enumToInt(direct_response->responseCode()));
-          if (!new_uri.empty() && add_location) {
-            response_headers.addReferenceKey(Http::Headers::get().Location, new_uri);
+          // Only build the new URI when it is used, as most direct responses have no location.
+          if (add_location && request_headers.Path()) {
+            std::string new_uri = direct_response->newUri(request_headers);
+            if (!new_uri.empty()) {
+              response_headers.addReferenceKey(Http::Headers::get().Location, new_uri);
+            }
           }
           direct_response->finalizeResponseHeaders(response_headers, callbacks_->streamInfo());
         },
@@ -822,9 +848,12 @@ Http::FilterHeadersStatus Filter::continueDecodeHeaders(
       const auto& policy_ref = *shadow_policy;
       if (FilterUtility::shouldShadow(policy_ref, config_->runtime_, callbacks_->streamId())) {
         active_shadow_policies_.push_back(std::cref(policy_ref));
-        shadow_headers_ = Http::createHeaderMap<Http::RequestHeaderMapImpl>(*downstream_headers_);
       }
     }
+    // All the shadow requests are created from the same copy of the headers.
+    if (!active_shadow_policies_.empty()) {
+      shadow_headers_ = Http::createHeaderMap<Http::RequestHeaderMapImpl>(*downstream_headers_);
+    }
   }
 
   ENVOY_STREAM_LOG(debug, "router decoding headers:\n{}", *callbacks_, headers);
@@ -993,12 +1022,15 @@ Http::FilterDataStatus Filter::decodeData(Buffer::Instance& data, bool end_strea
     }
   }
 
+  const std::shared_ptr<const std::string> shared_data =
+      shareShadowData(&data, shadow_streams_.size());
   for (auto* shadow_stream : shadow_streams_) {
     if (end_stream) {
       shadow_stream->removeDestructorCallback();
       shadow_stream->removeWatermarkCallbacks();
     }
-    Buffer::OwnedImpl copy(data);
+    Buffer::OwnedImpl copy;
+    addShadowData(copy, data, shared_data);
     shadow_stream->sendData(copy, end_stream);
   }
   if (end_stream) {
@@ -1121,6 +1153,8 @@ absl::optional<absl::string_view> Filter::getShadowCluster(const ShadowPolicy& p
 }
 
 void Filter::maybeDoShadowing() {
+  const std::shared_ptr<const std::string> shared_body =
+      shareShadowData(callbacks_->decodingBuffer(), active_shadow_policies_.size());
   for (const auto& shadow_policy_wrapper : active_shadow_policies_) {
     const auto& shadow_policy = shadow_policy_wrapper.get();
 
@@ -1135,7 +1169,7 @@ void Filter::maybeDoShadowing() {
     Http::RequestMessagePtr request(new Http::RequestMessageImpl(
         Http::createHeaderMap<Http::RequestHeaderMapImpl>(*shadow_headers_)));
     if (callbacks_->decodingBuffer()) {
-      request->body().add(*callbacks_->decodingBuffer());
+      addShadowData(request->body(), *callbacks_->decodingBuffer(), shared_body);
     }
     if (shadow_trailers_) {
       request->trailers(Http::createHeaderMap<Http::RequestTrailerMapImpl>(*shadow_trailers_));
@@ -1275,8 +1309,7 @@ void Filter::onSoftPerTryTimeout(UpstreamRequest& upstream_request) {
       // later if 1) we hit global timeout or 2) we get bad response headers
       // back.
       upstream_request.retried(true);
-
-      // TODO: cluster stat for hedge attempted.
+      cluster_->trafficStats()->upstream_rq_hedge_attempted_.inc();
     } else if (retry_status == RetryStatus::NoOverflow) {
       callbacks_->streamInfo().setResponseFlag(StreamInfo::CoreResponseFlag::UpstreamOverflow);
     } else if (retry_status == RetryStatus::NoRetryLimitExceeded) {
@@ -1638,7 +1671,7 @@ void Filter::resetOtherUpstreams(UpstreamRequest& upstream_request) {
     if (upstream_request_tmp.get() != &upstream_request) {
       upstream_request_tmp->resetStream();
       // TODO: per-host stat for hedge abandoned.
-      // TODO: cluster stat for hedge abandoned.
+      cluster_->trafficStats()->upstream_rq_hedge_abandoned_.inc();
     } else {
       final_upstream_request = std::move(upstream_request_tmp);
     }
@@ -1862,6 +1895,15 @@ void Filter::onUpstreamComplete(UpstreamRequest& upstream_request) {
   std::chrono::milliseconds response_time = std::chrono::duration_cast<std::chrono::milliseconds>(
       dispatcher.timeSource().monotonicTime() - downstream_request_complete_time_);
 
+  if (!callbacks_->streamInfo().healthCheck() &&
+      DateUtil::timePointValid(downstream_request_complete_time_)) {
+    OptRef<Upstream::HostLbPolicyData> lb_policy_data =
+        upstream_request.upstreamHost()->lbPolicyData();
+    if (lb_policy_data.has_value()) {
+      lb_policy_data->onResponseTime(response_time);
+    }
+  }
+
   Upstream::ClusterTimeoutBudgetStatsOptRef tb_stats = cluster()->timeoutBudgetStats();
   if (tb_stats.has_value()) {
     tb_stats->get().upstream_rq_timeout_budget_percent_used_.recordValue(
@@ -2244,7 +2286,7 @@ bool Filter::checkDropOverload(Upstream::ThreadLocalCluster& cluster,
           },
           absl::nullopt, StreamInfo::ResponseCodeDetails::get().DropOverload);
 
-      cluster.info()->loadReportStats().upstream_rq_drop_overload_.inc();
+      cluster.info()->loadReportStats()->upstream_rq_drop_overload_.inc();
       return true;
     }
   }
@@ -2314,10 +2356,10 @@ ProdFilter::createRetryState(const RetryPolicy& policy, Http::RequestHeaderMap&
   std::unique_ptr<RetryStateImpl> retry_state =
       RetryStateImpl::create(policy, request_headers, cluster, vcluster, route_stats_context,
                              context, dispatcher, priority);
-  if (retry_state != nullptr && retry_state->isAutomaticallyConfiguredForHttp3()) {
-    // Since doing retry will make Envoy to buffer the request body, if upstream using HTTP/3 is the
-    // only reason for doing retry, set the retry shadow buffer limit to 0 so that we don't retry or
-    // buffer safe requests with body which is not common.
+  if (retry_state != nullptr && retry_state->isAutomaticallyConfigured()) {
+    // Since doing retry will make Envoy to buffer the request body, if upstream using HTTP/3 or
+    // pipelining is the only reason for doing retry, set the retry shadow buffer limit to 0 so that
+    // we don't retry or buffer safe requests with body which is not common.
     setRetryShadowBufferLimit(0);
   }
   return retry_state;
@@ -132,13 +132,23 @@ bool SnapshotImpl::featureEnabled(absl::string_view key, uint64_t default_value,
   return featureEnabled(key, default_value, random_value, 100);
 }
 
+const Snapshot::Entry* SnapshotImpl::find(absl::string_view key) const {
+  // Most deployments override few or no keys, so skip hashing the key when there is nothing to
+  // find.
+  if (values_.empty() || key.empty()) {
+    return nullptr;
+  }
+  const auto it = values_.find(key);
+  return it == values_.end() ? nullptr : &it->second;
+}
+
 Snapshot::ConstStringOptRef SnapshotImpl::get(absl::string_view key) const {
   ASSERT(!isRuntimeFeature(key)); // Make sure runtime guarding is only used for getBoolean
-  auto entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end()) {
+  const Entry* entry = find(key);
+  if (entry == nullptr) {
     return absl::nullopt;
   } else {
-    return entry->second.raw_string_value_;
+    return entry->raw_string_value_;
   }
 }
 
@@ -150,68 +160,72 @@ bool SnapshotImpl::featureEnabled(absl::string_view key,
 bool SnapshotImpl::featureEnabled(absl::string_view key,
                                   const envoy::type::v3::FractionalPercent& default_value,
                                   uint64_t random_value) const {
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  envoy::type::v3::FractionalPercent percent;
-  if (entry != values_.end() && entry->second.fractional_percent_value_.has_value()) {
-    percent = entry->second.fractional_percent_value_.value();
-  } else if (entry != values_.end() && entry->second.uint_value_.has_value()) {
+  const Entry* entry = find(key);
+  // The percent is read in place rather than copied, since this runs for every request.
+  uint32_t numerator;
+  envoy::type::v3::FractionalPercent::DenominatorType denominator;
+  if (entry != nullptr && entry->fractional_percent_value_.has_value()) {
+    numerator = entry->fractional_percent_value_->numerator();
+    denominator = entry->fractional_percent_value_->denominator();
+  } else if (entry != nullptr && entry->uint_value_.has_value()) {
     // Check for > 100 because the runtime value is assumed to be specified as
     // an integer, and it also ensures that truncating the uint64_t runtime
     // value into a uint32_t percent numerator later is safe
-    if (entry->second.uint_value_.value() > 100) {
+    if (entry->uint_value_.value() > 100) {
       return true;
     }
 
     // The runtime value was specified as an integer rather than a fractional
     // percent proto. To preserve legacy semantics, we treat it as a percentage
     // (i.e. denominator of 100).
-    percent.set_numerator(entry->second.uint_value_.value());
-    percent.set_denominator(envoy::type::v3::FractionalPercent::HUNDRED);
+    numerator = entry->uint_value_.value();
+    denominator = envoy::type::v3::FractionalPercent::HUNDRED;
   } else {
-    percent = default_value;
+    numerator = default_value.numerator();
+    denominator = default_value.denominator();
   }
 
   // When numerator > denominator condition is always evaluates to TRUE
   // It becomes hard to debug why configuration does not work in case of wrong numerator.
   // Log debug message that numerator is invalid.
-  uint64_t denominator_value =
-      ProtobufPercentHelper::fractionalPercentDenominatorToInt(percent.denominator());
-  if (percent.numerator() > denominator_value) {
+  const uint64_t denominator_value =
+      ProtobufPercentHelper::fractionalPercentDenominatorToInt(denominator);
+  if (numerator > denominator_value) {
     ENVOY_LOG(debug,
               "WARNING runtime key '{}': numerator ({}) > denominator ({}), condition always "
               "evaluates to true",
-              key, percent.numerator(), denominator_value);
+              key, numerator, denominator_value);
   }
 
-  return ProtobufPercentHelper::evaluateFractionalPercent(percent, random_value);
+  return random_value % denominator_value < numerator;
 }
 
 uint64_t SnapshotImpl::getInteger(absl::string_view key, uint64_t default_value) const {
   ASSERT(!isRuntimeFeature(key));
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.uint_value_) {
+  const Entry* entry = find(key);
+  if (entry == nullptr || !entry->uint_value_) {
     return default_value;
   } else {
-    return entry->second.uint_value_.value();
+    return entry->uint_value_.value();
   }
 }
 
 double SnapshotImpl::getDouble(absl::string_view key, double default_value) const {
   ASSERT(!isRuntimeFeature(key)); // Make sure runtime guarding is only used for getBoolean
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.double_value_) {
+  const Entry* entry = find(key);
+  if (entry == nullptr || !entry->double_value_) {
     return default_value;
   } else {
-    return entry->second.double_value_.value();
+    return entry->double_value_.value();
   }
 }
 
 bool SnapshotImpl::getBoolean(absl::string_view key, bool default_value) const {
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.bool_value_.has_value()) {
+  const Entry* entry = find(key);
+  if (entry == nullptr || !entry->bool_value_.has_value()) {
     return default_value;
   } else {
-    return entry->second.bool_value_.value();
+    return entry->bool_value_.value();
   }
 }
 
@@ -226,8 +240,7 @@ SnapshotImpl::SnapshotImpl(Random::RandomGenerator& generator, RuntimeStats& sta
     : layers_{std::move(layers)}, generator_{generator}, stats_{stats} {
   for (const auto& layer : layers_) {
     for (const auto& kv : layer->values()) {
-      values_.erase(kv.first);
-      values_.emplace(kv.first, kv.second);
+      values_.insert_or_assign(kv.first, kv.second);
     }
   }
   stats.num_keys_.set(values_.size());
@@ -93,6 +93,9 @@ public:
                        const ProtobufWkt::Value& value, absl::string_view raw_string = "");
 
 private:
+  // @return the entry of the key, or nullptr if the key is not set.
+  const Entry* find(absl::string_view key) const;
+
   const std::vector<OverrideLayerConstPtr> layers_;
   EntryMap values_;
   Random::RandomGenerator& generator_;
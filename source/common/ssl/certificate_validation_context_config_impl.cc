@@ -9,6 +9,7 @@
 #include "source/common/common/fmt.h"
 #include "source/common/common/logger.h"
 #include "source/common/config/datasource.h"
+#include "source/common/protobuf/utility.h"
 
 #include "spdlog/spdlog.h"
 
@@ -44,7 +45,10 @@ CertificateValidationContextConfigImpl::CertificateValidationContextConfigImpl(
       max_verify_depth_(config.has_max_verify_depth()
                             ? absl::optional<uint32_t>(config.max_verify_depth().value())
                             : absl::nullopt),
-      auto_sni_san_match_(auto_sni_san_match) {}
+      auto_sni_san_match_(auto_sni_san_match),
+      verified_certificate_cache_size_(config.verified_certificate_cache().max_entries()),
+      verified_certificate_cache_max_age_(
+          PROTOBUF_GET_MS_OR_DEFAULT(config.verified_certificate_cache(), max_age, 0)) {}
 
 absl::StatusOr<std::unique_ptr<CertificateValidationContextConfigImpl>>
 CertificateValidationContextConfigImpl::create(
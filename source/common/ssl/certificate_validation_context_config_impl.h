@@ -60,6 +60,14 @@ public:
 
   bool autoSniSanMatch() const override { return auto_sni_san_match_; }
 
+  uint32_t verifiedCertificateCacheSize() const override {
+    return verified_certificate_cache_size_;
+  }
+
+  std::chrono::milliseconds verifiedCertificateCacheMaxAge() const override {
+    return verified_certificate_cache_max_age_;
+  }
+
 protected:
   CertificateValidationContextConfigImpl(
       std::string ca_cert, std::string certificate_revocation_list,
@@ -86,6 +94,8 @@ private:
   const bool only_verify_leaf_cert_crl_;
   absl::optional<uint32_t> max_verify_depth_;
   const bool auto_sni_san_match_;
+  const uint32_t verified_certificate_cache_size_;
+  const std::chrono::milliseconds verified_certificate_cache_max_age_;
 };
 
 } // namespace Ssl
@@ -6,6 +6,7 @@
 
 #include "source/common/common/cleanup.h"
 #include "source/common/common/thread.h"
+#include "source/common/stats/isolated_store_impl.h"
 #include "source/common/stats/symbol_table.h"
 #include "source/common/stats/utility.h"
 
@@ -99,6 +100,53 @@ private:
   StatsStructType stats_;
 };
 
+// Lazy-initialization wrapper for a StatsStructType which lives in a store of its own, rather than
+// in the scope of its owner, such as the stats latched for load reports. The store itself is only
+// allocated along with the stats, so isPresent() tells apart stats which were never used from
+// stats which are zero.
+template <typename StatsStructType>
+class DeferredIsolatedStats : public DeferredCreationCompatibleInterface<StatsStructType> {
+public:
+  // Caller should make sure stat_names and symbol_table outlive this object.
+  DeferredIsolatedStats(const typename StatsStructType::StatNameType& stat_names,
+                        SymbolTable& symbol_table)
+      : stat_names_(stat_names), symbol_table_(symbol_table) {}
+  inline StatsStructType& getOrCreate() override {
+    return internal_stats_.get([this]() { return new IsolatedStats(stat_names_, symbol_table_); })
+        ->stats_;
+  }
+  bool isPresent() const override { return !internal_stats_.isNull(); }
+
+private:
+  struct IsolatedStats {
+    IsolatedStats(const typename StatsStructType::StatNameType& stat_names,
+                  SymbolTable& symbol_table)
+        : store_(symbol_table), stats_(stat_names, *store_.rootScope()) {}
+
+    IsolatedStoreImpl store_;
+    StatsStructType stats_;
+  };
+
+  const typename StatsStructType::StatNameType& stat_names_;
+  SymbolTable& symbol_table_;
+  Thread::AtomicPtr<IsolatedStats, Thread::AtomicPtrAllocMode::DeleteOnDestruct> internal_stats_;
+};
+
+// Non-deferred wrapper over a StatsStructType which lives in a store of its own.
+template <typename StatsStructType>
+class DirectIsolatedStats : public DeferredCreationCompatibleInterface<StatsStructType> {
+public:
+  DirectIsolatedStats(const typename StatsStructType::StatNameType& stat_names,
+                      SymbolTable& symbol_table)
+      : store_(symbol_table), stats_(stat_names, *store_.rootScope()) {}
+  inline StatsStructType& getOrCreate() override { return stats_; }
+  bool isPresent() const override { return true; }
+
+private:
+  IsolatedStoreImpl store_;
+  StatsStructType stats_;
+};
+
 // Template that lazily initializes a StatsStruct.
 // The bootstrap config :ref:`enable_deferred_creation_stats
 // <envoy_v3_api_field_config.bootstrap.v3.Bootstrap.deferred_stat_options>` decides if
@@ -117,5 +165,21 @@ createDeferredCompatibleStats(Stats::ScopeSharedPtr scope,
   }
 }
 
+// Template that lazily initializes a StatsStruct in a store of its own, which is never seen by
+// the stats sinks or the admin endpoint.
+template <typename StatsStructType>
+DeferredCreationCompatibleStats<StatsStructType>
+createDeferredCompatibleIsolatedStats(SymbolTable& symbol_table,
+                                      const typename StatsStructType::StatNameType& stat_names,
+                                      bool defer_creation) {
+  if (defer_creation) {
+    return DeferredCreationCompatibleStats<StatsStructType>(
+        std::make_unique<DeferredIsolatedStats<StatsStructType>>(stat_names, symbol_table));
+  } else {
+    return DeferredCreationCompatibleStats<StatsStructType>(
+        std::make_unique<DirectIsolatedStats<StatsStructType>>(stat_names, symbol_table));
+  }
+}
+
 } // namespace Stats
 } // namespace Envoy
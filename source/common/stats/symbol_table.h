@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <stack>
 #include <string>
@@ -19,6 +20,7 @@
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
+#include "absl/synchronization/mutex.h"
 
 namespace Envoy {
 namespace Stats {
@@ -349,7 +351,7 @@ public:
   void sortByStatNames(Iter begin, Iter end, GetStatName get_stat_name) const {
     // Grab the lock once before sorting begins, so we don't have to re-take
     // it on every comparison.
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
     StatNameCompare<GetStatName, Obj> compare(*this, get_stat_name);
     std::sort(begin, end, compare);
   }
@@ -397,13 +399,20 @@ private:
 
   struct SharedSymbol {
     SharedSymbol(Symbol symbol) : symbol_(symbol) {}
+    // The maps are only rehashed with lock_ held exclusively, when no ref count can change.
+    SharedSymbol(SharedSymbol&& other) noexcept
+        : symbol_(other.symbol_), ref_count_(other.ref_count_.load(std::memory_order_relaxed)) {}
 
     Symbol symbol_;
-    uint32_t ref_count_{1};
+    // Incremented with lock_ held shared by encode() and incRefCount(), so that encoding names
+    // with existing symbols doesn't block decoding. A symbol with a ref count of 0 is only erased
+    // with lock_ held exclusively.
+    mutable std::atomic<uint32_t> ref_count_{1};
   };
 
-  // This must be held during both encode() and free().
-  mutable Thread::MutexBasicLockable lock_;
+  // Held shared to decode and compare names, and to encode names whose symbols all exist. Held
+  // exclusively to create and free symbols.
+  mutable absl::Mutex lock_;
 
   /**
    * Decodes a uint8_t array into an array of period-delimited strings. Note
@@ -434,7 +443,7 @@ private:
    * @param symbol the individual symbol to be decoded.
    * @return absl::string_view the decoded string.
    */
-  absl::string_view fromSymbol(Symbol symbol) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  absl::string_view fromSymbol(Symbol symbol) const ABSL_SHARED_LOCKS_REQUIRED(lock_);
 
   /**
    * Stages a new symbol for use. To be called after a successful insertion.
@@ -450,8 +459,18 @@ private:
    */
   void addTokensToEncoding(absl::string_view name, Encoding& encoding);
 
+  /**
+   * Adds the symbols of the tokens to symbols if all of them exist, taking lock_ shared.
+   *
+   * @param tokens The tokens of the name.
+   * @param symbols The symbols to append to.
+   * @return whether all symbols exist and were appended.
+   */
+  bool addExistingSymbols(const std::vector<absl::string_view>& tokens,
+                          std::vector<Symbol>& symbols);
+
   Symbol monotonicCounter() {
-    Thread::LockGuard lock(lock_);
+    absl::MutexLock lock(&lock_);
     return monotonic_counter_;
   }
 
@@ -475,6 +494,9 @@ private:
   // using an Envoy::IntervalSet.
   std::stack<Symbol> pool_ ABSL_GUARDED_BY(lock_);
   RecentLookups recent_lookups_ ABSL_GUARDED_BY(lock_);
+  // Lookups of names with existing symbols that were not recorded in recent_lookups_, as they were
+  // done with lock_ held shared.
+  std::atomic<uint64_t> shared_lookups_{0};
 };
 
 // Base class for holding the backing-storing for a StatName. The two derived
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <cstdint>
-#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -17,6 +16,7 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_set.h"
+#include "absl/functional/function_ref.h"
 #include "absl/strings/string_view.h"
 
 namespace Envoy {
@@ -99,10 +99,10 @@ private:
    * See DefaultTagRegexTester::produceTagsReverse in test/common/stats/stats_impl_test.cc.
    *
    * @param stat_name const std::string& the stat name.
-   * @param f std::function<void(const TagExtractorPtr&)> function to call for each extractor.
+   * @param f function to call for each extractor.
    */
   void forEachExtractorMatching(absl::string_view stat_name,
-                                std::function<void(const TagExtractorPtr&)> f) const;
+                                absl::FunctionRef<void(const TagExtractorPtr&)> f) const;
 
   std::vector<TagExtractorPtr> tag_extractors_without_prefix_;
 
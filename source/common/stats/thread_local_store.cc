@@ -821,13 +821,20 @@ ThreadLocalHistogramImpl::~ThreadLocalHistogramImpl() {
 void ThreadLocalHistogramImpl::recordValue(uint64_t value) {
   ASSERT(std::this_thread::get_id() == created_thread_id_);
   hist_insert_intscale(histograms_[current_active_], value, 0, 1);
+  has_values_[current_active_] = true;
   used_ = true;
 }
 
-void ThreadLocalHistogramImpl::merge(histogram_t* target) {
-  histogram_t** other_histogram = &histograms_[otherHistogramIndex()];
+bool ThreadLocalHistogramImpl::merge(histogram_t* target) {
+  const uint64_t other_index = otherHistogramIndex();
+  if (!has_values_[other_index]) {
+    return false;
+  }
+  histogram_t** other_histogram = &histograms_[other_index];
   hist_accumulate(target, other_histogram, 1);
   hist_clear(*other_histogram);
+  has_values_[other_index] = false;
+  return true;
 }
 
 ParentHistogramImpl::ParentHistogramImpl(StatName name, Histogram::Unit unit,
@@ -915,19 +922,30 @@ bool ParentHistogramImpl::hidden() const { return false; }
 void ParentHistogramImpl::merge() {
   Thread::ReleasableLockGuard lock(merge_lock_);
   if (merged_ || usedLockHeld()) {
-    hist_clear(interval_histogram_);
+    const bool interval_was_empty = interval_empty_;
+    if (!interval_was_empty) {
+      hist_clear(interval_histogram_);
+    }
     // Here we could copy all the pointers to TLS histograms in the tls_histogram_ list,
     // then release the lock before we do the actual merge. However it is not a big deal
     // because the tls_histogram merge is not that expensive as it is a single histogram
     // merge and adding TLS histograms is rare.
+    bool has_values = false;
     for (const TlsHistogramSharedPtr& tls_histogram : tls_histograms_) {
-      tls_histogram->merge(interval_histogram_);
+      has_values |= tls_histogram->merge(interval_histogram_);
     }
     // Since TLS merge is done, we can release the lock here.
     lock.release();
-    hist_accumulate(cumulative_histogram_, &interval_histogram_, 1);
-    cumulative_statistics_.refresh(cumulative_histogram_);
-    interval_statistics_.refresh(interval_histogram_);
+    interval_empty_ = !has_values;
+    // Most histograms record no values in most intervals, so only compute the statistics if
+    // they changed.
+    if (has_values) {
+      hist_accumulate(cumulative_histogram_, &interval_histogram_, 1);
+      cumulative_statistics_.refresh(cumulative_histogram_);
+    }
+    if (has_values || !interval_was_empty) {
+      interval_statistics_.refresh(interval_histogram_);
+    }
     merged_ = true;
   }
 }
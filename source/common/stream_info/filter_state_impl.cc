@@ -44,7 +44,7 @@ void FilterStateImpl::setData(absl::string_view data_name, std::shared_ptr<Objec
     // construction directly and this call will be a no-op.
     // So we only need to consider the case where ancestor is nullptr.
     maybeCreateParent(nullptr);
-    parent_->setData(data_name, data, state_type, life_span, stream_sharing);
+    parent_->setData(data_name, std::move(data), state_type, life_span, stream_sharing);
     return;
   }
   if (parent_ && parent_->hasDataWithName(data_name)) {
@@ -57,25 +57,25 @@ void FilterStateImpl::setData(absl::string_view data_name, std::shared_ptr<Objec
     // We have another object with same data_name. Check for mutability
     // violations namely: readonly data cannot be overwritten, mutable data
     // cannot be overwritten by readonly data.
-    const FilterStateImpl::FilterObject* current = it->second.get();
-    if (current->state_type_ == FilterState::StateType::ReadOnly) {
+    const FilterStateImpl::FilterObject& current = it->second;
+    if (current.state_type_ == FilterState::StateType::ReadOnly) {
       IS_ENVOY_BUG("FilterStateAccessViolation: FilterState::setData<T> called twice on same "
                    "ReadOnly state.");
       return;
     }
 
-    if (current->state_type_ != state_type) {
+    if (current.state_type_ != state_type) {
       IS_ENVOY_BUG("FilterStateAccessViolation: FilterState::setData<T> called twice with "
                    "different state types.");
       return;
     }
   }
 
-  std::unique_ptr<FilterStateImpl::FilterObject> filter_object(new FilterStateImpl::FilterObject());
-  filter_object->data_ = data;
-  filter_object->state_type_ = state_type;
-  filter_object->stream_sharing_ = stream_sharing;
-  data_storage_[data_name] = std::move(filter_object);
+  FilterStateImpl::FilterObject& filter_object = data_storage_[data_name];
+  filter_object.state_type_ = state_type;
+  filter_object.stream_sharing_ = stream_sharing;
+  // Last, as this may destroy the object set before.
+  filter_object.data_ = std::move(data);
 }
 
 bool FilterStateImpl::hasDataWithName(absl::string_view data_name) const {
@@ -93,12 +93,21 @@ FilterStateImpl::getDataReadOnlyGeneric(absl::string_view data_name) const {
     return nullptr;
   }
 
-  const FilterStateImpl::FilterObject* current = it->second.get();
-  return current->data_.get();
+  return it->second.data_.get();
 }
 
 FilterState::Object* FilterStateImpl::getDataMutableGeneric(absl::string_view data_name) {
-  return getDataSharedMutableGeneric(data_name).get();
+  const auto& it = data_storage_.find(data_name);
+
+  if (it == data_storage_.end()) {
+    if (parent_) {
+      return parent_->getDataMutableGeneric(data_name);
+    }
+    return nullptr;
+  }
+
+  // Unlike getDataSharedMutableGeneric(), this does not take a reference to the object.
+  return mutableData(it->second).get();
 }
 
 std::shared_ptr<FilterState::Object>
@@ -112,14 +121,7 @@ FilterStateImpl::getDataSharedMutableGeneric(absl::string_view data_name) {
     return nullptr;
   }
 
-  FilterStateImpl::FilterObject* current = it->second.get();
-  if (current->state_type_ == FilterState::StateType::ReadOnly) {
-    IS_ENVOY_BUG("FilterStateAccessViolation: FilterState accessed immutable data as mutable.");
-    // To reduce the chances of a crash, allow the mutation in this case instead of returning a
-    // nullptr.
-  }
-
-  return current->data_;
+  return mutableData(it->second);
 }
 
 bool FilterStateImpl::hasDataAtOrAboveLifeSpan(FilterState::LifeSpan life_span) const {
@@ -133,13 +135,13 @@ FilterState::ObjectsPtr FilterStateImpl::objectsSharedWithUpstreamConnection() c
   auto objects = parent_ ? parent_->objectsSharedWithUpstreamConnection()
                          : std::make_unique<FilterState::Objects>();
   for (const auto& [name, object] : data_storage_) {
-    switch (object->stream_sharing_) {
+    switch (object.stream_sharing_) {
     case StreamSharingMayImpactPooling::SharedWithUpstreamConnection:
-      objects->push_back({object->data_, object->state_type_, object->stream_sharing_, name});
+      objects->push_back({object.data_, object.state_type_, object.stream_sharing_, name});
       break;
     case StreamSharingMayImpactPooling::SharedWithUpstreamConnectionOnce:
       objects->push_back(
-          {object->data_, object->state_type_, StreamSharingMayImpactPooling::None, name});
+          {object.data_, object.state_type_, StreamSharingMayImpactPooling::None, name});
       break;
     default:
       break;
@@ -148,6 +150,16 @@ FilterState::ObjectsPtr FilterStateImpl::objectsSharedWithUpstreamConnection() c
   return objects;
 }
 
+const std::shared_ptr<FilterState::Object>&
+FilterStateImpl::mutableData(const FilterObject& filter_object) {
+  if (filter_object.state_type_ == FilterState::StateType::ReadOnly) {
+    IS_ENVOY_BUG("FilterStateAccessViolation: FilterState accessed immutable data as mutable.");
+    // To reduce the chances of a crash, allow the mutation in this case instead of returning a
+    // nullptr.
+  }
+  return filter_object.data_;
+}
+
 bool FilterStateImpl::hasDataWithNameInternally(absl::string_view data_name) const {
   return data_storage_.contains(data_name);
 }
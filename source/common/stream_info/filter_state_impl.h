@@ -50,11 +50,14 @@ public:
 private:
   // This only checks the local data_storage_ for data_name existence.
   bool hasDataWithNameInternally(absl::string_view data_name) const;
+  // Returns the data of the object, which is expected to be mutable.
+  static const std::shared_ptr<Object>& mutableData(const FilterObject& filter_object);
   void maybeCreateParent(FilterStateSharedPtr ancestor);
 
   FilterStateSharedPtr parent_;
   const FilterState::LifeSpan life_span_;
-  absl::flat_hash_map<std::string, std::unique_ptr<FilterObject>> data_storage_;
+  // The objects are stored in the map rather than allocated separately.
+  absl::flat_hash_map<std::string, FilterObject> data_storage_;
 };
 
 } // namespace StreamInfo
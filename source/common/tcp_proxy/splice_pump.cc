@@ -0,0 +1,211 @@
+#include "source/common/tcp_proxy/splice_pump.h"
+
+#include "envoy/common/platform.h"
+#include "envoy/event/dispatcher.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
+namespace Envoy {
+namespace TcpProxy {
+
+namespace {
+
+// The default capacity of a Linux pipe, and so the most data that is in flight in each direction.
+constexpr size_t PipeCapacity = 64 * 1024;
+// How much data a single file event moves in one direction before yielding to the event loop, so
+// that a pair of fast peers cannot starve other connections on the same worker.
+constexpr uint64_t MaxBytesPerEvent = 16 * PipeCapacity;
+
+} // namespace
+
+SplicePumpPtr SplicePump::create(Network::Connection& downstream, Network::Connection& upstream,
+                                 Callbacks& callbacks) {
+#if defined(__linux__)
+  OptRef<Network::IoHandle> downstream_handle = downstream.socketIoHandle();
+  OptRef<Network::IoHandle> upstream_handle = upstream.socketIoHandle();
+  if (!downstream_handle.has_value() || !upstream_handle.has_value() ||
+      !downstream_handle->isOpen() || !upstream_handle->isOpen()) {
+    return nullptr;
+  }
+  // splice() only supports moving stream socket data through a pipe for network sockets.
+  const auto& downstream_address = downstream.connectionInfoProvider().remoteAddress();
+  const auto& upstream_address = upstream.connectionInfoProvider().remoteAddress();
+  if (downstream_address == nullptr || upstream_address == nullptr ||
+      downstream_address->type() != Network::Address::Type::Ip ||
+      upstream_address->type() != Network::Address::Type::Ip) {
+    return nullptr;
+  }
+
+  SplicePumpPtr pump(new SplicePump(downstream.dispatcher(), downstream_handle->fdDoNotUse(),
+                                    upstream_handle->fdDoNotUse(), callbacks));
+  if (!pump->createPipe(pump->upstream_stream_) || !pump->createPipe(pump->downstream_stream_)) {
+    return nullptr;
+  }
+  return pump;
+#else
+  UNREFERENCED_PARAMETER(downstream);
+  UNREFERENCED_PARAMETER(upstream);
+  UNREFERENCED_PARAMETER(callbacks);
+  return nullptr;
+#endif
+}
+
+SplicePump::SplicePump(Event::Dispatcher& dispatcher, os_fd_t downstream_fd, os_fd_t upstream_fd,
+                       Callbacks& callbacks)
+    : callbacks_(callbacks), upstream_stream_(Direction::Upstream, downstream_fd, upstream_fd),
+      downstream_stream_(Direction::Downstream, upstream_fd, downstream_fd) {
+  // The connections keep their own file events for the same sockets. Since they are read
+  // disabled, those only watch for writability, which is harmless while their write buffers are
+  // empty.
+  downstream_event_ = dispatcher.createFileEvent(
+      downstream_fd,
+      [this](uint32_t events) {
+        onFileEvent(events, upstream_stream_, downstream_stream_);
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read | Event::FileReadyType::Write);
+  upstream_event_ = dispatcher.createFileEvent(
+      upstream_fd,
+      [this](uint32_t events) {
+        onFileEvent(events, downstream_stream_, upstream_stream_);
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read | Event::FileReadyType::Write);
+  upstream_stream_.source_event_ = downstream_event_.get();
+  downstream_stream_.source_event_ = upstream_event_.get();
+
+  // Data may have arrived before the pump existed. Start with one pass in each direction.
+  downstream_event_->activate(Event::FileReadyType::Read);
+  upstream_event_->activate(Event::FileReadyType::Read);
+}
+
+SplicePump::~SplicePump() {
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  for (Stream* stream : {&upstream_stream_, &downstream_stream_}) {
+    // Data still in the pipe is discarded; the pump is only destroyed when the connections close.
+    if (stream->pipe_read_ != INVALID_SOCKET) {
+      os_sys_calls.close(stream->pipe_read_);
+    }
+    if (stream->pipe_write_ != INVALID_SOCKET) {
+      os_sys_calls.close(stream->pipe_write_);
+    }
+  }
+}
+
+bool SplicePump::createPipe(Stream& stream) {
+#if defined(__linux__)
+  int fds[2];
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().pipe2(fds, O_NONBLOCK | O_CLOEXEC);
+  if (result.return_value_ != 0) {
+    ENVOY_LOG(debug, "failed to create splice pipe: {}", errorDetails(result.errno_));
+    return false;
+  }
+  stream.pipe_read_ = fds[0];
+  stream.pipe_write_ = fds[1];
+  return true;
+#else
+  UNREFERENCED_PARAMETER(stream);
+  return false;
+#endif
+}
+
+void SplicePump::onFileEvent(uint32_t events, Stream& readable, Stream& writable) {
+  // Write readiness is handled first: draining a pipe may be what lets the other direction of the
+  // same socket make progress again.
+  if (events & Event::FileReadyType::Write) {
+    writable.destination_writable_ = true;
+    if (!pump(writable)) {
+      return;
+    }
+  }
+  if (events & Event::FileReadyType::Read) {
+    readable.source_readable_ = true;
+    pump(readable);
+  }
+}
+
+bool SplicePump::pump(Stream& stream) {
+#if defined(__linux__)
+  auto& os_sys_calls = Api::LinuxOsSysCallsSingleton::get();
+  uint64_t bytes_moved = 0;
+  while (!failed_) {
+    while (stream.in_pipe_ > 0) {
+      if (!stream.destination_writable_) {
+        return true;
+      }
+      const Api::SysCallSizeResult result =
+          os_sys_calls.splice(stream.pipe_read_, nullptr, stream.destination_, nullptr,
+                              stream.in_pipe_, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+      if (result.return_value_ < 0) {
+        if (result.errno_ == SOCKET_ERROR_AGAIN) {
+          stream.destination_writable_ = false;
+          return true;
+        }
+        return fail(stream, result.errno_);
+      }
+      stream.in_pipe_ -= result.return_value_;
+      callbacks_.onSpliceBytesWritten(stream.direction_, result.return_value_);
+    }
+
+    if (stream.source_closed_) {
+      if (stream.end_stream_raised_) {
+        return true;
+      }
+      stream.end_stream_raised_ = true;
+      callbacks_.onSpliceEndStream(stream.direction_);
+      return false;
+    }
+    if (!stream.source_readable_) {
+      return true;
+    }
+    if (bytes_moved >= MaxBytesPerEvent) {
+      // The source is still readable; resume on the next event loop iteration.
+      stream.source_event_->activate(Event::FileReadyType::Read);
+      return true;
+    }
+
+    const Api::SysCallSizeResult result =
+        os_sys_calls.splice(stream.source_, nullptr, stream.pipe_write_, nullptr, PipeCapacity,
+                            SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (result.return_value_ < 0) {
+      if (result.errno_ == SOCKET_ERROR_AGAIN) {
+        stream.source_readable_ = false;
+        return true;
+      }
+      return fail(stream, result.errno_);
+    }
+    if (result.return_value_ == 0) {
+      stream.source_closed_ = true;
+      continue;
+    }
+    stream.in_pipe_ += result.return_value_;
+    bytes_moved += result.return_value_;
+    callbacks_.onSpliceBytesRead(stream.direction_, result.return_value_);
+  }
+  return false;
+#else
+  UNREFERENCED_PARAMETER(stream);
+  PANIC("not reached");
+#endif
+}
+
+bool SplicePump::fail(Stream& stream, int error) {
+  ENVOY_LOG(debug, "splice failed: {}", errorDetails(error));
+  failed_ = true;
+  callbacks_.onSpliceError(stream.direction_, error);
+  return false;
+}
+
+} // namespace TcpProxy
+} // namespace Envoy
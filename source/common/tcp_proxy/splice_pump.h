@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/common/platform.h"
+#include "envoy/event/file_event.h"
+#include "envoy/network/connection.h"
+
+#include "source/common/common/logger.h"
+
+namespace Envoy {
+namespace TcpProxy {
+
+class SplicePump;
+using SplicePumpPtr = std::unique_ptr<SplicePump>;
+
+/**
+ * Moves the payload between a downstream and an upstream TCP connection with splice(2) through
+ * a pipe per direction, so that it is never copied to user space.
+ *
+ * The pump reads from and writes to the sockets directly: the owner must keep both connections
+ * read disabled while the pump exists, and must make sure that nothing is pending in their write
+ * buffers when it is created. Data is read from a socket only once everything previously read
+ * from it has been written to the other socket, so at most a pipe's worth of data is in flight
+ * in each direction and a peer that stops reading stops the pump from reading from the other
+ * peer.
+ */
+class SplicePump : Logger::Loggable<Logger::Id::filter> {
+public:
+  enum class Direction {
+    // From the downstream connection to the upstream connection.
+    Upstream,
+    // From the upstream connection to the downstream connection.
+    Downstream,
+  };
+
+  class Callbacks {
+  public:
+    virtual ~Callbacks() = default;
+
+    /**
+     * Called when data has been read from the source socket of a direction.
+     */
+    virtual void onSpliceBytesRead(Direction direction, uint64_t bytes) PURE;
+
+    /**
+     * Called when data has been written to the destination socket of a direction.
+     */
+    virtual void onSpliceBytesWritten(Direction direction, uint64_t bytes) PURE;
+
+    /**
+     * Called when the source of a direction has been half closed and all data read from it has been
+     * written to the destination. The pump may be destroyed from within this callback.
+     */
+    virtual void onSpliceEndStream(Direction direction) PURE;
+
+    /**
+     * Called when moving data failed. The pump may be destroyed from within this callback, and
+     * does not move any further data otherwise.
+     */
+    virtual void onSpliceError(Direction direction, int error) PURE;
+  };
+
+  /**
+   * @return a pump moving data between the given connections, or nullptr if the platform or the
+   *         connections do not support splicing.
+   */
+  static SplicePumpPtr create(Network::Connection& downstream, Network::Connection& upstream,
+                              Callbacks& callbacks);
+
+  ~SplicePump();
+
+private:
+  struct Stream {
+    Stream(Direction direction, os_fd_t source, os_fd_t destination)
+        : direction_(direction), source_(source), destination_(destination) {}
+
+    const Direction direction_;
+    const os_fd_t source_;
+    const os_fd_t destination_;
+    // The file event of the source socket.
+    Event::FileEvent* source_event_{};
+    os_fd_t pipe_read_{INVALID_SOCKET};
+    os_fd_t pipe_write_{INVALID_SOCKET};
+    // Bytes read from the source that have not been written to the destination yet.
+    uint64_t in_pipe_{};
+    // Edge triggered readiness of the source and the destination.
+    bool source_readable_{true};
+    bool destination_writable_{true};
+    bool source_closed_{};
+    bool end_stream_raised_{};
+  };
+
+  SplicePump(Event::Dispatcher& dispatcher, os_fd_t downstream_fd, os_fd_t upstream_fd,
+             Callbacks& callbacks);
+
+  bool createPipe(Stream& stream);
+  void onFileEvent(uint32_t events, Stream& readable, Stream& writable);
+  // Move data until either side of the stream would block. Returns false if a callback that may
+  // destroy the pump has been invoked.
+  bool pump(Stream& stream);
+  bool fail(Stream& stream, int error);
+
+  Callbacks& callbacks_;
+  Stream upstream_stream_;
+  Stream downstream_stream_;
+  Event::FileEventPtr downstream_event_;
+  Event::FileEventPtr upstream_event_;
+  bool failed_{};
+};
+
+} // namespace TcpProxy
+} // namespace Envoy
@@ -114,7 +114,7 @@ Config::SharedConfig::SharedConfig(
     const envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy& config,
     Server::Configuration::FactoryContext& context)
     : stats_scope_(context.scope().createScope(fmt::format("tcp.{}", config.stat_prefix()))),
-      stats_(generateStats(*stats_scope_)) {
+      stats_(generateStats(*stats_scope_)), use_splice_(config.use_splice()) {
   if (config.has_idle_timeout()) {
     const uint64_t timeout = DurationUtil::durationToMilliseconds(config.idle_timeout());
     if (timeout > 0) {
@@ -188,7 +188,8 @@ Config::Config(const envoy::extensions::filters::network::tcp_proxy::v3::TcpProx
       upstream_drain_manager_slot_(context.serverFactoryContext().threadLocal().allocateSlot()),
       shared_config_(std::make_shared<SharedConfig>(config, context)),
       random_generator_(context.serverFactoryContext().api().randomGenerator()),
-      regex_engine_(context.serverFactoryContext().regexEngine()) {
+      regex_engine_(context.serverFactoryContext().regexEngine()),
+      drain_decision_(config.close_on_drain() ? &context.drainDecision() : nullptr) {
   upstream_drain_manager_slot_->set([](Event::Dispatcher&) {
     ThreadLocal::ThreadLocalObjectSharedPtr drain_manager =
         std::make_shared<UpstreamDrainManager>();
@@ -703,6 +704,7 @@ void Filter::onGenericPoolReady(StreamInfo::StreamInfo* info,
   if (info) {
     upstream_info.setUpstreamFilterState(info->filterState());
   }
+  maybeStartSplice();
 } // namespace TcpProxy
 
 const Router::MetadataMatchCriteria* Filter::metadataMatchCriteria() {
@@ -886,6 +888,11 @@ void Filter::onDownstreamEvent(Network::ConnectionEvent event) {
   ENVOY_CONN_LOG(trace, "on downstream event {}, has upstream = {}", read_callbacks_->connection(),
                  static_cast<int>(event), upstream_ != nullptr);
 
+  if (event == Network::ConnectionEvent::LocalClose ||
+      event == Network::ConnectionEvent::RemoteClose) {
+    splice_pump_.reset();
+  }
+
   if (upstream_) {
     Tcp::ConnectionPool::ConnectionDataPtr conn_data(upstream_->onDownstreamEvent(event));
     if (conn_data != nullptr &&
@@ -918,6 +925,9 @@ void Filter::onUpstreamData(Buffer::Instance& data, bool end_stream) {
   read_callbacks_->connection().write(data, end_stream);
   ASSERT(0 == data.length());
   resetIdleTimer(); // TODO(ggreenway) PERF: do we need to reset timer on both send and receive?
+  if (config_->drainDecision() != nullptr && config_->drainDecision()->drainClose()) {
+    onDrainClose();
+  }
 }
 
 void Filter::onUpstreamEvent(Network::ConnectionEvent event) {
@@ -931,6 +941,7 @@ void Filter::onUpstreamEvent(Network::ConnectionEvent event) {
 
   if (event == Network::ConnectionEvent::RemoteClose ||
       event == Network::ConnectionEvent::LocalClose) {
+    splice_pump_.reset();
     if (Runtime::runtimeFeatureEnabled(
             "envoy.restart_features.upstream_http_filters_with_tcp_proxy")) {
       read_callbacks_->connection().dispatcher().deferredDelete(std::move(upstream_));
@@ -1046,6 +1057,87 @@ void Filter::onUpstreamConnection() {
   }
 }
 
+void Filter::maybeStartSplice() {
+  // The pump is only created when the transport sockets of both connections pass the payload
+  // through unchanged, see Network::TransportSocket::passesRawBytesThrough().
+  if (!config_->useSplice() || receive_before_connect_ || upstream_ == nullptr ||
+      read_callbacks_->connection().state() != Network::Connection::State::Open ||
+      read_callbacks_->connection().ssl() != nullptr) {
+    return;
+  }
+  OptRef<Network::Connection> upstream_connection = upstream_->tcpConnection();
+  if (!upstream_connection.has_value() ||
+      upstream_connection->state() != Network::Connection::State::Open ||
+      upstream_connection->ssl() != nullptr) {
+    return;
+  }
+  // Any payload proxied so far went through the connection buffers, and spliced data must not
+  // overtake it.
+  if (getStreamInfo().getDownstreamBytesMeter()->wireBytesReceived() != 0 ||
+      getStreamInfo().getUpstreamBytesMeter()->wireBytesReceived() != 0) {
+    return;
+  }
+
+  splice_pump_ = SplicePump::create(read_callbacks_->connection(), *upstream_connection, *this);
+  if (splice_pump_ == nullptr) {
+    return;
+  }
+  ENVOY_CONN_LOG(debug, "splicing data between downstream and upstream",
+                 read_callbacks_->connection());
+  config_->stats().splice_total_.inc();
+  // The pump reads from the sockets from now on.
+  read_callbacks_->connection().readDisable(true);
+  upstream_->readDisable(true);
+}
+
+void Filter::onSpliceBytesRead(SplicePump::Direction direction, uint64_t bytes) {
+  if (direction == SplicePump::Direction::Upstream) {
+    config_->stats().downstream_cx_rx_bytes_total_.add(bytes);
+    getStreamInfo().getDownstreamBytesMeter()->addWireBytesReceived(bytes);
+  } else {
+    read_callbacks_->upstreamHost()->cluster().trafficStats()->upstream_cx_rx_bytes_total_.add(
+        bytes);
+    getStreamInfo().getUpstreamBytesMeter()->addWireBytesReceived(bytes);
+  }
+  resetIdleTimer();
+}
+
+void Filter::onSpliceBytesWritten(SplicePump::Direction direction, uint64_t bytes) {
+  if (direction == SplicePump::Direction::Upstream) {
+    read_callbacks_->upstreamHost()->cluster().trafficStats()->upstream_cx_tx_bytes_total_.add(
+        bytes);
+    getStreamInfo().getUpstreamBytesMeter()->addWireBytesSent(bytes);
+  } else {
+    config_->stats().downstream_cx_tx_bytes_total_.add(bytes);
+    getStreamInfo().getDownstreamBytesMeter()->addWireBytesSent(bytes);
+  }
+  resetIdleTimer();
+}
+
+void Filter::onSpliceEndStream(SplicePump::Direction direction) {
+  ENVOY_CONN_LOG(trace, "spliced {} half closed", read_callbacks_->connection(),
+                 direction == SplicePump::Direction::Upstream ? "downstream" : "upstream");
+  // Half close the other side the same way the buffered path does.
+  Buffer::OwnedImpl empty;
+  if (direction == SplicePump::Direction::Upstream) {
+    upstream_->encodeData(empty, true);
+  } else {
+    read_callbacks_->connection().write(empty, true);
+  }
+  // The connections never see the half close of their peers, as they don't read from their
+  // sockets, so close once both directions are done.
+  if (++splice_end_streams_ == 2 &&
+      read_callbacks_->connection().state() == Network::Connection::State::Open) {
+    read_callbacks_->connection().close(Network::ConnectionCloseType::FlushWrite);
+  }
+}
+
+void Filter::onSpliceError(SplicePump::Direction, int) {
+  config_->stats().splice_failed_.inc();
+  read_callbacks_->connection().close(Network::ConnectionCloseType::NoFlush,
+                                      StreamInfo::LocalCloseReasons::get().TcpProxySpliceFailed);
+}
+
 void Filter::onIdleTimeout() {
   ENVOY_CONN_LOG(debug, "Session timed out", read_callbacks_->connection());
   config_->stats().idle_timeout_.inc();
@@ -1064,6 +1156,14 @@ void Filter::onMaxDownstreamConnectionDuration() {
       StreamInfo::LocalCloseReasons::get().MaxConnectionDurationReached);
 }
 
+void Filter::onDrainClose() {
+  ENVOY_CONN_LOG(debug, "closing draining connection", read_callbacks_->connection());
+  config_->stats().downstream_cx_drain_close_.inc();
+  // The data which was just received from the upstream is flushed to the downstream.
+  read_callbacks_->connection().close(Network::ConnectionCloseType::FlushWrite,
+                                      StreamInfo::LocalCloseReasons::get().TcpProxyDrainClose);
+}
+
 void Filter::onAccessLogFlushInterval() {
   flushAccessLog(AccessLog::AccessLogType::TcpPeriodic);
   const SystemTime now = read_callbacks_->connection().dispatcher().timeSource().systemTime();
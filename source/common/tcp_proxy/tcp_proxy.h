@@ -13,6 +13,7 @@
 #include "envoy/http/codec.h"
 #include "envoy/http/header_evaluator.h"
 #include "envoy/network/connection.h"
+#include "envoy/network/drain_decision.h"
 #include "envoy/network/filter.h"
 #include "envoy/runtime/runtime.h"
 #include "envoy/server/filter_config.h"
@@ -33,6 +34,7 @@
 #include "source/common/network/hash_policy.h"
 #include "source/common/network/utility.h"
 #include "source/common/stream_info/stream_info_impl.h"
+#include "source/common/tcp_proxy/splice_pump.h"
 #include "source/common/tcp_proxy/upstream.h"
 #include "source/common/upstream/load_balancer_context_base.h"
 #include "source/common/upstream/od_cds_api_impl.h"
@@ -58,6 +60,7 @@ constexpr absl::string_view ReceiveBeforeConnectKey = "envoy.tcp_proxy.receive_b
  * All tcp proxy stats. @see stats_macros.h
  */
 #define ALL_TCP_PROXY_STATS(COUNTER, GAUGE)                                                        \
+  COUNTER(downstream_cx_drain_close)                                                               \
   COUNTER(downstream_cx_no_route)                                                                  \
   COUNTER(downstream_cx_rx_bytes_total)                                                            \
   COUNTER(downstream_cx_total)                                                                     \
@@ -67,6 +70,8 @@ constexpr absl::string_view ReceiveBeforeConnectKey = "envoy.tcp_proxy.receive_b
   COUNTER(early_data_received_count_total)                                                         \
   COUNTER(idle_timeout)                                                                            \
   COUNTER(max_downstream_connection_duration)                                                      \
+  COUNTER(splice_failed)                                                                           \
+  COUNTER(splice_total)                                                                            \
   COUNTER(upstream_flush_total)                                                                    \
   GAUGE(downstream_cx_rx_bytes_buffered, Accumulate)                                               \
   GAUGE(downstream_cx_tx_bytes_buffered, Accumulate)                                               \
@@ -254,6 +259,7 @@ public:
       }
     }
     const BackOffStrategyPtr& backoffStrategy() const { return backoff_strategy_; };
+    bool useSplice() const { return use_splice_; }
 
   private:
     static TcpProxyStats generateStats(Stats::Scope& scope);
@@ -263,6 +269,7 @@ public:
     const Stats::ScopeSharedPtr stats_scope_;
 
     const TcpProxyStats stats_;
+    const bool use_splice_;
     bool flush_access_log_on_connected_;
     absl::optional<std::chrono::milliseconds> idle_timeout_;
     absl::optional<std::chrono::milliseconds> max_downstream_connection_duration_;
@@ -325,6 +332,9 @@ public:
   bool flushAccessLogOnConnected() const { return shared_config_->flushAccessLogOnConnected(); }
   Regex::Engine& regexEngine() const { return regex_engine_; }
   const BackOffStrategyPtr& backoffStrategy() const { return shared_config_->backoffStrategy(); };
+  bool useSplice() const { return shared_config_->useSplice(); }
+  // Return nullptr if connections are not closed when the listener drains.
+  const Network::DrainDecision* drainDecision() const { return drain_decision_; }
 
 private:
   struct SimpleRouteImpl : public Route {
@@ -378,6 +388,7 @@ private:
   Random::RandomGenerator& random_generator_;
   std::unique_ptr<const Network::HashPolicyImpl> hash_policy_;
   Regex::Engine& regex_engine_; // Static lifetime object, safe to store as a reference
+  const Network::DrainDecision* drain_decision_{};
 };
 
 using ConfigSharedPtr = std::shared_ptr<Config>;
@@ -404,7 +415,8 @@ private:
 class Filter : public Network::ReadFilter,
                public Upstream::LoadBalancerContextBase,
                protected Logger::Loggable<Logger::Id::filter>,
-               public GenericConnectionPoolCallbacks {
+               public GenericConnectionPoolCallbacks,
+               public SplicePump::Callbacks {
 public:
   Filter(ConfigSharedPtr config, Upstream::ClusterManager& cluster_manager);
   ~Filter() override;
@@ -424,6 +436,12 @@ public:
                             absl::string_view failure_reason,
                             Upstream::HostDescriptionConstSharedPtr host) override;
 
+  // SplicePump::Callbacks
+  void onSpliceBytesRead(SplicePump::Direction direction, uint64_t bytes) override;
+  void onSpliceBytesWritten(SplicePump::Direction direction, uint64_t bytes) override;
+  void onSpliceEndStream(SplicePump::Direction direction) override;
+  void onSpliceError(SplicePump::Direction direction, int error) override;
+
   // Upstream::LoadBalancerContext
   const Router::MetadataMatchCriteria* metadataMatchCriteria() override;
   absl::optional<uint64_t> computeHashKey() override {
@@ -630,10 +648,12 @@ protected:
   void onUpstreamData(Buffer::Instance& data, bool end_stream);
   void onUpstreamEvent(Network::ConnectionEvent event);
   void onUpstreamConnection();
+  void maybeStartSplice();
   void onIdleTimeout();
   void resetIdleTimer();
   void disableIdleTimer();
   void onMaxDownstreamConnectionDuration();
+  void onDrainClose();
   void onAccessLogFlushInterval();
   void resetAccessLogFlushTimer();
   void flushAccessLog(AccessLog::AccessLogType access_log_type);
@@ -685,6 +705,10 @@ protected:
   bool early_data_end_stream_{false};
   Buffer::OwnedImpl early_data_buffer_{};
   HttpStreamDecoderFilterCallbacks upstream_decoder_filter_callbacks_;
+  // Moves the payload between the sockets when splicing is enabled. It reads from and writes to
+  // the sockets of both connections, so it is declared last to be destroyed before them.
+  SplicePumpPtr splice_pump_;
+  uint32_t splice_end_streams_{};
 };
 
 // This class deals with an upstream connection that needs to finish flushing, when the downstream
@@ -34,6 +34,7 @@
 #include "source/common/tls/stats.h"
 #include "source/common/tls/utility.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
 #include "openssl/ssl.h"
 #include "openssl/x509v3.h"
@@ -52,9 +53,65 @@ DefaultCertValidator::DefaultCertValidator(
     allow_untrusted_certificate_ = config_->trustChainVerification() ==
                                    envoy::extensions::transport_sockets::tls::v3::
                                        CertificateValidationContext::ACCEPT_UNTRUSTED;
+    if (config_->verifiedCertificateCacheSize() > 0) {
+      verified_certificate_cache_ = std::make_unique<VerifiedCertificateCache>(
+          config_->verifiedCertificateCacheSize(), config_->verifiedCertificateCacheMaxAge(),
+          context_.timeSource());
+    }
   }
 };
 
+std::string VerifiedCertificateCache::key(STACK_OF(X509)& cert_chain, bool is_server) {
+  std::string key(1, is_server ? 's' : 'c');
+  for (X509* cert : &cert_chain) {
+    uint8_t fingerprint[SHA256_DIGEST_LENGTH];
+    unsigned int fingerprint_len;
+    RELEASE_ASSERT(X509_digest(cert, EVP_sha256(), fingerprint, &fingerprint_len) == 1, "");
+    key.append(reinterpret_cast<const char*>(fingerprint), fingerprint_len);
+  }
+  return key;
+}
+
+bool VerifiedCertificateCache::contains(const std::string& key) {
+  const SystemTime now = time_source_.systemTime();
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+  if (it->second <= now) {
+    entries_.erase(it);
+    return false;
+  }
+  return true;
+}
+
+void VerifiedCertificateCache::insert(std::string key, STACK_OF(X509)& cert_chain) {
+  const SystemTime now = time_source_.systemTime();
+  SystemTime expiration = now + max_age_;
+  for (const X509* cert : &cert_chain) {
+    expiration = std::min(expiration, Utility::getExpirationTime(*cert));
+  }
+  if (expiration <= now) {
+    // The chain was only accepted because expired certificates are allowed.
+    return;
+  }
+
+  absl::MutexLock lock(&mutex_);
+  if (entries_.size() >= max_entries_) {
+    absl::erase_if(entries_, [now](const auto& entry) { return entry.second <= now; });
+    if (entries_.size() >= max_entries_) {
+      entries_.erase(entries_.begin());
+    }
+  }
+  entries_[std::move(key)] = expiration;
+}
+
+size_t VerifiedCertificateCache::size() {
+  absl::MutexLock lock(&mutex_);
+  return entries_.size();
+}
+
 absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_CTX*> contexts,
                                                                 bool provides_certificates) {
 
@@ -72,6 +129,15 @@ absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_
     }
   }
 
+  // All the certificates of the context verify peers against one trust store, so that the trusted
+  // CAs and CRLs are loaded once rather than once per certificate, which adds up with many SNI
+  // certificates.
+  X509_STORE* store = contexts.empty() ? nullptr : SSL_CTX_get_cert_store(contexts.front());
+  for (size_t i = 1; i < contexts.size(); i++) {
+    X509_STORE_up_ref(store);
+    SSL_CTX_set_cert_store(contexts[i], store);
+  }
+
   if (config_ != nullptr && !config_->caCert().empty() && !provides_certificates) {
     ca_file_path_ = config_->caCertPath();
     bssl::UniquePtr<BIO> bio(
@@ -85,8 +151,7 @@ absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_
           absl::StrCat("Failed to load trusted CA certificates from ", config_->caCertPath()));
     }
 
-    for (auto& ctx : contexts) {
-      X509_STORE* store = SSL_CTX_get_cert_store(ctx);
+    if (store != nullptr) {
       X509_STORE_set_flags(store, X509_V_FLAG_PARTIAL_CHAIN);
       bool has_crl = false;
       for (const X509_INFO* item : list.get()) {
@@ -140,8 +205,7 @@ absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_
           absl::StrCat("Failed to load CRL from ", config_->certificateRevocationListPath()));
     }
 
-    for (auto& ctx : contexts) {
-      X509_STORE* store = SSL_CTX_get_cert_store(ctx);
+    if (store != nullptr) {
       X509_STORE_set_flags(store, X509_V_FLAG_PARTIAL_CHAIN);
       for (const X509_INFO* item : list.get()) {
         if (item->crl) {
@@ -308,6 +372,18 @@ ValidationResults DefaultCertValidator::doVerifyCertChain(
     return {ValidationResults::ValidationStatus::Failed,
             Envoy::Ssl::ClientValidationStatus::NoClientCertificate, absl::nullopt, error};
   }
+  // The verification of a chain can only be remembered if it does not depend on the connection.
+  std::string cache_key;
+  if (verified_certificate_cache_ != nullptr && verify_trusted_ca_ && !auto_sni_san_match_ &&
+      (transport_socket_options == nullptr ||
+       transport_socket_options->verifySubjectAltNameListOverride().empty())) {
+    cache_key = VerifiedCertificateCache::key(cert_chain, is_server);
+    if (verified_certificate_cache_->contains(cache_key)) {
+      stats_.verified_cert_cache_hit_.inc();
+      return {ValidationResults::ValidationStatus::Successful,
+              Envoy::Ssl::ClientValidationStatus::Validated, absl::nullopt, absl::nullopt};
+    }
+  }
   Envoy::Ssl::ClientValidationStatus detailed_status =
       Envoy::Ssl::ClientValidationStatus::NotValidated;
   X509* leaf_cert = sk_X509_value(&cert_chain, 0);
@@ -354,6 +430,10 @@ ValidationResults DefaultCertValidator::doVerifyCertChain(
   const bool succeeded =
       verifyCertAndUpdateStatus(leaf_cert, host_name, transport_socket_options.get(),
                                 detailed_status, &error_details, &tls_alert);
+  if (succeeded && !cache_key.empty() &&
+      detailed_status == Envoy::Ssl::ClientValidationStatus::Validated) {
+    verified_certificate_cache_->insert(std::move(cache_key), cert_chain);
+  }
   return succeeded ? ValidationResults{ValidationResults::ValidationStatus::Successful,
                                        detailed_status, absl::nullopt, absl::nullopt}
                    : ValidationResults{ValidationResults::ValidationStatus::Failed, detailed_status,
@@ -515,6 +595,40 @@ absl::Status DefaultCertValidator::addClientValidationContext(SSL_CTX* ctx,
     return absl::OkStatus();
   }
 
+  // The CA names are parsed once, and copied to the SSL_CTX of each certificate.
+  if (client_ca_names_ == nullptr) {
+    RETURN_IF_NOT_OK(loadClientCaNames());
+  }
+  bssl::UniquePtr<STACK_OF(X509_NAME)> list(sk_X509_NAME_new_null());
+  RELEASE_ASSERT(list != nullptr, "");
+  for (X509_NAME* name : client_ca_names_.get()) {
+    bssl::UniquePtr<X509_NAME> name_dup(X509_NAME_dup(name));
+    if (name_dup == nullptr || !sk_X509_NAME_push(list.get(), name_dup.release())) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Failed to load trusted client CA certificates from ", config_->caCertPath()));
+    }
+  }
+  SSL_CTX_set_client_CA_list(ctx, list.release());
+
+  if (require_client_cert) {
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT, nullptr);
+  }
+  // Set the verify_depth
+  if (config_->maxVerifyDepth().has_value()) {
+    uint32_t max_verify_depth = std::min(config_->maxVerifyDepth().value(), uint32_t{INT_MAX});
+#if BORINGSSL_API_VERSION >= 29
+    // Older BoringSSLs behave like OpenSSL 1.0.x and exclude the leaf from the
+    // depth but include the trust anchor. Newer BoringSSLs match OpenSSL 1.1.x
+    // and later in excluding both the leaf and trust anchor. `maxVerifyDepth`
+    // documents the older behavior, so adjust the value to match.
+    max_verify_depth = max_verify_depth > 0 ? max_verify_depth - 1 : 0;
+#endif
+    SSL_CTX_set_verify_depth(ctx, static_cast<int>(max_verify_depth));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status DefaultCertValidator::loadClientCaNames() {
   bssl::UniquePtr<BIO> bio(
       BIO_new_mem_buf(const_cast<char*>(config_->caCert().data()), config_->caCert().size()));
   RELEASE_ASSERT(bio != nullptr, "");
@@ -554,23 +668,7 @@ absl::Status DefaultCertValidator::addClientValidationContext(SSL_CTX* ctx,
     return absl::InvalidArgumentError(
         absl::StrCat("Failed to load trusted client CA certificates from ", config_->caCertPath()));
   }
-  SSL_CTX_set_client_CA_list(ctx, list.release());
-
-  if (require_client_cert) {
-    SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT, nullptr);
-  }
-  // Set the verify_depth
-  if (config_->maxVerifyDepth().has_value()) {
-    uint32_t max_verify_depth = std::min(config_->maxVerifyDepth().value(), uint32_t{INT_MAX});
-#if BORINGSSL_API_VERSION >= 29
-    // Older BoringSSLs behave like OpenSSL 1.0.x and exclude the leaf from the
-    // depth but include the trust anchor. Newer BoringSSLs match OpenSSL 1.1.x
-    // and later in excluding both the leaf and trust anchor. `maxVerifyDepth`
-    // documents the older behavior, so adjust the value to match.
-    max_verify_depth = max_verify_depth > 0 ? max_verify_depth - 1 : 0;
-#endif
-    SSL_CTX_set_verify_depth(ctx, static_cast<int>(max_verify_depth));
-  }
+  client_ca_names_ = std::move(list);
   return absl::OkStatus();
 }
 
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "envoy/common/pure.h"
+#include "envoy/common/time.h"
 #include "envoy/network/transport_socket.h"
 #include "envoy/registry/registry.h"
 #include "envoy/ssl/context.h"
@@ -23,6 +24,7 @@
 #include "source/common/tls/cert_validator/san_matcher.h"
 #include "source/common/tls/stats.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
 #include "openssl/ssl.h"
 #include "openssl/x509v3.h"
@@ -32,6 +34,43 @@ namespace Extensions {
 namespace TransportSockets {
 namespace Tls {
 
+/**
+ * The peer certificate chains which passed verification, until they expire. Shared by the workers
+ * using the TLS context.
+ */
+class VerifiedCertificateCache {
+public:
+  VerifiedCertificateCache(uint32_t max_entries, std::chrono::milliseconds max_age,
+                           TimeSource& time_source)
+      : max_entries_(max_entries), max_age_(max_age), time_source_(time_source) {}
+
+  /**
+   * @return the key of a certificate chain, made of the SHA-256 fingerprints of its certificates.
+   */
+  static std::string key(STACK_OF(X509)& cert_chain, bool is_server);
+
+  /**
+   * @return whether the certificate chain with the key passed verification and did not expire.
+   */
+  bool contains(const std::string& key) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  /**
+   * Remembers that the certificate chain passed verification, until `max_age` has passed or any of
+   * its certificates expires.
+   */
+  void insert(std::string key, STACK_OF(X509)& cert_chain) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  size_t size() ABSL_LOCKS_EXCLUDED(mutex_);
+
+private:
+  const uint32_t max_entries_;
+  const std::chrono::milliseconds max_age_;
+  TimeSource& time_source_;
+  absl::Mutex mutex_;
+  // The expiration time of the verification of each chain.
+  absl::flat_hash_map<std::string, SystemTime> entries_ ABSL_GUARDED_BY(mutex_);
+};
+
 class DefaultCertValidator : public CertValidator, Logger::Loggable<Logger::Id::connection> {
 public:
   DefaultCertValidator(const Envoy::Ssl::CertificateValidationContextConfig* config,
@@ -104,6 +143,8 @@ public:
                                   const std::vector<SanMatcherPtr>& subject_alt_name_matchers);
 
 private:
+  absl::Status loadClientCaNames();
+
   bool verifyCertAndUpdateStatus(X509* leaf_cert, absl::string_view sni,
                                  const Network::TransportSocketOptions* transport_socket_options,
                                  Envoy::Ssl::ClientValidationStatus& detailed_status,
@@ -114,6 +155,7 @@ private:
   Server::Configuration::CommonFactoryContext& context_;
 
   bssl::UniquePtr<X509> ca_cert_;
+  bssl::UniquePtr<STACK_OF(X509_NAME)> client_ca_names_;
   std::string ca_file_path_;
   std::vector<SanMatcherPtr> subject_alt_name_matchers_;
   std::vector<std::vector<uint8_t>> verify_certificate_hash_list_;
@@ -121,6 +163,7 @@ private:
   bool allow_untrusted_certificate_{false};
   bool verify_trusted_ca_{false};
   const bool auto_sni_san_match_{false};
+  std::unique_ptr<VerifiedCertificateCache> verified_certificate_cache_;
 };
 
 DECLARE_FACTORY(DefaultCertValidatorFactory);
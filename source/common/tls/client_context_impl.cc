@@ -46,10 +46,11 @@ namespace Tls {
 
 absl::StatusOr<std::unique_ptr<ClientContextImpl>>
 ClientContextImpl::create(Stats::Scope& scope, const Envoy::Ssl::ClientContextConfig& config,
-                          Server::Configuration::CommonFactoryContext& factory_context) {
+                          Server::Configuration::CommonFactoryContext& factory_context,
+                          ClientSessionCacheSharedPtr session_cache) {
   absl::Status creation_status = absl::OkStatus();
-  auto ret = std::unique_ptr<ClientContextImpl>(
-      new ClientContextImpl(scope, config, factory_context, creation_status));
+  auto ret = std::unique_ptr<ClientContextImpl>(new ClientContextImpl(
+      scope, config, factory_context, std::move(session_cache), creation_status));
   RETURN_IF_NOT_OK(creation_status);
   return ret;
 }
@@ -57,13 +58,18 @@ ClientContextImpl::create(Stats::Scope& scope, const Envoy::Ssl::ClientContextCo
 ClientContextImpl::ClientContextImpl(Stats::Scope& scope,
                                      const Envoy::Ssl::ClientContextConfig& config,
                                      Server::Configuration::CommonFactoryContext& factory_context,
+                                     ClientSessionCacheSharedPtr session_cache,
                                      absl::Status& creation_status)
     : ContextImpl(scope, config, factory_context, nullptr /* additional_init */, creation_status),
       server_name_indication_(config.serverNameIndication()),
       auto_host_sni_(config.autoHostServerNameIndication()),
       allow_renegotiation_(config.allowRenegotiation()),
       enforce_rsa_key_usage_(config.enforceRsaKeyUsage()),
-      max_session_keys_(config.maxSessionKeys()) {
+      max_session_keys_(config.maxSessionKeys()),
+      session_cache_stats_(generateSslClientSessionCacheStats(scope)),
+      session_cache_(max_session_keys_ > 0 && session_cache == nullptr
+                         ? std::make_shared<ClientSessionCache>(max_session_keys_)
+                         : std::move(session_cache)) {
   if (!creation_status.ok()) {
     return;
   }
@@ -93,7 +99,7 @@ ClientContextImpl::ClientContextImpl(Stats::Scope& scope,
               static_cast<ContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
           ClientContextImpl* client_context_impl = dynamic_cast<ClientContextImpl*>(context_impl);
           RELEASE_ASSERT(client_context_impl != nullptr, ""); // for Coverity
-          return client_context_impl->newSessionKey(session);
+          return client_context_impl->newSessionKey(ssl, session);
         });
   }
 }
@@ -158,48 +164,24 @@ ClientContextImpl::newSsl(const Network::TransportSocketOptionsConstSharedPtr& o
 
   SSL_set_enforce_rsa_key_usage(ssl_con.get(), enforce_rsa_key_usage_);
 
-  if (max_session_keys_ > 0) {
-    if (session_keys_single_use_) {
-      // Stored single-use session keys, use write/write locks.
-      absl::WriterMutexLock l(&session_keys_mu_);
-      if (!session_keys_.empty()) {
-        // Use the most recently stored session key, since it has the highest
-        // probability of still being recognized/accepted by the server.
-        SSL_SESSION* session = session_keys_.front().get();
-        SSL_set_session(ssl_con.get(), session);
-        // Remove single-use session key (TLS 1.3) after first use.
-        if (SSL_SESSION_should_be_single_use(session)) {
-          session_keys_.pop_front();
-        }
-      }
+  if (session_cache_ != nullptr) {
+    // Only resume sessions of the same SNI, the server may not accept them for another one.
+    bssl::UniquePtr<SSL_SESSION> session = session_cache_->get(server_name_indication);
+    if (session != nullptr) {
+      SSL_set_session(ssl_con.get(), session.get());
+      session_cache_stats_.session_cache_hit_.inc();
     } else {
-      // Never stored single-use session keys, use read/write locks.
-      absl::ReaderMutexLock l(&session_keys_mu_);
-      if (!session_keys_.empty()) {
-        // Use the most recently stored session key, since it has the highest
-        // probability of still being recognized/accepted by the server.
-        SSL_SESSION* session = session_keys_.front().get();
-        SSL_set_session(ssl_con.get(), session);
-      }
+      session_cache_stats_.session_cache_miss_.inc();
     }
   }
 
   return ssl_con;
 }
 
-int ClientContextImpl::newSessionKey(SSL_SESSION* session) {
-  // In case we ever store single-use session key (TLS 1.3),
-  // we need to switch to using write/write locks.
-  if (SSL_SESSION_should_be_single_use(session)) {
-    session_keys_single_use_ = true;
-  }
-  absl::WriterMutexLock l(&session_keys_mu_);
-  // Evict oldest entries.
-  while (session_keys_.size() >= max_session_keys_) {
-    session_keys_.pop_back();
-  }
-  // Add new session key at the front of the queue, so that it's used first.
-  session_keys_.push_front(bssl::UniquePtr<SSL_SESSION>(session));
+int ClientContextImpl::newSessionKey(SSL* ssl, SSL_SESSION* session) {
+  const char* server_name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+  session_cache_->add(server_name != nullptr ? server_name : "",
+                      bssl::UniquePtr<SSL_SESSION>(session));
   return 1; // Tell BoringSSL that we took ownership of the session.
 }
 
@@ -20,6 +20,7 @@
 #include "source/common/common/matchers.h"
 #include "source/common/stats/symbol_table.h"
 #include "source/common/tls/cert_validator/cert_validator.h"
+#include "source/common/tls/client_session_cache.h"
 #include "source/common/tls/context_impl.h"
 #include "source/common/tls/context_manager_impl.h"
 #include "source/common/tls/stats.h"
@@ -41,7 +42,8 @@ class ClientContextImpl : public ContextImpl, public Envoy::Ssl::ClientContext {
 public:
   static absl::StatusOr<std::unique_ptr<ClientContextImpl>>
   create(Stats::Scope& scope, const Envoy::Ssl::ClientContextConfig& config,
-         Server::Configuration::CommonFactoryContext& factory_context);
+         Server::Configuration::CommonFactoryContext& factory_context,
+         ClientSessionCacheSharedPtr session_cache = nullptr);
 
   absl::StatusOr<bssl::UniquePtr<SSL>>
   newSsl(const Network::TransportSocketOptionsConstSharedPtr& options,
@@ -50,18 +52,18 @@ public:
 private:
   ClientContextImpl(Stats::Scope& scope, const Envoy::Ssl::ClientContextConfig& config,
                     Server::Configuration::CommonFactoryContext& factory_context,
-                    absl::Status& creation_status);
+                    ClientSessionCacheSharedPtr session_cache, absl::Status& creation_status);
 
-  int newSessionKey(SSL_SESSION* session);
+  int newSessionKey(SSL* ssl, SSL_SESSION* session);
 
   const std::string server_name_indication_;
   const bool auto_host_sni_;
   const bool allow_renegotiation_;
   const bool enforce_rsa_key_usage_;
   const size_t max_session_keys_;
-  absl::Mutex session_keys_mu_;
-  std::deque<bssl::UniquePtr<SSL_SESSION>> session_keys_ ABSL_GUARDED_BY(session_keys_mu_);
-  bool session_keys_single_use_{false};
+  SslClientSessionCacheStats session_cache_stats_;
+  // Null if session keys are not stored.
+  const ClientSessionCacheSharedPtr session_cache_;
 };
 
 } // namespace Tls
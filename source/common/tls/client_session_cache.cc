@@ -0,0 +1,69 @@
+#include "source/common/tls/client_session_cache.h"
+
+#include "absl/hash/hash.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+ClientSessionCache::Shard& ClientSessionCache::shard(absl::string_view sni) {
+  return shards_[absl::Hash<absl::string_view>()(sni) % NumShards];
+}
+
+bssl::UniquePtr<SSL_SESSION> ClientSessionCache::get(absl::string_view sni) {
+  Shard& shard = this->shard(sni);
+  if (!single_use_.load(std::memory_order_relaxed)) {
+    // Never stored single use session keys, use read/write locks.
+    absl::ReaderMutexLock lock(&shard.mutex_);
+    const auto it = shard.sessions_.find(sni);
+    if (it == shard.sessions_.end() || it->second.empty()) {
+      return nullptr;
+    }
+    // Use the most recently stored session key, since it has the highest probability of still
+    // being recognized/accepted by the server.
+    SSL_SESSION* session = it->second.front().get();
+    SSL_SESSION_up_ref(session);
+    return bssl::UniquePtr<SSL_SESSION>(session);
+  }
+
+  // Stored single use session keys, use write/write locks.
+  absl::WriterMutexLock lock(&shard.mutex_);
+  const auto it = shard.sessions_.find(sni);
+  if (it == shard.sessions_.end() || it->second.empty()) {
+    return nullptr;
+  }
+  bssl::UniquePtr<SSL_SESSION> session;
+  if (SSL_SESSION_should_be_single_use(it->second.front().get())) {
+    // Remove single use session key (TLS 1.3) after first use.
+    session = std::move(it->second.front());
+    it->second.pop_front();
+    if (it->second.empty()) {
+      shard.sessions_.erase(it);
+    }
+  } else {
+    SSL_SESSION_up_ref(it->second.front().get());
+    session.reset(it->second.front().get());
+  }
+  return session;
+}
+
+void ClientSessionCache::add(absl::string_view sni, bssl::UniquePtr<SSL_SESSION> session) {
+  if (SSL_SESSION_should_be_single_use(session.get())) {
+    single_use_.store(true, std::memory_order_relaxed);
+  }
+  Shard& shard = this->shard(sni);
+  absl::WriterMutexLock lock(&shard.mutex_);
+  auto& sessions = shard.sessions_[sni];
+  // Evict oldest entries.
+  while (sessions.size() >= max_session_keys_) {
+    sessions.pop_back();
+  }
+  // Add new session key at the front of the queue, so that it's used first.
+  sessions.push_front(std::move(session));
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * Session keys of upstream TLS connections, by the SNI of the connection. A cache is used by the
+ * connections of all workers, and is shared by the client contexts created from the same config,
+ * so that session keys survive the recreation of a context, e.g. by a cluster update. The SNIs
+ * are spread over a fixed number of shards, each with its own lock.
+ */
+class ClientSessionCache : NonCopyable {
+public:
+  explicit ClientSessionCache(size_t max_session_keys) : max_session_keys_(max_session_keys) {}
+
+  /**
+   * @param sni supplies the SNI of the connection, empty if none is sent.
+   * @return the most recently added session key for the SNI, or nullptr if there is none. Single
+   *         use (TLS 1.3) session keys are removed from the cache.
+   */
+  bssl::UniquePtr<SSL_SESSION> get(absl::string_view sni);
+
+  /**
+   * Adds a session key for the SNI, evicting the oldest session key of the SNI if there are
+   * already max_session_keys of them.
+   * @param sni supplies the SNI of the connection that received the session key.
+   * @param session supplies the session key.
+   */
+  void add(absl::string_view sni, bssl::UniquePtr<SSL_SESSION> session);
+
+  size_t maxSessionKeys() const { return max_session_keys_; }
+
+private:
+  static constexpr size_t NumShards = 16;
+
+  struct Shard {
+    absl::Mutex mutex_;
+    absl::flat_hash_map<std::string, std::deque<bssl::UniquePtr<SSL_SESSION>>>
+        sessions_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  Shard& shard(absl::string_view sni);
+
+  const size_t max_session_keys_;
+  // In case we ever store a single use session key (TLS 1.3), lookups have to take write locks.
+  std::atomic<bool> single_use_{false};
+  std::array<Shard, NumShards> shards_;
+};
+
+using ClientSessionCacheSharedPtr = std::shared_ptr<ClientSessionCache>;
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -7,6 +7,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/common/empty_string.h"
+#include "source/common/common/hash.h"
 #include "source/common/config/datasource.h"
 #include "source/common/network/cidr_range.h"
 #include "source/common/protobuf/message_validator_impl.h"
@@ -145,7 +146,8 @@ ContextConfigImpl::ContextConfigImpl(
                                                 default_min_protocol_version)),
       max_protocol_version_(tlsVersionFromProto(config.tls_params().tls_maximum_protocol_version(),
                                                 default_max_protocol_version)),
-      factory_context_(factory_context), tls_keylog_path_(config.key_log().path()) {
+      factory_context_(factory_context), tls_keylog_path_(config.key_log().path()),
+      kernel_tls_tx_offload_(config.enable_kernel_tls_tx_offload()) {
   SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
   auto list_or_error = Network::Address::IpList::create(config.key_log().local_address_range());
   SET_AND_RETURN_IF_NOT_OK(list_or_error.status(), creation_status);
@@ -359,6 +361,38 @@ ClientContextConfigImpl::ClientContextConfigImpl(
         "Multiple TLS certificates are not supported for client contexts");
     return;
   }
+
+  // Session keys skip the validation of the upstream certificate when they are resumed, so they
+  // may only be shared with contexts that validate it the same way. A validation context provided
+  // by a secret may change without changing the config.
+  switch (config.common_tls_context().validation_context_type_case()) {
+  case envoy::extensions::transport_sockets::tls::v3::CommonTlsContext::ValidationContextTypeCase::
+      kValidationContext:
+  case envoy::extensions::transport_sockets::tls::v3::CommonTlsContext::ValidationContextTypeCase::
+      VALIDATION_CONTEXT_TYPE_NOT_SET:
+    config_hash_ = MessageUtil::hash(config);
+    break;
+  default:
+    break;
+  }
+}
+
+absl::optional<uint64_t> ClientContextConfigImpl::sessionCacheKey() const {
+  if (!config_hash_.has_value()) {
+    return absl::nullopt;
+  }
+  // Certificates may be loaded from files or secrets, so their contents are part of the key.
+  uint64_t key = config_hash_.value();
+  for (const Ssl::TlsCertificateConfig& tls_certificate : tlsCertificates()) {
+    key = HashUtil::xxHash64(tls_certificate.certificateChain(), key);
+  }
+  if (const Ssl::CertificateValidationContextConfig* validation_context =
+          certificateValidationContext();
+      validation_context != nullptr) {
+    key = HashUtil::xxHash64(validation_context->caCert(), key);
+    key = HashUtil::xxHash64(validation_context->certificateRevocationList(), key);
+  }
+  return key;
 }
 
 } // namespace Tls
@@ -48,6 +48,7 @@ public:
   AccessLog::AccessLogManager& accessLogManager() const override {
     return factory_context_.serverFactoryContext().accessLogManager();
   }
+  bool kernelTlsTxOffload() const override { return kernel_tls_tx_offload_; }
 
   bool isReady() const override {
     const bool tls_is_ready =
@@ -116,6 +117,7 @@ private:
   const std::string tls_keylog_path_;
   std::unique_ptr<Network::Address::IpList> tls_keylog_local_;
   std::unique_ptr<Network::Address::IpList> tls_keylog_remote_;
+  const bool kernel_tls_tx_offload_;
 };
 
 class ClientContextConfigImpl : public ContextConfigImpl, public Envoy::Ssl::ClientContextConfig {
@@ -134,6 +136,7 @@ public:
   bool allowRenegotiation() const override { return allow_renegotiation_; }
   size_t maxSessionKeys() const override { return max_session_keys_; }
   bool enforceRsaKeyUsage() const override { return enforce_rsa_key_usage_; }
+  absl::optional<uint64_t> sessionCacheKey() const override;
 
 private:
   ClientContextConfigImpl(
@@ -149,6 +152,9 @@ private:
   const bool allow_renegotiation_;
   const bool enforce_rsa_key_usage_;
   const size_t max_session_keys_;
+  // Hash of the config if it determines the validation of upstream certificates, absl::nullopt
+  // if the validation context is provided by a secret.
+  absl::optional<uint64_t> config_hash_;
 };
 
 } // namespace Tls
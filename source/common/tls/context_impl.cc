@@ -3,18 +3,23 @@
 #include <openssl/ssl.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "envoy/admin/v3/certs.pb.h"
+#include "envoy/api/api.h"
 #include "envoy/common/exception.h"
 #include "envoy/common/platform.h"
 #include "envoy/ssl/ssl_socket_extended_info.h"
 #include "envoy/stats/scope.h"
+#include "envoy/thread/thread.h"
 #include "envoy/type/matcher/v3/string.pb.h"
 
 #include "source/common/common/assert.h"
@@ -57,6 +62,39 @@ namespace Extensions {
 namespace TransportSockets {
 namespace Tls {
 
+namespace {
+
+// Helper threads only pay off when each of them has a few certificates to load.
+constexpr size_t MinCertificatesPerLoaderThread = 8;
+constexpr size_t MaxCertificateLoaderThreads = 8;
+
+// Runs load(i) for each i below count on the calling thread and a bounded number of helper
+// threads. Parsing certificates and private keys is independent per SSL_CTX and CPU bound, which
+// makes contexts with many certificates slow to build on the main thread alone.
+void loadInParallel(Api::Api& api, size_t count, const std::function<void(size_t)>& load) {
+  const size_t helper_count = std::min<size_t>(
+      {count / MinCertificatesPerLoaderThread, MaxCertificateLoaderThreads,
+       std::max(std::thread::hardware_concurrency(), 1U) - 1});
+  std::atomic<size_t> next{0};
+  const auto run = [&next, count, &load]() {
+    for (size_t i = next++; i < count; i = next++) {
+      load(i);
+    }
+  };
+  std::vector<Thread::ThreadPtr> threads;
+  Thread::Options options;
+  options.name_ = "tls_cert_load";
+  for (size_t i = 0; i < helper_count; ++i) {
+    threads.push_back(api.threadFactory().createThread(run, options));
+  }
+  run();
+  for (auto& thread : threads) {
+    thread->join();
+  }
+}
+
+} // namespace
+
 int ContextImpl::sslExtendedSocketInfoIndex() {
   CONSTRUCT_ON_FIRST_USE(int, []() -> int {
     int ssl_context_index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
@@ -80,7 +118,8 @@ ContextImpl::ContextImpl(Stats::Scope& scope, const Envoy::Ssl::ContextConfig& c
       ssl_versions_(stat_name_set_->add("ssl.versions")),
       ssl_curves_(stat_name_set_->add("ssl.curves")),
       ssl_sigalgs_(stat_name_set_->add("ssl.sigalgs")), capabilities_(config.capabilities()),
-      tls_keylog_local_(config.tlsKeyLogLocal()), tls_keylog_remote_(config.tlsKeyLogRemote()) {
+      tls_keylog_local_(config.tlsKeyLogLocal()), tls_keylog_remote_(config.tlsKeyLogRemote()),
+      kernel_tls_tx_offload_(config.kernelTlsTxOffload()) {
 
   auto cert_validator_name = getCertValidatorName(config.certificateValidationContext());
   auto cert_validator_factory =
@@ -195,17 +234,35 @@ ContextImpl::ContextImpl(Stats::Scope& scope, const Envoy::Ssl::ContextConfig& c
 #endif
 
   if (!capabilities_.provides_certificates) {
-    for (uint32_t i = 0; i < tls_certificates.size(); ++i) {
+    // The certificate chains and private keys are loaded first, possibly in parallel, and then
+    // checked in order, so that the first error is the one which loading them in order would give.
+    std::vector<absl::Status> certificate_statuses(tls_certificates.size());
+    std::vector<absl::Status> private_key_statuses(tls_certificates.size());
+    const auto load_certificate = [this, &tls_certificates, &certificate_statuses,
+                                   &private_key_statuses](size_t i) {
       auto& ctx = tls_contexts_[i];
-      // Load certificate chain.
       const auto& tls_certificate = tls_certificates[i].get();
       if (!tls_certificate.pkcs12().empty()) {
-        creation_status = ctx.loadPkcs12(tls_certificate.pkcs12(), tls_certificate.pkcs12Path(),
-                                         tls_certificate.password());
+        certificate_statuses[i] = ctx.loadPkcs12(
+            tls_certificate.pkcs12(), tls_certificate.pkcs12Path(), tls_certificate.password());
       } else {
-        creation_status = ctx.loadCertificateChain(tls_certificate.certificateChain(),
-                                                   tls_certificate.certificateChainPath());
+        certificate_statuses[i] = ctx.loadCertificateChain(tls_certificate.certificateChain(),
+                                                           tls_certificate.certificateChainPath());
       }
+      if (certificate_statuses[i].ok() && tls_certificate.privateKeyMethod() == nullptr &&
+          !tls_certificate.privateKey().empty()) {
+        private_key_statuses[i] =
+            ctx.loadPrivateKey(tls_certificate.privateKey(), tls_certificate.privateKeyPath(),
+                               tls_certificate.password());
+      }
+    };
+    loadInParallel(factory_context_.api(), tls_certificates.size(), load_certificate);
+
+    for (uint32_t i = 0; i < tls_certificates.size(); ++i) {
+      auto& ctx = tls_contexts_[i];
+      // Certificate chain, loaded above.
+      const auto& tls_certificate = tls_certificates[i].get();
+      creation_status = certificate_statuses[i];
       if (!creation_status.ok()) {
         return;
       }
@@ -295,10 +352,8 @@ ContextImpl::ContextImpl(Stats::Scope& scope, const Envoy::Ssl::ContextConfig& c
 #endif
         SSL_CTX_set_private_key_method(ctx.ssl_ctx_.get(), private_key_method.get());
       } else if (!tls_certificate.privateKey().empty()) {
-        // Load private key.
-        creation_status =
-            ctx.loadPrivateKey(tls_certificate.privateKey(), tls_certificate.privateKeyPath(),
-                               tls_certificate.password());
+        // Private key, loaded above.
+        creation_status = private_key_statuses[i];
         if (!creation_status.ok()) {
           return;
         }
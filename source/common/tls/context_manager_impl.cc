@@ -27,13 +27,32 @@ ContextManagerImpl::createSslClientContext(Stats::Scope& scope,
   if (!config.isReady()) {
     return nullptr;
   }
-  auto context_or_error = ClientContextImpl::create(scope, config, factory_context_);
+  auto context_or_error =
+      ClientContextImpl::create(scope, config, factory_context_, clientSessionCache(config));
   RETURN_IF_NOT_OK(context_or_error.status());
   Envoy::Ssl::ClientContextSharedPtr context = std::move(context_or_error.value());
   contexts_.insert(context);
   return context;
 }
 
+ClientSessionCacheSharedPtr
+ContextManagerImpl::clientSessionCache(const Envoy::Ssl::ClientContextConfig& config) {
+  const absl::optional<uint64_t> key = config.sessionCacheKey();
+  if (config.maxSessionKeys() == 0 || !key.has_value()) {
+    return nullptr;
+  }
+
+  absl::erase_if(client_session_caches_,
+                 [](const auto& entry) { return entry.second.expired(); });
+  std::weak_ptr<ClientSessionCache>& entry = client_session_caches_[key.value()];
+  ClientSessionCacheSharedPtr session_cache = entry.lock();
+  if (session_cache == nullptr) {
+    session_cache = std::make_shared<ClientSessionCache>(config.maxSessionKeys());
+    entry = session_cache;
+  }
+  return session_cache;
+}
+
 absl::StatusOr<Envoy::Ssl::ServerContextSharedPtr> ContextManagerImpl::createSslServerContext(
     Stats::Scope& scope, const Envoy::Ssl::ServerContextConfig& config,
     const std::vector<std::string>& server_names, Ssl::ContextAdditionalInitFunc additional_init) {
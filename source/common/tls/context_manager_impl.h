@@ -10,8 +10,11 @@
 #include "envoy/ssl/private_key/private_key.h"
 #include "envoy/stats/scope.h"
 
+#include "source/common/tls/client_session_cache.h"
 #include "source/common/tls/private_key/private_key_manager_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace TransportSockets {
@@ -45,8 +48,15 @@ public:
   void removeContext(const Envoy::Ssl::ContextSharedPtr& old_context) override;
 
 private:
+  // @return the session cache for a client context created from the config, shared with the live
+  //         client contexts with the same session cache key.
+  ClientSessionCacheSharedPtr clientSessionCache(const Envoy::Ssl::ClientContextConfig& config);
+
   Server::Configuration::CommonFactoryContext& factory_context_;
   absl::flat_hash_set<Envoy::Ssl::ContextSharedPtr> contexts_;
+  // Client contexts are released on any thread, so they don't remove their session caches. Expired
+  // caches are removed when the next client context is created.
+  absl::flat_hash_map<uint64_t, std::weak_ptr<ClientSessionCache>> client_session_caches_;
   PrivateKeyMethodManagerImpl private_key_method_manager_{};
 };
 
@@ -1,8 +1,12 @@
 #include "source/common/tls/io_handle_bio.h"
 
+#include <algorithm>
+
 #include "envoy/buffer/buffer.h"
 #include "envoy/network/io_handle.h"
 
+#include "source/common/buffer/buffer_impl.h"
+
 #include "openssl/bio.h"
 #include "openssl/err.h"
 
@@ -13,21 +17,34 @@ namespace Tls {
 
 namespace {
 
+// The read-ahead buffer starts with room for a full TLS record, and is resized between these
+// bounds depending on how much the previous socket read returned.
+constexpr uint64_t MinReadAheadSize = 16 * 1024 + 512;
+constexpr uint64_t MaxReadAheadSize = 128 * 1024;
+
+struct IoHandleBioState {
+  IoHandleBioState(Envoy::Network::IoHandle& io_handle, bool read_ahead)
+      : io_handle_(io_handle), read_ahead_(read_ahead) {}
+
+  Envoy::Network::IoHandle& io_handle_;
+  const bool read_ahead_;
+  // Socket data read ahead of what BoringSSL asked for. BoringSSL reads the header and the body of
+  // each record separately, so without read-ahead every record costs two syscalls.
+  Buffer::OwnedImpl read_buffer_;
+  uint64_t read_ahead_size_{MinReadAheadSize};
+};
+
 // NOLINTNEXTLINE(readability-identifier-naming)
-inline Envoy::Network::IoHandle* bio_io_handle(BIO* bio) {
-  return reinterpret_cast<Envoy::Network::IoHandle*>(BIO_get_data(bio));
+inline IoHandleBioState* bio_state(BIO* bio) {
+  return reinterpret_cast<IoHandleBioState*>(BIO_get_data(bio));
 }
 
 // NOLINTNEXTLINE(readability-identifier-naming)
-int io_handle_read(BIO* b, char* out, int outl) {
-  if (out == nullptr) {
-    return 0;
-  }
-
+Api::IoCallUint64Result io_handle_readv(BIO* b, char* out, uint64_t outl) {
   Envoy::Buffer::RawSlice slice;
   slice.mem_ = out;
   slice.len_ = outl;
-  auto result = bio_io_handle(b)->readv(outl, &slice, 1);
+  auto result = bio_state(b)->io_handle_.readv(outl, &slice, 1);
   BIO_clear_retry_flags(b);
   if (!result.ok()) {
     auto err = result.err_->getErrorCode();
@@ -36,9 +53,61 @@ int io_handle_read(BIO* b, char* out, int outl) {
     } else {
       ERR_put_error(ERR_LIB_SYS, 0, result.err_->getSystemErrorCode(), __FILE__, __LINE__);
     }
-    return -1;
   }
-  return result.return_value_;
+  return result;
+}
+
+// Refills the empty read-ahead buffer with a single socket read, and adapts the size of the next
+// read: it doubles when the socket had more data than fitted, and halves when the read used less
+// than a quarter of the buffer.
+// NOLINTNEXTLINE(readability-identifier-naming)
+Api::IoCallUint64Result io_handle_read_ahead(BIO* b) {
+  IoHandleBioState& state = *bio_state(b);
+  ASSERT(state.read_buffer_.length() == 0);
+  auto reservation = state.read_buffer_.reserveSingleSlice(state.read_ahead_size_);
+  auto result = io_handle_readv(b, static_cast<char*>(reservation.slice().mem_),
+                                reservation.slice().len_);
+  if (!result.ok()) {
+    return result;
+  }
+  reservation.commit(result.return_value_);
+  if (result.return_value_ == state.read_ahead_size_) {
+    state.read_ahead_size_ = std::min(state.read_ahead_size_ * 2, MaxReadAheadSize);
+  } else if (result.return_value_ < state.read_ahead_size_ / 4) {
+    state.read_ahead_size_ = std::max(state.read_ahead_size_ / 2, MinReadAheadSize);
+  }
+  return result;
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+int io_handle_read(BIO* b, char* out, int outl) {
+  if (out == nullptr) {
+    return 0;
+  }
+
+  IoHandleBioState& state = *bio_state(b);
+  // Reads which are at least as large as the read-ahead buffer gain nothing from it.
+  if (!state.read_ahead_ || (state.read_buffer_.length() == 0 &&
+                             static_cast<uint64_t>(outl) >= state.read_ahead_size_)) {
+    auto result = io_handle_readv(b, out, outl);
+    return result.ok() ? result.return_value_ : -1;
+  }
+
+  if (state.read_buffer_.length() == 0) {
+    auto result = io_handle_read_ahead(b);
+    if (!result.ok()) {
+      return -1;
+    }
+    if (result.return_value_ == 0) {
+      // End of stream.
+      return 0;
+    }
+  }
+  BIO_clear_retry_flags(b);
+  const uint64_t length = std::min<uint64_t>(outl, state.read_buffer_.length());
+  state.read_buffer_.copyOut(0, length, out);
+  state.read_buffer_.drain(length);
+  return length;
 }
 
 // NOLINTNEXTLINE(readability-identifier-naming)
@@ -46,7 +115,7 @@ int io_handle_write(BIO* b, const char* in, int inl) {
   Envoy::Buffer::RawSlice slice;
   slice.mem_ = const_cast<char*>(in);
   slice.len_ = inl;
-  auto result = bio_io_handle(b)->writev(&slice, 1);
+  auto result = bio_state(b)->io_handle_.writev(&slice, 1);
   BIO_clear_retry_flags(b);
   if (!result.ok()) {
     auto err = result.err_->getErrorCode();
@@ -61,13 +130,16 @@ int io_handle_write(BIO* b, const char* in, int inl) {
 }
 
 // NOLINTNEXTLINE(readability-identifier-naming)
-long io_handle_ctrl(BIO*, int cmd, long, void*) {
+long io_handle_ctrl(BIO* b, int cmd, long, void*) {
   long ret = 1;
 
   switch (cmd) {
   case BIO_CTRL_FLUSH:
     ret = 1;
     break;
+  case BIO_CTRL_PENDING:
+    ret = bio_state(b)->read_buffer_.length();
+    break;
   default:
     ret = 0;
     break;
@@ -75,6 +147,13 @@ long io_handle_ctrl(BIO*, int cmd, long, void*) {
   return ret;
 }
 
+// NOLINTNEXTLINE(readability-identifier-naming)
+int io_handle_free(BIO* b) {
+  delete bio_state(b);
+  BIO_set_data(b, nullptr);
+  return 1;
+}
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 const BIO_METHOD* BIO_s_io_handle(void) {
   static const BIO_METHOD* method = [&] {
@@ -83,6 +162,7 @@ const BIO_METHOD* BIO_s_io_handle(void) {
     RELEASE_ASSERT(BIO_meth_set_read(ret, io_handle_read), "");
     RELEASE_ASSERT(BIO_meth_set_write(ret, io_handle_write), "");
     RELEASE_ASSERT(BIO_meth_set_ctrl(ret, io_handle_ctrl), "");
+    RELEASE_ASSERT(BIO_meth_set_destroy(ret, io_handle_free), "");
     return ret;
   }();
   return method;
@@ -91,14 +171,14 @@ const BIO_METHOD* BIO_s_io_handle(void) {
 } // namespace
 
 // NOLINTNEXTLINE(readability-identifier-naming)
-BIO* BIO_new_io_handle(Envoy::Network::IoHandle* io_handle) {
+BIO* BIO_new_io_handle(Envoy::Network::IoHandle* io_handle, bool read_ahead) {
   BIO* b;
 
   b = BIO_new(BIO_s_io_handle());
   RELEASE_ASSERT(b != nullptr, "");
 
   // Initialize the BIO
-  BIO_set_data(b, io_handle);
+  BIO_set_data(b, new IoHandleBioState(*io_handle, read_ahead));
   BIO_set_init(b, 1);
 
   return b;
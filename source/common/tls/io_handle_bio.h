@@ -13,9 +13,13 @@ namespace Tls {
  * Creates a custom BIO that can read from/write to an IoHandle. It's equivalent to a socket BIO
  * but instead of relying on access to an fd, it relies on IoHandle APIs for all interactions. The
  * IoHandle must remain valid for the lifetime of the BIO.
+ *
+ * With read_ahead, the BIO reads as much as is available from the socket into a buffer sized
+ * adaptively per connection, and serves the small reads of BoringSSL from that buffer, so that
+ * several TLS records are decrypted per socket read. BIO_pending() returns the buffered amount.
  */
 // NOLINTNEXTLINE(readability-identifier-naming)
-BIO* BIO_new_io_handle(Envoy::Network::IoHandle* io_handle);
+BIO* BIO_new_io_handle(Envoy::Network::IoHandle* io_handle, bool read_ahead = false);
 
 } // namespace Tls
 } // namespace TransportSockets
@@ -0,0 +1,299 @@
+#include "source/common/tls/kernel_tls.h"
+
+#include <cstring>
+#include <string>
+
+#include "envoy/common/exception.h"
+#include "envoy/common/platform.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "openssl/bio.h"
+#include "openssl/digest.h"
+#include "openssl/err.h"
+#include "openssl/hkdf.h"
+#include "openssl/mem.h"
+#include "openssl/nid.h"
+
+#if defined(__linux__)
+#include <linux/tls.h>
+#endif
+
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+
+namespace {
+
+constexpr uint8_t TlsAlertRecordType = 21;
+constexpr uint8_t TlsAlertLevelWarning = 1;
+constexpr uint8_t TlsAlertCloseNotify = 0;
+
+void storeSequence(uint64_t sequence, uint8_t* out) {
+  for (int i = 7; i >= 0; --i) {
+    out[i] = static_cast<uint8_t>(sequence);
+    sequence >>= 8;
+  }
+}
+
+#if !defined(OPENSSL_IS_AWSLC)
+// HKDF-Expand-Label from https://www.rfc-editor.org/rfc/rfc8446#section-7.1 with an empty context.
+absl::StatusOr<std::vector<uint8_t>> hkdfExpandLabel(const EVP_MD* digest,
+                                                     bssl::Span<const uint8_t> secret,
+                                                     absl::string_view label, size_t length) {
+  const std::string full_label = absl::StrCat("tls13 ", label);
+  std::vector<uint8_t> hkdf_label;
+  hkdf_label.reserve(4 + full_label.size());
+  hkdf_label.push_back(static_cast<uint8_t>(length >> 8));
+  hkdf_label.push_back(static_cast<uint8_t>(length));
+  hkdf_label.push_back(static_cast<uint8_t>(full_label.size()));
+  hkdf_label.insert(hkdf_label.end(), full_label.begin(), full_label.end());
+  hkdf_label.push_back(0);
+
+  std::vector<uint8_t> out(length);
+  if (!HKDF_expand(out.data(), out.size(), digest, secret.data(), secret.size(), hkdf_label.data(),
+                   hkdf_label.size())) {
+    return absl::InternalError("HKDF_expand failed");
+  }
+  return out;
+}
+#endif
+
+// A write BIO that rejects all writes. It is installed once the kernel owns the write direction
+// of the connection, since records sealed by BoringSSL would be re-encrypted by the kernel.
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+int kernel_tls_tx_write(BIO*, const char*, int) {
+  ERR_put_error(ERR_LIB_SYS, 0, EIO, __FILE__, __LINE__);
+  return -1;
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+long kernel_tls_tx_ctrl(BIO*, int cmd, long, void*) { return cmd == BIO_CTRL_FLUSH ? 1 : 0; }
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+const BIO_METHOD* BIO_s_kernel_tls_tx() {
+  static const BIO_METHOD* method = [] {
+    BIO_METHOD* ret = BIO_meth_new(BIO_TYPE_SOCKET, "kernel_tls_tx");
+    RELEASE_ASSERT(ret != nullptr, "");
+    RELEASE_ASSERT(BIO_meth_set_write(ret, kernel_tls_tx_write), "");
+    RELEASE_ASSERT(BIO_meth_set_ctrl(ret, kernel_tls_tx_ctrl), "");
+    return ret;
+  }();
+  return method;
+}
+
+#if defined(__linux__)
+template <class CryptoInfo>
+void fillAesGcmCryptoInfo(const TxCryptoInfo& info, uint16_t cipher_type, CryptoInfo& out) {
+  out.info.version = info.version_;
+  out.info.cipher_type = cipher_type;
+  RELEASE_ASSERT(info.key_.size() == sizeof(out.key), "");
+  memcpy(out.key, info.key_.data(), sizeof(out.key)); // NOLINT(safe-memcpy)
+  storeSequence(info.sequence_, out.rec_seq);
+  memcpy(out.salt, info.iv_.data(), sizeof(out.salt)); // NOLINT(safe-memcpy)
+  if (info.version_ == TLS1_3_VERSION) {
+    // The kernel splits the 12 byte TLS 1.3 IV into a 4 byte salt and an 8 byte IV.
+    RELEASE_ASSERT(info.iv_.size() == sizeof(out.salt) + sizeof(out.iv), "");
+    memcpy(out.iv, info.iv_.data() + sizeof(out.salt), sizeof(out.iv)); // NOLINT(safe-memcpy)
+  } else {
+    // BoringSSL uses the record sequence number as the explicit part of the TLS 1.2 nonce.
+    RELEASE_ASSERT(info.iv_.size() == sizeof(out.salt), "");
+    storeSequence(info.sequence_, out.iv);
+  }
+}
+#endif
+
+} // namespace
+
+absl::StatusOr<TxCryptoInfo> txCryptoInfo(const SSL& ssl) {
+  TxCryptoInfo info;
+  info.version_ = SSL_version(&ssl);
+  if (info.version_ != TLS1_2_VERSION && info.version_ != TLS1_3_VERSION) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("unsupported protocol version ", SSL_get_version(&ssl)));
+  }
+
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(&ssl);
+  if (cipher == nullptr) {
+    return absl::FailedPreconditionError("handshake has not completed");
+  }
+  info.cipher_nid_ = SSL_CIPHER_get_cipher_nid(cipher);
+  size_t key_length;
+  size_t iv_length = 12;
+  switch (info.cipher_nid_) {
+  case NID_aes_128_gcm:
+    key_length = 16;
+    if (info.version_ == TLS1_2_VERSION) {
+      iv_length = 4;
+    }
+    break;
+  case NID_aes_256_gcm:
+    key_length = 32;
+    if (info.version_ == TLS1_2_VERSION) {
+      iv_length = 4;
+    }
+    break;
+  case NID_chacha20_poly1305:
+    key_length = 32;
+    break;
+  default:
+    return absl::InvalidArgumentError(
+        absl::StrCat("unsupported cipher ", SSL_CIPHER_get_name(cipher)));
+  }
+
+  info.sequence_ = SSL_get_write_sequence(&ssl);
+
+  if (info.version_ == TLS1_3_VERSION) {
+#if defined(OPENSSL_IS_AWSLC)
+    return absl::UnimplementedError("TLS 1.3 traffic secrets are not available");
+#else
+    bssl::Span<const uint8_t> read_secret;
+    bssl::Span<const uint8_t> write_secret;
+    if (!bssl::SSL_get_traffic_secrets(&ssl, &read_secret, &write_secret)) {
+      return absl::InternalError("failed to get TLS 1.3 traffic secrets");
+    }
+    const EVP_MD* digest = EVP_get_digestbynid(SSL_CIPHER_get_prf_nid(cipher));
+    if (digest == nullptr) {
+      return absl::InternalError("unknown PRF digest");
+    }
+    auto key_or_error = hkdfExpandLabel(digest, write_secret, "key", key_length);
+    RETURN_IF_NOT_OK_REF(key_or_error.status());
+    auto iv_or_error = hkdfExpandLabel(digest, write_secret, "iv", iv_length);
+    RETURN_IF_NOT_OK_REF(iv_or_error.status());
+    info.key_ = std::move(*key_or_error);
+    info.iv_ = std::move(*iv_or_error);
+#endif
+  } else {
+    // The TLS 1.2 key block is laid out as the client and server MAC keys (empty for AEADs), the
+    // client and server keys, and then the client and server implicit IVs.
+    std::vector<uint8_t> key_block(SSL_get_key_block_len(&ssl));
+    if (key_block.size() != 2 * (key_length + iv_length)) {
+      return absl::InvalidArgumentError("unexpected key block length");
+    }
+    if (!SSL_generate_key_block(&ssl, key_block.data(), key_block.size())) {
+      return absl::InternalError("failed to generate key block");
+    }
+    const bool is_server = SSL_is_server(&ssl);
+    const uint8_t* key = key_block.data() + (is_server ? key_length : 0);
+    const uint8_t* iv = key_block.data() + 2 * key_length + (is_server ? iv_length : 0);
+    info.key_.assign(key, key + key_length);
+    info.iv_.assign(iv, iv + iv_length);
+    OPENSSL_cleanse(key_block.data(), key_block.size());
+  }
+
+  return info;
+}
+
+absl::Status enableTxOffload(SSL& ssl, Network::IoHandle& io_handle) {
+#if defined(__linux__)
+  auto info_or_error = txCryptoInfo(ssl);
+  RETURN_IF_NOT_OK_REF(info_or_error.status());
+  const TxCryptoInfo& info = *info_or_error;
+
+  union {
+    tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+    tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    tls12_crypto_info_chacha20_poly1305 chacha20_poly1305;
+#endif
+  } crypto_info;
+  memset(&crypto_info, 0, sizeof(crypto_info));
+  socklen_t crypto_info_length;
+  switch (info.cipher_nid_) {
+  case NID_aes_128_gcm:
+    fillAesGcmCryptoInfo(info, TLS_CIPHER_AES_GCM_128, crypto_info.aes_gcm_128);
+    crypto_info_length = sizeof(crypto_info.aes_gcm_128);
+    break;
+  case NID_aes_256_gcm:
+    fillAesGcmCryptoInfo(info, TLS_CIPHER_AES_GCM_256, crypto_info.aes_gcm_256);
+    crypto_info_length = sizeof(crypto_info.aes_gcm_256);
+    break;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+  case NID_chacha20_poly1305: {
+    auto& out = crypto_info.chacha20_poly1305;
+    out.info.version = info.version_;
+    out.info.cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+    RELEASE_ASSERT(info.key_.size() == sizeof(out.key) && info.iv_.size() == sizeof(out.iv), "");
+    memcpy(out.key, info.key_.data(), sizeof(out.key)); // NOLINT(safe-memcpy)
+    memcpy(out.iv, info.iv_.data(), sizeof(out.iv));    // NOLINT(safe-memcpy)
+    storeSequence(info.sequence_, out.rec_seq);
+    crypto_info_length = sizeof(out);
+    break;
+  }
+#endif
+  default:
+    return absl::InvalidArgumentError("cipher is not supported by the kernel headers");
+  }
+
+  static constexpr char UlpName[] = "tls";
+  Api::SysCallIntResult result =
+      io_handle.setOption(IPPROTO_TCP, TCP_ULP, UlpName, sizeof(UlpName) - 1);
+  if (result.return_value_ == 0) {
+    result = io_handle.setOption(SOL_TLS, TLS_TX, &crypto_info, crypto_info_length);
+  }
+  OPENSSL_cleanse(&crypto_info, sizeof(crypto_info));
+  if (result.return_value_ != 0) {
+    // Once the ULP is attached it cannot be detached again, but without TLS_TX the socket keeps
+    // passing data through unmodified, so BoringSSL can continue to own the write direction.
+    return absl::UnavailableError(
+        absl::StrCat("kernel TLS is unavailable: ", errorDetails(result.errno_)));
+  }
+
+  BIO* bio = BIO_new(BIO_s_kernel_tls_tx());
+  RELEASE_ASSERT(bio != nullptr, "");
+  BIO_set_init(bio, 1);
+  SSL_set0_wbio(&ssl, bio);
+  return absl::OkStatus();
+#else
+  UNREFERENCED_PARAMETER(ssl);
+  UNREFERENCED_PARAMETER(io_handle);
+  return absl::UnimplementedError("kernel TLS is only supported on Linux");
+#endif
+}
+
+Api::SysCallSizeResult sendCloseNotify(Network::IoHandle& io_handle) {
+#if defined(__linux__)
+  uint8_t alert[] = {TlsAlertLevelWarning, TlsAlertCloseNotify};
+  iovec iov{alert, sizeof(alert)};
+
+  char control[CMSG_SPACE(sizeof(uint8_t))];
+  memset(control, 0, sizeof(control));
+  msghdr message;
+  memset(&message, 0, sizeof(message));
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint8_t));
+  *CMSG_DATA(cmsg) = TlsAlertRecordType;
+
+  return Api::OsSysCallsSingleton::get().sendmsg(io_handle.fdDoNotUse(), &message, MSG_DONTWAIT);
+#else
+  UNREFERENCED_PARAMETER(io_handle);
+  return {-1, SOCKET_ERROR_NOT_SUP};
+#endif
+}
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "envoy/network/io_handle.h"
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+
+/**
+ * The state of the write direction of a TLS connection that the kernel needs to continue
+ * encrypting records where BoringSSL left off.
+ */
+struct TxCryptoInfo {
+  // The negotiated protocol version, TLS1_2_VERSION or TLS1_3_VERSION.
+  uint16_t version_{};
+  // The NID of the negotiated AEAD, one of NID_aes_128_gcm, NID_aes_256_gcm or
+  // NID_chacha20_poly1305.
+  int cipher_nid_{};
+  // The write key.
+  std::vector<uint8_t> key_;
+  // The write IV. For AES-GCM on TLS 1.2 this is the 4 byte implicit part of the nonce, otherwise
+  // it is the 12 byte value that is XORed with the record sequence number to form the nonce.
+  std::vector<uint8_t> iv_;
+  // The sequence number of the next record to be written.
+  uint64_t sequence_{};
+};
+
+/**
+ * Extract the write keys of an established connection.
+ * @param ssl a connection that has completed its handshake.
+ * @return the write state of the connection, or an error if the negotiated protocol version or
+ *         cipher cannot be offloaded to the kernel.
+ */
+absl::StatusOr<TxCryptoInfo> txCryptoInfo(const SSL& ssl);
+
+/**
+ * Hand the write direction of an established connection to the kernel. On success, all further
+ * data written to the socket is encrypted by the kernel and BoringSSL must no longer write to the
+ * connection: its write BIO is replaced with one that fails all writes, so any attempt by BoringSSL
+ * to send a record (for instance a TLS 1.3 KeyUpdate) results in a connection error rather than a
+ * corrupted stream. On failure the connection is left untouched.
+ * @param ssl a connection that has completed its handshake.
+ * @param io_handle the socket the connection is established on.
+ * @return OK if the kernel now encrypts the connection's writes.
+ */
+absl::Status enableTxOffload(SSL& ssl, Network::IoHandle& io_handle);
+
+/**
+ * Send a close_notify alert on a socket whose write direction has been offloaded to the kernel
+ * with enableTxOffload().
+ * @param io_handle the socket.
+ * @return the result of the underlying sendmsg() call.
+ */
+Api::SysCallSizeResult sendCloseNotify(Network::IoHandle& io_handle);
+
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
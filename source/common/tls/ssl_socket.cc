@@ -6,7 +6,9 @@
 #include "source/common/common/empty_string.h"
 #include "source/common/common/hex.h"
 #include "source/common/http/headers.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/common/tls/io_handle_bio.h"
+#include "source/common/tls/kernel_tls.h"
 #include "source/common/tls/ssl_handshaker.h"
 #include "source/common/tls/utility.h"
 
@@ -25,6 +27,28 @@ namespace {
 
 constexpr absl::string_view NotReadyReason{"TLS error: Secret is not supplied by SDS"};
 
+// The largest amount of plaintext that fits in a single TLS record.
+constexpr uint64_t MaxTlsRecordSize = 16384;
+
+// Returns a pointer to the first `size` bytes of `buffer` suitable for passing to SSL_write().
+// Data that is already contiguous in the first slice is used in place. Otherwise the leading
+// slices are gathered into per-thread scratch space so that a full record can be written. This
+// avoids linearizing the buffer, which would allocate a new slice and rewrite the front of the
+// buffer only for BoringSSL to read the plaintext once while sealing the record.
+const void* recordPlaintext(Buffer::Instance& buffer, uint64_t size) {
+  ASSERT(size <= MaxTlsRecordSize);
+  const Buffer::RawSlice front = buffer.frontSlice();
+  if (front.len_ >= size) {
+    return front.mem_;
+  }
+  static thread_local std::unique_ptr<uint8_t[]> scratch;
+  if (scratch == nullptr) {
+    scratch = std::make_unique<uint8_t[]>(MaxTlsRecordSize);
+  }
+  buffer.copyOut(0, size, scratch.get());
+  return scratch.get();
+}
+
 } // namespace
 
 absl::string_view NotReadySslSocket::failureReason() const { return NotReadyReason; }
@@ -80,7 +104,9 @@ void SslSocket::setTransportSocketCallbacks(Network::TransportSocketCallbacks& c
   }
 
   // Use custom BIO that reads from/writes to IoHandle
-  BIO* bio = BIO_new_io_handle(&callbacks_->ioHandle());
+  BIO* bio = BIO_new_io_handle(
+      &callbacks_->ioHandle(),
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.tls_bio_read_ahead"));
   SSL_set_bio(rawSsl(), bio, bio);
   SSL_set_ex_data(rawSsl(), ContextImpl::sslSocketIndex(), static_cast<void*>(callbacks_));
 }
@@ -184,6 +210,11 @@ void SslSocket::resumeHandshake() {
     ENVOY_CONN_LOG(debug, "async handshake completion error", callbacks_->connection());
     callbacks_->connection().close(Network::ConnectionCloseType::FlushWrite,
                                    "failed_resuming_async_handshake");
+  } else if (info_->state() == Ssl::SocketState::HandshakeComplete &&
+             BIO_pending(SSL_get_rbio(rawSsl())) > 0) {
+    // Data which the peer sent right after the handshake may already have been read ahead from
+    // the socket, in which case no read event is coming for it.
+    callbacks_->setTransportSocketIsReadable();
   }
 }
 
@@ -191,6 +222,9 @@ Network::Connection& SslSocket::connection() const { return callbacks_->connecti
 
 void SslSocket::onSuccess(SSL* ssl) {
   ctx_->logHandshake(ssl);
+  if (ctx_->kernelTlsTxOffload()) {
+    enableKernelTlsTx();
+  }
   if (callbacks_->connection().streamInfo().upstreamInfo()) {
     callbacks_->connection()
         .streamInfo()
@@ -206,6 +240,46 @@ void SslSocket::onSuccess(SSL* ssl) {
 
 void SslSocket::onFailure() { drainErrorQueue(); }
 
+void SslSocket::enableKernelTlsTx() {
+  const absl::Status status = KernelTls::enableTxOffload(*rawSsl(), callbacks_->ioHandle());
+  if (!status.ok()) {
+    ENVOY_CONN_LOG(debug, "kernel TLS transmit offload not enabled: {}", callbacks_->connection(),
+                   status.message());
+    ctx_->stats().kernel_tls_tx_offload_failed_.inc();
+    return;
+  }
+  ENVOY_CONN_LOG(debug, "kernel TLS transmit offload enabled", callbacks_->connection());
+  ctx_->stats().kernel_tls_tx_offloaded_.inc();
+  kernel_tls_tx_ = true;
+}
+
+Network::IoResult SslSocket::doKernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream) {
+  PostIoAction action = PostIoAction::KeepOpen;
+  uint64_t bytes_written = 0;
+  absl::optional<Api::IoError::IoErrorCode> err;
+  while (write_buffer.length() > 0) {
+    Api::IoCallUint64Result result = callbacks_->ioHandle().write(write_buffer);
+    if (!result.ok()) {
+      ENVOY_CONN_LOG(trace, "kernel TLS write error: {}", callbacks_->connection(),
+                     result.err_->getErrorDetails());
+      if (result.err_->getErrorCode() != Api::IoError::IoErrorCode::Again) {
+        err = result.err_->getErrorCode();
+        action = PostIoAction::Close;
+      }
+      break;
+    }
+    ENVOY_CONN_LOG(trace, "kernel TLS write returns: {}", callbacks_->connection(),
+                   result.return_value_);
+    bytes_written += result.return_value_;
+  }
+
+  if (write_buffer.length() == 0 && end_stream) {
+    shutdownSsl();
+  }
+
+  return {action, bytes_written, false, err};
+}
+
 PostIoAction SslSocket::doHandshake() { return info_->doHandshake(); }
 
 void SslSocket::drainErrorQueue() {
@@ -263,12 +337,16 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
     }
   }
 
+  if (kernel_tls_tx_) {
+    return doKernelTlsWrite(write_buffer, end_stream);
+  }
+
   uint64_t bytes_to_write;
   if (bytes_to_retry_) {
     bytes_to_write = bytes_to_retry_;
     bytes_to_retry_ = 0;
   } else {
-    bytes_to_write = std::min(write_buffer.length(), static_cast<uint64_t>(16384));
+    bytes_to_write = std::min(write_buffer.length(), MaxTlsRecordSize);
   }
 
   uint64_t total_bytes_written = 0;
@@ -278,15 +356,15 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
 
     // SSL_write() requires that if a previous call returns SSL_ERROR_WANT_WRITE, we need to call
     // it again with the same parameters. This is done by tracking last write size, but not write
-    // data, since linearize() will return the same undrained data anyway.
+    // data, since recordPlaintext() will return the same undrained data anyway.
     ASSERT(bytes_to_write <= write_buffer.length());
-    int rc = SSL_write(rawSsl(), write_buffer.linearize(bytes_to_write), bytes_to_write);
+    int rc = SSL_write(rawSsl(), recordPlaintext(write_buffer, bytes_to_write), bytes_to_write);
     ENVOY_CONN_LOG(trace, "ssl write returns: {}", callbacks_->connection(), rc);
     if (rc > 0) {
       ASSERT(rc == static_cast<int>(bytes_to_write));
       total_bytes_written += rc;
       write_buffer.drain(rc);
-      bytes_to_write = std::min(write_buffer.length(), static_cast<uint64_t>(16384));
+      bytes_to_write = std::min(write_buffer.length(), MaxTlsRecordSize);
     } else {
       int err = SSL_get_error(rawSsl(), rc);
       ENVOY_CONN_LOG(trace, "ssl error occurred while write: {}", callbacks_->connection(),
@@ -321,6 +399,15 @@ void SslSocket::shutdownSsl() {
   ASSERT(info_->state() != Ssl::SocketState::PreHandshake);
   if (info_->state() != Ssl::SocketState::ShutdownSent &&
       callbacks_->connection().state() != Network::Connection::State::Closed) {
+    if (kernel_tls_tx_) {
+      // BoringSSL no longer owns the write direction, so the alert has to be sent as a kernel TLS
+      // record. As with SSL_shutdown(), failing to send it is not fatal.
+      const Api::SysCallSizeResult result = KernelTls::sendCloseNotify(callbacks_->ioHandle());
+      ENVOY_CONN_LOG(debug, "kernel TLS shutdown: rc={}", callbacks_->connection(),
+                     result.return_value_);
+      info_->setState(Ssl::SocketState::ShutdownSent);
+      return;
+    }
     int rc = SSL_shutdown(rawSsl());
     if constexpr (Event::PlatformDefaultTriggerType == Event::FileTriggerType::EmulatedEdge) {
       // Windows operate under `EmulatedEdge`. These are level events that are artificially
@@ -14,6 +14,11 @@ SslStats generateSslStats(Stats::Scope& store) {
                         POOL_HISTOGRAM_PREFIX(store, prefix))};
 }
 
+SslClientSessionCacheStats generateSslClientSessionCacheStats(Stats::Scope& store) {
+  std::string prefix("ssl.");
+  return {ALL_SSL_CLIENT_SESSION_CACHE_STATS(POOL_COUNTER_PREFIX(store, prefix))};
+}
+
 } // namespace Tls
 } // namespace TransportSockets
 } // namespace Extensions
@@ -11,6 +11,8 @@ namespace Tls {
 #define ALL_SSL_STATS(COUNTER, GAUGE, HISTOGRAM)                                                   \
   COUNTER(connection_error)                                                                        \
   COUNTER(handshake)                                                                               \
+  COUNTER(kernel_tls_tx_offload_failed)                                                            \
+  COUNTER(kernel_tls_tx_offloaded)                                                                 \
   COUNTER(session_reused)                                                                          \
   COUNTER(no_certificate)                                                                          \
   COUNTER(fail_verify_no_cert)                                                                     \
@@ -21,6 +23,7 @@ namespace Tls {
   COUNTER(ocsp_staple_omitted)                                                                     \
   COUNTER(ocsp_staple_responses)                                                                   \
   COUNTER(ocsp_staple_requests)                                                                    \
+  COUNTER(verified_cert_cache_hit)                                                                 \
   COUNTER(was_key_usage_invalid)
 
 /**
@@ -32,6 +35,19 @@ struct SslStats {
 
 SslStats generateSslStats(Stats::Scope& store);
 
+#define ALL_SSL_CLIENT_SESSION_CACHE_STATS(COUNTER)                                                \
+  COUNTER(session_cache_hit)                                                                       \
+  COUNTER(session_cache_miss)
+
+/**
+ * Wrapper struct for the session cache stats of upstream TLS contexts. @see stats_macros.h
+ */
+struct SslClientSessionCacheStats {
+  ALL_SSL_CLIENT_SESSION_CACHE_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+SslClientSessionCacheStats generateSslClientSessionCacheStats(Stats::Scope& store);
+
 } // namespace Tls
 } // namespace TransportSockets
 } // namespace Extensions
@@ -329,6 +329,10 @@ ClusterManagerImpl::ClusterManagerImpl(
     : server_(server), factory_(factory), runtime_(runtime), stats_(stats), tls_(tls),
       xds_manager_(xds_manager), random_(api.randomGenerator()),
       deferred_cluster_creation_(bootstrap.cluster_manager().enable_deferred_cluster_creation()),
+      deferred_cluster_idle_timeout_(
+          deferred_cluster_creation_
+              ? PROTOBUF_GET_OPTIONAL_MS(bootstrap.cluster_manager(), deferred_cluster_idle_timeout)
+              : absl::nullopt),
       bind_config_(bootstrap.cluster_manager().has_upstream_bind_config()
                        ? absl::make_optional(bootstrap.cluster_manager().upstream_bind_config())
                        : absl::nullopt),
@@ -707,7 +711,8 @@ ThreadLocalClusterManagerStats
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::generateStats(Stats::Scope& scope,
                                                                  const std::string& thread_name) {
   const std::string final_prefix = absl::StrCat("thread_local_cluster_manager.", thread_name);
-  return {ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(POOL_GAUGE_PREFIX(scope, final_prefix))};
+  return {ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(POOL_COUNTER_PREFIX(scope, final_prefix),
+                                                 POOL_GAUGE_PREFIX(scope, final_prefix))};
 }
 
 absl::Status ClusterManagerImpl::onClusterInit(ClusterManagerCluster& cm_cluster) {
@@ -1151,6 +1156,10 @@ ThreadLocalCluster* ClusterManagerImpl::getThreadLocalCluster(absl::string_view
 
   auto entry = cluster_manager.thread_local_clusters_.find(cluster);
   if (entry != cluster_manager.thread_local_clusters_.end()) {
+    if (cluster_manager.idle_cluster_timer_ != nullptr) {
+      entry->second->setLastUsed(
+          cluster_manager.thread_local_dispatcher_.approximateMonotonicTime());
+    }
     return entry->second.get();
   } else {
     return cluster_manager.initializeClusterInlineIfExists(cluster);
@@ -1380,29 +1389,7 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
       cluster_manager->thread_local_deferred_clusters_[info->name()] =
           cluster_initialization_object;
 
-      // Invoke similar logic of onClusterAddOrUpdate.
-      ThreadLocalClusterCommand command = [&cluster_manager,
-                                           cluster_name = info->name()]() -> ThreadLocalCluster& {
-        // If we have multiple callbacks only the first one needs to use the
-        // command to initialize the cluster.
-        auto existing_cluster_entry = cluster_manager->thread_local_clusters_.find(cluster_name);
-        if (existing_cluster_entry != cluster_manager->thread_local_clusters_.end()) {
-          return *existing_cluster_entry->second;
-        }
-
-        auto* cluster_entry = cluster_manager->initializeClusterInlineIfExists(cluster_name);
-        ASSERT(cluster_entry != nullptr, "Deferred clusters initiailization should not fail.");
-        return *cluster_entry;
-      };
-      for (auto cb_it = cluster_manager->update_callbacks_.begin();
-           cb_it != cluster_manager->update_callbacks_.end();) {
-        // The current callback may remove itself from the list, so a handle for
-        // the next item is fetched before calling the callback.
-        auto curr_cb_it = cb_it;
-        ++cb_it;
-        (*curr_cb_it)->onClusterAddOrUpdate(info->name(), command);
-      }
-
+      cluster_manager->notifyDeferredClusterAddOrUpdate(info->name());
     } else {
       // Broadcast
       ThreadLocalClusterManagerImpl::ClusterEntry* new_cluster = nullptr;
@@ -1423,6 +1410,15 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
       if (cluster_manager->thread_local_clusters_[info->name()]) {
         cluster_manager->thread_local_clusters_[info->name()]->setDropOverload(drop_overload);
         cluster_manager->thread_local_clusters_[info->name()]->setDropCategory(drop_category);
+        if (cluster_manager->idle_cluster_timer_ != nullptr) {
+          // Keep the latest CIO so that the cluster can be evicted once idle.
+          auto& cluster_entry = *cluster_manager->thread_local_clusters_[info->name()];
+          if (cluster_entry.initializationObject() == nullptr) {
+            cluster_entry.setLastUsed(
+                cluster_manager->thread_local_dispatcher_.approximateMonotonicTime());
+          }
+          cluster_entry.setInitializationObject(cluster_initialization_object);
+        }
       }
       for (const auto& per_priority : params.per_priority_update_params_) {
         cluster_manager->updateClusterMembership(
@@ -1531,6 +1527,10 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::initializeClusterInlineIfExis
   }
   thread_local_clusters_[cluster]->setDropOverload(initialization_object->drop_overload_);
   thread_local_clusters_[cluster]->setDropCategory(initialization_object->drop_category_);
+  if (idle_cluster_timer_ != nullptr) {
+    cluster_entry_ptr->setInitializationObject(initialization_object);
+    cluster_entry_ptr->setLastUsed(thread_local_dispatcher_.approximateMonotonicTime());
+  }
 
   // Remove the CIO as we've initialized the cluster.
   thread_local_deferred_clusters_.erase(entry);
@@ -1538,6 +1538,62 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::initializeClusterInlineIfExis
   return cluster_entry_ptr;
 }
 
+void ClusterManagerImpl::ThreadLocalClusterManagerImpl::notifyDeferredClusterAddOrUpdate(
+    const std::string& cluster_name) {
+  // Invoke similar logic of onClusterAddOrUpdate.
+  ThreadLocalClusterCommand command = [this, cluster_name]() -> ThreadLocalCluster& {
+    // If we have multiple callbacks only the first one needs to use the
+    // command to initialize the cluster.
+    auto existing_cluster_entry = thread_local_clusters_.find(cluster_name);
+    if (existing_cluster_entry != thread_local_clusters_.end()) {
+      return *existing_cluster_entry->second;
+    }
+
+    auto* cluster_entry = initializeClusterInlineIfExists(cluster_name);
+    ASSERT(cluster_entry != nullptr, "Deferred clusters initiailization should not fail.");
+    return *cluster_entry;
+  };
+  for (auto cb_it = update_callbacks_.begin(); cb_it != update_callbacks_.end();) {
+    // The current callback may remove itself from the list, so a handle for
+    // the next item is fetched before calling the callback.
+    auto curr_cb_it = cb_it;
+    ++cb_it;
+    (*curr_cb_it)->onClusterAddOrUpdate(cluster_name, command);
+  }
+}
+
+void ClusterManagerImpl::ThreadLocalClusterManagerImpl::evictIdleClusters() {
+  const std::chrono::milliseconds idle_timeout = parent_.deferred_cluster_idle_timeout_.value();
+  const MonotonicTime now = thread_local_dispatcher_.approximateMonotonicTime();
+  std::vector<std::string> idle_clusters;
+  for (const auto& [name, cluster_entry] : thread_local_clusters_) {
+    if (cluster_entry->initializationObject() != nullptr &&
+        now - cluster_entry->lastUsed() >= idle_timeout && !cluster_entry->hasConnections()) {
+      idle_clusters.push_back(name);
+    }
+  }
+
+  for (const std::string& name : idle_clusters) {
+    ENVOY_LOG(debug, "evicting idle TLS cluster {}", name);
+    auto it = thread_local_clusters_.find(name);
+    ClusterInitializationObjectConstSharedPtr initialization_object =
+        it->second->initializationObject();
+    // Callbacks may keep a reference to the cluster, tell them it is going away.
+    for (auto cb_it = update_callbacks_.begin(); cb_it != update_callbacks_.end();) {
+      auto curr_cb_it = cb_it;
+      ++cb_it;
+      (*curr_cb_it)->onClusterRemoval(name);
+    }
+    thread_local_clusters_.erase(name);
+    thread_local_deferred_clusters_[name] = std::move(initialization_object);
+    local_stats_.clusters_evicted_.inc();
+    local_stats_.clusters_inflated_.set(thread_local_clusters_.size());
+    notifyDeferredClusterAddOrUpdate(name);
+  }
+
+  idle_cluster_timer_->enableTimer(idle_timeout);
+}
+
 ClusterManagerImpl::ClusterInitializationObject::ClusterInitializationObject(
     const ThreadLocalClusterUpdateParams& params, ClusterInfoConstSharedPtr cluster_info,
     LoadBalancerFactorySharedPtr load_balancer_factory, HostMapConstSharedPtr map,
@@ -1693,6 +1749,19 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::drainConnP
   }
 }
 
+bool ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::hasConnections() const {
+  for (const auto& host_set : priority_set_.hostSetsPerPriority()) {
+    for (const auto& host : host_set->hosts()) {
+      if (parent_.host_http_conn_pool_map_.contains(host) ||
+          parent_.host_tcp_conn_pool_map_.contains(host) ||
+          parent_.host_tcp_conn_map_.contains(host)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::drainConnPools(
     DrainConnectionsHostPredicate predicate, ConnectionPool::DrainBehavior behavior) {
   for (auto& host_set : priority_set_.hostSetsPerPriority()) {
@@ -1863,18 +1932,18 @@ ClusterManagerImpl::dumpClusterConfigs(const Matchers::StringMatcher& name_match
   config_dump->set_version_info(cds_api_ != nullptr ? cds_api_->versionInfo() : "");
   for (const auto& active_cluster_pair : active_clusters_) {
     const auto& cluster = *active_cluster_pair.second;
-    if (!name_matcher.match(cluster.cluster_config_.name())) {
+    if (!name_matcher.match(active_cluster_pair.first)) {
       continue;
     }
     if (!cluster.added_via_api_) {
       auto& static_cluster = *config_dump->mutable_static_clusters()->Add();
-      static_cluster.mutable_cluster()->PackFrom(cluster.cluster_config_);
+      *static_cluster.mutable_cluster() = cluster.cluster_config_;
       TimestampUtil::systemClockToTimestamp(cluster.last_updated_,
                                             *(static_cluster.mutable_last_updated()));
     } else {
       auto& dynamic_cluster = *config_dump->mutable_dynamic_active_clusters()->Add();
       dynamic_cluster.set_version_info(cluster.version_info_);
-      dynamic_cluster.mutable_cluster()->PackFrom(cluster.cluster_config_);
+      *dynamic_cluster.mutable_cluster() = cluster.cluster_config_;
       TimestampUtil::systemClockToTimestamp(cluster.last_updated_,
                                             *(dynamic_cluster.mutable_last_updated()));
     }
@@ -1882,12 +1951,12 @@ ClusterManagerImpl::dumpClusterConfigs(const Matchers::StringMatcher& name_match
 
   for (const auto& warming_cluster_pair : warming_clusters_) {
     const auto& cluster = *warming_cluster_pair.second;
-    if (!name_matcher.match(cluster.cluster_config_.name())) {
+    if (!name_matcher.match(warming_cluster_pair.first)) {
       continue;
     }
     auto& dynamic_cluster = *config_dump->mutable_dynamic_warming_clusters()->Add();
     dynamic_cluster.set_version_info(cluster.version_info_);
-    dynamic_cluster.mutable_cluster()->PackFrom(cluster.cluster_config_);
+    *dynamic_cluster.mutable_cluster() = cluster.cluster_config_;
     TimestampUtil::systemClockToTimestamp(cluster.last_updated_,
                                           *(dynamic_cluster.mutable_last_updated()));
   }
@@ -1909,6 +1978,13 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ThreadLocalClusterManagerImpl
     local_priority_set_ = &thread_local_clusters_[local_cluster_name]->prioritySet();
     local_stats_.clusters_inflated_.set(thread_local_clusters_.size());
   }
+
+  // Clusters are only deferred on workers, see postThreadLocalClusterUpdate().
+  if (parent_.deferred_cluster_idle_timeout_.has_value() &&
+      !Envoy::Thread::MainThread::isMainThread()) {
+    idle_cluster_timer_ = dispatcher.createTimer([this]() { evictIdleClusters(); });
+    idle_cluster_timer_->enableTimer(parent_.deferred_cluster_idle_timeout_.value());
+  }
 }
 
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::~ThreadLocalClusterManagerImpl() {
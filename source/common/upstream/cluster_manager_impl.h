@@ -227,13 +227,15 @@ struct ClusterManagerStats {
 /**
  * All thread local cluster manager stats. @see stats_macros.h
  */
-#define ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(GAUGE) GAUGE(clusters_inflated, NeverImport)
+#define ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(COUNTER, GAUGE)                                    \
+  COUNTER(clusters_evicted)                                                                        \
+  GAUGE(clusters_inflated, NeverImport)
 
 /**
  * Struct definition for all cluster manager stats. @see stats_macros.h
  */
 struct ThreadLocalClusterManagerStats {
-  ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(GENERATE_GAUGE_STRUCT)
+  ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
 };
 
 /**
@@ -625,6 +627,19 @@ private:
         drop_category_ = drop_category;
       }
 
+      // The latest CIO of a deferred cluster, to create the cluster again once it was evicted.
+      const ClusterInitializationObjectConstSharedPtr& initializationObject() const {
+        return initialization_object_;
+      }
+      void setInitializationObject(ClusterInitializationObjectConstSharedPtr object) {
+        initialization_object_ = std::move(object);
+      }
+      MonotonicTime lastUsed() const { return last_used_; }
+      void setLastUsed(MonotonicTime last_used) { last_used_ = last_used; }
+      // Returns whether any connection pool or connection of the thread local cluster manager
+      // belongs to a host of the cluster.
+      bool hasConnections() const;
+
     private:
       Http::ConnectionPool::Instance*
       httpConnPoolImpl(HostConstSharedPtr host, ResourcePriority priority,
@@ -668,6 +683,10 @@ private:
       // If multiple bit fields are set, it is acceptable as long as the status of override host is
       // in any of these statuses.
       const HostUtility::HostStatusSet override_host_statuses_{};
+
+      // Only set for deferred clusters if deferred_cluster_idle_timeout is configured.
+      ClusterInitializationObjectConstSharedPtr initialization_object_;
+      MonotonicTime last_used_;
     };
 
     using ClusterEntryPtr = std::unique_ptr<ClusterEntry>;
@@ -714,6 +733,18 @@ private:
      */
     ClusterEntry* initializeClusterInlineIfExists(absl::string_view cluster);
 
+    /**
+     * Notifies the cluster update callbacks that the given deferred cluster was added or updated.
+     * The cluster is initialized inline once a callback uses the command.
+     */
+    void notifyDeferredClusterAddOrUpdate(const std::string& cluster_name);
+
+    /**
+     * Releases the thread local state of deferred clusters that weren't used for
+     * deferred_cluster_idle_timeout, keeping their CIO so that they can be initialized again.
+     */
+    void evictIdleClusters();
+
     OptRef<Quic::EnvoyQuicNetworkObserverRegistry> getNetworkObserverRegistry() {
       return makeOptRefFromPtr(network_observer_registry_.get());
     }
@@ -747,6 +778,8 @@ private:
     bool destroying_{};
     ClusterDiscoveryManager cdm_;
     ThreadLocalClusterManagerStats local_stats_;
+    // Periodically evicts idle deferred clusters if deferred_cluster_idle_timeout is configured.
+    Event::TimerPtr idle_cluster_timer_;
 
   private:
     static ThreadLocalClusterManagerStats generateStats(Stats::Scope& scope,
@@ -760,11 +793,12 @@ private:
                 const uint64_t cluster_config_hash, const std::string& version_info,
                 bool added_via_api, bool required_for_ads, ClusterSharedPtr&& cluster,
                 TimeSource& time_source, const bool avoid_cds_removal = false)
-        : cluster_config_(cluster_config), config_hash_(cluster_config_hash),
-          version_info_(version_info), cluster_(std::move(cluster)),
-          last_updated_(time_source.systemTime()), added_via_api_(added_via_api),
-          avoid_cds_removal_(avoid_cds_removal), added_or_updated_{},
-          required_for_ads_(required_for_ads) {}
+        : config_hash_(cluster_config_hash), version_info_(version_info),
+          cluster_(std::move(cluster)), last_updated_(time_source.systemTime()),
+          added_via_api_(added_via_api), avoid_cds_removal_(avoid_cds_removal),
+          added_or_updated_{}, required_for_ads_(required_for_ads) {
+      cluster_config_.PackFrom(cluster_config);
+    }
 
     bool blockUpdate(uint64_t hash) { return !added_via_api_ || config_hash_ == hash; }
 
@@ -784,7 +818,9 @@ private:
     }
     bool requiredForAds() const override { return required_for_ads_; }
 
-    const envoy::config::cluster::v3::Cluster cluster_config_;
+    // The configuration is only kept for config dumps, so it is kept in the serialized form of the
+    // dump, which takes much less memory than the parsed message.
+    ProtobufWkt::Any cluster_config_;
     const uint64_t config_hash_;
     const std::string version_info_;
     // Don't change the order of cluster_ and thread_aware_lb_ as the thread_aware_lb_ may
@@ -919,6 +955,7 @@ private:
   Config::XdsManager& xds_manager_;
   Random::RandomGenerator& random_;
   const bool deferred_cluster_creation_;
+  const absl::optional<std::chrono::milliseconds> deferred_cluster_idle_timeout_;
   absl::optional<envoy::config::core::v3::BindConfig> bind_config_;
   Outlier::EventLoggerSharedPtr outlier_event_logger_;
   const LocalInfo::LocalInfo& local_info_;
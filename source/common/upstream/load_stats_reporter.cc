@@ -130,10 +130,14 @@ void LoadStatsReporter::sendLoadStatsRequest() {
         }
       }
     }
-    cluster_stats->set_total_dropped_requests(
-        cluster.info()->loadReportStats().upstream_rq_dropped_.latch());
-    const uint64_t drop_overload_count =
-        cluster.info()->loadReportStats().upstream_rq_drop_overload_.latch();
+    // Nothing was dropped if the load report stats were never instantiated.
+    DeferredCreationCompatibleClusterLoadReportStats& load_report_stats =
+        cluster.info()->loadReportStats();
+    uint64_t drop_overload_count = 0;
+    if (load_report_stats.isPresent()) {
+      cluster_stats->set_total_dropped_requests(load_report_stats->upstream_rq_dropped_.latch());
+      drop_overload_count = load_report_stats->upstream_rq_drop_overload_.latch();
+    }
     if (drop_overload_count > 0) {
       auto* dropped_request = cluster_stats->add_dropped_requests();
       dropped_request->set_category(cluster.dropCategory());
@@ -228,8 +232,12 @@ void LoadStatsReporter::startLoadReportPeriod() {
         host->stats().rq_total_.latch();
       }
     }
-    cluster.info()->loadReportStats().upstream_rq_dropped_.latch();
-    cluster.info()->loadReportStats().upstream_rq_drop_overload_.latch();
+    DeferredCreationCompatibleClusterLoadReportStats& load_report_stats =
+        cluster.info()->loadReportStats();
+    if (load_report_stats.isPresent()) {
+      load_report_stats->upstream_rq_dropped_.latch();
+      load_report_stats->upstream_rq_drop_overload_.latch();
+    }
   };
   if (message_->send_all_clusters()) {
     for (const auto& p : all_clusters.active_clusters_) {
@@ -613,32 +613,24 @@ void DetectorImpl::onConsecutiveErrorWorker(HostSharedPtr host,
   }
 }
 
-DetectorImpl::EjectionPair DetectorImpl::successRateEjectionThreshold(
-    double success_rate_sum, const std::vector<HostSuccessRatePair>& valid_success_rate_hosts,
-    double success_rate_stdev_factor) {
+DetectorImpl::EjectionPair
+DetectorImpl::successRateEjectionThreshold(const SuccessRateStatistics& success_rate_statistics,
+                                           double success_rate_stdev_factor) {
   // This function is using mean and standard deviation as statistical measures for outlier
-  // detection. First the mean is calculated by dividing the sum of success rate data over the
-  // number of data points. Then variance is calculated by taking the mean of the
-  // squared difference of data points to the mean of the data. Then standard deviation is
-  // calculated by taking the square root of the variance. Then the outlier threshold is
-  // calculated as the difference between the mean and the product of the standard
-  // deviation and a constant factor.
+  // detection. The mean and the variance, the mean of the squared difference of data points to
+  // the mean of the data, are accumulated while the success rates are collected. Then standard
+  // deviation is calculated by taking the square root of the variance. Then the outlier threshold
+  // is calculated as the difference between the mean and the product of the standard deviation
+  // and a constant factor.
   //
   // For example with a data set that looks like success_rate_data = {50, 100, 100, 100, 100} the
   // math would work as follows:
-  // success_rate_sum = 450
   // mean = 90
   // variance = 400
   // stdev = 20
   // threshold returned = 52
-  double mean = success_rate_sum / valid_success_rate_hosts.size();
-  double variance = 0;
-  std::for_each(valid_success_rate_hosts.begin(), valid_success_rate_hosts.end(),
-                [&variance, mean](HostSuccessRatePair v) {
-                  variance += std::pow(v.success_rate_ - mean, 2);
-                });
-  variance /= valid_success_rate_hosts.size();
-  double stdev = std::sqrt(variance);
+  const double mean = success_rate_statistics.mean();
+  const double stdev = std::sqrt(success_rate_statistics.variance());
 
   return {mean, (mean - (success_rate_stdev_factor * stdev))};
 }
@@ -656,7 +648,7 @@ void DetectorImpl::processSuccessRateEjections(
 
   std::vector<HostSuccessRatePair> valid_success_rate_hosts;
   std::vector<HostSuccessRatePair> valid_failure_percentage_hosts;
-  double success_rate_sum = 0;
+  SuccessRateStatistics success_rate_statistics;
 
   // Reset the Detector's success rate mean and stdev.
   getSRNums(monitor_type) = {-1, -1};
@@ -692,7 +684,7 @@ void DetectorImpl::processSuccessRateEjections(
 
       if (request_volume >= success_rate_request_volume) {
         valid_success_rate_hosts.emplace_back(HostSuccessRatePair(host.first, success_rate));
-        success_rate_sum += success_rate;
+        success_rate_statistics.add(success_rate);
       }
       if (request_volume >= failure_percentage_request_volume) {
         valid_failure_percentage_hosts.emplace_back(HostSuccessRatePair(host.first, success_rate));
@@ -706,8 +698,8 @@ void DetectorImpl::processSuccessRateEjections(
         runtime_.snapshot().getInteger(SuccessRateStdevFactorRuntime,
                                        config_.successRateStdevFactor()) /
         1000.0;
-    getSRNums(monitor_type) = successRateEjectionThreshold(
-        success_rate_sum, valid_success_rate_hosts, success_rate_stdev_factor);
+    getSRNums(monitor_type) =
+        successRateEjectionThreshold(success_rate_statistics, success_rate_stdev_factor);
     const double success_rate_ejection_threshold = getSRNums(monitor_type).ejection_threshold_;
     for (const auto& host_success_rate_pair : valid_success_rate_hosts) {
       if (host_success_rate_pair.success_rate_ < success_rate_ejection_threshold) {
@@ -747,7 +739,7 @@ void DetectorImpl::processSuccessRateEjections(
 void DetectorImpl::onIntervalTimer() {
   MonotonicTime now = time_source_.monotonicTime();
 
-  for (auto host : host_monitors_) {
+  for (const auto& host : host_monitors_) {
     checkHostForUneject(host.first, host.second, now);
 
     // Need to update the writer bucket to keep the data valid.
@@ -762,7 +754,7 @@ void DetectorImpl::onIntervalTimer() {
   processSuccessRateEjections(DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin);
 
   // Decrement time backoff for all hosts which have not been ejected.
-  for (auto host : host_monitors_) {
+  for (const auto& host : host_monitors_) {
     if (!host.first->healthFlagGet(Host::HealthFlag::FAILED_OUTLIER_CHECK)) {
       auto& monitor = host.second;
       // Node is healthy and was not ejected since the last check.
@@ -866,9 +858,14 @@ void EventLoggerImpl::setCommonEventParams(envoy::data::cluster::v3::OutlierDete
 }
 
 SuccessRateAccumulatorBucket* SuccessRateAccumulator::updateCurrentWriter() {
-  // Right now current is being written to and backup is not. Flush the backup and swap.
-  backup_success_rate_bucket_->success_request_counter_ = 0;
-  backup_success_rate_bucket_->total_request_counter_ = 0;
+  // Right now current is being written to and backup is not. Flush the backup and swap. Most
+  // hosts of large clusters don't receive requests in every interval, so skip the stores to
+  // buckets that are already empty.
+  if (backup_success_rate_bucket_->success_request_counter_.load(std::memory_order_relaxed) != 0 ||
+      backup_success_rate_bucket_->total_request_counter_.load(std::memory_order_relaxed) != 0) {
+    backup_success_rate_bucket_->success_request_counter_ = 0;
+    backup_success_rate_bucket_->total_request_counter_ = 0;
+  }
 
   current_success_rate_bucket_.swap(backup_success_rate_bucket_);
 
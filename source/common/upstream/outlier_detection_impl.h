@@ -50,6 +50,29 @@ struct HostSuccessRatePair {
   double success_rate_;
 };
 
+/**
+ * Streaming mean and variance of the success rates of the hosts of a cluster, using Welford's
+ * algorithm, so that the success rates only need to be visited once.
+ */
+class SuccessRateStatistics {
+public:
+  void add(double success_rate) {
+    ++count_;
+    const double delta = success_rate - mean_;
+    mean_ += delta / count_;
+    m2_ += delta * (success_rate - mean_);
+  }
+  uint64_t count() const { return count_; }
+  double mean() const { return mean_; }
+  // The population variance, the success rates of all valid hosts are known.
+  double variance() const { return count_ == 0 ? 0 : m2_ / count_; }
+
+private:
+  uint64_t count_{0};
+  double mean_{0};
+  double m2_{0};
+};
+
 struct SuccessRateAccumulatorBucket {
   std::atomic<uint64_t> success_request_counter_;
   std::atomic<uint64_t> total_request_counter_;
@@ -402,9 +425,8 @@ public:
    * This function returns pair of double values for success rate outlier detection. The pair
    * contains the average success rate of all valid hosts in the cluster and the ejection threshold.
    * If a host's success rate is under this threshold, the host is an outlier.
-   * @param success_rate_sum is the sum of the data in the success_rate_data vector.
-   * @param valid_success_rate_hosts is the vector containing the individual success rate data
-   *        points.
+   * @param success_rate_statistics is the mean and variance of the success rates of the valid
+   *        hosts.
    * @return EjectionPair
    */
   struct EjectionPair {
@@ -412,8 +434,7 @@ public:
     double ejection_threshold_;   // ejection threshold for the cluster
   };
   static EjectionPair
-  successRateEjectionThreshold(double success_rate_sum,
-                               const std::vector<HostSuccessRatePair>& valid_success_rate_hosts,
+  successRateEjectionThreshold(const SuccessRateStatistics& success_rate_statistics,
                                double success_rate_stdev_factor);
 
   const absl::node_hash_map<HostSharedPtr, DetectorHostMonitorImpl*>& getHostMonitors() {
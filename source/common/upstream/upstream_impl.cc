@@ -1009,10 +1009,12 @@ ClusterRequestResponseSizeStats ClusterInfoImpl::generateRequestResponseSizeStat
   return {stat_names, scope};
 }
 
-ClusterLoadReportStats
-ClusterInfoImpl::generateLoadReportStats(Stats::Scope& scope,
-                                         const ClusterLoadReportStatNames& stat_names) {
-  return {stat_names, scope};
+DeferredCreationCompatibleClusterLoadReportStats
+ClusterInfoImpl::generateLoadReportStats(Stats::SymbolTable& symbol_table,
+                                         const ClusterLoadReportStatNames& stat_names,
+                                         bool defer_creation) {
+  return Stats::createDeferredCompatibleIsolatedStats<ClusterLoadReportStats>(
+      symbol_table, stat_names, defer_creation);
 }
 
 ClusterTimeoutBudgetStats
@@ -1185,10 +1187,10 @@ ClusterInfoImpl::ClusterInfoImpl(
                            *stats_scope_),
       lb_stats_(factory_context.clusterManager().clusterLbStatNames(), *stats_scope_),
       endpoint_stats_(factory_context.clusterManager().clusterEndpointStatNames(), *stats_scope_),
-      load_report_stats_store_(stats_scope_->symbolTable()),
       load_report_stats_(
-          generateLoadReportStats(*load_report_stats_store_.rootScope(),
-                                  factory_context.clusterManager().clusterLoadReportStatNames())),
+          generateLoadReportStats(stats_scope_->symbolTable(),
+                                  factory_context.clusterManager().clusterLoadReportStatNames(),
+                                  server_context.statsConfig().enableDeferredCreationStats())),
       optional_cluster_stats_((config.has_track_cluster_stats() || config.track_timeout_budgets())
                                   ? std::make_unique<OptionalClusterStats>(
                                         config, *stats_scope_, factory_context.clusterManager())
@@ -1356,6 +1358,12 @@ ClusterInfoImpl::ClusterInfoImpl(
     optional_timeouts_.set<OptionalTimeoutNames::MaxConnectionDuration>(*max_connection_duration);
   }
 
+  if (config.preconnect_policy().has_peak_demand_window()) {
+    optional_timeouts_.set<OptionalTimeoutNames::PreconnectPeakDemandWindow>(
+        std::chrono::milliseconds(DurationUtil::durationToMilliseconds(
+            config.preconnect_policy().peak_demand_window())));
+  }
+
   if (config.has_eds_cluster_config()) {
     if (config.type() != envoy::config::cluster::v3::Cluster::EDS) {
       creation_status = absl::InvalidArgumentError("eds_cluster_config set in a non-EDS cluster");
@@ -842,8 +842,9 @@ public:
   static DeferredCreationCompatibleClusterTrafficStats
   generateStats(Stats::ScopeSharedPtr scope, const ClusterTrafficStatNames& cluster_stat_names,
                 bool defer_creation);
-  static ClusterLoadReportStats
-  generateLoadReportStats(Stats::Scope& scope, const ClusterLoadReportStatNames& stat_names);
+  static DeferredCreationCompatibleClusterLoadReportStats
+  generateLoadReportStats(Stats::SymbolTable& symbol_table,
+                          const ClusterLoadReportStatNames& stat_names, bool defer_creation);
   static ClusterCircuitBreakersStats
   generateCircuitBreakersStats(Stats::Scope& scope, Stats::StatName prefix, bool track_remaining,
                                const ClusterCircuitBreakersStatNames& stat_names);
@@ -870,8 +871,13 @@ public:
   // `OptionalTimeouts` manages various `optional` values. We pack them in a separate data
   // structure for memory efficiency -- avoiding overhead of `absl::optional` per variable, and
   // avoiding overhead of storing unset timeouts.
-  enum class OptionalTimeoutNames { IdleTimeout = 0, TcpPoolIdleTimeout, MaxConnectionDuration };
-  using OptionalTimeouts = PackedStruct<std::chrono::milliseconds, 3, OptionalTimeoutNames>;
+  enum class OptionalTimeoutNames {
+    IdleTimeout = 0,
+    TcpPoolIdleTimeout,
+    MaxConnectionDuration,
+    PreconnectPeakDemandWindow
+  };
+  using OptionalTimeouts = PackedStruct<std::chrono::milliseconds, 4, OptionalTimeoutNames>;
 
   const absl::optional<std::chrono::milliseconds> idleTimeout() const override {
     auto timeout = optional_timeouts_.get<OptionalTimeoutNames::IdleTimeout>();
@@ -897,6 +903,13 @@ public:
 
   float perUpstreamPreconnectRatio() const override { return per_upstream_preconnect_ratio_; }
   float peekaheadRatio() const override { return peekahead_ratio_; }
+  const absl::optional<std::chrono::milliseconds> preconnectPeakDemandWindow() const override {
+    auto window = optional_timeouts_.get<OptionalTimeoutNames::PreconnectPeakDemandWindow>();
+    if (window.has_value()) {
+      return *window;
+    }
+    return absl::nullopt;
+  }
   uint32_t perConnectionBufferLimitBytes() const override {
     return per_connection_buffer_limit_bytes_;
   }
@@ -964,7 +977,9 @@ public:
     return std::ref(*(optional_cluster_stats_->request_response_size_stats_));
   }
 
-  ClusterLoadReportStats& loadReportStats() const override { return load_report_stats_; }
+  DeferredCreationCompatibleClusterLoadReportStats& loadReportStats() const override {
+    return load_report_stats_;
+  }
 
   ClusterTimeoutBudgetStatsOptRef timeoutBudgetStats() const override {
     if (optional_cluster_stats_ == nullptr ||
@@ -1122,8 +1137,7 @@ private:
   mutable ClusterConfigUpdateStats config_update_stats_;
   mutable ClusterLbStats lb_stats_;
   mutable ClusterEndpointStats endpoint_stats_;
-  Stats::IsolatedStoreImpl load_report_stats_store_;
-  mutable ClusterLoadReportStats load_report_stats_;
+  mutable DeferredCreationCompatibleClusterLoadReportStats load_report_stats_;
   const std::unique_ptr<OptionalClusterStats> optional_cluster_stats_;
   const uint64_t features_;
   mutable ResourceManagers resource_managers_;
@@ -13,6 +13,7 @@
 #include "source/common/grpc/typed_async_client.h"
 #include "source/common/http/utility.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/common/tracing/null_span_impl.h"
 #include "source/extensions/access_loggers/common/grpc_access_logger_clients.h"
 #include "source/extensions/access_loggers/common/grpc_access_logger_utils.h"
@@ -113,7 +114,9 @@ public:
           flush();
           flush_timer_->enableTimer(buffer_flush_interval_msec_);
         })),
-        max_buffer_size_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, buffer_size_bytes, 16384)) {
+        max_buffer_size_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, buffer_size_bytes, 16384)),
+        limit_tcp_entries_(Runtime::runtimeFeatureEnabled(
+            "envoy.reloadable_features.grpc_access_log_limit_tcp_entries")) {
     flush_timer_->enableTimer(buffer_flush_interval_msec_);
     if (access_log_prefix.has_value()) {
       stats_ = std::make_unique<GrpcAccessLoggerStats>(GrpcAccessLoggerStats{
@@ -133,6 +136,11 @@ public:
   }
 
   void log(TcpLogProto&& entry) override {
+    // Like the HTTP entries, the TCP entries are dropped rather than buffered without bound while
+    // the stream is backed up.
+    if (limit_tcp_entries_ && !canLogMore()) {
+      return;
+    }
     approximate_message_size_bytes_ += entry.ByteSizeLong();
     addEntry(std::move(entry));
     if (approximate_message_size_bytes_ >= max_buffer_size_bytes_) {
@@ -205,6 +213,7 @@ private:
   const std::chrono::milliseconds buffer_flush_interval_msec_;
   const Event::TimerPtr flush_timer_;
   const uint64_t max_buffer_size_bytes_;
+  const bool limit_tcp_entries_;
   uint64_t approximate_message_size_bytes_ = 0;
   std::unique_ptr<GrpcAccessLoggerStats> stats_ = nullptr;
 };
@@ -94,7 +94,8 @@ AggregateClusterLoadBalancer::linearizePrioritySet(OptRef<const std::string> exc
             std::make_pair(priority_in_current_cluster, tlc));
 
         priority_context->cluster_and_priority_to_linearized_priority_[std::make_pair(
-            cluster, priority_in_current_cluster)] = next_priority_after_linearizing;
+            absl::string_view(cluster), priority_in_current_cluster)] =
+            next_priority_after_linearizing;
         next_priority_after_linearizing++;
       }
       priority_in_current_cluster++;
@@ -140,7 +141,7 @@ void AggregateClusterLoadBalancer::onClusterRemoval(const std::string& cluster_n
 absl::optional<uint32_t> AggregateClusterLoadBalancer::LoadBalancerImpl::hostToLinearizedPriority(
     const Upstream::HostDescription& host) const {
   auto it = priority_context_.cluster_and_priority_to_linearized_priority_.find(
-      std::make_pair(host.cluster().name(), host.priority()));
+      std::make_pair(absl::string_view(host.cluster().name()), host.priority()));
 
   if (it != priority_context_.cluster_and_priority_to_linearized_priority_.end()) {
     return it->second;
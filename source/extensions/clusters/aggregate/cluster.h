@@ -21,8 +21,10 @@ namespace Aggregate {
 using PriorityToClusterVector = std::vector<std::pair<uint32_t, Upstream::ThreadLocalCluster*>>;
 
 // Maps pair(host_cluster_name, host_priority) to the linearized priority of the Aggregate cluster.
+// The names are views of those in the ClusterSet of the load balancer which owns the map, so that
+// looking up the priority of a host does not copy the name of its cluster.
 using ClusterAndPriorityToLinearizedPriorityMap =
-    absl::flat_hash_map<std::pair<std::string, uint32_t>, uint32_t>;
+    absl::flat_hash_map<std::pair<absl::string_view, uint32_t>, uint32_t>;
 
 struct PriorityContext {
   Upstream::PrioritySetImpl priority_set_;
@@ -134,8 +136,9 @@ private:
   Upstream::ClusterManager& cluster_manager_;
   Runtime::Loader& runtime_;
   Random::RandomGenerator& random_;
-  PriorityContextPtr priority_context_;
+  // Outlives priority_context_, whose map has views of the names.
   const ClusterSetConstSharedPtr clusters_;
+  PriorityContextPtr priority_context_;
   Upstream::ClusterUpdateCallbacksHandlePtr handle_;
   absl::flat_hash_map<std::string, Envoy::Common::CallbackHandlePtr> member_update_cbs_;
 };
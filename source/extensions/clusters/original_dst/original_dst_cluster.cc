@@ -66,6 +66,14 @@ HostSelectionResponse OriginalDstCluster::LoadBalancer::chooseHost(LoadBalancerC
         it->second->used_ = true;
         return host;
       }
+      // Check if this load balancer already created a host for the address, which the cluster
+      // has not published yet.
+      auto pending_it = pending_hosts_.find(dst_addr.asString());
+      if (pending_it != pending_hosts_.end()) {
+        ENVOY_LOG(trace, "Using pending host {} {}.", *pending_it->second,
+                  pending_it->second->address()->asString());
+        return {pending_it->second};
+      }
       // Add a new host
       const Network::Address::Ip* dst_ip = dst_addr.ip();
       if (dst_ip) {
@@ -81,6 +89,7 @@ HostSelectionResponse OriginalDstCluster::LoadBalancer::chooseHost(LoadBalancerC
                 envoy::config::core::v3::UNKNOWN, parent_->cluster_->time_source_),
             std::unique_ptr<HostImpl>)));
         ENVOY_LOG(debug, "Created host {} {}.", *host, host->address()->asString());
+        pending_hosts_.emplace(dst_addr.asString(), host);
 
         // Tell the cluster about the new host
         // lambda cannot capture a member by value.
@@ -121,6 +121,10 @@ public:
     const absl::optional<Config::MetadataKey>& metadata_key_;
     const absl::optional<uint32_t> port_override_;
     HostMultiMapConstSharedPtr host_map_;
+    // Hosts created by this load balancer which are not in host_map_. Reusing them avoids posting
+    // a new host, and so copying the host map on the main thread, for every connection to the same
+    // new address until the load balancer is replaced by one with an updated host map.
+    absl::flat_hash_map<std::string, HostSharedPtr> pending_hosts_;
   };
 
   const absl::optional<Http::LowerCaseString>& httpHeaderName() { return http_header_name_; }
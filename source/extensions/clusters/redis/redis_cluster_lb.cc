@@ -1,5 +1,6 @@
 #include "source/extensions/clusters/redis/redis_cluster_lb.h"
 
+#include <algorithm>
 #include <string>
 
 namespace Envoy {
@@ -34,9 +35,15 @@ bool RedisClusterLoadBalancerFactory::onClusterSlotUpdate(ClusterSlotsSharedPtr&
 
   auto updated_slots = std::make_shared<SlotArray>();
   auto shard_vector = std::make_shared<std::vector<RedisShardSharedPtr>>();
-  absl::flat_hash_map<std::string, uint64_t> shards;
+  absl::flat_hash_map<std::string, uint16_t> shards;
 
   for (const ClusterSlot& slot : *slots) {
+    // A range outside of the key space can only come from a misbehaving server.
+    if (slot.start() < 0 || slot.end() >= static_cast<int64_t>(MaxSlot) ||
+        slot.start() > slot.end()) {
+      continue;
+    }
+
     // look in the updated map
     const std::string primary_address = slot.primary()->asString();
 
@@ -62,48 +69,56 @@ bool RedisClusterLoadBalancerFactory::onClusterSlotUpdate(ClusterSlotsSharedPtr&
                                                               primary_and_replicas, random_));
     }
 
-    for (auto i = slot.start(); i <= slot.end(); ++i) {
-      updated_slots->at(i) = result.first->second;
-    }
+    std::fill(updated_slots->begin() + slot.start(), updated_slots->begin() + slot.end() + 1,
+              result.first->second);
   }
 
+  auto topology = std::make_shared<const Topology>(
+      Topology{std::move(updated_slots), std::move(shard_vector)});
+  current_cluster_slot_ = std::move(slots);
   {
     absl::WriterMutexLock lock(&mutex_);
-    current_cluster_slot_ = std::move(slots);
-    slot_array_ = std::move(updated_slots);
-    shard_vector_ = std::move(shard_vector);
+    topology_.swap(topology);
   }
+  // The previous topology, if no load balancer holds it anymore, is destroyed outside of the lock.
   return true;
 }
 
 void RedisClusterLoadBalancerFactory::onHostHealthUpdate() {
-  ShardVectorSharedPtr current_shard_vector;
+  TopologySharedPtr current_topology;
   {
     absl::ReaderMutexLock lock(&mutex_);
-    current_shard_vector = shard_vector_;
+    current_topology = topology_;
   }
 
   // This can get called by cluster initialization before the Redis Cluster topology is resolved.
-  if (!current_shard_vector) {
+  if (!current_topology) {
     return;
   }
 
   auto shard_vector = std::make_shared<std::vector<RedisShardSharedPtr>>();
+  shard_vector->reserve(current_topology->shard_vector_->size());
 
-  for (auto const& shard : *current_shard_vector) {
+  for (auto const& shard : *current_topology->shard_vector_) {
     shard_vector->emplace_back(std::make_shared<RedisShard>(
         shard->primary(), shard->replicas().hostsPtr(), shard->allHosts().hostsPtr(), random_));
   }
 
+  auto topology = std::make_shared<const Topology>(
+      Topology{current_topology->slot_array_, std::move(shard_vector)});
   {
     absl::WriterMutexLock lock(&mutex_);
-    shard_vector_ = std::move(shard_vector);
+    topology_.swap(topology);
   }
 }
 
 Upstream::LoadBalancerPtr RedisClusterLoadBalancerFactory::create(Upstream::LoadBalancerParams) {
-  absl::ReaderMutexLock lock(&mutex_);
-  return std::make_unique<RedisClusterLoadBalancer>(slot_array_, shard_vector_, random_);
+  TopologySharedPtr topology;
+  {
+    absl::ReaderMutexLock lock(&mutex_);
+    topology = topology_;
+  }
+  return std::make_unique<RedisClusterLoadBalancer>(std::move(topology), random_);
 }
 
 namespace {
@@ -129,7 +144,7 @@ Upstream::HostConstSharedPtr chooseRandomHost(const Upstream::HostSetImpl& host_
 Upstream::HostSelectionResponse
 RedisClusterLoadBalancerFactory::RedisClusterLoadBalancer::chooseHost(
     Envoy::Upstream::LoadBalancerContext* context) {
-  if (!slot_array_) {
+  if (!topology_) {
     return {nullptr};
   }
   absl::optional<uint64_t> hash;
@@ -141,16 +156,17 @@ RedisClusterLoadBalancerFactory::RedisClusterLoadBalancer::chooseHost(
     return {nullptr};
   }
 
+  const std::vector<RedisShardSharedPtr>& shard_vector = *topology_->shard_vector_;
   RedisShardSharedPtr shard;
   if (dynamic_cast<const RedisSpecifyShardContextImpl*>(context)) {
-    if (hash.value() < shard_vector_->size()) {
-      shard = shard_vector_->at(hash.value());
+    if (hash.value() < shard_vector.size()) {
+      shard = shard_vector[hash.value()];
     } else {
       return {nullptr};
     }
   } else {
-    shard = shard_vector_->at(
-        slot_array_->at(hash.value() % Envoy::Extensions::Clusters::Redis::MaxSlot));
+    shard = shard_vector.at(
+        (*topology_->slot_array_)[hash.value() % Envoy::Extensions::Clusters::Redis::MaxSlot]);
   }
 
   auto redis_context = dynamic_cast<RedisLoadBalancerContext*>(context);
@@ -196,15 +196,30 @@ private:
 
   using RedisShardSharedPtr = std::shared_ptr<const RedisShard>;
   using ShardVectorSharedPtr = std::shared_ptr<std::vector<RedisShardSharedPtr>>;
-  using SlotArray = std::array<uint64_t, MaxSlot>;
+  // A cluster has at most one shard per slot, so the shard indexes fit in 16 bits, keeping the
+  // array at 32KB.
+  using SlotArray = std::array<uint16_t, MaxSlot>;
   using SlotArraySharedPtr = std::shared_ptr<const SlotArray>;
 
+  /**
+   * An immutable snapshot of the topology. The slot array and the shard vector it indexes are
+   * published together, so that a load balancer never sees the slot array of one topology with
+   * the shards of another. The slot array is shared by the snapshots which only differ in the
+   * health of the hosts.
+   */
+  struct Topology {
+    SlotArraySharedPtr slot_array_;
+    ShardVectorSharedPtr shard_vector_;
+  };
+
+  using TopologySharedPtr = std::shared_ptr<const Topology>;
+
   /*
    * This class implements load balancing according to `Redis Cluster
    * <https://redis.io/topics/cluster-spec>`_. This load balancer is thread local and created
    * through the RedisClusterLoadBalancerFactory by the cluster manager.
    *
-   * The topology is stored in slot_array_ and shard_vector_. According to the
+   * The topology is stored in the slot array and the shard vector of topology_. According to the
    * `Redis Cluster Spec <https://redis.io/topics/cluster-spec#keys-distribution-model`_, the key
    * space is split into a fixed size 16384 slots. The current implementation uses a fixed size
    * std::array() of the index of the shard in the shard_vector_. This has a fixed cpu and memory
@@ -213,10 +228,8 @@ private:
    */
   class RedisClusterLoadBalancer : public Upstream::LoadBalancer {
   public:
-    RedisClusterLoadBalancer(SlotArraySharedPtr slot_array, ShardVectorSharedPtr shard_vector,
-                             Random::RandomGenerator& random)
-        : slot_array_(std::move(slot_array)), shard_vector_(std::move(shard_vector)),
-          random_(random) {}
+    RedisClusterLoadBalancer(TopologySharedPtr topology, Random::RandomGenerator& random)
+        : topology_(std::move(topology)), random_(random) {}
 
     // Upstream::LoadBalancerBase
     Upstream::HostSelectionResponse chooseHost(Upstream::LoadBalancerContext*) override;
@@ -236,15 +249,14 @@ private:
     }
 
   private:
-    const SlotArraySharedPtr slot_array_;
-    const ShardVectorSharedPtr shard_vector_;
+    const TopologySharedPtr topology_;
     Random::RandomGenerator& random_;
   };
 
+  // Only held to copy or replace the pointer, the snapshots are built outside of it.
   absl::Mutex mutex_;
-  SlotArraySharedPtr slot_array_ ABSL_GUARDED_BY(mutex_);
+  TopologySharedPtr topology_ ABSL_GUARDED_BY(mutex_);
   ClusterSlotsSharedPtr current_cluster_slot_;
-  ShardVectorSharedPtr shard_vector_;
   Random::RandomGenerator& random_;
 };
 
@@ -12,6 +12,8 @@
 #include "source/extensions/common/async_files/async_file_manager_thread_pool.h"
 #include "source/extensions/common/async_files/status_after_file_error.h"
 
+#include "absl/container/fixed_array.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Common {
@@ -149,25 +151,34 @@ public:
 
   absl::StatusOr<size_t> executeImpl() override {
     ASSERT(fileDescriptor() != -1);
-    auto slices = contents_.getRawSlices();
     size_t total_bytes_written = 0;
-    for (const auto& slice : slices) {
-      size_t slice_bytes_written = 0;
-      while (slice_bytes_written < slice.len_) {
-        auto bytes_just_written =
-            posix().pwrite(fileDescriptor(), static_cast<char*>(slice.mem_) + slice_bytes_written,
-                           slice.len_ - slice_bytes_written, offset_ + total_bytes_written);
-        if (bytes_just_written.return_value_ == -1) {
-          return statusAfterFileError(bytes_just_written);
-        }
-        slice_bytes_written += bytes_just_written.return_value_;
-        total_bytes_written += bytes_just_written.return_value_;
+    while (contents_.length() > 0) {
+      auto bytes_just_written = writeSlices(offset_ + total_bytes_written);
+      if (bytes_just_written.return_value_ == -1) {
+        return statusAfterFileError(bytes_just_written);
       }
+      contents_.drain(bytes_just_written.return_value_);
+      total_bytes_written += bytes_just_written.return_value_;
     }
     return total_bytes_written;
   }
 
 private:
+  // Writes as many slices of the contents as fit in one syscall, rather than a syscall per slice.
+  Api::SysCallSizeResult writeSlices(off_t offset) {
+    constexpr uint64_t MaxSlicesPerWrite = 64;
+    const Buffer::RawSliceVector slices = contents_.getRawSlices(MaxSlicesPerWrite);
+    if (slices.size() == 1) {
+      return posix().pwrite(fileDescriptor(), slices[0].mem_, slices[0].len_, offset);
+    }
+    absl::FixedArray<iovec> iov(slices.size());
+    for (size_t i = 0; i < slices.size(); i++) {
+      iov[i].iov_base = slices[i].mem_;
+      iov[i].iov_len = slices[i].len_;
+    }
+    return posix().pwritev(fileDescriptor(), iov.begin(), iov.size(), offset);
+  }
+
   Buffer::OwnedImpl contents_;
   const off_t offset_;
 };
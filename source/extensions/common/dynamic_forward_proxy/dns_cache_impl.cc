@@ -51,7 +51,9 @@ DnsCacheImpl::DnsCacheImpl(
       file_system_(context.serverFactoryContext().api().fileSystem()),
       validation_visitor_(context.messageValidationVisitor()),
       host_ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config, host_ttl, 300000)),
-      max_hosts_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_hosts, 1024)) {
+      max_hosts_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_hosts, 1024)),
+      worker_local_host_lookup_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.dfp_worker_local_host_lookup")) {
   tls_slot_.set([&](Event::Dispatcher&) { return std::make_shared<ThreadLocalHostInfo>(*this); });
 
   loadCacheEntries(config);
@@ -114,7 +116,12 @@ DnsCacheImpl::loadDnsCacheEntryWithForceRefresh(absl::string_view raw_host, uint
   absl::optional<DnsHostInfoSharedPtr> host_info = absl::nullopt;
   bool ignore_cached_entries = force_refresh;
 
-  {
+  // Resolved hosts are usually found in the map of the worker, without contending on the lock
+  // with the other workers.
+  if (const auto local_host = tls_host_info.resolved_hosts_.find(host);
+      local_host != tls_host_info.resolved_hosts_.end()) {
+    host_info = local_host->second;
+  } else {
     absl::ReaderMutexLock read_lock{&primary_hosts_lock_};
     is_overflow = primary_hosts_.size() >= max_hosts_;
     auto tls_host = primary_hosts_.find(host);
@@ -140,6 +147,7 @@ DnsCacheImpl::loadDnsCacheEntryWithForceRefresh(absl::string_view raw_host, uint
     }
   }
   if (is_overflow) {
+    // Not checked for hosts found in the map of the worker, which their refresh replaces.
     ENVOY_LOG(debug, "DNS cache overflow for host '{}'", host);
     stats_.host_overflow_.inc();
     return {LoadDnsCacheEntryStatus::Overflow, nullptr, absl::nullopt};
@@ -310,9 +318,14 @@ void DnsCacheImpl::removeHost(const std::string& host, const PrimaryHostInfo& pr
     primary_hosts_.erase(host_it);
   }
   // In the case of force-remove and resolve, don't cancel outstanding resolve
-  // callbacks on remove, as a resolve is pending.
+  // callbacks on remove, as a resolve is pending. The workers must stop finding the host either
+  // way.
   if (update_threads) {
-    notifyThreads(host, primary_host.host_info_);
+    notifyThreads(host, primary_host.host_info_, /*removed=*/true);
+  } else if (worker_local_host_lookup_) {
+    tls_slot_.runOnAllThreads([host](OptRef<ThreadLocalHostInfo> local_host_info) {
+      local_host_info->resolved_hosts_.erase(host);
+    });
   }
 }
 
@@ -579,8 +592,8 @@ void DnsCacheImpl::runRemoveCallbacks(const std::string& host) {
 }
 
 void DnsCacheImpl::notifyThreads(const std::string& host,
-                                 const DnsHostInfoImplSharedPtr& resolved_info) {
-  auto shared_info = std::make_shared<HostMapUpdateInfo>(host, resolved_info);
+                                 const DnsHostInfoImplSharedPtr& resolved_info, bool removed) {
+  auto shared_info = std::make_shared<HostMapUpdateInfo>(host, resolved_info, removed);
   tls_slot_.runOnAllThreads([shared_info](OptRef<ThreadLocalHostInfo> local_host_info) {
     local_host_info->onHostMapUpdate(shared_info);
   });
@@ -597,6 +610,12 @@ DnsCacheImpl::ThreadLocalHostInfo::~ThreadLocalHostInfo() {
 
 void DnsCacheImpl::ThreadLocalHostInfo::onHostMapUpdate(
     const HostMapUpdateInfoSharedPtr& resolved_host) {
+  if (resolved_host->removed_) {
+    resolved_hosts_.erase(resolved_host->host_);
+  } else if (parent_.worker_local_host_lookup_ && resolved_host->info_->firstResolveComplete()) {
+    resolved_hosts_.insert_or_assign(resolved_host->host_, resolved_host->info_);
+  }
+
   auto host_it = pending_resolutions_.find(resolved_host->host_);
   if (host_it != pending_resolutions_.end()) {
     for (auto* resolution : host_it->second) {
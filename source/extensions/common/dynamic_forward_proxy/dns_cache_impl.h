@@ -92,10 +92,12 @@ private:
   using DnsHostInfoImplSharedPtr = std::shared_ptr<DnsHostInfoImpl>;
 
   struct HostMapUpdateInfo {
-    HostMapUpdateInfo(const std::string& host, DnsHostInfoImplSharedPtr info)
-        : host_(host), info_(std::move(info)) {}
+    HostMapUpdateInfo(const std::string& host, DnsHostInfoImplSharedPtr info, bool removed)
+        : host_(host), info_(std::move(info)), removed_(removed) {}
     std::string host_;
     DnsHostInfoImplSharedPtr info_;
+    // Whether the host was removed from the cache rather than resolved.
+    const bool removed_;
   };
   using HostMapUpdateInfoSharedPtr = std::shared_ptr<HostMapUpdateInfo>;
 
@@ -105,6 +107,10 @@ private:
     ~ThreadLocalHostInfo() override;
     void onHostMapUpdate(const HostMapUpdateInfoSharedPtr& resolved_info);
     absl::flat_hash_map<std::string, std::list<LoadDnsCacheEntryHandleImpl*>> pending_resolutions_;
+    // The hosts which have completed their first resolution, looked up by the worker without
+    // taking primary_hosts_lock_. The host infos are updated in place by the main thread when the
+    // hosts are re-resolved, so the entries only change when hosts are added or removed.
+    absl::flat_hash_map<std::string, DnsHostInfoSharedPtr> resolved_hosts_;
     DnsCacheImpl& parent_;
   };
 
@@ -242,7 +248,8 @@ private:
                                       const DnsHostInfoSharedPtr& host_info,
                                       Network::DnsResolver::ResolutionStatus status);
   void runRemoveCallbacks(const std::string& host);
-  void notifyThreads(const std::string& host, const DnsHostInfoImplSharedPtr& resolved_info);
+  void notifyThreads(const std::string& host, const DnsHostInfoImplSharedPtr& resolved_info,
+                     bool removed = false);
   void onReResolveAlarm(const std::string& host);
   void removeHost(const std::string& host, const PrimaryHostInfo& host_info, bool update_threads);
   void onResolveTimeout(const std::string& host);
@@ -284,6 +291,7 @@ private:
   absl::optional<Network::Address::IpVersion>
       ip_version_to_remove_ ABSL_GUARDED_BY(ip_version_to_remove_lock_) = absl::nullopt;
   bool enable_dfp_dns_trace_;
+  const bool worker_local_host_lookup_;
 };
 
 } // namespace DynamicForwardProxy
@@ -0,0 +1,117 @@
+#include "source/extensions/common/offload/offload_pool.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "source/common/common/assert.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace Offload {
+
+namespace {
+// Tasks queued per thread of the shared pool before filters fall back to processing inline.
+constexpr uint32_t MaxQueuedPerThread = 16;
+} // namespace
+
+SINGLETON_MANAGER_REGISTRATION(offload_pool_singleton);
+
+OffloadPool::OffloadPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count,
+                         uint32_t max_queued)
+    : max_queued_(max_queued) {
+  ASSERT(thread_count > 0);
+  ENVOY_LOG(debug, "creating offload pool with {} threads", thread_count);
+  threads_.reserve(thread_count);
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    threads_.push_back(thread_factory.createThread([this]() { threadRoutine(); },
+                                                   Thread::Options{absl::StrCat("offload:", i)}));
+  }
+}
+
+OffloadPool::~OffloadPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    terminate_ = true;
+  }
+  // The queued tasks are run before the threads exit.
+  for (auto& thread : threads_) {
+    thread->join();
+  }
+}
+
+std::shared_ptr<OffloadPool> OffloadPool::singleton(Singleton::Manager& singleton_manager,
+                                                    Thread::ThreadFactory& thread_factory) {
+  return singleton_manager.getTyped<OffloadPool>(
+      SINGLETON_MANAGER_REGISTERED_NAME(offload_pool_singleton), [&thread_factory] {
+        const uint32_t thread_count = std::max(1U, std::thread::hardware_concurrency());
+        return std::make_shared<OffloadPool>(thread_factory, thread_count,
+                                             thread_count * MaxQueuedPerThread);
+      });
+}
+
+absl::optional<OffloadPool::CancelFunction>
+OffloadPool::submit(Event::Dispatcher& dispatcher, absl::AnyInvocable<void()> work,
+                    absl::AnyInvocable<void()> on_complete) {
+  ASSERT(dispatcher.isThreadSafe());
+  auto cancelled = std::make_shared<std::atomic<bool>>(false);
+  {
+    absl::MutexLock lock(&mutex_);
+    if (queue_.size() >= max_queued_) {
+      return absl::nullopt;
+    }
+    queue_.push(Task{&dispatcher, std::move(work), std::move(on_complete), cancelled});
+  }
+  return [&dispatcher, cancelled]() {
+    ASSERT(dispatcher.isThreadSafe());
+    cancelled->store(true);
+  };
+}
+
+uint32_t OffloadPool::queued() const {
+  absl::MutexLock lock(&mutex_);
+  return queue_.size();
+}
+
+void OffloadPool::threadRoutine() {
+  const auto condition = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !queue_.empty() || terminate_;
+  };
+  while (true) {
+    Task task;
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(&condition));
+      if (queue_.empty()) {
+        ASSERT(terminate_);
+        return;
+      }
+      task = std::move(queue_.front());
+      queue_.pop();
+    }
+    run(task);
+  }
+}
+
+void OffloadPool::run(Task& task) {
+  if (task.cancelled_->load()) {
+    return;
+  }
+  task.work_();
+  // The work is destroyed here rather than on the dispatcher, as it may own the data it processed.
+  task.work_ = nullptr;
+  task.dispatcher_->post([on_complete = std::move(task.on_complete_),
+                          cancelled = std::move(task.cancelled_)]() mutable {
+    // Runs on the dispatcher, which is also where the task is cancelled, so there is no race.
+    if (!cancelled->load()) {
+      on_complete();
+    }
+  });
+}
+
+} // namespace Offload
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include "envoy/event/dispatcher.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/singleton/manager.h"
+#include "envoy/thread/thread.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace Offload {
+
+/**
+ * A pool of threads running CPU heavy work off the event loops, e.g. the processing of large
+ * bodies by filters. The completion of each task runs on the dispatcher that submitted it, so that
+ * a filter can resume processing where it left off.
+ *
+ * Tasks are run in the order they are submitted, and the number of tasks queued is bounded, so
+ * that filters fall back to processing inline, keeping their usual backpressure, when the pool is
+ * saturated.
+ */
+class OffloadPool : public Singleton::Instance, protected Logger::Loggable<Logger::Id::main> {
+public:
+  // Cancels a task. Must be called on the dispatcher of the task, after which its completion
+  // doesn't run. The work of the task may still run if it already started, and the functions of
+  // a cancelled task may be destroyed on a thread of the pool.
+  using CancelFunction = absl::AnyInvocable<void()>;
+
+  OffloadPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count, uint32_t max_queued);
+  ~OffloadPool() override;
+
+  /**
+   * Returns the offload pool shared by the filters, which has a thread per hardware thread.
+   *
+   * The singleton manager doesn't keep the pool alive, it persists only as long as the returned
+   * pointer has live references.
+   */
+  static std::shared_ptr<OffloadPool> singleton(Singleton::Manager& singleton_manager,
+                                                Thread::ThreadFactory& thread_factory);
+
+  /**
+   * Submits a task. The work runs on a thread of the pool, which mustn't access the state of the
+   * dispatcher thread, and the completion is then posted to the dispatcher, which must outlive the
+   * task.
+   * @param dispatcher the dispatcher to run the completion on.
+   * @param work the work to run on a thread of the pool.
+   * @param on_complete the completion, run on the dispatcher unless the task was cancelled.
+   * @return a function cancelling the task, or absl::nullopt if the pool is saturated, in which
+   *         case the caller should do the work inline.
+   */
+  absl::optional<CancelFunction> submit(Event::Dispatcher& dispatcher,
+                                        absl::AnyInvocable<void()> work,
+                                        absl::AnyInvocable<void()> on_complete)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  /**
+   * @return the number of tasks that are queued and haven't started running.
+   */
+  uint32_t queued() const ABSL_LOCKS_EXCLUDED(mutex_);
+
+private:
+  struct Task {
+    Event::Dispatcher* dispatcher_{};
+    absl::AnyInvocable<void()> work_;
+    absl::AnyInvocable<void()> on_complete_;
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+  };
+
+  void threadRoutine() ABSL_LOCKS_EXCLUDED(mutex_);
+  void run(Task& task);
+
+  const uint32_t max_queued_;
+  mutable absl::Mutex mutex_;
+  std::queue<Task> queue_ ABSL_GUARDED_BY(mutex_);
+  bool terminate_ ABSL_GUARDED_BY(mutex_){};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+using OffloadPoolSharedPtr = std::shared_ptr<OffloadPool>;
+
+} // namespace Offload
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
@@ -1,5 +1,7 @@
 #include "source/extensions/common/proxy_protocol/proxy_protocol_header.h"
 
+#include <bitset>
+#include <cstring>
 #include <sstream>
 
 #include "envoy/buffer/buffer.h"
@@ -7,6 +9,8 @@
 
 #include "source/common/network/address_impl.h"
 
+#include "absl/container/inlined_vector.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Common {
@@ -41,61 +45,66 @@ void generateV1Header(const Network::Address::Ip& source_address,
                    source_address.port(), dest_address.port(), source_address.version(), out);
 }
 
-void generateV2Header(const std::string& src_addr, const std::string& dst_addr, uint32_t src_port,
-                      uint32_t dst_port, Network::Address::IpVersion ip_version,
-                      uint16_t extension_length, Buffer::Instance& out) {
-  out.add(PROXY_PROTO_V2_SIGNATURE, PROXY_PROTO_V2_SIGNATURE_LEN);
+namespace {
 
-  const uint8_t version_and_command = PROXY_PROTO_V2_VERSION << 4 | PROXY_PROTO_V2_ONBEHALF_OF;
-  out.add(&version_and_command, 1);
-
-  uint8_t address_family_and_protocol;
-  switch (ip_version) {
-  case Network::Address::IpVersion::v4:
-    address_family_and_protocol = PROXY_PROTO_V2_AF_INET << 4;
-    break;
-  case Network::Address::IpVersion::v6:
-    address_family_and_protocol = PROXY_PROTO_V2_AF_INET6 << 4;
-    break;
-  }
-  address_family_and_protocol |= PROXY_PROTO_V2_TRANSPORT_STREAM;
-  out.add(&address_family_and_protocol, 1);
+// Adds the v2 header up to the TLVs for addresses of the same version to `out`, all at once.
+void addV2Header(const Network::Address::Ip& src, const Network::Address::Ip& dst,
+                 uint16_t extension_length, Buffer::Instance& out) {
+  ASSERT(src.version() == dst.version());
+  uint8_t header[PROXY_PROTO_V2_HEADER_LEN + PROXY_PROTO_V2_ADDR_LEN_INET6];
+  memcpy(header, PROXY_PROTO_V2_SIGNATURE, PROXY_PROTO_V2_SIGNATURE_LEN);
+  header[12] = PROXY_PROTO_V2_VERSION << 4 | PROXY_PROTO_V2_ONBEHALF_OF;
 
   // Number of following bytes part of the header in V2 protocol.
   uint16_t addr_length;
-  uint16_t addr_length_n; // Network byte order
-
-  switch (ip_version) {
+  uint8_t* addresses = header + PROXY_PROTO_V2_HEADER_LEN;
+  switch (src.version()) {
   case Network::Address::IpVersion::v4: {
-    addr_length = PROXY_PROTO_V2_ADDR_LEN_INET + extension_length;
-    addr_length_n = htons(addr_length);
-    out.add(&addr_length_n, 2);
-    const uint32_t net_src_addr =
-        Network::Address::Ipv4Instance(src_addr, src_port).ip()->ipv4()->address();
-    const uint32_t net_dst_addr =
-        Network::Address::Ipv4Instance(dst_addr, dst_port).ip()->ipv4()->address();
-    out.add(&net_src_addr, 4);
-    out.add(&net_dst_addr, 4);
+    header[13] = PROXY_PROTO_V2_AF_INET << 4 | PROXY_PROTO_V2_TRANSPORT_STREAM;
+    addr_length = PROXY_PROTO_V2_ADDR_LEN_INET;
+    const uint32_t net_src_addr = src.ipv4()->address();
+    const uint32_t net_dst_addr = dst.ipv4()->address();
+    memcpy(addresses, &net_src_addr, 4);
+    memcpy(addresses + 4, &net_dst_addr, 4);
+    addresses += 8;
     break;
   }
   case Network::Address::IpVersion::v6: {
-    addr_length = PROXY_PROTO_V2_ADDR_LEN_INET6 + extension_length;
-    addr_length_n = htons(addr_length);
-    out.add(&addr_length_n, 2);
-    const absl::uint128 net_src_addr =
-        Network::Address::Ipv6Instance(src_addr, src_port).ip()->ipv6()->address();
-    const absl::uint128 net_dst_addr =
-        Network::Address::Ipv6Instance(dst_addr, dst_port).ip()->ipv6()->address();
-    out.add(&net_src_addr, 16);
-    out.add(&net_dst_addr, 16);
+    header[13] = PROXY_PROTO_V2_AF_INET6 << 4 | PROXY_PROTO_V2_TRANSPORT_STREAM;
+    addr_length = PROXY_PROTO_V2_ADDR_LEN_INET6;
+    const absl::uint128 net_src_addr = src.ipv6()->address();
+    const absl::uint128 net_dst_addr = dst.ipv6()->address();
+    memcpy(addresses, &net_src_addr, 16);
+    memcpy(addresses + 16, &net_dst_addr, 16);
+    addresses += 32;
     break;
   }
   }
+  const uint16_t addr_length_n = htons(addr_length + extension_length); // Network byte order
+  memcpy(header + 14, &addr_length_n, 2);
+
+  const uint16_t net_src_port = htons(static_cast<uint16_t>(src.port()));
+  const uint16_t net_dst_port = htons(static_cast<uint16_t>(dst.port()));
+  memcpy(addresses, &net_src_port, 2);
+  memcpy(addresses + 2, &net_dst_port, 2);
+  out.add(header, PROXY_PROTO_V2_HEADER_LEN + addr_length);
+}
 
-  const uint16_t net_src_port = htons(static_cast<uint16_t>(src_port));
-  const uint16_t net_dst_port = htons(static_cast<uint16_t>(dst_port));
-  out.add(&net_src_port, 2);
-  out.add(&net_dst_port, 2);
+} // namespace
+
+void generateV2Header(const std::string& src_addr, const std::string& dst_addr, uint32_t src_port,
+                      uint32_t dst_port, Network::Address::IpVersion ip_version,
+                      uint16_t extension_length, Buffer::Instance& out) {
+  switch (ip_version) {
+  case Network::Address::IpVersion::v4:
+    addV2Header(*Network::Address::Ipv4Instance(src_addr, src_port).ip(),
+                *Network::Address::Ipv4Instance(dst_addr, dst_port).ip(), extension_length, out);
+    break;
+  case Network::Address::IpVersion::v6:
+    addV2Header(*Network::Address::Ipv6Instance(src_addr, src_port).ip(),
+                *Network::Address::Ipv6Instance(dst_addr, dst_port).ip(), extension_length, out);
+    break;
+  }
 }
 
 void generateV2Header(const std::string& src_addr, const std::string& dst_addr, uint32_t src_port,
@@ -104,24 +113,55 @@ void generateV2Header(const std::string& src_addr, const std::string& dst_addr,
   generateV2Header(src_addr, dst_addr, src_port, dst_port, ip_version, 0, out);
 }
 
+namespace {
+
+// Uses the binary addresses as they are when both have the same version. Otherwise the destination
+// is parsed as an address of the version of the source, which fails as it always has.
+void addV2HeaderForAddresses(const Network::Address::Ip& src, const Network::Address::Ip& dst,
+                             uint16_t extension_length, Buffer::Instance& out) {
+  if (src.version() == dst.version()) {
+    addV2Header(src, dst, extension_length, out);
+    return;
+  }
+  generateV2Header(src.addressAsString(), dst.addressAsString(), src.port(), dst.port(),
+                   src.version(), extension_length, out);
+}
+
+} // namespace
+
 void generateV2Header(const Network::Address::Ip& source_address,
                       const Network::Address::Ip& dest_address, Buffer::Instance& out) {
-  generateV2Header(source_address.addressAsString(), dest_address.addressAsString(),
-                   source_address.port(), dest_address.port(), source_address.version(), 0, out);
+  addV2HeaderForAddresses(source_address, dest_address, 0, out);
 }
 
 bool generateV2Header(const Network::ProxyProtocolData& proxy_proto_data, Buffer::Instance& out,
                       bool pass_all_tlvs, const absl::flat_hash_set<uint8_t>& pass_through_tlvs,
                       const std::vector<Envoy::Network::ProxyProtocolTLV>& custom_tlvs) {
-  std::vector<Envoy::Network::ProxyProtocolTLV> combined_tlv_vector;
-  std::vector<Envoy::Network::ProxyProtocolTLV> final_tlvs;
-  combined_tlv_vector.reserve(custom_tlvs.size() + proxy_proto_data.tlv_vector_.size());
+  // The TLVs to write are referenced rather than copied, as this runs for every upstream
+  // connection.
+  absl::InlinedVector<const Envoy::Network::ProxyProtocolTLV*, 8> tlvs;
+  tlvs.reserve(custom_tlvs.size() + proxy_proto_data.tlv_vector_.size());
+  std::bitset<256> seen_types;
+  uint64_t extension_length = 0;
+  bool skipped_tlvs = false;
+  const auto add_tlv = [&](const Envoy::Network::ProxyProtocolTLV& tlv) {
+    seen_types.set(tlv.type);
+    // Filter out TLVs that would exceed the 65535 limit.
+    const uint64_t new_size =
+        extension_length + PROXY_PROTO_V2_TLV_TYPE_LENGTH_LEN + tlv.value.size();
+    if (new_size > std::numeric_limits<uint16_t>::max()) {
+      ENVOY_LOG_MISC(warn, "Skipping TLV type {} because adding it would exceed the 65535 limit.",
+                     tlv.type);
+      skipped_tlvs = true;
+      return;
+    }
+    extension_length = new_size;
+    tlvs.push_back(&tlv);
+  };
 
-  absl::flat_hash_set<uint8_t> seen_types;
   for (const auto& tlv : custom_tlvs) {
-    ASSERT(!seen_types.contains(tlv.type));
-    combined_tlv_vector.emplace_back(tlv);
-    seen_types.insert(tlv.type);
+    ASSERT(!seen_types.test(tlv.type));
+    add_tlv(tlv);
   }
 
   // Combine TLVs from the proxy_proto_data with the custom TLVs.
@@ -130,28 +170,12 @@ bool generateV2Header(const Network::ProxyProtocolData& proxy_proto_data, Buffer
       // Skip any TLV that is not in the set of passthrough TLVs.
       continue;
     }
-    if (seen_types.contains(tlv.type)) {
+    if (seen_types.test(tlv.type)) {
       // Skip any duplicate TLVs from being added to the combined TLV vector.
       ENVOY_LOG_EVERY_POW_2_MISC(info, "Skipping duplicate TLV type {}", tlv.type);
       continue;
     }
-    seen_types.insert(tlv.type);
-    combined_tlv_vector.emplace_back(tlv);
-  }
-
-  // Filter out TLVs that would exceed the 65535 limit.
-  uint64_t extension_length = 0;
-  bool skipped_tlvs = false;
-  for (auto&& tlv : combined_tlv_vector) {
-    uint64_t new_size = extension_length + PROXY_PROTO_V2_TLV_TYPE_LENGTH_LEN + tlv.value.size();
-    if (new_size > std::numeric_limits<uint16_t>::max()) {
-      ENVOY_LOG_MISC(warn, "Skipping TLV type {} because adding it would exceed the 65535 limit.",
-                     tlv.type);
-      skipped_tlvs = true;
-      continue;
-    }
-    extension_length = new_size;
-    final_tlvs.push_back(tlv);
+    add_tlv(tlv);
   }
 
   ASSERT(extension_length <= std::numeric_limits<uint16_t>::max());
@@ -164,16 +188,16 @@ bool generateV2Header(const Network::ProxyProtocolData& proxy_proto_data, Buffer
     return false;
   }
 
-  const auto& src = *proxy_proto_data.src_addr_->ip();
-  const auto& dst = *proxy_proto_data.dst_addr_->ip();
-  generateV2Header(src.addressAsString(), dst.addressAsString(), src.port(), dst.port(),
-                   src.version(), static_cast<uint16_t>(extension_length), out);
+  addV2HeaderForAddresses(*proxy_proto_data.src_addr_->ip(), *proxy_proto_data.dst_addr_->ip(),
+                          static_cast<uint16_t>(extension_length), out);
 
-  for (auto&& tlv : combined_tlv_vector) {
-    out.add(&tlv.type, 1);
-    uint16_t size = htons(static_cast<uint16_t>(tlv.value.size()));
-    out.add(&size, sizeof(uint16_t));
-    out.add(&tlv.value.front(), tlv.value.size());
+  for (const Envoy::Network::ProxyProtocolTLV* tlv : tlvs) {
+    uint8_t type_and_length[PROXY_PROTO_V2_TLV_TYPE_LENGTH_LEN];
+    type_and_length[0] = tlv->type;
+    const uint16_t size = htons(static_cast<uint16_t>(tlv->value.size()));
+    memcpy(type_and_length + 1, &size, sizeof(uint16_t));
+    out.add(type_and_length, PROXY_PROTO_V2_TLV_TYPE_LENGTH_LEN);
+    out.add(tlv->value.data(), tlv->value.size());
   }
 
   // return true if no TLVs were skipped, otherwise false to increment the counter
@@ -52,7 +52,10 @@ TapConfigBaseImpl::TapConfigBaseImpl(const envoy::config::tap::v3::TapConfig& pr
           proto_config.output_config(), max_buffered_rx_bytes, DefaultMaxBufferedBytes)),
       max_buffered_tx_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
           proto_config.output_config(), max_buffered_tx_bytes, DefaultMaxBufferedBytes)),
-      streaming_(proto_config.output_config().streaming()) {
+      streaming_(proto_config.output_config().streaming()),
+      tap_enabled_(proto_config.has_tap_enabled()
+                       ? absl::make_optional(proto_config.tap_enabled())
+                       : absl::nullopt) {
 
   using TsfContextRef =
       std::reference_wrapper<Server::Configuration::TransportSocketFactoryContext>;
@@ -157,9 +160,16 @@ TapConfigBaseImpl::TapConfigBaseImpl(const envoy::config::tap::v3::TapConfig& pr
     Server::Configuration::FactoryContext& http_context = absl::get<HttpContextRef>(context).get();
     server_context = &http_context.serverFactoryContext();
   }
+  runtime_ = &server_context->runtime();
   buildMatcher(match, matchers_, *server_context);
 }
 
+bool TapConfigBaseImpl::tapEnabled() const {
+  return !tap_enabled_.has_value() ||
+         runtime_->snapshot().featureEnabled(tap_enabled_->runtime_key(),
+                                             tap_enabled_->default_value());
+}
+
 const Matcher& TapConfigBaseImpl::rootMatcher() const {
   ASSERT(!matchers_.empty());
   return *matchers_[0];
@@ -3,9 +3,11 @@
 #include <fstream>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/config/core/v3/base.pb.h"
 #include "envoy/config/tap/v3/common.pb.h"
 #include "envoy/data/tap/v3/common.pb.h"
 #include "envoy/data/tap/v3/wrapper.pb.h"
+#include "envoy/runtime/runtime.h"
 
 #include "source/extensions/common/matcher/matcher.h"
 #include "source/extensions/common/tap/tap.h"
@@ -101,6 +103,12 @@ public:
   const Matcher& rootMatcher() const override;
   bool streaming() const override { return streaming_; }
 
+  /**
+   * @return whether a new stream or connection is sampled for tapping as per tap_enabled. The
+   *         streams and connections which are not sampled are neither matched nor buffered.
+   */
+  bool tapEnabled() const;
+
 protected:
   TapConfigBaseImpl(const envoy::config::tap::v3::TapConfig& proto_config,
                     Common::Tap::Sink* admin_streamer, SinkContext context);
@@ -113,6 +121,8 @@ private:
   const uint32_t max_buffered_rx_bytes_;
   const uint32_t max_buffered_tx_bytes_;
   const bool streaming_;
+  const absl::optional<envoy::config::core::v3::RuntimeFractionalPercent> tap_enabled_;
+  Runtime::Loader* runtime_{};
   Sink* sink_to_use_;
   SinkPtr sink_;
   envoy::config::tap::v3::OutputSink::Format sink_format_;
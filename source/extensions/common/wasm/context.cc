@@ -832,9 +832,9 @@ BufferInterface* Context::getBuffer(WasmBufferType type) {
   case WasmBufferType::HttpCallResponseBody:
     response = rootContext()->http_call_response_;
     if (response) {
-      auto& body = (*response)->body();
-      return buffer_.set(
-          std::string_view(static_cast<const char*>(body.linearize(body.length())), body.length()));
+      // The body is copied into the VM from its slices, rather than linearized first.
+      const ::Envoy::Buffer::Instance& body = (*response)->body();
+      return buffer_.set(&body);
     }
     return nullptr;
   case WasmBufferType::GrpcReceiveBuffer:
@@ -1,5 +1,7 @@
 #include "source/extensions/compression/brotli/compressor/config.h"
 
+#include <algorithm>
+
 namespace Envoy {
 namespace Extensions {
 namespace Compression {
@@ -22,6 +24,13 @@ Envoy::Compression::Compressor::CompressorPtr BrotliCompressorFactory::createCom
                                                 chunk_size_);
 }
 
+Envoy::Compression::Compressor::CompressorPtr BrotliCompressorFactory::createLowEffortCompressor() {
+  return std::make_unique<BrotliCompressorImpl>(std::min(quality_, LowEffortQuality), window_bits_,
+                                                input_block_bits_,
+                                                disable_literal_context_modeling_, encoder_mode_,
+                                                chunk_size_);
+}
+
 BrotliCompressorImpl::EncoderMode BrotliCompressorFactory::encoderModeEnum(
     envoy::extensions::compression::brotli::compressor::v3::Brotli::EncoderMode encoder_mode) {
   switch (encoder_mode) {
@@ -23,6 +23,9 @@ const uint32_t DefaultWindowBits = 18;
 // Default quality.
 const uint32_t DefaultQuality = 3;
 
+// Quality of the compressors used under CPU pressure.
+const uint32_t LowEffortQuality = 1;
+
 // Default zlib chunk size.
 const uint32_t DefaultChunkSize = 4096;
 
@@ -42,6 +45,7 @@ public:
 
   // Envoy::Compression::Compressor::CompressorFactory
   Envoy::Compression::Compressor::CompressorPtr createCompressor() override;
+  Envoy::Compression::Compressor::CompressorPtr createLowEffortCompressor() override;
   const std::string& statsPrefix() const override { return brotliStatsPrefix(); }
   const std::string& contentEncoding() const override {
     return Http::CustomHeaders::get().ContentEncodingValues.Brotli;
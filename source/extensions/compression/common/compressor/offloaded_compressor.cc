@@ -0,0 +1,69 @@
+#include "source/extensions/compression/common/compressor/offloaded_compressor.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Common {
+namespace Compressor {
+
+OffloadedCompressor::OffloadedCompressor(Envoy::Compression::Compressor::CompressorPtr compressor,
+                                         Extensions::Common::Offload::OffloadPoolSharedPtr pool,
+                                         Event::Dispatcher& dispatcher)
+    : compressor_(std::move(compressor)), pool_(std::move(pool)), dispatcher_(dispatcher),
+      inline_completion_(dispatcher.createSchedulableCallback([this]() {
+        auto chunk = std::move(inline_chunk_);
+        complete(*chunk);
+      })) {
+  ASSERT(compressor_ != nullptr);
+}
+
+OffloadedCompressor::~OffloadedCompressor() {
+  if (cancel_.has_value()) {
+    (*cancel_)();
+  }
+}
+
+void OffloadedCompressor::compress(Buffer::Instance& data,
+                                   Envoy::Compression::Compressor::State state, Done done) {
+  ASSERT(done_ == nullptr);
+  done_ = std::move(done);
+  // The chunk is copied rather than moved to the pool, as the slices of the stream may carry
+  // memory accounts, drain trackers and fragments which are only safe to touch on the worker.
+  auto chunk = std::make_shared<Buffer::OwnedImpl>();
+  chunk->add(data);
+  data.drain(data.length());
+
+  cancel_ = pool_->submit(
+      dispatcher_,
+      [compressor = compressor_, chunk, state]() { compressor->compress(*chunk, state); },
+      [this, chunk]() {
+        cancel_.reset();
+        complete(*chunk);
+      });
+  if (cancel_.has_value()) {
+    return;
+  }
+  // The pool is saturated, hence the chunk is compressed inline, but still completed
+  // asynchronously as callers expect.
+  compressor_->compress(*chunk, state);
+  inline_chunk_ = std::move(chunk);
+  inline_completion_->scheduleCallbackCurrentIteration();
+}
+
+void OffloadedCompressor::complete(Buffer::Instance& compressed) {
+  auto result = std::make_unique<Buffer::OwnedImpl>();
+  result->move(compressed);
+  // The callback may pass the next chunk, or destroy the compressor.
+  Done done = std::move(done_);
+  done_ = nullptr;
+  done(std::move(result));
+}
+
+} // namespace Compressor
+} // namespace Common
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
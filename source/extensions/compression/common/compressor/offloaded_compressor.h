@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+
+#include "envoy/compression/compressor/async_compressor.h"
+#include "envoy/compression/compressor/compressor.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/schedulable_cb.h"
+
+#include "source/extensions/common/offload/offload_pool.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Common {
+namespace Compressor {
+
+/**
+ * Asynchronous compressor running a synchronous compressor on an offload pool, so that the
+ * compression doesn't hold up the worker. When the pool is saturated, the chunks are compressed
+ * inline, their callback being called on the next iteration of the dispatcher.
+ */
+class OffloadedCompressor : public Envoy::Compression::Compressor::AsyncCompressor {
+public:
+  OffloadedCompressor(Envoy::Compression::Compressor::CompressorPtr compressor,
+                      Extensions::Common::Offload::OffloadPoolSharedPtr pool,
+                      Event::Dispatcher& dispatcher);
+  ~OffloadedCompressor() override;
+
+  // Envoy::Compression::Compressor::AsyncCompressor
+  void compress(Buffer::Instance& data, Envoy::Compression::Compressor::State state,
+                Done done) override;
+
+private:
+  void complete(Buffer::Instance& compressed);
+
+  // Shared with the work in flight, which may still run once the compressor is destroyed.
+  const std::shared_ptr<Envoy::Compression::Compressor::Compressor> compressor_;
+  const Extensions::Common::Offload::OffloadPoolSharedPtr pool_;
+  Event::Dispatcher& dispatcher_;
+  absl::optional<Extensions::Common::Offload::OffloadPool::CancelFunction> cancel_;
+  // The callback of the chunk being compressed.
+  Done done_;
+  // The chunk compressed inline when the pool is saturated, completed by inline_completion_.
+  std::shared_ptr<Buffer::Instance> inline_chunk_;
+  const Event::SchedulableCallbackPtr inline_completion_;
+};
+
+} // namespace Compressor
+} // namespace Common
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
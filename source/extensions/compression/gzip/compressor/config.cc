@@ -65,6 +65,13 @@ Envoy::Compression::Compressor::CompressorPtr GzipCompressorFactory::createCompr
   return compressor;
 }
 
+Envoy::Compression::Compressor::CompressorPtr GzipCompressorFactory::createLowEffortCompressor() {
+  auto compressor = std::make_unique<ZlibCompressorImpl>(chunk_size_);
+  compressor->init(ZlibCompressorImpl::CompressionLevel::Speed, compression_strategy_,
+                   window_bits_, memory_level_);
+  return compressor;
+}
+
 Envoy::Compression::Compressor::CompressorFactoryPtr
 GzipCompressorLibraryFactory::createCompressorFactoryFromProtoTyped(
     const envoy::extensions::compression::gzip::compressor::v3::Gzip& proto_config,
@@ -20,7 +20,8 @@ ZlibCompressorImpl::ZlibCompressorImpl(uint64_t chunk_size)
     : Common::Base(chunk_size, [](z_stream* z) {
         deflateEnd(z);
         delete z;
-      }) {
+      }),
+      chunk_char_ptr_(new unsigned char[chunk_size]) {
   zstream_ptr_->zalloc = Z_NULL;
   zstream_ptr_->zfree = Z_NULL;
   zstream_ptr_->opaque = Z_NULL;
@@ -84,6 +85,17 @@ void ZlibCompressorImpl::process(Buffer::Instance& output_buffer, int64_t flush_
   }
 }
 
+void ZlibCompressorImpl::updateOutput(Buffer::Instance& output_buffer) {
+  const uint64_t n_output = chunk_size_ - zstream_ptr_->avail_out;
+  if (n_output == 0) {
+    return;
+  }
+
+  output_buffer.add(static_cast<void*>(chunk_char_ptr_.get()), n_output);
+  zstream_ptr_->avail_out = chunk_size_;
+  zstream_ptr_->next_out = chunk_char_ptr_.get();
+}
+
 } // namespace Compressor
 } // namespace Gzip
 } // namespace Compression
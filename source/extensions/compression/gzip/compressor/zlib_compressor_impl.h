@@ -88,6 +88,9 @@ public:
 private:
   bool deflateNext(int64_t flush_state);
   void process(Buffer::Instance& output_buffer, int64_t flush_state);
+  void updateOutput(Buffer::Instance& output_buffer);
+
+  const std::unique_ptr<unsigned char[]> chunk_char_ptr_;
 };
 
 } // namespace Compressor
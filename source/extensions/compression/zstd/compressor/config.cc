@@ -1,5 +1,7 @@
 #include "source/extensions/compression/zstd/compressor/config.h"
 
+#include <algorithm>
+
 namespace Envoy {
 namespace Extensions {
 namespace Compression {
@@ -13,7 +15,14 @@ ZstdCompressorFactory::ZstdCompressorFactory(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(zstd, compression_level, ZSTD_CLEVEL_DEFAULT)),
       enable_checksum_(zstd.enable_checksum()), strategy_(zstd.strategy()),
       chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(zstd, chunk_size, ZSTD_CStreamOutSize())) {
-  if (zstd.has_dictionary()) {
+  if (zstd.shared_dictionary()) {
+    if (!zstd.has_dictionary()) {
+      throwEnvoyExceptionOrPanic("zstd shared_dictionary requires a dictionary");
+    }
+    const std::string dictionary = THROW_OR_RETURN_VALUE(
+        Config::DataSource::read(zstd.dictionary(), false, api), std::string);
+    shared_dictionary_ = std::make_unique<ZstdSharedDictionary>(dictionary, compression_level_);
+  } else if (zstd.has_dictionary()) {
     Protobuf::RepeatedPtrField<envoy::config::core::v3::DataSource> dictionaries;
     dictionaries.Add()->CopyFrom(zstd.dictionary());
     cdict_manager_ = std::make_unique<ZstdCDictManager>(
@@ -26,6 +35,20 @@ ZstdCompressorFactory::ZstdCompressorFactory(
 
 Envoy::Compression::Compressor::CompressorPtr ZstdCompressorFactory::createCompressor() {
   return std::make_unique<ZstdCompressorImpl>(compression_level_, enable_checksum_, strategy_,
+                                              cdict_manager_, chunk_size_,
+                                              shared_dictionary_.get());
+}
+
+Envoy::Compression::Compressor::CompressorPtr ZstdCompressorFactory::createLowEffortCompressor() {
+  if (cdict_manager_ != nullptr || shared_dictionary_ != nullptr) {
+    // The compression level of dictionaries is set when they're loaded.
+    return createCompressor();
+  }
+  // Level 0 stands for the default level.
+  const uint32_t compression_level = compression_level_ == 0
+                                         ? LowEffortCompressionLevel
+                                         : std::min(compression_level_, LowEffortCompressionLevel);
+  return std::make_unique<ZstdCompressorImpl>(compression_level, enable_checksum_, strategy_,
                                               cdict_manager_, chunk_size_);
 }
 
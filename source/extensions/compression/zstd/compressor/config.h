@@ -14,6 +14,9 @@ namespace Compression {
 namespace Zstd {
 namespace Compressor {
 
+// Compression level of the compressors used under CPU pressure.
+const uint32_t LowEffortCompressionLevel = 1;
+
 namespace {
 
 const std::string& zstdStatsPrefix() { CONSTRUCT_ON_FIRST_USE(std::string, "zstd."); }
@@ -31,9 +34,15 @@ public:
 
   // Envoy::Compression::Compressor::CompressorFactory
   Envoy::Compression::Compressor::CompressorPtr createCompressor() override;
+  Envoy::Compression::Compressor::CompressorPtr createLowEffortCompressor() override;
   const std::string& statsPrefix() const override { return zstdStatsPrefix(); }
   const std::string& contentEncoding() const override {
-    return Http::CustomHeaders::get().ContentEncodingValues.Zstd;
+    return shared_dictionary_ != nullptr
+               ? Http::CustomHeaders::get().ContentEncodingValues.DictionaryZstd
+               : Http::CustomHeaders::get().ContentEncodingValues.Zstd;
+  }
+  absl::string_view sharedDictionaryHash() const override {
+    return shared_dictionary_ != nullptr ? shared_dictionary_->hash() : absl::string_view();
   }
 
 private:
@@ -42,6 +51,7 @@ private:
   const uint32_t strategy_;
   const uint32_t chunk_size_;
   ZstdCDictManagerPtr cdict_manager_{nullptr};
+  ZstdSharedDictionaryPtr shared_dictionary_;
 };
 
 class ZstdCompressorLibraryFactory
@@ -1,18 +1,55 @@
 #include "source/extensions/compression/zstd/compressor/zstd_compressor_impl.h"
 
+#include "envoy/common/exception.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/base64.h"
+#include "source/common/crypto/utility.h"
+
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Compression {
 namespace Zstd {
 namespace Compressor {
 
+namespace {
+// The magic number and the size of the skippable frame opening dcz streams, in little endian.
+constexpr absl::string_view DczMagicAndFrameSize{"\x5e\x2a\x4d\x18\x20\x00\x00\x00", 8};
+} // namespace
+
+ZstdSharedDictionary::ZstdSharedDictionary(absl::string_view dictionary,
+                                           uint32_t compression_level)
+    : cdict_(nullptr, &ZSTD_freeCDict) {
+  // Clients load shared dictionaries as raw content, while zstd would parse a trained dictionary.
+  if (ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size()) != 0) {
+    throwEnvoyExceptionOrPanic("zstd shared dictionaries must be raw content, not trained "
+                               "dictionaries");
+  }
+  cdict_.reset(ZSTD_createCDict(dictionary.data(), dictionary.size(), compression_level));
+  RELEASE_ASSERT(cdict_ != nullptr, "");
+
+  const std::vector<uint8_t> digest =
+      Envoy::Common::Crypto::UtilitySingleton::get().getSha256Digest(
+          Buffer::OwnedImpl(dictionary));
+  const absl::string_view digest_view(reinterpret_cast<const char*>(digest.data()),
+                                      digest.size());
+  hash_ = absl::StrCat(":", Base64::encode(digest_view.data(), digest_view.size()), ":");
+  stream_header_ = absl::StrCat(DczMagicAndFrameSize, digest_view);
+}
+
 ZstdCompressorImpl::ZstdCompressorImpl(uint32_t compression_level, bool enable_checksum,
                                        uint32_t strategy, const ZstdCDictManagerPtr& cdict_manager,
-                                       uint32_t chunk_size)
+                                       uint32_t chunk_size,
+                                       const ZstdSharedDictionary* shared_dictionary)
     : ZstdCompressorImplBase(compression_level, enable_checksum, strategy, chunk_size),
-      cdict_manager_(cdict_manager) {
+      cdict_manager_(cdict_manager), shared_dictionary_(shared_dictionary),
+      stream_header_pending_(shared_dictionary != nullptr) {
   size_t result;
-  if (cdict_manager_) {
+  if (shared_dictionary_ != nullptr) {
+    result = ZSTD_CCtx_refCDict(cctx_.get(), shared_dictionary_->cdict());
+  } else if (cdict_manager_) {
     ZSTD_CDict* cdict = cdict_manager_->getFirstDictionary();
     result = ZSTD_CCtx_refCDict(cctx_.get(), cdict);
   } else {
@@ -31,7 +68,12 @@ void ZstdCompressorImpl::compressProcess(const Buffer::Instance&,
   process(accumulation_buffer, ZSTD_e_continue);
 }
 
-void ZstdCompressorImpl::compressPostprocess(Buffer::Instance&) {}
+void ZstdCompressorImpl::compressPostprocess(Buffer::Instance& accumulation_buffer) {
+  if (stream_header_pending_) {
+    accumulation_buffer.prepend(shared_dictionary_->streamHeader());
+    stream_header_pending_ = false;
+  }
+}
 
 } // namespace Compressor
 } // namespace Zstd
@@ -16,13 +16,37 @@ using ZstdCDictManager =
     Common::DictionaryManager<ZSTD_CDict, ZSTD_freeCDict, ZSTD_getDictID_fromCDict>;
 using ZstdCDictManagerPtr = std::unique_ptr<ZstdCDictManager>;
 
+/**
+ * A raw dictionary shared with clients, which the Dictionary-Compressed Zstandard (dcz) streams
+ * compressed with it identify by its SHA-256 hash.
+ */
+class ZstdSharedDictionary : NonCopyable {
+public:
+  ZstdSharedDictionary(absl::string_view dictionary, uint32_t compression_level);
+
+  const ZSTD_CDict* cdict() const { return cdict_.get(); }
+
+  // The hash of the dictionary in the form of the Available-Dictionary header value.
+  const std::string& hash() const { return hash_; }
+
+  // The header of the dcz streams, a skippable zstd frame holding the hash of the dictionary.
+  const std::string& streamHeader() const { return stream_header_; }
+
+private:
+  std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)> cdict_;
+  std::string hash_;
+  std::string stream_header_;
+};
+using ZstdSharedDictionaryPtr = std::unique_ptr<ZstdSharedDictionary>;
+
 /**
  * Implementation of compressor's interface.
  */
 class ZstdCompressorImpl : public Envoy::Compression::Zstd::Compressor::ZstdCompressorImplBase {
 public:
   ZstdCompressorImpl(uint32_t compression_level, bool enable_checksum, uint32_t strategy,
-                     const ZstdCDictManagerPtr& cdict_manager, uint32_t chunk_size);
+                     const ZstdCDictManagerPtr& cdict_manager, uint32_t chunk_size,
+                     const ZstdSharedDictionary* shared_dictionary = nullptr);
 
 private:
   void compressPreprocess(Buffer::Instance& buffer,
@@ -34,6 +58,8 @@ private:
   void compressPostprocess(Buffer::Instance& accumulation_buffer) override;
 
   const ZstdCDictManagerPtr& cdict_manager_;
+  const ZstdSharedDictionary* shared_dictionary_;
+  bool stream_header_pending_;
 };
 
 } // namespace Compressor
@@ -3,6 +3,7 @@
 #include "envoy/service/discovery/v3/discovery.pb.h"
 
 #include "source/common/config/decoded_resource_impl.h"
+#include "source/common/common/hash.h"
 #include "source/common/config/utility.h"
 #include "source/common/memory/utils.h"
 #include "source/common/protobuf/protobuf.h"
@@ -406,7 +407,13 @@ void GrpcMuxImpl::onDiscoveryResponse(
   same_type_resume = pause(type_url);
   TRY_ASSERT_MAIN_THREAD {
     std::vector<DecodedResourcePtr> resources;
-    OpaqueResourceDecoder& resource_decoder = *api_state.watches_.front()->resource_decoder_;
+    const OpaqueResourceDecoderSharedPtr& resource_decoder =
+        api_state.watches_.front()->resource_decoder_;
+    if (resource_decoder != api_state.decoded_resources_decoder_) {
+      api_state.decoded_resources_.clear();
+      api_state.decoded_resources_decoder_ = resource_decoder;
+    }
+    absl::flat_hash_map<uint64_t, DecodedResourceCacheEntry> decoded_resources;
 
     for (const auto& resource : message->resources()) {
       // TODO(snowp): Check the underlying type when the resource is a Resource.
@@ -417,14 +424,16 @@ void GrpcMuxImpl::onDiscoveryResponse(
                         resource.type_url(), type_url, message->DebugString()));
       }
 
-      auto decoded_resource = THROW_OR_RETURN_VALUE(
-          DecodedResourceImpl::fromResource(resource_decoder, resource, message->version_info()),
-          DecodedResourceImplPtr);
+      DecodedResourcePtr decoded_resource = decodeResource(
+          api_state, *resource_decoder, resource, message->version_info(), decoded_resources);
 
       if (!isHeartbeatResource(type_url, *decoded_resource)) {
         resources.emplace_back(std::move(decoded_resource));
       }
     }
+    // Only the resources of this response are kept, so that the cache does not outgrow the
+    // resources which the server currently sends.
+    api_state.decoded_resources_ = std::move(decoded_resources);
 
     processDiscoveryResources(resources, api_state, type_url, message->version_info(),
                               /*call_delegate=*/true);
@@ -455,6 +464,35 @@ void GrpcMuxImpl::onDiscoveryResponse(
   queueDiscoveryRequest(type_url);
 }
 
+DecodedResourcePtr GrpcMuxImpl::decodeResource(
+    const ApiState& api_state, OpaqueResourceDecoder& resource_decoder,
+    const ProtobufWkt::Any& resource, const std::string& version,
+    absl::flat_hash_map<uint64_t, DecodedResourceCacheEntry>& decoded_resources) {
+  // Resources wrapped in a Resource carry a TTL and metadata which are not cached.
+  if (resource.Is<envoy::service::discovery::v3::Resource>() ||
+      !Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.xds_sotw_reuse_unchanged_resources")) {
+    return THROW_OR_RETURN_VALUE(
+        DecodedResourceImpl::fromResource(resource_decoder, resource, version),
+        DecodedResourceImplPtr);
+  }
+
+  // Hashing the encoded resource is much cheaper than decoding and validating it.
+  const uint64_t hash =
+      HashUtil::xxHash64(resource.value(), HashUtil::xxHash64(resource.type_url()));
+  if (const auto it = api_state.decoded_resources_.find(hash);
+      it != api_state.decoded_resources_.end()) {
+    decoded_resources.emplace(hash, it->second);
+    return std::make_unique<DecodedResourceImpl>(it->second.resource_, it->second.name_, version);
+  }
+  DecodedResourceImplPtr decoded_resource = THROW_OR_RETURN_VALUE(
+      DecodedResourceImpl::fromResource(resource_decoder, resource, version),
+      DecodedResourceImplPtr);
+  decoded_resources.emplace(hash, DecodedResourceCacheEntry{decoded_resource->sharedResource(),
+                                                            decoded_resource->name()});
+  return decoded_resource;
+}
+
 void GrpcMuxImpl::processDiscoveryResources(const std::vector<DecodedResourcePtr>& resources,
                                             ApiState& api_state, const std::string& type_url,
                                             const std::string& version_info,
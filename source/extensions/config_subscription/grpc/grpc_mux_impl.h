@@ -29,6 +29,7 @@
 #include "source/extensions/config_subscription/grpc/grpc_mux_context.h"
 #include "source/extensions/config_subscription/grpc/grpc_mux_failover.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "xds/core/v3/resource_name.pb.h"
 
@@ -235,6 +236,11 @@ private:
     EdsResourcesCacheOptRef eds_resources_cache_;
   };
 
+  struct DecodedResourceCacheEntry {
+    std::shared_ptr<const Protobuf::Message> resource_;
+    std::string name_;
+  };
+
   // Per muxed API state.
   struct ApiState {
     ApiState(Event::Dispatcher& dispatcher,
@@ -261,6 +267,12 @@ private:
     std::string control_plane_identifier_{};
     // If true, xDS resources were previously fetched from an xDS source or an xDS delegate.
     bool previously_fetched_data_{false};
+    // The resources decoded from the most recent response, keyed by the hash of their encoded
+    // form, so that the resources which the next response repeats are not decoded and validated
+    // again.
+    absl::flat_hash_map<uint64_t, DecodedResourceCacheEntry> decoded_resources_;
+    // The decoder which produced decoded_resources_.
+    OpaqueResourceDecoderSharedPtr decoded_resources_decoder_;
   };
 
   bool isHeartbeatResource(const std::string& type_url, const DecodedResource& resource) {
@@ -276,6 +288,13 @@ private:
   void loadConfigFromDelegate(const std::string& type_url,
                               const absl::flat_hash_set<std::string>& resource_names);
   // Must be invoked from the main or test thread.
+  // Decodes a resource of a state-of-the-world response, or reuses the message decoded for the
+  // same encoded resource in the previous response.
+  DecodedResourcePtr decodeResource(const ApiState& api_state,
+                                    OpaqueResourceDecoder& resource_decoder,
+                                    const ProtobufWkt::Any& resource, const std::string& version,
+                                    absl::flat_hash_map<uint64_t, DecodedResourceCacheEntry>&
+                                        decoded_resources);
   void processDiscoveryResources(const std::vector<DecodedResourcePtr>& resources,
                                  ApiState& api_state, const std::string& type_url,
                                  const std::string& version_info, bool call_delegate);
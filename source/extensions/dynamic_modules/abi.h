@@ -630,6 +630,32 @@ bool envoy_dynamic_module_callback_http_set_response_trailer(
     envoy_dynamic_module_type_buffer_module_ptr key, size_t key_length,
     envoy_dynamic_module_type_buffer_module_ptr value, size_t value_length);
 
+/**
+ * envoy_dynamic_module_callback_http_set_request_headers is called by the module to set multiple
+ * request headers at once. Each header is set exactly as if
+ * envoy_dynamic_module_callback_http_set_request_header were called with it, in the order of the
+ * given array, but without crossing the ABI boundary once per header.
+ *
+ * @param filter_envoy_ptr is the pointer to the DynamicModuleHttpFilter object of the
+ * corresponding HTTP filter.
+ * @param headers_vector is the array of envoy_dynamic_module_type_module_http_header to set. A
+ * header whose value_ptr is null is removed.
+ * @param headers_vector_size is the size of the headers_vector.
+ * @return true if the operation is successful, false otherwise.
+ */
+bool envoy_dynamic_module_callback_http_set_request_headers(
+    envoy_dynamic_module_type_http_filter_envoy_ptr filter_envoy_ptr,
+    envoy_dynamic_module_type_module_http_header* headers_vector, size_t headers_vector_size);
+
+/**
+ * envoy_dynamic_module_callback_http_set_response_headers is exactly the same as the
+ * envoy_dynamic_module_callback_http_set_request_headers, but for the response headers.
+ * See the comments on envoy_dynamic_module_callback_http_set_request_headers for more details.
+ */
+bool envoy_dynamic_module_callback_http_set_response_headers(
+    envoy_dynamic_module_type_http_filter_envoy_ptr filter_envoy_ptr,
+    envoy_dynamic_module_type_module_http_header* headers_vector, size_t headers_vector_size);
+
 /**
  * envoy_dynamic_module_callback_http_send_response is called by the module to send the response
  * to the downstream.
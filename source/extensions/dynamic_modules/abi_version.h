@@ -6,7 +6,7 @@ namespace DynamicModules {
 #endif
 // This is the ABI version calculated as a sha256 hash of the ABI header files. When the ABI
 // changes, this value must change, and the correctness of this value is checked by the test.
-const char* kAbiVersion = "597edaf69df3725fab3936e15a0fc3a8c23a0da209671221f4a21e56bd4598b1";
+const char* kAbiVersion = "5c0cb493068f6991236ea9c21e3dbf3031537283dda64032fd6cf6ab4b493d7d";
 
 #ifdef __cplusplus
 } // namespace DynamicModules
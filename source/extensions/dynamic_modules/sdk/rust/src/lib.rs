@@ -255,6 +255,14 @@ pub trait EnvoyHttpFilter {
   /// Returns true if the header is removed successfully.
   fn remove_request_header(&mut self, key: &str) -> bool;
 
+  /// Set multiple request headers at once.
+  ///
+  /// This is equivalent to calling [`EnvoyHttpFilter::set_request_header`] for each of the given
+  /// key-value pairs in order, but crosses the ABI boundary only once.
+  ///
+  /// Returns true if the headers are set successfully.
+  fn set_request_headers<'a>(&mut self, headers: Vec<(&'a str, &'a [u8])>) -> bool;
+
   /// Get the value of the request trailer with the given key.
   /// If the trailer is not found, this returns `None`.
   ///
@@ -319,6 +327,14 @@ pub trait EnvoyHttpFilter {
   /// Returns true if the header is removed successfully.
   fn remove_response_header(&mut self, key: &str) -> bool;
 
+  /// Set multiple response headers at once.
+  ///
+  /// This is equivalent to calling [`EnvoyHttpFilter::set_response_header`] for each of the given
+  /// key-value pairs in order, but crosses the ABI boundary only once.
+  ///
+  /// Returns true if the headers are set successfully.
+  fn set_response_headers<'a>(&mut self, headers: Vec<(&'a str, &'a [u8])>) -> bool;
+
   /// Get the value of the response trailer with the given key.
   /// If the trailer is not found, this returns `None`.
   ///
@@ -907,6 +923,20 @@ impl EnvoyHttpFilter for EnvoyHttpFilterImpl {
       )
     }
   }
+
+  fn set_request_headers(&mut self, headers: Vec<(&str, &[u8])>) -> bool {
+    self.set_headers_impl(
+      headers,
+      abi::envoy_dynamic_module_callback_http_set_request_headers,
+    )
+  }
+
+  fn set_response_headers(&mut self, headers: Vec<(&str, &[u8])>) -> bool {
+    self.set_headers_impl(
+      headers,
+      abi::envoy_dynamic_module_callback_http_set_response_headers,
+    )
+  }
 }
 
 impl EnvoyHttpFilterImpl {
@@ -914,6 +944,21 @@ impl EnvoyHttpFilterImpl {
     Self { raw_ptr }
   }
 
+  /// Implement the common logic for setting multiple headers at once.
+  fn set_headers_impl(
+    &mut self,
+    headers: Vec<(&str, &[u8])>,
+    callback: unsafe extern "C" fn(
+      filter_envoy_ptr: abi::envoy_dynamic_module_type_http_filter_envoy_ptr,
+      headers_vector: *mut abi::envoy_dynamic_module_type_module_http_header,
+      headers_vector_size: usize,
+    ) -> bool,
+  ) -> bool {
+    // See the comment in send_response for why this cast works.
+    let headers_ptr = headers.as_ptr() as *mut abi::envoy_dynamic_module_type_module_http_header;
+    unsafe { callback(self.raw_ptr, headers_ptr, headers.len()) }
+  }
+
   /// Implement the common logic for getting all headers/trailers.
   fn get_headers_impl(
     &self,
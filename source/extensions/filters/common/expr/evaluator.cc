@@ -1,5 +1,8 @@
 #include "source/extensions/filters/common/expr/evaluator.h"
 
+#include <array>
+#include <cstddef>
+
 #include "envoy/common/exception.h"
 #include "envoy/singleton/manager.h"
 
@@ -33,6 +36,38 @@ const ActivationLookupTable& getActivationTokens() {
 #undef _PAIR
 }
 
+#define _COUNT(_t) +1
+constexpr size_t NumActivationTokens = 0 ACTIVATION_TOKENS(_COUNT);
+#undef _COUNT
+
+// Size of the stack allocated first block of the arena of matches(), which is enough for the
+// wrappers and intermediate values of most conditions.
+constexpr size_t MatchArenaInitialBlockSize = 1024;
+
+// The activation of a single evaluation. As all the values it resolves live in the arena of the
+// evaluation, they are kept and reused if the expression refers to the same attribute again.
+class SingleEvaluationActivation : public StreamActivation {
+public:
+  using StreamActivation::StreamActivation;
+
+  absl::optional<CelValue> FindValue(absl::string_view name,
+                                     Protobuf::Arena* arena) const override {
+    const auto& tokens = getActivationTokens();
+    const auto token = tokens.find(name);
+    if (token == tokens.end()) {
+      return {};
+    }
+    auto& value = values_[static_cast<size_t>(token->second)];
+    if (!value.has_value()) {
+      value = findValue(static_cast<int>(token->second), arena);
+    }
+    return *value;
+  }
+
+private:
+  mutable std::array<absl::optional<absl::optional<CelValue>>, NumActivationTokens> values_;
+};
+
 } // namespace
 
 absl::optional<CelValue> StreamActivation::FindValue(absl::string_view name,
@@ -42,7 +77,13 @@ absl::optional<CelValue> StreamActivation::FindValue(absl::string_view name,
   if (token == tokens.end()) {
     return {};
   }
-  if (token->second == ActivationToken::XDS) {
+  return findValue(static_cast<int>(token->second), arena);
+}
+
+absl::optional<CelValue> StreamActivation::findValue(int token_value,
+                                                     Protobuf::Arena* arena) const {
+  const auto token = static_cast<ActivationToken>(token_value);
+  if (token == ActivationToken::XDS) {
     return CelValue::CreateMap(
         Protobuf::Arena::Create<XDSWrapper>(arena, *arena, activation_info_, local_info_));
   }
@@ -50,7 +91,7 @@ absl::optional<CelValue> StreamActivation::FindValue(absl::string_view name,
     return {};
   }
   const StreamInfo::StreamInfo& info = *activation_info_;
-  switch (token->second) {
+  switch (token) {
   case ActivationToken::Request:
     return CelValue::CreateMap(
         Protobuf::Arena::Create<RequestWrapper>(arena, *arena, activation_request_headers_, info));
@@ -134,12 +175,14 @@ BuilderPtr createBuilder(Protobuf::Arena* arena) {
   return builder;
 }
 
+BuilderInstance::BuilderInstance() : builder_(createBuilder(&constant_arena_)) {}
+
 SINGLETON_MANAGER_REGISTRATION(expression_builder);
 
 BuilderInstanceSharedPtr getBuilder(Server::Configuration::CommonFactoryContext& context) {
   return context.singletonManager().getTyped<BuilderInstance>(
       SINGLETON_MANAGER_REGISTERED_NAME(expression_builder),
-      [] { return std::make_shared<BuilderInstance>(createBuilder(nullptr)); });
+      [] { return std::make_shared<BuilderInstance>(); });
 }
 
 // Converts from CEL canonical to CEL v1alpha1
@@ -184,9 +227,9 @@ absl::optional<CelValue> evaluate(const Expression& expr, Protobuf::Arena& arena
                                   const Http::RequestHeaderMap* request_headers,
                                   const Http::ResponseHeaderMap* response_headers,
                                   const Http::ResponseTrailerMap* response_trailers) {
-  auto activation =
-      createActivation(local_info, info, request_headers, response_headers, response_trailers);
-  auto eval_status = expr.Evaluate(*activation, &arena);
+  const SingleEvaluationActivation activation(local_info, info, request_headers, response_headers,
+                                              response_trailers);
+  auto eval_status = expr.Evaluate(activation, &arena);
   if (!eval_status.ok()) {
     return {};
   }
@@ -196,7 +239,12 @@ absl::optional<CelValue> evaluate(const Expression& expr, Protobuf::Arena& arena
 
 bool matches(const Expression& expr, const StreamInfo::StreamInfo& info,
              const Http::RequestHeaderMap& headers) {
-  Protobuf::Arena arena;
+  // Most conditions are evaluated without any heap allocation for the arena.
+  alignas(std::max_align_t) char initial_block[MatchArenaInitialBlockSize];
+  Protobuf::ArenaOptions options;
+  options.initial_block = initial_block;
+  options.initial_block_size = sizeof(initial_block);
+  Protobuf::Arena arena(options);
   auto eval_status = Expr::evaluate(expr, arena, nullptr, info, &headers, nullptr, nullptr);
   if (!eval_status.has_value()) {
     return false;
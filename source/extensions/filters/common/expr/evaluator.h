@@ -58,6 +58,8 @@ public:
   }
 
 protected:
+  // Resolves the top level attribute with the given token, see evaluator.cc.
+  absl::optional<CelValue> findValue(int token, Protobuf::Arena* arena) const;
   void resetActivation() const;
   mutable const ::Envoy::LocalInfo::LocalInfo* local_info_{nullptr};
   mutable const StreamInfo::StreamInfo* activation_info_{nullptr};
@@ -78,9 +80,14 @@ ActivationPtr createActivation(const ::Envoy::LocalInfo::LocalInfo* local_info,
 class BuilderInstance : public Singleton::Instance {
 public:
   explicit BuilderInstance(BuilderPtr builder) : builder_(std::move(builder)) {}
+  // Creates a builder with constant folding. The folded constants of all the expressions it
+  // creates are held by this instance.
+  BuilderInstance();
   Builder& builder() { return *builder_; }
 
 private:
+  // Must outlive the builder and its expressions.
+  Protobuf::Arena constant_arena_;
   BuilderPtr builder_;
 };
 
@@ -91,7 +98,8 @@ using BuilderInstanceSharedPtr = std::shared_ptr<BuilderInstance>;
 // Throws an exception if fails to construct an expression builder.
 BuilderPtr createBuilder(Protobuf::Arena* arena);
 
-// Gets the singleton expression builder. Must be called on the main thread.
+// Gets the singleton expression builder, which folds constant subexpressions when creating
+// expressions. Must be called on the main thread.
 BuilderInstanceSharedPtr getBuilder(Server::Configuration::CommonFactoryContext& context);
 
 // Converts from CEL canonical to CEL v1alpha1
@@ -103,7 +111,8 @@ getExpr(const ::xds::type::v3::CelExpression& expression);
 ExpressionPtr createExpression(Builder& builder, const google::api::expr::v1alpha1::Expr& expr);
 
 // Evaluates an expression for a request. The arena is used to hold intermediate computational
-// results and potentially the final value.
+// results and potentially the final value. Each top level attribute, e.g. ``request``, is
+// resolved at most once per evaluation, and only if the expression refers to it.
 absl::optional<CelValue> evaluate(const Expression& expr, Protobuf::Arena& arena,
                                   const ::Envoy::LocalInfo::LocalInfo* local_info,
                                   const StreamInfo::StreamInfo& info,
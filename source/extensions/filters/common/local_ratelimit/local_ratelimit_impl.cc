@@ -76,27 +76,138 @@ ShareProviderManagerSharedPtr ShareProviderManager::singleton(Event::Dispatcher&
       });
 }
 
+namespace {
+
+// Returns a number that is distinct for every thread, to pick the token lease of the thread.
+size_t threadLeaseIndex() {
+  static std::atomic<size_t> next_index{0};
+  static thread_local const size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+} // namespace
+
 RateLimitTokenBucket::RateLimitTokenBucket(uint64_t max_tokens, uint64_t tokens_per_fill,
                                            std::chrono::milliseconds fill_interval,
-                                           TimeSource& time_source)
+                                           TimeSource& time_source, uint32_t worker_token_lease)
     : token_bucket_(max_tokens, time_source,
                     // Calculate the fill rate in tokens per second.
                     tokens_per_fill / std::chrono::duration<double>(fill_interval).count()),
-      fill_interval_(fill_interval) {}
+      fill_interval_(fill_interval), time_source_(time_source),
+      worker_token_lease_(worker_token_lease),
+      leases_(worker_token_lease > 0 ? std::make_unique<TokenLeases>() : nullptr) {}
 
 bool RateLimitTokenBucket::consume(double factor, uint64_t to_consume) {
   ASSERT(!(factor <= 0.0 || factor > 1.0));
+  if (leases_ != nullptr) {
+    return consumeLeased(to_consume / factor);
+  }
   auto cb = [tokens = to_consume / factor](double total) { return total < tokens ? 0.0 : tokens; };
   return token_bucket_.consume(cb) != 0.0;
 }
 
+uint64_t RateLimitTokenBucket::remainingTokens() const {
+  double remaining = token_bucket_.remainingTokens();
+  if (leases_ != nullptr) {
+    for (const TokenLease& lease : *leases_) {
+      remaining += lease.tokens_.load(std::memory_order_relaxed);
+    }
+  }
+  return static_cast<uint64_t>(std::min(remaining, token_bucket_.maxTokens()));
+}
+
+bool RateLimitTokenBucket::consumeLeased(double tokens) {
+  TokenLease& lease = (*leases_)[threadLeaseIndex() % LeaseShards];
+  const double now = nowInSeconds();
+
+  // A lease is kept for one fill interval at most. Giving back what is left to the shared bucket
+  // lets other workers use it when the load moves between workers.
+  if (isStale(lease, now)) {
+    returnLease(lease);
+  }
+  if (takeFromLease(lease, tokens)) {
+    return true;
+  }
+
+  // Workers that went idle never come back for their leases, so the stale leases of all the
+  // shards are returned before the shared bucket is used.
+  double leased = 0.0;
+  for (TokenLease& other : *leases_) {
+    if (isStale(other, now)) {
+      returnLease(other);
+    }
+    leased += other.tokens_.load(std::memory_order_relaxed);
+  }
+
+  // Take the tokens of this request and a new lease from the shared bucket at once. The bucket
+  // refills to max_tokens regardless of the leases, so whatever it holds above max_tokens minus
+  // the leased tokens is dropped: the bucket and the leases together never allow a burst larger
+  // than max_tokens.
+  double excess = 0.0;
+  const double taken = token_bucket_.consume(
+      [tokens, leased, &excess, max_tokens = token_bucket_.maxTokens(),
+       lease_size = worker_token_lease_](double total) {
+        excess = std::max(0.0, total + leased - max_tokens);
+        if (total - excess < tokens) {
+          return excess;
+        }
+        return std::min(total, excess + tokens + lease_size);
+      });
+  if (taken - excess >= tokens) {
+    double current = lease.tokens_.load(std::memory_order_relaxed);
+    while (!lease.tokens_.compare_exchange_weak(current, current + (taken - excess - tokens),
+                                                std::memory_order_relaxed)) {
+    }
+    lease.leased_at_.store(now, std::memory_order_relaxed);
+    return true;
+  }
+
+  // The shared bucket is empty, but other workers may not have used all of their leases. Taking
+  // from them means that no request is limited while the leases together hold enough tokens.
+  // Stale leases were returned above, so only the leases of the current interval are left.
+  for (TokenLease& other : *leases_) {
+    if (takeFromLease(other, tokens)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RateLimitTokenBucket::takeFromLease(TokenLease& lease, double tokens) {
+  double current = lease.tokens_.load(std::memory_order_relaxed);
+  do {
+    if (current < tokens) {
+      return false;
+    }
+  } while (!lease.tokens_.compare_exchange_weak(current, current - tokens,
+                                                std::memory_order_relaxed));
+  return true;
+}
+
+bool RateLimitTokenBucket::isStale(const TokenLease& lease, double now) const {
+  return now - lease.leased_at_.load(std::memory_order_relaxed) >=
+         std::chrono::duration<double>(fill_interval_).count();
+}
+
+void RateLimitTokenBucket::returnLease(TokenLease& lease) {
+  const double tokens = lease.tokens_.exchange(0.0, std::memory_order_relaxed);
+  if (tokens > 0.0) {
+    // A negative consumption adds the tokens back to the bucket.
+    token_bucket_.consume([tokens](double) { return -tokens; });
+  }
+}
+
+double RateLimitTokenBucket::nowInSeconds() const {
+  return std::chrono::duration<double>(time_source_.monotonicTime().time_since_epoch()).count();
+}
+
 LocalRateLimiterImpl::LocalRateLimiterImpl(
     const std::chrono::milliseconds fill_interval, const uint64_t max_tokens,
     const uint64_t tokens_per_fill, Event::Dispatcher& dispatcher,
     const Protobuf::RepeatedPtrField<
         envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptors,
     bool always_consume_default_token_bucket, ShareProviderSharedPtr shared_provider,
-    uint32_t lru_size)
+    uint32_t lru_size, uint32_t worker_token_lease)
     : time_source_(dispatcher.timeSource()), share_provider_(std::move(shared_provider)),
       always_consume_default_token_bucket_(always_consume_default_token_bucket) {
   // Ignore the default token bucket if fill_interval is 0 because 0 fill_interval means nothing
@@ -105,8 +216,8 @@ LocalRateLimiterImpl::LocalRateLimiterImpl(
     if (fill_interval < std::chrono::milliseconds(50)) {
       throw EnvoyException("local rate limit token bucket fill timer must be >= 50ms");
     }
-    default_token_bucket_ = std::make_shared<RateLimitTokenBucket>(max_tokens, tokens_per_fill,
-                                                                   fill_interval, time_source_);
+    default_token_bucket_ = std::make_shared<RateLimitTokenBucket>(
+        max_tokens, tokens_per_fill, fill_interval, time_source_, worker_token_lease);
   }
 
   for (const auto& descriptor : descriptors) {
@@ -135,14 +246,14 @@ LocalRateLimiterImpl::LocalRateLimiterImpl(
     if (wildcard_found) {
       DynamicDescriptorSharedPtr dynamic_descriptor = std::make_shared<DynamicDescriptor>(
           per_descriptor_max_tokens, per_descriptor_tokens_per_fill, per_descriptor_fill_interval,
-          lru_size, dispatcher.timeSource());
+          lru_size, dispatcher.timeSource(), worker_token_lease);
       dynamic_descriptors_.addDescriptor(std::move(new_descriptor), std::move(dynamic_descriptor));
       continue;
     }
     RateLimitTokenBucketSharedPtr per_descriptor_token_bucket =
-        std::make_shared<RateLimitTokenBucket>(per_descriptor_max_tokens,
-                                               per_descriptor_tokens_per_fill,
-                                               per_descriptor_fill_interval, time_source_);
+        std::make_shared<RateLimitTokenBucket>(
+            per_descriptor_max_tokens, per_descriptor_tokens_per_fill,
+            per_descriptor_fill_interval, time_source_, worker_token_lease);
     auto result =
         descriptors_.emplace(std::move(new_descriptor), std::move(per_descriptor_token_bucket));
     if (!result.second) {
@@ -284,19 +395,28 @@ DynamicDescriptorMap::getBucket(const RateLimit::Descriptor request_descriptor)
 DynamicDescriptor::DynamicDescriptor(uint64_t per_descriptor_max_tokens,
                                      uint64_t per_descriptor_tokens_per_fill,
                                      std::chrono::milliseconds per_descriptor_fill_interval,
-                                     uint32_t lru_size, TimeSource& time_source)
+                                     uint32_t lru_size, TimeSource& time_source,
+                                     uint32_t worker_token_lease)
     : max_tokens_(per_descriptor_max_tokens), tokens_per_fill_(per_descriptor_tokens_per_fill),
-      fill_interval_(per_descriptor_fill_interval), lru_size_(lru_size), time_source_(time_source) {
-}
+      fill_interval_(per_descriptor_fill_interval), lru_size_(lru_size), time_source_(time_source),
+      worker_token_lease_(worker_token_lease) {}
 
 RateLimitTokenBucketSharedPtr
 DynamicDescriptor::addOrGetDescriptor(const RateLimit::Descriptor& request_descriptor) {
+  {
+    absl::ReaderMutexLock lock(&dyn_desc_lock_);
+    auto iter = dynamic_descriptors_.find(request_descriptor);
+    if (iter != dynamic_descriptors_.end()) {
+      iter->second.second->referenced_.store(true, std::memory_order_relaxed);
+      return iter->second.first;
+    }
+  }
+
   absl::WriterMutexLock lock(&dyn_desc_lock_);
+  // Another thread may have added the descriptor since the lookup.
   auto iter = dynamic_descriptors_.find(request_descriptor);
   if (iter != dynamic_descriptors_.end()) {
-    if (iter->second.second != lru_list_.begin()) {
-      lru_list_.splice(lru_list_.begin(), lru_list_, iter->second.second);
-    }
+    iter->second.second->referenced_.store(true, std::memory_order_relaxed);
     return iter->second.first;
   }
   // add a new descriptor to the set along with its token bucket
@@ -305,22 +425,28 @@ DynamicDescriptor::addOrGetDescriptor(const RateLimit::Descriptor& request_descr
   ENVOY_LOG(trace, "max_tokens: {}, tokens_per_fill: {}, fill_interval: {}", max_tokens_,
             tokens_per_fill_, std::chrono::duration<double>(fill_interval_).count());
   per_descriptor_token_bucket = std::make_shared<RateLimitTokenBucket>(
-      max_tokens_, tokens_per_fill_, fill_interval_, time_source_);
+      max_tokens_, tokens_per_fill_, fill_interval_, time_source_, worker_token_lease_);
 
   ENVOY_LOG(trace, "DynamicDescriptor::addorGetDescriptor: adding dynamic descriptor: {}",
             request_descriptor.toString());
-  lru_list_.emplace_front(request_descriptor);
-  auto result = dynamic_descriptors_.emplace(
-      request_descriptor, std::pair(per_descriptor_token_bucket, lru_list_.begin()));
-  auto token_bucket = result.first->second.first;
-  if (lru_list_.size() > lru_size_) {
+  if (!lru_list_.empty() && lru_list_.size() >= lru_size_) {
+    // Entries used since they were last considered for eviction get a second chance. All of
+    // them may have been used, so this ends after one pass at most.
+    while (lru_list_.back().referenced_.load(std::memory_order_relaxed)) {
+      lru_list_.back().referenced_.store(false, std::memory_order_relaxed);
+      lru_list_.splice(lru_list_.begin(), lru_list_, std::prev(lru_list_.end()));
+    }
     ENVOY_LOG(trace,
               "DynamicDescriptor::addorGetDescriptor: lru_size({}) overflow. Removing dynamic "
               "descriptor: {}",
-              lru_size_, lru_list_.back().toString());
-    dynamic_descriptors_.erase(lru_list_.back());
+              lru_size_, lru_list_.back().descriptor_.toString());
+    dynamic_descriptors_.erase(lru_list_.back().descriptor_);
     lru_list_.pop_back();
   }
+  lru_list_.emplace_front(request_descriptor);
+  auto result = dynamic_descriptors_.emplace(
+      request_descriptor, std::pair(per_descriptor_token_bucket, lru_list_.begin()));
+  auto token_bucket = result.first->second.first;
   ASSERT(lru_list_.size() == dynamic_descriptors_.size());
   return token_bucket;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <ratio>
 
@@ -28,12 +30,21 @@ using ProtoLocalClusterRateLimit = envoy::extensions::common::ratelimit::v3::Loc
 class DynamicDescriptor : public Logger::Loggable<Logger::Id::rate_limit_quota> {
 public:
   DynamicDescriptor(uint64_t max_tokens, uint64_t tokens_per_fill,
-                    std::chrono::milliseconds fill_interval, uint32_t lru_size, TimeSource&);
+                    std::chrono::milliseconds fill_interval, uint32_t lru_size, TimeSource&,
+                    uint32_t worker_token_lease = 0);
   // add a new user configured descriptor to the set.
   RateLimitTokenBucketSharedPtr addOrGetDescriptor(const RateLimit::Descriptor& request_descriptor);
 
 private:
-  using LruList = std::list<RateLimit::Descriptor>;
+  // The cache is evicted with the second chance algorithm, so that lookups of cached descriptors
+  // only need a reader lock: they flag the entry as referenced instead of moving it in the list.
+  struct LruEntry {
+    explicit LruEntry(const RateLimit::Descriptor& descriptor) : descriptor_(descriptor) {}
+
+    const RateLimit::Descriptor descriptor_;
+    std::atomic<bool> referenced_{false};
+  };
+  using LruList = std::list<LruEntry>;
 
   mutable absl::Mutex dyn_desc_lock_;
   RateLimit::Descriptor::Map<std::pair<RateLimitTokenBucketSharedPtr, LruList::iterator>>
@@ -42,9 +53,10 @@ private:
   uint64_t max_tokens_;
   uint64_t tokens_per_fill_;
   const std::chrono::milliseconds fill_interval_;
-  LruList lru_list_;
+  LruList lru_list_ ABSL_GUARDED_BY(dyn_desc_lock_);
   uint32_t lru_size_;
   TimeSource& time_source_;
+  const uint32_t worker_token_lease_;
 };
 
 using DynamicDescriptorSharedPtr = std::shared_ptr<DynamicDescriptor>;
@@ -110,8 +122,13 @@ public:
 class RateLimitTokenBucket : public TokenBucketContext,
                              public Logger::Loggable<Logger::Id::local_rate_limit> {
 public:
+  /**
+   * @param worker_token_lease supplies the number of tokens a worker takes from the shared bucket
+   *        at once, to consume them without touching the shared bucket. 0 disables leasing.
+   */
   RateLimitTokenBucket(uint64_t max_tokens, uint64_t tokens_per_fill,
-                       std::chrono::milliseconds fill_interval, TimeSource& time_source);
+                       std::chrono::milliseconds fill_interval, TimeSource& time_source,
+                       uint32_t worker_token_lease = 0);
 
   // RateLimitTokenBucket
   bool consume(double factor = 1.0, uint64_t tokens = 1);
@@ -119,13 +136,35 @@ public:
   std::chrono::milliseconds fillInterval() const { return fill_interval_; }
 
   uint64_t maxTokens() const override { return static_cast<uint64_t>(token_bucket_.maxTokens()); }
-  uint64_t remainingTokens() const override {
-    return static_cast<uint64_t>(token_bucket_.remainingTokens());
-  }
+  uint64_t remainingTokens() const override;
 
 private:
+  // Tokens taken from the shared bucket by the threads of one shard. Each worker thread is
+  // assigned a shard, so with no more workers than shards a lease is only updated by one thread
+  // and its cache line is not shared. Leases are still atomic as other threads may take their
+  // tokens when the shared bucket runs out.
+  struct alignas(64) TokenLease {
+    std::atomic<double> tokens_{0.0};
+    // When the lease was last refilled, in seconds of the monotonic clock.
+    std::atomic<double> leased_at_{0.0};
+  };
+  static constexpr size_t LeaseShards = 32;
+  using TokenLeases = std::array<TokenLease, LeaseShards>;
+
+  bool consumeLeased(double tokens);
+  // Takes `tokens` from the lease if it holds enough of them.
+  static bool takeFromLease(TokenLease& lease, double tokens);
+  // Whether the lease was taken more than one fill interval ago.
+  bool isStale(const TokenLease& lease, double now) const;
+  // Gives the tokens of the lease back to the shared bucket.
+  void returnLease(TokenLease& lease);
+  double nowInSeconds() const;
+
   AtomicTokenBucketImpl token_bucket_;
   const std::chrono::milliseconds fill_interval_;
+  TimeSource& time_source_;
+  const double worker_token_lease_;
+  std::unique_ptr<TokenLeases> leases_;
 };
 using RateLimitTokenBucketSharedPtr = std::shared_ptr<RateLimitTokenBucket>;
 
@@ -142,7 +181,8 @@ public:
       const Protobuf::RepeatedPtrField<
           envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptors,
       bool always_consume_default_token_bucket = true,
-      ShareProviderSharedPtr shared_provider = nullptr, const uint32_t lru_size = 20);
+      ShareProviderSharedPtr shared_provider = nullptr, const uint32_t lru_size = 20,
+      const uint32_t worker_token_lease = 0);
   ~LocalRateLimiterImpl();
 
   Result requestAllowed(absl::Span<const RateLimit::Descriptor> request_descriptors);
@@ -42,8 +42,41 @@ void LuaLoggable::scriptLog(spdlog::level::level_enum level, absl::string_view m
   }
 }
 
-Coroutine::Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state)
-    : coroutine_state_(new_thread_state, false) {}
+void CoroutineDeleter::operator()(Coroutine* coroutine) const {
+  if (coroutine->pool_ != nullptr && coroutine->reusable()) {
+    coroutine->pool_->release(coroutine);
+  } else {
+    delete coroutine;
+  }
+}
+
+Coroutine::Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state,
+                     CoroutinePool* pool)
+    : coroutine_state_(new_thread_state, false), pool_(pool) {}
+
+void Coroutine::reset() {
+  ASSERT(reusable());
+  lua_settop(luaState(), 0);
+  state_ = State::NotStarted;
+}
+
+CoroutinePtr CoroutinePool::take() {
+  if (coroutines_.empty()) {
+    return nullptr;
+  }
+  CoroutinePtr coroutine(coroutines_.back().release());
+  coroutines_.pop_back();
+  coroutine->reset();
+  return coroutine;
+}
+
+void CoroutinePool::release(Coroutine* coroutine) {
+  if (coroutines_.size() >= MaxSize) {
+    delete coroutine;
+    return;
+  }
+  coroutines_.emplace_back(coroutine);
+}
 
 void Coroutine::start(int function_ref, int num_args, const std::function<void()>& yield_callback) {
   ASSERT(state_ == State::NotStarted);
@@ -82,17 +115,32 @@ void Coroutine::resume(int num_args, const std::function<void()>& yield_callback
 ThreadLocalState::ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls)
     : tls_slot_(ThreadLocal::TypedSlot<LuaThreadLocal>::makeUnique(tls)) {
 
-  // First verify that the supplied code can be parsed.
+  // First verify that the supplied code can be parsed and run, and compile it once for all the
+  // workers.
   CSmartPtr<lua_State, lua_close> state(luaL_newstate());
   RELEASE_ASSERT(state.get() != nullptr, "unable to create new Lua state object");
   luaL_openlibs(state.get());
 
-  if (0 != luaL_dostring(state.get(), code.c_str())) {
+  if (0 != luaL_loadstring(state.get(), code.c_str())) {
+    throw LuaException(fmt::format("script load error: {}", lua_tostring(state.get(), -1)));
+  }
+  // The bytecode keeps the debug information, so errors report the same chunk names and lines.
+  std::string bytecode;
+  lua_dump(
+      state.get(),
+      [](lua_State*, const void* data, size_t size, void* output) {
+        static_cast<std::string*>(output)->append(static_cast<const char*>(data), size);
+        return 0;
+      },
+      &bytecode);
+  if (0 != lua_pcall(state.get(), 0, LUA_MULTRET, 0)) {
     throw LuaException(fmt::format("script load error: {}", lua_tostring(state.get(), -1)));
   }
 
   // Now initialize on all threads.
-  tls_slot_->set([code](Event::Dispatcher&) { return std::make_shared<LuaThreadLocal>(code); });
+  tls_slot_->set([bytecode = std::move(bytecode)](Event::Dispatcher&) {
+    return std::make_shared<LuaThreadLocal>(bytecode);
+  });
 }
 
 int ThreadLocalState::getGlobalRef(uint64_t slot) {
@@ -121,16 +169,24 @@ uint64_t ThreadLocalState::registerGlobal(const std::string& global,
 }
 
 CoroutinePtr ThreadLocalState::createCoroutine() {
-  lua_State* state = tlsState().get();
-  return std::make_unique<Coroutine>(std::make_pair(lua_newthread(state), state));
+  LuaThreadLocal& tls = **tls_slot_;
+  CoroutinePtr coroutine = tls.coroutine_pool_.take();
+  if (coroutine != nullptr) {
+    return coroutine;
+  }
+  lua_State* state = tls.state_.get();
+  return CoroutinePtr(
+      new Coroutine(std::make_pair(lua_newthread(state), state), &tls.coroutine_pool_));
 }
 
-ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& code)
+ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& bytecode)
     : state_(luaL_newstate()) {
 
   RELEASE_ASSERT(state_.get() != nullptr, "unable to create new Lua state object");
   luaL_openlibs(state_.get());
-  int rc = luaL_dostring(state_.get(), code.c_str());
+  int rc = luaL_loadbuffer(state_.get(), bytecode.data(), bytecode.size(), "=script");
+  ASSERT(rc == 0);
+  rc = lua_pcall(state_.get(), 0, LUA_MULTRET, 0);
   ASSERT(rc == 0);
 }
 
@@ -423,6 +423,18 @@ public:
   }
 };
 
+class Coroutine;
+class CoroutinePool;
+
+/**
+ * Deletes a coroutine, or gives it back to the pool it came from if it can run another function.
+ */
+struct CoroutineDeleter {
+  void operator()(Coroutine* coroutine) const;
+};
+
+using CoroutinePtr = std::unique_ptr<Coroutine, CoroutineDeleter>;
+
 /**
  * This is a wrapper for a Lua coroutine. Lua intermixes coroutine and "thread." Lua does not have
  * real threads, only cooperatively scheduled coroutines.
@@ -431,10 +443,25 @@ class Coroutine : Logger::Loggable<Logger::Id::lua> {
 public:
   enum class State { NotStarted, Yielded, Finished };
 
-  Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state);
+  /**
+   * @param pool supplies the pool the coroutine is given back to when it is released, if any.
+   */
+  Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state,
+            CoroutinePool* pool = nullptr);
   lua_State* luaState() { return coroutine_state_.get(); }
   State state() { return state_; }
 
+  /**
+   * @return whether the coroutine finished without an error, so that its Lua thread can be used to
+   *         start another function.
+   */
+  bool reusable() { return state_ == State::Finished && lua_status(luaState()) == 0; }
+
+  /**
+   * Clear the stack of a reusable coroutine so that it can be started again.
+   */
+  void reset();
+
   /**
    * Start a coroutine.
    * @param function_ref supplies the previously registered function to call. Registered with
@@ -454,11 +481,39 @@ public:
   void resume(int num_args, const std::function<void()>& yield_callback);
 
 private:
+  friend struct CoroutineDeleter;
+
   LuaRef<lua_State> coroutine_state_;
+  CoroutinePool* const pool_;
   State state_{State::NotStarted};
 };
 
-using CoroutinePtr = std::unique_ptr<Coroutine>;
+/**
+ * Finished coroutines of a worker, kept to start the next functions without creating new Lua
+ * threads. Lua threads are garbage collected objects, so creating one for every call of a script
+ * makes each call pay for an allocation and for more frequent collections.
+ */
+class CoroutinePool {
+public:
+  // Bounds the number of idle Lua threads kept alive by a worker.
+  static constexpr size_t MaxSize = 64;
+
+  /**
+   * @return a pooled coroutine, or nullptr if the pool is empty.
+   */
+  CoroutinePtr take();
+
+  /**
+   * Keep a reusable coroutine, or delete it if the pool is full.
+   */
+  void release(Coroutine* coroutine);
+
+  size_t size() const { return coroutines_.size(); }
+
+private:
+  std::vector<std::unique_ptr<Coroutine>> coroutines_;
+};
+
 using Initializer = std::function<void(lua_State*)>;
 using InitializerList = std::vector<Initializer>;
 
@@ -472,10 +527,15 @@ public:
   ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls);
 
   /**
-   * @return CoroutinePtr a new coroutine.
+   * @return CoroutinePtr a coroutine, reusing a finished one of this worker if there is any.
    */
   CoroutinePtr createCoroutine();
 
+  /**
+   * @return the number of finished coroutines kept by this worker for reuse.
+   */
+  size_t pooledCoroutines() { return (*tls_slot_)->coroutine_pool_.size(); }
+
   /**
    * @return a global reference previously registered via registerGlobal(). This may return
    *         LUA_REFNIL if there was no such global.
@@ -516,10 +576,13 @@ public:
 
 private:
   struct LuaThreadLocal : public ThreadLocal::ThreadLocalObject {
-    LuaThreadLocal(const std::string& code);
+    // `bytecode` supplies the script as compiled on the main thread.
+    LuaThreadLocal(const std::string& bytecode);
 
     CSmartPtr<lua_State, lua_close> state_;
     std::vector<int> global_slots_;
+    // Declared after the state as the pooled coroutines reference it.
+    CoroutinePool coroutine_pool_;
   };
 
   CSmartPtr<lua_State, lua_close>& tlsState() { return (*tls_slot_)->state_; }
@@ -53,10 +53,20 @@ RoleBasedAccessControlEngineImpl::RoleBasedAccessControlEngineImpl(
     }
   }
 
+  // Policies are evaluated in the order of their names.
+  std::map<std::string, const envoy::config::rbac::v3::Policy*> sorted_policies;
   for (const auto& policy : rules.policies()) {
-    policies_.emplace(policy.first, std::make_unique<PolicyMatcher>(policy.second, builder_.get(),
-                                                                    validation_visitor, context));
+    sorted_policies.emplace(policy.first, &policy.second);
   }
+  std::vector<const envoy::config::rbac::v3::Policy*> policy_configs;
+  policy_configs.reserve(sorted_policies.size());
+  policies_.reserve(sorted_policies.size());
+  for (const auto& [name, policy] : sorted_policies) {
+    policy_configs.push_back(policy);
+    policies_.emplace_back(name, std::make_unique<PolicyMatcher>(*policy, builder_.get(),
+                                                                 validation_visitor, context));
+  }
+  policy_index_ = std::make_unique<PolicyIndex>(policy_configs);
 }
 
 bool RoleBasedAccessControlEngineImpl::handleAction(const Network::Connection& connection,
@@ -92,15 +102,19 @@ bool RoleBasedAccessControlEngineImpl::checkPolicyMatch(
     const Envoy::Http::RequestHeaderMap& headers, std::string* effective_policy_id) const {
   bool matched = false;
 
-  for (const auto& policy : policies_) {
-    if (policy.second->matches(connection, headers, info)) {
-      matched = true;
-      if (effective_policy_id != nullptr) {
-        *effective_policy_id = policy.first;
-      }
-      break;
+  // Only the policies the index can't rule out are evaluated, in the same order as all of them
+  // would be, so the first match is the same.
+  policy_index_->forEachCandidate(connection, headers, [&](uint32_t i) {
+    const auto& policy = policies_[i];
+    if (!policy.second->matches(connection, headers, info)) {
+      return false;
     }
-  }
+    matched = true;
+    if (effective_policy_id != nullptr) {
+      *effective_policy_id = policy.first;
+    }
+    return true;
+  });
 
   return matched;
 }
@@ -6,6 +6,7 @@
 #include "source/common/matcher/matcher.h"
 #include "source/extensions/filters/common/rbac/engine.h"
 #include "source/extensions/filters/common/rbac/matchers.h"
+#include "source/extensions/filters/common/rbac/policy_index.h"
 
 #include "xds/type/matcher/v3/matcher.pb.h"
 
@@ -86,7 +87,9 @@ private:
   const envoy::config::rbac::v3::RBAC::Action action_;
   const EnforcementMode mode_;
 
-  std::map<std::string, std::unique_ptr<PolicyMatcher>> policies_;
+  // Sorted by name, which is the order policies are evaluated in.
+  std::vector<std::pair<std::string, std::unique_ptr<PolicyMatcher>>> policies_;
+  std::unique_ptr<PolicyIndex> policy_index_;
 
   Protobuf::Arena constant_arena_;
   Expr::BuilderPtr builder_;
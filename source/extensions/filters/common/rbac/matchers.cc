@@ -1,11 +1,15 @@
 #include "source/extensions/filters/common/rbac/matchers.h"
 
+#include <algorithm>
+
 #include "envoy/config/rbac/v3/rbac.pb.h"
 #include "envoy/upstream/upstream.h"
 
 #include "source/common/config/utility.h"
 #include "source/extensions/filters/common/rbac/matcher_extension.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Filters {
@@ -136,16 +140,67 @@ bool AndMatcher::matches(const Network::Connection& connection,
 OrMatcher::OrMatcher(const Protobuf::RepeatedPtrField<envoy::config::rbac::v3::Permission>& rules,
                      ProtobufMessage::ValidationVisitor& validation_visitor,
                      Server::Configuration::CommonFactoryContext& context) {
+  std::vector<const envoy::config::route::v3::HeaderMatcher*> header_matchers;
   for (const auto& rule : rules) {
+    if (rule.rule_case() == envoy::config::rbac::v3::Permission::RuleCase::kHeader &&
+        HeaderRegexSetMatcher::combinableRegex(rule.header(), context) != nullptr) {
+      header_matchers.push_back(&rule.header());
+      continue;
+    }
     matchers_.push_back(Matcher::create(rule, validation_visitor, context));
   }
+  addHeaderMatchers(header_matchers, context);
 }
 
 OrMatcher::OrMatcher(const Protobuf::RepeatedPtrField<envoy::config::rbac::v3::Principal>& ids,
                      Server::Configuration::CommonFactoryContext& context) {
+  std::vector<const envoy::config::route::v3::HeaderMatcher*> header_matchers;
   for (const auto& id : ids) {
+    if (id.identifier_case() == envoy::config::rbac::v3::Principal::IdentifierCase::kHeader &&
+        HeaderRegexSetMatcher::combinableRegex(id.header(), context) != nullptr) {
+      header_matchers.push_back(&id.header());
+      continue;
+    }
     matchers_.push_back(Matcher::create(id, context));
   }
+  addHeaderMatchers(header_matchers, context);
+}
+
+void OrMatcher::addHeaderMatchers(
+    const std::vector<const envoy::config::route::v3::HeaderMatcher*>& header_matchers,
+    Server::Configuration::CommonFactoryContext& context) {
+  // The result of a set does not depend on the order of its matchers, so the header matchers are
+  // grouped by header, in the order of the first matcher of each header.
+  std::vector<std::string> names;
+  absl::flat_hash_map<std::string, std::vector<const envoy::config::route::v3::HeaderMatcher*>>
+      by_name;
+  for (const auto* header_matcher : header_matchers) {
+    auto& group = by_name[header_matcher->name()];
+    if (group.empty()) {
+      names.push_back(header_matcher->name());
+    }
+    group.push_back(header_matcher);
+  }
+
+  for (const std::string& name : names) {
+    const auto& group = by_name[name];
+    std::vector<MatcherConstSharedPtr> matchers;
+    std::vector<std::string> regexes;
+    for (const auto* header_matcher : group) {
+      matchers.push_back(std::make_shared<const HeaderMatcher>(*header_matcher, context));
+      regexes.push_back(*HeaderRegexSetMatcher::combinableRegex(*header_matcher, context));
+    }
+    if (group.size() > 1) {
+      auto regex_set_or_error = Regex::CompiledGoogleReSetMatcher::create(regexes);
+      if (regex_set_or_error.ok()) {
+        matchers_.push_back(std::make_shared<const HeaderRegexSetMatcher>(
+            name, std::move(regex_set_or_error.value()), std::move(matchers)));
+        continue;
+      }
+    }
+    // A single regex, or regexes that are too large to be combined, are matched one by one.
+    matchers_.insert(matchers_.end(), matchers.begin(), matchers.end());
+  }
 }
 
 bool OrMatcher::matches(const Network::Connection& connection,
@@ -166,6 +221,47 @@ bool NotMatcher::matches(const Network::Connection& connection,
   return !matcher_->matches(connection, headers, info);
 }
 
+const std::string*
+HeaderRegexSetMatcher::combinableRegex(const envoy::config::route::v3::HeaderMatcher& matcher,
+                                       Server::Configuration::CommonFactoryContext& context) {
+  if (matcher.invert_match() || matcher.treat_missing_header_as_empty() ||
+      dynamic_cast<const Regex::GoogleReEngine*>(&context.regexEngine()) == nullptr) {
+    return nullptr;
+  }
+  const envoy::type::matcher::v3::RegexMatcher* regex = nullptr;
+  if (matcher.header_match_specifier_case() ==
+      envoy::config::route::v3::HeaderMatcher::HeaderMatchSpecifierCase::kSafeRegexMatch) {
+    regex = &matcher.safe_regex_match();
+  } else if (matcher.header_match_specifier_case() ==
+                 envoy::config::route::v3::HeaderMatcher::HeaderMatchSpecifierCase::kStringMatch &&
+             matcher.string_match().match_pattern_case() ==
+                 envoy::type::matcher::v3::StringMatcher::MatchPatternCase::kSafeRegex) {
+    regex = &matcher.string_match().safe_regex();
+  }
+  // Regexes with their own program size limit keep their own matcher.
+  if (regex == nullptr || regex->has_google_re2()) {
+    return nullptr;
+  }
+  return &regex->regex();
+}
+
+bool HeaderRegexSetMatcher::matches(const Network::Connection& connection,
+                                    const Envoy::Http::RequestHeaderMap& headers,
+                                    const StreamInfo::StreamInfo& info) const {
+  const auto header_value = Envoy::Http::HeaderUtility::getAllOfHeaderAsString(headers, name_);
+  if (!header_value.result().has_value()) {
+    return false;
+  }
+  const absl::optional<bool> matched = regexes_->matchAny(header_value.result().value());
+  if (matched.has_value()) {
+    return matched.value();
+  }
+  return std::any_of(header_matchers_.begin(), header_matchers_.end(),
+                     [&](const MatcherConstSharedPtr& matcher) {
+                       return matcher->matches(connection, headers, info);
+                     });
+}
+
 bool HeaderMatcher::matches(const Network::Connection&,
                             const Envoy::Http::RequestHeaderMap& headers,
                             const StreamInfo::StreamInfo&) const {
@@ -11,6 +11,7 @@
 #include "envoy/type/matcher/v3/string.pb.h"
 
 #include "source/common/common/matchers.h"
+#include "source/common/common/regex.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/network/cidr_range.h"
 #include "source/extensions/filters/common/expr/evaluator.h"
@@ -87,6 +88,11 @@ public:
                const StreamInfo::StreamInfo&) const override;
 
 private:
+  // Adds the header matchers of the set, combining the regexes of the same header.
+  void addHeaderMatchers(
+      const std::vector<const envoy::config::route::v3::HeaderMatcher*>& header_matchers,
+      Server::Configuration::CommonFactoryContext& context);
+
   std::vector<MatcherConstSharedPtr> matchers_;
 };
 
@@ -150,6 +156,34 @@ private:
   const Envoy::Http::HeaderUtility::HeaderDataPtr header_;
 };
 
+/**
+ * Matches a header against the regexes of several header matchers of an OrMatcher at once, see
+ * Regex::CompiledGoogleReSetMatcher.
+ */
+class HeaderRegexSetMatcher : public Matcher {
+public:
+  HeaderRegexSetMatcher(const std::string& name, Regex::CompiledGoogleReSetMatcherPtr regexes,
+                        std::vector<MatcherConstSharedPtr> header_matchers)
+      : name_(name), regexes_(std::move(regexes)), header_matchers_(std::move(header_matchers)) {}
+
+  /**
+   * @return the regex of a header matcher that can be combined with the regexes of other header
+   *         matchers of the same header, or nullptr if it cannot be.
+   */
+  static const std::string*
+  combinableRegex(const envoy::config::route::v3::HeaderMatcher& matcher,
+                  Server::Configuration::CommonFactoryContext& context);
+
+  bool matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap& headers,
+               const StreamInfo::StreamInfo& info) const override;
+
+private:
+  const Envoy::Http::LowerCaseString name_;
+  const Regex::CompiledGoogleReSetMatcherPtr regexes_;
+  // The matchers of the regexes, used when the set runs out of memory for a header value.
+  const std::vector<MatcherConstSharedPtr> header_matchers_;
+};
+
 /**
  * Perform a match against an IP CIDR range. This rule can be applied to connection remote,
  * downstream local address, downstream direct remote address or downstream remote address.
@@ -0,0 +1,203 @@
+#include "source/extensions/filters/common/rbac/policy_index.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "source/common/http/path_utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+
+namespace {
+
+using envoy::config::rbac::v3::Permission;
+using envoy::config::rbac::v3::Principal;
+using envoy::type::matcher::v3::StringMatcher;
+
+struct PathKeys {
+  std::vector<std::string> exact;
+  std::vector<std::string> prefix;
+
+  void append(PathKeys&& other) {
+    std::move(other.exact.begin(), other.exact.end(), std::back_inserter(exact));
+    std::move(other.prefix.begin(), other.prefix.end(), std::back_inserter(prefix));
+  }
+};
+
+// Returns true, and adds the names to `names`, if `principal` only matches peers authenticated
+// with one of those names.
+bool principalNames(const Principal& principal, std::vector<std::string>& names);
+
+bool anyPrincipalNames(const Protobuf::RepeatedPtrField<Principal>& ids,
+                       std::vector<std::string>& names) {
+  std::vector<std::string> all;
+  for (const auto& id : ids) {
+    if (!principalNames(id, all)) {
+      return false;
+    }
+  }
+  std::move(all.begin(), all.end(), std::back_inserter(names));
+  return !ids.empty();
+}
+
+bool principalNames(const Principal& principal, std::vector<std::string>& names) {
+  switch (principal.identifier_case()) {
+  case Principal::IdentifierCase::kAuthenticated: {
+    const StringMatcher& matcher = principal.authenticated().principal_name();
+    if (matcher.match_pattern_case() != StringMatcher::MatchPatternCase::kExact ||
+        matcher.ignore_case()) {
+      return false;
+    }
+    names.push_back(matcher.exact());
+    return true;
+  }
+  case Principal::IdentifierCase::kOrIds:
+    return anyPrincipalNames(principal.or_ids().ids(), names);
+  case Principal::IdentifierCase::kAndIds:
+    // All ids must match, so any one of them that can be indexed is enough.
+    for (const auto& id : principal.and_ids().ids()) {
+      if (principalNames(id, names)) {
+        return true;
+      }
+    }
+    return false;
+  default:
+    return false;
+  }
+}
+
+// Returns true, and adds the paths to `keys`, if `permission` only matches requests whose URL
+// path is one of the exact paths or starts with one of the prefixes.
+bool permissionPaths(const Permission& permission, PathKeys& keys);
+
+bool anyPermissionPaths(const Protobuf::RepeatedPtrField<Permission>& rules, PathKeys& keys) {
+  PathKeys all;
+  for (const auto& rule : rules) {
+    if (!permissionPaths(rule, all)) {
+      return false;
+    }
+  }
+  keys.append(std::move(all));
+  return !rules.empty();
+}
+
+bool permissionPaths(const Permission& permission, PathKeys& keys) {
+  switch (permission.rule_case()) {
+  case Permission::RuleCase::kUrlPath: {
+    if (!permission.url_path().has_path() || permission.url_path().path().ignore_case()) {
+      return false;
+    }
+    const StringMatcher& matcher = permission.url_path().path();
+    if (matcher.match_pattern_case() == StringMatcher::MatchPatternCase::kExact) {
+      keys.exact.push_back(matcher.exact());
+      return true;
+    }
+    if (matcher.match_pattern_case() == StringMatcher::MatchPatternCase::kPrefix) {
+      keys.prefix.push_back(matcher.prefix());
+      return true;
+    }
+    return false;
+  }
+  case Permission::RuleCase::kOrRules:
+    return anyPermissionPaths(permission.or_rules().rules(), keys);
+  case Permission::RuleCase::kAndRules:
+    for (const auto& rule : permission.and_rules().rules()) {
+      if (permissionPaths(rule, keys)) {
+        return true;
+      }
+    }
+    return false;
+  default:
+    return false;
+  }
+}
+
+void addToList(std::vector<uint32_t>& list, uint32_t policy) {
+  // Policies are added in order, so a duplicate can only be the last one.
+  if (list.empty() || list.back() != policy) {
+    list.push_back(policy);
+  }
+}
+
+} // namespace
+
+PolicyIndex::PolicyIndex(const std::vector<const envoy::config::rbac::v3::Policy*>& policies) {
+  for (uint32_t i = 0; i < policies.size(); ++i) {
+    const auto& policy = *policies[i];
+
+    std::vector<std::string> names;
+    if (anyPrincipalNames(policy.principals(), names)) {
+      for (const auto& name : names) {
+        addToList(by_principal_[name], i);
+      }
+      has_indexed_policies_ = true;
+      continue;
+    }
+
+    PathKeys paths;
+    if (anyPermissionPaths(policy.permissions(), paths)) {
+      for (const auto& path : paths.exact) {
+        addToList(by_exact_path_[path], i);
+      }
+      for (const auto& prefix : paths.prefix) {
+        std::shared_ptr<PolicyList> list = by_path_prefix_.find(prefix);
+        if (list == nullptr) {
+          list = std::make_shared<PolicyList>();
+          by_path_prefix_.add(prefix, list);
+        }
+        addToList(*list, i);
+      }
+      has_indexed_policies_ = true;
+      continue;
+    }
+
+    unindexed_.push_back(i);
+  }
+}
+
+void PolicyIndex::addIndexedCandidates(const Network::Connection& connection,
+                                       const Http::RequestHeaderMap& headers,
+                                       Candidates& candidates) const {
+  const auto append = [&candidates](const PolicyList& list) {
+    candidates.insert(candidates.end(), list.begin(), list.end());
+  };
+
+  // The same identities as the authenticated principal matcher looks at.
+  const auto ssl = connection.ssl();
+  if (ssl != nullptr && !by_principal_.empty()) {
+    for (const std::string& uri : ssl->uriSanPeerCertificate()) {
+      addPrincipalCandidates(uri, candidates);
+    }
+    for (const std::string& dns : ssl->dnsSansPeerCertificate()) {
+      addPrincipalCandidates(dns, candidates);
+    }
+    addPrincipalCandidates(ssl->subjectPeerCertificate(), candidates);
+  }
+
+  if (headers.Path() != nullptr) {
+    const absl::string_view path = Http::PathUtil::removeQueryAndFragment(headers.getPathValue());
+    if (const auto it = by_exact_path_.find(path); it != by_exact_path_.end()) {
+      append(it->second);
+    }
+    by_path_prefix_.forEachPrefixValue(
+        path, [&append](const std::shared_ptr<PolicyList>& list) { append(*list); });
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+}
+
+void PolicyIndex::addPrincipalCandidates(absl::string_view name, Candidates& candidates) const {
+  if (const auto it = by_principal_.find(name); it != by_principal_.end()) {
+    candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+  }
+}
+
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
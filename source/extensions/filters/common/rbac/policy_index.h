@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/config/rbac/v3/rbac.pb.h"
+#include "envoy/http/header_map.h"
+#include "envoy/network/connection.h"
+
+#include "source/common/common/trie_lookup_table.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+
+/**
+ * Narrows down the policies of an RBAC engine that can match a connection or request, so that
+ * only those are evaluated. A policy whose principals all require an exact authenticated
+ * principal name is indexed by those names. Otherwise, a policy whose permissions all require an
+ * exact or prefix URL path is indexed by those paths. Other policies are always evaluated.
+ *
+ * The index never leaves out a policy that can match, so evaluating the candidates in order
+ * gives the same first match as evaluating every policy.
+ */
+class PolicyIndex {
+public:
+  // `policies` are in evaluation order, and are referred to by their position.
+  explicit PolicyIndex(const std::vector<const envoy::config::rbac::v3::Policy*>& policies);
+
+  // Calls `cb` with the position of every policy that may match, in increasing order, until it
+  // returns true.
+  template <class Callback>
+  void forEachCandidate(const Network::Connection& connection,
+                        const Http::RequestHeaderMap& headers, Callback cb) const {
+    if (!has_indexed_policies_) {
+      for (uint32_t policy : unindexed_) {
+        if (cb(policy)) {
+          return;
+        }
+      }
+      return;
+    }
+
+    Candidates indexed;
+    addIndexedCandidates(connection, headers, indexed);
+    // Merge the sorted candidates found in the index with the always evaluated policies.
+    auto it = indexed.begin();
+    for (uint32_t policy : unindexed_) {
+      for (; it != indexed.end() && *it < policy; ++it) {
+        if (cb(*it)) {
+          return;
+        }
+      }
+      if (cb(policy)) {
+        return;
+      }
+    }
+    for (; it != indexed.end(); ++it) {
+      if (cb(*it)) {
+        return;
+      }
+    }
+  }
+
+  // The number of policies that are evaluated for every connection or request.
+  size_t unindexedPolicies() const { return unindexed_.size(); }
+
+private:
+  using Candidates = absl::InlinedVector<uint32_t, 8>;
+  using PolicyList = std::vector<uint32_t>;
+
+  // Adds the positions of the indexed policies that may match, sorted and without duplicates.
+  void addIndexedCandidates(const Network::Connection& connection,
+                            const Http::RequestHeaderMap& headers, Candidates& candidates) const;
+  void addPrincipalCandidates(absl::string_view name, Candidates& candidates) const;
+
+  PolicyList unindexed_;
+  bool has_indexed_policies_{false};
+  absl::flat_hash_map<std::string, PolicyList> by_principal_;
+  absl::flat_hash_map<std::string, PolicyList> by_exact_path_;
+  TrieLookupTable<std::shared_ptr<PolicyList>> by_path_prefix_;
+};
+
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -42,7 +42,8 @@ GradientControllerConfig::GradientControllerConfig(
       min_concurrency_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config.min_rtt_calc_params(), min_concurrency, 3)),
       min_rtt_buffer_pct_(
-          PROTOBUF_PERCENT_TO_DOUBLE_OR_DEFAULT(proto_config.min_rtt_calc_params(), buffer, 25)) {}
+          PROTOBUF_PERCENT_TO_DOUBLE_OR_DEFAULT(proto_config.min_rtt_calc_params(), buffer, 25)),
+      continuous_min_rtt_(proto_config.min_rtt_calc_params().continuous()) {}
 GradientController::GradientController(GradientControllerConfig config,
                                        Event::Dispatcher& dispatcher, Runtime::Loader&,
                                        const std::string& stats_prefix, Stats::Scope& scope,
@@ -122,8 +123,14 @@ void GradientController::updateMinRTT() {
   deferred_limit_value_.store(0);
   stats_.min_rtt_calculation_active_.set(0);
 
-  min_rtt_calc_timer_->enableTimer(
-      applyJitter(config_.minRTTCalcInterval(), config_.jitterPercent()));
+  if (config_.continuousMinRTT()) {
+    // The minRTT is estimated from the sample windows from now on.
+    min_rtt_interval_start_ = time_source_.monotonicTime();
+    interval_min_rtt_ = std::chrono::microseconds::max();
+  } else {
+    min_rtt_calc_timer_->enableTimer(
+        applyJitter(config_.minRTTCalcInterval(), config_.jitterPercent()));
+  }
   sample_reset_timer_->enableTimer(config_.sampleRTTCalcInterval());
 }
 
@@ -145,12 +152,36 @@ void GradientController::resetSampleWindow() {
     return;
   }
 
+  if (config_.continuousMinRTT()) {
+    updateContinuousMinRTT();
+  }
   sample_rtt_ = processLatencySamplesAndClear();
   stats_.sample_rtt_msecs_.set(
       std::chrono::duration_cast<std::chrono::milliseconds>(sample_rtt_).count());
   updateConcurrencyLimit(calculateNewLimit());
 }
 
+void GradientController::updateContinuousMinRTT() {
+  // The lowest latency of the window, rather than the aggregate percentile, approximates the
+  // latency under ideal conditions while the upstream is loaded.
+  const std::array<double, 1> quantile{0};
+  std::array<double, 1> calculated_quantile;
+  hist_approx_quantile(latency_sample_hist_.get(), quantile.data(), 1, calculated_quantile.data());
+  const std::chrono::microseconds lowest_latency(static_cast<int>(calculated_quantile[0]));
+
+  interval_min_rtt_ = std::min(interval_min_rtt_, lowest_latency);
+  min_rtt_ = std::min<std::chrono::nanoseconds>(min_rtt_, lowest_latency);
+  const MonotonicTime now = time_source_.monotonicTime();
+  if (now - min_rtt_interval_start_ >= config_.minRTTCalcInterval()) {
+    // Forget the latencies sampled before the interval, in case the upstream got slower.
+    min_rtt_ = interval_min_rtt_;
+    interval_min_rtt_ = std::chrono::microseconds::max();
+    min_rtt_interval_start_ = now;
+  }
+  stats_.min_rtt_msecs_.set(
+      std::chrono::duration_cast<std::chrono::milliseconds>(min_rtt_).count());
+}
+
 std::chrono::microseconds GradientController::processLatencySamplesAndClear() {
   const std::array<double, 1> quantile{config_.sampleAggregatePercentile()};
   std::array<double, 1> calculated_quantile;
@@ -97,6 +97,8 @@ public:
     return std::max(0.0, std::min(val, 100.0)) / 100.0;
   }
 
+  bool continuousMinRTT() const { return continuous_min_rtt_; }
+
 private:
   class RuntimeKeyValues {
   public:
@@ -144,6 +146,9 @@ private:
 
   // The amount added to the measured minRTT as a hedge against natural variability in latency.
   const double min_rtt_buffer_pct_;
+
+  // Whether the minRTT is estimated from the sample windows after the first measurement.
+  const bool continuous_min_rtt_;
 };
 using GradientControllerConfigSharedPtr = std::shared_ptr<GradientControllerConfig>;
 
@@ -199,6 +204,11 @@ using GradientControllerConfigSharedPtr = std::shared_ptr<GradientControllerConf
  * configurable quantile value to represent the measured latencies. This quantile value sets
  * sampleRTT and the concurrency limit is updated as described in the algorithm section above.
  *
+ * With continuous minRTT estimation, only the first minRTT is measured in a minRTT sampling window.
+ * Afterwards, each sampleRTT calculation also lowers the minRTT to the lowest sampled latency, and
+ * every minRTT interval the minRTT is set to the lowest latency sampled during that interval, so
+ * that it can increase again.
+ *
  * When not in a sampling window, the controller is simply servicing the adaptive concurrency filter
  * via the public functions.
  *
@@ -236,6 +246,7 @@ private:
   uint32_t calculateNewLimit() ABSL_EXCLUSIVE_LOCKS_REQUIRED(sample_mutation_mtx_);
   void enterMinRTTSamplingWindow();
   void resetSampleWindow() ABSL_EXCLUSIVE_LOCKS_REQUIRED(sample_mutation_mtx_);
+  void updateContinuousMinRTT() ABSL_EXCLUSIVE_LOCKS_REQUIRED(sample_mutation_mtx_);
   void updateConcurrencyLimit(const uint32_t new_limit)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(sample_mutation_mtx_);
   std::chrono::milliseconds applyJitter(std::chrono::milliseconds interval,
@@ -261,6 +272,11 @@ private:
   // account for variable latencies. This is the numerator in the gradient value.
   std::chrono::nanoseconds min_rtt_;
 
+  // With continuous minRTT estimation, the start of the current minRTT interval and the lowest
+  // latency sampled since.
+  MonotonicTime min_rtt_interval_start_ ABSL_GUARDED_BY(sample_mutation_mtx_);
+  std::chrono::microseconds interval_min_rtt_ ABSL_GUARDED_BY(sample_mutation_mtx_);
+
   // Stores the aggregated sampled latencies for use in the gradient calculation.
   std::chrono::nanoseconds sample_rtt_ ABSL_GUARDED_BY(sample_mutation_mtx_);
 
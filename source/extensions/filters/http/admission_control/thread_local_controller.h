@@ -65,7 +65,7 @@ public:
   void recordFailure() override { recordRequest(false); }
 
   RequestData requestCounts() override {
-    maybeUpdateHistoricalData();
+    maybeUpdateHistoricalData(time_source_.monotonicTime());
     return global_data_;
   }
 
@@ -76,23 +76,22 @@ public:
 private:
   void recordRequest(bool success);
 
-  // Potentially remove any stale samples and record sample aggregates to the historical data.
-  void maybeUpdateHistoricalData();
+  // Potentially remove any stale samples and record sample aggregates to the historical data. The
+  // time is read once by the callers, as this runs for every request.
+  void maybeUpdateHistoricalData(MonotonicTime now);
 
   // Returns the age of the oldest sample in the historical data.
-  std::chrono::microseconds ageOfOldestSample() const {
+  std::chrono::microseconds ageOfOldestSample(MonotonicTime now) const {
     ASSERT(!historical_data_.empty());
     using namespace std::chrono;
-    return duration_cast<microseconds>(time_source_.monotonicTime() -
-                                       historical_data_.front().first);
+    return duration_cast<microseconds>(now - historical_data_.front().first);
   }
 
   // Returns the age of the newest sample in the historical data.
-  std::chrono::microseconds ageOfNewestSample() const {
+  std::chrono::microseconds ageOfNewestSample(MonotonicTime now) const {
     ASSERT(!historical_data_.empty());
     using namespace std::chrono;
-    return duration_cast<microseconds>(time_source_.monotonicTime() -
-                                       historical_data_.back().first);
+    return duration_cast<microseconds>(now - historical_data_.back().first);
   }
 
   // Removes the oldest sample in the historical data and reconciles the global data.
@@ -43,6 +43,11 @@ CacheFilterConfig::CacheFilterConfig(
     Server::Configuration::CommonFactoryContext& context)
     : vary_allow_list_(config.allowed_vary_headers(), context), time_source_(context.timeSource()),
       ignore_request_cache_control_header_(config.ignore_request_cache_control_header()),
+      collapsed_forwarding_timeout_(
+          config.has_collapsed_forwarding_timeout()
+              ? absl::make_optional(std::chrono::milliseconds(
+                    DurationUtil::durationToMilliseconds(config.collapsed_forwarding_timeout())))
+              : absl::nullopt),
       cluster_manager_(context.clusterManager()) {}
 
 CacheFilter::CacheFilter(std::shared_ptr<const CacheFilterConfig> config,
@@ -51,6 +56,9 @@ CacheFilter::CacheFilter(std::shared_ptr<const CacheFilterConfig> config,
 
 void CacheFilter::onDestroy() {
   filter_state_ = FilterState::Destroyed;
+  if (cancel_fill_wait_ != nullptr) {
+    stopWaitingForFill();
+  }
   if (lookup_ != nullptr) {
     lookup_->onDestroy();
   }
@@ -64,19 +72,30 @@ void CacheFilter::sendUpstreamRequest(Http::RequestHeaderMap& request_headers) {
   Router::RouteConstSharedPtr route = decoder_callbacks_->route();
   const Router::RouteEntry* route_entry = (route == nullptr) ? nullptr : route->routeEntry();
   if (route_entry == nullptr) {
+    abandonFill();
     return sendNoRouteResponse();
   }
   Upstream::ThreadLocalCluster* thread_local_cluster =
       config_->clusterManager().getThreadLocalCluster(route_entry->clusterName());
   if (thread_local_cluster == nullptr) {
+    abandonFill();
     return sendNoClusterResponse(route_entry->clusterName());
   }
+  // If this request is filling the cache entry, the UpstreamRequest ends the fill when it's done.
   upstream_request_ =
       UpstreamRequest::create(this, std::move(lookup_), std::move(lookup_result_), cache_,
                               thread_local_cluster->httpAsyncClient(), config_->upstreamOptions());
   upstream_request_->sendHeaders(request_headers);
 }
 
+void CacheFilter::abandonFill() {
+  if (filling_) {
+    // Nothing is going to be inserted, so don't keep the concurrent requests waiting.
+    filling_ = false;
+    config_->inFlightFills().endFill(*fill_key_);
+  }
+}
+
 void CacheFilter::sendNoRouteResponse() {
   decoder_callbacks_->sendLocalReply(Http::Code::NotFound, "", nullptr, absl::nullopt,
                                      "cache_no_route");
@@ -122,19 +141,72 @@ Http::FilterHeadersStatus CacheFilter::decodeHeaders(Http::RequestHeaderMap& hea
   }
   ASSERT(decoder_callbacks_);
 
-  LookupRequest lookup_request(headers, config_->timeSource().systemTime(),
+  is_head_request_ = headers.getMethodValue() == Http::Headers::get().MethodValues.Head;
+  startLookup(headers);
+  ENVOY_STREAM_LOG(debug, "CacheFilter::decodeHeaders starting lookup", *decoder_callbacks_);
+
+  // Stop the decoding stream until the cache lookup result is ready.
+  return Http::FilterHeadersStatus::StopAllIterationAndWatermark;
+}
+
+void CacheFilter::startLookup(Http::RequestHeaderMap& request_headers) {
+  LookupRequest lookup_request(request_headers, config_->timeSource().systemTime(),
                                config_->varyAllowList(),
                                config_->ignoreRequestCacheControlHeader());
   request_allows_inserts_ = !lookup_request.requestCacheControl().no_store_;
-  is_head_request_ = headers.getMethodValue() == Http::Headers::get().MethodValues.Head;
+  if (config_->collapsedForwardingTimeout().has_value() && !fill_key_.has_value()) {
+    fill_key_ = lookup_request.key();
+  }
   lookup_ = cache_->makeLookupContext(std::move(lookup_request), *decoder_callbacks_);
 
   ASSERT(lookup_);
-  getHeaders(headers);
-  ENVOY_STREAM_LOG(debug, "CacheFilter::decodeHeaders starting lookup", *decoder_callbacks_);
+  getHeaders(request_headers);
+}
 
-  // Stop the decoding stream until the cache lookup result is ready.
-  return Http::FilterHeadersStatus::StopAllIterationAndWatermark;
+void CacheFilter::onCacheMiss(Http::RequestHeaderMap& request_headers) {
+  // Only misses whose response may be inserted are worth waiting for.
+  if (!fill_key_.has_value() || waited_for_fill_ || !request_allows_inserts_ ||
+      is_head_request_) {
+    return sendUpstreamRequest(request_headers);
+  }
+  Event::Dispatcher& dispatcher = decoder_callbacks_->dispatcher();
+  absl::optional<InFlightFills::CancelFunction> cancel = config_->inFlightFills().waitForFill(
+      *fill_key_, dispatcher, [this, &request_headers]() { onFillComplete(request_headers); });
+  if (!cancel.has_value()) {
+    filling_ = true;
+    return sendUpstreamRequest(request_headers);
+  }
+  ENVOY_STREAM_LOG(debug, "CacheFilter waiting for a concurrent request to fill the cache",
+                   *decoder_callbacks_);
+  waited_for_fill_ = true;
+  cancel_fill_wait_ = std::move(*cancel);
+  fill_wait_timer_ =
+      dispatcher.createTimer([this, &request_headers]() { onFillWaitTimeout(request_headers); });
+  fill_wait_timer_->enableTimer(*config_->collapsedForwardingTimeout());
+}
+
+void CacheFilter::onFillComplete(Http::RequestHeaderMap& request_headers) {
+  ENVOY_STREAM_LOG(debug, "CacheFilter retrying lookup after a concurrent fill",
+                   *decoder_callbacks_);
+  stopWaitingForFill();
+  lookup_->onDestroy();
+  lookup_result_ = nullptr;
+  cache_entry_status_ = absl::nullopt;
+  // If the fill didn't insert anything usable, this lookup misses again and goes upstream.
+  startLookup(request_headers);
+}
+
+void CacheFilter::onFillWaitTimeout(Http::RequestHeaderMap& request_headers) {
+  ENVOY_STREAM_LOG(debug, "CacheFilter timed out waiting for a concurrent fill",
+                   *decoder_callbacks_);
+  stopWaitingForFill();
+  sendUpstreamRequest(request_headers);
+}
+
+void CacheFilter::stopWaitingForFill() {
+  ASSERT(cancel_fill_wait_ != nullptr);
+  std::exchange(cancel_fill_wait_, nullptr)();
+  fill_wait_timer_->disableTimer();
 }
 
 void CacheFilter::onUpstreamRequestComplete() { upstream_request_ = nullptr; }
@@ -171,6 +243,12 @@ Http::FilterHeadersStatus CacheFilter::encodeHeaders(Http::ResponseHeaderMap& he
     return Http::FilterHeadersStatus::Continue;
   }
 
+  if (cancel_fill_wait_ != nullptr) {
+    // A local reply was generated while waiting for a concurrent request to fill the cache.
+    stopWaitingForFill();
+    return Http::FilterHeadersStatus::Continue;
+  }
+
   IS_ENVOY_BUG("encodeHeaders should not be called except under the conditions handled above");
   return Http::FilterHeadersStatus::Continue;
 }
@@ -327,7 +405,7 @@ void CacheFilter::onHeaders(LookupResult&& result, Http::RequestHeaderMap& reque
     handleCacheHit(/* end_stream_after_headers = */ end_stream);
     return;
   case CacheEntryStatus::Unusable:
-    sendUpstreamRequest(request_headers);
+    onCacheMiss(request_headers);
     return;
   case CacheEntryStatus::LookupError:
     filter_state_ = FilterState::NotServingFromCache;
@@ -10,6 +10,7 @@
 #include "source/extensions/filters/http/cache/cache_headers_utils.h"
 #include "source/extensions/filters/http/cache/filter_state.h"
 #include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/filters/http/cache/in_flight_fills.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
 
 namespace Envoy {
@@ -30,11 +31,19 @@ public:
   const Http::AsyncClient::StreamOptions& upstreamOptions() const { return upstream_options_; }
   Upstream::ClusterManager& clusterManager() const { return cluster_manager_; }
   bool ignoreRequestCacheControlHeader() const { return ignore_request_cache_control_header_; }
+  // How long a cache miss waits for a concurrent request to fill the cache, if collapsed
+  // forwarding is enabled.
+  const absl::optional<std::chrono::milliseconds>& collapsedForwardingTimeout() const {
+    return collapsed_forwarding_timeout_;
+  }
+  InFlightFills& inFlightFills() const { return in_flight_fills_; }
 
 private:
   const VaryAllowList vary_allow_list_;
   TimeSource& time_source_;
   const bool ignore_request_cache_control_header_;
+  const absl::optional<std::chrono::milliseconds> collapsed_forwarding_timeout_;
+  mutable InFlightFills in_flight_fills_;
   Upstream::ClusterManager& cluster_manager_;
   Http::AsyncClient::StreamOptions upstream_options_;
 };
@@ -66,6 +75,9 @@ private:
   // filter chain so that the request can continue even if the downstream client disconnects.
   void sendUpstreamRequest(Http::RequestHeaderMap& request_headers);
 
+  // Ends the fill this request started, if any, when no upstream request is going to be sent.
+  void abandonFill();
+
   // In the event that there is no matching route when attempting to sendUpstreamRequest,
   // send a 404 locally.
   void sendNoRouteResponse();
@@ -82,6 +94,17 @@ private:
   // CacheFilter must make no more calls to upstream_request_ once this has been called.
   void onUpstreamRequestComplete();
 
+  // Creates lookup_ for the request and looks up its headers.
+  void startLookup(Http::RequestHeaderMap& request_headers);
+
+  // Called on a cache miss. Sends the request upstream, unless collapsed forwarding is enabled
+  // and a concurrent request is already filling the cache entry, in which case the lookup is
+  // retried once that fill ends or the wait times out.
+  void onCacheMiss(Http::RequestHeaderMap& request_headers);
+  void onFillComplete(Http::RequestHeaderMap& request_headers);
+  void onFillWaitTimeout(Http::RequestHeaderMap& request_headers);
+  void stopWaitingForFill();
+
   // Utility functions; make any necessary checks and call the corresponding lookup_ functions
   void getHeaders(Http::RequestHeaderMap& request_headers);
   void getBody();
@@ -159,6 +182,17 @@ private:
   bool is_head_request_ = false;
   // This toggle is used to detect callbacks being called directly and not posted.
   bool callback_called_directly_ = false;
+
+  // The key of the lookup, kept if collapsed forwarding is enabled.
+  absl::optional<Key> fill_key_;
+  // True if this request is filling the cache entry of fill_key_, until the UpstreamRequest it
+  // sends takes over ending the fill.
+  bool filling_ = false;
+  // True once the request has waited for a concurrent fill, so that it waits at most once.
+  bool waited_for_fill_ = false;
+  // Set while waiting for a concurrent request to fill the cache entry.
+  InFlightFills::CancelFunction cancel_fill_wait_;
+  Event::TimerPtr fill_wait_timer_;
   // The status of the insert operation or header update, or decision not to insert or update.
   // If it's too early to determine the final status, this is empty.
   absl::optional<InsertStatus> insert_status_;
@@ -79,6 +79,9 @@ public:
   LookupRequest(const Http::RequestHeaderMap& request_headers, SystemTime timestamp,
                 const VaryAllowList& vary_allow_list,
                 bool ignore_request_cache_control_header = false);
+  // Copied by caches that look up a request in several underlying caches.
+  LookupRequest(const LookupRequest& other);
+  LookupRequest(LookupRequest&& other) = default;
 
   const RequestCacheControl& requestCacheControl() const { return request_cache_control_; }
 
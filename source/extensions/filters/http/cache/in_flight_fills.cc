@@ -0,0 +1,58 @@
+#include "source/extensions/filters/http/cache/in_flight_fills.h"
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+absl::optional<InFlightFills::CancelFunction>
+InFlightFills::waitForFill(const Key& key, Event::Dispatcher& dispatcher,
+                           absl::AnyInvocable<void()> on_fill_complete) {
+  ASSERT(dispatcher.isThreadSafe());
+  absl::MutexLock lock(&mutex_);
+  auto [it, inserted] = fills_.try_emplace(key);
+  if (inserted) {
+    return absl::nullopt;
+  }
+  auto cancelled = std::make_shared<bool>(false);
+  it->second.push_back(Waiter{&dispatcher, std::move(on_fill_complete), cancelled});
+  return [&dispatcher, cancelled]() {
+    ASSERT(dispatcher.isThreadSafe());
+    *cancelled = true;
+  };
+}
+
+void InFlightFills::endFill(const Key& key) {
+  std::vector<Waiter> waiters;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = fills_.find(key);
+    ASSERT(it != fills_.end(), "endFill called for a key that isn't being filled");
+    if (it == fills_.end()) {
+      return;
+    }
+    waiters = std::move(it->second);
+    fills_.erase(it);
+  }
+  for (Waiter& waiter : waiters) {
+    // The waiter is cancelled on its own dispatcher, so checking there is race-free.
+    waiter.dispatcher_->post([on_fill_complete = std::move(waiter.on_fill_complete_),
+                              cancelled = std::move(waiter.cancelled_)]() mutable {
+      if (!*cancelled) {
+        on_fill_complete();
+      }
+    });
+  }
+}
+
+size_t InFlightFills::size() const {
+  absl::MutexLock lock(&mutex_);
+  return fills_.size();
+}
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "envoy/event/dispatcher.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/http/cache/key.pb.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+// Tracks the cache misses that are being filled from upstream, so that concurrent misses for the
+// same key wait for the response of the first one to be inserted rather than all being forwarded
+// upstream (collapsed forwarding). Shared by the workers using a filter config.
+class InFlightFills {
+public:
+  using CancelFunction = absl::AnyInvocable<void()>;
+
+  // If a fill of key is in flight, on_fill_complete is posted to dispatcher once it ends, and a
+  // function cancelling the wait, which must be called on dispatcher, is returned. Otherwise the
+  // caller becomes the filler of key and must call endFill(key) once its response is inserted or
+  // abandoned, and absl::nullopt is returned.
+  absl::optional<CancelFunction> waitForFill(const Key& key, Event::Dispatcher& dispatcher,
+                                             absl::AnyInvocable<void()> on_fill_complete);
+
+  // Ends the fill of key started by waitForFill, waking up the requests waiting for it.
+  void endFill(const Key& key);
+
+  // The number of keys being filled.
+  size_t size() const;
+
+private:
+  struct Waiter {
+    Event::Dispatcher* dispatcher_;
+    absl::AnyInvocable<void()> on_fill_complete_;
+    // Only read and written on dispatcher_, but shared with the posted callback.
+    std::shared_ptr<bool> cancelled_;
+  };
+
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<Key, std::vector<Waiter>, MessageUtil, MessageUtil>
+      fills_ ABSL_GUARDED_BY(mutex_);
+};
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -129,7 +129,8 @@ UpstreamRequest::UpstreamRequest(CacheFilter* filter, LookupContextPtr lookup,
       is_head_request_(filter->is_head_request_),
       request_allows_inserts_(filter->request_allows_inserts_), config_(filter->config_),
       filter_state_(filter->filter_state_), cache_(std::move(cache)),
-      stream_(async_client.start(*this, options)) {
+      stream_(async_client.start(*this, options)),
+      fill_key_(std::exchange(filter->filling_, false) ? filter->fill_key_ : absl::nullopt) {
   ASSERT(stream_ != nullptr);
 }
 
@@ -174,6 +175,11 @@ UpstreamRequest::~UpstreamRequest() {
     // to drain itself before destruction.
     insert_queue_->setSelfOwned(std::move(insert_queue_));
   }
+  if (fill_key_.has_value()) {
+    // If the insert is still draining, the waiting requests that look up the entry before it
+    // completes miss again and go upstream themselves.
+    config_->inFlightFills().endFill(*fill_key_);
+  }
 }
 
 void UpstreamRequest::onReset() { delete this; }
@@ -76,6 +76,8 @@ private:
   std::shared_ptr<HttpCache> cache_;
   Http::AsyncClient::Stream* stream_ = nullptr;
   std::unique_ptr<CacheInsertQueue> insert_queue_;
+  // Set if this request is filling a cache entry that concurrent requests wait for.
+  absl::optional<Key> fill_key_;
 };
 
 } // namespace Cache
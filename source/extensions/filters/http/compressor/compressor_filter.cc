@@ -3,6 +3,7 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/utility.h"
+#include "source/extensions/compression/common/compressor/offloaded_compressor.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -15,6 +16,8 @@ using envoy::extensions::filters::http::compressor::v3::CompressorPerRoute;
 
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
     accept_encoding_handle(Http::CustomHeaders::get().AcceptEncoding);
+Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
+    available_dictionary_handle(Http::CustomHeaders::get().AvailableDictionary);
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::ResponseHeaders>
     cache_control_handle(Http::CustomHeaders::get().CacheControl);
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::ResponseHeaders>
@@ -27,6 +30,12 @@ Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::Request
 Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::ResponseHeaders>
     response_content_encoding_handle(Http::CustomHeaders::get().ContentEncoding);
 
+// Load shed point under which requests and responses are compressed with less CPU effort.
+constexpr absl::string_view LowEffortLoadShedPoint{
+    "envoy.load_shed_points.http_compressor_low_effort"};
+// Load shed point under which requests and responses aren't compressed.
+constexpr absl::string_view BypassLoadShedPoint{"envoy.load_shed_points.http_compressor_bypass"};
+
 // Default minimum length of an upstream response that allows compression.
 const uint64_t DefaultMinimumContentLength = 30;
 
@@ -62,7 +71,7 @@ struct CompressorRegistry : public StreamInfo::FilterState::Object {
 // Key to per stream CompressorRegistry objects.
 const std::string& compressorRegistryKey() { CONSTRUCT_ON_FIRST_USE(std::string, "compressors"); }
 
-void compressAndUpdateStats(const Compression::Compressor::CompressorPtr& compressor,
+void compressAndUpdateStats(const Envoy::Compression::Compressor::CompressorPtr& compressor,
                             const CompressorStats& stats, Buffer::Instance& data, bool end_stream) {
   ASSERT(compressor != nullptr);
   stats.total_uncompressed_bytes_.add(data.length());
@@ -86,15 +95,22 @@ CompressorFilterConfig::DirectionConfig::DirectionConfig(
 CompressorFilterConfig::CompressorFilterConfig(
     const envoy::extensions::filters::http::compressor::v3::Compressor& proto_config,
     const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
-    Compression::Compressor::CompressorFactoryPtr compressor_factory)
+    Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory,
+    Server::LoadShedPointProvider& load_shed_point_provider,
+    Extensions::Common::Offload::OffloadPoolSharedPtr offload_pool)
     : common_stats_prefix_(fmt::format("{}compressor.{}.{}", stats_prefix,
                                        proto_config.compressor_library().name(),
                                        compressor_factory->statsPrefix())),
       request_direction_config_(proto_config, common_stats_prefix_, scope, runtime),
       response_direction_config_(proto_config, common_stats_prefix_, scope, runtime),
       content_encoding_(compressor_factory->contentEncoding()),
+      shared_dictionary_hash_(compressor_factory->sharedDictionaryHash()),
       compressor_factory_(std::move(compressor_factory)),
-      choose_first_(proto_config.choose_first()) {}
+      choose_first_(proto_config.choose_first()),
+      low_effort_point_(load_shed_point_provider.getLoadShedPoint(LowEffortLoadShedPoint)),
+      bypass_point_(load_shed_point_provider.getLoadShedPoint(BypassLoadShedPoint)),
+      offload_pool_(response_direction_config_.offloadCompression() ? std::move(offload_pool)
+                                                                    : nullptr) {}
 
 StringUtil::CaseUnorderedSet CompressorFilterConfig::DirectionConfig::contentTypeSet(
     const Protobuf::RepeatedPtrField<std::string>& types) {
@@ -130,6 +146,7 @@ CompressorFilterConfig::ResponseDirectionConfig::ResponseDirectionConfig(
           proto_config.has_response_direction_config()
               ? proto_config.response_direction_config().remove_accept_encoding_header()
               : proto_config.remove_accept_encoding_header()),
+      offload_compression_(proto_config.response_direction_config().offload_compression()),
       response_stats_{generateResponseStats(stats_prefix, scope)} {}
 
 const envoy::extensions::filters::http::compressor::v3::Compressor::CommonDirectionConfig
@@ -159,10 +176,34 @@ CompressorFilterConfig::ResponseDirectionConfig::commonConfig(
   return config;
 }
 
-Envoy::Compression::Compressor::CompressorPtr CompressorFilterConfig::makeCompressor() {
+bool CompressorFilterConfig::bypassCompression(const CompressorStats& stats) const {
+  if (bypass_point_ != nullptr && bypass_point_->shouldShedLoad()) {
+    stats.not_compressed_overload_.inc();
+    return true;
+  }
+  return false;
+}
+
+Envoy::Compression::Compressor::CompressorPtr
+CompressorFilterConfig::makeCompressor(const CompressorStats& stats) {
+  if (low_effort_point_ != nullptr && low_effort_point_->shouldShedLoad()) {
+    stats.compressed_low_effort_.inc();
+    return compressor_factory_->createLowEffortCompressor();
+  }
   return compressor_factory_->createCompressor();
 }
 
+Envoy::Compression::Compressor::AsyncCompressorPtr
+CompressorFilterConfig::makeAsyncResponseCompressor(Event::Dispatcher& dispatcher) {
+  Envoy::Compression::Compressor::AsyncCompressorPtr compressor =
+      compressor_factory_->createAsyncCompressor(dispatcher);
+  if (compressor == nullptr && offload_pool_ != nullptr) {
+    compressor = std::make_unique<Compression::Common::Compressor::OffloadedCompressor>(
+        makeCompressor(response_direction_config_.stats()), offload_pool_, dispatcher);
+  }
+  return compressor;
+}
+
 CompressorFilter::CompressorFilter(const CompressorFilterConfigSharedPtr config)
     : config_(std::move(config)) {}
 
@@ -200,6 +241,14 @@ Http::FilterHeadersStatus CompressorFilter::decodeHeaders(Http::RequestHeaderMap
     // decision on compressing the corresponding HTTP response.
     accept_encoding_ = std::make_unique<std::string>(accept_encoding->value().getStringView());
   }
+  const Http::HeaderEntry* available_dictionary =
+      headers.getInline(available_dictionary_handle.handle());
+  if (available_dictionary != nullptr) {
+    // The dictionary the client holds decides whether compressors sharing a dictionary with
+    // clients are usable for the response.
+    available_dictionary_ =
+        std::string(StringUtil::trim(available_dictionary->value().getStringView()));
+  }
 
   const auto& response_config = config_->responseDirectionConfig();
   const auto* per_route_config =
@@ -216,11 +265,11 @@ Http::FilterHeadersStatus CompressorFilter::decodeHeaders(Http::RequestHeaderMap
       request_config.isMinimumContentLength(headers) &&
       request_config.isContentTypeAllowed(headers) &&
       !headers.getInline(request_content_encoding_handle.handle()) &&
-      isTransferEncodingAllowed(headers)) {
+      isTransferEncodingAllowed(headers) && !config_->bypassCompression(request_config.stats())) {
     headers.removeContentLength();
     headers.setInline(request_content_encoding_handle.handle(), config_->contentEncoding());
     request_config.stats().compressed_.inc();
-    request_compressor_ = config_->makeCompressor();
+    request_compressor_ = config_->makeCompressor(request_config.stats());
   } else {
     request_config.stats().not_compressed_.inc();
   }
@@ -287,13 +336,18 @@ Http::FilterHeadersStatus CompressorFilter::encodeHeaders(Http::ResponseHeaderMa
       config.isContentTypeAllowed(headers) && !hasCacheControlNoTransform(headers) &&
       isEtagAllowed(headers) && !headers.getInline(response_content_encoding_handle.handle());
   if (!end_stream && isAcceptEncodingAllowed(isEnabledAndContentLengthBigEnough, headers) &&
-      isCompressible && isTransferEncodingAllowed(headers)) {
+      isCompressible && isTransferEncodingAllowed(headers) &&
+      !config_->bypassCompression(config.stats())) {
     sanitizeEtagHeader(headers);
     headers.removeContentLength();
     headers.setInline(response_content_encoding_handle.handle(), config_->contentEncoding());
     config.stats().compressed_.inc();
     // Finally instantiate the compressor.
-    response_compressor_ = config_->makeCompressor();
+    async_response_compressor_ =
+        config_->makeAsyncResponseCompressor(encoder_callbacks_->dispatcher());
+    if (async_response_compressor_ == nullptr) {
+      response_compressor_ = config_->makeCompressor(config.stats());
+    }
   } else {
     config.stats().not_compressed_.inc();
   }
@@ -302,13 +356,31 @@ Http::FilterHeadersStatus CompressorFilter::encodeHeaders(Http::ResponseHeaderMa
   // the Vary header would need to be inserted to let a caching proxy in front of Envoy
   // know that the requested resource still can be served with compression applied.
   if (isCompressible) {
-    insertVaryHeader(headers);
+    insertVaryHeader(headers, Http::CustomHeaders::get().VaryValues.AcceptEncoding);
+    // Likewise, the encoding of the response depends on the dictionary held by the client.
+    if (!config_->sharedDictionaryHash().empty()) {
+      insertVaryHeader(headers, Http::CustomHeaders::get().VaryValues.AvailableDictionary);
+    }
   }
 
   return Http::FilterHeadersStatus::Continue;
 }
 
 Http::FilterDataStatus CompressorFilter::encodeData(Buffer::Instance& data, bool end_stream) {
+  if (async_response_compressor_ != nullptr) {
+    config_->responseDirectionConfig().stats().total_uncompressed_bytes_.add(data.length());
+    pending_response_data_.move(data);
+    response_complete_ = end_stream;
+    compressNextResponseChunk();
+    const uint32_t buffer_limit = encoder_callbacks_->encoderBufferLimit();
+    if (buffer_limit > 0 && pending_response_data_.length() > buffer_limit &&
+        !above_write_buffer_high_watermark_) {
+      above_write_buffer_high_watermark_ = true;
+      encoder_callbacks_->onEncoderFilterAboveWriteBufferHighWatermark();
+    }
+    // The compressed data is injected once compressed.
+    return Http::FilterDataStatus::StopIterationNoBuffer;
+  }
   if (response_compressor_ != nullptr) {
     compressAndUpdateStats(response_compressor_, config_->responseDirectionConfig().stats(), data,
                            end_stream);
@@ -317,6 +389,13 @@ Http::FilterDataStatus CompressorFilter::encodeData(Buffer::Instance& data, bool
 }
 
 Http::FilterTrailersStatus CompressorFilter::encodeTrailers(Http::ResponseTrailerMap&) {
+  if (async_response_compressor_ != nullptr) {
+    // The trailers are passed on once the compressed stream is finished.
+    response_complete_ = true;
+    response_trailers_pending_ = true;
+    compressNextResponseChunk();
+    return Http::FilterTrailersStatus::StopIteration;
+  }
   if (response_compressor_ != nullptr) {
     Buffer::OwnedImpl empty_buffer;
     // The presence of trailers means the stream is ended, but encodeData()
@@ -329,6 +408,48 @@ Http::FilterTrailersStatus CompressorFilter::encodeTrailers(Http::ResponseTraile
   return Http::FilterTrailersStatus::Continue;
 }
 
+void CompressorFilter::onDestroy() {
+  // Cancels the compression of the pending chunk, if any.
+  async_response_compressor_.reset();
+}
+
+void CompressorFilter::compressNextResponseChunk() {
+  if (async_response_compressor_ == nullptr || compressing_response_chunk_ ||
+      (pending_response_data_.length() == 0 && !response_complete_)) {
+    return;
+  }
+  compressing_response_chunk_ = true;
+  const bool finish = response_complete_;
+  async_response_compressor_->compress(
+      pending_response_data_,
+      finish ? Envoy::Compression::Compressor::State::Finish
+             : Envoy::Compression::Compressor::State::Flush,
+      [this, finish](Buffer::InstancePtr compressed) {
+        onResponseChunkCompressed(std::move(compressed), finish);
+      });
+  if (above_write_buffer_high_watermark_) {
+    above_write_buffer_high_watermark_ = false;
+    encoder_callbacks_->onEncoderFilterBelowWriteBufferLowWatermark();
+  }
+}
+
+void CompressorFilter::onResponseChunkCompressed(Buffer::InstancePtr compressed, bool finished) {
+  compressing_response_chunk_ = false;
+  config_->responseDirectionConfig().stats().total_compressed_bytes_.add(compressed->length());
+  if (!finished) {
+    if (compressed->length() > 0) {
+      encoder_callbacks_->injectEncodedDataToFilterChain(*compressed, false);
+    }
+    compressNextResponseChunk();
+    return;
+  }
+  encoder_callbacks_->injectEncodedDataToFilterChain(*compressed, !response_trailers_pending_);
+  if (response_trailers_pending_) {
+    response_trailers_pending_ = false;
+    encoder_callbacks_->continueEncoding();
+  }
+}
+
 bool CompressorFilter::hasCacheControlNoTransform(Http::ResponseHeaderMap& headers) const {
   const Http::HeaderEntry* cache_control = headers.getInline(cache_control_handle.handle());
   if (cache_control) {
@@ -339,6 +460,15 @@ bool CompressorFilter::hasCacheControlNoTransform(Http::ResponseHeaderMap& heade
   return false;
 }
 
+// Whether the compressor for the encoding wins over a previous choice with the same q-value.
+bool CompressorFilter::preferredOnTie(
+    const std::map<std::string, CompressorInChain>& allowed_compressors,
+    absl::string_view encoding) {
+  const auto it = allowed_compressors.find(std::string(encoding));
+  return it != allowed_compressors.end() &&
+         (it->second.choose_first_ || it->second.shared_dictionary_);
+}
+
 // This function makes decision on which encoding to use for the response body and is
 // supposed to be called only once per request even if there are multiple compressor
 // filters in the chain. To make a decision the function needs to know what's the
@@ -386,14 +516,21 @@ CompressorFilter::chooseEncoding(const Http::ResponseHeaderMap& headers) const {
       }
     }
 
+    // A compressor sharing a dictionary with clients is only usable if the client holds it.
+    const bool shared_dictionary = !filter_config->sharedDictionaryHash().empty();
+    if (shared_dictionary && filter_config->sharedDictionaryHash() != available_dictionary_) {
+      continue;
+    }
+
     // There could be many compressors registered for the same content encoding, e.g. consider a
     // case when there are two gzip filters using different compression levels for different content
     // sizes. In such case we ignore duplicates (or different filters for the same encoding)
     // registered last.
     auto enc = allowed_compressors.find(filter_config->contentEncoding());
     if (enc == allowed_compressors.end()) {
-      allowed_compressors.insert(
-          {filter_config->contentEncoding(), {registration_count, filter_config->chooseFirst()}});
+      allowed_compressors.insert({filter_config->contentEncoding(),
+                                  {registration_count, filter_config->chooseFirst(),
+                                   shared_dictionary}});
       ++registration_count;
     }
   }
@@ -437,15 +574,15 @@ CompressorFilter::chooseEncoding(const Http::ResponseHeaderMap& headers) const {
   }
 
   // Find intersection of encodings accepted by the user agent and provided
-  // by the allowed compressors and choose the one with the highest q-value.
+  // by the allowed compressors and choose the one with the highest q-value. Among equal q-values,
+  // compressors sharing the dictionary held by the client are preferred, as they compress the best.
   EncPair choice{Http::CustomHeaders::get().AcceptEncodingValues.Identity, static_cast<float>(0)};
   for (const auto& pair : pairs) {
     if (allowed_compressors.count(std::string(pair.first)) ||
         pair.first == Http::CustomHeaders::get().AcceptEncodingValues.Identity ||
         pair.first == Http::CustomHeaders::get().AcceptEncodingValues.Wildcard) {
       if ((pair.second > choice.second) ||
-          (pair.second == choice.second &&
-           allowed_compressors[std::string(pair.first)].choose_first_)) {
+          (pair.second == choice.second && preferredOnTie(allowed_compressors, pair.first))) {
         choice = pair;
       }
     }
@@ -608,19 +745,17 @@ bool CompressorFilter::isTransferEncodingAllowed(Http::RequestOrResponseHeaderMa
   return true;
 }
 
-void CompressorFilter::insertVaryHeader(Http::ResponseHeaderMap& headers) {
+void CompressorFilter::insertVaryHeader(Http::ResponseHeaderMap& headers,
+                                        absl::string_view value) {
   const Http::HeaderEntry* vary = headers.getInline(vary_handle.handle());
   if (vary != nullptr) {
-    if (!StringUtil::findToken(vary->value().getStringView(), ",",
-                               Http::CustomHeaders::get().VaryValues.AcceptEncoding, true)) {
+    if (!StringUtil::findToken(vary->value().getStringView(), ",", value, true)) {
       std::string new_header;
-      absl::StrAppend(&new_header, vary->value().getStringView(), ", ",
-                      Http::CustomHeaders::get().VaryValues.AcceptEncoding);
+      absl::StrAppend(&new_header, vary->value().getStringView(), ", ", value);
       headers.setInline(vary_handle.handle(), new_header);
     }
   } else {
-    headers.setReferenceInline(vary_handle.handle(),
-                               Http::CustomHeaders::get().VaryValues.AcceptEncoding);
+    headers.setInline(vary_handle.handle(), value);
   }
 }
 
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <map>
+#include <string>
+
+#include "envoy/compression/compressor/async_compressor.h"
 #include "envoy/compression/compressor/factory.h"
+#include "envoy/event/dispatcher.h"
 #include "envoy/extensions/filters/http/compressor/v3/compressor.pb.h"
+#include "envoy/server/overload/load_shed_point.h"
 #include "envoy/stats/stats_macros.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/runtime/runtime_protos.h"
+#include "source/extensions/common/offload/offload_pool.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
 
 #include "absl/types/optional.h"
@@ -21,10 +29,14 @@ namespace Compressor {
  * compression. If the request (or response) was not marked for compression, the filter increments
  *  "not_compressed", but does not add to "total_uncompressed_bytes". This way, the user can
  *  measure the memory performance of the compression.
+ * "compressed_low_effort" and "not_compressed_overload" count the requests (or responses)
+ * compressed with less CPU effort, respectively not compressed, because of resource pressure.
  */
 #define COMMON_COMPRESSOR_STATS(COUNTER)                                                           \
   COUNTER(compressed)                                                                              \
+  COUNTER(compressed_low_effort)                                                                   \
   COUNTER(not_compressed)                                                                          \
+  COUNTER(not_compressed_overload)                                                                 \
   COUNTER(total_uncompressed_bytes)                                                                \
   COUNTER(total_compressed_bytes)                                                                  \
   COUNTER(content_length_too_small)
@@ -121,6 +133,7 @@ public:
     const ResponseCompressorStats& responseStats() const { return response_stats_; }
     bool disableOnEtagHeader() const { return disable_on_etag_header_; }
     bool removeAcceptEncodingHeader() const { return remove_accept_encoding_header_; }
+    bool offloadCompression() const { return offload_compression_; }
 
   private:
     static ResponseCompressorStats generateResponseStats(const std::string& prefix,
@@ -135,6 +148,7 @@ public:
 
     const bool disable_on_etag_header_;
     const bool remove_accept_encoding_header_;
+    const bool offload_compression_;
     const ResponseCompressorStats response_stats_;
   };
 
@@ -142,11 +156,24 @@ public:
   CompressorFilterConfig(
       const envoy::extensions::filters::http::compressor::v3::Compressor& proto_config,
       const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
-      Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory);
-
-  Envoy::Compression::Compressor::CompressorPtr makeCompressor();
+      Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory,
+      Server::LoadShedPointProvider& load_shed_point_provider,
+      Extensions::Common::Offload::OffloadPoolSharedPtr offload_pool = nullptr);
+
+  // Whether to skip compressing a request or response that would be compressed otherwise,
+  // because of resource pressure.
+  bool bypassCompression(const CompressorStats& stats) const;
+  // Makes the compressor of a request or response, with less CPU effort under resource pressure.
+  Envoy::Compression::Compressor::CompressorPtr makeCompressor(const CompressorStats& stats);
+  // Makes the asynchronous compressor of a response, if the compressor library compresses on an
+  // accelerator or the compression is offloaded, or nullptr.
+  Envoy::Compression::Compressor::AsyncCompressorPtr
+  makeAsyncResponseCompressor(Event::Dispatcher& dispatcher);
 
   const std::string contentEncoding() const { return content_encoding_; };
+  // The hash of the dictionary the compressors share with clients, if any, in which case they're
+  // only usable for the requests announcing it in their Available-Dictionary header.
+  const std::string& sharedDictionaryHash() const { return shared_dictionary_hash_; }
   bool chooseFirst() const { return choose_first_; };
   const RequestDirectionConfig& requestDirectionConfig() { return request_direction_config_; }
   const ResponseDirectionConfig& responseDirectionConfig() { return response_direction_config_; }
@@ -157,8 +184,12 @@ private:
   const ResponseDirectionConfig response_direction_config_;
 
   const std::string content_encoding_;
+  const std::string shared_dictionary_hash_;
   const Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory_;
   const bool choose_first_;
+  Server::LoadShedPoint* const low_effort_point_;
+  Server::LoadShedPoint* const bypass_point_;
+  const Extensions::Common::Offload::OffloadPoolSharedPtr offload_pool_;
 };
 using CompressorFilterConfigSharedPtr = std::shared_ptr<CompressorFilterConfig>;
 
@@ -197,6 +228,9 @@ public:
   Http::FilterDataStatus encodeData(Buffer::Instance& buffer, bool end_stream) override;
   Http::FilterTrailersStatus encodeTrailers(Http::ResponseTrailerMap&) override;
 
+  // Http::StreamFilterBase
+  void onDestroy() override;
+
 private:
   bool compressionEnabled(const CompressorFilterConfig::ResponseDirectionConfig& config,
                           const CompressorPerRouteFilterConfig* per_route_config) const;
@@ -208,7 +242,7 @@ private:
   bool isTransferEncodingAllowed(Http::RequestOrResponseHeaderMap& headers) const;
 
   void sanitizeEtagHeader(Http::ResponseHeaderMap& headers);
-  void insertVaryHeader(Http::ResponseHeaderMap& headers);
+  void insertVaryHeader(Http::ResponseHeaderMap& headers, absl::string_view value);
 
   class EncodingDecision : public StreamInfo::FilterState::Object {
   public:
@@ -226,15 +260,29 @@ private:
   struct CompressorInChain {
     uint32_t registration_count_;
     bool choose_first_;
+    bool shared_dictionary_;
   };
 
+  static bool preferredOnTie(const std::map<std::string, CompressorInChain>& allowed_compressors,
+                             absl::string_view encoding);
   std::unique_ptr<EncodingDecision> chooseEncoding(const Http::ResponseHeaderMap& headers) const;
   bool shouldCompress(const EncodingDecision& decision) const;
+  void compressNextResponseChunk();
+  void onResponseChunkCompressed(Buffer::InstancePtr compressed, bool finished);
 
   Envoy::Compression::Compressor::CompressorPtr response_compressor_;
   Envoy::Compression::Compressor::CompressorPtr request_compressor_;
+  // Compresses the response asynchronously instead of response_compressor_, one chunk at a time,
+  // the data received meanwhile waiting in pending_response_data_.
+  Envoy::Compression::Compressor::AsyncCompressorPtr async_response_compressor_;
+  Buffer::OwnedImpl pending_response_data_;
+  bool compressing_response_chunk_{};
+  bool response_complete_{};
+  bool response_trailers_pending_{};
+  bool above_write_buffer_high_watermark_{};
   const CompressorFilterConfigSharedPtr config_;
   std::unique_ptr<std::string> accept_encoding_;
+  std::string available_dictionary_;
 };
 
 } // namespace Compressor
@@ -27,9 +27,16 @@ absl::StatusOr<Http::FilterFactoryCb> CompressorFilterFactory::createFilterFacto
       *config_factory);
   Compression::Compressor::CompressorFactoryPtr compressor_factory =
       config_factory->createCompressorFactoryFromProto(*message, context);
+  Extensions::Common::Offload::OffloadPoolSharedPtr offload_pool;
+  if (proto_config.response_direction_config().offload_compression()) {
+    offload_pool = Extensions::Common::Offload::OffloadPool::singleton(
+        context.serverFactoryContext().singletonManager(),
+        context.serverFactoryContext().api().threadFactory());
+  }
   CompressorFilterConfigSharedPtr config = std::make_shared<CompressorFilterConfig>(
       proto_config, stats_prefix, context.scope(), context.serverFactoryContext().runtime(),
-      std::move(compressor_factory));
+      std::move(compressor_factory), context.serverFactoryContext().overloadManager(),
+      std::move(offload_pool));
   return [config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
     callbacks.addStreamFilter(std::make_shared<CompressorFilter>(config));
   };
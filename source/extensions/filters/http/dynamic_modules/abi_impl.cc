@@ -119,6 +119,34 @@ bool envoy_dynamic_module_callback_http_set_response_trailer(
   return setHeaderValueImpl(filter->response_trailers_, key, key_length, value, value_length);
 }
 
+bool setHeadersImpl(Http::HeaderMap* map,
+                    envoy_dynamic_module_type_module_http_header* headers_vector,
+                    size_t headers_vector_size) {
+  if (!map) {
+    return false;
+  }
+  for (size_t i = 0; i < headers_vector_size; i++) {
+    const auto& header = headers_vector[i];
+    setHeaderValueImpl(map, header.key_ptr, header.key_length, header.value_ptr,
+                       header.value_length);
+  }
+  return true;
+}
+
+bool envoy_dynamic_module_callback_http_set_request_headers(
+    envoy_dynamic_module_type_http_filter_envoy_ptr filter_envoy_ptr,
+    envoy_dynamic_module_type_module_http_header* headers_vector, size_t headers_vector_size) {
+  DynamicModuleHttpFilter* filter = static_cast<DynamicModuleHttpFilter*>(filter_envoy_ptr);
+  return setHeadersImpl(filter->request_headers_, headers_vector, headers_vector_size);
+}
+
+bool envoy_dynamic_module_callback_http_set_response_headers(
+    envoy_dynamic_module_type_http_filter_envoy_ptr filter_envoy_ptr,
+    envoy_dynamic_module_type_module_http_header* headers_vector, size_t headers_vector_size) {
+  DynamicModuleHttpFilter* filter = static_cast<DynamicModuleHttpFilter*>(filter_envoy_ptr);
+  return setHeadersImpl(filter->response_headers_, headers_vector, headers_vector_size);
+}
+
 size_t envoy_dynamic_module_callback_http_get_request_headers_count(
     envoy_dynamic_module_type_http_filter_envoy_ptr filter_envoy_ptr) {
   DynamicModuleHttpFilter* filter = static_cast<DynamicModuleHttpFilter*>(filter_envoy_ptr);
@@ -0,0 +1,274 @@
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "source/common/common/macros.h"
+#include "source/common/http/header_utility.h"
+#include "source/common/http/headers.h"
+#include "source/common/http/path_utility.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+
+namespace {
+
+// Separates the parts of a cache key. It can't appear in header values.
+constexpr absl::string_view KeySeparator = "\n";
+
+// The headers that carry the credentials of a request, always part of the cache key.
+const std::vector<Http::LowerCaseString>& credentialHeaders() {
+  CONSTRUCT_ON_FIRST_USE(std::vector<Http::LowerCaseString>,
+                         Http::CustomHeaders::get().Authorization,
+                         Http::Headers::get().ProxyAuthorization, Http::Headers::get().Cookie);
+}
+
+void appendField(std::string& key, absl::string_view value) {
+  absl::StrAppend(&key, KeySeparator, value.size(), ":", value);
+}
+
+void appendHeader(std::string& key, const Http::RequestHeaderMap& headers,
+                  const Http::LowerCaseString& name) {
+  const auto value = Http::HeaderUtility::getAllOfHeaderAsString(headers, name);
+  // Tell an absent header apart from an empty one.
+  absl::StrAppend(&key, KeySeparator, value.result().has_value() ? "=" : "",
+                  value.result().value_or(""));
+}
+
+uint64_t headersBytes(const Filters::Common::ExtAuthz::UnsafeHeaderVector& headers) {
+  uint64_t bytes = 0;
+  for (const auto& [name, value] : headers) {
+    bytes += name.size() + value.size();
+  }
+  return bytes;
+}
+
+} // namespace
+
+CachedResponseSharedPtr DecisionCache::lookup(absl::string_view key, MonotonicTime now,
+                                              MonotonicTime* expires_at) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  if (it->second->expires_at <= now) {
+    remove(it->second);
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  if (expires_at != nullptr) {
+    *expires_at = it->second->expires_at;
+  }
+  return it->second->response;
+}
+
+uint64_t DecisionCache::insert(absl::string_view key, CachedResponseSharedPtr response,
+                               MonotonicTime expires_at) {
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    remove(it->second);
+  }
+  const uint64_t bytes = entryBytes(key, *response);
+  if (bytes > max_bytes_) {
+    return 0;
+  }
+
+  uint64_t evicted = 0;
+  while (bytes_ + bytes > max_bytes_) {
+    remove(std::prev(entries_.end()));
+    ++evicted;
+  }
+  entries_.push_front(Entry{std::string(key), std::move(response), expires_at, bytes});
+  index_.emplace(entries_.front().key, entries_.begin());
+  bytes_ += bytes;
+  return evicted;
+}
+
+void DecisionCache::remove(EntryList::iterator it) {
+  bytes_ -= it->bytes;
+  index_.erase(it->key);
+  entries_.erase(it);
+}
+
+uint64_t DecisionCache::entryBytes(absl::string_view key,
+                                   const Filters::Common::ExtAuthz::Response& response) {
+  uint64_t bytes = sizeof(Entry) + sizeof(Filters::Common::ExtAuthz::Response) + 2 * key.size() +
+                   response.body.size() + response.dynamic_metadata.ByteSizeLong();
+  bytes += headersBytes(response.headers_to_append) + headersBytes(response.headers_to_set) +
+           headersBytes(response.headers_to_add) + headersBytes(response.response_headers_to_add) +
+           headersBytes(response.response_headers_to_set) +
+           headersBytes(response.response_headers_to_add_if_absent) +
+           headersBytes(response.response_headers_to_overwrite_if_exists);
+  for (const auto& header : response.headers_to_remove) {
+    bytes += header.size();
+  }
+  for (const auto& [name, value] : response.query_parameters_to_set) {
+    bytes += name.size() + value.size();
+  }
+  for (const auto& param : response.query_parameters_to_remove) {
+    bytes += param.size();
+  }
+  return bytes;
+}
+
+DecisionCacheManager::DecisionCacheManager(
+    const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config,
+    Server::Configuration::ServerFactoryContext& factory_context)
+    : time_source_(factory_context.timeSource()),
+      include_peer_identity_(config.include_peer_identity()),
+      default_ttl_(config.has_default_ttl()
+                       ? absl::optional<std::chrono::milliseconds>(
+                             PROTOBUF_GET_MS_REQUIRED(config, default_ttl))
+                       : absl::nullopt),
+      max_ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config, max_ttl, DefaultDecisionCacheMaxTtl.count())),
+      ttl_metadata_key_(config.ttl_metadata_key().empty() ? DefaultDecisionTtlMetadataKey
+                                                          : config.ttl_metadata_key()),
+      tls_(factory_context.threadLocal()) {
+  for (const auto& header : config.key_headers()) {
+    key_headers_.emplace_back(header);
+  }
+  if (config.has_path_template()) {
+    auto regex_or =
+        Regex::Utility::parseRegex(config.path_template().pattern(), factory_context.regexEngine());
+    THROW_IF_NOT_OK_REF(regex_or.status());
+    path_template_ = std::move(regex_or.value());
+    path_template_substitution_ = config.path_template().substitution();
+  }
+
+  const uint64_t max_bytes =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_bytes, DefaultDecisionCacheMaxBytes);
+  if (config.enable_shared_tier()) {
+    shared_tier_ = std::make_unique<SharedDecisionCache>(max_bytes);
+  }
+  tls_.set([max_bytes](Event::Dispatcher&) {
+    return std::make_shared<ThreadLocalDecisionCache>(max_bytes);
+  });
+}
+
+std::string DecisionCacheManager::cacheKey(
+    const Http::RequestHeaderMap& headers, const Network::Connection* connection,
+    const Router::Route* route, const Protobuf::Map<std::string, std::string>& context_extensions,
+    const envoy::config::core::v3::Metadata& route_metadata_context) const {
+  std::string key = absl::StrCat(headers.getMethodValue(), KeySeparator, headers.getHostValue(),
+                                 KeySeparator);
+  if (path_template_ != nullptr) {
+    absl::StrAppend(&key, path_template_->replaceAll(
+                              Http::PathUtil::removeQueryAndFragment(headers.getPathValue()),
+                              path_template_substitution_));
+  } else {
+    absl::StrAppend(&key, headers.getPathValue());
+  }
+
+  // Names from the configuration may contain the separator, so they are prefixed by their length.
+  if (route != nullptr) {
+    appendField(key, route->virtualHost().name());
+    appendField(key, route->routeName());
+  } else {
+    absl::StrAppend(&key, KeySeparator, "-");
+  }
+  // The map is not ordered, so the extensions are sorted by name.
+  std::vector<std::pair<absl::string_view, absl::string_view>> extensions(
+      context_extensions.begin(), context_extensions.end());
+  std::sort(extensions.begin(), extensions.end());
+  absl::StrAppend(&key, KeySeparator, extensions.size());
+  for (const auto& [name, value] : extensions) {
+    appendField(key, name);
+    appendField(key, value);
+  }
+  absl::StrAppend(&key, KeySeparator,
+                  route_metadata_context.filter_metadata().empty() &&
+                          route_metadata_context.typed_filter_metadata().empty()
+                      ? 0
+                      : MessageUtil::hash(route_metadata_context));
+
+  for (const auto& header : credentialHeaders()) {
+    appendHeader(key, headers, header);
+  }
+  for (const auto& header : key_headers_) {
+    appendHeader(key, headers, header);
+  }
+
+  if (include_peer_identity_ && connection != nullptr) {
+    absl::StrAppend(&key, KeySeparator);
+    const auto ssl = connection->ssl();
+    if (ssl != nullptr && !ssl->uriSanPeerCertificate().empty()) {
+      absl::StrAppend(&key, "uri:", ssl->uriSanPeerCertificate()[0]);
+    } else if (ssl != nullptr && !ssl->subjectPeerCertificate().empty()) {
+      absl::StrAppend(&key, "subject:", ssl->subjectPeerCertificate());
+    } else {
+      const auto& address = connection->connectionInfoProvider().remoteAddress();
+      if (address->ip() != nullptr) {
+        absl::StrAppend(&key, "ip:", address->ip()->addressAsString());
+      } else {
+        absl::StrAppend(&key, "address:", address->asStringView());
+      }
+    }
+  }
+  return key;
+}
+
+CachedResponseSharedPtr DecisionCacheManager::lookup(const std::string& key) {
+  const MonotonicTime now = time_source_.monotonicTime();
+  DecisionCache& local = tls_->cache;
+  CachedResponseSharedPtr response = local.lookup(key, now);
+  if (response != nullptr || shared_tier_ == nullptr) {
+    return response;
+  }
+  MonotonicTime expires_at;
+  response = shared_tier_->lookup(key, now, &expires_at);
+  if (response != nullptr) {
+    local.insert(key, response, expires_at);
+  }
+  return response;
+}
+
+uint64_t DecisionCacheManager::insert(const std::string& key,
+                                      const Filters::Common::ExtAuthz::Response& response) {
+  const auto ttl = decisionTtl(response);
+  if (!ttl.has_value()) {
+    return 0;
+  }
+  const MonotonicTime expires_at = time_source_.monotonicTime() + ttl.value();
+  auto cached = std::make_shared<const Filters::Common::ExtAuthz::Response>(response);
+  if (shared_tier_ != nullptr) {
+    shared_tier_->insert(key, cached, expires_at);
+  }
+  return tls_->cache.insert(key, std::move(cached), expires_at);
+}
+
+absl::optional<std::chrono::milliseconds>
+DecisionCacheManager::decisionTtl(const Filters::Common::ExtAuthz::Response& response) const {
+  absl::optional<std::chrono::milliseconds> ttl = default_ttl_;
+  const auto it = response.dynamic_metadata.fields().find(ttl_metadata_key_);
+  if (it != response.dynamic_metadata.fields().end()) {
+    double seconds = 0;
+    if (it->second.kind_case() == ProtobufWkt::Value::kNumberValue) {
+      seconds = it->second.number_value();
+    } else if (it->second.kind_case() != ProtobufWkt::Value::kStringValue ||
+               !absl::SimpleAtod(it->second.string_value(), &seconds)) {
+      return absl::nullopt;
+    }
+    // The value comes from the authorization server, so it is bounded before the conversion,
+    // which is undefined for values that don't fit.
+    const double ms = seconds * 1000;
+    if (!std::isfinite(ms) || ms <= 0) {
+      return absl::nullopt;
+    }
+    ttl = ms >= max_ttl_.count() ? max_ttl_ : std::chrono::milliseconds(static_cast<int64_t>(ms));
+  }
+  if (!ttl.has_value() || ttl.value() <= std::chrono::milliseconds::zero()) {
+    return absl::nullopt;
+  }
+  return std::min(ttl.value(), max_ttl_);
+}
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
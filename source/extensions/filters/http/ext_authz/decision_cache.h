@@ -0,0 +1,161 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/config/core/v3/base.pb.h"
+#include "envoy/extensions/filters/http/ext_authz/v3/ext_authz.pb.h"
+#include "envoy/http/header_map.h"
+#include "envoy/network/connection.h"
+#include "envoy/router/router.h"
+#include "envoy/server/factory_context.h"
+#include "envoy/thread_local/thread_local.h"
+#include "envoy/thread_local/thread_local_object.h"
+
+#include "source/common/common/regex.h"
+#include "source/extensions/filters/common/ext_authz/ext_authz.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+
+using CachedResponseSharedPtr = std::shared_ptr<const Filters::Common::ExtAuthz::Response>;
+
+// Default value of DecisionCache.max_bytes.
+inline constexpr uint64_t DefaultDecisionCacheMaxBytes = 1024 * 1024;
+// Default value of DecisionCache.max_ttl.
+inline constexpr std::chrono::milliseconds DefaultDecisionCacheMaxTtl = std::chrono::hours(1);
+// Default value of DecisionCache.ttl_metadata_key.
+inline constexpr absl::string_view DefaultDecisionTtlMetadataKey = "decision_ttl_seconds";
+
+/**
+ * A least recently used cache of authorization decisions, bounded by the approximate memory of its
+ * entries. Entries expire at the time given when they are inserted. Not thread safe.
+ */
+class DecisionCache {
+public:
+  explicit DecisionCache(uint64_t max_bytes) : max_bytes_(max_bytes) {}
+
+  // Returns the decision cached under `key`, or nullptr if there is none or it expired at `now`.
+  // If `expires_at` is not null, it is set to the expiry of the returned decision.
+  CachedResponseSharedPtr lookup(absl::string_view key, MonotonicTime now,
+                                 MonotonicTime* expires_at = nullptr);
+
+  // Caches `response` under `key` until `expires_at`, replacing any previous entry. Returns the
+  // number of entries evicted to make room for it.
+  uint64_t insert(absl::string_view key, CachedResponseSharedPtr response,
+                  MonotonicTime expires_at);
+
+  size_t size() const { return entries_.size(); }
+  uint64_t bytes() const { return bytes_; }
+
+  // The approximate memory used by an entry.
+  static uint64_t entryBytes(absl::string_view key,
+                             const Filters::Common::ExtAuthz::Response& response);
+
+private:
+  struct Entry {
+    std::string key;
+    CachedResponseSharedPtr response;
+    MonotonicTime expires_at;
+    uint64_t bytes;
+  };
+  using EntryList = std::list<Entry>;
+
+  void remove(EntryList::iterator it);
+
+  const uint64_t max_bytes_;
+  uint64_t bytes_{0};
+  // The most recently used entry is at the front. The keys of the index point into the entries.
+  EntryList entries_;
+  absl::flat_hash_map<absl::string_view, EntryList::iterator> index_;
+};
+
+/**
+ * A DecisionCache shared by all workers.
+ */
+class SharedDecisionCache {
+public:
+  explicit SharedDecisionCache(uint64_t max_bytes) : cache_(max_bytes) {}
+
+  CachedResponseSharedPtr lookup(absl::string_view key, MonotonicTime now,
+                                 MonotonicTime* expires_at) {
+    absl::MutexLock lock(&mutex_);
+    return cache_.lookup(key, now, expires_at);
+  }
+
+  uint64_t insert(absl::string_view key, CachedResponseSharedPtr response,
+                  MonotonicTime expires_at) {
+    absl::MutexLock lock(&mutex_);
+    return cache_.insert(key, std::move(response), expires_at);
+  }
+
+private:
+  absl::Mutex mutex_;
+  DecisionCache cache_ ABSL_GUARDED_BY(mutex_);
+};
+
+struct ThreadLocalDecisionCache : public ThreadLocal::ThreadLocalObject {
+  explicit ThreadLocalDecisionCache(uint64_t max_bytes) : cache(max_bytes) {}
+
+  DecisionCache cache;
+};
+
+/**
+ * The decision caches of one filter config: a cache per worker and the optional shared tier.
+ */
+class DecisionCacheManager {
+public:
+  DecisionCacheManager(
+      const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config,
+      Server::Configuration::ServerFactoryContext& factory_context);
+
+  // Returns the cache key of the request, built from its method, host, (templated) path, its
+  // credentials, the configured headers and, if configured, the identity of the peer. The route,
+  // the context extensions merged from the per-route configs and the route metadata sent to the
+  // authorization server are part of the key as well, as they can change the decision.
+  std::string
+  cacheKey(const Http::RequestHeaderMap& headers, const Network::Connection* connection,
+           const Router::Route* route,
+           const Protobuf::Map<std::string, std::string>& context_extensions,
+           const envoy::config::core::v3::Metadata& route_metadata_context) const;
+
+  // Returns the decision cached under `key` by this worker or, on a miss, by the shared tier.
+  CachedResponseSharedPtr lookup(const std::string& key);
+
+  // Caches the decision for the TTL returned by the authorization server or the default TTL.
+  // Returns the number of entries evicted from the cache of this worker.
+  uint64_t insert(const std::string& key, const Filters::Common::ExtAuthz::Response& response);
+
+private:
+  // Returns the TTL of the decision, at most max_ttl_, or nullopt if it must not be cached.
+  absl::optional<std::chrono::milliseconds>
+  decisionTtl(const Filters::Common::ExtAuthz::Response& response) const;
+
+  TimeSource& time_source_;
+  std::vector<Http::LowerCaseString> key_headers_;
+  Regex::CompiledMatcherPtr path_template_;
+  std::string path_template_substitution_;
+  const bool include_peer_identity_;
+  const absl::optional<std::chrono::milliseconds> default_ttl_;
+  const std::chrono::milliseconds max_ttl_;
+  const std::string ttl_metadata_key_;
+  std::unique_ptr<SharedDecisionCache> shared_tier_;
+  ThreadLocal::TypedSlot<ThreadLocalDecisionCache> tls_;
+};
+
+using DecisionCacheManagerPtr = std::unique_ptr<DecisionCacheManager>;
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -160,6 +160,10 @@ FilterConfig::FilterConfig(const envoy::extensions::filters::http::ext_authz::v3
     disallowed_headers_matcher_ = Filters::Common::ExtAuthz::CheckRequestUtils::toRequestMatchers(
         config.disallowed_headers(), false, factory_context);
   }
+  if (config.has_decision_cache()) {
+    decision_cache_ =
+        std::make_unique<DecisionCacheManager>(config.decision_cache(), factory_context);
+  }
 }
 
 void FilterConfigPerRoute::merge(const FilterConfigPerRoute& other) {
@@ -234,6 +238,31 @@ void Filter::initiateCall(const Http::RequestHeaderMap& headers) {
                         config_->routeTypedMetadataContextNamespaces(), route_metadata_context);
   }
 
+  // Decisions on requests whose body is sent to the authorization server are not cached, as the
+  // body is not part of the cache key. The key is built after the per-route configs are merged,
+  // as they change what is sent to the authorization server.
+  DecisionCacheManager* decision_cache = config_->decisionCache();
+  if (decision_cache != nullptr && !buffer_data_) {
+    std::string key =
+        decision_cache->cacheKey(headers, decoder_callbacks_->connection().ptr(),
+                                 decoder_callbacks_->route().get(), context_extensions,
+                                 route_metadata_context);
+    CachedResponseSharedPtr cached = decision_cache->lookup(key);
+    if (cached != nullptr) {
+      ENVOY_STREAM_LOG(trace, "ext_authz filter using cached decision", *decoder_callbacks_);
+      stats_.decision_cache_hit_.inc();
+      state_ = State::Calling;
+      filter_return_ = FilterReturn::StopDecoding;
+      cluster_ = decoder_callbacks_->clusterInfo();
+      initiating_call_ = true;
+      onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(*cached));
+      initiating_call_ = false;
+      return;
+    }
+    stats_.decision_cache_miss_.inc();
+    decision_cache_key_ = std::move(key);
+  }
+
   Filters::Common::ExtAuthz::CheckRequestUtils::createHttpCheck(
       decoder_callbacks_, headers, std::move(context_extensions), std::move(metadata_context),
       std::move(route_metadata_context), check_request_, max_request_bytes_, config_->packAsBytes(),
@@ -474,6 +503,11 @@ void Filter::onComplete(Filters::Common::ExtAuthz::ResponsePtr&& response) {
 
   updateLoggingInfo();
 
+  if (!decision_cache_key_.empty() && response->status != CheckStatus::Error) {
+    stats_.decision_cache_eviction_.add(
+        config_->decisionCache()->insert(decision_cache_key_, *response));
+  }
+
   if (!response->dynamic_metadata.fields().empty()) {
     if (!config_->enableDynamicMetadataIngestion()) {
       ENVOY_STREAM_LOG(trace,
@@ -25,6 +25,7 @@
 #include "source/extensions/filters/common/ext_authz/ext_authz_grpc_impl.h"
 #include "source/extensions/filters/common/ext_authz/ext_authz_http_impl.h"
 #include "source/extensions/filters/common/mutation_rules/mutation_rules.h"
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -43,7 +44,10 @@ namespace ExtAuthz {
   COUNTER(failure_mode_allowed)                                                                    \
   COUNTER(invalid)                                                                                 \
   COUNTER(ignored_dynamic_metadata)                                                                \
-  COUNTER(filter_state_name_collision)
+  COUNTER(filter_state_name_collision)                                                             \
+  COUNTER(decision_cache_hit)                                                                      \
+  COUNTER(decision_cache_miss)                                                                     \
+  COUNTER(decision_cache_eviction)
 
 /**
  * Wrapper struct for ext_authz filter stats. @see stats_macros.h
@@ -206,6 +210,9 @@ public:
     return disallowed_headers_matcher_;
   }
 
+  // Returns nullptr if the decision cache is not configured.
+  DecisionCacheManager* decisionCache() const { return decision_cache_.get(); }
+
 private:
   static Http::Code toErrorCode(uint64_t status) {
     const auto code = static_cast<Http::Code>(status);
@@ -270,6 +277,7 @@ private:
 
   Filters::Common::ExtAuthz::MatcherSharedPtr allowed_headers_matcher_;
   Filters::Common::ExtAuthz::MatcherSharedPtr disallowed_headers_matcher_;
+  DecisionCacheManagerPtr decision_cache_;
 
 public:
   // TODO(nezdolik): deprecate cluster scope stats counters in favor of filter scope stats
@@ -427,6 +435,8 @@ private:
   bool buffer_data_{};
   bool skip_check_{false};
   envoy::service::auth::v3::CheckRequest check_request_{};
+  // The key under which the decision for this request is cached, if the decision cache missed.
+  std::string decision_cache_key_;
 };
 
 } // namespace ExtAuthz
@@ -4,6 +4,7 @@
 #include "source/extensions/filters/http/ext_proc/client_impl.h"
 #include "source/extensions/filters/http/ext_proc/ext_proc.h"
 #include "source/extensions/filters/http/ext_proc/http_client/http_client_impl.h"
+#include "source/extensions/filters/http/ext_proc/multiplexed_client_impl.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -60,6 +61,10 @@ absl::Status verifyFilterConfig(
         "One and only one of grpc_service or http_service must be configured");
   }
 
+  if (config.has_multiplexing() && config.has_http_service()) {
+    return absl::InvalidArgumentError("multiplexing is only supported with grpc_service");
+  }
+
   if (config.disable_clear_route_cache() &&
       (config.route_cache_action() !=
        envoy::extensions::filters::http::ext_proc::v3::ExternalProcessor::DEFAULT)) {
@@ -91,7 +96,17 @@ ExternalProcessingFilterConfig::createFilterFactoryFromProtoTyped(
       proto_config, std::chrono::milliseconds(message_timeout_ms), max_message_timeout_ms,
       dual_info.scope, stats_prefix, dual_info.is_upstream,
       Envoy::Extensions::Filters::Common::Expr::getBuilder(context), context);
-  if (proto_config.has_grpc_service()) {
+  if (proto_config.has_multiplexing()) {
+    auto shared_streams = std::make_shared<SharedProcessorStreams>(
+        proto_config.multiplexing(), context.clusterManager().grpcAsyncClientManager(),
+        dual_info.scope, context.threadLocal());
+    return [filter_config = std::move(filter_config), shared_streams = std::move(shared_streams)](
+               Http::FilterChainFactoryCallbacks& callbacks) {
+      auto client = std::make_unique<MultiplexedProcessorClient>(shared_streams);
+      callbacks.addStreamFilter(
+          Http::StreamFilterSharedPtr{std::make_shared<Filter>(filter_config, std::move(client))});
+    };
+  } else if (proto_config.has_grpc_service()) {
     return [filter_config = std::move(filter_config), &context,
             dual_info](Http::FilterChainFactoryCallbacks& callbacks) {
       auto client = std::make_unique<ExternalProcessorClientImpl>(
@@ -136,7 +151,17 @@ ExternalProcessingFilterConfig::createFilterFactoryFromProtoWithServerContextTyp
       server_context.scope(), stats_prefix, false,
       Envoy::Extensions::Filters::Common::Expr::getBuilder(server_context), server_context);
 
-  if (proto_config.has_grpc_service()) {
+  if (proto_config.has_multiplexing()) {
+    auto shared_streams = std::make_shared<SharedProcessorStreams>(
+        proto_config.multiplexing(), server_context.clusterManager().grpcAsyncClientManager(),
+        server_context.scope(), server_context.threadLocal());
+    return [filter_config = std::move(filter_config), shared_streams = std::move(shared_streams)](
+               Http::FilterChainFactoryCallbacks& callbacks) {
+      auto client = std::make_unique<MultiplexedProcessorClient>(shared_streams);
+      callbacks.addStreamFilter(
+          Http::StreamFilterSharedPtr{std::make_shared<Filter>(filter_config, std::move(client))});
+    };
+  } else if (proto_config.has_grpc_service()) {
     return [filter_config = std::move(filter_config),
             &server_context](Http::FilterChainFactoryCallbacks& callbacks) {
       auto client = std::make_unique<ExternalProcessorClientImpl>(
@@ -0,0 +1,254 @@
+#include "source/extensions/filters/http/ext_proc/multiplexed_client_impl.h"
+
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExternalProcessing {
+
+static constexpr char kMultiplexedMethod[] =
+    "envoy.service.ext_proc.v3.ExternalProcessor.ProcessMultiplexed";
+
+MultiplexedProcessorStream::MultiplexedProcessorStream(SharedProcessorStreamSharedPtr parent,
+                                                       uint64_t stream_id,
+                                                       ExternalProcessorCallbacks& callbacks,
+                                                       TimeSource& time_source)
+    : parent_(std::move(parent)), stream_id_(stream_id), callbacks_(callbacks),
+      stream_info_(time_source, nullptr, StreamInfo::FilterState::LifeSpan::FilterChain) {
+  stream_info_.setUpstreamInfo(std::make_shared<StreamInfo::UpstreamInfoImpl>());
+}
+
+MultiplexedProcessorStream::~MultiplexedProcessorStream() { close(); }
+
+void MultiplexedProcessorStream::send(envoy::service::ext_proc::v3::ProcessingRequest&& request,
+                                      bool end_stream) {
+  stream_info_.getUpstreamBytesMeter()->addWireBytesSent(request.ByteSizeLong());
+  parent_->send(stream_id_, std::move(request), end_stream);
+}
+
+bool MultiplexedProcessorStream::close() {
+  if (closed_) {
+    return false;
+  }
+  ENVOY_LOG(debug, "Closing multiplexed stream {}", stream_id_);
+  closed_ = true;
+  parent_->detach(stream_id_);
+  return true;
+}
+
+StreamInfo::StreamInfo& MultiplexedProcessorStream::streamInfo() {
+  parent_->copyUpstreamInfo(stream_info_);
+  return stream_info_;
+}
+
+void MultiplexedProcessorStream::onReceiveMessage(std::unique_ptr<ProcessingResponse>&& response) {
+  stream_info_.getUpstreamBytesMeter()->addWireBytesReceived(response->ByteSizeLong());
+  if (!callbacks_.has_value()) {
+    ENVOY_LOG(debug, "Underlying filter object has been destroyed.");
+    return;
+  }
+  callbacks_->onReceiveMessage(std::move(response));
+}
+
+void MultiplexedProcessorStream::onRemoteClose(Grpc::Status::GrpcStatus status,
+                                               const std::string& message) {
+  ENVOY_LOG(debug, "Multiplexed stream {} closed remotely with status {}: {}", stream_id_, status,
+            message);
+  closed_ = true;
+
+  if (!callbacks_.has_value()) {
+    ENVOY_LOG(debug, "Underlying filter object has been destroyed.");
+    return;
+  }
+
+  callbacks_->logStreamInfo();
+  if (status == Grpc::Status::Ok) {
+    callbacks_->onGrpcClose();
+  } else {
+    callbacks_->onGrpcError(status, message);
+  }
+}
+
+SharedProcessorStream::SharedProcessorStream(Grpc::RawAsyncClientSharedPtr client,
+                                             Event::Dispatcher& dispatcher,
+                                             uint32_t max_batch_size)
+    : client_(std::move(client)), dispatcher_(dispatcher),
+      flush_callback_(dispatcher.createSchedulableCallback([this]() { flush(); })),
+      max_batch_size_(max_batch_size) {}
+
+SharedProcessorStream::~SharedProcessorStream() {
+  if (stream_ != nullptr) {
+    stream_.resetStream();
+  }
+}
+
+bool SharedProcessorStream::startStream() {
+  ENVOY_LOG(debug, "Opening shared gRPC stream to external processor");
+  auto descriptor =
+      Protobuf::DescriptorPool::generated_pool()->FindMethodByName(kMultiplexedMethod);
+  stream_ = client_.start(*descriptor, *this, Http::AsyncClient::StreamOptions());
+  return stream_ != nullptr;
+}
+
+ExternalProcessorStreamPtr SharedProcessorStream::attach(ExternalProcessorCallbacks& callbacks) {
+  if (stream_ == nullptr && !startStream()) {
+    callbacks.onGrpcError(Grpc::Status::Unavailable, "failed to start the shared gRPC stream");
+    return nullptr;
+  }
+  const uint64_t stream_id = next_stream_id_++;
+  auto stream = std::make_unique<MultiplexedProcessorStream>(shared_from_this(), stream_id,
+                                                             callbacks, dispatcher_.timeSource());
+  streams_[stream_id] = stream.get();
+  return stream;
+}
+
+void SharedProcessorStream::send(uint64_t stream_id,
+                                 envoy::service::ext_proc::v3::ProcessingRequest&& request,
+                                 bool end_stream) {
+  if (stream_ == nullptr) {
+    // The shared stream closed and the HTTP stream has not yet seen the close.
+    return;
+  }
+  // Body chunks can be large and are often streamed, so they are not held back. Sending the
+  // batch with them keeps the messages of each HTTP stream in order.
+  const bool send_now = request.has_request_body() || request.has_response_body();
+  auto* entry = pending_.add_requests();
+  entry->set_stream_id(stream_id);
+  *entry->mutable_request() = std::move(request);
+  entry->set_end_of_stream(end_stream);
+
+  if (send_now || static_cast<uint32_t>(pending_.requests_size()) >= max_batch_size_) {
+    flush();
+  } else if (!flush_callback_->enabled()) {
+    flush_callback_->scheduleCallbackCurrentIteration();
+  }
+}
+
+void SharedProcessorStream::detach(uint64_t stream_id) {
+  if (streams_.erase(stream_id) == 0 || stream_ == nullptr) {
+    return;
+  }
+  // Let the processor drop the state of this HTTP stream.
+  auto* entry = pending_.add_requests();
+  entry->set_stream_id(stream_id);
+  entry->set_end_of_stream(true);
+  if (static_cast<uint32_t>(pending_.requests_size()) >= max_batch_size_) {
+    flush();
+  } else if (!flush_callback_->enabled()) {
+    flush_callback_->scheduleCallbackCurrentIteration();
+  }
+}
+
+void SharedProcessorStream::flush() {
+  flush_callback_->cancel();
+  if (pending_.requests().empty()) {
+    return;
+  }
+  if (stream_ != nullptr) {
+    stream_.sendMessage(pending_, false);
+  }
+  pending_.Clear();
+}
+
+void SharedProcessorStream::copyUpstreamInfo(StreamInfo::StreamInfo& info) {
+  if (stream_ == nullptr) {
+    return;
+  }
+  const StreamInfo::StreamInfo& grpc_info = stream_.streamInfo();
+  if (grpc_info.upstreamInfo().has_value() && info.upstreamInfo()->upstreamHost() == nullptr) {
+    info.upstreamInfo()->setUpstreamHost(grpc_info.upstreamInfo()->upstreamHost());
+  }
+  if (!info.upstreamClusterInfo().has_value() && grpc_info.upstreamClusterInfo().has_value()) {
+    info.setUpstreamClusterInfo(grpc_info.upstreamClusterInfo().value());
+  }
+}
+
+void SharedProcessorStream::onReceiveMessage(std::unique_ptr<ProcessingResponseBatch>&& batch) {
+  // The callbacks may destroy the last HTTP stream holding on to this object.
+  const auto self = shared_from_this();
+  for (auto& entry : *batch->mutable_responses()) {
+    const uint64_t stream_id = entry.stream_id();
+    auto it = streams_.find(stream_id);
+    if (it == streams_.end()) {
+      ENVOY_LOG(debug, "Dropping response for unknown multiplexed stream {}", stream_id);
+      continue;
+    }
+    if (entry.has_response()) {
+      it->second->onReceiveMessage(
+          std::make_unique<ProcessingResponse>(std::move(*entry.mutable_response())));
+    }
+    if (entry.end_of_stream()) {
+      // Look it up again, the response may have closed the HTTP stream.
+      it = streams_.find(stream_id);
+      if (it != streams_.end()) {
+        MultiplexedProcessorStream* stream = it->second;
+        streams_.erase(it);
+        stream->onRemoteClose(Grpc::Status::Ok, "");
+      }
+    }
+  }
+}
+
+void SharedProcessorStream::onRemoteClose(Grpc::Status::GrpcStatus status,
+                                          const std::string& message) {
+  ENVOY_LOG(debug, "Shared gRPC stream closed remotely with status {}: {}", status, message);
+  const auto self = shared_from_this();
+  stream_ = nullptr;
+  flush_callback_->cancel();
+  pending_.Clear();
+
+  // Every HTTP stream on the shared stream sees the close. New HTTP streams start a new one.
+  auto streams = std::move(streams_);
+  streams_.clear();
+  for (auto& [stream_id, stream] : streams) {
+    stream->onRemoteClose(status, message);
+  }
+}
+
+SharedProcessorStreams::SharedProcessorStreams(
+    const envoy::extensions::filters::http::ext_proc::v3::MultiplexingOptions& config,
+    Grpc::AsyncClientManager& client_manager, Stats::Scope& scope, ThreadLocal::SlotAllocator& tls)
+    : client_manager_(client_manager), scope_(scope),
+      max_batch_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_batch_size, DefaultMaxBatchSize)),
+      tls_(tls) {
+  tls_.set([](Event::Dispatcher& dispatcher) {
+    return std::make_shared<ThreadLocalSharedStreams>(dispatcher);
+  });
+}
+
+SharedProcessorStream&
+SharedProcessorStreams::get(const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key) {
+  ThreadLocalSharedStreams& local = *tls_;
+  auto it = local.streams.find(config_with_hash_key);
+  if (it != local.streams.end()) {
+    return *it->second;
+  }
+  auto client_or_error =
+      client_manager_.getOrCreateRawAsyncClientWithHashKey(config_with_hash_key, scope_, true);
+  THROW_IF_NOT_OK_REF(client_or_error.status());
+  auto stream = std::make_shared<SharedProcessorStream>(client_or_error.value(), local.dispatcher,
+                                                        max_batch_size_);
+  SharedProcessorStream& ref = *stream;
+  local.streams.emplace(config_with_hash_key, std::move(stream));
+  return ref;
+}
+
+ExternalProcessorStreamPtr MultiplexedProcessorClient::start(
+    ExternalProcessorCallbacks& callbacks,
+    const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key,
+    Http::AsyncClient::StreamOptions&, Http::StreamFilterSidestreamWatermarkCallbacks&) {
+  return shared_streams_->get(config_with_hash_key).attach(callbacks);
+}
+
+void MultiplexedProcessorClient::sendRequest(
+    envoy::service::ext_proc::v3::ProcessingRequest&& request, bool end_stream, const uint64_t,
+    RequestCallbacks*, StreamBase* stream) {
+  ExternalProcessorStream* grpc_stream = dynamic_cast<ExternalProcessorStream*>(stream);
+  grpc_stream->send(std::move(request), end_stream);
+}
+
+} // namespace ExternalProcessing
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "envoy/event/dispatcher.h"
+#include "envoy/extensions/filters/http/ext_proc/v3/ext_proc.pb.h"
+#include "envoy/grpc/async_client_manager.h"
+#include "envoy/service/ext_proc/v3/external_processor.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/thread_local/thread_local.h"
+#include "envoy/thread_local/thread_local_object.h"
+
+#include "source/common/common/logger.h"
+#include "source/common/grpc/typed_async_client.h"
+#include "source/common/stream_info/stream_info_impl.h"
+#include "source/extensions/filters/http/ext_proc/client.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExternalProcessing {
+
+using envoy::service::ext_proc::v3::ProcessingRequestBatch;
+using envoy::service::ext_proc::v3::ProcessingResponse;
+using envoy::service::ext_proc::v3::ProcessingResponseBatch;
+
+// Default value of MultiplexingOptions.max_batch_size.
+inline constexpr uint32_t DefaultMaxBatchSize = 32;
+
+class SharedProcessorStream;
+using SharedProcessorStreamSharedPtr = std::shared_ptr<SharedProcessorStream>;
+
+// The conversation of one HTTP stream with the external processor, carried on a
+// SharedProcessorStream. It keeps the shared stream alive until it is destroyed.
+class MultiplexedProcessorStream : public ExternalProcessorStream,
+                                   public Logger::Loggable<Logger::Id::ext_proc> {
+public:
+  MultiplexedProcessorStream(SharedProcessorStreamSharedPtr parent, uint64_t stream_id,
+                             ExternalProcessorCallbacks& callbacks, TimeSource& time_source);
+  ~MultiplexedProcessorStream() override;
+
+  // ExternalProcessorStream
+  void send(envoy::service::ext_proc::v3::ProcessingRequest&& request, bool end_stream) override;
+  bool close() override;
+  const StreamInfo::StreamInfo& streamInfo() const override { return stream_info_; }
+  StreamInfo::StreamInfo& streamInfo() override;
+  void notifyFilterDestroy() override { callbacks_.reset(); }
+
+  // Called by the shared stream.
+  void onReceiveMessage(std::unique_ptr<ProcessingResponse>&& response);
+  void onRemoteClose(Grpc::Status::GrpcStatus status, const std::string& message);
+
+private:
+  const SharedProcessorStreamSharedPtr parent_;
+  const uint64_t stream_id_;
+  // Optional reference to filter object.
+  OptRef<ExternalProcessorCallbacks> callbacks_;
+  // Only tracks the bytes of this stream's messages and the upstream of the shared stream.
+  StreamInfo::StreamInfoImpl stream_info_;
+  bool closed_ = false;
+};
+
+// A long-lived ProcessMultiplexed gRPC stream shared by the HTTP streams of one worker.
+// Headers and trailers messages are batched until the end of the current event loop iteration;
+// body messages flush the batch immediately. The gRPC stream is started on first use and
+// restarted on the next use after it has been closed.
+class SharedProcessorStream : public Grpc::AsyncStreamCallbacks<ProcessingResponseBatch>,
+                              public std::enable_shared_from_this<SharedProcessorStream>,
+                              public Logger::Loggable<Logger::Id::ext_proc> {
+public:
+  SharedProcessorStream(Grpc::RawAsyncClientSharedPtr client, Event::Dispatcher& dispatcher,
+                        uint32_t max_batch_size);
+  ~SharedProcessorStream() override;
+
+  // Starts the conversation of a new HTTP stream. Returns nullptr, after reporting the error to
+  // `callbacks`, if the gRPC stream could not be started.
+  ExternalProcessorStreamPtr attach(ExternalProcessorCallbacks& callbacks);
+
+  // Called by MultiplexedProcessorStream.
+  void send(uint64_t stream_id, envoy::service::ext_proc::v3::ProcessingRequest&& request,
+            bool end_stream);
+  void detach(uint64_t stream_id);
+  // Copies the upstream host and cluster of the gRPC stream, if it is open, into `info`.
+  void copyUpstreamInfo(StreamInfo::StreamInfo& info);
+
+  // AsyncStreamCallbacks
+  void onReceiveMessage(std::unique_ptr<ProcessingResponseBatch>&& batch) override;
+
+  // RawAsyncStreamCallbacks
+  void onCreateInitialMetadata(Http::RequestHeaderMap&) override {}
+  void onReceiveInitialMetadata(Http::ResponseHeaderMapPtr&&) override {}
+  void onReceiveTrailingMetadata(Http::ResponseTrailerMapPtr&&) override {}
+  void onRemoteClose(Grpc::Status::GrpcStatus status, const std::string& message) override;
+
+private:
+  bool startStream();
+  void flush();
+
+  Grpc::AsyncClient<ProcessingRequestBatch, ProcessingResponseBatch> client_;
+  Grpc::AsyncStream<ProcessingRequestBatch> stream_;
+  Event::Dispatcher& dispatcher_;
+  const Event::SchedulableCallbackPtr flush_callback_;
+  const uint32_t max_batch_size_;
+  ProcessingRequestBatch pending_;
+  uint64_t next_stream_id_ = 1;
+  absl::flat_hash_map<uint64_t, MultiplexedProcessorStream*> streams_;
+};
+
+// The shared streams of one worker, keyed by gRPC service.
+struct ThreadLocalSharedStreams : public ThreadLocal::ThreadLocalObject {
+  explicit ThreadLocalSharedStreams(Event::Dispatcher& dispatcher) : dispatcher(dispatcher) {}
+
+  Event::Dispatcher& dispatcher;
+  absl::flat_hash_map<Grpc::GrpcServiceConfigWithHashKey, SharedProcessorStreamSharedPtr> streams;
+};
+
+// Per filter config state of the multiplexed clients: the thread local shared streams and what
+// is needed to create them.
+class SharedProcessorStreams {
+public:
+  SharedProcessorStreams(
+      const envoy::extensions::filters::http::ext_proc::v3::MultiplexingOptions& config,
+      Grpc::AsyncClientManager& client_manager, Stats::Scope& scope,
+      ThreadLocal::SlotAllocator& tls);
+
+  // Returns the shared stream of the current worker for the given gRPC service.
+  SharedProcessorStream& get(const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key);
+
+private:
+  Grpc::AsyncClientManager& client_manager_;
+  Stats::Scope& scope_;
+  const uint32_t max_batch_size_;
+  ThreadLocal::TypedSlot<ThreadLocalSharedStreams> tls_;
+};
+
+using SharedProcessorStreamsSharedPtr = std::shared_ptr<SharedProcessorStreams>;
+
+// Client used when the filter is configured with `multiplexing`. The streams it starts are
+// multiplexed on the shared stream of the current worker.
+class MultiplexedProcessorClient : public ExternalProcessorClient {
+public:
+  explicit MultiplexedProcessorClient(SharedProcessorStreamsSharedPtr shared_streams)
+      : shared_streams_(std::move(shared_streams)) {}
+
+  ExternalProcessorStreamPtr
+  start(ExternalProcessorCallbacks& callbacks,
+        const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key,
+        Http::AsyncClient::StreamOptions& options,
+        Http::StreamFilterSidestreamWatermarkCallbacks& sidestream_watermark_callbacks) override;
+  void sendRequest(envoy::service::ext_proc::v3::ProcessingRequest&& request, bool end_stream,
+                   const uint64_t stream_id, RequestCallbacks* callbacks,
+                   StreamBase* stream) override;
+  void cancel() override {}
+  const Envoy::StreamInfo::StreamInfo* getStreamInfo() const override { return nullptr; }
+
+private:
+  const SharedProcessorStreamsSharedPtr shared_streams_;
+};
+
+} // namespace ExternalProcessing
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
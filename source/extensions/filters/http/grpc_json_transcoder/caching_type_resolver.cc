@@ -0,0 +1,38 @@
+#include "source/extensions/filters/http/grpc_json_transcoder/caching_type_resolver.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcJsonTranscoder {
+
+// The types aren't resolved under the lock of the cache, a type being at worst resolved
+// concurrently by several workers the first time.
+
+absl::Status CachingTypeResolver::ResolveMessageType(const std::string& type_url,
+                                                     ProtobufWkt::Type* message_type) {
+  if (message_types_.find(type_url, message_type)) {
+    return absl::OkStatus();
+  }
+  absl::Status status = resolver_->ResolveMessageType(type_url, message_type);
+  if (status.ok()) {
+    message_types_.insert(type_url, *message_type);
+  }
+  return status;
+}
+
+absl::Status CachingTypeResolver::ResolveEnumType(const std::string& type_url,
+                                                  ProtobufWkt::Enum* enum_type) {
+  if (enum_types_.find(type_url, enum_type)) {
+    return absl::OkStatus();
+  }
+  absl::Status status = resolver_->ResolveEnumType(type_url, enum_type);
+  if (status.ok()) {
+    enum_types_.insert(type_url, *enum_type);
+  }
+  return status;
+}
+
+} // namespace GrpcJsonTranscoder
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "source/common/protobuf/protobuf.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcJsonTranscoder {
+
+/**
+ * Type resolver caching the types resolved by another one. The protobuf JSON conversions resolve
+ * the types of each message they convert, which the descriptor pool resolver builds anew from the
+ * descriptors every time, so that without the cache each message of a stream pays for building
+ * the types of all its fields. Thread safe, as the resolver is shared by the workers.
+ */
+class CachingTypeResolver : public Protobuf::util::TypeResolver {
+public:
+  explicit CachingTypeResolver(std::unique_ptr<Protobuf::util::TypeResolver> resolver)
+      : resolver_(std::move(resolver)) {}
+
+  // Protobuf::util::TypeResolver
+  absl::Status ResolveMessageType(const std::string& type_url,
+                                  ProtobufWkt::Type* message_type) override;
+  absl::Status ResolveEnumType(const std::string& type_url, ProtobufWkt::Enum* enum_type) override;
+
+private:
+  template <class T> class TypeCache {
+  public:
+    bool find(const std::string& type_url, T* type) const {
+      absl::ReaderMutexLock lock(&mutex_);
+      auto it = types_.find(type_url);
+      if (it == types_.end()) {
+        return false;
+      }
+      *type = *it->second;
+      return true;
+    }
+
+    void insert(const std::string& type_url, const T& type) {
+      absl::MutexLock lock(&mutex_);
+      types_.try_emplace(type_url, std::make_unique<const T>(type));
+    }
+
+  private:
+    mutable absl::Mutex mutex_;
+    absl::flat_hash_map<std::string, std::unique_ptr<const T>> types_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  const std::unique_ptr<Protobuf::util::TypeResolver> resolver_;
+  TypeCache<ProtobufWkt::Type> message_types_;
+  TypeCache<ProtobufWkt::Enum> enum_types_;
+};
+
+} // namespace GrpcJsonTranscoder
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -16,6 +16,7 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
+#include "source/extensions/filters/http/grpc_json_transcoder/caching_type_resolver.h"
 #include "source/extensions/filters/http/grpc_json_transcoder/http_body_utils.h"
 
 #include "absl/strings/str_join.h"
@@ -152,9 +153,12 @@ JsonTranscoderConfig::JsonTranscoderConfig(
     addBuiltinSymbolDescriptor("google.rpc.Status");
   }
 
-  type_helper_ = std::make_unique<google::grpc::transcoding::TypeHelper>(
+  // The resolver is shared by the requests and the messages they transcode, hence caches the types.
+  std::unique_ptr<Protobuf::util::TypeResolver> resolver(
       Protobuf::util::NewTypeResolverForDescriptorPool(Grpc::Common::typeUrlPrefix(),
                                                        &descriptor_pool_));
+  type_helper_ = std::make_unique<google::grpc::transcoding::TypeHelper>(
+      new CachingTypeResolver(std::move(resolver)));
 
   PathMatcherBuilder<MethodInfoSharedPtr> pmb;
   // clang-format off
@@ -298,6 +302,7 @@ Status JsonTranscoderConfig::createMethodInfo(const Protobuf::MethodDescriptor*
                                               MethodInfoSharedPtr& method_info) {
   method_info = std::make_shared<MethodInfo>();
   method_info->descriptor_ = descriptor;
+  method_info->response_type_url_ = Grpc::Common::typeUrl(descriptor->output_type()->full_name());
 
   Status status =
       resolveField(descriptor->input_type(), http_rule.body(),
@@ -401,11 +406,9 @@ absl::Status JsonTranscoderConfig::createTranscoder(
         method_info->descriptor_->client_streaming(), true);
   }
 
-  const auto response_type_url =
-      Grpc::Common::typeUrl(method_info->descriptor_->output_type()->full_name());
   ResponseToJsonTranslatorPtr response_translator{new ResponseToJsonTranslator(
-      type_helper_->Resolver(), response_type_url, method_info->descriptor_->server_streaming(),
-      &response_input, response_translate_options_)};
+      type_helper_->Resolver(), method_info->response_type_url_,
+      method_info->descriptor_->server_streaming(), &response_input, response_translate_options_)};
 
   transcoder = std::make_unique<TranscoderImpl>(std::move(request_translator),
                                                 std::move(json_request_translator),
@@ -27,6 +27,7 @@ namespace GrpcJsonTranscoder {
 
 struct MethodInfo {
   const Protobuf::MethodDescriptor* descriptor_ = nullptr;
+  std::string response_type_url_;
   std::vector<const ProtobufWkt::Field*> request_body_field_path;
   std::vector<const ProtobufWkt::Field*> response_body_field_path;
   bool request_type_is_http_body_ = false;
@@ -0,0 +1,145 @@
+#include "source/extensions/filters/http/ip_tagging/ip_tag_trie.h"
+
+#include <utility>
+#include <vector>
+
+#include "envoy/config/core/v3/address.pb.h"
+
+#include "source/common/common/thread.h"
+#include "source/common/config/datasource.h"
+#include "source/common/network/cidr_range.h"
+#include "source/common/protobuf/message_validator_impl.h"
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace IpTagging {
+
+namespace {
+
+absl::StatusOr<IpTagTrieConstSharedPtr> buildTrie(const IpTagList& ip_tags) {
+  std::vector<std::pair<std::string, std::vector<Network::Address::CidrRange>>> tag_data;
+  tag_data.reserve(ip_tags.size());
+  for (const auto& ip_tag : ip_tags) {
+    std::vector<Network::Address::CidrRange> cidr_set;
+    cidr_set.reserve(ip_tag.ip_list().size());
+    for (const envoy::config::core::v3::CidrRange& entry : ip_tag.ip_list()) {
+      absl::StatusOr<Network::Address::CidrRange> cidr_or_error =
+          Network::Address::CidrRange::create(entry);
+      if (!cidr_or_error.status().ok()) {
+        return absl::InvalidArgumentError(
+            fmt::format("invalid ip/mask combo '{}/{}' (format is <ip>/<# mask bits>)",
+                        entry.address_prefix(), entry.prefix_len().value()));
+      }
+      cidr_set.emplace_back(std::move(cidr_or_error.value()));
+    }
+    tag_data.emplace_back(ip_tag.ip_tag_name(), std::move(cidr_set));
+  }
+
+  IpTagTrieConstSharedPtr trie;
+  // The trie throws if it would have too many nodes.
+  TRY_ASSERT_MAIN_THREAD { trie = std::make_shared<const IpTagTrie>(tag_data); }
+  END_TRY
+  catch (const EnvoyException& e) {
+    return absl::InvalidArgumentError(e.what());
+  }
+  return trie;
+}
+
+bool sameIpTags(const IpTagList& lhs, const IpTagList& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (int i = 0; i < lhs.size(); ++i) {
+    if (!Protobuf::util::MessageDifferencer::Equals(lhs[i], rhs[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+absl::StatusOr<IpTagTrieConstSharedPtr> IpTagTrieRegistry::getOrCreate(const IpTagList& ip_tags) {
+  const uint64_t key = MessageUtil::hash(ip_tags);
+  if (const auto it = tries_.find(key); it != tries_.end()) {
+    IpTagTrieConstSharedPtr trie = it->second.trie_.lock();
+    if (trie != nullptr && sameIpTags(it->second.ip_tags_, ip_tags)) {
+      return trie;
+    }
+  }
+
+  absl::StatusOr<IpTagTrieConstSharedPtr> trie_or = buildTrie(ip_tags);
+  RETURN_IF_NOT_OK_REF(trie_or.status());
+  // Forget the tries that no filter uses anymore.
+  for (auto it = tries_.begin(); it != tries_.end();) {
+    if (it->second.trie_.expired()) {
+      tries_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  // On a hash collision, the trie of the other IP tags is no longer shared.
+  tries_[key] = Entry{ip_tags, trie_or.value()};
+  return trie_or;
+}
+
+absl::Status parseIpTags(const std::string& data, IpTags& tags) {
+  TRY_ASSERT_MAIN_THREAD {
+    MessageUtil::loadFromYaml(data, tags, ProtobufMessage::getStrictValidationVisitor());
+  }
+  END_TRY
+  catch (const EnvoyException& e) {
+    return absl::InvalidArgumentError(fmt::format("invalid IP tags file: {}", e.what()));
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<IpTagsReloaderPtr>
+IpTagsReloader::create(IpTagTrieConstSharedPtr initial_trie, const std::string& filename,
+                       const std::string& watched_directory, IpTagTrieRegistrySharedPtr registry,
+                       Event::Dispatcher& main_dispatcher, ThreadLocal::SlotAllocator& tls,
+                       Api::Api& api) {
+  IpTagsReloaderPtr reloader(new IpTagsReloader(filename, std::move(registry), api));
+  reloader->tls_ = ThreadLocal::TypedSlot<ThreadLocalTrie>::makeUnique(tls);
+  reloader->tls_->set([initial_trie = std::move(initial_trie)](Event::Dispatcher&) {
+    return std::make_shared<ThreadLocalTrie>(initial_trie);
+  });
+
+  reloader->watcher_ = main_dispatcher.createFilesystemWatcher();
+  RETURN_IF_NOT_OK(reloader->watcher_->addWatch(
+      absl::StrCat(watched_directory, "/"), Filesystem::Watcher::Events::MovedTo,
+      [reloader = reloader.get()](uint32_t) -> absl::Status {
+        const absl::Status status = reloader->reload();
+        if (!status.ok()) {
+          // Keep the previous tags rather than failing the watch.
+          ENVOY_LOG(error, "failed to reload IP tags from {}: {}", reloader->filename_,
+                    status.message());
+        }
+        return absl::OkStatus();
+      }));
+  return reloader;
+}
+
+absl::Status IpTagsReloader::reload() {
+  absl::StatusOr<std::string> data_or = Config::DataSource::readFile(filename_, api_, false);
+  RETURN_IF_NOT_OK_REF(data_or.status());
+  IpTags tags;
+  RETURN_IF_NOT_OK(parseIpTags(data_or.value(), tags));
+  absl::StatusOr<IpTagTrieConstSharedPtr> trie_or = registry_->getOrCreate(tags.ip_tags());
+  RETURN_IF_NOT_OK_REF(trie_or.status());
+
+  ENVOY_LOG(info, "reloaded {} IP tags from {}", tags.ip_tags().size(), filename_);
+  tls_->runOnAllThreads([trie = std::move(trie_or.value())](OptRef<ThreadLocalTrie> tls_trie) {
+    if (tls_trie.has_value()) {
+      tls_trie->trie_ = trie;
+    }
+  });
+  return absl::OkStatus();
+}
+
+} // namespace IpTagging
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "envoy/api/api.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/extensions/filters/http/ip_tagging/v3/ip_tagging.pb.h"
+#include "envoy/filesystem/watcher.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/logger.h"
+#include "source/common/network/lc_trie.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace IpTagging {
+
+using IpTag = envoy::extensions::filters::http::ip_tagging::v3::IPTagging::IPTag;
+using IpTagList = Protobuf::RepeatedPtrField<IpTag>;
+using IpTags = envoy::extensions::filters::http::ip_tagging::v3::IPTagging::IPTags;
+using IpTagTrie = Network::LcTrie::LcTrie<std::string>;
+using IpTagTrieConstSharedPtr = std::shared_ptr<const IpTagTrie>;
+
+/**
+ * The IP tag tries of all the IP tagging filters, by the IP tags they are built from. Filters
+ * with the same IP tags share one trie, and a filter that is updated without changing its IP
+ * tags does not build its trie again. Only used on the main thread.
+ */
+class IpTagTrieRegistry : public Singleton::Instance {
+public:
+  /**
+   * @return the trie for `ip_tags`, which is only built if no filter uses it already, or an error
+   *         if an IP tag is invalid.
+   */
+  absl::StatusOr<IpTagTrieConstSharedPtr> getOrCreate(const IpTagList& ip_tags);
+
+  size_t size() const { return tries_.size(); }
+
+private:
+  struct Entry {
+    // The IP tags the trie is built from, compared on lookup as their hashes may collide.
+    IpTagList ip_tags_;
+    std::weak_ptr<const IpTagTrie> trie_;
+  };
+
+  absl::flat_hash_map<uint64_t, Entry> tries_;
+};
+
+using IpTagTrieRegistrySharedPtr = std::shared_ptr<IpTagTrieRegistry>;
+
+/**
+ * Parses the YAML or JSON contents of an IP tags file.
+ */
+absl::Status parseIpTags(const std::string& data, IpTags& tags);
+
+/**
+ * Gives the workers the trie of an IP tags file, and replaces it with the trie of the new file
+ * whenever a file is moved into the watched directory. Must be destroyed on the main thread.
+ */
+class IpTagsReloader : Logger::Loggable<Logger::Id::filter> {
+public:
+  static absl::StatusOr<std::unique_ptr<IpTagsReloader>>
+  create(IpTagTrieConstSharedPtr initial_trie, const std::string& filename,
+         const std::string& watched_directory, IpTagTrieRegistrySharedPtr registry,
+         Event::Dispatcher& main_dispatcher, ThreadLocal::SlotAllocator& tls, Api::Api& api);
+
+  // The trie of the worker, or of the main thread.
+  const IpTagTrie& trie() const { return *(*tls_)->trie_; }
+
+  // Loads the file again, and gives the new trie to the workers if it loaded.
+  absl::Status reload();
+
+private:
+  struct ThreadLocalTrie : public ThreadLocal::ThreadLocalObject {
+    explicit ThreadLocalTrie(IpTagTrieConstSharedPtr trie) : trie_(std::move(trie)) {}
+    IpTagTrieConstSharedPtr trie_;
+  };
+
+  IpTagsReloader(const std::string& filename, IpTagTrieRegistrySharedPtr registry, Api::Api& api)
+      : filename_(filename), registry_(std::move(registry)), api_(api) {}
+
+  const std::string filename_;
+  const IpTagTrieRegistrySharedPtr registry_;
+  Api::Api& api_;
+  ThreadLocal::TypedSlotPtr<ThreadLocalTrie> tls_;
+  // Declared last, so that no reload starts while the other members are destroyed.
+  Filesystem::WatcherPtr watcher_;
+};
+
+using IpTagsReloaderPtr = std::unique_ptr<IpTagsReloader>;
+
+} // namespace IpTagging
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -1,8 +1,11 @@
 #include "source/extensions/filters/http/ip_tagging/ip_tagging_filter.h"
 
 #include "envoy/config/core/v3/address.pb.h"
+#include "envoy/config/core/v3/base.pb.h"
 #include "envoy/extensions/filters/http/ip_tagging/v3/ip_tagging.pb.h"
+#include "envoy/singleton/manager.h"
 
+#include "source/common/config/datasource.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
 
@@ -13,12 +16,15 @@ namespace Extensions {
 namespace HttpFilters {
 namespace IpTagging {
 
+SINGLETON_MANAGER_REGISTRATION(ip_tag_trie_registry);
+
 absl::StatusOr<IpTaggingFilterConfigSharedPtr> IpTaggingFilterConfig::create(
     const envoy::extensions::filters::http::ip_tagging::v3::IPTagging& config,
-    const std::string& stat_prefix, Stats::Scope& scope, Runtime::Loader& runtime) {
+    const std::string& stat_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
+    Server::Configuration::ServerFactoryContext& context) {
   absl::Status creation_status = absl::OkStatus();
   auto config_ptr = std::shared_ptr<IpTaggingFilterConfig>(
-      new IpTaggingFilterConfig(config, stat_prefix, scope, runtime, creation_status));
+      new IpTaggingFilterConfig(config, stat_prefix, scope, runtime, context, creation_status));
   RETURN_IF_NOT_OK(creation_status);
   return config_ptr;
 }
@@ -26,7 +32,7 @@ absl::StatusOr<IpTaggingFilterConfigSharedPtr> IpTaggingFilterConfig::create(
 IpTaggingFilterConfig::IpTaggingFilterConfig(
     const envoy::extensions::filters::http::ip_tagging::v3::IPTagging& config,
     const std::string& stat_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
-    absl::Status& creation_status)
+    Server::Configuration::ServerFactoryContext& context, absl::Status& creation_status)
     : request_type_(requestTypeEnum(config.request_type())), scope_(scope), runtime_(runtime),
       stat_name_set_(scope.symbolTable().makeSet("IpTagging")),
       stats_prefix_(stat_name_set_->add(stat_prefix + "ip_tagging")),
@@ -35,42 +41,61 @@ IpTaggingFilterConfig::IpTaggingFilterConfig(
       ip_tag_header_(config.has_ip_tag_header() ? config.ip_tag_header().header() : ""),
       ip_tag_header_action_(config.has_ip_tag_header()
                                 ? config.ip_tag_header().action()
-                                : HeaderAction::IPTagging_IpTagHeader_HeaderAction_SANITIZE) {
-
-  // Once loading IP tags from a file system is supported, the restriction on the size
-  // of the set should be removed and observability into what tags are loaded needs
-  // to be implemented.
-  // TODO(ccaraman): Remove size check once file system support is implemented.
-  // Work is tracked by issue https://github.com/envoyproxy/envoy/issues/2695.
-  if (config.ip_tags().empty()) {
+                                : HeaderAction::IPTagging_IpTagHeader_HeaderAction_SANITIZE),
+      main_dispatcher_(context.mainThreadDispatcher()) {
+  if (config.ip_tags().empty() && !config.has_ip_tags_datasource()) {
     creation_status =
         absl::InvalidArgumentError("HTTP IP Tagging Filter requires ip_tags to be specified.");
     return;
   }
+  if (!config.ip_tags().empty() && config.has_ip_tags_datasource()) {
+    creation_status = absl::InvalidArgumentError(
+        "HTTP IP Tagging Filter requires only one of ip_tags and ip_tags_datasource.");
+    return;
+  }
 
-  std::vector<std::pair<std::string, std::vector<Network::Address::CidrRange>>> tag_data;
-  tag_data.reserve(config.ip_tags().size());
-  for (const auto& ip_tag : config.ip_tags()) {
-    std::vector<Network::Address::CidrRange> cidr_set;
-    cidr_set.reserve(ip_tag.ip_list().size());
-    for (const envoy::config::core::v3::CidrRange& entry : ip_tag.ip_list()) {
-
-      absl::StatusOr<Network::Address::CidrRange> cidr_or_error =
-          Network::Address::CidrRange::create(entry);
-      if (cidr_or_error.status().ok()) {
-        cidr_set.emplace_back(std::move(cidr_or_error.value()));
-      } else {
-        creation_status = absl::InvalidArgumentError(
-            fmt::format("invalid ip/mask combo '{}/{}' (format is <ip>/<# mask bits>)",
-                        entry.address_prefix(), entry.prefix_len().value()));
-        return;
-      }
-    }
+  IpTags file_tags;
+  if (config.has_ip_tags_datasource()) {
+    absl::StatusOr<std::string> data_or =
+        Config::DataSource::read(config.ip_tags_datasource(), false, context.api());
+    SET_AND_RETURN_IF_NOT_OK(data_or.status(), creation_status);
+    SET_AND_RETURN_IF_NOT_OK(parseIpTags(data_or.value(), file_tags), creation_status);
+  }
+  const IpTagList& ip_tags =
+      config.has_ip_tags_datasource() ? file_tags.ip_tags() : config.ip_tags();
 
-    tag_data.emplace_back(ip_tag.ip_tag_name(), cidr_set);
+  // Tags are only counted by name if they are known when the filter is created. Tags that a
+  // reload adds are counted as unknown_tag.hit.
+  for (const auto& ip_tag : ip_tags) {
     stat_name_set_->rememberBuiltin(absl::StrCat(ip_tag.ip_tag_name(), ".hit"));
   }
-  trie_ = std::make_unique<Network::LcTrie::LcTrie<std::string>>(tag_data);
+
+  auto registry = context.singletonManager().getTyped<IpTagTrieRegistry>(
+      SINGLETON_MANAGER_REGISTERED_NAME(ip_tag_trie_registry),
+      [] { return std::make_shared<IpTagTrieRegistry>(); });
+  absl::StatusOr<IpTagTrieConstSharedPtr> trie_or = registry->getOrCreate(ip_tags);
+  SET_AND_RETURN_IF_NOT_OK(trie_or.status(), creation_status);
+  trie_ = std::move(trie_or.value());
+
+  const auto& source = config.ip_tags_datasource();
+  if (source.has_watched_directory() &&
+      source.specifier_case() == envoy::config::core::v3::DataSource::kFilename) {
+    absl::StatusOr<IpTagsReloaderPtr> reloader_or = IpTagsReloader::create(
+        trie_, source.filename(), source.watched_directory().path(), std::move(registry),
+        context.mainThreadDispatcher(), context.threadLocal(), context.api());
+    SET_AND_RETURN_IF_NOT_OK(reloader_or.status(), creation_status);
+    reloader_ = std::move(reloader_or.value());
+    // The workers use the trie of the reloader.
+    trie_ = nullptr;
+  }
+}
+
+IpTaggingFilterConfig::~IpTaggingFilterConfig() {
+  if (reloader_ != nullptr && !main_dispatcher_.isThreadSafe()) {
+    // The last filter may be destroyed on a worker, but the file watcher and the thread local
+    // slot of the reloader must be destroyed on the main thread.
+    main_dispatcher_.post([to_delete = std::move(reloader_)] {});
+  }
 }
 
 void IpTaggingFilterConfig::incCounter(Stats::StatName name) {
@@ -95,7 +120,7 @@ Http::FilterHeadersStatus IpTaggingFilter::decodeHeaders(Http::RequestHeaderMap&
     return Http::FilterHeadersStatus::Continue;
   }
 
-  std::vector<std::string> tags =
+  const std::vector<std::string>& tags =
       config_->trie().getData(callbacks_->streamInfo().downstreamAddressProvider().remoteAddress());
 
   applyTags(headers, tags);
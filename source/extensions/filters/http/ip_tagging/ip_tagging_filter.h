@@ -11,11 +11,11 @@
 #include "envoy/extensions/filters/http/ip_tagging/v3/ip_tagging.pb.h"
 #include "envoy/http/filter.h"
 #include "envoy/runtime/runtime.h"
+#include "envoy/server/factory_context.h"
 #include "envoy/stats/scope.h"
 
-#include "source/common/network/cidr_range.h"
-#include "source/common/network/lc_trie.h"
 #include "source/common/stats/symbol_table.h"
+#include "source/extensions/filters/http/ip_tagging/ip_tag_trie.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -36,11 +36,15 @@ public:
       envoy::extensions::filters::http::ip_tagging::v3::IPTagging::IpTagHeader::HeaderAction;
   static absl::StatusOr<std::shared_ptr<IpTaggingFilterConfig>>
   create(const envoy::extensions::filters::http::ip_tagging::v3::IPTagging& config,
-         const std::string& stat_prefix, Stats::Scope& scope, Runtime::Loader& runtime);
+         const std::string& stat_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
+         Server::Configuration::ServerFactoryContext& context);
+  ~IpTaggingFilterConfig();
 
   Runtime::Loader& runtime() { return runtime_; }
   FilterRequestType requestType() const { return request_type_; }
-  const Network::LcTrie::LcTrie<std::string>& trie() const { return *trie_; }
+  const IpTagTrie& trie() const { return reloader_ != nullptr ? reloader_->trie() : *trie_; }
+  // Only set when the IP tags are reloaded from a watched file.
+  IpTagsReloader* reloader() const { return reloader_.get(); }
 
   OptRef<const Http::LowerCaseString> ipTagHeader() const {
     if (ip_tag_header_.get().empty()) {
@@ -59,7 +63,9 @@ public:
 private:
   IpTaggingFilterConfig(const envoy::extensions::filters::http::ip_tagging::v3::IPTagging& config,
                         const std::string& stat_prefix, Stats::Scope& scope,
-                        Runtime::Loader& runtime, absl::Status& creation_status);
+                        Runtime::Loader& runtime,
+                        Server::Configuration::ServerFactoryContext& context,
+                        absl::Status& creation_status);
 
   static FilterRequestType requestTypeEnum(
       envoy::extensions::filters::http::ip_tagging::v3::IPTagging::RequestType request_type) {
@@ -85,7 +91,9 @@ private:
   const Stats::StatName no_hit_;
   const Stats::StatName total_;
   const Stats::StatName unknown_tag_;
-  std::unique_ptr<Network::LcTrie::LcTrie<std::string>> trie_;
+  Event::Dispatcher& main_dispatcher_;
+  IpTagTrieConstSharedPtr trie_;
+  IpTagsReloaderPtr reloader_;
   const Http::LowerCaseString
       ip_tag_header_; // An empty string indicates that no ip_tag_header is set.
   const HeaderAction ip_tag_header_action_;
@@ -52,6 +52,8 @@ struct Rule {
 };
 
 using Rules = std::vector<Rule>;
+// The keys looked up by each rule, from the root of the JSON body.
+using KeyPaths = std::vector<std::vector<std::string>>;
 
 /**
  * Configuration for the Json to Metadata filter.
@@ -69,6 +71,8 @@ public:
   bool doResponse() const { return !response_rules_.empty(); }
   const Rules& requestRules() const { return request_rules_; }
   const Rules& responseRules() const { return response_rules_; }
+  const KeyPaths& requestKeyPaths() const { return request_key_paths_; }
+  const KeyPaths& responseKeyPaths() const { return response_key_paths_; }
   bool requestContentTypeAllowed(absl::string_view) const;
   bool responseContentTypeAllowed(absl::string_view) const;
 
@@ -79,6 +83,8 @@ private:
   JsonToMetadataStats respstats_;
   const Rules request_rules_;
   const Rules response_rules_;
+  const KeyPaths request_key_paths_;
+  const KeyPaths response_key_paths_;
   const absl::flat_hash_set<std::string> request_allow_content_types_;
   const absl::flat_hash_set<std::string> response_allow_content_types_;
   const bool request_allow_empty_content_type_;
@@ -125,9 +131,9 @@ private:
                         Http::StreamFilterCallbacks& filter_callback,
                         bool& processing_finished_flag);
   // Parse the body while we have the whole json.
-  void processBody(const Buffer::Instance* body, const Rules& rules, bool should_clear_route_cache,
-                   JsonToMetadataStats& stats, Http::StreamFilterCallbacks& filter_callback,
-                   bool& processing_finished_flag);
+  void processBody(const Buffer::Instance* body, const Rules& rules, const KeyPaths& key_paths,
+                   bool should_clear_route_cache, JsonToMetadataStats& stats,
+                   Http::StreamFilterCallbacks& filter_callback, bool& processing_finished_flag);
   void processRequestBody();
   void processResponseBody();
 
@@ -1,9 +1,11 @@
 #include "source/extensions/filters/http/jwt_authn/jwt_cache.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "source/common/common/assert.h"
 
+#include "openssl/sha.h"
 #include "simple_lru_cache/simple_lru_cache_inl.h"
 
 using ::google::simple_lru_cache::SimpleLRUCache;
@@ -19,14 +21,30 @@ constexpr int kJwtCacheDefaultSize = 100;
 // The maximum size of JWT to be cached.
 constexpr int kMaxJwtSizeForCache = 4 * 1024; // 4KiB
 
+// The cache keeps the digests of the tokens rather than the tokens, which are often larger. A
+// collision would let a token use the verification result of another one, so the digest must be
+// collision resistant.
+std::string cacheKey(const std::string& token) {
+  std::string key(SHA256_DIGEST_LENGTH, '\0');
+  SHA256(reinterpret_cast<const uint8_t*>(token.data()), token.size(),
+         reinterpret_cast<uint8_t*>(key.data()));
+  return key;
+}
+
 class JwtCacheImpl : public JwtCache {
 public:
   JwtCacheImpl(bool enable_cache, const JwtCacheConfig& config, TimeSource& time_source)
       : time_source_(time_source) {
     if (enable_cache) {
       // if cache_size is 0, it is not specified in the config, use default
-      auto cache_size =
+      int64_t cache_size =
           config.jwt_cache_size() == 0 ? kJwtCacheDefaultSize : config.jwt_cache_size();
+      if (config.jwt_cache_max_bytes() > 0) {
+        // Each token takes as many units of the cache as it has bytes.
+        cache_size = static_cast<int64_t>(
+            std::min<uint64_t>(config.jwt_cache_max_bytes(), std::numeric_limits<int64_t>::max()));
+        size_tokens_by_bytes_ = true;
+      }
       jwt_lru_cache_ =
           std::make_unique<SimpleLRUCache<std::string, ::google::jwt_verify::Jwt>>(cache_size);
       max_jwt_size_for_cache_ =
@@ -44,8 +62,9 @@ public:
     if (!jwt_lru_cache_) {
       return nullptr;
     }
+    const std::string key = cacheKey(token);
     SimpleLRUCache<std::string, ::google::jwt_verify::Jwt>::ScopedLookup lookup(
-        jwt_lru_cache_.get(), token);
+        jwt_lru_cache_.get(), key);
     if (lookup.found()) {
       ::google::jwt_verify::Jwt* const found_jwt = lookup.value();
       ASSERT(found_jwt != nullptr);
@@ -53,7 +72,7 @@ public:
           ::google::jwt_verify::Status::JwtExpired) {
         return found_jwt;
       } else {
-        jwt_lru_cache_->remove(token);
+        jwt_lru_cache_->remove(key);
       }
     }
     return nullptr;
@@ -65,7 +84,8 @@ public:
     }
     if (static_cast<uint32_t>(token.size()) <= max_jwt_size_for_cache_) {
       // pass the ownership of jwt to cache
-      jwt_lru_cache_->insert(token, jwt.release(), 1);
+      jwt_lru_cache_->insert(cacheKey(token), jwt.release(),
+                             size_tokens_by_bytes_ ? static_cast<int64_t>(token.size()) : 1);
     }
   }
 
@@ -73,6 +93,7 @@ private:
   std::unique_ptr<SimpleLRUCache<std::string, ::google::jwt_verify::Jwt>> jwt_lru_cache_;
   TimeSource& time_source_;
   uint32_t max_jwt_size_for_cache_;
+  bool size_tokens_by_bytes_{};
 };
 } // namespace
 
@@ -17,7 +17,7 @@ namespace Extensions {
 namespace HttpFilters {
 namespace JwtAuthn {
 
-// Cache key is the JWT string, value is parsed JWT struct.
+// Cache key is the SHA-256 digest of the JWT string, value is parsed JWT struct.
 
 class JwtCache;
 using JwtCachePtr = std::unique_ptr<JwtCache>;
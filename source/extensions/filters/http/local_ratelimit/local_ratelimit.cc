@@ -32,6 +32,7 @@ FilterConfig::FilterConfig(
       tokens_per_fill_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.token_bucket(), tokens_per_fill, 1)),
       max_dynamic_descriptors_(
           config.has_max_dynamic_descriptors() ? config.max_dynamic_descriptors().value() : 20),
+      worker_token_lease_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, worker_token_lease, 0)),
       descriptors_(config.descriptors()),
       rate_limit_per_connection_(config.local_rate_limit_per_downstream_connection()),
       always_consume_default_token_bucket_(
@@ -112,7 +113,8 @@ FilterConfig::FilterConfig(
 
   rate_limiter_ = std::make_unique<Filters::Common::LocalRateLimit::LocalRateLimiterImpl>(
       fill_interval_, max_tokens_, tokens_per_fill_, dispatcher_, descriptors_,
-      always_consume_default_token_bucket_, std::move(share_provider), max_dynamic_descriptors_);
+      always_consume_default_token_bucket_, std::move(share_provider), max_dynamic_descriptors_,
+      worker_token_lease_);
 }
 
 Filters::Common::LocalRateLimit::LocalRateLimiterImpl::Result
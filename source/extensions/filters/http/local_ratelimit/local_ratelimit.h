@@ -147,6 +147,7 @@ private:
   const uint32_t max_tokens_;
   const uint32_t tokens_per_fill_;
   const uint32_t max_dynamic_descriptors_;
+  const uint32_t worker_token_lease_;
   const Protobuf::RepeatedPtrField<
       envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>
       descriptors_;
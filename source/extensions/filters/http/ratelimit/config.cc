@@ -23,15 +23,25 @@ Http::FilterFactoryCb RateLimitFilterConfig::createFilterFactoryFromProtoTyped(
   auto& server_context = context.serverFactoryContext();
 
   ASSERT(!proto_config.domain().empty());
-  FilterConfigSharedPtr filter_config(new FilterConfig(proto_config, server_context.localInfo(),
-                                                       context.scope(), server_context.runtime(),
-                                                       server_context.httpContext()));
   const std::chrono::milliseconds timeout =
       std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(proto_config, timeout, 20));
 
   THROW_IF_NOT_OK(Config::Utility::checkTransportVersion(proto_config.rate_limit_service()));
   Grpc::GrpcServiceConfigWithHashKey config_with_hash_key =
       Grpc::GrpcServiceConfigWithHashKey(proto_config.rate_limit_service().grpc_service());
+
+  QuotaLeasesPtr quota_leases;
+  if (proto_config.has_quota_lease()) {
+    quota_leases = std::make_unique<QuotaLeases>(
+        proto_config.quota_lease(), server_context.threadLocal(),
+        [config_with_hash_key, &context, timeout]() {
+          return Filters::Common::RateLimit::rateLimitClient(context, config_with_hash_key,
+                                                             timeout);
+        });
+  }
+  FilterConfigSharedPtr filter_config(new FilterConfig(
+      proto_config, server_context.localInfo(), context.scope(), server_context.runtime(),
+      server_context.httpContext(), std::move(quota_leases)));
   return [config_with_hash_key, &context, timeout,
           filter_config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
     callbacks.addStreamFilter(std::make_shared<Filter>(
@@ -0,0 +1,207 @@
+#include "source/extensions/filters/http/ratelimit/quota_lease.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/common/tracing/null_span_impl.h"
+
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace RateLimitFilter {
+
+using Filters::Common::RateLimit::LimitStatus;
+
+QuotaLeaseConfig::QuotaLeaseConfig(
+    const envoy::extensions::filters::http::ratelimit::v3::RateLimit::QuotaLease& config)
+    : lease_size_(config.lease_size()),
+      lease_duration_(PROTOBUF_GET_MS_OR_DEFAULT(config, lease_duration, 1000)),
+      max_leases_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_leases, 1000)) {}
+
+ThreadLocalQuotaLeases::ThreadLocalQuotaLeases(const QuotaLeaseConfig& config,
+                                               Event::Dispatcher& dispatcher,
+                                               RateLimitClientFactory client_factory)
+    : config_(config), dispatcher_(dispatcher), client_factory_(std::move(client_factory)),
+      flush_callback_(dispatcher.createSchedulableCallback([this]() { flush(); })) {}
+
+ThreadLocalQuotaLeases::~ThreadLocalQuotaLeases() {
+  for (const LeaseRequestPtr& request : requests_) {
+    request->cancel();
+  }
+}
+
+bool ThreadLocalQuotaLeases::tryConsume(
+    const std::string& domain, const std::vector<Envoy::RateLimit::Descriptor>& descriptors,
+    uint64_t hits) {
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  if (num_leases_ + descriptors.size() > config_.max_leases_) {
+    removeExpiredLeases(now);
+  }
+  LeaseMap& domain_leases = leases_[domain];
+  absl::InlinedVector<Lease*, 4> leases;
+  bool allowed = true;
+  for (const Envoy::RateLimit::Descriptor& descriptor : descriptors) {
+    if (descriptor.limit_.has_value() || descriptor.hits_addend_.has_value()) {
+      // The rate limit service must see these, so the whole request goes to it.
+      return false;
+    }
+    Lease* lease = findOrCreateLease(domain_leases, descriptor, now);
+    if (lease == nullptr || lease->hits_ < hits) {
+      allowed = false;
+    }
+    leases.push_back(lease);
+  }
+
+  for (size_t i = 0; i < descriptors.size(); ++i) {
+    Lease* lease = leases[i];
+    if (lease == nullptr) {
+      continue;
+    }
+    if (allowed) {
+      lease->hits_ -= hits;
+    }
+    if (!lease->requested_ && lease->retry_at_ <= now &&
+        lease->hits_ <= config_.lease_size_ / 2) {
+      requestLease(domain, descriptors[i], *lease);
+    }
+  }
+  return allowed;
+}
+
+uint64_t ThreadLocalQuotaLeases::leasedHits(const std::string& domain,
+                                            const Envoy::RateLimit::Descriptor& descriptor) {
+  const auto domain_leases = leases_.find(domain);
+  if (domain_leases == leases_.end()) {
+    return 0;
+  }
+  const auto lease = domain_leases->second.find(descriptor);
+  if (lease == domain_leases->second.end() ||
+      lease->second.expires_at_ <= dispatcher_.timeSource().monotonicTime()) {
+    return 0;
+  }
+  return lease->second.hits_;
+}
+
+ThreadLocalQuotaLeases::Lease*
+ThreadLocalQuotaLeases::findOrCreateLease(LeaseMap& leases,
+                                          const Envoy::RateLimit::Descriptor& descriptor,
+                                          MonotonicTime now) {
+  auto it = leases.find(descriptor);
+  if (it == leases.end()) {
+    if (num_leases_ >= config_.max_leases_) {
+      return nullptr;
+    }
+    // Only the entries identify a lease.
+    it = leases.emplace(Envoy::RateLimit::Descriptor{descriptor.entries_}, Lease{}).first;
+    ++num_leases_;
+  }
+  Lease& lease = it->second;
+  if (lease.expires_at_ <= now) {
+    lease.hits_ = 0;
+  }
+  return &lease;
+}
+
+void ThreadLocalQuotaLeases::removeExpiredLeases(MonotonicTime now) {
+  for (auto& [domain, leases] : leases_) {
+    for (auto it = leases.begin(); it != leases.end();) {
+      // Leases that are being renewed are kept for the response.
+      if (!it->second.requested_ && it->second.expires_at_ <= now) {
+        leases.erase(it++);
+        --num_leases_;
+      } else {
+        ++it;
+      }
+    }
+  }
+}
+
+void ThreadLocalQuotaLeases::requestLease(const std::string& domain,
+                                          const Envoy::RateLimit::Descriptor& descriptor,
+                                          Lease& lease) {
+  lease.requested_ = true;
+  pending_[domain].push_back(Envoy::RateLimit::Descriptor{descriptor.entries_});
+  // All the leases requested in this event loop iteration are taken with one call per domain.
+  if (!flush_callback_->enabled()) {
+    flush_callback_->scheduleCallbackNextIteration();
+  }
+}
+
+void ThreadLocalQuotaLeases::flush() {
+  auto pending = std::move(pending_);
+  pending_.clear();
+  for (auto& [domain, descriptors] : pending) {
+    ENVOY_LOG(debug, "requesting {} quota leases for domain {}", descriptors.size(), domain);
+    LinkedList::moveIntoList(
+        std::make_unique<LeaseRequest>(*this, domain, std::move(descriptors)), requests_);
+    // The response may complete the request, and remove it from the list, inline.
+    requests_.front()->start();
+  }
+}
+
+void ThreadLocalQuotaLeases::onLeaseResponse(
+    LeaseRequest& request, LimitStatus status,
+    const Filters::Common::RateLimit::DescriptorStatusList* descriptor_statuses,
+    const std::string& domain, const std::vector<Envoy::RateLimit::Descriptor>& descriptors) {
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  LeaseMap& domain_leases = leases_[domain];
+  const bool per_descriptor =
+      descriptor_statuses != nullptr && descriptor_statuses->size() == descriptors.size();
+  for (size_t i = 0; i < descriptors.size(); ++i) {
+    const auto it = domain_leases.find(descriptors[i]);
+    if (it == domain_leases.end()) {
+      continue;
+    }
+    Lease& lease = it->second;
+    lease.requested_ = false;
+    const bool granted =
+        status != LimitStatus::Error &&
+        (per_descriptor ? (*descriptor_statuses)[i].code() ==
+                              envoy::service::ratelimit::v3::RateLimitResponse::OK
+                        : status == LimitStatus::OK);
+    if (!granted) {
+      // Requests with this descriptor call the rate limit service until it is retried, instead of
+      // asking it for a lease on every event loop iteration.
+      lease.retry_at_ = now + config_.lease_duration_;
+      continue;
+    }
+    if (lease.expires_at_ <= now) {
+      lease.hits_ = 0;
+    }
+    lease.hits_ += config_.lease_size_;
+    lease.expires_at_ = now + config_.lease_duration_;
+  }
+  dispatcher_.deferredDelete(request.removeFromList(requests_));
+}
+
+ThreadLocalQuotaLeases::LeaseRequest::LeaseRequest(
+    ThreadLocalQuotaLeases& parent, std::string domain,
+    std::vector<Envoy::RateLimit::Descriptor> descriptors)
+    : parent_(parent), domain_(std::move(domain)), descriptors_(std::move(descriptors)),
+      client_(parent.client_factory_()) {}
+
+void ThreadLocalQuotaLeases::LeaseRequest::start() {
+  client_->limit(*this, domain_, descriptors_, Tracing::NullSpan::instance(), absl::nullopt,
+                 parent_.config_.lease_size_);
+}
+
+void ThreadLocalQuotaLeases::LeaseRequest::complete(
+    LimitStatus status, Filters::Common::RateLimit::DescriptorStatusListPtr&& descriptor_statuses,
+    Http::ResponseHeaderMapPtr&&, Http::RequestHeaderMapPtr&&, const std::string&,
+    Filters::Common::RateLimit::DynamicMetadataPtr&&) {
+  parent_.onLeaseResponse(*this, status, descriptor_statuses.get(), domain_, descriptors_);
+}
+
+QuotaLeases::QuotaLeases(
+    const envoy::extensions::filters::http::ratelimit::v3::RateLimit::QuotaLease& config,
+    ThreadLocal::SlotAllocator& tls, RateLimitClientFactory client_factory)
+    : config_(config), tls_(tls) {
+  tls_.set([this, client_factory = std::move(client_factory)](Event::Dispatcher& dispatcher) {
+    return std::make_shared<ThreadLocalQuotaLeases>(config_, dispatcher, client_factory);
+  });
+}
+
+} // namespace RateLimitFilter
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/event/deferred_deletable.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/extensions/filters/http/ratelimit/v3/rate_limit.pb.h"
+#include "envoy/ratelimit/ratelimit.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/linked_object.h"
+#include "source/common/common/logger.h"
+#include "source/extensions/filters/common/ratelimit/ratelimit.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace RateLimitFilter {
+
+using RateLimitClientFactory = std::function<Filters::Common::RateLimit::ClientPtr()>;
+
+struct QuotaLeaseConfig {
+  explicit QuotaLeaseConfig(
+      const envoy::extensions::filters::http::ratelimit::v3::RateLimit::QuotaLease& config);
+
+  const uint32_t lease_size_;
+  const std::chrono::milliseconds lease_duration_;
+  const uint32_t max_leases_;
+};
+
+/**
+ * The hits one worker leased from the rate limit service, by domain and descriptor. Leases are
+ * requested with the hits addend of a rate limit request, so the rate limit service counts the
+ * whole lease when it grants it.
+ */
+class ThreadLocalQuotaLeases : public ThreadLocal::ThreadLocalObject,
+                               Logger::Loggable<Logger::Id::filter> {
+public:
+  ThreadLocalQuotaLeases(const QuotaLeaseConfig& config, Event::Dispatcher& dispatcher,
+                         RateLimitClientFactory client_factory);
+  ~ThreadLocalQuotaLeases() override;
+
+  /**
+   * Takes `hits` from the leases of all of `descriptors` if they all hold enough of them, and
+   * requests new leases for the descriptors that run low.
+   * @return whether the hits were taken, in which case the request is allowed.
+   */
+  bool tryConsume(const std::string& domain,
+                  const std::vector<Envoy::RateLimit::Descriptor>& descriptors, uint64_t hits);
+
+  // The hits left in the lease of a descriptor, for tests.
+  uint64_t leasedHits(const std::string& domain, const Envoy::RateLimit::Descriptor& descriptor);
+
+private:
+  struct Lease {
+    uint64_t hits_{};
+    MonotonicTime expires_at_;
+    // No new lease is requested before this time, after the rate limit service refused one.
+    MonotonicTime retry_at_;
+    bool requested_{};
+  };
+
+  // One call to the rate limit service taking leases for the descriptors of one domain.
+  class LeaseRequest : public Filters::Common::RateLimit::RequestCallbacks,
+                       public Event::DeferredDeletable,
+                       public LinkedObject<LeaseRequest> {
+  public:
+    LeaseRequest(ThreadLocalQuotaLeases& parent, std::string domain,
+                 std::vector<Envoy::RateLimit::Descriptor> descriptors);
+
+    void start();
+    void cancel() { client_->cancel(); }
+
+    // Filters::Common::RateLimit::RequestCallbacks
+    void complete(Filters::Common::RateLimit::LimitStatus status,
+                  Filters::Common::RateLimit::DescriptorStatusListPtr&& descriptor_statuses,
+                  Http::ResponseHeaderMapPtr&&, Http::RequestHeaderMapPtr&&, const std::string&,
+                  Filters::Common::RateLimit::DynamicMetadataPtr&&) override;
+
+  private:
+    ThreadLocalQuotaLeases& parent_;
+    const std::string domain_;
+    const std::vector<Envoy::RateLimit::Descriptor> descriptors_;
+    Filters::Common::RateLimit::ClientPtr client_;
+  };
+  using LeaseRequestPtr = std::unique_ptr<LeaseRequest>;
+  // Leases keep their address while other leases are added.
+  using LeaseMap = absl::node_hash_map<Envoy::RateLimit::Descriptor, Lease,
+                                       Envoy::RateLimit::Descriptor::Hash,
+                                       Envoy::RateLimit::Descriptor::Equal>;
+
+  Lease* findOrCreateLease(LeaseMap& leases, const Envoy::RateLimit::Descriptor& descriptor,
+                           MonotonicTime now);
+  void removeExpiredLeases(MonotonicTime now);
+  void requestLease(const std::string& domain, const Envoy::RateLimit::Descriptor& descriptor,
+                    Lease& lease);
+  void flush();
+  void onLeaseResponse(LeaseRequest& request, Filters::Common::RateLimit::LimitStatus status,
+                       const Filters::Common::RateLimit::DescriptorStatusList* descriptor_statuses,
+                       const std::string& domain,
+                       const std::vector<Envoy::RateLimit::Descriptor>& descriptors);
+
+  const QuotaLeaseConfig& config_;
+  Event::Dispatcher& dispatcher_;
+  RateLimitClientFactory client_factory_;
+  absl::flat_hash_map<std::string, LeaseMap> leases_;
+  uint64_t num_leases_{};
+  // The descriptors to request leases for on the next flush, by domain.
+  absl::flat_hash_map<std::string, std::vector<Envoy::RateLimit::Descriptor>> pending_;
+  Event::SchedulableCallbackPtr flush_callback_;
+  std::list<LeaseRequestPtr> requests_;
+};
+
+/**
+ * The quota leases of a rate limit filter config, with one set of leases per worker.
+ */
+class QuotaLeases {
+public:
+  QuotaLeases(const envoy::extensions::filters::http::ratelimit::v3::RateLimit::QuotaLease& config,
+              ThreadLocal::SlotAllocator& tls, RateLimitClientFactory client_factory);
+
+  bool tryConsume(const std::string& domain,
+                  const std::vector<Envoy::RateLimit::Descriptor>& descriptors, uint64_t hits) {
+    return tls_->tryConsume(domain, descriptors, hits);
+  }
+
+private:
+  const QuotaLeaseConfig config_;
+  ThreadLocal::TypedSlot<ThreadLocalQuotaLeases> tls_;
+};
+
+using QuotaLeasesPtr = std::unique_ptr<QuotaLeases>;
+
+} // namespace RateLimitFilter
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -1,5 +1,6 @@
 #include "source/extensions/filters/http/ratelimit/ratelimit.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -58,6 +59,14 @@ void Filter::initiateCall(const Http::RequestHeaderMap& headers) {
   std::vector<Envoy::RateLimit::Descriptor> descriptors;
   populateRateLimitDescriptors(descriptors, headers, false);
   if (!descriptors.empty()) {
+    const uint64_t hits = std::max<uint64_t>(1, static_cast<uint64_t>(getHitAddend()));
+    if (config_->quotaLeases() != nullptr &&
+        config_->quotaLeases()->tryConsume(getDomain(), descriptors, hits)) {
+      Filters::Common::RateLimit::StatNames& stat_names = config_->statNames();
+      cluster_->statsScope().counterFromStatName(stat_names.ok_).inc();
+      cluster_->statsScope().counterFromStatName(stat_names.leased_).inc();
+      return;
+    }
     state_ = State::Calling;
     initiating_call_ = true;
     client_->limit(*this, getDomain(), descriptors, callbacks_->activeSpan(),
@@ -20,6 +20,7 @@
 #include "source/extensions/filters/common/ratelimit/ratelimit.h"
 #include "source/extensions/filters/common/ratelimit/stat_names.h"
 #include "source/extensions/filters/common/ratelimit_config/ratelimit_config.h"
+#include "source/extensions/filters/http/ratelimit/quota_lease.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -43,7 +44,8 @@ class FilterConfig {
 public:
   FilterConfig(const envoy::extensions::filters::http::ratelimit::v3::RateLimit& config,
                const LocalInfo::LocalInfo& local_info, Stats::Scope& scope,
-               Runtime::Loader& runtime, Http::Context& http_context)
+               Runtime::Loader& runtime, Http::Context& http_context,
+               QuotaLeasesPtr quota_leases = nullptr)
       : domain_(config.domain()), stage_(static_cast<uint64_t>(config.stage())),
         request_type_(config.request_type().empty() ? stringToType("both")
                                                     : stringToType(config.request_type())),
@@ -62,7 +64,8 @@ public:
         response_headers_parser_(THROW_OR_RETURN_VALUE(
             Envoy::Router::HeaderParser::configure(config.response_headers_to_add()),
             Router::HeaderParserPtr)),
-        status_on_error_(toRatelimitServerErrorCode(config.status_on_error().code())) {}
+        status_on_error_(toRatelimitServerErrorCode(config.status_on_error().code())),
+        quota_leases_(std::move(quota_leases)) {}
   const std::string& domain() const { return domain_; }
   const LocalInfo::LocalInfo& localInfo() const { return local_info_; }
   uint64_t stage() const { return stage_; }
@@ -80,6 +83,7 @@ public:
   Http::Code rateLimitedStatus() { return rate_limited_status_; }
   const Router::HeaderParser& responseHeadersParser() const { return *response_headers_parser_; }
   Http::Code statusOnError() const { return status_on_error_; }
+  QuotaLeases* quotaLeases() const { return quota_leases_.get(); }
 
 private:
   static FilterRequestType stringToType(const std::string& request_type) {
@@ -124,6 +128,7 @@ private:
   const Http::Code rate_limited_status_;
   Router::HeaderParserPtr response_headers_parser_;
   const Http::Code status_on_error_;
+  const QuotaLeasesPtr quota_leases_;
 };
 
 using FilterConfigSharedPtr = std::shared_ptr<FilterConfig>;
@@ -65,7 +65,8 @@ using HttpPerRequestTapperPtr = std::unique_ptr<HttpPerRequestTapper>;
 class HttpTapConfig : public virtual Extensions::Common::Tap::TapConfig {
 public:
   /**
-   * @return a new per-request HTTP tapper which is used to handle tapping of a discrete request.
+   * @return a new per-request HTTP tapper which is used to handle tapping of a discrete request,
+   *         or nullptr if the request is not sampled for tapping.
    * @param tap_config provides http tap config
    * @param stream_id supplies the owning HTTP stream ID.
    */
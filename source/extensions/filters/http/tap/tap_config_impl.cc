@@ -38,6 +38,9 @@ HttpTapConfigImpl::HttpTapConfigImpl(const envoy::config::tap::v3::TapConfig& pr
 HttpPerRequestTapperPtr HttpTapConfigImpl::createPerRequestTapper(
     const envoy::extensions::filters::http::tap::v3::Tap& tap_config, uint64_t stream_id,
     OptRef<const Network::Connection> connection) {
+  if (!tapEnabled()) {
+    return nullptr;
+  }
   return std::make_unique<HttpPerRequestTapperImpl>(shared_from_this(), tap_config, stream_id,
                                                     connection);
 }
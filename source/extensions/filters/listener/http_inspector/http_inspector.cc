@@ -25,7 +25,9 @@ const absl::string_view Filter::HTTP2_CONNECTION_PREFACE = "PRI * HTTP/2.0\r\n\r
 
 Filter::Filter(const ConfigSharedPtr config)
     : config_(config), no_op_callbacks_(),
-      requested_read_bytes_(Config::DEFAULT_INITIAL_BUFFER_SIZE) {
+      requested_read_bytes_(Config::DEFAULT_INITIAL_BUFFER_SIZE) {}
+
+void Filter::createParser() {
   // Filter for only Request Message types with NoOp Parser callbacks.
   if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http_inspector_use_balsa_parser")) {
     // Set both allow_custom_methods and enable_trailers to true with BalsaParser.
@@ -105,6 +107,11 @@ ParseState Filter::parseHttpHeader(absl::string_view data) {
     if (data[0] == '\r' || data[0] == '\n') {
       return ParseState::Error;
     }
+    // The parser is only created for HTTP/1 candidates, not for the connections which turn out to
+    // be TLS or HTTP/2, which are the most common on the listeners with an http inspector.
+    if (parser_ == nullptr) {
+      createParser();
+    }
 
     absl::string_view new_data = data.substr(nread_);
     const size_t pos = new_data.find_first_of('\n');
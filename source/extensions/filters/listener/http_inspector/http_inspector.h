@@ -114,6 +114,7 @@ public:
 private:
   static const absl::string_view HTTP2_CONNECTION_PREFACE;
 
+  void createParser();
   void done(bool success);
   ParseState parseHttpHeader(absl::string_view data);
 
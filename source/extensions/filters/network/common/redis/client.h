@@ -155,6 +155,12 @@ public:
    */
   virtual std::chrono::milliseconds bufferFlushTimeoutInMs() const PURE;
 
+  /**
+   * @return when enabled, the commands for a single upstream host made during an event loop
+   * iteration are written together at the end of the iteration.
+   */
+  virtual bool coalesceWrites() const PURE;
+
   /**
    * @return the maximum number of upstream connections to unknown hosts when enableRedirection() is
    * true.
@@ -26,6 +26,7 @@ ConfigImpl::ConfigImpl(
           config, buffer_flush_timeout,
           3)), // Default timeout is 3ms. If max_buffer_size_before_flush is zero, this is not used
                // as the buffer is flushed on each request immediately.
+      coalesce_writes_(config.coalesce_writes()),
       max_upstream_unknown_connections_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_upstream_unknown_connections, 100)),
       enable_command_stats_(config.enable_command_stats()) {
@@ -86,6 +87,9 @@ ClientImpl::ClientImpl(Upstream::HostConstSharedPtr host, Event::Dispatcher& dis
       flush_timer_(dispatcher.createTimer([this]() { flushBufferAndResetTimer(); })),
       time_source_(dispatcher.timeSource()), redis_command_stats_(redis_command_stats),
       scope_(scope), is_transaction_client_(is_transaction_client) {
+  if (config_->coalesceWrites()) {
+    flush_cb_ = dispatcher.createSchedulableCallback([this]() { flushBufferAndResetTimer(); });
+  }
   Upstream::ClusterTrafficStats& traffic_stats = *host->cluster().trafficStats();
   traffic_stats.upstream_cx_total_.inc();
   host->stats().cx_total_.inc();
@@ -107,6 +111,9 @@ void ClientImpl::flushBufferAndResetTimer() {
   if (flush_timer_->enabled()) {
     flush_timer_->disableTimer();
   }
+  if (flush_cb_ != nullptr) {
+    flush_cb_->cancel();
+  }
   connection_->write(encoder_buffer_, false);
 }
 
@@ -128,8 +135,17 @@ PoolRequest* ClientImpl::makeRequest(const RespValue& request, ClientCallbacks&
   pending_requests_.emplace_back(*this, callbacks, command);
   encoder_->encode(request, encoder_buffer_);
 
-  // If buffer is full, flush. If the buffer was empty before the request, start the timer.
-  if (encoder_buffer_.length() >= config_->maxBufferSizeBeforeFlush()) {
+  // If buffer is full, flush. Otherwise, if writes are coalesced, flush at the end of the event
+  // loop iteration, which lets the requests made on behalf of other downstream connections in the
+  // meantime share the write. If the buffer was empty before the request, start the timer.
+  const uint32_t max_buffer_size = config_->maxBufferSizeBeforeFlush();
+  if (max_buffer_size > 0 && encoder_buffer_.length() >= max_buffer_size) {
+    flushBufferAndResetTimer();
+  } else if (flush_cb_ != nullptr) {
+    if (!flush_cb_->enabled()) {
+      flush_cb_->scheduleCallbackCurrentIteration();
+    }
+  } else if (max_buffer_size == 0) {
     flushBufferAndResetTimer();
   } else if (empty_buffer) {
     flush_timer_->enableTimer(std::chrono::milliseconds(config_->bufferFlushTimeoutInMs()));
@@ -200,6 +216,9 @@ void ClientImpl::onEvent(Network::ConnectionEvent event) {
     }
 
     connect_or_op_timer_->disableTimer();
+    if (flush_cb_ != nullptr) {
+      flush_cb_->cancel();
+    }
   } else if (event == Network::ConnectionEvent::Connected) {
     connected_ = true;
     ASSERT(!pending_requests_.empty());
@@ -208,6 +208,14 @@ public:
    * @param out supplies the buffer to encode to.
    */
   virtual void encode(const RespValue& value, Buffer::Instance& out) PURE;
+
+  /**
+   * Encode a RESP value to a buffer, moving large bulk strings into the buffer rather than copying
+   * them.
+   * @param value supplies the value to encode. It is left in a valid but unspecified state.
+   * @param out supplies the buffer to encode to.
+   */
+  virtual void encode(RespValue&& value, Buffer::Instance& out) PURE;
 };
 
 using EncoderPtr = std::unique_ptr<Encoder>;
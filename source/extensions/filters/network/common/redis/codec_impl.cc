@@ -1,5 +1,6 @@
 #include "source/extensions/filters/network/common/redis/codec_impl.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -330,7 +331,9 @@ RespValue::CompositeArray::CompositeArrayConstIterator::empty() {
 }
 
 void DecoderImpl::decode(Buffer::Instance& data) {
+  remaining_after_slice_ = data.length();
   for (const Buffer::RawSlice& slice : data.getRawSlices()) {
+    remaining_after_slice_ -= slice.len_;
     parseSlice(slice);
   }
 
@@ -651,7 +654,11 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
       } else {
         ASSERT(current_value.value_->type() == RespType::BulkString);
         if (!pending_integer_.negative_) {
-          // TODO(mattklein123): reserve and define max length since we don't stream currently.
+          // Reserve as much of the string as was already received, so that large values are not
+          // reallocated as they are appended, without trusting the length sent by the peer.
+          current_value.value_->asString().reserve(
+              std::min(static_cast<uint64_t>(pending_integer_.integer_),
+                       remaining_after_slice_ + remaining));
           state_ = State::BulkStringBody;
         } else {
           // Null bulk string. Switch type to null and move to value complete.
@@ -774,15 +781,55 @@ void EncoderImpl::encode(const RespValue& value, Buffer::Instance& out) {
   }
 }
 
-void EncoderImpl::encodeArray(const std::vector<RespValue>& array, Buffer::Instance& out) {
+namespace {
+
+// Owns a bulk string which was moved into an output buffer.
+class StringBufferFragment : public Buffer::BufferFragment {
+public:
+  explicit StringBufferFragment(std::string&& string) : string_(std::move(string)) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return string_.data(); }
+  size_t size() const override { return string_.size(); }
+  void done() override { delete this; }
+
+private:
+  const std::string string_;
+};
+
+} // namespace
+
+void EncoderImpl::encode(RespValue&& value, Buffer::Instance& out) {
+  switch (value.type()) {
+  case RespType::Array: {
+    encodeArrayHeader(value.asArray().size(), out);
+    for (RespValue& element : value.asArray()) {
+      encode(std::move(element), out);
+    }
+    break;
+  }
+  case RespType::BulkString: {
+    encodeBulkString(std::move(value.asString()), out);
+    break;
+  }
+  default:
+    encode(static_cast<const RespValue&>(value), out);
+    break;
+  }
+}
+
+void EncoderImpl::encodeArrayHeader(uint64_t size, Buffer::Instance& out) {
   char buffer[32];
   char* current = buffer;
   *current++ = '*';
-  current += StringUtil::itoa(current, 21, array.size());
+  current += StringUtil::itoa(current, 21, size);
   *current++ = '\r';
   *current++ = '\n';
   out.add(buffer, current - buffer);
+}
 
+void EncoderImpl::encodeArray(const std::vector<RespValue>& array, Buffer::Instance& out) {
+  encodeArrayHeader(array.size(), out);
   for (const RespValue& value : array) {
     encode(value, out);
   }
@@ -790,30 +837,38 @@ void EncoderImpl::encodeArray(const std::vector<RespValue>& array, Buffer::Insta
 
 void EncoderImpl::encodeCompositeArray(const RespValue::CompositeArray& composite_array,
                                        Buffer::Instance& out) {
-  char buffer[32];
-  char* current = buffer;
-  *current++ = '*';
-  current += StringUtil::itoa(current, 21, composite_array.size());
-  *current++ = '\r';
-  *current++ = '\n';
-  out.add(buffer, current - buffer);
+  encodeArrayHeader(composite_array.size(), out);
   for (const RespValue& value : composite_array) {
     encode(value, out);
   }
 }
 
-void EncoderImpl::encodeBulkString(const std::string& string, Buffer::Instance& out) {
+void EncoderImpl::encodeBulkStringHeader(uint64_t size, Buffer::Instance& out) {
   char buffer[32];
   char* current = buffer;
   *current++ = '$';
-  current += StringUtil::itoa(current, 21, string.size());
+  current += StringUtil::itoa(current, 21, size);
   *current++ = '\r';
   *current++ = '\n';
   out.add(buffer, current - buffer);
+}
+
+void EncoderImpl::encodeBulkString(const std::string& string, Buffer::Instance& out) {
+  encodeBulkStringHeader(string.size(), out);
   out.add(string);
   out.add("\r\n", 2);
 }
 
+void EncoderImpl::encodeBulkString(std::string&& string, Buffer::Instance& out) {
+  encodeBulkStringHeader(string.size(), out);
+  if (string.size() >= MinMovedBulkStringSize) {
+    out.addBufferFragment(*new StringBufferFragment(std::move(string)));
+  } else {
+    out.add(string);
+  }
+  out.add("\r\n", 2);
+}
+
 void EncoderImpl::encodeError(const std::string& string, Buffer::Instance& out) {
   out.add("-", 1);
   out.add(string);
@@ -66,6 +66,8 @@ private:
   void parseSlice(const Buffer::RawSlice& slice);
 
   DecoderCallbacks& callbacks_;
+  // The number of bytes passed to decode() after the slice being parsed.
+  uint64_t remaining_after_slice_{};
   State state_{State::ValueRootStart};
   PendingInteger pending_integer_;
   RespValuePtr pending_value_root_;
@@ -88,13 +90,20 @@ public:
  */
 class EncoderImpl : public Encoder {
 public:
+  // Bulk strings of at least this size are moved into the output buffer rather than copied.
+  static constexpr uint64_t MinMovedBulkStringSize = 16 * 1024;
+
   // RedisProxy::Encoder
   void encode(const RespValue& value, Buffer::Instance& out) override;
+  void encode(RespValue&& value, Buffer::Instance& out) override;
 
 private:
+  void encodeArrayHeader(uint64_t size, Buffer::Instance& out);
   void encodeArray(const std::vector<RespValue>& array, Buffer::Instance& out);
   void encodeCompositeArray(const RespValue::CompositeArray& array, Buffer::Instance& out);
+  void encodeBulkStringHeader(uint64_t size, Buffer::Instance& out);
   void encodeBulkString(const std::string& string, Buffer::Instance& out);
+  void encodeBulkString(std::string&& string, Buffer::Instance& out);
   void encodeError(const std::string& string, Buffer::Instance& out);
   void encodeInteger(int64_t integer, Buffer::Instance& out);
   void encodeSimpleString(const std::string& string, Buffer::Instance& out);
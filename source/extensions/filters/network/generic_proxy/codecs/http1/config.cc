@@ -275,8 +275,13 @@ bool Http1CodecBase::decodeBuffer(Buffer::Instance& buffer) {
 
   while (decoding_buffer_.length() > 0) {
     const auto slice = decoding_buffer_.frontSlice();
+    parsing_slice_ = static_cast<const char*>(slice.mem_);
+    parsing_slice_length_ = slice.len_;
+    parsing_slice_drained_ = 0;
     const auto nread = parser_->execute(static_cast<const char*>(slice.mem_), slice.len_);
-    decoding_buffer_.drain(nread);
+    ASSERT(nread >= parsing_slice_drained_);
+    decoding_buffer_.drain(nread - parsing_slice_drained_);
+    parsing_slice_ = nullptr;
 
     if (const auto status = parser_->getStatus(); status == Http::Http1::ParserStatus::Error) {
       // Parser has encountered an error. Return false to indicate decoding failure. Ignore the
@@ -297,6 +302,21 @@ bool Http1CodecBase::decodeBuffer(Buffer::Instance& buffer) {
   return dispatchBufferedBody(false);
 }
 
+void Http1CodecBase::bufferBody(const char* data, size_t length) {
+  // The body is in the slice being parsed, ahead of the bytes not yet parsed, so it can be moved
+  // out of the decoding buffer. Slices which only hold body bytes are then handed over without
+  // copying them.
+  if (parsing_slice_ != nullptr && data >= parsing_slice_ + parsing_slice_drained_ &&
+      data + length <= parsing_slice_ + parsing_slice_length_) {
+    const size_t offset = data - parsing_slice_;
+    decoding_buffer_.drain(offset - parsing_slice_drained_);
+    buffered_body_.move(decoding_buffer_, length);
+    parsing_slice_drained_ = offset + length;
+    return;
+  }
+  buffered_body_.add(data, length);
+}
+
 bool Http1CodecBase::dispatchBufferedBody(bool end_stream) {
   if (single_frame_mode_) {
     // Do nothing to the buffered body until the onMessageComplete callback if we are in single
@@ -226,7 +226,7 @@ public:
     header_parsing_state_ = HeaderParsingState::Done;
     return onHeadersCompleteImpl();
   }
-  void bufferBody(const char* data, size_t length) override { buffered_body_.add(data, length); }
+  void bufferBody(const char* data, size_t length) override;
   Http::Http1::CallbackResult onMessageComplete() override { return onMessageCompleteImpl(); }
   void onChunkHeader(bool is_final_chunk) override {
     if (is_final_chunk) {
@@ -270,6 +270,11 @@ protected:
   Envoy::Buffer::OwnedImpl encoding_buffer_;
 
   Buffer::OwnedImpl buffered_body_;
+  // The front slice of the decoding buffer which is being parsed, and how many of its bytes were
+  // already moved out, so that the body can be moved to the buffered body instead of copied.
+  const char* parsing_slice_{};
+  size_t parsing_slice_length_{};
+  size_t parsing_slice_drained_{};
 
   Http::Http1::ParserPtr parser_;
   Http::HeaderString current_header_field_;
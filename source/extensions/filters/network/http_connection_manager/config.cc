@@ -427,6 +427,7 @@ HttpConnectionManagerConfig::HttpConnectionManagerConfig(
                                : nullptr),
       header_validator_factory_(createHeaderValidatorFactory(config, context, creation_status)),
       append_local_overload_(config.append_local_overload()),
+      track_cpu_time_(config.track_cpu_time()),
       append_x_forwarded_port_(config.append_x_forwarded_port()),
       add_proxy_protocol_connection_state_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, add_proxy_protocol_connection_state, true)) {
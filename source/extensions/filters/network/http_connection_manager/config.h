@@ -270,6 +270,7 @@ public:
 #endif
   }
   bool appendLocalOverload() const override { return append_local_overload_; }
+  bool trackCpuTime() const override { return track_cpu_time_; }
   bool appendXForwardedPort() const override { return append_x_forwarded_port_; }
   bool addProxyProtocolConnectionState() const override {
     return add_proxy_protocol_connection_state_;
@@ -368,6 +369,7 @@ private:
   const std::unique_ptr<HttpConnectionManagerProto::ProxyStatusConfig> proxy_status_config_;
   const Http::HeaderValidatorFactoryPtr header_validator_factory_;
   const bool append_local_overload_;
+  const bool track_cpu_time_;
   const bool append_x_forwarded_port_;
   const bool add_proxy_protocol_connection_state_;
 };
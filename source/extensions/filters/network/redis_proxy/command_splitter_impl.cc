@@ -185,6 +185,14 @@ void DelayFaultRequest::onDelayResponse() {
 
 void DelayFaultRequest::cancel() { delay_timer_->disableTimer(); }
 
+void ReadCacheFillRequest::onResponse(Common::Redis::RespValuePtr&& response) {
+  if (response->type() == Common::Redis::RespType::BulkString ||
+      response->type() == Common::Redis::RespType::Null) {
+    cache_.insert(key_, *response, time_source_.monotonicTime(), epoch_);
+  }
+  callbacks_.onResponse(std::move(response));
+}
+
 SplitRequestPtr SimpleRequest::create(Router& router,
                                       Common::Redis::RespValuePtr&& incoming_request,
                                       SplitCallbacks& callbacks, CommandStats& command_stats,
@@ -698,13 +706,15 @@ SplitRequestPtr TransactionRequest::create(Router& router,
 
 InstanceImpl::InstanceImpl(RouterPtr&& router, Stats::Scope& scope, const std::string& stat_prefix,
                            TimeSource& time_source, bool latency_in_micros,
-                           Common::Redis::FaultManagerPtr&& fault_manager)
+                           Common::Redis::FaultManagerPtr&& fault_manager,
+                           ReadCacheSharedPtr read_cache)
     : router_(std::move(router)), simple_command_handler_(*router_),
       eval_command_handler_(*router_), mget_handler_(*router_), mset_handler_(*router_),
       keys_handler_(*router_), split_keys_sum_result_handler_(*router_),
       transaction_handler_(*router_), stats_{ALL_COMMAND_SPLITTER_STATS(
                                           POOL_COUNTER_PREFIX(scope, stat_prefix + "splitter."))},
-      time_source_(time_source), fault_manager_(std::move(fault_manager)) {
+      time_source_(time_source), fault_manager_(std::move(fault_manager)),
+      read_cache_(std::move(read_cache)) {
   for (const std::string& command : Common::Redis::SupportedCommands::simpleCommands()) {
     addHandler(scope, stat_prefix, command, latency_in_micros, simple_command_handler_);
   }
@@ -859,6 +869,18 @@ SplitRequestPtr InstanceImpl::makeRequest(Common::Redis::RespValuePtr&& request,
   // Fault Injection Check
   const Common::Redis::Fault* fault_ptr = fault_manager_->getFaultForCommand(command_name);
 
+  if (read_cache_ != nullptr) {
+    if (command_name == Common::Redis::SupportedCommands::get() &&
+        request->asArray().size() == 2 && !callbacks.transaction().active_ &&
+        fault_ptr == nullptr && read_cache_->cacheable(request->asArray()[1].asString())) {
+      return makeCachedGetRequest(std::move(request), callbacks, *handler, stream_info);
+    }
+    if (command_name != Common::Redis::SupportedCommands::get() &&
+        command_name != Common::Redis::SupportedCommands::mget()) {
+      read_cache_->invalidate(*request);
+    }
+  }
+
   // Check if delay, which determines which callbacks to use. If a delay fault is enabled,
   // the delay fault itself wraps the request (or other fault) and the delay fault itself
   // implements the callbacks functions, and in turn calls the real callbacks after injecting
@@ -898,6 +920,30 @@ SplitRequestPtr InstanceImpl::makeRequest(Common::Redis::RespValuePtr&& request,
   }
 }
 
+SplitRequestPtr InstanceImpl::makeCachedGetRequest(Common::Redis::RespValuePtr&& request,
+                                                   SplitCallbacks& callbacks, HandlerData& handler,
+                                                   const StreamInfo::StreamInfo& stream_info) {
+  ThreadLocalReadCache& cache = read_cache_->local();
+  const std::string& key = request->asArray()[1].asString();
+  handler.command_stats_.total_.inc();
+  Common::Redis::RespValuePtr cached = cache.lookup(key, time_source_.monotonicTime());
+  if (cached != nullptr) {
+    ENVOY_LOG(debug, "serving '{}' from the read cache", key);
+    handler.command_stats_.success_.inc();
+    callbacks.onResponse(std::move(cached));
+    return nullptr;
+  }
+
+  auto fill_request = std::make_unique<ReadCacheFillRequest>(callbacks, cache, key, time_source_);
+  fill_request->wrapped_request_ptr_ = handler.handler_.get().startRequest(
+      std::move(request), *fill_request, handler.command_stats_, time_source_, false, stream_info);
+  // The wrapped request may already have responded.
+  if (fill_request->wrapped_request_ptr_ == nullptr) {
+    return nullptr;
+  }
+  return fill_request;
+}
+
 void InstanceImpl::onInvalidRequest(SplitCallbacks& callbacks) {
   stats_.invalid_request_.inc();
   callbacks.onResponse(Common::Redis::Utility::makeError(Response::get().InvalidRequest));
@@ -16,6 +16,7 @@
 #include "source/extensions/filters/network/common/redis/utility.h"
 #include "source/extensions/filters/network/redis_proxy/command_splitter.h"
 #include "source/extensions/filters/network/redis_proxy/conn_pool_impl.h"
+#include "source/extensions/filters/network/redis_proxy/read_cache.h"
 #include "source/extensions/filters/network/redis_proxy/router.h"
 
 namespace Envoy {
@@ -171,6 +172,39 @@ private:
   Common::Redis::RespValuePtr response_;
 };
 
+/**
+ * ReadCacheFillRequest wraps a GET request and caches its response.
+ */
+class ReadCacheFillRequest : public SplitRequest, public SplitCallbacks {
+public:
+  ReadCacheFillRequest(SplitCallbacks& callbacks, ThreadLocalReadCache& cache, std::string key,
+                       TimeSource& time_source)
+      : callbacks_(callbacks), cache_(cache), key_(std::move(key)), time_source_(time_source),
+        epoch_(cache.epoch()) {}
+
+  // SplitCallbacks
+  bool connectionAllowed() override { return callbacks_.connectionAllowed(); }
+  void onQuit() override { callbacks_.onQuit(); }
+  void onAuth(const std::string& password) override { callbacks_.onAuth(password); }
+  void onAuth(const std::string& username, const std::string& password) override {
+    callbacks_.onAuth(username, password);
+  }
+  void onResponse(Common::Redis::RespValuePtr&& response) override;
+  Common::Redis::Client::Transaction& transaction() override { return callbacks_.transaction(); }
+
+  // RedisProxy::CommandSplitter::SplitRequest
+  void cancel() override { wrapped_request_ptr_->cancel(); }
+
+  SplitRequestPtr wrapped_request_ptr_;
+
+private:
+  SplitCallbacks& callbacks_;
+  ThreadLocalReadCache& cache_;
+  const std::string key_;
+  TimeSource& time_source_;
+  const uint64_t epoch_;
+};
+
 /**
  * SimpleRequest hashes the first argument as the key.
  */
@@ -384,7 +418,7 @@ class InstanceImpl : public Instance, Logger::Loggable<Logger::Id::redis> {
 public:
   InstanceImpl(RouterPtr&& router, Stats::Scope& scope, const std::string& stat_prefix,
                TimeSource& time_source, bool latency_in_micros,
-               Common::Redis::FaultManagerPtr&& fault_manager);
+               Common::Redis::FaultManagerPtr&& fault_manager, ReadCacheSharedPtr read_cache);
 
   // RedisProxy::CommandSplitter::Instance
   SplitRequestPtr makeRequest(Common::Redis::RespValuePtr&& request, SplitCallbacks& callbacks,
@@ -404,6 +438,9 @@ private:
   void addHandler(Stats::Scope& scope, const std::string& stat_prefix, const std::string& name,
                   bool latency_in_micros, CommandHandler& handler);
   void onInvalidRequest(SplitCallbacks& callbacks);
+  SplitRequestPtr makeCachedGetRequest(Common::Redis::RespValuePtr&& request,
+                                       SplitCallbacks& callbacks, HandlerData& handler,
+                                       const StreamInfo::StreamInfo& stream_info);
 
   RouterPtr router_;
   CommandHandlerFactory<SimpleRequest> simple_command_handler_;
@@ -417,6 +454,7 @@ private:
   InstanceStats stats_;
   TimeSource& time_source_;
   Common::Redis::FaultManagerPtr fault_manager_;
+  const ReadCacheSharedPtr read_cache_;
 };
 
 } // namespace CommandSplitter
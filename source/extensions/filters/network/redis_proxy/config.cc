@@ -10,6 +10,7 @@
 #include "source/extensions/filters/network/common/redis/fault_impl.h"
 #include "source/extensions/filters/network/redis_proxy/command_splitter_impl.h"
 #include "source/extensions/filters/network/redis_proxy/proxy_filter.h"
+#include "source/extensions/filters/network/redis_proxy/read_cache.h"
 #include "source/extensions/filters/network/redis_proxy/router_impl.h"
 
 #include "absl/container/flat_hash_set.h"
@@ -91,10 +92,18 @@ Network::FilterFactoryCb RedisProxyFilterConfigFactory::createFilterFactoryFromP
   auto fault_manager = std::make_unique<Common::Redis::FaultManagerImpl>(
       server_context.api().randomGenerator(), server_context.runtime(), proto_config.faults());
 
+  ReadCacheSharedPtr read_cache;
+  if (proto_config.has_read_cache()) {
+    read_cache =
+        std::make_shared<ReadCache>(proto_config.read_cache(), server_context.threadLocal(),
+                                    context.scope(), filter_config->stat_prefix_);
+  }
+
   std::shared_ptr<CommandSplitter::Instance> splitter =
       std::make_shared<CommandSplitter::InstanceImpl>(
           std::move(router), context.scope(), filter_config->stat_prefix_,
-          server_context.timeSource(), proto_config.latency_in_micros(), std::move(fault_manager));
+          server_context.timeSource(), proto_config.latency_in_micros(), std::move(fault_manager),
+          std::move(read_cache));
 
   auto has_external_auth_provider_ = proto_config.has_external_auth_provider();
   auto grpc_service = proto_config.external_auth_provider().grpc_service();
@@ -0,0 +1,124 @@
+#include "source/extensions/filters/network/redis_proxy/read_cache.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/match.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+
+namespace {
+constexpr uint64_t DefaultMaxBytesPerWorker = 16 * 1024 * 1024;
+} // namespace
+
+ThreadLocalReadCache::~ThreadLocalReadCache() {
+  // The gauges accumulate the caches of all the workers, and outlive this cache when the filter is
+  // updated.
+  stats_.bytes_.sub(bytes_);
+  stats_.entries_.sub(entries_.size());
+}
+
+Common::Redis::RespValuePtr ThreadLocalReadCache::lookup(const std::string& key,
+                                                         MonotonicTime now) {
+  const auto it = index_.find(key);
+  if (it == index_.end()) {
+    stats_.miss_.inc();
+    return nullptr;
+  }
+  if (it->second->expiry_ <= now) {
+    erase(it->second);
+    stats_.miss_.inc();
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  stats_.hit_.inc();
+  return std::make_unique<Common::Redis::RespValue>(entries_.front().value_);
+}
+
+void ThreadLocalReadCache::insert(const std::string& key, const Common::Redis::RespValue& value,
+                                  MonotonicTime now, uint64_t epoch) {
+  ASSERT(value.type() == Common::Redis::RespType::BulkString ||
+         value.type() == Common::Redis::RespType::Null);
+  // A command which may have changed the value was forwarded after the response was requested.
+  if (epoch != epoch_) {
+    return;
+  }
+  if (const auto it = index_.find(key); it != index_.end()) {
+    erase(it->second);
+  }
+  const uint64_t bytes =
+      key.size() +
+      (value.type() == Common::Redis::RespType::BulkString ? value.asString().size() : 0);
+  if (bytes > max_bytes_) {
+    return;
+  }
+  while (bytes_ + bytes > max_bytes_) {
+    erase(std::prev(entries_.end()));
+    stats_.eviction_.inc();
+  }
+
+  entries_.push_front(Entry{key, value, now + ttl_, bytes});
+  index_.emplace(entries_.front().key_, entries_.begin());
+  bytes_ += bytes;
+  stats_.bytes_.add(bytes);
+  stats_.entries_.inc();
+  stats_.insert_.inc();
+}
+
+void ThreadLocalReadCache::invalidate(const std::string& key) {
+  epoch_++;
+  if (const auto it = index_.find(key); it != index_.end()) {
+    erase(it->second);
+    stats_.invalidation_.inc();
+  }
+}
+
+void ThreadLocalReadCache::erase(EntryList::iterator entry) {
+  bytes_ -= entry->bytes_;
+  stats_.bytes_.sub(entry->bytes_);
+  stats_.entries_.dec();
+  index_.erase(entry->key_);
+  entries_.erase(entry);
+}
+
+ReadCache::ReadCache(
+    const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::ReadCache& config,
+    ThreadLocal::SlotAllocator& tls, Stats::Scope& scope, const std::string& stat_prefix)
+    : key_prefixes_(config.key_prefixes().begin(), config.key_prefixes().end()),
+      stats_({ALL_REDIS_READ_CACHE_STATS(POOL_COUNTER_PREFIX(scope, stat_prefix + "read_cache."),
+                                         POOL_GAUGE_PREFIX(scope, stat_prefix + "read_cache."))}),
+      tls_(ThreadLocal::TypedSlot<ThreadLocalReadCache>::makeUnique(tls)) {
+  const uint64_t max_bytes =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_bytes_per_worker, DefaultMaxBytesPerWorker);
+  const std::chrono::milliseconds ttl(PROTOBUF_GET_MS_REQUIRED(config, ttl));
+  tls_->set([max_bytes, ttl, stats = stats_, scope = scope.getShared()](Event::Dispatcher&) {
+    return std::make_shared<ThreadLocalReadCache>(max_bytes, ttl, stats, scope);
+  });
+}
+
+bool ReadCache::cacheable(absl::string_view key) const {
+  for (const std::string& prefix : key_prefixes_) {
+    if (absl::StartsWith(key, prefix)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ReadCache::invalidate(const Common::Redis::RespValue& request) {
+  const std::vector<Common::Redis::RespValue>& arguments = request.asArray();
+  // Values which happen to look like keys are forgotten too, which is harmless.
+  for (uint64_t i = 1; i < arguments.size(); i++) {
+    if (cacheable(arguments[i].asString())) {
+      local().invalidate(arguments[i].asString());
+    }
+  }
+}
+
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
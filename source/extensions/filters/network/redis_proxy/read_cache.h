@@ -0,0 +1,142 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/filters/network/redis_proxy/v3/redis_proxy.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/extensions/filters/network/common/redis/codec.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+
+/**
+ * All read cache stats. @see stats_macros.h
+ */
+#define ALL_REDIS_READ_CACHE_STATS(COUNTER, GAUGE)                                                 \
+  COUNTER(eviction)                                                                                \
+  COUNTER(hit)                                                                                     \
+  COUNTER(insert)                                                                                  \
+  COUNTER(invalidation)                                                                            \
+  COUNTER(miss)                                                                                    \
+  GAUGE(bytes, Accumulate)                                                                         \
+  GAUGE(entries, Accumulate)
+
+/**
+ * Struct definition for all read cache stats. @see stats_macros.h
+ */
+struct ReadCacheStats {
+  ALL_REDIS_READ_CACHE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+/**
+ * The GET responses cached by a worker, evicted in least recently used order.
+ */
+class ThreadLocalReadCache : public ThreadLocal::ThreadLocalObject {
+public:
+  ThreadLocalReadCache(uint64_t max_bytes, std::chrono::milliseconds ttl, ReadCacheStats stats,
+                       Stats::ScopeSharedPtr scope)
+      : max_bytes_(max_bytes), ttl_(ttl), scope_(std::move(scope)), stats_(stats) {}
+  ~ThreadLocalReadCache() override;
+
+  /**
+   * @return a copy of the cached response for the key, or nullptr if there is none or it has
+   *         expired.
+   */
+  Common::Redis::RespValuePtr lookup(const std::string& key, MonotonicTime now);
+
+  /**
+   * Caches the response for the key, unless a key was invalidated since the epoch at which the
+   * response was requested.
+   */
+  void insert(const std::string& key, const Common::Redis::RespValue& value, MonotonicTime now,
+              uint64_t epoch);
+
+  /**
+   * Forgets the response for the key, if any.
+   */
+  void invalidate(const std::string& key);
+
+  /**
+   * @return the number of invalidations so far, with which responses requested now must be
+   *         inserted.
+   */
+  uint64_t epoch() const { return epoch_; }
+
+private:
+  struct Entry {
+    std::string key_;
+    Common::Redis::RespValue value_;
+    MonotonicTime expiry_;
+    uint64_t bytes_;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  void erase(EntryList::iterator entry);
+
+  const uint64_t max_bytes_;
+  const std::chrono::milliseconds ttl_;
+  // Keeps the stats alive until the cache is destroyed on its worker, which may happen after the
+  // filter is gone.
+  const Stats::ScopeSharedPtr scope_;
+  ReadCacheStats stats_;
+  // The most recently used entries first.
+  EntryList entries_;
+  // Keyed by views of the keys of the entries.
+  absl::flat_hash_map<absl::string_view, EntryList::iterator> index_;
+  uint64_t bytes_{};
+  uint64_t epoch_{};
+};
+
+/**
+ * The read cache configuration of a proxy filter, and the caches of the workers.
+ */
+class ReadCache {
+public:
+  ReadCache(
+      const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::ReadCache& config,
+      ThreadLocal::SlotAllocator& tls, Stats::Scope& scope, const std::string& stat_prefix);
+
+  /**
+   * @return whether the responses for the key are cached.
+   */
+  bool cacheable(absl::string_view key) const;
+
+  /**
+   * Forgets the cached responses for the keys named by the arguments of a request, which may
+   * modify them.
+   */
+  void invalidate(const Common::Redis::RespValue& request);
+
+  /**
+   * @return the cache of the calling worker.
+   */
+  ThreadLocalReadCache& local() { return *tls_; }
+
+private:
+  const std::vector<std::string> key_prefixes_;
+  ReadCacheStats stats_;
+  ThreadLocal::TypedSlotPtr<ThreadLocalReadCache> tls_;
+};
+
+using ReadCacheSharedPtr = std::shared_ptr<ReadCache>;
+
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
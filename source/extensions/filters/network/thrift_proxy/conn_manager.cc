@@ -212,7 +212,9 @@ DecoderEventHandler& ConnectionManager::newDecoderEventHandler() {
 }
 
 bool ConnectionManager::ResponseDecoder::passthroughEnabled() const {
-  return parent_.parent_.passthroughEnabled();
+  // The response belongs to this rpc, which is not the latest one when requests are pipelined, and
+  // only this rpc's upstream transport and protocol tell whether its payload can be passed through.
+  return parent_.parent_.config_->payloadPassthrough() && parent_.passthroughSupported();
 }
 
 bool ConnectionManager::passthroughEnabled() const {
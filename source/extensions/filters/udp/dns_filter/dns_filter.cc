@@ -16,6 +16,7 @@ namespace DnsFilter {
 
 static constexpr std::chrono::milliseconds DEFAULT_RESOLVER_TIMEOUT{500};
 static constexpr std::chrono::seconds DEFAULT_RESOLVER_TTL{300};
+static constexpr uint32_t DEFAULT_MAX_CACHED_ANSWERS = 1024;
 
 DnsFilterEnvoyConfig::DnsFilterEnvoyConfig(
     Server::Configuration::ListenerFactoryContext& context,
@@ -174,6 +175,10 @@ DnsFilterEnvoyConfig::DnsFilterEnvoyConfig(
     resolver_timeout_ = std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
         client_config, resolver_timeout, DEFAULT_RESOLVER_TIMEOUT.count()));
     max_pending_lookups_ = client_config.max_pending_lookups();
+    answer_cache_ttl_ =
+        std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(client_config, answer_cache_ttl, 0));
+    max_cached_answers_ = PROTOBUF_GET_WRAPPED_OR_DEFAULT(client_config, max_cached_answers,
+                                                          DEFAULT_MAX_CACHED_ANSWERS);
   } else {
     // In case client_config doesn't exist, create default DNS resolver factory and save it.
     dns_resolver_factory_ = &Network::createDefaultDnsResolverFactory(typed_dns_resolver_config_);
@@ -244,6 +249,11 @@ DnsFilter::DnsFilter(Network::UdpReadFilterCallbacks& callbacks,
     }
 
     config_->stats().externally_resolved_queries_.inc();
+    // Only the answers of the resolvers are cached, not the failures and the timeouts.
+    if (context->in_callback_ &&
+        context->resolution_status_ == Network::DnsResolver::ResolutionStatus::Completed) {
+      cacheAnswer(*query, iplist);
+    }
     if (iplist.empty()) {
       config_->stats().unanswered_queries_.inc();
     }
@@ -337,6 +347,9 @@ DnsLookupResponseCode DnsFilter::getResponseForQuery(DnsQueryContextPtr& context
     // Forwarding queries is enabled if the configuration contains a client configuration
     // for the dns_filter.
     if (forward_queries) {
+      if (resolveViaAnswerCache(context, *query)) {
+        continue;
+      }
       ENVOY_LOG(debug, "resolving name [{}] via external resolvers", query->name_);
       resolver_->resolveExternalQuery(std::move(context), query.get());
 
@@ -351,6 +364,39 @@ DnsLookupResponseCode DnsFilter::getResponseForQuery(DnsQueryContextPtr& context
   return DnsLookupResponseCode::Success;
 }
 
+bool DnsFilter::resolveViaAnswerCache(DnsQueryContextPtr& context, const DnsQueryRecord& query) {
+  if (config_->answerCacheTtl().count() == 0) {
+    return false;
+  }
+  const auto it = answer_cache_.find(std::make_pair(query.name_, query.type_));
+  if (it == answer_cache_.end() ||
+      it->second.expiry_ <= listener_.dispatcher().timeSource().monotonicTime()) {
+    config_->stats().answer_cache_misses_.inc();
+    return false;
+  }
+
+  ENVOY_LOG(debug, "resolving name [{}] from cached external answers", query.name_);
+  config_->stats().answer_cache_hits_.inc();
+  const std::chrono::seconds ttl = getDomainTTL(query.name_);
+  for (const auto& address : it->second.addresses_) {
+    message_parser_.storeDnsAnswerRecord(context, query, ttl, address);
+  }
+  return true;
+}
+
+void DnsFilter::cacheAnswer(const DnsQueryRecord& query, const AddressConstPtrVec& addresses) {
+  if (config_->answerCacheTtl().count() == 0) {
+    return;
+  }
+  auto key = std::make_pair(query.name_, query.type_);
+  if (!answer_cache_.contains(key) && answer_cache_.size() >= config_->maxCachedAnswers()) {
+    answer_cache_.erase(answer_cache_.begin());
+  }
+  const MonotonicTime expiry =
+      listener_.dispatcher().timeSource().monotonicTime() + config_->answerCacheTtl();
+  answer_cache_.insert_or_assign(std::move(key), CachedAnswer{addresses, expiry});
+}
+
 bool DnsFilter::resolveViaConfiguredHosts(DnsQueryContextPtr& context,
                                           const DnsQueryRecord& query) {
   switch (query.type_) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "envoy/common/time.h"
 #include "envoy/event/file_event.h"
 #include "envoy/extensions/filters/udp/dns_filter/v3/dns_filter.pb.h"
 #include "envoy/network/dns.h"
@@ -12,6 +13,7 @@
 #include "source/extensions/filters/udp/dns_filter/dns_filter_resolver.h"
 #include "source/extensions/filters/udp/dns_filter/dns_parser.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 
 namespace Envoy {
@@ -25,7 +27,8 @@ namespace DnsFilter {
 #define ALL_DNS_FILTER_STATS(COUNTER, HISTOGRAM)                                                   \
   COUNTER(a_record_queries)                                                                        \
   COUNTER(aaaa_record_queries)                                                                     \
-  COUNTER(srv_record_queries)                                                                      \
+  COUNTER(answer_cache_hits)                                                                       \
+  COUNTER(answer_cache_misses)                                                                     \
   COUNTER(cluster_a_record_answers)                                                                \
   COUNTER(cluster_aaaa_record_answers)                                                             \
   COUNTER(cluster_srv_record_answers)                                                              \
@@ -33,8 +36,9 @@ namespace DnsFilter {
   COUNTER(downstream_rx_errors)                                                                    \
   COUNTER(downstream_rx_invalid_queries)                                                           \
   COUNTER(downstream_rx_queries)                                                                   \
-  COUNTER(external_a_record_queries)                                                               \
+  COUNTER(downstream_tx_responses)                                                                 \
   COUNTER(external_a_record_answers)                                                               \
+  COUNTER(external_a_record_queries)                                                               \
   COUNTER(external_aaaa_record_answers)                                                            \
   COUNTER(external_aaaa_record_queries)                                                            \
   COUNTER(external_unsupported_answers)                                                            \
@@ -45,14 +49,14 @@ namespace DnsFilter {
   COUNTER(local_aaaa_record_answers)                                                               \
   COUNTER(local_srv_record_answers)                                                                \
   COUNTER(local_unsupported_answers)                                                               \
-  COUNTER(unanswered_queries)                                                                      \
-  COUNTER(unsupported_queries)                                                                     \
-  COUNTER(downstream_tx_responses)                                                                 \
-  COUNTER(query_buffer_underflow)                                                                  \
-  COUNTER(query_parsing_failure)                                                                   \
   COUNTER(queries_with_additional_rrs)                                                             \
   COUNTER(queries_with_ans_or_authority_rrs)                                                       \
+  COUNTER(query_buffer_underflow)                                                                  \
+  COUNTER(query_parsing_failure)                                                                   \
   COUNTER(record_name_overflow)                                                                    \
+  COUNTER(srv_record_queries)                                                                      \
+  COUNTER(unanswered_queries)                                                                      \
+  COUNTER(unsupported_queries)                                                                     \
   HISTOGRAM(downstream_rx_bytes, Bytes)                                                            \
   HISTOGRAM(downstream_rx_query_latency, Milliseconds)                                             \
   HISTOGRAM(downstream_tx_bytes, Bytes)
@@ -92,6 +96,8 @@ public:
   uint64_t retryCount() const { return retry_count_; }
   Random::RandomGenerator& random() const { return random_; }
   uint64_t maxPendingLookups() const { return max_pending_lookups_; }
+  std::chrono::milliseconds answerCacheTtl() const { return answer_cache_ttl_; }
+  uint32_t maxCachedAnswers() const { return max_cached_answers_; }
   const envoy::config::core::v3::TypedExtensionConfig& typedDnsResolverConfig() const {
     return typed_dns_resolver_config_;
   }
@@ -130,6 +136,9 @@ private:
   std::chrono::milliseconds resolver_timeout_;
   Random::RandomGenerator& random_;
   uint64_t max_pending_lookups_;
+  // Zero if external answers are not cached.
+  std::chrono::milliseconds answer_cache_ttl_{};
+  uint32_t max_cached_answers_{};
   envoy::config::core::v3::TypedExtensionConfig typed_dns_resolver_config_;
   Network::DnsResolverFactory* dns_resolver_factory_;
 };
@@ -351,6 +360,22 @@ private:
     }
   }
 
+  /**
+   * @brief Answers the query from the answers of the external resolvers cached by this worker
+   *
+   * @param context object containing the query context
+   * @param query query object containing the name to be resolved
+   * @return bool true if an unexpired answer, possibly without any address, was cached for the
+   * query
+   */
+  bool resolveViaAnswerCache(DnsQueryContextPtr& context, const DnsQueryRecord& query);
+
+  /**
+   * @brief Caches the answer of the external resolvers for the query, evicting an arbitrary entry
+   * if the cache is full
+   */
+  void cacheAnswer(const DnsQueryRecord& query, const AddressConstPtrVec& addresses);
+
   /**
    * @brief Helper function to retrieve the Endpoint configuration for a requested domain
    */
@@ -379,6 +404,13 @@ private:
   Network::Address::InstanceConstSharedPtr local_;
   Network::Address::InstanceConstSharedPtr peer_;
   DnsFilterResolverCallback resolver_callback_;
+
+  struct CachedAnswer {
+    AddressConstPtrVec addresses_;
+    MonotonicTime expiry_;
+  };
+  // The answers of the external resolvers, keyed by the name and the type of the query.
+  absl::flat_hash_map<std::pair<std::string, uint16_t>, CachedAnswer> answer_cache_;
 };
 
 } // namespace DnsFilter
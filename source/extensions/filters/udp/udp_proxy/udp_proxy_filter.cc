@@ -323,7 +323,9 @@ UdpProxyFilter::ActiveSession::ActiveSession(UdpProxyFilter& filter,
     : filter_(filter), addresses_(std::move(addresses)), host_(host),
       session_id_(next_global_session_id_++),
       idle_timer_(filter_.read_callbacks_->udpListener().dispatcher().createTimer(
-          [this] { onIdleTimer(); })),
+          [this] { onIdleTimerFired(); })),
+      lazy_idle_timer_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.udp_proxy_lazy_idle_timer")),
       udp_session_info_(StreamInfo::StreamInfoImpl(filter_.config_->timeSource(),
                                                    createDownstreamConnectionInfoProvider(),
                                                    StreamInfo::FilterState::LifeSpan::Connection)) {
@@ -725,9 +727,28 @@ void UdpProxyFilter::ActiveSession::resetIdleTimer() {
     return;
   }
 
+  if (lazy_idle_timer_) {
+    last_activity_ = filter_.config_->timeSource().monotonicTime();
+    if (idle_timer_->enabled()) {
+      return;
+    }
+  }
   idle_timer_->enableTimer(filter_.config_->sessionTimeout());
 }
 
+void UdpProxyFilter::ActiveSession::onIdleTimerFired() {
+  if (lazy_idle_timer_) {
+    const std::chrono::nanoseconds idle =
+        filter_.config_->timeSource().monotonicTime() - last_activity_;
+    if (idle < filter_.config_->sessionTimeout()) {
+      idle_timer_->enableTimer(
+          std::chrono::ceil<std::chrono::milliseconds>(filter_.config_->sessionTimeout() - idle));
+      return;
+    }
+  }
+  onIdleTimer();
+}
+
 void UdpProxyFilter::ActiveSession::processUpstreamDatagram(Network::UdpRecvData& recv_data) {
   for (auto& active_write_filter : write_filters_) {
     auto status = active_write_filter->write_filter_->onWrite(recv_data);
@@ -657,6 +657,11 @@ protected:
     // idle timeouts work so we should consider unifying the implementation if we move to a time
     // stamp and scan approach.
     const Event::TimerPtr idle_timer_;
+    // With the udp_proxy_lazy_idle_timer runtime guard, the idle timer is not re-enabled for each
+    // datagram. The time of the last datagram is recorded instead, and the timer is enabled again
+    // for the rest of the timeout when it fires after it.
+    const bool lazy_idle_timer_;
+    MonotonicTime last_activity_;
     Event::TimerPtr access_log_flush_timer_;
 
     UdpProxySessionStats session_stats_{};
@@ -666,6 +671,7 @@ protected:
 
   private:
     std::shared_ptr<Network::ConnectionInfoSetterImpl> createDownstreamConnectionInfoProvider();
+    void onIdleTimerFired();
     void onAccessLogFlushInterval();
     void rearmAccessLogFlushTimer();
     void disableAccessLogFlushTimer();
@@ -705,6 +711,8 @@ protected:
       }
     }
 
+    void onDatagramsRead(uint32_t) override {}
+
     size_t numPacketsExpectedPerEventLoop() const final {
       // TODO(mattklein123) change this to a reasonable number if needed.
       return Network::MAX_NUM_PACKETS_PER_EVENT_LOOP;
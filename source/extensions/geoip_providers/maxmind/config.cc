@@ -37,7 +37,8 @@ public:
           std::make_shared<GeoipProviderConfig>(proto_config, stat_prefix, context.scope());
       driver = std::make_shared<GeoipProvider>(
           context.serverFactoryContext().mainThreadDispatcher(),
-          context.serverFactoryContext().api(), singleton, provider_config);
+          context.serverFactoryContext().api(), context.serverFactoryContext().threadLocal(),
+          singleton, provider_config);
       drivers_[key] = driver;
     }
     return driver;
@@ -2,6 +2,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/protobuf/protobuf.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
@@ -32,8 +33,10 @@ GeoipProviderConfig::GeoipProviderConfig(
                                                  : absl::nullopt),
       anon_db_path_(!config.anon_db_path().empty() ? absl::make_optional(config.anon_db_path())
                                                    : absl::nullopt),
+      lookup_cache_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, lookup_cache_size, 0)),
       stats_scope_(scope.createScope(absl::StrCat(stat_prefix, "maxmind."))),
-      stat_name_set_(stats_scope_->symbolTable().makeSet("Maxmind")) {
+      stat_name_set_(stats_scope_->symbolTable().makeSet("Maxmind")),
+      lookup_cache_hit_(stat_name_set_->add("lookup_cache_hit")) {
   auto geo_headers_to_add = config.common_provider_config().geo_headers_to_add();
   country_header_ = !geo_headers_to_add.country().empty()
                         ? absl::make_optional(geo_headers_to_add.country())
@@ -92,9 +95,15 @@ void GeoipProviderConfig::incCounter(Stats::StatName name) {
 }
 
 GeoipProvider::GeoipProvider(Event::Dispatcher& dispatcher, Api::Api& api,
-                             Singleton::InstanceSharedPtr owner,
+                             ThreadLocal::SlotAllocator& tls, Singleton::InstanceSharedPtr owner,
                              GeoipProviderConfigSharedPtr config)
     : config_(config), owner_(owner) {
+  if (config_->lookupCacheSize() > 0) {
+    lookup_cache_ = ThreadLocal::TypedSlot<LookupCache>::makeUnique(tls);
+    lookup_cache_->set([max_size = config_->lookupCacheSize()](Event::Dispatcher&) {
+      return std::make_shared<LookupCache>(max_size);
+    });
+  }
   city_db_ =
       config_->cityDbPath() ? initMaxmindDb(config_->cityDbPath().value(), CITY_DB_TYPE) : nullptr;
   isp_db_ =
@@ -148,11 +157,67 @@ GeoipProvider::~GeoipProvider() {
 void GeoipProvider::lookup(Geolocation::LookupRequest&& request,
                            Geolocation::LookupGeoHeadersCallback&& cb) const {
   auto& remote_address = request.remoteAddress();
-  auto lookup_result = absl::flat_hash_map<std::string, std::string>{};
-  lookupInCityDb(remote_address, lookup_result);
-  lookupInAsnDb(remote_address, lookup_result);
-  lookupInAnonDb(remote_address, lookup_result);
-  cb(std::move(lookup_result));
+  const Network::Address::Ip* ip = remote_address->ip();
+  if (lookup_cache_ == nullptr || ip == nullptr) {
+    auto lookup_result = absl::flat_hash_map<std::string, std::string>{};
+    lookupInCityDb(remote_address, lookup_result);
+    lookupInAsnDb(remote_address, lookup_result);
+    lookupInAnonDb(remote_address, lookup_result);
+    cb(std::move(lookup_result));
+    return;
+  }
+
+  const LookupCacheKey key =
+      ip->version() == Network::Address::IpVersion::v4
+          ? LookupCacheKey(ip->ipv4()->address(), false)
+          : LookupCacheKey(ip->ipv6()->address(), true);
+  // Read before the lookup, so that a result from a database that is replaced meanwhile is
+  // cached for the old databases only.
+  const uint64_t db_generation = db_generation_.load(std::memory_order_acquire);
+  LookupCache& cache = **lookup_cache_;
+  LookupResultConstSharedPtr cached = cache.find(key, db_generation);
+  if (cached != nullptr) {
+    config_->incLookupCacheHit();
+    cb(std::move(*cached));
+    return;
+  }
+  auto lookup_result = std::make_shared<absl::flat_hash_map<std::string, std::string>>();
+  lookupInCityDb(remote_address, *lookup_result);
+  lookupInAsnDb(remote_address, *lookup_result);
+  lookupInAnonDb(remote_address, *lookup_result);
+  cached = lookup_result;
+  cache.insert(key, cached, db_generation);
+  cb(std::move(*cached));
+}
+
+GeoipProvider::LookupResultConstSharedPtr
+GeoipProvider::LookupCache::find(const LookupCacheKey& key, uint64_t db_generation) {
+  if (db_generation != db_generation_) {
+    entries_.clear();
+    index_.clear();
+    db_generation_ = db_generation;
+    return nullptr;
+  }
+  const auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->second;
+}
+
+void GeoipProvider::LookupCache::insert(const LookupCacheKey& key,
+                                        LookupResultConstSharedPtr result,
+                                        uint64_t db_generation) {
+  if (db_generation != db_generation_) {
+    return;
+  }
+  if (entries_.size() >= max_size_) {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+  entries_.emplace_front(key, std::move(result));
+  index_[key] = entries_.begin();
 }
 
 void GeoipProvider::lookupInCityDb(
@@ -330,6 +395,8 @@ absl::Status GeoipProvider::mmdbReload(const MaxmindDbSharedPtr reloaded_db,
       ENVOY_LOG(error, "Unsupported maxmind db type {}", db_type);
       return absl::InvalidArgumentError(fmt::format("Unsupported maxmind db type {}", db_type));
     }
+    // The workers clear their lookup caches on their next lookup.
+    db_generation_.fetch_add(1, std::memory_order_release);
   } else {
     config_->incDbReloadError(db_type);
   }
@@ -1,12 +1,19 @@
 #pragma once
 
+#include <atomic>
+#include <list>
+
 #include "envoy/common/platform.h"
 #include "envoy/extensions/geoip_providers/maxmind/v3/maxmind.pb.h"
 #include "envoy/geoip/geoip_provider_driver.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "source/common/common/logger.h"
 #include "source/common/common/thread_synchronizer.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/numeric/int128.h"
+
 #include "maxminddb.h"
 
 namespace Envoy {
@@ -36,6 +43,8 @@ public:
   const absl::optional<std::string>& anonTorHeader() const { return anon_tor_header_; }
   const absl::optional<std::string>& anonProxyHeader() const { return anon_proxy_header_; }
 
+  uint32_t lookupCacheSize() const { return lookup_cache_size_; }
+
   void incLookupError(absl::string_view maxmind_db_type) {
     incCounter(
         stat_name_set_->getBuiltin(absl::StrCat(maxmind_db_type, ".lookup_error"), unknown_hit_));
@@ -59,6 +68,8 @@ public:
                                           unknown_hit_));
   }
 
+  void incLookupCacheHit() { incCounter(lookup_cache_hit_); }
+
   void registerGeoDbStats(const absl::string_view& db_type);
 
   Stats::Scope& getStatsScopeForTest() const { return *stats_scope_; }
@@ -79,9 +90,12 @@ private:
   absl::optional<std::string> anon_tor_header_;
   absl::optional<std::string> anon_proxy_header_;
 
+  const uint32_t lookup_cache_size_;
+
   Stats::ScopeSharedPtr stats_scope_;
   Stats::StatNameSetPtr stat_name_set_;
   const Stats::StatName unknown_hit_;
+  const Stats::StatName lookup_cache_hit_;
   void incCounter(Stats::StatName name);
 };
 
@@ -104,8 +118,8 @@ class GeoipProvider : public Envoy::Geolocation::Driver,
                       public Logger::Loggable<Logger::Id::geolocation> {
 
 public:
-  GeoipProvider(Event::Dispatcher& dispatcher, Api::Api& api, Singleton::InstanceSharedPtr owner,
-                GeoipProviderConfigSharedPtr config);
+  GeoipProvider(Event::Dispatcher& dispatcher, Api::Api& api, ThreadLocal::SlotAllocator& tls,
+                Singleton::InstanceSharedPtr owner, GeoipProviderConfigSharedPtr config);
 
   ~GeoipProvider() override;
 
@@ -113,6 +127,31 @@ public:
   void lookup(Geolocation::LookupRequest&&, Geolocation::LookupGeoHeadersCallback&&) const override;
 
 private:
+  using LookupResultConstSharedPtr =
+      std::shared_ptr<const absl::flat_hash_map<std::string, std::string>>;
+  // The IP address, and whether it is an IPv6 address.
+  using LookupCacheKey = std::pair<absl::uint128, bool>;
+
+  // The lookup results of the most recently seen client addresses of one worker.
+  class LookupCache : public ThreadLocal::ThreadLocalObject {
+  public:
+    explicit LookupCache(uint32_t max_size) : max_size_(max_size) {}
+
+    // Returns the cached result for `key`, if it was cached for the current databases.
+    LookupResultConstSharedPtr find(const LookupCacheKey& key, uint64_t db_generation);
+    void insert(const LookupCacheKey& key, LookupResultConstSharedPtr result,
+                uint64_t db_generation);
+
+  private:
+    using Entry = std::pair<LookupCacheKey, LookupResultConstSharedPtr>;
+
+    const uint32_t max_size_;
+    uint64_t db_generation_{};
+    // Most recently used first.
+    std::list<Entry> entries_;
+    absl::flat_hash_map<LookupCacheKey, std::list<Entry>::iterator> index_;
+  };
+
   // Allow the unit test to have access to private members.
   friend class GeoipProviderPeer;
   GeoipProviderConfigSharedPtr config_;
@@ -123,6 +162,10 @@ private:
   Thread::ThreadPtr mmdb_reload_thread_;
   Event::DispatcherPtr mmdb_reload_dispatcher_;
   Filesystem::WatcherPtr mmdb_watcher_;
+  // Only set if the lookup cache is enabled.
+  ThreadLocal::TypedSlotPtr<LookupCache> lookup_cache_;
+  // Incremented whenever a database is reloaded, which invalidates the cached lookups.
+  std::atomic<uint64_t> db_generation_{0};
   MaxmindDbSharedPtr initMaxmindDb(const std::string& db_path, const absl::string_view& db_type,
                                    bool reload = false);
   void lookupInCityDb(const Network::Address::InstanceConstSharedPtr& remote_address,
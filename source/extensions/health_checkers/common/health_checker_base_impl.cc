@@ -1,16 +1,23 @@
 #include "source/extensions/health_checkers/common/health_checker_base_impl.h"
 
+#include <algorithm>
+
 #include "envoy/config/core/v3/address.pb.h"
 #include "envoy/config/core/v3/health_check.pb.h"
 #include "envoy/data/core/v3/health_check_event.pb.h"
 #include "envoy/stats/scope.h"
 
 #include "source/common/network/utility.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/router/router.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Upstream {
 
+SINGLETON_MANAGER_REGISTRATION(shared_health_check_sessions);
+
 HealthCheckerImplBase::HealthCheckerImplBase(const Cluster& cluster,
                                              const envoy::config::core::v3::HealthCheck& config,
                                              Event::Dispatcher& dispatcher,
@@ -29,6 +36,7 @@ HealthCheckerImplBase::HealthCheckerImplBase(const Cluster& cluster,
       no_traffic_healthy_interval_(PROTOBUF_GET_MS_OR_DEFAULT(config, no_traffic_healthy_interval,
                                                               no_traffic_interval_.count())),
       initial_jitter_(PROTOBUF_GET_MS_OR_DEFAULT(config, initial_jitter, 0)),
+      spread_initial_checks_(config.spread_initial_checks()),
       interval_jitter_(PROTOBUF_GET_MS_OR_DEFAULT(config, interval_jitter, 0)),
       interval_jitter_percent_(config.interval_jitter_percent()),
       unhealthy_interval_(
@@ -39,6 +47,8 @@ HealthCheckerImplBase::HealthCheckerImplBase(const Cluster& cluster,
           PROTOBUF_GET_MS_OR_DEFAULT(config, healthy_edge_interval, interval_.count())),
       transport_socket_options_(initTransportSocketOptions(config)),
       transport_socket_match_metadata_(initTransportSocketMatchMetadata(config)),
+      shared_key_prefix_(config.share_across_clusters() ? absl::StrCat(MessageUtil::hash(config))
+                                                        : ""),
       member_update_cb_{cluster_.prioritySet().addMemberUpdateCb(
           [this](const HostVector& hosts_added, const HostVector& hosts_removed) -> absl::Status {
             onClusterMemberUpdate(hosts_added, hosts_removed);
@@ -72,6 +82,58 @@ MetadataConstSharedPtr HealthCheckerImplBase::initTransportSocketMatchMetadata(
   return nullptr;
 }
 
+void HealthCheckerImplBase::shareSessions(Singleton::Manager& singleton_manager) {
+  if (shared_key_prefix_.empty()) {
+    return;
+  }
+  shared_sessions_ = singleton_manager.getTyped<SharedSessions>(
+      SINGLETON_MANAGER_REGISTERED_NAME(shared_health_check_sessions),
+      [] { return std::make_shared<SharedSessions>(); });
+}
+
+bool HealthCheckerImplBase::SharedSessions::add(const std::string& key,
+                                                ActiveHealthCheckSession& session) {
+  auto& sessions = sessions_[key];
+  sessions.push_back(&session);
+  return sessions.size() == 1;
+}
+
+HealthCheckerImplBase::ActiveHealthCheckSession*
+HealthCheckerImplBase::SharedSessions::remove(const std::string& key,
+                                              ActiveHealthCheckSession& session) {
+  auto it = sessions_.find(key);
+  ASSERT(it != sessions_.end());
+  const bool was_probing = it->second.front() == &session;
+  it->second.remove(&session);
+  if (it->second.empty()) {
+    sessions_.erase(it);
+    return nullptr;
+  }
+  return was_probing ? it->second.front() : nullptr;
+}
+
+bool HealthCheckerImplBase::SharedSessions::probing(const std::string& key,
+                                                    const ActiveHealthCheckSession& session) const {
+  const auto it = sessions_.find(key);
+  return it != sessions_.end() && it->second.front() == &session;
+}
+
+bool HealthCheckerImplBase::SharedSessions::following(
+    const std::string& key, const ActiveHealthCheckSession& session) const {
+  const auto it = sessions_.find(key);
+  return it != sessions_.end() && it->second.front() != &session &&
+         std::find(it->second.begin(), it->second.end(), &session) != it->second.end();
+}
+
+std::vector<HealthCheckerImplBase::ActiveHealthCheckSession*>
+HealthCheckerImplBase::SharedSessions::followers(const std::string& key) const {
+  const auto it = sessions_.find(key);
+  if (it == sessions_.end()) {
+    return {};
+  }
+  return {std::next(it->second.begin()), it->second.end()};
+}
+
 HealthCheckerImplBase::~HealthCheckerImplBase() {
   // First clear callbacks that otherwise will be run from
   // ActiveHealthCheckSession::onDeferredDeleteBase(). This prevents invoking a callback on a
@@ -160,14 +222,20 @@ HealthCheckerImplBase::intervalWithJitter(uint64_t base_time_ms,
 }
 
 void HealthCheckerImplBase::addHosts(const HostVector& hosts) {
-  for (const HostSharedPtr& host : hosts) {
+  // With spread initial checks, the i-th of n hosts is first checked after i/n of the spread.
+  const uint64_t spread_ms =
+      spread_initial_checks_
+          ? (initial_jitter_.count() > 0 ? initial_jitter_.count() : interval_.count())
+          : 0;
+  for (size_t i = 0; i < hosts.size(); ++i) {
+    const HostSharedPtr& host = hosts[i];
     if (host->disableActiveHealthCheck()) {
       continue;
     }
     active_sessions_[host] = makeSession(host);
     host->setHealthChecker(
         HealthCheckHostMonitorPtr{new HealthCheckHostMonitorImpl(shared_from_this(), host)});
-    active_sessions_[host]->start();
+    active_sessions_[host]->start(std::chrono::milliseconds(spread_ms * i / hosts.size()));
   }
 }
 
@@ -259,8 +327,29 @@ HealthCheckerImplBase::ActiveHealthCheckSession::~ActiveHealthCheckSession() {
   ASSERT(interval_timer_ == nullptr && timeout_timer_ == nullptr);
 }
 
+void HealthCheckerImplBase::ActiveHealthCheckSession::start(
+    std::chrono::milliseconds initial_delay) {
+  if (parent_.shared_sessions_ != nullptr) {
+    shared_key_ = absl::StrCat(parent_.shared_key_prefix_, "_",
+                               host_->healthCheckAddress()->asString(), "_",
+                               host_->hostnameForHealthChecks());
+    if (!parent_.shared_sessions_->add(shared_key_, *this)) {
+      // The host is probed by the session of another health checker, follow its results.
+      return;
+    }
+  }
+  onInitialInterval(initial_delay);
+}
+
 void HealthCheckerImplBase::ActiveHealthCheckSession::onDeferredDeleteBase() {
   HealthState state = HealthState::Unhealthy;
+  if (!shared_key_.empty()) {
+    ActiveHealthCheckSession* next = parent_.shared_sessions_->remove(shared_key_, *this);
+    shared_key_.clear();
+    if (next != nullptr) {
+      next->onPromoted();
+    }
+  }
   // The session is about to be deferred deleted. Make sure all timers are gone and any
   // implementation specific state is destroyed.
   interval_timer_.reset();
@@ -281,6 +370,7 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::onDeferredDeleteBase() {
 }
 
 void HealthCheckerImplBase::ActiveHealthCheckSession::handleSuccess(bool degraded) {
+  const bool probing = this->probing();
   // If we are healthy, reset the # of unhealthy to zero.
   num_unhealthy_ = 0;
 
@@ -342,8 +432,12 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::handleSuccess(bool degrade
   first_check_ = false;
   parent_.runCallbacks(host_, changed_state, HealthState::Healthy);
 
+  if (!probing) {
+    return;
+  }
   timeout_timer_->disableTimer();
   interval_timer_->enableTimer(parent_.interval(HealthState::Healthy, changed_state));
+  shareResult([degraded](ActiveHealthCheckSession& session) { session.handleSuccess(degraded); });
 }
 
 namespace {
@@ -404,7 +498,11 @@ HealthTransition HealthCheckerImplBase::ActiveHealthCheckSession::setUnhealthy(
 
 void HealthCheckerImplBase::ActiveHealthCheckSession::handleFailure(
     envoy::data::core::v3::HealthCheckFailureType type, bool retriable) {
+  const bool probing = this->probing();
   HealthTransition changed_state = setUnhealthy(type, retriable);
+  if (!probing) {
+    return;
+  }
   // It's possible that the previous call caused this session to be deferred deleted.
   if (timeout_timer_ != nullptr) {
     timeout_timer_->disableTimer();
@@ -413,6 +511,36 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::handleFailure(
   if (interval_timer_ != nullptr) {
     interval_timer_->enableTimer(parent_.interval(HealthState::Unhealthy, changed_state));
   }
+  shareResult([type, retriable](ActiveHealthCheckSession& session) {
+    session.handleFailure(type, retriable);
+  });
+}
+
+bool HealthCheckerImplBase::ActiveHealthCheckSession::probing() const {
+  return shared_key_.empty() || parent_.shared_sessions_->probing(shared_key_, *this);
+}
+
+void HealthCheckerImplBase::ActiveHealthCheckSession::shareResult(
+    const std::function<void(ActiveHealthCheckSession&)>& handle_result) {
+  // The session may have been removed by the callbacks of its result, in which case the key is
+  // cleared and the result isn't shared. The callbacks of a follower result may remove the
+  // followers after it, or promote one, so each is checked before applying the result.
+  if (shared_key_.empty()) {
+    return;
+  }
+  const SharedSessionsSharedPtr shared_sessions = parent_.shared_sessions_;
+  const std::string key = shared_key_;
+  for (ActiveHealthCheckSession* session : shared_sessions->followers(key)) {
+    if (shared_sessions->following(key, *session)) {
+      handle_result(*session);
+    }
+  }
+}
+
+void HealthCheckerImplBase::ActiveHealthCheckSession::onPromoted() {
+  // Probe soon, the promotion may happen while the health checker of the removed session is
+  // destroyed, so the cluster isn't used to pick the interval.
+  interval_timer_->enableTimer(parent_.intervalWithJitter(0, parent_.initial_jitter_));
 }
 
 HealthTransition
@@ -438,8 +566,15 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::onTimeoutBase() {
   handleFailure(envoy::data::core::v3::NETWORK_TIMEOUT);
 }
 
-void HealthCheckerImplBase::ActiveHealthCheckSession::onInitialInterval() {
-  if (parent_.initial_jitter_.count() == 0) {
+void HealthCheckerImplBase::ActiveHealthCheckSession::onInitialInterval(
+    std::chrono::milliseconds initial_delay) {
+  if (parent_.spread_initial_checks_) {
+    if (initial_delay.count() == 0) {
+      onIntervalBase();
+    } else {
+      interval_timer_->enableTimer(initial_delay);
+    }
+  } else if (parent_.initial_jitter_.count() == 0) {
     onIntervalBase();
   } else {
     interval_timer_->enableTimer(
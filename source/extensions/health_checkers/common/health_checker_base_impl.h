@@ -1,5 +1,10 @@
 #pragma once
 
+#include <functional>
+#include <list>
+#include <string>
+#include <vector>
+
 #include "envoy/access_log/access_log.h"
 #include "envoy/common/callback.h"
 #include "envoy/common/random_generator.h"
@@ -7,6 +12,8 @@
 #include "envoy/data/core/v3/health_check_event.pb.h"
 #include "envoy/event/timer.h"
 #include "envoy/runtime/runtime.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/singleton/manager.h"
 #include "envoy/stats/scope.h"
 #include "envoy/type/matcher/string.pb.h"
 #include "envoy/upstream/health_checker.h"
@@ -15,6 +22,8 @@
 #include "source/common/common/matchers.h"
 #include "source/common/network/transport_socket_options_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -55,6 +64,13 @@ public:
     return transport_socket_match_metadata_;
   }
 
+  /**
+   * Makes the sessions share probes of their hosts with the sessions of other health checkers, if
+   * enabled by the config. Must be called before start().
+   * @param singleton_manager supplies the manager of the process wide session registry.
+   */
+  void shareSessions(Singleton::Manager& singleton_manager);
+
 protected:
   class ActiveHealthCheckSession : public Event::DeferredDeletable {
   public:
@@ -62,7 +78,9 @@ protected:
     HealthTransition setUnhealthy(envoy::data::core::v3::HealthCheckFailureType type,
                                   bool retriable);
     void onDeferredDeleteBase();
-    void start() { onInitialInterval(); }
+    // @param initial_delay supplies the delay of the first health check when the first health
+    //        checks are spread, see spread_initial_checks_.
+    void start(std::chrono::milliseconds initial_delay = std::chrono::milliseconds::zero());
 
   protected:
     ActiveHealthCheckSession(HealthCheckerImplBase& parent, HostSharedPtr host);
@@ -82,7 +100,14 @@ protected:
     virtual void onTimeout() PURE;
     void onTimeoutBase();
     virtual void onDeferredDelete() PURE;
-    void onInitialInterval();
+    void onInitialInterval(std::chrono::milliseconds initial_delay);
+    // Whether the session probes its host, rather than following the results of the session of
+    // another health checker.
+    bool probing() const;
+    // Applies the result of a probe of this session to the sessions following it.
+    void shareResult(const std::function<void(ActiveHealthCheckSession&)>& handle_result);
+    // Starts probing the host when the session probing it is removed.
+    void onPromoted();
 
     HealthCheckerImplBase& parent_;
     Event::TimerPtr interval_timer_;
@@ -91,10 +116,51 @@ protected:
     uint32_t num_healthy_{};
     bool first_check_{true};
     TimeSource& time_source_;
+    // Key of the host in the shared session registry, empty if the session isn't shared.
+    std::string shared_key_;
   };
 
   using ActiveHealthCheckSessionPtr = std::unique_ptr<ActiveHealthCheckSession>;
 
+  /**
+   * Main thread registry of the sessions that share probes, by health check config and host. The
+   * first session added for a key probes the host, the others follow its results. When the
+   * probing session is removed, the next one takes over.
+   */
+  class SharedSessions : public Singleton::Instance {
+  public:
+    /**
+     * @return whether the session probes the host.
+     */
+    bool add(const std::string& key, ActiveHealthCheckSession& session);
+
+    /**
+     * @return the session that takes over probing the host if the removed session probed it, or
+     *         nullptr.
+     */
+    ActiveHealthCheckSession* remove(const std::string& key, ActiveHealthCheckSession& session);
+
+    /**
+     * @return whether the session is the one probing the host.
+     */
+    bool probing(const std::string& key, const ActiveHealthCheckSession& session) const;
+
+    /**
+     * @return whether the session follows the results of another session.
+     */
+    bool following(const std::string& key, const ActiveHealthCheckSession& session) const;
+
+    /**
+     * @return the sessions following the results of the session probing the host.
+     */
+    std::vector<ActiveHealthCheckSession*> followers(const std::string& key) const;
+
+  private:
+    absl::flat_hash_map<std::string, std::list<ActiveHealthCheckSession*>> sessions_;
+  };
+
+  using SharedSessionsSharedPtr = std::shared_ptr<SharedSessions>;
+
   HealthCheckerImplBase(const Cluster& cluster, const envoy::config::core::v3::HealthCheck& config,
                         Event::Dispatcher& dispatcher, Runtime::Loader& runtime,
                         Random::RandomGenerator& random, HealthCheckEventLoggerPtr&& event_logger);
@@ -153,6 +219,7 @@ private:
   const std::chrono::milliseconds no_traffic_interval_;
   const std::chrono::milliseconds no_traffic_healthy_interval_;
   const std::chrono::milliseconds initial_jitter_;
+  const bool spread_initial_checks_;
   const std::chrono::milliseconds interval_jitter_;
   const uint32_t interval_jitter_percent_;
   const std::chrono::milliseconds unhealthy_interval_;
@@ -161,6 +228,9 @@ private:
   absl::node_hash_map<HostSharedPtr, ActiveHealthCheckSessionPtr> active_sessions_;
   const std::shared_ptr<const Network::TransportSocketOptionsImpl> transport_socket_options_;
   const MetadataConstSharedPtr transport_socket_match_metadata_;
+  // Prefix of the shared session keys, empty if sharing isn't enabled by the config.
+  const std::string shared_key_prefix_;
+  SharedSessionsSharedPtr shared_sessions_;
   const Common::CallbackHandlePtr member_update_cb_;
 };
 
@@ -48,8 +48,10 @@ getMethod(const envoy::config::core::v3::RequestMethod config_method) {
 Upstream::HealthCheckerSharedPtr HttpHealthCheckerFactory::createCustomHealthChecker(
     const envoy::config::core::v3::HealthCheck& config,
     Server::Configuration::HealthCheckerFactoryContext& context) {
-  return std::make_shared<ProdHttpHealthCheckerImpl>(context.cluster(), config, context,
-                                                     context.eventLogger());
+  auto health_checker = std::make_shared<ProdHttpHealthCheckerImpl>(context.cluster(), config,
+                                                                    context, context.eventLogger());
+  health_checker->shareSessions(context.serverFactoryContext().singletonManager());
+  return health_checker;
 }
 
 REGISTER_FACTORY(HttpHealthCheckerFactory, Server::Configuration::CustomHealthCheckerFactory);
@@ -6,6 +6,8 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/http/header_map_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -43,9 +45,9 @@ public:
     trailers_ = std::move(entry.trailers_);
     LookupResult result = entry.response_headers_
                               ? request_.makeLookupResult(std::move(entry.response_headers_),
-                                                          std::move(entry.metadata_), body_.size())
+                                                          std::move(entry.metadata_), bodySize())
                               : LookupResult{};
-    bool end_stream = body_.empty() && trailers_ == nullptr;
+    bool end_stream = bodySize() == 0 && trailers_ == nullptr;
     dispatcher_.post([result = std::move(result), cb = std::move(cb), end_stream,
                       cancelled = cancelled_]() mutable {
       if (!*cancelled) {
@@ -55,9 +57,19 @@ public:
   }
 
   void getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) override {
-    ASSERT(range.end() <= body_.length(), "Attempt to read past end of body.");
-    auto result = std::make_unique<Buffer::OwnedImpl>(&body_[range.begin()], range.length());
-    bool end_stream = trailers_ == nullptr && range.end() == body_.length();
+    ASSERT(range.end() <= bodySize(), "Attempt to read past end of body.");
+    // The range is served from the cached body, which the fragment keeps alive, without copying
+    // it.
+    auto result = std::make_unique<Buffer::OwnedImpl>();
+    if (range.length() > 0) {
+      auto fragment = new Buffer::BufferFragmentImpl(
+          body_->data() + range.begin(), range.length(),
+          [body = body_](const void*, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
+            delete this_fragment;
+          });
+      result->addBufferFragment(*fragment);
+    }
+    bool end_stream = trailers_ == nullptr && range.end() == bodySize();
     dispatcher_.post([result = std::move(result), cb = std::move(cb), end_stream,
                       cancelled = cancelled_]() mutable {
       if (!*cancelled) {
@@ -82,11 +94,13 @@ public:
   Event::Dispatcher& dispatcher() const { return dispatcher_; }
 
 private:
+  uint64_t bodySize() const { return body_ ? body_->size() : 0; }
+
   Event::Dispatcher& dispatcher_;
   std::shared_ptr<bool> cancelled_ = std::make_shared<bool>(false);
   SimpleHttpCache& cache_;
   const LookupRequest request_;
-  std::string body_;
+  std::shared_ptr<const std::string> body_;
   Http::ResponseTrailerMapPtr trailers_;
 };
 
@@ -186,27 +200,31 @@ void SimpleHttpCache::updateHeaders(const LookupContext& lookup_context,
       std::move(on_complete)(result);
     });
   };
-  if (iter == map_.end() || !iter->second.response_headers_) {
+  if (iter == map_.end() || !iter->second.entry_.response_headers_) {
     std::move(post_complete)(false);
     return;
   }
-  if (VaryHeaderUtils::hasVary(*iter->second.response_headers_)) {
+  if (VaryHeaderUtils::hasVary(*iter->second.entry_.response_headers_)) {
     absl::optional<Key> varied_key =
-        variedRequestKey(simple_lookup_context.request(), *iter->second.response_headers_);
+        variedRequestKey(simple_lookup_context.request(), *iter->second.entry_.response_headers_);
     if (!varied_key.has_value()) {
       std::move(post_complete)(false);
       return;
     }
     iter = map_.find(varied_key.value());
-    if (iter == map_.end() || !iter->second.response_headers_) {
+    if (iter == map_.end() || !iter->second.entry_.response_headers_) {
       std::move(post_complete)(false);
       return;
     }
   }
-  Entry& entry = iter->second;
-
-  applyHeaderUpdate(response_headers, *entry.response_headers_);
-  entry.metadata_ = metadata;
+  StoredEntry& stored_entry = iter->second;
+
+  applyHeaderUpdate(response_headers, *stored_entry.entry_.response_headers_);
+  stored_entry.entry_.metadata_ = metadata;
+  size_bytes_ -= stored_entry.size_bytes_;
+  stored_entry.size_bytes_ = entrySizeBytes(iter->first, stored_entry.entry_);
+  evict(stored_entry.size_bytes_, &iter->first);
+  size_bytes_ += stored_entry.size_bytes_;
   std::move(post_complete)(true);
 }
 
@@ -216,28 +234,93 @@ SimpleHttpCache::Entry SimpleHttpCache::lookup(const LookupRequest& request) {
   if (iter == map_.end()) {
     return Entry{};
   }
-  ASSERT(iter->second.response_headers_);
+  ASSERT(iter->second.entry_.response_headers_);
 
-  if (VaryHeaderUtils::hasVary(*iter->second.response_headers_)) {
-    return varyLookup(request, iter->second.response_headers_);
+  if (VaryHeaderUtils::hasVary(*iter->second.entry_.response_headers_)) {
+    iter->second.referenced_.store(true, std::memory_order_relaxed);
+    return varyLookup(request, iter->second.entry_.response_headers_);
   } else {
-    Http::ResponseTrailerMapPtr trailers_map;
-    if (iter->second.trailers_) {
-      trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*iter->second.trailers_);
+    return copyEntry(iter->second);
+  }
+}
+
+SimpleHttpCache::Entry SimpleHttpCache::copyEntry(const StoredEntry& stored_entry) {
+  stored_entry.referenced_.store(true, std::memory_order_relaxed);
+  const Entry& entry = stored_entry.entry_;
+  Http::ResponseTrailerMapPtr trailers_map;
+  if (entry.trailers_) {
+    trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*entry.trailers_);
+  }
+  return SimpleHttpCache::Entry{
+      Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*entry.response_headers_),
+      entry.metadata_, entry.body_, std::move(trailers_map)};
+}
+
+uint64_t SimpleHttpCache::entrySizeBytes(const Key& key, const Entry& entry) {
+  return key.ByteSizeLong() + entry.response_headers_->byteSize() +
+         (entry.body_ ? entry.body_->size() : 0) +
+         (entry.trailers_ ? entry.trailers_->byteSize() : 0);
+}
+
+bool SimpleHttpCache::store(const Key& key, Entry&& entry) {
+  const uint64_t size_bytes = entrySizeBytes(key, entry);
+  if (max_size_bytes_ > 0 && size_bytes > max_size_bytes_) {
+    return false;
+  }
+  auto iter = map_.find(key);
+  if (iter != map_.end()) {
+    size_bytes_ -= iter->second.size_bytes_;
+  }
+  // Make room before inserting, so that the new entry is never the one evicted.
+  evict(size_bytes, iter != map_.end() ? &iter->first : nullptr);
+  if (iter == map_.end()) {
+    iter = map_.try_emplace(key).first;
+    eviction_order_.push_back(&iter->first);
+  }
+  StoredEntry& stored_entry = iter->second;
+  stored_entry.entry_ = std::move(entry);
+  stored_entry.size_bytes_ = size_bytes;
+  size_bytes_ += size_bytes;
+  return true;
+}
+
+void SimpleHttpCache::evict(uint64_t incoming_size_bytes, const Key* excluded_key) {
+  if (max_size_bytes_ == 0) {
+    return;
+  }
+  // Each entry is given a second chance if it was looked up since the last pass, so this walks
+  // the eviction order at most twice. The excluded entry isn't counted in size_bytes_, so the
+  // loop also ends once it is the only one left.
+  while (size_bytes_ > 0 && size_bytes_ + incoming_size_bytes > max_size_bytes_) {
+    ASSERT(!eviction_order_.empty());
+    if (eviction_order_.front() == excluded_key) {
+      eviction_order_.splice(eviction_order_.end(), eviction_order_, eviction_order_.begin());
+      continue;
+    }
+    auto iter = map_.find(*eviction_order_.front());
+    ASSERT(iter != map_.end());
+    if (iter->second.referenced_.exchange(false, std::memory_order_relaxed)) {
+      eviction_order_.splice(eviction_order_.end(), eviction_order_, eviction_order_.begin());
+      continue;
     }
-    return SimpleHttpCache::Entry{
-        Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*iter->second.response_headers_),
-        iter->second.metadata_, iter->second.body_, std::move(trailers_map)};
+    size_bytes_ -= iter->second.size_bytes_;
+    eviction_order_.pop_front();
+    map_.erase(iter);
   }
 }
 
+uint64_t SimpleHttpCache::sizeBytes() const {
+  absl::ReaderMutexLock lock(&mutex_);
+  return size_bytes_;
+}
+
 bool SimpleHttpCache::insert(const Key& key, Http::ResponseHeaderMapPtr&& response_headers,
                              ResponseMetadata&& metadata, std::string&& body,
                              Http::ResponseTrailerMapPtr&& trailers) {
   absl::WriterMutexLock lock(&mutex_);
-  map_[key] = SimpleHttpCache::Entry{std::move(response_headers), std::move(metadata),
-                                     std::move(body), std::move(trailers)};
-  return true;
+  return store(key, SimpleHttpCache::Entry{std::move(response_headers), std::move(metadata),
+                                           std::make_shared<const std::string>(std::move(body)),
+                                           std::move(trailers)});
 }
 
 SimpleHttpCache::Entry
@@ -256,15 +339,8 @@ SimpleHttpCache::varyLookup(const LookupRequest& request,
   if (iter == map_.end()) {
     return SimpleHttpCache::Entry{};
   }
-  ASSERT(iter->second.response_headers_);
-  Http::ResponseTrailerMapPtr trailers_map;
-  if (iter->second.trailers_) {
-    trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*iter->second.trailers_);
-  }
-
-  return SimpleHttpCache::Entry{
-      Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*iter->second.response_headers_),
-      iter->second.metadata_, iter->second.body_, std::move(trailers_map)};
+  ASSERT(iter->second.entry_.response_headers_);
+  return copyEntry(iter->second);
 }
 
 bool SimpleHttpCache::varyInsert(const Key& request_key,
@@ -289,8 +365,12 @@ bool SimpleHttpCache::varyInsert(const Key& request_key,
   }
 
   varied_request_key.add_custom_fields(vary_identifier.value());
-  map_[varied_request_key] = SimpleHttpCache::Entry{
-      std::move(response_headers), std::move(metadata), std::move(body), std::move(trailers)};
+  if (!store(varied_request_key,
+             SimpleHttpCache::Entry{std::move(response_headers), std::move(metadata),
+                                    std::make_shared<const std::string>(std::move(body)),
+                                    std::move(trailers)})) {
+    return false;
+  }
 
   // Add a special entry to flag that this request generates varied responses.
   auto iter = map_.find(request_key);
@@ -304,8 +384,11 @@ bool SimpleHttpCache::varyInsert(const Key& request_key,
     // have inserted for that resource. For the first entry simply use vary_identifier as the
     // entry_list; for future entries append vary_identifier to existing list.
     std::string entry_list;
-    map_[request_key] =
-        SimpleHttpCache::Entry{std::move(vary_only_map), {}, std::move(entry_list), {}};
+    store(request_key, SimpleHttpCache::Entry{
+                           std::move(vary_only_map),
+                           {},
+                           std::make_shared<const std::string>(std::move(entry_list)),
+                           {}});
   }
   return true;
 }
@@ -329,6 +412,26 @@ CacheInfo SimpleHttpCache::cacheInfo() const {
 
 SINGLETON_MANAGER_REGISTRATION(simple_http_cache_singleton);
 
+// Shares a cache between the filters configured with the same maximum size.
+class SimpleHttpCacheSingleton : public Singleton::Instance {
+public:
+  std::shared_ptr<SimpleHttpCache> get(uint64_t max_size_bytes) {
+    absl::MutexLock lock(&mutex_);
+    std::weak_ptr<SimpleHttpCache>& weak_cache = caches_[max_size_bytes];
+    std::shared_ptr<SimpleHttpCache> cache = weak_cache.lock();
+    if (cache == nullptr) {
+      cache = std::make_shared<SimpleHttpCache>(max_size_bytes);
+      weak_cache = cache;
+    }
+    return cache;
+  }
+
+private:
+  absl::Mutex mutex_;
+  // The caches are destroyed when no filter uses them anymore.
+  absl::flat_hash_map<uint64_t, std::weak_ptr<SimpleHttpCache>> caches_ ABSL_GUARDED_BY(mutex_);
+};
+
 class SimpleHttpCacheFactory : public HttpCacheFactory {
 public:
   // From UntypedFactory
@@ -340,15 +443,16 @@ public:
   }
   // From HttpCacheFactory
   std::shared_ptr<HttpCache>
-  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig&,
+  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
            Server::Configuration::FactoryContext& context) override {
-    return context.serverFactoryContext().singletonManager().getTyped<SimpleHttpCache>(
-        SINGLETON_MANAGER_REGISTERED_NAME(simple_http_cache_singleton), &createCache);
-  }
-
-private:
-  static std::shared_ptr<Singleton::Instance> createCache() {
-    return std::make_shared<SimpleHttpCache>();
+    envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig config;
+    THROW_IF_NOT_OK(MessageUtil::unpackTo(filter_config.typed_config(), config));
+    return context.serverFactoryContext()
+        .singletonManager()
+        .getTyped<SimpleHttpCacheSingleton>(
+            SINGLETON_MANAGER_REGISTERED_NAME(simple_http_cache_singleton),
+            [] { return std::make_shared<SimpleHttpCacheSingleton>(); }, /*pin=*/true)
+        ->get(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_cache_size_bytes, 0));
   }
 };
 
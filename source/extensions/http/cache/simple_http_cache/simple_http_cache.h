@@ -1,10 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <list>
+#include <memory>
+
 #include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/http/cache/http_cache.h"
 
 #include "absl/base/thread_annotations.h"
-#include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_map.h"
 #include "absl/synchronization/mutex.h"
 
 namespace Envoy {
@@ -12,16 +16,37 @@ namespace Extensions {
 namespace HttpFilters {
 namespace Cache {
 
-// Example cache backend that never evicts. Not suitable for production use.
-class SimpleHttpCache : public HttpCache, public Singleton::Instance {
+// In-memory cache backend, which evicts the responses that weren't looked up recently when it
+// exceeds its maximum size, if any. Not suitable for production use.
+class SimpleHttpCache : public HttpCache {
 private:
   struct Entry {
     Http::ResponseHeaderMapPtr response_headers_;
     ResponseMetadata metadata_;
-    std::string body_;
+    // Shared by the lookups, which serve it without copying it.
+    std::shared_ptr<const std::string> body_;
     Http::ResponseTrailerMapPtr trailers_;
   };
 
+  struct StoredEntry {
+    Entry entry_;
+    uint64_t size_bytes_{};
+    // Set by the lookups, which only hold the mutex for reading, and cleared by the eviction
+    // passes, which skip the referenced entries once.
+    mutable std::atomic<bool> referenced_{};
+  };
+
+  // Stores the entry of a key, replacing the existing one if any, and evicts entries until the
+  // cache fits in its maximum size. Returns false if the entry alone exceeds the maximum size.
+  bool store(const Key& key, Entry&& entry) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Evicts entries until an entry of incoming_size_bytes fits in the maximum size. The entry of
+  // excluded_key, if any, is the one being replaced and is never evicted.
+  void evict(uint64_t incoming_size_bytes, const Key* excluded_key)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Returns a copy of a stored entry, which shares its body, and marks it as referenced.
+  static Entry copyEntry(const StoredEntry& stored_entry);
+  static uint64_t entrySizeBytes(const Key& key, const Entry& entry);
+
   // Looks for a response that has been varied. Only called from lookup.
   Entry varyLookup(const LookupRequest& request,
                    const Http::ResponseHeaderMapPtr& response_headers);
@@ -33,6 +58,11 @@ private:
   static const absl::flat_hash_set<Http::LowerCaseString> headersNotToUpdate();
 
 public:
+  // Creates a cache that never evicts.
+  SimpleHttpCache() = default;
+  // Creates a cache that evicts entries when it exceeds max_size_bytes, if it isn't 0.
+  explicit SimpleHttpCache(uint64_t max_size_bytes) : max_size_bytes_(max_size_bytes) {}
+
   // HttpCache
   LookupContextPtr makeLookupContext(LookupRequest&& request,
                                      Http::StreamFilterCallbacks& callbacks) override;
@@ -48,14 +78,22 @@ public:
               ResponseMetadata&& metadata, std::string&& body,
               Http::ResponseTrailerMapPtr&& trailers);
 
+  // Returns the sum of the sizes of the cached entries.
+  uint64_t sizeBytes() const;
+
   // Inserts a response that has been varied on certain headers.
   bool varyInsert(const Key& request_key, Http::ResponseHeaderMapPtr&& response_headers,
                   ResponseMetadata&& metadata, std::string&& body,
                   const Http::RequestHeaderMap& request_headers,
                   const VaryAllowList& vary_allow_list, Http::ResponseTrailerMapPtr&& trailers);
 
-  absl::Mutex mutex_;
-  absl::flat_hash_map<Key, Entry, MessageUtil, MessageUtil> map_ ABSL_GUARDED_BY(mutex_);
+  const uint64_t max_size_bytes_{};
+  mutable absl::Mutex mutex_;
+  // The map is node based, so that the eviction order can point to its keys.
+  absl::node_hash_map<Key, StoredEntry, MessageUtil, MessageUtil> map_ ABSL_GUARDED_BY(mutex_);
+  // The keys by insertion order, which the eviction passes walk from the oldest.
+  std::list<const Key*> eviction_order_ ABSL_GUARDED_BY(mutex_);
+  uint64_t size_bytes_ ABSL_GUARDED_BY(mutex_){};
 };
 
 } // namespace Cache
@@ -0,0 +1,60 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/extensions/http/cache/tiered_http_cache/v3/tiered_http_cache.pb.h"
+#include "envoy/extensions/http/cache/tiered_http_cache/v3/tiered_http_cache.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/http/cache/tiered_http_cache/tiered_http_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace {
+
+class TieredHttpCacheFactory : public HttpCacheFactory {
+public:
+  // From UntypedFactory
+  std::string name() const override { return std::string(TieredHttpCacheName); }
+  // From TypedFactory
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<
+        envoy::extensions::http::cache::tiered_http_cache::v3::TieredHttpCacheConfig>();
+  }
+  // From HttpCacheFactory
+  std::shared_ptr<HttpCache>
+  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
+           Server::Configuration::FactoryContext& context) override {
+    envoy::extensions::http::cache::tiered_http_cache::v3::TieredHttpCacheConfig config;
+    THROW_IF_NOT_OK(MessageUtil::unpackTo(filter_config.typed_config(), config));
+    std::vector<std::shared_ptr<HttpCache>> tiers;
+    tiers.reserve(config.tiers_size());
+    for (const ProtobufWkt::Any& tier_config : config.tiers()) {
+      const std::string type{TypeUtil::typeUrlToDescriptorFullName(tier_config.type_url())};
+      HttpCacheFactory* const tier_factory =
+          Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(type);
+      if (tier_factory == nullptr) {
+        throw EnvoyException(
+            fmt::format("Didn't find a registered implementation for type: '{}'", type));
+      }
+      // Each tier gets the filter config with its own cache config.
+      envoy::extensions::filters::http::cache::v3::CacheConfig tier_filter_config = filter_config;
+      *tier_filter_config.mutable_typed_config() = tier_config;
+      tiers.push_back(tier_factory->getCache(tier_filter_config, context));
+    }
+    return std::make_shared<TieredHttpCache>(std::move(tiers),
+                                             context.serverFactoryContext().timeSource());
+  }
+};
+
+static Registry::RegisterFactory<TieredHttpCacheFactory, HttpCacheFactory> register_;
+
+} // namespace
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,260 @@
+#include "source/extensions/http/cache/tiered_http_cache/tiered_http_cache.h"
+
+#include "source/common/http/header_map_impl.h"
+#include "source/common/http/headers.h"
+#include "source/extensions/filters/http/cache/cache_custom_headers.h"
+
+#include "absl/strings/numbers.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+TieredHttpCache::TieredHttpCache(std::vector<std::shared_ptr<HttpCache>> tiers,
+                                 TimeSource& time_source)
+    : tiers_(std::move(tiers)), time_source_(time_source) {
+  ASSERT(!tiers_.empty());
+}
+
+LookupContextPtr TieredHttpCache::makeLookupContext(LookupRequest&& request,
+                                                    Http::StreamFilterCallbacks& callbacks) {
+  return std::make_unique<TieredLookupContext>(*this, std::move(request), callbacks);
+}
+
+InsertContextPtr TieredHttpCache::makeInsertContext(LookupContextPtr&& lookup_context,
+                                                    Http::StreamFilterCallbacks& callbacks) {
+  ASSERT(lookup_context != nullptr);
+  auto& tiered_lookup_context = dynamic_cast<TieredLookupContext&>(*lookup_context);
+  std::vector<InsertContextPtr> inserts;
+  for (size_t tier = 0; tier < tiers_.size(); ++tier) {
+    InsertContextPtr insert = tiers_[tier]->makeInsertContext(
+        tiered_lookup_context.releaseTierContext(tier, callbacks), callbacks);
+    if (insert != nullptr) {
+      inserts.push_back(std::move(insert));
+    }
+  }
+  lookup_context->onDestroy();
+  if (inserts.empty()) {
+    return nullptr;
+  }
+  return std::make_unique<TieredInsertContext>(std::move(inserts));
+}
+
+void TieredHttpCache::updateHeaders(const LookupContext& lookup_context,
+                                    const Http::ResponseHeaderMap& response_headers,
+                                    const ResponseMetadata& metadata,
+                                    UpdateHeadersCallback on_complete) {
+  // Only the tier the validated response was found in has it; the faster tiers missed it.
+  const auto& tiered_lookup_context = dynamic_cast<const TieredLookupContext&>(lookup_context);
+  tiers_[tiered_lookup_context.foundTier()]->updateHeaders(
+      tiered_lookup_context.foundTierContext(), response_headers, metadata,
+      std::move(on_complete));
+}
+
+CacheInfo TieredHttpCache::cacheInfo() const {
+  CacheInfo cache_info;
+  cache_info.name_ = TieredHttpCacheName;
+  cache_info.supports_range_requests_ = true;
+  for (const std::shared_ptr<HttpCache>& tier : tiers_) {
+    cache_info.supports_range_requests_ &= tier->cacheInfo().supports_range_requests_;
+  }
+  return cache_info;
+}
+
+TieredLookupContext::TieredLookupContext(const TieredHttpCache& cache, LookupRequest&& request,
+                                         Http::StreamFilterCallbacks& callbacks)
+    : cache_(cache), request_(std::move(request)), callbacks_(callbacks),
+      tier_contexts_(cache.tiers().size()) {}
+
+void TieredLookupContext::getHeaders(LookupHeadersCallback&& cb) { lookUpTier(0, std::move(cb)); }
+
+void TieredLookupContext::lookUpTier(size_t tier, LookupHeadersCallback&& cb) {
+  found_tier_ = tier;
+  tier_contexts_[tier] =
+      cache_.tiers()[tier]->makeLookupContext(LookupRequest(request_), callbacks_);
+  tier_contexts_[tier]->getHeaders(
+      [this, tier, cb = std::move(cb)](LookupResult&& result, bool end_stream) mutable {
+        const bool found = result.cache_entry_status_ != CacheEntryStatus::Unusable &&
+                           result.cache_entry_status_ != CacheEntryStatus::LookupError;
+        if (!found && tier + 1 < tier_contexts_.size()) {
+          return lookUpTier(tier + 1, std::move(cb));
+        }
+        if (found && tier > 0) {
+          return promoteHeaders(std::move(result), end_stream, std::move(cb));
+        }
+        cb(std::move(result), end_stream);
+      });
+}
+
+void TieredLookupContext::promoteHeaders(LookupResult&& result, bool end_stream,
+                                         LookupHeadersCallback&& cb) {
+  // Responses that need validation are updated in the tier they were found in, and partial reads
+  // would leave an incomplete promotion.
+  if (result.cache_entry_status_ == CacheEntryStatus::Ok && !result.range_details_.has_value() &&
+      request_.requestHeaders().getMethodValue() != Http::Headers::get().MethodValues.Head) {
+    promotion_ = cache_.tiers()[0]->makeInsertContext(std::move(tier_contexts_[0]), callbacks_);
+    promoting_ = promotion_ != nullptr;
+  }
+  if (!promoting_) {
+    return cb(std::move(result), end_stream);
+  }
+  // The lookup set the age of the response, which the first tier recomputes from the time it was
+  // received.
+  auto headers = Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*result.headers_);
+  uint64_t age_seconds = 0;
+  if (!absl::SimpleAtoi(headers->getInlineValue(CacheCustomHeaders::age()), &age_seconds)) {
+    age_seconds = 0;
+  }
+  headers->removeInline(CacheCustomHeaders::age());
+  const ResponseMetadata metadata{cache_.timeSource().systemTime() -
+                                  std::chrono::seconds(age_seconds)};
+  auto result_ptr = std::make_unique<LookupResult>(std::move(result));
+  promote(
+      [headers = std::move(headers), metadata, end_stream](InsertContext& promotion,
+                                                           InsertCallback on_complete) {
+        promotion.insertHeaders(*headers, metadata, std::move(on_complete), end_stream);
+      },
+      [result = std::move(result_ptr), end_stream, cb = std::move(cb)]() mutable {
+        cb(std::move(*result), end_stream);
+      });
+}
+
+void TieredLookupContext::promote(absl::AnyInvocable<void(InsertContext&, InsertCallback)> send,
+                                  absl::AnyInvocable<void()> done) {
+  if (!promoting_) {
+    return done();
+  }
+  send(*promotion_, [this, done = std::move(done)](bool ready_for_more) mutable {
+    // If the first tier gave up on the response, it's still served from the tier it was found in.
+    promoting_ = ready_for_more;
+    done();
+  });
+}
+
+void TieredLookupContext::getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) {
+  tier_contexts_[found_tier_]->getBody(
+      range, [this, cb = std::move(cb)](Buffer::InstancePtr&& body, bool end_stream) mutable {
+        if (body == nullptr) {
+          // The end of the body of a response with trailers and an unknown length.
+          return cb(std::move(body), end_stream);
+        }
+        const Buffer::Instance& fragment = *body;
+        promote(
+            [&fragment, end_stream](InsertContext& promotion, InsertCallback on_complete) {
+              promotion.insertBody(fragment, std::move(on_complete), end_stream);
+            },
+            [body = std::move(body), end_stream, cb = std::move(cb)]() mutable {
+              cb(std::move(body), end_stream);
+            });
+      });
+}
+
+void TieredLookupContext::getTrailers(LookupTrailersCallback&& cb) {
+  tier_contexts_[found_tier_]->getTrailers(
+      [this, cb = std::move(cb)](Http::ResponseTrailerMapPtr&& trailers) mutable {
+        const Http::ResponseTrailerMap& promoted_trailers = *trailers;
+        promote(
+            [&promoted_trailers](InsertContext& promotion, InsertCallback on_complete) {
+              promotion.insertTrailers(promoted_trailers, std::move(on_complete));
+            },
+            [trailers = std::move(trailers), cb = std::move(cb)]() mutable {
+              cb(std::move(trailers));
+            });
+      });
+}
+
+void TieredLookupContext::onDestroy() {
+  if (promotion_ != nullptr) {
+    promotion_->onDestroy();
+    promotion_ = nullptr;
+    promoting_ = false;
+  }
+  for (LookupContextPtr& tier_context : tier_contexts_) {
+    if (tier_context != nullptr) {
+      tier_context->onDestroy();
+      tier_context = nullptr;
+    }
+  }
+}
+
+LookupContextPtr TieredLookupContext::releaseTierContext(size_t tier,
+                                                         Http::StreamFilterCallbacks& callbacks) {
+  if (tier_contexts_[tier] == nullptr) {
+    return cache_.tiers()[tier]->makeLookupContext(LookupRequest(request_), callbacks);
+  }
+  return std::move(tier_contexts_[tier]);
+}
+
+TieredInsertContext::TieredInsertContext(std::vector<InsertContextPtr> tiers) {
+  tiers_.reserve(tiers.size());
+  for (InsertContextPtr& tier : tiers) {
+    tiers_.push_back(Tier{std::move(tier)});
+  }
+}
+
+void TieredInsertContext::send(
+    absl::AnyInvocable<void(InsertContext&, InsertCallback)> send_to_tier,
+    InsertCallback on_complete) {
+  ASSERT(pending_ == 0);
+  on_complete_ = std::move(on_complete);
+  for (const Tier& tier : tiers_) {
+    pending_ += tier.accepting_;
+  }
+  // The tiers may complete inline, so pending_ is counted before sending to any of them.
+  for (Tier& tier : tiers_) {
+    if (!tier.accepting_) {
+      continue;
+    }
+    send_to_tier(*tier.context_, [this, &tier](bool ready_for_more) {
+      tier.accepting_ = ready_for_more;
+      if (--pending_ > 0) {
+        return;
+      }
+      bool any_accepting = false;
+      for (const Tier& t : tiers_) {
+        any_accepting |= t.accepting_;
+      }
+      std::exchange(on_complete_, nullptr)(any_accepting);
+    });
+  }
+}
+
+void TieredInsertContext::insertHeaders(const Http::ResponseHeaderMap& response_headers,
+                                        const ResponseMetadata& metadata,
+                                        InsertCallback insert_complete, bool end_stream) {
+  send(
+      [&response_headers, &metadata, end_stream](InsertContext& tier, InsertCallback on_complete) {
+        tier.insertHeaders(response_headers, metadata, std::move(on_complete), end_stream);
+      },
+      std::move(insert_complete));
+}
+
+void TieredInsertContext::insertBody(const Buffer::Instance& fragment,
+                                     InsertCallback ready_for_next_fragment, bool end_stream) {
+  send(
+      [&fragment, end_stream](InsertContext& tier, InsertCallback on_complete) {
+        tier.insertBody(fragment, std::move(on_complete), end_stream);
+      },
+      std::move(ready_for_next_fragment));
+}
+
+void TieredInsertContext::insertTrailers(const Http::ResponseTrailerMap& trailers,
+                                         InsertCallback insert_complete) {
+  send(
+      [&trailers](InsertContext& tier, InsertCallback on_complete) {
+        tier.insertTrailers(trailers, std::move(on_complete));
+      },
+      std::move(insert_complete));
+}
+
+void TieredInsertContext::onDestroy() {
+  for (Tier& tier : tiers_) {
+    tier.context_->onDestroy();
+  }
+}
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "envoy/common/time.h"
+
+#include "source/extensions/filters/http/cache/http_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+inline constexpr absl::string_view TieredHttpCacheName =
+    "envoy.extensions.http.cache.tiered_http_cache";
+
+// A cache composed of tiers of caches, ordered fastest first, e.g. an in-memory cache in front of
+// a file system cache. Lookups try the tiers in order, and responses found in a lower tier are
+// promoted to the first tier as they are read. Inserts write through to all the tiers, so a
+// response evicted from a faster tier is still found in the slower ones.
+class TieredHttpCache : public HttpCache {
+public:
+  TieredHttpCache(std::vector<std::shared_ptr<HttpCache>> tiers, TimeSource& time_source);
+
+  // HttpCache
+  LookupContextPtr makeLookupContext(LookupRequest&& request,
+                                     Http::StreamFilterCallbacks& callbacks) override;
+  InsertContextPtr makeInsertContext(LookupContextPtr&& lookup_context,
+                                     Http::StreamFilterCallbacks& callbacks) override;
+  void updateHeaders(const LookupContext& lookup_context,
+                     const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata, UpdateHeadersCallback on_complete) override;
+  CacheInfo cacheInfo() const override;
+
+  const std::vector<std::shared_ptr<HttpCache>>& tiers() const { return tiers_; }
+  TimeSource& timeSource() const { return time_source_; }
+
+private:
+  const std::vector<std::shared_ptr<HttpCache>> tiers_;
+  TimeSource& time_source_;
+};
+
+// Looks up a request in the tiers of a TieredHttpCache until one of them has a usable response.
+class TieredLookupContext : public LookupContext {
+public:
+  TieredLookupContext(const TieredHttpCache& cache, LookupRequest&& request,
+                      Http::StreamFilterCallbacks& callbacks);
+
+  // LookupContext
+  void getHeaders(LookupHeadersCallback&& cb) override;
+  void getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) override;
+  void getTrailers(LookupTrailersCallback&& cb) override;
+  void onDestroy() override;
+
+  // Returns the lookup context of a tier, making one if the tier wasn't looked up, to insert a
+  // response into it.
+  LookupContextPtr releaseTierContext(size_t tier, Http::StreamFilterCallbacks& callbacks);
+  // The tier the response was found in, or the last tier if none had it.
+  size_t foundTier() const { return found_tier_; }
+  const LookupContext& foundTierContext() const { return *tier_contexts_[found_tier_]; }
+
+private:
+  void lookUpTier(size_t tier, LookupHeadersCallback&& cb);
+  // Starts promoting a response found in a lower tier to the first one, if it's going to be read
+  // in full, and passes it on once the first tier accepted its headers.
+  void promoteHeaders(LookupResult&& result, bool end_stream, LookupHeadersCallback&& cb);
+  // If promoting, sends a fragment to the first tier, and runs done once it accepted it.
+  // Otherwise runs done right away.
+  void promote(absl::AnyInvocable<void(InsertContext&, InsertCallback)> send,
+               absl::AnyInvocable<void()> done);
+
+  const TieredHttpCache& cache_;
+  const LookupRequest request_;
+  Http::StreamFilterCallbacks& callbacks_;
+  // One per tier, null for the tiers that weren't looked up.
+  std::vector<LookupContextPtr> tier_contexts_;
+  size_t found_tier_ = 0;
+  // Set while promoting the response to the first tier. Each fragment is passed on once the first
+  // tier accepted it, so that there's at most one fragment in flight.
+  InsertContextPtr promotion_;
+  bool promoting_ = false;
+};
+
+// Inserts a response into all the tiers of a TieredHttpCache, as long as they accept it.
+class TieredInsertContext : public InsertContext {
+public:
+  explicit TieredInsertContext(std::vector<InsertContextPtr> tiers);
+
+  // InsertContext
+  void insertHeaders(const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata, InsertCallback insert_complete,
+                     bool end_stream) override;
+  void insertBody(const Buffer::Instance& fragment, InsertCallback ready_for_next_fragment,
+                  bool end_stream) override;
+  void insertTrailers(const Http::ResponseTrailerMap& trailers,
+                      InsertCallback insert_complete) override;
+  void onDestroy() override;
+
+private:
+  struct Tier {
+    InsertContextPtr context_;
+    bool accepting_ = true;
+  };
+
+  // Sends a fragment to each tier still accepting the response, and calls on_complete with
+  // whether any of them accepts more once they all completed.
+  void send(absl::AnyInvocable<void(InsertContext&, InsertCallback)> send_to_tier,
+            InsertCallback on_complete);
+
+  std::vector<Tier> tiers_;
+  InsertCallback on_complete_;
+  size_t pending_ = 0;
+};
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -27,9 +27,12 @@ Api::SysCallIntResult makeInvalidSyscallResult() {
  * @param dst supplies the buffer where the data is move to.
  * @param src supplies the buffer where the data is move from.
  * @param max_length supplies the max bytes the call can move.
+ * @param whole_slices supplies whether to stop at the end of the last slice of src which fits in
+ *        max_length, if any, rather than copying the part of the next slice which fits.
  * @return number of bytes this call moves.
  */
-uint64_t moveUpTo(Buffer::Instance& dst, Buffer::Instance& src, uint64_t max_length) {
+uint64_t moveUpTo(Buffer::Instance& dst, Buffer::Instance& src, uint64_t max_length,
+                  bool whole_slices) {
   ASSERT(src.length() > 0);
   if (dst.highWatermark() != 0) {
     if (dst.length() < dst.highWatermark()) {
@@ -43,6 +46,18 @@ uint64_t moveUpTo(Buffer::Instance& dst, Buffer::Instance& src, uint64_t max_len
     }
   }
   uint64_t res = std::min(max_length, src.length());
+  if (whole_slices && res < src.length()) {
+    uint64_t whole_slices_length = 0;
+    for (const Buffer::RawSlice& slice : src.getRawSlices()) {
+      if (whole_slices_length + slice.len_ > res) {
+        break;
+      }
+      whole_slices_length += slice.len_;
+    }
+    if (whole_slices_length > 0) {
+      res = whole_slices_length;
+    }
+  }
   dst.move(src, res, /*reset_drain_trackers_and_accounting=*/true);
   return res;
 }
@@ -138,7 +153,8 @@ Api::IoCallUint64Result IoHandleImpl::read(Buffer::Instance& buffer,
       return {0, Network::IoSocketError::getIoSocketEagainError()};
     }
   }
-  const uint64_t bytes_to_read = moveUpTo(buffer, pending_received_data_, max_length);
+  const uint64_t bytes_to_read =
+      moveUpTo(buffer, pending_received_data_, max_length, /*whole_slices=*/false);
   return {bytes_to_read, Api::IoError::none()};
 }
 
@@ -207,10 +223,12 @@ Api::IoCallUint64Result IoHandleImpl::write(Buffer::Instance& buffer) {
     return {0, Network::IoSocketError::getIoSocketEagainError()};
   }
   const uint64_t max_bytes_to_write = buffer.length();
+  // The slices of the buffer are handed over to the peer rather than copied, as the rest of the
+  // buffer is written by the next call anyway.
   const uint64_t total_bytes_to_write =
       moveUpTo(*peer_handle_->getWriteBuffer(), buffer,
                // Below value comes from Buffer::OwnedImpl::default_read_reservation_size_.
-               MAX_FRAGMENT * FRAGMENT_SIZE);
+               MAX_FRAGMENT * FRAGMENT_SIZE, /*whole_slices=*/true);
   peer_handle_->setNewDataAvailable();
   ENVOY_LOG(trace, "socket {} write {} bytes of {}", static_cast<void*>(this), total_bytes_to_write,
             max_bytes_to_write);
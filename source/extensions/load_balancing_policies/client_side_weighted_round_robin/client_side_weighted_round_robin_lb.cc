@@ -44,6 +44,8 @@ ClientSideWeightedRoundRobinLbConfig::ClientSideWeightedRoundRobinLbConfig(
       PROTOBUF_GET_MS_OR_DEFAULT(lb_proto, weight_expiration_period, 180000));
   weight_update_period =
       std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(lb_proto, weight_update_period, 1000));
+  weight_change_threshold =
+      PROTOBUF_PERCENT_TO_DOUBLE_OR_DEFAULT(lb_proto, weight_change_threshold, 0) / 100.0;
 }
 
 ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLb::WorkerLocalLb(
@@ -72,6 +74,7 @@ void ClientSideWeightedRoundRobinLoadBalancer::initFromConfig(
   blackout_period_ = lb_config.blackout_period;
   weight_expiration_period_ = lb_config.weight_expiration_period;
   weight_update_period_ = lb_config.weight_update_period;
+  weight_change_threshold_ = lb_config.weight_change_threshold;
 }
 
 void ClientSideWeightedRoundRobinLoadBalancer::updateWeightsOnMainThread() {
@@ -108,8 +111,7 @@ bool ClientSideWeightedRoundRobinLoadBalancer::updateWeightsOnHosts(const HostVe
     if (client_side_weight.has_value()) {
       const uint32_t new_weight = client_side_weight.value();
       weights.push_back(new_weight);
-      if (new_weight != host_ptr->weight()) {
-        host_ptr->weight(new_weight);
+      if (updateHostWeight(*host_ptr, new_weight)) {
         ENVOY_LOG(trace, "updateWeights hostWeight {} = {}", getHostAddress(host_ptr.get()),
                   host_ptr->weight());
         weights_updated = true;
@@ -139,8 +141,7 @@ bool ClientSideWeightedRoundRobinLoadBalancer::updateWeightsOnHosts(const HostVe
     }
     // Update the hosts with default weight.
     for (const auto& host_ptr : hosts_with_default_weight) {
-      if (default_weight != host_ptr->weight()) {
-        host_ptr->weight(default_weight);
+      if (updateHostWeight(*host_ptr, default_weight)) {
         ENVOY_LOG(trace, "updateWeights default hostWeight {} = {}", getHostAddress(host_ptr.get()),
                   host_ptr->weight());
         weights_updated = true;
@@ -150,6 +151,23 @@ bool ClientSideWeightedRoundRobinLoadBalancer::updateWeightsOnHosts(const HostVe
   return weights_updated;
 }
 
+bool ClientSideWeightedRoundRobinLoadBalancer::updateHostWeight(Host& host, uint32_t weight) {
+  const uint32_t current_weight = host.weight();
+  if (weight == current_weight) {
+    return false;
+  }
+  // Every applied change rebuilds the schedulers of all workers, so ignore the small changes
+  // caused by noise in the load reports. They are applied once they add up, as they are compared
+  // with the weight in use rather than the previous calculated weight.
+  const uint32_t change =
+      weight > current_weight ? weight - current_weight : current_weight - weight;
+  if (change < weight_change_threshold_ * current_weight) {
+    return false;
+  }
+  host.weight(weight);
+  return true;
+}
+
 void ClientSideWeightedRoundRobinLoadBalancer::addClientSideLbPolicyDataToHosts(
     const HostVector& hosts) {
   for (const auto& host_ptr : hosts) {
@@ -34,6 +34,8 @@ public:
   std::chrono::milliseconds blackout_period;
   std::chrono::milliseconds weight_expiration_period;
   std::chrono::milliseconds weight_update_period;
+  // The smallest relative change of a host weight that is applied.
+  double weight_change_threshold;
 
   Event::Dispatcher& main_thread_dispatcher_;
   ThreadLocal::SlotAllocator& tls_slot_allocator_;
@@ -208,6 +210,10 @@ private:
   // Returns true if any host weight is updated.
   bool updateWeightsOnHosts(const HostVector& hosts);
 
+  // Set the weight of `host` to `weight` unless it differs from the current
+  // weight by less than `weight_change_threshold_`. Returns true if it is set.
+  bool updateHostWeight(Host& host, uint32_t weight);
+
   // Add client side host LB policy data to all `hosts`.
   void addClientSideLbPolicyDataToHosts(const HostVector& hosts);
 
@@ -232,6 +238,7 @@ private:
   std::chrono::milliseconds blackout_period_;
   std::chrono::milliseconds weight_expiration_period_;
   std::chrono::milliseconds weight_update_period_;
+  double weight_change_threshold_;
 
   Event::TimerPtr weight_calculation_timer_;
   // Callback for `priority_set_` updates.
@@ -906,13 +906,21 @@ void EdfLoadBalancerBase::recalculateHostsInSlowStart(const HostVector& hosts) {
 
 void EdfLoadBalancerBase::refresh(uint32_t priority) {
   const auto add_hosts_source = [this](HostsSource source, const HostVector& hosts) {
-    // Nuke existing scheduler if it exists.
-    auto& scheduler = scheduler_[source] = Scheduler{};
     refreshHostSource(source);
     if (isSlowStartEnabled()) {
       recalculateHostsInSlowStart(hosts);
     }
 
+    // Most EDS updates of large clusters only touch a few localities, keep the scheduler of a
+    // source whose hosts and weights are unchanged instead of rebuilding it. Building a scheduler
+    // is O(n log n) and also restarts the pick sequence of the source.
+    auto& scheduler = scheduler_[source];
+    if (scheduler.edf_ != nullptr && !isSlowStartEnabled() && scheduler.sameHosts(hosts)) {
+      return;
+    }
+    // Nuke existing scheduler if it exists.
+    scheduler = Scheduler{};
+
     // Check if the original host weights are equal and no hosts are in slow start mode, in that
     // case EDF creation is skipped. When all original weights are equal and no hosts are in slow
     // start mode we can rely on unweighted host pick to do optimal round robin and least-loaded
@@ -941,6 +949,12 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
         // at which point it is reinserted into the EdfScheduler with its new
         // weight in chooseHost().
         [this](const Host& host) { return hostWeight(host); }, seed_));
+    scheduler.hosts_.reserve(hosts.size());
+    scheduler.weights_.reserve(hosts.size());
+    for (const auto& host : hosts) {
+      scheduler.hosts_.push_back(host);
+      scheduler.weights_.push_back(host->weight());
+    }
   };
   // Populate EdfSchedulers for each valid HostsSource value for the host set at this priority.
   const auto& host_set = priority_set_.hostSetsPerPriority()[priority];
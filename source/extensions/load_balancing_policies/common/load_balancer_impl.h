@@ -486,6 +486,23 @@ protected:
     // host weights of 2 or more hosts differ. When not present, the
     // implementation of chooseHostOnce falls back to unweightedHostPick.
     std::unique_ptr<EdfScheduler<Host>> edf_;
+    // The hosts and their weights edf_ was built from, to keep edf_ across refreshes that don't
+    // change them. Like the entries of edf_, the hosts are weak so that removed hosts are freed.
+    std::vector<std::weak_ptr<Host>> hosts_;
+    std::vector<uint32_t> weights_;
+
+    bool sameHosts(const HostVector& hosts) const {
+      if (hosts.size() != hosts_.size()) {
+        return false;
+      }
+      for (size_t i = 0; i < hosts.size(); ++i) {
+        if (hosts[i].owner_before(hosts_[i]) || hosts_[i].owner_before(hosts[i]) ||
+            hosts[i]->weight() != weights_[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
   };
 
   void initialize();
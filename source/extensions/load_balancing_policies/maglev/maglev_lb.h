@@ -83,18 +83,28 @@ public:
 protected:
   struct TableBuildEntry {
     TableBuildEntry(const HostConstSharedPtr& host, uint64_t offset, uint64_t skip, double weight)
-        : host_(host), offset_(offset), skip_(skip), weight_(weight) {}
+        : host_(host), skip_(skip), weight_(weight), permutation_(offset) {}
 
     HostConstSharedPtr host_;
-    const uint64_t offset_;
     const uint64_t skip_;
     const double weight_;
     double target_weight_{};
-    uint64_t next_{};
+    // The current entry of the permutation of the host, i.e. (offset + skip * next) % table_size
+    // after next steps.
+    uint64_t permutation_;
     uint64_t count_{};
   };
 
-  uint64_t permutation(const TableBuildEntry& entry);
+  /**
+   * Advances the permutation of the entry to its next table index. This is equivalent to
+   * recomputing (offset + skip * next) % table_size, without a division per probe.
+   */
+  void nextPermutation(TableBuildEntry& entry) const {
+    entry.permutation_ += entry.skip_;
+    if (entry.permutation_ >= table_size_) {
+      entry.permutation_ -= table_size_;
+    }
+  }
 
   /**
    * Template method for constructing the Maglev table.
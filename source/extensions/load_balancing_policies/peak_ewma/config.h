@@ -0,0 +1,48 @@
+#pragma once
+
+#include "envoy/extensions/load_balancing_policies/peak_ewma/v3/peak_ewma.pb.h"
+#include "envoy/extensions/load_balancing_policies/peak_ewma/v3/peak_ewma.pb.validate.h"
+#include "envoy/server/factory_context.h"
+#include "envoy/upstream/load_balancer.h"
+
+#include "source/common/common/logger.h"
+#include "source/extensions/load_balancing_policies/common/factory_base.h"
+#include "source/extensions/load_balancing_policies/peak_ewma/peak_ewma_lb.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace PeakEwma {
+
+using PeakEwmaLbProto = envoy::extensions::load_balancing_policies::peak_ewma::v3::PeakEwma;
+
+class Factory : public Upstream::TypedLoadBalancerFactoryBase<PeakEwmaLbProto> {
+public:
+  Factory()
+      : Upstream::TypedLoadBalancerFactoryBase<PeakEwmaLbProto>(
+            "envoy.load_balancing_policies.peak_ewma") {}
+
+  Upstream::ThreadAwareLoadBalancerPtr create(OptRef<const Upstream::LoadBalancerConfig> lb_config,
+                                              const Upstream::ClusterInfo& cluster_info,
+                                              const Upstream::PrioritySet& priority_set,
+                                              Runtime::Loader& runtime,
+                                              Envoy::Random::RandomGenerator& random,
+                                              TimeSource& time_source) override {
+    return std::make_unique<Upstream::PeakEwmaThreadAwareLoadBalancer>(
+        lb_config, cluster_info, priority_set, runtime, random, time_source);
+  }
+
+  absl::StatusOr<Upstream::LoadBalancerConfigPtr>
+  loadConfig(Server::Configuration::ServerFactoryContext&,
+             const Protobuf::Message& config) override {
+    const auto& lb_config = dynamic_cast<const PeakEwmaLbProto&>(config);
+    return Upstream::LoadBalancerConfigPtr{new Upstream::PeakEwmaLbConfig(lb_config)};
+  }
+};
+
+DECLARE_FACTORY(Factory);
+
+} // namespace PeakEwma
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
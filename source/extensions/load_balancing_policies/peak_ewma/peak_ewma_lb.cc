@@ -0,0 +1,144 @@
+#include "source/extensions/load_balancing_policies/peak_ewma/peak_ewma_lb.h"
+
+#include <cmath>
+
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Upstream {
+
+PeakEwmaLbConfig::PeakEwmaLbConfig(const PeakEwmaLbProto& lb_proto)
+    : decay_time_(
+          std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(lb_proto, decay_time, 10000))),
+      default_rtt_ms_(PROTOBUF_GET_MS_OR_DEFAULT(lb_proto, default_rtt, 100)),
+      locality_lb_config_(LoadBalancerConfigHelper::localityLbConfigFromProto(lb_proto)) {}
+
+PeakEwmaHostLbPolicyData::PeakEwmaHostLbPolicyData(TimeSource& time_source,
+                                                   std::chrono::nanoseconds decay_time,
+                                                   double default_rtt_ms)
+    : time_source_(time_source), decay_time_ns_(decay_time.count()),
+      default_rtt_ms_(default_rtt_ms), rtt_ms_(default_rtt_ms),
+      last_update_(time_source.monotonicTime()) {}
+
+double PeakEwmaHostLbPolicyData::decay(MonotonicTime now) const {
+  const auto elapsed = now - last_update_.load(std::memory_order_relaxed);
+  if (elapsed.count() <= 0) {
+    return 1.0;
+  }
+  return std::exp(-static_cast<double>(elapsed.count()) / decay_time_ns_);
+}
+
+void PeakEwmaHostLbPolicyData::onResponseTime(std::chrono::milliseconds response_time) {
+  const MonotonicTime now = time_source_.monotonicTime();
+  const double sample = response_time.count();
+  const double estimate = rtt_ms_.load(std::memory_order_relaxed);
+  if (sample > estimate) {
+    // React to a slower host immediately, and only recover from it gradually.
+    rtt_ms_.store(sample, std::memory_order_relaxed);
+  } else {
+    const double w = decay(now);
+    rtt_ms_.store(estimate * w + sample * (1.0 - w), std::memory_order_relaxed);
+  }
+  last_update_.store(now, std::memory_order_relaxed);
+}
+
+double PeakEwmaHostLbPolicyData::rtt(MonotonicTime now) const {
+  const double w = decay(now);
+  return rtt_ms_.load(std::memory_order_relaxed) * w + default_rtt_ms_ * (1.0 - w);
+}
+
+PeakEwmaLoadBalancer::PeakEwmaLoadBalancer(
+    const PrioritySet& priority_set, const PrioritySet* local_priority_set, ClusterLbStats& stats,
+    Runtime::Loader& runtime, Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
+    const absl::optional<LocalityLbConfig>& locality_lb_config, double default_rtt_ms,
+    TimeSource& time_source)
+    : ZoneAwareLoadBalancerBase(priority_set, local_priority_set, stats, runtime, random,
+                                healthy_panic_threshold, locality_lb_config),
+      default_rtt_ms_(default_rtt_ms), time_source_(time_source) {}
+
+HostConstSharedPtr PeakEwmaLoadBalancer::peekAnotherHost(LoadBalancerContext* context) {
+  if (tooManyPreconnects(stashed_random_.size(), total_healthy_hosts_)) {
+    return nullptr;
+  }
+  return peekOrChoose(context, true);
+}
+
+HostConstSharedPtr PeakEwmaLoadBalancer::chooseHostOnce(LoadBalancerContext* context) {
+  return peekOrChoose(context, false);
+}
+
+double PeakEwmaLoadBalancer::cost(const Host& host, MonotonicTime now) const {
+  // Hosts that were added before the policy data could be attached, e.g. by a priority update
+  // processed by the workers first, use the default response time.
+  const auto data = host.typedLbPolicyData<PeakEwmaHostLbPolicyData>();
+  const double rtt = data.has_value() ? data->rtt(now) : default_rtt_ms_;
+  return rtt * (host.stats().rq_active_.value() + 1);
+}
+
+HostConstSharedPtr PeakEwmaLoadBalancer::peekOrChoose(LoadBalancerContext* context, bool peek) {
+  const uint64_t random_hash = random(peek);
+  const absl::optional<HostsSource> hosts_source = hostSourceToUse(context, random_hash);
+  if (!hosts_source) {
+    return nullptr;
+  }
+
+  const HostVector& hosts_to_use = hostSourceToHosts(*hosts_source);
+  if (hosts_to_use.empty()) {
+    return nullptr;
+  }
+  const size_t first = random_hash % hosts_to_use.size();
+  if (hosts_to_use.size() == 1) {
+    return hosts_to_use[first];
+  }
+
+  // Choose a second host distinct from the first one.
+  const size_t second =
+      (first + 1 + random_.random() % (hosts_to_use.size() - 1)) % hosts_to_use.size();
+  const MonotonicTime now = time_source_.monotonicTime();
+  const HostSharedPtr& first_host = hosts_to_use[first];
+  const HostSharedPtr& second_host = hosts_to_use[second];
+  return cost(*second_host, now) < cost(*first_host, now) ? second_host : first_host;
+}
+
+PeakEwmaThreadAwareLoadBalancer::PeakEwmaThreadAwareLoadBalancer(
+    OptRef<const LoadBalancerConfig> lb_config, const ClusterInfo& cluster_info,
+    const PrioritySet& priority_set, Runtime::Loader& runtime, Random::RandomGenerator& random,
+    TimeSource& time_source)
+    : lb_config_(dynamic_cast<const PeakEwmaLbConfig&>(lb_config.ref())),
+      priority_set_(priority_set), time_source_(time_source),
+      factory_(std::make_shared<WorkerLocalLbFactory>(lb_config_, cluster_info, runtime, random,
+                                                      time_source)) {}
+
+absl::Status PeakEwmaThreadAwareLoadBalancer::initialize() {
+  for (const HostSetPtr& host_set : priority_set_.hostSetsPerPriority()) {
+    addLbPolicyDataToHosts(host_set->hosts());
+  }
+
+  priority_update_cb_ = priority_set_.addPriorityUpdateCb(
+      [this](uint32_t, const HostVector& hosts_added, const HostVector&) -> absl::Status {
+        addLbPolicyDataToHosts(hosts_added);
+        return absl::OkStatus();
+      });
+  return absl::OkStatus();
+}
+
+void PeakEwmaThreadAwareLoadBalancer::addLbPolicyDataToHosts(const HostVector& hosts) {
+  for (const auto& host : hosts) {
+    if (!host->lbPolicyData().has_value()) {
+      host->setLbPolicyData(std::make_unique<PeakEwmaHostLbPolicyData>(
+          time_source_, lb_config_.decay_time_, lb_config_.default_rtt_ms_));
+    }
+  }
+}
+
+LoadBalancerPtr
+PeakEwmaThreadAwareLoadBalancer::WorkerLocalLbFactory::create(LoadBalancerParams params) {
+  return std::make_unique<PeakEwmaLoadBalancer>(
+      params.priority_set, params.local_priority_set, cluster_info_.lbStats(), runtime_, random_,
+      PROTOBUF_PERCENT_TO_ROUNDED_INTEGER_OR_DEFAULT(cluster_info_.lbConfig(),
+                                                     healthy_panic_threshold, 100, 50),
+      lb_config_.locality_lb_config_, lb_config_.default_rtt_ms_, time_source_);
+}
+
+} // namespace Upstream
+} // namespace Envoy
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/load_balancing_policies/peak_ewma/v3/peak_ewma.pb.h"
+#include "envoy/upstream/load_balancer.h"
+#include "envoy/upstream/upstream.h"
+
+#include "source/common/common/callback_impl.h"
+#include "source/extensions/load_balancing_policies/common/load_balancer_impl.h"
+
+namespace Envoy {
+namespace Upstream {
+
+using PeakEwmaLbProto = envoy::extensions::load_balancing_policies::peak_ewma::v3::PeakEwma;
+
+/**
+ * Load balancer config used to wrap the config proto.
+ */
+class PeakEwmaLbConfig : public Upstream::LoadBalancerConfig {
+public:
+  PeakEwmaLbConfig(const PeakEwmaLbProto& lb_proto);
+
+  const std::chrono::nanoseconds decay_time_;
+  const double default_rtt_ms_;
+  const absl::optional<ZoneAwareLoadBalancerBase::LocalityLbConfig> locality_lb_config_;
+};
+
+/**
+ * Latency estimate of a host, a peak EWMA of the response times reported by the router. Hosts
+ * are shared by the load balancers of all workers, so the estimate is updated concurrently. The
+ * updates are not serialized: a response time reported at the same time as another one may be
+ * lost, which doesn't matter for an estimate.
+ */
+class PeakEwmaHostLbPolicyData : public HostLbPolicyData {
+public:
+  PeakEwmaHostLbPolicyData(TimeSource& time_source, std::chrono::nanoseconds decay_time,
+                           double default_rtt_ms);
+
+  // Upstream::HostLbPolicyData
+  void onResponseTime(std::chrono::milliseconds response_time) override;
+
+  /**
+   * @return the estimated response time in milliseconds at the given time. Without new response
+   *         times the estimate decays towards the default response time.
+   */
+  double rtt(MonotonicTime now) const;
+
+private:
+  // Weight of the estimate at last_update_ after the time since then.
+  double decay(MonotonicTime now) const;
+
+  TimeSource& time_source_;
+  const double decay_time_ns_;
+  const double default_rtt_ms_;
+  std::atomic<double> rtt_ms_;
+  std::atomic<MonotonicTime> last_update_;
+};
+
+/**
+ * Power of two choices load balancer that sends a request to the one of two random hosts with the
+ * lower peak EWMA response time times active requests. Priorities and localities are chosen as by
+ * the other zone aware load balancers.
+ */
+class PeakEwmaLoadBalancer : public ZoneAwareLoadBalancerBase {
+public:
+  PeakEwmaLoadBalancer(const PrioritySet& priority_set, const PrioritySet* local_priority_set,
+                       ClusterLbStats& stats, Runtime::Loader& runtime,
+                       Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
+                       const absl::optional<LocalityLbConfig>& locality_lb_config,
+                       double default_rtt_ms, TimeSource& time_source);
+
+  // Upstream::ZoneAwareLoadBalancerBase
+  HostConstSharedPtr chooseHostOnce(LoadBalancerContext* context) override;
+  HostConstSharedPtr peekAnotherHost(LoadBalancerContext* context) override;
+
+private:
+  HostConstSharedPtr peekOrChoose(LoadBalancerContext* context, bool peek);
+  double cost(const Host& host, MonotonicTime now) const;
+
+  const double default_rtt_ms_;
+  TimeSource& time_source_;
+};
+
+/**
+ * Thread aware part of the peak EWMA load balancer. It attaches the latency estimate to the hosts
+ * of the cluster on the main thread, the worker load balancers only read it.
+ */
+class PeakEwmaThreadAwareLoadBalancer : public ThreadAwareLoadBalancer {
+public:
+  PeakEwmaThreadAwareLoadBalancer(OptRef<const LoadBalancerConfig> lb_config,
+                                  const ClusterInfo& cluster_info,
+                                  const PrioritySet& priority_set, Runtime::Loader& runtime,
+                                  Random::RandomGenerator& random, TimeSource& time_source);
+
+  // Upstream::ThreadAwareLoadBalancer
+  LoadBalancerFactorySharedPtr factory() override { return factory_; }
+  absl::Status initialize() override;
+
+private:
+  class WorkerLocalLbFactory : public LoadBalancerFactory {
+  public:
+    WorkerLocalLbFactory(const PeakEwmaLbConfig& lb_config, const ClusterInfo& cluster_info,
+                         Runtime::Loader& runtime, Random::RandomGenerator& random,
+                         TimeSource& time_source)
+        : lb_config_(lb_config), cluster_info_(cluster_info), runtime_(runtime), random_(random),
+          time_source_(time_source) {}
+
+    // Upstream::LoadBalancerFactory
+    LoadBalancerPtr create(LoadBalancerParams params) override;
+    bool recreateOnHostChange() const override { return false; }
+
+  private:
+    const PeakEwmaLbConfig lb_config_;
+    const ClusterInfo& cluster_info_;
+    Runtime::Loader& runtime_;
+    Random::RandomGenerator& random_;
+    TimeSource& time_source_;
+  };
+
+  void addLbPolicyDataToHosts(const HostVector& hosts);
+
+  const PeakEwmaLbConfig lb_config_;
+  const PrioritySet& priority_set_;
+  TimeSource& time_source_;
+  std::shared_ptr<WorkerLocalLbFactory> factory_;
+  Common::CallbackHandlePtr priority_update_cb_;
+};
+
+} // namespace Upstream
+} // namespace Envoy
@@ -8,6 +8,7 @@
 #include "envoy/config/cluster/v3/cluster.pb.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
 
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
@@ -192,20 +193,21 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
     const absl::string_view key_to_hash = hashKey(host, use_hostname_for_hashing);
     ASSERT(!key_to_hash.empty());
 
+    // The hash key is the host key followed by '_' and `i`. `i` is written in place after the
+    // prefix for every hash, rather than formatted into a temporary string and inserted.
     hash_key_buffer.assign(key_to_hash.begin(), key_to_hash.end());
     hash_key_buffer.emplace_back('_');
-    auto offset_start = hash_key_buffer.end();
+    const size_t prefix_size = hash_key_buffer.size();
+    hash_key_buffer.resize(prefix_size + StringUtil::MIN_ITOA_OUT_LEN);
 
     // As noted above: maintain current_hashes and target_hashes as running sums across the entire
     // host set. `i` is needed only to construct the hash key, and tally min/max hashes per host.
     target_hashes += scale * entry.second;
     uint64_t i = 0;
     while (current_hashes < target_hashes) {
-      const std::string i_str = absl::StrCat("", i);
-      hash_key_buffer.insert(offset_start, i_str.begin(), i_str.end());
-
-      absl::string_view hash_key(static_cast<char*>(hash_key_buffer.data()),
-                                 hash_key_buffer.size());
+      const uint32_t i_size = StringUtil::itoa(hash_key_buffer.data() + prefix_size,
+                                               StringUtil::MIN_ITOA_OUT_LEN, i);
+      const absl::string_view hash_key(hash_key_buffer.data(), prefix_size + i_size);
 
       const uint64_t hash =
           (hash_function == HashFunction::Cluster_RingHashLbConfig_HashFunction_MURMUR_HASH_2)
@@ -216,7 +218,6 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
       ring_.push_back({hash, host});
       ++i;
       ++current_hashes;
-      hash_key_buffer.erase(offset_start, hash_key_buffer.end());
     }
     min_hashes_per_host = std::min(i, min_hashes_per_host);
     max_hashes_per_host = std::max(i, max_hashes_per_host);
@@ -61,7 +61,8 @@ SubsetLoadBalancer::SubsetLoadBalancer(const SubsetLoadBalancerConfig& lb_config
       locality_weight_aware_(lb_config_.subsetInfo().localityWeightAware()),
       scale_locality_weight_(lb_config_.subsetInfo().scaleLocalityWeight()),
       list_as_any_(lb_config_.subsetInfo().listAsAny()),
-      allow_redundant_keys_(lb_config_.subsetInfo().allowRedundantKeys()) {
+      allow_redundant_keys_(lb_config_.subsetInfo().allowRedundantKeys()),
+      lazy_subset_creation_(lb_config_.subsetInfo().lazySubsetCreation()) {
   ASSERT(lb_config_.subsetInfo().isEnabled());
 
   if (fallback_policy_ != envoy::config::cluster::v3::Cluster::LbSubsetConfig::NO_FALLBACK) {
@@ -372,10 +373,13 @@ HostConstSharedPtr SubsetLoadBalancer::tryChooseHostFromContext(LoadBalancerCont
 
   // Route has metadata match criteria defined, see if we have a matching subset.
   LbSubsetEntryPtr entry = findSubset(match_criteria->metadataMatchCriteria());
-  if (entry == nullptr || !entry->active()) {
+  if (entry == nullptr || !entry->hasHosts()) {
     // No matching subset or subset not active: use fallback policy.
     return {nullptr};
   }
+  if (!entry->initialized()) {
+    initPendingLbSubsetEntry(entry);
+  }
 
   host_chosen = true;
   stats_.lb_subsets_selected_.inc();
@@ -472,6 +476,18 @@ void SubsetLoadBalancer::initLbSubsetEntryOnce(LbSubsetEntryPtr& entry, bool sin
   stats_.lb_subsets_created_.inc();
 }
 
+// Creates the load balancer of a lazily created subset from the hosts it tracked so far.
+void SubsetLoadBalancer::initPendingLbSubsetEntry(LbSubsetEntryPtr& entry) {
+  initLbSubsetEntryOnce(entry, entry->single_host_subset_);
+  for (const auto& [priority, hosts] : entry->pending_hosts_) {
+    for (const auto& host : hosts) {
+      entry->lb_subset_->pushHost(priority, host);
+    }
+    entry->lb_subset_->finalize(priority, random_.random());
+  }
+  entry->pending_hosts_.clear();
+}
+
 // Iterates all the hosts of specified priority, looking up an LbSubsetEntryPtr for each and add
 // hosts to related entry. Because the metadata of host can be updated inlined, we must evaluate
 // every hosts for every update.
@@ -479,6 +495,12 @@ void SubsetLoadBalancer::processSubsets(uint32_t priority, const HostVector& all
   absl::flat_hash_set<const LbSubsetEntry*> single_host_entries;
   uint64_t collision_count_of_single_host_entries{};
 
+  if (lazy_subset_creation_) {
+    // The pending hosts of this priority are collected again below.
+    forEachSubset(subsets_,
+                  [priority](LbSubsetEntryPtr& entry) { entry->pending_hosts_.erase(priority); });
+  }
+
   for (const auto& host : all_hosts) {
     for (const auto& subset_selector : subset_selectors_) {
       const auto& keys = subset_selector->selectorKeys();
@@ -488,7 +510,12 @@ void SubsetLoadBalancer::processSubsets(uint32_t priority, const HostVector& all
       for (const auto& kvs : all_kvs) {
         // The host has metadata for each key, find or create its subset.
         auto entry = findOrCreateLbSubsetEntry(subsets_, kvs, 0);
-        initLbSubsetEntryOnce(entry, subset_selector->singleHostPerSubset());
+        if (lazy_subset_creation_ && !entry->initialized()) {
+          // Only track the hosts, the load balancer is created on the first request.
+          entry->single_host_subset_ = subset_selector->singleHostPerSubset();
+        } else {
+          initLbSubsetEntryOnce(entry, subset_selector->singleHostPerSubset());
+        }
 
         if (entry->single_host_subset_) {
           if (single_host_entries.contains(entry.get())) {
@@ -498,7 +525,11 @@ void SubsetLoadBalancer::processSubsets(uint32_t priority, const HostVector& all
           single_host_entries.emplace(entry.get());
         }
 
-        entry->lb_subset_->pushHost(priority, host);
+        if (entry->initialized()) {
+          entry->lb_subset_->pushHost(priority, host);
+        } else {
+          entry->pending_hosts_[priority].push_back(host);
+        }
       }
     }
   }
@@ -681,7 +712,7 @@ void SubsetLoadBalancer::purgeEmptySubsets(LbSubsetMap& subsets) {
 
       purgeEmptySubsets(entry->children_);
 
-      if (entry->active() || entry->hasChildren()) {
+      if (entry->hasHosts() || entry->hasChildren()) {
         it++;
         continue;
       }
@@ -321,6 +321,7 @@ private:
 
     bool initialized() const { return lb_subset_ != nullptr; }
     bool active() const { return initialized() && lb_subset_->active(); }
+    bool hasHosts() const { return active() || !pending_hosts_.empty(); }
     bool hasChildren() const { return !children_.empty(); }
 
     LbSubsetMap children_;
@@ -328,11 +329,16 @@ private:
     // Only initialized if a match exists at this level.
     LbSubsetPtr lb_subset_;
 
+    // With lazy subset creation, the hosts of the subset per priority until lb_subset_ is
+    // initialized by the first request that selects the subset.
+    std::map<uint32_t, HostVector> pending_hosts_;
+
     // Used to quick check if entry is single host subset entry or not.
     bool single_host_subset_{};
   };
 
   void initLbSubsetEntryOnce(LbSubsetEntryPtr& entry, bool single_host_subset);
+  void initPendingLbSubsetEntry(LbSubsetEntryPtr& entry);
 
   // Create filtered default subset (if necessary) and other subsets based on current hosts.
   void refreshSubsets();
@@ -405,6 +411,7 @@ private:
   const bool scale_locality_weight_ : 1;
   const bool list_as_any_ : 1;
   const bool allow_redundant_keys_{};
+  const bool lazy_subset_creation_{};
 };
 
 } // namespace Upstream
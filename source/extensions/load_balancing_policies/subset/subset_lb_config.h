@@ -111,6 +111,12 @@ public:
    * @return bool whether redundant key/value pairs is allowed in the request metadata.
    */
   virtual bool allowRedundantKeys() const PURE;
+
+  /*
+   * @return bool whether the load balancer of a subset is only created when the subset is first
+   * selected by a request.
+   */
+  virtual bool lazySubsetCreation() const PURE;
 };
 
 using LoadBalancerSubsetInfoPtr = std::unique_ptr<LoadBalancerSubsetInfo>;
@@ -136,7 +142,8 @@ public:
         locality_weight_aware_(subset_config.locality_weight_aware()),
         scale_locality_weight_(subset_config.scale_locality_weight()),
         panic_mode_any_(subset_config.panic_mode_any()), list_as_any_(subset_config.list_as_any()),
-        allow_redundant_keys_(subset_config.allow_redundant_keys()) {
+        allow_redundant_keys_(subset_config.allow_redundant_keys()),
+        lazy_subset_creation_(subset_config.lazy_subset_creation()) {
     for (const auto& subset : subset_config.subset_selectors()) {
       if (!subset.keys().empty()) {
         subset_selectors_.emplace_back(std::make_shared<SubsetSelector>(
@@ -190,6 +197,7 @@ public:
   bool panicModeAny() const override { return panic_mode_any_; }
   bool listAsAny() const override { return list_as_any_; }
   bool allowRedundantKeys() const override { return allow_redundant_keys_; }
+  bool lazySubsetCreation() const override { return lazy_subset_creation_; }
 
 private:
   const ProtobufWkt::Struct default_subset_;
@@ -203,6 +211,7 @@ private:
   const bool panic_mode_any_ : 1;
   const bool list_as_any_ : 1;
   const bool allow_redundant_keys_{};
+  const bool lazy_subset_creation_{};
 };
 
 using DefaultLoadBalancerSubsetInfo = ConstSingleton<LoadBalancerSubsetInfoImpl>;
@@ -0,0 +1,40 @@
+#include "source/extensions/network/connection_balance/reuse_port_bpf/config.h"
+
+#include "envoy/registry/registry.h"
+#include "envoy/server/factory_context.h"
+
+#if defined(__linux__)
+#include "source/extensions/network/connection_balance/reuse_port_bpf/connection_balancer_impl.h"
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace ReusePortBpf {
+
+Network::ConnectionBalancerSharedPtr
+ReusePortBpfConnectionBalanceFactory::createConnectionBalancerFromProto(
+    const Protobuf::Message&, Server::Configuration::FactoryContext& context) {
+#if defined(__linux__)
+  auto balancer_or_error = ReusePortBpfConnectionBalancerImpl::create(
+      context.serverFactoryContext().options().concurrency());
+  if (balancer_or_error.ok()) {
+    return std::move(*balancer_or_error);
+  }
+  // Without the program the kernel's default reuse port selection applies, which is what the
+  // listener would get without a balancer.
+  ENVOY_LOG(warn, "reuse port BPF connection balancer unavailable, not balancing: {}",
+            balancer_or_error.status().message());
+#else
+  UNREFERENCED_PARAMETER(context);
+  ENVOY_LOG(warn, "reuse port BPF connection balancer is only supported on Linux");
+#endif
+  return std::make_shared<Network::NopConnectionBalancerImpl>();
+}
+
+REGISTER_FACTORY(ReusePortBpfConnectionBalanceFactory, Network::ConnectionBalanceFactory);
+
+} // namespace ReusePortBpf
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
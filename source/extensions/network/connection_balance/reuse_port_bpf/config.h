@@ -0,0 +1,34 @@
+#pragma once
+
+#include "envoy/extensions/network/connection_balance/reuse_port_bpf/v3/reuse_port_bpf.pb.h"
+
+#include "source/common/common/logger.h"
+#include "source/common/network/connection_balancer_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace ReusePortBpf {
+
+class ReusePortBpfConnectionBalanceFactory : public Network::ConnectionBalanceFactory,
+                                             Logger::Loggable<Logger::Id::config> {
+public:
+  // Network::ConnectionBalanceFactory
+  Network::ConnectionBalancerSharedPtr
+  createConnectionBalancerFromProto(const Protobuf::Message& config,
+                                    Server::Configuration::FactoryContext& context) override;
+
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<
+        envoy::extensions::network::connection_balance::reuse_port_bpf::v3::ReusePortBpf>();
+  }
+
+  std::string name() const override { return "envoy.network.connection_balance.reuse_port_bpf"; }
+};
+
+DECLARE_FACTORY(ReusePortBpfConnectionBalanceFactory);
+
+} // namespace ReusePortBpf
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,304 @@
+#include "source/extensions/network/connection_balance/reuse_port_bpf/connection_balancer_impl.h"
+
+#include <sys/socket.h>
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#include "envoy/common/exception.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/fmt.h"
+#include "source/common/common/utility.h"
+#include "source/common/listener_manager/active_tcp_listener.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace ReusePortBpf {
+
+namespace {
+
+// The count of slots without a handler, so that they are never the least loaded.
+constexpr uint64_t UnusedSlotCount = std::numeric_limits<uint64_t>::max();
+// The low bits of the key the program compares, which hold the tie breaker.
+constexpr int32_t TieBreakerBits = 6;
+static_assert(ReusePortBpfConnectionBalancerImpl::MaxSlots == 1 << TieBreakerBits);
+// The stack slot holding the map key.
+constexpr int16_t KeyOffset = -4;
+
+struct bpf_insn instruction(uint8_t code, uint8_t dst, uint8_t src, int16_t off, int32_t imm) {
+  struct bpf_insn result;
+  memset(&result, 0, sizeof(result));
+  result.code = code;
+  result.dst_reg = dst;
+  result.src_reg = src;
+  result.off = off;
+  result.imm = imm;
+  return result;
+}
+
+void loadMapFd(std::vector<struct bpf_insn>& program, uint8_t dst, int map_fd) {
+  // A 64 bit immediate load takes two instructions.
+  program.push_back(instruction(BPF_LD | BPF_DW | BPF_IMM, dst, BPF_PSEUDO_MAP_FD, 0, map_fd));
+  program.push_back(instruction(0, 0, 0, 0, 0));
+}
+
+void zeroAttr(union bpf_attr& attr) { memset(&attr, 0, sizeof(attr)); }
+
+absl::StatusOr<os_fd_t> createMap(uint32_t map_type, uint32_t slots) {
+  union bpf_attr attr;
+  zeroAttr(attr);
+  attr.map_type = map_type;
+  attr.key_size = sizeof(uint32_t);
+  attr.value_size = sizeof(uint64_t);
+  attr.max_entries = slots;
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().bpf(BPF_MAP_CREATE, &attr, sizeof(attr));
+  if (result.return_value_ < 0) {
+    return absl::UnavailableError(
+        fmt::format("failed to create BPF map: {}", errorDetails(result.errno_)));
+  }
+  return result.return_value_;
+}
+
+Api::SysCallIntResult updateElement(os_fd_t map_fd, uint32_t key, uint64_t value) {
+  union bpf_attr attr;
+  zeroAttr(attr);
+  attr.map_fd = map_fd;
+  attr.key = reinterpret_cast<uintptr_t>(&key);
+  attr.value = reinterpret_cast<uintptr_t>(&value);
+  attr.flags = BPF_ANY;
+  return Api::LinuxOsSysCallsSingleton::get().bpf(BPF_MAP_UPDATE_ELEM, &attr, sizeof(attr));
+}
+
+Api::SysCallIntResult deleteElement(os_fd_t map_fd, uint32_t key) {
+  union bpf_attr attr;
+  zeroAttr(attr);
+  attr.map_fd = map_fd;
+  attr.key = reinterpret_cast<uintptr_t>(&key);
+  return Api::LinuxOsSysCallsSingleton::get().bpf(BPF_MAP_DELETE_ELEM, &attr, sizeof(attr));
+}
+
+} // namespace
+
+std::vector<struct bpf_insn> leastConnectionsProgram(int counts_map_fd, int sockets_map_fd,
+                                                     uint32_t slots) {
+  ASSERT(slots <= ReusePortBpfConnectionBalancerImpl::MaxSlots);
+  std::vector<struct bpf_insn> program;
+  // r6 holds the context, r9 the tie breaker, r7 the lowest key so far and r8 its slot.
+  program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_6, BPF_REG_1, 0, 0));
+  program.push_back(instruction(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_9, BPF_REG_1,
+                                offsetof(struct sk_reuseport_md, hash), 0));
+  program.push_back(instruction(BPF_ALU64 | BPF_AND | BPF_K, BPF_REG_9, 0, 0,
+                                ReusePortBpfConnectionBalancerImpl::MaxSlots - 1));
+  program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_7, 0, 0, -1));
+  program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_8, 0, 0, -1));
+
+  // The loop over the slots is unrolled, the key of a slot is its count followed by the slot
+  // xor'ed with the tie breaker.
+  for (uint32_t slot = 0; slot < slots; ++slot) {
+    program.push_back(instruction(BPF_ST | BPF_MEM | BPF_W, BPF_REG_10, 0, KeyOffset, slot));
+    loadMapFd(program, BPF_REG_1, counts_map_fd);
+    program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_2, BPF_REG_10, 0, 0));
+    program.push_back(instruction(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_2, 0, 0, KeyOffset));
+    program.push_back(instruction(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_map_lookup_elem));
+    // Skip the rest of the slot if the lookup failed.
+    program.push_back(instruction(BPF_JMP | BPF_JEQ | BPF_K, BPF_REG_0, 0, 8, 0));
+    program.push_back(instruction(BPF_LDX | BPF_MEM | BPF_DW, BPF_REG_1, BPF_REG_0, 0, 0));
+    program.push_back(instruction(BPF_ALU64 | BPF_LSH | BPF_K, BPF_REG_1, 0, 0, TieBreakerBits));
+    program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_2, BPF_REG_9, 0, 0));
+    program.push_back(instruction(BPF_ALU64 | BPF_XOR | BPF_K, BPF_REG_2, 0, 0, slot));
+    program.push_back(instruction(BPF_ALU64 | BPF_OR | BPF_X, BPF_REG_1, BPF_REG_2, 0, 0));
+    // Skip updating the lowest key unless this one is lower.
+    program.push_back(instruction(BPF_JMP | BPF_JGE | BPF_X, BPF_REG_1, BPF_REG_7, 2, 0));
+    program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_7, BPF_REG_1, 0, 0));
+    program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_8, 0, 0, slot));
+  }
+
+  // Skip the selection if no slot could be looked up.
+  program.push_back(instruction(BPF_JMP | BPF_JEQ | BPF_K, BPF_REG_8, 0, 8, -1));
+  program.push_back(instruction(BPF_STX | BPF_MEM | BPF_W, BPF_REG_10, BPF_REG_8, KeyOffset, 0));
+  program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_1, BPF_REG_6, 0, 0));
+  loadMapFd(program, BPF_REG_2, sockets_map_fd);
+  program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_3, BPF_REG_10, 0, 0));
+  program.push_back(instruction(BPF_ALU64 | BPF_ADD | BPF_K, BPF_REG_3, 0, 0, KeyOffset));
+  program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_4, 0, 0, 0));
+  program.push_back(instruction(BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_sk_select_reuseport));
+  // If nothing was selected, e.g. because the socket of the slot has been closed, passing makes
+  // the kernel fall back to its default selection.
+  program.push_back(instruction(BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, SK_PASS));
+  program.push_back(instruction(BPF_JMP | BPF_EXIT, 0, 0, 0, 0));
+  return program;
+}
+
+absl::StatusOr<std::shared_ptr<ReusePortBpfConnectionBalancerImpl>>
+ReusePortBpfConnectionBalancerImpl::create(uint32_t slots) {
+  if (slots == 0 || slots > MaxSlots) {
+    return absl::InvalidArgumentError(
+        fmt::format("the reuse port BPF balancer supports 1 to {} workers, not {}", MaxSlots,
+                    slots));
+  }
+  // The destructor closes whatever has been created if a later step fails.
+  std::shared_ptr<ReusePortBpfConnectionBalancerImpl> balancer(
+      new ReusePortBpfConnectionBalancerImpl(slots));
+
+  absl::StatusOr<os_fd_t> fd_or_error = createMap(BPF_MAP_TYPE_ARRAY, slots);
+  RETURN_IF_NOT_OK_REF(fd_or_error.status());
+  balancer->counts_map_fd_ = *fd_or_error;
+  for (uint32_t slot = 0; slot < slots; ++slot) {
+    const Api::SysCallIntResult result =
+        updateElement(balancer->counts_map_fd_, slot, UnusedSlotCount);
+    if (result.return_value_ < 0) {
+      return absl::UnavailableError(
+          fmt::format("failed to initialize BPF map: {}", errorDetails(result.errno_)));
+    }
+  }
+
+  fd_or_error = createMap(BPF_MAP_TYPE_REUSEPORT_SOCKARRAY, slots);
+  RETURN_IF_NOT_OK_REF(fd_or_error.status());
+  balancer->sockets_map_fd_ = *fd_or_error;
+
+  const std::vector<struct bpf_insn> program =
+      leastConnectionsProgram(balancer->counts_map_fd_, balancer->sockets_map_fd_, slots);
+  static const char license[] = "Apache-2.0";
+  union bpf_attr attr;
+  zeroAttr(attr);
+  attr.prog_type = BPF_PROG_TYPE_SK_REUSEPORT;
+  attr.insns = reinterpret_cast<uintptr_t>(program.data());
+  attr.insn_cnt = program.size();
+  attr.license = reinterpret_cast<uintptr_t>(license);
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().bpf(BPF_PROG_LOAD, &attr, sizeof(attr));
+  if (result.return_value_ < 0) {
+    return absl::UnavailableError(
+        fmt::format("failed to load BPF program: {}", errorDetails(result.errno_)));
+  }
+  balancer->program_fd_ = result.return_value_;
+  return balancer;
+}
+
+ReusePortBpfConnectionBalancerImpl::ReusePortBpfConnectionBalancerImpl(uint32_t slots)
+    : slots_(slots),
+      handlers_(std::make_unique<std::atomic<Network::BalancedConnectionHandler*>[]>(slots)) {}
+
+ReusePortBpfConnectionBalancerImpl::~ReusePortBpfConnectionBalancerImpl() {
+  // The program stays attached to the reuse port group, which holds its own references to the
+  // program and its maps, until the listen sockets are closed or another program replaces it.
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  for (os_fd_t fd : {program_fd_, sockets_map_fd_, counts_map_fd_}) {
+    if (fd != INVALID_SOCKET) {
+      os_sys_calls.close(fd);
+    }
+  }
+}
+
+void ReusePortBpfConnectionBalancerImpl::registerHandler(
+    Network::BalancedConnectionHandler& handler) {
+  auto* listener = dynamic_cast<Server::ActiveTcpListener*>(&handler);
+  const Network::SocketSharedPtr socket =
+      listener != nullptr ? listener->listen_socket_.lock() : nullptr;
+  if (socket == nullptr || !socket->ioHandle().isOpen()) {
+    ENVOY_LOG(debug, "not balancing a handler without a listen socket");
+    return;
+  }
+
+  absl::MutexLock lock(&lock_);
+  if (attach_failed_) {
+    return;
+  }
+  uint32_t slot = 0;
+  while (slot < slots_ && handlers_[slot].load() != nullptr) {
+    ++slot;
+  }
+  if (slot == slots_) {
+    ENVOY_LOG(warn, "reuse port BPF balancer has no free slot for the listener of {}",
+              listener->dispatcher().name());
+    return;
+  }
+
+  if (!attached_) {
+    // The program applies to the whole reuse port group, any of its sockets can attach it.
+    const Api::SysCallIntResult result = socket->setSocketOption(
+        SOL_SOCKET, SO_ATTACH_REUSEPORT_EBPF, &program_fd_, sizeof(program_fd_));
+    if (result.return_value_ != 0) {
+      ENVOY_LOG(warn,
+                "failed to attach the reuse port BPF program, using the default reuse port "
+                "selection: {}",
+                errorDetails(result.errno_));
+      attach_failed_ = true;
+      return;
+    }
+    attached_ = true;
+  }
+
+  // The count must be in place before the socket can be selected.
+  publishCount(slot, handler.numConnections());
+  const Api::SysCallIntResult result =
+      updateElement(sockets_map_fd_, slot, socket->ioHandle().fdDoNotUse());
+  if (result.return_value_ < 0) {
+    ENVOY_LOG(warn, "failed to add the listen socket of {} to the reuse port BPF balancer: {}",
+              listener->dispatcher().name(), errorDetails(result.errno_));
+    publishCount(slot, UnusedSlotCount);
+    return;
+  }
+  handlers_[slot].store(&handler);
+}
+
+void ReusePortBpfConnectionBalancerImpl::unregisterHandler(
+    Network::BalancedConnectionHandler& handler) {
+  absl::MutexLock lock(&lock_);
+  const uint32_t slot = findSlot(handler);
+  if (slot == slots_) {
+    return;
+  }
+  handlers_[slot].store(nullptr);
+  // The kernel removes the socket itself if it has been closed already.
+  deleteElement(sockets_map_fd_, slot);
+  publishCount(slot, UnusedSlotCount);
+}
+
+Network::BalancedConnectionHandler& ReusePortBpfConnectionBalancerImpl::pickTargetHandler(
+    Network::BalancedConnectionHandler& current_handler) {
+  // The kernel has already picked the socket, and so the handler.
+  current_handler.incNumConnections();
+  const uint32_t slot = findSlot(current_handler);
+  if (slot != slots_) {
+    publishCount(slot, current_handler.numConnections());
+  }
+  return current_handler;
+}
+
+void ReusePortBpfConnectionBalancerImpl::onConnectionClosed(
+    Network::BalancedConnectionHandler& handler) {
+  const uint32_t slot = findSlot(handler);
+  if (slot != slots_) {
+    publishCount(slot, handler.numConnections());
+  }
+}
+
+uint32_t ReusePortBpfConnectionBalancerImpl::findSlot(
+    const Network::BalancedConnectionHandler& handler) const {
+  for (uint32_t slot = 0; slot < slots_; ++slot) {
+    if (handlers_[slot].load(std::memory_order_relaxed) == &handler) {
+      return slot;
+    }
+  }
+  return slots_;
+}
+
+void ReusePortBpfConnectionBalancerImpl::publishCount(uint32_t slot, uint64_t count) {
+  const Api::SysCallIntResult result = updateElement(counts_map_fd_, slot, count);
+  if (result.return_value_ < 0) {
+    ENVOY_LOG(debug, "failed to update the connection count of slot {}: {}", slot,
+              errorDetails(result.errno_));
+  }
+}
+
+} // namespace ReusePortBpf
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <linux/bpf.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "envoy/common/platform.h"
+#include "envoy/network/connection_balancer.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace ReusePortBpf {
+
+/**
+ * Build the SK_REUSEPORT program that selects, from the sockets in the sockets map, the one whose
+ * slot has the lowest connection count in the counts map. Ties are broken with the hash of the
+ * connection so that connections arriving in a burst, before the counts have been updated, are
+ * still spread. The kernel's default selection is used if no socket can be selected.
+ * @param counts_map_fd supplies an array map of uint64_t connection counts, indexed by slot.
+ * @param sockets_map_fd supplies a reuse port socket array map, indexed by slot.
+ * @param slots supplies the number of slots of both maps, at most MaxSlots.
+ */
+std::vector<struct bpf_insn> leastConnectionsProgram(int counts_map_fd, int sockets_map_fd,
+                                                     uint32_t slots);
+
+/**
+ * Connection balancer that steers new connections to the listen socket of the worker with the
+ * fewest connections with a BPF program attached to the SO_REUSEPORT group of the listener's
+ * sockets. Every registered handler gets a slot, under which its socket and its connection count
+ * are stored in BPF maps. The count is updated by the handler's worker as it accepts and closes
+ * connections, so no connection is moved between workers once accepted.
+ *
+ * Handlers that are not TCP listeners with their own listen socket are not balanced.
+ */
+class ReusePortBpfConnectionBalancerImpl : public Network::ConnectionBalancer,
+                                           Logger::Loggable<Logger::Id::conn_handler> {
+public:
+  // The number of slots is limited by the number of instructions the verifier of older kernels
+  // accepts, and by the bits of the key that are used for breaking ties.
+  static constexpr uint32_t MaxSlots = 64;
+
+  /**
+   * Create the maps and load the program.
+   * @param slots supplies the number of handlers that can be balanced, typically the number of
+   *        workers.
+   * @return the balancer, or an error if the kernel doesn't support or permit the program.
+   */
+  static absl::StatusOr<std::shared_ptr<ReusePortBpfConnectionBalancerImpl>>
+  create(uint32_t slots);
+
+  ~ReusePortBpfConnectionBalancerImpl() override;
+
+  // Network::ConnectionBalancer
+  void registerHandler(Network::BalancedConnectionHandler& handler) override;
+  void unregisterHandler(Network::BalancedConnectionHandler& handler) override;
+  Network::BalancedConnectionHandler&
+  pickTargetHandler(Network::BalancedConnectionHandler& current_handler) override;
+  void onConnectionClosed(Network::BalancedConnectionHandler& handler) override;
+
+private:
+  explicit ReusePortBpfConnectionBalancerImpl(uint32_t slots);
+
+  // Returns the slot of a registered handler, or slots_ if the handler is not balanced. This is
+  // called on every accept and close, so it does not take the lock.
+  uint32_t findSlot(const Network::BalancedConnectionHandler& handler) const;
+  void publishCount(uint32_t slot, uint64_t count);
+
+  const uint32_t slots_;
+  os_fd_t counts_map_fd_{INVALID_SOCKET};
+  os_fd_t sockets_map_fd_{INVALID_SOCKET};
+  os_fd_t program_fd_{INVALID_SOCKET};
+  // The handler of every slot, nullptr for free slots.
+  const std::unique_ptr<std::atomic<Network::BalancedConnectionHandler*>[]> handlers_;
+  // Serializes the registration of handlers, which happens on each worker.
+  absl::Mutex lock_;
+  bool attached_ ABSL_GUARDED_BY(lock_){};
+  bool attach_failed_ ABSL_GUARDED_BY(lock_){};
+};
+
+} // namespace ReusePortBpf
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
@@ -52,6 +52,7 @@ DnsResolverImpl::DnsResolverImpl(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, query_tries, DEFAULT_QUERY_TRIES))),
       rotate_nameservers_(config.rotate_nameservers()), resolvers_csv_(resolvers_csv),
       filter_unroutable_families_(config.filter_unroutable_families()),
+      coalesce_queries_(config.coalesce_queries()),
       scope_(root_scope.createScope("dns.cares.")), stats_(generateCaresDnsResolverStats(*scope_)) {
   AresOptions options = defaultAresOptions();
   initializeChannel(&options.options_, options.optmask_);
@@ -326,28 +327,20 @@ void DnsResolverImpl::PendingResolution::finishResolve() {
                   "dns resolution for {} completed with status {}", dns_name_,
                   static_cast<int>(pending_response_.status_));
 
-  if (!cancelled_) {
-    // Use a raw try here because it is used in both main thread and filter.
-    // Can not convert to use status code as there may be unexpected exceptions in server fuzz
-    // tests, which must be handled. Potential exception may come from getAddressWithPort() or
-    // portFromTcpUrl().
-    // TODO(chaoqin-li1123): remove try catch pattern here once we figure how to handle unexpected
-    // exception in fuzz tests.
-    TRY_NEEDS_AUDIT {
-      callback_(pending_response_.status_, std::move(pending_response_.details_),
-                std::move(pending_response_.address_list_));
+  // Queries issued by the callbacks start a new resolution.
+  if (coalescing_) {
+    parent_.coalescing_resolutions_.erase(std::make_pair(dns_name_, dns_lookup_family_));
+    coalescing_ = false;
+  }
+  // The coalesced queries get copies of the response, which the query which was sent then takes.
+  for (const CoalescedQueryPtr& query : coalesced_queries_) {
+    if (!query->cancelled_) {
+      invokeCallback(query->callback_, std::list<DnsResponse>(pending_response_.address_list_));
     }
-    END_TRY
-    MULTI_CATCH(
-        const EnvoyException& e,
-        {
-          ENVOY_LOG(critical, "EnvoyException in c-ares callback: {}", e.what());
-          dispatcher_.post([s = std::string(e.what())] { throw EnvoyException(s); });
-        },
-        {
-          ENVOY_LOG(critical, "Unknown exception in c-ares callback");
-          dispatcher_.post([] { throw EnvoyException("unknown"); });
-        });
+  }
+
+  if (!cancelled_) {
+    invokeCallback(callback_, std::move(pending_response_.address_list_));
   } else {
     ENVOY_LOG_EVENT(debug, "cares_dns_callback_cancelled",
                     "dns resolution callback for {} not issued. Cancelled with reason={}",
@@ -359,6 +352,30 @@ void DnsResolverImpl::PendingResolution::finishResolve() {
   }
 }
 
+void DnsResolverImpl::PendingResolution::invokeCallback(const ResolveCb& callback,
+                                                        std::list<DnsResponse>&& address_list) {
+  // Use a raw try here because it is used in both main thread and filter.
+  // Can not convert to use status code as there may be unexpected exceptions in server fuzz
+  // tests, which must be handled. Potential exception may come from getAddressWithPort() or
+  // portFromTcpUrl().
+  // TODO(chaoqin-li1123): remove try catch pattern here once we figure how to handle unexpected
+  // exception in fuzz tests.
+  TRY_NEEDS_AUDIT {
+    callback(pending_response_.status_, pending_response_.details_, std::move(address_list));
+  }
+  END_TRY
+  MULTI_CATCH(
+      const EnvoyException& e,
+      {
+        ENVOY_LOG(critical, "EnvoyException in c-ares callback: {}", e.what());
+        dispatcher_.post([s = std::string(e.what())] { throw EnvoyException(s); });
+      },
+      {
+        ENVOY_LOG(critical, "Unknown exception in c-ares callback");
+        dispatcher_.post([] { throw EnvoyException("unknown"); });
+      });
+}
+
 void DnsResolverImpl::updateAresTimer() {
   // Update the timeout for events.
   timeval timeout;
@@ -420,6 +437,17 @@ ActiveDnsQuery* DnsResolverImpl::resolve(const std::string& dns_name,
     initializeChannel(&options.options_, options.optmask_);
   }
 
+  if (coalesce_queries_) {
+    const auto it = coalescing_resolutions_.find(std::make_pair(dns_name, dns_lookup_family));
+    if (it != coalescing_resolutions_.end()) {
+      ENVOY_LOG_EVENT(debug, "cares_dns_resolution_coalesced",
+                      "dns resolution for {} coalesced with the one in flight", dns_name);
+      stats_.resolve_coalesced_.inc();
+      it->second->coalesced_queries_.push_back(std::make_unique<CoalescedQuery>(callback));
+      return it->second->coalesced_queries_.back().get();
+    }
+  }
+
   auto pending_resolution = std::make_unique<AddrInfoPendingResolution>(
       *this, callback, dispatcher_, channel_, dns_name, dns_lookup_family);
   pending_resolution->startResolution();
@@ -435,6 +463,11 @@ ActiveDnsQuery* DnsResolverImpl::resolve(const std::string& dns_name,
     // if ~DnsResolverImpl() happens via ares_destroy() and subsequent handling of ARES_EDESTRUCTION
     // in DnsResolverImpl::PendingResolution::onAresGetAddrInfoCallback()).
     pending_resolution->owned_ = true;
+    if (coalesce_queries_) {
+      pending_resolution->coalescing_ = true;
+      coalescing_resolutions_.emplace(std::make_pair(dns_name, dns_lookup_family),
+                                      pending_resolution.get());
+    }
     return pending_resolution.release();
   }
 }
@@ -457,8 +490,8 @@ void DnsResolverImpl::chargeGetAddrInfoErrorStats(int status, int timeouts) {
 DnsResolverImpl::AddrInfoPendingResolution::AddrInfoPendingResolution(
     DnsResolverImpl& parent, ResolveCb callback, Event::Dispatcher& dispatcher,
     ares_channel channel, const std::string& dns_name, DnsLookupFamily dns_lookup_family)
-    : PendingResolution(parent, callback, dispatcher, channel, dns_name),
-      dns_lookup_family_(dns_lookup_family), available_interfaces_(availableInterfaces()) {
+    : PendingResolution(parent, callback, dispatcher, channel, dns_name, dns_lookup_family),
+      available_interfaces_(availableInterfaces()) {
   if (dns_lookup_family == DnsLookupFamily::Auto ||
       dns_lookup_family == DnsLookupFamily::V4Preferred) {
     dual_resolution_ = true;
@@ -14,6 +14,7 @@
 #include "source/common/common/utility.h"
 #include "source/common/network/dns_resolver/dns_factory_util.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "ares.h"
 
@@ -25,6 +26,7 @@ namespace Network {
  */
 #define ALL_CARES_DNS_RESOLVER_STATS(COUNTER, GAUGE)                                               \
   COUNTER(resolve_total)                                                                           \
+  COUNTER(resolve_coalesced)                                                                       \
   GAUGE(pending_resolutions, NeverImport)                                                          \
   COUNTER(not_found)                                                                               \
   COUNTER(get_addr_failure)                                                                        \
@@ -66,6 +68,23 @@ public:
 
 private:
   friend class DnsResolverImplPeer;
+
+  // A query which completes with the response to an identical query in flight.
+  class CoalescedQuery : public ActiveDnsQuery {
+  public:
+    explicit CoalescedQuery(ResolveCb callback) : callback_(std::move(callback)) {}
+
+    // Network::ActiveDnsQuery
+    void cancel(CancelReason) override { cancelled_ = true; }
+    void addTrace(uint8_t) override {}
+    std::string getTraces() override { return {}; }
+
+    const ResolveCb callback_;
+    bool cancelled_ = false;
+  };
+
+  using CoalescedQueryPtr = std::unique_ptr<CoalescedQuery>;
+
   class PendingResolution : public ActiveDnsQuery {
   public:
     // Network::ActiveDnsQuery
@@ -84,15 +103,21 @@ private:
     bool owned_ = false;
     // Has the query completed? Only meaningful if !owned_;
     bool completed_ = false;
+    // Whether identical queries can still be coalesced with this one.
+    bool coalescing_ = false;
+    // The queries coalesced with this one, which complete with it.
+    std::list<CoalescedQueryPtr> coalesced_queries_;
 
   protected:
     // Network::ActiveDnsQuery
     PendingResolution(DnsResolverImpl& parent, ResolveCb callback, Event::Dispatcher& dispatcher,
-                      ares_channel channel, const std::string& dns_name)
+                      ares_channel channel, const std::string& dns_name,
+                      DnsLookupFamily dns_lookup_family)
         : parent_(parent), callback_(callback), dispatcher_(dispatcher), channel_(channel),
-          dns_name_(dns_name) {}
+          dns_name_(dns_name), dns_lookup_family_(dns_lookup_family) {}
 
     void finishResolve();
+    void invokeCallback(const ResolveCb& callback, std::list<DnsResponse>&& address_list);
 
     DnsResolverImpl& parent_;
     // Caller supplied callback to invoke on query completion or error.
@@ -103,6 +128,7 @@ private:
     bool cancelled_ = false;
     const ares_channel channel_;
     const std::string dns_name_;
+    const DnsLookupFamily dns_lookup_family_;
     CancelReason cancel_reason_;
 
     // Small wrapping struct to accumulate addresses from firings of the
@@ -164,7 +190,6 @@ private:
     // all concurrent queries are unwound before cleaning up the resolution.
     uint32_t pending_resolutions_ = 0;
     int family_ = AF_INET;
-    const DnsLookupFamily dns_lookup_family_;
     // Queried for at construction time.
     const AvailableInterfaces available_interfaces_;
   };
@@ -204,6 +229,10 @@ private:
   const bool rotate_nameservers_;
   const absl::optional<std::string> resolvers_csv_;
   const bool filter_unroutable_families_;
+  const bool coalesce_queries_;
+  // The resolutions in flight with which identical queries are coalesced.
+  absl::flat_hash_map<std::pair<std::string, DnsLookupFamily>, PendingResolution*>
+      coalescing_resolutions_;
   Stats::ScopeSharedPtr scope_;
   CaresDnsResolverStats stats_;
 };
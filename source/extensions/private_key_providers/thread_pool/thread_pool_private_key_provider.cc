@@ -0,0 +1,323 @@
+#include "source/extensions/private_key_providers/thread_pool/thread_pool_private_key_provider.h"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+#include "source/common/config/datasource.h"
+#include "source/common/protobuf/utility.h"
+
+#include "openssl/rsa.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+namespace {
+
+ThreadPoolPrivateKeyStats generateStats(Stats::Scope& scope) {
+  return ThreadPoolPrivateKeyStats{ALL_THREAD_POOL_PRIVATE_KEY_STATS(
+      POOL_COUNTER_PREFIX(scope, "thread_pool_private_key"),
+      POOL_GAUGE_PREFIX(scope, "thread_pool_private_key"))};
+}
+
+bool sign(EVP_PKEY& pkey, uint16_t signature_algorithm, const std::vector<uint8_t>& in,
+          std::vector<uint8_t>& out) {
+  if (EVP_PKEY_id(&pkey) != SSL_get_signature_algorithm_key_type(signature_algorithm)) {
+    return false;
+  }
+  const EVP_MD* md = SSL_get_signature_algorithm_digest(signature_algorithm);
+  if (md == nullptr) {
+    return false;
+  }
+
+  bssl::ScopedEVP_MD_CTX ctx;
+  EVP_PKEY_CTX* pkey_ctx;
+  if (!EVP_DigestSignInit(ctx.get(), &pkey_ctx, md, nullptr, &pkey)) {
+    return false;
+  }
+  if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm) &&
+      (!EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) ||
+       !EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1))) {
+    return false;
+  }
+
+  size_t out_len = EVP_PKEY_size(&pkey);
+  out.resize(out_len);
+  if (!EVP_DigestSign(ctx.get(), out.data(), &out_len, in.data(), in.size())) {
+    return false;
+  }
+  out.resize(out_len);
+  return true;
+}
+
+bool decrypt(EVP_PKEY& pkey, const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+  RSA* rsa = EVP_PKEY_get0_RSA(&pkey);
+  if (rsa == nullptr) {
+    return false;
+  }
+  size_t out_len = RSA_size(rsa);
+  out.resize(out_len);
+  if (!RSA_decrypt(rsa, &out_len, out.data(), out.size(), in.data(), in.size(), RSA_NO_PADDING)) {
+    return false;
+  }
+  out.resize(out_len);
+  return true;
+}
+
+ThreadPoolPrivateKeyConnection* connection(SSL* ssl) {
+  return static_cast<ThreadPoolPrivateKeyConnection*>(
+      SSL_get_ex_data(ssl, ThreadPoolPrivateKeyMethodProvider::connectionIndex()));
+}
+
+ssl_private_key_result_t privateKeySign(SSL* ssl, uint8_t* out, size_t* out_len, size_t max_out,
+                                        uint16_t signature_algorithm, const uint8_t* in,
+                                        size_t in_len) {
+  ThreadPoolPrivateKeyConnection* ops = connection(ssl);
+  if (ops == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return ops->start(KeyOperation::Type::Sign, signature_algorithm, in, in_len, out, out_len,
+                    max_out);
+}
+
+ssl_private_key_result_t privateKeyDecrypt(SSL* ssl, uint8_t* out, size_t* out_len,
+                                           size_t max_out, const uint8_t* in, size_t in_len) {
+  ThreadPoolPrivateKeyConnection* ops = connection(ssl);
+  if (ops == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return ops->start(KeyOperation::Type::Decrypt, 0, in, in_len, out, out_len, max_out);
+}
+
+ssl_private_key_result_t privateKeyComplete(SSL* ssl, uint8_t* out, size_t* out_len,
+                                            size_t max_out) {
+  ThreadPoolPrivateKeyConnection* ops = connection(ssl);
+  if (ops == nullptr) {
+    return ssl_private_key_failure;
+  }
+  return ops->complete(out, out_len, max_out);
+}
+
+int createIndex() {
+  int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  RELEASE_ASSERT(index >= 0, "Failed to get SSL user data index.");
+  return index;
+}
+
+} // namespace
+
+void KeyOperation::run(EVP_PKEY& pkey) {
+  switch (type_) {
+  case Type::Sign:
+    succeeded_ = sign(pkey, signature_algorithm_, input_, output_);
+    break;
+  case Type::Decrypt:
+    succeeded_ = decrypt(pkey, input_, output_);
+    break;
+  }
+}
+
+void KeyOperation::postCompletion(const std::shared_ptr<KeyOperation>& self) {
+  absl::MutexLock lock(&mutex_);
+  if (dispatcher_ != nullptr) {
+    dispatcher_->post([self]() { self->onComplete(); });
+  }
+}
+
+void KeyOperation::cancel() {
+  absl::MutexLock lock(&mutex_);
+  dispatcher_ = nullptr;
+}
+
+bool KeyOperation::cancelled() {
+  absl::MutexLock lock(&mutex_);
+  return dispatcher_ == nullptr;
+}
+
+void KeyOperation::onComplete() {
+  if (cancelled()) {
+    return;
+  }
+  done_ = true;
+  cb_.onPrivateKeyMethodComplete();
+}
+
+KeyOperationPool::KeyOperationPool(bssl::UniquePtr<EVP_PKEY> pkey, uint32_t thread_count,
+                                   uint32_t max_queued_operations,
+                                   Thread::ThreadFactory& thread_factory,
+                                   ThreadPoolPrivateKeyStats& stats)
+    : pkey_(std::move(pkey)), max_queued_operations_(max_queued_operations), stats_(stats) {
+  if (thread_count == 0) {
+    thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  ENVOY_LOG(debug, "starting {} private key operation threads", thread_count);
+  for (uint32_t i = 0; i < thread_count; i++) {
+    threads_.push_back(thread_factory.createThread([this]() { threadRoutine(); }));
+  }
+}
+
+KeyOperationPool::~KeyOperationPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    terminate_ = true;
+  }
+  for (auto& thread : threads_) {
+    thread->join();
+  }
+  absl::MutexLock lock(&mutex_);
+  stats_.queued_operations_.sub(queue_.size());
+}
+
+bool KeyOperationPool::enqueue(KeyOperationSharedPtr operation) {
+  absl::MutexLock lock(&mutex_);
+  if (queue_.size() >= max_queued_operations_) {
+    return false;
+  }
+  queue_.push(std::move(operation));
+  stats_.queued_operations_.inc();
+  return true;
+}
+
+void KeyOperationPool::threadRoutine() {
+  while (true) {
+    KeyOperationSharedPtr operation;
+    {
+      absl::MutexLock lock(&mutex_);
+      auto condition = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+        return terminate_ || !queue_.empty();
+      };
+      mutex_.Await(absl::Condition(&condition));
+      if (terminate_) {
+        return;
+      }
+      operation = std::move(queue_.front());
+      queue_.pop();
+      stats_.queued_operations_.dec();
+    }
+    // The handshakes of closed connections need no signature.
+    if (operation->cancelled()) {
+      continue;
+    }
+    operation->run(*pkey_);
+    operation->postCompletion(operation);
+  }
+}
+
+ThreadPoolPrivateKeyConnection::~ThreadPoolPrivateKeyConnection() {
+  if (operation_ != nullptr) {
+    operation_->cancel();
+  }
+}
+
+ssl_private_key_result_t ThreadPoolPrivateKeyConnection::start(KeyOperation::Type type,
+                                                               uint16_t signature_algorithm,
+                                                               const uint8_t* in, size_t in_len,
+                                                               uint8_t* out, size_t* out_len,
+                                                               size_t max_out) {
+  if (operation_ != nullptr) {
+    return ssl_private_key_failure;
+  }
+  auto operation =
+      std::make_shared<KeyOperation>(type, signature_algorithm, in, in_len, dispatcher_, cb_);
+  if (pool_.enqueue(operation)) {
+    stats_.offloaded_operations_.inc();
+    operation_ = std::move(operation);
+    return ssl_private_key_retry;
+  }
+
+  // Rather than queueing without bound while a burst of handshakes outpaces the pool, the worker
+  // thread does the operation itself.
+  stats_.inline_operations_.inc();
+  operation->run(pool_.privateKey());
+  return copyResult(*operation, out, out_len, max_out);
+}
+
+ssl_private_key_result_t ThreadPoolPrivateKeyConnection::complete(uint8_t* out, size_t* out_len,
+                                                                  size_t max_out) {
+  if (operation_ == nullptr) {
+    return ssl_private_key_failure;
+  }
+  if (!operation_->done_) {
+    return ssl_private_key_retry;
+  }
+  KeyOperationSharedPtr operation = std::move(operation_);
+  return copyResult(*operation, out, out_len, max_out);
+}
+
+ssl_private_key_result_t ThreadPoolPrivateKeyConnection::copyResult(const KeyOperation& operation,
+                                                                    uint8_t* out, size_t* out_len,
+                                                                    size_t max_out) {
+  if (!operation.succeeded_ || operation.output_.size() > max_out) {
+    stats_.failed_operations_.inc();
+    return ssl_private_key_failure;
+  }
+  std::copy(operation.output_.begin(), operation.output_.end(), out);
+  *out_len = operation.output_.size();
+  return ssl_private_key_success;
+}
+
+ThreadPoolPrivateKeyMethodProvider::ThreadPoolPrivateKeyMethodProvider(
+    const envoy::extensions::private_key_providers::thread_pool::v3::
+        ThreadPoolPrivateKeyMethodConfig& config,
+    Server::Configuration::TransportSocketFactoryContext& factory_context)
+    : stats_(generateStats(factory_context.statsScope())) {
+  Api::Api& api = factory_context.serverFactoryContext().api();
+  const std::string private_key = THROW_OR_RETURN_VALUE(
+      Config::DataSource::read(config.private_key(), false, api), std::string);
+
+  bssl::UniquePtr<BIO> bio(
+      BIO_new_mem_buf(const_cast<char*>(private_key.data()), private_key.size()));
+  bssl::UniquePtr<EVP_PKEY> pkey(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  if (pkey == nullptr) {
+    throw EnvoyException("Failed to read private key.");
+  }
+  if (EVP_PKEY_id(pkey.get()) != EVP_PKEY_RSA && EVP_PKEY_id(pkey.get()) != EVP_PKEY_EC) {
+    throw EnvoyException("Not supported key type, only EC and RSA are supported.");
+  }
+
+  method_ = std::make_shared<SSL_PRIVATE_KEY_METHOD>();
+  method_->sign = privateKeySign;
+  method_->decrypt = privateKeyDecrypt;
+  method_->complete = privateKeyComplete;
+
+  pool_ = std::make_unique<KeyOperationPool>(
+      std::move(pkey), config.thread_count(),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_queued_operations, 1024), api.threadFactory(),
+      stats_);
+}
+
+void ThreadPoolPrivateKeyMethodProvider::registerPrivateKeyMethod(
+    SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher& dispatcher) {
+  if (SSL_get_ex_data(ssl, connectionIndex()) != nullptr) {
+    throw EnvoyException("Not registering the thread pool provider twice for same context");
+  }
+  SSL_set_ex_data(ssl, connectionIndex(),
+                  new ThreadPoolPrivateKeyConnection(cb, dispatcher, *pool_, stats_));
+}
+
+void ThreadPoolPrivateKeyMethodProvider::unregisterPrivateKeyMethod(SSL* ssl) {
+  ThreadPoolPrivateKeyConnection* ops = connection(ssl);
+  SSL_set_ex_data(ssl, connectionIndex(), nullptr);
+  delete ops;
+}
+
+bool ThreadPoolPrivateKeyMethodProvider::checkFips() {
+  EVP_PKEY& pkey = pool_->privateKey();
+  if (EVP_PKEY_id(&pkey) == EVP_PKEY_RSA) {
+    return RSA_check_fips(EVP_PKEY_get0_RSA(&pkey)) != 0;
+  }
+  return EC_KEY_check_fips(EVP_PKEY_get0_EC_KEY(&pkey)) != 0;
+}
+
+int ThreadPoolPrivateKeyMethodProvider::connectionIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, createIndex());
+}
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
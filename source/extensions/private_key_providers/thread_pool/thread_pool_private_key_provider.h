@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include "envoy/api/api.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/extensions/private_key_providers/thread_pool/v3/thread_pool.pb.h"
+#include "envoy/server/transport_socket_config.h"
+#include "envoy/ssl/private_key/private_key.h"
+#include "envoy/ssl/private_key/private_key_config.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread/thread.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+#define ALL_THREAD_POOL_PRIVATE_KEY_STATS(COUNTER, GAUGE)                                          \
+  COUNTER(failed_operations)                                                                       \
+  COUNTER(inline_operations)                                                                       \
+  COUNTER(offloaded_operations)                                                                    \
+  GAUGE(queued_operations, Accumulate)
+
+/**
+ * Thread pool private key provider stats. @see stats_macros.h
+ */
+struct ThreadPoolPrivateKeyStats {
+  ALL_THREAD_POOL_PRIVATE_KEY_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+// A sign or decrypt operation of a TLS handshake. The input and the result are handed over between
+// the worker thread and a thread of the pool through the queue of the pool and the post of the
+// completion to the dispatcher of the worker thread.
+class KeyOperation {
+public:
+  enum class Type { Sign, Decrypt };
+
+  KeyOperation(Type type, uint16_t signature_algorithm, const uint8_t* in, size_t in_len,
+               Event::Dispatcher& dispatcher, Ssl::PrivateKeyConnectionCallbacks& cb)
+      : type_(type), signature_algorithm_(signature_algorithm), input_(in, in + in_len), cb_(cb),
+        dispatcher_(&dispatcher) {}
+
+  // Performs the operation with the key, on any thread.
+  void run(EVP_PKEY& pkey);
+
+  // Runs onComplete() on the worker thread, unless the operation was cancelled. Called from the
+  // thread of the pool which ran the operation.
+  void postCompletion(const std::shared_ptr<KeyOperation>& self) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Called on the worker thread when the connection goes away.
+  void cancel() ABSL_LOCKS_EXCLUDED(mutex_);
+  bool cancelled() ABSL_LOCKS_EXCLUDED(mutex_);
+
+  const Type type_;
+  const uint16_t signature_algorithm_;
+  const std::vector<uint8_t> input_;
+  std::vector<uint8_t> output_;
+  bool succeeded_{};
+  // Only used on the worker thread.
+  bool done_{};
+
+private:
+  void onComplete();
+
+  Ssl::PrivateKeyConnectionCallbacks& cb_;
+  absl::Mutex mutex_;
+  // Reset once the operation is cancelled, so that nothing is posted to a worker thread which may
+  // no longer exist.
+  Event::Dispatcher* dispatcher_ ABSL_GUARDED_BY(mutex_);
+};
+
+using KeyOperationSharedPtr = std::shared_ptr<KeyOperation>;
+
+// The threads performing the key operations of a provider, shared by all worker threads.
+class KeyOperationPool : public Logger::Loggable<Logger::Id::connection> {
+public:
+  KeyOperationPool(bssl::UniquePtr<EVP_PKEY> pkey, uint32_t thread_count,
+                   uint32_t max_queued_operations, Thread::ThreadFactory& thread_factory,
+                   ThreadPoolPrivateKeyStats& stats);
+  ~KeyOperationPool() ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Queues an operation for the threads of the pool.
+  // @return false if too many operations are queued already.
+  bool enqueue(KeyOperationSharedPtr operation) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  EVP_PKEY& privateKey() { return *pkey_; }
+
+private:
+  void threadRoutine() ABSL_LOCKS_EXCLUDED(mutex_);
+
+  const bssl::UniquePtr<EVP_PKEY> pkey_;
+  const uint32_t max_queued_operations_;
+  ThreadPoolPrivateKeyStats& stats_;
+  absl::Mutex mutex_;
+  std::queue<KeyOperationSharedPtr> queue_ ABSL_GUARDED_BY(mutex_);
+  bool terminate_ ABSL_GUARDED_BY(mutex_){};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+// The private key operation in flight on an SSL connection, if any.
+class ThreadPoolPrivateKeyConnection {
+public:
+  ThreadPoolPrivateKeyConnection(Ssl::PrivateKeyConnectionCallbacks& cb,
+                                 Event::Dispatcher& dispatcher, KeyOperationPool& pool,
+                                 ThreadPoolPrivateKeyStats& stats)
+      : cb_(cb), dispatcher_(dispatcher), pool_(pool), stats_(stats) {}
+  ~ThreadPoolPrivateKeyConnection();
+
+  ssl_private_key_result_t start(KeyOperation::Type type, uint16_t signature_algorithm,
+                                 const uint8_t* in, size_t in_len, uint8_t* out, size_t* out_len,
+                                 size_t max_out);
+  ssl_private_key_result_t complete(uint8_t* out, size_t* out_len, size_t max_out);
+
+private:
+  ssl_private_key_result_t copyResult(const KeyOperation& operation, uint8_t* out,
+                                      size_t* out_len, size_t max_out);
+
+  Ssl::PrivateKeyConnectionCallbacks& cb_;
+  Event::Dispatcher& dispatcher_;
+  KeyOperationPool& pool_;
+  ThreadPoolPrivateKeyStats& stats_;
+  KeyOperationSharedPtr operation_;
+};
+
+// ThreadPoolPrivateKeyMethodProvider performs the private key operations of SSL sockets on a
+// thread pool.
+class ThreadPoolPrivateKeyMethodProvider : public virtual Ssl::PrivateKeyMethodProvider,
+                                           public Logger::Loggable<Logger::Id::connection> {
+public:
+  ThreadPoolPrivateKeyMethodProvider(
+      const envoy::extensions::private_key_providers::thread_pool::v3::
+          ThreadPoolPrivateKeyMethodConfig& config,
+      Server::Configuration::TransportSocketFactoryContext& factory_context);
+
+  // Ssl::PrivateKeyMethodProvider
+  void registerPrivateKeyMethod(SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb,
+                                Event::Dispatcher& dispatcher) override;
+  void unregisterPrivateKeyMethod(SSL* ssl) override;
+  bool checkFips() override;
+  bool isAvailable() override { return true; }
+  Ssl::BoringSslPrivateKeyMethodSharedPtr getBoringSslPrivateKeyMethod() override {
+    return method_;
+  }
+
+  static int connectionIndex();
+
+private:
+  ThreadPoolPrivateKeyStats stats_;
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  std::unique_ptr<KeyOperationPool> pool_;
+};
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -14,8 +14,8 @@ namespace FixedHeapMonitor {
 
 Server::ResourceMonitorPtr FixedHeapMonitorFactory::createResourceMonitorFromProtoTyped(
     const envoy::extensions::resource_monitors::fixed_heap::v3::FixedHeapConfig& config,
-    Server::Configuration::ResourceMonitorFactoryContext& /*unused_context*/) {
-  return std::make_unique<FixedHeapMonitor>(config);
+    Server::Configuration::ResourceMonitorFactoryContext& context) {
+  return std::make_unique<FixedHeapMonitor>(config, context.api().timeSource());
 }
 
 /**
@@ -4,6 +4,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/memory/stats.h"
+#include "source/common/protobuf/utility.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -18,11 +19,37 @@ uint64_t MemoryStatsReader::freeMappedHeapBytes() { return Memory::Stats::totalP
 
 FixedHeapMonitor::FixedHeapMonitor(
     const envoy::extensions::resource_monitors::fixed_heap::v3::FixedHeapConfig& config,
-    std::unique_ptr<MemoryStatsReader> stats)
-    : max_heap_(config.max_heap_size_bytes()), stats_(std::move(stats)) {
+    TimeSource& time_source, std::unique_ptr<MemoryStatsReader> stats)
+    : max_heap_(config.max_heap_size_bytes()),
+      growth_lookahead_(config.has_growth_lookahead()
+                            ? absl::make_optional(std::chrono::milliseconds(
+                                  PROTOBUF_GET_MS_REQUIRED(config, growth_lookahead)))
+                            : absl::nullopt),
+      time_source_(time_source), stats_(std::move(stats)) {
   ASSERT(max_heap_ > 0);
 }
 
+double FixedHeapMonitor::projectUsage(size_t used) {
+  if (!growth_lookahead_.has_value()) {
+    return used;
+  }
+
+  const MonotonicTime now = time_source_.monotonicTime();
+  double projected = used;
+  if (last_update_time_.has_value() && now > *last_update_time_ && used > last_used_) {
+    const double elapsed =
+        std::chrono::duration_cast<std::chrono::duration<double>>(now - *last_update_time_)
+            .count();
+    const double bytes_per_second = (used - last_used_) / elapsed;
+    projected +=
+        bytes_per_second *
+        std::chrono::duration_cast<std::chrono::duration<double>>(*growth_lookahead_).count();
+  }
+  last_update_time_ = now;
+  last_used_ = used;
+  return projected;
+}
+
 void FixedHeapMonitor::updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) {
 
   auto computeUsedMemory = [this]() -> size_t {
@@ -36,7 +63,7 @@ void FixedHeapMonitor::updateResourceUsage(Server::ResourceUpdateCallbacks& call
   const size_t used = computeUsedMemory();
 
   Server::ResourceUsage usage;
-  usage.resource_pressure_ = used / static_cast<double>(max_heap_);
+  usage.resource_pressure_ = projectUsage(used) / static_cast<double>(max_heap_);
 
   ENVOY_LOG_MISC(trace, "FixedHeapMonitor: used={}, max_heap={}, pressure={}", used, max_heap_,
                  usage.resource_pressure_);
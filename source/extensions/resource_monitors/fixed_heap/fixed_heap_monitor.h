@@ -1,8 +1,13 @@
 #pragma once
 
+#include <chrono>
+
+#include "envoy/common/time.h"
 #include "envoy/extensions/resource_monitors/fixed_heap/v3/fixed_heap.pb.h"
 #include "envoy/server/resource_monitor.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace ResourceMonitors {
@@ -31,13 +36,23 @@ class FixedHeapMonitor : public Server::ResourceMonitor {
 public:
   FixedHeapMonitor(
       const envoy::extensions::resource_monitors::fixed_heap::v3::FixedHeapConfig& config,
+      TimeSource& time_source,
       std::unique_ptr<MemoryStatsReader> stats = std::make_unique<MemoryStatsReader>());
 
   void updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) override;
 
 private:
+  // @return the usage projected after the growth lookahead, or the used bytes if the usage is not
+  //         growing or there is no lookahead.
+  double projectUsage(size_t used);
+
   const uint64_t max_heap_;
+  const absl::optional<std::chrono::milliseconds> growth_lookahead_;
+  TimeSource& time_source_;
   std::unique_ptr<MemoryStatsReader> stats_;
+  // The time and used bytes of the previous update, from which the growth rate is computed.
+  absl::optional<MonotonicTime> last_update_time_;
+  size_t last_used_{};
 };
 
 } // namespace FixedHeapMonitor
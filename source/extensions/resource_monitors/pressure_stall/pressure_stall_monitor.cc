@@ -0,0 +1,103 @@
+#include "source/extensions/resource_monitors/pressure_stall/pressure_stall_monitor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/fmt.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace PressureStallMonitor {
+
+namespace {
+
+constexpr double DEFAULT_SMOOTHING_FACTOR = 0.5;
+constexpr absl::string_view TOTAL_FIELD = "total=";
+
+std::string pressureFile(
+    const envoy::extensions::resource_monitors::pressure_stall::v3::PressureStallConfig& config) {
+  using Config = envoy::extensions::resource_monitors::pressure_stall::v3::PressureStallConfig;
+  const std::string& cgroup_path =
+      config.cgroup_path().empty() ? LINUX_CGROUP_PATH : config.cgroup_path();
+  switch (config.resource()) {
+    PANIC_ON_PROTO_ENUM_SENTINEL_VALUES;
+  case Config::CPU:
+    return cgroup_path + "/cpu.pressure";
+  case Config::MEMORY:
+    return cgroup_path + "/memory.pressure";
+  case Config::IO:
+    return cgroup_path + "/io.pressure";
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+} // namespace
+
+PressureStallMonitor::PressureStallMonitor(
+    const envoy::extensions::resource_monitors::pressure_stall::v3::PressureStallConfig& config,
+    TimeSource& time_source)
+    : pressure_file_(pressureFile(config)), line_prefix_(config.full() ? "full " : "some "),
+      smoothing_factor_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, smoothing_factor, DEFAULT_SMOOTHING_FACTOR)),
+      time_source_(time_source) {}
+
+absl::StatusOr<uint64_t> PressureStallMonitor::readTotalStallTime() const {
+  std::ifstream file(pressure_file_);
+  if (!file.is_open()) {
+    return absl::UnavailableError(
+        fmt::format("Can't open pressure stall information file {}", pressure_file_));
+  }
+
+  // Lines are formatted as "some avg10=0.00 avg60=0.00 avg300=0.00 total=0".
+  std::string line;
+  while (std::getline(file, line)) {
+    if (!absl::StartsWith(line, line_prefix_)) {
+      continue;
+    }
+    const size_t pos = line.find(TOTAL_FIELD);
+    uint64_t total;
+    if (pos == std::string::npos ||
+        !absl::SimpleAtoi(absl::string_view(line).substr(pos + TOTAL_FIELD.size()), &total)) {
+      break;
+    }
+    return total;
+  }
+  return absl::InvalidArgumentError(fmt::format(
+      "Unexpected format in pressure stall information file {}", pressure_file_));
+}
+
+void PressureStallMonitor::updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) {
+  const absl::StatusOr<uint64_t> total_stall_time = readTotalStallTime();
+  if (!total_stall_time.ok()) {
+    callbacks.onFailure(EnvoyException(std::string(total_stall_time.status().message())));
+    return;
+  }
+
+  const MonotonicTime now = time_source_.monotonicTime();
+  if (previous_time_.has_value() && now > *previous_time_ &&
+      *total_stall_time >= previous_total_stall_time_) {
+    const double elapsed_us =
+        std::chrono::duration<double, std::micro>(now - *previous_time_).count();
+    const double sample =
+        std::min(1.0, (*total_stall_time - previous_total_stall_time_) / elapsed_us);
+    pressure_ = smoothing_factor_ * sample + (1 - smoothing_factor_) * pressure_;
+  }
+  previous_time_ = now;
+  previous_total_stall_time_ = *total_stall_time;
+
+  Server::ResourceUsage usage;
+  usage.resource_pressure_ = pressure_;
+  callbacks.onSuccess(usage);
+}
+
+} // namespace PressureStallMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
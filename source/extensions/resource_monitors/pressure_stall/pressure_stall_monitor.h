@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/resource_monitors/pressure_stall/v3/pressure_stall.pb.h"
+#include "envoy/server/resource_monitor.h"
+
+#include "absl/status/statusor.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace PressureStallMonitor {
+
+static const std::string LINUX_CGROUP_PATH = "/sys/fs/cgroup";
+
+/**
+ * Resource monitor reporting the share of time stalled on a resource, from the cgroup v2 Pressure
+ * Stall Information files.
+ */
+class PressureStallMonitor : public Server::ResourceMonitor {
+public:
+  PressureStallMonitor(
+      const envoy::extensions::resource_monitors::pressure_stall::v3::PressureStallConfig& config,
+      TimeSource& time_source);
+
+  void updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) override;
+
+private:
+  // @return the total time stalled in microseconds, from the line of the PSI file.
+  absl::StatusOr<uint64_t> readTotalStallTime() const;
+
+  const std::string pressure_file_;
+  // "some " or "full ".
+  const std::string line_prefix_;
+  const double smoothing_factor_;
+  TimeSource& time_source_;
+  double pressure_{};
+  // The time and total stall time of the previous update, from which the next sample is computed.
+  absl::optional<MonotonicTime> previous_time_;
+  uint64_t previous_total_stall_time_{};
+};
+
+} // namespace PressureStallMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -20,6 +20,7 @@
 #include "source/common/network/utility.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 
 namespace Envoy {
@@ -43,11 +44,12 @@ void UdpStatsdSink::WriterImpl::writeBuffer(Buffer::Instance& data) {
   Network::Utility::writeToSocket(*io_handle_, data, nullptr, *parent_.server_address_);
 }
 
-UdpStatsdSink::UdpStatsdSink(ThreadLocal::SlotAllocator& tls,
+UdpStatsdSink::UdpStatsdSink(ThreadLocal::SlotAllocator& tls, Stats::SymbolTable& symbol_table,
                              Network::Address::InstanceConstSharedPtr address, const bool use_tag,
                              const std::string& prefix, absl::optional<uint64_t> buffer_size,
                              const Statsd::TagFormat& tag_format)
-    : tls_(tls.allocateSlot()), server_address_(std::move(address)), use_tag_(use_tag),
+    : tls_(tls.allocateSlot()), symbol_table_(symbol_table), server_address_(std::move(address)),
+      use_tag_(use_tag),
       prefix_(prefix.empty() ? Statsd::getDefaultPrefix() : prefix),
       buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format) {
   tls_->set([this](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr {
@@ -58,11 +60,13 @@ UdpStatsdSink::UdpStatsdSink(ThreadLocal::SlotAllocator& tls,
 void UdpStatsdSink::flush(Stats::MetricSnapshot& snapshot) {
   Writer& writer = tls_->getTyped<Writer>();
   Buffer::OwnedImpl buffer;
+  flush_count_++;
 
   for (const auto& counter : snapshot.counters()) {
     if (counter.counter_.get().used()) {
-      const std::string counter_str = buildMessage(counter.counter_.get(), counter.delta_, "|c");
-      writeBuffer(buffer, writer, counter_str);
+      const RenderedMetric& rendered = renderMetric(counter.counter_.get());
+      writeBuffer(buffer, writer,
+                  absl::StrCat(rendered.name_, ":", counter.delta_, "|c", rendered.tags_));
     }
   }
 
@@ -73,8 +77,9 @@ void UdpStatsdSink::flush(Stats::MetricSnapshot& snapshot) {
 
   for (const auto& gauge : snapshot.gauges()) {
     if (gauge.get().used()) {
-      const std::string gauge_str = buildMessage(gauge.get(), gauge.get().value(), "|g");
-      writeBuffer(buffer, writer, gauge_str);
+      const RenderedMetric& rendered = renderMetric(gauge.get());
+      writeBuffer(buffer, writer,
+                  absl::StrCat(rendered.name_, ":", gauge.get().value(), "|g", rendered.tags_));
     }
   }
 
@@ -85,6 +90,33 @@ void UdpStatsdSink::flush(Stats::MetricSnapshot& snapshot) {
 
   flushBuffer(buffer, writer);
   // TODO(efimki): Add support of text readouts stats.
+
+  // Forget the metrics which were not used by this flush, which may have been deleted.
+  absl::erase_if(rendered_metrics_, [this](const auto& entry) {
+    return entry.second->flush_count_ != flush_count_;
+  });
+}
+
+const UdpStatsdSink::RenderedMetric& UdpStatsdSink::renderMetric(const Stats::Metric& metric) {
+  // Rendering the name and the tags of a metric requires locking the symbol table, so it is only
+  // done when the metric is first flushed. The tags of a metric are extracted from its name.
+  auto it = rendered_metrics_.find(metric.statName());
+  if (it == rendered_metrics_.end()) {
+    auto rendered = std::make_unique<RenderedMetric>(metric.statName(), symbol_table_);
+    rendered->name_ = absl::StrCat(prefix_, ".", getName(metric));
+    switch (tag_format_.tag_position) {
+    case Statsd::TagPosition::TagAfterValue:
+      rendered->tags_ = buildTagStr(metric.tags());
+      break;
+    case Statsd::TagPosition::TagAfterName:
+      absl::StrAppend(&rendered->name_, buildTagStr(metric.tags()));
+      break;
+    }
+    const Stats::StatName stat_name = rendered->stat_name_.statName();
+    it = rendered_metrics_.emplace(stat_name, std::move(rendered)).first;
+  }
+  it->second->flush_count_ = flush_count_;
+  return *it->second;
 }
 
 void UdpStatsdSink::writeBuffer(Buffer::OwnedImpl& buffer, Writer& writer,
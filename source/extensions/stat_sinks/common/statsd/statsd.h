@@ -15,8 +15,10 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/macros.h"
 #include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/stats/symbol_table.h"
 #include "source/extensions/stat_sinks/common/statsd/tag_formats.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -41,16 +43,18 @@ public:
     virtual void writeBuffer(Buffer::Instance& data) PURE;
   };
 
-  UdpStatsdSink(ThreadLocal::SlotAllocator& tls, Network::Address::InstanceConstSharedPtr address,
-                const bool use_tag, const std::string& prefix = getDefaultPrefix(),
+  UdpStatsdSink(ThreadLocal::SlotAllocator& tls, Stats::SymbolTable& symbol_table,
+                Network::Address::InstanceConstSharedPtr address, const bool use_tag,
+                const std::string& prefix = getDefaultPrefix(),
                 absl::optional<uint64_t> buffer_size = absl::nullopt,
                 const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat());
   // For testing.
-  UdpStatsdSink(ThreadLocal::SlotAllocator& tls, const std::shared_ptr<Writer>& writer,
-                const bool use_tag, const std::string& prefix = getDefaultPrefix(),
+  UdpStatsdSink(ThreadLocal::SlotAllocator& tls, Stats::SymbolTable& symbol_table,
+                const std::shared_ptr<Writer>& writer, const bool use_tag,
+                const std::string& prefix = getDefaultPrefix(),
                 absl::optional<uint64_t> buffer_size = absl::nullopt,
                 const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat())
-      : tls_(tls.allocateSlot()), use_tag_(use_tag),
+      : tls_(tls.allocateSlot()), symbol_table_(symbol_table), use_tag_(use_tag),
         prefix_(prefix.empty() ? getDefaultPrefix() : prefix),
         buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format) {
     tls_->set(
@@ -82,6 +86,25 @@ private:
     const Network::IoHandlePtr io_handle_;
   };
 
+  /**
+   * The name and tags of a metric rendered for the flushes in which the metric is used.
+   */
+  struct RenderedMetric {
+    RenderedMetric(Stats::StatName stat_name, Stats::SymbolTable& symbol_table)
+        : stat_name_(stat_name, symbol_table) {}
+
+    // Holds references to the symbols of the name, so that they are not reused for another name
+    // while the metric is cached.
+    const Stats::StatNameManagedStorage stat_name_;
+    // The prefixed name, followed by the tags if they precede the value.
+    std::string name_;
+    // The tags if they follow the value.
+    std::string tags_;
+    // The last flush in which the metric was used.
+    uint64_t flush_count_{};
+  };
+
+  const RenderedMetric& renderMetric(const Stats::Metric& metric);
   void flushBuffer(Buffer::OwnedImpl& buffer, Writer& writer) const;
   void writeBuffer(Buffer::OwnedImpl& buffer, Writer& writer, const std::string& data) const;
 
@@ -92,12 +115,16 @@ private:
   const std::string buildTagStr(const std::vector<Stats::Tag>& tags) const;
 
   const ThreadLocal::SlotPtr tls_;
+  Stats::SymbolTable& symbol_table_;
   const Network::Address::InstanceConstSharedPtr server_address_;
   const bool use_tag_;
   // Prefix for all flushed stats.
   const std::string prefix_;
   const uint64_t buffer_size_;
   const Statsd::TagFormat tag_format_;
+  // Only used by flush(), on the main thread. Keyed by the name stored in the value.
+  absl::flat_hash_map<Stats::StatName, std::unique_ptr<RenderedMetric>> rendered_metrics_;
+  uint64_t flush_count_{};
 };
 
 /**
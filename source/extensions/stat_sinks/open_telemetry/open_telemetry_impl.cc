@@ -14,6 +14,7 @@ OtlpOptions::OtlpOptions(const SinkConfig& sink_config)
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, emit_tags_as_attributes, true)),
       use_tag_extracted_name_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, use_tag_extracted_name, true)),
+      omit_unchanged_deltas_(sink_config.omit_unchanged_deltas()),
       stat_prefix_(!sink_config.prefix().empty() ? sink_config.prefix() + "." : "") {}
 
 OpenTelemetryGrpcMetricsExporterImpl::OpenTelemetryGrpcMetricsExporterImpl(
@@ -62,19 +63,21 @@ MetricsExportRequestPtr OtlpMetricsFlusherImpl::flush(Stats::MetricSnapshot& sna
   }
 
   for (const auto& counter : snapshot.counters()) {
-    if (predicate_(counter.counter_)) {
+    if (predicate_(counter.counter_) && !omitCounter(counter.delta_)) {
       flushCounter(*scope_metrics->add_metrics(), counter.counter_.get(),
                    counter.counter_.get().value(), counter.delta_, snapshot_time_ns);
     }
   }
 
   for (const auto& counter : snapshot.hostCounters()) {
-    flushCounter(*scope_metrics->add_metrics(), counter, counter.value(), counter.delta(),
-                 snapshot_time_ns);
+    if (!omitCounter(counter.delta())) {
+      flushCounter(*scope_metrics->add_metrics(), counter, counter.value(), counter.delta(),
+                   snapshot_time_ns);
+    }
   }
 
   for (const auto& histogram : snapshot.histograms()) {
-    if (predicate_(histogram)) {
+    if (predicate_(histogram) && !omitHistogram(histogram)) {
       flushHistogram(*scope_metrics->add_metrics(), histogram, snapshot_time_ns);
     }
   }
@@ -82,6 +85,15 @@ MetricsExportRequestPtr OtlpMetricsFlusherImpl::flush(Stats::MetricSnapshot& sna
   return request;
 }
 
+bool OtlpMetricsFlusherImpl::omitCounter(uint64_t delta) const {
+  return delta == 0 && config_->reportCountersAsDeltas() && config_->omitUnchangedDeltas();
+}
+
+bool OtlpMetricsFlusherImpl::omitHistogram(const Stats::ParentHistogram& parent_histogram) const {
+  return config_->reportHistogramsAsDeltas() && config_->omitUnchangedDeltas() &&
+         parent_histogram.intervalStatistics().sampleCount() == 0;
+}
+
 template <class GaugeType>
 void OtlpMetricsFlusherImpl::flushGauge(opentelemetry::proto::metrics::v1::Metric& metric,
                                         const GaugeType& gauge_stat,
@@ -41,6 +41,7 @@ public:
   bool reportHistogramsAsDeltas() { return report_histograms_as_deltas_; }
   bool emitTagsAsAttributes() { return emit_tags_as_attributes_; }
   bool useTagExtractedName() { return use_tag_extracted_name_; }
+  bool omitUnchangedDeltas() { return omit_unchanged_deltas_; }
   const std::string& statPrefix() { return stat_prefix_; }
 
 private:
@@ -48,6 +49,7 @@ private:
   const bool report_histograms_as_deltas_;
   const bool emit_tags_as_attributes_;
   const bool use_tag_extracted_name_;
+  const bool omit_unchanged_deltas_;
   const std::string stat_prefix_;
 };
 
@@ -79,6 +81,11 @@ public:
   MetricsExportRequestPtr flush(Stats::MetricSnapshot& snapshot) const override;
 
 private:
+  // @return whether a counter or a histogram which did not change since the previous flush, as
+  //         indicated by its delta, is left out of the export request.
+  bool omitCounter(uint64_t delta) const;
+  bool omitHistogram(const Stats::ParentHistogram& parent_histogram) const;
+
   template <class GaugeType>
   void flushGauge(opentelemetry::proto::metrics::v1::Metric& metric, const GaugeType& gauge,
                   int64_t snapshot_time_ns) const;
@@ -6,7 +6,9 @@
 #include "source/common/tracing/trace_context_impl.h"
 #include "source/extensions/tracers/opentelemetry/span_context.h"
 
-#include "absl/strings/escaping.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -30,6 +32,21 @@ bool isAllZeros(const absl::string_view& input) {
   return std::all_of(input.begin(), input.end(), [](const char& c) { return c == '0'; });
 }
 
+// Positions of the hyphens of a traceparent header of the expected size.
+constexpr size_t kTraceIdOffset = kVersionHexSize + 1;
+constexpr size_t kParentIdOffset = kTraceIdOffset + kTraceIdHexSize + 1;
+constexpr size_t kTraceFlagsOffset = kParentIdOffset + kParentIdHexSize + 1;
+
+// Returns the error of a traceparent header of the expected size whose hyphens aren't at the
+// expected positions. This is only used on invalid headers, so it doesn't matter that it allocates.
+absl::Status invalidHyphenationError(absl::string_view header) {
+  std::vector<absl::string_view> components = absl::StrSplit(header, '-', absl::SkipEmpty());
+  if (components.size() != 4) {
+    return absl::InvalidArgumentError("Invalid traceparent hyphenation");
+  }
+  return absl::InvalidArgumentError("Invalid traceparent field sizes");
+}
+
 } // namespace
 
 SpanContextExtractor::SpanContextExtractor(Tracing::TraceContext& trace_context)
@@ -53,20 +70,18 @@ absl::StatusOr<SpanContext> SpanContextExtractor::extractSpanContext() {
   if (header_value_string.size() != kTraceparentHeaderSize) {
     return absl::InvalidArgumentError("Invalid traceparent header length");
   }
-  // Try to split it into its component parts:
-  std::vector<absl::string_view> propagation_header_components =
-      absl::StrSplit(header_value_string, '-', absl::SkipEmpty());
-  if (propagation_header_components.size() != 4) {
-    return absl::InvalidArgumentError("Invalid traceparent hyphenation");
-  }
-  absl::string_view version = propagation_header_components[0];
-  absl::string_view trace_id = propagation_header_components[1];
-  absl::string_view parent_id = propagation_header_components[2];
-  absl::string_view trace_flags = propagation_header_components[3];
-  if (version.size() != kVersionHexSize || trace_id.size() != kTraceIdHexSize ||
-      parent_id.size() != kParentIdHexSize || trace_flags.size() != kTraceFlagsHexSize) {
-    return absl::InvalidArgumentError("Invalid traceparent field sizes");
+  // The header has a fixed size, so its fields are at fixed positions, and it's valid only if the
+  // hyphens are there, which avoids splitting it.
+  if (header_value_string[kTraceIdOffset - 1] != '-' ||
+      header_value_string[kParentIdOffset - 1] != '-' ||
+      header_value_string[kTraceFlagsOffset - 1] != '-') {
+    return invalidHyphenationError(header_value_string);
   }
+  absl::string_view version = header_value_string.substr(0, kVersionHexSize);
+  absl::string_view trace_id = header_value_string.substr(kTraceIdOffset, kTraceIdHexSize);
+  absl::string_view parent_id = header_value_string.substr(kParentIdOffset, kParentIdHexSize);
+  absl::string_view trace_flags =
+      header_value_string.substr(kTraceFlagsOffset, kTraceFlagsHexSize);
   if (!isValidHex(version) || !isValidHex(trace_id) || !isValidHex(parent_id) ||
       !isValidHex(trace_flags)) {
     return absl::InvalidArgumentError("Invalid header hex");
@@ -82,25 +97,29 @@ absl::StatusOr<SpanContext> SpanContextExtractor::extractSpanContext() {
 
   // Set whether or not the span is sampled from the trace flags.
   // See https://w3c.github.io/trace-context/#trace-flags.
-  char decoded_trace_flags = absl::HexStringToBytes(trace_flags).front();
-  bool sampled = (decoded_trace_flags & 1);
+  // The sampled flag is the lowest bit, so it's in the last hex digit.
+  const char low_digit = trace_flags.back();
+  const int low_bits =
+      absl::ascii_isdigit(low_digit) ? low_digit - '0' : absl::ascii_tolower(low_digit) - 'a' + 10;
+  bool sampled = (low_bits & 1);
 
   // If a tracestate header is received without an accompanying traceparent header,
   // it is invalid and MUST be discarded. Because we're already checking for the
   // traceparent header above, we don't need to check here.
   // See https://www.w3.org/TR/trace-context/#processing-model-for-working-with-trace-context
   absl::string_view tracestate_key = OpenTelemetryConstants::get().TRACE_STATE.key();
-  std::vector<std::string> tracestate_values;
+  std::string tracestate;
+  bool has_tracestate = false;
   // Multiple tracestate header fields MUST be handled as specified by RFC7230 Section 3.2.2 Field
   // Order.
-  trace_context_.forEach(
-      [&tracestate_key, &tracestate_values](absl::string_view key, absl::string_view value) {
-        if (key == tracestate_key) {
-          tracestate_values.push_back(std::string{value});
-        }
-        return true;
-      });
-  std::string tracestate = absl::StrJoin(tracestate_values, ",");
+  trace_context_.forEach([&tracestate_key, &tracestate, &has_tracestate](absl::string_view key,
+                                                                          absl::string_view value) {
+    if (key == tracestate_key) {
+      absl::StrAppend(&tracestate, has_tracestate ? "," : "", value);
+      has_tracestate = true;
+    }
+    return true;
+  });
 
   SpanContext span_context(version, trace_id, parent_id, sampled, tracestate);
   return span_context;
@@ -26,6 +26,14 @@ using opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest;
 
 namespace {
 
+void appendHex(std::string& output, absl::string_view bytes) {
+  static constexpr absl::string_view digits = "0123456789abcdef";
+  for (const char byte : bytes) {
+    output.push_back(digits[static_cast<uint8_t>(byte) >> 4]);
+    output.push_back(digits[static_cast<uint8_t>(byte) & 0xf]);
+  }
+}
+
 const Tracing::TraceContextHandler& traceParentHeader() {
   CONSTRUCT_ON_FIRST_USE(Tracing::TraceContextHandler, "traceparent");
 }
@@ -62,8 +70,6 @@ Span::Span(const std::string& name, const StreamInfo::StreamInfo& stream_info,
            SystemTime start_time, Envoy::TimeSource& time_source, Tracer& parent_tracer,
            OTelSpanKind span_kind)
     : stream_info_(stream_info), parent_tracer_(parent_tracer), time_source_(time_source) {
-  span_ = ::opentelemetry::proto::trace::v1::Span();
-
   span_.set_kind(span_kind);
 
   span_.set_name(name);
@@ -90,12 +96,16 @@ void Span::finishSpan() {
 void Span::setOperation(absl::string_view operation) { span_.set_name(operation); };
 
 void Span::injectContext(Tracing::TraceContext& trace_context, const Tracing::UpstreamContext&) {
-  std::string trace_id_hex = absl::BytesToHexString(span_.trace_id());
-  std::string span_id_hex = absl::BytesToHexString(span_.span_id());
-  std::vector<uint8_t> trace_flags_vec{sampled()};
-  std::string trace_flags_hex = Hex::encode(trace_flags_vec);
-  std::string traceparent_header_value =
-      absl::StrCat(kDefaultVersion, "-", trace_id_hex, "-", span_id_hex, "-", trace_flags_hex);
+  // The header is encoded in place, rather than concatenating the hex encodings of its fields.
+  std::string traceparent_header_value;
+  traceparent_header_value.reserve(kDefaultVersion.size() + 2 * span_.trace_id().size() +
+                                   2 * span_.span_id().size() + 5);
+  traceparent_header_value.append(kDefaultVersion);
+  traceparent_header_value.push_back('-');
+  appendHex(traceparent_header_value, span_.trace_id());
+  traceparent_header_value.push_back('-');
+  appendHex(traceparent_header_value, span_.span_id());
+  traceparent_header_value.append(sampled() ? "-01" : "-00");
   // Set the traceparent in the trace_context.
   traceParentHeader().setRefKey(trace_context, traceparent_header_value);
   // Also set the tracestate.
@@ -116,14 +126,9 @@ void Span::setAttribute(absl::string_view name, const OTelAttribute& attribute_v
     }
   }
   // If we haven't found an existing match already, we can add a new key/value.
-  opentelemetry::proto::common::v1::KeyValue key_value =
-      opentelemetry::proto::common::v1::KeyValue();
-  opentelemetry::proto::common::v1::AnyValue value_proto =
-      opentelemetry::proto::common::v1::AnyValue();
-  OtlpUtils::populateAnyValue(value_proto, attribute_value);
-  key_value.set_key(std::string{name});
-  *key_value.mutable_value() = value_proto;
-  *span_.add_attributes() = key_value;
+  opentelemetry::proto::common::v1::KeyValue* key_value = span_.add_attributes();
+  key_value->set_key(std::string{name});
+  OtlpUtils::populateAnyValue(*key_value->mutable_value(), attribute_value);
 }
 
 ::opentelemetry::proto::trace::v1::Status_StatusCode
@@ -187,6 +192,24 @@ Tracer::Tracer(OpenTelemetryTraceExporterPtr exporter, Envoy::TimeSource& time_s
                const ResourceConstSharedPtr resource, SamplerSharedPtr sampler)
     : exporter_(std::move(exporter)), time_source_(time_source), random_(random), runtime_(runtime),
       tracing_stats_(tracing_stats), resource_(resource), sampler_(sampler) {
+  // A request consists of ResourceSpans.
+  ::opentelemetry::proto::trace::v1::ResourceSpans* resource_span = request_.add_resource_spans();
+  resource_span->set_schema_url(resource_->schema_url_);
+
+  // add resource attributes
+  for (auto const& att : resource_->attributes_) {
+    opentelemetry::proto::common::v1::KeyValue* key_value =
+        resource_span->mutable_resource()->add_attributes();
+    key_value->set_key(std::string{att.first});
+    key_value->mutable_value()->set_string_value(std::string{att.second});
+  }
+
+  span_buffer_ = resource_span->add_scope_spans();
+
+  // set the instrumentation scope name and version
+  *span_buffer_->mutable_scope()->mutable_name() = "envoy";
+  *span_buffer_->mutable_scope()->mutable_version() = Envoy::VersionInfo::version();
+
   flush_timer_ = dispatcher.createTimer([this]() -> void {
     tracing_stats_.timer_flushed_.inc();
     flushSpans();
@@ -202,53 +225,28 @@ void Tracer::enableTimer() {
 }
 
 void Tracer::flushSpans() {
-  if (span_buffer_.empty()) {
+  if (span_buffer_->spans().empty()) {
     return;
   }
 
-  ExportTraceServiceRequest request;
-  // A request consists of ResourceSpans.
-  ::opentelemetry::proto::trace::v1::ResourceSpans* resource_span = request.add_resource_spans();
-  resource_span->set_schema_url(resource_->schema_url_);
-
-  // add resource attributes
-  for (auto const& att : resource_->attributes_) {
-    opentelemetry::proto::common::v1::KeyValue key_value =
-        opentelemetry::proto::common::v1::KeyValue();
-    opentelemetry::proto::common::v1::AnyValue value_proto =
-        opentelemetry::proto::common::v1::AnyValue();
-    value_proto.set_string_value(std::string{att.second});
-    key_value.set_key(std::string{att.first});
-    *key_value.mutable_value() = value_proto;
-    (*resource_span->mutable_resource()->add_attributes()) = key_value;
-  }
-
-  ::opentelemetry::proto::trace::v1::ScopeSpans* scope_span = resource_span->add_scope_spans();
-
-  // set the instrumentation scope name and version
-  *scope_span->mutable_scope()->mutable_name() = "envoy";
-  *scope_span->mutable_scope()->mutable_version() = Envoy::VersionInfo::version();
-
-  for (const auto& pending_span : span_buffer_) {
-    (*scope_span->add_spans()) = pending_span;
-  }
   if (exporter_) {
-    tracing_stats_.spans_sent_.add(span_buffer_.size());
-    if (!exporter_->log(request)) {
+    tracing_stats_.spans_sent_.add(span_buffer_->spans_size());
+    // The exporters serialize the request before returning.
+    if (!exporter_->log(request_)) {
       // TODO: should there be any sort of retry or reporting here?
       ENVOY_LOG(trace, "Unsuccessful log request to OpenTelemetry trace collector.");
     }
   } else {
     ENVOY_LOG(info, "Skipping log request to OpenTelemetry: no exporter configured");
   }
-  span_buffer_.clear();
+  span_buffer_->mutable_spans()->Clear();
 }
 
 void Tracer::sendSpan(::opentelemetry::proto::trace::v1::Span& span) {
-  span_buffer_.push_back(span);
+  *span_buffer_->add_spans() = span;
   const uint64_t min_flush_spans =
       runtime_.snapshot().getInteger("tracing.opentelemetry.min_flush_spans", 5U);
-  if (span_buffer_.size() >= min_flush_spans) {
+  if (static_cast<uint64_t>(span_buffer_->spans_size()) >= min_flush_spans) {
     flushSpans();
   }
 }
@@ -258,19 +256,21 @@ Tracing::SpanPtr Tracer::startSpan(const std::string& operation_name,
                                    Tracing::Decision tracing_decision,
                                    OptRef<const Tracing::TraceContext> trace_context,
                                    OTelSpanKind span_kind) {
-  // Create an Tracers::OpenTelemetry::Span class that will contain the OTel span.
-  Span new_span(operation_name, stream_info, start_time, time_source_, *this, span_kind);
+  // Create an Tracers::OpenTelemetry::Span class that will contain the OTel span. It's populated in
+  // place, as copying it would copy the whole span proto.
+  auto new_span = std::make_unique<Span>(operation_name, stream_info, start_time, time_source_,
+                                         *this, span_kind);
   uint64_t trace_id_high = random_.random();
   uint64_t trace_id = random_.random();
-  new_span.setTraceId(absl::StrCat(Hex::uint64ToHex(trace_id_high), Hex::uint64ToHex(trace_id)));
+  new_span->setTraceId(absl::StrCat(Hex::uint64ToHex(trace_id_high), Hex::uint64ToHex(trace_id)));
   uint64_t span_id = random_.random();
-  new_span.setId(Hex::uint64ToHex(span_id));
+  new_span->setId(Hex::uint64ToHex(span_id));
   if (sampler_) {
-    callSampler(sampler_, stream_info, absl::nullopt, new_span, operation_name, trace_context);
+    callSampler(sampler_, stream_info, absl::nullopt, *new_span, operation_name, trace_context);
   } else {
-    new_span.setSampled(tracing_decision.traced);
+    new_span->setSampled(tracing_decision.traced);
   }
-  return std::make_unique<Span>(new_span);
+  return new_span;
 }
 
 Tracing::SpanPtr Tracer::startSpan(const std::string& operation_name,
@@ -279,26 +279,27 @@ Tracing::SpanPtr Tracer::startSpan(const std::string& operation_name,
                                    OptRef<const Tracing::TraceContext> trace_context,
                                    OTelSpanKind span_kind) {
   // Create a new span and populate details from the span context.
-  Span new_span(operation_name, stream_info, start_time, time_source_, *this, span_kind);
-  new_span.setTraceId(previous_span_context.traceId());
+  auto new_span = std::make_unique<Span>(operation_name, stream_info, start_time, time_source_,
+                                         *this, span_kind);
+  new_span->setTraceId(previous_span_context.traceId());
   if (!previous_span_context.parentId().empty()) {
-    new_span.setParentId(previous_span_context.parentId());
+    new_span->setParentId(previous_span_context.parentId());
   }
   // Generate a new identifier for the span id.
   uint64_t span_id = random_.random();
-  new_span.setId(Hex::uint64ToHex(span_id));
+  new_span->setId(Hex::uint64ToHex(span_id));
   if (sampler_) {
     // Sampler should make a sampling decision and set tracestate
-    callSampler(sampler_, stream_info, previous_span_context, new_span, operation_name,
+    callSampler(sampler_, stream_info, previous_span_context, *new_span, operation_name,
                 trace_context);
   } else {
     // Respect the previous span's sampled flag.
-    new_span.setSampled(previous_span_context.sampled());
+    new_span->setSampled(previous_span_context.sampled());
     if (!previous_span_context.tracestate().empty()) {
-      new_span.setTracestate(std::string{previous_span_context.tracestate()});
+      new_span->setTracestate(std::string{previous_span_context.tracestate()});
     }
   }
-  return std::make_unique<Span>(new_span);
+  return new_span;
 }
 
 } // namespace OpenTelemetry
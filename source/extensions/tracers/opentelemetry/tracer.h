@@ -68,7 +68,11 @@ private:
   OpenTelemetryTraceExporterPtr exporter_;
   Envoy::TimeSource& time_source_;
   Random::RandomGenerator& random_;
-  std::vector<::opentelemetry::proto::trace::v1::Span> span_buffer_;
+  // The request sent on each flush, with the resource and the scope of the spans set once. The
+  // spans are buffered in it directly, and it's reused across flushes so that the span protos
+  // cleared after a flush are reused for the next ones.
+  ExportTraceServiceRequest request_;
+  ::opentelemetry::proto::trace::v1::ScopeSpans* span_buffer_;
   Runtime::Loader& runtime_;
   Event::TimerPtr flush_timer_;
   OpenTelemetryTracerStats tracing_stats_;
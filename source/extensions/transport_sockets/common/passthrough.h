@@ -81,6 +81,9 @@ public:
   bool startSecureTransport() override { return false; }
   void configureInitialCongestionWindow(uint64_t bandwidth_bits_per_sec,
                                         std::chrono::microseconds rtt) override;
+  // Wrapping sockets generally add to or observe the payload. Those that don't can forward this to
+  // the wrapped socket.
+  bool passesRawBytesThrough() const override { return false; }
 
 protected:
   Network::TransportSocketPtr transport_socket_;
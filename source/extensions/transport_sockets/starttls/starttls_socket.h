@@ -56,6 +56,9 @@ public:
     return active_socket_->configureInitialCongestionWindow(bandwidth_bits_per_sec, rtt);
   }
 
+  // The payload may switch to TLS at any time.
+  bool passesRawBytesThrough() const override { return false; }
+
 private:
   // This is a proxy for wrapping the transport callback object passed from the consumer.
   // Its primary purpose is to filter Connected events to ensure they only happen once per open.
@@ -60,6 +60,9 @@ public:
 
   // SocketTapConfig
   PerSocketTapperPtr createPerSocketTapper(const Network::Connection& connection) override {
+    if (!tapEnabled()) {
+      return nullptr;
+    }
     return std::make_unique<PerSocketTapperImpl>(shared_from_this(), connection);
   }
   TimeSource& timeSource() const override { return time_source_; }
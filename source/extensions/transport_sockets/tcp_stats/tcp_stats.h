@@ -61,6 +61,8 @@ public:
   void setTransportSocketCallbacks(Network::TransportSocketCallbacks& callbacks) override;
   void onConnected() override;
   void closeSocket(Network::ConnectionEvent event) override;
+  // Only the TCP info of the socket is sampled, the payload is left to the wrapped socket.
+  bool passesRawBytesThrough() const override { return transport_socket_->passesRawBytesThrough(); }
 
 private:
   absl::optional<struct tcp_info> querySocketInfo();
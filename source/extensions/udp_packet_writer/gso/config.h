@@ -16,10 +16,12 @@ namespace Quic {
 class UdpGsoBatchWriterFactoryFactory : public Network::UdpPacketWriterFactoryFactory {
 public:
   std::string name() const override { return "envoy.udp_packet_writer.gso"; }
-  Network::UdpPacketWriterFactoryPtr
-  createUdpPacketWriterFactory(const envoy::config::core::v3::TypedExtensionConfig&) override {
+  Network::UdpPacketWriterFactoryPtr createUdpPacketWriterFactory(
+      const envoy::config::core::v3::TypedExtensionConfig& config) override {
 #ifdef ENVOY_ENABLE_QUIC
-    return std::make_unique<UdpGsoBatchWriterFactory>();
+    envoy::extensions::udp_packet_writer::v3::UdpGsoBatchWriterFactory writer_config;
+    THROW_IF_NOT_OK(MessageUtil::unpackTo(config.typed_config(), writer_config));
+    return std::make_unique<UdpGsoBatchWriterFactory>(writer_config.enable_release_time());
 #else
     return {};
 #endif
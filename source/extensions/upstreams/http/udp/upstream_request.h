@@ -91,6 +91,7 @@ public:
     ENVOY_LOG_MISC(warn, "{} UDP datagrams were dropped.", dropped);
     datagrams_dropped_ += dropped;
   }
+  void onDatagramsRead(uint32_t) override {}
   size_t numPacketsExpectedPerEventLoop() const override {
     return Network::MAX_NUM_PACKETS_PER_EVENT_LOOP;
   }
@@ -19,7 +19,8 @@ ActiveUdpListenerBase::ActiveUdpListenerBase(uint32_t worker_index, uint32_t con
     : ActiveListenerImplBase(parent, config), worker_index_(worker_index),
       concurrency_(concurrency), parent_(parent), listen_socket_(listen_socket),
       udp_listener_(std::move(listener)),
-      udp_stats_({ALL_UDP_LISTENER_STATS(POOL_COUNTER_PREFIX(config->listenerScope(), "udp"))}),
+      udp_stats_({ALL_UDP_LISTENER_STATS(POOL_COUNTER_PREFIX(config->listenerScope(), "udp"),
+                                         POOL_HISTOGRAM_PREFIX(config->listenerScope(), "udp"))}),
       udp_listener_worker_router_(config_->udpListenerConfig()->listenerWorkerRouter(
           *listen_socket.connectionInfoProvider().localAddress())) {
   ASSERT(worker_index_ < concurrency_);
@@ -56,6 +57,7 @@ void ActiveUdpListenerBase::onData(Network::UdpRecvData&& data) {
   if (dest == worker_index_) {
     onDataWorker(std::move(data));
   } else {
+    udp_stats_.downstream_rx_datagram_forwarded_.inc();
     udp_listener_worker_router_.deliver(dest, std::move(data));
   }
 }
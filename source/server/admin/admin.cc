@@ -119,19 +119,25 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
       route_config_provider_(server.timeSource()),
       scoped_route_config_provider_(server.timeSource()), clusters_handler_(server),
       config_dump_handler_(config_tracker_, server), init_dump_handler_(server),
-      stats_handler_(server), logs_handler_(server), profiling_handler_(profile_path),
-      runtime_handler_(server), listeners_handler_(server), server_cmd_handler_(server),
-      server_info_handler_(server),
+      stats_handler_(server), logs_handler_(server),
+      profiling_handler_(profile_path, server.api().fileSystem()), runtime_handler_(server),
+      listeners_handler_(server), server_cmd_handler_(server), server_info_handler_(server),
       // TODO(jsedgwick) add /runtime_reset endpoint that removes all admin-set values
       handlers_{
           makeHandler("/", "Admin home page", MAKE_ADMIN_HANDLER(handlerAdminHome), false, false),
           makeHandler("/certs", "print certs on machine",
                       MAKE_ADMIN_HANDLER(server_info_handler_.handlerCerts), false, false),
-          makeHandler("/clusters", "upstream cluster status",
-                      MAKE_ADMIN_HANDLER(clusters_handler_.handlerClusters), false, false),
-          makeHandler(
-              "/config_dump", "dump current Envoy configs (experimental)",
-              MAKE_ADMIN_HANDLER(config_dump_handler_.handlerConfigDump), false, false,
+          makeStreamingHandler(
+              "/clusters", "upstream cluster status", clusters_handler_, false, false,
+              {{Admin::ParamDescriptor::Type::Enum,
+                "format",
+                "File format to use",
+                {"text", "json"}},
+               {Admin::ParamDescriptor::Type::String, "name_regex",
+                "Render only the clusters whose names match the specified regex"}}),
+          makeStreamingHandler(
+              "/config_dump", "dump current Envoy configs (experimental)", config_dump_handler_,
+              false, false,
               {{Admin::ParamDescriptor::Type::String, "resource", "The resource to dump"},
                {Admin::ParamDescriptor::Type::String, "mask",
                 "The mask to apply. When both resource and mask are specified, "
@@ -151,6 +157,8 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
                         "all listeners with /init_dump?mask=listener`"}}),
           makeHandler("/contention", "dump current Envoy mutex contention stats (if enabled)",
                       MAKE_ADMIN_HANDLER(stats_handler_.handlerContention), false, false),
+          makeHandler("/cpu_profile", "dump the samples of the running CPU profiler (if enabled)",
+                      MAKE_ADMIN_HANDLER(profiling_handler_.handlerCpuProfile), false, false),
           makeHandler("/cpuprofiler", "enable/disable the CPU profiler",
                       MAKE_ADMIN_HANDLER(profiling_handler_.handlerCpuProfiler), false, true,
                       {{Admin::ParamDescriptor::Type::Enum,
@@ -199,7 +207,10 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
                         "desired logging level, this will change all loggers's level",
                         prepend("", LogsHandler::levelStrings())}}),
           makeHandler("/memory", "print current allocation/heap usage",
-                      MAKE_ADMIN_HANDLER(server_info_handler_.handlerMemory), false, false),
+                      MAKE_ADMIN_HANDLER(server_info_handler_.handlerMemory), false, false,
+                      {{ParamDescriptor::Type::Boolean, "subsystems",
+                        "Estimate the memory allocated by each subsystem from the sampled heap "
+                        "profile (if supported)"}}),
           makeHandler("/quitquitquit", "exit the server",
                       MAKE_ADMIN_HANDLER(server_cmd_handler_.handlerQuitQuitQuit), false, true),
           makeHandler("/reset_counters", "reset all counters to zero",
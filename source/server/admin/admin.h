@@ -239,6 +239,7 @@ public:
   bool appendLocalOverload() const override { return false; }
   bool appendXForwardedPort() const override { return false; }
   bool addProxyProtocolConnectionState() const override { return true; }
+  bool trackCpuTime() const override { return false; }
 
 private:
   friend class AdminTestingPeer;
@@ -266,16 +267,21 @@ private:
    * @param removeable indicates whether the handler can be removed after being added
    * @param mutates_state indicates whether the handler will mutate state and therefore
    *                      must be accessed via HTTP POST rather than GET.
+   * @param params command parameter descriptors.
    * @return the UrlHandler.
    */
   template <class Handler>
   UrlHandler makeStreamingHandler(const std::string& prefix, const std::string& help_text,
-                                  Handler& handler, bool removable, bool mutates_state) {
-    return {prefix, help_text,
+                                  Handler& handler, bool removable, bool mutates_state,
+                                  const ParamDescriptorVec& params = {}) {
+    return {prefix,
+            help_text,
             [&handler](AdminStream& admin_stream) -> Admin::RequestPtr {
               return handler.makeRequest(admin_stream);
             },
-            removable, mutates_state};
+            removable,
+            mutates_state,
+            params};
   }
 
   /**
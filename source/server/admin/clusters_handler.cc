@@ -1,13 +1,16 @@
 #include "source/server/admin/clusters_handler.h"
 
 #include "envoy/admin/v3/clusters.pb.h"
+#include "envoy/config/core/v3/base.pb.h"
+#include "envoy/config/core/v3/health_check.pb.h"
 
 #include "source/common/http/headers.h"
 #include "source/common/http/utility.h"
-#include "source/common/network/utility.h"
 #include "source/common/upstream/host_utility.h"
 #include "source/server/admin/utils.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -27,33 +30,65 @@ void addCircuitBreakerSettingsAsText(const std::string& cluster_name,
                            resource_manager.retries().max()));
 }
 
-void addCircuitBreakerSettingsAsJson(const envoy::config::core::v3::RoutingPriority& priority,
+// The JSON below is written with the names and encodings of the fields of the
+// envoy::admin::v3::Clusters proto, omitting the fields with default values as its rendering did.
+
+void addCircuitBreakerSettingsAsJson(envoy::config::core::v3::RoutingPriority priority,
                                      Upstream::ResourceManager& resource_manager,
-                                     envoy::admin::v3::ClusterStatus& cluster_status) {
-  auto& thresholds = *cluster_status.mutable_circuit_breakers()->add_thresholds();
-  thresholds.set_priority(priority);
-  thresholds.mutable_max_connections()->set_value(resource_manager.connections().max());
-  thresholds.mutable_max_pending_requests()->set_value(resource_manager.pendingRequests().max());
-  thresholds.mutable_max_requests()->set_value(resource_manager.requests().max());
-  thresholds.mutable_max_retries()->set_value(resource_manager.retries().max());
+                                     Json::BufferStreamer::Array& thresholds) {
+  Json::BufferStreamer::MapPtr threshold = thresholds.addMap();
+  if (priority != envoy::config::core::v3::RoutingPriority::DEFAULT) {
+    threshold->addEntries({{"priority", envoy::config::core::v3::RoutingPriority_Name(priority)}});
+  }
+  threshold->addEntries({{"max_connections", resource_manager.connections().max()},
+                         {"max_pending_requests", resource_manager.pendingRequests().max()},
+                         {"max_requests", resource_manager.requests().max()},
+                         {"max_retries", resource_manager.retries().max()}});
 }
 
-} // namespace
-
-ClustersHandler::ClustersHandler(Server::Instance& server) : HandlerContextBase(server) {}
-
-Http::Code ClustersHandler::handlerClusters(Http::ResponseHeaderMap& response_headers,
-                                            Buffer::Instance& response, AdminStream& admin_stream) {
-  const auto format_value = Utility::formatParam(admin_stream.queryParams());
+// Adds a type.v3.Percent.
+void addPercentAsJson(absl::string_view key, double value, Json::BufferStreamer::Map& map) {
+  map.addKey(key);
+  map.addMap()->addEntries({{"value", value}});
+}
 
-  if (format_value.has_value() && format_value.value() == "json") {
-    writeClustersAsJson(response);
-    response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
+// Adds a config.core.v3.Address, as Network::Utility::addressToProtobufAddress() would fill it.
+void addAddressAsJson(const Network::Address::Instance& address, Json::BufferStreamer::Map& map) {
+  map.addKey("address");
+  Json::BufferStreamer::MapPtr address_map = map.addMap();
+  if (address.type() == Network::Address::Type::Pipe) {
+    address_map->addKey("pipe");
+    address_map->addMap()->addEntries({{"path", address.asStringView()}});
+  } else if (address.type() == Network::Address::Type::Ip) {
+    address_map->addKey("socket_address");
+    address_map->addMap()->addEntries(
+        {{"address", address.ip()->addressAsString()},
+         {"port_value", static_cast<uint64_t>(address.ip()->port())}});
   } else {
-    writeClustersAsText(response);
+    ASSERT(address.type() == Network::Address::Type::EnvoyInternal);
+    address_map->addKey("envoy_internal_address");
+    Json::BufferStreamer::MapPtr internal_map = address_map->addMap();
+    internal_map->addEntries(
+        {{"server_listener_name", address.envoyInternalAddress()->addressId()}});
+    if (!address.envoyInternalAddress()->endpointId().empty()) {
+      internal_map->addEntries({{"endpoint_id", address.envoyInternalAddress()->endpointId()}});
+    }
   }
+}
 
-  return Http::Code::OK;
+// Adds an admin.v3.SimpleMetric. Its uint64 value is rendered as a string.
+void addMetricAsJson(absl::string_view name, uint64_t value, absl::string_view type,
+                     Json::BufferStreamer::Array& stats) {
+  const std::string value_str = absl::StrCat(value);
+  stats.addMap()->addEntries({{"name", name}, {"value", value_str}, {"type", type}});
+}
+
+} // namespace
+
+ClustersHandler::ClustersHandler(Server::Instance& server) : HandlerContextBase(server) {}
+
+Admin::RequestPtr ClustersHandler::makeRequest(AdminStream& admin_stream) const {
+  return std::make_unique<ClustersRequest>(*this, admin_stream.queryParams());
 }
 
 // Helper method that ensures that we've setting flags based on all the health flag values on the
@@ -107,170 +142,206 @@ void setHealthFlag(Upstream::Host::HealthFlag flag, const Upstream::Host& host,
   }
 }
 
-// TODO(efimki): Add support of text readouts stats.
-void ClustersHandler::writeClustersAsJson(Buffer::Instance& response) {
-  envoy::admin::v3::Clusters clusters;
-  // TODO(mattklein123): Add ability to see warming clusters in admin output.
-  auto all_clusters = server_.clusterManager().clusters();
-  for (const auto& [name, cluster_ref] : all_clusters.active_clusters_) {
-    UNREFERENCED_PARAMETER(name);
-    const Upstream::Cluster& cluster = cluster_ref.get();
-    Upstream::ClusterInfoConstSharedPtr cluster_info = cluster.info();
-
-    envoy::admin::v3::ClusterStatus& cluster_status = *clusters.add_cluster_statuses();
-    cluster_status.set_name(cluster_info->name());
-    cluster_status.set_observability_name(cluster_info->observabilityName());
-    if (const auto& name = cluster_info->edsServiceName(); !name.empty()) {
-      cluster_status.set_eds_service_name(name);
-    }
+void ClustersHandler::writeClusterAsJson(const Upstream::Cluster& cluster,
+                                         Json::BufferStreamer::Map& map) const {
+  Upstream::ClusterInfoConstSharedPtr cluster_info = cluster.info();
+  map.addEntries({{"name", cluster_info->name()}});
+  if (const auto& name = cluster_info->observabilityName(); !name.empty()) {
+    map.addEntries({{"observability_name", name}});
+  }
+  if (const auto& name = cluster_info->edsServiceName(); !name.empty()) {
+    map.addEntries({{"eds_service_name", name}});
+  }
+
+  map.addKey("circuit_breakers");
+  {
+    Json::BufferStreamer::MapPtr circuit_breakers = map.addMap();
+    circuit_breakers->addKey("thresholds");
+    Json::BufferStreamer::ArrayPtr thresholds = circuit_breakers->addArray();
     addCircuitBreakerSettingsAsJson(
         envoy::config::core::v3::RoutingPriority::DEFAULT,
-        cluster.info()->resourceManager(Upstream::ResourcePriority::Default), cluster_status);
-    addCircuitBreakerSettingsAsJson(
-        envoy::config::core::v3::RoutingPriority::HIGH,
-        cluster.info()->resourceManager(Upstream::ResourcePriority::High), cluster_status);
+        cluster_info->resourceManager(Upstream::ResourcePriority::Default), *thresholds);
+    addCircuitBreakerSettingsAsJson(envoy::config::core::v3::RoutingPriority::HIGH,
+                                    cluster_info->resourceManager(Upstream::ResourcePriority::High),
+                                    *thresholds);
+  }
 
-    const Upstream::Outlier::Detector* outlier_detector = cluster.outlierDetector();
-    if (outlier_detector != nullptr &&
-        outlier_detector->successRateEjectionThreshold(
-            Upstream::Outlier::DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin) > 0.0) {
-      cluster_status.mutable_success_rate_ejection_threshold()->set_value(
-          outlier_detector->successRateEjectionThreshold(
-              Upstream::Outlier::DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin));
+  const Upstream::Outlier::Detector* outlier_detector = cluster.outlierDetector();
+  if (outlier_detector != nullptr) {
+    const double threshold = outlier_detector->successRateEjectionThreshold(
+        Upstream::Outlier::DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin);
+    if (threshold > 0.0) {
+      addPercentAsJson("success_rate_ejection_threshold", threshold, map);
     }
-    if (outlier_detector != nullptr &&
-        outlier_detector->successRateEjectionThreshold(
-            Upstream::Outlier::DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin) > 0.0) {
-      cluster_status.mutable_local_origin_success_rate_ejection_threshold()->set_value(
-          outlier_detector->successRateEjectionThreshold(
-              Upstream::Outlier::DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin));
+    const double local_origin_threshold = outlier_detector->successRateEjectionThreshold(
+        Upstream::Outlier::DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin);
+    if (local_origin_threshold > 0.0) {
+      addPercentAsJson("local_origin_success_rate_ejection_threshold", local_origin_threshold,
+                       map);
     }
+  }
 
-    cluster_status.set_added_via_api(cluster_info->addedViaApi());
+  if (cluster_info->addedViaApi()) {
+    map.addEntries({{"added_via_api", true}});
+  }
 
-    for (auto& host_set : cluster.prioritySet().hostSetsPerPriority()) {
-      for (auto& host : host_set->hosts()) {
-        envoy::admin::v3::HostStatus& host_status = *cluster_status.add_host_statuses();
-        Network::Utility::addressToProtobufAddress(*host->address(),
-                                                   *host_status.mutable_address());
-        host_status.set_hostname(host->hostname());
-        host_status.mutable_locality()->MergeFrom(host->locality());
+  map.addKey("host_statuses");
+  Json::BufferStreamer::ArrayPtr host_statuses = map.addArray();
+  for (auto& host_set : cluster.prioritySet().hostSetsPerPriority()) {
+    for (auto& host : host_set->hosts()) {
+      writeHostAsJson(*host, *host_statuses->addMap());
+    }
+  }
+}
 
-        for (const auto& [counter_name, counter] : host->counters()) {
-          auto& metric = *host_status.add_stats();
-          metric.set_name(std::string(counter_name));
-          metric.set_value(counter.get().value());
-          metric.set_type(envoy::admin::v3::SimpleMetric::COUNTER);
-        }
+void ClustersHandler::writeHostAsJson(const Upstream::Host& host,
+                                      Json::BufferStreamer::Map& map) const {
+  addAddressAsJson(*host.address(), map);
+  if (!host.hostname().empty()) {
+    map.addEntries({{"hostname", host.hostname()}});
+  }
 
-        for (const auto& [gauge_name, gauge] : host->gauges()) {
-          auto& metric = *host_status.add_stats();
-          metric.set_name(std::string(gauge_name));
-          metric.set_value(gauge.get().value());
-          metric.set_type(envoy::admin::v3::SimpleMetric::GAUGE);
-        }
+  map.addKey("locality");
+  {
+    Json::BufferStreamer::MapPtr locality = map.addMap();
+    for (const auto& [key, value] :
+         {std::make_pair("region", &host.locality().region()),
+          std::make_pair("zone", &host.locality().zone()),
+          std::make_pair("sub_zone", &host.locality().sub_zone())}) {
+      if (!value->empty()) {
+        locality->addEntries({{key, *value}});
+      }
+    }
+  }
 
-        envoy::admin::v3::HostHealthStatus& health_status = *host_status.mutable_health_status();
+  const auto counters = host.counters();
+  const auto gauges = host.gauges();
+  if (!counters.empty() || !gauges.empty()) {
+    map.addKey("stats");
+    Json::BufferStreamer::ArrayPtr stats = map.addArray();
+    for (const auto& [counter_name, counter] : counters) {
+      addMetricAsJson(counter_name, counter.get().value(), "COUNTER", *stats);
+    }
+    for (const auto& [gauge_name, gauge] : gauges) {
+      addMetricAsJson(gauge_name, gauge.get().value(), "GAUGE", *stats);
+    }
+  }
+
+  // The flags are gathered in the small proto that setHealthFlag() fills, and written from there.
+  envoy::admin::v3::HostHealthStatus health_status;
 
 // Invokes setHealthFlag for each health flag.
 #define SET_HEALTH_FLAG(name, notused)                                                             \
-  setHealthFlag(Upstream::Host::HealthFlag::name, *host, health_status);
-        HEALTH_FLAG_ENUM_VALUES(SET_HEALTH_FLAG)
+  setHealthFlag(Upstream::Host::HealthFlag::name, host, health_status);
+  HEALTH_FLAG_ENUM_VALUES(SET_HEALTH_FLAG)
 #undef SET_HEALTH_FLAG
 
-        double success_rate = host->outlierDetector().successRate(
-            Upstream::Outlier::DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin);
-        if (success_rate >= 0.0) {
-          host_status.mutable_success_rate()->set_value(success_rate);
-        }
-
-        host_status.set_weight(host->weight());
-
-        host_status.set_priority(host->priority());
-        success_rate = host->outlierDetector().successRate(
-            Upstream::Outlier::DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin);
-        if (success_rate >= 0.0) {
-          host_status.mutable_local_origin_success_rate()->set_value(success_rate);
-        }
+  map.addKey("health_status");
+  {
+    Json::BufferStreamer::MapPtr health = map.addMap();
+    if (health_status.eds_health_status() != envoy::config::core::v3::HEALTHY) {
+      health->addEntries({{"eds_health_status", envoy::config::core::v3::HealthStatus_Name(
+                                                    health_status.eds_health_status())}});
+    }
+    for (const auto& [key, value] :
+         {std::make_pair("failed_active_health_check", health_status.failed_active_health_check()),
+          std::make_pair("failed_outlier_check", health_status.failed_outlier_check()),
+          std::make_pair("failed_active_degraded_check",
+                         health_status.failed_active_degraded_check()),
+          std::make_pair("pending_dynamic_removal", health_status.pending_dynamic_removal()),
+          std::make_pair("pending_active_hc", health_status.pending_active_hc()),
+          std::make_pair("excluded_via_immediate_hc_fail",
+                         health_status.excluded_via_immediate_hc_fail()),
+          std::make_pair("active_hc_timeout", health_status.active_hc_timeout())}) {
+      if (value) {
+        health->addEntries({{key, true}});
       }
     }
   }
-  response.add(MessageUtil::getJsonStringFromMessageOrError(clusters, true)); // pretty-print
+
+  const double success_rate = host.outlierDetector().successRate(
+      Upstream::Outlier::DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin);
+  if (success_rate >= 0.0) {
+    addPercentAsJson("success_rate", success_rate, map);
+  }
+  const double local_origin_success_rate = host.outlierDetector().successRate(
+      Upstream::Outlier::DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin);
+  if (local_origin_success_rate >= 0.0) {
+    addPercentAsJson("local_origin_success_rate", local_origin_success_rate, map);
+  }
+
+  if (host.weight() != 0) {
+    map.addEntries({{"weight", static_cast<uint64_t>(host.weight())}});
+  }
+  if (host.priority() != 0) {
+    map.addEntries({{"priority", static_cast<uint64_t>(host.priority())}});
+  }
 }
 
 // TODO(efimki): Add support of text readouts stats.
-void ClustersHandler::writeClustersAsText(Buffer::Instance& response) {
-  // TODO(mattklein123): Add ability to see warming clusters in admin output.
-  auto all_clusters = server_.clusterManager().clusters();
-  for (const auto& [name, cluster_ref] : all_clusters.active_clusters_) {
-    UNREFERENCED_PARAMETER(name);
-    const Upstream::Cluster& cluster = cluster_ref.get();
-    const std::string& cluster_name = cluster.info()->name();
-    response.add(fmt::format("{}::observability_name::{}\n", cluster_name,
-                             cluster.info()->observabilityName()));
-    addOutlierInfo(cluster_name, cluster.outlierDetector(), response);
-
-    addCircuitBreakerSettingsAsText(
-        cluster_name, "default",
-        cluster.info()->resourceManager(Upstream::ResourcePriority::Default), response);
-    addCircuitBreakerSettingsAsText(
-        cluster_name, "high", cluster.info()->resourceManager(Upstream::ResourcePriority::High),
-        response);
-
-    response.add(
-        fmt::format("{}::added_via_api::{}\n", cluster_name, cluster.info()->addedViaApi()));
-    if (const auto& name = cluster.info()->edsServiceName(); !name.empty()) {
-      response.add(fmt::format("{}::eds_service_name::{}\n", cluster_name, name));
-    }
-    for (auto& host_set : cluster.prioritySet().hostSetsPerPriority()) {
-      for (auto& host : host_set->hosts()) {
-        const std::string& host_address = host->address()->asString();
-        std::map<absl::string_view, uint64_t> all_stats;
-        for (const auto& [counter_name, counter] : host->counters()) {
-          all_stats[counter_name] = counter.get().value();
-        }
-
-        for (const auto& [gauge_name, gauge] : host->gauges()) {
-          all_stats[gauge_name] = gauge.get().value();
-        }
-
-        for (const auto& [stat_name, stat] : all_stats) {
-          response.add(
-              fmt::format("{}::{}::{}::{}\n", cluster_name, host_address, stat_name, stat));
-        }
-
-        response.add(
-            fmt::format("{}::{}::hostname::{}\n", cluster_name, host_address, host->hostname()));
-        response.add(fmt::format("{}::{}::health_flags::{}\n", cluster_name, host_address,
-                                 Upstream::HostUtility::healthFlagsToString(*host)));
-        response.add(
-            fmt::format("{}::{}::weight::{}\n", cluster_name, host_address, host->weight()));
-        response.add(fmt::format("{}::{}::region::{}\n", cluster_name, host_address,
-                                 host->locality().region()));
-        response.add(
-            fmt::format("{}::{}::zone::{}\n", cluster_name, host_address, host->locality().zone()));
-        response.add(fmt::format("{}::{}::sub_zone::{}\n", cluster_name, host_address,
-                                 host->locality().sub_zone()));
-        response.add(
-            fmt::format("{}::{}::canary::{}\n", cluster_name, host_address, host->canary()));
-        response.add(
-            fmt::format("{}::{}::priority::{}\n", cluster_name, host_address, host->priority()));
-        response.add(fmt::format(
-            "{}::{}::success_rate::{}\n", cluster_name, host_address,
-            host->outlierDetector().successRate(
-                Upstream::Outlier::DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin)));
-        response.add(fmt::format(
-            "{}::{}::local_origin_success_rate::{}\n", cluster_name, host_address,
-            host->outlierDetector().successRate(
-                Upstream::Outlier::DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin)));
+void ClustersHandler::writeClusterAsText(const Upstream::Cluster& cluster,
+                                         Buffer::Instance& response) const {
+  const std::string& cluster_name = cluster.info()->name();
+  response.add(fmt::format("{}::observability_name::{}\n", cluster_name,
+                           cluster.info()->observabilityName()));
+  addOutlierInfo(cluster_name, cluster.outlierDetector(), response);
+
+  addCircuitBreakerSettingsAsText(
+      cluster_name, "default",
+      cluster.info()->resourceManager(Upstream::ResourcePriority::Default), response);
+  addCircuitBreakerSettingsAsText(
+      cluster_name, "high", cluster.info()->resourceManager(Upstream::ResourcePriority::High),
+      response);
+
+  response.add(fmt::format("{}::added_via_api::{}\n", cluster_name, cluster.info()->addedViaApi()));
+  if (const auto& name = cluster.info()->edsServiceName(); !name.empty()) {
+    response.add(fmt::format("{}::eds_service_name::{}\n", cluster_name, name));
+  }
+  for (auto& host_set : cluster.prioritySet().hostSetsPerPriority()) {
+    for (auto& host : host_set->hosts()) {
+      const std::string& host_address = host->address()->asString();
+      std::map<absl::string_view, uint64_t> all_stats;
+      for (const auto& [counter_name, counter] : host->counters()) {
+        all_stats[counter_name] = counter.get().value();
+      }
+
+      for (const auto& [gauge_name, gauge] : host->gauges()) {
+        all_stats[gauge_name] = gauge.get().value();
       }
+
+      for (const auto& [stat_name, stat] : all_stats) {
+        response.add(fmt::format("{}::{}::{}::{}\n", cluster_name, host_address, stat_name, stat));
+      }
+
+      response.add(
+          fmt::format("{}::{}::hostname::{}\n", cluster_name, host_address, host->hostname()));
+      response.add(fmt::format("{}::{}::health_flags::{}\n", cluster_name, host_address,
+                               Upstream::HostUtility::healthFlagsToString(*host)));
+      response.add(fmt::format("{}::{}::weight::{}\n", cluster_name, host_address, host->weight()));
+      response.add(fmt::format("{}::{}::region::{}\n", cluster_name, host_address,
+                               host->locality().region()));
+      response.add(
+          fmt::format("{}::{}::zone::{}\n", cluster_name, host_address, host->locality().zone()));
+      response.add(fmt::format("{}::{}::sub_zone::{}\n", cluster_name, host_address,
+                               host->locality().sub_zone()));
+      response.add(fmt::format("{}::{}::canary::{}\n", cluster_name, host_address, host->canary()));
+      response.add(
+          fmt::format("{}::{}::priority::{}\n", cluster_name, host_address, host->priority()));
+      response.add(fmt::format(
+          "{}::{}::success_rate::{}\n", cluster_name, host_address,
+          host->outlierDetector().successRate(
+              Upstream::Outlier::DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin)));
+      response.add(fmt::format(
+          "{}::{}::local_origin_success_rate::{}\n", cluster_name, host_address,
+          host->outlierDetector().successRate(
+              Upstream::Outlier::DetectorHostMonitor::SuccessRateMonitorType::LocalOrigin)));
     }
   }
 }
 
 void ClustersHandler::addOutlierInfo(const std::string& cluster_name,
                                      const Upstream::Outlier::Detector* outlier_detector,
-                                     Buffer::Instance& response) {
+                                     Buffer::Instance& response) const {
   if (outlier_detector) {
     response.add(fmt::format(
         "{}::outlier::success_rate_average::{:g}\n", cluster_name,
@@ -291,5 +362,62 @@ void ClustersHandler::addOutlierInfo(const std::string& cluster_name,
   }
 }
 
+ClustersRequest::ClustersRequest(const ClustersHandler& handler,
+                                 Http::Utility::QueryParamsMulti&& query_params)
+    : handler_(handler), query_params_(std::move(query_params)) {}
+
+Http::Code ClustersRequest::start(Http::ResponseHeaderMap& response_headers) {
+  absl::StatusOr<Matchers::StringMatcherPtr> name_matcher =
+      Utility::buildNameMatcher(query_params_, handler_.server_.regexEngine());
+  if (!name_matcher.ok()) {
+    response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Text);
+    error_ = name_matcher.status().ToString();
+    return Http::Code::BadRequest;
+  }
+  name_matcher_ = std::move(*name_matcher);
+
+  const auto format_value = Utility::formatParam(query_params_);
+  json_ = format_value.has_value() && format_value.value() == "json";
+  if (json_) {
+    response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
+  }
+
+  // Only the cluster references are taken here. The hosts of a cluster are gathered when its
+  // chunk is rendered, after the name filter has been applied.
+  clusters_ = handler_.server_.clusterManager().clusters();
+  next_ = clusters_.active_clusters_.begin();
+  return Http::Code::OK;
+}
+
+bool ClustersRequest::nextChunk(Buffer::Instance& response) {
+  if (!error_.empty()) {
+    response.add(error_);
+    return false;
+  }
+
+  // Skip to the next cluster whose name matches.
+  while (next_ != clusters_.active_clusters_.end() && !name_matcher_->match(next_->first)) {
+    ++next_;
+  }
+  if (next_ == clusters_.active_clusters_.end()) {
+    if (json_) {
+      response.add(started_ ? "]}" : "{\"cluster_statuses\":[]}");
+    }
+    return false;
+  }
+
+  const Upstream::Cluster& cluster = next_->second.get();
+  if (json_) {
+    response.add(started_ ? "," : "{\"cluster_statuses\":[");
+    Json::BufferStreamer streamer(response);
+    handler_.writeClusterAsJson(cluster, *streamer.makeRootMap());
+  } else {
+    handler_.writeClusterAsText(cluster, response);
+  }
+  started_ = true;
+  ++next_;
+  return true;
+}
+
 } // namespace Server
 } // namespace Envoy
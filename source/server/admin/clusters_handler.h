@@ -2,11 +2,15 @@
 
 #include "envoy/admin/v3/clusters.pb.h"
 #include "envoy/buffer/buffer.h"
+#include "envoy/common/matchers.h"
 #include "envoy/http/codes.h"
 #include "envoy/http/header_map.h"
+#include "envoy/http/query_params.h"
 #include "envoy/server/admin.h"
 #include "envoy/server/instance.h"
+#include "envoy/upstream/cluster_manager.h"
 
+#include "source/common/json/json_streamer.h"
 #include "source/server/admin/handler_ctx.h"
 
 #include "absl/strings/string_view.h"
@@ -29,15 +33,43 @@ class ClustersHandler : public HandlerContextBase {
 public:
   ClustersHandler(Server::Instance& server);
 
-  Http::Code handlerClusters(Http::ResponseHeaderMap& response_headers, Buffer::Instance& response,
-                             AdminStream&);
+  Admin::RequestPtr makeRequest(AdminStream& admin_stream) const;
 
 private:
+  friend class ClustersRequest;
+
   void addOutlierInfo(const std::string& cluster_name,
                       const Upstream::Outlier::Detector* outlier_detector,
-                      Buffer::Instance& response);
-  void writeClustersAsJson(Buffer::Instance& response);
-  void writeClustersAsText(Buffer::Instance& response);
+                      Buffer::Instance& response) const;
+  void writeClusterAsJson(const Upstream::Cluster& cluster, Json::BufferStreamer::Map& map) const;
+  void writeHostAsJson(const Upstream::Host& host, Json::BufferStreamer::Map& map) const;
+  void writeClusterAsText(const Upstream::Cluster& cluster, Buffer::Instance& response) const;
+};
+
+/**
+ * Renders the clusters one per chunk, so that the output for all the hosts of all the clusters is
+ * never held in memory at once. The JSON output parses as an envoy::admin::v3::Clusters, but is
+ * written directly rather than built as one.
+ */
+class ClustersRequest : public Admin::Request {
+public:
+  ClustersRequest(const ClustersHandler& handler, Http::Utility::QueryParamsMulti&& query_params);
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+  bool nextChunk(Buffer::Instance& response) override;
+
+private:
+  const ClustersHandler& handler_;
+  const Http::Utility::QueryParamsMulti query_params_;
+  bool json_{};
+  Matchers::StringMatcherPtr name_matcher_;
+  // TODO(mattklein123): Add ability to see warming clusters in admin output.
+  Upstream::ClusterManager::ClusterInfoMaps clusters_;
+  Upstream::ClusterManager::ClusterInfoMap::const_iterator next_;
+  bool started_{};
+  // The body of an error response.
+  std::string error_;
 };
 
 } // namespace Server
@@ -11,6 +11,10 @@
 #include "source/common/network/utility.h"
 #include "source/server/admin/utils.h"
 
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -126,69 +130,36 @@ bool shouldIncludeEdsInDump(const Http::Utility::QueryParamsMulti& params) {
   return params.getFirstValue("include_eds").has_value();
 }
 
-absl::StatusOr<Matchers::StringMatcherPtr>
-buildNameMatcher(const Http::Utility::QueryParamsMulti& params, Regex::Engine& engine) {
-  const auto name_regex = params.getFirstValue("name_regex");
-  if (!name_regex.has_value() || name_regex->empty()) {
-    return std::make_unique<Matchers::UniversalStringMatcher>();
-  }
-  envoy::type::matcher::v3::RegexMatcher matcher;
-  *matcher.mutable_google_re2() = envoy::type::matcher::v3::RegexMatcher::GoogleRE2();
-  matcher.set_regex(*name_regex);
-  auto regex_or_error = Regex::Utility::parseRegex(matcher, engine);
-  if (regex_or_error.status().ok()) {
-    return std::move(*regex_or_error);
-  }
-  return absl::InvalidArgumentError(absl::StrCat("Error while parsing name_regex from ",
-                                                 *name_regex, ": ",
-                                                 regex_or_error.status().message()));
-}
-
 } // namespace
 
 ConfigDumpHandler::ConfigDumpHandler(ConfigTracker& config_tracker, Server::Instance& server)
     : HandlerContextBase(server), config_tracker_(config_tracker) {}
 
-Http::Code ConfigDumpHandler::handlerConfigDump(Http::ResponseHeaderMap& response_headers,
-                                                Buffer::Instance& response,
-                                                AdminStream& admin_stream) const {
-  Http::Utility::QueryParamsMulti query_params = admin_stream.queryParams();
+Admin::RequestPtr ConfigDumpHandler::makeRequest(AdminStream& admin_stream) const {
+  return std::make_unique<ConfigDumpRequest>(*this, admin_stream.queryParams());
+}
+
+absl::optional<std::pair<Http::Code, std::string>>
+ConfigDumpHandler::collectConfigs(const Http::Utility::QueryParamsMulti& query_params,
+                                  DumpedConfigs& configs) const {
   const absl::optional<std::string> resource =
       Utility::nonEmptyQueryParam(query_params, "resource");
   const absl::optional<std::string> mask = Utility::nonEmptyQueryParam(query_params, "mask");
   const bool include_eds = shouldIncludeEdsInDump(query_params);
   const absl::StatusOr<Matchers::StringMatcherPtr> name_matcher =
-      buildNameMatcher(query_params, server_.regexEngine());
+      Utility::buildNameMatcher(query_params, server_.regexEngine());
   if (!name_matcher.ok()) {
-    response.add(name_matcher.status().ToString());
-    response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Text);
-    return Http::Code::BadRequest;
+    return std::make_pair(Http::Code::BadRequest, name_matcher.status().ToString());
   }
 
-  envoy::admin::v3::ConfigDump dump;
-
-  absl::optional<std::pair<Http::Code, std::string>> err;
   if (resource.has_value()) {
-    err = addResourceToDump(dump, mask, resource.value(), **name_matcher, include_eds);
-  } else {
-    err = addAllConfigToDump(dump, mask, **name_matcher, include_eds);
+    return addResourceToDump(configs, mask, resource.value(), **name_matcher, include_eds);
   }
-  if (err.has_value()) {
-    response_headers.addReference(Http::Headers::get().XContentTypeOptions,
-                                  Http::Headers::get().XContentTypeOptionValues.Nosniff);
-    response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Text);
-    response.add(err.value().second);
-    return err.value().first;
-  }
-  MessageUtil::redact(dump);
-
-  response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
-  response.add(MessageUtil::getJsonStringFromMessageOrError(dump, true)); // pretty-print
-  return Http::Code::OK;
+  return addAllConfigToDump(configs, mask, **name_matcher, include_eds);
 }
 
 absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addResourceToDump(
-    envoy::admin::v3::ConfigDump& dump, const absl::optional<std::string>& mask,
+    DumpedConfigs& configs, const absl::optional<std::string>& mask,
     const std::string& resource, const Matchers::StringMatcher& name_matcher,
     bool include_eds) const {
   Envoy::Server::ConfigTracker::CbsMap callbacks_map = config_tracker_.getCallbacksMap();
@@ -218,7 +189,10 @@ absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addResourc
                       field_descriptor->name(), field_descriptor->name()))};
     }
 
-    auto repeated = reflection->GetRepeatedPtrField<Protobuf::Message>(*message, field_descriptor);
+    // Each element of the field is a config of the dump.
+    auto& repeated =
+        *reflection->MutableRepeatedPtrField<Protobuf::Message>(message.get(), field_descriptor);
+    configs.sources_.push_back(std::move(message));
     for (Protobuf::Message& msg : repeated) {
       if (mask.has_value()) {
         Protobuf::FieldMask field_mask;
@@ -229,8 +203,7 @@ absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addResourc
                                                    " could not be successfully used."))};
         }
       }
-      auto* config = dump.add_configs();
-      config->PackFrom(msg);
+      configs.entries_.push_back({&msg, configs.sources_.size() - 1});
     }
 
     // We found the desired resource so there is no need to continue iterating over
@@ -243,7 +216,7 @@ absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addResourc
 }
 
 absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addAllConfigToDump(
-    envoy::admin::v3::ConfigDump& dump, const absl::optional<std::string>& mask,
+    DumpedConfigs& configs, const absl::optional<std::string>& mask,
     const Matchers::StringMatcher& name_matcher, bool include_eds) const {
   Envoy::Server::ConfigTracker::CbsMap callbacks_map = config_tracker_.getCallbacksMap();
   if (include_eds) {
@@ -273,10 +246,9 @@ absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addAllConf
       }
     }
 
-    auto* config = dump.add_configs();
-    config->PackFrom(*message);
+    configs.add(std::move(message));
   }
-  if (dump.configs().empty() && mask.has_value()) {
+  if (configs.entries_.empty() && mask.has_value()) {
     return absl::optional<std::pair<Http::Code, std::string>>{std::make_pair(
         Http::Code::BadRequest,
         absl::StrCat("FieldMask ", *mask, " could not be successfully applied to any configs."))};
@@ -400,5 +372,60 @@ void ConfigDumpHandler::addLbEndpoint(
   }
 }
 
+ConfigDumpRequest::ConfigDumpRequest(const ConfigDumpHandler& handler,
+                                     Http::Utility::QueryParamsMulti&& query_params)
+    : handler_(handler), query_params_(std::move(query_params)) {}
+
+Http::Code ConfigDumpRequest::start(Http::ResponseHeaderMap& response_headers) {
+  absl::optional<std::pair<Http::Code, std::string>> err =
+      handler_.collectConfigs(query_params_, configs_);
+  if (err.has_value()) {
+    response_headers.addReference(Http::Headers::get().XContentTypeOptions,
+                                  Http::Headers::get().XContentTypeOptionValues.Nosniff);
+    response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Text);
+    error_ = std::move(err.value().second);
+    configs_ = DumpedConfigs();
+    return err.value().first;
+  }
+  response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
+  return Http::Code::OK;
+}
+
+bool ConfigDumpRequest::nextChunk(Buffer::Instance& response) {
+  if (!error_.empty()) {
+    response.add(error_);
+    return false;
+  }
+  const std::vector<DumpedConfigs::Entry>& entries = configs_.entries_;
+  if (entries.empty()) {
+    // An empty ConfigDump renders as an empty object.
+    response.add("{}\n");
+    return false;
+  }
+
+  const DumpedConfigs::Entry& entry = entries[next_];
+  MessageUtil::redact(*entry.config_);
+  ProtobufWkt::Any any;
+  any.PackFrom(*entry.config_);
+  std::string json = MessageUtil::getJsonStringFromMessageOrError(any, true); // pretty-print
+  if (absl::EndsWith(json, "\n")) {
+    json.pop_back();
+  }
+  // Indent the config as an element of the "configs" array of a pretty-printed ConfigDump.
+  response.add(absl::StrCat(next_ == 0 ? "{\n \"configs\": [\n  " : ",\n  ",
+                            absl::StrReplaceAll(json, {{"\n", "\n  "}})));
+
+  ++next_;
+  // Release the message holding the config once all of its configs are rendered.
+  if (next_ == entries.size() || entries[next_].source_ != entry.source_) {
+    configs_.sources_[entry.source_].reset();
+  }
+  if (next_ < entries.size()) {
+    return true;
+  }
+  response.add("\n ]\n}\n");
+  return false;
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -5,6 +5,7 @@
 #include "envoy/config/endpoint/v3/endpoint_components.pb.h"
 #include "envoy/http/codes.h"
 #include "envoy/http/header_map.h"
+#include "envoy/http/query_params.h"
 #include "envoy/server/admin.h"
 #include "envoy/server/instance.h"
 
@@ -16,25 +17,55 @@
 namespace Envoy {
 namespace Server {
 
+/**
+ * The configs of a dump, in order. The configs point into the messages returned by the config
+ * tracker callbacks, which are kept along with them.
+ */
+struct DumpedConfigs {
+  struct Entry {
+    Protobuf::Message* config_;
+    // The index of the message holding the config in sources_.
+    size_t source_;
+  };
+
+  void add(ProtobufTypes::MessagePtr source) {
+    entries_.push_back({source.get(), sources_.size()});
+    sources_.push_back(std::move(source));
+  }
+
+  std::vector<ProtobufTypes::MessagePtr> sources_;
+  std::vector<Entry> entries_;
+};
+
 class ConfigDumpHandler : public HandlerContextBase {
 
 public:
   ConfigDumpHandler(ConfigTracker& config_tracker, Server::Instance& server);
 
-  Http::Code handlerConfigDump(Http::ResponseHeaderMap& response_headers,
-                               Buffer::Instance& response, AdminStream&) const;
+  Admin::RequestPtr makeRequest(AdminStream& admin_stream) const;
 
 private:
+  friend class ConfigDumpRequest;
+
+  /**
+   * Collects the configs to dump, with the name, resource and mask filters applied.
+   * @return absl::nullopt on success, else the Http::Code and an error message that should be added
+   * to the admin response.
+   */
   absl::optional<std::pair<Http::Code, std::string>>
-  addAllConfigToDump(envoy::admin::v3::ConfigDump& dump, const absl::optional<std::string>& mask,
+  collectConfigs(const Http::Utility::QueryParamsMulti& query_params,
+                 DumpedConfigs& configs) const;
+
+  absl::optional<std::pair<Http::Code, std::string>>
+  addAllConfigToDump(DumpedConfigs& configs, const absl::optional<std::string>& mask,
                      const Matchers::StringMatcher& name_matcher, bool include_eds) const;
   /**
-   * Add the config matching the passed resource to the passed config dump.
+   * Add the config matching the passed resource to the passed configs.
    * @return absl::nullopt on success, else the Http::Code and an error message that should be added
    * to the admin response.
    */
   absl::optional<std::pair<Http::Code, std::string>>
-  addResourceToDump(envoy::admin::v3::ConfigDump& dump, const absl::optional<std::string>& mask,
+  addResourceToDump(DumpedConfigs& configs, const absl::optional<std::string>& mask,
                     const std::string& resource, const Matchers::StringMatcher& name_matcher,
                     bool include_eds) const;
 
@@ -49,5 +80,28 @@ private:
   ConfigTracker& config_tracker_;
 };
 
+/**
+ * Renders a config dump one config per chunk, so that the JSON of the whole dump is never held in
+ * memory at once. The output is the same as rendering the envoy::admin::v3::ConfigDump holding
+ * the configs.
+ */
+class ConfigDumpRequest : public Admin::Request {
+public:
+  ConfigDumpRequest(const ConfigDumpHandler& handler,
+                    Http::Utility::QueryParamsMulti&& query_params);
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+  bool nextChunk(Buffer::Instance& response) override;
+
+private:
+  const ConfigDumpHandler& handler_;
+  const Http::Utility::QueryParamsMulti query_params_;
+  DumpedConfigs configs_;
+  size_t next_{0};
+  // The body of an error response.
+  std::string error_;
+};
+
 } // namespace Server
 } // namespace Envoy
@@ -1,12 +1,15 @@
 #include "source/server/admin/profiling_handler.h"
 
+#include "source/common/http/headers.h"
 #include "source/common/profiler/profiler.h"
 #include "source/server/admin/utils.h"
 
 namespace Envoy {
 namespace Server {
 
-ProfilingHandler::ProfilingHandler(const std::string& profile_path) : profile_path_(profile_path) {}
+ProfilingHandler::ProfilingHandler(const std::string& profile_path,
+                                   Filesystem::Instance& file_system)
+    : profile_path_(profile_path), file_system_(file_system) {}
 
 Http::Code ProfilingHandler::handlerCpuProfiler(Http::ResponseHeaderMap&,
                                                 Buffer::Instance& response,
@@ -34,6 +37,25 @@ Http::Code ProfilingHandler::handlerCpuProfiler(Http::ResponseHeaderMap&,
   return Http::Code::OK;
 }
 
+Http::Code ProfilingHandler::handlerCpuProfile(Http::ResponseHeaderMap& response_headers,
+                                               Buffer::Instance& response, AdminStream&) {
+  // The profiler keeps running, so that it can be left enabled at a low sampling frequency and
+  // its samples fetched whenever needed.
+  if (!Profiler::Cpu::flushProfiler()) {
+    response.add("The CPU profiler is not running");
+    return Http::Code::BadRequest;
+  }
+
+  auto profile = file_system_.fileReadToEnd(profile_path_);
+  if (!profile.ok()) {
+    response.add(fmt::format("Fail to read the CPU profile: {}", profile.status().message()));
+    return Http::Code::InternalServerError;
+  }
+  response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.OctetStream);
+  response.add(profile.value());
+  return Http::Code::OK;
+}
+
 Http::Code ProfilingHandler::handlerHeapProfiler(Http::ResponseHeaderMap&,
                                                  Buffer::Instance& response,
                                                  AdminStream& admin_stream) {
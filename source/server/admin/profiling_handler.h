@@ -1,6 +1,7 @@
 #pragma once
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/filesystem/filesystem.h"
 #include "envoy/http/codes.h"
 #include "envoy/http/header_map.h"
 #include "envoy/server/admin.h"
@@ -13,16 +14,20 @@ namespace Server {
 class ProfilingHandler {
 
 public:
-  ProfilingHandler(const std::string& profile_path);
+  ProfilingHandler(const std::string& profile_path, Filesystem::Instance& file_system);
 
   Http::Code handlerCpuProfiler(Http::ResponseHeaderMap& response_headers,
                                 Buffer::Instance& response, AdminStream&);
 
+  Http::Code handlerCpuProfile(Http::ResponseHeaderMap& response_headers,
+                               Buffer::Instance& response, AdminStream&);
+
   Http::Code handlerHeapProfiler(Http::ResponseHeaderMap& response_headers,
                                  Buffer::Instance& response, AdminStream&);
 
 private:
   const std::string profile_path_;
+  Filesystem::Instance& file_system_;
 };
 
 class TcmallocProfilingHandler {
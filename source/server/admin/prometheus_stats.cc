@@ -8,6 +8,7 @@
 #include "source/common/stats/histogram_impl.h"
 #include "source/common/upstream/host_utility.h"
 
+#include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
 
@@ -20,6 +21,8 @@ const Regex::CompiledGoogleReMatcher& promRegex() {
   CONSTRUCT_ON_FIRST_USE(Regex::CompiledGoogleReMatcherNoSafetyChecks, "[^a-zA-Z0-9_]");
 }
 
+bool isValidNameChar(char c) { return absl::ascii_isalnum(c) || c == '_'; }
+
 /**
  * Take a string and sanitize it according to Prometheus conventions.
  */
@@ -27,23 +30,39 @@ std::string sanitizeName(const absl::string_view name) {
   // The name must match the regex [a-zA-Z_][a-zA-Z0-9_]* as required by
   // prometheus. Refer to https://prometheus.io/docs/concepts/data_model/.
   // The initial [a-zA-Z_] constraint is always satisfied by the namespace prefix.
-  return promRegex().replaceAll(name, "_");
+  // Names are sanitized for every metric of a scrape, so ASCII names, i.e. nearly all of them, are
+  // sanitized without the regex. Non-ASCII characters are replaced by the regex, which replaces a
+  // multi-byte UTF-8 character with a single '_'.
+  std::string sanitized(name);
+  for (char& c : sanitized) {
+    if (!absl::ascii_isascii(c)) {
+      return promRegex().replaceAll(name, "_");
+    }
+    if (!isValidNameChar(c)) {
+      c = '_';
+    }
+  }
+  return sanitized;
 }
 
 /**
  * Take tag values and sanitize it for text serialization, according to
- * Prometheus conventions.
+ * Prometheus conventions, and append it to the output.
  */
-std::string sanitizeValue(const absl::string_view value) {
+void appendSanitizedValue(const absl::string_view value, std::string& output) {
   // Removes problematic characters from Prometheus tag values to prevent
   // text serialization issues. This matches the prometheus text formatting code:
   // https://github.com/prometheus/common/blob/88f1636b699ae4fb949d292ffb904c205bf542c9/expfmt/text_create.go#L419-L420.
   // The goal is to replace '\' with "\\", newline with "\n", and '"' with "\"".
-  return absl::StrReplaceAll(value, {
-                                        {R"(\)", R"(\\)"},
-                                        {"\n", R"(\n)"},
-                                        {R"(")", R"(\")"},
-                                    });
+  if (value.find_first_of("\\\n\"") == absl::string_view::npos) {
+    output.append(value.data(), value.size());
+    return;
+  }
+  absl::StrAppend(&output, absl::StrReplaceAll(value, {
+                                                          {R"(\)", R"(\\)"},
+                                                          {"\n", R"(\n)"},
+                                                          {R"(")", R"(\")"},
+                                                      }));
 }
 
 /*
@@ -66,8 +85,8 @@ struct PrimitiveMetricSnapshotLessThan {
 
 std::string generateNumericOutput(uint64_t value, const Stats::TagVector& tags,
                                   const std::string& prefixed_tag_extracted_name) {
-  const std::string formatted_tags = PrometheusStatsFormatter::formattedTags(tags);
-  return fmt::format("{0}{{{1}}} {2}\n", prefixed_tag_extracted_name, formatted_tags, value);
+  return absl::StrCat(prefixed_tag_extracted_name, "{",
+                      PrometheusStatsFormatter::formattedTags(tags), "} ", value, "\n");
 }
 
 /*
@@ -308,12 +327,16 @@ std::string generateSummaryOutput(const Stats::ParentHistogram& histogram,
 } // namespace
 
 std::string PrometheusStatsFormatter::formattedTags(const std::vector<Stats::Tag>& tags) {
-  std::vector<std::string> buf;
-  buf.reserve(tags.size());
+  std::string output;
   for (const Stats::Tag& tag : tags) {
-    buf.push_back(fmt::format("{}=\"{}\"", sanitizeName(tag.name_), sanitizeValue(tag.value_)));
+    if (!output.empty()) {
+      output.push_back(',');
+    }
+    absl::StrAppend(&output, sanitizeName(tag.name_), "=\"");
+    appendSanitizedValue(tag.value_, output);
+    output.push_back('"');
   }
-  return absl::StrJoin(buf, ",");
+  return output;
 }
 
 absl::Status PrometheusStatsFormatter::validateParams(const StatsParams& params) {
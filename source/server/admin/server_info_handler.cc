@@ -41,7 +41,8 @@ Http::Code ServerInfoHandler::handlerHotRestartVersion(Http::ResponseHeaderMap&,
 
 // TODO(ambuc): Add more tcmalloc stats, export proto details based on allocator.
 Http::Code ServerInfoHandler::handlerMemory(Http::ResponseHeaderMap& response_headers,
-                                            Buffer::Instance& response, AdminStream&) {
+                                            Buffer::Instance& response,
+                                            AdminStream& admin_stream) {
   response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
   envoy::admin::v3::Memory memory;
   memory.set_allocated(Memory::Stats::totalCurrentlyAllocated());
@@ -50,6 +51,11 @@ Http::Code ServerInfoHandler::handlerMemory(Http::ResponseHeaderMap& response_he
   memory.set_pageheap_unmapped(Memory::Stats::totalPageHeapUnmapped());
   memory.set_pageheap_free(Memory::Stats::totalPageHeapFree());
   memory.set_total_physical_bytes(Memory::Stats::totalPhysicalBytes());
+  if (admin_stream.queryParams().getFirstValue("subsystems").has_value()) {
+    for (const auto& [subsystem, allocated] : Memory::Stats::allocatedBySubsystem()) {
+      (*memory.mutable_allocated_by_subsystem())[subsystem] = allocated;
+    }
+  }
   response.add(MessageUtil::getJsonStringFromMessageOrError(memory, true, true)); // pretty-print
   return Http::Code::OK;
 }
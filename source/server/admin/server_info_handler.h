@@ -31,7 +31,7 @@ public:
                                       Buffer::Instance& response, AdminStream&);
 
   Http::Code handlerMemory(Http::ResponseHeaderMap& response_headers, Buffer::Instance& response,
-                           AdminStream&);
+                           AdminStream& admin_stream);
 };
 
 } // namespace Server
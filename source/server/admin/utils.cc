@@ -1,8 +1,13 @@
 #include "source/server/admin/utils.h"
 
+#include "envoy/type/matcher/v3/regex.pb.h"
+
 #include "source/common/common/enum_to_int.h"
+#include "source/common/common/regex.h"
 #include "source/common/http/headers.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Server {
 namespace Utility {
@@ -68,6 +73,24 @@ absl::optional<std::string> formatParam(const Http::Utility::QueryParamsMulti& p
   return nonEmptyQueryParam(params, "format");
 }
 
+absl::StatusOr<Matchers::StringMatcherPtr>
+buildNameMatcher(const Http::Utility::QueryParamsMulti& params, Regex::Engine& engine) {
+  const auto name_regex = params.getFirstValue("name_regex");
+  if (!name_regex.has_value() || name_regex->empty()) {
+    return std::make_unique<Matchers::UniversalStringMatcher>();
+  }
+  envoy::type::matcher::v3::RegexMatcher matcher;
+  *matcher.mutable_google_re2() = envoy::type::matcher::v3::RegexMatcher::GoogleRE2();
+  matcher.set_regex(*name_regex);
+  auto regex_or_error = Regex::Utility::parseRegex(matcher, engine);
+  if (regex_or_error.status().ok()) {
+    return std::move(*regex_or_error);
+  }
+  return absl::InvalidArgumentError(absl::StrCat("Error while parsing name_regex from ",
+                                                 *name_regex, ": ",
+                                                 regex_or_error.status().message()));
+}
+
 } // namespace Utility
 } // namespace Server
 } // namespace Envoy
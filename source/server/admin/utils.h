@@ -3,12 +3,17 @@
 #include <regex>
 
 #include "envoy/admin/v3/server_info.pb.h"
+#include "envoy/common/matchers.h"
+#include "envoy/common/regex.h"
 #include "envoy/init/manager.h"
 
+#include "source/common/common/matchers.h"
 #include "source/common/http/codes.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/utility.h"
 
+#include "absl/status/statusor.h"
+
 namespace Envoy {
 namespace Server {
 namespace Utility {
@@ -28,6 +33,14 @@ absl::optional<std::string> formatParam(const Http::Utility::QueryParamsMulti& p
 absl::optional<std::string> nonEmptyQueryParam(const Http::Utility::QueryParamsMulti& params,
                                                const std::string& key);
 
+/**
+ * Builds the matcher of the names of the resources to render from the name_regex query parameter,
+ * which matches every name when it is absent or empty.
+ * @return an InvalidArgumentError if the regex is malformed.
+ */
+absl::StatusOr<Matchers::StringMatcherPtr>
+buildNameMatcher(const Http::Utility::QueryParamsMulti& params, Regex::Engine& engine);
+
 } // namespace Utility
 } // namespace Server
 } // namespace Envoy
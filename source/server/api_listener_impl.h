@@ -150,6 +150,7 @@ protected:
       unixSocketPeerCredentials() const override {
         return absl::nullopt;
       }
+      OptRef<Network::IoHandle> socketIoHandle() override { return {}; }
       void setConnectionStats(const Network::Connection::ConnectionStats&) override {}
       Ssl::ConnectionInfoConstSharedPtr ssl() const override { return nullptr; }
       absl::string_view requestedServerName() const override { return EMPTY_STRING; }
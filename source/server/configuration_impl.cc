@@ -83,7 +83,10 @@ bool FilterChainUtility::buildQuicFilterChain(
 
 StatsConfigImpl::StatsConfigImpl(const envoy::config::bootstrap::v3::Bootstrap& bootstrap,
                                  absl::Status& status)
-    : deferred_stat_options_(bootstrap.deferred_stat_options()) {
+    : deferred_stat_options_(bootstrap.deferred_stat_options()),
+      enable_delta_stat_flush_(bootstrap.delta_stat_flush_options().enable_delta_stat_flush()),
+      delta_stat_full_flush_interval_(PROTOBUF_GET_MS_OR_DEFAULT(
+          bootstrap.delta_stat_flush_options(), full_flush_interval, 60000)) {
   status = absl::OkStatus();
   if (bootstrap.has_stats_flush_interval() &&
       bootstrap.stats_flush_case() !=
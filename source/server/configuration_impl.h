@@ -61,12 +61,18 @@ public:
   bool enableDeferredCreationStats() const override {
     return deferred_stat_options_.enable_deferred_creation_stats();
   }
+  bool enableDeltaStatFlush() const override { return enable_delta_stat_flush_; }
+  std::chrono::milliseconds deltaStatFullFlushInterval() const override {
+    return delta_stat_full_flush_interval_;
+  }
 
 private:
   std::list<Stats::SinkPtr> sinks_;
   std::chrono::milliseconds flush_interval_;
   bool flush_on_admin_{false};
   const envoy::config::bootstrap::v3::Bootstrap::DeferredStatOptions deferred_stat_options_;
+  const bool enable_delta_stat_flush_;
+  const std::chrono::milliseconds delta_stat_full_flush_interval_;
 };
 
 /**
@@ -150,7 +150,9 @@ std::unique_ptr<HotRestartMessage> HotRestartingChild::getParentStats() {
   }
 
   HotRestartMessage wrapped_request;
-  wrapped_request.mutable_request()->mutable_stats();
+  // Once the gauges of a reply were merged, the parent only has to send the changed ones.
+  const bool changed_gauges_only = stat_merger_ != nullptr;
+  wrapped_request.mutable_request()->mutable_stats()->set_changed_gauges_only(changed_gauges_only);
   main_rpc_stream_.sendHotRestartMessage(parent_address_, wrapped_request);
 
   std::unique_ptr<HotRestartMessage> wrapped_reply =
@@ -85,7 +85,8 @@ void HotRestartingParent::onSocketEvent() {
 
     case HotRestartMessage::Request::kStats: {
       HotRestartMessage wrapped_reply;
-      internal_->exportStatsToChild(wrapped_reply.mutable_reply()->mutable_stats());
+      internal_->exportStatsToChild(wrapped_reply.mutable_reply()->mutable_stats(),
+                                    wrapped_request->request().stats().changed_gauges_only());
       main_rpc_stream_.sendHotRestartMessage(child_address_, wrapped_reply);
       break;
     }
@@ -172,14 +173,27 @@ HotRestartingParent::Internal::getListenSocketsForChild(const HotRestartMessage:
 // implementation can negate the benefit of symbolized stat names by periodically reaching the
 // magnitude of memory usage that they are meant to avoid, since this map holds full-string
 // names. The problem can be solved by splitting the export up over many chunks.
-void HotRestartingParent::Internal::exportStatsToChild(HotRestartMessage::Reply::Stats* stats) {
-  server_->stats().forEachSinkedGauge(nullptr, [this, stats](Stats::Gauge& gauge) mutable {
-    if (gauge.used()) {
-      const std::string name = gauge.name();
-      (*stats->mutable_gauges())[name] = gauge.value();
-      recordDynamics(stats, name, gauge.statName());
-    }
-  });
+void HotRestartingParent::Internal::exportStatsToChild(HotRestartMessage::Reply::Stats* stats,
+                                                       bool changed_gauges_only) {
+  // Gauges are exported on every stats flush of the child until the parent terminates, but most of
+  // them don't change, so the child can ask for the changed ones only.
+  absl::flat_hash_map<std::string, uint64_t> exported_gauges;
+  exported_gauges.reserve(exported_gauges_.size());
+  server_->stats().forEachSinkedGauge(
+      nullptr, [this, stats, changed_gauges_only, &exported_gauges](Stats::Gauge& gauge) mutable {
+        if (gauge.used()) {
+          std::string name = gauge.name();
+          const uint64_t value = gauge.value();
+          const auto previous = exported_gauges_.find(name);
+          if (!changed_gauges_only || previous == exported_gauges_.end() ||
+              previous->second != value) {
+            (*stats->mutable_gauges())[name] = value;
+            recordDynamics(stats, name, gauge.statName());
+          }
+          exported_gauges.emplace(std::move(name), value);
+        }
+      });
+  exported_gauges_ = std::move(exported_gauges);
 
   server_->stats().forEachSinkedCounter(nullptr, [this, stats](Stats::Counter& counter) mutable {
     if (counter.used()) {
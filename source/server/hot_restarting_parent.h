@@ -3,6 +3,8 @@
 #include "source/common/common/hash.h"
 #include "source/server/hot_restarting_base.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -36,7 +38,10 @@ public:
     envoy::HotRestartMessage
     getListenSocketsForChild(const envoy::HotRestartMessage::Request& request);
     // 'stats' is a field in the reply protobuf to be sent to the child, which we should populate.
-    void exportStatsToChild(envoy::HotRestartMessage::Reply::Stats* stats);
+    // If changed_gauges_only is set, only the gauges whose value changed since the previous export
+    // are included.
+    void exportStatsToChild(envoy::HotRestartMessage::Reply::Stats* stats,
+                            bool changed_gauges_only = false);
     void recordDynamics(envoy::HotRestartMessage::Reply::Stats* stats, const std::string& name,
                         Stats::StatName stat_name);
     void drainListeners();
@@ -47,6 +52,8 @@ public:
   private:
     Server::Instance* const server_{};
     HotRestartMessageSender& udp_sender_;
+    // The gauge values of the previous export, by name.
+    absl::flat_hash_map<std::string, uint64_t> exported_gauges_;
   };
 
 private:
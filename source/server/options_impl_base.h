@@ -79,6 +79,9 @@ public:
     signal_handling_enabled_ = signal_handling_enabled;
   }
   void setCpusetThreads(bool cpuset_threads_enabled) { cpuset_threads_ = cpuset_threads_enabled; }
+  void setPinWorkerThreads(bool pin_worker_threads_enabled) {
+    pin_worker_threads_ = pin_worker_threads_enabled;
+  }
   void setAllowUnknownFields(bool allow_unknown_static_fields) {
     allow_unknown_static_fields_ = allow_unknown_static_fields;
   }
@@ -146,6 +149,7 @@ public:
   bool coreDumpEnabled() const override { return core_dump_enabled_; }
   const Stats::TagVector& statsTags() const override { return stats_tags_; }
   bool cpusetThreadsEnabled() const override { return cpuset_threads_; }
+  bool pinWorkerThreadsEnabled() const override { return pin_worker_threads_; }
   const std::vector<std::string>& disabledExtensions() const override {
     return disabled_extensions_;
   }
@@ -210,6 +214,7 @@ private:
   bool mutex_tracing_enabled_{false};
   bool core_dump_enabled_{false};
   bool cpuset_threads_{false};
+  bool pin_worker_threads_{false};
   std::vector<std::string> disabled_extensions_;
   Stats::TagVector stats_tags_;
   uint32_t count_{0};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 
 #include "source/common/common/logger.h"
 
@@ -8,5 +9,8 @@ namespace Envoy {
 class OptionsImplPlatform : protected Logger::Loggable<Logger::Id::config> {
 public:
   static uint32_t getCpuCount();
+  // @return the CPUs the process may run on, in increasing order, or an empty vector if they can't
+  //         be known on this platform.
+  static std::vector<uint32_t> getCpus();
 };
 } // namespace Envoy
@@ -10,4 +10,9 @@ uint32_t OptionsImplPlatform::getCpuCount() {
   return std::thread::hardware_concurrency();
 }
 
+std::vector<uint32_t> OptionsImplPlatform::getCpus() {
+  ENVOY_LOG(warn, "CPUs to pin threads to are only known on Linux, not pinning threads.");
+  return {};
+}
+
 } // namespace Envoy
@@ -37,9 +37,31 @@ uint32_t OptionsImplPlatformLinux::getCpuAffinityCount(unsigned int hw_threads)
   return hw_threads;
 }
 
+std::vector<uint32_t> OptionsImplPlatformLinux::getCpuAffinity() {
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().sched_getaffinity(getpid(), sizeof(cpu_set_t), &mask);
+  if (result.return_value_ == -1) {
+    return {};
+  }
+
+  std::vector<uint32_t> cpus;
+  for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &mask)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
 uint32_t OptionsImplPlatform::getCpuCount() {
   unsigned int hw_threads = std::max(1U, std::thread::hardware_concurrency());
   return OptionsImplPlatformLinux::getCpuAffinityCount(hw_threads);
 }
 
+std::vector<uint32_t> OptionsImplPlatform::getCpus() {
+  return OptionsImplPlatformLinux::getCpuAffinity();
+}
+
 } // namespace Envoy
@@ -6,10 +6,12 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace Envoy {
 class OptionsImplPlatformLinux {
 public:
   static uint32_t getCpuAffinityCount(unsigned int hw_threads);
+  static std::vector<uint32_t> getCpuAffinity();
 };
 } // namespace Envoy
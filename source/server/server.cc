@@ -54,6 +54,7 @@
 #include "source/server/configuration_impl.h"
 #include "source/server/listener_hooks.h"
 #include "source/server/listener_manager_factory.h"
+#include "source/server/options_impl_platform.h"
 #include "source/server/regex_engine.h"
 #include "source/server/utils.h"
 
@@ -87,7 +88,9 @@ InstanceBase::InstanceBase(Init::Manager& init_manager, const Options& options,
       validation_context_(options_.allowUnknownStaticFields(),
                           !options.rejectUnknownDynamicFields(),
                           options.ignoreUnknownDynamicFields(), options.skipDeprecatedLogs()),
-      time_source_(time_system), restarter_(restarter), start_time_(time(nullptr)),
+      time_source_(time_system),
+      startup_trace_(time_source_, Memory::Stats::totalCurrentlyAllocated), restarter_(restarter),
+      start_time_(time(nullptr)),
       original_start_time_(start_time_), stats_store_(store), thread_local_(tls),
       random_generator_(std::move(random_generator)),
       api_(new Api::Impl(
@@ -97,7 +100,10 @@ InstanceBase::InstanceBase(Init::Manager& init_manager, const Options& options,
       dispatcher_(api_->allocateDispatcher("main_thread")),
       access_log_manager_(options.fileFlushIntervalMsec(), *api_, *dispatcher_, access_log_lock,
                           store),
-      handler_(getHandler(*dispatcher_)), worker_factory_(thread_local_, *api_, hooks),
+      handler_(getHandler(*dispatcher_)),
+      worker_factory_(thread_local_, *api_, hooks,
+                      options.pinWorkerThreadsEnabled() ? OptionsImplPlatform::getCpus()
+                                                        : std::vector<uint32_t>{}),
       mutex_tracer_(options.mutexTracingEnabled() ? &Envoy::MutexTracerImpl::getOrCreateTracer()
                                                   : nullptr),
       grpc_context_(store.symbolTable()), http_context_(store.symbolTable()),
@@ -161,17 +167,47 @@ void InstanceBase::failHealthcheck(bool fail) {
   server_stats_->live_.set(live_.load());
 }
 
+bool DeltaStatFlushState::beginFlush(MonotonicTime now) {
+  current_gauges_.reserve(previous_gauges_.size());
+  if (!last_full_flush_.has_value() || now - last_full_flush_.value() >= full_flush_interval_) {
+    last_full_flush_ = now;
+    return false;
+  }
+  return true;
+}
+
+bool DeltaStatFlushState::gaugeChanged(Stats::Gauge& gauge) {
+  const uint64_t value = gauge.value();
+  current_gauges_.emplace(&gauge, GaugeValue{Stats::GaugeSharedPtr(&gauge), value});
+  const auto it = previous_gauges_.find(&gauge);
+  return it == previous_gauges_.end() || it->second.value_ != value;
+}
+
+void DeltaStatFlushState::endFlush() {
+  // Gauges that were not flushed again, e.g. because they were removed, are released.
+  previous_gauges_ = std::move(current_gauges_);
+  current_gauges_.clear();
+}
+
 MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
                                        Upstream::ClusterManager& cluster_manager,
-                                       TimeSource& time_source) {
+                                       TimeSource& time_source, DeltaStatFlushState* delta_state) {
+  const bool changed_only =
+      delta_state != nullptr && delta_state->beginFlush(time_source.monotonicTime());
+
   store.forEachSinkedCounter(
       [this](std::size_t size) {
         snapped_counters_.reserve(size);
         counters_.reserve(size);
       },
-      [this](Stats::Counter& counter) {
+      [this, changed_only](Stats::Counter& counter) {
+        // Counters are latched even if they are not flushed.
+        const uint64_t delta = counter.latch();
+        if (changed_only && delta == 0) {
+          return;
+        }
         snapped_counters_.push_back(Stats::CounterSharedPtr(&counter));
-        counters_.push_back({counter.latch(), counter});
+        counters_.push_back({delta, counter});
       });
 
   store.forEachSinkedGauge(
@@ -179,7 +215,10 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
         snapped_gauges_.reserve(size);
         gauges_.reserve(size);
       },
-      [this](Stats::Gauge& gauge) {
+      [this, delta_state, changed_only](Stats::Gauge& gauge) {
+        if (delta_state != nullptr && !delta_state->gaugeChanged(gauge) && changed_only) {
+          return;
+        }
         snapped_gauges_.push_back(Stats::GaugeSharedPtr(&gauge));
         gauges_.push_back(gauge);
       });
@@ -189,7 +228,10 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
         snapped_histograms_.reserve(size);
         histograms_.reserve(size);
       },
-      [this](Stats::ParentHistogram& histogram) {
+      [this, changed_only](Stats::ParentHistogram& histogram) {
+        if (changed_only && histogram.intervalStatistics().sampleCount() == 0) {
+          return;
+        }
         snapped_histograms_.push_back(Stats::ParentHistogramSharedPtr(&histogram));
         histograms_.push_back(histogram);
       });
@@ -206,23 +248,30 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
 
   Upstream::HostUtility::forEachHostMetric(
       cluster_manager,
-      [this](Stats::PrimitiveCounterSnapshot&& metric) {
+      [this, changed_only](Stats::PrimitiveCounterSnapshot&& metric) {
+        if (changed_only && metric.delta() == 0) {
+          return;
+        }
         host_counters_.emplace_back(std::move(metric));
       },
       [this](Stats::PrimitiveGaugeSnapshot&& metric) {
         host_gauges_.emplace_back(std::move(metric));
       });
 
+  if (delta_state != nullptr) {
+    delta_state->endFlush();
+  }
   snapshot_time_ = time_source.systemTime();
 }
 
 void InstanceUtil::flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
-                                       Upstream::ClusterManager& cm, TimeSource& time_source) {
+                                       Upstream::ClusterManager& cm, TimeSource& time_source,
+                                       DeltaStatFlushState* delta_state) {
   // Create a snapshot and flush to all sinks.
   // NOTE: Even if there are no sinks, creating the snapshot has the important property that it
   //       latches all counters on a periodic basis. The hot restart code assumes this is being
   //       done so this should not be removed.
-  MetricSnapshotImpl snapshot(store, cm, time_source);
+  MetricSnapshotImpl snapshot(store, cm, time_source, delta_state);
   for (const auto& sink : sinks) {
     sink->flush(snapshot);
   }
@@ -284,7 +333,7 @@ void InstanceBase::flushStatsInternal() {
   updateServerStats();
   auto& stats_config = config_.statsConfig();
   InstanceUtil::flushMetricsToSinks(stats_config.sinks(), stats_store_, clusterManager(),
-                                    timeSource());
+                                    timeSource(), delta_stat_flush_state_.get());
   // TODO(ramaraochavali): consider adding different flush interval for histograms.
   if (stat_flush_timer_ != nullptr) {
     stat_flush_timer_->enableTimer(stats_config.flushInterval());
@@ -354,9 +403,12 @@ absl::Status InstanceUtil::loadBootstrapConfig(
   const std::string& config_path = options.configPath();
   const std::string& config_yaml = options.configYaml();
   const envoy::config::bootstrap::v3::Bootstrap& config_proto = options.configProto();
+  // Sizing walks the whole message, which is large for bootstraps built in code, e.g. by Envoy
+  // Mobile, so it is done once.
+  const bool has_config_proto = config_proto.ByteSizeLong() != 0;
 
   // One of config_path and config_yaml or bootstrap should be specified.
-  if (config_path.empty() && config_yaml.empty() && config_proto.ByteSizeLong() == 0) {
+  if (config_path.empty() && config_yaml.empty() && !has_config_proto) {
     return absl::InvalidArgumentError(
         "At least one of --config-path or --config-yaml or Options::configProto() "
         "should be non-empty");
@@ -376,7 +428,7 @@ absl::Status InstanceUtil::loadBootstrapConfig(
 #endif
     bootstrap.MergeFrom(bootstrap_override);
   }
-  if (config_proto.ByteSizeLong() != 0) {
+  if (has_config_proto) {
     bootstrap.MergeFrom(config_proto);
   }
   MessageUtil::validate(bootstrap, validation_visitor);
@@ -440,9 +492,21 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
   // TLS always contains a valid main thread dispatcher when TLS is used.
   thread_local_.registerThread(*dispatcher_, true);
 
+  startup_trace_.beginPhase("startup");
+  init_manager_.setTargetObserver([this](absl::string_view target_name, Init::TargetEvent event) {
+    const std::string phase = absl::StrCat("init ", target_name);
+    if (event == Init::TargetEvent::Initializing) {
+      startup_trace_.beginPhase(phase);
+    } else {
+      startup_trace_.endPhase(phase);
+    }
+  });
+
   // Handle configuration that needs to take place prior to the main configuration load.
+  startup_trace_.beginPhase("load_bootstrap");
   RETURN_IF_NOT_OK(InstanceUtil::loadBootstrapConfig(
       bootstrap_, options_, messageValidationContext().staticValidationVisitor(), *api_));
+  startup_trace_.endPhase("load_bootstrap");
   bootstrap_config_update_time_ = time_source_.systemTime();
 
   if (bootstrap_.has_application_log_config()) {
@@ -617,6 +681,23 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
                                        initial_config.admin().ignoreGlobalConnLimit());
 
   config_tracker = admin_->getConfigTracker();
+  admin_->addHandler(
+      "/startup_trace", "print how long the phases of the server startup took",
+      [this](Http::ResponseHeaderMap& response_headers, Buffer::Instance& response,
+             AdminStream& admin_stream) -> Http::Code {
+        if (admin_stream.queryParams().getFirstValue("format") == "json") {
+          response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
+          response.add(startup_trace_.toChromeTrace());
+        } else {
+          response.add(startup_trace_.toText());
+        }
+        return Http::Code::OK;
+      },
+      false, false,
+      {{Admin::ParamDescriptor::Type::Enum,
+        "format",
+        "json prints the phases in the Chrome trace event format",
+        {"text", "json"}}});
 #endif
   secret_manager_ = std::make_unique<Secret::SecretManagerImpl>(config_tracker);
 
@@ -707,7 +788,9 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
 
   // Runtime gets initialized before the main configuration since during main configuration
   // load things may grab a reference to the loader for later use.
+  startup_trace_.beginPhase("create_runtime");
   runtime_ = component_factory.createRuntime(*this, initial_config);
+  startup_trace_.endPhase("create_runtime");
   validation_context_.setRuntime(runtime());
 
   if (!runtime().snapshot().getBoolean("envoy.disallow_global_stats", false)) {
@@ -764,7 +847,10 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
   // thread local data per above. See MainImpl::initialize() for why ConfigImpl
   // is constructed as part of the InstanceBase and then populated once
   // cluster_manager_factory_ is available.
+  startup_trace_.beginPhase("load_static_config");
+  startup_trace_.beginPhase("primary_clusters");
   RETURN_IF_NOT_OK(config_.initialize(bootstrap_, *this, *cluster_manager_factory_));
+  startup_trace_.endPhase("load_static_config");
 
   // Instruct the listener manager to create the LDS provider if needed. This must be done later
   // because various items do not yet exist when the listener manager is created.
@@ -798,6 +884,10 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
     stat_flush_timer_ = dispatcher_->createTimer([this]() -> void { flushStats(); });
     stat_flush_timer_->enableTimer(stats_config.flushInterval());
   }
+  if (stats_config.enableDeltaStatFlush()) {
+    delta_stat_flush_state_ =
+        std::make_unique<DeltaStatFlushState>(stats_config.deltaStatFullFlushInterval());
+  }
 
   // Now that we are initialized, notify the bootstrap extensions.
   for (auto&& bootstrap_extension : bootstrap_extensions_) {
@@ -812,11 +902,14 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
 }
 
 void InstanceBase::onClusterManagerPrimaryInitializationComplete() {
+  startup_trace_.endPhase("primary_clusters");
+  startup_trace_.beginPhase("rtds");
   // If RTDS was not configured the `onRuntimeReady` callback is immediately invoked.
   runtime().startRtdsSubscriptions([this]() { onRuntimeReady(); });
 }
 
 void InstanceBase::onRuntimeReady() {
+  startup_trace_.endPhase("rtds");
   // Begin initializing secondary clusters after RTDS configuration has been applied.
   // Initializing can throw exceptions, so catch these.
   TRY_ASSERT_MAIN_THREAD {
@@ -864,6 +957,7 @@ void InstanceBase::onRuntimeReady() {
 }
 
 void InstanceBase::startWorkers() {
+  startup_trace_.beginPhase("start_workers");
   // The callback will be called after workers are started.
   THROW_IF_NOT_OK(
       listener_manager_->startWorkers(makeOptRefFromPtr(worker_guard_dog_.get()), [this]() {
@@ -872,6 +966,9 @@ void InstanceBase::startWorkers() {
         }
 
         initialization_timer_->complete();
+        startup_trace_.endPhase("start_workers");
+        startup_trace_.endPhase("startup");
+        startup_trace_.complete();
         // Update server stats as soon as initialization is done.
         updateServerStats();
         workers_started_ = true;
@@ -46,8 +46,10 @@
 #endif
 #include "source/server/configuration_impl.h"
 #include "source/server/listener_hooks.h"
+#include "source/server/startup_trace.h"
 #include "source/server/worker_impl.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
 
@@ -97,6 +99,47 @@ struct ServerStats {
   ALL_SERVER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT, GENERATE_HISTOGRAM_STRUCT)
 };
 
+/**
+ * State kept between delta stats flushes, which only pass the metrics that changed since the
+ * previous flush to the sinks. Every full_flush_interval a flush passes all metrics.
+ */
+class DeltaStatFlushState {
+public:
+  explicit DeltaStatFlushState(std::chrono::milliseconds full_flush_interval)
+      : full_flush_interval_(full_flush_interval) {}
+
+  /**
+   * Starts a flush.
+   * @param now supplies the time of the flush.
+   * @return whether the flush only passes the changed metrics.
+   */
+  bool beginFlush(MonotonicTime now);
+
+  /**
+   * Records the value of a gauge of the flush. Must be called for every sinked gauge.
+   * @return whether the value of the gauge changed since the previous flush.
+   */
+  bool gaugeChanged(Stats::Gauge& gauge);
+
+  /**
+   * Ends a flush.
+   */
+  void endFlush();
+
+private:
+  struct GaugeValue {
+    // Keeps the gauge alive so that its address isn't reused by another gauge.
+    Stats::GaugeSharedPtr gauge_;
+    uint64_t value_;
+  };
+  using GaugeValueMap = absl::flat_hash_map<const Stats::Gauge*, GaugeValue>;
+
+  const std::chrono::milliseconds full_flush_interval_;
+  absl::optional<MonotonicTime> last_full_flush_;
+  GaugeValueMap previous_gauges_;
+  GaugeValueMap current_gauges_;
+};
+
 /**
  * Interface for creating service components during boot.
  */
@@ -131,9 +174,11 @@ public:
    * flush() on each sink.
    * @param sinks supplies the list of sinks.
    * @param store provides the store being flushed.
+   * @param delta_state supplies the state of delta flushes, or nullptr if all metrics are flushed.
    */
   static void flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
-                                  Upstream::ClusterManager& cm, TimeSource& time_source);
+                                  Upstream::ClusterManager& cm, TimeSource& time_source,
+                                  DeltaStatFlushState* delta_state = nullptr);
 
   /**
    * Load a bootstrap config and perform validation.
@@ -377,6 +422,7 @@ private:
   const Options& options_;
   ProtobufMessage::ProdValidationContextImpl validation_context_;
   TimeSource& time_source_;
+  StartupTrace startup_trace_;
   // Delete local_info_ as late as possible as some members below may reference it during their
   // destruction.
   LocalInfo::LocalInfoPtr local_info_;
@@ -409,6 +455,7 @@ private:
   Configuration::MainImpl config_;
   Network::DnsResolverSharedPtr dns_resolver_;
   Event::TimerPtr stat_flush_timer_;
+  std::unique_ptr<DeltaStatFlushState> delta_stat_flush_state_;
   DrainManagerPtr drain_manager_;
   std::unique_ptr<Upstream::ClusterManagerFactory> cluster_manager_factory_;
   std::unique_ptr<Server::GuardDog> main_thread_guard_dog_;
@@ -463,7 +510,8 @@ private:
 class MetricSnapshotImpl : public Stats::MetricSnapshot {
 public:
   explicit MetricSnapshotImpl(Stats::Store& store, Upstream::ClusterManager& cluster_manager,
-                              TimeSource& time_source);
+                              TimeSource& time_source,
+                              DeltaStatFlushState* delta_state = nullptr);
 
   // Stats::MetricSnapshot
   const std::vector<CounterSnapshot>& counters() override { return counters_; }
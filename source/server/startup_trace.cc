@@ -0,0 +1,99 @@
+#include "source/server/startup_trace.h"
+
+#include <algorithm>
+
+#include "source/common/json/json_streamer.h"
+
+#include "absl/strings/str_cat.h"
+#include "fmt/format.h"
+
+namespace Envoy {
+namespace Server {
+
+StartupTrace::StartupTrace(TimeSource& time_source, AllocatedBytesFn allocated_bytes)
+    : time_source_(time_source), allocated_bytes_(std::move(allocated_bytes)),
+      origin_(time_source.monotonicTime()) {}
+
+std::chrono::microseconds StartupTrace::elapsed() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(time_source_.monotonicTime() -
+                                                               origin_);
+}
+
+void StartupTrace::beginPhase(absl::string_view name) {
+  if (completed_) {
+    return;
+  }
+  pending_[name].push_back({elapsed(), allocated_bytes_()});
+}
+
+void StartupTrace::endPhase(absl::string_view name) {
+  if (completed_) {
+    return;
+  }
+  const auto it = pending_.find(name);
+  if (it == pending_.end()) {
+    return;
+  }
+  const PendingPhase pending = it->second.front();
+  it->second.pop_front();
+  if (it->second.empty()) {
+    pending_.erase(it);
+  }
+  phases_.push_back({std::string(name), pending.start_, elapsed() - pending.start_,
+                     static_cast<int64_t>(allocated_bytes_() - pending.allocated_bytes_)});
+}
+
+void StartupTrace::complete() {
+  completed_ = true;
+  pending_.clear();
+}
+
+std::string StartupTrace::toText() const {
+  std::vector<const Phase*> sorted;
+  sorted.reserve(phases_.size());
+  for (const Phase& phase : phases_) {
+    sorted.push_back(&phase);
+  }
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const Phase* a, const Phase* b) { return a->start_ < b->start_; });
+
+  std::string output = fmt::format("{:>12} {:>12} {:>12}  {}\n", "start_ms", "duration_ms",
+                                   "allocated_kb", "phase");
+  for (const Phase* phase : sorted) {
+    absl::StrAppend(&output, fmt::format("{:>12.3f} {:>12.3f} {:>12}  {}\n",
+                                         phase->start_.count() / 1e3,
+                                         phase->duration_.count() / 1e3,
+                                         phase->allocated_bytes_ / 1024, phase->name_));
+  }
+  if (!completed_) {
+    absl::StrAppend(&output, "(startup is still in progress)\n");
+  }
+  return output;
+}
+
+std::string StartupTrace::toChromeTrace() const {
+  std::string output;
+  Json::StringStreamer streamer(output);
+  Json::StringStreamer::MapPtr root = streamer.makeRootMap();
+  root->addKey("traceEvents");
+  Json::StringStreamer::ArrayPtr events = root->addArray();
+  for (const Phase& phase : phases_) {
+    Json::StringStreamer::MapPtr event = events->addMap();
+    // Complete events, all on the main thread.
+    event->addEntries({{"name", absl::string_view(phase.name_)},
+                       {"cat", absl::string_view("startup")},
+                       {"ph", absl::string_view("X")},
+                       {"ts", int64_t(phase.start_.count())},
+                       {"dur", int64_t(phase.duration_.count())},
+                       {"pid", int64_t(0)},
+                       {"tid", int64_t(0)}});
+    event->addKey("args");
+    event->addMap()->addEntries({{"allocated_bytes", phase.allocated_bytes_}});
+  }
+  events.reset();
+  root.reset();
+  return output;
+}
+
+} // namespace Server
+} // namespace Envoy
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Server {
+
+/**
+ * Records how long the phases of server startup take, and how much memory they leave allocated,
+ * so that the admin interface can report where the time to become ready and the fixed memory
+ * overhead of the server went. Phases may overlap, e.g. the wait for an init target overlaps with
+ * the phase that registered it. Only used on the main thread.
+ */
+class StartupTrace {
+public:
+  struct Phase {
+    std::string name_;
+    // Relative to the construction of the trace.
+    std::chrono::microseconds start_;
+    std::chrono::microseconds duration_;
+    // The change of the memory allocated by the whole process over the phase, so this includes
+    // the allocations of any phase which overlaps with it.
+    int64_t allocated_bytes_;
+  };
+
+  using AllocatedBytesFn = std::function<uint64_t()>;
+
+  /**
+   * @param allocated_bytes returns the memory currently allocated by the process.
+   */
+  StartupTrace(TimeSource& time_source, AllocatedBytesFn allocated_bytes);
+
+  /**
+   * Starts timing a phase. Phases with the same name may be in progress at the same time, e.g.
+   * init targets of different listeners which share a name.
+   */
+  void beginPhase(absl::string_view name);
+
+  /**
+   * Stops timing the earliest started phase in progress with the name. Stopping a phase which was
+   * not started is ignored.
+   */
+  void endPhase(absl::string_view name);
+
+  /**
+   * Stops recording once startup is over; later phases are ignored, as are the phases which are
+   * still in progress.
+   */
+  void complete();
+
+  bool completed() const { return completed_; }
+  const std::vector<Phase>& phases() const { return phases_; }
+
+  /**
+   * @return a table of the phases ordered by their start, with the times in milliseconds and the
+   *         allocated memory in kilobytes.
+   */
+  std::string toText() const;
+
+  /**
+   * @return the phases in the Chrome trace event format, which chrome://tracing and Perfetto load.
+   */
+  std::string toChromeTrace() const;
+
+private:
+  std::chrono::microseconds elapsed() const;
+
+  struct PendingPhase {
+    std::chrono::microseconds start_;
+    uint64_t allocated_bytes_;
+  };
+
+  TimeSource& time_source_;
+  const AllocatedBytesFn allocated_bytes_;
+  const MonotonicTime origin_;
+  // The phases in progress by name, in the order they started.
+  absl::flat_hash_map<std::string, std::deque<PendingPhase>> pending_;
+  std::vector<Phase> phases_;
+  bool completed_{};
+};
+
+} // namespace Server
+} // namespace Envoy
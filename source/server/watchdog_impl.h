@@ -24,9 +24,12 @@ public:
 
   // Server::WatchDog
   void touch() override {
-    // Set touched_ if not already set.
-    bool expected = false;
-    touched_.compare_exchange_strong(expected, true, std::memory_order_relaxed);
+    // Set touched_ if not already set. This is called for every event run by the dispatcher of
+    // the monitored thread, so it only writes to the cache line shared with the guard dog once
+    // per guard dog interval, rather than doing a read-modify-write each time.
+    if (!touched_.load(std::memory_order_relaxed)) {
+      touched_.store(true, std::memory_order_relaxed);
+    }
   }
 
 private:
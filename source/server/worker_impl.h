@@ -28,8 +28,11 @@ struct WorkerStatNames {
 
 class ProdWorkerFactory : public WorkerFactory, Logger::Loggable<Logger::Id::main> {
 public:
-  ProdWorkerFactory(ThreadLocal::Instance& tls, Api::Api& api, ListenerHooks& hooks)
-      : tls_(tls), api_(api), stat_names_(api.rootScope().symbolTable()), hooks_(hooks) {}
+  // @param worker_cpus the CPUs to pin the worker threads to, in turn, or empty to not pin them.
+  ProdWorkerFactory(ThreadLocal::Instance& tls, Api::Api& api, ListenerHooks& hooks,
+                    std::vector<uint32_t> worker_cpus = {})
+      : tls_(tls), api_(api), stat_names_(api.rootScope().symbolTable()), hooks_(hooks),
+        worker_cpus_(std::move(worker_cpus)) {}
 
   // Server::WorkerFactory
   WorkerPtr createWorker(uint32_t index, OverloadManager& overload_manager,
@@ -41,6 +44,7 @@ private:
   Api::Api& api_;
   WorkerStatNames stat_names_;
   ListenerHooks& hooks_;
+  const std::vector<uint32_t> worker_cpus_;
 };
 
 /**
@@ -50,7 +54,8 @@ class WorkerImpl : public Worker, Logger::Loggable<Logger::Id::main> {
 public:
   WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks, Event::DispatcherPtr&& dispatcher,
              Network::ConnectionHandlerPtr handler, OverloadManager& overload_manager,
-             Api::Api& api, WorkerStatNames& stat_names);
+             Api::Api& api, WorkerStatNames& stat_names,
+             absl::optional<uint32_t> cpu = absl::nullopt);
 
   // Server::Worker
   void addListener(absl::optional<uint64_t> overridden_listener, Network::ListenerConfig& listener,
@@ -81,6 +86,8 @@ private:
   Network::ConnectionHandlerPtr handler_;
   Api::Api& api_;
   Stats::Counter& reset_streams_counter_;
+  // The CPU to pin the thread to, if any.
+  const absl::optional<uint32_t> cpu_;
   Thread::ThreadPtr thread_;
   WatchDogSharedPtr watch_dog_;
 };
@@ -8,6 +8,7 @@
 #include "test/mocks/api/mocks.h"
 #include "test/mocks/event/mocks.h"
 #include "test/mocks/filesystem/mocks.h"
+#include "test/mocks/thread/mocks.h"
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
@@ -443,6 +444,56 @@ TEST_F(AccessLogManagerImplTest, BigDataChunkShouldBeFlushedWithoutTimer) {
   EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+TEST_F(AccessLogManagerImplTest, FilesShareFlushThread) {
+  Thread::MockThreadFactory mock_thread_factory;
+  EXPECT_CALL(api_, threadFactory()).WillRepeatedly(ReturnRef(mock_thread_factory));
+  // A single flush thread is started, on the first write.
+  EXPECT_CALL(mock_thread_factory, createThread(_, _))
+      .WillOnce(Invoke([this](std::function<void()> thread_routine,
+                              Thread::OptionsOptConstRef options) -> Thread::ThreadPtr {
+        return thread_factory_.createThread(thread_routine, options);
+      }));
+  EXPECT_CALL(dispatcher_, createTimer_(_)).WillRepeatedly(ReturnNew<NiceMock<Event::MockTimer>>());
+
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log =
+      access_log_manager_
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  NiceMock<Filesystem::MockFile>* file2 = new NiceMock<Filesystem::MockFile>;
+  EXPECT_CALL(*file2, path()).WillRepeatedly(Return("bar"));
+  EXPECT_CALL(file_system_,
+              createFile(testing::Matcher<const Envoy::Filesystem::FilePathAndType&>(
+                  Filesystem::FilePathAndType{Filesystem::DestinationType::File, "bar"})))
+      .WillOnce(Return(ByMove(std::unique_ptr<NiceMock<Filesystem::MockFile>>(file2))));
+  EXPECT_CALL(*file2, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log2 =
+      access_log_manager_
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "bar"})
+          .value();
+
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(data, "foo");
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  EXPECT_CALL(*file2, write_(_))
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(data, "bar");
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  log->write("foo");
+  log2->write("bar");
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_writes_, 1));
+  EXPECT_TRUE(file2->waitForEventCount(file2->num_writes_, 1));
+  EXPECT_TRUE(waitForCounterEq("filesystem.write_completed", 2));
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  EXPECT_CALL(*file2, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
 TEST_F(AccessLogManagerImplTest, ReopenAllFiles) {
   EXPECT_CALL(dispatcher_, createTimer_(_)).WillRepeatedly(ReturnNew<NiceMock<Event::MockTimer>>());
 
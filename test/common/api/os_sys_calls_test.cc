@@ -11,7 +11,7 @@
 
 namespace Envoy {
 
-// Test happy path for `open`, `pwrite`, `pread`, `fstat`, `close`, `stat` and `unlink`.
+// Test happy path for `open`, `pwrite`, `pread`, `pwritev`, `fstat`, `close`, `stat` and `unlink`.
 TEST(OsSyscallsTest, OpenPwritePreadFstatCloseStatUnlink) {
   auto& os_syscalls = Api::OsSysCallsSingleton::get();
   std::string path{TestEnvironment::temporaryPath("envoy_test")};
@@ -44,6 +44,16 @@ TEST(OsSyscallsTest, OpenPwritePreadFstatCloseStatUnlink) {
   EXPECT_EQ(read_result.errno_, 0);
   absl::string_view read_buffer_view{read_buffer, sizeof(read_buffer)};
   EXPECT_EQ(file_contents, read_buffer_view);
+  // Test `pwritev`
+  char first[] = "ab";
+  char second[] = "c";
+  iovec iov[2] = {{first, 2}, {second, 1}};
+  write_result = os_syscalls.pwritev(fd, iov, 2, 2);
+  EXPECT_EQ(write_result.return_value_, 3);
+  EXPECT_EQ(write_result.errno_, 0);
+  read_result = os_syscalls.pread(fd, read_buffer, sizeof(read_buffer), 0);
+  EXPECT_EQ(read_result.return_value_, sizeof(read_buffer));
+  EXPECT_EQ("12abc", read_buffer_view);
 #endif
   // Test `fstat`
   struct stat fstat_value;
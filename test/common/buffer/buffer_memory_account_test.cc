@@ -89,6 +89,27 @@ TEST_F(BufferMemoryAccountTest, ManagesAccountBalance) {
   account->clearDownstream();
 }
 
+TEST_F(BufferMemoryAccountTest, TracksPeakBalance) {
+  auto account = factory_.createAccount(mock_reset_handler_);
+  EXPECT_EQ(account->peakBalance(), 0);
+  {
+    Buffer::OwnedImpl buffer(account);
+    buffer.add(std::string(4096, 'a'));
+    buffer.add(std::string(4096, 'b'));
+    EXPECT_EQ(account->peakBalance(), 8192);
+
+    buffer.drain(4096);
+    EXPECT_EQ(getBalance(account), 4096);
+    EXPECT_EQ(account->peakBalance(), 8192);
+  }
+
+  // The peak remains once all the buffers are freed.
+  EXPECT_EQ(getBalance(account), 0);
+  EXPECT_EQ(account->peakBalance(), 8192);
+
+  account->clearDownstream();
+}
+
 TEST_F(BufferMemoryAccountTest, BufferAccountsForUnownedSliceMovedInto) {
   auto account = factory_.createAccount(mock_reset_handler_);
   Buffer::OwnedImpl accounted_buffer(account);
@@ -123,6 +123,57 @@ static void bufferCreate(benchmark::State& state) {
 }
 BENCHMARK(bufferCreate)->Arg(1)->Arg(4096)->Arg(16384)->Arg(65536);
 
+// Compare slice creation and destruction with and without the per-thread slice storage pool.
+// state.range(0) is the amount of content, state.range(1) is 1 if pooling is enabled.
+static void bufferCreateSliceStoragePool(benchmark::State& state) {
+  const std::string data(state.range(0), 'a');
+  const absl::string_view input(data);
+  Buffer::SliceStoragePool::setEnabled(state.range(1) != 0);
+  Buffer::SliceStoragePool::releaseThreadLocal();
+  uint64_t length = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Buffer::OwnedImpl buffer(input);
+    length += buffer.length();
+  }
+  benchmark::DoNotOptimize(length);
+  Buffer::SliceStoragePool::setEnabled(true);
+}
+BENCHMARK(bufferCreateSliceStoragePool)
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Args({4096, 0})
+    ->Args({4096, 1})
+    ->Args({16384, 0})
+    ->Args({16384, 1})
+    ->Args({65536, 0})
+    ->Args({65536, 1});
+
+// Compare read reservation throughput with and without the per-thread slice storage pool.
+// state.range(0) is the number of bytes committed per reservation, state.range(1) is 1 if pooling
+// is enabled.
+static void bufferReserveCommitSliceStoragePool(benchmark::State& state) {
+  const uint64_t length = state.range(0);
+  Buffer::SliceStoragePool::setEnabled(state.range(1) != 0);
+  Buffer::SliceStoragePool::releaseThreadLocal();
+  Buffer::OwnedImpl buffer;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    auto reservation = buffer.reserveForRead();
+    reservation.commit(length);
+    buffer.drain(buffer.length());
+  }
+  benchmark::DoNotOptimize(buffer.length());
+  Buffer::SliceStoragePool::setEnabled(true);
+}
+BENCHMARK(bufferReserveCommitSliceStoragePool)
+    ->Args({1, 0})
+    ->Args({1, 1})
+    ->Args({16384, 0})
+    ->Args({16384, 1})
+    ->Args({65536, 0})
+    ->Args({65536, 1});
+
 // Grow an OwnedImpl in very small amounts.
 static void bufferAddSmallIncrement(benchmark::State& state) {
   const std::string data("a");
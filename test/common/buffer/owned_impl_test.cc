@@ -1277,6 +1277,98 @@ TEST_F(OwnedImplTest, FrontSlice) {
   EXPECT_EQ(1, buffer.frontSlice().len_);
 }
 
+TEST_F(OwnedImplTest, SliceStoragePoolReusesStorage) {
+  SliceStoragePool::releaseThreadLocal();
+  const SliceStoragePool::Stats& stats = SliceStoragePool::stats();
+  const uint64_t hits_before = stats.hits_;
+
+  const uint8_t* first_storage;
+  {
+    Buffer::OwnedImpl buffer;
+    buffer.add(std::string(4096, 'a'));
+    first_storage = static_cast<const uint8_t*>(buffer.frontSlice().mem_);
+  }
+  EXPECT_EQ(4096, stats.retained_bytes_);
+
+  {
+    Buffer::OwnedImpl buffer;
+    buffer.add(std::string(100, 'b'));
+    EXPECT_EQ(first_storage, buffer.frontSlice().mem_);
+    EXPECT_EQ(hits_before + 1, stats.hits_);
+    EXPECT_EQ(0, stats.retained_bytes_);
+  }
+
+  // Storage of a different size class is not handed out for a 4KB slice.
+  {
+    Buffer::OwnedImpl buffer;
+    buffer.add(std::string(8192, 'c'));
+  }
+  EXPECT_EQ(4096 + 8192, stats.retained_bytes_);
+  {
+    Buffer::OwnedImpl buffer;
+    buffer.add(std::string(8192, 'd'));
+    EXPECT_EQ(4096, stats.retained_bytes_);
+  }
+
+  SliceStoragePool::releaseThreadLocal();
+  EXPECT_EQ(0, stats.retained_bytes_);
+}
+
+TEST_F(OwnedImplTest, SliceStoragePoolBounded) {
+  SliceStoragePool::releaseThreadLocal();
+  const SliceStoragePool::Stats& stats = SliceStoragePool::stats();
+
+  // Slices larger than the biggest size class go straight back to the allocator.
+  {
+    Buffer::OwnedImpl buffer;
+    buffer.add(std::string(SliceStoragePool::MaxCachedSize + 1, 'a'));
+  }
+  EXPECT_EQ(0, stats.retained_bytes_);
+
+  // Each size class retains a bounded number of blocks.
+  {
+    std::vector<Buffer::OwnedImpl> buffers(SliceStoragePool::MaxEntriesPerSizeClass * 2);
+    for (auto& buffer : buffers) {
+      buffer.add(std::string(4096, 'b'));
+    }
+  }
+  EXPECT_EQ(SliceStoragePool::MaxEntriesPerSizeClass * 4096, stats.retained_bytes_);
+
+  SliceStoragePool::releaseAll();
+  EXPECT_EQ(0, stats.retained_bytes_);
+}
+
+TEST_F(OwnedImplTest, SliceStoragePoolReservation) {
+  SliceStoragePool::releaseThreadLocal();
+  const SliceStoragePool::Stats& stats = SliceStoragePool::stats();
+
+  {
+    Buffer::OwnedImpl buffer;
+    auto reservation = buffer.reserveForRead();
+    EXPECT_EQ(Reservation::MAX_SLICES_, reservation.numSlices());
+    EXPECT_EQ(0, stats.retained_bytes_);
+    reservation.commit(1);
+    EXPECT_EQ((Reservation::MAX_SLICES_ - 1) * Slice::default_slice_size_, stats.retained_bytes_);
+  }
+  // Uncommitted reservation slices and the committed slice are all returned to the pool, up to
+  // the size class limit.
+  EXPECT_EQ(SliceStoragePool::MaxEntriesPerSizeClass * Slice::default_slice_size_,
+            stats.retained_bytes_);
+
+  SliceStoragePool::releaseThreadLocal();
+}
+
+TEST_F(OwnedImplTest, SliceStoragePoolDisabled) {
+  SliceStoragePool::releaseThreadLocal();
+  SliceStoragePool::setEnabled(false);
+  {
+    Buffer::OwnedImpl buffer;
+    buffer.add(std::string(4096, 'a'));
+  }
+  EXPECT_EQ(0, SliceStoragePool::stats().retained_bytes_);
+  SliceStoragePool::setEnabled(true);
+}
+
 template <class T> struct OwnedImplTypedTest : public OwnedImplTest {
   using IoSocketHandleTestType = T;
 };
@@ -85,6 +85,46 @@ static void envoyNormal(benchmark::State& state) {
   }
 }
 
+/**
+ * A sink which drops the log lines, so that only the cost of logging them is measured.
+ */
+class NullSinkDelegate : public Logger::SinkDelegate {
+public:
+  explicit NullSinkDelegate(Logger::DelegatingLogSinkSharedPtr log_sink)
+      : SinkDelegate(log_sink) {
+    setDelegate();
+  }
+  ~NullSinkDelegate() override { restoreDelegate(); }
+
+  // Logger::SinkDelegate
+  void log(absl::string_view, const spdlog::details::log_msg&) override {}
+  void flush() override {}
+};
+
+std::unique_ptr<NullSinkDelegate> null_sink;
+
+static void setUpNullSink(const benchmark::State&) {
+  Logger::Registry::setLogFormat("[%Y-%m-%d %T.%e][%t][%l][%n] [%g:%#] %v");
+  null_sink = std::make_unique<NullSinkDelegate>(Logger::Registry::getSink());
+}
+
+static void tearDownNullSink(const benchmark::State&) { null_sink.reset(); }
+
+/**
+ * Benchmark for ENVOY_LOG from many threads at once, which format their log lines at the same
+ * time.
+ */
+static void envoyContended(benchmark::State& state) {
+  std::string msg(100, '.');
+  GET_MISC_LOGGER().set_level(spdlog::level::trace);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (int i = 0; i < state.range(0); i++) {
+      ENVOY_LOG_MISC(trace, "Contended: {}", msg);
+    }
+  }
+}
+
 /**
  * Benchmark for a large number of level setting.
  */
@@ -133,6 +173,14 @@ BENCHMARK(envoyNormal)->Args({1 << 10, 1})->Threads(20)->MeasureProcessCPUTime()
 BENCHMARK(envoyNormal)->Args({1 << 10, 0})->Threads(200)->MeasureProcessCPUTime();
 BENCHMARK(envoyNormal)->Args({1 << 10, 1})->Threads(200)->MeasureProcessCPUTime();
 
+BENCHMARK(envoyContended)->Arg(1 << 10)->Setup(setUpNullSink)->Teardown(tearDownNullSink);
+BENCHMARK(envoyContended)
+    ->Arg(1 << 10)
+    ->Threads(20)
+    ->MeasureProcessCPUTime()
+    ->Setup(setUpNullSink)
+    ->Teardown(tearDownNullSink);
+
 BENCHMARK(fineGrainLogLevelSetting)->Arg(1 << 10);
 BENCHMARK(envoyLevelSetting)->Arg(1 << 10);
 
@@ -0,0 +1,79 @@
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "source/common/common/node_pool.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+TEST(NodePoolTest, ReusesFreedNodes) {
+  NodePool pool;
+  void* first = pool.allocate(sizeof(std::string), alignof(std::string));
+  ASSERT_NE(nullptr, first);
+  pool.deallocate(first);
+  EXPECT_EQ(first, pool.allocate(sizeof(std::string), alignof(std::string)));
+}
+
+TEST(NodePoolTest, OnlyServesOneSize) {
+  NodePool pool;
+  EXPECT_FALSE(pool.serves(64, 2 * alignof(std::max_align_t)));
+  EXPECT_TRUE(pool.serves(64, 8));
+  EXPECT_TRUE(pool.serves(64, 8));
+  EXPECT_FALSE(pool.serves(32, 8));
+  EXPECT_FALSE(pool.serves(64, 16));
+  EXPECT_EQ(nullptr, pool.allocate(32, 8));
+}
+
+TEST(NodePoolTest, NodesAreDistinctAndAligned) {
+  NodePool pool;
+  std::vector<char*> nodes;
+  for (int i = 0; i < 100; ++i) {
+    auto* node = static_cast<char*>(pool.allocate(24, 8));
+    ASSERT_NE(nullptr, node);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(node) % 8);
+    for (char* other : nodes) {
+      EXPECT_TRUE(node + 24 <= other || other + 24 <= node);
+    }
+    nodes.push_back(node);
+  }
+}
+
+TEST(NodePoolAllocatorTest, List) {
+  NodePool pool;
+  std::list<std::string, NodePoolAllocator<std::string>> list{NodePoolAllocator<std::string>(pool)};
+  for (int i = 0; i < 100; ++i) {
+    list.push_back(std::string(64, 'a' + i % 26));
+  }
+  list.remove_if([](const std::string& value) { return value[0] == 'a'; });
+  for (int i = 0; i < 10; ++i) {
+    list.push_front(std::to_string(i));
+  }
+  EXPECT_EQ(106U, list.size());
+  EXPECT_EQ("9", list.front());
+  EXPECT_EQ(std::string(64, 'v'), list.back());
+  list.clear();
+  EXPECT_TRUE(list.empty());
+}
+
+TEST(NodePoolAllocatorTest, ArraysUseStdAllocator) {
+  NodePool pool;
+  NodePoolAllocator<uint64_t> allocator(pool);
+  uint64_t* node = allocator.allocate(1);
+  uint64_t* array = allocator.allocate(4);
+  array[3] = 1;
+  // The node size is fixed now, so another object type of a different size isn't pooled either.
+  NodePoolAllocator<std::string> other(allocator);
+  std::string* string = other.allocate(1);
+  EXPECT_FALSE(pool.serves(sizeof(std::string), alignof(std::string)));
+  other.deallocate(string, 1);
+  allocator.deallocate(array, 4);
+  allocator.deallocate(node, 1);
+  EXPECT_TRUE(allocator == other);
+}
+
+} // namespace
+} // namespace Envoy
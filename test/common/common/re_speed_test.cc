@@ -1,13 +1,16 @@
 // Note: this should be run with --compilation_mode=opt, and would benefit from
 // a quiescent system with disabled cstate power management.
 
+#include <memory>
 #include <regex>
 
 #include "source/common/common/assert.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "benchmark/benchmark.h"
 #include "re2/re2.h"
+#include "re2/set.h"
 
 // NOLINT(namespace-envoy)
 
@@ -126,3 +129,61 @@ static void BM_RE2_AltPattern(benchmark::State& state) {
   RELEASE_ASSERT(passes > 0, "");
 }
 BENCHMARK(BM_RE2_AltPattern);
+
+// Regexes like those of a route table or an RBAC policy with many path or header regexes, of which
+// the inputs match at most one.
+static std::vector<std::string> multiPatterns(int64_t count) {
+  std::vector<std::string> patterns;
+  for (int64_t i = 0; i < count; ++i) {
+    patterns.push_back(absl::StrCat("/api/v", i % 4, "/service", i, "/[a-z]+/[0-9]+"));
+  }
+  return patterns;
+}
+
+static const char* MultiPatternInputs[] = {
+    "/api/v1/service1/users/12345",
+    "/api/v3/service63/orders/1",
+    "/api/v2/service2/no/match",
+    "/static/index.html",
+};
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RE2_MultiPatternEach(benchmark::State& state) {
+  std::vector<std::unique_ptr<re2::RE2>> regexes;
+  for (const std::string& pattern : multiPatterns(state.range(0))) {
+    regexes.push_back(std::make_unique<re2::RE2>(pattern));
+  }
+  uint32_t passes = 0;
+  for (auto _ : state) { // NOLINT
+    for (const char* input : MultiPatternInputs) {
+      for (const auto& regex : regexes) {
+        if (re2::RE2::FullMatch(input, *regex)) {
+          ++passes;
+          break;
+        }
+      }
+    }
+  }
+  RELEASE_ASSERT(passes > 0, "");
+}
+BENCHMARK(BM_RE2_MultiPatternEach)->Arg(4)->Arg(64)->Arg(1024);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RE2_MultiPatternSet(benchmark::State& state) {
+  re2::RE2::Set set(re2::RE2::Options(re2::RE2::Quiet), re2::RE2::ANCHOR_BOTH);
+  for (const std::string& pattern : multiPatterns(state.range(0))) {
+    RELEASE_ASSERT(set.Add(pattern, nullptr) >= 0, "");
+  }
+  RELEASE_ASSERT(set.Compile(), "");
+  uint32_t passes = 0;
+  std::vector<int> matches;
+  for (auto _ : state) { // NOLINT
+    for (const char* input : MultiPatternInputs) {
+      if (set.Match(input, &matches)) {
+        ++passes;
+      }
+    }
+  }
+  RELEASE_ASSERT(passes > 0, "");
+}
+BENCHMARK(BM_RE2_MultiPatternSet)->Arg(4)->Arg(64)->Arg(1024);
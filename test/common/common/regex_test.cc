@@ -140,6 +140,27 @@ TEST(Utility, ParseRegex) {
   }
 }
 
+TEST(CompiledGoogleReSetMatcher, Match) {
+  const auto set = *CompiledGoogleReSetMatcher::create({"/foo/.*", "/foo/bar", "/[a-z]+"});
+  EXPECT_EQ(3, set->size());
+  std::vector<int> matches;
+  EXPECT_TRUE(set->match("/foo/bar", matches));
+  EXPECT_EQ(std::vector<int>({0, 1}), matches);
+  EXPECT_TRUE(set->match("/baz", matches));
+  EXPECT_EQ(std::vector<int>({2}), matches);
+  // Like CompiledGoogleReMatcher, the regexes must match the whole value.
+  EXPECT_TRUE(set->match("/baz/", matches));
+  EXPECT_TRUE(matches.empty());
+
+  EXPECT_EQ(true, set->matchAny("/foo/"));
+  EXPECT_EQ(false, set->matchAny("/1"));
+}
+
+TEST(CompiledGoogleReSetMatcher, InvalidRegex) {
+  EXPECT_EQ(CompiledGoogleReSetMatcher::create({"/foo", "(+invalid)"}).status().message(),
+            "no argument for repetition operator: +");
+}
+
 } // namespace
 } // namespace Regex
 } // namespace Envoy
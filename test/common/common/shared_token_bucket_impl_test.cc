@@ -18,6 +18,8 @@ protected:
     return !locked;
   }
 
+  Thread::MutexBasicLockable& mutex(SharedTokenBucketImpl& token) { return token.mutex_; }
+
   Thread::ThreadSynchronizer& synchronizer(SharedTokenBucketImpl& token) {
     return token.synchronizer_;
   };
@@ -124,6 +126,19 @@ TEST_F(SharedTokenBucketImplTest, Reset) {
   EXPECT_EQ(0, token_bucket.consume(5, true, time_to_next_token));
 }
 
+// Verifies that a reset which is ignored does not take the lock.
+TEST_F(SharedTokenBucketImplTest, IgnoredResetDoesNotLock) {
+  SharedTokenBucketImpl token_bucket{16, time_system_, 16};
+  token_bucket.maybeReset(1);
+
+  mutex(token_bucket).lock();
+  // This would deadlock if it took the lock.
+  token_bucket.maybeReset(5);
+  mutex(token_bucket).unlock();
+
+  EXPECT_EQ(1, token_bucket.consume(5, true, time_to_next_token));
+}
+
 // Verifies that TokenBucket can consume tokens with thread safety.
 TEST_F(SharedTokenBucketImplTest, SynchronizedConsume) {
   SharedTokenBucketImpl token_bucket{10, time_system_, 1};
@@ -1,5 +1,9 @@
 #include <functional>
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #if defined(__linux__) || defined(__APPLE__)
 #include "source/common/common/posix/thread_impl.h"
 #endif
@@ -301,6 +305,33 @@ TEST(PosixThreadTest, InvalidThreadPriority) {
   EXPECT_NE(thread_priority, options.priority_);
 }
 
+#ifdef __linux__
+TEST(PosixThreadTest, ThreadCpu) {
+  cpu_set_t process_mask;
+  CPU_ZERO(&process_mask);
+  ASSERT_EQ(0, sched_getaffinity(0, sizeof(process_mask), &process_mask));
+  uint32_t last_cpu = 0;
+  for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &process_mask)) {
+      last_cpu = cpu;
+    }
+  }
+
+  auto thread_factory = PosixThreadFactory::create();
+  Options options;
+  options.cpu_ = last_cpu;
+  cpu_set_t thread_mask;
+  CPU_ZERO(&thread_mask);
+  auto thread = thread_factory->createThread(
+      [&]() { sched_getaffinity(0, sizeof(thread_mask), &thread_mask); }, options,
+      /* crash_on_failure= */ false);
+  thread->join();
+
+  EXPECT_EQ(1, CPU_COUNT(&thread_mask));
+  EXPECT_TRUE(CPU_ISSET(last_cpu, &thread_mask));
+}
+#endif
+
 class PosixThreadFactoryFailCreate : public PosixThreadFactory {
 protected:
   int createPthread(ThreadHandle*) override { return 1; }
@@ -1,3 +1,5 @@
+#include <vector>
+
 #include "source/common/common/trie_lookup_table.h"
 
 #include "gtest/gtest.h"
@@ -65,6 +67,35 @@ TEST(TrieLookupTable, LongestPrefix) {
   EXPECT_EQ(nullptr, trie.findLongestPrefix(" "));
 }
 
+TEST(TrieLookupTable, ForEachPrefixValue) {
+  TrieLookupTable<const char*> trie;
+  const char* cstr_a = "a";
+  const char* cstr_b = "b";
+  const char* cstr_c = "c";
+  const char* cstr_d = "d";
+
+  const auto prefix_values = [&trie](absl::string_view key) {
+    std::vector<const char*> values;
+    trie.forEachPrefixValue(key, [&values](const char* value) { values.push_back(value); });
+    return values;
+  };
+
+  EXPECT_TRUE(trie.add("/foo", cstr_b));
+  EXPECT_TRUE(trie.add("/foo/bar", cstr_c));
+  EXPECT_TRUE(trie.add("/baz", cstr_d));
+
+  EXPECT_EQ(std::vector<const char*>({cstr_b, cstr_c}), prefix_values("/foo/bar/zzz"));
+  EXPECT_EQ(std::vector<const char*>({cstr_b}), prefix_values("/foo/ba"));
+  EXPECT_EQ(std::vector<const char*>({cstr_d}), prefix_values("/baz"));
+  EXPECT_EQ(std::vector<const char*>(), prefix_values("/fo"));
+  EXPECT_EQ(std::vector<const char*>(), prefix_values(""));
+
+  // The value of the empty key is a prefix of every key.
+  EXPECT_TRUE(trie.add("", cstr_a));
+  EXPECT_EQ(std::vector<const char*>({cstr_a, cstr_b, cstr_c}), prefix_values("/foo/bar"));
+  EXPECT_EQ(std::vector<const char*>({cstr_a}), prefix_values(""));
+}
+
 TEST(TrieLookupTable, VeryDeepTrieDoesNotStackOverflowOnDestructor) {
   TrieLookupTable<const char*> trie;
   const char* cstr_a = "a";
@@ -25,6 +25,9 @@ TEST(MetadataTest, MetadataValue) {
   EXPECT_FALSE(Metadata::metadataValue(&metadata, "foo", "bar").bool_value());
   EXPECT_FALSE(
       Metadata::metadataValue(&metadata, MetadataFilters::get().ENVOY_LB, "bar").bool_value());
+  EXPECT_FALSE(Metadata::metadataValue(nullptr, MetadataFilters::get().ENVOY_LB,
+                                       MetadataEnvoyLbKeys::get().CANARY)
+                   .bool_value());
 }
 
 TEST(MetadataTest, MetadataValuePath) {
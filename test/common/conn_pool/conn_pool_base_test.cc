@@ -354,6 +354,37 @@ TEST_F(ConnPoolImplBaseTest, ExplicitPreconnectNotHealthy) {
   EXPECT_FALSE(pool_.maybePreconnectImpl(1));
 }
 
+// With a peak demand window, connections for a burst of streams are kept until the burst is
+// older than the window.
+TEST_F(ConnPoolImplDispatcherBaseTest, PreconnectForPeakDemand) {
+  ON_CALL(*cluster_, perUpstreamPreconnectRatio).WillByDefault(Return(1));
+  ON_CALL(*cluster_, preconnectPeakDemandWindow)
+      .WillByDefault(Return(absl::optional<std::chrono::milliseconds>(1000)));
+
+  EXPECT_CALL(pool_, instantiateActiveClient).Times(3);
+  std::vector<Cancellable*> cancelables;
+  for (int i = 0; i < 3; ++i) {
+    cancelables.push_back(pool_.newStreamImpl(context_, /*can_send_early_data=*/false));
+  }
+  CHECK_STATE(0 /*active*/, 3 /*pending*/, 3 /*connecting capacity*/);
+
+  // The connections are still needed for the peak demand.
+  for (Cancellable* cancelable : cancelables) {
+    cancelable->cancel(ConnectionPool::CancelPolicy::CloseExcess);
+  }
+  CHECK_STATE(0 /*active*/, 0 /*pending*/, 3 /*connecting capacity*/);
+
+  // Once the burst is older than the window, connections are only kept for the new demand.
+  time_system_.advanceTimeWait(std::chrono::milliseconds(2001));
+  EXPECT_CALL(pool_, instantiateActiveClient).Times(0);
+  Cancellable* cancelable = pool_.newStreamImpl(context_, /*can_send_early_data=*/false);
+  CHECK_STATE(0 /*active*/, 1 /*pending*/, 3 /*connecting capacity*/);
+  cancelable->cancel(ConnectionPool::CancelPolicy::CloseExcess);
+  CHECK_STATE(0 /*active*/, 0 /*pending*/, 2 /*connecting capacity*/);
+
+  pool_.destructAllConnections();
+}
+
 TEST_F(ConnPoolImplDispatcherBaseTest, MaxConnectionDurationTimerNull) {
   // Force a null max connection duration optional.
   // newActiveClientAndStream() will expect the connection duration timer to remain null.
@@ -1,4 +1,5 @@
 #include <functional>
+#include <vector>
 
 #include "envoy/common/scope_tracker.h"
 #include "envoy/thread/thread.h"
@@ -391,6 +392,8 @@ TEST_F(DispatcherImplTest, InitializeStats) {
               histogram("test.dispatcher.loop_duration_us", Stats::Histogram::Unit::Microseconds));
   EXPECT_CALL(store_,
               histogram("test.dispatcher.poll_delay_us", Stats::Histogram::Unit::Microseconds));
+  EXPECT_CALL(store_, histogram("test.dispatcher.tracked_scope_duration_us",
+                                Stats::Histogram::Unit::Microseconds));
   dispatcher_->initializeStats(scope_, "test.");
 }
 
@@ -456,6 +459,44 @@ TEST_F(DispatcherImplTest, PostExecuteAndDestructOrder) {
   }
 }
 
+// Callbacks posted by the callbacks of a batch run in order in the following batches, which reuse
+// the buffer of the previous ones.
+TEST_F(DispatcherImplTest, PostAcrossBatches) {
+  constexpr int batches = 10;
+  constexpr int callbacks_per_batch = 3;
+  std::vector<int> order;
+  std::function<void(int)> post_batch = [&](int batch) {
+    for (int i = 0; i < callbacks_per_batch; ++i) {
+      dispatcher_->post([&, batch, i]() {
+        order.push_back(batch * callbacks_per_batch + i);
+        if (i + 1 < callbacks_per_batch) {
+          return;
+        }
+        if (batch + 1 < batches) {
+          post_batch(batch + 1);
+          return;
+        }
+        {
+          Thread::LockGuard lock(mu_);
+          ASSERT(!work_finished_);
+          work_finished_ = true;
+        }
+        cv_.notifyOne();
+      });
+    }
+  };
+  post_batch(0);
+
+  Thread::LockGuard lock(mu_);
+  while (!work_finished_) {
+    cv_.wait(mu_);
+  }
+  ASSERT_EQ(batches * callbacks_per_batch, order.size());
+  for (int i = 0; i < batches * callbacks_per_batch; ++i) {
+    EXPECT_EQ(i, order[i]);
+  }
+}
+
 // Ensure that there is no deadlock related to calling a posted callback, or
 // destructing a closure when finished calling it.
 TEST_F(DispatcherImplTest, RunPostCallbacksLocking) {
@@ -1482,6 +1523,64 @@ TEST(DispatcherWithScaledTimerFactoryTest, CreateScaledTimerWithTimerType) {
   dispatcher->createScaledTimer(ScaledTimerType::UnscaledRealTimerForTest, []() {});
 }
 
+class DispatcherTrackedScopeTest : public testing::Test {
+protected:
+  DispatcherTrackedScopeTest()
+      : api_(Api::createApiForTest(time_system_)),
+        dispatcher_(api_->allocateDispatcher("test_thread")) {}
+
+  void initializeStats() {
+    dispatcher_->initializeStats(*store_.rootScope(), "test.");
+    dispatcher_->run(Dispatcher::RunType::NonBlock);
+  }
+
+  // Runs a scope of a tracked object dumping the given message that lasts for the given duration.
+  void runScope(absl::string_view message, std::chrono::milliseconds duration) {
+    MessageTrackedObject object(message);
+    ScopeTrackerScopeState state(&object, *dispatcher_);
+    MessageTrackedObject nested("nested");
+    ScopeTrackerScopeState nested_state(&nested, *dispatcher_);
+    time_system_.advanceTimeAsyncImpl(duration);
+  }
+
+  std::string dumpOnFatalError() {
+    std::array<char, 1024> buffer;
+    OutputBufferStream ostream{buffer.data(), buffer.size()};
+    static_cast<DispatcherImpl*>(dispatcher_.get())->onFatalError(ostream);
+    return std::string(ostream.contents());
+  }
+
+  NiceMock<Stats::MockStore> store_;
+  Event::SimulatedTimeSystem time_system_;
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+};
+
+// Tracked scopes aren't measured without stats.
+TEST_F(DispatcherTrackedScopeTest, NotMeasuredWithoutStats) {
+  runScope("slow", std::chrono::milliseconds(100));
+  EXPECT_EQ("", dumpOnFatalError());
+}
+
+// The state of the outermost tracked objects of the last slow scopes is dumped on fatal errors.
+TEST_F(DispatcherTrackedScopeTest, DumpsLastSlowScopes) {
+  initializeStats();
+  runScope("fast", std::chrono::milliseconds(1));
+  EXPECT_EQ("", dumpOnFatalError());
+
+  runScope("first", std::chrono::milliseconds(10));
+  runScope("second", std::chrono::milliseconds(20));
+  EXPECT_EQ("Last slow tracked scopes:\n  10000us: first\n  20000us: second\n",
+            dumpOnFatalError());
+
+  runScope("third", std::chrono::milliseconds(30));
+  runScope("fourth", std::chrono::milliseconds(40));
+  runScope("fifth", std::chrono::milliseconds(50));
+  EXPECT_EQ("Last slow tracked scopes:\n  20000us: second\n  30000us: third\n  40000us: fourth\n"
+            "  50000us: fifth\n",
+            dumpOnFatalError());
+}
+
 class DispatcherWithWatchdogTest : public testing::Test {
 protected:
   DispatcherWithWatchdogTest()
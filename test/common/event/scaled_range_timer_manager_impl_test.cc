@@ -9,6 +9,7 @@
 #include "test/mocks/common.h"
 #include "test/mocks/event/wrapped_dispatcher.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "gtest/gtest.h"
@@ -94,6 +95,25 @@ TEST_F(ScaledRangeTimerManagerTest, CreateSingleScaledTimer) {
   EXPECT_FALSE(timer->enabled());
 }
 
+TEST_F(ScaledRangeTimerManagerTest, CreateSingleScaledTimerOnTimerWheel) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.restart_features.scaled_timers_use_timer_wheel", "true"}});
+  ScaledRangeTimerManagerImpl manager(dispatcher_);
+
+  MockFunction<TimerCb> callback;
+  auto timer = manager.createTimer(ScaledMinimum(UnitFloat(0.5)), callback.AsStdFunction());
+
+  timer->enableTimer(std::chrono::seconds(10));
+  EXPECT_TRUE(timer->enabled());
+
+  simTime().advanceTimeAndRun(std::chrono::seconds(5), dispatcher_, Dispatcher::RunType::Block);
+  EXPECT_TRUE(timer->enabled());
+
+  EXPECT_CALL(callback, Call());
+  simTime().advanceTimeAndRun(std::chrono::seconds(5), dispatcher_, Dispatcher::RunType::Block);
+  EXPECT_FALSE(timer->enabled());
+}
+
 TEST_F(ScaledRangeTimerManagerTest, EnableAndDisableTimer) {
   ScaledRangeTimerManagerImpl manager(dispatcher_);
 
@@ -0,0 +1,136 @@
+#include <chrono>
+#include <vector>
+
+#include "envoy/event/timer.h"
+
+#include "source/common/event/dispatcher_impl.h"
+#include "source/common/event/timer_wheel.h"
+
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+using testing::MockFunction;
+
+class TimerWheelTest : public testing::Test, public TestUsingSimulatedTime {
+public:
+  TimerWheelTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")),
+        wheel_(*dispatcher_) {}
+
+  void advance(std::chrono::milliseconds duration) {
+    simTime().advanceTimeAndRun(duration, *dispatcher_, Dispatcher::RunType::NonBlock);
+  }
+
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+  TimerWheel wheel_;
+};
+
+TEST_F(TimerWheelTest, CreateAndDestroyTimer) {
+  MockFunction<TimerCb> callback;
+  auto timer = wheel_.createTimer(callback.AsStdFunction());
+  EXPECT_FALSE(timer->enabled());
+  timer->enableTimer(std::chrono::seconds(1));
+  EXPECT_TRUE(timer->enabled());
+}
+
+TEST_F(TimerWheelTest, FiresAtExpiry) {
+  MockFunction<TimerCb> callback;
+  auto timer = wheel_.createTimer(callback.AsStdFunction());
+  timer->enableTimer(std::chrono::milliseconds(10));
+
+  advance(std::chrono::milliseconds(9));
+  EXPECT_TRUE(timer->enabled());
+
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(1));
+  EXPECT_FALSE(timer->enabled());
+}
+
+// Timers with expiries at the boundaries of the levels of the wheel fire neither early nor late.
+TEST_F(TimerWheelTest, FiresAtExpiryOnAllLevels) {
+  const std::vector<std::chrono::milliseconds> durations = {
+      std::chrono::milliseconds(1),      std::chrono::milliseconds(63),
+      std::chrono::milliseconds(64),     std::chrono::milliseconds(65),
+      std::chrono::milliseconds(4095),   std::chrono::milliseconds(4096),
+      std::chrono::milliseconds(4097),   std::chrono::milliseconds(262145),
+      std::chrono::milliseconds(300000), std::chrono::milliseconds(16777217)};
+  for (const auto duration : durations) {
+    MockFunction<TimerCb> callback;
+    auto timer = wheel_.createTimer(callback.AsStdFunction());
+    timer->enableTimer(duration);
+
+    advance(duration - std::chrono::milliseconds(1));
+    EXPECT_TRUE(timer->enabled()) << duration.count();
+
+    EXPECT_CALL(callback, Call());
+    advance(std::chrono::milliseconds(1));
+    EXPECT_FALSE(timer->enabled()) << duration.count();
+  }
+}
+
+TEST_F(TimerWheelTest, DisableAndEnableAgain) {
+  MockFunction<TimerCb> callback;
+  auto timer = wheel_.createTimer(callback.AsStdFunction());
+  timer->enableTimer(std::chrono::milliseconds(100));
+  timer->disableTimer();
+  EXPECT_FALSE(timer->enabled());
+
+  EXPECT_CALL(callback, Call()).Times(0);
+  advance(std::chrono::milliseconds(200));
+
+  // Enabling again postpones the expiry.
+  timer->enableTimer(std::chrono::milliseconds(100));
+  advance(std::chrono::milliseconds(50));
+  timer->enableTimer(std::chrono::milliseconds(100));
+  advance(std::chrono::milliseconds(99));
+  testing::Mock::VerifyAndClearExpectations(&callback);
+
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(1));
+}
+
+TEST_F(TimerWheelTest, CallbackDestroysOtherExpiredTimer) {
+  MockFunction<TimerCb> callback;
+  TimerPtr second;
+  auto first = wheel_.createTimer([&] {
+    callback.Call();
+    second.reset();
+  });
+  second = wheel_.createTimer(callback.AsStdFunction());
+  first->enableTimer(std::chrono::milliseconds(10));
+  second->enableTimer(std::chrono::milliseconds(10));
+
+  // The second timer is destroyed by the callback of the first before firing.
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(10));
+  EXPECT_FALSE(first->enabled());
+}
+
+TEST_F(TimerWheelTest, CallbackEnablesTimerAgain) {
+  MockFunction<TimerCb> callback;
+  TimerPtr timer;
+  timer = wheel_.createTimer([&] {
+    callback.Call();
+    timer->enableTimer(std::chrono::milliseconds(0));
+  });
+  timer->enableTimer(std::chrono::milliseconds(0));
+
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(1));
+  EXPECT_TRUE(timer->enabled());
+
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(1));
+  timer->disableTimer();
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
@@ -400,6 +400,17 @@ TEST(SubstitutionFormatterTest, streamInfoFormatter) {
                 ProtoEq(ValueUtil::numberValue(25.0)));
   }
 
+  {
+    StreamInfoFormatter cpu_time_format("CPU_TIME");
+    EXPECT_EQ("0", cpu_time_format.formatWithContext({}, stream_info));
+
+    stream_info.downstream_timing_.addCpuTime(std::chrono::microseconds(1500));
+    stream_info.downstream_timing_.addCpuTime(std::chrono::nanoseconds(700));
+    EXPECT_EQ("1500", cpu_time_format.formatWithContext({}, stream_info));
+    EXPECT_THAT(cpu_time_format.formatValueWithContext({}, stream_info),
+                ProtoEq(ValueUtil::numberValue(1500.0)));
+  }
+
   {
     StreamInfoFormatter bytes_retransmitted_format("BYTES_RETRANSMITTED");
     EXPECT_CALL(stream_info, bytesRetransmitted()).WillRepeatedly(Return(1));
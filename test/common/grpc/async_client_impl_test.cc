@@ -116,6 +116,41 @@ TEST_F(EnvoyAsyncClientImplTest, HostIsOverrideByConfig) {
   EXPECT_EQ(grpc_stream, nullptr);
 }
 
+// Validate that the path header names the method of each stream, when the paths are reused across
+// streams.
+TEST_F(EnvoyAsyncClientImplTest, PathIsMethodOfEachStream) {
+  NiceMock<MockAsyncStreamCallbacks<helloworld::HelloReply>> grpc_callbacks;
+  Http::AsyncClient::StreamCallbacks* http_callbacks;
+
+  Http::MockAsyncClientStream http_stream;
+  EXPECT_CALL(http_client_, start(_, _))
+      .Times(3)
+      .WillRepeatedly(
+          Invoke([&http_callbacks, &http_stream](Http::AsyncClient::StreamCallbacks& callbacks,
+                                                 const Http::AsyncClient::StreamOptions&) {
+            http_callbacks = &callbacks;
+            return &http_stream;
+          }));
+
+  std::vector<std::string> paths;
+  EXPECT_CALL(http_stream, sendHeaders(_, _))
+      .Times(3)
+      .WillRepeatedly(Invoke([&http_callbacks, &paths](Http::RequestHeaderMap& headers, bool) {
+        paths.emplace_back(headers.getPathValue());
+        http_callbacks->onReset();
+      }));
+  RawAsyncClientPtr raw_client = *AsyncClientImpl::create(cm_, config, test_time_.timeSystem());
+  EXPECT_EQ(nullptr, raw_client->startRaw("helloworld.Greeter", "SayHello", grpc_callbacks,
+                                          Http::AsyncClient::StreamOptions()));
+  EXPECT_EQ(nullptr, raw_client->startRaw("helloworld.Greeter", "SayGoodbye", grpc_callbacks,
+                                          Http::AsyncClient::StreamOptions()));
+  EXPECT_EQ(nullptr, raw_client->startRaw("helloworld.Greeter", "SayHello", grpc_callbacks,
+                                          Http::AsyncClient::StreamOptions()));
+  EXPECT_THAT(paths, testing::ElementsAre("/helloworld.Greeter/SayHello",
+                                          "/helloworld.Greeter/SayGoodbye",
+                                          "/helloworld.Greeter/SayHello"));
+}
+
 // Validate that the metadata header is the initial metadata in gRPC service config and the value is
 // interpolated.
 TEST_F(EnvoyAsyncClientImplTest, MetadataIsInitialized) {
@@ -221,6 +221,55 @@ TEST(GrpcCodecTest, decodeMultipleFrame) {
   }
 }
 
+// The frame data is moved out of the input rather than copied.
+TEST(GrpcCodecTest, DecodeMovesFrameData) {
+  const std::string payload(16384, 'a');
+  std::array<uint8_t, 5> header;
+  Encoder().newFrame(GRPC_FH_DEFAULT, payload.size(), header);
+
+  Buffer::OwnedImpl buffer(header.data(), header.size());
+  Buffer::OwnedImpl payload_buffer(payload);
+  const void* payload_mem = payload_buffer.frontSlice().mem_;
+  buffer.move(payload_buffer);
+  ASSERT_EQ(2, buffer.getRawSlices().size());
+  ASSERT_EQ(payload_mem, buffer.getRawSlices()[1].mem_);
+
+  std::vector<Frame> frames;
+  Decoder decoder;
+  EXPECT_TRUE(decoder.decode(buffer, frames).ok());
+  EXPECT_EQ(0, buffer.length());
+  ASSERT_EQ(1, frames.size());
+  EXPECT_EQ(payload.size(), frames[0].length_);
+  EXPECT_EQ(payload_mem, frames[0].data_->frontSlice().mem_);
+  EXPECT_EQ(payload, frames[0].data_->toString());
+}
+
+// A frame header split across inputs is decoded.
+TEST(GrpcCodecTest, DecodeSplitFrameHeader) {
+  helloworld::HelloRequest request;
+  request.set_name("hello");
+  std::array<uint8_t, 5> header;
+  Encoder().newFrame(GRPC_FH_DEFAULT, request.ByteSize(), header);
+
+  std::vector<Frame> frames;
+  Decoder decoder;
+  Buffer::OwnedImpl buffer(header.data(), 2);
+  EXPECT_TRUE(decoder.decode(buffer, frames).ok());
+  EXPECT_EQ(0, buffer.length());
+  EXPECT_TRUE(decoder.hasBufferedData());
+
+  buffer.add(header.data() + 2, 3);
+  buffer.add(request.SerializeAsString());
+  EXPECT_TRUE(decoder.decode(buffer, frames).ok());
+  EXPECT_EQ(0, buffer.length());
+  EXPECT_FALSE(decoder.hasBufferedData());
+  ASSERT_EQ(1, frames.size());
+  EXPECT_EQ(GRPC_FH_DEFAULT, frames[0].flags_);
+  helloworld::HelloRequest result;
+  EXPECT_TRUE(result.ParseFromString(frames[0].data_->toString()));
+  EXPECT_EQ("hello", result.name());
+}
+
 TEST(GrpcCodecTest, decodeSingleFrameOverLimit) {
   helloworld::HelloRequest request;
   std::string test_str = std::string(64 * 1024, 'a');
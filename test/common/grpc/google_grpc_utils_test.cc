@@ -86,6 +86,39 @@ TEST(GoogleGrpcUtilsTest, ByteBufferInstanceRoundTrip) {
   EXPECT_EQ(buffer_instance2->toString(), "test this");
 }
 
+// Test that large data is aliased rather than copied in both directions, and small data is copied.
+TEST(GoogleGrpcUtilsTest, LargeDataIsAliased) {
+  const std::string large(GoogleGrpcUtils::MaxCopiedSize + 1, 'a');
+  auto buffer = std::make_unique<Buffer::OwnedImpl>();
+  Buffer::BufferFragmentImpl fragment(large.data(), large.size(), nullptr);
+  buffer->addBufferFragment(fragment);
+  auto byte_buffer = GoogleGrpcUtils::makeByteBuffer(std::move(buffer));
+  std::vector<grpc::Slice> slices;
+  RELEASE_ASSERT(byte_buffer.Dump(&slices).ok(), "");
+  ASSERT_EQ(1U, slices.size());
+  EXPECT_EQ(static_cast<const void*>(large.data()), slices[0].begin());
+
+  auto buffer_instance = GoogleGrpcUtils::makeBufferInstance(byte_buffer);
+  EXPECT_EQ(static_cast<const void*>(large.data()), buffer_instance->frontSlice().mem_);
+  EXPECT_EQ(large, buffer_instance->toString());
+}
+
+TEST(GoogleGrpcUtilsTest, SmallDataIsCopied) {
+  const std::string small(GoogleGrpcUtils::MaxCopiedSize, 'a');
+  auto buffer = std::make_unique<Buffer::OwnedImpl>();
+  Buffer::BufferFragmentImpl fragment(small.data(), small.size(), nullptr);
+  buffer->addBufferFragment(fragment);
+  auto byte_buffer = GoogleGrpcUtils::makeByteBuffer(std::move(buffer));
+  std::vector<grpc::Slice> slices;
+  RELEASE_ASSERT(byte_buffer.Dump(&slices).ok(), "");
+  ASSERT_EQ(1U, slices.size());
+  EXPECT_NE(static_cast<const void*>(small.data()), slices[0].begin());
+
+  auto buffer_instance = GoogleGrpcUtils::makeBufferInstance(byte_buffer);
+  EXPECT_NE(slices[0].begin(), buffer_instance->frontSlice().mem_);
+  EXPECT_EQ(small, buffer_instance->toString());
+}
+
 // Validate that we build the grpc::ChannelArguments as expected.
 TEST(GoogleGrpcUtilsTest, ChannelArgsFromConfig) {
   const auto config = TestUtility::parseYaml<envoy::config::core::v3::GrpcService>(R"EOF(
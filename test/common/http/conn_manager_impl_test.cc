@@ -1,4 +1,5 @@
 #include <chrono>
+#include <ctime>
 
 #include "envoy/network/proxy_protocol.h"
 
@@ -20,6 +21,7 @@ using testing::Invoke;
 using testing::InvokeWithoutArgs;
 using testing::Mock;
 using testing::Return;
+using testing::ReturnPointee;
 using testing::ReturnRef;
 
 namespace Envoy {
@@ -2325,6 +2327,62 @@ TEST_F(HttpConnectionManagerImplTest, TestFilterCanEnrichAccessLogs) {
   conn_manager_->onData(fake_input, false);
 }
 
+#ifndef WIN32
+// The thread CPU clock is not read on Windows.
+TEST_F(HttpConnectionManagerImplTest, TestCpuTimeAccessLog) {
+  track_cpu_time_ = true;
+  setup();
+
+  std::shared_ptr<MockStreamDecoderFilter> filter(new NiceMock<MockStreamDecoderFilter>());
+  std::shared_ptr<AccessLog::MockInstance> handler(new NiceMock<AccessLog::MockInstance>());
+
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillOnce(Invoke([&](FilterChainManager& manager) -> bool {
+        FilterFactoryCb filter_factory = createDecoderFilterFactoryCb(filter);
+        FilterFactoryCb handler_factory = createLogHandlerFactoryCb(handler);
+
+        manager.applyFilterFactoryCb({}, filter_factory);
+        manager.applyFilterFactoryCb({}, handler_factory);
+        return true;
+      }));
+
+  EXPECT_CALL(*filter, decodeHeaders(_, true))
+      .WillOnce(Invoke([](RequestHeaderMap&, bool) -> FilterHeadersStatus {
+        // Keep the CPU busy for a while, so that the thread CPU clock advances.
+        const std::clock_t start = std::clock();
+        while (std::clock() - start < CLOCKS_PER_SEC / 100) {
+        }
+        return FilterHeadersStatus::StopIteration;
+      }));
+
+  EXPECT_CALL(*handler, log(_, _))
+      .WillOnce(Invoke([](const Formatter::HttpFormatterContext&,
+                          const StreamInfo::StreamInfo& stream_info) {
+        EXPECT_GE(stream_info.downstreamTiming()->cpuTime(), std::chrono::milliseconds(1));
+      }));
+
+  EXPECT_CALL(*codec_, dispatch(_))
+      .WillRepeatedly(Invoke([&](Buffer::Instance& data) -> Http::Status {
+        RequestDecoder* decoder = &conn_manager_->newStream(response_encoder_);
+
+        RequestHeaderMapPtr headers{new TestRequestHeaderMapImpl{
+            {":method", "GET"}, {":authority", "host"}, {":path", "/"}}};
+        decoder->decodeHeaders(std::move(headers), true);
+
+        filter->callbacks_->streamInfo().setResponseCodeDetails("");
+        ResponseHeaderMapPtr response_headers{new TestResponseHeaderMapImpl{{":status", "200"}}};
+        filter->callbacks_->encodeHeaders(std::move(response_headers), true, "details");
+        response_encoder_.stream_.codec_callbacks_->onCodecEncodeComplete();
+
+        data.drain(4);
+        return Http::okStatus();
+      }));
+
+  Buffer::OwnedImpl fake_input("1234");
+  conn_manager_->onData(fake_input, false);
+}
+#endif
+
 TEST_F(HttpConnectionManagerImplTest, TestRemoteDownstreamDisconnectAccessLog) {
   setup();
 
@@ -4129,6 +4187,73 @@ TEST_F(HttpConnectionManagerImplTest, FooUpgradeDrainClose) {
   filter_callbacks_.connection_.raiseEvent(Network::ConnectionEvent::RemoteClose);
 }
 
+// The idle timer of an upgraded stream is rescheduled at most once per event loop iteration.
+TEST_F(HttpConnectionManagerImplTest, UpgradeIdleTimerResetOncePerIteration) {
+  stream_idle_timeout_ = std::chrono::milliseconds(10);
+  setup(SetupOpts().setTracing(false));
+  MonotonicTime now(std::chrono::seconds(1));
+  ON_CALL(filter_callbacks_.connection_.dispatcher_, approximateMonotonicTime())
+      .WillByDefault(ReturnPointee(&now));
+
+  auto* filter = new MockStreamFilter();
+  EXPECT_CALL(*filter, decodeHeaders(_, false))
+      .WillOnce(Return(FilterHeadersStatus::StopIteration));
+  EXPECT_CALL(*filter, encodeHeaders(_, false)).WillOnce(Return(FilterHeadersStatus::Continue));
+  EXPECT_CALL(response_encoder_, encodeHeaders(_, false));
+  EXPECT_CALL(*filter, setDecoderFilterCallbacks(_));
+  EXPECT_CALL(*filter, setEncoderFilterCallbacks(_));
+  EXPECT_CALL(filter_factory_, createUpgradeFilterChain(_, _, _, _))
+      .WillOnce(Invoke([&](absl::string_view, const Http::FilterChainFactory::UpgradeMap*,
+                           FilterChainManager& manager, const Http::FilterChainOptions&) -> bool {
+        auto factory = createStreamFilterFactoryCb(StreamFilterSharedPtr{filter});
+        manager.applyFilterFactoryCb({}, factory);
+        return true;
+      }));
+
+  Event::MockTimer* idle_timer = nullptr;
+  EXPECT_CALL(*codec_, dispatch(_)).WillOnce(Invoke([&](Buffer::Instance& data) -> Http::Status {
+    idle_timer = setUpTimer();
+    EXPECT_CALL(*idle_timer, enableTimer(std::chrono::milliseconds(10), _)).Times(AnyNumber());
+    decoder_ = &conn_manager_->newStream(response_encoder_);
+    RequestHeaderMapPtr headers{new TestRequestHeaderMapImpl{{":authority", "host"},
+                                                             {":method", "GET"},
+                                                             {":path", "/"},
+                                                             {"connection", "Upgrade"},
+                                                             {"upgrade", "foo"}}};
+    decoder_->decodeHeaders(std::move(headers), false);
+
+    filter->decoder_callbacks_->streamInfo().setResponseCodeDetails("");
+    ResponseHeaderMapPtr response_headers{new TestResponseHeaderMapImpl{
+        {":status", "101"}, {"Connection", "upgrade"}, {"upgrade", "foo"}}};
+    filter->decoder_callbacks_->encodeHeaders(std::move(response_headers), false, "details");
+    data.drain(data.length());
+    return Http::okStatus();
+  }));
+  Buffer::OwnedImpl fake_input("1234");
+  conn_manager_->onData(fake_input, false);
+  Mock::VerifyAndClearExpectations(idle_timer);
+
+  EXPECT_CALL(*filter, decodeData(_, false))
+      .Times(3)
+      .WillRepeatedly(Return(FilterDataStatus::StopIterationNoBuffer));
+  now += std::chrono::milliseconds(1);
+  EXPECT_CALL(*idle_timer, enableTimer(std::chrono::milliseconds(10), _));
+  Buffer::OwnedImpl data1("a");
+  decoder_->decodeData(data1, false);
+  Buffer::OwnedImpl data2("b");
+  decoder_->decodeData(data2, false);
+  Mock::VerifyAndClearExpectations(idle_timer);
+
+  now += std::chrono::milliseconds(1);
+  EXPECT_CALL(*idle_timer, enableTimer(std::chrono::milliseconds(10), _));
+  Buffer::OwnedImpl data3("c");
+  decoder_->decodeData(data3, false);
+
+  EXPECT_CALL(*filter, onStreamComplete());
+  EXPECT_CALL(*filter, onDestroy());
+  filter_callbacks_.connection_.raiseEvent(Network::ConnectionEvent::RemoteClose);
+}
+
 // Make sure CONNECT requests hit the upgrade filter path.
 TEST_F(HttpConnectionManagerImplTest, ConnectAsUpgrade) {
   setup(SetupOpts().setTracing(false));
@@ -140,6 +140,7 @@ public:
   bool addProxyProtocolConnectionState() const override {
     return parent_.addProxyProtocolConnectionState();
   }
+  bool trackCpuTime() const override { return parent_.trackCpuTime(); }
 
 private:
   ConnectionManagerConfig& parent_;
@@ -35,6 +35,7 @@ TEST(FilterChainUtilityTest, CreateFilterChainForFactoriesWithRouteDisabled) {
 
   {
     // If empty filter chain options is provided, all filters should be added.
+    EXPECT_CALL(manager, reserveFilters(3));
     EXPECT_CALL(manager, applyFilterFactoryCb(_, _)).Times(3);
     FilterChainUtility::createFilterChainForFactories(manager, Http::EmptyFilterChainOptions{},
                                                       filter_factories);
@@ -0,0 +1,129 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "source/common/http/filter_task.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+// A fake asynchronous service, whose calls complete when the test completes them.
+class FakeService {
+public:
+  AsyncCall<int>::CancelFunction call(AsyncCall<int>::Done done) {
+    pending_.push_back(std::move(done));
+    const size_t index = pending_.size() - 1;
+    return [this, index]() {
+      pending_[index] = nullptr;
+      ++cancelled_;
+    };
+  }
+
+  void complete(size_t index, int result) {
+    ASSERT_TRUE(pending_[index]);
+    auto done = std::move(pending_[index]);
+    pending_[index] = nullptr;
+    done(result);
+  }
+
+  std::vector<AsyncCall<int>::Done> pending_;
+  int cancelled_{};
+};
+
+class FilterTaskTest : public testing::Test {
+public:
+  FilterTask sum(int calls) {
+    for (int i = 0; i < calls; ++i) {
+      sum_ += co_await AsyncCall<int>([this](auto done) { return service_.call(std::move(done)); });
+    }
+    events_.push_back("done");
+  }
+
+  FilterTask inlineCall() {
+    sum_ = co_await AsyncCall<int>([](auto done) -> AsyncCall<int>::CancelFunction {
+      done(42);
+      return []() {};
+    });
+  }
+
+  FakeService service_;
+  int sum_{};
+  std::vector<std::string> events_;
+};
+
+TEST_F(FilterTaskTest, CompletesWithoutWaiting) {
+  FilterTask task = sum(0);
+  EXPECT_TRUE(task.done());
+  EXPECT_EQ(std::vector<std::string>{"done"}, events_);
+}
+
+TEST_F(FilterTaskTest, CompletesInline) {
+  FilterTask task = inlineCall();
+  EXPECT_TRUE(task.done());
+  EXPECT_EQ(42, sum_);
+}
+
+TEST_F(FilterTaskTest, ResumesOnCompletion) {
+  FilterTask task = sum(2);
+  EXPECT_FALSE(task.done());
+  task.onAsyncCompletion([this]() { events_.push_back("completion"); });
+
+  service_.complete(0, 1);
+  EXPECT_FALSE(task.done());
+  EXPECT_EQ(1, sum_);
+
+  service_.complete(1, 2);
+  EXPECT_TRUE(task.done());
+  EXPECT_EQ(3, sum_);
+  EXPECT_EQ((std::vector<std::string>{"done", "completion"}), events_);
+  EXPECT_EQ(0, service_.cancelled_);
+}
+
+TEST_F(FilterTaskTest, CompletionDestroysTask) {
+  auto task = std::make_unique<FilterTask>(sum(1));
+  task->onAsyncCompletion([&task]() { task.reset(); });
+  service_.complete(0, 1);
+  EXPECT_EQ(nullptr, task);
+}
+
+TEST_F(FilterTaskTest, DestroyCancelsPendingCall) {
+  FilterTask task = sum(2);
+  service_.complete(0, 1);
+  task.reset();
+
+  EXPECT_TRUE(task.done());
+  EXPECT_EQ(1, service_.cancelled_);
+  EXPECT_EQ(1, sum_);
+  EXPECT_TRUE(events_.empty());
+}
+
+TEST_F(FilterTaskTest, MoveTransfersCoroutine) {
+  FilterTask task = sum(1);
+  FilterTask other;
+  other = std::move(task);
+  EXPECT_TRUE(task.done());
+  EXPECT_FALSE(other.done());
+  service_.complete(0, 1);
+  EXPECT_TRUE(other.done());
+  EXPECT_EQ(0, service_.cancelled_);
+}
+
+TEST(FilterTaskFrameAllocatorTest, ReusesFrames) {
+  void* frame = FilterTaskFrameAllocator::allocate(100);
+  FilterTaskFrameAllocator::deallocate(frame, 100);
+  // Frames of the same size class are reused.
+  void* reused = FilterTaskFrameAllocator::allocate(120);
+  EXPECT_EQ(frame, reused);
+  FilterTaskFrameAllocator::deallocate(reused, 120);
+
+  // Large frames aren't cached.
+  void* large = FilterTaskFrameAllocator::allocate(4096);
+  FilterTaskFrameAllocator::deallocate(large, 4096);
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
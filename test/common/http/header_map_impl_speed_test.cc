@@ -1,5 +1,6 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
+#include "source/common/memory/stats.h"
 
 #include "test/test_common/utility.h"
 
@@ -210,6 +211,51 @@ static void headerMapImplPopulate(benchmark::State& state) {
 }
 BENCHMARK(headerMapImplPopulate);
 
+/**
+ * Measure the speed of creating, populating and destroying the headers of a request, as done once
+ * per stream. The numeric Arg passed by the BENCHMARK(...) macro call below indicates how many
+ * dummy headers are added after a realistic set of request headers. The memory held by a populated
+ * map is reported as a counter when the heap statistics are available (i.e. with tcmalloc).
+ */
+static void headerMapImplRequestLifetime(benchmark::State& state) {
+  const std::pair<LowerCaseString, std::string> headers_to_add[] = {
+      {LowerCaseString(":method"), "GET"},
+      {LowerCaseString(":path"), "/search/results?query=envoy+proxy&page=2"},
+      {LowerCaseString(":scheme"), "https"},
+      {LowerCaseString(":authority"), "www.example.com"},
+      {LowerCaseString("user-agent"),
+       "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko)"},
+      {LowerCaseString("accept"), "text/html,application/xhtml+xml,application/xml;q=0.9"},
+      {LowerCaseString("accept-language"), "en-US,en;q=0.9"},
+      {LowerCaseString("accept-encoding"), "gzip, deflate, br"},
+      {LowerCaseString("cookie"), "session_id=4f3c2a1b9e8d7c6b5a4f3e2d1c0b9a8f"},
+      {LowerCaseString("x-forwarded-proto"), "https"},
+      {LowerCaseString("x-request-id"), "c9a5d3e0-2f1b-4a8c-9d7e-6b5a4f3e2d1c"},
+  };
+  const size_t num_dummy_headers = state.range(0);
+  const auto populate = [&]() {
+    auto headers = Http::RequestHeaderMapImpl::create();
+    for (const auto& key_value : headers_to_add) {
+      headers->addReference(key_value.first, key_value.second);
+    }
+    addDummyHeaders(*headers, num_dummy_headers);
+    return headers;
+  };
+
+  const uint64_t allocated_before = Memory::Stats::totalCurrentlyAllocated();
+  {
+    auto headers = populate();
+    state.counters["allocated_bytes"] =
+        Memory::Stats::totalCurrentlyAllocated() - allocated_before;
+  }
+
+  for (auto _ : state) { // NOLINT
+    auto headers = populate();
+    benchmark::DoNotOptimize(headers->size());
+  }
+}
+BENCHMARK(headerMapImplRequestLifetime)->Arg(0)->Arg(10)->Arg(50);
+
 /**
  * Measure the speed of encoding headers as part of upgraded requests (HTTP/1 to HTTP/2)
  * @note The measured time for each iteration includes the time needed to add
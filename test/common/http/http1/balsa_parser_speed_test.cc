@@ -0,0 +1,87 @@
+#include "source/common/http/http1/balsa_parser.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+
+namespace {
+
+class NullParserCallbacks : public ParserCallbacks {
+public:
+  CallbackResult onMessageBegin() override { return CallbackResult::Success; }
+  CallbackResult onUrl(const char*, size_t) override { return CallbackResult::Success; }
+  CallbackResult onStatus(const char*, size_t) override { return CallbackResult::Success; }
+  CallbackResult onHeaderField(const char*, size_t) override { return CallbackResult::Success; }
+  CallbackResult onHeaderValue(const char*, size_t) override { return CallbackResult::Success; }
+  CallbackResult onHeadersComplete() override { return CallbackResult::Success; }
+  void bufferBody(const char*, size_t) override {}
+  CallbackResult onMessageComplete() override { return CallbackResult::Success; }
+  void onChunkHeader(bool) override {}
+};
+
+// A request as sent by a browser, with long field values and a long URL.
+constexpr absl::string_view Request =
+    "GET /search/results/page?query=envoy+proxy+http1+header+parsing&lang=en-US&page=2 HTTP/1.1\r\n"
+    "Host: www.example.com\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) "
+    "Chrome/124.0.0.0 Safari/537.36\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8"
+    "\r\n"
+    "Accept-Language: en-US,en;q=0.9\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Referer: https://www.example.com/search/results/page?query=envoy+proxy&lang=en-US&page=1\r\n"
+    "Cookie: session_id=4f3c2a1b9e8d7c6b5a4f3e2d1c0b9a8f; preferences=theme%3Ddark%26layout%3D"
+    "compact; tracking_consent=yes\r\n"
+    "Cache-Control: max-age=0\r\n"
+    "Sec-Fetch-Dest: document\r\n"
+    "Sec-Fetch-Mode: navigate\r\n"
+    "Sec-Fetch-Site: same-origin\r\n"
+    "Upgrade-Insecure-Requests: 1\r\n"
+    "\r\n";
+
+constexpr absl::string_view Response =
+    "HTTP/1.1 200 OK\r\n"
+    "Date: Mon, 13 May 2024 10:00:00 GMT\r\n"
+    "Content-Type: text/html; charset=utf-8\r\n"
+    "Content-Length: 0\r\n"
+    "Cache-Control: private, no-cache, no-store, must-revalidate, max-age=0\r\n"
+    "Set-Cookie: session_id=4f3c2a1b9e8d7c6b5a4f3e2d1c0b9a8f; Path=/; Secure; HttpOnly; "
+    "SameSite=Lax\r\n"
+    "Strict-Transport-Security: max-age=31536000; includeSubDomains; preload\r\n"
+    "X-Content-Type-Options: nosniff\r\n"
+    "X-Envoy-Upstream-Service-Time: 12\r\n"
+    "Server: envoy\r\n"
+    "\r\n";
+
+void parse(benchmark::State& state, MessageType type, absl::string_view message) {
+  NullParserCallbacks callbacks;
+  for (auto _ : state) { // NOLINT
+    BalsaParser parser(type, &callbacks, 60 * 1024, /*enable_trailers=*/false,
+                       /*allow_custom_methods=*/false);
+    const size_t consumed = parser.execute(message.data(), message.size());
+    benchmark::DoNotOptimize(consumed);
+    if (parser.getStatus() == ParserStatus::Error) {
+      state.SkipWithError("parser error");
+      break;
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * message.size());
+}
+
+} // namespace
+
+static void BM_ParseRequest(benchmark::State& state) {
+  parse(state, MessageType::Request, Request);
+}
+BENCHMARK(BM_ParseRequest);
+
+static void BM_ParseResponse(benchmark::State& state) {
+  parse(state, MessageType::Response, Response);
+}
+BENCHMARK(BM_ParseResponse);
+
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
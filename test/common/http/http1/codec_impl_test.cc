@@ -1693,6 +1693,30 @@ TEST_P(Http1ServerConnectionImplTest, HeaderOnlyResponse) {
   EXPECT_EQ(Protocol::Http11, codec_->protocol());
 }
 
+// Status codes without a standard reason phrase are encoded with "Unknown".
+TEST_P(Http1ServerConnectionImplTest, UnknownStatusResponse) {
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  Http::ResponseEncoder* response_encoder = nullptr;
+  EXPECT_CALL(callbacks_, newStream(_, _))
+      .WillOnce(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoder = &encoder;
+        return decoder;
+      }));
+
+  Buffer::OwnedImpl buffer("GET / HTTP/1.1\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+
+  TestResponseHeaderMapImpl headers{{":status", "299"}};
+  response_encoder->encodeHeaders(headers, true);
+  EXPECT_EQ("HTTP/1.1 299 Unknown\r\ncontent-length: 0\r\n\r\n", output);
+}
+
 // As with Http1ClientConnectionImplTest.LargeHeaderRequestEncode but validate
 // the response encoder instead of request encoder.
 TEST_P(Http1ServerConnectionImplTest, LargeHeaderResponseEncode) {
@@ -2812,6 +2836,90 @@ TEST_P(Http1ClientConnectionImplTest, EmptyBodyResponse200) {
   EXPECT_TRUE(status.ok());
 }
 
+TEST_P(Http1ClientConnectionImplTest, PipelinedResponses) {
+  initialize();
+
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+
+  TestRequestHeaderMapImpl headers{{":method", "GET"}, {":path", "/"}, {":authority", "host"}};
+  NiceMock<MockResponseDecoder> response_decoder1;
+  Http::RequestEncoder& request_encoder1 = codec_->newStream(response_decoder1);
+  EXPECT_TRUE(request_encoder1.encodeHeaders(headers, true).ok());
+  NiceMock<MockResponseDecoder> response_decoder2;
+  Http::RequestEncoder& request_encoder2 = codec_->newStream(response_decoder2);
+  EXPECT_TRUE(request_encoder2.encodeHeaders(headers, true).ok());
+  EXPECT_EQ("GET / HTTP/1.1\r\nhost: host\r\n\r\nGET / HTTP/1.1\r\nhost: host\r\n\r\n",
+            output);
+
+  // Both responses are decoded in order from one read.
+  InSequence sequence;
+  EXPECT_CALL(response_decoder1,
+              decodeHeaders_(HeaderHasValueRef(Headers::get().Status, "200"), false));
+  EXPECT_CALL(response_decoder1, decodeData(BufferStringEqual("a"), true));
+  EXPECT_CALL(response_decoder2,
+              decodeHeaders_(HeaderHasValueRef(Headers::get().Status, "204"), true));
+  Buffer::OwnedImpl response(
+      "HTTP/1.1 200 OK\r\nContent-Length: 1\r\n\r\naHTTP/1.1 204 No Content\r\n\r\n");
+  auto status = codec_->dispatch(response);
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(0, response.length());
+}
+
+TEST_P(Http1ClientConnectionImplTest, PipelinedRequestsReset) {
+  initialize();
+
+  TestRequestHeaderMapImpl headers{{":method", "GET"}, {":path", "/"}, {":authority", "host"}};
+  NiceMock<MockResponseDecoder> response_decoder1;
+  Http::RequestEncoder& request_encoder1 = codec_->newStream(response_decoder1);
+  EXPECT_TRUE(request_encoder1.encodeHeaders(headers, true).ok());
+  NiceMock<MockResponseDecoder> response_decoder2;
+  Http::RequestEncoder& request_encoder2 = codec_->newStream(response_decoder2);
+  EXPECT_TRUE(request_encoder2.encodeHeaders(headers, true).ok());
+  Http::MockStreamCallbacks callbacks1;
+  request_encoder1.getStream().addCallbacks(callbacks1);
+  Http::MockStreamCallbacks callbacks2;
+  request_encoder2.getStream().addCallbacks(callbacks2);
+
+  // Resetting a fully sent request leaves the connection to the other one.
+  EXPECT_CALL(callbacks1, onResetStream(StreamResetReason::LocalReset, _));
+  EXPECT_CALL(callbacks2, onResetStream(_, _)).Times(0);
+  request_encoder1.getStream().resetStream(StreamResetReason::LocalReset);
+
+  // The response of the reset request is discarded.
+  EXPECT_CALL(response_decoder1, decodeHeaders_(_, _)).Times(0);
+  EXPECT_CALL(response_decoder1, decodeData(_, _)).Times(0);
+  EXPECT_CALL(response_decoder2,
+              decodeHeaders_(HeaderHasValueRef(Headers::get().Status, "204"), true));
+  Buffer::OwnedImpl response(
+      "HTTP/1.1 200 OK\r\nContent-Length: 1\r\n\r\naHTTP/1.1 204 No Content\r\n\r\n");
+  auto status = codec_->dispatch(response);
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(0, response.length());
+}
+
+TEST_P(Http1ClientConnectionImplTest, PipelinedRequestsConnectionFailure) {
+  initialize();
+
+  TestRequestHeaderMapImpl headers{{":method", "GET"}, {":path", "/"}, {":authority", "host"}};
+  NiceMock<MockResponseDecoder> response_decoder1;
+  Http::RequestEncoder& request_encoder1 = codec_->newStream(response_decoder1);
+  EXPECT_TRUE(request_encoder1.encodeHeaders(headers, true).ok());
+  NiceMock<MockResponseDecoder> response_decoder2;
+  Http::RequestEncoder& request_encoder2 = codec_->newStream(response_decoder2);
+  EXPECT_TRUE(request_encoder2.encodeHeaders(headers, true).ok());
+  Http::MockStreamCallbacks callbacks1;
+  request_encoder1.getStream().addCallbacks(callbacks1);
+  Http::MockStreamCallbacks callbacks2;
+  request_encoder2.getStream().addCallbacks(callbacks2);
+
+  // All requests are reset with the connection. The pipelined one, whose response has not
+  // started, is refused so that it may be sent again.
+  EXPECT_CALL(callbacks1, onResetStream(StreamResetReason::ConnectionTermination, _));
+  EXPECT_CALL(callbacks2, onResetStream(StreamResetReason::RemoteRefusedStreamReset, _));
+  request_encoder2.getStream().resetStream(StreamResetReason::ConnectionTermination);
+}
+
 TEST_P(Http1ClientConnectionImplTest, HeadRequest) {
   initialize();
 
@@ -169,7 +169,7 @@ public:
  * Helper for dealing with an active test request.
  */
 struct ActiveTestRequest {
-  enum class Type { Pending, CreateConnection, Immediate };
+  enum class Type { Pending, CreateConnection, Immediate, Pipelined };
 
   ActiveTestRequest(Http1ConnPoolImplTest& parent, size_t client_index, Type type)
       : parent_(parent), client_index_(client_index) {
@@ -180,13 +180,14 @@ struct ActiveTestRequest {
       parent.conn_pool_->expectClientCreate();
     }
 
-    if (type == Type::Immediate) {
+    if (type == Type::Immediate || type == Type::Pipelined) {
       expectNewStream();
     }
 
-    handle_ = parent.conn_pool_->newStream(outer_decoder_, callbacks_, {false, true});
+    handle_ = parent.conn_pool_->newStream(outer_decoder_, callbacks_,
+                                           {type == Type::Pipelined, true});
 
-    if (type == Type::Immediate) {
+    if (type == Type::Immediate || type == Type::Pipelined) {
       EXPECT_EQ(nullptr, handle_);
     } else {
       EXPECT_NE(nullptr, handle_);
@@ -1102,6 +1103,172 @@ TEST_F(Http1ConnPoolImplTest, PendingRequestIsConsideredActive) {
   EXPECT_EQ(1U, cluster_->traffic_stats_->upstream_cx_destroy_local_.value());
 }
 
+/**
+ * Test that replay-safe requests are pipelined on a busy connection, up to the configured number of
+ * requests in flight and only behind responses that are not late.
+ */
+TEST_F(Http1ConnPoolImplTest, PipelinedRequests) {
+  Event::SimulatedTimeSystem simulated_time;
+  cluster_->http1_settings_.max_requests_in_flight_ = 2;
+  cluster_->http1_settings_.pipelining_head_of_line_timeout_ = std::chrono::milliseconds(100);
+  cluster_->resetResourceManager(1, 1024, 1024, 1, 1);
+
+  ActiveTestRequest r1(*this, 0, ActiveTestRequest::Type::CreateConnection);
+  r1.startRequest();
+
+  // Requests which are not safe to replay wait for the connection.
+  ActiveTestRequest r2(*this, 0, ActiveTestRequest::Type::Pending);
+  r2.handle_->cancel(Envoy::ConnectionPool::CancelPolicy::Default);
+
+  ActiveTestRequest r3(*this, 0, ActiveTestRequest::Type::Pipelined);
+  r3.startRequest();
+  EXPECT_EQ(1U, cluster_->traffic_stats_->upstream_rq_pipelined_.value());
+
+  // At most two requests are in flight.
+  NiceMock<MockResponseDecoder> outer_decoder;
+  ConnPoolCallbacks callbacks;
+  Http::ConnectionPool::Cancellable* handle =
+      conn_pool_->newStream(outer_decoder, callbacks, {true, true});
+  EXPECT_NE(nullptr, handle);
+  handle->cancel(Envoy::ConnectionPool::CancelPolicy::Default);
+
+  // The connection stays busy while the pipelined request waits for its response.
+  conn_pool_->expectEnableUpstreamReady();
+  r1.completeResponse(false);
+  conn_pool_->expectAndRunUpstreamReady();
+  ActiveTestRequest r4(*this, 0, ActiveTestRequest::Type::Pending);
+  r4.handle_->cancel(Envoy::ConnectionPool::CancelPolicy::Default);
+
+  // Nothing is pipelined behind a late response.
+  simulated_time.advanceTimeWait(std::chrono::milliseconds(100));
+  handle = conn_pool_->newStream(outer_decoder, callbacks, {true, true});
+  EXPECT_NE(nullptr, handle);
+  handle->cancel(Envoy::ConnectionPool::CancelPolicy::Default);
+  EXPECT_EQ(1U, cluster_->traffic_stats_->upstream_rq_pipelined_.value());
+
+  conn_pool_->expectEnableUpstreamReady();
+  r3.completeResponse(false);
+  EXPECT_CALL(*conn_pool_, onClientDestroy());
+  conn_pool_->expectAndRunUpstreamReady();
+  conn_pool_->test_clients_[0].connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  dispatcher_.clearDeferredDeleteList();
+}
+
+/**
+ * Test that nothing is pipelined behind a request which is not safe to send again.
+ */
+TEST_F(Http1ConnPoolImplTest, NoPipeliningBehindUnsafeRequest) {
+  cluster_->http1_settings_.max_requests_in_flight_ = 2;
+  cluster_->http1_settings_.pipelining_head_of_line_timeout_ = std::chrono::milliseconds(100);
+  cluster_->resetResourceManager(1, 1024, 1024, 1, 1);
+
+  ActiveTestRequest r1(*this, 0, ActiveTestRequest::Type::CreateConnection);
+  EXPECT_TRUE(
+      r1.callbacks_.outer_encoder_
+          ->encodeHeaders(TestRequestHeaderMapImpl{{":path", "/"}, {":method", "POST"}}, true)
+          .ok());
+
+  NiceMock<MockResponseDecoder> outer_decoder;
+  ConnPoolCallbacks callbacks;
+  Http::ConnectionPool::Cancellable* handle =
+      conn_pool_->newStream(outer_decoder, callbacks, {true, true});
+  EXPECT_NE(nullptr, handle);
+  handle->cancel(Envoy::ConnectionPool::CancelPolicy::Default);
+  EXPECT_EQ(0U, cluster_->traffic_stats_->upstream_rq_pipelined_.value());
+
+  conn_pool_->expectEnableUpstreamReady();
+  r1.completeResponse(false);
+  EXPECT_CALL(*conn_pool_, onClientDestroy());
+  conn_pool_->expectAndRunUpstreamReady();
+  conn_pool_->test_clients_[0].connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  dispatcher_.clearDeferredDeleteList();
+}
+
+/**
+ * Test that resetting a stream while others wait on the connection keeps the connection and
+ * pipelining, and that the connection is closed once only discarded responses are left on it.
+ */
+TEST_F(Http1ConnPoolImplTest, PipelinedRequestReset) {
+  cluster_->http1_settings_.max_requests_in_flight_ = 2;
+  cluster_->http1_settings_.pipelining_head_of_line_timeout_ = std::chrono::milliseconds(100);
+  cluster_->resetResourceManager(1, 1024, 1024, 1, 1);
+
+  ActiveTestRequest r1(*this, 0, ActiveTestRequest::Type::CreateConnection);
+  r1.startRequest();
+  ActiveTestRequest r2(*this, 0, ActiveTestRequest::Type::Pipelined);
+  r2.startRequest();
+
+  // The pipelined stream is not affected by the reset of the first one.
+  r1.request_encoder_.getStream().resetStream(StreamResetReason::LocalReset);
+  conn_pool_->expectEnableUpstreamReady();
+  r2.completeResponse(false);
+  conn_pool_->expectAndRunUpstreamReady();
+
+  ActiveTestRequest r3(*this, 0, ActiveTestRequest::Type::Immediate);
+  r3.startRequest();
+  ActiveTestRequest r4(*this, 0, ActiveTestRequest::Type::Pipelined);
+  r4.startRequest();
+  EXPECT_EQ(2U, cluster_->traffic_stats_->upstream_rq_pipelined_.value());
+
+  r4.request_encoder_.getStream().resetStream(StreamResetReason::LocalReset);
+  conn_pool_->expectEnableUpstreamReady();
+  EXPECT_CALL(*conn_pool_, onClientDestroy());
+  r3.completeResponse(false);
+  dispatcher_.clearDeferredDeleteList();
+}
+
+/**
+ * Test that the pool keeps pipelining after a connection with pipelined requests fails, but stops
+ * after a protocol error on such a connection.
+ */
+TEST_F(Http1ConnPoolImplTest, PipelinedRequestsFailure) {
+  cluster_->http1_settings_.max_requests_in_flight_ = 2;
+  cluster_->http1_settings_.pipelining_head_of_line_timeout_ = std::chrono::milliseconds(100);
+  cluster_->resetResourceManager(1, 1024, 1024, 1, 1);
+
+  ActiveTestRequest r1(*this, 0, ActiveTestRequest::Type::CreateConnection);
+  r1.startRequest();
+  ActiveTestRequest r2(*this, 0, ActiveTestRequest::Type::Pipelined);
+  r2.startRequest();
+
+  Http::MockStreamCallbacks stream_callbacks1;
+  r1.request_encoder_.getStream().addCallbacks(stream_callbacks1);
+  Http::MockStreamCallbacks stream_callbacks2;
+  r2.request_encoder_.getStream().addCallbacks(stream_callbacks2);
+  EXPECT_CALL(stream_callbacks1, onResetStream(StreamResetReason::ConnectionTermination, _));
+  EXPECT_CALL(stream_callbacks2, onResetStream(StreamResetReason::ConnectionTermination, _));
+  EXPECT_CALL(*conn_pool_, onClientDestroy());
+  conn_pool_->test_clients_[0].connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  dispatcher_.clearDeferredDeleteList();
+
+  ActiveTestRequest r3(*this, 0, ActiveTestRequest::Type::CreateConnection);
+  r3.startRequest();
+  ActiveTestRequest r4(*this, 0, ActiveTestRequest::Type::Pipelined);
+  r4.startRequest();
+  EXPECT_EQ(2U, cluster_->traffic_stats_->upstream_rq_pipelined_.value());
+
+  EXPECT_CALL(*conn_pool_, onClientDestroy());
+  r3.request_encoder_.getStream().resetStream(StreamResetReason::ProtocolError);
+  dispatcher_.clearDeferredDeleteList();
+
+  ActiveTestRequest r5(*this, 0, ActiveTestRequest::Type::CreateConnection);
+  r5.startRequest();
+  NiceMock<MockResponseDecoder> outer_decoder;
+  ConnPoolCallbacks callbacks;
+  Http::ConnectionPool::Cancellable* handle =
+      conn_pool_->newStream(outer_decoder, callbacks, {true, true});
+  EXPECT_NE(nullptr, handle);
+  handle->cancel(Envoy::ConnectionPool::CancelPolicy::Default);
+  EXPECT_EQ(2U, cluster_->traffic_stats_->upstream_rq_pipelined_.value());
+
+  conn_pool_->expectEnableUpstreamReady();
+  r5.completeResponse(false);
+  EXPECT_CALL(*conn_pool_, onClientDestroy());
+  conn_pool_->expectAndRunUpstreamReady();
+  conn_pool_->test_clients_[0].connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  dispatcher_.clearDeferredDeleteList();
+}
+
 // Schedulable callback that can track it's destruction.
 class MockDestructSchedulableCallback : public Event::MockSchedulableCallback {
 public:
@@ -0,0 +1,91 @@
+#include <string>
+
+#include "source/common/http/http1/header_scanner.h"
+
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+namespace HeaderScanner {
+namespace {
+
+bool isTokenChar(char c) {
+  return absl::string_view("!#$%&'*+-.0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ^_`"
+                           "abcdefghijklmnopqrstuvwxyz|~")
+             .find(c) != absl::string_view::npos;
+}
+
+bool isPathQueryChar(char c) { return c == 9 || c == 12 || ('!' <= c && c <= 126); }
+
+bool isCrOrLf(char c) { return c == '\r' || c == '\n'; }
+
+TEST(HeaderScannerTest, Empty) {
+  EXPECT_TRUE(isToken(""));
+  EXPECT_TRUE(isPathQuery(""));
+  EXPECT_FALSE(containsCrOrLf(""));
+}
+
+TEST(HeaderScannerTest, Examples) {
+  EXPECT_TRUE(isToken("Content-Type"));
+  EXPECT_TRUE(isToken("x-envoy-upstream-service-time"));
+  EXPECT_TRUE(isToken("X_Custom.Header~1!"));
+  EXPECT_FALSE(isToken("x-envoy-upstream-service time"));
+  EXPECT_FALSE(isToken("x-envoy-upstream-service-time:"));
+
+  EXPECT_TRUE(isPathQuery("/api/v1/resource?filter=a%20b&sort=desc#fragment"));
+  EXPECT_FALSE(isPathQuery("/api/v1/resource?filter=a b"));
+  EXPECT_FALSE(isPathQuery("/api/v1/resource/\x80"));
+
+  EXPECT_FALSE(containsCrOrLf("text/html,application/xhtml+xml,application/xml;q=0.9"));
+  EXPECT_TRUE(containsCrOrLf("text/html,application/xhtml+xml,\rapplication/xml;q=0.9"));
+  EXPECT_TRUE(containsCrOrLf("text/html,application/xhtml+xml,application/xml;q=0.9\n"));
+}
+
+// Place every byte value at every position of inputs of various lengths, so that both the blocks
+// and the remainder are checked against the character classes.
+TEST(HeaderScannerTest, AllCharactersAtAllPositions) {
+  for (size_t length = 1; length <= 48; ++length) {
+    for (size_t position = 0; position < length; ++position) {
+      for (int c = 0; c < 256; ++c) {
+        const char ch = static_cast<char>(c);
+        std::string token(length, 'a');
+        token[position] = ch;
+        EXPECT_EQ(isTokenChar(ch), isToken(token)) << length << " " << position << " " << c;
+
+        std::string path_query(length, '/');
+        path_query[position] = ch;
+        EXPECT_EQ(isPathQueryChar(ch), isPathQuery(path_query))
+            << length << " " << position << " " << c;
+
+        std::string value(length, ' ');
+        value[position] = ch;
+        EXPECT_EQ(isCrOrLf(ch), containsCrOrLf(value)) << length << " " << position << " " << c;
+      }
+    }
+  }
+}
+
+// Token characters outside of the common letters, digits and '-' are accepted in any block.
+TEST(HeaderScannerTest, UncommonTokenCharacters) {
+  EXPECT_TRUE(isToken("!#$%&'*+-.^_`|~!#$%&'*+-.^_`|~!#"));
+  EXPECT_FALSE(isToken("!#$%&'*+-.^_`|~!#$%&'*+-.^_`|~!\""));
+}
+
+// Input that doesn't start at an aligned address.
+TEST(HeaderScannerTest, Unaligned) {
+  const std::string input = "xx-forwarded-for-forwarded-for-forwarded-for";
+  for (size_t offset = 0; offset < 16; ++offset) {
+    const absl::string_view view = absl::string_view(input).substr(offset);
+    EXPECT_TRUE(isToken(view));
+    EXPECT_TRUE(isPathQuery(view));
+    EXPECT_FALSE(containsCrOrLf(view));
+  }
+}
+
+} // namespace
+} // namespace HeaderScanner
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
@@ -600,6 +600,59 @@ TEST_P(Http2CodecImplTest, SimpleRequestResponse) {
   }
 }
 
+// DATA frames end at slice boundaries, so that their payload is not copied.
+TEST_P(Http2CodecImplTest, DataFramesAlignedToSlices) {
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, true).ok());
+  driveToCompletion();
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, false));
+  response_encoder_->encodeHeaders(response_headers, false);
+
+  // Without alignment, the first frame would take all of the first slice and part of the second.
+  Buffer::OwnedImpl response_body;
+  response_body.appendSliceForTest(std::string(10000, 'a'));
+  response_body.appendSliceForTest(std::string(10000, 'b'));
+  InSequence s;
+  EXPECT_CALL(response_decoder_, decodeData(_, false))
+      .WillOnce(Invoke([](Buffer::Instance& data, bool) {
+        EXPECT_EQ(std::string(10000, 'a'), data.toString());
+      }));
+  EXPECT_CALL(response_decoder_, decodeData(_, true))
+      .WillOnce(Invoke([](Buffer::Instance& data, bool) {
+        EXPECT_EQ(std::string(10000, 'b'), data.toString());
+      }));
+  response_encoder_->encodeData(response_body, true);
+  driveToCompletion();
+}
+
+TEST_P(Http2CodecImplTest, ConnectionWindowGrowsToBandwidthDelayProduct) {
+  server_settings_.emplace(smallWindowHttp2Settings());
+  server_http2_options_.mutable_max_connection_window_size()->set_value(1024 * 1024);
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, false).ok());
+  driveToCompletion();
+  EXPECT_EQ(65535, getSendWindowSize(client_));
+
+  // The client fills the connection window within the round trip of the server's BDP PING, so
+  // the server grows the window once the PING is acknowledged.
+  EXPECT_CALL(request_decoder_, decodeData(_, false)).Times(AnyNumber());
+  Buffer::OwnedImpl body(std::string(65535, 'a'));
+  request_encoder_->encodeData(body, false);
+  driveToCompletion();
+  EXPECT_GT(getSendWindowSize(client_), 65535);
+  EXPECT_LE(getSendWindowSize(client_), 1024 * 1024);
+}
+
 TEST_P(Http2CodecImplTest, ClientUnexpectedHeaders) {
   initialize();
 
@@ -1,7 +1,11 @@
+#include <string>
+#include <vector>
+
 #include "source/common/init/manager_impl.h"
 
 #include "test/mocks/init/mocks.h"
 
+#include "absl/strings/str_cat.h"
 #include "gtest/gtest.h"
 
 using ::testing::InSequence;
@@ -66,6 +70,37 @@ TEST(InitManagerImplTest, AddAsyncTargetsWhenUninitialized) {
   expectInitialized(m);
 }
 
+TEST(InitManagerImplTest, TargetObserver) {
+  ManagerImpl m("test");
+  std::vector<std::string> events;
+  m.setTargetObserver([&events](absl::string_view target_name, Manager::TargetEvent event) {
+    events.push_back(absl::StrCat(target_name, event == Manager::TargetEvent::Ready ? " ready"
+                                                                                     : " init"));
+  });
+
+  ExpectableTargetImpl t1("t1");
+  m.add(t1);
+  ExpectableTargetImpl t2("t2");
+  m.add(t2);
+
+  ExpectableWatcherImpl w;
+  t1.expectInitialize();
+  t2.expectInitializeWillCallReady();
+  m.initialize(w);
+
+  // Targets added while initializing are initialized immediately.
+  ExpectableTargetImpl t3("t3");
+  t3.expectInitialize();
+  m.add(t3);
+  t3.ready();
+
+  w.expectReady();
+  t1.ready();
+  EXPECT_EQ(std::vector<std::string>({"target t1 init", "target t2 init", "target t2 ready",
+                                      "target t3 init", "target t3 ready", "target t1 ready"}),
+            events);
+}
+
 TEST(InitManagerImplTest, AddMixedTargetsWhenUninitialized) {
   InSequence s;
 
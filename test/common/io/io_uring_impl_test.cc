@@ -1,3 +1,5 @@
+#include <sys/socket.h>
+
 #include <functional>
 
 #include "source/common/io/io_uring_impl.h"
@@ -102,7 +104,7 @@ TEST_P(IoUringImplParamTest, InvalidParams) {
   auto file_event = dispatcher->createFileEvent(
       event_fd,
       [this, &completions_nr](uint32_t) {
-        io_uring_->forEveryCompletion([&completions_nr](Request*, int32_t res, bool) {
+        io_uring_->forEveryCompletion([&completions_nr](Request*, int32_t res, uint32_t, bool) {
           EXPECT_TRUE(res < 0);
           completions_nr++;
         });
@@ -139,7 +141,7 @@ TEST_F(IoUringImplTest, InjectCompletion) {
       event_fd,
       [this, &completions_nr](uint32_t) {
         io_uring_->forEveryCompletion(
-            [&completions_nr](Request* user_data, int32_t res, bool injected) {
+            [&completions_nr](Request* user_data, int32_t res, uint32_t, bool injected) {
               EXPECT_TRUE(injected);
               EXPECT_EQ(1, dynamic_cast<TestRequest*>(user_data)->data_);
               EXPECT_EQ(-11, res);
@@ -172,8 +174,9 @@ TEST_F(IoUringImplTest, NestInjectCompletion) {
   auto file_event = dispatcher->createFileEvent(
       event_fd,
       [this, &fd2, &completions_nr, &request2](uint32_t) {
-        io_uring_->forEveryCompletion([this, &fd2, &completions_nr,
-                                       &request2](Request* user_data, int32_t res, bool injected) {
+        io_uring_->forEveryCompletion([this, &fd2, &completions_nr, &request2](
+                                          Request* user_data, int32_t res, uint32_t,
+                                          bool injected) {
           EXPECT_TRUE(injected);
           if (completions_nr == 0) {
             EXPECT_EQ(1, dynamic_cast<TestRequest*>(user_data)->data_);
@@ -214,7 +217,7 @@ TEST_F(IoUringImplTest, RemoveInjectCompletion) {
       event_fd,
       [this, &completions_nr](uint32_t) {
         io_uring_->forEveryCompletion(
-            [&completions_nr](Request* user_data, int32_t res, bool injected) {
+            [&completions_nr](Request* user_data, int32_t res, uint32_t, bool injected) {
               EXPECT_TRUE(injected);
               EXPECT_EQ(1, dynamic_cast<TestRequest*>(user_data)->data_);
               EXPECT_EQ(-11, res);
@@ -250,7 +253,8 @@ TEST_F(IoUringImplTest, NestRemoveInjectCompletion) {
       event_fd,
       [this, &fd2, &completions_nr, &data2](uint32_t) {
         io_uring_->forEveryCompletion(
-            [this, &fd2, &completions_nr, &data2](Request* user_data, int32_t res, bool injected) {
+            [this, &fd2, &completions_nr, &data2](Request* user_data, int32_t res, uint32_t,
+                                                  bool injected) {
               EXPECT_TRUE(injected);
               if (completions_nr == 0) {
                 EXPECT_EQ(1, dynamic_cast<TestRequest*>(user_data)->data_);
@@ -302,7 +306,7 @@ TEST_F(IoUringImplTest, PrepareReadvAllDataFitsOneChunk) {
   auto file_event = dispatcher->createFileEvent(
       event_fd,
       [this, &completions_nr, d = dispatcher.get()](uint32_t) {
-        io_uring_->forEveryCompletion([&completions_nr](Request*, int32_t res, bool) {
+        io_uring_->forEveryCompletion([&completions_nr](Request*, int32_t res, uint32_t, bool) {
           completions_nr++;
           EXPECT_EQ(res, strlen("test text"));
         });
@@ -348,7 +352,8 @@ TEST_F(IoUringImplTest, PrepareReadvQueueOverflow) {
   auto file_event = dispatcher->createFileEvent(
       event_fd,
       [this, &completions_nr](uint32_t) {
-        io_uring_->forEveryCompletion([&completions_nr](Request* user_data, int32_t res, bool) {
+        io_uring_->forEveryCompletion([&completions_nr](Request* user_data, int32_t res, uint32_t,
+                                                        bool) {
           EXPECT_TRUE(user_data != nullptr);
           EXPECT_EQ(res, 2);
           completions_nr++;
@@ -401,6 +406,105 @@ TEST_F(IoUringImplTest, PrepareReadvQueueOverflow) {
   EXPECT_EQ(static_cast<char*>(iov3.iov_base)[1], 'f');
 }
 
+TEST_F(IoUringImplTest, RecvMultishotIntoProvidedBuffers) {
+  ProvidedBufferRingSharedPtr buffer_ring = io_uring_->createProvidedBufferRing(1, 4, 16);
+  if (buffer_ring == nullptr) {
+    GTEST_SKIP() << "provided buffer rings are not supported";
+  }
+  EXPECT_EQ(1, buffer_ring->group());
+  EXPECT_EQ(16, buffer_ring->bufferSize());
+
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  auto dispatcher = api_->allocateDispatcher("test_thread");
+  os_fd_t event_fd = io_uring_->registerEventfd();
+  std::vector<std::string> received;
+  bool more = true;
+  auto file_event = dispatcher->createFileEvent(
+      event_fd,
+      [this, &buffer_ring, &received, &more](uint32_t) {
+        io_uring_->forEveryCompletion(
+            [&buffer_ring, &received, &more](Request*, int32_t res, uint32_t flags, bool) {
+              more = flags & IORING_CQE_F_MORE;
+              if (res <= 0) {
+                return;
+              }
+              ASSERT_TRUE(flags & IORING_CQE_F_BUFFER);
+              const uint16_t id = flags >> IORING_CQE_BUFFER_SHIFT;
+              received.emplace_back(reinterpret_cast<char*>(buffer_ring->buffer(id)), res);
+              buffer_ring->recycle(id);
+            });
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+
+  int data = 1;
+  TestRequest request(data);
+  ASSERT_EQ(IoUringResult::Ok, io_uring_->prepareRecvMultishot(fds[0], 1, &request));
+  ASSERT_EQ(IoUringResult::Ok, io_uring_->submit());
+
+  // A single request keeps completing, each time with a buffer of the ring.
+  ASSERT_EQ(5, write(fds[1], "hello", 5));
+  waitForCondition(*dispatcher, [&received]() { return received.size() == 1; });
+  ASSERT_EQ(5, write(fds[1], "world", 5));
+  waitForCondition(*dispatcher, [&received]() { return received.size() == 2; });
+  EXPECT_EQ("hello", received[0]);
+  EXPECT_EQ("world", received[1]);
+  EXPECT_TRUE(more);
+
+  // The request ends with the remote close.
+  close(fds[1]);
+  waitForCondition(*dispatcher, [&more]() { return !more; });
+  close(fds[0]);
+}
+
+TEST_F(IoUringImplTest, SendmsgZeroCopy) {
+  if (!io_uring_->isOpSupported(IORING_OP_SENDMSG_ZC)) {
+    GTEST_SKIP() << "zero copy send is not supported";
+  }
+
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  auto dispatcher = api_->allocateDispatcher("test_thread");
+  os_fd_t event_fd = io_uring_->registerEventfd();
+  int32_t sent = 0;
+  bool notified = false;
+  auto file_event = dispatcher->createFileEvent(
+      event_fd,
+      [this, &sent, &notified](uint32_t) {
+        io_uring_->forEveryCompletion(
+            [&sent, &notified](Request*, int32_t res, uint32_t flags, bool) {
+              if (flags & IORING_CQE_F_NOTIF) {
+                notified = true;
+              } else {
+                sent = res;
+              }
+            });
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+
+  char data[] = "hello";
+  struct iovec iov {
+    data, 5
+  };
+  struct msghdr msg {};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  int request_data = 1;
+  TestRequest request(request_data);
+  ASSERT_EQ(IoUringResult::Ok, io_uring_->prepareSendmsgZeroCopy(fds[1], &msg, &request));
+  ASSERT_EQ(IoUringResult::Ok, io_uring_->submit());
+  waitForCondition(*dispatcher, [&sent, &notified]() { return sent != 0 && notified; });
+  EXPECT_EQ(5, sent);
+
+  char received[5];
+  EXPECT_EQ(5, read(fds[0], received, sizeof(received)));
+  EXPECT_EQ("hello", absl::string_view(received, sizeof(received)));
+  close(fds[0]);
+  close(fds[1]);
+}
+
 } // namespace
 } // namespace Io
 } // namespace Envoy
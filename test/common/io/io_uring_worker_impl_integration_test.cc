@@ -5,6 +5,7 @@
 #include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/io/io_uring_worker_impl.h"
 #include "source/common/network/address_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
 
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
@@ -87,10 +88,15 @@ public:
   bool is_shutdown_injected_completion_{false};
 };
 
-class IoUringWorkerTestImpl : public IoUringWorkerImpl {
+struct TestStats {
+  Stats::IsolatedStoreImpl store_;
+};
+
+class IoUringWorkerTestImpl : public TestStats, public IoUringWorkerImpl {
 public:
   IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher)
-      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, dispatcher) {}
+      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, 0, 0, *store_.rootScope(),
+                          dispatcher) {}
 
   IoUringSocket& addTestSocket(os_fd_t fd) {
     return addSocket(std::make_unique<IoUringSocketTestImpl>(fd, *this));
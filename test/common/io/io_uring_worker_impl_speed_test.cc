@@ -0,0 +1,138 @@
+// Compares receiving data through the io_uring worker, with and without provided buffers, against
+// receiving it through a dispatcher file event and readv(), which is what sockets use by default.
+
+#include <sys/socket.h>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/io/io_uring_impl.h"
+#include "source/common/io/io_uring_worker_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Io {
+namespace {
+
+constexpr uint64_t ChunkSize = 16 * 1024;
+constexpr uint64_t ChunksPerIteration = 64;
+
+class SocketPair {
+public:
+  SocketPair() {
+    RELEASE_ASSERT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds_) == 0, "");
+  }
+  ~SocketPair() {
+    ::close(fds_[1]);
+    if (!reader_closed_) {
+      ::close(fds_[0]);
+    }
+  }
+
+  os_fd_t reader() const { return fds_[0]; }
+  os_fd_t writer() const { return fds_[1]; }
+  // The io_uring worker closes the sockets it owns.
+  void readerClosed() { reader_closed_ = true; }
+
+private:
+  int fds_[2];
+  bool reader_closed_{false};
+};
+
+// Write all chunks of an iteration, running the dispatcher until the reader has received each.
+void writeAndReceive(Event::Dispatcher& dispatcher, const SocketPair& sockets,
+                     const uint64_t& received) {
+  const std::string chunk(ChunkSize, 'a');
+  uint64_t written = received;
+  for (uint64_t i = 0; i < ChunksPerIteration; ++i) {
+    uint64_t offset = 0;
+    while (offset < chunk.size()) {
+      const ssize_t rc = ::write(sockets.writer(), chunk.data() + offset, chunk.size() - offset);
+      if (rc > 0) {
+        offset += rc;
+        written += rc;
+      }
+      dispatcher.run(Event::Dispatcher::RunType::NonBlock);
+    }
+  }
+  while (received < written) {
+    dispatcher.run(Event::Dispatcher::RunType::NonBlock);
+  }
+}
+
+void BM_FileEventRead(benchmark::State& state) {
+  Api::ApiPtr api = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  SocketPair sockets;
+  Network::IoSocketHandleImpl io_handle(sockets.reader());
+  uint64_t received = 0;
+  Buffer::OwnedImpl buffer;
+  io_handle.initializeFileEvent(
+      *dispatcher,
+      [&io_handle, &buffer, &received](uint32_t) {
+        while (true) {
+          Api::IoCallUint64Result result = io_handle.read(buffer, absl::nullopt);
+          if (!result.ok() || result.return_value_ == 0) {
+            break;
+          }
+          received += result.return_value_;
+          buffer.drain(buffer.length());
+        }
+        return absl::OkStatus();
+      },
+      Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+
+  for (auto _ : state) {
+    writeAndReceive(*dispatcher, sockets, received);
+  }
+  state.SetBytesProcessed(received);
+  io_handle.resetFileEvents();
+  sockets.readerClosed();
+  io_handle.close();
+}
+BENCHMARK(BM_FileEventRead)->Unit(benchmark::kMicrosecond);
+
+// state.range(0) is the number of provided buffers, 0 reads into a buffer allocated per read.
+void BM_IoUringWorkerRead(benchmark::State& state) {
+  if (!isIoUringSupported()) {
+    state.SkipWithError("io_uring is not supported");
+    return;
+  }
+  Api::ApiPtr api = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  Stats::IsolatedStoreImpl store;
+  SocketPair sockets;
+  uint64_t received = 0;
+  {
+    IoUringWorkerImpl worker(std::make_unique<IoUringImpl>(1024, false), ChunkSize, 1000,
+                             state.range(0), 0, *store.rootScope(), *dispatcher);
+    IoUringSocket* socket = nullptr;
+    socket = &worker.addServerSocket(
+        sockets.reader(),
+        [&socket, &received](uint32_t events) {
+          if (events & Event::FileReadyType::Read) {
+            Buffer::Instance& buffer = socket->getReadParam()->buf_;
+            received += buffer.length();
+            buffer.drain(buffer.length());
+          }
+          return absl::OkStatus();
+        },
+        false);
+
+    for (auto _ : state) {
+      writeAndReceive(*dispatcher, sockets, received);
+    }
+    state.SetBytesProcessed(received);
+    state.counters["multishot_recv"] = worker.stats().recv_multishot_total_.value();
+    state.counters["completions"] = worker.stats().completions_total_.value();
+  }
+  sockets.readerClosed();
+}
+BENCHMARK(BM_IoUringWorkerRead)->Arg(0)->Arg(256)->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace Io
+} // namespace Envoy
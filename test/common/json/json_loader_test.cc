@@ -363,6 +363,52 @@ TEST_F(JsonLoaderTest, Double) {
   }
 }
 
+// Keys and strings are moved out of the parser, which reuses its buffers for the next ones.
+TEST_F(JsonLoaderTest, KeysAndStrings) {
+  ObjectSharedPtr json = *Factory::loadFromString(
+      R"EOF({"a": "first", "b": {"c": "second", "d": ["x", "y"]}, "a": "last", "e": 1})EOF");
+  EXPECT_EQ("last", *json->getString("a"));
+  ObjectSharedPtr b = *json->getObject("b");
+  EXPECT_EQ("second", *b->getString("c"));
+  EXPECT_EQ(std::vector<std::string>({"x", "y"}), *b->getStringArray("d"));
+  EXPECT_EQ(1, *json->getInteger("e"));
+}
+
+TEST_F(JsonLoaderTest, LoadWithPaths) {
+  const std::string json = R"EOF({
+    "a": {"b": {"c": 1, "d": 2}, "e": {"f": 3}, "g": "h"},
+    "i": [{"j": 4}, 5],
+    "k": {"l": [6]},
+    "m": "n"
+  })EOF";
+  {
+    ObjectSharedPtr root = *Factory::loadFromString(json, {{"a", "b"}, {"a", "g", "x"}, {"i"}});
+    EXPECT_EQ(R"EOF({"a":{"b":{"c":1,"d":2},"g":"h"},"i":[{"j":4},5]})EOF",
+              root->asJsonString());
+    // Line numbers are still those of the whole document.
+    expectError((*root->getObject("a"))->getValue("e"), absl::StatusCode::kNotFound,
+                "key 'e' missing from lines 2-2");
+  }
+  {
+    ObjectSharedPtr root = *Factory::loadFromString(json, {{"k", "l", "x"}, {"m", "x"}});
+    EXPECT_EQ(R"EOF({"k":{"l":[6]},"m":"n"})EOF", root->asJsonString());
+  }
+  {
+    ObjectSharedPtr root = *Factory::loadFromString(json, {{"x"}});
+    EXPECT_EQ("null", root->asJsonString());
+    EXPECT_TRUE(root->empty());
+  }
+  {
+    ObjectSharedPtr root = *Factory::loadFromString(json, {{"x"}, {}});
+    EXPECT_EQ(Factory::loadFromString(json).value()->asJsonString(), root->asJsonString());
+  }
+  // Parts which are dropped are still validated.
+  EXPECT_FALSE(Factory::loadFromString(R"EOF({"a": 1, "b": {"c": [1, }})EOF", {{"a"}}).ok());
+  EXPECT_EQ(R"EOF({"a":1})EOF",
+            (*Factory::loadFromString(R"EOF({"a": 1, "b": [{"a": 2}]})EOF", {{"a"}}))
+                ->asJsonString());
+}
+
 TEST_F(JsonLoaderTest, LoadArray) {
   ObjectSharedPtr json1 = *Factory::loadFromString("[1.11, 22, \"cat\"]");
   ObjectSharedPtr json2 = *Factory::loadFromString("[22, \"cat\", 1.11]");
@@ -196,6 +196,14 @@ TEST_P(FilterChainManagerImplTest, AddSingleFilterChain) {
   }
 }
 
+// Source IP levels without prefixes are looked up without tries, and match any source address.
+TEST_P(FilterChainManagerImplTest, CatchAllSourceMatchesAnySourceAddress) {
+  addSingleFilterChainHelper(filter_chain_template_);
+  EXPECT_NE(findFilterChainHelper(10000, "127.0.0.1", "", "tls", {}, "8.8.8.8", 111), nullptr);
+  EXPECT_NE(findFilterChainHelper(10000, "127.0.0.1", "", "tls", {}, "2001:db8::1", 111), nullptr);
+  EXPECT_NE(findFilterChainHelper(10000, "127.0.0.1", "", "tls", {}, "/tmp/test.sock", 0), nullptr);
+}
+
 TEST_P(FilterChainManagerImplTest, FilterChainUseFallbackIfNoFilterChainMatches) {
   // The build helper will build matchable filter chain and then build the default filter chain.
   EXPECT_CALL(filter_chain_factory_builder_, buildFilterChain(_, _))
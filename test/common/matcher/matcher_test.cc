@@ -643,5 +643,116 @@ TEST_F(MatcherTest, RecursiveMatcherCannotMatch) {
   EXPECT_EQ(recursive_result.match_state_, MatchState::UnableToMatch);
   EXPECT_EQ(recursive_result.result_, nullptr);
 }
+
+// A data input factory counting the data inputs it creates and the values they extract.
+class CountingDataInputFactory : public DataInputFactory<TestData> {
+public:
+  CountingDataInputFactory() : injection_(*this) {}
+
+  DataInputFactoryCb<TestData>
+  createDataInputFactoryCb(const Protobuf::Message&, ProtobufMessage::ValidationVisitor&) override {
+    return [this]() {
+      ++inputs_;
+      return std::make_unique<CountingInput>(gets_);
+    };
+  }
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<ProtobufWkt::UInt32Value>();
+  }
+  std::string name() const override { return "counting"; }
+
+  uint32_t inputs_{};
+  uint32_t gets_{};
+
+private:
+  struct CountingInput : public DataInput<TestData> {
+    explicit CountingInput(uint32_t& gets) : gets_(gets) {}
+    DataInputGetResult get(const TestData&) const override {
+      ++gets_;
+      return {DataInputGetResult::DataAvailability::AllDataAvailable, std::string("foo")};
+    }
+    uint32_t& gets_;
+  };
+
+  Registry::InjectFactory<DataInputFactory<TestData>> injection_;
+};
+
+TEST_F(MatcherTest, SharedDataInputs) {
+  const std::string yaml = R"EOF(
+matcher_list:
+  matchers:
+  - on_match:
+      action:
+        name: test_action
+        typed_config:
+          "@type": type.googleapis.com/google.protobuf.StringValue
+          value: first
+    predicate:
+      and_matcher:
+        predicate:
+        - single_predicate:
+            input:
+              name: counting
+              typed_config:
+                "@type": type.googleapis.com/google.protobuf.UInt32Value
+            value_match:
+              exact: foo
+        - single_predicate:
+            input:
+              name: counting
+              typed_config:
+                "@type": type.googleapis.com/google.protobuf.UInt32Value
+            value_match:
+              exact: bar
+  - on_match:
+      action:
+        name: test_action
+        typed_config:
+          "@type": type.googleapis.com/google.protobuf.StringValue
+          value: second
+    predicate:
+      or_matcher:
+        predicate:
+        - single_predicate:
+            input:
+              name: counting
+              typed_config:
+                "@type": type.googleapis.com/google.protobuf.UInt32Value
+                value: 1
+            value_match:
+              exact: bar
+        - not_matcher:
+            single_predicate:
+              input:
+                name: counting
+                typed_config:
+                  "@type": type.googleapis.com/google.protobuf.UInt32Value
+              value_match:
+                exact: bar
+  )EOF";
+
+  envoy::config::common::matcher::v3::Matcher matcher;
+  MessageUtil::loadFromYaml(yaml, matcher, ProtobufMessage::getStrictValidationVisitor());
+
+  TestUtility::validate(matcher);
+
+  CountingDataInputFactory input_factory;
+
+  // Every input is validated, but the predicates with the same input config share a data input.
+  EXPECT_CALL(validation_visitor_,
+              performDataInputValidation(_, "type.googleapis.com/google.protobuf.UInt32Value"))
+      .Times(4);
+  auto match_tree = factory_.create(matcher)();
+  EXPECT_EQ(input_factory.inputs_, 2);
+
+  // Each input is extracted once per match.
+  for (uint32_t i = 1; i <= 2; ++i) {
+    const auto result = evaluateMatch(*match_tree, TestData());
+    EXPECT_EQ(result.match_state_, MatchState::MatchComplete);
+    ASSERT_NE(result.result_, nullptr);
+    EXPECT_EQ(result.result_()->getTyped<StringAction>().string_, "second");
+    EXPECT_EQ(input_factory.gets_, 2 * i);
+  }
+}
 } // namespace Matcher
 } // namespace Envoy
@@ -1,3 +1,4 @@
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/event/dispatcher_impl.h"
 #include "source/common/memory/heap_shrinker.h"
 #include "source/common/memory/stats.h"
@@ -54,6 +55,12 @@ TEST_F(HeapShrinkerTest, ShrinkWhenTriggered) {
 
   HeapShrinker h(dispatcher_, overload_manager_, *stats_.rootScope());
 
+  {
+    Buffer::OwnedImpl buffer;
+    buffer.add(std::string(4096, 'a'));
+  }
+  EXPECT_GT(Buffer::SliceStoragePool::stats().retained_bytes_, 0);
+
   auto data = std::make_unique<char[]>(5000000);
   const uint64_t physical_mem_before_shrink =
       Stats::totalCurrentlyReserved() - Stats::totalPageHeapUnmapped();
@@ -64,6 +71,7 @@ TEST_F(HeapShrinkerTest, ShrinkWhenTriggered) {
   action_cb(Server::OverloadActionState::saturated());
   step();
   EXPECT_EQ(1, shrink_count.value());
+  EXPECT_EQ(0, Buffer::SliceStoragePool::stats().retained_bytes_);
 
   const uint64_t physical_mem_after_shrink =
       Stats::totalCurrentlyReserved() - Stats::totalPageHeapUnmapped();
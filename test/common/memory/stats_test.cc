@@ -0,0 +1,41 @@
+#include "source/common/memory/stats.h"
+
+#include "absl/strings/match.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Memory {
+namespace {
+
+TEST(StatsTest, SubsystemOfSymbol) {
+  EXPECT_EQ("Envoy::Stats",
+            Stats::subsystemOfSymbol("Envoy::Stats::ThreadLocalStoreImpl::counterFromStatName()"));
+  EXPECT_EQ("Envoy::Router", Stats::subsystemOfSymbol(
+                                 "Envoy::Router::RouteEntryImplBase::RouteEntryImplBase<>()"));
+  EXPECT_EQ("Envoy::Extensions::TransportSockets::Tls",
+            Stats::subsystemOfSymbol(
+                "Envoy::Extensions::TransportSockets::Tls::ContextImpl::ContextImpl()"));
+  EXPECT_EQ("Envoy::Extensions::Common",
+            Stats::subsystemOfSymbol("Envoy::Extensions::Common::foo()"));
+  // The parameters aren't part of the subsystem.
+  EXPECT_EQ("Envoy::Buffer",
+            Stats::subsystemOfSymbol("Envoy::Buffer::OwnedImpl::add(std::basic_string_view<>)"));
+  EXPECT_EQ("Envoy", Stats::subsystemOfSymbol("Envoy::main()"));
+  EXPECT_EQ(absl::nullopt, Stats::subsystemOfSymbol("std::vector<>::push_back()"));
+  EXPECT_EQ(absl::nullopt, Stats::subsystemOfSymbol("malloc"));
+}
+
+TEST(StatsTest, AllocatedBySubsystem) {
+  const auto allocated = Stats::allocatedBySubsystem();
+#if defined(TCMALLOC)
+  for (const auto& [subsystem, bytes] : allocated) {
+    EXPECT_TRUE(subsystem == "other" || absl::StartsWith(subsystem, "Envoy")) << subsystem;
+  }
+#else
+  EXPECT_TRUE(allocated.empty());
+#endif
+}
+
+} // namespace
+} // namespace Memory
+} // namespace Envoy
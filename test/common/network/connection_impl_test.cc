@@ -328,6 +328,14 @@ TEST_P(ConnectionImplTest, UniqueId) {
   disconnect(false);
 }
 
+// The socket of a connection using the raw buffer transport socket is handed out.
+TEST_P(ConnectionImplTest, SocketIoHandle) {
+  setUpBasicConnection();
+  ASSERT_TRUE(client_connection_->socketIoHandle().has_value());
+  EXPECT_TRUE(client_connection_->socketIoHandle()->isOpen());
+  disconnect(false);
+}
+
 TEST_P(ConnectionImplTest, SetSslConnection) {
   setUpBasicConnection();
   const Ssl::ConnectionInfoConstSharedPtr ssl_info = std::make_shared<Ssl::MockConnectionInfo>();
@@ -2603,6 +2611,16 @@ TEST_F(MockTransportConnectionImplTest, ObjectDestructOrder) {
   EXPECT_TRUE(file_ready_cb_(Event::FileReadyType::Read).ok());
 }
 
+// The socket is only handed out when the transport socket passes the payload through, which is not
+// implied by the transport socket not using TLS.
+TEST_F(MockTransportConnectionImplTest, SocketIoHandle) {
+  ASSERT_EQ(nullptr, connection_->ssl());
+  EXPECT_CALL(*transport_socket_, passesRawBytesThrough()).WillOnce(Return(false));
+  EXPECT_FALSE(connection_->socketIoHandle().has_value());
+  EXPECT_CALL(*transport_socket_, passesRawBytesThrough()).WillOnce(Return(true));
+  EXPECT_TRUE(connection_->socketIoHandle().has_value());
+}
+
 // Verify that read resumptions requested via setTransportSocketIsReadable() are scheduled once read
 // is re-enabled.
 TEST_F(MockTransportConnectionImplTest, ReadBufferReadyResumeAfterReadDisable) {
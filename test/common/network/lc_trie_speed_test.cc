@@ -50,6 +50,36 @@ struct CidrInputs {
       tag_data_minimal_;
 };
 
+// A large IP reputation list: 2M IPv4 prefixes, mostly /24 and /32, spread over 16 tags.
+struct LargeCidrInputs {
+  static constexpr size_t NumPrefixes = 2 * 1024 * 1024;
+
+  LargeCidrInputs() {
+    std::vector<std::vector<Envoy::Network::Address::CidrRange>> ranges(16);
+    uint32_t state = 1;
+    for (size_t i = 0; i < NumPrefixes; i++) {
+      // A fixed linear congruential generator, so that every run uses the same prefixes.
+      state = state * 1664525 + 1013904223;
+      const uint32_t length = (state & 0x3) == 0 ? 32 : 24;
+      ranges[i % ranges.size()].push_back(*Envoy::Network::Address::CidrRange::create(
+          fmt::format("{}.{}.{}.{}/{}", state >> 24, (state >> 16) & 0xff, (state >> 8) & 0xff,
+                      state & 0xff, length)));
+    }
+    for (size_t i = 0; i < ranges.size(); i++) {
+      tag_data_.emplace_back(fmt::format("tag_{}", i), std::move(ranges[i]));
+    }
+    for (uint32_t i = 0; i < 1024; i++) {
+      state = state * 1664525 + 1013904223;
+      addresses_.push_back(Envoy::Network::Utility::parseInternetAddressNoThrow(
+          fmt::format("{}.{}.{}.{}", state >> 24, (state >> 16) & 0xff, (state >> 8) & 0xff,
+                      state & 0xff)));
+    }
+  }
+
+  std::vector<std::pair<std::string, std::vector<Envoy::Network::Address::CidrRange>>> tag_data_;
+  std::vector<Envoy::Network::Address::InstanceConstSharedPtr> addresses_;
+};
+
 } // namespace
 
 namespace Envoy {
@@ -153,4 +183,37 @@ static void lcTrieLookupMinimal(benchmark::State& state) {
 
 BENCHMARK(lcTrieLookupMinimal);
 
+static void lcTrieConstructLarge(benchmark::State& state) {
+  LargeCidrInputs inputs;
+
+  std::unique_ptr<Envoy::Network::LcTrie::LcTrie<std::string>> trie;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    trie = std::make_unique<Envoy::Network::LcTrie::LcTrie<std::string>>(inputs.tag_data_);
+  }
+  benchmark::DoNotOptimize(trie);
+}
+
+BENCHMARK(lcTrieConstructLarge)->Unit(benchmark::kMillisecond)->Iterations(1);
+
+// The argument is the root branching factor.
+static void lcTrieLookupLarge(benchmark::State& state) {
+  LargeCidrInputs inputs;
+  std::unique_ptr<Envoy::Network::LcTrie::LcTrie<std::string>> lc_trie =
+      std::make_unique<Envoy::Network::LcTrie::LcTrie<std::string>>(inputs.tag_data_, false, 0.5,
+                                                                   state.range(0));
+
+  size_t i = 0;
+  size_t output_tags = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    i++;
+    i %= inputs.addresses_.size();
+    output_tags += lc_trie->getData(inputs.addresses_[i]).size();
+  }
+  benchmark::DoNotOptimize(output_tags);
+}
+
+BENCHMARK(lcTrieLookupLarge)->Arg(0)->Arg(16);
+
 } // namespace Envoy
@@ -326,28 +326,19 @@ TEST_F(LcTrieTest, ExclusiveNestedPrefixesWithCatchAll) {
   expectIPAndTags(test_case);
 }
 
-// Ensure the trie will reject inputs that would cause it to exceed the maximum 2^20 nodes
-// when using the default fill factor.
-TEST_F(LcTrieTest, MaximumEntriesExceptionDefault) {
+// The previous limit of 2^19 CIDR ranges with the default fill factor is now accepted.
+TEST_F(LcTrieTest, ManyEntriesDefault) {
   static const size_t num_prefixes = 1 << 19;
   Address::CidrRange address = *Address::CidrRange::create("10.0.0.1/8");
-  std::vector<Address::CidrRange> prefixes;
-  prefixes.reserve(num_prefixes);
-  for (size_t i = 0; i < num_prefixes; i++) {
-    prefixes.push_back(address);
-  }
-  EXPECT_EQ(num_prefixes, prefixes.size());
+  std::vector<Address::CidrRange> prefixes(num_prefixes, address);
 
-  std::pair<std::string, std::vector<Address::CidrRange>> ip_tag =
-      std::make_pair("bad_tag", prefixes);
-  std::vector<std::pair<std::string, std::vector<Address::CidrRange>>> ip_tags_input{ip_tag};
-  EXPECT_THROW_WITH_MESSAGE(new LcTrie<std::string>(ip_tags_input), EnvoyException,
-                            "The input vector has '524288' CIDR range entries. "
-                            "LC-Trie can only support '262144' CIDR ranges with "
-                            "the specified fill factor.");
+  std::vector<std::pair<std::string, std::vector<Address::CidrRange>>> ip_tags_input{
+      std::make_pair("tag", std::move(prefixes))};
+  trie_ = std::make_unique<LcTrie<std::string>>(ip_tags_input);
+  expectIPAndTags({{"10.1.2.3", {"tag"}}, {"11.0.0.1", {}}});
 }
 
-// Ensure the trie will reject inputs that would cause it to exceed the maximum 2^20 nodes
+// Ensure the trie will reject inputs that would cause it to exceed the maximum 2^24 nodes
 // when using a fill factor override.
 TEST_F(LcTrieTest, MaximumEntriesExceptionOverride) {
   static const size_t num_prefixes = 8192;
@@ -365,12 +356,24 @@ TEST_F(LcTrieTest, MaximumEntriesExceptionOverride) {
   std::pair<std::string, std::vector<Address::CidrRange>> ip_tag =
       std::make_pair("bad_tag", prefixes);
   std::vector<std::pair<std::string, std::vector<Address::CidrRange>>> ip_tags_input{ip_tag};
-  EXPECT_THROW_WITH_MESSAGE(new LcTrie<std::string>(ip_tags_input, false, 0.01), EnvoyException,
+  EXPECT_THROW_WITH_MESSAGE(new LcTrie<std::string>(ip_tags_input, false, 0.0005), EnvoyException,
                             "The input vector has '8192' CIDR range entries. "
-                            "LC-Trie can only support '5242' CIDR ranges with "
+                            "LC-Trie can only support '4194' CIDR ranges with "
                             "the specified fill factor.");
 }
 
+// Leaves with the same data share it, whatever the order the data was added in.
+TEST_F(LcTrieTest, SharedData) {
+  setup({{"10.0.0.0/24", "10.0.2.0/24"}, {"10.0.2.0/24", "10.0.0.0/24", "10.0.4.0/24"}});
+  const auto& first = trie_->getData(Utility::parseInternetAddressNoThrow("10.0.0.1"));
+  const auto& second = trie_->getData(Utility::parseInternetAddressNoThrow("10.0.2.1"));
+  EXPECT_EQ(&first, &second);
+  EXPECT_EQ(first.size(), 2);
+  EXPECT_EQ(trie_->getData(Utility::parseInternetAddressNoThrow("10.0.4.1")),
+            std::vector<std::string>{"tag_1"});
+  EXPECT_TRUE(trie_->getData(Utility::parseInternetAddressNoThrow("10.0.1.1")).empty());
+}
+
 } // namespace LcTrie
 } // namespace Network
 } // namespace Envoy
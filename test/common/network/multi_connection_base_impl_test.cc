@@ -1113,6 +1113,23 @@ TEST_F(MultiConnectionBaseImplTest, UnixSocketPeerCredentials) {
   EXPECT_FALSE(impl_->unixSocketPeerCredentials().has_value());
 }
 
+TEST_F(MultiConnectionBaseImplTest, SocketIoHandle) {
+  setupMultiConnectionImpl(2);
+
+  // There is no single socket to hand out while the attempts are racing.
+  startConnect();
+  EXPECT_FALSE(impl_->socketIoHandle().has_value());
+
+  EXPECT_CALL(*failover_timer_, disableTimer());
+  EXPECT_CALL(*createdConnections()[0], removeConnectionCallbacks(_));
+  connectionCallbacks()[0]->onEvent(ConnectionEvent::Connected);
+
+  testing::NiceMock<MockIoHandle> io_handle;
+  EXPECT_CALL(*createdConnections()[0], socketIoHandle())
+      .WillOnce(Return(OptRef<IoHandle>(io_handle)));
+  EXPECT_EQ(&io_handle, impl_->socketIoHandle().ptr());
+}
+
 TEST_F(MultiConnectionBaseImplTest, Ssl) {
   setupMultiConnectionImpl(2);
 
@@ -44,6 +44,7 @@ public:
   void onDataWorker(Network::UdpRecvData&& data) override;
   void post(Network::UdpRecvData&& data) override;
   void onDatagramsDropped(uint32_t dropped) override;
+  void onDatagramsRead(uint32_t) override {}
   uint32_t workerIndex() const override;
   Network::UdpPacketWriter& udpPacketWriter() override;
   size_t numPacketsExpectedPerEventLoop() const override;
@@ -728,7 +728,11 @@ TEST_P(UdpListenerImplTest, UdpGroBasic) {
 
         const std::string data_str = data.buffer_->toString();
         EXPECT_EQ(data_str, client_data[num_packets_received_by_listener_ - 1]);
+        // Each packet refers to its segment of the read as a single slice.
+        EXPECT_EQ(data.buffer_->getRawSlices().size(), 1);
       }));
+  // The packets are reported as one read.
+  EXPECT_CALL(listener_callbacks_, onDatagramsRead(4u));
 
   EXPECT_CALL(listener_callbacks_, onWriteReady(_)).WillOnce(Invoke([&](const Socket& socket) {
     EXPECT_EQ(&socket.ioHandle(), &server_socket_->ioHandle());
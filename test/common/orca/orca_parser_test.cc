@@ -156,6 +156,16 @@ TEST(OrcaParserUtilTest, NativeHttpEncodedHeaderContainsEmptyUtilizationMetricKe
       StatusHelpers::HasStatus(absl::InvalidArgumentError("utilization metric key is empty.")));
 }
 
+TEST(OrcaParserUtilTest, NativeHttpEncodedHeaderContainsDuplicateUtilizationMetric) {
+  Http::TestRequestHeaderMapImpl headers{
+      {std::string(kEndpointLoadMetricsHeader),
+       absl::StrCat(kHeaderFormatPrefixText,
+                    "utilization.total=0.5,named_metrics.total=0.2,utilization.total=0.6")}};
+  EXPECT_THAT(parseOrcaLoadReportHeaders(headers),
+              StatusHelpers::HasStatus(absl::AlreadyExistsError(absl::StrCat(
+                  kEndpointLoadMetricsHeader, " contains duplicate metric: utilization.total"))));
+}
+
 TEST(OrcaParserUtilTest, NativeHttpEncodedHeaderContainsDuplicateNamedMetric) {
   Http::TestRequestHeaderMapImpl headers{
       {std::string(kEndpointLoadMetricsHeader),
@@ -65,4 +65,28 @@ BENCHMARK_CAPTURE(bmHashByDeterministicHash, map, testProtoWithMaps());
 BENCHMARK_CAPTURE(bmHashByDeterministicHash, recursion, testProtoWithRecursion());
 BENCHMARK_CAPTURE(bmHashByDeterministicHash, repeatedFields, testProtoWithRepeatedFields());
 
+// Compares keeping a copy of a message with keeping it packed in an Any, as done for the
+// configuration kept for config dumps. The bytes counter reports the memory used by each form.
+static void bmRetainByCopy(benchmark::State& state, std::unique_ptr<Protobuf::Message> msg) {
+  std::unique_ptr<Protobuf::Message> copy(msg->New());
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    copy->CopyFrom(*msg);
+  }
+  state.counters["bytes"] = copy->SpaceUsedLong();
+}
+BENCHMARK_CAPTURE(bmRetainByCopy, map, testProtoWithMaps());
+BENCHMARK_CAPTURE(bmRetainByCopy, repeatedFields, testProtoWithRepeatedFields());
+
+static void bmRetainByPack(benchmark::State& state, std::unique_ptr<Protobuf::Message> msg) {
+  ProtobufWkt::Any any;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    any.PackFrom(*msg);
+  }
+  state.counters["bytes"] = any.SpaceUsedLong();
+}
+BENCHMARK_CAPTURE(bmRetainByPack, map, testProtoWithMaps());
+BENCHMARK_CAPTURE(bmRetainByPack, repeatedFields, testProtoWithRepeatedFields());
+
 } // namespace Envoy
@@ -265,6 +265,21 @@ TEST_P(EnvoyQuicDispatcherTest, CreateNewConnectionUponCHLO) {
   processValidChloPacketAndInitializeFilters(false);
 }
 
+TEST_P(EnvoyQuicDispatcherTest, MaxQpackDynamicTableCapacity) {
+  Network::MockUdpListenerConfig udp_listener_config;
+  udp_listener_config.config_.mutable_quic_options()
+      ->mutable_max_qpack_dynamic_table_capacity()
+      ->set_value(1024);
+  ON_CALL(listener_config_, udpListenerConfig())
+      .WillByDefault(Return(Network::UdpListenerConfigOptRef(udp_listener_config)));
+  PreparedFilterChainMocks mocks(*this);
+  processValidChloPacketAndCheckStatus(false);
+  const auto* session = static_cast<const EnvoyQuicServerSession*>(
+      quic::test::QuicDispatcherPeer::FindSession(&envoy_quic_dispatcher_, connection_id_));
+  EXPECT_EQ(1024u, session->qpack_maximum_dynamic_table_capacity());
+  envoy_quic_dispatcher_.Shutdown();
+}
+
 TEST_P(EnvoyQuicDispatcherTest, CloseConnectionDuringNetworkFilterInstallation) {
   Network::MockFilterChainManager filter_chain_manager;
   std::shared_ptr<Network::MockReadFilter> read_filter(new Network::MockReadFilter());
@@ -10,6 +10,7 @@
 #include "source/common/quic/envoy_quic_packet_writer.h"
 
 #include "test/mocks/api/mocks.h"
+#include "test/mocks/network/mocks.h"
 #include "test/test_common/threadsafe_singleton_injector.h"
 
 #include "gmock/gmock.h"
@@ -109,6 +110,24 @@ TEST_F(EnvoyQuicWriterTest, SendBlocked) {
   EXPECT_FALSE(envoy_quic_writer_.IsWriteBlocked());
 }
 
+TEST_F(EnvoyQuicWriterTest, SendWithReleaseTime) {
+  auto* udp_writer = new testing::StrictMock<Network::MockUdpPacketWriter>();
+  EnvoyQuicPacketWriter writer{Network::UdpPacketWriterPtr(udp_writer)};
+  std::string str("Hello World!");
+  quic::QuicPacketWriterParams params;
+  params.release_time_delay = quic::QuicTime::Delta::FromMicroseconds(250);
+
+  EXPECT_CALL(*udp_writer, supportsReleaseTime()).WillRepeatedly(Return(true));
+  EXPECT_TRUE(writer.SupportsReleaseTime());
+  EXPECT_CALL(*udp_writer, writePacketWithReleaseTime(_, _, _, std::chrono::microseconds(250)))
+      .WillOnce(Return(
+          testing::ByMove(Api::IoCallUint64Result(str.length(), Api::IoError::none()))));
+  quic::WriteResult result =
+      writer.WritePacket(str.data(), str.length(), self_address_, peer_address_, nullptr, params);
+  EXPECT_EQ(quic::WRITE_STATUS_OK, result.status);
+  EXPECT_EQ(str.length(), result.bytes_written);
+}
+
 TEST_F(EnvoyQuicWriterTest, SendFailure) {
   std::string str("Hello World!");
   quic::QuicPacketWriterParams params;
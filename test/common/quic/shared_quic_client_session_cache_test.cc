@@ -0,0 +1,50 @@
+#include <ctime>
+
+#include "source/common/quic/shared_quic_client_session_cache.h"
+
+#include "gtest/gtest.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Quic {
+namespace {
+
+class SharedQuicClientSessionCacheTest : public testing::Test {
+protected:
+  bssl::UniquePtr<SSL_SESSION> newSession() {
+    return bssl::UniquePtr<SSL_SESSION>(SSL_SESSION_new(ssl_ctx_.get()));
+  }
+
+  quic::QuicWallTime now() const {
+    return quic::QuicWallTime::FromUNIXSeconds(static_cast<uint64_t>(time(nullptr)));
+  }
+
+  bssl::UniquePtr<SSL_CTX> ssl_ctx_{SSL_CTX_new(TLS_method())};
+  const quic::QuicServerId server_id_{"example.com", 443};
+  const quic::TransportParameters params_;
+};
+
+TEST_F(SharedQuicClientSessionCacheTest, SharedCachesHaveTheSameEntries) {
+  SharedQuicClientSessionCache cache;
+  std::unique_ptr<SharedQuicClientSessionCache> shared = cache.share();
+
+  cache.Insert(server_id_, newSession(), params_, nullptr);
+  EXPECT_NE(nullptr, shared->Lookup(server_id_, now(), ssl_ctx_.get()));
+
+  shared->Insert(server_id_, newSession(), params_, nullptr);
+  shared->Clear();
+  EXPECT_EQ(nullptr, cache.Lookup(server_id_, now(), ssl_ctx_.get()));
+}
+
+TEST_F(SharedQuicClientSessionCacheTest, SeparateCaches) {
+  SharedQuicClientSessionCache cache;
+  SharedQuicClientSessionCache other;
+
+  cache.Insert(server_id_, newSession(), params_, nullptr);
+  EXPECT_EQ(nullptr, other.Lookup(server_id_, now(), ssl_ctx_.get()));
+  EXPECT_NE(nullptr, cache.Lookup(server_id_, now(), ssl_ctx_.get()));
+}
+
+} // namespace
+} // namespace Quic
+} // namespace Envoy
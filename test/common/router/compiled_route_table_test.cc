@@ -0,0 +1,98 @@
+#include <vector>
+
+#include "source/common/router/compiled_route_table.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using PathMatch = CompiledRouteTable::PathMatch;
+
+std::vector<uint32_t> candidates(const CompiledRouteTable& table, absl::string_view path) {
+  std::vector<uint32_t> indices;
+  table.forEachCandidate(path, [&indices](uint32_t index) {
+    indices.push_back(index);
+    return false;
+  });
+  return indices;
+}
+
+TEST(CompiledRouteTableTest, ExactAndPrefix) {
+  const CompiledRouteTable table({{PathMatchType::Exact, "/foo", true},
+                                  {PathMatchType::Prefix, "/foo/", true},
+                                  {PathMatchType::Exact, "/foo/bar", true},
+                                  {PathMatchType::PathSeparatedPrefix, "/foo", true},
+                                  {PathMatchType::Prefix, "/", true},
+                                  {PathMatchType::Exact, "/foo", true}},
+                                 true, false);
+  EXPECT_EQ(std::vector<uint32_t>({0, 3, 4, 5}), candidates(table, "/foo"));
+  EXPECT_EQ(std::vector<uint32_t>({1, 2, 3, 4}), candidates(table, "/foo/bar"));
+  EXPECT_EQ(std::vector<uint32_t>({1, 3, 4}), candidates(table, "/foo/baz"));
+  EXPECT_EQ(std::vector<uint32_t>({4}), candidates(table, "/bar"));
+  EXPECT_EQ(std::vector<uint32_t>(), candidates(table, "bar"));
+}
+
+TEST(CompiledRouteTableTest, QueryAndFragmentAreIgnored) {
+  const CompiledRouteTable table(
+      {{PathMatchType::Exact, "/foo", true}, {PathMatchType::Prefix, "/foo/", true}}, true,
+      false);
+  EXPECT_EQ(std::vector<uint32_t>({0}), candidates(table, "/foo?bar=/foo/"));
+  EXPECT_EQ(std::vector<uint32_t>({0}), candidates(table, "/foo#/foo/"));
+  EXPECT_EQ(std::vector<uint32_t>(), candidates(table, "/foo;/foo/"));
+}
+
+TEST(CompiledRouteTableTest, PathParameters) {
+  const std::vector<PathMatch> routes{{PathMatchType::Exact, "/foo", true}};
+  EXPECT_EQ(std::vector<uint32_t>(),
+            candidates(CompiledRouteTable(routes, true, false), "/foo;x"));
+  EXPECT_EQ(std::vector<uint32_t>({0}),
+            candidates(CompiledRouteTable(routes, true, true), "/foo;x"));
+}
+
+// Routes that can't be indexed are always candidates, in route order.
+TEST(CompiledRouteTableTest, OtherRoutes) {
+  const CompiledRouteTable table({{PathMatchType::Exact, "/FOO", false},
+                                  {PathMatchType::Prefix, "/foo", true},
+                                  {PathMatchType::Template, "/foo/{bar}", true},
+                                  {PathMatchType::None, "", true},
+                                  {PathMatchType::Prefix, "/Bar", false}},
+                                 true, false);
+  EXPECT_EQ(std::vector<uint32_t>({0, 1, 2, 3, 4}), candidates(table, "/foo"));
+  EXPECT_EQ(std::vector<uint32_t>({0, 2, 3, 4}), candidates(table, "/bar"));
+}
+
+TEST(CompiledRouteTableTest, Regex) {
+  const std::vector<PathMatch> routes{{PathMatchType::Regex, "/foo/[0-9]+", true},
+                                      {PathMatchType::Prefix, "/foo", true},
+                                      {PathMatchType::Regex, "/foo/.*", true},
+                                      {PathMatchType::Regex, "/bar", true}};
+  const CompiledRouteTable table(routes, true, false);
+  EXPECT_EQ(std::vector<uint32_t>({0, 1, 2}), candidates(table, "/foo/123"));
+  EXPECT_EQ(std::vector<uint32_t>({1, 2}), candidates(table, "/foo/abc"));
+  // Regexes match the whole path.
+  EXPECT_EQ(std::vector<uint32_t>(), candidates(table, "/bar/baz"));
+  EXPECT_EQ(std::vector<uint32_t>({3}), candidates(table, "/bar?baz"));
+
+  // Without a regex set all regex routes are candidates.
+  const CompiledRouteTable no_set_table(routes, false, false);
+  EXPECT_EQ(std::vector<uint32_t>({0, 2, 3}), candidates(no_set_table, "/bar/baz"));
+}
+
+TEST(CompiledRouteTableTest, StopsWhenCallbackReturnsTrue) {
+  const CompiledRouteTable table({{PathMatchType::Prefix, "/", true},
+                                  {PathMatchType::Template, "/{foo}", true},
+                                  {PathMatchType::Prefix, "/foo", true}},
+                                 true, false);
+  std::vector<uint32_t> indices;
+  table.forEachCandidate("/foo", [&indices](uint32_t index) {
+    indices.push_back(index);
+    return index == 1;
+  });
+  EXPECT_EQ(std::vector<uint32_t>({0, 1}), indices);
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -6,6 +6,7 @@
 
 #include "test/mocks/server/instance.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "benchmark/benchmark.h"
@@ -59,7 +60,7 @@ static RouteConfiguration genRouteConfig(benchmark::State& state,
       break;
     }
     case RouteMatch::PathSpecifierCase::kPath: {
-      match->set_prefix(absl::StrCat("/shelves/shelf_", i, "/route_", i));
+      match->set_path(absl::StrCat("/shelves/shelf_", i, "/route_", i));
       break;
     }
     case RouteMatch::PathSpecifierCase::kSafeRegex: {
@@ -76,6 +77,40 @@ static RouteConfiguration genRouteConfig(benchmark::State& state,
   return route_config;
 }
 
+/**
+ * Generates a route config with `n` routes that cycle through prefix, exact path and regex
+ * matchers, in the form of:
+ * - /shelves/shelf_0/...
+ * - /shelves/shelf_1/route_1
+ * - /shelves/{shelf_id}/route_2
+ * - etc.
+ */
+static RouteConfiguration genMixedRouteConfig(benchmark::State& state) {
+  RouteConfiguration route_config;
+  VirtualHost* v_host = route_config.add_virtual_hosts();
+  v_host->set_name("default");
+  v_host->add_domains("*");
+
+  for (int i = 0; i < state.range(0); ++i) {
+    Route* route = v_host->add_routes();
+    route->mutable_direct_response()->set_status(200);
+    RouteMatch* match = route->mutable_match();
+    switch (i % 3) {
+    case 0:
+      match->set_prefix(absl::StrCat("/shelves/shelf_", i, "/"));
+      break;
+    case 1:
+      match->set_path(absl::StrCat("/shelves/shelf_", i, "/route_", i));
+      break;
+    default:
+      match->mutable_safe_regex()->set_regex(absl::StrCat("^/shelves/[^\\\\/]+/route_", i, "$"));
+      break;
+    }
+  }
+
+  return route_config;
+}
+
 /**
  * Generates a route config using matcher tree semantics with n entries.
  */
@@ -256,6 +291,68 @@ static void bmRouteTableSizeWithRegexMatch(benchmark::State& state) {
   bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kSafeRegex);
 }
 
+/**
+ * Benchmark a route table that mixes prefix, exact path and regex matchers, see
+ * genMixedRouteConfig(). The second argument selects whether the routes are indexed by path, see
+ * CompiledRouteTable, or matched one after another.
+ */
+static void bmRouteTableSizeWithMixedMatch(benchmark::State& state) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.router_compiled_route_table",
+                               state.range(1) != 0 ? "true" : "false"}});
+
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+
+  std::shared_ptr<ConfigImpl> config =
+      *ConfigImpl::create(genMixedRouteConfig(state), factory_context,
+                          ProtobufMessage::getNullValidationVisitor(), true);
+
+  const Http::TestRequestHeaderMapImpl headers = genRequestHeaders(state.range(0) - 1);
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(config->route(headers, stream_info, 0));
+  }
+}
+
+/**
+ * Benchmark the time to load a route config with mixed matchers, see genMixedRouteConfig(), split
+ * into 10 virtual hosts. With the second argument set, each load is an update of the previously
+ * loaded config in which the routes of a single virtual host changed.
+ */
+static void bmRouteConfigLoad(benchmark::State& state) {
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+
+  RouteConfiguration route_config;
+  const RouteConfiguration mixed_route_config = genMixedRouteConfig(state);
+  for (int i = 0; i < 10; ++i) {
+    VirtualHost* v_host = route_config.add_virtual_hosts();
+    v_host->set_name(absl::StrCat("vhost_", i));
+    v_host->add_domains(absl::StrCat("vhost_", i, ".com"));
+    for (int j = i; j < mixed_route_config.virtual_hosts(0).routes_size(); j += 10) {
+      *v_host->add_routes() = mixed_route_config.virtual_hosts(0).routes(j);
+    }
+  }
+
+  const bool update = state.range(1) != 0;
+  std::shared_ptr<ConfigImpl> config;
+  uint32_t version = 0;
+  for (auto _ : state) { // NOLINT
+    if (update) {
+      state.PauseTiming();
+      Route* route = route_config.mutable_virtual_hosts(0)->mutable_routes(0);
+      route->mutable_direct_response()->set_status(200 + version++ % 100);
+      state.ResumeTiming();
+    }
+    config = *ConfigImpl::create(route_config, factory_context,
+                                 ProtobufMessage::getNullValidationVisitor(), false,
+                                 update ? config.get() : nullptr);
+  }
+}
+
 /**
  * Benchmark matcher tree route matching performance with exact path matchers in the form of:
  * - /shelves/shelf_1/route_1
@@ -314,7 +411,14 @@ static void bmRouteTableSizeWithPrefixMatcherTree(benchmark::State& state) {
 BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
-
+BENCHMARK(bmRouteTableSizeWithMixedMatch)
+    ->ArgsProduct({{16, 1000, 10000}, {0, 1}})
+    ->ArgNames({"routes", "compiled"});
+
+BENCHMARK(bmRouteConfigLoad)
+    ->ArgsProduct({{100, 1000, 10000}, {0, 1}})
+    ->ArgNames({"routes", "update"})
+    ->Unit(benchmark::kMillisecond);
 BENCHMARK(bmRouteTableSizeWithExactMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithPrefixMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 
@@ -64,7 +64,7 @@ public:
                  Server::Configuration::ServerFactoryContext& factory_context,
                  bool validate_clusters_default, absl::Status& creation_status)
       : ConfigImpl(config, factory_context, ProtobufMessage::getNullValidationVisitor(),
-                   validate_clusters_default, creation_status),
+                   validate_clusters_default, nullptr, creation_status),
         config_(config) {}
 
   void setupRouteConfig(const Http::RequestHeaderMap& headers, uint64_t random_value) const {
@@ -1197,6 +1197,116 @@ virtual_hosts:
             config.route(genHeaders("example.com", "/", "GET"), 0)->routeEntry()->clusterName());
 }
 
+// Unchanged virtual hosts are shared with the previous version of the route configuration.
+TEST_F(RouteMatcherTest, ReuseUnchangedVirtualHosts) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: foo
+    domains: ["foo.com"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: "foo" }
+  - name: bar
+    domains: ["bar.com"]
+    routes:
+      - match: { prefix: "/" }
+        route: { cluster: "bar" }
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters({"foo", "bar", "baz"}, {});
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  const auto proto_config = parseRouteConfigurationFromYaml(yaml);
+  auto previous = *ConfigImpl::create(proto_config, factory_context_,
+                                      ProtobufMessage::getNullValidationVisitor(), false);
+  const Http::TestRequestHeaderMapImpl foo_headers = genHeaders("foo.com", "/", "GET");
+  const Http::TestRequestHeaderMapImpl bar_headers = genHeaders("bar.com", "/", "GET");
+
+  auto changed_proto_config = proto_config;
+  changed_proto_config.mutable_virtual_hosts(1)->mutable_routes(0)->mutable_route()->set_cluster(
+      "baz");
+  auto config = *ConfigImpl::create(changed_proto_config, factory_context_,
+                                    ProtobufMessage::getNullValidationVisitor(), false,
+                                    previous.get());
+  EXPECT_EQ(&previous->route(foo_headers, stream_info, 0)->virtualHost(),
+            &config->route(foo_headers, stream_info, 0)->virtualHost());
+  EXPECT_NE(&previous->route(bar_headers, stream_info, 0)->virtualHost(),
+            &config->route(bar_headers, stream_info, 0)->virtualHost());
+  EXPECT_EQ("baz", config->route(bar_headers, stream_info, 0)->routeEntry()->clusterName());
+
+  // Virtual hosts refer to the global route config, so they aren't reused if it changed.
+  changed_proto_config.set_max_direct_response_body_size_bytes(1);
+  config = *ConfigImpl::create(changed_proto_config, factory_context_,
+                               ProtobufMessage::getNullValidationVisitor(), false, previous.get());
+  EXPECT_NE(&previous->route(foo_headers, stream_info, 0)->virtualHost(),
+            &config->route(foo_headers, stream_info, 0)->virtualHost());
+
+  // Reused virtual hosts would skip cluster validation.
+  config = *ConfigImpl::create(proto_config, factory_context_,
+                               ProtobufMessage::getNullValidationVisitor(), true, previous.get());
+  EXPECT_NE(&previous->route(foo_headers, stream_info, 0)->virtualHost(),
+            &config->route(foo_headers, stream_info, 0)->virtualHost());
+
+  mergeValues({{"envoy.reloadable_features.router_reuse_unchanged_virtual_hosts", "false"}});
+  config = *ConfigImpl::create(proto_config, factory_context_,
+                               ProtobufMessage::getNullValidationVisitor(), false, previous.get());
+  EXPECT_NE(&previous->route(foo_headers, stream_info, 0)->virtualHost(),
+            &config->route(foo_headers, stream_info, 0)->virtualHost());
+}
+
+// Routes of different route configurations share equal policies and header parsers.
+TEST_F(RouteMatcherTest, InternRoutePolicies) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: foo
+    domains: ["*"]
+    routes:
+      - match: { prefix: "/" }
+        route:
+          cluster: foo
+          retry_policy: { retry_on: "5xx", num_retries: 3 }
+          hash_policy:
+            - header: { header_name: "x-foo" }
+          metadata_match:
+            filter_metadata:
+              envoy.lb: { version: "1" }
+        request_headers_to_add:
+          - header: { key: x-foo, value: foo }
+        response_headers_to_remove: ["x-bar"]
+  )EOF";
+
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  const auto proto_config = parseRouteConfigurationFromYaml(yaml);
+  auto first = *ConfigImpl::create(proto_config, factory_context_,
+                                   ProtobufMessage::getNullValidationVisitor(), false);
+  auto second = *ConfigImpl::create(proto_config, factory_context_,
+                                    ProtobufMessage::getNullValidationVisitor(), false);
+  const auto headers = genHeaders("foo.com", "/", "GET");
+  const RouteEntry* first_entry = first->route(headers, stream_info, 0)->routeEntry();
+  const RouteEntry* second_entry = second->route(headers, stream_info, 0)->routeEntry();
+  ASSERT_NE(first_entry, second_entry);
+  EXPECT_EQ(&first_entry->retryPolicy(), &second_entry->retryPolicy());
+  EXPECT_EQ(first_entry->hashPolicy(), second_entry->hashPolicy());
+  EXPECT_EQ(first_entry->metadataMatchCriteria(), second_entry->metadataMatchCriteria());
+
+  auto changed_proto_config = proto_config;
+  changed_proto_config.mutable_virtual_hosts(0)
+      ->mutable_routes(0)
+      ->mutable_route()
+      ->mutable_retry_policy()
+      ->mutable_num_retries()
+      ->set_value(2);
+  auto changed = *ConfigImpl::create(changed_proto_config, factory_context_,
+                                     ProtobufMessage::getNullValidationVisitor(), false);
+  const RouteEntry* changed_entry = changed->route(headers, stream_info, 0)->routeEntry();
+  EXPECT_NE(&first_entry->retryPolicy(), &changed_entry->retryPolicy());
+  EXPECT_EQ(2U, changed_entry->retryPolicy().numRetries());
+  EXPECT_EQ(first_entry->hashPolicy(), changed_entry->hashPolicy());
+
+  // The shared objects outlive the config they were created for.
+  first.reset();
+  EXPECT_EQ(3U, second->route(headers, stream_info, 0)->routeEntry()->retryPolicy().numRetries());
+}
+
 TEST_F(RouteMatcherTest, TestRoutesWithInvalidRegex) {
   std::string invalid_route = R"EOF(
 virtual_hosts:
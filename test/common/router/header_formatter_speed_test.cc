@@ -9,7 +9,7 @@
 namespace Envoy {
 namespace Router {
 
-static void bmEvaluateHeaders(benchmark::State& state) {
+static void evaluateHeaders(benchmark::State& state, absl::string_view value) {
   auto request_header = Http::RequestHeaderMapImpl::create();
   request_header->addCopy(Http::LowerCaseString("bar"), "a");
   request_header->addCopy(Http::LowerCaseString("foo"), 1);
@@ -31,9 +31,7 @@ static void bmEvaluateHeaders(benchmark::State& state) {
       header_value_option->set_append_action(HeaderValueOption::OVERWRITE_IF_EXISTS_OR_ADD);
     }
     mutable_header->set_key(fmt::format("test{}", i));
-    // The value of the header to add is a static string. HeaderParser::configure will allocate a
-    // simple formatter which does no real formatting and returns the same string.
-    mutable_header->set_value("TEST");
+    mutable_header->set_value(std::string(value));
   }
 
   // Instantiate HeaderParser
@@ -44,7 +42,15 @@ static void bmEvaluateHeaders(benchmark::State& state) {
   }
 }
 
+// The value of the headers to add is a static string, which HeaderParser uses without formatting.
+static void bmEvaluateHeaders(benchmark::State& state) { evaluateHeaders(state, "TEST"); }
 BENCHMARK(bmEvaluateHeaders)->DenseRange(2, 20, 2);
 
+// The value of the headers to add is formatted from a request header.
+static void bmEvaluateFormattedHeaders(benchmark::State& state) {
+  evaluateHeaders(state, "%REQ(bar)%");
+}
+BENCHMARK(bmEvaluateFormattedHeaders)->DenseRange(2, 20, 2);
+
 } // namespace Router
 } // namespace Envoy
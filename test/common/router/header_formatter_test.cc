@@ -24,6 +24,7 @@
 #include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -479,6 +480,27 @@ request_headers_to_add:
   EXPECT_EQ("static-value", header_map.get_("static-header"));
 }
 
+// Static and formatted values are interleaved, and there are more formatted values than the
+// inline capacity of the storage for them.
+TEST(HeaderParserTest, EvaluateStaticAndFormattedHeaders) {
+  Protobuf::RepeatedPtrField<envoy::config::core::v3::HeaderValueOption> headers_to_add;
+  for (int i = 0; i < 12; i++) {
+    auto* header = headers_to_add.Add()->mutable_header();
+    header->set_key(absl::StrCat("x-header-", i));
+    header->set_value(i % 2 == 0 ? absl::StrCat("static-", i) : absl::StrCat("%PROTOCOL%-", i));
+  }
+
+  HeaderParserPtr req_header_parser = HeaderParser::configure(headers_to_add).value();
+  Http::TestRequestHeaderMapImpl header_map{{":method", "POST"}};
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  stream_info.protocol_ = Envoy::Http::Protocol::Http11;
+  req_header_parser->evaluateHeaders(header_map, stream_info);
+  for (int i = 0; i < 12; i++) {
+    EXPECT_EQ(i % 2 == 0 ? absl::StrCat("static-", i) : absl::StrCat("HTTP/1.1-", i),
+              header_map.get_(absl::StrCat("x-header-", i)));
+  }
+}
+
 TEST(HeaderParserTest, EvaluateCompoundHeaders) {
   const std::string yaml = R"EOF(
 match: { prefix: "/new_endpoint" }
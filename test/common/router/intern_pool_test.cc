@@ -0,0 +1,86 @@
+#include <memory>
+#include <string>
+
+#include "source/common/router/intern_pool.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+struct Object {
+  explicit Object(std::string value) : value_(std::move(value)) {}
+  const std::string value_;
+};
+
+struct OtherObject {};
+
+class InternPoolTest : public testing::Test {
+protected:
+  absl::StatusOr<std::shared_ptr<const Object>> get(const std::string& config,
+                                                    const std::string& value) {
+    return pool_->getOrCreate<Object>(config, [this, &value]() {
+      ++created_;
+      return std::make_unique<Object>(value);
+    });
+  }
+
+  std::shared_ptr<InternPool> pool_{std::make_shared<InternPool>()};
+  uint32_t created_{};
+};
+
+TEST_F(InternPoolTest, SharesObjectsWithTheSameKey) {
+  auto first = get("a", "foo");
+  auto second = get("a", "bar");
+  ASSERT_TRUE(first.ok());
+  ASSERT_TRUE(second.ok());
+  EXPECT_EQ(first->get(), second->get());
+  EXPECT_EQ("foo", (*second)->value_);
+  EXPECT_EQ(1U, created_);
+
+  // Configs that differ in any byte get their own object.
+  auto third = get("b", "bar");
+  EXPECT_NE(first->get(), third->get());
+  auto fourth = get(std::string("a\0", 2), "baz");
+  EXPECT_NE(first->get(), fourth->get());
+  EXPECT_EQ(3U, created_);
+
+  // The type is part of the key.
+  auto other = pool_->getOrCreate<OtherObject>(
+      "a", []() -> absl::StatusOr<std::unique_ptr<OtherObject>> {
+        return std::make_unique<OtherObject>();
+      });
+  ASSERT_TRUE(other.ok());
+  EXPECT_EQ(4U, pool_->size());
+}
+
+TEST_F(InternPoolTest, ReleasesUnusedObjects) {
+  auto first = get("a", "foo");
+  EXPECT_EQ(1U, pool_->size());
+  first->reset();
+  EXPECT_EQ(0U, pool_->size());
+
+  auto second = get("a", "bar");
+  EXPECT_EQ("bar", (*second)->value_);
+  EXPECT_EQ(2U, created_);
+}
+
+TEST_F(InternPoolTest, ObjectsOutliveTheirOwner) {
+  auto object = get("a", "foo");
+  pool_.reset();
+  EXPECT_EQ("foo", (*object)->value_);
+}
+
+TEST_F(InternPoolTest, CreationErrors) {
+  auto object = pool_->getOrCreate<Object>(
+      "a", []() -> absl::StatusOr<std::unique_ptr<Object>> {
+        return absl::InvalidArgumentError("invalid");
+      });
+  EXPECT_EQ(absl::InvalidArgumentError("invalid"), object.status());
+  EXPECT_EQ(0U, pool_->size());
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -514,6 +514,32 @@ TEST_F(RouterRetryStateImplTest, Http3AutoConfigRetryOnTooEarlyRetriableStatusCo
   verifyRetryWithRemoteResponse(request, "425", false /* is_grpc */);
 }
 
+TEST_F(RouterRetryStateImplTest, PipeliningAutoConfigRetryOnRefusedStream) {
+  // Retry upon refused streams should be automatically configured for safe requests, which may be
+  // pipelined on HTTP/1.1 connections.
+  cluster_.http1_settings_.max_requests_in_flight_ = 2;
+  Http::TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  setup(request_headers);
+  EXPECT_TRUE(state_->enabled());
+
+  EXPECT_EQ(RetryStatus::No, state_->shouldRetryReset(remote_reset_, RetryState::Http3Used::No,
+                                                      reset_callback_, false));
+
+  expectTimerCreateAndEnable();
+  EXPECT_EQ(RetryStatus::Yes,
+            state_->shouldRetryReset(remote_refused_stream_reset_, RetryState::Http3Used::No,
+                                     reset_callback_, false));
+  EXPECT_CALL(callback_ready_, ready());
+  retry_timer_->invokeCallback();
+  EXPECT_EQ(1UL, cluster_.trafficStats()->upstream_rq_retry_.value());
+
+  // Requests which are not safe are never pipelined.
+  Http::TestRequestHeaderMapImpl post_headers{{":method", "POST"}};
+  setup(post_headers);
+  EXPECT_EQ(nullptr, state_);
+}
+
 TEST_F(RouterRetryStateImplTest, NoRetryUponTooEarlyStatusCodeWithDownstreamEarlyData) {
   EXPECT_CALL(cluster_, features()).WillRepeatedly(Return(Upstream::ClusterInfo::Features::HTTP3));
   // A request with "EarlyData" header won't be retried upon 425.
@@ -2210,7 +2210,12 @@ TEST_F(RouterTest, HedgedPerTryTimeoutFirstRequestSucceeds) {
   EXPECT_TRUE(verifyHostUpstreamStats(1, 0));
   EXPECT_EQ(0U, router_->upstreamRequests().size());
 
-  // TODO: Verify hedge stats here once they are implemented.
+  EXPECT_EQ(1U, cm_.thread_local_cluster_.cluster_.info_->stats_store_
+                    .counter("upstream_rq_hedge_attempted")
+                    .value());
+  EXPECT_EQ(1U, cm_.thread_local_cluster_.cluster_.info_->stats_store_
+                    .counter("upstream_rq_hedge_abandoned")
+                    .value());
 }
 
 // Tests that an upstream request is reset even if it can't be retried as long as there is
@@ -4869,18 +4874,22 @@ TEST_P(RouterShadowingTest, BufferingShadow) {
   EXPECT_CALL(callbacks_, decodingBuffer())
       .Times(AtLeast(2))
       .WillRepeatedly(Return(body_data.get()));
+  // Both shadow requests share a single copy of the body.
+  const void* foo_body = nullptr;
   EXPECT_CALL(*shadow_writer_, shadow_("foo", _, _))
-      .WillOnce(Invoke([](const std::string&, Http::RequestMessagePtr& request,
-                          const Http::AsyncClient::RequestOptions& options) -> void {
-        EXPECT_NE(request->body().length(), 0);
+      .WillOnce(Invoke([&foo_body](const std::string&, Http::RequestMessagePtr& request,
+                                   const Http::AsyncClient::RequestOptions& options) -> void {
+        EXPECT_EQ("hello", request->body().toString());
+        foo_body = request->body().frontSlice().mem_;
         EXPECT_NE(nullptr, request->trailers());
         EXPECT_EQ(absl::optional<std::chrono::milliseconds>(10), options.timeout);
         EXPECT_TRUE(options.sampled_.value());
       }));
   EXPECT_CALL(*shadow_writer_, shadow_("fizz", _, _))
-      .WillOnce(Invoke([](const std::string&, Http::RequestMessagePtr& request,
-                          const Http::AsyncClient::RequestOptions& options) -> void {
-        EXPECT_NE(request->body().length(), 0);
+      .WillOnce(Invoke([&foo_body](const std::string&, Http::RequestMessagePtr& request,
+                                   const Http::AsyncClient::RequestOptions& options) -> void {
+        EXPECT_EQ("hello", request->body().toString());
+        EXPECT_EQ(foo_body, request->body().frontSlice().mem_);
         EXPECT_NE(nullptr, request->trailers());
         EXPECT_EQ(absl::optional<std::chrono::milliseconds>(10), options.timeout);
         EXPECT_FALSE(options.sampled_.value());
@@ -561,6 +561,11 @@ TEST_F(StaticLoaderImplTest, All) {
   EXPECT_EQ(1.1, loader_->snapshot().getDouble("foo", 1.1));
   EXPECT_CALL(generator_, random()).WillOnce(Return(49));
   EXPECT_TRUE(loader_->snapshot().featureEnabled("foo", 50));
+  envoy::type::v3::FractionalPercent percent;
+  percent.set_numerator(30);
+  percent.set_denominator(envoy::type::v3::FractionalPercent::TEN_THOUSAND);
+  EXPECT_TRUE(loader_->snapshot().featureEnabled("foo", percent, 10029));
+  EXPECT_FALSE(loader_->snapshot().featureEnabled("foo", percent, 10030));
   testNewOverrides(*loader_, store_);
 }
 
@@ -64,6 +64,26 @@ TEST_F(AllocatorImplTest, CountersWithSameName) {
   EXPECT_EQ(2, c2->value());
 }
 
+TEST_F(AllocatorImplTest, CounterLatchAndReset) {
+  CounterSharedPtr counter = alloc_.makeCounter(makeStat("counter.name"), StatName(), {});
+  counter->add(5);
+  EXPECT_EQ(5, counter->value());
+  EXPECT_EQ(5, counter->latch());
+  EXPECT_EQ(5, counter->value());
+  EXPECT_EQ(0, counter->latch());
+
+  counter->inc();
+  EXPECT_EQ(6, counter->value());
+
+  // A reset doesn't affect the pending increment.
+  counter->reset();
+  EXPECT_EQ(0, counter->value());
+  counter->inc();
+  EXPECT_EQ(1, counter->value());
+  EXPECT_EQ(2, counter->latch());
+  EXPECT_EQ(1, counter->value());
+}
+
 TEST_F(AllocatorImplTest, GaugesWithSameName) {
   StatName gauge_name = makeStat("gauges.name");
   GaugeSharedPtr g1 = alloc_.makeGauge(gauge_name, StatName(), {}, Gauge::ImportMode::Accumulate);
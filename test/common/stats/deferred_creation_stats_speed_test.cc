@@ -149,6 +149,30 @@ BENCHMARK(benchmarkDeferredCreationCreationInstantiateSameThread)
     ->ArgsProduct({{0, 1}, {1000, 2000, 5000, 10000, 20000}})
     ->Unit(::benchmark::kMillisecond);
 
+// Benchmark creation of stats which live in stores of their own, such as the load report stats
+// of clusters. When deferred, neither the stores nor the stats are allocated.
+void benchmarkDeferredCreationIsolatedCreation(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(1) > 2000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  SymbolTableImpl symbol_table;
+  AwesomeStatNames stat_names(symbol_table);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    std::vector<DeferredCreationCompatibleStats<AwesomeStats>> stats;
+    stats.reserve(state.range(1));
+    for (int64_t i = 0; i < state.range(1); ++i) {
+      stats.push_back(createDeferredCompatibleIsolatedStats<AwesomeStats>(
+          symbol_table, stat_names, state.range(0) == 1));
+    }
+  }
+}
+
+BENCHMARK(benchmarkDeferredCreationIsolatedCreation)
+    ->ArgsProduct({{0, 1}, {1000, 2000, 5000, 10000, 20000}})
+    ->Unit(::benchmark::kMillisecond);
+
 class MultiThreadDeferredCreationStatsTest : public ThreadLocalRealThreadsMixin,
                                              public DeferredCreationStatsBenchmarkBase {
 public:
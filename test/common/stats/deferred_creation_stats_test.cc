@@ -201,6 +201,24 @@ TEST_F(DeferredCreationStatsTest, WhenScopesOverlapStatsAreAliveAsLongAsThereAre
   EXPECT_EQ(TestUtility::findGauge(store_, "bluh.AwesomeStats.initialized"), nullptr);
 }
 
+// Tests that isolated stats are kept out of the store, and only allocated on first use if
+// deferred.
+TEST_F(DeferredCreationStatsTest, IsolatedStats) {
+  MyStats non_lazy = createDeferredCompatibleIsolatedStats<AwesomeStats>(symbol_table_,
+                                                                         stats_names_, false);
+  EXPECT_TRUE(non_lazy.isPresent());
+  MyStats lazy =
+      createDeferredCompatibleIsolatedStats<AwesomeStats>(symbol_table_, stats_names_, true);
+  EXPECT_FALSE(lazy.isPresent());
+  lazy->foo_.inc();
+  EXPECT_TRUE(lazy.isPresent());
+  EXPECT_EQ(lazy->foo_.value(), 1);
+  // Each instance has a store of its own.
+  EXPECT_EQ(non_lazy->foo_.value(), 0);
+  EXPECT_EQ(TestUtility::findCounter(store_, "foo"), nullptr);
+  EXPECT_EQ(TestUtility::findGauge(store_, "AwesomeStats.initialized"), nullptr);
+}
+
 } // namespace
 } // namespace Stats
 } // namespace Envoy
@@ -63,6 +63,25 @@ static void bmCreateRace(benchmark::State& state) {
 }
 BENCHMARK(bmCreateRace)->Unit(::benchmark::kMillisecond);
 
+// Decodes and compares names from many threads, as the admin handlers and stats sinks do while
+// workers encode names, which only takes the symbol table lock shared.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmDecodeContended(benchmark::State& state) {
+  // Shared by all threads of the benchmark, and never freed as the threads may still use them
+  // after the first thread finished.
+  static Envoy::Stats::SymbolTableImpl* table = new Envoy::Stats::SymbolTableImpl;
+  static Envoy::Stats::StatNamePool* pool = new Envoy::Stats::StatNamePool(*table);
+  static const Envoy::Stats::StatName a = pool->add("cluster.backend.upstream_rq_total");
+  static const Envoy::Stats::StatName b = pool->add("cluster.backend.upstream_rq_time");
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    benchmark::DoNotOptimize(table->toString(a));
+    benchmark::DoNotOptimize(table->lessThan(a, b));
+  }
+}
+BENCHMARK(bmDecodeContended)->ThreadRange(1, 64)->UseRealTime();
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void bmJoinStatNames(benchmark::State& state) {
   Envoy::Stats::SymbolTableImpl symbol_table;
@@ -56,6 +56,11 @@ public:
     }
   }
 
+  Stats::Counter& counter(absl::string_view name) {
+    Stats::StatNameManagedStorage stat_name(name, symbol_table_);
+    return store_.rootScope()->counterFromStatName(stat_name.statName());
+  }
+
   void initThreading() {
     if (!Envoy::Event::Libevent::Global::initialized()) {
       Envoy::Event::Libevent::Global::initialize();
@@ -138,5 +143,19 @@ static void BM_StatsWithTlsAndRejectionsWithoutDot(benchmark::State& state) {
 }
 BENCHMARK(BM_StatsWithTlsAndRejectionsWithoutDot);
 
+// Tests the performance of incrementing the same counter from multiple threads, as workers do
+// for hot counters such as downstream_rq_total.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_CounterIncContended(benchmark::State& state) {
+  // Shared by all threads of the benchmark.
+  static Envoy::ThreadLocalStorePerf context;
+  static Envoy::Stats::Counter& counter = context.counter("http.ingress.downstream_rq_total");
+
+  for (auto _ : state) { // NOLINT
+    counter.inc();
+  }
+}
+BENCHMARK(BM_CounterIncContended)->ThreadRange(1, 64)->UseRealTime();
+
 // TODO(jmarantz): add multi-threaded variant of this test, that aggressively
 // looks up stats in multiple threads to try to trigger contention issues.
@@ -1689,6 +1689,28 @@ TEST_F(HistogramTest, MultiHistogramMultipleMerges) {
   EXPECT_EQ(2, validateMerge());
 }
 
+// Merges of intervals without values skip the histograms, which must keep their statistics.
+TEST_F(HistogramTest, MergesWithoutValues) {
+  Histogram& h1 = scope_.histogramFromString("h1", Histogram::Unit::Unspecified);
+  Histogram& h2 = scope_.histogramFromString("h2", Histogram::Unit::Unspecified);
+
+  expectCallAndAccumulate(h1, 1);
+  expectCallAndAccumulate(h2, 5);
+  EXPECT_EQ(2, validateMerge());
+
+  // The first merge without values empties the interval, the second leaves it empty.
+  EXPECT_EQ(2, validateMerge());
+  EXPECT_EQ(2, validateMerge());
+
+  expectCallAndAccumulate(h2, 7);
+  EXPECT_EQ(2, validateMerge());
+  EXPECT_EQ(2, validateMerge());
+
+  expectCallAndAccumulate(h1, 3);
+  expectCallAndAccumulate(h2, 9);
+  EXPECT_EQ(2, validateMerge());
+}
+
 TEST_F(HistogramTest, BasicScopeHistogramMerge) {
   ScopeSharedPtr scope1 = store_->createScope("scope1.");
 
@@ -210,6 +210,21 @@ TEST_F(FilterStateImplTest, NoNameConflictMutableAndMutable) {
   EXPECT_EQ(8, filterState().getDataReadOnly<TestStoredTypeTracking>("test_4")->access());
 }
 
+TEST_F(FilterStateImplTest, OverwrittenMutableDataIsDestroyed) {
+  size_t destruction_count = 0u;
+  filterState().setData("test_name",
+                        std::make_unique<TestStoredTypeTracking>(1, nullptr, &destruction_count),
+                        FilterState::StateType::Mutable, FilterState::LifeSpan::FilterChain);
+  filterState().setData("test_name",
+                        std::make_unique<TestStoredTypeTracking>(2, nullptr, &destruction_count),
+                        FilterState::StateType::Mutable, FilterState::LifeSpan::FilterChain);
+  EXPECT_EQ(1u, destruction_count);
+  EXPECT_EQ(2, filterState().getDataMutable<TestStoredTypeTracking>("test_name")->access());
+
+  resetFilterState();
+  EXPECT_EQ(2u, destruction_count);
+}
+
 TEST_F(FilterStateImplTest, UnknownName) {
   EXPECT_EQ(nullptr, filterState().getDataReadOnly<SimpleType>("test_1"));
   EXPECT_EQ(nullptr, filterState().getDataMutable<SimpleType>("test_1"));
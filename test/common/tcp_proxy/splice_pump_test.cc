@@ -0,0 +1,217 @@
+#include <fcntl.h>
+
+#include "source/common/tcp_proxy/splice_pump.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/network/connection.h"
+#include "test/mocks/network/io_handle.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace TcpProxy {
+namespace {
+
+// splice() is only available on Linux; the pump is never created elsewhere.
+#if defined(__linux__)
+
+using testing::_;
+using testing::DoAll;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+using testing::SaveArg;
+
+constexpr os_fd_t DownstreamFd = 10;
+constexpr os_fd_t UpstreamFd = 11;
+// The pipes moving data upstream and downstream.
+constexpr int UpstreamPipe[2] = {20, 21};
+constexpr int DownstreamPipe[2] = {30, 31};
+
+class MockSplicePumpCallbacks : public SplicePump::Callbacks {
+public:
+  MOCK_METHOD(void, onSpliceBytesRead, (SplicePump::Direction, uint64_t));
+  MOCK_METHOD(void, onSpliceBytesWritten, (SplicePump::Direction, uint64_t));
+  MOCK_METHOD(void, onSpliceEndStream, (SplicePump::Direction));
+  MOCK_METHOD(void, onSpliceError, (SplicePump::Direction, int));
+};
+
+class SplicePumpTest : public testing::Test {
+protected:
+  SplicePumpTest() {
+    ON_CALL(downstream_io_handle_, fdDoNotUse()).WillByDefault(Return(DownstreamFd));
+    ON_CALL(downstream_io_handle_, isOpen()).WillByDefault(Return(true));
+    ON_CALL(upstream_io_handle_, fdDoNotUse()).WillByDefault(Return(UpstreamFd));
+    ON_CALL(upstream_io_handle_, isOpen()).WillByDefault(Return(true));
+    ON_CALL(downstream_, socketIoHandle())
+        .WillByDefault(Return(OptRef<Network::IoHandle>(downstream_io_handle_)));
+    ON_CALL(upstream_, socketIoHandle())
+        .WillByDefault(Return(OptRef<Network::IoHandle>(upstream_io_handle_)));
+  }
+
+  void createPump() {
+    EXPECT_CALL(linux_os_sys_calls_, pipe2(_, O_NONBLOCK | O_CLOEXEC))
+        .WillOnce(Invoke([](int fds[2], int) {
+          fds[0] = UpstreamPipe[0];
+          fds[1] = UpstreamPipe[1];
+          return Api::SysCallIntResult{0, 0};
+        }))
+        .WillOnce(Invoke([](int fds[2], int) {
+          fds[0] = DownstreamPipe[0];
+          fds[1] = DownstreamPipe[1];
+          return Api::SysCallIntResult{0, 0};
+        }));
+    downstream_event_ = new NiceMock<Event::MockFileEvent>();
+    upstream_event_ = new NiceMock<Event::MockFileEvent>();
+    EXPECT_CALL(downstream_.dispatcher_, createFileEvent_(DownstreamFd, _, _, _))
+        .WillOnce(DoAll(SaveArg<1>(&downstream_cb_), Return(downstream_event_)));
+    EXPECT_CALL(downstream_.dispatcher_, createFileEvent_(UpstreamFd, _, _, _))
+        .WillOnce(DoAll(SaveArg<1>(&upstream_cb_), Return(upstream_event_)));
+    // Both directions get a pass once the event loop runs.
+    EXPECT_CALL(*downstream_event_, activate(Event::FileReadyType::Read));
+    EXPECT_CALL(*upstream_event_, activate(Event::FileReadyType::Read));
+
+    pump_ = SplicePump::create(downstream_, upstream_, callbacks_);
+    ASSERT_NE(nullptr, pump_);
+  }
+
+  void expectSplice(int fd_in, int fd_out, ssize_t rc, int error = 0) {
+    EXPECT_CALL(linux_os_sys_calls_, splice(fd_in, nullptr, fd_out, nullptr, _, _))
+        .InSequence(splice_sequence_)
+        .WillOnce(Return(Api::SysCallSizeResult{rc, error}))
+        .RetiresOnSaturation();
+  }
+
+  void expectClosePipes() {
+    for (int fd : {UpstreamPipe[0], UpstreamPipe[1], DownstreamPipe[0], DownstreamPipe[1]}) {
+      EXPECT_CALL(os_sys_calls_, close(fd)).WillOnce(Return(Api::SysCallIntResult{0, 0}));
+    }
+  }
+
+  NiceMock<Api::MockOsSysCalls> os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_{&os_sys_calls_};
+  NiceMock<Api::MockLinuxOsSysCalls> linux_os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> linux_os_calls_{&linux_os_sys_calls_};
+  NiceMock<Network::MockIoHandle> downstream_io_handle_;
+  NiceMock<Network::MockIoHandle> upstream_io_handle_;
+  NiceMock<Network::MockConnection> downstream_;
+  NiceMock<Network::MockConnection> upstream_;
+  MockSplicePumpCallbacks callbacks_;
+  Event::MockFileEvent* downstream_event_{};
+  Event::MockFileEvent* upstream_event_{};
+  Event::FileReadyCb downstream_cb_;
+  Event::FileReadyCb upstream_cb_;
+  SplicePumpPtr pump_;
+  testing::Sequence splice_sequence_;
+};
+
+TEST_F(SplicePumpTest, NoSocket) {
+  EXPECT_CALL(upstream_, socketIoHandle()).WillOnce(Return(OptRef<Network::IoHandle>()));
+  EXPECT_EQ(nullptr, SplicePump::create(downstream_, upstream_, callbacks_));
+}
+
+TEST_F(SplicePumpTest, PipeCreationFails) {
+  EXPECT_CALL(linux_os_sys_calls_, pipe2(_, _)).WillOnce(Return(Api::SysCallIntResult{-1, EMFILE}));
+  EXPECT_EQ(nullptr, SplicePump::create(downstream_, upstream_, callbacks_));
+}
+
+TEST_F(SplicePumpTest, MovesDataAndHalfCloses) {
+  createPump();
+
+  // Downstream data is moved to the upstream socket through the pipe until the downstream socket
+  // has no more data.
+  expectSplice(DownstreamFd, UpstreamPipe[1], 100);
+  expectSplice(UpstreamPipe[0], UpstreamFd, 100);
+  expectSplice(DownstreamFd, UpstreamPipe[1], -1, EAGAIN);
+  EXPECT_CALL(callbacks_, onSpliceBytesRead(SplicePump::Direction::Upstream, 100));
+  EXPECT_CALL(callbacks_, onSpliceBytesWritten(SplicePump::Direction::Upstream, 100));
+  ASSERT_TRUE(downstream_cb_(Event::FileReadyType::Read).ok());
+
+  // Upstream data, written partially at first.
+  expectSplice(UpstreamFd, DownstreamPipe[1], 50);
+  expectSplice(DownstreamPipe[0], DownstreamFd, 20);
+  expectSplice(DownstreamPipe[0], DownstreamFd, 30);
+  expectSplice(UpstreamFd, DownstreamPipe[1], -1, EAGAIN);
+  EXPECT_CALL(callbacks_, onSpliceBytesRead(SplicePump::Direction::Downstream, 50));
+  EXPECT_CALL(callbacks_, onSpliceBytesWritten(SplicePump::Direction::Downstream, 20));
+  EXPECT_CALL(callbacks_, onSpliceBytesWritten(SplicePump::Direction::Downstream, 30));
+  ASSERT_TRUE(upstream_cb_(Event::FileReadyType::Read).ok());
+
+  // The downstream half closes.
+  expectSplice(DownstreamFd, UpstreamPipe[1], 0);
+  EXPECT_CALL(callbacks_, onSpliceEndStream(SplicePump::Direction::Upstream));
+  ASSERT_TRUE(downstream_cb_(Event::FileReadyType::Read).ok());
+
+  // Nothing is read once the source has been closed.
+  ASSERT_TRUE(downstream_cb_(Event::FileReadyType::Read).ok());
+
+  expectClosePipes();
+  pump_.reset();
+}
+
+TEST_F(SplicePumpTest, DestinationBackpressure) {
+  createPump();
+
+  expectSplice(DownstreamFd, UpstreamPipe[1], 1000);
+  expectSplice(UpstreamPipe[0], UpstreamFd, -1, EAGAIN);
+  EXPECT_CALL(callbacks_, onSpliceBytesRead(SplicePump::Direction::Upstream, 1000));
+  ASSERT_TRUE(downstream_cb_(Event::FileReadyType::Read).ok());
+
+  // More downstream data is not read while the upstream socket is not writable.
+  EXPECT_CALL(linux_os_sys_calls_, splice(_, _, _, _, _, _)).Times(0);
+  ASSERT_TRUE(downstream_cb_(Event::FileReadyType::Read).ok());
+  testing::Mock::VerifyAndClearExpectations(&linux_os_sys_calls_);
+
+  // Once the upstream socket is writable the pipe drains and reading resumes.
+  expectSplice(UpstreamPipe[0], UpstreamFd, 1000);
+  expectSplice(DownstreamFd, UpstreamPipe[1], -1, EAGAIN);
+  EXPECT_CALL(callbacks_, onSpliceBytesWritten(SplicePump::Direction::Upstream, 1000));
+  ASSERT_TRUE(upstream_cb_(Event::FileReadyType::Write).ok());
+
+  expectClosePipes();
+  pump_.reset();
+}
+
+TEST_F(SplicePumpTest, YieldsToEventLoop) {
+  createPump();
+
+  // A source that always has data is drained in bounded chunks.
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamFd, _, UpstreamPipe[1], _, _, _))
+      .Times(16)
+      .WillRepeatedly(Return(Api::SysCallSizeResult{64 * 1024, 0}));
+  EXPECT_CALL(linux_os_sys_calls_, splice(UpstreamPipe[0], _, UpstreamFd, _, _, _))
+      .Times(16)
+      .WillRepeatedly(Return(Api::SysCallSizeResult{64 * 1024, 0}));
+  EXPECT_CALL(callbacks_, onSpliceBytesRead(SplicePump::Direction::Upstream, 64 * 1024)).Times(16);
+  EXPECT_CALL(callbacks_, onSpliceBytesWritten(SplicePump::Direction::Upstream, 64 * 1024))
+      .Times(16);
+  EXPECT_CALL(*downstream_event_, activate(Event::FileReadyType::Read));
+  ASSERT_TRUE(downstream_cb_(Event::FileReadyType::Read).ok());
+
+  expectClosePipes();
+  pump_.reset();
+}
+
+TEST_F(SplicePumpTest, Error) {
+  createPump();
+
+  expectSplice(UpstreamFd, DownstreamPipe[1], -1, ECONNRESET);
+  EXPECT_CALL(callbacks_, onSpliceError(SplicePump::Direction::Downstream, ECONNRESET));
+  ASSERT_TRUE(upstream_cb_(Event::FileReadyType::Read).ok());
+
+  // No more data is moved after a failure.
+  EXPECT_CALL(linux_os_sys_calls_, splice(_, _, _, _, _, _)).Times(0);
+  ASSERT_TRUE(downstream_cb_(Event::FileReadyType::Read | Event::FileReadyType::Write).ok());
+
+  expectClosePipes();
+  pump_.reset();
+}
+
+#endif
+
+} // namespace
+} // namespace TcpProxy
+} // namespace Envoy
@@ -1319,6 +1319,41 @@ TEST_P(TcpProxyTest, IdleTimeoutWithFilterStateOverride) {
 
 // Tests that the idle timer closes both connections, and gets updated when either
 // connection has activity.
+// Test that a connection is closed after upstream data once the listener drains, if configured.
+TEST_P(TcpProxyTest, CloseOnDrain) {
+  envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy config = defaultConfig();
+  config.set_close_on_drain(true);
+  setup(1, config);
+  raiseEventUpstreamConnected(0);
+
+  EXPECT_CALL(factory_context_.drain_manager_, drainClose()).WillOnce(Return(false));
+  Buffer::OwnedImpl response("hello");
+  EXPECT_CALL(filter_callbacks_.connection_, write(BufferEqual(&response), _));
+  upstream_callbacks_->onUpstreamData(response, false);
+
+  EXPECT_CALL(factory_context_.drain_manager_, drainClose()).WillOnce(Return(true));
+  response.add("world");
+  EXPECT_CALL(filter_callbacks_.connection_, write(BufferEqual(&response), _));
+  EXPECT_CALL(filter_callbacks_.connection_,
+              close(Network::ConnectionCloseType::FlushWrite,
+                    StreamInfo::LocalCloseReasons::get().TcpProxyDrainClose));
+  EXPECT_CALL(*upstream_connections_.at(0), close(Network::ConnectionCloseType::NoFlush, _));
+  upstream_callbacks_->onUpstreamData(response, false);
+  EXPECT_EQ(1U, config_->stats().downstream_cx_drain_close_.value());
+}
+
+// Test that the drain state is not consulted unless configured.
+TEST_P(TcpProxyTest, NoCloseOnDrainByDefault) {
+  setup(1);
+  raiseEventUpstreamConnected(0);
+
+  EXPECT_CALL(factory_context_.drain_manager_, drainClose()).Times(0);
+  Buffer::OwnedImpl response("hello");
+  EXPECT_CALL(filter_callbacks_.connection_, write(BufferEqual(&response), _));
+  upstream_callbacks_->onUpstreamData(response, false);
+  EXPECT_EQ(0U, config_->stats().downstream_cx_drain_close_.value());
+}
+
 TEST_P(TcpProxyTest, IdleTimeout) {
   envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy config = defaultConfig();
   config.mutable_idle_timeout()->set_seconds(1);
@@ -1,13 +1,16 @@
 #include <string>
 #include <vector>
 
+#include "source/common/network/transport_socket_options_impl.h"
 #include "source/common/tls/cert_validator/default_validator.h"
 #include "source/common/tls/cert_validator/san_matcher.h"
+#include "source/common/tls/utility.h"
 
 #include "test/common/tls/cert_validator/test_common.h"
 #include "test/common/tls/ssl_test_utility.h"
 #include "test/mocks/server/server_factory_context.h"
 #include "test/test_common/environment.h"
+#include "test/test_common/simulated_time_system.h"
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
@@ -674,6 +677,103 @@ TEST(DefaultCertValidatorTest, WithVerifyDepth) {
   EXPECT_EQ(X509_STORE_CTX_get_error(store_ctx.get()), X509_V_OK);
 }
 
+TEST(DefaultCertValidatorTest, VerifiedCertificateCache) {
+  Event::SimulatedTimeSystem time_system;
+  NiceMock<Server::Configuration::MockServerFactoryContext> context;
+  Stats::TestUtil::TestStore test_store;
+  SslStats stats = generateSslStats(*test_store.rootScope());
+  envoy::config::core::v3::TypedExtensionConfig typed_conf;
+  auto test_config = std::make_unique<TestCertificateValidationContextConfig>(
+      typed_conf, false, std::vector<envoy::extensions::transport_sockets::tls::v3::
+                                         SubjectAltNameMatcher>{},
+      TestEnvironment::readFileToStringForTest(
+          TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/ca_cert.pem")));
+  test_config->setVerifiedCertificateCache(1, std::chrono::minutes(1));
+  auto default_validator =
+      std::make_unique<DefaultCertValidator>(test_config.get(), stats, context);
+  SSLContextPtr ssl_ctx = SSL_CTX_new(TLS_method());
+  ASSERT_TRUE(default_validator->initializeSslContexts({ssl_ctx.get()}, false).ok());
+
+  bssl::UniquePtr<STACK_OF(X509)> dns_chain = readCertChainFromFile(
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/san_dns_cert.pem"));
+  bssl::UniquePtr<STACK_OF(X509)> uri_chain = readCertChainFromFile(
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/san_uri_cert.pem"));
+  bssl::UniquePtr<STACK_OF(X509)> untrusted_chain =
+      readCertChainFromFile(TestEnvironment::substitute(
+          "{{ test_rundir }}/test/common/tls/test_data/selfsigned_cert.pem"));
+  time_system.setSystemTime(Utility::getValidFrom(*sk_X509_value(dns_chain.get(), 0)) +
+                            std::chrono::hours(1));
+  auto verify = [&](STACK_OF(X509) & chain,
+                    const Network::TransportSocketOptionsConstSharedPtr& options = nullptr) {
+    return default_validator->doVerifyCertChain(chain, nullptr, options, *ssl_ctx, {}, true, "")
+        .status;
+  };
+
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, verify(*dns_chain));
+  EXPECT_EQ(0, stats.verified_cert_cache_hit_.value());
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, verify(*dns_chain));
+  EXPECT_EQ(1, stats.verified_cert_cache_hit_.value());
+
+  // Chains failing verification are not remembered.
+  EXPECT_EQ(ValidationResults::ValidationStatus::Failed, verify(*untrusted_chain));
+  EXPECT_EQ(ValidationResults::ValidationStatus::Failed, verify(*untrusted_chain));
+  EXPECT_EQ(1, stats.verified_cert_cache_hit_.value());
+  EXPECT_EQ(2, stats.fail_verify_error_.value());
+
+  // A subject alt name override is checked on every connection.
+  auto options = std::make_shared<Network::TransportSocketOptionsImpl>(
+      "", std::vector<std::string>{"server1.example.com"});
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, verify(*dns_chain, options));
+  EXPECT_EQ(1, stats.verified_cert_cache_hit_.value());
+
+  // The cache holds one chain.
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, verify(*uri_chain));
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, verify(*dns_chain));
+  EXPECT_EQ(1, stats.verified_cert_cache_hit_.value());
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, verify(*dns_chain));
+  EXPECT_EQ(2, stats.verified_cert_cache_hit_.value());
+
+  // Chains are verified again after max_age.
+  time_system.advanceTimeWait(std::chrono::minutes(1));
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful, verify(*dns_chain));
+  EXPECT_EQ(2, stats.verified_cert_cache_hit_.value());
+}
+
+// The SSL_CTXs of all the certificates of a context share one trust store and client CA list.
+TEST(DefaultCertValidatorTest, SslContextsShareTrustStore) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> context;
+  Stats::TestUtil::TestStore test_store;
+  SslStats stats = generateSslStats(*test_store.rootScope());
+  envoy::config::core::v3::TypedExtensionConfig typed_conf;
+  auto test_config = std::make_unique<TestCertificateValidationContextConfig>(
+      typed_conf, false, std::vector<envoy::extensions::transport_sockets::tls::v3::
+                                         SubjectAltNameMatcher>{},
+      TestEnvironment::readFileToStringForTest(
+          TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/ca_cert.pem")));
+  auto default_validator =
+      std::make_unique<DefaultCertValidator>(test_config.get(), stats, context);
+
+  SSLContextPtr ssl_ctx1 = SSL_CTX_new(TLS_method());
+  SSLContextPtr ssl_ctx2 = SSL_CTX_new(TLS_method());
+  ASSERT_TRUE(
+      default_validator->initializeSslContexts({ssl_ctx1.get(), ssl_ctx2.get()}, false).ok());
+  EXPECT_EQ(SSL_CTX_get_cert_store(ssl_ctx1.get()), SSL_CTX_get_cert_store(ssl_ctx2.get()));
+
+  ASSERT_TRUE(default_validator->addClientValidationContext(ssl_ctx1.get(), false).ok());
+  ASSERT_TRUE(default_validator->addClientValidationContext(ssl_ctx2.get(), false).ok());
+  const STACK_OF(X509_NAME)* names1 = SSL_CTX_get_client_CA_list(ssl_ctx1.get());
+  const STACK_OF(X509_NAME)* names2 = SSL_CTX_get_client_CA_list(ssl_ctx2.get());
+  ASSERT_EQ(1, sk_X509_NAME_num(names1));
+  ASSERT_EQ(1, sk_X509_NAME_num(names2));
+  EXPECT_EQ(0, X509_NAME_cmp(sk_X509_NAME_value(names1, 0), sk_X509_NAME_value(names2, 0)));
+
+  bssl::UniquePtr<STACK_OF(X509)> chain = readCertChainFromFile(
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/san_dns_cert.pem"));
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful,
+            default_validator->doVerifyCertChain(*chain, nullptr, nullptr, *ssl_ctx2, {}, true, "")
+                .status);
+}
+
 class MockCertificateValidationContextConfig : public Ssl::CertificateValidationContextConfig {
 public:
   MockCertificateValidationContextConfig() : MockCertificateValidationContextConfig("") {}
@@ -705,6 +805,10 @@ public:
   bool onlyVerifyLeafCertificateCrl() const override { return false; }
   absl::optional<uint32_t> maxVerifyDepth() const override { return absl::nullopt; }
   bool autoSniSanMatch() const override { return false; }
+  uint32_t verifiedCertificateCacheSize() const override { return 0; }
+  std::chrono::milliseconds verifiedCertificateCacheMaxAge() const override {
+    return std::chrono::milliseconds(0);
+  }
 
 private:
   std::string s_;
@@ -106,6 +106,17 @@ public:
 
   absl::optional<uint32_t> maxVerifyDepth() const override { return max_verify_depth_; }
   bool autoSniSanMatch() const override { return auto_sni_san_match_; }
+  uint32_t verifiedCertificateCacheSize() const override {
+    return verified_certificate_cache_size_;
+  }
+  std::chrono::milliseconds verifiedCertificateCacheMaxAge() const override {
+    return verified_certificate_cache_max_age_;
+  }
+
+  void setVerifiedCertificateCache(uint32_t size, std::chrono::milliseconds max_age) {
+    verified_certificate_cache_size_ = size;
+    verified_certificate_cache_max_age_ = max_age;
+  }
 
 private:
   bool allow_expired_certificate_{false};
@@ -117,6 +128,8 @@ private:
   const std::string ca_cert_path_{"TEST_CA_CERT_PATH"};
   const absl::optional<uint32_t> max_verify_depth_{absl::nullopt};
   const bool auto_sni_san_match_{false};
+  uint32_t verified_certificate_cache_size_{};
+  std::chrono::milliseconds verified_certificate_cache_max_age_{};
 };
 
 } // namespace Tls
@@ -0,0 +1,61 @@
+#include "source/common/tls/client_session_cache.h"
+
+#include "gtest/gtest.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+class ClientSessionCacheTest : public testing::Test {
+public:
+  // @return a new session of the given protocol version, and a pointer to it.
+  std::pair<bssl::UniquePtr<SSL_SESSION>, SSL_SESSION*> newSession(uint16_t version) {
+    bssl::UniquePtr<SSL_SESSION> session(SSL_SESSION_new(ssl_ctx_.get()));
+    EXPECT_EQ(1, SSL_SESSION_set_protocol_version(session.get(), version));
+    SSL_SESSION* ptr = session.get();
+    return {std::move(session), ptr};
+  }
+
+  bssl::UniquePtr<SSL_CTX> ssl_ctx_{SSL_CTX_new(TLS_method())};
+};
+
+TEST_F(ClientSessionCacheTest, BySni) {
+  ClientSessionCache cache(2);
+  auto [foo1, foo1_ptr] = newSession(TLS1_2_VERSION);
+  auto [foo2, foo2_ptr] = newSession(TLS1_2_VERSION);
+  auto [bar, bar_ptr] = newSession(TLS1_2_VERSION);
+  cache.add("foo.com", std::move(foo1));
+  cache.add("foo.com", std::move(foo2));
+  cache.add("bar.com", std::move(bar));
+
+  // Sessions that aren't single use stay in the cache.
+  EXPECT_EQ(foo2_ptr, cache.get("foo.com").get());
+  EXPECT_EQ(foo2_ptr, cache.get("foo.com").get());
+  EXPECT_EQ(bar_ptr, cache.get("bar.com").get());
+  EXPECT_EQ(nullptr, cache.get("baz.com"));
+  EXPECT_EQ(nullptr, cache.get(""));
+}
+
+TEST_F(ClientSessionCacheTest, SingleUseAndEviction) {
+  ClientSessionCache cache(2);
+  auto [session1, session1_ptr] = newSession(TLS1_3_VERSION);
+  auto [session2, session2_ptr] = newSession(TLS1_3_VERSION);
+  auto [session3, session3_ptr] = newSession(TLS1_3_VERSION);
+  cache.add("", std::move(session1));
+  cache.add("", std::move(session2));
+  cache.add("", std::move(session3));
+
+  // The oldest session was evicted, the others are removed once used.
+  EXPECT_EQ(session3_ptr, cache.get("").get());
+  EXPECT_EQ(session2_ptr, cache.get("").get());
+  EXPECT_EQ(nullptr, cache.get(""));
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
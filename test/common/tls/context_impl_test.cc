@@ -29,6 +29,7 @@
 #include "test/mocks/ssl/mocks.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
 #include "gtest/gtest.h"
@@ -621,6 +622,32 @@ TEST_F(SslContextImplTest, AcceptableMultipleEcdsaCerts) {
   EXPECT_NO_THROW(loadConfig(*server_context_config));
 }
 
+// The certificates of a context with many certificates are loaded on helper threads, and the
+// first invalid one in configuration order is reported.
+TEST_F(SslContextImplTest, ManyCertificatesLoadedInParallel) {
+  ON_CALL(server_factory_context_.api_, threadFactory())
+      .WillByDefault(ReturnRef(Thread::threadFactoryForTest()));
+  const auto make_config = [this](const std::vector<std::string>& private_keys) {
+    envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext tls_context;
+    for (const std::string& private_key : private_keys) {
+      auto* tls_certificate = tls_context.mutable_common_tls_context()->add_tls_certificates();
+      tls_certificate->mutable_certificate_chain()->set_filename(TestEnvironment::substitute(
+          "{{ test_rundir }}/test/common/tls/test_data/san_dns_rsa_1_cert.pem"));
+      tls_certificate->mutable_private_key()->set_filename(TestEnvironment::substitute(
+          "{{ test_rundir }}/test/common/tls/test_data/" + private_key));
+    }
+    return *ServerContextConfigImpl::create(tls_context, factory_context_, false);
+  };
+
+  std::vector<std::string> private_keys(32, "san_dns_rsa_1_key.pem");
+  EXPECT_NO_THROW(loadConfig(*make_config(private_keys)));
+
+  private_keys[9] = "san_dns_rsa_2_key.pem";
+  private_keys[25] = "selfsigned_ecdsa_p256_key.pem";
+  EXPECT_THROW_WITH_REGEX(loadConfig(*make_config(private_keys)), EnvoyException,
+                          "Failed to load private key from .*san_dns_rsa_2_key.pem");
+}
+
 // One cert which contains one of the SAN values in the CN is acceptable, because CN is not used if
 // SANs are present.
 TEST_F(SslContextImplTest, CertDuplicatedSansAndCN) {
@@ -1844,6 +1871,48 @@ TEST_F(ClientContextConfigImplTest, StaticCertificateValidationContext) {
             client_context_config->certificateValidationContext()->caCert());
 }
 
+// Validate that client context configs only share session keys if they validate upstream
+// certificates the same way.
+TEST_F(ClientContextConfigImplTest, SessionCacheKey) {
+  const std::string yaml = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/selfsigned_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/selfsigned_key.pem"
+    validation_context:
+      trusted_ca: { filename: "{{ test_rundir }}/test/common/tls/test_data/ca_cert.pem" }
+  sni: "foo.com"
+  )EOF";
+  envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext tls_context;
+  TestUtility::loadFromYaml(TestEnvironment::substitute(yaml), tls_context);
+  auto client_context_config = *ClientContextConfigImpl::create(tls_context, factory_context_);
+  const absl::optional<uint64_t> key = client_context_config->sessionCacheKey();
+  ASSERT_TRUE(key.has_value());
+  EXPECT_EQ(key, (*ClientContextConfigImpl::create(tls_context, factory_context_))
+                     ->sessionCacheKey());
+
+  tls_context.set_sni("bar.com");
+  EXPECT_NE(key, (*ClientContextConfigImpl::create(tls_context, factory_context_))
+                     ->sessionCacheKey());
+
+  // A validation context provided by a secret may change without changing the config.
+  envoy::extensions::transport_sockets::tls::v3::Secret secret_config;
+  const std::string secret_yaml = R"EOF(
+  name: "def.com"
+  validation_context:
+    trusted_ca: { filename: "{{ test_rundir }}/test/common/tls/test_data/ca_cert.pem" }
+  )EOF";
+  TestUtility::loadFromYaml(TestEnvironment::substitute(secret_yaml), secret_config);
+  EXPECT_TRUE(factory_context_.secretManager().addStaticSecret(secret_config).ok());
+  tls_context.mutable_common_tls_context()
+      ->mutable_validation_context_sds_secret_config()
+      ->set_name("def.com");
+  EXPECT_EQ(absl::nullopt, (*ClientContextConfigImpl::create(tls_context, factory_context_))
+                               ->sessionCacheKey());
+}
+
 // Validate that constructor of client context config throws an exception when static TLS
 // certificate is missing.
 TEST_F(ClientContextConfigImplTest, MissingStaticSecretTlsCertificates) {
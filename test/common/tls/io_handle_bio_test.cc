@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <vector>
+
 #include "source/common/network/io_socket_error_impl.h"
 #include "source/common/tls/io_handle_bio.h"
 
@@ -8,6 +11,7 @@
 #include "openssl/ssl.h"
 
 using testing::_;
+using testing::Invoke;
 using testing::NiceMock;
 using testing::Return;
 
@@ -45,6 +49,71 @@ TEST_F(IoHandleBioTest, TestMiscApis) {
   EXPECT_EQ(ret, 1);
 }
 
+class IoHandleBioReadAheadTest : public testing::Test {
+public:
+  IoHandleBioReadAheadTest() { bio_ = BIO_new_io_handle(&io_handle_, true); }
+  ~IoHandleBioReadAheadTest() override { BIO_free(bio_); }
+
+  // Expects a socket read of the given size, which returns `available` bytes of 'a'.
+  void expectReadv(uint64_t max_length, uint64_t available) {
+    EXPECT_CALL(io_handle_, readv(max_length, _, 1))
+        .WillOnce(Invoke([available](uint64_t, Buffer::RawSlice* slices, uint64_t) {
+          const uint64_t length = std::min<uint64_t>(available, slices[0].len_);
+          memset(slices[0].mem_, 'a', length);
+          return Api::IoCallUint64Result(length, Api::IoError::none());
+        }));
+  }
+
+  BIO* bio_;
+  NiceMock<Network::MockIoHandle> io_handle_;
+};
+
+// Small reads are served from a single socket read.
+TEST_F(IoHandleBioReadAheadTest, SmallReadsShareSocketRead) {
+  expectReadv(16896, 100);
+  char out[64];
+  EXPECT_EQ(5, BIO_read(bio_, out, 5));
+  EXPECT_EQ(95U, BIO_pending(bio_));
+  EXPECT_EQ(64, BIO_read(bio_, out, 64));
+  EXPECT_EQ(31, BIO_read(bio_, out, 64));
+  EXPECT_EQ(0U, BIO_pending(bio_));
+
+  EXPECT_CALL(io_handle_, readv(_, _, 1))
+      .WillOnce(Return(testing::ByMove(
+          Api::IoCallUint64Result(0, Network::IoSocketError::getIoSocketEagainError()))));
+  EXPECT_EQ(-1, BIO_read(bio_, out, 5));
+  EXPECT_TRUE(BIO_should_retry(bio_));
+}
+
+// The size of the socket reads follows how much data the socket has.
+TEST_F(IoHandleBioReadAheadTest, AdaptiveSize) {
+  std::vector<char> out(128 * 1024);
+  expectReadv(16896, 16896);
+  EXPECT_EQ(16896, BIO_read(bio_, out.data(), 16000) + BIO_read(bio_, out.data(), 16000));
+  expectReadv(33792, 33792);
+  EXPECT_EQ(5, BIO_read(bio_, out.data(), 5));
+  EXPECT_EQ(33787, BIO_read(bio_, out.data(), out.size()));
+  expectReadv(67584, 100);
+  EXPECT_EQ(5, BIO_read(bio_, out.data(), 5));
+  EXPECT_EQ(95, BIO_read(bio_, out.data(), out.size()));
+  expectReadv(33792, 100);
+  EXPECT_EQ(5, BIO_read(bio_, out.data(), 5));
+}
+
+// Reads which are larger than the read-ahead buffer go to the socket directly.
+TEST_F(IoHandleBioReadAheadTest, LargeReadBypassesBuffer) {
+  std::vector<char> out(32 * 1024);
+  expectReadv(out.size(), 20000);
+  EXPECT_EQ(20000, BIO_read(bio_, out.data(), out.size()));
+  EXPECT_EQ(0U, BIO_pending(bio_));
+}
+
+TEST_F(IoHandleBioReadAheadTest, EndOfStream) {
+  expectReadv(16896, 0);
+  char out[5];
+  EXPECT_EQ(0, BIO_read(bio_, out, 5));
+}
+
 } // namespace Tls
 } // namespace TransportSockets
 } // namespace Extensions
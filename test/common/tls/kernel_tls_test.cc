@@ -0,0 +1,246 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "source/common/tls/kernel_tls.h"
+
+#include "test/common/tls/ssl_certs_test.h"
+#include "test/mocks/network/io_handle.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "openssl/aead.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace KernelTls {
+namespace {
+
+using ::testing::_;
+using ::testing::Return;
+
+constexpr uint8_t ApplicationDataRecordType = 23;
+
+class KernelTlsTest : public SslCertsTest {
+protected:
+  KernelTlsTest()
+      : client_ctx_(SSL_CTX_new(TLS_method())), server_ctx_(SSL_CTX_new(TLS_method())) {}
+
+  // Complete a handshake between a client and a server that are connected by a BIO pair, using
+  // the given protocol version and, for TLS 1.2, cipher suite.
+  void handshake(uint16_t version, const char* tls12_cipher = nullptr) {
+    for (SSL_CTX* ctx : {client_ctx_.get(), server_ctx_.get()}) {
+      ASSERT_TRUE(SSL_CTX_set_min_proto_version(ctx, version));
+      ASSERT_TRUE(SSL_CTX_set_max_proto_version(ctx, version));
+      if (tls12_cipher != nullptr) {
+        ASSERT_TRUE(SSL_CTX_set_strict_cipher_list(ctx, tls12_cipher));
+      }
+    }
+    ASSERT_TRUE(SSL_CTX_use_certificate_chain_file(
+        server_ctx_.get(), TestEnvironment::substitute(
+                               "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem")
+                               .c_str()));
+    ASSERT_TRUE(SSL_CTX_use_PrivateKey_file(
+        server_ctx_.get(),
+        TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem")
+            .c_str(),
+        SSL_FILETYPE_PEM));
+
+    client_ssl_.reset(SSL_new(client_ctx_.get()));
+    server_ssl_.reset(SSL_new(server_ctx_.get()));
+    SSL_set_connect_state(client_ssl_.get());
+    SSL_set_accept_state(server_ssl_.get());
+
+    BIO *client_bio, *server_bio;
+    ASSERT_EQ(1, BIO_new_bio_pair(&client_bio, BufferLength, &server_bio, BufferLength));
+    SSL_set_bio(client_ssl_.get(), client_bio, client_bio);
+    SSL_set_bio(server_ssl_.get(), server_bio, server_bio);
+
+    bool client_done = false;
+    bool server_done = false;
+    while (!client_done || !server_done) {
+      if (!client_done) {
+        const int rc = SSL_do_handshake(client_ssl_.get());
+        client_done = rc == 1;
+        ASSERT_TRUE(client_done || SSL_get_error(client_ssl_.get(), rc) == SSL_ERROR_WANT_READ);
+      }
+      if (!server_done) {
+        const int rc = SSL_do_handshake(server_ssl_.get());
+        server_done = rc == 1;
+        ASSERT_TRUE(server_done || SSL_get_error(server_ssl_.get(), rc) == SSL_ERROR_WANT_READ);
+      }
+    }
+  }
+
+  // Seal an application data record the way the kernel would from the server's write state and
+  // check that the client accepts it.
+  void expectClientDecrypts(const TxCryptoInfo& info, const std::string& plaintext) {
+    const EVP_AEAD* aead = nullptr;
+    switch (info.cipher_nid_) {
+    case NID_aes_128_gcm:
+      aead = EVP_aead_aes_128_gcm();
+      break;
+    case NID_aes_256_gcm:
+      aead = EVP_aead_aes_256_gcm();
+      break;
+    case NID_chacha20_poly1305:
+      aead = EVP_aead_chacha20_poly1305();
+      break;
+    }
+    ASSERT_NE(nullptr, aead);
+    bssl::ScopedEVP_AEAD_CTX ctx;
+    ASSERT_TRUE(EVP_AEAD_CTX_init(ctx.get(), aead, info.key_.data(), info.key_.size(),
+                                  EVP_AEAD_DEFAULT_TAG_LENGTH, nullptr));
+
+    uint8_t sequence[8];
+    for (int i = 0; i < 8; ++i) {
+      sequence[i] = static_cast<uint8_t>(info.sequence_ >> (8 * (7 - i)));
+    }
+
+    const bool explicit_nonce = info.version_ == TLS1_2_VERSION && info.iv_.size() == 4;
+    std::vector<uint8_t> nonce;
+    if (explicit_nonce) {
+      nonce.assign(info.iv_.begin(), info.iv_.end());
+      nonce.insert(nonce.end(), sequence, sequence + sizeof(sequence));
+    } else {
+      nonce = info.iv_;
+      for (int i = 0; i < 8; ++i) {
+        nonce[nonce.size() - 8 + i] ^= sequence[i];
+      }
+    }
+
+    std::vector<uint8_t> inner(plaintext.begin(), plaintext.end());
+    if (info.version_ == TLS1_3_VERSION) {
+      inner.push_back(ApplicationDataRecordType);
+    }
+    const size_t sealed_length = inner.size() + EVP_AEAD_max_overhead(aead);
+    const size_t record_length = sealed_length + (explicit_nonce ? sizeof(sequence) : 0);
+
+    std::vector<uint8_t> ad;
+    if (info.version_ == TLS1_3_VERSION) {
+      ad = {ApplicationDataRecordType, 0x03, 0x03, static_cast<uint8_t>(record_length >> 8),
+            static_cast<uint8_t>(record_length)};
+    } else {
+      ad.assign(sequence, sequence + sizeof(sequence));
+      ad.insert(ad.end(), {ApplicationDataRecordType, 0x03, 0x03,
+                           static_cast<uint8_t>(inner.size() >> 8),
+                           static_cast<uint8_t>(inner.size())});
+    }
+
+    std::vector<uint8_t> record = {ApplicationDataRecordType, 0x03, 0x03,
+                                   static_cast<uint8_t>(record_length >> 8),
+                                   static_cast<uint8_t>(record_length)};
+    if (explicit_nonce) {
+      record.insert(record.end(), sequence, sequence + sizeof(sequence));
+    }
+    const size_t header_length = record.size();
+    record.resize(header_length + sealed_length);
+    size_t out_length;
+    ASSERT_TRUE(EVP_AEAD_CTX_seal(ctx.get(), record.data() + header_length, &out_length,
+                                  sealed_length, nonce.data(), nonce.size(), inner.data(),
+                                  inner.size(), ad.data(), ad.size()));
+    ASSERT_EQ(sealed_length, out_length);
+
+    ASSERT_EQ(static_cast<int>(record.size()),
+              BIO_write(SSL_get_wbio(server_ssl_.get()), record.data(), record.size()));
+    std::string received(plaintext.size(), '\0');
+    ASSERT_EQ(static_cast<int>(plaintext.size()),
+              SSL_read(client_ssl_.get(), received.data(), received.size()));
+    EXPECT_EQ(plaintext, received);
+  }
+
+  static constexpr size_t BufferLength = 1 << 16;
+
+  bssl::UniquePtr<SSL_CTX> client_ctx_, server_ctx_;
+  bssl::UniquePtr<SSL> client_ssl_, server_ssl_;
+};
+
+TEST_F(KernelTlsTest, Tls12AesGcm) {
+  handshake(TLS1_2_VERSION, "ECDHE-RSA-AES128-GCM-SHA256");
+  auto info_or_error = txCryptoInfo(*server_ssl_);
+  ASSERT_TRUE(info_or_error.ok()) << info_or_error.status();
+  EXPECT_EQ(TLS1_2_VERSION, info_or_error->version_);
+  EXPECT_EQ(NID_aes_128_gcm, info_or_error->cipher_nid_);
+  EXPECT_EQ(16, info_or_error->key_.size());
+  EXPECT_EQ(4, info_or_error->iv_.size());
+  expectClientDecrypts(*info_or_error, "hello from the kernel");
+}
+
+TEST_F(KernelTlsTest, Tls12ChaCha20Poly1305) {
+  handshake(TLS1_2_VERSION, "ECDHE-RSA-CHACHA20-POLY1305");
+  auto info_or_error = txCryptoInfo(*server_ssl_);
+  ASSERT_TRUE(info_or_error.ok()) << info_or_error.status();
+  EXPECT_EQ(NID_chacha20_poly1305, info_or_error->cipher_nid_);
+  EXPECT_EQ(12, info_or_error->iv_.size());
+  expectClientDecrypts(*info_or_error, "hello from the kernel");
+}
+
+TEST_F(KernelTlsTest, Tls12SequenceNumber) {
+  handshake(TLS1_2_VERSION, "ECDHE-RSA-AES256-GCM-SHA384");
+  ASSERT_EQ(5, SSL_write(server_ssl_.get(), "hello", 5));
+  char buf[5];
+  ASSERT_EQ(5, SSL_read(client_ssl_.get(), buf, sizeof(buf)));
+
+  auto info_or_error = txCryptoInfo(*server_ssl_);
+  ASSERT_TRUE(info_or_error.ok()) << info_or_error.status();
+  EXPECT_EQ(NID_aes_256_gcm, info_or_error->cipher_nid_);
+  expectClientDecrypts(*info_or_error, "record written after one from BoringSSL");
+}
+
+#if !defined(OPENSSL_IS_AWSLC)
+TEST_F(KernelTlsTest, Tls13) {
+  handshake(TLS1_3_VERSION);
+  auto info_or_error = txCryptoInfo(*server_ssl_);
+  ASSERT_TRUE(info_or_error.ok()) << info_or_error.status();
+  EXPECT_EQ(TLS1_3_VERSION, info_or_error->version_);
+  EXPECT_EQ(12, info_or_error->iv_.size());
+  expectClientDecrypts(*info_or_error, "hello from the kernel");
+}
+#endif
+
+TEST_F(KernelTlsTest, UnsupportedCipher) {
+  handshake(TLS1_2_VERSION, "ECDHE-RSA-AES128-SHA");
+  auto info_or_error = txCryptoInfo(*server_ssl_);
+  EXPECT_EQ(absl::StatusCode::kInvalidArgument, info_or_error.status().code());
+}
+
+#if defined(__linux__)
+TEST_F(KernelTlsTest, SocketRejectsUlp) {
+  handshake(TLS1_2_VERSION, "ECDHE-RSA-AES128-GCM-SHA256");
+  BIO* wbio = SSL_get_wbio(server_ssl_.get());
+
+  Network::MockIoHandle io_handle;
+  EXPECT_CALL(io_handle, setOption(IPPROTO_TCP, _, _, _))
+      .WillOnce(Return(Api::SysCallIntResult{-1, ENOENT}));
+  const absl::Status status = enableTxOffload(*server_ssl_, io_handle);
+  EXPECT_EQ(absl::StatusCode::kUnavailable, status.code());
+  // BoringSSL keeps ownership of the write direction.
+  EXPECT_EQ(wbio, SSL_get_wbio(server_ssl_.get()));
+  expectClientDecrypts(*txCryptoInfo(*server_ssl_), "still readable");
+}
+
+TEST_F(KernelTlsTest, EnableReplacesWriteBio) {
+  handshake(TLS1_2_VERSION, "ECDHE-RSA-AES128-GCM-SHA256");
+  BIO* wbio = SSL_get_wbio(server_ssl_.get());
+
+  Network::MockIoHandle io_handle;
+  // Attaching the TLS ULP and installing the transmit keys.
+  EXPECT_CALL(io_handle, setOption(_, _, _, _))
+      .Times(2)
+      .WillRepeatedly(Return(Api::SysCallIntResult{0, 0}));
+  ASSERT_TRUE(enableTxOffload(*server_ssl_, io_handle).ok());
+  EXPECT_NE(wbio, SSL_get_wbio(server_ssl_.get()));
+  // Any write BoringSSL still attempts fails instead of bypassing the kernel.
+  EXPECT_GE(0, SSL_write(server_ssl_.get(), "hello", 5));
+}
+#endif
+
+} // namespace
+} // namespace KernelTls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
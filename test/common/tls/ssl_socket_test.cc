@@ -6512,7 +6512,8 @@ protected:
   }
 
   void readBufferLimitTest(uint32_t read_buffer_limit, uint32_t expected_chunk_size,
-                           uint32_t write_size, uint32_t num_writes, bool reserve_write_space) {
+                           uint32_t write_size, uint32_t num_writes, bool reserve_write_space,
+                           uint32_t fragment_size = 0) {
     initialize();
 
     EXPECT_CALL(listener_callbacks_, onAccept_(_))
@@ -6552,8 +6553,21 @@ protected:
           dispatcher_->exit();
         }));
 
+    const std::string fragment_data(write_size, 'a');
     for (uint32_t i = 0; i < num_writes; i++) {
-      Buffer::OwnedImpl data(std::string(write_size, 'a'));
+      Buffer::OwnedImpl data;
+      if (fragment_size > 0) {
+        // Build the write out of many small slices that cannot be coalesced.
+        for (uint32_t offset = 0; offset < write_size; offset += fragment_size) {
+          data.addBufferFragment(*new Buffer::BufferFragmentImpl(
+              fragment_data.data() + offset, std::min(fragment_size, write_size - offset),
+              [](const void*, size_t, const Buffer::BufferFragmentImpl* fragment) {
+                delete fragment;
+              }));
+        }
+      } else {
+        data.add(fragment_data);
+      }
 
       if (reserve_write_space) {
         data.appendSliceForTest(absl::string_view());
@@ -6694,6 +6708,11 @@ TEST_P(SslReadBufferLimitTest, NoLimitSmallWrites) {
   readBufferLimitTest(0, 256 * 1024, 1, 256 * 1024, false);
 }
 
+// Writes made of many small slices are gathered into full TLS records.
+TEST_P(SslReadBufferLimitTest, NoLimitFragmentedWrites) {
+  readBufferLimitTest(0, 256 * 1024, 256 * 1024, 1, false, 100);
+}
+
 TEST_P(SslReadBufferLimitTest, SomeLimit) {
   readBufferLimitTest(32 * 1024, 32 * 1024, 256 * 1024, 1, false);
 }
@@ -22,6 +22,7 @@ namespace Upstream {
 namespace {
 
 using testing::_;
+using testing::ReturnPointee;
 
 using ClusterType = absl::variant<envoy::config::cluster::v3::Cluster::DiscoveryType,
                                   envoy::config::cluster::v3::Cluster::CustomClusterType>;
@@ -214,6 +215,58 @@ TEST_P(StaticClusterTest, CdsStaticClustersAreDeferredInitialized) {
   EXPECT_EQ(readGauge("thread_local_cluster_manager.test_thread.clusters_inflated"), 1);
 }
 
+// Test that inflated clusters are evicted once idle and can be initialized again.
+TEST_P(StaticClusterTest, IdleClustersAreEvicted) {
+  const std::string yaml = R"EOF(
+    cluster_manager:
+      deferred_cluster_idle_timeout: 10s
+    static_resources:
+      clusters:
+      - name: cluster_1
+        connect_timeout: 0.250s
+        lb_policy: ROUND_ROBIN
+        load_assignment:
+          cluster_name: cluster_1
+          endpoints:
+          - lb_endpoints:
+            - endpoint:
+                address:
+                  socket_address:
+                    address: 127.0.0.1
+                    port_value: 11001
+    )EOF";
+
+  auto bootstrap = parseBootstrapFromV3YamlEnableDeferredCluster(yaml);
+  MonotonicTime now{std::chrono::seconds(1)};
+  ON_CALL(factory_.tls_.dispatcher_, approximateMonotonicTime())
+      .WillByDefault(ReturnPointee(&now));
+  auto* idle_timer = new NiceMock<Event::MockTimer>(&factory_.tls_.dispatcher_);
+  EXPECT_CALL(*idle_timer, enableTimer(std::chrono::milliseconds(10000), _)).Times(3);
+  create(bootstrap);
+
+  EXPECT_NE(nullptr, cluster_manager_->getThreadLocalCluster("cluster_1"));
+  EXPECT_EQ(readGauge("thread_local_cluster_manager.test_thread.clusters_inflated"), 1);
+
+  // Still in use.
+  now += std::chrono::seconds(5);
+  EXPECT_NE(nullptr, cluster_manager_->getThreadLocalCluster("cluster_1"));
+  now += std::chrono::seconds(6);
+  idle_timer->invokeCallback();
+  EXPECT_EQ(readGauge("thread_local_cluster_manager.test_thread.clusters_inflated"), 1);
+
+  now += std::chrono::seconds(10);
+  EXPECT_LOG_CONTAINS("debug", "evicting idle TLS cluster cluster_1", idle_timer->invokeCallback());
+  EXPECT_EQ(readGauge("thread_local_cluster_manager.test_thread.clusters_inflated"), 0);
+  EXPECT_EQ(1UL,
+            TestUtility::findCounter(factory_.stats_,
+                                     "thread_local_cluster_manager.test_thread.clusters_evicted")
+                ->value());
+
+  EXPECT_LOG_CONTAINS("debug", "initializing TLS cluster cluster_1 inline",
+                      cluster_manager_->getThreadLocalCluster("cluster_1"));
+  EXPECT_EQ(readGauge("thread_local_cluster_manager.test_thread.clusters_inflated"), 1);
+}
+
 // Test that we can merge deferred cds cluster configuration.
 TEST_P(StaticClusterTest, MergeStaticCdsClusterUpdates) {
   const std::string bootstrap_yaml = R"EOF(
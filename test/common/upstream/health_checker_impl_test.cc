@@ -19,6 +19,7 @@
 #include "source/common/json/json_loader.h"
 #include "source/common/network/utility.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/singleton/manager_impl.h"
 #include "source/common/upstream/health_checker_impl.h"
 #include "source/common/upstream/upstream_impl.h"
 #include "source/extensions/health_checkers/grpc/health_checker_impl.h"
@@ -4644,6 +4645,97 @@ TEST_F(TcpHealthCheckerImplTest, NoData) {
   interval_timer_->invokeCallback();
 }
 
+// The session of a host that is in another cluster with the same health check follows the
+// results of the session probing it, and takes over when the probing session is removed.
+TEST_F(TcpHealthCheckerImplTest, ShareAcrossClusters) {
+  InSequence s;
+
+  const std::string yaml = R"EOF(
+    timeout: 1s
+    interval: 1s
+    unhealthy_threshold: 2
+    healthy_threshold: 2
+    share_across_clusters: true
+    tcp_health_check: {}
+    )EOF";
+  Singleton::ManagerImpl singleton_manager;
+  allocHealthChecker(yaml);
+  health_checker_->shareSessions(singleton_manager);
+  auto other_cluster = std::make_shared<NiceMock<MockClusterMockPrioritySet>>();
+  auto other_health_checker = std::make_shared<TcpHealthCheckerImpl>(
+      *other_cluster, parseHealthCheckFromV3Yaml(yaml), dispatcher_, runtime_, random_,
+      std::make_unique<NiceMock<MockHealthCheckEventLogger>>());
+  other_health_checker->shareSessions(singleton_manager);
+
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster_->info_, "tcp://127.0.0.1:80", simTime())};
+  other_cluster->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(other_cluster->info_, "tcp://127.0.0.1:80", simTime())};
+  expectSessionCreate();
+  expectClientCreate();
+  EXPECT_CALL(*timeout_timer_, enableTimer(_, _));
+  health_checker_->start();
+
+  // The other session doesn't connect to the host.
+  other_cluster->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagSet(
+      Host::HealthFlag::FAILED_ACTIVE_HC);
+  auto* other_interval_timer = new Event::MockTimer(&dispatcher_);
+  auto* other_timeout_timer = new Event::MockTimer(&dispatcher_);
+  other_health_checker->start();
+
+  // The result of the probe applies to both hosts.
+  EXPECT_CALL(*connection_, close(Network::ConnectionCloseType::Abort));
+  EXPECT_CALL(*timeout_timer_, disableTimer());
+  EXPECT_CALL(*interval_timer_, enableTimer(_, _));
+  EXPECT_CALL(*other_timeout_timer, disableTimer()).Times(0);
+  EXPECT_CALL(*other_interval_timer, enableTimer(_, _)).Times(0);
+  connection_->raiseEvent(Network::ConnectionEvent::Connected);
+  EXPECT_EQ(Host::Health::Healthy,
+            other_cluster->prioritySet().getMockHostSet(0)->hosts_[0]->coarseHealth());
+  EXPECT_EQ(1UL, cluster_->info_->stats_store_.counter("health_check.attempt").value());
+  EXPECT_EQ(0UL, other_cluster->info_->stats_store_.counter("health_check.attempt").value());
+  EXPECT_EQ(1UL, other_cluster->info_->stats_store_.counter("health_check.success").value());
+
+  // Removing the probing session makes the other session probe the host.
+  HostVector removed{cluster_->prioritySet().getMockHostSet(0)->hosts_.back()};
+  cluster_->prioritySet().getMockHostSet(0)->hosts_.clear();
+  EXPECT_CALL(*other_interval_timer, enableTimer(_, _));
+  cluster_->prioritySet().getMockHostSet(0)->runCallbacks({}, removed);
+
+  expectClientCreate();
+  EXPECT_CALL(*other_timeout_timer, enableTimer(_, _));
+  other_interval_timer->invokeCallback();
+  EXPECT_CALL(*connection_, close(Network::ConnectionCloseType::Abort));
+  EXPECT_CALL(*other_timeout_timer, disableTimer());
+  EXPECT_CALL(*other_interval_timer, enableTimer(_, _));
+  connection_->raiseEvent(Network::ConnectionEvent::Connected);
+  EXPECT_EQ(2UL, other_cluster->info_->stats_store_.counter("health_check.success").value());
+}
+
+// The first checks of hosts added together are spread evenly over the interval.
+TEST_F(TcpHealthCheckerImplTest, SpreadInitialChecks) {
+  InSequence s;
+
+  allocHealthChecker(R"EOF(
+    timeout: 1s
+    interval: 1s
+    unhealthy_threshold: 2
+    healthy_threshold: 2
+    spread_initial_checks: true
+    tcp_health_check: {}
+    )EOF");
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster_->info_, "tcp://127.0.0.1:80", simTime()),
+      makeTestHost(cluster_->info_, "tcp://127.0.0.1:81", simTime())};
+  expectSessionCreate();
+  expectClientCreate();
+  EXPECT_CALL(*timeout_timer_, enableTimer(_, _));
+  auto* second_interval_timer = new Event::MockTimer(&dispatcher_);
+  new Event::MockTimer(&dispatcher_);
+  EXPECT_CALL(*second_interval_timer, enableTimer(std::chrono::milliseconds(500), _));
+  health_checker_->start();
+}
+
 TEST_F(TcpHealthCheckerImplTest, PassiveFailure) {
   InSequence s;
 
@@ -2745,15 +2745,14 @@ TEST(OutlierDetectionEventLoggerImplTest, All) {
 }
 
 TEST(OutlierUtility, SRThreshold) {
-  std::vector<HostSuccessRatePair> data = {
-      HostSuccessRatePair(nullptr, 50),  HostSuccessRatePair(nullptr, 100),
-      HostSuccessRatePair(nullptr, 100), HostSuccessRatePair(nullptr, 100),
-      HostSuccessRatePair(nullptr, 100),
-  };
-  double sum = 450;
+  SuccessRateStatistics statistics;
+  for (double success_rate : {50, 100, 100, 100, 100}) {
+    statistics.add(success_rate);
+  }
+  EXPECT_EQ(5U, statistics.count());
 
   DetectorImpl::EjectionPair success_rate_nums =
-      DetectorImpl::successRateEjectionThreshold(sum, data, 1.9);
+      DetectorImpl::successRateEjectionThreshold(statistics, 1.9);
   EXPECT_EQ(90.0, success_rate_nums.success_rate_average_); // average success rate
   EXPECT_EQ(52.0, success_rate_nums.ejection_threshold_);   //  ejection threshold
 }
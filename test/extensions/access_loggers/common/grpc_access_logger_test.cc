@@ -197,8 +197,7 @@ TEST_F(StreamingGrpcAccessLogTest, BasicFlow) {
   expectFlushedLogEntriesCount(stream, MOCK_TCP_LOG_FIELD_NAME, 1);
   logger_->log(ProtobufWkt::Empty());
   EXPECT_EQ(2, logger_->numClears());
-  // TCP logging doesn't change the logs_written counter.
-  EXPECT_EQ(1,
+  EXPECT_EQ(2,
             TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_written")->value());
 
   // Verify that sending an empty response message doesn't do anything bad.
@@ -216,7 +215,7 @@ TEST_F(StreamingGrpcAccessLogTest, BasicFlow) {
   EXPECT_EQ(3, logger_->numClears());
   EXPECT_EQ(0,
             TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_dropped")->value());
-  EXPECT_EQ(2,
+  EXPECT_EQ(3,
             TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_written")->value());
 }
 
@@ -267,6 +266,32 @@ TEST_F(StreamingGrpcAccessLogTest, WatermarksOverrun) {
             TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_dropped")->value());
 }
 
+// TCP entries are dropped too while the stream is backed up.
+TEST_F(StreamingGrpcAccessLogTest, TcpWatermarksOverrun) {
+  InSequence s;
+  initLogger(FlushInterval, 1);
+
+  MockAccessLogStream stream;
+  AccessLogCallbacks* callbacks;
+  expectStreamStart(stream, &callbacks);
+
+  // Fail to flush, so the log stays buffered up.
+  EXPECT_CALL(stream, isAboveWriteBufferHighWatermark()).WillOnce(Return(true));
+  EXPECT_CALL(stream, sendMessageRaw_(_, false)).Times(0);
+  logger_->log(mockHttpEntry());
+  EXPECT_EQ(0, logger_->numClears());
+
+  // The TCP entry is dropped rather than buffered.
+  EXPECT_CALL(stream, isAboveWriteBufferHighWatermark()).WillOnce(Return(true));
+  EXPECT_CALL(stream, sendMessageRaw_(_, _)).Times(0);
+  logger_->log(ProtobufWkt::Empty());
+  EXPECT_EQ(0, logger_->numClears());
+  EXPECT_EQ(1,
+            TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_written")->value());
+  EXPECT_EQ(1,
+            TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_dropped")->value());
+}
+
 // Test that stream failure is handled correctly.
 TEST_F(StreamingGrpcAccessLogTest, StreamFailure) {
   initLogger(FlushInterval, 0);
@@ -420,8 +445,7 @@ TEST_F(UnaryGrpcAccessLogTest, BasicFlow) {
   // Message should be initialized and cleared every time a request is sent.
   EXPECT_EQ(2, logger_->numInits());
   EXPECT_EQ(2, logger_->numClears());
-  // TCP logging doesn't change the logs_written counter.
-  EXPECT_EQ(1,
+  EXPECT_EQ(2,
             TestUtility::findCounter(stats_store_, "mock_access_log_prefix.logs_written")->value());
   // No dropped logs expected.
   EXPECT_EQ(0,
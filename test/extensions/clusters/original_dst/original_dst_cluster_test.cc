@@ -313,6 +313,40 @@ TEST_F(OriginalDstClusterTest, AddressCollision) {
   EXPECT_EQ(1UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
 }
 
+// A load balancer reuses the host it created for an address until the host is in its host map.
+TEST_F(OriginalDstClusterTest, PendingHostReused) {
+  std::string yaml = R"EOF(
+    name: name
+    connect_timeout: 1.250s
+    type: ORIGINAL_DST
+    lb_policy: CLUSTER_PROVIDED
+  )EOF";
+
+  EXPECT_CALL(initialized_, ready());
+  setupFromYaml(yaml);
+
+  NiceMock<Network::MockConnection> connection;
+  TestLoadBalancerContext lb_context(&connection);
+  connection.stream_info_.downstream_connection_info_provider_->restoreLocalAddress(
+      std::make_shared<Network::Address::Ipv4Instance>("10.10.11.11"));
+
+  OriginalDstCluster::LoadBalancer lb(handle_);
+  Event::PostCb post_cb;
+  EXPECT_CALL(server_context_.dispatcher_, post(_)).WillOnce([&post_cb](Event::PostCb cb) {
+    post_cb = std::move(cb);
+  });
+  HostConstSharedPtr host1 = lb.chooseHost(&lb_context).host;
+  ASSERT_NE(host1, nullptr);
+  // The second choice neither creates nor posts another host.
+  HostConstSharedPtr host2 = lb.chooseHost(&lb_context).host;
+  EXPECT_EQ(host1, host2);
+
+  EXPECT_CALL(membership_updated_, ready());
+  post_cb();
+  EXPECT_EQ(1UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+  EXPECT_EQ(host1, OriginalDstCluster::LoadBalancer(handle_).chooseHost(&lb_context).host);
+}
+
 TEST_F(OriginalDstClusterTest, HostInUse) {
   std::string yaml = R"EOF(
     name: name
@@ -394,6 +394,47 @@ TEST_F(RedisClusterLoadBalancerTest, ClusterSlotUpdate) {
   validateAssignment(hosts, updated_assignments);
 }
 
+// A load balancer keeps routing with the topology it was created with, which is not torn by
+// later updates.
+TEST_F(RedisClusterLoadBalancerTest, ClusterSlotUpdateKeepsCreatedLoadBalancer) {
+  Upstream::HostVector hosts{Upstream::makeTestHost(info_, "tcp://127.0.0.1:90", simTime()),
+                             Upstream::makeTestHost(info_, "tcp://127.0.0.1:91", simTime())};
+  Upstream::HostMap all_hosts{{hosts[0]->address()->asString(), hosts[0]},
+                              {hosts[1]->address()->asString(), hosts[1]}};
+  init();
+  EXPECT_EQ(true, factory_->onClusterSlotUpdate(
+                      std::make_unique<std::vector<ClusterSlot>>(std::vector<ClusterSlot>{
+                          ClusterSlot(0, 16383, hosts[0]->address())}),
+                      all_hosts));
+  Upstream::LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+
+  EXPECT_EQ(true, factory_->onClusterSlotUpdate(
+                      std::make_unique<std::vector<ClusterSlot>>(std::vector<ClusterSlot>{
+                          ClusterSlot(0, 1000, hosts[1]->address()),
+                          ClusterSlot(1001, 16383, hosts[0]->address())}),
+                      all_hosts));
+  factory_->onHostHealthUpdate();
+
+  TestLoadBalancerContext context(100);
+  EXPECT_EQ(hosts[0]->address()->asString(), lb->chooseHost(&context).host->address()->asString());
+  validateAssignment(hosts, {{100, 1}, {1100, 0}});
+}
+
+// Slot ranges outside of the key space are ignored.
+TEST_F(RedisClusterLoadBalancerTest, ClusterSlotOutOfRange) {
+  Upstream::HostVector hosts{Upstream::makeTestHost(info_, "tcp://127.0.0.1:90", simTime()),
+                             Upstream::makeTestHost(info_, "tcp://127.0.0.1:91", simTime())};
+  Upstream::HostMap all_hosts{{hosts[0]->address()->asString(), hosts[0]},
+                              {hosts[1]->address()->asString(), hosts[1]}};
+  init();
+  EXPECT_EQ(true, factory_->onClusterSlotUpdate(
+                      std::make_unique<std::vector<ClusterSlot>>(std::vector<ClusterSlot>{
+                          ClusterSlot(0, 16383, hosts[0]->address()),
+                          ClusterSlot(16000, 16384, hosts[1]->address())}),
+                      all_hosts));
+  validateAssignment(hosts, {{100, 0}, {16100, 0}});
+}
+
 TEST_F(RedisClusterLoadBalancerTest, ClusterSlotNoUpdate) {
   Upstream::HostVector hosts{Upstream::makeTestHost(info_, "tcp://127.0.0.1:90", simTime()),
                              Upstream::makeTestHost(info_, "tcp://127.0.0.1:91", simTime()),
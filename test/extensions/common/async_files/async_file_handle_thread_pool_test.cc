@@ -384,6 +384,30 @@ TEST_F(AsyncFileHandleWithMockPosixTest, PartialWriteRetries) {
   close(handle);
 }
 
+TEST_F(AsyncFileHandleWithMockPosixTest, MultipleSlicesAreWrittenTogether) {
+  auto handle = createAnonymousFile();
+  Buffer::OwnedImpl write_value;
+  write_value.appendSliceForTest("hel");
+  write_value.appendSliceForTest("lo world");
+  EXPECT_CALL(mock_posix_file_operations_, pwritev(_, _, 2, 0))
+      .WillOnce([](int, const iovec* iov, int, off_t) {
+        EXPECT_EQ("hel", absl::string_view(static_cast<const char*>(iov[0].iov_base),
+                                           iov[0].iov_len));
+        EXPECT_EQ("lo world", absl::string_view(static_cast<const char*>(iov[1].iov_base),
+                                                iov[1].iov_len));
+        return Api::SysCallSizeResult{4, 0};
+      });
+  EXPECT_CALL(mock_posix_file_operations_, pwrite(_, IsMemoryMatching("o world"), 7, 4))
+      .WillOnce(Return(Api::SysCallSizeResult{7, 0}));
+  absl::StatusOr<size_t> write_status;
+  EXPECT_OK(handle->write(dispatcher_.get(), write_value, 0, [&](absl::StatusOr<size_t> status) {
+    write_status = std::move(status.value());
+  }));
+  resolveFileActions();
+  EXPECT_THAT(write_status, IsOkAndHolds(11U));
+  close(handle);
+}
+
 TEST_F(AsyncFileHandleWithMockPosixTest, TruncateReturnsErrorOnTruncatingToLargerThanFile) {
   AsyncFileHandle handle = createAnonymousFile();
   absl::Status truncate_status;
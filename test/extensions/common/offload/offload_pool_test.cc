@@ -0,0 +1,120 @@
+#include <memory>
+
+#include "source/common/singleton/manager_impl.h"
+#include "source/extensions/common/offload/offload_pool.h"
+
+#include "test/test_common/utility.h"
+
+#include "absl/synchronization/notification.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace Offload {
+namespace {
+
+class OffloadPoolTest : public testing::Test {
+public:
+  OffloadPoolTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")) {}
+
+  // Submits a task whose work blocks until release_ is notified.
+  void submitBlockingTask(OffloadPool& pool) {
+    ASSERT_TRUE(pool.submit(
+                        *dispatcher_,
+                        [this]() {
+                          started_.Notify();
+                          release_.WaitForNotification();
+                        },
+                        []() {})
+                    .has_value());
+    started_.WaitForNotification();
+  }
+
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  absl::Notification started_;
+  absl::Notification release_;
+};
+
+TEST_F(OffloadPoolTest, CompletionRunsOnDispatcher) {
+  OffloadPool pool(api_->threadFactory(), 2, 4);
+  Thread::ThreadId work_thread;
+  Thread::ThreadId completion_thread;
+  ASSERT_TRUE(pool.submit(
+                      *dispatcher_,
+                      [&]() { work_thread = api_->threadFactory().currentThreadId(); },
+                      [&]() {
+                        completion_thread = api_->threadFactory().currentThreadId();
+                        dispatcher_->exit();
+                      })
+                  .has_value());
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  EXPECT_EQ(api_->threadFactory().currentThreadId(), completion_thread);
+  EXPECT_FALSE(work_thread.isEmpty());
+  EXPECT_NE(completion_thread, work_thread);
+}
+
+TEST_F(OffloadPoolTest, CancelledTaskDoesntRun) {
+  OffloadPool pool(api_->threadFactory(), 1, 4);
+  submitBlockingTask(pool);
+
+  bool cancelled_ran = false;
+  auto cancel = pool.submit(
+      *dispatcher_, [&]() { cancelled_ran = true; }, [&]() { cancelled_ran = true; });
+  ASSERT_TRUE(cancel.has_value());
+  (*cancel)();
+  ASSERT_TRUE(pool.submit(
+                      *dispatcher_, []() {}, [this]() { dispatcher_->exit(); })
+                  .has_value());
+  release_.Notify();
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  // Tasks run in order on the single thread, so the cancelled one was skipped.
+  EXPECT_FALSE(cancelled_ran);
+}
+
+TEST_F(OffloadPoolTest, CancelAfterWorkSkipsCompletion) {
+  OffloadPool pool(api_->threadFactory(), 1, 4);
+  bool completion_ran = false;
+  absl::Notification work_done;
+  auto cancel = pool.submit(
+      *dispatcher_, [&]() { work_done.Notify(); }, [&]() { completion_ran = true; });
+  ASSERT_TRUE(cancel.has_value());
+  work_done.WaitForNotification();
+  (*cancel)();
+  ASSERT_TRUE(pool.submit(
+                      *dispatcher_, []() {}, [this]() { dispatcher_->exit(); })
+                  .has_value());
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  EXPECT_FALSE(completion_ran);
+}
+
+TEST_F(OffloadPoolTest, SaturatedPoolRejectsTasks) {
+  OffloadPool pool(api_->threadFactory(), 1, 1);
+  submitBlockingTask(pool);
+
+  EXPECT_TRUE(pool.submit(
+                      *dispatcher_, []() {}, []() {})
+                  .has_value());
+  EXPECT_EQ(1, pool.queued());
+  EXPECT_FALSE(pool.submit(
+                       *dispatcher_, []() {}, []() {})
+                   .has_value());
+  release_.Notify();
+}
+
+TEST_F(OffloadPoolTest, Singleton) {
+  Singleton::ManagerImpl singleton_manager;
+  OffloadPoolSharedPtr pool = OffloadPool::singleton(singleton_manager, api_->threadFactory());
+  EXPECT_EQ(pool, OffloadPool::singleton(singleton_manager, api_->threadFactory()));
+}
+
+} // namespace
+} // namespace Offload
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
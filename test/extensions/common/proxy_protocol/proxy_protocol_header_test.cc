@@ -208,6 +208,11 @@ TEST(ProxyProtocolHeaderTest, GeneratesV2WithTLVExceedingLengthLimit) {
 
   EXPECT_LOG_CONTAINS("warn", "Skipping TLV type 5 because adding it would exceed the 65535 limit",
                       generateV2Header(proxy_proto_data, buff, true, {}, {}));
+
+  // The skipped TLV is not written either.
+  Buffer::OwnedImpl expected_buff;
+  generateV2Header(*src_addr->ip(), *dst_addr->ip(), expected_buff);
+  EXPECT_TRUE(TestUtility::buffersEqual(expected_buff, buff));
 }
 
 TEST(ProxyProtocolHeaderTest, GeneratesV2WithCustomTLVs) {
@@ -204,6 +204,36 @@ TEST(TypedExtensionConfigTest, AddTestConfigHttpContext) {
   TestConfigImpl(tap_config, nullptr, factory_context);
 }
 
+TEST(TypedExtensionConfigTest, TapEnabled) {
+  const std::string tap_config_yaml =
+      R"EOF(
+  match:
+    any_match: true
+  output_config:
+    sinks:
+      - file_per_tap:
+          path_prefix: /tmp/tap
+)EOF";
+  envoy::config::tap::v3::TapConfig tap_config;
+  TestUtility::loadFromYaml(tap_config_yaml, tap_config);
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  auto& snapshot = factory_context.server_factory_context_.runtime_loader_.snapshot_;
+
+  // Every stream is tapped when tap_enabled is not set.
+  EXPECT_TRUE(TestConfigImpl(tap_config, nullptr, factory_context).tapEnabled());
+
+  tap_config.mutable_tap_enabled()->set_runtime_key("tap.enabled");
+  tap_config.mutable_tap_enabled()->mutable_default_value()->set_numerator(10);
+  TestConfigImpl config(tap_config, nullptr, factory_context);
+  EXPECT_CALL(snapshot, featureEnabled("tap.enabled",
+                                       testing::Matcher<const envoy::type::v3::FractionalPercent&>(
+                                           ProtoEq(tap_config.tap_enabled().default_value()))))
+      .WillOnce(Return(false))
+      .WillOnce(Return(true));
+  EXPECT_FALSE(config.tapEnabled());
+  EXPECT_TRUE(config.tapEnabled());
+}
+
 TEST(TypedExtensionConfigTest, AddTestConfigTransportSocketContext) {
   const std::string tap_config_yaml =
       R"EOF(
@@ -0,0 +1,94 @@
+#include <memory>
+#include <string>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/common/offload/offload_pool.h"
+#include "source/extensions/compression/common/compressor/offloaded_compressor.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Common {
+namespace Compressor {
+namespace {
+
+using Envoy::Compression::Compressor::State;
+
+// Appends the state to the data instead of compressing it.
+class TestCompressor : public Envoy::Compression::Compressor::Compressor {
+public:
+  void compress(Buffer::Instance& buffer, State state) override {
+    buffer.add(state == State::Finish ? "|finish" : "|flush");
+  }
+};
+
+class OffloadedCompressorTest : public testing::Test {
+public:
+  OffloadedCompressorTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")) {}
+
+  std::unique_ptr<OffloadedCompressor> makeCompressor(uint32_t max_queued) {
+    pool_ = std::make_shared<Extensions::Common::Offload::OffloadPool>(api_->threadFactory(), 1,
+                                                                       max_queued);
+    return std::make_unique<OffloadedCompressor>(std::make_unique<TestCompressor>(), pool_,
+                                                 *dispatcher_);
+  }
+
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  Extensions::Common::Offload::OffloadPoolSharedPtr pool_;
+};
+
+TEST_F(OffloadedCompressorTest, CompressesChunksInOrder) {
+  auto compressor = makeCompressor(4);
+  std::string compressed;
+  Buffer::OwnedImpl data("abc");
+  compressor->compress(data, State::Flush, [&](Buffer::InstancePtr chunk) {
+    compressed += chunk->toString();
+    Buffer::OwnedImpl next("def");
+    compressor->compress(next, State::Finish, [&](Buffer::InstancePtr chunk) {
+      compressed += chunk->toString();
+      dispatcher_->exit();
+    });
+    EXPECT_EQ(0, next.length());
+  });
+  EXPECT_EQ(0, data.length());
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  EXPECT_EQ("abc|flushdef|finish", compressed);
+}
+
+TEST_F(OffloadedCompressorTest, SaturatedPoolCompressesInline) {
+  auto compressor = makeCompressor(0);
+  std::string compressed;
+  Buffer::OwnedImpl data("abc");
+  compressor->compress(data, State::Finish,
+                       [&](Buffer::InstancePtr chunk) { compressed = chunk->toString(); });
+  // The callback is still called asynchronously.
+  EXPECT_EQ("", compressed);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+
+  EXPECT_EQ("abc|finish", compressed);
+}
+
+TEST_F(OffloadedCompressorTest, DestroyCancelsCompression) {
+  auto compressor = makeCompressor(0);
+  bool done = false;
+  Buffer::OwnedImpl data("abc");
+  compressor->compress(data, State::Flush, [&](Buffer::InstancePtr) { done = true; });
+  compressor.reset();
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+
+  EXPECT_FALSE(done);
+}
+
+} // namespace
+} // namespace Compressor
+} // namespace Common
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
@@ -326,6 +326,30 @@ TEST_F(ZlibDecompressorImplTest, CompressDecompressOfMultipleSlices) {
   EXPECT_EQ(original_text, decompressed_text);
 }
 
+// The decompressed data is appended to whatever the output buffer already holds.
+TEST_F(ZlibDecompressorImplTest, DecompressAppendsToOutputBuffer) {
+  Buffer::OwnedImpl buffer;
+  TestUtility::feedBufferWithRandomCharacters(buffer, 10 * default_input_size);
+  const std::string original_text = buffer.toString();
+
+  Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl compressor;
+  compressor.init(
+      Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionLevel::Standard,
+      Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionStrategy::Standard,
+      gzip_window_bits, memory_level);
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+
+  ZlibDecompressorImpl decompressor{stats_scope_, "test.", 16, 100};
+  decompressor.init(gzip_window_bits);
+
+  Buffer::OwnedImpl output_buffer("prefix");
+  decompressor.decompress(buffer, output_buffer);
+
+  EXPECT_EQ("prefix" + original_text, output_buffer.toString());
+  ASSERT_EQ(compressor.checksum(), decompressor.checksum());
+  ASSERT_EQ(0, decompressor.decompression_error_);
+}
+
 class ZlibDecompressorStatsTest : public testing::Test {
 protected:
   void chargeErrorStats(const int result) { decompressor_.chargeErrorStats(result); }
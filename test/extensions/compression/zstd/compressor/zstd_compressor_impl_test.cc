@@ -1,4 +1,5 @@
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/hex.h"
 #include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/compression/zstd/compressor/config.h"
 #include "source/extensions/compression/zstd/decompressor/zstd_decompressor_impl.h"
@@ -105,6 +106,16 @@ TEST_F(ZstdCompressorImplTest, CompressWitHugeBuffer) {
   verifyWithDecompressor(std::move(compressor));
 }
 
+TEST_F(ZstdCompressorImplTest, LowEffortCompressor) {
+  envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
+  zstd.mutable_compression_level()->set_value(19);
+  Zstd::Compressor::ZstdCompressorLibraryFactory lib_factory;
+  NiceMock<Server::Configuration::MockFactoryContext> mock_context;
+  auto factory = lib_factory.createCompressorFactoryFromProto(zstd, mock_context);
+
+  verifyWithDecompressor(factory->createLowEffortCompressor());
+}
+
 TEST_F(ZstdCompressorImplTest, IllegalConfig) {
   envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
   Zstd::Compressor::ZstdCompressorLibraryFactory lib_factory;
@@ -138,6 +149,61 @@ TEST_F(ZstdCompressorImplTest, IllegalConfig) {
                "assert failure: id != 0. Details: Illegal Zstd dictionary");
 }
 
+TEST_F(ZstdCompressorImplTest, SharedDictionary) {
+  envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
+  TestUtility::loadFromJson(R"EOF({
+  "shared_dictionary": true,
+  "dictionary": {
+    "inline_string": "abc"
+  }
+})EOF",
+                            zstd);
+  Zstd::Compressor::ZstdCompressorLibraryFactory lib_factory;
+  NiceMock<Server::Configuration::MockFactoryContext> mock_context;
+  auto factory = lib_factory.createCompressorFactoryFromProto(zstd, mock_context);
+  EXPECT_EQ("dcz", factory->contentEncoding());
+  // The base64 of the SHA-256 hash of "abc".
+  EXPECT_EQ(":ungWv48Bz+pBQUDeXa4iI7ADYaOWF3qctBD/YfIAFa0=:", factory->sharedDictionaryHash());
+
+  const std::string original_text = "abcabcabc, and then some more abc";
+  Buffer::OwnedImpl buffer(original_text);
+  factory->createCompressor()->compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  const std::string compressed = buffer.toString();
+
+  // The stream opens with a skippable frame holding the hash of the dictionary.
+  ASSERT_GT(compressed.size(), 40);
+  EXPECT_EQ(std::string("\x5e\x2a\x4d\x18\x20\x00\x00\x00", 8), compressed.substr(0, 8));
+  const std::vector<uint8_t> digest =
+      Hex::decode("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  EXPECT_EQ(std::string(digest.begin(), digest.end()), compressed.substr(8, 32));
+
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+  std::string decompressed(original_text.size(), '\0');
+  const size_t size =
+      ZSTD_decompress_usingDict(dctx.get(), decompressed.data(), decompressed.size(),
+                                compressed.data(), compressed.size(), "abc", 3);
+  ASSERT_FALSE(ZSTD_isError(size));
+  EXPECT_EQ(original_text, decompressed.substr(0, size));
+}
+
+TEST_F(ZstdCompressorImplTest, IllegalSharedDictionaryConfig) {
+  envoy::extensions::compression::zstd::compressor::v3::Zstd zstd;
+  Zstd::Compressor::ZstdCompressorLibraryFactory lib_factory;
+  NiceMock<Server::Configuration::MockFactoryContext> mock_context;
+
+  zstd.set_shared_dictionary(true);
+  EXPECT_THROW_WITH_MESSAGE(lib_factory.createCompressorFactoryFromProto(zstd, mock_context),
+                            EnvoyException, "zstd shared_dictionary requires a dictionary");
+
+  // Trained dictionaries start with the zstd dictionary magic number followed by their id.
+  zstd.mutable_dictionary()->set_inline_bytes(
+      std::string("\x37\xa4\x30\xec\x01\x00\x00\x00", 8));
+  EXPECT_THROW_WITH_MESSAGE(lib_factory.createCompressorFactoryFromProto(zstd, mock_context),
+                            EnvoyException,
+                            "zstd shared dictionaries must be raw content, not trained "
+                            "dictionaries");
+}
+
 } // namespace
 } // namespace Compressor
 } // namespace Zstd
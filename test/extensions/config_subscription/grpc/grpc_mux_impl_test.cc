@@ -673,6 +673,66 @@ TEST_P(GrpcMuxImplTest, WildcardWatch) {
   }
 }
 
+// Resources which a response repeats unchanged share the message decoded for the previous response.
+TEST_P(GrpcMuxImplTest, UnchangedResourcesNotDecodedAgain) {
+  setup();
+
+  InSequence s;
+  const std::string& type_url = Config::TypeUrl::get().ClusterLoadAssignment;
+  OpaqueResourceDecoderSharedPtr resource_decoder(
+      std::make_shared<TestUtility::TestOpaqueResourceDecoderImpl<
+          envoy::config::endpoint::v3::ClusterLoadAssignment>>("cluster_name"));
+  auto foo_sub = grpc_mux_->addWatch(type_url, {}, callbacks_, resource_decoder, {});
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  expectSendMessage(type_url, {}, "", true);
+  grpc_mux_->start();
+
+  auto make_response = [&type_url](const std::string& version, int64_t y_stale_after) {
+    auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+    response->set_type_url(type_url);
+    response->set_version_info(version);
+    envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment;
+    load_assignment.set_cluster_name("x");
+    response->add_resources()->PackFrom(load_assignment);
+    load_assignment.set_cluster_name("y");
+    load_assignment.mutable_policy()->mutable_endpoint_stale_after()->set_seconds(y_stale_after);
+    response->add_resources()->PackFrom(load_assignment);
+    return response;
+  };
+
+  std::vector<const Protobuf::Message*> first_messages;
+  EXPECT_CALL(callbacks_, onConfigUpdate(_, "1"))
+      .WillOnce(Invoke(
+          [&first_messages](const std::vector<DecodedResourceRef>& resources, const std::string&) {
+            EXPECT_EQ(2, resources.size());
+            for (const auto& resource : resources) {
+              first_messages.push_back(&resource.get().resource());
+            }
+            return absl::OkStatus();
+          }));
+  expectSendMessage(type_url, {}, "1");
+  grpc_mux_->grpcStreamForTest().onReceiveMessage(make_response("1", 1));
+
+  EXPECT_CALL(callbacks_, onConfigUpdate(_, "2"))
+      .WillOnce(Invoke(
+          [&first_messages](const std::vector<DecodedResourceRef>& resources, const std::string&) {
+            EXPECT_EQ(2, resources.size());
+            EXPECT_EQ("x", resources[0].get().name());
+            EXPECT_EQ("2", resources[0].get().version());
+            EXPECT_EQ(first_messages[0], &resources[0].get().resource());
+            EXPECT_EQ("y", resources[1].get().name());
+            EXPECT_NE(first_messages[1], &resources[1].get().resource());
+            EXPECT_EQ(2, dynamic_cast<const envoy::config::endpoint::v3::ClusterLoadAssignment&>(
+                             resources[1].get().resource())
+                             .policy()
+                             .endpoint_stale_after()
+                             .seconds());
+            return absl::OkStatus();
+          }));
+  expectSendMessage(type_url, {}, "2");
+  grpc_mux_->grpcStreamForTest().onReceiveMessage(make_response("2", 2));
+}
+
 // Validate behavior when watches specify resources (potentially overlapping).
 TEST_P(GrpcMuxImplTest, WatchDemux) {
   setup();
@@ -242,6 +242,63 @@ INSTANTIATE_TEST_SUITE_P(
                       envoy_dynamic_module_callback_http_set_response_header,
                       envoy_dynamic_module_callback_http_set_response_trailer));
 
+// Parameterized test for set_headers
+using SetHeadersCallbackType = bool (*)(envoy_dynamic_module_type_http_filter_envoy_ptr,
+                                        envoy_dynamic_module_type_module_http_header*, size_t);
+
+class DynamicModuleHttpFilterSetHeadersTest
+    : public DynamicModuleHttpFilterTest,
+      public ::testing::WithParamInterface<SetHeadersCallbackType> {};
+
+TEST_P(DynamicModuleHttpFilterSetHeadersTest, SetHeaders) {
+  SetHeadersCallbackType callback = GetParam();
+
+  // Test with nullptr accessors.
+  EXPECT_FALSE(callback(filter_.get(), nullptr, 0));
+
+  std::initializer_list<std::pair<std::string, std::string>> headers = {
+      {"single", "value"}, {"multi", "value1"}, {"multi", "value2"}, {"removed", "value"}};
+  Http::TestRequestHeaderMapImpl request_headers{headers};
+  filter_->request_headers_ = &request_headers;
+  Http::TestResponseHeaderMapImpl response_headers{headers};
+  filter_->response_headers_ = &response_headers;
+
+  Http::HeaderMap* header_map = nullptr;
+  if (callback == &envoy_dynamic_module_callback_http_set_request_headers) {
+    header_map = &request_headers;
+  } else if (callback == &envoy_dynamic_module_callback_http_set_response_headers) {
+    header_map = &response_headers;
+  } else {
+    FAIL();
+  }
+
+  std::string new_key = "new_one";
+  std::string single_key = "single";
+  std::string multi_key = "multi";
+  std::string removed_key = "removed";
+  std::string new_value = "new_value";
+  envoy_dynamic_module_type_module_http_header headers_vector[] = {
+      {new_key.data(), new_key.size(), new_value.data(), new_value.size()},
+      {single_key.data(), single_key.size(), new_value.data(), new_value.size()},
+      {multi_key.data(), multi_key.size(), new_value.data(), new_value.size()},
+      {removed_key.data(), removed_key.size(), nullptr, 0},
+  };
+  EXPECT_TRUE(callback(filter_.get(), headers_vector, 4));
+
+  for (const std::string& key : {new_key, single_key, multi_key}) {
+    auto values = header_map->get(Envoy::Http::LowerCaseString(key));
+    ASSERT_EQ(values.size(), 1);
+    EXPECT_EQ(values[0]->value().getStringView(), new_value);
+  }
+  EXPECT_TRUE(header_map->get(Envoy::Http::LowerCaseString(removed_key)).empty());
+  EXPECT_EQ(header_map->size(), 3);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SetHeadersTests, DynamicModuleHttpFilterSetHeadersTest,
+    ::testing::Values(envoy_dynamic_module_callback_http_set_request_headers,
+                      envoy_dynamic_module_callback_http_set_response_headers));
+
 // Parameterized test for get_headers_count
 using GetHeadersCountCallbackType = size_t (*)(envoy_dynamic_module_type_http_filter_envoy_ptr);
 
@@ -54,6 +54,55 @@ TEST(Evaluator, Activation) {
   EXPECT_TRUE(activation->FindValue("upstream_filter_state", &arena).has_value());
 }
 
+// Every term refers to `request`, which is only resolved once per evaluation.
+TEST(Evaluator, RepeatedAttributes) {
+  google::api::expr::v1alpha1::Expr expr;
+  TestUtility::loadFromYaml(R"EOF(
+  call_expr:
+    function: _&&_
+    args:
+    - call_expr:
+        function: _==_
+        args:
+        - select_expr: {operand: {ident_expr: {name: request}}, field: path}
+        - const_expr: {string_value: "/foo"}
+    - call_expr:
+        function: _==_
+        args:
+        - select_expr: {operand: {ident_expr: {name: request}}, field: method}
+        - const_expr: {string_value: "GET"}
+  )EOF",
+                            expr);
+  BuilderInstance builder;
+  const auto compiled = createExpression(builder.builder(), expr);
+
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  Http::TestRequestHeaderMapImpl headers{{":path", "/foo"}, {":method", "GET"}};
+  EXPECT_TRUE(matches(*compiled, info, headers));
+  headers.setMethod("POST");
+  EXPECT_FALSE(matches(*compiled, info, headers));
+}
+
+TEST(Evaluator, ConstantFolding) {
+  google::api::expr::v1alpha1::Expr expr;
+  TestUtility::loadFromYaml(R"EOF(
+  call_expr:
+    function: _+_
+    args:
+    - const_expr: {string_value: "foo"}
+    - const_expr: {string_value: "bar"}
+  )EOF",
+                            expr);
+  BuilderInstance builder;
+  const auto compiled = createExpression(builder.builder(), expr);
+
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  ProtobufWkt::Arena arena;
+  const auto value = evaluate(*compiled, arena, nullptr, info, nullptr, nullptr, nullptr);
+  ASSERT_TRUE(value.has_value());
+  EXPECT_EQ(print(value.value()), "foobar");
+}
+
 } // namespace
 } // namespace Expr
 } // namespace Common
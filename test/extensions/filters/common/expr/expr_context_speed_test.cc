@@ -3,6 +3,7 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/router/string_accessor_impl.h"
 #include "source/extensions/filters/common/expr/context.h"
+#include "source/extensions/filters/common/expr/evaluator.h"
 
 #include "test/mocks/local_info/mocks.h"
 #include "test/mocks/ssl/mocks.h"
@@ -90,6 +91,38 @@ public:
     }
   }
 
+  // A condition referring to several request attributes, as used by RBAC or access log filters.
+  void testEvaluate(::benchmark::State& state) {
+    google::api::expr::v1alpha1::Expr expr;
+    TestUtility::loadFromYaml(R"EOF(
+    call_expr:
+      function: _&&_
+      args:
+      - call_expr:
+          function: _==_
+          args:
+          - select_expr: {operand: {ident_expr: {name: request}}, field: method}
+          - const_expr: {string_value: "POST"}
+      - call_expr:
+          function: startsWith
+          target: {select_expr: {operand: {ident_expr: {name: request}}, field: path}}
+          args:
+          - call_expr:
+              function: _+_
+              args:
+              - const_expr: {string_value: "/me"}
+              - const_expr: {string_value: "ow"}
+    )EOF",
+                              expr);
+    BuilderInstance builder;
+    const auto compiled = createExpression(builder.builder(), expr);
+
+    for (auto _ : state) { // NOLINT
+      const bool matched = matches(*compiled, info_, request_headers_);
+      benchmark::DoNotOptimize(matched);
+    }
+  }
+
 private:
   Http::TestRequestHeaderMapImpl makeRequestHeaders() {
     return Http::TestRequestHeaderMapImpl{{":method", "POST"},      {":scheme", "http"},
@@ -165,6 +198,11 @@ static void bmFilterState(::benchmark::State& state) {
   speed_test.testFilterState(state);
 }
 
+static void bmEvaluate(::benchmark::State& state) {
+  ExpressionContextSpeedTest speed_test(0);
+  speed_test.testEvaluate(state);
+}
+
 BENCHMARK(bmRequestAttributes)
     ->Unit(::benchmark::kMicrosecond)
     ->RangeMultiplier(100)
@@ -177,6 +215,8 @@ BENCHMARK(bmResponseAttributes)
 
 BENCHMARK(bmFilterState)->Unit(::benchmark::kMicrosecond)->RangeMultiplier(100)->Range(10, 100000);
 
+BENCHMARK(bmEvaluate);
+
 } // namespace Expr
 } // namespace Common
 } // namespace Filters
@@ -137,6 +137,80 @@ TEST_F(LocalRateLimiterImplTest, TooFastFillRate) {
       EnvoyException, "local rate limit token bucket fill timer must be >= 50ms");
 }
 
+// With a lease, a worker takes tokens in batches but never more than the bucket holds.
+TEST_F(LocalRateLimiterImplTest, WorkerTokenLease) {
+  RateLimitTokenBucket bucket(10, 10, std::chrono::milliseconds(1000),
+                              dispatcher_.globalTimeSystem(), 4);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(bucket.consume());
+  }
+  EXPECT_FALSE(bucket.consume());
+  EXPECT_EQ(bucket.remainingTokens(), 0);
+
+  // The first request of the interval takes one token and leases four more.
+  dispatcher_.globalTimeSystem().advanceTimeWait(std::chrono::milliseconds(500));
+  EXPECT_TRUE(bucket.consume());
+  EXPECT_EQ(bucket.remainingTokens(), 4);
+
+  // A stale lease goes back to the shared bucket before a new one is taken.
+  dispatcher_.globalTimeSystem().advanceTimeWait(std::chrono::milliseconds(1000));
+  EXPECT_TRUE(bucket.consume());
+  EXPECT_EQ(bucket.remainingTokens(), 9);
+}
+
+// The lease of an idle worker counts against the refilled bucket, and is returned once stale.
+TEST_F(LocalRateLimiterImplTest, WorkerTokenLeaseIdleWorker) {
+  RateLimitTokenBucket bucket(10, 10, std::chrono::milliseconds(1000),
+                              dispatcher_.globalTimeSystem(), 4);
+  const auto burst = [&bucket]() {
+    uint64_t allowed = 0;
+    while (bucket.consume()) {
+      allowed++;
+    }
+    return allowed;
+  };
+
+  // Another worker takes a lease of four tokens and goes idle.
+  Thread::ThreadPtr idle_worker =
+      Thread::threadFactoryForTest().createThread([&bucket]() { EXPECT_TRUE(bucket.consume()); });
+  idle_worker->join();
+  EXPECT_EQ(bucket.remainingTokens(), 9);
+
+  // The shared bucket refills to max_tokens, but a burst still gets no more than max_tokens.
+  dispatcher_.globalTimeSystem().advanceTimeWait(std::chrono::milliseconds(500));
+  EXPECT_EQ(burst(), 10);
+
+  // Once stale, the idle lease is returned rather than kept on top of the refilled bucket.
+  dispatcher_.globalTimeSystem().advanceTimeWait(std::chrono::milliseconds(1000));
+  Thread::threadFactoryForTest()
+      .createThread([&bucket]() { EXPECT_TRUE(bucket.consume()); })
+      ->join();
+  dispatcher_.globalTimeSystem().advanceTimeWait(std::chrono::milliseconds(1000));
+  EXPECT_EQ(burst(), 10);
+}
+
+TEST_F(LocalRateLimiterImplTest, WorkerTokenLeaseAcrossThreads) {
+  RateLimitTokenBucket bucket(1000, 1, std::chrono::milliseconds(1000000),
+                              dispatcher_.globalTimeSystem(), 64);
+  std::atomic<uint64_t> allowed{0};
+  std::vector<Thread::ThreadPtr> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.push_back(Thread::threadFactoryForTest().createThread([&bucket, &allowed]() {
+      for (int j = 0; j < 500; ++j) {
+        if (bucket.consume()) {
+          allowed++;
+        }
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread->join();
+  }
+  // Leases never let more requests through than the bucket holds, and no token is lost in them.
+  EXPECT_LE(allowed.load(), 1000);
+  EXPECT_EQ(allowed.load() + bucket.remainingTokens(), 1000);
+}
+
 class LocalRateLimiterDescriptorImplTest : public LocalRateLimiterImplTest {
 public:
   void initializeWithAtomicTokenBucketDescriptor(const std::chrono::milliseconds fill_interval,
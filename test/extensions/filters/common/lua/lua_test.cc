@@ -104,6 +104,82 @@ TEST_F(LuaTest, EmptyError) {
                           "unspecified lua error");
 }
 
+// Coroutines that finish without error are reused, others are not.
+TEST_F(LuaTest, CoroutineReuse) {
+  const std::string SCRIPT{R"EOF(
+    function callMe(object)
+      object:testCall()
+    end
+
+    function fail()
+      error("failed")
+    end
+
+    function yield()
+      coroutine.yield()
+    end
+  )EOF"};
+
+  setup(SCRIPT);
+  const int call_me = state_->getGlobalRef(state_->registerGlobal("callMe", initializers_));
+  const int fail = state_->getGlobalRef(state_->registerGlobal("fail", initializers_));
+  const int yield = state_->getGlobalRef(state_->registerGlobal("yield", initializers_));
+
+  CoroutinePtr cr1(state_->createCoroutine());
+  const Coroutine* first = cr1.get();
+  LuaRef<TestObject> ref1(TestObject::create(cr1->luaState()), true);
+  EXPECT_CALL(*ref1.get(), doTestCall(_));
+  cr1->start(call_me, 1, yield_callback_);
+  EXPECT_EQ(cr1->state(), Coroutine::State::Finished);
+  cr1.reset();
+  EXPECT_EQ(state_->pooledCoroutines(), 1);
+
+  // The finished coroutine runs the next function from an empty stack.
+  CoroutinePtr cr2(state_->createCoroutine());
+  EXPECT_EQ(cr2.get(), first);
+  EXPECT_EQ(cr2->state(), Coroutine::State::NotStarted);
+  EXPECT_EQ(lua_gettop(cr2->luaState()), 0);
+  LuaRef<TestObject> ref2(TestObject::create(cr2->luaState()), true);
+  EXPECT_CALL(*ref2.get(), doTestCall(_));
+  cr2->start(call_me, 1, yield_callback_);
+  EXPECT_EQ(state_->pooledCoroutines(), 0);
+
+  CoroutinePtr cr3(state_->createCoroutine());
+  EXPECT_THROW_WITH_REGEX(cr3->start(fail, 0, yield_callback_), LuaException, "failed");
+  cr3.reset();
+  EXPECT_EQ(state_->pooledCoroutines(), 0);
+
+  CoroutinePtr cr4(state_->createCoroutine());
+  EXPECT_CALL(on_yield_, ready());
+  cr4->start(yield, 0, yield_callback_);
+  EXPECT_EQ(cr4->state(), Coroutine::State::Yielded);
+  cr4.reset();
+  EXPECT_EQ(state_->pooledCoroutines(), 0);
+
+  EXPECT_CALL(*ref1.get(), onDestroy());
+  EXPECT_CALL(*ref2.get(), onDestroy());
+  ref1.reset();
+  ref2.reset();
+  lua_gc(cr2->luaState(), LUA_GCCOLLECT, 0);
+  cr2.reset();
+  EXPECT_EQ(state_->pooledCoroutines(), 1);
+}
+
+// Errors of the script compiled on the main thread keep reporting its chunk name and lines.
+TEST_F(LuaTest, BytecodeKeepsDebugInformation) {
+  const std::string SCRIPT{R"EOF(
+    function callMe()
+      error("failed")
+    end
+  )EOF"};
+
+  setup(SCRIPT);
+  const int call_me = state_->getGlobalRef(state_->registerGlobal("callMe", initializers_));
+  CoroutinePtr cr(state_->createCoroutine());
+  EXPECT_THROW_WITH_MESSAGE(cr->start(call_me, 0, yield_callback_), LuaException,
+                            "[string \"...\"]:3: failed");
+}
+
 // Basic yield/resume functionality.
 TEST_F(LuaTest, YieldAndResume) {
   const std::string SCRIPT{R"EOF(
@@ -0,0 +1,84 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "envoy/config/rbac/v3/rbac.pb.h"
+
+#include "source/extensions/filters/common/rbac/engine_impl.h"
+
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/server/server_factory_context.h"
+#include "test/mocks/ssl/mocks.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+using testing::Const;
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+namespace {
+
+// Builds `num_policies` policies, each allowing one SPIFFE ID under one path prefix, like a
+// service mesh config. With `indexable` false, principals are matched by prefix, which the
+// policy index can't use, so every policy is evaluated as without an index.
+envoy::config::rbac::v3::RBAC makeRules(int num_policies, bool indexable) {
+  envoy::config::rbac::v3::RBAC rbac;
+  rbac.set_action(envoy::config::rbac::v3::RBAC::ALLOW);
+  for (int i = 0; i < num_policies; ++i) {
+    envoy::config::rbac::v3::Policy policy;
+    policy.add_permissions()->mutable_url_path()->mutable_path()->set_prefix(
+        absl::StrCat("/service", i, "/"));
+    auto* name = policy.add_principals()->mutable_authenticated()->mutable_principal_name();
+    const std::string spiffe_id = absl::StrCat("spiffe://cluster.local/ns/default/sa/client", i);
+    if (indexable) {
+      name->set_exact(spiffe_id);
+    } else {
+      name->set_prefix(spiffe_id);
+    }
+    (*rbac.mutable_policies())[absl::StrCat("policy", i)] = policy;
+  }
+  return rbac;
+}
+
+// The request of the last client, to the path it is allowed to use.
+void bmEngine(benchmark::State& state, bool indexable) {
+  const int num_policies = state.range(0);
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  RoleBasedAccessControlEngineImpl engine(makeRules(num_policies, indexable),
+                                          ProtobufMessage::getStrictValidationVisitor(),
+                                          factory_context);
+
+  NiceMock<Network::MockConnection> connection;
+  auto ssl = std::make_shared<NiceMock<Ssl::MockConnectionInfo>>();
+  const std::vector<std::string> uri_sans{
+      absl::StrCat("spiffe://cluster.local/ns/default/sa/client", num_policies - 1)};
+  ON_CALL(*ssl, uriSanPeerCertificate()).WillByDefault(Return(absl::MakeConstSpan(uri_sans)));
+  ON_CALL(Const(connection), ssl()).WillByDefault(Return(ssl));
+  Http::TestRequestHeaderMapImpl headers{
+      {":path", absl::StrCat("/service", num_policies - 1, "/items?page=2")}};
+  NiceMock<StreamInfo::MockStreamInfo> info;
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    bool allowed = engine.handleAction(connection, headers, info, nullptr);
+    benchmark::DoNotOptimize(allowed);
+  }
+}
+
+void bmIndexedPolicies(benchmark::State& state) { bmEngine(state, true); }
+BENCHMARK(bmIndexedPolicies)->Arg(10)->Arg(100)->Arg(1000)->Arg(3000);
+
+void bmUnindexedPolicies(benchmark::State& state) { bmEngine(state, false); }
+BENCHMARK(bmUnindexedPolicies)->Arg(10)->Arg(100)->Arg(1000)->Arg(3000);
+
+} // namespace
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
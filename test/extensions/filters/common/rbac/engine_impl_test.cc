@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 
 using testing::Const;
+using testing::Return;
 using testing::ReturnPointee;
 using testing::ReturnRef;
 
@@ -249,6 +250,50 @@ TEST(RoleBasedAccessControlEngineImpl, DeniedDenylist) {
   checkEngine(engine, true, LogResult::Undecided, info, conn, headers);
 }
 
+// Indexed policies are only evaluated for matching peers and paths, and the policy that matches
+// first in name order is still the effective one.
+TEST(RoleBasedAccessControlEngineImpl, IndexedPoliciesKeepFirstMatch) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  envoy::config::rbac::v3::RBAC rbac;
+  TestUtility::loadFromYaml(R"EOF(
+  action: ALLOW
+  policies:
+    a-by-principal:
+      permissions: [{any: true}]
+      principals: [{authenticated: {principal_name: {exact: "spiffe://client"}}}]
+    b-by-path:
+      permissions: [{url_path: {path: {prefix: "/public/"}}}]
+      principals: [{any: true}]
+    c-not-indexed:
+      permissions: [{header: {name: "x-debug", present_match: true}}]
+      principals: [{any: true}]
+  )EOF",
+                            rbac);
+  RBAC::RoleBasedAccessControlEngineImpl engine(rbac, ProtobufMessage::getStrictValidationVisitor(),
+                                                factory_context);
+
+  NiceMock<Envoy::Network::MockConnection> conn;
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  std::string effective_policy_id;
+  Envoy::Http::TestRequestHeaderMapImpl headers{{":path", "/private"}};
+  EXPECT_FALSE(engine.handleAction(conn, headers, info, &effective_policy_id));
+
+  headers.setCopy(Http::LowerCaseString("x-debug"), "1");
+  EXPECT_TRUE(engine.handleAction(conn, headers, info, &effective_policy_id));
+  EXPECT_EQ(effective_policy_id, "c-not-indexed");
+
+  headers.setPath("/public/index.html");
+  EXPECT_TRUE(engine.handleAction(conn, headers, info, &effective_policy_id));
+  EXPECT_EQ(effective_policy_id, "b-by-path");
+
+  auto ssl = std::make_shared<NiceMock<Ssl::MockConnectionInfo>>();
+  const std::vector<std::string> uri_sans{"spiffe://client"};
+  ON_CALL(*ssl, uriSanPeerCertificate()).WillByDefault(Return(absl::MakeConstSpan(uri_sans)));
+  ON_CALL(Const(conn), ssl()).WillByDefault(Return(ssl));
+  EXPECT_TRUE(engine.handleAction(conn, headers, info, &effective_policy_id));
+  EXPECT_EQ(effective_policy_id, "a-by-principal");
+}
+
 TEST(RoleBasedAccessControlEngineImpl, BasicCondition) {
   NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
   envoy::config::rbac::v3::Policy policy;
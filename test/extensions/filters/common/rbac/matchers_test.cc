@@ -152,6 +152,41 @@ TEST(OrMatcher, Principal_Set) {
   checkMatcher(RBAC::OrMatcher(set, factory_context), true, conn, headers, info);
 }
 
+TEST(OrMatcher, HeaderRegexSet) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  envoy::config::rbac::v3::Principal::Set set;
+  for (const std::string regex : {"foo-[0-9]+", "bar-.*"}) {
+    auto* header = set.add_ids()->mutable_header();
+    header->set_name("x-user");
+    header->mutable_string_match()->mutable_safe_regex()->set_regex(regex);
+  }
+  // Inverted matchers are not combined.
+  auto* inverted = set.add_ids()->mutable_header();
+  inverted->set_name("x-other");
+  inverted->mutable_safe_regex_match()->set_regex("baz");
+  inverted->set_invert_match(true);
+
+  Envoy::Network::MockConnection conn;
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  const RBAC::OrMatcher matcher(set, factory_context);
+  checkMatcher(matcher, true, conn,
+               Envoy::Http::TestRequestHeaderMapImpl{{"x-user", "foo-12"}, {"x-other", "baz"}},
+               info);
+  checkMatcher(matcher, true, conn,
+               Envoy::Http::TestRequestHeaderMapImpl{{"x-user", "bar-"}, {"x-other", "baz"}}, info);
+  checkMatcher(matcher, false, conn,
+               Envoy::Http::TestRequestHeaderMapImpl{{"x-user", "foo-"}, {"x-other", "baz"}},
+               info);
+  // The regexes match the whole header value.
+  checkMatcher(matcher, false, conn,
+               Envoy::Http::TestRequestHeaderMapImpl{{"x-user", "xbar-"}, {"x-other", "baz"}},
+               info);
+  checkMatcher(matcher, false, conn, Envoy::Http::TestRequestHeaderMapImpl{{"x-other", "baz"}},
+               info);
+  checkMatcher(matcher, true, conn, Envoy::Http::TestRequestHeaderMapImpl{{"x-other", "qux"}},
+               info);
+}
+
 TEST(NotMatcher, Permission) {
   NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
   envoy::config::rbac::v3::Permission perm;
@@ -0,0 +1,145 @@
+#include <deque>
+
+#include "envoy/config/rbac/v3/rbac.pb.h"
+
+#include "source/extensions/filters/common/rbac/policy_index.h"
+
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/ssl/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::Const;
+using testing::ElementsAre;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace RBAC {
+namespace {
+
+class PolicyIndexTest : public testing::Test {
+protected:
+  void initialize(const std::vector<std::string>& yamls) {
+    for (const auto& yaml : yamls) {
+      TestUtility::loadFromYaml(yaml, configs_.emplace_back());
+    }
+    std::vector<const envoy::config::rbac::v3::Policy*> policies;
+    for (const auto& config : configs_) {
+      policies.push_back(&config);
+    }
+    index_ = std::make_unique<PolicyIndex>(policies);
+  }
+
+  void setPeer(std::vector<std::string> uri_sans, std::string subject = "") {
+    uri_sans_ = std::move(uri_sans);
+    subject_ = std::move(subject);
+    ON_CALL(*ssl_, uriSanPeerCertificate()).WillByDefault(Return(absl::MakeConstSpan(uri_sans_)));
+    ON_CALL(*ssl_, subjectPeerCertificate()).WillByDefault(ReturnRef(subject_));
+    ON_CALL(Const(connection_), ssl()).WillByDefault(Return(ssl_));
+  }
+
+  std::vector<uint32_t> candidates(absl::string_view path = "",
+                                   absl::optional<uint32_t> stop_at = absl::nullopt) {
+    Http::TestRequestHeaderMapImpl headers;
+    if (!path.empty()) {
+      headers.setPath(path);
+    }
+    std::vector<uint32_t> result;
+    index_->forEachCandidate(connection_, headers, [&](uint32_t policy) {
+      result.push_back(policy);
+      return stop_at == policy;
+    });
+    return result;
+  }
+
+  std::deque<envoy::config::rbac::v3::Policy> configs_;
+  std::unique_ptr<PolicyIndex> index_;
+  NiceMock<Network::MockConnection> connection_;
+  std::shared_ptr<NiceMock<Ssl::MockConnectionInfo>> ssl_{
+      std::make_shared<NiceMock<Ssl::MockConnectionInfo>>()};
+  std::vector<std::string> uri_sans_;
+  std::string subject_;
+};
+
+const std::string AnyPermission = R"EOF(
+permissions: [{any: true}]
+)EOF";
+
+TEST_F(PolicyIndexTest, IndexesByPrincipalAndPath) {
+  initialize({
+      // 0: indexed by principal.
+      R"EOF(
+      permissions: [{any: true}]
+      principals: [{authenticated: {principal_name: {exact: "spiffe://a"}}}]
+      )EOF",
+      // 1: indexed by exact path.
+      R"EOF(
+      permissions: [{url_path: {path: {exact: "/admin"}}}]
+      principals: [{any: true}]
+      )EOF",
+      // 2: not indexed, as one of its principals may match any peer.
+      R"EOF(
+      permissions: [{any: true}]
+      principals:
+      - authenticated: {principal_name: {exact: "spiffe://a"}}
+      - remote_ip: {address_prefix: "10.0.0.0", prefix_len: 8}
+      )EOF",
+      // 3: indexed by path prefixes.
+      R"EOF(
+      permissions:
+      - or_rules:
+          rules:
+          - url_path: {path: {prefix: "/api/"}}
+          - url_path: {path: {prefix: "/api/v2/"}}
+      principals: [{any: true}]
+      )EOF",
+      // 4: indexed by principal through the requirements of an and_ids.
+      R"EOF(
+      permissions: [{any: true}]
+      principals:
+      - and_ids:
+          ids:
+          - remote_ip: {address_prefix: "10.0.0.0", prefix_len: 8}
+          - authenticated: {principal_name: {exact: "CN=b"}}
+      )EOF",
+      // 5: not indexed, as case insensitive paths are not indexed.
+      R"EOF(
+      permissions: [{url_path: {path: {exact: "/admin", ignore_case: true}}}]
+      principals: [{any: true}]
+      )EOF",
+  });
+  EXPECT_EQ(index_->unindexedPolicies(), 2);
+
+  EXPECT_THAT(candidates(), ElementsAre(2, 5));
+  EXPECT_THAT(candidates("/admin?x=1"), ElementsAre(1, 2, 5));
+  EXPECT_THAT(candidates("/api/v2/users"), ElementsAre(2, 3, 5));
+  EXPECT_THAT(candidates("/api"), ElementsAre(2, 5));
+
+  setPeer({"spiffe://a"}, "CN=b");
+  EXPECT_THAT(candidates(), ElementsAre(0, 2, 4, 5));
+  EXPECT_THAT(candidates("/api/v1"), ElementsAre(0, 2, 3, 4, 5));
+  // Evaluation stops at the first match.
+  EXPECT_THAT(candidates("/api/v1", 2), ElementsAre(0, 2));
+}
+
+TEST_F(PolicyIndexTest, NothingIndexed) {
+  initialize({AnyPermission + "principals: [{any: true}]",
+              AnyPermission + "principals: [{authenticated: {}}]"});
+  EXPECT_EQ(index_->unindexedPolicies(), 2);
+  EXPECT_THAT(candidates("/"), ElementsAre(0, 1));
+  EXPECT_THAT(candidates("/", 0), ElementsAre(0));
+}
+
+} // namespace
+} // namespace RBAC
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -553,6 +553,59 @@ min_rtt_calc_params:
   EXPECT_EQ(limit_val, controller->concurrencyLimit());
 }
 
+TEST_F(GradientControllerTest, ContinuousMinRTT) {
+  const std::string yaml = R"EOF(
+sample_aggregate_percentile:
+  value: 50
+concurrency_limit_params:
+  max_concurrency_limit:
+  concurrency_update_interval: 0.1s
+min_rtt_calc_params:
+  jitter:
+    value: 0.0
+  interval: 30s
+  request_count: 5
+  continuous: true
+)EOF";
+
+  auto controller = makeController(yaml);
+  EXPECT_EQ(controller->concurrencyLimit(), 3);
+  advancePastMinRTTStage(controller, yaml, std::chrono::milliseconds(5));
+  verifyMinRTTValue(std::chrono::milliseconds(5));
+  time_system_.advanceTimeAndRun(std::chrono::seconds(1), *dispatcher_,
+                                 Event::Dispatcher::RunType::Block);
+
+  const auto sampleWindow = [&](std::chrono::milliseconds latency) {
+    for (int i = 1; i <= 5; ++i) {
+      tryForward(controller, true);
+      sampleLatency(controller, latency);
+    }
+    time_system_.advanceTimeAndRun(std::chrono::milliseconds(101), *dispatcher_,
+                                   Event::Dispatcher::RunType::Block);
+  };
+
+  // Faster samples lower the minRTT right away.
+  sampleWindow(std::chrono::milliseconds(4));
+  verifyMinRTTValue(std::chrono::milliseconds(4));
+  const auto limit_val = controller->concurrencyLimit();
+  EXPECT_GT(limit_val, 3);
+
+  // The limit is not pinned to the minimum concurrency once the interval elapses.
+  time_system_.advanceTimeAndRun(std::chrono::seconds(31), *dispatcher_,
+                                 Event::Dispatcher::RunType::Block);
+  verifyMinRTTInactive();
+  EXPECT_EQ(controller->concurrencyLimit(), limit_val);
+
+  // The interval which saw the 4ms samples ends with the next window, after which slower samples
+  // raise the minRTT at the end of the following interval.
+  sampleWindow(std::chrono::milliseconds(13));
+  verifyMinRTTValue(std::chrono::milliseconds(4));
+  time_system_.advanceTimeAndRun(std::chrono::seconds(31), *dispatcher_,
+                                 Event::Dispatcher::RunType::Block);
+  sampleWindow(std::chrono::milliseconds(13));
+  verifyMinRTTValue(std::chrono::milliseconds(13));
+}
+
 TEST_F(GradientControllerTest, MinRTTRescheduleTest) {
   const std::string yaml = R"EOF(
 sample_aggregate_percentile:
@@ -34,7 +34,9 @@ protected:
   // The filter has to be created as a shared_ptr to enable shared_from_this() which is used in the
   // cache callbacks.
   CacheFilterSharedPtr makeFilter(std::shared_ptr<HttpCache> cache, bool auto_destroy = true) {
-    auto config = std::make_shared<CacheFilterConfig>(config_, context_.server_factory_context_);
+    auto config = filter_config_ != nullptr ? filter_config_
+                                            : std::make_shared<CacheFilterConfig>(
+                                                  config_, context_.server_factory_context_);
     std::shared_ptr<CacheFilter> filter(new CacheFilter(config, cache),
                                         [auto_destroy](CacheFilter* f) {
                                           if (auto_destroy) {
@@ -283,6 +285,8 @@ protected:
 
   std::shared_ptr<SimpleHttpCache> simple_cache_ = std::make_shared<SimpleHttpCache>();
   envoy::extensions::filters::http::cache::v3::CacheConfig config_;
+  // If set, shared by the filters made by makeFilter, as by the filters of a filter chain.
+  std::shared_ptr<const CacheFilterConfig> filter_config_;
   std::shared_ptr<StreamInfo::FilterState> filter_state_ =
       std::make_shared<StreamInfo::FilterStateImpl>(StreamInfo::FilterState::LifeSpan::FilterChain);
   NiceMock<Server::Configuration::MockFactoryContext> context_;
@@ -381,6 +385,65 @@ TEST_F(CacheFilterTest, CacheMiss) {
   }
 }
 
+TEST_F(CacheFilterTest, CollapsedForwardingServesWaitingRequestFromCache) {
+  request_headers_.setHost("CollapsedForwardingServesWaitingRequestFromCache");
+  config_.mutable_collapsed_forwarding_timeout()->set_seconds(10);
+  filter_config_ = std::make_shared<CacheFilterConfig>(config_, context_.server_factory_context_);
+  CacheFilterSharedPtr filler = makeFilter(simple_cache_);
+  CacheFilterSharedPtr waiter = makeFilter(simple_cache_);
+  EXPECT_EQ(filler->decodeHeaders(request_headers_, true),
+            Http::FilterHeadersStatus::StopAllIterationAndWatermark);
+  EXPECT_EQ(waiter->decodeHeaders(request_headers_, true),
+            Http::FilterHeadersStatus::StopAllIterationAndWatermark);
+  pumpDispatcher();
+
+  // Only the first miss is sent upstream, the second one waits for it.
+  ASSERT_EQ(mock_upstreams_.size(), 1);
+  EXPECT_EQ(filter_config_->inFlightFills().size(), 1);
+
+  receiveUpstreamHeaders(0, response_headers_, true);
+  EXPECT_EQ(filter_config_->inFlightFills().size(), 0);
+
+  // Once the response is inserted, the waiting request is served from the cache.
+  EXPECT_CALL(decoder_callbacks_, encodeHeaders_(IsSupersetOfHeaders(response_headers_), true));
+  pumpDispatcher();
+  ::testing::Mock::VerifyAndClearExpectations(&decoder_callbacks_);
+  EXPECT_EQ(mock_upstreams_.size(), 1);
+  waiter->onStreamComplete();
+  EXPECT_THAT(lookupStatus(), IsOkAndHolds(LookupStatus::CacheHit));
+}
+
+TEST_F(CacheFilterTest, CollapsedForwardingWaitTimesOut) {
+  request_headers_.setHost("CollapsedForwardingWaitTimesOut");
+  config_.mutable_collapsed_forwarding_timeout()->set_seconds(1);
+  filter_config_ = std::make_shared<CacheFilterConfig>(config_, context_.server_factory_context_);
+  CacheFilterSharedPtr filler = makeFilter(simple_cache_);
+  CacheFilterSharedPtr waiter = makeFilter(simple_cache_);
+  filler->decodeHeaders(request_headers_, true);
+  waiter->decodeHeaders(request_headers_, true);
+  pumpDispatcher();
+  ASSERT_EQ(mock_upstreams_.size(), 1);
+
+  // The upstream is too slow, so the waiting request is sent upstream itself.
+  time_source_.advanceTimeWait(std::chrono::seconds(1));
+  pumpDispatcher();
+  ASSERT_EQ(mock_upstreams_.size(), 2);
+  EXPECT_THAT(mock_upstreams_headers_sent_[1], testing::Optional(request_headers_));
+}
+
+TEST_F(CacheFilterTest, CollapsedForwardingDoesntWaitForUncacheableRequests) {
+  request_headers_.setHost("CollapsedForwardingDoesntWaitForUncacheableRequests");
+  config_.mutable_collapsed_forwarding_timeout()->set_seconds(10);
+  filter_config_ = std::make_shared<CacheFilterConfig>(config_, context_.server_factory_context_);
+  CacheFilterSharedPtr filler = makeFilter(simple_cache_);
+  testDecodeRequestMiss(0, filler);
+
+  // A request whose response won't be inserted doesn't wait for the fill.
+  request_headers_.setReferenceKey(Http::CustomHeaders::get().CacheControl, "no-store");
+  CacheFilterSharedPtr no_store = makeFilter(simple_cache_);
+  testDecodeRequestMiss(1, no_store);
+}
+
 TEST_F(CacheFilterTest, Disabled) {
   request_headers_.setHost("CacheDisabled");
   CacheFilterSharedPtr filter = makeFilter(std::shared_ptr<HttpCache>{});
@@ -0,0 +1,72 @@
+#include "source/extensions/filters/http/cache/in_flight_fills.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace {
+
+class InFlightFillsTest : public testing::Test {
+protected:
+  InFlightFillsTest() { key_.set_host("example.com"); }
+
+  void pumpDispatcher() { dispatcher_->run(Event::Dispatcher::RunType::NonBlock); }
+
+  Api::ApiPtr api_ = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher_ = api_->allocateDispatcher("test_thread");
+  InFlightFills fills_;
+  Key key_;
+};
+
+TEST_F(InFlightFillsTest, FirstRequestFills) {
+  EXPECT_FALSE(fills_.waitForFill(key_, *dispatcher_, []() { FAIL(); }).has_value());
+  EXPECT_EQ(1, fills_.size());
+  fills_.endFill(key_);
+  EXPECT_EQ(0, fills_.size());
+}
+
+TEST_F(InFlightFillsTest, WaitersArePostedWhenFillEnds) {
+  ASSERT_FALSE(fills_.waitForFill(key_, *dispatcher_, []() {}).has_value());
+  int completed = 0;
+  auto cancel1 = fills_.waitForFill(key_, *dispatcher_, [&completed]() { ++completed; });
+  auto cancel2 = fills_.waitForFill(key_, *dispatcher_, [&completed]() { ++completed; });
+  ASSERT_TRUE(cancel1.has_value());
+  ASSERT_TRUE(cancel2.has_value());
+
+  fills_.endFill(key_);
+  EXPECT_EQ(0, completed);
+  pumpDispatcher();
+  EXPECT_EQ(2, completed);
+
+  // The next request fills again.
+  EXPECT_FALSE(fills_.waitForFill(key_, *dispatcher_, []() {}).has_value());
+}
+
+TEST_F(InFlightFillsTest, CancelledWaiterIsntCalled) {
+  ASSERT_FALSE(fills_.waitForFill(key_, *dispatcher_, []() {}).has_value());
+  bool completed = false;
+  auto cancel = fills_.waitForFill(key_, *dispatcher_, [&completed]() { completed = true; });
+  ASSERT_TRUE(cancel.has_value());
+  (*cancel)();
+  fills_.endFill(key_);
+  pumpDispatcher();
+  EXPECT_FALSE(completed);
+}
+
+TEST_F(InFlightFillsTest, KeysAreFilledIndependently) {
+  Key other_key = key_;
+  other_key.set_path("/other");
+  EXPECT_FALSE(fills_.waitForFill(key_, *dispatcher_, []() {}).has_value());
+  EXPECT_FALSE(fills_.waitForFill(other_key, *dispatcher_, []() {}).has_value());
+  EXPECT_EQ(2, fills_.size());
+}
+
+} // namespace
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
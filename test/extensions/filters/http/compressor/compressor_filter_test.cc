@@ -1,8 +1,12 @@
+#include <deque>
+#include <string>
+
 #include "source/extensions/filters/http/compressor/compressor_filter.h"
 
 #include "test/mocks/compression/compressor/mocks.h"
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/server/overload_manager.h"
 #include "test/mocks/stats/mocks.h"
 #include "test/test_common/utility.h"
 
@@ -18,24 +22,79 @@ using envoy::extensions::filters::http::compressor::v3::CompressorPerRoute;
 using testing::NiceMock;
 using testing::Return;
 
+// A chunk passed to an asynchronous compressor, completed by the test.
+struct AsyncChunk {
+  std::string data_;
+  Envoy::Compression::Compressor::State state_;
+  Envoy::Compression::Compressor::AsyncCompressor::Done done_;
+};
+
+// Asynchronous compressor appending the state to the chunks instead of compressing them, whose
+// pending chunks are cancelled when it's destroyed.
+class TestAsyncCompressor : public Envoy::Compression::Compressor::AsyncCompressor {
+public:
+  explicit TestAsyncCompressor(std::deque<AsyncChunk>& chunks) : chunks_(chunks) {}
+  ~TestAsyncCompressor() override { chunks_.clear(); }
+
+  void compress(Buffer::Instance& data, Envoy::Compression::Compressor::State state,
+                Done done) override {
+    EXPECT_TRUE(chunks_.empty());
+    chunks_.push_back({data.toString(), state, std::move(done)});
+    data.drain(data.length());
+  }
+
+private:
+  std::deque<AsyncChunk>& chunks_;
+};
+
 class TestCompressorFactory : public Envoy::Compression::Compressor::CompressorFactory {
 public:
-  TestCompressorFactory(const std::string& content_encoding)
-      : content_encoding_(content_encoding) {}
+  TestCompressorFactory(const std::string& content_encoding,
+                        const std::string& shared_dictionary_hash = "")
+      : content_encoding_(content_encoding), shared_dictionary_hash_(shared_dictionary_hash) {}
 
   Envoy::Compression::Compressor::CompressorPtr createCompressor() override {
     auto compressor = std::make_unique<Compression::Compressor::MockCompressor>();
     EXPECT_CALL(*compressor, compress(_, _)).Times(expected_compress_calls_);
     return compressor;
   }
+  Envoy::Compression::Compressor::CompressorPtr createLowEffortCompressor() override {
+    ++low_effort_compressors_;
+    return createCompressor();
+  }
+  Envoy::Compression::Compressor::AsyncCompressorPtr
+  createAsyncCompressor(Event::Dispatcher&) override {
+    if (!async_) {
+      return nullptr;
+    }
+    return std::make_unique<TestAsyncCompressor>(async_chunks_);
+  }
   const std::string& statsPrefix() const override { CONSTRUCT_ON_FIRST_USE(std::string, "test."); }
   const std::string& contentEncoding() const override { return content_encoding_; }
+  absl::string_view sharedDictionaryHash() const override { return shared_dictionary_hash_; }
 
   void setExpectedCompressCalls(uint32_t calls) { expected_compress_calls_ = calls; }
+  uint32_t lowEffortCompressors() const { return low_effort_compressors_; }
+  void setAsync() { async_ = true; }
+  size_t pendingAsyncChunks() const { return async_chunks_.size(); }
+  // Completes the pending chunk, whose data and state are returned.
+  std::string completeAsyncChunk() {
+    AsyncChunk chunk = std::move(async_chunks_.front());
+    async_chunks_.pop_front();
+    const std::string compressed = absl::StrCat(
+        chunk.data_,
+        chunk.state_ == Envoy::Compression::Compressor::State::Finish ? "|finish" : "|flush");
+    chunk.done_(std::make_unique<Buffer::OwnedImpl>(compressed));
+    return compressed;
+  }
 
 private:
+  bool async_{};
+  std::deque<AsyncChunk> async_chunks_;
   uint32_t expected_compress_calls_{1};
+  uint32_t low_effort_compressors_{};
   const std::string content_encoding_;
+  const std::string shared_dictionary_hash_;
 };
 
 class CompressorFilterTest : public testing::Test {
@@ -65,7 +124,8 @@ public:
     auto compressor_factory = std::make_unique<TestCompressorFactory>("test");
     compressor_factory_ = compressor_factory.get();
     config_ = std::make_shared<CompressorFilterConfig>(compressor, "test.", *stats_.rootScope(),
-                                                       runtime_, std::move(compressor_factory));
+                                                       runtime_, std::move(compressor_factory),
+                                                       overload_manager_);
     filter_ = std::make_unique<CompressorFilter>(config_);
     filter_->setDecoderFilterCallbacks(decoder_callbacks_);
     filter_->setEncoderFilterCallbacks(encoder_callbacks_);
@@ -179,6 +239,7 @@ public:
   std::string response_stats_prefix_{};
   Stats::TestUtil::TestStore stats_;
   NiceMock<Runtime::MockLoader> runtime_;
+  NiceMock<Server::MockOverloadManager> overload_manager_;
   NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks_;
   NiceMock<Http::MockStreamEncoderFilterCallbacks> encoder_callbacks_;
 };
@@ -429,6 +490,130 @@ TEST_F(CompressorFilterTest, EmptyResponse) {
 }
 
 // Verify removeAcceptEncoding header.
+TEST_F(CompressorFilterTest, LowEffortCompressionUnderResourcePressure) {
+  NiceMock<Server::MockLoadShedPoint> low_effort_point;
+  ON_CALL(overload_manager_,
+          getLoadShedPoint("envoy.load_shed_points.http_compressor_low_effort"))
+      .WillByDefault(Return(&low_effort_point));
+  setUpFilter(R"EOF(
+{
+  "compressor_library": {
+     "name": "test",
+     "typed_config": {
+       "@type": "type.googleapis.com/envoy.extensions.compression.gzip.compressor.v3.Gzip"
+     }
+  }
+}
+)EOF");
+  EXPECT_CALL(low_effort_point, shouldShedLoad()).WillOnce(Return(true));
+  doRequestNoCompression({{":method", "get"}, {"accept-encoding", "test"}});
+  Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
+  doResponseCompression(headers, false);
+  EXPECT_EQ(1, compressor_factory_->lowEffortCompressors());
+  EXPECT_EQ(1, stats_.counter("test.compressor.test.test.compressed_low_effort").value());
+}
+
+TEST_F(CompressorFilterTest, BypassCompressionUnderResourcePressure) {
+  NiceMock<Server::MockLoadShedPoint> bypass_point;
+  ON_CALL(overload_manager_, getLoadShedPoint("envoy.load_shed_points.http_compressor_bypass"))
+      .WillByDefault(Return(&bypass_point));
+  setUpFilter(R"EOF(
+{
+  "compressor_library": {
+     "name": "test",
+     "typed_config": {
+       "@type": "type.googleapis.com/envoy.extensions.compression.gzip.compressor.v3.Gzip"
+     }
+  }
+}
+)EOF");
+  EXPECT_CALL(bypass_point, shouldShedLoad()).WillOnce(Return(true));
+  doRequestNoCompression({{":method", "get"}, {"accept-encoding", "test"}});
+  Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
+  doResponseNoCompression(headers);
+  EXPECT_EQ(1, stats_.counter("test.compressor.test.test.not_compressed_overload").value());
+  // The response could still be compressed for other requests.
+  EXPECT_EQ("Accept-Encoding", headers.get_("vary"));
+}
+
+TEST_F(CompressorFilterTest, AsyncResponseCompression) {
+  compressor_factory_->setAsync();
+  doRequestNoCompression({{":method", "get"}, {"accept-encoding", "test"}});
+  Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+  EXPECT_EQ("test", headers.get_("content-encoding"));
+
+  Buffer::OwnedImpl first("abc");
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(first, false));
+  // Chunks are compressed one at a time, the data received meanwhile waiting for the next one.
+  Buffer::OwnedImpl second("def");
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(second, false));
+  Buffer::OwnedImpl last("ghi");
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(last, true));
+  EXPECT_EQ(1, compressor_factory_->pendingAsyncChunks());
+
+  std::string injected;
+  EXPECT_CALL(encoder_callbacks_, injectEncodedDataToFilterChain(_, false))
+      .WillOnce(Invoke([&](Buffer::Instance& data, bool) { injected += data.toString(); }));
+  EXPECT_EQ("abc|flush", compressor_factory_->completeAsyncChunk());
+  EXPECT_CALL(encoder_callbacks_, injectEncodedDataToFilterChain(_, true))
+      .WillOnce(Invoke([&](Buffer::Instance& data, bool) { injected += data.toString(); }));
+  EXPECT_EQ("defghi|finish", compressor_factory_->completeAsyncChunk());
+
+  EXPECT_EQ("abc|flushdefghi|finish", injected);
+  EXPECT_EQ(9, stats_.counter("test.compressor.test.test.total_uncompressed_bytes").value());
+  EXPECT_EQ(injected.size(),
+            stats_.counter("test.compressor.test.test.total_compressed_bytes").value());
+}
+
+TEST_F(CompressorFilterTest, AsyncResponseCompressionWithTrailers) {
+  compressor_factory_->setAsync();
+  doRequestNoCompression({{":method", "get"}, {"accept-encoding", "test"}});
+  Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+  Buffer::OwnedImpl data("abc");
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(data, false));
+  Http::TestResponseTrailerMapImpl trailers;
+  EXPECT_EQ(Http::FilterTrailersStatus::StopIteration, filter_->encodeTrailers(trailers));
+
+  EXPECT_CALL(encoder_callbacks_, injectEncodedDataToFilterChain(_, false)).Times(2);
+  EXPECT_EQ("abc|flush", compressor_factory_->completeAsyncChunk());
+  // The trailers are passed on once the compressed stream is finished.
+  EXPECT_CALL(encoder_callbacks_, continueEncoding());
+  EXPECT_EQ("|finish", compressor_factory_->completeAsyncChunk());
+}
+
+TEST_F(CompressorFilterTest, AsyncResponseCompressionWatermarks) {
+  compressor_factory_->setAsync();
+  ON_CALL(encoder_callbacks_, encoderBufferLimit()).WillByDefault(Return(4));
+  doRequestNoCompression({{":method", "get"}, {"accept-encoding", "test"}});
+  Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+  Buffer::OwnedImpl first("abc");
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(first, false));
+
+  EXPECT_CALL(encoder_callbacks_, onEncoderFilterAboveWriteBufferHighWatermark());
+  Buffer::OwnedImpl second("defgh");
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(second, false));
+
+  EXPECT_CALL(encoder_callbacks_, onEncoderFilterBelowWriteBufferLowWatermark());
+  EXPECT_EQ("abc|flush", compressor_factory_->completeAsyncChunk());
+  EXPECT_EQ(1, compressor_factory_->pendingAsyncChunks());
+}
+
+TEST_F(CompressorFilterTest, AsyncResponseCompressionCancelledOnDestroy) {
+  compressor_factory_->setAsync();
+  doRequestNoCompression({{":method", "get"}, {"accept-encoding", "test"}});
+  Http::TestResponseHeaderMapImpl headers{{":method", "get"}, {"content-length", "256"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(headers, false));
+  Buffer::OwnedImpl data("abc");
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(data, true));
+  EXPECT_EQ(1, compressor_factory_->pendingAsyncChunks());
+
+  filter_->onDestroy();
+  EXPECT_EQ(0, compressor_factory_->pendingAsyncChunks());
+}
+
 TEST_F(CompressorFilterTest, RemoveAcceptEncodingHeader) {
   // Filter true, no response direction overrides. Header is removed.
   {
@@ -930,7 +1115,8 @@ protected:
     auto compressor_factory1 = std::make_unique<TestCompressorFactory>("test1");
     compressor_factory1->setExpectedCompressCalls(0);
     auto config1 = std::make_shared<CompressorFilterConfig>(
-        compressor, "test1.", *stats1_.rootScope(), runtime_, std::move(compressor_factory1));
+        compressor, "test1.", *stats1_.rootScope(), runtime_, std::move(compressor_factory1),
+        overload_manager_);
     filter1_ = std::make_unique<CompressorFilter>(config1);
 
     TestUtility::loadFromJson(R"EOF(
@@ -947,11 +1133,13 @@ protected:
     auto compressor_factory2 = std::make_unique<TestCompressorFactory>("test2");
     compressor_factory2->setExpectedCompressCalls(0);
     auto config2 = std::make_shared<CompressorFilterConfig>(
-        compressor, "test2.", *stats2_.rootScope(), runtime_, std::move(compressor_factory2));
+        compressor, "test2.", *stats2_.rootScope(), runtime_, std::move(compressor_factory2),
+        overload_manager_);
     filter2_ = std::make_unique<CompressorFilter>(config2);
   }
 
   NiceMock<Runtime::MockLoader> runtime_;
+  NiceMock<Server::MockOverloadManager> overload_manager_;
   Stats::TestUtil::TestStore stats1_;
   Stats::TestUtil::TestStore stats2_;
   std::unique_ptr<CompressorFilter> filter1_;
@@ -1029,6 +1217,69 @@ TEST_F(MultipleFiltersTest, UseFirstRegisteredFilterWhenWildcard) {
   EXPECT_EQ(1, stats2_.counter("test2.compressor.test2.test.header_wildcard").value());
 }
 
+class SharedDictionaryTest : public MultipleFiltersTest {
+protected:
+  void SetUp() override {
+    envoy::extensions::filters::http::compressor::v3::Compressor compressor;
+    compressor.mutable_compressor_library()->set_name("test1");
+    auto compressor_factory1 = std::make_unique<TestCompressorFactory>("test1");
+    compressor_factory1->setExpectedCompressCalls(0);
+    filter1_ = std::make_unique<CompressorFilter>(std::make_shared<CompressorFilterConfig>(
+        compressor, "test1.", *stats1_.rootScope(), runtime_, std::move(compressor_factory1),
+        overload_manager_));
+
+    compressor.mutable_compressor_library()->set_name("test2");
+    auto compressor_factory2 = std::make_unique<TestCompressorFactory>("dcz", ":hash:");
+    compressor_factory2->setExpectedCompressCalls(0);
+    filter2_ = std::make_unique<CompressorFilter>(std::make_shared<CompressorFilterConfig>(
+        compressor, "test2.", *stats2_.rootScope(), runtime_, std::move(compressor_factory2),
+        overload_manager_));
+
+    filter1_->setDecoderFilterCallbacks(decoder_callbacks_);
+    filter2_->setDecoderFilterCallbacks(decoder_callbacks_);
+  }
+
+  void doRequest(Http::TestRequestHeaderMapImpl&& request_headers) {
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+              filter1_->decodeHeaders(request_headers, false));
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+              filter2_->decodeHeaders(request_headers, false));
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter1_->encodeHeaders(headers_, false));
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter2_->encodeHeaders(headers_, false));
+  }
+
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks_;
+  Http::TestResponseHeaderMapImpl headers_{{":method", "get"}, {"content-length", "256"}};
+};
+
+TEST_F(SharedDictionaryTest, PreferredWhenDictionaryIsAvailable) {
+  doRequest({{":method", "get"},
+             {"accept-encoding", "test1, dcz"},
+             {"available-dictionary", ":hash:"}});
+  EXPECT_EQ("dcz", headers_.get_("content-encoding"));
+  EXPECT_EQ("Accept-Encoding, Available-Dictionary", headers_.get_("vary"));
+  EXPECT_EQ(1, stats2_.counter("test2.compressor.test2.test.compressed").value());
+  EXPECT_EQ(1,
+            stats1_.counter("test1.compressor.test1.test.header_compressor_overshadowed").value());
+}
+
+TEST_F(SharedDictionaryTest, SkippedWhenDictionaryIsNotAvailable) {
+  doRequest({{":method", "get"},
+             {"accept-encoding", "dcz, test1"},
+             {"available-dictionary", ":other:"}});
+  EXPECT_EQ("test1", headers_.get_("content-encoding"));
+  EXPECT_EQ("Accept-Encoding, Available-Dictionary", headers_.get_("vary"));
+  EXPECT_EQ(1, stats1_.counter("test1.compressor.test1.test.compressed").value());
+  EXPECT_EQ(0, stats2_.counter("test2.compressor.test2.test.compressed").value());
+}
+
+TEST_F(SharedDictionaryTest, SkippedWithoutDictionary) {
+  doRequest({{":method", "get"}, {"accept-encoding", "dcz"}});
+  EXPECT_FALSE(headers_.has("content-encoding"));
+  EXPECT_EQ(0, stats1_.counter("test1.compressor.test1.test.compressed").value());
+  EXPECT_EQ(0, stats2_.counter("test2.compressor.test2.test.compressed").value());
+}
+
 // TODO(giantcroc): Refactor the code of MultipleFiltersTest and CompressorFilterTest due to many
 // duplicate methods
 class ChooseFirstTest : public MultipleFiltersTest,
@@ -1053,7 +1304,8 @@ protected:
                               compressor);
     auto compressor_factory1 = std::make_unique<TestCompressorFactory>("test1");
     auto config1 = std::make_shared<CompressorFilterConfig>(
-        compressor, "test1.", *stats1_.rootScope(), runtime_, std::move(compressor_factory1));
+        compressor, "test1.", *stats1_.rootScope(), runtime_, std::move(compressor_factory1),
+        overload_manager_);
     filter1_ = std::make_unique<CompressorFilter>(config1);
 
     TestUtility::loadFromJson(fmt::format(R"EOF(
@@ -1071,7 +1323,8 @@ protected:
                               compressor);
     auto compressor_factory2 = std::make_unique<TestCompressorFactory>("test2");
     auto config2 = std::make_shared<CompressorFilterConfig>(
-        compressor, "test2.", *stats2_.rootScope(), runtime_, std::move(compressor_factory2));
+        compressor, "test2.", *stats2_.rootScope(), runtime_, std::move(compressor_factory2),
+        overload_manager_);
     filter2_ = std::make_unique<CompressorFilter>(config2);
   }
 
@@ -1173,14 +1426,16 @@ TEST_P(ChooseFirstTest, Validate) {
 TEST(CompressorFilterConfigTests, MakeCompressorTest) {
   const envoy::extensions::filters::http::compressor::v3::Compressor compressor_cfg;
   NiceMock<Runtime::MockLoader> runtime;
+  NiceMock<Server::MockOverloadManager> overload_manager;
   Stats::TestUtil::TestStore stats;
   auto compressor_factory(std::make_unique<Compression::Compressor::MockCompressorFactory>());
   EXPECT_CALL(*compressor_factory, createCompressor());
   EXPECT_CALL(*compressor_factory, statsPrefix());
   EXPECT_CALL(*compressor_factory, contentEncoding());
   CompressorFilterConfig config(compressor_cfg, "test.compressor.", *stats.rootScope(), runtime,
-                                std::move(compressor_factory));
-  Envoy::Compression::Compressor::CompressorPtr compressor = config.makeCompressor();
+                                std::move(compressor_factory), overload_manager);
+  Envoy::Compression::Compressor::CompressorPtr compressor =
+      config.makeCompressor(config.responseDirectionConfig().stats());
 }
 
 } // namespace
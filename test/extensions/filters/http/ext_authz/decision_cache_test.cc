@@ -0,0 +1,282 @@
+#include <limits>
+
+#include "envoy/extensions/filters/http/ext_authz/v3/ext_authz.pb.h"
+
+#include "source/common/network/address_impl.h"
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
+
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/router/mocks.h"
+#include "test/mocks/server/server_factory_context.h"
+#include "test/mocks/ssl/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+namespace {
+
+using Filters::Common::ExtAuthz::CheckStatus;
+using Filters::Common::ExtAuthz::Response;
+
+CachedResponseSharedPtr makeResponse(CheckStatus status, std::string body = "") {
+  auto response = std::make_shared<Response>();
+  response->status = status;
+  response->body = std::move(body);
+  return response;
+}
+
+class DecisionCacheTest : public testing::Test {
+protected:
+  Event::SimulatedTimeSystem time_system_;
+};
+
+TEST_F(DecisionCacheTest, Expiry) {
+  DecisionCache cache(DefaultDecisionCacheMaxBytes);
+  const MonotonicTime now = time_system_.monotonicTime();
+  EXPECT_EQ(cache.insert("a", makeResponse(CheckStatus::OK), now + std::chrono::seconds(1)), 0);
+
+  MonotonicTime expires_at;
+  ASSERT_NE(cache.lookup("a", now, &expires_at), nullptr);
+  EXPECT_EQ(expires_at, now + std::chrono::seconds(1));
+  EXPECT_EQ(cache.lookup("b", now), nullptr);
+
+  EXPECT_EQ(cache.lookup("a", now + std::chrono::seconds(1)), nullptr);
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.bytes(), 0);
+}
+
+TEST_F(DecisionCacheTest, EvictsLeastRecentlyUsed) {
+  const auto response = makeResponse(CheckStatus::Denied, "denied");
+  const uint64_t entry_bytes = DecisionCache::entryBytes("a", *response);
+  DecisionCache cache(2 * entry_bytes);
+  const MonotonicTime expires_at = time_system_.monotonicTime() + std::chrono::seconds(10);
+
+  EXPECT_EQ(cache.insert("a", response, expires_at), 0);
+  EXPECT_EQ(cache.insert("b", response, expires_at), 0);
+  EXPECT_EQ(cache.bytes(), 2 * entry_bytes);
+  // Using "a" makes "b" the least recently used entry.
+  EXPECT_NE(cache.lookup("a", time_system_.monotonicTime()), nullptr);
+  EXPECT_EQ(cache.insert("c", response, expires_at), 1);
+  EXPECT_EQ(cache.lookup("b", time_system_.monotonicTime()), nullptr);
+  EXPECT_NE(cache.lookup("a", time_system_.monotonicTime()), nullptr);
+  EXPECT_NE(cache.lookup("c", time_system_.monotonicTime()), nullptr);
+
+  // Replacing an entry does not evict others.
+  EXPECT_EQ(cache.insert("c", response, expires_at), 0);
+  EXPECT_EQ(cache.size(), 2);
+
+  // Entries larger than the whole cache are not cached.
+  EXPECT_EQ(cache.insert("d", makeResponse(CheckStatus::OK, std::string(3 * entry_bytes, 'x')),
+                         expires_at),
+            0);
+  EXPECT_EQ(cache.lookup("d", time_system_.monotonicTime()), nullptr);
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST_F(DecisionCacheTest, SharedTierKeepsExpiry) {
+  SharedDecisionCache cache(DefaultDecisionCacheMaxBytes);
+  const MonotonicTime now = time_system_.monotonicTime();
+  cache.insert("a", makeResponse(CheckStatus::OK), now + std::chrono::seconds(3));
+
+  MonotonicTime expires_at;
+  EXPECT_NE(cache.lookup("a", now, &expires_at), nullptr);
+  EXPECT_EQ(expires_at, now + std::chrono::seconds(3));
+  EXPECT_EQ(cache.lookup("a", now + std::chrono::seconds(3), nullptr), nullptr);
+}
+
+class DecisionCacheManagerTest : public testing::Test {
+protected:
+  DecisionCacheManagerTest() {
+    ON_CALL(factory_context_, timeSource()).WillByDefault(ReturnRef(time_system_));
+    connection_.stream_info_.downstream_connection_info_provider_->setRemoteAddress(
+        std::make_shared<Network::Address::Ipv4Instance>("1.2.3.4", 1111));
+  }
+
+  void initialize(const std::string& yaml) {
+    envoy::extensions::filters::http::ext_authz::v3::DecisionCache config;
+    TestUtility::loadFromYaml(yaml, config);
+    manager_ = std::make_unique<DecisionCacheManager>(config, factory_context_);
+  }
+
+  std::string cacheKey(const Http::RequestHeaderMap& headers,
+                       const Router::Route* route = nullptr) {
+    return manager_->cacheKey(headers, &connection_, route, context_extensions_,
+                              route_metadata_context_);
+  }
+
+  Response responseWithTtl(const ProtobufWkt::Value& ttl) {
+    Response response;
+    response.status = CheckStatus::OK;
+    (*response.dynamic_metadata.mutable_fields())["decision_ttl_seconds"] = ttl;
+    return response;
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context_;
+  NiceMock<Network::MockConnection> connection_;
+  std::unique_ptr<DecisionCacheManager> manager_;
+  Protobuf::Map<std::string, std::string> context_extensions_;
+  envoy::config::core::v3::Metadata route_metadata_context_;
+};
+
+TEST_F(DecisionCacheManagerTest, CacheKey) {
+  initialize(R"EOF(
+  key_headers: ["x-tenant"]
+  path_template:
+    pattern:
+      regex: "^/users/[^/]+"
+    substitution: "/users/*"
+  )EOF");
+
+  Http::TestRequestHeaderMapImpl headers{{":method", "GET"},
+                                         {":authority", "example.com"},
+                                         {":path", "/users/alice?verbose=1"},
+                                         {"authorization", "Bearer token"}};
+  const std::string key = cacheKey(headers);
+  EXPECT_EQ(key, "GET\nexample.com\n/users/*\n-\n0\n0\n=Bearer token\n\n\n");
+
+  // Other users share the decision, other credentials do not.
+  headers.setPath("/users/bob");
+  EXPECT_EQ(cacheKey(headers), key);
+  headers.setCopy(Http::LowerCaseString("authorization"), "Bearer other");
+  EXPECT_NE(cacheKey(headers), key);
+
+  // An empty header is not the same as a missing one.
+  headers.setCopy(Http::LowerCaseString("x-tenant"), "");
+  EXPECT_EQ(cacheKey(headers), "GET\nexample.com\n/users/*\n-\n0\n0\n=Bearer other\n\n\n=");
+
+  // Cookies are credentials as well.
+  headers.setCopy(Http::LowerCaseString("cookie"), "session=1");
+  EXPECT_EQ(cacheKey(headers),
+            "GET\nexample.com\n/users/*\n-\n0\n0\n=Bearer other\n\n=session=1\n=");
+}
+
+// The route and what the per-route configs send to the authorization server are part of the key.
+TEST_F(DecisionCacheManagerTest, CacheKeyRoute) {
+  initialize("{}");
+  Http::TestRequestHeaderMapImpl headers{
+      {":method", "GET"}, {":authority", "example.com"}, {":path", "/"}};
+  NiceMock<Router::MockRoute> route;
+  const std::string key = cacheKey(headers, &route);
+  EXPECT_EQ(key, "GET\nexample.com\n/\n10:fake_vhost\n15:fake_route_name\n0\n0\n\n\n");
+  EXPECT_NE(cacheKey(headers), key);
+
+  route.route_name_ = "other_route";
+  EXPECT_NE(cacheKey(headers, &route), key);
+  route.route_name_ = "fake_route_name";
+
+  // Context extensions are sorted by name.
+  context_extensions_["b"] = "2";
+  context_extensions_["a"] = "1";
+  const std::string key_with_extensions =
+      "GET\nexample.com\n/\n10:fake_vhost\n15:fake_route_name\n2\n1:a\n1:1\n1:b\n1:2\n0\n\n\n";
+  EXPECT_EQ(cacheKey(headers, &route), key_with_extensions);
+
+  (*route_metadata_context_.mutable_filter_metadata())["ns"] = ProtobufWkt::Struct();
+  EXPECT_NE(cacheKey(headers, &route), key_with_extensions);
+}
+
+TEST_F(DecisionCacheManagerTest, PeerIdentity) {
+  initialize("include_peer_identity: true");
+  Http::TestRequestHeaderMapImpl headers{
+      {":method", "GET"}, {":authority", "example.com"}, {":path", "/"}};
+  EXPECT_EQ(cacheKey(headers), "GET\nexample.com\n/\n-\n0\n0\n\n\n\nip:1.2.3.4");
+
+  auto ssl = std::make_shared<NiceMock<Ssl::MockConnectionInfo>>();
+  const std::vector<std::string> uri_sans{"spiffe://example.com/client"};
+  const std::string subject = "CN=client";
+  ON_CALL(*ssl, subjectPeerCertificate()).WillByDefault(ReturnRef(subject));
+  ON_CALL(connection_, ssl()).WillByDefault(Return(ssl));
+  EXPECT_EQ(cacheKey(headers), "GET\nexample.com\n/\n-\n0\n0\n\n\n\nsubject:CN=client");
+
+  ON_CALL(*ssl, uriSanPeerCertificate()).WillByDefault(Return(absl::MakeConstSpan(uri_sans)));
+  EXPECT_EQ(cacheKey(headers),
+            "GET\nexample.com\n/\n-\n0\n0\n\n\n\nuri:spiffe://example.com/client");
+}
+
+TEST_F(DecisionCacheManagerTest, Ttl) {
+  initialize("default_ttl: 10s");
+
+  // The TTL of the authorization server wins over the default one.
+  ProtobufWkt::Value ttl;
+  ttl.set_number_value(1);
+  manager_->insert("number", responseWithTtl(ttl));
+  ttl.set_string_value("100");
+  manager_->insert("string", responseWithTtl(ttl));
+  ttl.set_number_value(0);
+  manager_->insert("zero", responseWithTtl(ttl));
+  ttl.set_bool_value(true);
+  manager_->insert("invalid", responseWithTtl(ttl));
+  manager_->insert("default", *makeResponse(CheckStatus::Denied));
+
+  EXPECT_NE(manager_->lookup("number"), nullptr);
+  EXPECT_NE(manager_->lookup("string"), nullptr);
+  EXPECT_EQ(manager_->lookup("zero"), nullptr);
+  EXPECT_EQ(manager_->lookup("invalid"), nullptr);
+  EXPECT_NE(manager_->lookup("default"), nullptr);
+
+  time_system_.advanceTimeWait(std::chrono::seconds(5));
+  EXPECT_EQ(manager_->lookup("number"), nullptr);
+  EXPECT_NE(manager_->lookup("default"), nullptr);
+  time_system_.advanceTimeWait(std::chrono::seconds(5));
+  EXPECT_EQ(manager_->lookup("default"), nullptr);
+  EXPECT_NE(manager_->lookup("string"), nullptr);
+}
+
+// TTLs that don't fit in the TTL type are not cached or are reduced to max_ttl.
+TEST_F(DecisionCacheManagerTest, TtlBounds) {
+  initialize(R"EOF(
+  default_ttl: 600s
+  max_ttl: 60s
+  )EOF");
+
+  ProtobufWkt::Value ttl;
+  ttl.set_number_value(std::numeric_limits<double>::quiet_NaN());
+  manager_->insert("nan", responseWithTtl(ttl));
+  ttl.set_number_value(std::numeric_limits<double>::infinity());
+  manager_->insert("infinity", responseWithTtl(ttl));
+  ttl.set_string_value("-inf");
+  manager_->insert("negative_infinity", responseWithTtl(ttl));
+  ttl.set_number_value(-1e300);
+  manager_->insert("negative", responseWithTtl(ttl));
+  ttl.set_number_value(1e300);
+  manager_->insert("huge", responseWithTtl(ttl));
+  ttl.set_string_value("1e300");
+  manager_->insert("huge_string", responseWithTtl(ttl));
+  manager_->insert("default", *makeResponse(CheckStatus::OK));
+
+  EXPECT_EQ(manager_->lookup("nan"), nullptr);
+  EXPECT_EQ(manager_->lookup("infinity"), nullptr);
+  EXPECT_EQ(manager_->lookup("negative_infinity"), nullptr);
+  EXPECT_EQ(manager_->lookup("negative"), nullptr);
+  EXPECT_NE(manager_->lookup("huge"), nullptr);
+  EXPECT_NE(manager_->lookup("huge_string"), nullptr);
+  EXPECT_NE(manager_->lookup("default"), nullptr);
+
+  time_system_.advanceTimeWait(std::chrono::seconds(60));
+  EXPECT_EQ(manager_->lookup("huge"), nullptr);
+  EXPECT_EQ(manager_->lookup("huge_string"), nullptr);
+  EXPECT_EQ(manager_->lookup("default"), nullptr);
+}
+
+TEST_F(DecisionCacheManagerTest, NoTtl) {
+  initialize("{}");
+  manager_->insert("key", *makeResponse(CheckStatus::OK));
+  EXPECT_EQ(manager_->lookup("key"), nullptr);
+}
+
+} // namespace
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -1063,6 +1063,106 @@ TEST_F(HttpFilterTest, ErrorFailClose) {
   EXPECT_EQ(1U, config_->stats().error_.value());
 }
 
+// Decisions are served from the decision cache to later requests with the same cache key.
+TEST_F(HttpFilterTest, DecisionCacheHit) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_authz_server"
+  decision_cache:
+    default_ttl: 10s
+  )EOF");
+
+  prepareCheck();
+  request_headers_.addCopy(Http::Headers::get().Path, "/foo");
+  request_headers_.addCopy(Http::LowerCaseString("authorization"), "Bearer token");
+  EXPECT_CALL(*client_, check(_, _, _, _))
+      .WillOnce(
+          Invoke([&](Filters::Common::ExtAuthz::RequestCallbacks& callbacks,
+                     const envoy::service::auth::v3::CheckRequest&, Tracing::Span&,
+                     const StreamInfo::StreamInfo&) -> void { request_callbacks_ = &callbacks; }));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            filter_->decodeHeaders(request_headers_, false));
+  Filters::Common::ExtAuthz::Response response{};
+  response.status = Filters::Common::ExtAuthz::CheckStatus::OK;
+  response.headers_to_set = {{"x-user", "alice"}};
+  EXPECT_CALL(decoder_filter_callbacks_, continueDecoding());
+  request_callbacks_->onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(response));
+  EXPECT_EQ(1U, config_->stats().decision_cache_miss_.value());
+
+  // A second request with the same key is authorized without calling the server.
+  client_ = new NiceMock<Filters::Common::ExtAuthz::MockClient>();
+  filter_ = std::make_unique<Filter>(config_, Filters::Common::ExtAuthz::ClientPtr{client_});
+  filter_->setDecoderFilterCallbacks(decoder_filter_callbacks_);
+  Http::TestRequestHeaderMapImpl request_headers{{":path", "/foo"},
+                                                 {"authorization", "Bearer token"}};
+  EXPECT_CALL(*client_, check(_, _, _, _)).Times(0);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, false));
+  EXPECT_EQ(request_headers.get_("x-user"), "alice");
+  EXPECT_EQ(1U, config_->stats().decision_cache_hit_.value());
+  EXPECT_EQ(2U, config_->stats().ok_.value());
+
+  // Other credentials miss the cache.
+  client_ = new NiceMock<Filters::Common::ExtAuthz::MockClient>();
+  filter_ = std::make_unique<Filter>(config_, Filters::Common::ExtAuthz::ClientPtr{client_});
+  filter_->setDecoderFilterCallbacks(decoder_filter_callbacks_);
+  request_headers.setCopy(Http::LowerCaseString("authorization"), "Bearer other");
+  EXPECT_CALL(*client_, check(_, _, _, _));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            filter_->decodeHeaders(request_headers, false));
+  EXPECT_EQ(2U, config_->stats().decision_cache_miss_.value());
+}
+
+// Decisions made with the context extensions of one route are not reused for another route.
+TEST_F(HttpFilterTest, DecisionCachePerRouteContextExtensions) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_authz_server"
+  decision_cache:
+    default_ttl: 10s
+  )EOF");
+
+  envoy::extensions::filters::http::ext_authz::v3::ExtAuthzPerRoute settings;
+  (*settings.mutable_check_settings()->mutable_context_extensions())["tenant"] = "a";
+  FilterConfigPerRoute tenant_a(settings);
+  (*settings.mutable_check_settings()->mutable_context_extensions())["tenant"] = "b";
+  FilterConfigPerRoute tenant_b(settings);
+  const FilterConfigPerRoute* per_route = &tenant_a;
+  ON_CALL(*decoder_filter_callbacks_.route_, mostSpecificPerFilterConfig(_))
+      .WillByDefault(Invoke([&](absl::string_view) { return per_route; }));
+  ON_CALL(*decoder_filter_callbacks_.route_, perFilterConfigs(_))
+      .WillByDefault(Invoke([&](absl::string_view) -> Router::RouteSpecificFilterConfigs {
+        return {per_route};
+      }));
+
+  prepareCheck();
+  request_headers_.addCopy(Http::Headers::get().Path, "/foo");
+  EXPECT_CALL(*client_, check(_, _, _, _))
+      .WillOnce(
+          Invoke([&](Filters::Common::ExtAuthz::RequestCallbacks& callbacks,
+                     const envoy::service::auth::v3::CheckRequest&, Tracing::Span&,
+                     const StreamInfo::StreamInfo&) -> void { request_callbacks_ = &callbacks; }));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            filter_->decodeHeaders(request_headers_, false));
+  Filters::Common::ExtAuthz::Response response{};
+  response.status = Filters::Common::ExtAuthz::CheckStatus::OK;
+  EXPECT_CALL(decoder_filter_callbacks_, continueDecoding());
+  request_callbacks_->onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(response));
+
+  // The same request with the context extensions of another route calls the server.
+  per_route = &tenant_b;
+  client_ = new NiceMock<Filters::Common::ExtAuthz::MockClient>();
+  filter_ = std::make_unique<Filter>(config_, Filters::Common::ExtAuthz::ClientPtr{client_});
+  filter_->setDecoderFilterCallbacks(decoder_filter_callbacks_);
+  Http::TestRequestHeaderMapImpl request_headers{{":path", "/foo"}};
+  EXPECT_CALL(*client_, check(_, _, _, _));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            filter_->decodeHeaders(request_headers, false));
+  EXPECT_EQ(0U, config_->stats().decision_cache_hit_.value());
+  EXPECT_EQ(2U, config_->stats().decision_cache_miss_.value());
+}
+
 // Verifies that the filter responds with a configurable HTTP status when an network error occurs.
 TEST_F(HttpFilterTest, ErrorCustomStatusCode) {
   InSequence s;
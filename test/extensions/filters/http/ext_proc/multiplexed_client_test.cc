@@ -0,0 +1,236 @@
+#include "source/common/grpc/codec.h"
+#include "source/common/grpc/common.h"
+#include "source/extensions/filters/http/ext_proc/multiplexed_client_impl.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/grpc/mocks.h"
+#include "test/mocks/stream_info/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using envoy::service::ext_proc::v3::ProcessingRequest;
+using envoy::service::ext_proc::v3::ProcessingRequestBatch;
+using envoy::service::ext_proc::v3::ProcessingResponse;
+using envoy::service::ext_proc::v3::ProcessingResponseBatch;
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExternalProcessing {
+namespace {
+
+class TestCallbacks : public ExternalProcessorCallbacks {
+public:
+  void onReceiveMessage(std::unique_ptr<ProcessingResponse>&& response) override {
+    responses_.push_back(std::move(response));
+  }
+  void onGrpcError(Grpc::Status::GrpcStatus status, const std::string&) override {
+    grpc_status_ = status;
+  }
+  void onGrpcClose() override { grpc_closed_ = true; }
+  void logStreamInfo() override {}
+  void onComplete(ProcessingResponse&) override {}
+  void onError() override {}
+
+  std::vector<std::unique_ptr<ProcessingResponse>> responses_;
+  Grpc::Status::GrpcStatus grpc_status_ = Grpc::Status::WellKnownGrpcStatus::Ok;
+  bool grpc_closed_ = false;
+};
+
+class MultiplexedClientTest : public testing::Test {
+protected:
+  MultiplexedClientTest()
+      : async_client_(std::make_shared<NiceMock<Grpc::MockAsyncClient>>()),
+        flush_callback_(new NiceMock<Event::MockSchedulableCallback>(&dispatcher_)) {
+    ON_CALL(*async_client_, startRaw("envoy.service.ext_proc.v3.ExternalProcessor",
+                                     "ProcessMultiplexed", _, _))
+        .WillByDefault(Invoke([this](absl::string_view, absl::string_view,
+                                     Grpc::RawAsyncStreamCallbacks& callbacks,
+                                     const Http::AsyncClient::StreamOptions&) {
+          stream_callbacks_ = &callbacks;
+          return &grpc_stream_;
+        }));
+    ON_CALL(grpc_stream_, sendMessageRaw_(_, false))
+        .WillByDefault(Invoke([this](Buffer::InstancePtr& request, bool) {
+          // Skip the gRPC frame header.
+          request->drain(Grpc::GRPC_FRAME_HEADER_SIZE);
+          ProcessingRequestBatch batch;
+          ASSERT_TRUE(batch.ParseFromString(request->toString()));
+          sent_batches_.push_back(batch);
+        }));
+    ON_CALL(grpc_stream_, streamInfo()).WillByDefault(ReturnRef(grpc_stream_info_));
+    shared_stream_ = std::make_shared<SharedProcessorStream>(async_client_, dispatcher_, 3);
+  }
+
+  void receive(const ProcessingResponseBatch& batch) {
+    EXPECT_TRUE(stream_callbacks_->onReceiveMessageRaw(Grpc::Common::serializeMessage(batch)));
+  }
+
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  std::shared_ptr<NiceMock<Grpc::MockAsyncClient>> async_client_;
+  NiceMock<Event::MockSchedulableCallback>* flush_callback_;
+  NiceMock<Grpc::MockAsyncStream> grpc_stream_;
+  NiceMock<StreamInfo::MockStreamInfo> grpc_stream_info_;
+  Grpc::RawAsyncStreamCallbacks* stream_callbacks_{};
+  std::vector<ProcessingRequestBatch> sent_batches_;
+  SharedProcessorStreamSharedPtr shared_stream_;
+};
+
+// HTTP streams share one gRPC stream and their headers are sent in one batch.
+TEST_F(MultiplexedClientTest, BatchesHeadersOfStreams) {
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _));
+  TestCallbacks callbacks1, callbacks2;
+  auto stream1 = shared_stream_->attach(callbacks1);
+  auto stream2 = shared_stream_->attach(callbacks2);
+  ASSERT_NE(stream1, nullptr);
+  ASSERT_NE(stream2, nullptr);
+
+  ProcessingRequest request;
+  request.mutable_request_headers();
+  stream1->send(ProcessingRequest(request), false);
+  stream2->send(ProcessingRequest(request), false);
+  EXPECT_TRUE(sent_batches_.empty());
+  EXPECT_TRUE(flush_callback_->enabled_);
+
+  flush_callback_->invokeCallback();
+  ASSERT_EQ(sent_batches_.size(), 1);
+  ASSERT_EQ(sent_batches_[0].requests_size(), 2);
+  EXPECT_EQ(sent_batches_[0].requests(0).stream_id(), 1);
+  EXPECT_TRUE(sent_batches_[0].requests(0).request().has_request_headers());
+  EXPECT_EQ(sent_batches_[0].requests(1).stream_id(), 2);
+  EXPECT_GT(stream1->streamInfo().getUpstreamBytesMeter()->wireBytesSent(), 0);
+}
+
+// Body chunks are sent right away, after the messages held before them.
+TEST_F(MultiplexedClientTest, BodySentImmediately) {
+  TestCallbacks callbacks;
+  auto stream = shared_stream_->attach(callbacks);
+
+  ProcessingRequest headers;
+  headers.mutable_request_headers();
+  stream->send(std::move(headers), false);
+  ProcessingRequest body;
+  body.mutable_request_body()->set_body("foo");
+  stream->send(std::move(body), false);
+
+  ASSERT_EQ(sent_batches_.size(), 1);
+  ASSERT_EQ(sent_batches_[0].requests_size(), 2);
+  EXPECT_TRUE(sent_batches_[0].requests(0).request().has_request_headers());
+  EXPECT_EQ(sent_batches_[0].requests(1).request().request_body().body(), "foo");
+  EXPECT_FALSE(flush_callback_->enabled_);
+}
+
+// A full batch is sent without waiting for the end of the event loop iteration.
+TEST_F(MultiplexedClientTest, FullBatchSent) {
+  TestCallbacks callbacks;
+  auto stream = shared_stream_->attach(callbacks);
+
+  ProcessingRequest request;
+  request.mutable_response_trailers();
+  stream->send(ProcessingRequest(request), false);
+  stream->send(ProcessingRequest(request), false);
+  EXPECT_TRUE(sent_batches_.empty());
+  stream->send(ProcessingRequest(request), false);
+  ASSERT_EQ(sent_batches_.size(), 1);
+  EXPECT_EQ(sent_batches_[0].requests_size(), 3);
+  EXPECT_FALSE(flush_callback_->enabled_);
+}
+
+// Responses are delivered to the HTTP stream they are tagged with.
+TEST_F(MultiplexedClientTest, RoutesResponses) {
+  TestCallbacks callbacks1, callbacks2;
+  auto stream1 = shared_stream_->attach(callbacks1);
+  auto stream2 = shared_stream_->attach(callbacks2);
+
+  ProcessingResponseBatch batch;
+  auto* response = batch.add_responses();
+  response->set_stream_id(2);
+  response->mutable_response()->mutable_request_headers();
+  response = batch.add_responses();
+  response->set_stream_id(1);
+  response->mutable_response()->mutable_response_headers();
+  response->set_end_of_stream(true);
+  // Unknown streams are ignored.
+  batch.add_responses()->set_stream_id(42);
+  receive(batch);
+
+  ASSERT_EQ(callbacks1.responses_.size(), 1);
+  EXPECT_TRUE(callbacks1.responses_[0]->has_response_headers());
+  EXPECT_TRUE(callbacks1.grpc_closed_);
+  ASSERT_EQ(callbacks2.responses_.size(), 1);
+  EXPECT_TRUE(callbacks2.responses_[0]->has_request_headers());
+  EXPECT_FALSE(callbacks2.grpc_closed_);
+
+  // The processor already ended stream 1, so closing it sends nothing.
+  EXPECT_FALSE(stream1->close());
+  EXPECT_FALSE(flush_callback_->enabled_);
+}
+
+// Closing an HTTP stream tells the processor that it ended.
+TEST_F(MultiplexedClientTest, CloseSendsEndOfStream) {
+  TestCallbacks callbacks;
+  auto stream = shared_stream_->attach(callbacks);
+  EXPECT_TRUE(stream->close());
+  EXPECT_FALSE(stream->close());
+
+  flush_callback_->invokeCallback();
+  ASSERT_EQ(sent_batches_.size(), 1);
+  ASSERT_EQ(sent_batches_[0].requests_size(), 1);
+  EXPECT_EQ(sent_batches_[0].requests(0).stream_id(), 1);
+  EXPECT_TRUE(sent_batches_[0].requests(0).end_of_stream());
+  EXPECT_FALSE(sent_batches_[0].requests(0).has_request());
+}
+
+// An error on the shared stream fails all its HTTP streams, and the next HTTP stream starts a new
+// gRPC stream.
+TEST_F(MultiplexedClientTest, RemoteCloseFailsAllStreams) {
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).Times(2);
+  TestCallbacks callbacks1, callbacks2;
+  auto stream1 = shared_stream_->attach(callbacks1);
+  auto stream2 = shared_stream_->attach(callbacks2);
+
+  stream_callbacks_->onRemoteClose(Grpc::Status::Internal, "oops");
+  EXPECT_EQ(callbacks1.grpc_status_, Grpc::Status::Internal);
+  EXPECT_EQ(callbacks2.grpc_status_, Grpc::Status::Internal);
+  EXPECT_FALSE(stream1->close());
+
+  TestCallbacks callbacks3;
+  auto stream3 = shared_stream_->attach(callbacks3);
+  EXPECT_NE(stream3, nullptr);
+}
+
+TEST_F(MultiplexedClientTest, StartFailure) {
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(nullptr));
+  TestCallbacks callbacks;
+  EXPECT_EQ(shared_stream_->attach(callbacks), nullptr);
+  EXPECT_EQ(callbacks.grpc_status_, Grpc::Status::Unavailable);
+}
+
+// Responses for a destroyed filter are dropped.
+TEST_F(MultiplexedClientTest, FilterDestroyed) {
+  TestCallbacks callbacks;
+  auto stream = shared_stream_->attach(callbacks);
+  stream->notifyFilterDestroy();
+
+  ProcessingResponseBatch batch;
+  auto* response = batch.add_responses();
+  response->set_stream_id(1);
+  response->mutable_response()->mutable_request_headers();
+  response->set_end_of_stream(true);
+  receive(batch);
+  EXPECT_TRUE(callbacks.responses_.empty());
+  EXPECT_FALSE(callbacks.grpc_closed_);
+}
+
+} // namespace
+} // namespace ExternalProcessing
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,88 @@
+#include <memory>
+#include <string>
+
+#include "source/common/protobuf/protobuf.h"
+#include "source/extensions/filters/http/grpc_json_transcoder/caching_type_resolver.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace GrpcJsonTranscoder {
+namespace {
+
+// Counts the types resolved by the descriptor pool resolver.
+class CountingTypeResolver : public Protobuf::util::TypeResolver {
+public:
+  CountingTypeResolver()
+      : resolver_(Protobuf::util::NewTypeResolverForDescriptorPool(
+            "type.googleapis.com", Protobuf::DescriptorPool::generated_pool())) {}
+
+  absl::Status ResolveMessageType(const std::string& type_url,
+                                  ProtobufWkt::Type* message_type) override {
+    ++resolved_;
+    return resolver_->ResolveMessageType(type_url, message_type);
+  }
+  absl::Status ResolveEnumType(const std::string& type_url, ProtobufWkt::Enum* enum_type) override {
+    ++resolved_;
+    return resolver_->ResolveEnumType(type_url, enum_type);
+  }
+
+  int resolved_{};
+
+private:
+  const std::unique_ptr<Protobuf::util::TypeResolver> resolver_;
+};
+
+class CachingTypeResolverTest : public testing::Test {
+public:
+  CachingTypeResolverTest() {
+    auto counting = std::make_unique<CountingTypeResolver>();
+    counting_ = counting.get();
+    resolver_ = std::make_unique<CachingTypeResolver>(std::move(counting));
+  }
+
+  CountingTypeResolver* counting_;
+  std::unique_ptr<CachingTypeResolver> resolver_;
+};
+
+TEST_F(CachingTypeResolverTest, CachesMessageTypes) {
+  ProtobufWkt::Type first;
+  ASSERT_TRUE(
+      resolver_->ResolveMessageType("type.googleapis.com/google.protobuf.Duration", &first).ok());
+  ProtobufWkt::Type second;
+  ASSERT_TRUE(
+      resolver_->ResolveMessageType("type.googleapis.com/google.protobuf.Duration", &second).ok());
+
+  EXPECT_EQ("google.protobuf.Duration", second.name());
+  EXPECT_TRUE(TestUtility::protoEqual(first, second));
+  EXPECT_EQ(1, counting_->resolved_);
+}
+
+TEST_F(CachingTypeResolverTest, CachesEnumTypes) {
+  ProtobufWkt::Enum first;
+  ASSERT_TRUE(
+      resolver_->ResolveEnumType("type.googleapis.com/google.protobuf.NullValue", &first).ok());
+  ProtobufWkt::Enum second;
+  ASSERT_TRUE(
+      resolver_->ResolveEnumType("type.googleapis.com/google.protobuf.NullValue", &second).ok());
+
+  EXPECT_TRUE(TestUtility::protoEqual(first, second));
+  EXPECT_EQ(1, counting_->resolved_);
+}
+
+TEST_F(CachingTypeResolverTest, DoesntCacheUnknownTypes) {
+  ProtobufWkt::Type type;
+  EXPECT_FALSE(resolver_->ResolveMessageType("type.googleapis.com/unknown.Type", &type).ok());
+  EXPECT_FALSE(resolver_->ResolveMessageType("type.googleapis.com/unknown.Type", &type).ok());
+  EXPECT_EQ(2, counting_->resolved_);
+}
+
+} // namespace
+} // namespace GrpcJsonTranscoder
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -7,15 +7,22 @@
 #include "source/common/network/utility.h"
 #include "source/extensions/filters/http/ip_tagging/ip_tagging_filter.h"
 
+#include "test/mocks/filesystem/mocks.h"
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/server/server_factory_context.h"
 #include "test/mocks/stats/mocks.h"
+#include "test/test_common/environment.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::_;
+using testing::DoAll;
 using testing::Return;
+using testing::ReturnRef;
+using testing::SaveArg;
 
 namespace Envoy {
 namespace Extensions {
@@ -44,7 +51,7 @@ ip_tags:
     envoy::extensions::filters::http::ip_tagging::v3::IPTagging config;
     TestUtility::loadFromYaml(yaml, config);
     auto config_or =
-        IpTaggingFilterConfig::create(config, "prefix.", *stats_.rootScope(), runtime_);
+        IpTaggingFilterConfig::create(config, "prefix.", *stats_.rootScope(), runtime_, context_);
     if (expected_error.has_value()) {
       EXPECT_FALSE(config_or.ok());
       EXPECT_EQ(expected_error.value(), absl::StrCat(config_or.status()));
@@ -63,6 +70,8 @@ ip_tags:
   }
 
   NiceMock<Stats::MockStore> stats_;
+  // Outlives the filter configs, which are destroyed on its dispatcher.
+  NiceMock<Server::Configuration::MockServerFactoryContext> context_;
   IpTaggingFilterConfigSharedPtr config_;
   std::unique_ptr<IpTaggingFilter> filter_;
   NiceMock<Http::MockStreamDecoderFilterCallbacks> filter_callbacks_;
@@ -471,6 +480,126 @@ ip_tags:
       "<ip>/<# mask bits>)");
 }
 
+TEST_F(IpTaggingFilterTest, BothIpTagsAndDatasource) {
+  const std::string external_request_yaml = R"EOF(
+request_type: external
+ip_tags:
+  - ip_tag_name: external_request
+    ip_list:
+      - {address_prefix: 1.2.3.4, prefix_len: 32}
+ip_tags_datasource:
+  inline_string: "ip_tags: []"
+)EOF";
+  initializeFilter(
+      external_request_yaml,
+      "INVALID_ARGUMENT: HTTP IP Tagging Filter requires only one of ip_tags and "
+      "ip_tags_datasource.");
+}
+
+TEST_F(IpTaggingFilterTest, SharedTrie) {
+  initializeFilter(internal_request_yaml);
+  IpTaggingFilterConfigSharedPtr first = config_;
+  initializeFilter(internal_request_yaml);
+  EXPECT_EQ(&first->trie(), &config_->trie());
+
+  const std::string other_yaml = R"EOF(
+request_type: internal
+ip_tags:
+  - ip_tag_name: internal_request
+    ip_list:
+      - {address_prefix: 1.2.3.6, prefix_len: 32}
+)EOF";
+  initializeFilter(other_yaml);
+  EXPECT_NE(&first->trie(), &config_->trie());
+}
+
+TEST_F(IpTaggingFilterTest, InlineDatasource) {
+  const std::string yaml = R"EOF(
+request_type: internal
+ip_tags_datasource:
+  inline_string: |
+    ip_tags:
+    - ip_tag_name: internal_request
+      ip_list:
+      - {address_prefix: 1.2.3.5, prefix_len: 32}
+)EOF";
+  initializeFilter(yaml);
+  Http::TestRequestHeaderMapImpl request_headers{{"x-envoy-internal", "true"}};
+  Network::Address::InstanceConstSharedPtr remote_address =
+      Network::Utility::parseInternetAddressNoThrow("1.2.3.5");
+  filter_callbacks_.stream_info_.downstream_connection_info_provider_->setRemoteAddress(
+      remote_address);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, false));
+  EXPECT_EQ("internal_request", request_headers.get_(Http::Headers::get().EnvoyIpTags));
+}
+
+TEST_F(IpTaggingFilterTest, InvalidDatasource) {
+  const std::string yaml = R"EOF(
+request_type: internal
+ip_tags_datasource:
+  inline_string: "ip_tags: {"
+)EOF";
+  // The rest of the error message comes from the YAML parser.
+  envoy::extensions::filters::http::ip_tagging::v3::IPTagging config;
+  TestUtility::loadFromYaml(yaml, config);
+  auto config_or =
+      IpTaggingFilterConfig::create(config, "prefix.", *stats_.rootScope(), runtime_, context_);
+  ASSERT_FALSE(config_or.ok());
+  EXPECT_THAT(config_or.status().message(), testing::HasSubstr("invalid IP tags file"));
+}
+
+TEST_F(IpTaggingFilterTest, ReloadDatasource) {
+  Api::ApiPtr api = Api::createApiForTest();
+  ON_CALL(context_, api()).WillByDefault(ReturnRef(*api));
+  const std::string directory = TestEnvironment::temporaryPath("ip_tags");
+  TestEnvironment::createPath(directory);
+  const std::string filename = directory + "/tags.yaml";
+  TestEnvironment::writeStringToFileForTest(filename, R"EOF(
+ip_tags:
+- ip_tag_name: internal_request
+  ip_list:
+  - {address_prefix: 1.2.3.5, prefix_len: 32}
+)EOF",
+                                            true);
+
+  auto* watcher = new NiceMock<Filesystem::MockWatcher>();
+  Filesystem::Watcher::OnChangedCb on_changed;
+  EXPECT_CALL(context_.dispatcher_, createFilesystemWatcher_()).WillOnce(Return(watcher));
+  EXPECT_CALL(*watcher, addWatch(directory + "/", Filesystem::Watcher::Events::MovedTo, _))
+      .WillOnce(DoAll(SaveArg<2>(&on_changed), Return(absl::OkStatus())));
+  initializeFilter(fmt::format(R"EOF(
+request_type: internal
+ip_tags_datasource:
+  filename: {}
+  watched_directory: {{path: {}}}
+)EOF",
+                               filename, directory));
+  ASSERT_NE(config_->reloader(), nullptr);
+
+  const auto lookup = [this](const std::string& address) {
+    return config_->trie().getData(Network::Utility::parseInternetAddressNoThrow(address));
+  };
+  EXPECT_EQ(lookup("1.2.3.5"), std::vector<std::string>{"internal_request"});
+  EXPECT_TRUE(lookup("1.2.3.6").empty());
+
+  TestEnvironment::writeStringToFileForTest(filename, R"EOF(
+ip_tags:
+- ip_tag_name: internal_request
+  ip_list:
+  - {address_prefix: 1.2.3.6, prefix_len: 32}
+)EOF",
+                                            true);
+  EXPECT_TRUE(on_changed(Filesystem::Watcher::Events::MovedTo).ok());
+  EXPECT_TRUE(lookup("1.2.3.5").empty());
+  EXPECT_EQ(lookup("1.2.3.6"), std::vector<std::string>{"internal_request"});
+
+  // A bad file keeps the previous tags.
+  TestEnvironment::writeStringToFileForTest(filename, "ip_tags: {", true);
+  EXPECT_TRUE(on_changed(Filesystem::Watcher::Events::MovedTo).ok());
+  EXPECT_FALSE(config_->reloader()->reload().ok());
+  EXPECT_EQ(lookup("1.2.3.6"), std::vector<std::string>{"internal_request"});
+}
+
 } // namespace
 } // namespace IpTagging
 } // namespace HttpFilters
@@ -1388,6 +1388,43 @@ request_rules:
   EXPECT_EQ(getCounterValue("json_to_metadata.rq.invalid_json_body"), 0);
 }
 
+// The parts of the body which no rule selects are not looked at, even if they have the same keys.
+TEST_F(FilterTest, UnselectedPartsOfBody) {
+  initializeFilter(R"EOF(
+request_rules:
+  rules:
+  - selectors:
+    - key: messages
+    - key: foo
+    on_present:
+      metadata_namespace: envoy.lb
+      key: foo
+  - selectors:
+    - key: stream
+    on_present:
+      metadata_namespace: envoy.lb
+      key: stream
+)EOF");
+  const std::string request_body = R"delimiter({"foo":"top", "messages":{
+      "foo":"bar",
+      "other":{"foo":"nested", "messages":{"foo":"deeper"}}
+    },
+    "history":[{"messages":{"foo":"old"}}],
+    "stream":"yes"
+  })delimiter";
+  const std::map<std::string, std::string> expected = {{"foo", "bar"}, {"stream", "yes"}};
+
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration,
+            filter_->decodeHeaders(incoming_headers_, false));
+
+  EXPECT_CALL(decoder_callbacks_, streamInfo()).WillRepeatedly(ReturnRef(stream_info_));
+  EXPECT_CALL(stream_info_, setDynamicMetadata("envoy.lb", MapEq(expected)));
+  testRequestWithBody(request_body);
+
+  EXPECT_EQ(getCounterValue("json_to_metadata.rq.success"), 1);
+  EXPECT_EQ(getCounterValue("json_to_metadata.rq.invalid_json_body"), 0);
+}
+
 TEST_F(FilterTest, CustomRequestAllowContentTypeAccepted) {
   initializeFilter(R"EOF(
 request_rules:
@@ -110,6 +110,24 @@ TEST_F(JwtCacheTest, TestInvalidTokenSize) {
   EXPECT_TRUE(jwt == nullptr);
 }
 
+TEST_F(JwtCacheTest, TestCacheBoundedByBytes) {
+  const size_t good_size = std::string(GoodToken).length();
+  const size_t non_expiring_size = std::string(NonExpiringToken).length();
+  envoy::extensions::filters::http::jwt_authn::v3::JwtCacheConfig config;
+  // Holds either token, but not both.
+  config.set_jwt_cache_max_bytes(std::max(good_size, non_expiring_size) + 1);
+  cache_ = JwtCache::create(true, config, time_system_);
+
+  loadJwt(GoodToken);
+  cache_->insert(GoodToken, std::move(jwt_));
+  EXPECT_NE(cache_->lookup(GoodToken), nullptr);
+
+  loadJwt(NonExpiringToken);
+  cache_->insert(NonExpiringToken, std::move(jwt_));
+  EXPECT_NE(cache_->lookup(NonExpiringToken), nullptr);
+  EXPECT_EQ(cache_->lookup(GoodToken), nullptr);
+}
+
 } // namespace
 } // namespace JwtAuthn
 } // namespace HttpFilters
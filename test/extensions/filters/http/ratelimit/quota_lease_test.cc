@@ -0,0 +1,180 @@
+#include <memory>
+#include <vector>
+
+#include "envoy/extensions/filters/http/ratelimit/v3/rate_limit.pb.h"
+
+#include "source/extensions/filters/http/ratelimit/quota_lease.h"
+
+#include "test/extensions/filters/common/ratelimit/mocks.h"
+#include "test/mocks/event/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace RateLimitFilter {
+namespace {
+
+using Filters::Common::RateLimit::DescriptorStatusList;
+using Filters::Common::RateLimit::LimitStatus;
+using Filters::Common::RateLimit::MockClient;
+using Filters::Common::RateLimit::RequestCallbacks;
+
+class QuotaLeaseTest : public testing::Test {
+protected:
+  void initialize(const std::string& yaml) {
+    envoy::extensions::filters::http::ratelimit::v3::RateLimit::QuotaLease proto_config;
+    TestUtility::loadFromYaml(yaml, proto_config);
+    config_ = std::make_unique<QuotaLeaseConfig>(proto_config);
+    flush_ = new NiceMock<Event::MockSchedulableCallback>(&dispatcher_);
+    leases_ = std::make_unique<ThreadLocalQuotaLeases>(*config_, dispatcher_, [this]() {
+      auto client = std::make_unique<NiceMock<MockClient>>();
+      ON_CALL(*client, limit(_, "foo", _, _, _, _))
+          .WillByDefault(Invoke([this](RequestCallbacks& callbacks, const std::string&,
+                                       const std::vector<RateLimit::Descriptor>& descriptors,
+                                       Tracing::Span&, OptRef<const StreamInfo::StreamInfo>,
+                                       uint32_t hits_addend) {
+            EXPECT_EQ(hits_addend, config_->lease_size_);
+            calls_.push_back({&callbacks, descriptors});
+          }));
+      clients_.push_back(client.get());
+      return client;
+    });
+  }
+
+  bool tryConsume(const std::vector<RateLimit::Descriptor>& descriptors, uint64_t hits = 1) {
+    return leases_->tryConsume("foo", descriptors, hits);
+  }
+
+  struct Call {
+    RequestCallbacks* callbacks_;
+    std::vector<RateLimit::Descriptor> descriptors_;
+  };
+
+  const RateLimit::Descriptor a_{{{"key", "a"}}};
+  const RateLimit::Descriptor b_{{{"key", "b"}}};
+  Event::SimulatedTimeSystem time_system_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  NiceMock<Event::MockSchedulableCallback>* flush_{};
+  std::unique_ptr<QuotaLeaseConfig> config_;
+  std::unique_ptr<ThreadLocalQuotaLeases> leases_;
+  std::vector<MockClient*> clients_;
+  std::vector<Call> calls_;
+};
+
+TEST_F(QuotaLeaseTest, LeasesAreBatchedAndUsed) {
+  initialize("lease_size: 10");
+
+  // Without leases, requests go to the rate limit service, and leases are requested with one
+  // call on the next event loop iteration.
+  EXPECT_FALSE(tryConsume({a_}));
+  EXPECT_FALSE(tryConsume({a_, b_}));
+  EXPECT_TRUE(flush_->enabled_);
+  EXPECT_TRUE(calls_.empty());
+  flush_->invokeCallback();
+  ASSERT_EQ(calls_.size(), 1);
+  EXPECT_EQ(calls_[0].descriptors_, (std::vector<RateLimit::Descriptor>{a_, b_}));
+
+  calls_[0].callbacks_->complete(LimitStatus::OK, nullptr, nullptr, nullptr, "", nullptr);
+  EXPECT_EQ(leases_->leasedHits("foo", a_), 10);
+  EXPECT_EQ(leases_->leasedHits("foo", b_), 10);
+
+  // Leases are renewed once half of them is used.
+  EXPECT_TRUE(tryConsume({a_, b_}, 4));
+  EXPECT_FALSE(flush_->enabled_);
+  EXPECT_TRUE(tryConsume({a_}));
+  EXPECT_TRUE(flush_->enabled_);
+  EXPECT_EQ(leases_->leasedHits("foo", a_), 5);
+  EXPECT_EQ(leases_->leasedHits("foo", b_), 6);
+
+  // A request needing more hits than any lease holds takes none of them.
+  EXPECT_FALSE(tryConsume({a_, b_}, 6));
+  EXPECT_EQ(leases_->leasedHits("foo", b_), 6);
+
+  flush_->invokeCallback();
+  ASSERT_EQ(calls_.size(), 2);
+  EXPECT_EQ(calls_[1].descriptors_, (std::vector<RateLimit::Descriptor>{a_}));
+  calls_[1].callbacks_->complete(LimitStatus::OK, nullptr, nullptr, nullptr, "", nullptr);
+  EXPECT_EQ(leases_->leasedHits("foo", a_), 15);
+
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(leases_->leasedHits("foo", a_), 0);
+  EXPECT_FALSE(tryConsume({a_}));
+}
+
+TEST_F(QuotaLeaseTest, RefusedLeasesAreRetriedLater) {
+  initialize("{lease_size: 10, lease_duration: 2s}");
+
+  EXPECT_FALSE(tryConsume({a_, b_}));
+  flush_->invokeCallback();
+  ASSERT_EQ(calls_.size(), 1);
+  auto statuses = std::make_unique<DescriptorStatusList>(2);
+  (*statuses)[0].set_code(envoy::service::ratelimit::v3::RateLimitResponse::OK);
+  (*statuses)[1].set_code(envoy::service::ratelimit::v3::RateLimitResponse::OVER_LIMIT);
+  calls_[0].callbacks_->complete(LimitStatus::OverLimit, std::move(statuses), nullptr, nullptr,
+                                 "", nullptr);
+  EXPECT_EQ(leases_->leasedHits("foo", a_), 10);
+  EXPECT_EQ(leases_->leasedHits("foo", b_), 0);
+
+  EXPECT_FALSE(tryConsume({a_, b_}));
+  EXPECT_EQ(leases_->leasedHits("foo", a_), 10);
+  EXPECT_TRUE(tryConsume({a_}));
+  EXPECT_FALSE(flush_->enabled_);
+
+  time_system_.advanceTimeWait(std::chrono::seconds(2));
+  EXPECT_FALSE(tryConsume({b_}));
+  EXPECT_TRUE(flush_->enabled_);
+  flush_->invokeCallback();
+  ASSERT_EQ(calls_.size(), 2);
+  calls_[1].callbacks_->complete(LimitStatus::Error, nullptr, nullptr, nullptr, "", nullptr);
+  EXPECT_FALSE(tryConsume({b_}));
+  EXPECT_FALSE(flush_->enabled_);
+}
+
+TEST_F(QuotaLeaseTest, UnleasedDescriptors) {
+  initialize("{lease_size: 10, max_leases: 1}");
+
+  RateLimit::Descriptor with_hits{{{"key", "a"}}};
+  with_hits.hits_addend_ = 2;
+  EXPECT_FALSE(tryConsume({with_hits}));
+  EXPECT_FALSE(flush_->enabled_);
+
+  // Only one descriptor fits.
+  EXPECT_FALSE(tryConsume({a_, b_}));
+  flush_->invokeCallback();
+  ASSERT_EQ(calls_.size(), 1);
+  EXPECT_EQ(calls_[0].descriptors_, (std::vector<RateLimit::Descriptor>{a_}));
+  calls_[0].callbacks_->complete(LimitStatus::OK, nullptr, nullptr, nullptr, "", nullptr);
+  EXPECT_FALSE(tryConsume({a_, b_}));
+  EXPECT_TRUE(tryConsume({a_}));
+
+  // Expired leases make room for others.
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_FALSE(tryConsume({b_}));
+  flush_->invokeCallback();
+  ASSERT_EQ(calls_.size(), 2);
+  EXPECT_EQ(calls_[1].descriptors_, (std::vector<RateLimit::Descriptor>{b_}));
+}
+
+TEST_F(QuotaLeaseTest, DestroyCancelsRequests) {
+  initialize("lease_size: 10");
+  EXPECT_FALSE(tryConsume({a_}));
+  flush_->invokeCallback();
+  ASSERT_EQ(clients_.size(), 1);
+  EXPECT_CALL(*clients_[0], cancel());
+  leases_.reset();
+}
+
+} // namespace
+} // namespace RateLimitFilter
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
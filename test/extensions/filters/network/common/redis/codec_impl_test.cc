@@ -275,6 +275,43 @@ TEST_F(RedisEncoderDecoderImplTest, BulkString) {
   EXPECT_EQ(0UL, buffer_.length());
 }
 
+// Large bulk strings are moved into the buffer when the value is moved.
+TEST_F(RedisEncoderDecoderImplTest, MovedLargeBulkString) {
+  const std::string large(EncoderImpl::MinMovedBulkStringSize, 'a');
+  std::vector<RespValue> values(2);
+  values[0].type(RespType::BulkString);
+  values[0].asString() = "small";
+  values[1].type(RespType::BulkString);
+  values[1].asString() = large;
+  RespValue value;
+  value.type(RespType::Array);
+  value.asArray().swap(values);
+  const RespValue expected(value);
+
+  encoder_.encode(std::move(value), buffer_);
+  EXPECT_EQ(absl::StrCat("*2\r\n$5\r\nsmall\r\n$", large.size(), "\r\n", large, "\r\n"),
+            buffer_.toString());
+  decoder_.decode(buffer_);
+  EXPECT_EQ(expected, *decoded_values_[0]);
+  EXPECT_EQ(0UL, buffer_.length());
+}
+
+// A large bulk string split over several decode calls is decoded whole.
+TEST_F(RedisEncoderDecoderImplTest, LargeBulkStringInPieces) {
+  RespValue value;
+  value.type(RespType::BulkString);
+  value.asString() = std::string(1024 * 1024, 'b');
+  encoder_.encode(value, buffer_);
+
+  while (buffer_.length() > 0) {
+    Buffer::OwnedImpl piece;
+    piece.move(buffer_, std::min<uint64_t>(buffer_.length(), 100000));
+    decoder_.decode(piece);
+  }
+  ASSERT_EQ(1UL, decoded_values_.size());
+  EXPECT_EQ(value, *decoded_values_[0]);
+}
+
 TEST_F(RedisEncoderDecoderImplTest, Integer) {
   RespValue value;
   value.type(RespType::Integer);
@@ -30,6 +30,10 @@ public:
   ~MockEncoder() override;
 
   MOCK_METHOD(void, encode, (const Common::Redis::RespValue& value, Buffer::Instance& out));
+  // Expectations are set on the copying overload, which sees the same value.
+  void encode(Common::Redis::RespValue&& value, Buffer::Instance& out) override {
+    encode(static_cast<const Common::Redis::RespValue&>(value), out);
+  }
 
 private:
   Common::Redis::EncoderImpl real_encoder_;
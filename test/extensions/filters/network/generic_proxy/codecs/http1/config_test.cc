@@ -331,6 +331,35 @@ TEST_F(Http1ServerCodecTest, DecodeRequestWithBody) {
   codec_->decode(buffer, false);
 }
 
+// A body which fills its own slices is moved out of the decoding buffer.
+TEST_F(Http1ServerCodecTest, DecodeRequestWithLargeBody) {
+  ON_CALL(codec_callbacks_, connection())
+      .WillByDefault(testing::Return(makeOptRef<Network::Connection>(mock_connection_)));
+
+  Buffer::OwnedImpl buffer;
+
+  buffer.add("GET / HTTP/1.1\r\n"
+             "Host: host\r\n"
+             "Content-Length: 32768\r\n"
+             "\r\n"
+             "body");
+  Buffer::OwnedImpl large_body(std::string(32764, 'a'));
+  buffer.move(large_body);
+
+  EXPECT_CALL(codec_callbacks_, onDecodingSuccess(_, _));
+  EXPECT_CALL(codec_callbacks_, onDecodingSuccess(_))
+      .WillOnce(Invoke([](RequestCommonFramePtr frame) {
+        auto* body = dynamic_cast<HttpRawBodyFrame*>(frame.get());
+        EXPECT_EQ(frame->frameFlags().endStream(), true);
+
+        EXPECT_EQ(body->buffer().length(), 32768);
+        EXPECT_EQ(body->buffer().toString(), "body" + std::string(32764, 'a'));
+      }));
+
+  codec_->decode(buffer, false);
+  EXPECT_EQ(buffer.length(), 0);
+}
+
 TEST_F(Http1ServerCodecTest, DecodeRequestAndCloseConnectionAfterHeader) {
   ON_CALL(codec_callbacks_, connection())
       .WillByDefault(testing::Return(makeOptRef<Network::Connection>(mock_connection_)));
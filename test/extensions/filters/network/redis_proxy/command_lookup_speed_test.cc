@@ -87,7 +87,8 @@ public:
       "redis.foo.",
       time_system_,
       false,
-      std::make_unique<NiceMock<MockFaultManager>>(fault_manager_)};
+      std::make_unique<NiceMock<MockFaultManager>>(fault_manager_),
+      nullptr};
   NoOpSplitCallbacks callbacks_;
   CommandSplitter::SplitRequestPtr handle_;
 };
@@ -5,9 +5,11 @@
 #include <string>
 #include <vector>
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/fmt.h"
 #include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/filters/network/common/redis/client_impl.h"
+#include "source/extensions/filters/network/common/redis/codec_impl.h"
 #include "source/extensions/filters/network/common/redis/supported_commands.h"
 #include "source/extensions/filters/network/redis_proxy/command_splitter_impl.h"
 #include "source/extensions/filters/network/redis_proxy/router_impl.h"
@@ -133,3 +135,62 @@ static void bmSplitCreateVariant(benchmark::State& state) {
   state.counters["use_count"] = request.use_count();
 }
 BENCHMARK(bmSplitCreateVariant)->Ranges({{1, 100}, {64, 8 << 14}});
+
+static Envoy::Extensions::NetworkFilters::Common::Redis::RespValue
+makeBulkStringValue(uint64_t value_size) {
+  Envoy::Extensions::NetworkFilters::Common::Redis::RespValue value;
+  value.type(Envoy::Extensions::NetworkFilters::Common::Redis::RespType::BulkString);
+  value.asString() = std::string(value_size, 'v');
+  return value;
+}
+
+static void bmEncodeCopy(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::Common::Redis::EncoderImpl encoder;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    state.PauseTiming();
+    const Envoy::Extensions::NetworkFilters::Common::Redis::RespValue value =
+        makeBulkStringValue(state.range(0));
+    Envoy::Buffer::OwnedImpl buffer;
+    state.ResumeTiming();
+    encoder.encode(value, buffer);
+  }
+}
+BENCHMARK(bmEncodeCopy)->Range(1 << 10, 1 << 20);
+
+static void bmEncodeMove(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::Common::Redis::EncoderImpl encoder;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    state.PauseTiming();
+    Envoy::Extensions::NetworkFilters::Common::Redis::RespValue value =
+        makeBulkStringValue(state.range(0));
+    Envoy::Buffer::OwnedImpl buffer;
+    state.ResumeTiming();
+    encoder.encode(std::move(value), buffer);
+  }
+}
+BENCHMARK(bmEncodeMove)->Range(1 << 10, 1 << 20);
+
+class NullDecoderCallbacks
+    : public Envoy::Extensions::NetworkFilters::Common::Redis::DecoderCallbacks {
+public:
+  void onRespValue(Envoy::Extensions::NetworkFilters::Common::Redis::RespValuePtr&&) override {}
+};
+
+static void bmDecode(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::Common::Redis::EncoderImpl encoder;
+  Envoy::Buffer::OwnedImpl encoded;
+  encoder.encode(makeBulkStringValue(state.range(0)), encoded);
+  NullDecoderCallbacks callbacks;
+  Envoy::Extensions::NetworkFilters::Common::Redis::DecoderImpl decoder(callbacks);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    state.PauseTiming();
+    Envoy::Buffer::OwnedImpl buffer;
+    buffer.add(encoded);
+    state.ResumeTiming();
+    decoder.decode(buffer);
+  }
+}
+BENCHMARK(bmDecode)->Range(1 << 10, 1 << 20);
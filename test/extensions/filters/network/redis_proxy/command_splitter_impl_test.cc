@@ -9,6 +9,7 @@
 #include "source/extensions/filters/network/common/redis/fault_impl.h"
 #include "source/extensions/filters/network/common/redis/supported_commands.h"
 #include "source/extensions/filters/network/redis_proxy/command_splitter_impl.h"
+#include "source/extensions/filters/network/redis_proxy/read_cache.h"
 
 #include "test/extensions/filters/network/common/redis/mocks.h"
 #include "test/extensions/filters/network/redis_proxy/mocks.h"
@@ -16,6 +17,7 @@
 #include "test/mocks/event/mocks.h"
 #include "test/mocks/stats/mocks.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/simulated_time_system.h"
 
 using testing::_;
@@ -80,7 +82,8 @@ public:
                          "redis.foo.",
                          time_system_,
                          latency_in_micros_,
-                         std::make_unique<NiceMock<MockFaultManager>>(fault_manager_)};
+                         std::make_unique<NiceMock<MockFaultManager>>(fault_manager_),
+                         nullptr};
   MockSplitCallbacks callbacks_;
   SplitRequestPtr handle_;
 };
@@ -1468,6 +1471,113 @@ INSTANTIATE_TEST_SUITE_P(RedisSingleServerRequestWithDelayFaultTest,
                          RedisSingleServerRequestWithDelayFaultTest,
                          testing::ValuesIn(Common::Redis::SupportedCommands::simpleCommands()));
 
+class RedisReadCacheTest : public testing::Test {
+public:
+  RedisReadCacheTest() {
+    envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::ReadCache config;
+    config.add_key_prefixes("cached:");
+    config.mutable_ttl()->set_seconds(1);
+    read_cache_ = std::make_shared<ReadCache>(config, tls_, *store_.rootScope(), "redis.foo.");
+    splitter_ = std::make_unique<InstanceImpl>(
+        std::make_unique<NiceMock<MockRouter>>(route_), *store_.rootScope(), "redis.foo.",
+        time_system_, false, std::make_unique<NiceMock<MockFaultManager>>(fault_manager_),
+        read_cache_);
+  }
+
+  Common::Redis::RespValuePtr makeCommand(const std::vector<std::string>& arguments) {
+    Common::Redis::RespValuePtr request{new Common::Redis::RespValue()};
+    std::vector<Common::Redis::RespValue> values(arguments.size());
+    for (uint64_t i = 0; i < arguments.size(); i++) {
+      values[i].type(Common::Redis::RespType::BulkString);
+      values[i].asString() = arguments[i];
+    }
+    request->type(Common::Redis::RespType::Array);
+    request->asArray().swap(values);
+    return request;
+  }
+
+  // Sends the command upstream, and returns the callbacks of the upstream request.
+  ConnPool::PoolCallbacks* forward(const std::vector<std::string>& arguments) {
+    ConnPool::PoolCallbacks* pool_callbacks{};
+    EXPECT_CALL(callbacks_, connectionAllowed()).WillOnce(Return(true));
+    EXPECT_CALL(*conn_pool_, makeRequest_(arguments[1], _, _))
+        .WillOnce(DoAll(WithArg<2>(SaveArgAddress(&pool_callbacks)), Return(&pool_request_)));
+    handles_.push_back(
+        splitter_->makeRequest(makeCommand(arguments), callbacks_, dispatcher_, stream_info_));
+    EXPECT_NE(nullptr, handles_.back());
+    return pool_callbacks;
+  }
+
+  void respond(ConnPool::PoolCallbacks* pool_callbacks, const std::string& value) {
+    Common::Redis::RespValuePtr response{new Common::Redis::RespValue()};
+    response->type(Common::Redis::RespType::BulkString);
+    response->asString() = value;
+    EXPECT_CALL(callbacks_, onResponse_(PointeesEq(response.get())));
+    pool_callbacks->onResponse(std::move(response));
+  }
+
+  void expectCached(const std::string& key, const std::string& value) {
+    Common::Redis::RespValue response;
+    response.type(Common::Redis::RespType::BulkString);
+    response.asString() = value;
+    EXPECT_CALL(callbacks_, connectionAllowed()).WillOnce(Return(true));
+    EXPECT_CALL(callbacks_, onResponse_(PointeesEq(&response)));
+    EXPECT_EQ(nullptr, splitter_->makeRequest(makeCommand({"get", key}), callbacks_, dispatcher_,
+                                              stream_info_));
+  }
+
+  ConnPool::MockInstance* conn_pool_{new ConnPool::MockInstance()};
+  std::shared_ptr<NiceMock<MockRoute>> route_{
+      new NiceMock<MockRoute>(ConnPool::InstanceSharedPtr{conn_pool_})};
+  NiceMock<Stats::MockIsolatedStatsStore> store_;
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  NiceMock<MockFaultManager> fault_manager_;
+  Event::SimulatedTimeSystem time_system_;
+  ReadCacheSharedPtr read_cache_;
+  std::unique_ptr<InstanceImpl> splitter_;
+  MockSplitCallbacks callbacks_;
+  Common::Redis::Client::MockPoolRequest pool_request_;
+  std::vector<SplitRequestPtr> handles_;
+};
+
+TEST_F(RedisReadCacheTest, ServesCachedKeysUntilExpiry) {
+  respond(forward({"get", "cached:a"}), "value");
+  expectCached("cached:a", "value");
+  EXPECT_EQ(1UL, store_.counter("redis.foo.read_cache.hit").value());
+  EXPECT_EQ(1UL, store_.counter("redis.foo.read_cache.miss").value());
+  EXPECT_EQ(2UL, store_.counter("redis.foo.command.get.total").value());
+
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  respond(forward({"get", "cached:a"}), "value");
+  EXPECT_EQ(2UL, store_.counter("redis.foo.read_cache.miss").value());
+}
+
+TEST_F(RedisReadCacheTest, OtherKeysAreNotCached) {
+  respond(forward({"get", "other:a"}), "value");
+  respond(forward({"get", "other:a"}), "value");
+  EXPECT_EQ(0UL, store_.counter("redis.foo.read_cache.miss").value());
+  EXPECT_EQ(0UL, store_.counter("redis.foo.read_cache.insert").value());
+}
+
+TEST_F(RedisReadCacheTest, WriteInvalidates) {
+  respond(forward({"get", "cached:a"}), "value");
+  respond(forward({"set", "cached:a", "new"}), "OK");
+  EXPECT_EQ(1UL, store_.counter("redis.foo.read_cache.invalidation").value());
+  respond(forward({"get", "cached:a"}), "new");
+  expectCached("cached:a", "new");
+}
+
+// A response requested before a write to the key is not cached.
+TEST_F(RedisReadCacheTest, WriteDuringFillIsNotCached) {
+  ConnPool::PoolCallbacks* get_callbacks = forward({"get", "cached:a"});
+  respond(forward({"set", "cached:a", "new"}), "OK");
+  respond(get_callbacks, "value");
+  EXPECT_EQ(0UL, store_.counter("redis.foo.read_cache.insert").value());
+  respond(forward({"get", "cached:a"}), "new");
+}
+
 } // namespace CommandSplitter
 } // namespace RedisProxy
 } // namespace NetworkFilters
@@ -0,0 +1,164 @@
+#include <chrono>
+#include <string>
+
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/filters/network/redis_proxy/read_cache.h"
+
+#include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+namespace {
+
+class ReadCacheTest : public testing::Test {
+public:
+  void initialize(uint64_t max_bytes) {
+    envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::ReadCache config;
+    config.add_key_prefixes("a:");
+    config.add_key_prefixes("b:");
+    config.mutable_ttl()->set_seconds(10);
+    config.mutable_max_bytes_per_worker()->set_value(max_bytes);
+    cache_ = std::make_unique<ReadCache>(config, tls_, *store_.rootScope(), "redis.foo.");
+  }
+
+  Common::Redis::RespValue bulkString(const std::string& string) {
+    Common::Redis::RespValue value;
+    value.type(Common::Redis::RespType::BulkString);
+    value.asString() = string;
+    return value;
+  }
+
+  void insert(const std::string& key, const std::string& value) {
+    ThreadLocalReadCache& local = cache_->local();
+    local.insert(key, bulkString(value), time_system_.monotonicTime(), local.epoch());
+  }
+
+  bool cached(const std::string& key) {
+    return cache_->local().lookup(key, time_system_.monotonicTime()) != nullptr;
+  }
+
+  uint64_t gauge(const std::string& name) {
+    return store_
+        .gaugeFromString("redis.foo.read_cache." + name, Stats::Gauge::ImportMode::Accumulate)
+        .value();
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  testing::NiceMock<ThreadLocal::MockInstance> tls_;
+  Event::SimulatedTimeSystem time_system_;
+  std::unique_ptr<ReadCache> cache_;
+};
+
+// The entries of a cache are no longer counted once a new config replaces it.
+TEST_F(ReadCacheTest, Reload) {
+  initialize(1024);
+  insert("a:1", "value");
+  insert("a:2", "value");
+  EXPECT_EQ(2UL, gauge("entries"));
+  EXPECT_EQ(16UL, gauge("bytes"));
+
+  initialize(1024);
+  EXPECT_EQ(0UL, gauge("entries"));
+  EXPECT_EQ(0UL, gauge("bytes"));
+  insert("a:1", "value");
+  EXPECT_EQ(1UL, gauge("entries"));
+  EXPECT_EQ(8UL, gauge("bytes"));
+}
+
+TEST_F(ReadCacheTest, Cacheable) {
+  initialize(1024);
+  EXPECT_TRUE(cache_->cacheable("a:1"));
+  EXPECT_TRUE(cache_->cacheable("b:"));
+  EXPECT_FALSE(cache_->cacheable("c:1"));
+  EXPECT_FALSE(cache_->cacheable("a"));
+}
+
+TEST_F(ReadCacheTest, LookupReturnsCopy) {
+  initialize(1024);
+  insert("a:1", "value");
+  Common::Redis::RespValuePtr value = cache_->local().lookup("a:1", time_system_.monotonicTime());
+  ASSERT_NE(nullptr, value);
+  EXPECT_EQ(bulkString("value"), *value);
+
+  Common::Redis::RespValue null;
+  cache_->local().insert("a:2", null, time_system_.monotonicTime(), cache_->local().epoch());
+  value = cache_->local().lookup("a:2", time_system_.monotonicTime());
+  ASSERT_NE(nullptr, value);
+  EXPECT_EQ(Common::Redis::RespType::Null, value->type());
+  EXPECT_EQ(2UL, gauge("entries"));
+  EXPECT_EQ(11UL, gauge("bytes"));
+}
+
+TEST_F(ReadCacheTest, Expiry) {
+  initialize(1024);
+  insert("a:1", "value");
+  time_system_.advanceTimeWait(std::chrono::seconds(9));
+  EXPECT_TRUE(cached("a:1"));
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_FALSE(cached("a:1"));
+  EXPECT_EQ(0UL, gauge("entries"));
+  EXPECT_EQ(0UL, gauge("bytes"));
+}
+
+// The least recently used entries are evicted to make room.
+TEST_F(ReadCacheTest, EvictsLeastRecentlyUsed) {
+  // Room for three entries of 8 bytes.
+  initialize(24);
+  insert("a:1", "12345");
+  insert("a:2", "12345");
+  insert("a:3", "12345");
+  EXPECT_TRUE(cached("a:1"));
+  insert("a:4", "12345");
+  EXPECT_FALSE(cached("a:2"));
+  EXPECT_TRUE(cached("a:1"));
+  EXPECT_TRUE(cached("a:3"));
+  EXPECT_TRUE(cached("a:4"));
+  EXPECT_EQ(1UL, store_.counterFromString("redis.foo.read_cache.eviction").value());
+  EXPECT_EQ(24UL, gauge("bytes"));
+
+  // Values larger than the cache are not cached.
+  insert("a:5", std::string(100, 'x'));
+  EXPECT_FALSE(cached("a:5"));
+  EXPECT_EQ(3UL, gauge("entries"));
+}
+
+TEST_F(ReadCacheTest, ReplacesValue) {
+  initialize(1024);
+  insert("a:1", "old");
+  insert("a:1", "new value");
+  EXPECT_EQ(bulkString("new value"), *cache_->local().lookup("a:1", time_system_.monotonicTime()));
+  EXPECT_EQ(1UL, gauge("entries"));
+  EXPECT_EQ(12UL, gauge("bytes"));
+}
+
+TEST_F(ReadCacheTest, InvalidateRequestArguments) {
+  initialize(1024);
+  insert("a:1", "value");
+  insert("b:1", "value");
+  insert("a:2", "value");
+  Common::Redis::RespValue request;
+  request.type(Common::Redis::RespType::Array);
+  request.asArray() = {bulkString("del"), bulkString("a:1"), bulkString("b:1"),
+                       bulkString("c:1")};
+  const uint64_t epoch = cache_->local().epoch();
+  cache_->invalidate(request);
+  EXPECT_FALSE(cached("a:1"));
+  EXPECT_FALSE(cached("b:1"));
+  EXPECT_TRUE(cached("a:2"));
+  EXPECT_EQ(2UL, store_.counterFromString("redis.foo.read_cache.invalidation").value());
+
+  // Responses requested before the invalidation are not cached.
+  cache_->local().insert("a:1", bulkString("stale"), time_system_.monotonicTime(), epoch);
+  EXPECT_FALSE(cached("a:1"));
+}
+
+} // namespace
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
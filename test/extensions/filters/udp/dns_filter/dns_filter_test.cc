@@ -12,6 +12,7 @@
 #include "test/test_common/registry.h"
 #include "test/test_common/simulated_time_system.h"
 
+#include "absl/strings/str_replace.h"
 #include "dns_filter_test_utils.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -937,6 +938,98 @@ TEST_F(DnsFilterTest, ExternalResolutionReturnNoAddresses) {
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
 }
 
+TEST_F(DnsFilterTest, ExternalResolutionAnswerCache) {
+  const std::string domain("www.foobaz.com");
+  setup(absl::StrReplaceAll(forward_query_on_config,
+                            {{"max_pending_lookups: 1",
+                              "max_pending_lookups: 1\n  answer_cache_ttl: 10s"}}));
+
+  const std::string query =
+      Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_A, DNS_RECORD_CLASS_IN);
+  ASSERT_FALSE(query.empty());
+
+  new NiceMock<Event::MockTimer>(&dispatcher_);
+  Network::DnsResolver::ResolveCb resolve_cb;
+  EXPECT_CALL(*resolver_, resolve(domain, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  resolve_cb(Network::DnsResolver::ResolutionStatus::Completed, "",
+             TestUtility::makeDnsResponse({"130.207.244.251"}));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  // The same query is answered from the cache, without the resolver.
+  simTime().advanceTimeWait(std::chrono::seconds(5));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  response_ctx_ = ResponseValidator::createResponseContext(udp_response_, counters_);
+  EXPECT_TRUE(response_ctx_->parse_status_);
+  EXPECT_EQ(DNS_RESPONSE_CODE_NO_ERROR, response_ctx_->getQueryResponseCode());
+  ASSERT_EQ(1, response_ctx_->answers_.size());
+  Utils::verifyAddress({"130.207.244.251"}, response_ctx_->answers_.begin()->second);
+
+  // The answer is resolved again once it expires.
+  simTime().advanceTimeWait(std::chrono::seconds(5));
+  new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*resolver_, resolve(domain, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  resolve_cb(Network::DnsResolver::ResolutionStatus::Completed, "",
+             TestUtility::makeDnsResponse({"130.207.244.252"}));
+  response_ctx_ = ResponseValidator::createResponseContext(udp_response_, counters_);
+  ASSERT_EQ(1, response_ctx_->answers_.size());
+  Utils::verifyAddress({"130.207.244.252"}, response_ctx_->answers_.begin()->second);
+
+  EXPECT_EQ(3, config_->stats().downstream_rx_queries_.value());
+  EXPECT_EQ(2, config_->stats().externally_resolved_queries_.value());
+  EXPECT_EQ(1, config_->stats().answer_cache_hits_.value());
+  EXPECT_EQ(2, config_->stats().answer_cache_misses_.value());
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+}
+
+TEST_F(DnsFilterTest, ExternalResolutionAnswerCacheNegative) {
+  const std::string domain("www.foobaz.com");
+  setup(absl::StrReplaceAll(forward_query_on_config,
+                            {{"max_pending_lookups: 1",
+                              "max_pending_lookups: 1\n  answer_cache_ttl: 10s"}}));
+
+  const std::string a_query =
+      Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_A, DNS_RECORD_CLASS_IN);
+  const std::string aaaa_query =
+      Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_AAAA, DNS_RECORD_CLASS_IN);
+
+  // A lookup which times out is not cached.
+  auto timeout_timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*resolver_, resolve(domain, _, _)).WillOnce(Return(&resolver_->active_query_));
+  sendQueryFromClient("10.0.0.1:1000", a_query);
+  simTime().advanceTimeWait(std::chrono::milliseconds(1500));
+  timeout_timer->invokeCallback();
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  // A name without addresses is cached, separately for each record type.
+  new NiceMock<Event::MockTimer>(&dispatcher_);
+  Network::DnsResolver::ResolveCb resolve_cb;
+  EXPECT_CALL(*resolver_, resolve(domain, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  sendQueryFromClient("10.0.0.1:1000", a_query);
+  resolve_cb(Network::DnsResolver::ResolutionStatus::Completed, "",
+             TestUtility::makeDnsResponse({}));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  sendQueryFromClient("10.0.0.1:1000", a_query);
+  response_ctx_ = ResponseValidator::createResponseContext(udp_response_, counters_);
+  EXPECT_TRUE(response_ctx_->parse_status_);
+  EXPECT_EQ(DNS_RESPONSE_CODE_NAME_ERROR, response_ctx_->getQueryResponseCode());
+  EXPECT_EQ(0, response_ctx_->answers_.size());
+
+  new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*resolver_, resolve(domain, _, _)).WillOnce(Return(&resolver_->active_query_));
+  sendQueryFromClient("10.0.0.1:1000", aaaa_query);
+
+  EXPECT_EQ(1, config_->stats().answer_cache_hits_.value());
+  EXPECT_EQ(3, config_->stats().answer_cache_misses_.value());
+  EXPECT_EQ(3, config_->stats().unanswered_queries_.value());
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+}
+
 TEST_F(DnsFilterTest, ExternalResolutionTimeout) {
   InSequence s;
 
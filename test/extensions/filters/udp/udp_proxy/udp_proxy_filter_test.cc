@@ -28,6 +28,8 @@
 #include "test/mocks/upstream/host.h"
 #include "test/mocks/upstream/load_balancer_context.h"
 #include "test/mocks/upstream/thread_local_cluster.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/threadsafe_singleton_injector.h"
 
 #include "gmock/gmock.h"
@@ -140,10 +142,17 @@ public:
           }));
     }
 
+    void expectIdleTimerReset() {
+      // A lazy idle timer which is enabled already is left as is.
+      if (!parent_.lazy_idle_timer_ || !idle_timer_->enabled_) {
+        EXPECT_CALL(*idle_timer_, enableTimer(parent_.config_->sessionTimeout(), nullptr));
+      }
+    }
+
     void expectWriteToUpstream(const std::string& data, int sys_errno = 0,
                                const Network::Address::Ip* local_ip = nullptr,
                                bool expect_connect = false, int connect_sys_errno = 0) {
-      EXPECT_CALL(*idle_timer_, enableTimer(parent_.config_->sessionTimeout(), nullptr));
+      expectIdleTimerReset();
       if (expect_connect) {
         EXPECT_CALL(*socket_->io_handle_, connect(_))
             .WillOnce(Invoke([connect_sys_errno]() -> Api::SysCallIntResult {
@@ -202,7 +211,7 @@ public:
 
     void recvDataFromUpstream(const std::string& data, int recv_sys_errno = 0,
                               int send_sys_errno = 0) {
-      EXPECT_CALL(*idle_timer_, enableTimer(parent_.config_->sessionTimeout(), nullptr));
+      expectIdleTimerReset();
 
       if (parent_.expect_gro_) {
         EXPECT_CALL(*socket_->io_handle_, supportsUdpGro());
@@ -439,6 +448,7 @@ use_original_src_ip: true
 
   TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_;
   NiceMock<Server::Configuration::MockListenerFactoryContext> factory_context_;
+  bool lazy_idle_timer_{};
   UdpProxyFilterConfigSharedPtr config_;
   Network::MockUdpReadFilterCallbacks callbacks_;
   Upstream::ClusterUpdateCallbacks* cluster_update_callbacks_{};
@@ -672,6 +682,54 @@ matcher:
   EXPECT_EQ(output_.front(), "2 1");
 }
 
+class UdpProxyFilterLazyIdleTimerTest : public Event::TestUsingSimulatedTime,
+                                        public UdpProxyFilterTest {
+public:
+  UdpProxyFilterLazyIdleTimerTest() {
+    scoped_runtime_.mergeValues(
+        {{"envoy.reloadable_features.udp_proxy_lazy_idle_timer", "true"}});
+    lazy_idle_timer_ = true;
+  }
+
+  TestScopedRuntime scoped_runtime_;
+};
+
+// The idle timer is not enabled again for each datagram, but for the rest of the timeout when it
+// fires after a datagram.
+TEST_F(UdpProxyFilterLazyIdleTimerTest, IdleTimeoutAfterLastDatagram) {
+  InSequence s;
+
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  test_sessions_[0].expectWriteToUpstream("hello", 0, nullptr, true);
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+
+  simTime().advanceTimeWait(std::chrono::seconds(20));
+  test_sessions_[0].expectWriteToUpstream("hello2");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello2");
+
+  simTime().advanceTimeWait(std::chrono::seconds(40));
+  EXPECT_CALL(*test_sessions_[0].idle_timer_, enableTimer(std::chrono::milliseconds(20000), _));
+  test_sessions_[0].idle_timer_->invokeCallback();
+  EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
+  EXPECT_EQ(0, config_->stats().idle_timeout_.value());
+
+  simTime().advanceTimeWait(std::chrono::seconds(20));
+  test_sessions_[0].idle_timer_->invokeCallback();
+  EXPECT_EQ(0, config_->stats().downstream_sess_active_.value());
+  EXPECT_EQ(1, config_->stats().idle_timeout_.value());
+}
+
 // Verify downstream send and receive error handling.
 TEST_F(UdpProxyFilterTest, SendReceiveErrorHandling) {
   InSequence s;
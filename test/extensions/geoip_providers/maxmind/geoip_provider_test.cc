@@ -406,6 +406,82 @@ TEST_F(GeoipProviderTest, DbReloadedOnMmdbFileUpdate) {
   TestEnvironment::renameFile(city_db_path + "1", city_db_path);
 }
 
+TEST_F(GeoipProviderTest, LookupCache) {
+  const std::string config_yaml = R"EOF(
+    common_provider_config:
+      geo_headers_to_add:
+        country: "x-geo-country"
+        region: "x-geo-region"
+        city: "x-geo-city"
+    city_db_path: "{{ test_rundir }}/test/extensions/geoip_providers/maxmind/test_data/GeoLite2-City-Test.mmdb"
+    lookup_cache_size: 1
+  )EOF";
+  initializeProvider(config_yaml, cb_added_nullopt);
+  testing::MockFunction<void(Geolocation::LookupResult &&)> lookup_cb;
+  EXPECT_CALL(lookup_cb, Call(_)).WillRepeatedly(SaveArg<0>(&captured_lookup_response_));
+  const auto lookup = [&](const std::string& address) {
+    captured_lookup_response_.clear();
+    provider_->lookup(
+        Geolocation::LookupRequest{Network::Utility::parseInternetAddressNoThrow(address)},
+        lookup_cb.AsStdFunction());
+  };
+  auto& provider_scope = GeoipProviderPeer::providerScope(provider_);
+
+  lookup("78.26.243.166");
+  EXPECT_EQ("Boxford", captured_lookup_response_["x-geo-city"]);
+  lookup("78.26.243.166");
+  EXPECT_EQ("Boxford", captured_lookup_response_["x-geo-city"]);
+  expectStats("city_db", 1, 1);
+  EXPECT_EQ(1, provider_scope.counterFromString("lookup_cache_hit").value());
+
+  // The other address evicts the first one.
+  lookup("63.25.243.11");
+  EXPECT_EQ(3, captured_lookup_response_.size());
+  lookup("78.26.243.166");
+  EXPECT_EQ("Boxford", captured_lookup_response_["x-geo-city"]);
+  expectStats("city_db", 3, 3);
+  EXPECT_EQ(1, provider_scope.counterFromString("lookup_cache_hit").value());
+}
+
+TEST_F(GeoipProviderTest, LookupCacheClearedOnDbReload) {
+  constexpr absl::string_view config_yaml = R"EOF(
+    common_provider_config:
+      geo_headers_to_add:
+        city: "x-geo-city"
+    city_db_path: {}
+    lookup_cache_size: 10
+  )EOF";
+  std::string city_db_path = TestEnvironment::substitute(default_city_db_path);
+  std::string reloaded_city_db_path = TestEnvironment::substitute(default_updated_city_db_path);
+  auto cb_added_opt = absl::make_optional<ConditionalInitializer>();
+  initializeProvider(fmt::format(config_yaml, city_db_path), cb_added_opt);
+  testing::MockFunction<void(Geolocation::LookupResult &&)> lookup_cb;
+  EXPECT_CALL(lookup_cb, Call(_)).WillRepeatedly(SaveArg<0>(&captured_lookup_response_));
+  const auto lookup = [&]() {
+    captured_lookup_response_.clear();
+    provider_->lookup(
+        Geolocation::LookupRequest{Network::Utility::parseInternetAddressNoThrow("78.26.243.166")},
+        lookup_cb.AsStdFunction());
+  };
+
+  lookup();
+  EXPECT_EQ("Boxford", captured_lookup_response_["x-geo-city"]);
+  TestEnvironment::renameFile(city_db_path, city_db_path + "1");
+  TestEnvironment::renameFile(reloaded_city_db_path, city_db_path);
+  cb_added_opt.value().waitReady();
+  {
+    absl::ReaderMutexLock guard(&mutex_);
+    EXPECT_TRUE(on_changed_cbs_[0](Filesystem::Watcher::Events::MovedTo).ok());
+  }
+  expectReloadStats("city_db", 1, 0);
+  lookup();
+  EXPECT_EQ("BoxfordImaginary", captured_lookup_response_["x-geo-city"]);
+  expectStats("city_db", 2, 2);
+  // Clean up modifications to mmdb file names.
+  TestEnvironment::renameFile(city_db_path, reloaded_city_db_path);
+  TestEnvironment::renameFile(city_db_path + "1", city_db_path);
+}
+
 TEST_F(GeoipProviderTest, DbReloadError) {
   constexpr absl::string_view config_yaml = R"EOF(
     common_provider_config:
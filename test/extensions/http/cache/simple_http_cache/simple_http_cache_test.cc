@@ -1,7 +1,9 @@
+#include "envoy/extensions/http/cache/simple_http_cache/v3/config.pb.h"
 #include "envoy/http/header_map.h"
 #include "envoy/registry/registry.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/http/header_map_impl.h"
 #include "source/extensions/filters/http/cache/cache_entry_utils.h"
 #include "source/extensions/filters/http/cache/cache_headers_utils.h"
 #include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
@@ -34,6 +36,85 @@ INSTANTIATE_TEST_SUITE_P(SimpleHttpCacheTest, HttpCacheImplementationTest,
                            return "SimpleHttpCache";
                          });
 
+class SimpleHttpCacheEvictionTest : public testing::Test {
+public:
+  LookupRequest makeLookupRequest(absl::string_view path) {
+    Http::TestRequestHeaderMapImpl request_headers{{":path", std::string(path)},
+                                                   {":method", "GET"},
+                                                   {":scheme", "https"},
+                                                   {":authority", "example.com"}};
+    return {request_headers, time_system_.systemTime(), vary_allow_list_};
+  }
+
+  bool insert(SimpleHttpCache& cache, absl::string_view path, std::string body) {
+    return cache.insert(makeLookupRequest(path).key(),
+                        Http::createHeaderMap<Http::ResponseHeaderMapImpl>(
+                            {{Http::LowerCaseString(":status"), "200"}}),
+                        {}, std::move(body), nullptr);
+  }
+
+  bool cached(SimpleHttpCache& cache, absl::string_view path) {
+    return cache.lookup(makeLookupRequest(path)).response_headers_ != nullptr;
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  testing::NiceMock<Server::Configuration::MockServerFactoryContext> factory_context_;
+  VaryAllowList vary_allow_list_{{}, factory_context_};
+};
+
+TEST_F(SimpleHttpCacheEvictionTest, UnboundedCacheNeverEvicts) {
+  SimpleHttpCache cache;
+  EXPECT_TRUE(insert(cache, "/a", std::string(1000, 'a')));
+  EXPECT_TRUE(insert(cache, "/b", std::string(1000, 'b')));
+  EXPECT_TRUE(cached(cache, "/a"));
+  EXPECT_TRUE(cached(cache, "/b"));
+  EXPECT_GT(cache.sizeBytes(), 2000U);
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, EvictsUnreferencedEntriesFirst) {
+  SimpleHttpCache cache(2500);
+  EXPECT_TRUE(insert(cache, "/a", std::string(1000, 'a')));
+  EXPECT_TRUE(insert(cache, "/b", std::string(1000, 'b')));
+  // The lookup gives the oldest entry a second chance.
+  EXPECT_TRUE(cached(cache, "/a"));
+  EXPECT_TRUE(insert(cache, "/c", std::string(1000, 'c')));
+
+  EXPECT_TRUE(cached(cache, "/a"));
+  EXPECT_FALSE(cached(cache, "/b"));
+  EXPECT_TRUE(cached(cache, "/c"));
+  EXPECT_LE(cache.sizeBytes(), 2500U);
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, NeverEvictsInsertedEntry) {
+  SimpleHttpCache cache(2500);
+  EXPECT_TRUE(insert(cache, "/a", std::string(1000, 'a')));
+  EXPECT_TRUE(insert(cache, "/b", std::string(1000, 'b')));
+  // Both existing entries get a second chance, but the new one must still be kept.
+  EXPECT_TRUE(cached(cache, "/a"));
+  EXPECT_TRUE(cached(cache, "/b"));
+  EXPECT_TRUE(insert(cache, "/c", std::string(1000, 'c')));
+
+  EXPECT_FALSE(cached(cache, "/a"));
+  EXPECT_TRUE(cached(cache, "/b"));
+  EXPECT_TRUE(cached(cache, "/c"));
+  EXPECT_LE(cache.sizeBytes(), 2500U);
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, ReplacingEntryUpdatesSize) {
+  SimpleHttpCache cache(2500);
+  EXPECT_TRUE(insert(cache, "/a", std::string(1000, 'a')));
+  const uint64_t size_bytes = cache.sizeBytes();
+  EXPECT_TRUE(insert(cache, "/a", std::string(1000, 'b')));
+  EXPECT_EQ(size_bytes, cache.sizeBytes());
+}
+
+TEST_F(SimpleHttpCacheEvictionTest, RejectsEntryLargerThanCache) {
+  SimpleHttpCache cache(500);
+  EXPECT_FALSE(insert(cache, "/a", std::string(1000, 'a')));
+  EXPECT_FALSE(cached(cache, "/a"));
+  EXPECT_EQ(0, cache.sizeBytes());
+}
+
 TEST(Registration, GetFactory) {
   HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
       "envoy.extensions.http.cache.simple_http_cache.v3.SimpleHttpCacheConfig");
@@ -45,6 +126,26 @@ TEST(Registration, GetFactory) {
             "envoy.extensions.http.cache.simple");
 }
 
+TEST(Registration, SharesCachesWithSameMaxSize) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.simple_http_cache.v3.SimpleHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  envoy::extensions::filters::http::cache::v3::CacheConfig unbounded_config;
+  unbounded_config.mutable_typed_config()->PackFrom(
+      envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig());
+  envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig bounded;
+  bounded.mutable_max_cache_size_bytes()->set_value(1024);
+  envoy::extensions::filters::http::cache::v3::CacheConfig bounded_config;
+  bounded_config.mutable_typed_config()->PackFrom(bounded);
+
+  std::shared_ptr<HttpCache> unbounded_cache = factory->getCache(unbounded_config, factory_context);
+  std::shared_ptr<HttpCache> bounded_cache = factory->getCache(bounded_config, factory_context);
+  EXPECT_NE(unbounded_cache, bounded_cache);
+  EXPECT_EQ(unbounded_cache, factory->getCache(unbounded_config, factory_context));
+  EXPECT_EQ(bounded_cache, factory->getCache(bounded_config, factory_context));
+}
+
 } // namespace
 } // namespace Cache
 } // namespace HttpFilters
@@ -0,0 +1,124 @@
+#include "envoy/extensions/http/cache/simple_http_cache/v3/config.pb.h"
+#include "envoy/extensions/http/cache/tiered_http_cache/v3/tiered_http_cache.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/http/header_map_impl.h"
+#include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
+#include "source/extensions/http/cache/tiered_http_cache/tiered_http_cache.h"
+
+#include "test/extensions/filters/http/cache/http_cache_implementation_test_common.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace {
+
+class TieredHttpCacheTestDelegate : public HttpCacheTestDelegate {
+public:
+  std::shared_ptr<HttpCache> cache() override { return cache_; }
+  bool validationEnabled() const override { return true; }
+
+  SimpleHttpCache& memory() { return *memory_; }
+  SimpleHttpCache& disk() { return *disk_; }
+
+private:
+  Event::SimulatedTimeSystem time_system_;
+  std::shared_ptr<SimpleHttpCache> memory_ = std::make_shared<SimpleHttpCache>();
+  std::shared_ptr<SimpleHttpCache> disk_ = std::make_shared<SimpleHttpCache>();
+  std::shared_ptr<TieredHttpCache> cache_ = std::make_shared<TieredHttpCache>(
+      std::vector<std::shared_ptr<HttpCache>>{memory_, disk_}, time_system_);
+};
+
+INSTANTIATE_TEST_SUITE_P(TieredHttpCacheTest, HttpCacheImplementationTest,
+                         testing::Values(std::make_unique<TieredHttpCacheTestDelegate>),
+                         [](const testing::TestParamInfo<HttpCacheImplementationTest::ParamType>&) {
+                           return "TieredHttpCache";
+                         });
+
+class TieredHttpCacheTest : public HttpCacheImplementationTest {
+protected:
+  TieredHttpCacheTestDelegate& tiers() {
+    return dynamic_cast<TieredHttpCacheTestDelegate&>(*delegate_);
+  }
+
+  bool cached(SimpleHttpCache& cache, absl::string_view path) {
+    return cache.lookup(makeLookupRequest(path)).response_headers_ != nullptr;
+  }
+
+  void insertIntoDisk(absl::string_view path, std::string body) {
+    ASSERT_TRUE(tiers().disk().insert(makeLookupRequest(path).key(),
+                                      Http::createHeaderMap<Http::ResponseHeaderMapImpl>(
+                                          response_headers_),
+                                      {time_system_.systemTime()}, std::move(body), nullptr));
+  }
+
+  Http::TestResponseHeaderMapImpl response_headers_{
+      {":status", "200"},
+      {"date", formatter_.fromTime(time_system_.systemTime())},
+      {"cache-control", "public,max-age=3600"}};
+};
+
+INSTANTIATE_TEST_SUITE_P(TieredHttpCacheTest, TieredHttpCacheTest,
+                         testing::Values(std::make_unique<TieredHttpCacheTestDelegate>));
+
+TEST_P(TieredHttpCacheTest, InsertsIntoAllTiers) {
+  ASSERT_TRUE(insert("/a", response_headers_, "body").ok());
+  EXPECT_TRUE(cached(tiers().memory(), "/a"));
+  EXPECT_TRUE(cached(tiers().disk(), "/a"));
+}
+
+TEST_P(TieredHttpCacheTest, PromotesResponsesFoundInLowerTier) {
+  insertIntoDisk("/a", "body");
+  EXPECT_FALSE(cached(tiers().memory(), "/a"));
+
+  LookupContextPtr context = lookup("/a");
+  EXPECT_TRUE(expectLookupSuccessWithBodyAndTrailers(context.get(), "body"));
+  context->onDestroy();
+  pumpDispatcher();
+  EXPECT_TRUE(cached(tiers().memory(), "/a"));
+}
+
+TEST_P(TieredHttpCacheTest, DoesntPromotePartialReads) {
+  insertIntoDisk("/a", "body");
+
+  // Only the headers are read.
+  LookupContextPtr context = lookup("/a");
+  EXPECT_EQ(CacheEntryStatus::Ok, lookup_result_.cache_entry_status_);
+  context->onDestroy();
+  pumpDispatcher();
+  EXPECT_FALSE(cached(tiers().memory(), "/a"));
+}
+
+TEST(TieredHttpCacheFactoryTest, MakesTiersFromTheirConfigs) {
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  envoy::extensions::filters::http::cache::v3::CacheConfig config;
+  envoy::extensions::http::cache::tiered_http_cache::v3::TieredHttpCacheConfig tiered_config;
+  envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig simple_config;
+  simple_config.mutable_max_cache_size_bytes()->set_value(1024);
+  tiered_config.add_tiers()->PackFrom(simple_config);
+  simple_config.mutable_max_cache_size_bytes()->set_value(4096);
+  tiered_config.add_tiers()->PackFrom(simple_config);
+  config.mutable_typed_config()->PackFrom(tiered_config);
+
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.tiered_http_cache.v3.TieredHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  std::shared_ptr<HttpCache> cache = factory->getCache(config, factory_context);
+  auto* tiered_cache = dynamic_cast<TieredHttpCache*>(cache.get());
+  ASSERT_NE(tiered_cache, nullptr);
+  ASSERT_EQ(2, tiered_cache->tiers().size());
+  EXPECT_NE(tiered_cache->tiers()[0], tiered_cache->tiers()[1]);
+  EXPECT_EQ(cache->cacheInfo().name_, "envoy.extensions.http.cache.tiered_http_cache");
+}
+
+} // namespace
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
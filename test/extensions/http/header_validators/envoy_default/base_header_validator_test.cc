@@ -156,6 +156,30 @@ TEST_F(BaseHeaderValidatorTest, ValidateGenericHeaderValue) {
   }
 }
 
+// Values longer than a word are validated a word at a time, with the characters tested in each
+// position of the words and of the remainder.
+TEST_F(BaseHeaderValidatorTest, ValidateLongGenericHeaderValue) {
+  auto uhv = createBase(empty_config);
+  std::string value(19, 'a');
+  for (size_t position = 0; position < value.size(); ++position) {
+    for (int i = 0; i <= 0xff; ++i) {
+      char c = static_cast<char>(i);
+      HeaderString header_string{"x"};
+      value[position] = c;
+
+      setHeaderStringUnvalidated(header_string, value);
+
+      auto result = uhv->validateGenericHeaderValue(header_string);
+      if (testCharInTable(kGenericHeaderValueCharTable, c)) {
+        EXPECT_ACCEPT(result);
+      } else {
+        EXPECT_REJECT_WITH_DETAILS(result, UhvResponseCodeDetail::get().InvalidValueCharacters);
+      }
+    }
+    value[position] = '\t';
+  }
+}
+
 TEST_F(BaseHeaderValidatorTest, ValidateContentLength) {
   HeaderString valid{"100"};
   HeaderString invalid{"10a2"};
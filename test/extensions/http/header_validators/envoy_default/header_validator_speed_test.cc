@@ -0,0 +1,65 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+#include <vector>
+
+#include "source/extensions/http/header_validators/envoy_default/header_validator.h"
+
+#include "test/mocks/http/header_validator.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Http {
+namespace HeaderValidators {
+namespace EnvoyDefault {
+namespace {
+
+// Header values of the kinds and lengths seen in browser and API traffic.
+std::vector<::Envoy::Http::HeaderString> headerValues() {
+  const std::vector<std::string> values = {
+      "gzip, deflate, br",
+      "en-US,en;q=0.9",
+      "text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8",
+      "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) "
+      "Chrome/120.0.0.0 Safari/537.36",
+      "Bearer eyJhbGciOiJSUzI1NiIsInR5cCI6IkpXVCJ9.eyJpc3MiOiJodHRwczovL2V4YW1wbGUuY29tIiwic3Vi"
+      "IjoiMTIzNDU2Nzg5MCIsImF1ZCI6ImFwaSIsImV4cCI6MTcwMDAwMDAwMH0.c2lnbmF0dXJl",
+      "session=3f2a9c0e1b7d4e6f8a5b2c1d0e9f8a7b; theme=dark; _ga=GA1.2.1234567890.1700000000; "
+      "consent=true",
+      "1f0c7c6e-2a8b-4d4e-9c3f-6b5a4d3c2b1a",
+      "no-cache",
+  };
+  std::vector<::Envoy::Http::HeaderString> header_values(values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    header_values[i].setCopy(values[i]);
+  }
+  return header_values;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_ValidateGenericHeaderValue(benchmark::State& state) {
+  envoy::extensions::http::header_validators::envoy_default::v3::HeaderValidatorConfig config;
+  ConfigOverrides overrides;
+  testing::NiceMock<::Envoy::Http::MockHeaderValidatorStats> stats;
+  HeaderValidator validator(config, ::Envoy::Http::Protocol::Http11, stats, overrides);
+  const std::vector<::Envoy::Http::HeaderString> header_values = headerValues();
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (const auto& value : header_values) {
+      benchmark::DoNotOptimize(validator.validateGenericHeaderValue(value).ok());
+    }
+  }
+}
+BENCHMARK(BM_ValidateGenericHeaderValue);
+
+} // namespace EnvoyDefault
+} // namespace HeaderValidators
+} // namespace Http
+} // namespace Extensions
+} // namespace Envoy
@@ -455,6 +455,22 @@ TEST_F(IoHandleImplTest, WriteAgain) {
   EXPECT_EQ(10, buf.length());
 }
 
+// A partial write moves the slices which fit rather than copying part of the next one.
+TEST_F(IoHandleImplTest, PartialWriteMovesWholeSlices) {
+  io_handle_peer_->setWatermarks(FRAGMENT_SIZE + FRAGMENT_SIZE / 2);
+  Buffer::OwnedImpl buf;
+  buf.appendSliceForTest(std::string(FRAGMENT_SIZE, 'a'));
+  buf.appendSliceForTest(std::string(FRAGMENT_SIZE, 'b'));
+  const void* first_slice = buf.frontSlice().mem_;
+
+  auto result = io_handle_->write(buf);
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(FRAGMENT_SIZE, result.return_value_);
+  EXPECT_EQ(std::string(FRAGMENT_SIZE, 'b'), buf.toString());
+  EXPECT_EQ(first_slice, io_handle_peer_->getWriteBuffer()->frontSlice().mem_);
+  EXPECT_EQ(std::string(FRAGMENT_SIZE, 'a'), io_handle_peer_->getWriteBuffer()->toString());
+}
+
 TEST_F(IoHandleImplTest, PartialWrite) {
   const uint64_t INITIAL_SIZE = 4 * FRAGMENT_SIZE;
   io_handle_peer_->setWatermarks(FRAGMENT_SIZE + 1);
@@ -149,6 +149,21 @@ TEST_F(KeyValueStoreTest, Persist) {
   EXPECT_FALSE(store_->get("bar").has_value());
 }
 
+// The periodic flush does not rewrite the file if the store did not change.
+TEST_F(KeyValueStoreTest, PeriodicFlushSkipsUnchangedStore) {
+  store_->addOrUpdate("foo", "bar", absl::nullopt);
+  flush_timer_->invokeCallback();
+  EXPECT_EQ("3\nfoo3\nbar", TestEnvironment::readFileToStringForTest(filename_));
+
+  TestEnvironment::writeStringToFileForTest(filename_, "unchanged", true);
+  flush_timer_->invokeCallback();
+  EXPECT_EQ("unchanged", TestEnvironment::readFileToStringForTest(filename_));
+
+  store_->remove("foo");
+  flush_timer_->invokeCallback();
+  EXPECT_EQ("", TestEnvironment::readFileToStringForTest(filename_));
+}
+
 TEST_F(KeyValueStoreTest, PersistWithTTL) {
   test_time_.setSystemTime(std::chrono::milliseconds(0));
   store_->addOrUpdate("foo", "bar", std::chrono::seconds(2));
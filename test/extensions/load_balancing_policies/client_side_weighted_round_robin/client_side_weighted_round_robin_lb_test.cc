@@ -32,7 +32,7 @@ public:
 
   void updateWeightsOnMainThread() { lb_->updateWeightsOnMainThread(); }
 
-  void updateWeightsOnHosts(const HostVector& hosts) { lb_->updateWeightsOnHosts(hosts); }
+  bool updateWeightsOnHosts(const HostVector& hosts) { return lb_->updateWeightsOnHosts(hosts); }
 
   static absl::optional<uint32_t>
   getClientSideWeightIfValidFromHost(const Host& host, const MonotonicTime& min_non_empty_since,
@@ -182,6 +182,34 @@ TEST_P(ClientSideWeightedRoundRobinLoadBalancerTest,
   EXPECT_EQ(hosts[2]->weight(), 42);
 }
 
+TEST_P(ClientSideWeightedRoundRobinLoadBalancerTest, UpdateWeightsIgnoresChangesBelowThreshold) {
+  lb_config_.weight_change_threshold = 0.1;
+  init(false);
+  HostVector hosts = {
+      makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
+      makeTestHost(info_, "tcp://127.0.0.1:81", simTime()),
+  };
+  simTime().setMonotonicTime(MonotonicTime(std::chrono::seconds(30)));
+  lb_->setHostClientSideWeight(hosts[0], 100, 5, 10);
+  lb_->setHostClientSideWeight(hosts[1], 200, 5, 10);
+  EXPECT_TRUE(lb_->updateWeightsOnHosts(hosts));
+  EXPECT_EQ(hosts[0]->weight(), 100);
+  EXPECT_EQ(hosts[1]->weight(), 200);
+
+  // Changes of less than 10% of the current weights are ignored.
+  lb_->setHostClientSideWeight(hosts[0], 109, 5, 20);
+  lb_->setHostClientSideWeight(hosts[1], 185, 5, 20);
+  EXPECT_FALSE(lb_->updateWeightsOnHosts(hosts));
+  EXPECT_EQ(hosts[0]->weight(), 100);
+  EXPECT_EQ(hosts[1]->weight(), 200);
+
+  // They are applied once they add up to at least 10%.
+  lb_->setHostClientSideWeight(hosts[0], 111, 5, 25);
+  EXPECT_TRUE(lb_->updateWeightsOnHosts(hosts));
+  EXPECT_EQ(hosts[0]->weight(), 111);
+  EXPECT_EQ(hosts[1]->weight(), 200);
+}
+
 TEST_P(ClientSideWeightedRoundRobinLoadBalancerTest, UpdateWeightsOneHostHasClientSideWeight) {
   init(false);
   HostVector hosts = {
@@ -78,6 +78,8 @@ BENCHMARK(benchmarkMaglevLoadBalancerBuildTable)
     ->Arg(100)
     ->Arg(200)
     ->Arg(500)
+    ->Arg(1000)
+    ->Arg(10000)
     ->Unit(::benchmark::kMillisecond);
 
 void benchmarkMaglevLoadBalancerHostLoss(::benchmark::State& state) {
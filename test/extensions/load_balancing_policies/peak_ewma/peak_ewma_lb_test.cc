@@ -0,0 +1,115 @@
+#include <chrono>
+#include <cmath>
+
+#include "source/extensions/load_balancing_policies/peak_ewma/peak_ewma_lb.h"
+
+#include "test/extensions/load_balancing_policies/common/load_balancer_impl_base_test.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+using testing::Return;
+
+TEST(PeakEwmaHostLbPolicyDataTest, PeakAndDecay) {
+  Event::SimulatedTimeSystem time_system;
+  PeakEwmaHostLbPolicyData data(time_system, std::chrono::seconds(10), 100);
+  EXPECT_DOUBLE_EQ(100, data.rtt(time_system.monotonicTime()));
+
+  // A slower response replaces the estimate.
+  data.onResponseTime(std::chrono::milliseconds(300));
+  EXPECT_DOUBLE_EQ(300, data.rtt(time_system.monotonicTime()));
+
+  // Without responses the estimate decays towards the default.
+  time_system.advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_DOUBLE_EQ(300 * std::exp(-1.0) + 100 * (1 - std::exp(-1.0)),
+                   data.rtt(time_system.monotonicTime()));
+
+  // A faster response is averaged into the estimate at the last update.
+  data.onResponseTime(std::chrono::milliseconds(20));
+  EXPECT_DOUBLE_EQ(300 * std::exp(-1.0) + 20 * (1 - std::exp(-1.0)),
+                   data.rtt(time_system.monotonicTime()));
+}
+
+class PeakEwmaLoadBalancerTest : public LoadBalancerTestBase {
+public:
+  void init() {
+    PeakEwmaLbProto proto;
+    lb_config_ = std::make_unique<PeakEwmaLbConfig>(proto);
+    thread_aware_lb_ = std::make_unique<PeakEwmaThreadAwareLoadBalancer>(
+        *lb_config_, *info_, priority_set_, runtime_, random_, simTime());
+    ASSERT_TRUE(thread_aware_lb_->initialize().ok());
+    lb_ = thread_aware_lb_->factory()->create({priority_set_, nullptr});
+  }
+
+  void addHosts() {
+    const HostVector hosts{makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
+                           makeTestHost(info_, "tcp://127.0.0.1:81", simTime())};
+    hostSet().healthy_hosts_ = hosts;
+    hostSet().hosts_ = hosts;
+    hostSet().runCallbacks(hosts, {});
+  }
+
+  std::unique_ptr<PeakEwmaLbConfig> lb_config_;
+  ThreadAwareLoadBalancerPtr thread_aware_lb_;
+  LoadBalancerPtr lb_;
+};
+
+TEST_P(PeakEwmaLoadBalancerTest, NoHosts) {
+  init();
+
+  EXPECT_EQ(nullptr, lb_->peekAnotherHost(nullptr));
+  EXPECT_EQ(nullptr, lb_->chooseHost(nullptr).host);
+}
+
+TEST_P(PeakEwmaLoadBalancerTest, SingleHost) {
+  init();
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime())};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks(hostSet().hosts_, {});
+
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
+}
+
+TEST_P(PeakEwmaLoadBalancerTest, PicksLowerLatency) {
+  init();
+  addHosts();
+  ASSERT_TRUE(hostSet().hosts_[0]->lbPolicyData().has_value());
+  ASSERT_TRUE(hostSet().hosts_[1]->lbPolicyData().has_value());
+
+  hostSet().hosts_[0]->lbPolicyData()->onResponseTime(std::chrono::milliseconds(500));
+
+  // Whichever host is picked first, the faster one is chosen.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_CALL(random_, random()).WillOnce(Return(1)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
+}
+
+TEST_P(PeakEwmaLoadBalancerTest, PicksFewerActiveRequests) {
+  init();
+  addHosts();
+
+  hostSet().hosts_[0]->lbPolicyData()->onResponseTime(std::chrono::milliseconds(200));
+  // 200ms * 1 is cheaper than 100ms * 3.
+  hostSet().hosts_[1]->stats().rq_active_.add(2);
+
+  EXPECT_CALL(random_, random()).WillOnce(Return(1)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
+
+  // 200ms * 4 is more expensive than 100ms * 3.
+  hostSet().hosts_[0]->stats().rq_active_.add(3);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
+}
+
+INSTANTIATE_TEST_SUITE_P(PrimaryOrFailoverAndLegacyOrNew, PeakEwmaLoadBalancerTest,
+                         ::testing::Values(LoadBalancerTestParam{true},
+                                           LoadBalancerTestParam{false}));
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
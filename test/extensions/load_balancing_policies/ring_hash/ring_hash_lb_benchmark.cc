@@ -48,9 +48,13 @@ BENCHMARK(benchmarkRingHashLoadBalancerBuildRing)
     ->Args({100, 65536})
     ->Args({200, 65536})
     ->Args({500, 65536})
+    ->Args({1000, 65536})
+    ->Args({10000, 65536})
     ->Args({100, 256000})
     ->Args({200, 256000})
     ->Args({500, 256000})
+    ->Args({1000, 256000})
+    ->Args({10000, 256000})
     ->Unit(::benchmark::kMillisecond);
 
 void benchmarkRingHashLoadBalancerChooseHost(::benchmark::State& state) {
@@ -68,6 +68,35 @@ BENCHMARK(benchmarkRoundRobinLoadBalancerBuild)
     ->Args({50000, 100, 50})
     ->Unit(::benchmark::kMillisecond);
 
+// Measures an update of the host set that leaves the hosts and their weights unchanged, e.g. an
+// EDS update that only touches another priority, which doesn't rebuild the EDF schedulers.
+void benchmarkRoundRobinLoadBalancerRefreshUnchanged(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t weighted_subset_percent = state.range(1);
+  const uint64_t weight = state.range(2);
+
+  if (benchmark::skipExpensiveBenchmarks() && num_hosts > 10000) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  RoundRobinTester tester(num_hosts, weighted_subset_percent, weight);
+  tester.initialize();
+  const HostSet& host_set = *tester.priority_set_.hostSetsPerPriority()[0];
+  const HostVectorConstSharedPtr hosts = std::make_shared<HostVector>(host_set.hosts());
+  const HostsPerLocalityConstSharedPtr hosts_per_locality = makeHostsPerLocality({*hosts});
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    tester.priority_set_.updateHosts(0, HostSetImpl::partitionHosts(hosts, hosts_per_locality),
+                                     {}, {}, {}, tester.random_.random(), absl::nullopt);
+  }
+}
+BENCHMARK(benchmarkRoundRobinLoadBalancerRefreshUnchanged)
+    ->Args({500, 50, 50})
+    ->Args({2500, 50, 50})
+    ->Args({10000, 50, 50})
+    ->Args({25000, 50, 50})
+    ->Unit(::benchmark::kMillisecond);
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -60,6 +60,7 @@ public:
   MOCK_METHOD(bool, panicModeAny, (), (const));
   MOCK_METHOD(bool, listAsAny, (), (const));
   MOCK_METHOD(bool, allowRedundantKeys, (), (const));
+  MOCK_METHOD(bool, lazySubsetCreation, (), (const));
 
   std::vector<SubsetSelectorPtr> subset_selectors_;
 };
@@ -968,6 +969,59 @@ TEST_P(SubsetLoadBalancerTest, BalancesSubsetAfterUpdate) {
   EXPECT_EQ(3U, stats_.lb_subsets_created_.value());
 }
 
+TEST_P(SubsetLoadBalancerTest, LazySubsetCreation) {
+  EXPECT_CALL(subset_info_, fallbackPolicy())
+      .WillRepeatedly(Return(envoy::config::cluster::v3::Cluster::LbSubsetConfig::NO_FALLBACK));
+  EXPECT_CALL(subset_info_, lazySubsetCreation()).WillRepeatedly(Return(true));
+
+  std::vector<SubsetSelectorPtr> subset_selectors = {makeSelector(
+      {"version"},
+      envoy::config::cluster::v3::Cluster::LbSubsetConfig::LbSubsetSelector::NOT_DEFINED)};
+
+  EXPECT_CALL(subset_info_, subsetSelectors()).WillRepeatedly(ReturnRef(subset_selectors));
+
+  init({
+      {"tcp://127.0.0.1:80", {{"version", "1.0"}}},
+      {"tcp://127.0.0.1:81", {{"version", "1.0"}}},
+      {"tcp://127.0.0.1:82", {{"version", "1.1"}}},
+  });
+
+  // No subset load balancer is created before a request selects the subset.
+  EXPECT_EQ(0U, stats_.lb_subsets_created_.value());
+  EXPECT_EQ(0U, stats_.lb_subsets_active_.value());
+
+  TestLoadBalancerContext context_10({{"version", "1.0"}});
+  TestLoadBalancerContext context_11({{"version", "1.1"}});
+  TestLoadBalancerContext context_12({{"version", "1.2"}});
+
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10).host);
+  EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10).host);
+  EXPECT_EQ(nullptr, lb_->chooseHost(&context_12).host);
+  EXPECT_EQ(1U, stats_.lb_subsets_created_.value());
+  EXPECT_EQ(1U, stats_.lb_subsets_active_.value());
+
+  // The hosts of a subset without load balancer follow the updates.
+  host_set_.hosts_[0]->metadata(buildMetadata("1.1"));
+  host_set_.runCallbacks({}, {});
+  EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10).host);
+  EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10).host);
+  EXPECT_EQ(1U, stats_.lb_subsets_created_.value());
+
+  const HostConstSharedPtr host = lb_->chooseHost(&context_11).host;
+  EXPECT_TRUE(host == host_set_.hosts_[0] || host == host_set_.hosts_[2]);
+  EXPECT_NE(host, lb_->chooseHost(&context_11).host);
+  EXPECT_EQ(2U, stats_.lb_subsets_created_.value());
+  EXPECT_EQ(2U, stats_.lb_subsets_active_.value());
+
+  // A subset that lost all its hosts before being used is purged without being accounted for.
+  host_set_.hosts_[2]->metadata(buildMetadata("1.3"));
+  host_set_.runCallbacks({}, {});
+  host_set_.hosts_[2]->metadata(buildMetadata("1.4"));
+  host_set_.runCallbacks({}, {});
+  EXPECT_EQ(2U, stats_.lb_subsets_created_.value());
+  EXPECT_EQ(0U, stats_.lb_subsets_removed_.value());
+}
+
 TEST_P(SubsetLoadBalancerTest, ListAsAnyEnabled) {
   EXPECT_CALL(subset_info_, fallbackPolicy())
       .WillRepeatedly(Return(envoy::config::cluster::v3::Cluster::LbSubsetConfig::NO_FALLBACK));
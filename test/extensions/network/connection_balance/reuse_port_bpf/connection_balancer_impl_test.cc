@@ -0,0 +1,161 @@
+#include <linux/bpf.h>
+
+#include <limits>
+
+#include "envoy/config/core/v3/extension.pb.h"
+#include "envoy/extensions/network/connection_balance/reuse_port_bpf/v3/reuse_port_bpf.pb.h"
+
+#include "source/common/network/connection_balancer_impl.h"
+#include "source/extensions/network/connection_balance/reuse_port_bpf/config.h"
+#include "source/extensions/network/connection_balance/reuse_port_bpf/connection_balancer_impl.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "absl/strings/match.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ConnectionBalance {
+namespace ReusePortBpf {
+namespace {
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+
+class MockBalancedConnectionHandler : public Network::BalancedConnectionHandler {
+public:
+  MOCK_METHOD(uint64_t, numConnections, (), (const));
+  MOCK_METHOD(void, incNumConnections, ());
+  MOCK_METHOD(void, post, (Network::ConnectionSocketPtr && socket));
+  MOCK_METHOD(void, onAcceptWorker,
+              (Network::ConnectionSocketPtr && socket,
+               bool hand_off_restored_destination_connections, bool rebalanced));
+};
+
+constexpr int CountsMapFd = 10;
+constexpr int SocketsMapFd = 11;
+constexpr int ProgramFd = 12;
+
+class ReusePortBpfConnectionBalancerTest : public testing::Test {
+protected:
+  // Expect the maps to be created and the program to be loaded for the given number of slots.
+  void expectCreate(uint32_t slots) {
+    testing::InSequence s;
+    EXPECT_CALL(linux_os_sys_calls_, bpf(BPF_MAP_CREATE, _, _))
+        .WillOnce(Invoke([slots](int, union bpf_attr* attr, unsigned int) {
+          EXPECT_EQ(BPF_MAP_TYPE_ARRAY, attr->map_type);
+          EXPECT_EQ(slots, attr->max_entries);
+          return Api::SysCallIntResult{CountsMapFd, 0};
+        }));
+    // Every slot starts out unused.
+    EXPECT_CALL(linux_os_sys_calls_, bpf(BPF_MAP_UPDATE_ELEM, _, _))
+        .Times(slots)
+        .WillRepeatedly(Invoke([](int, union bpf_attr* attr, unsigned int) {
+          EXPECT_EQ(CountsMapFd, attr->map_fd);
+          EXPECT_EQ(std::numeric_limits<uint64_t>::max(),
+                    *reinterpret_cast<const uint64_t*>(attr->value));
+          return Api::SysCallIntResult{0, 0};
+        }));
+    EXPECT_CALL(linux_os_sys_calls_, bpf(BPF_MAP_CREATE, _, _))
+        .WillOnce(Invoke([](int, union bpf_attr* attr, unsigned int) {
+          EXPECT_EQ(BPF_MAP_TYPE_REUSEPORT_SOCKARRAY, attr->map_type);
+          return Api::SysCallIntResult{SocketsMapFd, 0};
+        }));
+    EXPECT_CALL(linux_os_sys_calls_, bpf(BPF_PROG_LOAD, _, _))
+        .WillOnce(Invoke([slots](int, union bpf_attr* attr, unsigned int) {
+          EXPECT_EQ(BPF_PROG_TYPE_SK_REUSEPORT, attr->prog_type);
+          EXPECT_EQ(leastConnectionsProgram(CountsMapFd, SocketsMapFd, slots).size(),
+                    attr->insn_cnt);
+          return Api::SysCallIntResult{ProgramFd, 0};
+        }));
+  }
+
+  void expectClose(std::vector<int> fds) {
+    for (int fd : fds) {
+      EXPECT_CALL(os_sys_calls_, close(fd)).WillOnce(Return(Api::SysCallIntResult{0, 0}));
+    }
+  }
+
+  NiceMock<Api::MockOsSysCalls> os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_{&os_sys_calls_};
+  NiceMock<Api::MockLinuxOsSysCalls> linux_os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> linux_os_calls_{&linux_os_sys_calls_};
+};
+
+TEST_F(ReusePortBpfConnectionBalancerTest, InvalidSlots) {
+  EXPECT_EQ(absl::StatusCode::kInvalidArgument,
+            ReusePortBpfConnectionBalancerImpl::create(0).status().code());
+  constexpr uint32_t TooManySlots = ReusePortBpfConnectionBalancerImpl::MaxSlots + 1;
+  EXPECT_EQ(absl::StatusCode::kInvalidArgument,
+            ReusePortBpfConnectionBalancerImpl::create(TooManySlots).status().code());
+}
+
+TEST_F(ReusePortBpfConnectionBalancerTest, ProgramLoadFails) {
+  EXPECT_CALL(linux_os_sys_calls_, bpf(BPF_MAP_CREATE, _, _))
+      .WillOnce(Return(Api::SysCallIntResult{CountsMapFd, 0}))
+      .WillOnce(Return(Api::SysCallIntResult{SocketsMapFd, 0}));
+  EXPECT_CALL(linux_os_sys_calls_, bpf(BPF_MAP_UPDATE_ELEM, _, _))
+      .Times(2)
+      .WillRepeatedly(Return(Api::SysCallIntResult{0, 0}));
+  EXPECT_CALL(linux_os_sys_calls_, bpf(BPF_PROG_LOAD, _, _))
+      .WillOnce(Return(Api::SysCallIntResult{-1, EPERM}));
+  // The maps that were created are closed again.
+  expectClose({SocketsMapFd, CountsMapFd});
+  EXPECT_EQ(absl::StatusCode::kUnavailable,
+            ReusePortBpfConnectionBalancerImpl::create(2).status().code());
+}
+
+TEST_F(ReusePortBpfConnectionBalancerTest, HandlerWithoutListenSocketIsNotBalanced) {
+  expectCreate(2);
+  auto balancer_or_error = ReusePortBpfConnectionBalancerImpl::create(2);
+  ASSERT_TRUE(balancer_or_error.ok());
+  auto balancer = std::move(*balancer_or_error);
+
+  MockBalancedConnectionHandler handler;
+  balancer->registerHandler(handler);
+  // The connection is only counted, there is no slot to publish the count to.
+  EXPECT_CALL(handler, incNumConnections());
+  EXPECT_CALL(linux_os_sys_calls_, bpf(_, _, _)).Times(0);
+  EXPECT_EQ(&handler, &balancer->pickTargetHandler(handler));
+  balancer->onConnectionClosed(handler);
+  balancer->unregisterHandler(handler);
+
+  expectClose({ProgramFd, SocketsMapFd, CountsMapFd});
+  balancer.reset();
+}
+
+TEST_F(ReusePortBpfConnectionBalancerTest, FactoryFallsBackWithoutBpf) {
+  EXPECT_CALL(linux_os_sys_calls_, bpf(BPF_MAP_CREATE, _, _))
+      .WillOnce(Return(Api::SysCallIntResult{-1, EPERM}));
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  ReusePortBpfConnectionBalanceFactory factory;
+  envoy::config::core::v3::TypedExtensionConfig config;
+  config.mutable_typed_config()->PackFrom(
+      envoy::extensions::network::connection_balance::reuse_port_bpf::v3::ReusePortBpf());
+  EXPECT_NE(nullptr, dynamic_cast<Network::NopConnectionBalancerImpl*>(
+                         factory.createConnectionBalancerFromProto(config, context).get()));
+}
+
+// Loads the program for real, which needs the privileges to load BPF programs.
+TEST(ReusePortBpfConnectionBalancerKernelTest, ProgramIsAccepted) {
+  auto balancer_or_error =
+      ReusePortBpfConnectionBalancerImpl::create(ReusePortBpfConnectionBalancerImpl::MaxSlots);
+  // Creating the maps already fails without the privileges.
+  if (absl::StartsWith(balancer_or_error.status().message(), "failed to create BPF map")) {
+    GTEST_SKIP() << balancer_or_error.status();
+  }
+  // Otherwise a failure is the verifier rejecting the program.
+  EXPECT_TRUE(balancer_or_error.ok()) << balancer_or_error.status();
+}
+
+} // namespace
+} // namespace ReusePortBpf
+} // namespace ConnectionBalance
+} // namespace Extensions
+} // namespace Envoy
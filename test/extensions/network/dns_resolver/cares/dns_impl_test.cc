@@ -724,6 +724,7 @@ public:
     cares.set_filter_unroutable_families(filterUnroutableFamilies());
     cares.set_allocated_udp_max_queries(udpMaxQueries());
     cares.set_rotate_nameservers(setRotateNameservers());
+    cares.set_coalesce_queries(coalesceQueries());
 
     // Copy over the dns_resolver_options_.
     cares.mutable_dns_resolver_options()->MergeFrom(dns_resolver_options);
@@ -964,6 +965,7 @@ protected:
   virtual bool setResolverInConstructor() const { return false; }
   virtual bool filterUnroutableFamilies() const { return false; }
   virtual bool setRotateNameservers() const { return false; }
+  virtual bool coalesceQueries() const { return false; }
   virtual ProtobufWkt::UInt32Value* udpMaxQueries() const { return nullptr; }
   Stats::TestUtil::TestStore stats_store_;
   NiceMock<Runtime::MockLoader> runtime_;
@@ -2063,6 +2065,47 @@ TEST_P(DnsImplAresFlagsForDefaultSearchDomainTest, NoDefaultSearchDomainNotSet)
   ares_destroy_options(&opts);
 }
 
+class DnsImplCoalesceQueriesTest : public DnsImplTest {
+protected:
+  bool coalesceQueries() const override { return true; }
+};
+
+// Parameterize the DNS test server socket address.
+INSTANTIATE_TEST_SUITE_P(IpVersions, DnsImplCoalesceQueriesTest,
+                         testing::ValuesIn(TestEnvironment::getIpVersionsForTest()),
+                         TestUtility::ipTestParamsToString);
+
+// Validate that identical queries in flight are sent once, and all complete with the response.
+TEST_P(DnsImplCoalesceQueriesTest, CoalesceQueriesInFlight) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  // A cancelled coalesced query is not called back.
+  ActiveDnsQuery* query =
+      resolveWithUnreferencedParameters("some.good.domain", DnsLookupFamily::V4Only, false);
+  ASSERT_NE(nullptr, query);
+  query->cancel(Network::ActiveDnsQuery::CancelReason::QueryAbandoned);
+
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  checkStats(1 /*resolve_total*/, 0 /*pending_resolutions*/, 0 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/);
+  EXPECT_EQ(2, stats_store_.counter("dns.cares.resolve_coalesced").value());
+
+  // Queries issued once the resolution completed are sent again.
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  checkStats(2 /*resolve_total*/, 0 /*pending_resolutions*/, 0 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/);
+  EXPECT_EQ(2, stats_store_.counter("dns.cares.resolve_coalesced").value());
+}
+
 class DnsImplCustomResolverTest : public DnsImplTest {
   bool tcpOnly() const override { return false; }
   void updateDnsResolverOptions() override {
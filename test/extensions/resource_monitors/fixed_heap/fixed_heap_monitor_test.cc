@@ -2,6 +2,8 @@
 
 #include "source/extensions/resource_monitors/fixed_heap/fixed_heap_monitor.h"
 
+#include "test/test_common/simulated_time_system.h"
+
 #include "absl/types/optional.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -49,7 +51,8 @@ TEST(FixedHeapMonitorTest, ComputesCorrectUsage) {
   EXPECT_CALL(*stats_reader, reservedHeapBytes()).WillOnce(Return(800));
   EXPECT_CALL(*stats_reader, unmappedHeapBytes()).WillOnce(Return(100));
   EXPECT_CALL(*stats_reader, freeMappedHeapBytes()).WillOnce(Return(200));
-  auto monitor = std::make_unique<FixedHeapMonitor>(config, std::move(stats_reader));
+  Event::SimulatedTimeSystem time_system;
+  auto monitor = std::make_unique<FixedHeapMonitor>(config, time_system, std::move(stats_reader));
 
   ResourcePressure resource;
   monitor->updateResourceUsage(resource);
@@ -68,12 +71,44 @@ TEST(FixedHeapMonitorTest, ComputeUsageWithRealMemoryStats) {
       (stats_reader->reservedHeapBytes() - stats_reader->unmappedHeapBytes() -
        stats_reader->freeMappedHeapBytes()) /
       static_cast<double>(max_heap);
-  auto monitor = std::make_unique<FixedHeapMonitor>(config, std::move(stats_reader));
+  Event::SimulatedTimeSystem time_system;
+  auto monitor = std::make_unique<FixedHeapMonitor>(config, time_system, std::move(stats_reader));
 
   ResourcePressure resource;
   monitor->updateResourceUsage(resource);
   EXPECT_NEAR(resource.pressure(), expected_usage, 0.0005);
 }
+
+TEST(FixedHeapMonitorTest, ProjectsGrowingUsage) {
+  envoy::extensions::resource_monitors::fixed_heap::v3::FixedHeapConfig config;
+  config.set_max_heap_size_bytes(1000);
+  config.mutable_growth_lookahead()->set_seconds(2);
+  auto stats_reader = std::make_unique<MockMemoryStatsReader>();
+  EXPECT_CALL(*stats_reader, reservedHeapBytes())
+      .WillOnce(Return(200))
+      .WillOnce(Return(300))
+      .WillOnce(Return(250));
+  EXPECT_CALL(*stats_reader, unmappedHeapBytes()).WillRepeatedly(Return(0));
+  EXPECT_CALL(*stats_reader, freeMappedHeapBytes()).WillRepeatedly(Return(0));
+  Event::SimulatedTimeSystem time_system;
+  auto monitor = std::make_unique<FixedHeapMonitor>(config, time_system, std::move(stats_reader));
+
+  // Nothing to project from on the first update.
+  ResourcePressure resource;
+  monitor->updateResourceUsage(resource);
+  EXPECT_EQ(resource.pressure(), 0.2);
+
+  // Grew by 100 bytes in a second, which is 200 more bytes in two seconds.
+  time_system.advanceTimeWait(std::chrono::seconds(1));
+  monitor->updateResourceUsage(resource);
+  EXPECT_DOUBLE_EQ(resource.pressure(), 0.5);
+
+  // Shrinking usage is not projected.
+  time_system.advanceTimeWait(std::chrono::seconds(1));
+  monitor->updateResourceUsage(resource);
+  EXPECT_EQ(resource.pressure(), 0.25);
+}
+
 } // namespace
 } // namespace FixedHeapMonitor
 } // namespace ResourceMonitors
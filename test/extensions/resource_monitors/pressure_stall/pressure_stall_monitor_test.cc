@@ -0,0 +1,126 @@
+#include <chrono>
+
+#include "envoy/extensions/resource_monitors/pressure_stall/v3/pressure_stall.pb.h"
+
+#include "source/extensions/resource_monitors/pressure_stall/pressure_stall_monitor.h"
+
+#include "test/test_common/environment.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ResourceMonitors {
+namespace PressureStallMonitor {
+namespace {
+
+class ResourcePressure : public Server::ResourceUpdateCallbacks {
+public:
+  void onSuccess(const Server::ResourceUsage& usage) override {
+    pressure_ = usage.resource_pressure_;
+    error_.reset();
+  }
+
+  void onFailure(const EnvoyException& error) override {
+    pressure_.reset();
+    error_ = error;
+  }
+
+  bool hasPressure() const { return pressure_.has_value(); }
+  bool hasError() const { return error_.has_value(); }
+
+  double pressure() const { return *pressure_; }
+
+private:
+  absl::optional<double> pressure_;
+  absl::optional<EnvoyException> error_;
+};
+
+class PressureStallMonitorTest : public testing::Test {
+protected:
+  PressureStallMonitorTest() : file_updater_(cgroup_path_ + "/cpu.pressure") {
+    config_.set_cgroup_path(cgroup_path_);
+    config_.mutable_smoothing_factor()->set_value(1);
+  }
+
+  void writePressure(uint64_t some_total, uint64_t full_total) {
+    file_updater_.update(fmt::format("some avg10=0.00 avg60=0.00 avg300=0.00 total={}\n"
+                                     "full avg10=0.00 avg60=0.00 avg300=0.00 total={}\n",
+                                     some_total, full_total));
+  }
+
+  const std::string cgroup_path_{TestEnvironment::temporaryDirectory()};
+  AtomicFileUpdater file_updater_;
+  envoy::extensions::resource_monitors::pressure_stall::v3::PressureStallConfig config_;
+  Event::SimulatedTimeSystem time_system_;
+  ResourcePressure resource_;
+};
+
+TEST_F(PressureStallMonitorTest, ReportsShareOfTimeStalled) {
+  PressureStallMonitor monitor(config_, time_system_);
+  writePressure(1000000, 0);
+  // Nothing to compare with on the first update.
+  monitor.updateResourceUsage(resource_);
+  ASSERT_TRUE(resource_.hasPressure());
+  EXPECT_EQ(resource_.pressure(), 0);
+
+  // Stalled for 250ms in a second.
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  writePressure(1250000, 0);
+  monitor.updateResourceUsage(resource_);
+  ASSERT_TRUE(resource_.hasPressure());
+  EXPECT_DOUBLE_EQ(resource_.pressure(), 0.25);
+}
+
+TEST_F(PressureStallMonitorTest, ReadsFullLine) {
+  config_.set_full(true);
+  PressureStallMonitor monitor(config_, time_system_);
+  writePressure(0, 0);
+  monitor.updateResourceUsage(resource_);
+
+  time_system_.advanceTimeWait(std::chrono::seconds(2));
+  writePressure(2000000, 1000000);
+  monitor.updateResourceUsage(resource_);
+  ASSERT_TRUE(resource_.hasPressure());
+  EXPECT_DOUBLE_EQ(resource_.pressure(), 0.5);
+}
+
+TEST_F(PressureStallMonitorTest, SmoothsSamples) {
+  config_.mutable_smoothing_factor()->set_value(0.5);
+  PressureStallMonitor monitor(config_, time_system_);
+  writePressure(0, 0);
+  monitor.updateResourceUsage(resource_);
+
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  writePressure(1000000, 0);
+  monitor.updateResourceUsage(resource_);
+  EXPECT_DOUBLE_EQ(resource_.pressure(), 0.5);
+
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  writePressure(2000000, 0);
+  monitor.updateResourceUsage(resource_);
+  EXPECT_DOUBLE_EQ(resource_.pressure(), 0.75);
+}
+
+TEST_F(PressureStallMonitorTest, MissingFile) {
+  config_.set_resource(
+      envoy::extensions::resource_monitors::pressure_stall::v3::PressureStallConfig::IO);
+  PressureStallMonitor monitor(config_, time_system_);
+  monitor.updateResourceUsage(resource_);
+  EXPECT_TRUE(resource_.hasError());
+}
+
+TEST_F(PressureStallMonitorTest, UnexpectedFormat) {
+  PressureStallMonitor monitor(config_, time_system_);
+  file_updater_.update("some avg10=0.00 avg60=0.00 avg300=0.00\n");
+  monitor.updateResourceUsage(resource_);
+  EXPECT_TRUE(resource_.hasError());
+}
+
+} // namespace
+} // namespace PressureStallMonitor
+} // namespace ResourceMonitors
+} // namespace Extensions
+} // namespace Envoy
@@ -10,6 +10,7 @@
 #include "source/extensions/stat_sinks/common/statsd/statsd.h"
 #include "source/extensions/stat_sinks/common/statsd/tag_formats.h"
 
+#include "test/common/stats/stat_test_utility.h"
 #include "test/mocks/stats/mocks.h"
 #include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/environment.h"
@@ -50,9 +51,10 @@ TEST(UdpOverUdsStatsdSinkTest, InitWithPipeAddress) {
   std::shared_ptr<Network::Address::PipeInstance> uds_address =
       *Network::Address::PipeInstance::create(
           TestEnvironment::unixDomainSocketPath("udstest.1.sock"));
+  Stats::TestUtil::TestSymbolTable symbol_table_;
   NiceMock<ThreadLocal::MockInstance> tls_;
   NiceMock<Stats::MockMetricSnapshot> snapshot;
-  UdpStatsdSink sink(tls_, uds_address, false);
+  UdpStatsdSink sink(tls_, *symbol_table_, uds_address, false);
 
   NiceMock<Stats::MockCounter> counter;
   counter.name_ = "test_counter";
@@ -82,10 +84,11 @@ INSTANTIATE_TEST_SUITE_P(IpVersions, UdpStatsdSinkTest,
                          TestUtility::ipTestParamsToString);
 
 TEST_P(UdpStatsdSinkTest, InitWithIpAddress) {
+  Stats::TestUtil::TestSymbolTable symbol_table_;
   NiceMock<ThreadLocal::MockInstance> tls_;
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   Network::Test::UdpSyncPeer server(GetParam());
-  UdpStatsdSink sink(tls_, server.localAddress(), false);
+  UdpStatsdSink sink(tls_, *symbol_table_, server.localAddress(), false);
 
   NiceMock<Stats::MockCounter> counter;
   counter.name_ = "test_counter";
@@ -149,10 +152,11 @@ INSTANTIATE_TEST_SUITE_P(IpVersions, UdpStatsdSinkWithTagsTest,
                          TestUtility::ipTestParamsToString);
 
 TEST_P(UdpStatsdSinkWithTagsTest, InitWithIpAddress) {
+  Stats::TestUtil::TestSymbolTable symbol_table_;
   NiceMock<ThreadLocal::MockInstance> tls_;
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   Network::Test::UdpSyncPeer server(GetParam());
-  UdpStatsdSink sink(tls_, server.localAddress(), true);
+  UdpStatsdSink sink(tls_, *symbol_table_, server.localAddress(), true);
 
   std::vector<Stats::Tag> tags = {Stats::Tag{"node", "test"}};
   NiceMock<Stats::MockCounter> counter;
@@ -220,8 +224,9 @@ TEST(UdpStatsdSinkTest, CheckActualStats) {
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
   writer_ptr->delegateBufferFake();
+  Stats::TestUtil::TestSymbolTable symbol_table_;
   NiceMock<ThreadLocal::MockInstance> tls_;
-  UdpStatsdSink sink(tls_, writer_ptr, false, getDefaultPrefix(), 1024);
+  UdpStatsdSink sink(tls_, *symbol_table_, writer_ptr, false, getDefaultPrefix(), 1024);
 
   NiceMock<Stats::MockCounter> counter;
   counter.name_ = "test_counter";
@@ -255,13 +260,44 @@ TEST(UdpStatsdSinkTest, CheckActualStats) {
   tls_.shutdownThread();
 }
 
+// The rendered names are reused across flushes, and follow the name of the metric.
+TEST(UdpStatsdSinkTest, RenderedNamesFollowMetricNames) {
+  NiceMock<Stats::MockMetricSnapshot> snapshot;
+  auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
+  writer_ptr->delegateBufferFake();
+  Stats::TestUtil::TestSymbolTable symbol_table_;
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  UdpStatsdSink sink(tls_, *symbol_table_, writer_ptr, false, getDefaultPrefix(), 1024);
+
+  NiceMock<Stats::MockCounter> counter;
+  counter.name_ = "test_counter";
+  counter.used_ = true;
+  snapshot.counters_.push_back({1, counter});
+
+  sink.flush(snapshot);
+  snapshot.counters_[0].delta_ = 2;
+  sink.flush(snapshot);
+  // The same metric object, now with another name.
+  counter.name_ = "other_counter";
+  sink.flush(snapshot);
+  // A metric which was not used by the previous flush is rendered again.
+  counter.name_ = "test_counter";
+  sink.flush(snapshot);
+
+  EXPECT_THAT(writer_ptr->buffer_writes,
+              testing::ElementsAre("envoy.test_counter:1|c", "envoy.test_counter:2|c",
+                                   "envoy.other_counter:2|c", "envoy.test_counter:2|c"));
+  tls_.shutdownThread();
+}
+
 TEST(UdpStatsdSinkTest, CheckMetricLargerThanBuffer) {
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
   writer_ptr->delegateBufferFake();
+  Stats::TestUtil::TestSymbolTable symbol_table_;
   NiceMock<ThreadLocal::MockInstance> tls_;
   uint64_t buffer_size = 4;
-  UdpStatsdSink sink(tls_, writer_ptr, false, getDefaultPrefix(), buffer_size);
+  UdpStatsdSink sink(tls_, *symbol_table_, writer_ptr, false, getDefaultPrefix(), buffer_size);
 
   NiceMock<Stats::MockCounter> counter;
   counter.name_ = "test_counter";
@@ -293,9 +329,10 @@ TEST(UdpStatsdSinkTest, CheckBufferedWritesWithinBufferSize) {
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
   writer_ptr->delegateBufferFake();
+  Stats::TestUtil::TestSymbolTable symbol_table_;
   NiceMock<ThreadLocal::MockInstance> tls_;
   uint64_t buffer_size = 1024;
-  UdpStatsdSink sink(tls_, writer_ptr, false, getDefaultPrefix(), buffer_size);
+  UdpStatsdSink sink(tls_, *symbol_table_, writer_ptr, false, getDefaultPrefix(), buffer_size);
 
   NiceMock<Stats::MockCounter> counter;
   counter.name_ = "test_counter";
@@ -322,9 +359,10 @@ TEST(UdpStatsdSinkTest, CheckBufferedWritesExceedingBufferSize) {
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
   writer_ptr->delegateBufferFake();
+  Stats::TestUtil::TestSymbolTable symbol_table_;
   NiceMock<ThreadLocal::MockInstance> tls_;
   uint64_t buffer_size = 64;
-  UdpStatsdSink sink(tls_, writer_ptr, false, getDefaultPrefix(), buffer_size);
+  UdpStatsdSink sink(tls_, *symbol_table_, writer_ptr, false, getDefaultPrefix(), buffer_size);
 
   NiceMock<Stats::MockCounter> counter_1;
   counter_1.name_ = "test_counter_1";
@@ -359,8 +397,9 @@ TEST(UdpStatsdSinkTest, CheckActualStatsWithCustomPrefix) {
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
   writer_ptr->delegateBufferFake();
+  Stats::TestUtil::TestSymbolTable symbol_table_;
   NiceMock<ThreadLocal::MockInstance> tls_;
-  UdpStatsdSink sink(tls_, writer_ptr, false, "test_prefix", 1024);
+  UdpStatsdSink sink(tls_, *symbol_table_, writer_ptr, false, "test_prefix", 1024);
 
   NiceMock<Stats::MockCounter> counter;
   counter.name_ = "test_counter";
@@ -380,8 +419,9 @@ TEST(UdpStatsdSinkTest, CheckActualStatsWithCustomPrefix) {
 TEST(UdpStatsdSinkTest, SiSuffix) {
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
+  Stats::TestUtil::TestSymbolTable symbol_table_;
   NiceMock<ThreadLocal::MockInstance> tls_;
-  UdpStatsdSink sink(tls_, writer_ptr, false);
+  UdpStatsdSink sink(tls_, *symbol_table_, writer_ptr, false);
 
   NiceMock<Stats::MockHistogram> items;
   items.name_ = "items";
@@ -421,8 +461,9 @@ TEST(UdpStatsdSinkTest, SiSuffix) {
 TEST(UdpStatsdSinkTest, ScaledPercent) {
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
+  Stats::TestUtil::TestSymbolTable symbol_table_;
   NiceMock<ThreadLocal::MockInstance> tls_;
-  UdpStatsdSink sink(tls_, writer_ptr, false);
+  UdpStatsdSink sink(tls_, *symbol_table_, writer_ptr, false);
 
   NiceMock<Stats::MockHistogram> items;
   items.name_ = "items";
@@ -439,8 +480,9 @@ TEST(UdpStatsdSinkWithTagsTest, CheckActualStats) {
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
   writer_ptr->delegateBufferFake();
+  Stats::TestUtil::TestSymbolTable symbol_table_;
   NiceMock<ThreadLocal::MockInstance> tls_;
-  UdpStatsdSink sink(tls_, writer_ptr, true, getDefaultPrefix(), 1024);
+  UdpStatsdSink sink(tls_, *symbol_table_, writer_ptr, true, getDefaultPrefix(), 1024);
 
   std::vector<Stats::Tag> tags = {Stats::Tag{"key1", "value1"}, Stats::Tag{"key2", "value2"}};
   NiceMock<Stats::MockCounter> counter;
@@ -481,8 +523,9 @@ TEST(UdpStatsdSinkWithTagsTest, CheckActualStats) {
 TEST(UdpStatsdSinkWithTagsTest, SiSuffix) {
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
+  Stats::TestUtil::TestSymbolTable symbol_table_;
   NiceMock<ThreadLocal::MockInstance> tls_;
-  UdpStatsdSink sink(tls_, writer_ptr, true);
+  UdpStatsdSink sink(tls_, *symbol_table_, writer_ptr, true);
 
   std::vector<Stats::Tag> tags = {Stats::Tag{"key1", "value1"}, Stats::Tag{"key2", "value2"}};
 
@@ -529,8 +572,10 @@ TEST(UdpStatsdSinkWithTagsTest, GraphiteTagSyntax) {
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
   writer_ptr->delegateBufferFake();
+  Stats::TestUtil::TestSymbolTable symbol_table_;
   NiceMock<ThreadLocal::MockInstance> tls_;
-  UdpStatsdSink sink(tls_, writer_ptr, true, getDefaultPrefix(), 1024, getGraphiteTagFormat());
+  UdpStatsdSink sink(tls_, *symbol_table_, writer_ptr, true, getDefaultPrefix(), 1024,
+                     getGraphiteTagFormat());
 
   std::vector<Stats::Tag> tags = {Stats::Tag{"key1", "value1"}, Stats::Tag{"key2", "value2"}};
   NiceMock<Stats::MockCounter> counter;
@@ -39,13 +39,15 @@ public:
                                          bool report_histograms_as_deltas = false,
                                          bool emit_tags_as_attributes = true,
                                          bool use_tag_extracted_name = true,
-                                         const std::string& stat_prefix = "") {
+                                         const std::string& stat_prefix = "",
+                                         bool omit_unchanged_deltas = false) {
     envoy::extensions::stat_sinks::open_telemetry::v3::SinkConfig sink_config;
     sink_config.set_report_counters_as_deltas(report_counters_as_deltas);
     sink_config.set_report_histograms_as_deltas(report_histograms_as_deltas);
     sink_config.mutable_emit_tags_as_attributes()->set_value(emit_tags_as_attributes);
     sink_config.mutable_use_tag_extracted_name()->set_value(use_tag_extracted_name);
     sink_config.set_prefix(stat_prefix);
+    sink_config.set_omit_unchanged_deltas(omit_unchanged_deltas);
 
     return std::make_shared<OtlpOptions>(sink_config);
   }
@@ -409,6 +411,32 @@ TEST_F(OtlpMetricsFlusherTests, DeltaCounterMetric) {
   expectSum(metricAt(3, metrics), getTagExtractedName("test_host_counter2"), 5, true);
 }
 
+TEST_F(OtlpMetricsFlusherTests, DeltaCounterMetricOmitsUnchanged) {
+  OtlpMetricsFlusherImpl flusher(otlpOptions(true, false, true, true, "", true));
+
+  addCounterToSnapshot("test_counter1", 0, 1);
+  addCounterToSnapshot("test_counter2", 2, 3);
+  addHostCounterToSnapshot("test_host_counter1", 0, 4);
+  addHostCounterToSnapshot("test_host_counter2", 5, 10);
+
+  MetricsExportRequestSharedPtr metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 2);
+  expectSum(metricAt(0, metrics), getTagExtractedName("test_counter2"), 2, true);
+  expectSum(metricAt(1, metrics), getTagExtractedName("test_host_counter2"), 5, true);
+}
+
+TEST_F(OtlpMetricsFlusherTests, CumulativeCounterMetricKeepsUnchanged) {
+  OtlpMetricsFlusherImpl flusher(otlpOptions(false, false, true, true, "", true));
+
+  addCounterToSnapshot("test_counter1", 0, 1);
+  addHostCounterToSnapshot("test_host_counter1", 0, 4);
+
+  MetricsExportRequestSharedPtr metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 2);
+  expectSum(metricAt(0, metrics), getTagExtractedName("test_counter1"), 1, false);
+  expectSum(metricAt(1, metrics), getTagExtractedName("test_host_counter1"), 4, false);
+}
+
 TEST_F(OtlpMetricsFlusherTests, CumulativeHistogramMetric) {
   OtlpMetricsFlusherImpl flusher(otlpOptions());
 
@@ -433,6 +461,18 @@ TEST_F(OtlpMetricsFlusherTests, DeltaHistogramMetric) {
   expectHistogram(metricAt(1, metrics), getTagExtractedName("test_histogram2"), true);
 }
 
+TEST_F(OtlpMetricsFlusherTests, DeltaHistogramMetricOmitsUnchanged) {
+  OtlpMetricsFlusherImpl flusher(otlpOptions(false, true, true, true, "", true));
+
+  addHistogramToSnapshot("test_histogram1", true);
+  // No value was recorded in the interval.
+  addHistogramToSnapshot("test_histogram2", false);
+
+  MetricsExportRequestSharedPtr metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 1);
+  expectHistogram(metricAt(0, metrics), getTagExtractedName("test_histogram1"), true);
+}
+
 class MockOpenTelemetryGrpcMetricsExporter : public OpenTelemetryGrpcMetricsExporter {
 public:
   MOCK_METHOD(void, send, (MetricsExportRequestPtr &&));
@@ -50,6 +50,19 @@ TEST(SpanContextExtractorTest, ExtractSpanContextNotSampled) {
   EXPECT_FALSE(span_context->sampled());
 }
 
+TEST(SpanContextExtractorTest, ExtractSampledFlagFromTraceFlags) {
+  for (const auto& [flags, sampled] : std::vector<std::pair<std::string, bool>>{
+           {"03", true}, {"0a", false}, {"0B", true}, {"FE", false}, {"ff", true}}) {
+    Tracing::TestTraceContextImpl request_headers{
+        {"traceparent", fmt::format("{}-{}-{}-{}", version, trace_id, parent_id, flags)}};
+    SpanContextExtractor span_context_extractor(request_headers);
+    absl::StatusOr<SpanContext> span_context = span_context_extractor.extractSpanContext();
+
+    EXPECT_OK(span_context);
+    EXPECT_EQ(sampled, span_context->sampled()) << flags;
+  }
+}
+
 TEST(SpanContextExtractorTest, ThrowsExceptionWithoutHeader) {
   Tracing::TestTraceContextImpl request_headers{{}};
   SpanContextExtractor span_context_extractor(request_headers);
@@ -107,6 +107,17 @@ TEST_F(TcpStatsTest, Periodic) {
   tcp_stats_socket_->closeSocket(Network::ConnectionEvent::RemoteClose);
 }
 
+// Validate that the payload may bypass the socket if it may bypass the wrapped socket, as only the
+// TCP info of the socket is sampled.
+TEST_F(TcpStatsTest, PassesRawBytesThrough) {
+  initialize(false);
+
+  EXPECT_CALL(*inner_socket_, passesRawBytesThrough()).WillOnce(Return(true));
+  EXPECT_TRUE(tcp_stats_socket_->passesRawBytesThrough());
+  EXPECT_CALL(*inner_socket_, passesRawBytesThrough()).WillOnce(Return(false));
+  EXPECT_FALSE(tcp_stats_socket_->passesRawBytesThrough());
+}
+
 // Validate that stats are updated when the connection is closed. Gauges should be set to zero,
 // and counters should be appropriately updated.
 TEST_F(TcpStatsTest, CloseSocket) {
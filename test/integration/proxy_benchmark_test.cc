@@ -0,0 +1,183 @@
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "source/common/common/assert.h"
+#include "source/common/tls/context_manager_impl.h"
+
+#include "test/integration/http_integration.h"
+#include "test/integration/ssl_utility.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/network_utility.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+constexpr uint64_t DefaultTestIterations = 1000;
+
+/*
+ * This file contains a set of tests that may be used to measure the throughput and latency of
+ * the whole proxy for a few representative configurations. Each test starts a server with the
+ * integration test framework, proxying to an autonomous upstream in the same process, and sends
+ * requests one after another on a single downstream connection.
+ *
+ * Each test writes one line of JSON with its results to stdout, and appends it to the file named
+ * by the environment variable PROXY_BENCHMARK_OUTPUT if it is set, so that the results of runs
+ * may be compared by tooling:
+ *
+ *    {"scenario": "http1-to-http2", "requests": 1000, "rps": ..., "p50_us": ..., "p99_us": ...,
+ *     "p999_us": ..., "cpu_us_per_request": ...}
+ *
+ * The CPU time is that of the whole process, so that it includes the client and the upstream.
+ * It is meaningful when comparing runs of the same test, rather than as an absolute figure.
+ *
+ * By default, each test sends 1000 requests, which is likely not enough for a consistent result.
+ * The environment variable PROXY_BENCHMARK_ITERATIONS may be used to override this.
+ */
+class ProxyBenchmarkTest : public HttpIntegrationTest, public testing::Test {
+protected:
+  ProxyBenchmarkTest() : HttpIntegrationTest(Http::CodecType::HTTP1, getIpVersion()) {}
+
+  static Network::Address::IpVersion getIpVersion() {
+    return Network::Test::supportsIpVersion(Network::Address::IpVersion::v4)
+               ? Network::Address::IpVersion::v4
+               : Network::Address::IpVersion::v6;
+  }
+
+  void TearDown() override {
+    cleanupUpstreamAndDownstream();
+    client_ssl_ctx_.reset();
+  }
+
+  void initialize() override {
+    // This enables a built-in automatic upstream server.
+    autonomous_upstream_ = true;
+    if (tls_) {
+      config_helper_.addSslConfig();
+    }
+    HttpIntegrationTest::initialize();
+    if (tls_) {
+      client_ssl_ctx_ = Ssl::createClientSslTransportSocketFactory({}, context_manager_, *api_);
+    }
+  }
+
+  Network::ClientConnectionPtr makeDownstreamConnection() {
+    if (!tls_) {
+      return makeClientConnection(lookupPort("http"));
+    }
+    return dispatcher_->createClientConnection(
+        Ssl::getSslAddress(version_, lookupPort("http")), nullptr,
+        client_ssl_ctx_->createTransportSocket(nullptr, nullptr), nullptr, nullptr);
+  }
+
+  static uint64_t getTestIterations() {
+    const auto env_value = TestEnvironment::getOptionalEnvVar("PROXY_BENCHMARK_ITERATIONS");
+    uint64_t iterations;
+    if (env_value && absl::SimpleAtoi(*env_value, &iterations) && iterations > 0) {
+      return iterations;
+    }
+    return DefaultTestIterations;
+  }
+
+  static std::chrono::microseconds cpuTime() {
+    struct rusage usage;
+    RELEASE_ASSERT(getrusage(RUSAGE_SELF, &usage) == 0, "");
+    return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+  }
+
+  void measureHttpGets(absl::string_view scenario, uint64_t response_size = 100) {
+    codec_client_ = makeHttpConnection(makeDownstreamConnection());
+    Http::TestRequestHeaderMapImpl headers;
+    HttpTestUtility::addDefaultHeaders(headers);
+    headers.addCopy(Http::LowerCaseString("response_size_bytes"), response_size);
+    const auto send_request = [&]() {
+      auto response = codec_client_->makeHeaderOnlyRequest(headers);
+      ASSERT_TRUE(response->waitForEndStream());
+      EXPECT_THAT(response->headers(), Http::HttpStatusIs("200"));
+      EXPECT_EQ(response_size, response->body().size());
+    };
+
+    // Warm up the connections and the caches of the server before measuring.
+    const uint64_t iterations = getTestIterations();
+    for (uint64_t i = 0; i < std::max<uint64_t>(iterations / 10, 1); i++) {
+      send_request();
+    }
+
+    std::vector<std::chrono::nanoseconds> latencies;
+    latencies.reserve(iterations);
+    const std::chrono::microseconds cpu_start = cpuTime();
+    const MonotonicTime start = timeSystem().monotonicTime();
+    for (uint64_t i = 0; i < iterations; i++) {
+      const MonotonicTime request_start = timeSystem().monotonicTime();
+      send_request();
+      latencies.push_back(timeSystem().monotonicTime() - request_start);
+    }
+    const std::chrono::duration<double> elapsed = timeSystem().monotonicTime() - start;
+    const std::chrono::microseconds cpu = cpuTime() - cpu_start;
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&latencies](double p) {
+      const size_t index =
+          std::min(static_cast<size_t>(latencies.size() * p), latencies.size() - 1);
+      return std::chrono::duration_cast<std::chrono::microseconds>(latencies[index]).count();
+    };
+    const std::string result = fmt::format(
+        R"EOF({{"scenario": "{}", "requests": {}, "rps": {:.0f}, "p50_us": {}, "p99_us": {}, )EOF"
+        R"EOF("p999_us": {}, "cpu_us_per_request": {:.1f}}})EOF",
+        scenario, iterations, iterations / elapsed.count(), percentile(0.5), percentile(0.99),
+        percentile(0.999), static_cast<double>(cpu.count()) / iterations);
+    std::cout << result << std::endl;
+    const auto output = TestEnvironment::getOptionalEnvVar("PROXY_BENCHMARK_OUTPUT");
+    if (output) {
+      std::ofstream(*output, std::ios_base::app) << result << std::endl;
+    }
+  }
+
+  bool tls_{};
+  Extensions::TransportSockets::Tls::ContextManagerImpl context_manager_{server_factory_context_};
+  Network::UpstreamTransportSocketFactoryPtr client_ssl_ctx_;
+};
+
+TEST_F(ProxyBenchmarkTest, Http1ToHttp1) {
+  initialize();
+  measureHttpGets("http1-to-http1");
+}
+
+TEST_F(ProxyBenchmarkTest, Http1ToHttp2) {
+  setUpstreamProtocol(Http::CodecType::HTTP2);
+  initialize();
+  measureHttpGets("http1-to-http2");
+}
+
+TEST_F(ProxyBenchmarkTest, Http2ToHttp2) {
+  setDownstreamProtocol(Http::CodecType::HTTP2);
+  setUpstreamProtocol(Http::CodecType::HTTP2);
+  initialize();
+  measureHttpGets("http2-to-http2");
+}
+
+TEST_F(ProxyBenchmarkTest, Http2ToHttp2LargeResponse) {
+  setDownstreamProtocol(Http::CodecType::HTTP2);
+  setUpstreamProtocol(Http::CodecType::HTTP2);
+  initialize();
+  measureHttpGets("http2-to-http2-large-response", 64 * 1024);
+}
+
+TEST_F(ProxyBenchmarkTest, TlsHttp1ToHttp1) {
+  tls_ = true;
+  initialize();
+  measureHttpGets("tls-http1-to-http1");
+}
+
+} // namespace
+} // namespace Envoy
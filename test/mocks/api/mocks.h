@@ -83,6 +83,8 @@ public:
   MOCK_METHOD(SysCallSizeResult, readv, (os_fd_t, const iovec*, int));
   MOCK_METHOD(SysCallSizeResult, pwrite,
               (os_fd_t fd, const void* buffer, size_t length, off_t offset), (const));
+  MOCK_METHOD(SysCallSizeResult, pwritev,
+              (os_fd_t fd, const iovec* iov, int num_iov, off_t offset), (const));
   MOCK_METHOD(SysCallSizeResult, pread, (os_fd_t fd, void* buffer, size_t length, off_t offset),
               (const));
   MOCK_METHOD(SysCallSizeResult, send, (os_fd_t socket, void* buffer, size_t length, int flags));
@@ -142,6 +144,11 @@ class MockLinuxOsSysCalls : public LinuxOsSysCallsImpl {
 public:
   // Api::LinuxOsSysCalls
   MOCK_METHOD(SysCallIntResult, sched_getaffinity, (pid_t pid, size_t cpusetsize, cpu_set_t* mask));
+  MOCK_METHOD(SysCallIntResult, pipe2, (int pipefd[2], int flags));
+  MOCK_METHOD(SysCallSizeResult, splice,
+              (int fd_in, off_t* off_in, int fd_out, off_t* off_out, size_t len,
+               unsigned int flags));
+  MOCK_METHOD(SysCallIntResult, bpf, (int cmd, union bpf_attr* attr, unsigned int size));
 };
 #endif
 
@@ -201,6 +201,7 @@ public:
 
   // Http::FilterChainManager
   MOCK_METHOD(void, applyFilterFactoryCb, (FilterContext context, FilterFactoryCb& factory));
+  MOCK_METHOD(void, reserveFilters, (size_t count));
 
   NiceMock<MockFilterChainFactoryCallbacks> callbacks_;
 };
@@ -705,6 +706,7 @@ public:
   MOCK_METHOD(bool, appendLocalOverload, (), (const));
   MOCK_METHOD(bool, appendXForwardedPort, (), (const));
   MOCK_METHOD(bool, addProxyProtocolConnectionState, (), (const));
+  MOCK_METHOD(bool, trackCpuTime, (), (const));
 
   class AllowInternalAddressConfig : public Http::InternalAddressConfig {
   public:
@@ -75,6 +75,7 @@ struct MockManager : Manager {
   MOCK_METHOD(void, initialize, (const Watcher&));
   MOCK_METHOD((const absl::flat_hash_map<std::string, uint32_t>&), unreadyTargets, (), (const));
   MOCK_METHOD(void, dumpUnreadyTargets, (envoy::admin::v3::UnreadyTargetsDumps&));
+  MOCK_METHOD(void, setTargetObserver, (TargetObserver));
 };
 
 } // namespace Init
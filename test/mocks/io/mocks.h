@@ -19,12 +19,19 @@ public:
   MOCK_METHOD(IoUringResult, prepareConnect,
               (os_fd_t fd, const Network::Address::InstanceConstSharedPtr& address,
                Request* user_data));
+  MOCK_METHOD(bool, isOpSupported, (uint8_t op), (const));
+  MOCK_METHOD(ProvidedBufferRingSharedPtr, createProvidedBufferRing,
+              (uint16_t group, uint32_t num_buffers, uint32_t buffer_size));
+  MOCK_METHOD(IoUringResult, prepareRecvMultishot,
+              (os_fd_t fd, uint16_t buffer_group, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareReadv,
               (os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
                Request* user_data));
   MOCK_METHOD(IoUringResult, prepareWritev,
               (os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
                Request* user_data));
+  MOCK_METHOD(IoUringResult, prepareSendmsgZeroCopy,
+              (os_fd_t fd, const struct msghdr* msg, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareClose, (os_fd_t fd, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareCancel, (Request * cancelling_user_data, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareShutdown, (os_fd_t fd, int how, Request* user_data));
@@ -33,6 +40,14 @@ public:
   MOCK_METHOD(void, removeInjectedCompletion, (os_fd_t fd));
 };
 
+class MockProvidedBufferRing : public ProvidedBufferRing {
+public:
+  MOCK_METHOD(uint16_t, group, (), (const));
+  MOCK_METHOD(uint32_t, bufferSize, (), (const));
+  MOCK_METHOD(uint8_t*, buffer, (uint16_t id));
+  MOCK_METHOD(void, recycle, (uint16_t id));
+};
+
 class MockIoUringSocket : public IoUringSocket {
 public:
   MOCK_METHOD(os_fd_t, fd, (), (const));
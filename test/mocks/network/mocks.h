@@ -182,6 +182,7 @@ public:
 
   MOCK_METHOD(void, onData, (UdpRecvData && data));
   MOCK_METHOD(void, onDatagramsDropped, (uint32_t dropped));
+  MOCK_METHOD(void, onDatagramsRead, (uint32_t datagrams));
   MOCK_METHOD(void, onReadReady, ());
   MOCK_METHOD(void, onWriteReady, (const Socket& socket));
   MOCK_METHOD(void, onReceiveError, (Api::IoError::IoErrorCode err));
@@ -640,6 +641,11 @@ public:
   MOCK_METHOD(Api::IoCallUint64Result, writePacket,
               (const Buffer::Instance& buffer, const Address::Ip* local_ip,
                const Address::Instance& peer_address));
+  MOCK_METHOD(bool, supportsReleaseTime, (), (const));
+  MOCK_METHOD(Api::IoCallUint64Result, writePacketWithReleaseTime,
+              (const Buffer::Instance& buffer, const Address::Ip* local_ip,
+               const Address::Instance& peer_address,
+               std::chrono::microseconds release_time_delay));
   MOCK_METHOD(bool, isWriteBlocked, (), (const));
   MOCK_METHOD(void, setWritable, ());
   MOCK_METHOD(uint64_t, getMaxPacketSize, (const Address::Instance& peer_address), (const));
@@ -707,6 +713,7 @@ public:
   MOCK_METHOD(void, unregisterHandler, (BalancedConnectionHandler & handler));
   MOCK_METHOD(BalancedConnectionHandler&, pickTargetHandler,
               (BalancedConnectionHandler & current_handler));
+  MOCK_METHOD(void, onConnectionClosed, (BalancedConnectionHandler & handler));
 };
 
 class MockListenerFilterMatcher : public ListenerFilterMatcher {
@@ -723,6 +730,7 @@ public:
                Address::InstanceConstSharedPtr peer_address, Buffer::InstancePtr buffer,
                MonotonicTime receive_time, uint8_t tos, Buffer::OwnedImpl saved_cmsg));
   MOCK_METHOD(void, onDatagramsDropped, (uint32_t dropped));
+  MOCK_METHOD(void, onDatagramsRead, (uint32_t datagrams));
   MOCK_METHOD(uint64_t, maxDatagramSize, (), (const));
   MOCK_METHOD(size_t, numPacketsExpectedPerEventLoop, (), (const));
   MOCK_METHOD(const IoHandle::UdpSaveCmsgConfig&, saveCmsgConfig, (), (const));
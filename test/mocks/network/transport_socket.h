@@ -36,6 +36,7 @@ public:
   MOCK_METHOD(bool, startSecureTransport, ());
   MOCK_METHOD(void, configureInitialCongestionWindow,
               (uint64_t bandwidth_bits_per_sec, std::chrono::microseconds rtt));
+  MOCK_METHOD(bool, passesRawBytesThrough, (), (const));
 
   TransportSocketCallbacks* callbacks_{};
 };
@@ -50,6 +50,8 @@ public:
   MOCK_METHOD(bool, flushOnAdmin, (), (const));
   MOCK_METHOD(const Stats::SinkPredicates*, sinkPredicates, (), (const));
   MOCK_METHOD(bool, enableDeferredCreationStats, (), (const));
+  MOCK_METHOD(bool, enableDeltaStatFlush, (), (const));
+  MOCK_METHOD(std::chrono::milliseconds, deltaStatFullFlushInterval, (), (const));
 };
 
 class MockServerFactoryContext : public virtual ServerFactoryContext {
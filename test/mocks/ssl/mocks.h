@@ -116,10 +116,12 @@ public:
   MOCK_METHOD(bool, allowRenegotiation, (), (const));
   MOCK_METHOD(bool, enforceRsaKeyUsage, (), (const));
   MOCK_METHOD(size_t, maxSessionKeys, (), (const));
+  MOCK_METHOD(absl::optional<uint64_t>, sessionCacheKey, (), (const));
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogLocal, (), (const));
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogRemote, (), (const));
   MOCK_METHOD(const std::string&, tlsKeyLogPath, (), (const));
   MOCK_METHOD(AccessLog::AccessLogManager&, accessLogManager, (), (const));
+  MOCK_METHOD(bool, kernelTlsTxOffload, (), (const));
   Ssl::HandshakerCapabilities capabilities_;
   std::string sni_{"default_sni.example.com"};
   std::string ciphers_{"RSA"};
@@ -163,6 +165,7 @@ public:
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogRemote, (), (const));
   MOCK_METHOD(const std::string&, tlsKeyLogPath, (), (const));
   MOCK_METHOD(AccessLog::AccessLogManager&, accessLogManager, (), (const));
+  MOCK_METHOD(bool, kernelTlsTxOffload, (), (const));
   MOCK_METHOD(bool, fullScanCertsOnSNIMismatch, (), (const));
 
   Ssl::HandshakerCapabilities capabilities_;
@@ -213,6 +216,8 @@ public:
   MOCK_METHOD(bool, onlyVerifyLeafCertificateCrl, (), (const));
   MOCK_METHOD(absl::optional<uint32_t>, maxVerifyDepth, (), (const));
   MOCK_METHOD(bool, autoSniSanMatch, (), (const));
+  MOCK_METHOD(uint32_t, verifiedCertificateCacheSize, (), (const));
+  MOCK_METHOD(std::chrono::milliseconds, verifiedCertificateCacheMaxAge, (), (const));
 };
 
 class MockPrivateKeyMethodManager : public PrivateKeyMethodManager {
@@ -3,6 +3,7 @@
 #include "envoy/network/filter.h"
 #include "envoy/network/listener.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/network/listen_socket_impl.h"
 #include "source/common/network/socket_option_factory.h"
 #include "source/common/network/udp_packet_writer_handler_impl.h"
@@ -11,6 +12,7 @@
 #include "test/mocks/network/mocks.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/network_utility.h"
+#include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -194,6 +196,16 @@ TEST_P(ActiveUdpListenerTest, MultipleFiltersOnReceiveErrorStopIteration) {
   active_listener_->onReceiveError(Api::IoError::IoErrorCode::UnknownError);
 }
 
+TEST_P(ActiveUdpListenerTest, ForwardToOtherWorker) {
+  setup(2);
+  active_listener_->destination_ = 1;
+
+  Network::UdpRecvData data;
+  data.buffer_ = std::make_unique<Buffer::OwnedImpl>("hello");
+  active_listener_->onData(std::move(data));
+  EXPECT_EQ(1U, TestUtility::findCounter(store_, "udp.downstream_rx_datagram_forwarded")->value());
+}
+
 } // namespace
 } // namespace Server
 } // namespace Envoy
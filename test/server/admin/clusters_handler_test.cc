@@ -4,6 +4,7 @@
 #include "test/mocks/event/mocks.h"
 #include "test/server/admin/admin_instance.h"
 
+using testing::HasSubstr;
 using testing::Return;
 using testing::ReturnPointee;
 using testing::ReturnRef;
@@ -245,6 +246,43 @@ fake_cluster::1.2.3.4:80::local_origin_success_rate::93.2
   EXPECT_EQ(expected_text, response2.toString());
 }
 
+TEST_P(AdminInstanceTest, ClustersNameRegex) {
+  Upstream::ClusterManager::ClusterInfoMaps cluster_maps;
+  ON_CALL(server_.cluster_manager_, clusters()).WillByDefault(ReturnPointee(&cluster_maps));
+  NiceMock<Upstream::MockClusterMockPrioritySet> cluster;
+  cluster_maps.active_clusters_.emplace(cluster.info_->name_, cluster);
+
+  Http::TestResponseHeaderMapImpl header_map;
+  {
+    Buffer::OwnedImpl response;
+    EXPECT_EQ(Http::Code::OK,
+              getCallback("/clusters?format=json&name_regex=fake_.*", header_map, response));
+    envoy::admin::v3::Clusters output_proto;
+    TestUtility::loadFromJson(response.toString(), output_proto);
+    ASSERT_EQ(1, output_proto.cluster_statuses_size());
+    EXPECT_EQ("fake_cluster", output_proto.cluster_statuses(0).name());
+  }
+  {
+    // The regex must match the whole name.
+    Buffer::OwnedImpl response;
+    EXPECT_EQ(Http::Code::OK,
+              getCallback("/clusters?format=json&name_regex=fake", header_map, response));
+    envoy::admin::v3::Clusters output_proto;
+    TestUtility::loadFromJson(response.toString(), output_proto);
+    EXPECT_EQ(0, output_proto.cluster_statuses_size());
+  }
+  {
+    Buffer::OwnedImpl response;
+    EXPECT_EQ(Http::Code::OK, getCallback("/clusters?name_regex=other", header_map, response));
+    EXPECT_EQ("", response.toString());
+  }
+  {
+    Buffer::OwnedImpl response;
+    EXPECT_EQ(Http::Code::BadRequest, getCallback("/clusters?name_regex=[", header_map, response));
+    EXPECT_THAT(response.toString(), HasSubstr("Error while parsing name_regex from ["));
+  }
+}
+
 TEST_P(AdminInstanceTest, TestSetHealthFlag) {
   std::shared_ptr<Upstream::MockClusterInfo> cluster{new NiceMock<Upstream::MockClusterInfo>()};
   Event::MockDispatcher dispatcher;
@@ -73,6 +73,55 @@ TEST_P(AdminInstanceTest, ConfigDump) {
   EXPECT_EQ(expected_json, response2.toString());
 }
 
+TEST_P(AdminInstanceTest, ConfigDumpEmpty) {
+  Buffer::OwnedImpl response;
+  Http::TestResponseHeaderMapImpl header_map;
+  EXPECT_EQ(Http::Code::OK, getCallback("/config_dump", header_map, response));
+  EXPECT_EQ("{}\n", response.toString());
+}
+
+// Each config of the dump is rendered in its own chunk.
+TEST_P(AdminInstanceTest, ConfigDumpStreamsConfigs) {
+  auto foo_entry = admin_.getConfigTracker().add("foo", [](const Matchers::StringMatcher&) {
+    auto msg = std::make_unique<ProtobufWkt::StringValue>();
+    msg->set_value("foo_config");
+    return msg;
+  });
+  auto bar_entry = admin_.getConfigTracker().add("bar", [](const Matchers::StringMatcher&) {
+    auto msg = std::make_unique<ProtobufWkt::StringValue>();
+    msg->set_value("bar_config");
+    return msg;
+  });
+  request_headers_.setMethod(Http::Headers::get().MethodValues.Get);
+  request_headers_.setPath("/config_dump");
+  admin_filter_.decodeHeaders(request_headers_, false);
+  Admin::RequestPtr request = admin_.makeRequest(admin_filter_);
+  Http::TestResponseHeaderMapImpl header_map;
+  EXPECT_EQ(Http::Code::OK, request->start(header_map));
+  EXPECT_EQ(Http::Headers::get().ContentTypeValues.Json, header_map.getContentTypeValue());
+
+  Buffer::OwnedImpl response;
+  EXPECT_TRUE(request->nextChunk(response));
+  EXPECT_EQ(R"EOF({
+ "configs": [
+  {
+   "@type": "type.googleapis.com/google.protobuf.StringValue",
+   "value": "bar_config"
+  })EOF",
+            response.toString());
+  response.drain(response.length());
+  EXPECT_FALSE(request->nextChunk(response));
+  EXPECT_EQ(R"EOF(,
+  {
+   "@type": "type.googleapis.com/google.protobuf.StringValue",
+   "value": "foo_config"
+  }
+ ]
+}
+)EOF",
+            response.toString());
+}
+
 TEST_P(AdminInstanceTest, ConfigDumpMaintainsOrder) {
   // Add configs in random order and validate config_dump dumps in the order.
   auto bootstrap_entry =
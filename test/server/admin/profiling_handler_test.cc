@@ -6,6 +6,8 @@
 namespace Envoy {
 namespace Server {
 
+using testing::Return;
+
 INSTANTIATE_TEST_SUITE_P(IpVersions, AdminInstanceTest,
                          testing::ValuesIn(TestEnvironment::getIpVersionsForTest()),
                          TestUtility::ipTestParamsToString);
@@ -29,6 +31,31 @@ TEST_P(AdminInstanceTest, AdminCpuProfiler) {
   EXPECT_FALSE(Profiler::Cpu::profilerEnabled());
 }
 
+TEST_P(AdminInstanceTest, AdminCpuProfile) {
+  Buffer::OwnedImpl data;
+  Http::TestResponseHeaderMapImpl header_map;
+  EXPECT_EQ(Http::Code::BadRequest, getCallback("/cpu_profile", header_map, data));
+  EXPECT_EQ("The CPU profiler is not running", data.toString());
+
+#ifdef PROFILER_AVAILABLE
+  EXPECT_EQ(Http::Code::OK, postCallback("/cpuprofiler?enable=y", header_map, data));
+  EXPECT_CALL(server_.api_.file_system_, fileReadToEnd(cpu_profile_path_))
+      .WillOnce(Return(std::string("profile")));
+  data.drain(data.length());
+  EXPECT_EQ(Http::Code::OK, getCallback("/cpu_profile", header_map, data));
+  EXPECT_EQ("profile", data.toString());
+  EXPECT_EQ("application/octet-stream", header_map.getContentTypeValue());
+  // The profile is served without stopping the profiler.
+  EXPECT_TRUE(Profiler::Cpu::profilerEnabled());
+
+  EXPECT_CALL(server_.api_.file_system_, fileReadToEnd(cpu_profile_path_))
+      .WillOnce(Return(absl::NotFoundError("no profile")));
+  data.drain(data.length());
+  EXPECT_EQ(Http::Code::InternalServerError, getCallback("/cpu_profile", header_map, data));
+  EXPECT_EQ(Http::Code::OK, postCallback("/cpuprofiler?enable=n", header_map, data));
+#endif
+}
+
 TEST_P(AdminInstanceTest, AdminHeapProfilerOnRepeatedRequest) {
   Buffer::OwnedImpl data;
   Http::TestResponseHeaderMapImpl header_map;
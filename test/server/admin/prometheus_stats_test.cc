@@ -193,6 +193,15 @@ TEST_F(PrometheusStatsFormatterTest, FormattedTags) {
   EXPECT_EQ(expected, actual);
 }
 
+TEST_F(PrometheusStatsFormatterTest, FormattedTagsNonAscii) {
+  std::vector<Stats::Tag> tags;
+  tags.push_back({"a.t\xc3\xa4g", "v\xc3\xa4lue"});
+  tags.push_back({"b-tag", "value"});
+  // A multi-byte character of a name is replaced by a single '_', values are kept.
+  EXPECT_EQ("a_t_g=\"v\xc3\xa4lue\",b_tag=\"value\"",
+            PrometheusStatsFormatter::formattedTags(tags));
+}
+
 TEST_F(PrometheusStatsFormatterTest, MetricNameCollison) {
   Stats::CustomStatNamespacesImpl custom_namespaces;
 
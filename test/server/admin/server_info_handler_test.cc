@@ -61,6 +61,19 @@ TEST_P(AdminInstanceTest, Memory) {
                                   Property(&envoy::admin::v3::Memory::pageheap_unmapped, Ge(0)),
                                   Property(&envoy::admin::v3::Memory::pageheap_free, Ge(0)),
                                   Property(&envoy::admin::v3::Memory::total_thread_cache, Ge(0))));
+  EXPECT_TRUE(output_proto.allocated_by_subsystem().empty());
+}
+
+TEST_P(AdminInstanceTest, MemoryBySubsystem) {
+  Http::TestResponseHeaderMapImpl header_map;
+  Buffer::OwnedImpl response;
+  EXPECT_EQ(Http::Code::OK, getCallback("/memory?subsystems", header_map, response));
+  envoy::admin::v3::Memory output_proto;
+  TestUtility::loadFromJson(response.toString(), output_proto);
+#if !defined(TCMALLOC)
+  // Only Google's tcmalloc is supported.
+  EXPECT_TRUE(output_proto.allocated_by_subsystem().empty());
+#endif
 }
 
 TEST_P(AdminInstanceTest, GetReadyRequest) {
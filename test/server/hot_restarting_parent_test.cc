@@ -268,6 +268,39 @@ TEST_F(HotRestartingParentTest, ExportStatsToChild) {
   }
 }
 
+TEST_F(HotRestartingParentTest, ExportChangedGaugesToChild) {
+  Stats::TestUtil::TestStore store;
+  MockListenerManager listener_manager;
+  EXPECT_CALL(server_, listenerManager()).WillRepeatedly(ReturnRef(listener_manager));
+  EXPECT_CALL(listener_manager, numConnections()).WillRepeatedly(Return(0));
+  EXPECT_CALL(server_, stats()).WillRepeatedly(ReturnRef(store));
+
+  store.gauge("g1", Stats::Gauge::ImportMode::Accumulate).set(123);
+  store.gauge("g2", Stats::Gauge::ImportMode::Accumulate).set(456);
+  {
+    HotRestartMessage::Reply::Stats stats;
+    hot_restarting_parent_.exportStatsToChild(&stats, true);
+    EXPECT_EQ(123, stats.gauges().at("g1"));
+    EXPECT_EQ(456, stats.gauges().at("g2"));
+  }
+  // Only changed and new gauges are exported.
+  {
+    store.gauge("g2", Stats::Gauge::ImportMode::Accumulate).add(1);
+    store.gauge("g3", Stats::Gauge::ImportMode::Accumulate).set(0);
+    HotRestartMessage::Reply::Stats stats;
+    hot_restarting_parent_.exportStatsToChild(&stats, true);
+    EXPECT_EQ(stats.gauges().end(), stats.gauges().find("g1"));
+    EXPECT_EQ(457, stats.gauges().at("g2"));
+    EXPECT_EQ(0, stats.gauges().at("g3"));
+  }
+  // Unless the child asks for all gauges.
+  {
+    HotRestartMessage::Reply::Stats stats;
+    hot_restarting_parent_.exportStatsToChild(&stats, false);
+    EXPECT_EQ(3, stats.gauges().size());
+  }
+}
+
 TEST_F(HotRestartingParentTest, RetainDynamicStats) {
   MockListenerManager listener_manager;
   Stats::SymbolTableImpl parent_symbol_table;
@@ -160,6 +160,64 @@ TEST(ServerInstanceUtil, flushImportModeUninitializedGauges) {
   InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
 }
 
+TEST(ServerInstanceUtil, flushDeltaStats) {
+  InSequence s;
+
+  NiceMock<Upstream::MockClusterManager> cm;
+  Stats::TestUtil::TestStore store;
+  Event::SimulatedTimeSystem time_system;
+  DeltaStatFlushState delta_state(std::chrono::seconds(60));
+  Stats::Counter& c1 = store.counter("c1");
+  Stats::Counter& c2 = store.counter("c2");
+  Stats::Gauge& g1 = store.gauge("g1", Stats::Gauge::ImportMode::Accumulate);
+  Stats::Gauge& g2 = store.gauge("g2", Stats::Gauge::ImportMode::Accumulate);
+  store.textReadout("text").set("is important");
+  c1.inc();
+  g1.set(5);
+
+  std::list<Stats::SinkPtr> sinks;
+  Stats::MockSink* sink = new StrictMock<Stats::MockSink>();
+  sinks.emplace_back(sink);
+
+  // The first flush passes all metrics.
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.counters().size(), 2);
+    EXPECT_EQ(snapshot.gauges().size(), 2);
+    EXPECT_EQ(snapshot.textReadouts().size(), 1);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system, &delta_state);
+
+  // Later flushes only pass the changed counters and gauges.
+  c2.add(3);
+  g1.set(5);
+  g2.set(1);
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    ASSERT_EQ(snapshot.counters().size(), 1);
+    EXPECT_EQ(snapshot.counters()[0].counter_.get().name(), "c2");
+    EXPECT_EQ(snapshot.counters()[0].delta_, 3);
+    ASSERT_EQ(snapshot.gauges().size(), 1);
+    EXPECT_EQ(snapshot.gauges()[0].get().name(), "g2");
+    EXPECT_EQ(snapshot.textReadouts().size(), 1);
+  }));
+  time_system.advanceTimeWait(std::chrono::seconds(5));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system, &delta_state);
+
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_TRUE(snapshot.counters().empty());
+    EXPECT_TRUE(snapshot.gauges().empty());
+  }));
+  time_system.advanceTimeWait(std::chrono::seconds(5));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system, &delta_state);
+
+  // Once the full flush interval passed, all metrics are passed again.
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.counters().size(), 2);
+    EXPECT_EQ(snapshot.gauges().size(), 2);
+  }));
+  time_system.advanceTimeWait(std::chrono::seconds(60));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system, &delta_state);
+}
+
 class RunHelperTest : public testing::Test {
 public:
   RunHelperTest() {
@@ -0,0 +1,117 @@
+#include "source/common/json/json_loader.h"
+#include "source/server/startup_trace.h"
+
+#include "test/test_common/simulated_time_system.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Server {
+namespace {
+
+class StartupTraceTest : public testing::Test, public Event::TestUsingSimulatedTime {
+protected:
+  void advance(uint64_t ms) { simTime().advanceTimeWait(std::chrono::milliseconds(ms)); }
+
+  StartupTrace::AllocatedBytesFn allocatedBytes() {
+    return [this]() { return allocated_bytes_; };
+  }
+
+  uint64_t allocated_bytes_{1024 * 1024};
+};
+
+TEST_F(StartupTraceTest, RecordsPhases) {
+  StartupTrace trace(simTime(), allocatedBytes());
+  trace.beginPhase("startup");
+  advance(5);
+  trace.beginPhase("load_bootstrap");
+  advance(10);
+  allocated_bytes_ += 4096;
+  trace.endPhase("load_bootstrap");
+  advance(1);
+  allocated_bytes_ -= 1024;
+  trace.endPhase("startup");
+
+  ASSERT_EQ(2, trace.phases().size());
+  EXPECT_EQ("load_bootstrap", trace.phases()[0].name_);
+  EXPECT_EQ(std::chrono::milliseconds(5), trace.phases()[0].start_);
+  EXPECT_EQ(std::chrono::milliseconds(10), trace.phases()[0].duration_);
+  EXPECT_EQ(4096, trace.phases()[0].allocated_bytes_);
+  EXPECT_EQ("startup", trace.phases()[1].name_);
+  EXPECT_EQ(std::chrono::milliseconds(0), trace.phases()[1].start_);
+  EXPECT_EQ(std::chrono::milliseconds(16), trace.phases()[1].duration_);
+  EXPECT_EQ(3072, trace.phases()[1].allocated_bytes_);
+
+  // The text report is ordered by the start of the phases.
+  EXPECT_EQ("    start_ms  duration_ms allocated_kb  phase\n"
+            "       0.000       16.000            3  startup\n"
+            "       5.000       10.000            4  load_bootstrap\n"
+            "(startup is still in progress)\n",
+            trace.toText());
+}
+
+// Phases with the same name in progress at the same time are all recorded.
+TEST_F(StartupTraceTest, OverlappingPhasesWithTheSameName) {
+  StartupTrace trace(simTime(), allocatedBytes());
+  trace.beginPhase("init RDS");
+  advance(2);
+  trace.beginPhase("init RDS");
+  advance(3);
+  trace.endPhase("init RDS");
+  advance(4);
+  trace.endPhase("init RDS");
+  trace.endPhase("init RDS");
+
+  ASSERT_EQ(2, trace.phases().size());
+  EXPECT_EQ(std::chrono::milliseconds(0), trace.phases()[0].start_);
+  EXPECT_EQ(std::chrono::milliseconds(5), trace.phases()[0].duration_);
+  EXPECT_EQ(std::chrono::milliseconds(2), trace.phases()[1].start_);
+  EXPECT_EQ(std::chrono::milliseconds(7), trace.phases()[1].duration_);
+}
+
+TEST_F(StartupTraceTest, UnmatchedEndIgnored) {
+  StartupTrace trace(simTime(), allocatedBytes());
+  trace.endPhase("rtds");
+  EXPECT_TRUE(trace.phases().empty());
+}
+
+TEST_F(StartupTraceTest, NothingRecordedOnceComplete) {
+  StartupTrace trace(simTime(), allocatedBytes());
+  trace.beginPhase("init target LDS");
+  trace.beginPhase("start_workers");
+  trace.endPhase("start_workers");
+  trace.complete();
+  // Neither the phase in progress nor later phases are recorded.
+  trace.endPhase("init target LDS");
+  trace.beginPhase("late");
+  trace.endPhase("late");
+
+  ASSERT_EQ(1, trace.phases().size());
+  EXPECT_EQ("start_workers", trace.phases()[0].name_);
+  EXPECT_EQ("    start_ms  duration_ms allocated_kb  phase\n"
+            "       0.000        0.000            0  start_workers\n",
+            trace.toText());
+}
+
+TEST_F(StartupTraceTest, ChromeTrace) {
+  StartupTrace trace(simTime(), allocatedBytes());
+  advance(2);
+  trace.beginPhase("init target \"quoted\"");
+  advance(3);
+  allocated_bytes_ += 100;
+  trace.endPhase("init target \"quoted\"");
+
+  Json::ObjectSharedPtr json = Json::Factory::loadFromString(trace.toChromeTrace()).value();
+  std::vector<Json::ObjectSharedPtr> events = json->getObjectArray("traceEvents").value();
+  ASSERT_EQ(1, events.size());
+  EXPECT_EQ("init target \"quoted\"", events[0]->getString("name").value());
+  EXPECT_EQ("startup", events[0]->getString("cat").value());
+  EXPECT_EQ("X", events[0]->getString("ph").value());
+  EXPECT_EQ(2000, events[0]->getInteger("ts").value());
+  EXPECT_EQ(3000, events[0]->getInteger("dur").value());
+  EXPECT_EQ(100, events[0]->getObject("args").value()->getInteger("allocated_bytes").value());
+}
+
+} // namespace
+} // namespace Server
+} // namespace Envoy